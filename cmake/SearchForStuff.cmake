@@ -546,6 +546,39 @@ if (PKG_CONFIG_FOUND)
     BUILD_WARNING ("GNU Triangulation Surface library not found - Gazebo will not have CSG support.")
   endif ()
 
+  ########################################
+  # Find zstd and lz4, optional encodings of log files
+  pkg_check_modules(ZSTD libzstd)
+  if (ZSTD_FOUND)
+    message (STATUS "Looking for zstd - found")
+    set (HAVE_ZSTD TRUE)
+  else ()
+    set (HAVE_ZSTD FALSE)
+    BUILD_WARNING ("zstd not found - log files will not support zstd encoding.")
+  endif ()
+
+  pkg_check_modules(LZ4 liblz4)
+  if (LZ4_FOUND)
+    message (STATUS "Looking for lz4 - found")
+    set (HAVE_LZ4 TRUE)
+  else ()
+    set (HAVE_LZ4 FALSE)
+    BUILD_WARNING ("lz4 not found - log files will not support lz4 encoding.")
+  endif ()
+
+  ########################################
+  # Find EGL, used to render without an X server
+  if (NOT APPLE AND NOT WIN32)
+    pkg_check_modules(egl egl)
+    if (egl_FOUND)
+      message (STATUS "Looking for EGL - found")
+      set (HAVE_EGL TRUE)
+    else ()
+      set (HAVE_EGL FALSE)
+      BUILD_WARNING ("EGL not found - Gazebo will need an X server to render.")
+    endif ()
+  endif ()
+
   #################################################
   # Find bullet
   # First and preferred option is to look for bullet standard pkgconfig,
@@ -569,6 +602,11 @@ if (PKG_CONFIG_FOUND)
     add_definitions( -DLIBBULLET_VERSION_GT_282 )
   endif()
 
+  # The task scheduler interface of the multithreaded dynamics world
+  if (NOT BULLET_VERSION VERSION_LESS 2.88)
+    add_definitions( -DLIBBULLET_VERSION_GE_288 )
+  endif()
+
   ########################################
   # Find libusb
   pkg_check_modules(libusb-1.0 libusb-1.0)
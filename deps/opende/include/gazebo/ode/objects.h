@@ -108,6 +108,26 @@ ODE_API int dWorldGetIslandThreads (dWorldID);
  */
 ODE_API void dWorldSetIslandThreads (dWorldID, int num_island_threads);
 
+/**
+ * @brief Call a function once on each thread of the island thread pool,
+ * e.g. to name the threads. Returns when every call returned.
+ *
+ * @ingroup world
+ */
+ODE_API void dWorldInitIslandThreads (dWorldID, void (*fn)(void *data),
+                                      void *data);
+
+/**
+ * @brief Get the wall clock time that each island of the last step took,
+ * in seconds, in the order the islands were found.
+ *
+ * @param times array receiving the times, may be NULL
+ * @param max_times size of the times array
+ * @returns the number of islands of the last step
+ * @ingroup world
+ */
+ODE_API int dWorldGetIslandTimes (dWorldID, double *times, int max_times);
+
 /**
  * @brief Set the number of thread pool threads for quickstep
  *
@@ -2131,6 +2151,26 @@ ODE_API void dJointSetFeedback (dJointID, dJointFeedback *);
  */
 ODE_API dJointFeedback *dJointGetFeedback (dJointID);
 
+/**
+ * @brief Get the constraint multipliers computed for the joint by the last
+ * quickstep, which are used to warm start the next quickstep.
+ * @ingroup joints
+ * @param lambda array of 6 multipliers of the constraint rows.
+ * @param lambda_erp array of 6 multipliers of the erp constraint rows.
+ */
+ODE_API void dJointGetLambda (dJointID, dReal *lambda, dReal *lambda_erp);
+
+/**
+ * @brief Set the constraint multipliers used to warm start the next
+ * quickstep, e.g. for a contact joint that replaces a contact joint of the
+ * previous step.
+ * @ingroup joints
+ * @param lambda array of 6 multipliers of the constraint rows.
+ * @param lambda_erp array of 6 multipliers of the erp constraint rows.
+ */
+ODE_API void dJointSetLambda (dJointID, const dReal *lambda,
+    const dReal *lambda_erp);
+
 /**
  * @brief Set the joint anchor point.
  * @ingroup joints
@@ -185,6 +185,17 @@ struct dxBody : public dObject {
 };
 
 
+// an island of a step, as scheduled on the island thread pool
+struct dxIsland {
+  dxBody *const *body;  // first body of the island
+  int bcount;           // number of bodies
+  dxJoint *const *joint; // first joint of the island
+  int jcount;           // number of joints
+  size_t cost;          // stepper memory estimate, grows with the rows
+  int index;            // order in which the island was found
+};
+
+
 struct dxWorld : public dBase {
   dxBody *firstbody;    // body linked list
   dxJoint *firstjoint;    // joint linked list
@@ -204,6 +215,8 @@ struct dxWorld : public dBase {
   dReal max_angular_speed;      // limit the angular velocity to this magnitude
   boost::threadpool::pool *threadpool;
   boost::threadpool::pool *row_threadpool;
+  std::vector<dxIsland> islands; // islands of the step, in scheduling order
+  std::vector<double> island_times; // seconds per island of the last step
 };
 
 
@@ -38,6 +38,8 @@
 #include "step.h"
 #include "quickstep.h"
 #include "util.h"
+#include <boost/bind/bind.hpp>
+#include <boost/thread/barrier.hpp>
 #include "odetls.h"
 #include "robuststep.h"
 
@@ -1542,6 +1544,21 @@ dJointFeedback *dJointGetFeedback (dxJoint *joint)
   return joint->feedback;
 }
 
+void dJointGetLambda (dxJoint *joint, dReal *lambda, dReal *lambda_erp)
+{
+  dAASSERT (joint && lambda && lambda_erp);
+  memcpy (lambda, joint->lambda, 6 * sizeof(dReal));
+  memcpy (lambda_erp, joint->lambda_erp, 6 * sizeof(dReal));
+}
+
+void dJointSetLambda (dxJoint *joint, const dReal *lambda,
+  const dReal *lambda_erp)
+{
+  dAASSERT (joint && lambda && lambda_erp);
+  memcpy (joint->lambda, lambda, 6 * sizeof(dReal));
+  memcpy (joint->lambda_erp, lambda_erp, 6 * sizeof(dReal));
+}
+
 
 
 dJointID dConnectingJoint (dBodyID in_b1, dBodyID in_b2)
@@ -1779,6 +1796,18 @@ int dWorldGetIslandThreads (dWorldID w)
   return w->threadpool->size();
 }
 
+int dWorldGetIslandTimes (dWorldID w, double *times, int max_times)
+{
+  dAASSERT (w);
+  int count = (int)w->island_times.size();
+  if (times) {
+    for (int i = 0; i < count && i < max_times; ++i) {
+      times[i] = w->island_times[i];
+    }
+  }
+  return count;
+}
+
 void dWorldSetIslandThreads (dWorldID w, int num_island_threads)
 {
   dAASSERT (w);
@@ -1792,6 +1821,28 @@ void dWorldSetIslandThreads (dWorldID w, int num_island_threads)
   }
 }
 
+static void initThread (void (*fn)(void *), void *data,
+                        boost::barrier *started)
+{
+  fn (data);
+  // hold the thread until every thread of the pool took a call
+  started->wait();
+}
+
+void dWorldInitIslandThreads (dWorldID w, void (*fn)(void *), void *data)
+{
+  dAASSERT (w && fn);
+  if (!w->threadpool || w->threadpool->size() == 0) {
+    return;
+  }
+  w->threadpool->wait();
+  boost::barrier started (w->threadpool->size());
+  for (size_t i = 0; i < w->threadpool->size(); ++i) {
+    w->threadpool->schedule (boost::bind (&initThread, fn, data, &started));
+  }
+  w->threadpool->wait();
+}
+
 void dWorldSetQuickStepThreads (dWorldID w, int num_quickstep_threads)
 {
   dAASSERT (w);
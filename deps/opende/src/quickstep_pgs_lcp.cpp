@@ -49,6 +49,7 @@ std::vector<dReal> errors;
 
 using namespace ode;
 
+ODE_SIMD_DISPATCH
 static void* ComputeRows(void *p)
 {
   dxPGSLCPParameters *params = (dxPGSLCPParameters *)p;
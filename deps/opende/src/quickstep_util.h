@@ -31,6 +31,24 @@
 #define Kf(x) _mm_set_pd((x),(x))
 #endif
 
+// ODE_SIMD selects the vector kernels of dot6 and sum6. They are written
+// with gcc vector extensions, which compile to SSE2 or AVX on x86 and to
+// NEON on arm. Define ODE_NO_SIMD to use the scalar reference kernels.
+#if defined(dDOUBLE) && defined(__GNUC__) && !defined(ODE_NO_SIMD) && \
+    (defined(__SSE2__) || defined(__ARM_NEON))
+#define ODE_SIMD
+#include <cstring>
+#endif
+
+// ODE_SIMD_DISPATCH compiles a solver function once per instruction set,
+// the version for the cpu being picked when the library is loaded.
+#if defined(ODE_SIMD) && defined(__x86_64__) && defined(__linux__) && \
+    !defined(__clang__)
+#define ODE_SIMD_DISPATCH __attribute__((target_clones("avx", "default")))
+#else
+#define ODE_SIMD_DISPATCH
+#endif
+
 
 #undef REPORT_THREAD_TIMING
 #undef USE_TPROW
@@ -215,17 +233,33 @@ inline void scaled_add (int n, dRealMutablePtr x, dRealPtr y, dRealPtr z, dReal
   for (int i=0; i<n; i++) x[i] = y[i] + z[i]*alpha;
 }
 
+#ifdef ODE_SIMD
+typedef dReal dSimd4 __attribute__((vector_size(4 * sizeof(dReal))));
+typedef dReal dSimd2 __attribute__((vector_size(2 * sizeof(dReal))));
+
+// unaligned loads and stores, the rows of J are not aligned on 32 bytes
+template <typename T>
+inline T simd_load(dRealPtr a)
+{
+  T v;
+  std::memcpy(&v, a, sizeof(v));
+  return v;
+}
+
+template <typename T>
+inline void simd_store(dRealMutablePtr a, const T &v)
+{
+  std::memcpy(a, &v, sizeof(v));
+}
+#endif
+
 // dot product of two vector a and b with length 6
-// define ODE_SSE to enable SSE, which is used to speed up
-// vector math operations with gcc compiler
-// macro SSE is renamed to ODE_SSE due to conflict with Eigen3 in DART
 inline dReal dot6(dRealPtr a, dRealPtr b)
 {
-#ifdef ODE_SSE
-  __m128d d = _mm_load_pd(a+0) * _mm_load_pd(b+0) + _mm_load_pd(a+2) * _mm_load_pd(b+2) + _mm_load_pd(a+4) * _mm_load_pd(b+4);
-  double r[2];
-  _mm_store_pd(r, d);
-  return r[0] + r[1];
+#ifdef ODE_SIMD
+  const dSimd4 d4 = simd_load<dSimd4>(a) * simd_load<dSimd4>(b);
+  const dSimd2 d2 = simd_load<dSimd2>(a + 4) * simd_load<dSimd2>(b + 4);
+  return (d4[0] + d4[2] + d2[0]) + (d4[1] + d4[3] + d2[1]);
 #else
   return a[0] * b[0] +
          a[1] * b[1] +
@@ -239,11 +273,10 @@ inline dReal dot6(dRealPtr a, dRealPtr b)
 // a = a + delta * b, vector a and b with length 6
 inline void sum6(dRealMutablePtr a, dReal delta, dRealPtr b)
 {
-#ifdef ODE_SSE
-  __m128d __delta = Kf(delta);
-  _mm_store_pd(a + 0, _mm_load_pd(a + 0) + __delta * _mm_load_pd(b + 0));
-  _mm_store_pd(a + 2, _mm_load_pd(a + 2) + __delta * _mm_load_pd(b + 2));
-  _mm_store_pd(a + 4, _mm_load_pd(a + 4) + __delta * _mm_load_pd(b + 4));
+#ifdef ODE_SIMD
+  simd_store(a, simd_load<dSimd4>(a) + delta * simd_load<dSimd4>(b));
+  simd_store(a + 4,
+             simd_load<dSimd2>(a + 4) + delta * simd_load<dSimd2>(b + 4));
 #else
   a[0] += delta * b[0];
   a[1] += delta * b[1];
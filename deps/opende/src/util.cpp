@@ -27,6 +27,8 @@
 #include "util.h"
 #include <boost/thread/recursive_mutex.hpp>
 #include <boost/bind/bind.hpp>
+#include <algorithm>
+#include <chrono>
 #include <gazebo/ode/timer.h>
 
 #undef REPORT_THREAD_TIMING
@@ -400,6 +402,19 @@ static size_t EstimateIslandsProcessingMemoryRequirements(dxWorld *world, size_t
   return res;
 }
 
+// a kinematic body that no enabled joint attaches to a dynamic body has no
+// constraint to solve, so it is kept out of the islands and only moved by
+// its velocity, see dxProcessIslands
+static bool dxIsLoneKinematicBody(const dxBody *b)
+{
+  if (b->invMass != 0) return false;
+  for (dxJointNode *n=b->firstjoint; n; n=n->next) {
+    if (n->joint->isEnabled() && n->body && n->body->invMass != 0)
+      return false;
+  }
+  return true;
+}
+
 // sorts out islands,
 // cllocates array for island information into arrays: body[nj], joint[nb], islandsizes[2*nb]
 //   context->SavePreallocations(islandcount, islandsizes, body, joint,islandreqs);
@@ -454,6 +469,15 @@ static size_t BuildIslandsAndEstimateStepperMemoryRequirements(dxWorldProcessCon
       // get bb = the next enabled, untagged body, and tag it
       if (!bb->island_tag) {
         if (!(bb->flags & dxBodyDisabled)) {
+          // tagged 2 to be moved after the islands, along with its joints
+          // that no island reaches
+          if (dxIsLoneKinematicBody(bb)) {
+            bb->island_tag = 2;
+            for (dxJointNode *n=bb->firstjoint; n; n=n->next)
+              n->joint->island_tag = 1;
+            continue;
+          }
+
           bb->island_tag = 1;
 
           dxBody **bodycurr = bodystart;
@@ -593,6 +617,34 @@ void dxProcessOneIsland(dxWorldProcessContext *island_context, dxWorld *world, d
 #endif
 }
 
+// steps islands [first, last) of world->islands one after the other,
+// recording the time that each one took
+static void dxProcessIslandBatch(dxWorld *world, dReal stepsize,
+                                 dstepper_fn_t stepper,
+                                 size_t first, size_t last)
+{
+  for (size_t i = first; i < last; ++i) {
+    const dxIsland &island = world->islands[i];
+
+    // get working memory for each island
+    dxStepWorkingMemory *island_wmem = world->island_wmems[island.index];
+    dIASSERT(island_wmem != NULL);
+    dxWorldProcessContext *island_context = island_wmem->GetWorldProcessingContext();
+
+    const std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+    dxProcessOneIsland(island_context, world, stepsize, stepper,
+                       island.body, island.bcount, island.joint, island.jcount);
+    world->island_times[island.index] = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start).count();
+  }
+}
+
+static bool dxIslandCostGreater(const dxIsland &a, const dxIsland &b)
+{
+  return a.cost > b.cost;
+}
+
 void dxProcessIslands (dxWorld *world, dReal stepsize, dstepper_fn_t stepper)
 {
   const int sizeelements = 2;
@@ -624,39 +676,71 @@ void dxProcessIslands (dxWorld *world, dReal stepsize, dstepper_fn_t stepper)
   printf(">>>>>>>>>>>> start island spawn threads at time %f\n",cur_time);
 #endif
 
+  // the stepper memory estimate grows with the bodies and constraint rows
+  // of an island, and the solver iterations are the same for every island,
+  // so it orders the islands by cost
+  world->islands.clear();
+  world->island_times.assign(islandcount, 0.0);
+  size_t totalcost = 0;
   for (int const *sizescurr = islandsizes; sizescurr != sizesend; sizescurr += sizeelements) {
-    int bcount = sizescurr[0];
-    int jcount = sizescurr[1];
-
-    // get working memory for each island
-    dxStepWorkingMemory *island_wmem = world->island_wmems[island_index++];
-    dIASSERT(island_wmem != NULL);
-    dxWorldProcessContext *island_context = island_wmem->GetWorldProcessingContext();
+    dxIsland island;
+    island.body = bodystart;
+    island.bcount = sizescurr[0];
+    island.joint = jointstart;
+    island.jcount = sizescurr[1];
+    island.cost = islandreqs[island_index];
+    island.index = island_index++;
+    world->islands.push_back(island);
+    totalcost += island.cost;
+
+    bodystart += island.bcount;
+    jointstart += island.jcount;
+  }
 
-#define USE_TPISLAND
-#ifdef USE_TPISLAND
-    IFTIMING(dTimerNow("scheduling island"));
-    //printf("debug opende tp %d\n",world->threadpool->size());
-    if (world->threadpool && world->threadpool->size() > 0)
-      world->threadpool->schedule(boost::bind(dxProcessOneIsland,island_context, world, stepsize, stepper,bodystart, bcount, jointstart, jcount));
-    else //automatically skip threadpool if only 1 thread allocated
-      dxProcessOneIsland(island_context, world, stepsize, stepper,bodystart, bcount, jointstart, jcount);
-#else
-    dxProcessOneIsland(island_context, world, stepsize, stepper,bodystart, bcount, jointstart, jcount);
-#endif
+  IFTIMING(dTimerNow("scheduling islands"));
+  const size_t threads = world->threadpool ? world->threadpool->size() : 0;
+  if (threads > 0 && world->islands.size() > 1) {
+    // the pool threads take the tasks in order, so scheduling the costly
+    // islands first keeps them from finishing last on a single thread.
+    // islands below a fraction of the cost of a thread are batched, to
+    // save the per task overhead.
+    std::stable_sort(world->islands.begin(), world->islands.end(),
+                     dxIslandCostGreater);
+    const size_t batchcost = totalcost / (threads * 4);
+
+    size_t first = 0;
+    size_t cost = 0;
+    for (size_t i = 0; i < world->islands.size(); ++i) {
+      cost += world->islands[i].cost;
+      if (cost >= batchcost || i + 1 == world->islands.size()) {
+        world->threadpool->schedule(boost::bind(dxProcessIslandBatch, world,
+                                                stepsize, stepper, first, i + 1));
+        first = i + 1;
+        cost = 0;
+      }
+    }
 
-    bodystart += bcount;
-    jointstart += jcount;
-  }
-#ifdef USE_TPISLAND
-  IFTIMING(dTimerNow("islands wait"));
-  if (world->threadpool && world->threadpool->size() > 0)
+    IFTIMING(dTimerNow("islands wait"));
     world->threadpool->wait();
-#endif
+  }
+  else {
+    // automatically skip threadpool if only 1 thread allocated
+    dxProcessIslandBatch(world, stepsize, stepper, 0, world->islands.size());
+  }
   IFTIMING(dTimerEnd());
   IFTIMING(dTimerReport (stdout,1));
 
 
+  // move the kinematic bodies kept out of the islands, and clear their
+  // accumulators like the steppers do
+  for (dxBody *b=world->firstbody; b; b=(dxBody*)b->next) {
+    if (b->island_tag == 2) {
+      dxStepBody(b, stepsize);
+      dSetZero(b->facc, 3);
+      dSetZero(b->tacc, 3);
+    }
+  }
+
 #ifdef REPORT_THREAD_TIMING
   gettimeofday(&tv,NULL);
   double end_time = (double)tv.tv_sec + (double)tv.tv_usec / 1.e6;
@@ -1,7 +1,7 @@
 #ifndef PARALLEL_COMMON_H
 #define PARALLEL_COMMON_H
 
-#include <ode/ode.h>
+#include <gazebo/ode/ode.h>
 #include <stdlib.h>
 #include <vector>
 
@@ -1,11 +1,11 @@
-#include <ode/objects.h>
-#include <ode/ode.h>
-#include <ode/odemath.h>
-#include <ode/rotation.h>
-#include <ode/timer.h>
-#include <ode/error.h>
-#include <ode/matrix.h>
-#include <ode/misc.h>
+#include <gazebo/ode/objects.h>
+#include <gazebo/ode/ode.h>
+#include <gazebo/ode/odemath.h>
+#include <gazebo/ode/rotation.h>
+#include <gazebo/ode/timer.h>
+#include <gazebo/ode/error.h>
+#include <gazebo/ode/matrix.h>
+#include <gazebo/ode/misc.h>
 #include "objects.h"
 #include "config.h"
 #include "joints/joint.h"
@@ -332,6 +332,64 @@ static void worldSolve(dxWorldProcessContext *context,
   }
 }
 
+// Fill the rms statistics of the quickstep parameters the way the serial
+// quickstep does, from one more sweep over the solved constraint rows.
+// J, b and Ad must have been scaled by compute_Adcfm_b.
+static void computeRMSStats(const int m, dRealPtr J, const int *jb,
+  dRealPtr lambda, dRealPtr fc, dRealPtr b, dRealPtr Ad, dRealPtr lo,
+  dRealPtr hi, const int *findex, dxQuickStepParameters *qs)
+{
+  // 0: bilateral constraints, 1: contact normals, 2: friction
+  dReal residual[3] = {0, 0, 0};
+  dReal dlambda[3] = {0, 0, 0};
+  int count[3] = {0, 0, 0};
+
+  for (int i=0; i<m; i++) {
+    dRealPtr J_ptr = J + i*12;
+    dRealPtr fc_ptr1 = fc + 6*jb[i*2];
+    dReal delta = b[i] - lambda[i]*Ad[i];
+    for (int j=0; j<6; j++) delta -= fc_ptr1[j] * J_ptr[j];
+    if (jb[i*2+1] >= 0) {
+      dRealPtr fc_ptr2 = fc + 6*jb[i*2+1];
+      for (int j=0; j<6; j++) delta -= fc_ptr2[j] * J_ptr[6+j];
+    }
+
+    dReal hi_act, lo_act;
+    if (findex[i] >= 0) {
+      hi_act = dFabs (hi[i] * lambda[findex[i]]);
+      lo_act = -hi_act;
+    } else {
+      hi_act = hi[i];
+      lo_act = lo[i];
+    }
+
+    dReal new_lambda = lambda[i] + delta;
+    if (new_lambda < lo_act) new_lambda = lo_act;
+    else if (new_lambda > hi_act) new_lambda = hi_act;
+    const dReal step = new_lambda - lambda[i];
+
+    const int type = findex[i] >= 0 ? 2 : (findex[i] == -2 ? 1 : 0);
+    residual[type] += delta*delta;
+    dlambda[type] += step*step;
+    count[type]++;
+  }
+
+  dReal residualTotal = 0, dlambdaTotal = 0;
+  int countTotal = 0;
+  for (int k=0; k<3; k++) {
+    qs->rms_constraint_residual[k] =
+      count[k] > 0 ? dSqrt(residual[k] / count[k]) : 0;
+    qs->rms_dlambda[k] = count[k] > 0 ? dSqrt(dlambda[k] / count[k]) : 0;
+    residualTotal += residual[k];
+    dlambdaTotal += dlambda[k];
+    countTotal += count[k];
+  }
+  qs->rms_constraint_residual[3] =
+    countTotal > 0 ? dSqrt(residualTotal / countTotal) : 0;
+  qs->rms_dlambda[3] = countTotal > 0 ? dSqrt(dlambdaTotal / countTotal) : 0;
+  qs->num_contacts = count[1];
+}
+
 void dxParallelProcessIslands (dxWorld *world, dReal stepsize, dstepper_fn_t stepper)
 {
   const int sizeelements = 2;
@@ -753,6 +811,8 @@ void dxParallelQuickStepper( dxWorldProcessContext *context,
         worldSolve(context,m,nb,J,jb,body,invI,lambda,cforce,rhs,lo,hi,cfm,iMJ,Ad,findex,&world->qs);
 #endif
 
+      computeRMSStats(m,J,jb,lambda,cforce,rhs,Ad,lo,hi,findex,&world->qs);
+
       IFBENCHMARKING (dTimerEnd());
 
     } END_STATE_SAVE(context, lcpstate);
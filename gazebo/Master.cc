@@ -22,7 +22,10 @@
 #include <boost/bind/bind.hpp>
 #include <boost/make_shared.hpp>
 #include <google/protobuf/descriptor.h>
+#include <memory>
 #include <set>
+#include <unordered_map>
+#include "gazebo/common/ThreadConfig.hh"
 #include "gazebo/transport/IOManager.hh"
 
 #include "Master.hh"
@@ -35,11 +38,23 @@ namespace gazebo
 {
   struct MasterPrivate
   {
-    /// \brief All the known publishers.
-    gazebo::Master::PubList publishers;
+    /// \brief All the known publishers, by topic.
+    std::unordered_map<std::string, gazebo::Master::PubList> publishers;
 
-    /// \brief All the known subscribers.
-    gazebo::Master::SubList subscribers;
+    /// \brief All the known subscribers, by topic.
+    std::unordered_map<std::string, gazebo::Master::SubList> subscribers;
+
+    /// \brief Topics advertised by each connection, by connection id.
+    std::unordered_map<unsigned int, std::set<std::string> >
+      connectionPublishers;
+
+    /// \brief Topics subscribed to by each connection, by connection id.
+    std::unordered_map<unsigned int, std::set<std::string> >
+      connectionSubscribers;
+
+    /// \brief Publishers advertised since the connections were last told,
+    /// sent to all of them in one message.
+    msgs::Publishers newPublishers;
 
     /// \brief All the known connections.
     gazebo::Master::Connection_M connections;
@@ -117,21 +132,22 @@ void Master::OnAccept(transport::ConnectionPtr _newConnection)
   _newConnection->EnqueueMsg(msgs::Package("topic_namepaces_init",
                               namespacesMsg), true);
 
-  // Send all the publishers
-  msgs::Publishers publishersMsg;
-  PubList::iterator pubiter;
-  for (pubiter = this->dataPtr->publishers.begin();
-       pubiter != this->dataPtr->publishers.end(); ++pubiter)
-  {
-    msgs::Publish *pub = publishersMsg.add_publisher();
-    pub->CopyFrom(pubiter->first);
-  }
-  _newConnection->EnqueueMsg(
-      msgs::Package("publishers_init", publishersMsg), true);
-
   // Add the connection to our list
   {
     std::lock_guard<std::recursive_mutex> lock(this->dataPtr->connectionMutex);
+
+    // Send all the publishers. The other connections are told about the
+    // new publishers first, which the new one gets here.
+    this->SendNewPublishers();
+    msgs::Publishers publishersMsg;
+    for (auto const &topic : this->dataPtr->publishers)
+    {
+      for (auto const &pub : topic.second)
+        publishersMsg.add_publisher()->CopyFrom(pub.first);
+    }
+    _newConnection->EnqueueMsg(
+        msgs::Package("publishers_init", publishersMsg), true);
+
     int index = this->dataPtr->connections.size();
 
     this->dataPtr->connections[index] = _newConnection;
@@ -180,21 +196,51 @@ void Master::OnRead(const unsigned int _connectionIndex,
 void Master::SendSubscribers(const std::string &_topic,
                              const std::string &_buffer)
 {
+  auto topicIter = this->dataPtr->subscribers.find(_topic);
+  if (topicIter == this->dataPtr->subscribers.end())
+    return;
+
   // Find all subscribers for this topic
   std::set<transport::ConnectionPtr> uniqueConnections;
-  for (auto const &subscriber : this->dataPtr->subscribers)
-    if (subscriber.first.topic() == _topic)
-      uniqueConnections.insert(subscriber.second);
+  for (auto const &subscriber : topicIter->second)
+    uniqueConnections.insert(subscriber.second);
 
-  // Send message to all unique connections
+  // Send message to all unique connections, which share the data
+  auto buffer = std::make_shared<const std::string>(_buffer);
   for (auto &conn : uniqueConnections)
-    conn->EnqueueMsg(_buffer);
+    conn->EnqueueMsg(buffer, boost::function<void(uint32_t)>(), 0);
+}
+
+//////////////////////////////////////////////////
+void Master::SendAll(const std::string &_buffer)
+{
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->connectionMutex);
+
+  auto buffer = std::make_shared<const std::string>(_buffer);
+  for (auto &conn : this->dataPtr->connections)
+  {
+    if (conn.second)
+      conn.second->EnqueueMsg(buffer, boost::function<void(uint32_t)>(), 0);
+  }
+}
+
+//////////////////////////////////////////////////
+void Master::SendNewPublishers()
+{
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->connectionMutex);
+  if (this->dataPtr->newPublishers.publisher_size() == 0)
+    return;
+
+  this->SendAll(msgs::Package("publishers_add",
+        this->dataPtr->newPublishers));
+  this->dataPtr->newPublishers.Clear();
 }
 
 //////////////////////////////////////////////////
 void Master::ProcessMessage(const unsigned int _connectionIndex,
                             const std::string &_data)
 {
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->connectionMutex);
   transport::ConnectionPtr conn = this->dataPtr->connections[_connectionIndex];
 
   if (!conn || !conn->IsOpen())
@@ -214,33 +260,21 @@ void Master::ProcessMessage(const unsigned int _connectionIndex,
                      worldNameMsg.data());
     if (iter == this->dataPtr->worldNames.end())
     {
-      std::lock_guard<std::recursive_mutex>
-          lock(this->dataPtr->connectionMutex);
       this->dataPtr->worldNames.push_back(worldNameMsg.data());
-
-      Connection_M::iterator iter2;
-      for (iter2 = this->dataPtr->connections.begin();
-          iter2 != this->dataPtr->connections.end(); ++iter2)
-      {
-        iter2->second->EnqueueMsg(
-            msgs::Package("topic_namespace_add", worldNameMsg));
-      }
+      this->SendAll(msgs::Package("topic_namespace_add", worldNameMsg));
     }
   }
   else if (packet.type() == "advertise")
   {
-    std::lock_guard<std::recursive_mutex> lock(this->dataPtr->connectionMutex);
     msgs::Publish pub;
     pub.ParseFromString(packet.serialized_data());
 
-    Connection_M::iterator iter2;
-    for (iter2 = this->dataPtr->connections.begin();
-         iter2 != this->dataPtr->connections.end(); ++iter2)
-    {
-      iter2->second->EnqueueMsg(msgs::Package("publisher_add", pub));
-    }
+    // All the connections are told at the end of the pass, see RunOnce
+    this->dataPtr->newPublishers.add_publisher()->CopyFrom(pub);
 
-    this->dataPtr->publishers.push_back(std::make_pair(pub, conn));
+    this->dataPtr->publishers[pub.topic()].push_back(
+        std::make_pair(pub, conn));
+    this->dataPtr->connectionPublishers[conn->GetId()].insert(pub.topic());
 
     this->SendSubscribers(pub.topic(),
         msgs::Package("publisher_advertise", pub));
@@ -262,18 +296,16 @@ void Master::ProcessMessage(const unsigned int _connectionIndex,
     msgs::Subscribe sub;
     sub.ParseFromString(packet.serialized_data());
 
-    this->dataPtr->subscribers.push_back(std::make_pair(sub, conn));
-
-    PubList::iterator iter;
+    this->dataPtr->subscribers[sub.topic()].push_back(
+        std::make_pair(sub, conn));
+    this->dataPtr->connectionSubscribers[conn->GetId()].insert(sub.topic());
 
     // Find all publishers of the topic
-    for (iter = this->dataPtr->publishers.begin();
-        iter != this->dataPtr->publishers.end(); ++iter)
+    auto topicIter = this->dataPtr->publishers.find(sub.topic());
+    if (topicIter != this->dataPtr->publishers.end())
     {
-      if (iter->first.topic() == sub.topic())
-      {
-        conn->EnqueueMsg(msgs::Package("publisher_subscribe", iter->first));
-      }
+      for (auto const &pub : topicIter->second)
+        conn->EnqueueMsg(msgs::Package("publisher_subscribe", pub.first));
     }
   }
   else if (packet.type() == "request")
@@ -284,12 +316,10 @@ void Master::ProcessMessage(const unsigned int _connectionIndex,
     if (req.request() == "get_publishers")
     {
       msgs::Publishers msg;
-      PubList::iterator iter;
-      for (iter = this->dataPtr->publishers.begin();
-          iter != this->dataPtr->publishers.end(); ++iter)
+      for (auto const &topic : this->dataPtr->publishers)
       {
-        msgs::Publish *pub = msg.add_publisher();
-        pub->CopyFrom(iter->first);
+        for (auto const &pub : topic.second)
+          msg.add_publisher()->CopyFrom(pub.first);
       }
       conn->EnqueueMsg(msgs::Package("publisher_list", msg), true);
     }
@@ -299,18 +329,12 @@ void Master::ProcessMessage(const unsigned int _connectionIndex,
       msgs::GzString_V msg;
 
       // Add all topics that are published
-      for (PubList::iterator iter = this->dataPtr->publishers.begin();
-          iter != this->dataPtr->publishers.end(); ++iter)
-      {
-        topics.insert(iter->first.topic());
-      }
+      for (auto const &topic : this->dataPtr->publishers)
+        topics.insert(topic.first);
 
       // Add all topics that are subscribed
-      for (SubList::iterator iter = this->dataPtr->subscribers.begin();
-           iter != this->dataPtr->subscribers.end(); ++iter)
-      {
-        topics.insert(iter->first.topic());
-      }
+      for (auto const &topic : this->dataPtr->subscribers)
+        topics.insert(topic.first);
 
       // Construct the message of only unique names
       for (std::set<std::string>::iterator iter =
@@ -328,33 +352,26 @@ void Master::ProcessMessage(const unsigned int _connectionIndex,
       msgs::TopicInfo ti;
       ti.set_msg_type(pub.msg_type());
 
-      PubList::iterator piter;
-      SubList::iterator siter;
-
       // Find all publishers of the topic
-      for (piter = this->dataPtr->publishers.begin();
-          piter != this->dataPtr->publishers.end(); ++piter)
+      auto pubIter = this->dataPtr->publishers.find(req.data());
+      if (pubIter != this->dataPtr->publishers.end())
       {
-        if (piter->first.topic() == req.data())
-        {
-          msgs::Publish *pubPtr = ti.add_publisher();
-          pubPtr->CopyFrom(piter->first);
-        }
+        for (auto const &pubPair : pubIter->second)
+          ti.add_publisher()->CopyFrom(pubPair.first);
       }
 
       // Find all subscribers of the topic
-      for (siter = this->dataPtr->subscribers.begin();
-          siter != this->dataPtr->subscribers.end(); ++siter)
+      auto subIter = this->dataPtr->subscribers.find(req.data());
+      if (subIter != this->dataPtr->subscribers.end())
       {
-        if (siter->first.topic() == req.data())
+        for (auto const &subPair : subIter->second)
         {
           // If the topic info message type has not been set or the
           // topic info message type is an empty string, then set the topic
           // info message type based on a subscriber's message type.
           if (!ti.has_msg_type() || ti.msg_type().empty())
-            ti.set_msg_type(siter->first.msg_type());
-          msgs::Subscribe *sub = ti.add_subscriber();
-          sub->CopyFrom(siter->first);
+            ti.set_msg_type(subPair.first.msg_type());
+          ti.add_subscriber()->CopyFrom(subPair.first);
         }
       }
 
@@ -384,6 +401,7 @@ void Master::ProcessMessage(const unsigned int _connectionIndex,
 //////////////////////////////////////////////////
 void Master::Run()
 {
+  common::ThreadConfig::Instance()->Apply("master");
   while (!this->dataPtr->stop)
   {
     this->RunOnce();
@@ -413,6 +431,9 @@ void Master::RunOnce()
     }
   }
 
+  // Tell all the connections about the publishers advertised in this pass
+  this->SendNewPublishers();
+
   // Process all the connections
   {
     std::lock_guard<std::recursive_mutex> lock(this->dataPtr->connectionMutex);
@@ -453,45 +474,41 @@ void Master::RemoveConnection(Connection_M::iterator _connIter)
     }
   }
 
+  const unsigned int id = _connIter->second->GetId();
+
   // Remove all publishers for this connection
-  bool done = false;
-  while (!done)
+  std::list<msgs::Publish> pubs;
+  for (auto const &topic : this->dataPtr->connectionPublishers[id])
   {
-    done = true;
-    PubList::iterator pubIter = this->dataPtr->publishers.begin();
-    while (pubIter != this->dataPtr->publishers.end())
+    auto topicIter = this->dataPtr->publishers.find(topic);
+    if (topicIter == this->dataPtr->publishers.end())
+      continue;
+    for (auto const &pub : topicIter->second)
     {
-      if ((*pubIter).second->GetId() == _connIter->second->GetId())
-      {
-        this->RemovePublisher((*pubIter).first);
-        done = false;
-        break;
-      }
-      else
-        ++pubIter;
+      if (pub.second->GetId() == id)
+        pubs.push_back(pub.first);
     }
   }
+  for (auto const &pub : pubs)
+    this->RemovePublisher(pub);
+  this->dataPtr->connectionPublishers.erase(id);
 
-
-  done = false;
-  while (!done)
+  // Remove all subscribers for this connection
+  std::list<msgs::Subscribe> subs;
+  for (auto const &topic : this->dataPtr->connectionSubscribers[id])
   {
-    done = true;
-
-    // Remove all subscribers for this connection
-    SubList::iterator subIter = this->dataPtr->subscribers.begin();
-    while (subIter != this->dataPtr->subscribers.end())
+    auto topicIter = this->dataPtr->subscribers.find(topic);
+    if (topicIter == this->dataPtr->subscribers.end())
+      continue;
+    for (auto const &sub : topicIter->second)
     {
-      if ((*subIter).second->GetId() == _connIter->second->GetId())
-      {
-        this->RemoveSubscriber((*subIter).first);
-        done = false;
-        break;
-      }
-      else
-        ++subIter;
+      if (sub.second->GetId() == id)
+        subs.push_back(sub.first);
     }
   }
+  for (auto const &sub : subs)
+    this->RemoveSubscriber(sub);
+  this->dataPtr->connectionSubscribers.erase(id);
 
   this->dataPtr->connections.erase(_connIter);
 }
@@ -499,58 +516,94 @@ void Master::RemoveConnection(Connection_M::iterator _connIter)
 /////////////////////////////////////////////////
 void Master::RemovePublisher(const msgs::Publish _pub)
 {
-  {
-    std::lock_guard<std::recursive_mutex> lock(this->dataPtr->connectionMutex);
-    Connection_M::iterator iter2;
-    for (iter2 = this->dataPtr->connections.begin();
-        iter2 != this->dataPtr->connections.end(); ++iter2)
-    {
-      iter2->second->EnqueueMsg(msgs::Package("publisher_del", _pub));
-    }
-  }
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->connectionMutex);
+
+  // The connections learn about the publisher before its removal
+  this->SendNewPublishers();
+  this->SendAll(msgs::Package("publisher_del", _pub));
 
   this->SendSubscribers(_pub.topic(), msgs::Package("unadvertise", _pub));
 
-  PubList::iterator pubIter = this->dataPtr->publishers.begin();
-  while (pubIter != this->dataPtr->publishers.end())
+  auto topicIter = this->dataPtr->publishers.find(_pub.topic());
+  if (topicIter == this->dataPtr->publishers.end())
+    return;
+
+  std::set<unsigned int> removed;
+  PubList &pubs = topicIter->second;
+  PubList::iterator pubIter = pubs.begin();
+  while (pubIter != pubs.end())
   {
-    if (pubIter->first.topic() == _pub.topic() &&
-        pubIter->first.host() == _pub.host() &&
+    if (pubIter->first.host() == _pub.host() &&
         pubIter->first.port() == _pub.port())
     {
-      pubIter = this->dataPtr->publishers.erase(pubIter);
+      removed.insert(pubIter->second->GetId());
+      pubIter = pubs.erase(pubIter);
     }
     else
       ++pubIter;
   }
+
+  // Update the topics of the connections that no longer advertise it
+  for (auto const &pub : pubs)
+    removed.erase(pub.second->GetId());
+  for (auto const &id : removed)
+  {
+    auto connIter = this->dataPtr->connectionPublishers.find(id);
+    if (connIter != this->dataPtr->connectionPublishers.end())
+      connIter->second.erase(_pub.topic());
+  }
+
+  if (pubs.empty())
+    this->dataPtr->publishers.erase(topicIter);
 }
 
 /////////////////////////////////////////////////
 void Master::RemoveSubscriber(const msgs::Subscribe _sub)
 {
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->connectionMutex);
+
   // Find all publishers of the topic, and remove the subscriptions
-  for (PubList::iterator iter = this->dataPtr->publishers.begin();
-      iter != this->dataPtr->publishers.end(); ++iter)
+  auto pubIter = this->dataPtr->publishers.find(_sub.topic());
+  if (pubIter != this->dataPtr->publishers.end())
   {
-    if (iter->first.topic() == _sub.topic())
-    {
-      iter->second->EnqueueMsg(msgs::Package("unsubscribe", _sub));
-    }
+    auto buffer = std::make_shared<const std::string>(
+        msgs::Package("unsubscribe", _sub));
+    for (auto const &pub : pubIter->second)
+      pub.second->EnqueueMsg(buffer, boost::function<void(uint32_t)>(), 0);
   }
 
+  auto topicIter = this->dataPtr->subscribers.find(_sub.topic());
+  if (topicIter == this->dataPtr->subscribers.end())
+    return;
+
   // Remove the subscribers from our list
-  SubList::iterator subiter = this->dataPtr->subscribers.begin();
-  while (subiter != this->dataPtr->subscribers.end())
+  std::set<unsigned int> removed;
+  SubList &subs = topicIter->second;
+  SubList::iterator subiter = subs.begin();
+  while (subiter != subs.end())
   {
-    if (subiter->first.topic() == _sub.topic() &&
-        subiter->first.host() == _sub.host() &&
+    if (subiter->first.host() == _sub.host() &&
         subiter->first.port() == _sub.port())
     {
-      subiter = this->dataPtr->subscribers.erase(subiter);
+      removed.insert(subiter->second->GetId());
+      subiter = subs.erase(subiter);
     }
     else
       ++subiter;
   }
+
+  // Update the topics of the connections that no longer subscribe to it
+  for (auto const &sub : subs)
+    removed.erase(sub.second->GetId());
+  for (auto const &id : removed)
+  {
+    auto connIter = this->dataPtr->connectionSubscribers.find(id);
+    if (connIter != this->dataPtr->connectionSubscribers.end())
+      connIter->second.erase(_sub.topic());
+  }
+
+  if (subs.empty())
+    this->dataPtr->subscribers.erase(topicIter);
 }
 
 //////////////////////////////////////////////////
@@ -583,6 +636,9 @@ void Master::Fini()
   this->dataPtr->connections.clear();
   this->dataPtr->subscribers.clear();
   this->dataPtr->publishers.clear();
+  this->dataPtr->connectionSubscribers.clear();
+  this->dataPtr->connectionPublishers.clear();
+  this->dataPtr->newPublishers.Clear();
 }
 
 //////////////////////////////////////////////////
@@ -590,18 +646,10 @@ msgs::Publish Master::GetPublisher(const std::string &_topic)
 {
   msgs::Publish msg;
 
-  PubList::iterator iter;
-
-  // Find all publishers of the topic
-  for (iter = this->dataPtr->publishers.begin();
-       iter != this->dataPtr->publishers.end(); ++iter)
-  {
-    if (iter->first.topic() == _topic)
-    {
-      msg = iter->first;
-      break;
-    }
-  }
+  // Find the first publisher of the topic
+  auto iter = this->dataPtr->publishers.find(_topic);
+  if (iter != this->dataPtr->publishers.end() && !iter->second.empty())
+    msg = iter->second.front().first;
 
   return msg;
 }
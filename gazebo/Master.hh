@@ -83,6 +83,15 @@ namespace gazebo
     private: void SendSubscribers(const std::string &_topic,
                                   const std::string &_buffer);
 
+    /// \brief Send a message to all the connections. The connections
+    /// share the data.
+    /// \param[in] _buffer Data to write
+    private: void SendAll(const std::string &_buffer);
+
+    /// \brief Tell all the connections about the publishers advertised
+    /// since the last call, in one message.
+    private: void SendNewPublishers();
+
     /// \brief Process a message
     /// \param[in] _connectionIndex Index of the connection which generated the
     /// message
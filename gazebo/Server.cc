@@ -24,7 +24,12 @@
 
 #include <stdio.h>
 #include <signal.h>
+#include <cstdint>
+#include <ctime>
+#include <fstream>
 #include <mutex>
+#include <set>
+#include <sstream>
 #include <boost/algorithm/string.hpp>
 #include <boost/filesystem.hpp>
 #include <boost/lexical_cast.hpp>
@@ -52,10 +57,14 @@
 #include "gazebo/util/LogPlay.hh"
 #include "gazebo/common/ModelDatabase.hh"
 #include "gazebo/common/Exception.hh"
+#include "gazebo/common/ThreadConfig.hh"
+#include "gazebo/common/Tracer.hh"
 #include "gazebo/common/Plugin.hh"
 #include "gazebo/common/CommonIface.hh"
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Events.hh"
+#include "gazebo/common/SystemPaths.hh"
+#include "gazebo/gazebo_config.h"
 
 #include "gazebo/msgs/msgs.hh"
 
@@ -99,6 +108,230 @@ namespace gazebo
               << "This can lead to an unexpected behaviour." << "\n";
     }
 
+    /// \brief Convert the value of a scenario parameter to a string.
+    /// \param[in] _value The value.
+    /// \return The value as a string, empty if its type is not supported.
+    static std::string ScenarioParam(const msgs::Any &_value)
+    {
+      std::ostringstream str;
+      switch (_value.type())
+      {
+        case msgs::Any::DOUBLE:
+          str << _value.double_value();
+          break;
+        case msgs::Any::INT32:
+          str << _value.int_value();
+          break;
+        case msgs::Any::STRING:
+          str << _value.string_value();
+          break;
+        case msgs::Any::BOOLEAN:
+          str << (_value.bool_value() ? "true" : "false");
+          break;
+        case msgs::Any::VECTOR3D:
+          str << msgs::ConvertIgn(_value.vector3d_value());
+          break;
+        case msgs::Any::POSE3D:
+          str << msgs::ConvertIgn(_value.pose3d_value());
+          break;
+        default:
+          gzwarn << "Unsupported scenario parameter type["
+                 << _value.type() << "]\n";
+          break;
+      }
+      return str.str();
+    }
+
+    /// \brief Restore the pristine state of the scenario world, and signal
+    /// the plugins to start a new scenario.
+    /// \param[in] _msg The request.
+    void ResetScenario(const msgs::ServerControl &_msg)
+    {
+      std::string worldName = this->scenarioWorld;
+      if (_msg.has_save_world_name() && !_msg.save_world_name().empty())
+        worldName = _msg.save_world_name();
+
+      physics::WorldPtr world;
+      if (this->scenarioWorld.empty())
+      {
+        gzerr << "Unable to reset the scenario, the server was not started "
+              << "with --scenario-server\n";
+      }
+      else if (worldName != this->scenarioWorld)
+      {
+        gzerr << "Unable to reset the scenario. Unknown world ["
+              << worldName << "]\n";
+      }
+      else if (physics::has_world(worldName))
+      {
+        world = physics::get_world(worldName);
+      }
+
+      bool success = false;
+      if (world)
+      {
+        common::StrStr_M params;
+        for (auto const &param : _msg.scenario_param())
+          params[param.name()] = ScenarioParam(param.value());
+
+        // keep the world from stepping while the plugins set up the new
+        // scenario
+        const bool paused = world->IsPaused();
+        world->SetPaused(true);
+        success = world->Restore(this->scenarioSnapshot);
+        if (success)
+          event::Events::scenarioReset(worldName, params);
+        world->SetPaused(paused);
+      }
+
+      msgs::WorldModify worldMsg;
+      worldMsg.set_world_name(worldName);
+      worldMsg.set_scenario_reset(success);
+      this->worldModPub->Publish(worldMsg);
+    }
+
+    /// \brief Get the path of the world cache entry of a world file, named
+    /// after a hash of the file and of everything else that changes how it
+    /// is resolved.
+    /// \param[in] _filename Path of the world file.
+    /// \return Path of the entry without extension, empty if the world file
+    /// could not be read.
+    boost::filesystem::path WorldCachePath(const std::string &_filename)
+    {
+      std::ifstream in(_filename, std::ios::binary);
+      if (!in)
+        return boost::filesystem::path();
+
+      std::stringstream key;
+      key << in.rdbuf() << '\n' << _filename
+          << '\n' << GAZEBO_VERSION_FULL << '\n' << SDF_VERSION;
+      for (auto const &env : {"GAZEBO_MODEL_PATH", "GAZEBO_RESOURCE_PATH",
+            "SDF_PATH", "IGN_FUEL_CACHE_PATH"})
+      {
+        const char *value = common::getEnv(env);
+        key << '\n' << (value ? value : "");
+      }
+      const std::string str = key.str();
+
+      return boost::filesystem::path(
+          common::SystemPaths::Instance()->GetLogPath()) /
+          "world_cache" / common::get_sha1<std::string>(str);
+    }
+
+    /// \brief Read a world from the world cache. The entry is used only if
+    /// none of the files the world was resolved from changed since it was
+    /// written.
+    /// \param[in] _filename Path of the world file.
+    /// \param[out] _sdf The resolved world.
+    /// \return True if the world was read from the cache.
+    bool ReadWorldCache(const std::string &_filename, sdf::SDFPtr _sdf)
+    {
+      const boost::filesystem::path path = this->WorldCachePath(_filename);
+      if (path.empty())
+        return false;
+
+      // First line: the original SDF version, then one line per file:
+      // <size> <modification time> <path>
+      std::ifstream deps(path.string() + ".deps");
+      std::string originalVersion;
+      if (!deps || !std::getline(deps, originalVersion))
+        return false;
+
+      std::string line;
+      while (std::getline(deps, line))
+      {
+        std::istringstream fields(line);
+        uintmax_t size;
+        std::time_t time;
+        std::string file;
+        if (!(fields >> size >> time) || !std::getline(fields >> std::ws, file))
+          return false;
+
+        boost::system::error_code ec;
+        if (boost::filesystem::file_size(file, ec) != size || ec ||
+            boost::filesystem::last_write_time(file, ec) != time || ec)
+        {
+          return false;
+        }
+      }
+
+      std::ifstream in(path.string() + ".sdf", std::ios::binary);
+      if (!in)
+        return false;
+      std::stringstream content;
+      content << in.rdbuf();
+
+      if (!sdf::readString(content.str(), _sdf))
+      {
+        gzwarn << "Unable to read the world cache entry[" << path.string()
+               << ".sdf], the world will be loaded from its file\n";
+        return false;
+      }
+      _sdf->Root()->SetOriginalVersion(originalVersion);
+      return true;
+    }
+
+    /// \brief Write a resolved world to the world cache. Relative URIs are
+    /// made absolute, in the world as well, since the cached world is read
+    /// back from a string.
+    /// \param[in] _filename Path of the world file.
+    /// \param[in] _sdf The world read from the file.
+    void WriteWorldCache(const std::string &_filename,
+        const sdf::SDFPtr &_sdf)
+    {
+      const boost::filesystem::path path = this->WorldCachePath(_filename);
+      if (path.empty())
+        return;
+
+      boost::system::error_code ec;
+      boost::filesystem::create_directories(path.parent_path(), ec);
+
+      // the world file and the files of the models it includes
+      std::set<std::string> files;
+      std::list<sdf::ElementPtr> elems = {_sdf->Root()};
+      while (!elems.empty())
+      {
+        sdf::ElementPtr elem = elems.front();
+        elems.pop_front();
+        if (boost::filesystem::is_regular_file(elem->FilePath(), ec))
+          files.insert(elem->FilePath());
+        for (sdf::ElementPtr child = elem->GetFirstElement(); child;
+             child = child->GetNextElement())
+        {
+          elems.push_back(child);
+        }
+      }
+
+      std::ostringstream deps;
+      deps << _sdf->Root()->OriginalVersion() << '\n';
+      for (auto const &file : files)
+      {
+        const uintmax_t size = boost::filesystem::file_size(file, ec);
+        if (ec)
+          return;
+        const std::time_t time = boost::filesystem::last_write_time(file, ec);
+        if (ec)
+          return;
+        deps << size << ' ' << time << ' ' << file << '\n';
+      }
+
+      // write the world before its dependencies: an entry is only valid
+      // once both are complete
+      std::ofstream out(path.string() + ".sdf", std::ios::binary);
+      common::convertToFullPaths(_sdf->Root());
+      out << _sdf->Root()->ToString("");
+      out.close();
+      std::ofstream depsOut(path.string() + ".deps");
+      depsOut << deps.str();
+      depsOut.close();
+      if (!out || !depsOut)
+      {
+        gzwarn << "Unable to write the world cache entry[" << path.string()
+               << "]\n";
+        boost::filesystem::remove(path.string() + ".deps", ec);
+      }
+    }
+
     /// \brief Boolean used to stop the server.
     static bool stop;
 
@@ -134,6 +367,16 @@ namespace gazebo
 
     /// \brief Set whether to lockstep physics and rendering
     bool lockstep = false;
+
+    /// \brief True to load worlds from the world cache, see --world-cache
+    bool worldCache = false;
+
+    /// \brief Name of the world restored for each new scenario, empty
+    /// unless started with --scenario-server.
+    std::string scenarioWorld;
+
+    /// \brief Handle of the snapshot of the pristine scenario world.
+    uint32_t scenarioSnapshot = 0;
   };
 }
 
@@ -184,26 +427,65 @@ bool Server::ParseArgs(int _argc, char **_argv)
     ("help,h", "Produce this help message.")
     ("pause,u", "Start the server in a paused state.")
     ("lockstep", "Lockstep simulation so sensor update rates are respected.")
+    ("lockstep-pipeline",
+     "Lockstep simulation with the rendering sensors one pose snapshot "
+     "behind physics, so that physics and rendering overlap.")
     ("physics,e", po::value<std::string>(),
      "Specify a physics engine (ode|bullet|dart|simbody).")
     ("play,p", po::value<std::string>(), "Play a log file.")
     ("record,r", "Record state data.")
     ("record_encoding", po::value<std::string>()->default_value("zlib"),
-     "Compression encoding format for log data (zlib|bz2|txt).")
+     "Compression encoding format for log data (zlib|bz2|zstd|lz4|txt).")
     ("record_path", po::value<std::string>()->default_value(""),
      "Absolute path in which to store state data")
     ("record_period", po::value<double>()->default_value(-1),
      "Recording period (seconds).")
     ("record_filter", po::value<std::string>()->default_value(""),
      "Recording filter (supports wildcard and regular expression).")
+    ("record_keyframe_period", po::value<double>()->default_value(0),
+     "Recording keyframe period (seconds). States in between keyframes only "
+     "have the models that changed.")
     ("record_resources", "Recording with model meshes and materials.")
+    ("record_queue", po::value<unsigned int>()->default_value(0),
+     "Number of states queued for recording, so that the simulation does "
+     "not wait for the recording thread.")
+    ("record_queue_block", "Wait for the recording thread when the "
+     "recording queue is full, instead of dropping states.")
+    ("record_topic", po::value<std::vector<std::string> >(),
+     "Record the messages of a topic with the state (may be repeated).")
     ("seed",  po::value<double>(), "Start with a given random number seed.")
     ("iters",  po::value<unsigned int>(), "Number of iterations to simulate.")
     ("minimal_comms", "Reduce the TCP/IP traffic output by gzserver")
     ("server-plugin,s", po::value<std::vector<std::string> >(),
      "Load a plugin.")
     ("profile,o", po::value<std::string>(),
-     "Physics preset profile name from the options in the world file.");
+     "Physics preset profile name from the options in the world file.")
+    ("sensor-threads", po::value<unsigned int>(),
+     "Number of threads that update the non-image sensors of each type "
+     "(0 for all the cores, default 1).")
+    ("batch-render",
+     "Let cameras with the same view share their culling and shadow maps.")
+    ("sensor-offload",
+     "Let sensor worker processes render the camera and other image "
+     "sensors, following the state of the world over ignition transport.")
+    ("sensor-worker", po::value<std::string>(),
+     "Render the image sensors of the world for a server started with "
+     "--sensor-offload, under the given worker name.")
+    ("render-device", po::value<std::string>(),
+     "Index of the GPU to render the sensors with off screen, or \"auto\" "
+     "to spread the servers of a node over its GPUs by master port. "
+     "Overrides the GAZEBO_RENDER_DEVICE environment variable.")
+    ("scenario-server",
+     "Keep the world loaded between scenarios: its state before the first "
+     "step is restored on each reset_scenario server control request, "
+     "instead of starting a new server.")
+    ("world-cache",
+     "Cache the resolved world in ~/.gazebo/world_cache, so that the next "
+     "start with the same files skips parsing the world and its included "
+     "models.")
+    ("threads", po::value<std::string>(),
+     "Pin the threads to CPUs, e.g. \"world=2:numa;sensors=4-7;*=8-15\". "
+     "Overrides the GAZEBO_THREADS environment variable.");
 
   po::options_description hiddenDesc("Hidden options");
   hiddenDesc.add_options()
@@ -260,11 +542,33 @@ bool Server::ParseArgs(int _argc, char **_argv)
     gazebo::common::Console::SetQuiet(false);
   }
 
+  // Keep the simulation threads from waiting on the terminal, and from
+  // flooding it with the same message every step
+  gazebo::common::Console::SetAsync(true);
+  gazebo::common::Console::SetDeduplicate(true);
+
+  this->dataPtr->worldCache = this->dataPtr->vm.count("world-cache") > 0;
+
   if (this->dataPtr->vm.count("minimal_comms"))
     gazebo::transport::setMinimalComms(true);
   else
     gazebo::transport::setMinimalComms(false);
 
+  // Place the threads before any is started. The memory of the world is
+  // allocated by this thread, on the NUMA node of the world thread.
+  {
+    std::string threads;
+    if (this->dataPtr->vm.count("threads"))
+      threads = this->dataPtr->vm["threads"].as<std::string>();
+    else if (const char *env = common::getEnv("GAZEBO_THREADS"))
+      threads = env;
+
+    if (!common::ThreadConfig::Instance()->Load(threads))
+      return false;
+    common::ThreadConfig::Instance()->Apply("gzserver");
+    common::ThreadConfig::Instance()->PlaceMemory("world");
+  }
+
   // Set the random number seed if present on the command line.
   if (this->dataPtr->vm.count("seed"))
   {
@@ -321,8 +625,27 @@ bool Server::ParseArgs(int _argc, char **_argv)
   {
     this->dataPtr->lockstep = true;
   }
+  if (this->dataPtr->vm.count("lockstep-pipeline"))
+  {
+    this->dataPtr->lockstep = true;
+    rendering::set_lockstep_pipelined(true);
+  }
   rendering::set_lockstep_enabled(this->dataPtr->lockstep);
 
+  if (this->dataPtr->vm.count("render-device"))
+  {
+    rendering::set_render_device(
+        this->dataPtr->vm["render-device"].as<std::string>());
+  }
+
+  if (this->dataPtr->vm.count("sensor-offload"))
+    sensors::set_offload_primary(true);
+  if (this->dataPtr->vm.count("sensor-worker"))
+  {
+    sensors::set_offload_worker(
+        this->dataPtr->vm["sensor-worker"].as<std::string>());
+  }
+
   if (!this->PreLoad())
   {
     gzerr << "Unable to load gazebo\n";
@@ -451,6 +774,7 @@ bool Server::LoadFile(const std::string &_filename,
         if (fileExtension == "sdf" || fileExtension == "world")
         {
           filename = current.c_str();
+          common::ModelDatabase::Instance()->PrefetchFile(filename);
           if (!sdf::readFile(filename, sdf))
           {
             gzerr << "Unable to read SDF from URL[" << filename << "]\n";
@@ -474,12 +798,27 @@ bool Server::LoadFile(const std::string &_filename,
     }
     fclose(test);
 
+    if (this->dataPtr->worldCache &&
+        this->dataPtr->ReadWorldCache(foundFile, sdf))
+    {
+      gzmsg << "Loading world file [" << foundFile << "] from the world "
+            << "cache" << std::endl;
+      return this->LoadImpl(sdf->Root(), _physics);
+    }
+
+    // Download the included models concurrently, instead of one after the
+    // other while the includes are parsed.
+    common::ModelDatabase::Instance()->PrefetchFile(foundFile);
+
     if (!sdf::readFile(foundFile, sdf))
     {
       gzerr << "Unable to read sdf file[" << filename << "]\n";
       return false;
     }
 
+    if (this->dataPtr->worldCache)
+      this->dataPtr->WriteWorldCache(foundFile, sdf);
+
     gzmsg << "Loading world file [" << foundFile << "]" << std::endl;
   }
   
@@ -557,6 +896,12 @@ bool Server::LoadImpl(sdf::ElementPtr _elem,
     {
       gzthrow("Failed to load the World\n"  << e);
     }
+
+    // The state is published to, or followed from, other processes
+    if (this->dataPtr->vm.count("sensor-offload"))
+      world->SetSensorOffloadEnabled(true);
+    if (this->dataPtr->vm.count("sensor-worker"))
+      world->SetSensorOffloadFollower(true);
   }
 
   this->dataPtr->node = transport::NodePtr(new transport::Node());
@@ -651,6 +996,13 @@ void Server::Run()
   sensors::run_once(true);
 
   // Run the sensor threads
+  if (this->dataPtr->vm.count("sensor-threads"))
+  {
+    sensors::set_worker_threads(
+        this->dataPtr->vm["sensor-threads"].as<unsigned int>());
+  }
+  if (this->dataPtr->vm.count("batch-render"))
+    sensors::set_batch_render(true);
   sensors::run_threads();
 
   unsigned int iterations = 0;
@@ -669,17 +1021,28 @@ void Server::Run()
     }
   }
 
+  // Keep the pristine state of the world, restored for each new scenario
+  if (this->dataPtr->vm.count("scenario-server") && physics::has_world(""))
+  {
+    physics::WorldPtr world = physics::get_world();
+    this->dataPtr->scenarioWorld = world->Name();
+    this->dataPtr->scenarioSnapshot = world->Snapshot();
+    gzmsg << "Serving scenarios of world [" << world->Name() << "]\n";
+  }
+
   // Run each world. Each world starts a new thread
   physics::run_worlds(iterations);
 
   this->dataPtr->initialized = true;
 
   IGN_PROFILE_THREAD_NAME("gzserver");
+  common::Tracer::Instance()->SetThreadName("gzserver");
   // Stay on this loop until Gazebo needs to be shut down
   // The server and sensor manager outlive worlds
   while (!this->dataPtr->stop)
   {
     IGN_PROFILE("Server::Run");
+    GZ_TRACE_SCOPE("Server::Run");
     IGN_PROFILE_BEGIN("ProcessControlMsgs");
     if (this->dataPtr->lockstep)
       rendering::wait_for_render_request("", 0.100);
@@ -729,8 +1092,19 @@ void Server::ProcessParams()
       params.path = iter->second;
       params.period = this->dataPtr->vm["record_period"].as<double>();
       params.filter = this->dataPtr->vm["record_filter"].as<std::string>();
+      params.keyframePeriod =
+          this->dataPtr->vm["record_keyframe_period"].as<double>();
       params.recordResources =
           this->dataPtr->params.count("record_resources") > 0;
+      params.queueSize =
+          this->dataPtr->vm["record_queue"].as<unsigned int>();
+      params.dropOnOverflow =
+          this->dataPtr->vm.count("record_queue_block") == 0;
+      if (this->dataPtr->vm.count("record_topic"))
+      {
+        params.topics = this->dataPtr->vm["record_topic"].as<
+            std::vector<std::string> >();
+      }
       util::LogRecord::Instance()->Start(params);
     }
   }
@@ -835,6 +1209,10 @@ void Server::ProcessControlMsgs()
         worldMsg.set_cloned_uri("http://" + host + ":" + port);
       this->dataPtr->worldModPub->Publish(worldMsg);
     }
+    else if ((*iter).has_reset_scenario() && (*iter).reset_scenario())
+    {
+      this->dataPtr->ResetScenario(*iter);
+    }
     else if ((*iter).has_save_world_name())
     {
       // Get the world pointer.
@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cstdlib>
+#include <new>
+
+#include "gazebo/gazebo_config.h"
+#include "gazebo/common/AllocationCounter.hh"
+
+using namespace gazebo;
+using namespace common;
+
+#ifdef HAVE_ALLOCATION_COUNTING
+/// \brief Allocations of each thread. Plain data, so that it is usable
+/// from operator new before and after the other thread locals.
+static thread_local AllocationCount g_threadAllocations;
+
+/////////////////////////////////////////////////
+/// \brief Count an allocation and allocate it.
+/// \param[in] _size Size of the allocation.
+/// \return The memory.
+static void *CountedAllocate(std::size_t _size)
+{
+  ++g_threadAllocations.count;
+  g_threadAllocations.bytes += _size;
+
+  if (_size == 0)
+    _size = 1;
+  while (true)
+  {
+    void *ptr = std::malloc(_size);
+    if (ptr)
+      return ptr;
+
+    std::new_handler handler = std::get_new_handler();
+    if (!handler)
+      throw std::bad_alloc();
+    handler();
+  }
+}
+
+/////////////////////////////////////////////////
+void *operator new(std::size_t _size)
+{
+  return CountedAllocate(_size);
+}
+
+/////////////////////////////////////////////////
+void *operator new[](std::size_t _size)
+{
+  return CountedAllocate(_size);
+}
+
+/////////////////////////////////////////////////
+void *operator new(std::size_t _size, const std::nothrow_t &) noexcept
+{
+  try
+  {
+    return CountedAllocate(_size);
+  }
+  catch(...)
+  {
+    return nullptr;
+  }
+}
+
+/////////////////////////////////////////////////
+void *operator new[](std::size_t _size, const std::nothrow_t &) noexcept
+{
+  try
+  {
+    return CountedAllocate(_size);
+  }
+  catch(...)
+  {
+    return nullptr;
+  }
+}
+
+/////////////////////////////////////////////////
+void operator delete(void *_ptr) noexcept
+{
+  std::free(_ptr);
+}
+
+/////////////////////////////////////////////////
+void operator delete[](void *_ptr) noexcept
+{
+  std::free(_ptr);
+}
+
+/////////////////////////////////////////////////
+void operator delete(void *_ptr, std::size_t) noexcept
+{
+  std::free(_ptr);
+}
+
+/////////////////////////////////////////////////
+void operator delete[](void *_ptr, std::size_t) noexcept
+{
+  std::free(_ptr);
+}
+
+/////////////////////////////////////////////////
+void operator delete(void *_ptr, const std::nothrow_t &) noexcept
+{
+  std::free(_ptr);
+}
+
+/////////////////////////////////////////////////
+void operator delete[](void *_ptr, const std::nothrow_t &) noexcept
+{
+  std::free(_ptr);
+}
+#endif
+
+/////////////////////////////////////////////////
+bool AllocationCounter::Available()
+{
+#ifdef HAVE_ALLOCATION_COUNTING
+  return true;
+#else
+  return false;
+#endif
+}
+
+/////////////////////////////////////////////////
+AllocationCount AllocationCounter::Thread()
+{
+#ifdef HAVE_ALLOCATION_COUNTING
+  return g_threadAllocations;
+#else
+  return AllocationCount();
+#endif
+}
@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_COMMON_ALLOCATIONCOUNTER_HH_
+#define GAZEBO_COMMON_ALLOCATIONCOUNTER_HH_
+
+#include <cstdint>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace common
+  {
+    /// \addtogroup gazebo_common
+    /// \{
+
+    /// \class AllocationCount AllocationCounter.hh common/common.hh
+    /// \brief Number and total size of heap allocations.
+    class GZ_COMMON_VISIBLE AllocationCount
+    {
+      /// \brief Get the allocations made since an earlier count.
+      /// \param[in] _earlier The earlier count.
+      /// \return The difference of the counts.
+      public: AllocationCount operator-(const AllocationCount &_earlier) const
+              {
+                AllocationCount result;
+                result.count = this->count - _earlier.count;
+                result.bytes = this->bytes - _earlier.bytes;
+                return result;
+              }
+
+      /// \brief Add allocations to the count.
+      /// \param[in] _other The allocations.
+      /// \return This count.
+      public: AllocationCount &operator+=(const AllocationCount &_other)
+              {
+                this->count += _other.count;
+                this->bytes += _other.bytes;
+                return *this;
+              }
+
+      /// \brief Number of allocations.
+      public: uint64_t count = 0;
+
+      /// \brief Total size of the allocations, in bytes.
+      public: uint64_t bytes = 0;
+    };
+
+    /// \class AllocationCounter AllocationCounter.hh common/common.hh
+    /// \brief Counts the allocations of operator new made by each thread,
+    /// so that the tracer spans, the cost counters and the phases of the
+    /// world steps can report the allocations made while they ran.
+    ///
+    /// Counting is a build option, ENABLE_ALLOCATION_COUNTING, because it
+    /// replaces the global operator new and delete of the programs linked
+    /// to gazebo_common. The replacements allocate with malloc and add two
+    /// thread local increments. Without the option the counts stay zero.
+    class GZ_COMMON_VISIBLE AllocationCounter
+    {
+      /// \brief Check whether the allocations are counted.
+      /// \return True if gazebo was built with ENABLE_ALLOCATION_COUNTING.
+      public: static bool Available();
+
+      /// \brief Get the allocations made by the calling thread since it
+      /// started. Allocations are attributed by taking the difference of
+      /// two counts.
+      /// \return The allocations of the thread.
+      public: static AllocationCount Thread();
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "gazebo/common/AllocationCounter.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class AllocationCounterTest : public gazebo::testing::AutoLogFixture { };
+
+/// \brief Keeps the test allocations from being optimized out.
+static void *volatile g_sink = nullptr;
+
+/////////////////////////////////////////////////
+TEST_F(AllocationCounterTest, Count)
+{
+  const common::AllocationCount start = common::AllocationCounter::Thread();
+  std::unique_ptr<int> value(new int(3));
+  std::unique_ptr<char[]> buffer(new char[100]);
+  g_sink = value.get();
+  g_sink = buffer.get();
+  const common::AllocationCount made =
+    common::AllocationCounter::Thread() - start;
+
+  if (!common::AllocationCounter::Available())
+  {
+    EXPECT_EQ(0u, made.count);
+    EXPECT_EQ(0u, made.bytes);
+    return;
+  }
+  EXPECT_EQ(2u, made.count);
+  EXPECT_EQ(sizeof(int) + 100u, made.bytes);
+
+  // Freeing memory isn't an allocation
+  value.reset();
+  buffer.reset();
+  EXPECT_EQ(2u, (common::AllocationCounter::Thread() - start).count);
+
+  common::AllocationCount total;
+  total += made;
+  total += made;
+  EXPECT_EQ(4u, total.count);
+}
+
+/////////////////////////////////////////////////
+TEST_F(AllocationCounterTest, Threads)
+{
+  const common::AllocationCount start = common::AllocationCounter::Thread();
+
+  // The allocations of another thread aren't counted in this one
+  uint64_t otherCount = 0;
+  std::thread thread([&otherCount]()
+      {
+        const common::AllocationCount otherStart =
+          common::AllocationCounter::Thread();
+        std::vector<double> values(1000);
+        g_sink = values.data();
+        otherCount = (common::AllocationCounter::Thread() - otherStart).count;
+      });
+  thread.join();
+
+  if (common::AllocationCounter::Available())
+  {
+    EXPECT_EQ(1u, otherCount);
+  }
+
+  // Creating the thread may allocate in this one, but the vector of the
+  // other thread isn't counted here
+  const common::AllocationCount made =
+    common::AllocationCounter::Thread() - start;
+  EXPECT_LT(made.bytes, 1000 * sizeof(double));
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
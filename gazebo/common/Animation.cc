@@ -135,6 +135,42 @@ double Animation::GetKeyFramesAtTime(double _time, KeyFrame **_kf1,
   while (_time > this->length && this->length > 0.0)
     _time -= this->length;
 
+  // Times usually move forward in small steps, so check the segment found
+  // last and the one after it before searching.
+  const unsigned int count = this->keyFrames.size();
+  for (unsigned int i = this->keyIndex;
+       i < count && i <= this->keyIndex + 1; ++i)
+  {
+    if (this->keyFrames[i]->GetTime() >= _time)
+      break;
+
+    // A key frame exactly at the time is left to the search below
+    if (i + 1 < count && this->keyFrames[i + 1]->GetTime() <= _time)
+      continue;
+
+    _firstKeyIndex = i;
+    this->keyIndex = i;
+    *_kf1 = this->keyFrames[i];
+    t1 = (*_kf1)->GetTime();
+
+    if (i + 1 < count)
+    {
+      *_kf2 = this->keyFrames[i + 1];
+      t2 = (*_kf2)->GetTime();
+    }
+    else
+    {
+      // Wrap back to the first keyframe
+      *_kf2 = this->keyFrames.front();
+      t2 = this->length + (*_kf2)->GetTime();
+    }
+
+    if (ignition::math::equal(t1, t2))
+      return 0.0;
+    else
+      return (_time - t1) / (t2 - t1);
+  }
+
   KeyFrame_V::const_iterator iter;
   KeyFrame timeKey(_time);
   iter = std::lower_bound(this->keyFrames.begin(), this->keyFrames.end(),
@@ -160,6 +196,7 @@ double Animation::GetKeyFramesAtTime(double _time, KeyFrame **_kf1,
   }
 
   _firstKeyIndex = std::distance(this->keyFrames.begin(), iter);
+  this->keyIndex = _firstKeyIndex;
 
   *_kf1 = *iter;
   t1 = (*_kf1)->GetTime();
@@ -227,6 +264,32 @@ void PoseAnimation::BuildInterpolationSplines() const
 
   this->positionSpline->RecalcTangents();
   this->rotationSpline->RecalcTangents();
+
+  // Expand the Hermite form of each segment into the coefficients of
+  // a * t^3 + b * t^2 + c * t + d. The segment after the last key frame
+  // stays at the last key frame, like Spline::Interpolate.
+  const unsigned int count = this->positionSpline->PointCount();
+  this->positionCoefficients.resize(count * 4);
+  for (unsigned int i = 0; i < count; ++i)
+  {
+    ignition::math::Vector3d *coeffs = &this->positionCoefficients[i * 4];
+    const ignition::math::Vector3d p0 = this->positionSpline->Point(i);
+    if (i + 1 == count)
+    {
+      coeffs[0] = coeffs[1] = coeffs[2] = ignition::math::Vector3d::Zero;
+      coeffs[3] = p0;
+      continue;
+    }
+
+    const ignition::math::Vector3d p1 = this->positionSpline->Point(i + 1);
+    const ignition::math::Vector3d m0 = this->positionSpline->Tangent(i);
+    const ignition::math::Vector3d m1 = this->positionSpline->Tangent(i + 1);
+    coeffs[0] = p0 * 2.0 - p1 * 2.0 + m0 + m1;
+    coeffs[1] = p1 * 3.0 - p0 * 3.0 - m0 * 2.0 - m1;
+    coeffs[2] = m0;
+    coeffs[3] = p0;
+  }
+
   this->build = false;
 }
 
@@ -258,11 +321,29 @@ void PoseAnimation::GetInterpolatedKeyFrame(double _time,
   }
   else
   {
-    _kf.Translation(this->positionSpline->Interpolate(firstKeyIndex, t));
+    const ignition::math::Vector3d *coeffs =
+        &this->positionCoefficients[firstKeyIndex * 4];
+    _kf.Translation(((coeffs[0] * t + coeffs[1]) * t + coeffs[2]) * t +
+        coeffs[3]);
     _kf.Rotation(this->rotationSpline->Interpolate(firstKeyIndex, t));
   }
 }
 
+/////////////////////////////////////////////////
+void PoseAnimation::InterpolatedPoses(
+    const std::vector<const PoseAnimation *> &_animations,
+    std::vector<ignition::math::Pose3d> &_poses)
+{
+  _poses.resize(_animations.size());
+
+  PoseKeyFrame kf(0);
+  for (size_t i = 0; i < _animations.size(); ++i)
+  {
+    _animations[i]->GetInterpolatedKeyFrame(kf);
+    _poses[i].Set(kf.Translation(), kf.Rotation());
+  }
+}
+
 /////////////////////////////////////////////////
 NumericAnimation::NumericAnimation(const std::string &_name,
     double _length, bool _loop)
@@ -315,3 +396,18 @@ void NumericAnimation::GetInterpolatedKeyFrame(NumericKeyFrame &_kf) const
     _kf.SetValue(k1->GetValue() + diff * t);
   }
 }
+
+/////////////////////////////////////////////////
+void NumericAnimation::InterpolatedValues(
+    const std::vector<const NumericAnimation *> &_animations,
+    std::vector<double> &_values)
+{
+  _values.resize(_animations.size());
+
+  NumericKeyFrame kf(0);
+  for (size_t i = 0; i < _animations.size(); ++i)
+  {
+    _animations[i]->GetInterpolatedKeyFrame(kf);
+    _values[i] = kf.GetValue();
+  }
+}
@@ -19,6 +19,7 @@
 
 #include <string>
 #include <vector>
+#include <ignition/math/Pose3.hh>
 #include <ignition/math/Spline.hh>
 #include <ignition/math/RotationSpline.hh>
 #include "gazebo/util/system.hh"
@@ -80,7 +81,10 @@ namespace gazebo
       /// \return A pointer the keyframe, nullptr if the _index is invalid
       public: KeyFrame* GetKeyFrame(unsigned int _index) const;
 
-      /// \brief Get the two key frames that bound a time value
+      /// \brief Get the two key frames that bound a time value. The segment
+      /// found last is checked first, so that times moving forward find
+      /// their key frames in constant time, before falling back to a binary
+      /// search.
       /// \param[in] _time The time in seconds
       /// \param[out] _kf1 Lower bound keyframe that is returned
       /// \param[out] _kf2 Upper bound keyframe that is returned
@@ -111,6 +115,10 @@ namespace gazebo
 
       /// \brief array of key frames
       protected: KeyFrame_V keyFrames;
+
+      /// \brief Index of the lower bound key frame found last by
+      /// GetKeyFramesAtTime.
+      private: mutable unsigned int keyIndex = 0;
     };
     /// \}
 
@@ -139,6 +147,14 @@ namespace gazebo
       /// \param[out] _kf PoseKeyFrame reference to hold the interpolated result
       public: void GetInterpolatedKeyFrame(PoseKeyFrame &_kf) const;
 
+      /// \brief Get the interpolated poses of several animations at their
+      /// current times.
+      /// \param[in] _animations The animations.
+      /// \param[out] _poses The pose of each animation, in the same order.
+      public: static void InterpolatedPoses(
+                  const std::vector<const PoseAnimation *> &_animations,
+                  std::vector<ignition::math::Pose3d> &_poses);
+
       /// \brief Get a keyframe using a passed in time.
       /// \param[in] _time Time in seconds
       /// \param[out] _kf PoseKeyFrame reference to hold the interpolated result
@@ -154,6 +170,12 @@ namespace gazebo
       /// \brief smooth interpolation for rotation
       private: mutable ignition::math::RotationSpline *rotationSpline;
 
+      /// \brief Cubic coefficients of each segment of the position spline,
+      /// four per key frame, so that interpolating a position does not
+      /// evaluate the Hermite basis.
+      private: mutable std::vector<ignition::math::Vector3d>
+                   positionCoefficients;
+
       /// \brief Spline tension parameter.
       private: double tension = 0.0;
     };
@@ -184,6 +206,14 @@ namespace gazebo
       /// \param[out] _kf NumericKeyFrame reference to hold the
       /// interpolated result
       public: void GetInterpolatedKeyFrame(NumericKeyFrame &_kf) const;
+
+      /// \brief Get the interpolated values of several animations at their
+      /// current times.
+      /// \param[in] _animations The animations.
+      /// \param[out] _values The value of each animation, in the same order.
+      public: static void InterpolatedValues(
+                  const std::vector<const NumericAnimation *> &_animations,
+                  std::vector<double> &_values);
     };
     /// \}
   }
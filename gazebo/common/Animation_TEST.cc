@@ -16,6 +16,9 @@
 */
 
 #include <gtest/gtest.h>
+#include <cmath>
+#include <memory>
+#include <vector>
 
 #include <ignition/math/Quaternion.hh>
 #include <ignition/math/Vector3.hh>
@@ -103,6 +106,97 @@ TEST_F(AnimationTest, NumericAnimation)
   EXPECT_DOUBLE_EQ(12, interpolatedKey.GetValue());
 }
 
+/////////////////////////////////////////////////
+TEST_F(AnimationTest, NumericAnimationSteps)
+{
+  common::NumericAnimation anim("numeric_test", 100, false);
+  for (int i = 0; i <= 100; ++i)
+    anim.CreateKeyFrame(i)->SetValue(i * i);
+
+  auto expected = [](const double _time)
+  {
+    const double i = std::floor(_time);
+    return i * i + (2 * i + 1) * (_time - i);
+  };
+
+  common::NumericKeyFrame interpolatedKey(0);
+
+  // Step forward, then backward, then jump around
+  for (double time = 0; time <= 100; time += 0.25)
+  {
+    anim.SetTime(time);
+    anim.GetInterpolatedKeyFrame(interpolatedKey);
+    EXPECT_NEAR(expected(time), interpolatedKey.GetValue(), 1e-6);
+  }
+  for (double time = 100; time >= 0; time -= 0.75)
+  {
+    anim.SetTime(time);
+    anim.GetInterpolatedKeyFrame(interpolatedKey);
+    EXPECT_NEAR(expected(time), interpolatedKey.GetValue(), 1e-6);
+  }
+  for (double time : {90.5, 3.0, 3.5, 57.25, 0.0, 99.9})
+  {
+    anim.SetTime(time);
+    anim.GetInterpolatedKeyFrame(interpolatedKey);
+    EXPECT_NEAR(expected(time), interpolatedKey.GetValue(), 1e-6);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(AnimationTest, InterpolatedValues)
+{
+  common::NumericAnimation anim1("numeric_test1", 10, false);
+  anim1.CreateKeyFrame(0.0)->SetValue(0.0);
+  anim1.CreateKeyFrame(10.0)->SetValue(30.0);
+  anim1.SetTime(4.0);
+
+  common::NumericAnimation anim2("numeric_test2", 2, false);
+  anim2.CreateKeyFrame(0.0)->SetValue(1.0);
+  anim2.CreateKeyFrame(2.0)->SetValue(-1.0);
+  anim2.SetTime(1.5);
+
+  std::vector<double> values;
+  common::NumericAnimation::InterpolatedValues({&anim1, &anim2}, values);
+  ASSERT_EQ(2u, values.size());
+  EXPECT_DOUBLE_EQ(12.0, values[0]);
+  EXPECT_DOUBLE_EQ(-0.5, values[1]);
+}
+
+/////////////////////////////////////////////////
+TEST_F(AnimationTest, InterpolatedPoses)
+{
+  std::vector<std::unique_ptr<common::PoseAnimation>> anims;
+  std::vector<const common::PoseAnimation *> animPtrs;
+  for (int i = 0; i < 3; ++i)
+  {
+    anims.emplace_back(new common::PoseAnimation("pose_test", 10.0, false));
+    for (int k = 0; k <= 10; ++k)
+    {
+      common::PoseKeyFrame *key = anims.back()->CreateKeyFrame(k);
+      key->Translation(ignition::math::Vector3d(k, i * k * k, -k));
+      key->Rotation(ignition::math::Quaterniond(0, 0, 0.1 * k * i));
+    }
+    anims.back()->SetTime(1.3 + i * 2.9);
+    animPtrs.push_back(anims.back().get());
+  }
+
+  std::vector<ignition::math::Pose3d> poses;
+  common::PoseAnimation::InterpolatedPoses(animPtrs, poses);
+  ASSERT_EQ(anims.size(), poses.size());
+
+  for (size_t i = 0; i < anims.size(); ++i)
+  {
+    common::PoseKeyFrame interpolatedKey(0);
+    anims[i]->GetInterpolatedKeyFrame(interpolatedKey);
+    EXPECT_EQ(interpolatedKey.Translation(), poses[i].Pos());
+    EXPECT_EQ(interpolatedKey.Rotation(), poses[i].Rot());
+
+    // Straight motion in x stays straight
+    const double time = anims[i]->GetTime();
+    EXPECT_NEAR(time, poses[i].Pos().X(), 1e-6);
+  }
+}
+
 
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
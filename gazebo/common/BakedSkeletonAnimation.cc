@@ -0,0 +1,249 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+
+#include <ignition/math/Helpers.hh>
+#include <ignition/math/Quaternion.hh>
+#include <ignition/math/Vector3.hh>
+
+#include "gazebo/common/BakedSkeletonAnimation.hh"
+#include "gazebo/common/SkeletonAnimation.hh"
+
+namespace gazebo
+{
+  namespace common
+  {
+    /// \internal
+    /// \brief Private data for BakedSkeletonAnimation.
+    class BakedSkeletonAnimationPrivate
+    {
+      /// \brief Get the sample at or before a time.
+      /// \param[in] _time Time within the animation.
+      /// \param[out] _alpha Fraction of the way to the next sample.
+      /// \return Index of the sample.
+      public: unsigned int Sample(const double _time, double &_alpha) const;
+
+      /// \brief Number of nodes.
+      public: unsigned int nodeCount = 0;
+
+      /// \brief Numbers of the animated nodes.
+      public: std::vector<unsigned int> animated;
+
+      /// \brief Whether each node is animated.
+      public: std::vector<bool> hasNode;
+
+      /// \brief Sample times, ascending.
+      public: std::vector<double> times;
+
+      /// \brief Node positions, nodeCount per sample.
+      public: std::vector<ignition::math::Vector3d> positions;
+
+      /// \brief Node rotations, nodeCount per sample.
+      public: std::vector<ignition::math::Quaterniond> rotations;
+
+      /// \brief Length of the animation.
+      public: double length = 0;
+    };
+  }
+}
+
+using namespace gazebo;
+using namespace common;
+
+//////////////////////////////////////////////////
+unsigned int BakedSkeletonAnimationPrivate::Sample(const double _time,
+    double &_alpha) const
+{
+  _alpha = 0;
+  auto next = std::upper_bound(this->times.begin(), this->times.end(),
+      _time);
+  if (next == this->times.begin())
+    return 0;
+  if (next == this->times.end())
+    return static_cast<unsigned int>(this->times.size() - 1);
+
+  auto prev = next - 1;
+  _alpha = (_time - *prev) / (*next - *prev);
+  return static_cast<unsigned int>(prev - this->times.begin());
+}
+
+//////////////////////////////////////////////////
+BakedSkeletonAnimation::BakedSkeletonAnimation(
+    const SkeletonAnimation &_anim, const std::vector<std::string> &_nodes,
+    const double _rate)
+: dataPtr(new BakedSkeletonAnimationPrivate)
+{
+  this->dataPtr->nodeCount = static_cast<unsigned int>(_nodes.size());
+  this->dataPtr->hasNode.assign(_nodes.size(), false);
+  for (unsigned int i = 0; i < _nodes.size(); ++i)
+  {
+    if (_anim.HasNode(_nodes[i]))
+    {
+      this->dataPtr->hasNode[i] = true;
+      this->dataPtr->animated.push_back(i);
+    }
+  }
+
+  this->dataPtr->length = std::max(0.0, _anim.GetLength());
+  const double rate = std::max(_rate, 1.0);
+  const unsigned int intervals = std::max(1u,
+      static_cast<unsigned int>(std::ceil(this->dataPtr->length * rate)));
+  for (unsigned int k = 0; k <= intervals; ++k)
+  {
+    this->dataPtr->times.push_back(
+        std::min(k / rate, this->dataPtr->length));
+  }
+
+  const size_t count = this->dataPtr->times.size() * _nodes.size();
+  this->dataPtr->positions.resize(count);
+  this->dataPtr->rotations.resize(count);
+  for (size_t k = 0; k < this->dataPtr->times.size(); ++k)
+  {
+    const std::map<std::string, ignition::math::Matrix4d> pose =
+      _anim.PoseAt(this->dataPtr->times[k]);
+    for (auto i : this->dataPtr->animated)
+    {
+      auto iter = pose.find(_nodes[i]);
+      if (iter == pose.end())
+        continue;
+      this->dataPtr->positions[k * _nodes.size() + i] =
+        iter->second.Translation();
+      this->dataPtr->rotations[k * _nodes.size() + i] =
+        iter->second.Rotation();
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+BakedSkeletonAnimation::~BakedSkeletonAnimation()
+{
+}
+
+//////////////////////////////////////////////////
+unsigned int BakedSkeletonAnimation::NodeCount() const
+{
+  return this->dataPtr->nodeCount;
+}
+
+//////////////////////////////////////////////////
+bool BakedSkeletonAnimation::HasNode(const unsigned int _node) const
+{
+  return _node < this->dataPtr->nodeCount && this->dataPtr->hasNode[_node];
+}
+
+//////////////////////////////////////////////////
+unsigned int BakedSkeletonAnimation::SampleCount() const
+{
+  return static_cast<unsigned int>(this->dataPtr->times.size());
+}
+
+//////////////////////////////////////////////////
+double BakedSkeletonAnimation::Length() const
+{
+  return this->dataPtr->length;
+}
+
+//////////////////////////////////////////////////
+void BakedSkeletonAnimation::PoseAt(const double _time,
+    std::vector<ignition::math::Matrix4d> &_pose, const bool _loop) const
+{
+  const double length = this->dataPtr->length;
+  double time = std::max(0.0, _time);
+  if (time > length)
+  {
+    if (_loop && length > 0)
+      time = std::fmod(time, length);
+    else
+      time = length;
+  }
+
+  double alpha;
+  const unsigned int k = this->dataPtr->Sample(time, alpha);
+  const unsigned int n = this->dataPtr->nodeCount;
+  const ignition::math::Vector3d *pos0 = &this->dataPtr->positions[k * n];
+  const ignition::math::Quaterniond *rot0 = &this->dataPtr->rotations[k * n];
+
+  _pose.resize(n, ignition::math::Matrix4d::Identity);
+  if (alpha <= 0)
+  {
+    for (auto i : this->dataPtr->animated)
+    {
+      _pose[i] = ignition::math::Matrix4d(rot0[i]);
+      _pose[i].SetTranslation(pos0[i]);
+    }
+    return;
+  }
+
+  const ignition::math::Vector3d *pos1 = pos0 + n;
+  const ignition::math::Quaterniond *rot1 = rot0 + n;
+  for (auto i : this->dataPtr->animated)
+  {
+    _pose[i] = ignition::math::Matrix4d(ignition::math::Quaterniond::Slerp(
+          alpha, rot0[i], rot1[i], true));
+    _pose[i].SetTranslation(pos0[i] + (pos1[i] - pos0[i]) * alpha);
+  }
+}
+
+//////////////////////////////////////////////////
+void BakedSkeletonAnimation::PoseAtX(const double _x,
+    const unsigned int _node, std::vector<ignition::math::Matrix4d> &_pose,
+    const bool _loop) const
+{
+  if (!this->HasNode(_node))
+  {
+    this->PoseAt(0, _pose, _loop);
+    return;
+  }
+
+  const unsigned int n = this->dataPtr->nodeCount;
+  const size_t last = this->dataPtr->times.size() - 1;
+  const double firstX = this->dataPtr->positions[_node].X();
+  const double lastX = this->dataPtr->positions[last * n + _node].X();
+
+  double x = std::max(_x, firstX);
+  if (x > lastX && (!_loop || lastX <= 0))
+    x = lastX;
+  else if (x > lastX)
+    x = std::fmod(x, lastX);
+
+  // The node is assumed to move forward along X, as in
+  // NodeAnimation::GetTimeAtX
+  size_t k = 0;
+  size_t end = last;
+  while (k < end)
+  {
+    const size_t mid = (k + end) / 2;
+    if (this->dataPtr->positions[mid * n + _node].X() < x)
+      k = mid + 1;
+    else
+      end = mid;
+  }
+
+  double time = this->dataPtr->times[k];
+  const double xk = this->dataPtr->positions[k * n + _node].X();
+  if (k > 0 && !ignition::math::equal(xk, x))
+  {
+    const double xPrev = this->dataPtr->positions[(k - 1) * n + _node].X();
+    const double tPrev = this->dataPtr->times[k - 1];
+    time = tPrev + (time - tPrev) * (x - xPrev) / (xk - xPrev);
+  }
+
+  this->PoseAt(time, _pose, _loop);
+}
@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_COMMON_BAKEDSKELETONANIMATION_HH_
+#define GAZEBO_COMMON_BAKEDSKELETONANIMATION_HH_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <ignition/math/Matrix4.hh>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace common
+  {
+    class SkeletonAnimation;
+
+    // Forward declare private data class.
+    class BakedSkeletonAnimationPrivate;
+
+    /// \addtogroup gazebo_common Common Animation
+    /// \{
+
+    /// \class BakedSkeletonAnimation BakedSkeletonAnimation.hh
+    /// common/common.hh
+    /// \brief A skeleton animation sampled at a fixed rate into flat
+    /// arrays, indexed by node number.
+    ///
+    /// A pose is interpolated between the two samples around its time,
+    /// found by binary search, without the per node keyframe lookups and
+    /// string keyed maps of SkeletonAnimation::PoseAt. The samples are read
+    /// only once baked, so one baked animation may be shared by several
+    /// threads.
+    class GZ_COMMON_VISIBLE BakedSkeletonAnimation
+    {
+      /// \brief Constructor.
+      /// \param[in] _anim The animation to sample.
+      /// \param[in] _nodes Names of the animation nodes, in the order of
+      /// the node numbers. Names not in the animation are not animated.
+      /// \param[in] _rate Number of samples per second.
+      public: BakedSkeletonAnimation(const SkeletonAnimation &_anim,
+                  const std::vector<std::string> &_nodes,
+                  const double _rate = 60.0);
+
+      /// \brief Destructor.
+      public: virtual ~BakedSkeletonAnimation();
+
+      /// \brief Get the number of nodes.
+      /// \return Number of nodes given to the constructor.
+      public: unsigned int NodeCount() const;
+
+      /// \brief Check whether a node is animated.
+      /// \param[in] _node Node number.
+      /// \return True if the animation has the node.
+      public: bool HasNode(const unsigned int _node) const;
+
+      /// \brief Get the number of samples.
+      /// \return Number of samples.
+      public: unsigned int SampleCount() const;
+
+      /// \brief Get the length of the animation.
+      /// \return Length in seconds.
+      public: double Length() const;
+
+      /// \brief Get the transforms of the nodes at a time, like
+      /// SkeletonAnimation::PoseAt.
+      /// \param[in] _time Time in seconds.
+      /// \param[out] _pose Transform of each node, resized to NodeCount.
+      /// The transforms of the nodes that are not animated are left as
+      /// they were.
+      /// \param[in] _loop True to wrap times past the length.
+      public: void PoseAt(const double _time,
+                  std::vector<ignition::math::Matrix4d> &_pose,
+                  const bool _loop = true) const;
+
+      /// \brief Get the transforms of the nodes when a node is at a
+      /// distance along the X axis, like SkeletonAnimation::PoseAtX.
+      /// \param[in] _x Distance along the X axis.
+      /// \param[in] _node Number of the node whose X is given.
+      /// \param[out] _pose Transform of each node, see PoseAt.
+      /// \param[in] _loop True to wrap distances past the last one.
+      public: void PoseAtX(const double _x, const unsigned int _node,
+                  std::vector<ignition::math::Matrix4d> &_pose,
+                  const bool _loop = true) const;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<BakedSkeletonAnimationPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
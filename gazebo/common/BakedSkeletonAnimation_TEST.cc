@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <ignition/math/Pose3.hh>
+
+#include "gazebo/common/BakedSkeletonAnimation.hh"
+#include "gazebo/common/SkeletonAnimation.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class BakedSkeletonAnimationTest : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+/// \brief Check that two transforms are the same.
+/// \param[in] _a First transform.
+/// \param[in] _b Second transform.
+static void ExpectNear(const ignition::math::Matrix4d &_a,
+    const ignition::math::Matrix4d &_b)
+{
+  for (int i = 0; i < 4; ++i)
+  {
+    for (int j = 0; j < 4; ++j)
+      EXPECT_NEAR(_a(i, j), _b(i, j), 1e-9);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(BakedSkeletonAnimationTest, PoseAt)
+{
+  common::SkeletonAnimation anim("walk");
+  anim.AddKeyFrame("hip", 0.0, ignition::math::Pose3d(0, 0, 1, 0, 0, 0));
+  anim.AddKeyFrame("hip", 0.5, ignition::math::Pose3d(1, 0, 1, 0, 0, 0.5));
+  anim.AddKeyFrame("hip", 1.0, ignition::math::Pose3d(2, 0, 1, 0, 0, 1.0));
+  anim.AddKeyFrame("knee", 0.0, ignition::math::Pose3d(0, 0, 0.5, 0.3, 0, 0));
+  anim.AddKeyFrame("knee", 0.25, ignition::math::Pose3d(0, 0, 0.5, -1, 0, 0));
+  anim.AddKeyFrame("knee", 1.0, ignition::math::Pose3d(0, 0, 0.5, 0.3, 0, 0));
+
+  const std::vector<std::string> nodes = {"hip", "knee", "foot"};
+  common::BakedSkeletonAnimation baked(anim, nodes, 20);
+  EXPECT_EQ(3u, baked.NodeCount());
+  EXPECT_TRUE(baked.HasNode(0));
+  EXPECT_TRUE(baked.HasNode(1));
+  EXPECT_FALSE(baked.HasNode(2));
+  EXPECT_FALSE(baked.HasNode(3));
+  EXPECT_EQ(21u, baked.SampleCount());
+  EXPECT_DOUBLE_EQ(1.0, baked.Length());
+
+  // The keyframes fall on samples, so the poses are those of the animation
+  std::vector<ignition::math::Matrix4d> pose;
+  for (double t : {0.0, 0.01, 0.3, 0.5, 0.777, 1.0, 1.3, 2.5})
+  {
+    baked.PoseAt(t, pose);
+    ASSERT_EQ(3u, pose.size());
+    std::map<std::string, ignition::math::Matrix4d> expected =
+      anim.PoseAt(t);
+    ExpectNear(expected["hip"], pose[0]);
+    ExpectNear(expected["knee"], pose[1]);
+    ExpectNear(ignition::math::Matrix4d::Identity, pose[2]);
+  }
+
+  // Without loop the last pose is kept
+  baked.PoseAt(1.3, pose, false);
+  ExpectNear(anim.PoseAt(1.0)["hip"], pose[0]);
+
+  // Along X the hip is at half the distance at a quarter of the time
+  baked.PoseAtX(0.5, 0, pose);
+  ExpectNear(anim.PoseAt(0.25)["hip"], pose[0]);
+  ExpectNear(anim.PoseAtX(0.5, "hip")["knee"], pose[1]);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
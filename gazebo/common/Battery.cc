@@ -78,6 +78,7 @@ void Battery::InitConsumers()
 {
   std::lock_guard<std::mutex> lock(this->dataPtr->powerLoadsMutex);
   this->dataPtr->powerLoads.clear();
+  this->dataPtr->totalPowerLoad = 0.0;
 }
 
 /////////////////////////////////////////////////
@@ -93,8 +94,15 @@ uint32_t Battery::AddConsumer()
 bool Battery::RemoveConsumer(uint32_t _consumerId)
 {
   std::lock_guard<std::mutex> lock(this->dataPtr->powerLoadsMutex);
-  if (this->dataPtr->powerLoads.erase(_consumerId))
+  auto iter = this->dataPtr->powerLoads.find(_consumerId);
+  if (iter != this->dataPtr->powerLoads.end())
   {
+    this->dataPtr->totalPowerLoad -= iter->second;
+    this->dataPtr->powerLoads.erase(iter);
+
+    // Don't keep the rounding errors of the removed loads around
+    if (this->dataPtr->powerLoads.empty())
+      this->dataPtr->totalPowerLoad = 0.0;
     return true;
   }
   else
@@ -115,6 +123,7 @@ bool Battery::SetPowerLoad(const uint32_t _consumerId, const double _powerLoad)
     return false;
   }
 
+  this->dataPtr->totalPowerLoad += _powerLoad - iter->second;
   iter->second = _powerLoad;
   return true;
 }
@@ -141,15 +150,31 @@ const Battery::PowerLoad_M &Battery::PowerLoads() const
   return this->dataPtr->powerLoads;
 }
 
+/////////////////////////////////////////////////
+double Battery::TotalPowerLoad() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->powerLoadsMutex);
+  return this->dataPtr->totalPowerLoad;
+}
+
 /////////////////////////////////////////////////
 double Battery::Voltage() const
 {
   return this->dataPtr->realVoltage;
 }
 
+/////////////////////////////////////////////////
+void Battery::SetVoltage(const double _voltage)
+{
+  this->dataPtr->realVoltage = std::max(0.0, _voltage);
+}
+
 /////////////////////////////////////////////////
 void Battery::Update()
 {
+  if (!this->dataPtr->updateFunc)
+    return;
+
   this->dataPtr->realVoltage = std::max(0.0,
       this->dataPtr->updateFunc(shared_from_this()));
 }
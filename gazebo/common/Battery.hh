@@ -107,16 +107,30 @@ namespace gazebo
       /// \return List of power loads in watts.
       public: const PowerLoad_M &PowerLoads() const;
 
+      /// \brief Get the sum of the power loads of the consumers in watts.
+      /// The sum is kept as the loads change, so that battery models don't
+      /// iterate over the consumers on every update.
+      /// \return Total power load in watts.
+      public: double TotalPowerLoad() const;
+
       /// \brief Get the real voltage in volts.
       /// \return Voltage.
       public: double Voltage() const;
 
+      /// \brief Set the real voltage, for a battery model that isn't run by
+      /// Update, such as the linear batteries of physics::BatterySystem.
+      /// \param[in] _voltage Voltage in volts, negative values are clamped
+      /// to zero.
+      /// \sa SetUpdateFunc
+      public: void SetVoltage(const double _voltage);
+
       /// \brief Setup function to update voltage.
       /// \param[in] _updateFunc The update function callback that is used
       /// to modify the battery's voltage. The parameter to the update
       /// function callback is a reference to an instance of
       /// Battery::UpdateData. The update function must return the new
       /// battery voltage as a double.
+      /// The voltage is left unchanged by Update if the function is empty.
       /// \sa UpdateData
       public: void SetUpdateFunc(
                   std::function<double (const BatteryPtr &)> _updateFunc);
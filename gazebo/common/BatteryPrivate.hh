@@ -40,6 +40,9 @@ namespace gazebo
       /// \brief Map of unique consumer ID to power loads in watts.
       public: std::map<uint32_t, double> powerLoads;
 
+      /// \brief Sum of powerLoads in watts, kept as the loads change.
+      public: double totalPowerLoad = 0.0;
+
       /// \brief Counter used to produce unique consumer (powerload) ids.
       public: uint32_t powerLoadCounter;
 
@@ -121,6 +121,15 @@ TEST_F(BatteryTest, SetPowerLoad)
   EXPECT_DOUBLE_EQ(powerLoad1, 1.0);
   EXPECT_TRUE(battery->PowerLoad(consumerId2, powerLoad2));
   EXPECT_DOUBLE_EQ(powerLoad2, 2.0);
+
+  // The total follows the loads
+  EXPECT_DOUBLE_EQ(3.0, battery->TotalPowerLoad());
+  EXPECT_TRUE(battery->SetPowerLoad(consumerId2, 5.0));
+  EXPECT_DOUBLE_EQ(6.0, battery->TotalPowerLoad());
+  EXPECT_TRUE(battery->RemoveConsumer(consumerId1));
+  EXPECT_DOUBLE_EQ(5.0, battery->TotalPowerLoad());
+  EXPECT_TRUE(battery->RemoveConsumer(consumerId2));
+  EXPECT_DOUBLE_EQ(0.0, battery->TotalPowerLoad());
 }
 
 /// \brief A fixture class to help with updating the battery voltage.
@@ -200,6 +209,14 @@ TEST_F(BatteryTest, SetUpdateFunc)
     battery->Update();
 
   EXPECT_DOUBLE_EQ(battery->Voltage(), initVoltage + N * fixture.step);
+
+  // Without an update function the voltage is only set explicitly
+  battery->SetUpdateFunc(nullptr);
+  battery->SetVoltage(11.0);
+  battery->Update();
+  EXPECT_DOUBLE_EQ(11.0, battery->Voltage());
+  battery->SetVoltage(-1.0);
+  EXPECT_DOUBLE_EQ(0.0, battery->Voltage());
 }
 
 int main(int argc, char **argv)
@@ -82,6 +82,7 @@ namespace gazebo
     class NumericAnimation;
     class Param;
     class PoseAnimation;
+    class RealTimePacer;
     class SkeletonAnimation;
     class SphericalCoordinates;
     class Time;
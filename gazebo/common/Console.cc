@@ -14,7 +14,15 @@
  * limitations under the License.
  *
  */
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 #include <boost/filesystem.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/algorithm/string/regex.hpp>
@@ -29,13 +37,546 @@
 using namespace gazebo;
 using namespace common;
 
+namespace gazebo
+{
+  namespace common
+  {
+    /// \brief A message, either being written by a thread or waiting to be
+    /// output.
+    class ConsoleMessage
+    {
+      /// \brief Buffer of the logger the message is written to, nullptr if
+      /// there is no message.
+      public: std::streambuf *buffer = nullptr;
+
+      /// \brief True if the message is also output to the terminal.
+      public: bool terminal = false;
+
+      /// \brief Terminal stream of the message.
+      public: Logger::LogType type = Logger::STDOUT;
+
+      /// \brief Terminal color of the message.
+      public: int color = 0;
+
+      /// \brief Text written before the message, only to the log file.
+      public: std::string prefix;
+
+      /// \brief Start of the message, such as the level and call site.
+      public: std::string head;
+
+      /// \brief Call site of the statement, empty if unknown.
+      public: std::string site;
+
+      /// \brief Text of the message, starting with the head.
+      public: std::string text;
+    };
+
+    /// \brief Filters the messages of all loggers and outputs them, either
+    /// from the thread that logged them or from a background thread.
+    class ConsoleWriter
+    {
+      /// \brief Get the writer, which is never destroyed so that messages
+      /// may be logged during static destruction.
+      /// \return The writer.
+      public: static ConsoleWriter &Instance();
+
+      /// \brief Start a message of the calling thread, ending the previous
+      /// one.
+      /// \param[in] _buffer Buffer of the logger.
+      /// \param[in] _prefix Text written only to the log file.
+      /// \param[in] _head Start of the message.
+      /// \param[in] _site Call site, empty if unknown.
+      public: void Begin(std::streambuf *_buffer, const std::string &_prefix,
+                  const std::string &_head, const std::string &_site);
+
+      /// \brief Append text to the message of the calling thread, starting
+      /// a message if the thread was writing to another logger.
+      /// \param[in] _buffer Buffer of the logger.
+      /// \param[in] _s Text to append.
+      /// \param[in] _n Length of the text.
+      public: void Append(std::streambuf *_buffer, const char *_s,
+                  const std::streamsize _n);
+
+      /// \brief End the message of the calling thread if it is written to a
+      /// buffer.
+      /// \param[in] _buffer Buffer of the logger.
+      public: void End(const std::streambuf *_buffer);
+
+      /// \brief End a message and output it.
+      /// \param[in] _message The message, which is reset.
+      public: void End(ConsoleMessage &_message);
+
+      /// \brief Set whether messages are output by the background thread.
+      /// \param[in] _async True to output messages in the background.
+      public: void SetAsync(const bool _async);
+
+      /// \brief Get whether messages are output by the background thread.
+      /// \return True if messages are output in the background.
+      public: bool Async();
+
+      /// \brief Wait until the messages logged so far are output.
+      public: void Flush();
+
+      /// \brief Set the number of messages per second of a call site.
+      /// \param[in] _count Messages per second, 0 for no limit.
+      public: void SetRateLimit(const unsigned int _count);
+
+      /// \brief Get the number of messages per second of a call site.
+      /// \return Messages per second, 0 for no limit.
+      public: unsigned int RateLimit() const;
+
+      /// \brief Set whether repeated messages are dropped.
+      /// \param[in] _deduplicate True to drop repeated messages.
+      public: void SetDeduplicate(const bool _deduplicate);
+
+      /// \brief Get whether repeated messages are dropped.
+      /// \return True if repeated messages are dropped.
+      public: bool Deduplicate() const;
+
+      /// \brief Get the buffer of the log file.
+      /// \return The buffer.
+      public: static FileLogger::Buffer *FileBuffer();
+
+      /// \brief Mutex held while writing to the terminal or the log file.
+      public: std::mutex writeMutex;
+
+      /// \brief Apply the deduplication and the rate limit to a message.
+      /// \param[in] _message The message.
+      /// \return True if the message should be output.
+      private: bool Filter(const ConsoleMessage &_message);
+
+      /// \brief Queue a message, or output it if messages are not output
+      /// in the background.
+      /// \param[in] _message The message.
+      private: void Push(ConsoleMessage &&_message);
+
+      /// \brief Output a message. The caller holds writeMutex.
+      /// \param[in] _message The message.
+      /// \param[in] _flush True to flush the log file.
+      private: void Write(const ConsoleMessage &_message, const bool _flush);
+
+      /// \brief Output the queued messages until stopped.
+      private: void Run();
+
+      /// \brief Number of times a message was repeated at a call site, and
+      /// the number of messages of the call site in the current second.
+      private: class Site
+               {
+                 /// \brief Last message output.
+                 public: std::string text;
+
+                 /// \brief Number of repeats of the last message dropped.
+                 public: unsigned int repeats = 0;
+
+                 /// \brief Time the last message was output or reported.
+                 public: std::chrono::steady_clock::time_point repeatTime;
+
+                 /// \brief Start of the rate limit window.
+                 public: std::chrono::steady_clock::time_point window;
+
+                 /// \brief Number of messages output in the window.
+                 public: unsigned int count = 0;
+
+                 /// \brief Number of messages dropped in the window.
+                 public: unsigned int dropped = 0;
+               };
+
+      /// \brief State of each call site, by call site or logger.
+      private: std::map<std::string, Site> sites;
+
+      /// \brief Mutex protecting sites.
+      private: std::mutex sitesMutex;
+
+      /// \brief Messages per second of a call site, 0 for no limit.
+      private: std::atomic<unsigned int> rateLimit{0};
+
+      /// \brief True if repeated messages are dropped.
+      private: std::atomic<bool> deduplicate{false};
+
+      /// \brief True if messages are output in the background.
+      private: bool async = false;
+
+      /// \brief True to stop the background thread.
+      private: bool stop = false;
+
+      /// \brief Messages waiting for the background thread.
+      private: std::vector<ConsoleMessage> queue;
+
+      /// \brief Number of messages queued so far.
+      private: uint64_t queued = 0;
+
+      /// \brief Number of queued messages output so far.
+      private: uint64_t written = 0;
+
+      /// \brief Mutex protecting async, stop, queue, queued and written.
+      private: std::mutex queueMutex;
+
+      /// \brief Notified when messages are queued or stop is set.
+      private: std::condition_variable queueCondition;
+
+      /// \brief Notified when queued messages were output.
+      private: std::condition_variable writtenCondition;
+
+      /// \brief Mutex serializing SetAsync.
+      private: std::mutex threadMutex;
+
+      /// \brief Background thread.
+      private: std::thread thread;
+    };
+  }
+}
+
+/// \brief Message being written by a thread.
+class ConsolePendingMessage : public ConsoleMessage
+{
+  /// \brief Destructor. Outputs the last message of an exiting thread.
+  public: ~ConsolePendingMessage();
+};
+
+/// \brief Message being written by the current thread.
+static thread_local ConsolePendingMessage g_pendingMessage;
+
+/// \brief Outputs the queued messages at exit, while the loggers exist.
+class ConsoleShutdown
+{
+  /// \brief Destructor.
+  public: ~ConsoleShutdown()
+          {
+            ConsoleWriter::Instance().SetAsync(false);
+          }
+};
+
 FileLogger gazebo::common::Console::log("");
 Logger Console::msg("[Msg] ", 32, Logger::STDOUT);
 Logger Console::err("[Err] ", 31, Logger::STDERR);
 Logger Console::dbg("[Dbg] ", 36, Logger::STDOUT);
 Logger Console::warn("[Wrn] ", 33, Logger::STDERR);
 
+/// \brief Destroyed before the loggers.
+static ConsoleShutdown g_consoleShutdown;
+
 bool Console::quiet = true;
+Console::LogLevel Console::verbosity = Console::LEVEL_DBG;
+
+//////////////////////////////////////////////////
+ConsolePendingMessage::~ConsolePendingMessage()
+{
+  if (this->buffer)
+    ConsoleWriter::Instance().End(*this);
+}
+
+//////////////////////////////////////////////////
+ConsoleWriter &ConsoleWriter::Instance()
+{
+  static ConsoleWriter *writer = new ConsoleWriter();
+  return *writer;
+}
+
+//////////////////////////////////////////////////
+void ConsoleWriter::Begin(std::streambuf *_buffer, const std::string &_prefix,
+    const std::string &_head, const std::string &_site)
+{
+  ConsoleMessage &message = g_pendingMessage;
+  if (message.buffer)
+    this->End(message);
+
+  Logger::Buffer *logger = dynamic_cast<Logger::Buffer*>(_buffer);
+  message.buffer = _buffer;
+  message.terminal = logger != nullptr;
+  if (logger)
+  {
+    message.type = logger->type;
+    message.color = logger->color;
+  }
+  message.prefix = _prefix;
+  message.head = _head;
+  message.site = _site;
+  message.text = _head;
+}
+
+//////////////////////////////////////////////////
+void ConsoleWriter::Append(std::streambuf *_buffer, const char *_s,
+    const std::streamsize _n)
+{
+  ConsoleMessage &message = g_pendingMessage;
+  if (message.buffer != _buffer)
+    this->Begin(_buffer, "", "", "");
+  message.text.append(_s, _n);
+}
+
+//////////////////////////////////////////////////
+void ConsoleWriter::End(const std::streambuf *_buffer)
+{
+  ConsoleMessage &message = g_pendingMessage;
+  if (message.buffer && message.buffer == _buffer)
+    this->End(message);
+}
+
+//////////////////////////////////////////////////
+void ConsoleWriter::End(ConsoleMessage &_message)
+{
+  ConsoleMessage done(std::move(_message));
+  _message.buffer = nullptr;
+  _message.text.clear();
+
+  if (done.text.empty() || !this->Filter(done))
+    return;
+
+  this->Push(std::move(done));
+}
+
+//////////////////////////////////////////////////
+bool ConsoleWriter::Filter(const ConsoleMessage &_message)
+{
+  const bool dedup = this->deduplicate;
+  const unsigned int limit = this->rateLimit;
+  if (!dedup && (limit == 0 || _message.site.empty()))
+    return true;
+
+  const auto now = std::chrono::steady_clock::now();
+  const std::chrono::seconds interval(1);
+
+  // The notes are output with the prefix of the message that caused them
+  ConsoleMessage note;
+  note.terminal = _message.terminal;
+  note.type = _message.type;
+  note.color = _message.color;
+  note.prefix = _message.prefix;
+  std::vector<ConsoleMessage> notes;
+
+  bool output = true;
+  {
+    std::lock_guard<std::mutex> lock(this->sitesMutex);
+    std::string key = _message.site;
+    if (key.empty())
+    {
+      std::ostringstream stream;
+      stream << _message.buffer;
+      key = stream.str();
+    }
+    Site &site = this->sites[key];
+
+    if (dedup && _message.text == site.text)
+    {
+      // Report the repeats at most every second
+      ++site.repeats;
+      output = false;
+      if (now - site.repeatTime < interval)
+        return false;
+    }
+
+    if (site.repeats > 0)
+    {
+      note.text = _message.head + "Last message repeated " +
+        std::to_string(site.repeats) + " times\n";
+      notes.push_back(note);
+      site.repeats = 0;
+    }
+    site.repeatTime = now;
+
+    if (output)
+    {
+      if (dedup)
+        site.text = _message.text;
+
+      if (limit > 0 && !_message.site.empty())
+      {
+        if (now - site.window >= interval)
+        {
+          if (site.dropped > 0)
+          {
+            note.text = _message.head + "Dropped " +
+              std::to_string(site.dropped) +
+              " messages over the rate limit\n";
+            notes.push_back(note);
+          }
+          site.window = now;
+          site.count = 0;
+          site.dropped = 0;
+        }
+
+        if (site.count >= limit)
+        {
+          ++site.dropped;
+          output = false;
+        }
+        else
+          ++site.count;
+      }
+    }
+  }
+
+  for (auto &n : notes)
+    this->Push(std::move(n));
+
+  return output;
+}
+
+//////////////////////////////////////////////////
+void ConsoleWriter::Push(ConsoleMessage &&_message)
+{
+  {
+    std::lock_guard<std::mutex> lock(this->queueMutex);
+    if (this->async)
+    {
+      this->queue.push_back(std::move(_message));
+      ++this->queued;
+      this->queueCondition.notify_one();
+      return;
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(this->writeMutex);
+  this->Write(_message, true);
+}
+
+//////////////////////////////////////////////////
+void ConsoleWriter::Write(const ConsoleMessage &_message, const bool _flush)
+{
+  // Log messages to disk
+  FileLogger::Buffer *file = FileBuffer();
+  if (file && file->stream)
+  {
+    *file->stream << _message.prefix << _message.text;
+    if (_flush)
+      file->stream->flush();
+  }
+
+  // Output to terminal
+  if (!_message.terminal || Console::GetQuiet())
+    return;
+
+  std::ostream &out = _message.type == Logger::STDOUT ? std::cout : std::cerr;
+#ifndef _WIN32
+  out << "\033[1;" << _message.color << "m" << _message.text << "\033[0m";
+#else
+  out << _message.text;
+#endif
+}
+
+//////////////////////////////////////////////////
+void ConsoleWriter::Run()
+{
+  std::vector<ConsoleMessage> batch;
+  std::unique_lock<std::mutex> lock(this->queueMutex);
+  while (true)
+  {
+    this->queueCondition.wait(lock, [this]
+        {
+          return this->stop || !this->queue.empty();
+        });
+    if (this->queue.empty())
+      break;
+
+    batch.swap(this->queue);
+    lock.unlock();
+
+    {
+      std::lock_guard<std::mutex> writeLock(this->writeMutex);
+      for (const auto &message : batch)
+        this->Write(message, false);
+
+      FileLogger::Buffer *file = FileBuffer();
+      if (file && file->stream)
+        file->stream->flush();
+      std::cout.flush();
+    }
+
+    lock.lock();
+    this->written += batch.size();
+    batch.clear();
+    this->writtenCondition.notify_all();
+  }
+}
+
+//////////////////////////////////////////////////
+void ConsoleWriter::SetAsync(const bool _async)
+{
+  std::lock_guard<std::mutex> threadLock(this->threadMutex);
+  if (_async == this->thread.joinable())
+    return;
+
+  if (_async)
+  {
+    std::lock_guard<std::mutex> lock(this->queueMutex);
+    this->async = true;
+    this->stop = false;
+    this->thread = std::thread(&ConsoleWriter::Run, this);
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(this->queueMutex);
+    this->stop = true;
+    this->queueCondition.notify_one();
+  }
+  this->thread.join();
+
+  // Output the messages queued after the thread stopped
+  std::vector<ConsoleMessage> rest;
+  {
+    std::lock_guard<std::mutex> lock(this->queueMutex);
+    this->async = false;
+    rest.swap(this->queue);
+    this->written += rest.size();
+    this->writtenCondition.notify_all();
+  }
+
+  std::lock_guard<std::mutex> lock(this->writeMutex);
+  for (const auto &message : rest)
+    this->Write(message, true);
+}
+
+//////////////////////////////////////////////////
+bool ConsoleWriter::Async()
+{
+  std::lock_guard<std::mutex> lock(this->queueMutex);
+  return this->async;
+}
+
+//////////////////////////////////////////////////
+void ConsoleWriter::Flush()
+{
+  if (g_pendingMessage.buffer)
+    this->End(g_pendingMessage);
+
+  std::unique_lock<std::mutex> lock(this->queueMutex);
+  const uint64_t target = this->queued;
+  this->writtenCondition.wait(lock, [this, target]
+      {
+        return this->written >= target;
+      });
+}
+
+//////////////////////////////////////////////////
+void ConsoleWriter::SetRateLimit(const unsigned int _count)
+{
+  this->rateLimit = _count;
+}
+
+//////////////////////////////////////////////////
+unsigned int ConsoleWriter::RateLimit() const
+{
+  return this->rateLimit;
+}
+
+//////////////////////////////////////////////////
+void ConsoleWriter::SetDeduplicate(const bool _deduplicate)
+{
+  this->deduplicate = _deduplicate;
+}
+
+//////////////////////////////////////////////////
+bool ConsoleWriter::Deduplicate() const
+{
+  return this->deduplicate;
+}
+
+//////////////////////////////////////////////////
+FileLogger::Buffer *ConsoleWriter::FileBuffer()
+{
+  return static_cast<FileLogger::Buffer*>(Console::log.rdbuf());
+}
 
 //////////////////////////////////////////////////
 void Console::SetQuiet(bool _quiet)
@@ -49,11 +590,64 @@ bool Console::GetQuiet()
   return quiet;
 }
 
+//////////////////////////////////////////////////
+void Console::SetVerbosity(const LogLevel _level)
+{
+  verbosity = _level;
+}
+
+//////////////////////////////////////////////////
+Console::LogLevel Console::Verbosity()
+{
+  return verbosity;
+}
+
+//////////////////////////////////////////////////
+void Console::SetAsync(const bool _async)
+{
+  ConsoleWriter::Instance().SetAsync(_async);
+}
+
+//////////////////////////////////////////////////
+bool Console::Async()
+{
+  return ConsoleWriter::Instance().Async();
+}
+
+//////////////////////////////////////////////////
+void Console::Flush()
+{
+  ConsoleWriter::Instance().Flush();
+}
+
+//////////////////////////////////////////////////
+void Console::SetRateLimit(const unsigned int _count)
+{
+  ConsoleWriter::Instance().SetRateLimit(_count);
+}
+
+//////////////////////////////////////////////////
+unsigned int Console::RateLimit()
+{
+  return ConsoleWriter::Instance().RateLimit();
+}
+
+//////////////////////////////////////////////////
+void Console::SetDeduplicate(const bool _deduplicate)
+{
+  ConsoleWriter::Instance().SetDeduplicate(_deduplicate);
+}
+
+//////////////////////////////////////////////////
+bool Console::Deduplicate()
+{
+  return ConsoleWriter::Instance().Deduplicate();
+}
+
 /////////////////////////////////////////////////
 Logger::Logger(const std::string &_prefix, int _color, LogType _type)
   : std::ostream(new Buffer(_type, _color)), color(_color), prefix(_prefix)
 {
-  this->setf(std::ios_base::unitbuf);
 }
 
 /////////////////////////////////////////////////
@@ -65,8 +659,10 @@ Logger::~Logger()
 /////////////////////////////////////////////////
 Logger &Logger::operator()()
 {
-  Console::log << "(" << Time::GetWallTime() << ") ";
-  (*this) << this->prefix;
+  std::ostringstream timeString;
+  timeString << "(" << Time::GetWallTime() << ") ";
+  ConsoleWriter::Instance().Begin(this->rdbuf(), timeString.str(),
+      this->prefix, "");
 
   return (*this);
 }
@@ -76,12 +672,14 @@ Logger &Logger::operator()(const std::string &_file, int _line)
 {
   int index = _file.find_last_of("/") + 1;
 
-  Console::log << "(" << Time::GetWallTime() << ") ";
+  std::ostringstream timeString;
+  timeString << "(" << Time::GetWallTime() << ") ";
   std::stringstream prefixString;
   prefixString << this->prefix
     << "[" << _file.substr(index , _file.size() - index) << ":"
     << _line << "] ";
-  (*this) << prefixString.str();
+  ConsoleWriter::Instance().Begin(this->rdbuf(), timeString.str(),
+      prefixString.str(), _file + ":" + std::to_string(_line));
 
   return (*this);
 }
@@ -90,52 +688,40 @@ Logger &Logger::operator()(const std::string &_file, int _line)
 Logger::Buffer::Buffer(LogType _type, int _color)
   :  type(_type), color(_color)
 {
+  // Leave the put area empty, so that all text goes to the message of the
+  // writing thread
+  this->setp(nullptr, nullptr);
 }
 
 /////////////////////////////////////////////////
 Logger::Buffer::~Buffer()
 {
-  // Can't throw from a destructor
-  try
-  {
-    this->pubsync();
-  }
-  catch(...)
-  {
-    std::cerr << "Exception thrown while pubsync'ing Buffer" << std::endl;
-  }
+  // The messages of the threads are output when the threads exit
 }
 
 /////////////////////////////////////////////////
 int Logger::Buffer::sync()
 {
-  // Log messages to disk
-  Console::log << this->str();
-  Console::log.flush();
+  ConsoleWriter::Instance().End(this);
+  return 0;
+}
 
-  // Output to terminal
-  if (!Console::GetQuiet())
+/////////////////////////////////////////////////
+std::streamsize Logger::Buffer::xsputn(const char *_s, std::streamsize _n)
+{
+  ConsoleWriter::Instance().Append(this, _s, _n);
+  return _n;
+}
+
+/////////////////////////////////////////////////
+int Logger::Buffer::overflow(int _c)
+{
+  if (_c != traits_type::eof())
   {
-    if (this->type == Logger::STDOUT)
-    {
-      #ifndef _WIN32
-      std::cout << "\033[1;" << this->color << "m" << this->str() << "\033[0m";
-      #else
-      std::cout << this->str();
-      #endif
-    }
-    else
-    {
-      #ifndef _WIN32
-      std::cerr << "\033[1;" << this->color << "m" << this->str() << "\033[0m";
-      #else
-      std::cerr << this->str();
-      #endif
-    }
+    const char c = traits_type::to_char_type(_c);
+    ConsoleWriter::Instance().Append(this, &c, 1);
   }
-
-  this->str("");
-  return 0;
+  return traits_type::not_eof(_c);
 }
 
 /////////////////////////////////////////////////
@@ -143,7 +729,6 @@ FileLogger::FileLogger(const std::string &_filename)
   : std::ostream(new Buffer(_filename)),
     logDirectory("")
 {
-  this->setf(std::ios_base::unitbuf);
 }
 
 /////////////////////////////////////////////////
@@ -180,6 +765,9 @@ void FileLogger::Init(const std::string &_prefix, const std::string &_filename)
 
   logPath /= _filename;
 
+  // Messages may be written by another thread
+  std::lock_guard<std::mutex> lock(ConsoleWriter::Instance().writeMutex);
+
   // Check if the Init method has been already called, and if so
   // remove current buffer.
   if (buf->stream && buf->stream->is_open())
@@ -226,7 +814,9 @@ void FileLogger::Init(const std::string &_prefix, const std::string &_filename)
 /////////////////////////////////////////////////
 FileLogger &FileLogger::operator()()
 {
-  (*this) << "(" << Time::GetWallTime() << ") ";
+  std::ostringstream timeString;
+  timeString << "(" << Time::GetWallTime() << ") ";
+  ConsoleWriter::Instance().Begin(this->rdbuf(), "", timeString.str(), "");
   return (*this);
 }
 
@@ -234,8 +824,11 @@ FileLogger &FileLogger::operator()()
 FileLogger &FileLogger::operator()(const std::string &_file, int _line)
 {
   int index = _file.find_last_of("/") + 1;
-  (*this) << "(" << Time::GetWallTime() << ") ["
+  std::ostringstream prefixString;
+  prefixString << "(" << Time::GetWallTime() << ") ["
     << _file.substr(index , _file.size() - index) << ":" << _line << "]";
+  ConsoleWriter::Instance().Begin(this->rdbuf(), "", prefixString.str(),
+      _file + ":" + std::to_string(_line));
 
   return (*this);
 }
@@ -267,6 +860,10 @@ std::string FileLogger::GetLogDirectory() const
 FileLogger::Buffer::Buffer(const std::string &_filename)
   : stream(nullptr)
 {
+  // Leave the put area empty, so that all text goes to the message of the
+  // writing thread
+  this->setp(nullptr, nullptr);
+
   if (!_filename.empty())
   {
     this->stream = new std::ofstream(_filename.c_str(), std::ios::out);
@@ -291,13 +888,25 @@ FileLogger::Buffer::~Buffer()
 /////////////////////////////////////////////////
 int FileLogger::Buffer::sync()
 {
-  if (!this->stream)
-    return -1;
-
-  *this->stream << this->str();
+  ConsoleWriter::Instance().End(this);
+  return 0;
+}
 
-  this->stream->flush();
+/////////////////////////////////////////////////
+std::streamsize FileLogger::Buffer::xsputn(const char *_s,
+    std::streamsize _n)
+{
+  ConsoleWriter::Instance().Append(this, _s, _n);
+  return _n;
+}
 
-  this->str("");
-  return !(*this->stream);
+/////////////////////////////////////////////////
+int FileLogger::Buffer::overflow(int _c)
+{
+  if (_c != traits_type::eof())
+  {
+    const char c = traits_type::to_char_type(_c);
+    ConsoleWriter::Instance().Append(this, &c, 1);
+  }
+  return traits_type::not_eof(_c);
 }
@@ -37,20 +37,35 @@ namespace gazebo
     /// \addtogroup gazebo_common Common
     /// \{
 
+    /// \brief Start a logging statement of the given level. The rest of
+    /// the statement is only evaluated if the level is enabled, see
+    /// Console::SetVerbosity, and is written as one message once the
+    /// statement completes.
+    /// \param[in] _level Console::LogLevel of the statement.
+    #define GZ_CONSOLE_STATEMENT(_level) \
+        !::gazebo::common::Console::Enabled( \
+            ::gazebo::common::Console::_level) ? (void)0 : \
+        ::gazebo::common::ConsoleStatement() &
+
     /// \brief Output a message
-    #define gzmsg (::gazebo::common::Console::msg())
+    #define gzmsg GZ_CONSOLE_STATEMENT(LEVEL_MSG) \
+        (::gazebo::common::Console::msg())
 
     /// \brief Output a debug message
-    #define gzdbg (::gazebo::common::Console::dbg(__FILE__, __LINE__))
+    #define gzdbg GZ_CONSOLE_STATEMENT(LEVEL_DBG) \
+        (::gazebo::common::Console::dbg(__FILE__, __LINE__))
 
     /// \brief Output a warning message
-    #define gzwarn (::gazebo::common::Console::warn(__FILE__, __LINE__))
+    #define gzwarn GZ_CONSOLE_STATEMENT(LEVEL_WARN) \
+        (::gazebo::common::Console::warn(__FILE__, __LINE__))
 
     /// \brief Output an error message
-    #define gzerr (::gazebo::common::Console::err(__FILE__, __LINE__))
+    #define gzerr GZ_CONSOLE_STATEMENT(LEVEL_ERR) \
+        (::gazebo::common::Console::err(__FILE__, __LINE__))
 
     /// \brief Output a message to a log file
-    #define gzlog (::gazebo::common::Console::log())
+    #define gzlog ::gazebo::common::ConsoleStatement() & \
+        (::gazebo::common::Console::log())
 
     /// \brief Initialize log file with filename given by _str.
     /// If called twice, it will close currently in use and open a new
@@ -65,8 +80,27 @@ namespace gazebo
     /// \return Full path of the directory
     #define gzLogDirectory() (::gazebo::common::Console::log.GetLogDirectory())
 
+    /// \class ConsoleStatement Console.hh common/common.hh
+    /// \brief Completes a statement of the logging macros: the message
+    /// written by the statement is handed to the console writer at once,
+    /// instead of piece by piece.
+    class GZ_COMMON_VISIBLE ConsoleStatement
+    {
+      /// \brief End the statement.
+      /// \param[in] _stream Stream the statement wrote to.
+      public: void operator&(std::ostream &_stream)
+              {
+                _stream.flush();
+              }
+    };
+
     /// \class FileLogger FileLogger.hh common/common.hh
     /// \brief A logger that outputs messages to a file.
+    ///
+    /// Text is collected in a buffer of the thread writing it and is
+    /// written once a message is complete: at the end of a gzlog
+    /// statement, when the stream is flushed, or when the thread starts
+    /// another message.
     class GZ_COMMON_VISIBLE FileLogger : public std::ostream
     {
       /// \brief Constructor.
@@ -117,11 +151,25 @@ namespace gazebo
                    /// \brief Destructor.
                    public: virtual ~Buffer();
 
-                   /// \brief Sync the stream (output the string buffer
-                   /// contents).
+                   /// \brief Sync the stream (output the message of the
+                   /// calling thread).
                    /// \return Return 0 on success.
                    public: virtual int sync();
 
+                   /// \brief Append characters to the message of the
+                   /// calling thread.
+                   /// \param[in] _s Characters to append.
+                   /// \param[in] _n Number of characters.
+                   /// \return Number of characters appended.
+                   public: virtual std::streamsize xsputn(const char *_s,
+                               std::streamsize _n);
+
+                   /// \brief Append a character to the message of the
+                   /// calling thread.
+                   /// \param[in] _c Character to append.
+                   /// \return The character.
+                   public: virtual int overflow(int _c);
+
                    /// \brief Stream to output information into.
                    public: std::ofstream *stream;
                  };
@@ -129,10 +177,14 @@ namespace gazebo
       /// \brief Stores the full path of the directory where all the log files
       /// are stored.
       private: std::string logDirectory;
+
+      /// \brief The writer outputs the messages of the buffer.
+      private: friend class ConsoleWriter;
     };
 
     /// \class Logger Logger.hh common/common.hh
-    /// \brief Terminal logger.
+    /// \brief Terminal logger. Messages are collected per thread like the
+    /// messages of FileLogger.
     class GZ_COMMON_VISIBLE Logger : public std::ostream
     {
       /// \enum LogType.
@@ -178,11 +230,25 @@ namespace gazebo
                    /// \brief Destructor.
                    public: virtual ~Buffer();
 
-                   /// \brief Sync the stream (output the string buffer
-                   /// contents).
+                   /// \brief Sync the stream (output the message of the
+                   /// calling thread).
                    /// \return Return 0 on success.
                    public: virtual int sync();
 
+                   /// \brief Append characters to the message of the
+                   /// calling thread.
+                   /// \param[in] _s Characters to append.
+                   /// \param[in] _n Number of characters.
+                   /// \return Number of characters appended.
+                   public: virtual std::streamsize xsputn(const char *_s,
+                               std::streamsize _n);
+
+                   /// \brief Append a character to the message of the
+                   /// calling thread.
+                   /// \param[in] _c Character to append.
+                   /// \return The character.
+                   public: virtual int overflow(int _c);
+
                    /// \brief Destination type for the messages.
                    public: LogType type;
 
@@ -197,6 +263,9 @@ namespace gazebo
 
       /// \brief Prefix to use when logging to file.
       private: std::string prefix;
+
+      /// \brief The writer outputs the messages of the buffer.
+      private: friend class ConsoleWriter;
     };
 
     /// \class Console Console.hh common/common.hh
@@ -204,6 +273,75 @@ namespace gazebo
     /// (such as verbose vs. quiet output).
     class GZ_COMMON_VISIBLE Console
     {
+      /// \enum LogLevel
+      /// \brief Level of a message, from the most to the least important.
+      public: enum LogLevel
+              {
+                /// \brief Error messages, gzerr.
+                LEVEL_ERR = 1,
+                /// \brief Warning messages, gzwarn.
+                LEVEL_WARN = 2,
+                /// \brief Informational messages, gzmsg.
+                LEVEL_MSG = 3,
+                /// \brief Debug messages, gzdbg.
+                LEVEL_DBG = 4
+              };
+
+      /// \brief Set the least important level of the messages that are
+      /// output. Statements of less important messages are not evaluated.
+      /// \param[in] _level The level, LEVEL_DBG by default.
+      public: static void SetVerbosity(const LogLevel _level);
+
+      /// \brief Get the least important level of the messages that are
+      /// output.
+      /// \return The level.
+      public: static LogLevel Verbosity();
+
+      /// \brief Check whether messages of a level are output.
+      /// \param[in] _level The level.
+      /// \return True if the messages are output.
+      public: static bool Enabled(const LogLevel _level)
+              {
+                return _level <= verbosity;
+              }
+
+      /// \brief Set whether messages are written by a background thread,
+      /// so that the threads logging them do not wait for the terminal or
+      /// the log file. Disabling it writes the queued messages first.
+      /// \param[in] _async True to write messages in the background,
+      /// false by default.
+      public: static void SetAsync(const bool _async);
+
+      /// \brief Get whether messages are written by a background thread.
+      /// \return True if messages are written in the background.
+      public: static bool Async();
+
+      /// \brief Wait until the messages logged so far are written.
+      public: static void Flush();
+
+      /// \brief Set the number of messages that each gzerr, gzwarn or gzdbg
+      /// statement may output per second. The number of messages dropped
+      /// is reported with the next message of the statement.
+      /// \param[in] _count Messages per second, 0 for no limit, which is
+      /// the default.
+      public: static void SetRateLimit(const unsigned int _count);
+
+      /// \brief Get the number of messages each statement may output per
+      /// second.
+      /// \return Messages per second, 0 for no limit.
+      public: static unsigned int RateLimit();
+
+      /// \brief Set whether a message repeating the previous message of the
+      /// same statement is dropped. The number of repeats is reported when
+      /// the statement outputs another message, or at most every second.
+      /// \param[in] _deduplicate True to drop repeated messages, false by
+      /// default.
+      public: static void SetDeduplicate(const bool _deduplicate);
+
+      /// \brief Get whether repeated messages are dropped.
+      /// \return True if repeated messages are dropped.
+      public: static bool Deduplicate();
+
       /// \brief Set quiet output.
       /// \param[in] q True to prevent warning.
       public: static void SetQuiet(bool _q);
@@ -229,6 +367,9 @@ namespace gazebo
 
       /// \brief Indicates if console messages should be quiet.
       private: static bool quiet;
+
+      /// \brief Least important level of the messages that are output.
+      private: static LogLevel verbosity;
     };
     /// \}
   }
@@ -18,6 +18,9 @@
 #include <gtest/gtest.h>
 #include <boost/filesystem.hpp>
 #include <stdlib.h>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include "gazebo/common/Time.hh"
 #include "gazebo/common/Console.hh"
@@ -274,6 +277,124 @@ TEST_F(Console_TEST, ColorErr)
   EXPECT_TRUE(logContent.find(logString) != std::string::npos);
 }
 
+/////////////////////////////////////////////////
+/// \brief Count the occurrences of a string.
+/// \param[in] _content String to search.
+/// \param[in] _str String to count.
+/// \return Number of occurrences.
+size_t count(const std::string &_content, const std::string &_str)
+{
+  size_t result = 0;
+  for (size_t pos = _content.find(_str); pos != std::string::npos;
+       pos = _content.find(_str, pos + _str.size()))
+  {
+    ++result;
+  }
+  return result;
+}
+
+/////////////////////////////////////////////////
+/// \brief Test Console::SetVerbosity
+TEST_F(Console_TEST, Verbosity)
+{
+  int evaluated = 0;
+  auto evaluate = [&evaluated]()
+  {
+    return ++evaluated;
+  };
+
+  gazebo::common::Console::SetVerbosity(
+      gazebo::common::Console::LEVEL_WARN);
+  EXPECT_EQ(gazebo::common::Console::LEVEL_WARN,
+      gazebo::common::Console::Verbosity());
+  EXPECT_TRUE(gazebo::common::Console::Enabled(
+      gazebo::common::Console::LEVEL_ERR));
+  EXPECT_FALSE(gazebo::common::Console::Enabled(
+      gazebo::common::Console::LEVEL_MSG));
+
+  gzdbg << "filtered debug " << evaluate() << std::endl;
+  gzmsg << "filtered msg " << evaluate() << std::endl;
+  gzwarn << "kept warning " << evaluate() << std::endl;
+  EXPECT_EQ(1, evaluated);
+
+  gazebo::common::Console::SetVerbosity(gazebo::common::Console::LEVEL_DBG);
+
+  std::string logContent = this->GetLogContent();
+  EXPECT_EQ(std::string::npos, logContent.find("filtered"));
+  EXPECT_NE(std::string::npos, logContent.find("kept warning 1"));
+}
+
+/////////////////////////////////////////////////
+/// \brief Test messages from several threads written in the background
+TEST_F(Console_TEST, Async)
+{
+  gazebo::common::Console::SetAsync(true);
+  EXPECT_TRUE(gazebo::common::Console::Async());
+
+  const int threadCount = 4;
+  const int messageCount = 100;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < threadCount; ++t)
+  {
+    threads.push_back(std::thread([t]()
+    {
+      for (int i = 0; i < messageCount; ++i)
+        gzlog << "thread " << t << " message " << i << '\n';
+    }));
+  }
+  for (auto &thread : threads)
+    thread.join();
+
+  gazebo::common::Console::Flush();
+  std::string logContent = this->GetLogContent();
+  for (int t = 0; t < threadCount; ++t)
+  {
+    for (int i = 0; i < messageCount; ++i)
+    {
+      std::ostringstream stream;
+      stream << "thread " << t << " message " << i;
+      EXPECT_NE(std::string::npos, logContent.find(stream.str()));
+    }
+  }
+
+  gazebo::common::Console::SetAsync(false);
+  EXPECT_FALSE(gazebo::common::Console::Async());
+}
+
+/////////////////////////////////////////////////
+/// \brief Test Console::SetDeduplicate
+TEST_F(Console_TEST, Deduplicate)
+{
+  gazebo::common::Console::SetDeduplicate(true);
+  EXPECT_TRUE(gazebo::common::Console::Deduplicate());
+
+  for (int i = 0; i <= 10; ++i)
+    gzwarn << (i < 10 ? "repeated" : "other") << " warning\n";
+
+  gazebo::common::Console::SetDeduplicate(false);
+
+  std::string logContent = this->GetLogContent();
+  EXPECT_EQ(1u, count(logContent, "repeated warning"));
+  EXPECT_NE(std::string::npos, logContent.find("repeated 9 times"));
+  EXPECT_EQ(1u, count(logContent, "other warning"));
+}
+
+/////////////////////////////////////////////////
+/// \brief Test Console::SetRateLimit
+TEST_F(Console_TEST, RateLimit)
+{
+  gazebo::common::Console::SetRateLimit(5);
+  EXPECT_EQ(5u, gazebo::common::Console::RateLimit());
+
+  for (int i = 0; i < 20; ++i)
+    gzerr << "limited error " << i << "\n";
+
+  gazebo::common::Console::SetRateLimit(0);
+
+  std::string logContent = this->GetLogContent();
+  EXPECT_EQ(5u, count(logContent, "limited error"));
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
@@ -0,0 +1,722 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/common/ConvexDecomposition.hh"
+
+namespace gazebo
+{
+  namespace common
+  {
+    /// \internal
+    /// \brief Private data for the ConvexDecomposition class
+    class ConvexDecompositionPrivate
+    {
+      /// \brief Maximum number of hulls.
+      public: unsigned int maxHulls = 16;
+
+      /// \brief Concavity below which a part isn't split, as a fraction of
+      /// the diagonal of the bounding box of the mesh.
+      public: double concavity = 0.01;
+    };
+  }
+}
+
+using namespace gazebo;
+using namespace common;
+
+namespace
+{
+  /// \brief Maximum number of vertices, and of triangles, used to evaluate
+  /// a cut.
+  const size_t kMaxSamples = 512;
+
+  /// \brief Number of cut positions tried along each axis.
+  const unsigned int kCutsPerAxis = 3;
+
+  /// \brief Magic number of the files written by ConvexDecomposition::Save.
+  const char kMagic[4] = {'G', 'Z', 'C', 'H'};
+
+  /// \brief Version of the files written by ConvexDecomposition::Save.
+  const uint32_t kVersion = 1;
+
+  /// \brief Plane of a face of a hull.
+  struct Plane
+  {
+    /// \brief Outward unit normal.
+    ignition::math::Vector3d normal;
+
+    /// \brief Distance of the plane from the origin along the normal.
+    double offset;
+  };
+
+  /// \brief Triangle of a part.
+  struct Triangle
+  {
+    /// \brief Corners of the triangle, counter clockwise.
+    ignition::math::Vector3d v[3];
+
+    /// \brief Get the normal of the triangle, scaled by twice its area.
+    /// \return The normal.
+    ignition::math::Vector3d Normal() const
+    {
+      return (this->v[1] - this->v[0]).Cross(this->v[2] - this->v[0]);
+    }
+  };
+
+  /// \brief Part of a mesh being decomposed.
+  struct Part
+  {
+    /// \brief Triangles of the part.
+    std::vector<Triangle> triangles;
+
+    /// \brief Concavity of the part.
+    double concavity = 0;
+  };
+
+  /// \brief Compute the planes of the faces of a hull.
+  /// \param[in] _hull The hull.
+  /// \return One plane per face.
+  std::vector<Plane> HullPlanes(const ConvexHull &_hull)
+  {
+    std::vector<Plane> planes;
+    for (size_t i = 0; i + 2 < _hull.indices.size(); i += 3)
+    {
+      const auto &a = _hull.vertices[_hull.indices[i]];
+      const auto &b = _hull.vertices[_hull.indices[i+1]];
+      const auto &c = _hull.vertices[_hull.indices[i+2]];
+      Plane plane;
+      plane.normal = (b - a).Cross(c - a).Normalize();
+      plane.offset = plane.normal.Dot(a);
+      planes.push_back(plane);
+    }
+    return planes;
+  }
+
+  /// \brief Get the corners of the triangles of a part.
+  /// \param[in] _part The part.
+  /// \param[in] _maxPoints Maximum number of points returned. Larger parts
+  /// are sampled uniformly.
+  /// \return The points.
+  std::vector<ignition::math::Vector3d> PartPoints(const Part &_part,
+      const size_t _maxPoints)
+  {
+    const size_t count = 3 * _part.triangles.size();
+    const double stride = std::max(1.0,
+        static_cast<double>(count) / _maxPoints);
+    std::vector<ignition::math::Vector3d> points;
+    for (double i = 0; i < count; i += stride)
+    {
+      const size_t index = static_cast<size_t>(i);
+      points.push_back(_part.triangles[index / 3].v[index % 3]);
+    }
+    return points;
+  }
+
+  /// \brief Compute the hull of a part. Flat parts are given a thickness
+  /// behind their surface.
+  /// \param[in] _part The part.
+  /// \param[in] _maxPoints Maximum number of points used.
+  /// \param[in] _thickness Thickness given to flat parts.
+  /// \param[out] _hull The hull.
+  /// \return False if no hull could be computed.
+  bool PartHull(const Part &_part, const size_t _maxPoints,
+      const double _thickness, ConvexHull &_hull)
+  {
+    std::vector<ignition::math::Vector3d> points =
+      PartPoints(_part, _maxPoints);
+    if (ConvexDecomposition::Hull(points, _hull))
+      return true;
+
+    ignition::math::Vector3d normal;
+    for (auto const &t : _part.triangles)
+      normal += t.Normal();
+    if (normal == ignition::math::Vector3d::Zero)
+      return false;
+    normal.Normalize();
+
+    const size_t count = points.size();
+    for (size_t i = 0; i < count; ++i)
+      points.push_back(points[i] - normal * _thickness);
+    return ConvexDecomposition::Hull(points, _hull);
+  }
+
+  /// \brief Compute the concavity of a part: the largest distance from the
+  /// centroid of a triangle of the part to the boundary of the hull, along
+  /// the normal of the triangle.
+  /// \param[in] _part The part.
+  /// \param[in] _thickness Thickness given to flat parts.
+  /// \return The concavity.
+  double PartConcavity(const Part &_part, const double _thickness)
+  {
+    ConvexHull hull;
+    if (!PartHull(_part, kMaxSamples, _thickness, hull))
+      return 0;
+
+    const std::vector<Plane> planes = HullPlanes(hull);
+    const double stride = std::max(1.0,
+        static_cast<double>(_part.triangles.size()) / kMaxSamples);
+    double concavity = 0;
+    for (double i = 0; i < _part.triangles.size(); i += stride)
+    {
+      const Triangle &t = _part.triangles[static_cast<size_t>(i)];
+      const auto p = (t.v[0] + t.v[1] + t.v[2]) / 3.0;
+      const auto n = t.Normal().Normalize();
+      double exit = std::numeric_limits<double>::max();
+      for (auto const &plane : planes)
+      {
+        double denom = plane.normal.Dot(n);
+        if (denom > 1e-12)
+          exit = std::min(exit, (plane.offset - plane.normal.Dot(p)) / denom);
+      }
+      if (exit < std::numeric_limits<double>::max())
+        concavity = std::max(concavity, exit);
+    }
+    return concavity;
+  }
+
+  /// \brief Cut the triangles of a part with an axis aligned plane.
+  /// Triangles that cross the plane are clipped.
+  /// \param[in] _part The part.
+  /// \param[in] _axis Axis normal to the plane.
+  /// \param[in] _cut Position of the plane along the axis.
+  /// \param[out] _below Triangles below the plane.
+  /// \param[out] _above Triangles above the plane.
+  void CutPart(const Part &_part, const unsigned int _axis,
+      const double _cut, Part &_below, Part &_above)
+  {
+    // Append the fan triangulation of a convex polygon
+    auto fan = [](const std::vector<ignition::math::Vector3d> &_polygon,
+        Part &_out)
+    {
+      for (size_t i = 1; i + 1 < _polygon.size(); ++i)
+      {
+        Triangle t;
+        t.v[0] = _polygon[0];
+        t.v[1] = _polygon[i];
+        t.v[2] = _polygon[i+1];
+        _out.triangles.push_back(t);
+      }
+    };
+
+    std::vector<ignition::math::Vector3d> below, above;
+    for (auto const &t : _part.triangles)
+    {
+      double d[3];
+      for (unsigned int k = 0; k < 3; ++k)
+        d[k] = t.v[k][_axis] - _cut;
+
+      if (d[0] <= 0 && d[1] <= 0 && d[2] <= 0)
+      {
+        _below.triangles.push_back(t);
+        continue;
+      }
+      if (d[0] >= 0 && d[1] >= 0 && d[2] >= 0)
+      {
+        _above.triangles.push_back(t);
+        continue;
+      }
+
+      below.clear();
+      above.clear();
+      for (unsigned int k = 0; k < 3; ++k)
+      {
+        const unsigned int n = (k + 1) % 3;
+        if (d[k] <= 0)
+          below.push_back(t.v[k]);
+        if (d[k] >= 0)
+          above.push_back(t.v[k]);
+        if ((d[k] < 0 && d[n] > 0) || (d[k] > 0 && d[n] < 0))
+        {
+          const auto p = t.v[k] + (t.v[n] - t.v[k]) * (d[k] / (d[k] - d[n]));
+          below.push_back(p);
+          above.push_back(p);
+        }
+      }
+      fan(below, _below);
+      fan(above, _above);
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+ConvexDecomposition::ConvexDecomposition()
+  : dataPtr(new ConvexDecompositionPrivate)
+{
+}
+
+//////////////////////////////////////////////////
+ConvexDecomposition::~ConvexDecomposition()
+{
+}
+
+//////////////////////////////////////////////////
+void ConvexDecomposition::SetMaxHulls(const unsigned int _maxHulls)
+{
+  this->dataPtr->maxHulls = std::max(1u, _maxHulls);
+}
+
+//////////////////////////////////////////////////
+unsigned int ConvexDecomposition::MaxHulls() const
+{
+  return this->dataPtr->maxHulls;
+}
+
+//////////////////////////////////////////////////
+void ConvexDecomposition::SetConcavity(const double _concavity)
+{
+  this->dataPtr->concavity = std::max(0.0, _concavity);
+}
+
+//////////////////////////////////////////////////
+double ConvexDecomposition::Concavity() const
+{
+  return this->dataPtr->concavity;
+}
+
+//////////////////////////////////////////////////
+bool ConvexDecomposition::Decompose(const float *_vertices,
+    const unsigned int _numVertices, const int *_indices,
+    const unsigned int _numIndices, std::vector<ConvexHull> &_hulls) const
+{
+  _hulls.clear();
+  if (!_vertices || !_indices || _numVertices == 0 || _numIndices < 3)
+    return false;
+
+  for (unsigned int i = 0; i < _numIndices; ++i)
+  {
+    if (_indices[i] < 0 || static_cast<unsigned int>(_indices[i]) >=
+        _numVertices)
+    {
+      gzerr << "Invalid vertex index [" << _indices[i] << "]\n";
+      return false;
+    }
+  }
+
+  std::vector<Part> parts(1);
+  ignition::math::Vector3d min(_vertices[0], _vertices[1], _vertices[2]);
+  ignition::math::Vector3d max = min;
+  for (unsigned int i = 0; i + 2 < _numIndices; i += 3)
+  {
+    Triangle t;
+    for (unsigned int k = 0; k < 3; ++k)
+    {
+      const float *v = _vertices + 3 * _indices[i + k];
+      t.v[k].Set(v[0], v[1], v[2]);
+      min.Min(t.v[k]);
+      max.Max(t.v[k]);
+    }
+    parts[0].triangles.push_back(t);
+  }
+
+  const double diagonal = (max - min).Length();
+  if (diagonal <= 0)
+    return false;
+
+  const double threshold = this->dataPtr->concavity * diagonal;
+  const double thickness = 0.01 * diagonal;
+  parts[0].concavity = PartConcavity(parts[0], thickness);
+
+  while (parts.size() < this->dataPtr->maxHulls)
+  {
+    // Split the most concave part
+    auto worst = std::max_element(parts.begin(), parts.end(),
+        [](const Part &_a, const Part &_b)
+        {
+          return _a.concavity < _b.concavity;
+        });
+    if (worst->concavity <= threshold)
+      break;
+
+    ignition::math::Vector3d partMin = worst->triangles[0].v[0];
+    ignition::math::Vector3d partMax = partMin;
+    for (auto const &t : worst->triangles)
+    {
+      for (auto const &v : t.v)
+      {
+        partMin.Min(v);
+        partMax.Max(v);
+      }
+    }
+
+    // Try a few axis aligned cuts, keep the one with the least concave
+    // halves.
+    double bestCost = std::numeric_limits<double>::max();
+    Part bestBelow, bestAbove;
+    for (unsigned int axis = 0; axis < 3; ++axis)
+    {
+      for (unsigned int k = 1; k <= kCutsPerAxis; ++k)
+      {
+        const double cut = partMin[axis] +
+          (partMax[axis] - partMin[axis]) * k / (kCutsPerAxis + 1);
+        Part below, above;
+        CutPart(*worst, axis, cut, below, above);
+        if (below.triangles.empty() || above.triangles.empty())
+          continue;
+
+        below.concavity = PartConcavity(below, thickness);
+        above.concavity = PartConcavity(above, thickness);
+        const double cost = std::max(below.concavity, above.concavity);
+        if (cost < bestCost)
+        {
+          bestCost = cost;
+          bestBelow = std::move(below);
+          bestAbove = std::move(above);
+        }
+      }
+    }
+
+    // The part can't be cut, e.g. it is flat
+    if (bestBelow.triangles.empty())
+    {
+      worst->concavity = 0;
+      continue;
+    }
+
+    *worst = std::move(bestBelow);
+    parts.push_back(std::move(bestAbove));
+  }
+
+  for (auto const &part : parts)
+  {
+    ConvexHull hull;
+    if (PartHull(part, std::numeric_limits<size_t>::max(), thickness, hull))
+      _hulls.push_back(hull);
+  }
+
+  return !_hulls.empty();
+}
+
+//////////////////////////////////////////////////
+bool ConvexDecomposition::Hull(
+    const std::vector<ignition::math::Vector3d> &_points, ConvexHull &_hull)
+{
+  _hull.vertices.clear();
+  _hull.indices.clear();
+  if (_points.size() < 4)
+    return false;
+
+  ignition::math::Vector3d min = _points[0];
+  ignition::math::Vector3d max = _points[0];
+  for (auto const &p : _points)
+  {
+    min.Min(p);
+    max.Max(p);
+  }
+  const double eps = 1e-7 * (max - min).Length();
+  if (eps <= 0)
+    return false;
+
+  // Initial tetrahedron
+  size_t i0 = 0;
+  for (size_t i = 1; i < _points.size(); ++i)
+  {
+    if (_points[i].X() < _points[i0].X())
+      i0 = i;
+  }
+
+  auto farthest = [&](const std::function<double(
+        const ignition::math::Vector3d &)> &_dist, double &_max)
+  {
+    size_t best = 0;
+    _max = -1;
+    for (size_t i = 0; i < _points.size(); ++i)
+    {
+      double d = _dist(_points[i]);
+      if (d > _max)
+      {
+        _max = d;
+        best = i;
+      }
+    }
+    return best;
+  };
+
+  const auto &p0 = _points[i0];
+  double dist;
+  size_t i1 = farthest([&](const ignition::math::Vector3d &_p)
+      {
+        return _p.Distance(p0);
+      }, dist);
+  if (dist <= eps)
+    return false;
+
+  const auto dir = (_points[i1] - p0).Normalize();
+  size_t i2 = farthest([&](const ignition::math::Vector3d &_p)
+      {
+        return (_p - p0).Cross(dir).Length();
+      }, dist);
+  if (dist <= eps)
+    return false;
+
+  const auto normal = (_points[i1] - p0).Cross(_points[i2] - p0).Normalize();
+  size_t i3 = farthest([&](const ignition::math::Vector3d &_p)
+      {
+        return std::abs(normal.Dot(_p - p0));
+      }, dist);
+  if (dist <= eps)
+    return false;
+
+  struct Face
+  {
+    unsigned int v[3];
+    ignition::math::Vector3d normal;
+    double offset;
+    bool alive;
+  };
+  std::vector<Face> faces;
+  std::unordered_map<uint64_t, unsigned int> edges;
+  auto edgeKey = [](const unsigned int _a, const unsigned int _b)
+  {
+    return (static_cast<uint64_t>(_a) << 32) | _b;
+  };
+
+  auto addFace = [&](unsigned int _a, unsigned int _b, unsigned int _c)
+  {
+    Face face;
+    face.v[0] = _a;
+    face.v[1] = _b;
+    face.v[2] = _c;
+    face.normal = (_points[_b] - _points[_a]).Cross(
+        _points[_c] - _points[_a]).Normalize();
+    face.offset = face.normal.Dot(_points[_a]);
+    face.alive = true;
+    unsigned int index = static_cast<unsigned int>(faces.size());
+    faces.push_back(face);
+    edges[edgeKey(_a, _b)] = index;
+    edges[edgeKey(_b, _c)] = index;
+    edges[edgeKey(_c, _a)] = index;
+  };
+
+  const auto inside = (_points[i0] + _points[i1] + _points[i2] +
+      _points[i3]) / 4.0;
+  const unsigned int simplex[4] = {static_cast<unsigned int>(i0),
+    static_cast<unsigned int>(i1), static_cast<unsigned int>(i2),
+    static_cast<unsigned int>(i3)};
+  const unsigned int simplexFaces[4][3] =
+    {{0, 1, 2}, {0, 1, 3}, {0, 2, 3}, {1, 2, 3}};
+  for (auto const &f : simplexFaces)
+  {
+    unsigned int a = simplex[f[0]];
+    unsigned int b = simplex[f[1]];
+    unsigned int c = simplex[f[2]];
+    auto n = (_points[b] - _points[a]).Cross(_points[c] - _points[a]);
+    if (n.Dot(inside - _points[a]) > 0)
+      std::swap(b, c);
+    addFace(a, b, c);
+  }
+
+  // Add the points one at a time
+  std::vector<char> visible;
+  std::vector<std::pair<unsigned int, unsigned int>> horizon;
+  for (size_t i = 0; i < _points.size(); ++i)
+  {
+    if (i == i0 || i == i1 || i == i2 || i == i3)
+      continue;
+
+    const auto &p = _points[i];
+
+    // Start from the face the point is farthest above
+    size_t top = faces.size();
+    double topDist = eps;
+    for (size_t f = 0; f < faces.size(); ++f)
+    {
+      if (!faces[f].alive)
+        continue;
+      double d = faces[f].normal.Dot(p) - faces[f].offset;
+      if (d > topDist)
+      {
+        topDist = d;
+        top = f;
+      }
+    }
+    if (top == faces.size())
+      continue;
+
+    // The visible faces are the ones connected to it that the point is
+    // above, this keeps the horizon a single loop.
+    visible.assign(faces.size(), 0);
+    visible[top] = 1;
+    std::vector<size_t> stack(1, top);
+    while (!stack.empty())
+    {
+      size_t f = stack.back();
+      stack.pop_back();
+      for (unsigned int k = 0; k < 3; ++k)
+      {
+        auto neighbor = edges.find(
+            edgeKey(faces[f].v[(k+1) % 3], faces[f].v[k]));
+        if (neighbor == edges.end() || visible[neighbor->second])
+          continue;
+        const Face &face = faces[neighbor->second];
+        if (face.normal.Dot(p) - face.offset > eps)
+        {
+          visible[neighbor->second] = 1;
+          stack.push_back(neighbor->second);
+        }
+      }
+    }
+
+    horizon.clear();
+    for (size_t f = 0; f < faces.size(); ++f)
+    {
+      if (!visible[f])
+        continue;
+      for (unsigned int k = 0; k < 3; ++k)
+      {
+        unsigned int a = faces[f].v[k];
+        unsigned int b = faces[f].v[(k+1) % 3];
+        auto neighbor = edges.find(edgeKey(b, a));
+        if (neighbor == edges.end() || !visible[neighbor->second])
+          horizon.emplace_back(a, b);
+      }
+    }
+
+    for (size_t f = 0; f < faces.size(); ++f)
+    {
+      if (!visible[f])
+        continue;
+      faces[f].alive = false;
+      for (unsigned int k = 0; k < 3; ++k)
+      {
+        auto edge = edges.find(edgeKey(faces[f].v[k], faces[f].v[(k+1) % 3]));
+        if (edge != edges.end() && edge->second == f)
+          edges.erase(edge);
+      }
+    }
+
+    for (auto const &edge : horizon)
+      addFace(edge.first, edge.second, static_cast<unsigned int>(i));
+  }
+
+  // Keep the vertices that are used by a face
+  std::unordered_map<unsigned int, unsigned int> remap;
+  for (auto const &face : faces)
+  {
+    if (!face.alive)
+      continue;
+    for (unsigned int k = 0; k < 3; ++k)
+    {
+      auto iter = remap.find(face.v[k]);
+      if (iter == remap.end())
+      {
+        iter = remap.emplace(face.v[k],
+            static_cast<unsigned int>(_hull.vertices.size())).first;
+        _hull.vertices.push_back(_points[face.v[k]]);
+      }
+      _hull.indices.push_back(iter->second);
+    }
+  }
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool ConvexDecomposition::Save(const std::string &_filename,
+    const std::vector<ConvexHull> &_hulls)
+{
+  std::ofstream out(_filename, std::ios::binary);
+  if (!out)
+    return false;
+
+  auto writeU32 = [&out](const uint32_t _value)
+  {
+    out.write(reinterpret_cast<const char *>(&_value), sizeof(_value));
+  };
+
+  out.write(kMagic, sizeof(kMagic));
+  writeU32(kVersion);
+  writeU32(static_cast<uint32_t>(_hulls.size()));
+  for (auto const &hull : _hulls)
+  {
+    writeU32(static_cast<uint32_t>(hull.vertices.size()));
+    for (auto const &v : hull.vertices)
+    {
+      const double xyz[3] = {v.X(), v.Y(), v.Z()};
+      out.write(reinterpret_cast<const char *>(xyz), sizeof(xyz));
+    }
+    writeU32(static_cast<uint32_t>(hull.indices.size()));
+    for (auto i : hull.indices)
+      writeU32(i);
+  }
+
+  return static_cast<bool>(out);
+}
+
+//////////////////////////////////////////////////
+bool ConvexDecomposition::Load(const std::string &_filename,
+    std::vector<ConvexHull> &_hulls)
+{
+  _hulls.clear();
+  std::ifstream in(_filename, std::ios::binary);
+  if (!in)
+    return false;
+
+  auto readU32 = [&in](uint32_t &_value)
+  {
+    return static_cast<bool>(
+        in.read(reinterpret_cast<char *>(&_value), sizeof(_value)));
+  };
+
+  char magic[sizeof(kMagic)];
+  uint32_t version = 0;
+  uint32_t count = 0;
+  if (!in.read(magic, sizeof(magic)) ||
+      std::memcmp(magic, kMagic, sizeof(kMagic)) != 0 ||
+      !readU32(version) || version != kVersion || !readU32(count))
+  {
+    return false;
+  }
+
+  for (uint32_t h = 0; h < count; ++h)
+  {
+    ConvexHull hull;
+    uint32_t numVertices = 0;
+    if (!readU32(numVertices))
+      return false;
+    for (uint32_t i = 0; i < numVertices; ++i)
+    {
+      double xyz[3];
+      if (!in.read(reinterpret_cast<char *>(xyz), sizeof(xyz)))
+        return false;
+      hull.vertices.emplace_back(xyz[0], xyz[1], xyz[2]);
+    }
+
+    uint32_t numIndices = 0;
+    if (!readU32(numIndices) || numIndices % 3 != 0)
+      return false;
+    for (uint32_t i = 0; i < numIndices; ++i)
+    {
+      uint32_t index = 0;
+      if (!readU32(index) || index >= numVertices)
+        return false;
+      hull.indices.push_back(index);
+    }
+    _hulls.push_back(hull);
+  }
+
+  return true;
+}
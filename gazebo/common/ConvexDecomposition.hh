@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_COMMON_CONVEXDECOMPOSITION_HH_
+#define GAZEBO_COMMON_CONVEXDECOMPOSITION_HH_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <ignition/math/Vector3.hh>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace common
+  {
+    // Forward declare private data class.
+    class ConvexDecompositionPrivate;
+
+    /// \addtogroup gazebo_common Common
+    /// \{
+
+    /// \class ConvexHull ConvexDecomposition.hh common/common.hh
+    /// \brief A convex polyhedron with triangular faces.
+    class GZ_COMMON_VISIBLE ConvexHull
+    {
+      /// \brief Vertices of the hull.
+      public: std::vector<ignition::math::Vector3d> vertices;
+
+      /// \brief Three vertex indices per face, counter clockwise when seen
+      /// from outside of the hull.
+      public: std::vector<unsigned int> indices;
+    };
+
+    /// \class ConvexDecomposition ConvexDecomposition.hh common/common.hh
+    /// \brief Approximates a concave triangle mesh with a set of convex
+    /// hulls.
+    ///
+    /// The mesh is split recursively, in the spirit of (V-)HACD: the part
+    /// with the largest concavity is cut by the axis aligned plane that
+    /// minimizes the concavity of the two halves, until every part is
+    /// convex enough or the maximum number of hulls is reached. The
+    /// concavity of a part is the largest distance, along the surface
+    /// normal, from a vertex of the part to the boundary of its hull.
+    class GZ_COMMON_VISIBLE ConvexDecomposition
+    {
+      /// \brief Constructor.
+      public: ConvexDecomposition();
+
+      /// \brief Destructor.
+      public: virtual ~ConvexDecomposition();
+
+      /// \brief Set the maximum number of hulls of a decomposition.
+      /// \param[in] _maxHulls Maximum number of hulls, at least one.
+      public: void SetMaxHulls(const unsigned int _maxHulls);
+
+      /// \brief Get the maximum number of hulls of a decomposition.
+      /// \return Maximum number of hulls.
+      public: unsigned int MaxHulls() const;
+
+      /// \brief Set the concavity below which a part isn't split.
+      /// \param[in] _concavity Concavity, as a fraction of the diagonal of
+      /// the bounding box of the mesh.
+      public: void SetConcavity(const double _concavity);
+
+      /// \brief Get the concavity below which a part isn't split.
+      /// \return Concavity, as a fraction of the diagonal of the bounding
+      /// box of the mesh.
+      public: double Concavity() const;
+
+      /// \brief Decompose a triangle mesh, given by the arrays returned by
+      /// Mesh::FillArrays.
+      /// \param[in] _vertices Vertex array, three values per vertex.
+      /// \param[in] _numVertices Number of vertices.
+      /// \param[in] _indices Index array, three indices per triangle.
+      /// \param[in] _numIndices Number of indices.
+      /// \param[out] _hulls The convex hulls.
+      /// \return False if the mesh has no volume.
+      public: bool Decompose(const float *_vertices,
+                  const unsigned int _numVertices, const int *_indices,
+                  const unsigned int _numIndices,
+                  std::vector<ConvexHull> &_hulls) const;
+
+      /// \brief Compute the convex hull of a set of points. Flat sets of
+      /// points don't have a hull.
+      /// \param[in] _points The points.
+      /// \param[out] _hull The convex hull.
+      /// \return False if the points are coplanar.
+      public: static bool Hull(
+                  const std::vector<ignition::math::Vector3d> &_points,
+                  ConvexHull &_hull);
+
+      /// \brief Save hulls to a binary file.
+      /// \param[in] _filename Path of the file.
+      /// \param[in] _hulls Hulls to save.
+      /// \return True if the file was written.
+      public: static bool Save(const std::string &_filename,
+                  const std::vector<ConvexHull> &_hulls);
+
+      /// \brief Load hulls saved with Save.
+      /// \param[in] _filename Path of the file.
+      /// \param[out] _hulls The hulls.
+      /// \return False if the file doesn't exist or is invalid.
+      public: static bool Load(const std::string &_filename,
+                  std::vector<ConvexHull> &_hulls);
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<ConvexDecompositionPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,180 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <boost/filesystem.hpp>
+#include <vector>
+
+#include "gazebo/common/ConvexDecomposition.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class ConvexDecompositionTest : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+/// \brief Append the triangles of an axis aligned box to mesh arrays.
+/// \param[in] _min Minimum corner of the box.
+/// \param[in] _max Maximum corner of the box.
+/// \param[in,out] _vertices Vertex array.
+/// \param[in,out] _indices Index array.
+static void AddBox(const ignition::math::Vector3d &_min,
+    const ignition::math::Vector3d &_max, std::vector<float> &_vertices,
+    std::vector<int> &_indices)
+{
+  const int first = static_cast<int>(_vertices.size() / 3);
+  for (int i = 0; i < 8; ++i)
+  {
+    _vertices.push_back((i & 1) ? _max.X() : _min.X());
+    _vertices.push_back((i & 2) ? _max.Y() : _min.Y());
+    _vertices.push_back((i & 4) ? _max.Z() : _min.Z());
+  }
+
+  // Two counter clockwise triangles per side
+  const int faces[12][3] = {
+    {0, 2, 1}, {1, 2, 3}, {4, 5, 6}, {5, 7, 6},
+    {0, 1, 4}, {1, 5, 4}, {2, 6, 3}, {3, 6, 7},
+    {0, 4, 2}, {2, 4, 6}, {1, 3, 5}, {3, 7, 5}};
+  for (auto const &face : faces)
+  {
+    for (auto index : face)
+      _indices.push_back(first + index);
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Check if a point is inside of a hull.
+/// \param[in] _hull The hull.
+/// \param[in] _point The point.
+/// \return True if the point is inside.
+static bool Inside(const common::ConvexHull &_hull,
+    const ignition::math::Vector3d &_point)
+{
+  for (size_t i = 0; i < _hull.indices.size(); i += 3)
+  {
+    const auto &a = _hull.vertices[_hull.indices[i]];
+    const auto &b = _hull.vertices[_hull.indices[i+1]];
+    const auto &c = _hull.vertices[_hull.indices[i+2]];
+    if ((b - a).Cross(c - a).Dot(_point - a) > 0)
+      return false;
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+TEST_F(ConvexDecompositionTest, Hull)
+{
+  // Corners of a unit cube, plus interior and duplicate points
+  std::vector<ignition::math::Vector3d> points;
+  for (int i = 0; i < 8; ++i)
+    points.emplace_back(i & 1, (i & 2) >> 1, (i & 4) >> 2);
+  points.emplace_back(0.5, 0.5, 0.5);
+  points.emplace_back(0.2, 0.7, 0.4);
+  points.emplace_back(1, 1, 1);
+
+  common::ConvexHull hull;
+  ASSERT_TRUE(common::ConvexDecomposition::Hull(points, hull));
+  EXPECT_EQ(8u, hull.vertices.size());
+  EXPECT_EQ(36u, hull.indices.size());
+
+  // Faces point outward
+  EXPECT_TRUE(Inside(hull, ignition::math::Vector3d(0.5, 0.5, 0.5)));
+  EXPECT_FALSE(Inside(hull, ignition::math::Vector3d(1.5, 0.5, 0.5)));
+  EXPECT_FALSE(Inside(hull, ignition::math::Vector3d(0.5, -0.5, 0.5)));
+
+  // Coplanar points have no hull
+  std::vector<ignition::math::Vector3d> flat;
+  for (int i = 0; i < 4; ++i)
+    flat.emplace_back(i & 1, (i & 2) >> 1, 0);
+  EXPECT_FALSE(common::ConvexDecomposition::Hull(flat, hull));
+}
+
+/////////////////////////////////////////////////
+TEST_F(ConvexDecompositionTest, Convex)
+{
+  std::vector<float> vertices;
+  std::vector<int> indices;
+  AddBox(ignition::math::Vector3d(-1, -2, -3),
+      ignition::math::Vector3d(1, 2, 3), vertices, indices);
+
+  common::ConvexDecomposition decomposition;
+  std::vector<common::ConvexHull> hulls;
+  ASSERT_TRUE(decomposition.Decompose(vertices.data(),
+        vertices.size() / 3, indices.data(), indices.size(), hulls));
+  ASSERT_EQ(1u, hulls.size());
+  EXPECT_EQ(8u, hulls[0].vertices.size());
+}
+
+/////////////////////////////////////////////////
+TEST_F(ConvexDecompositionTest, Bin)
+{
+  // An open box: a floor and four walls
+  std::vector<float> vertices;
+  std::vector<int> indices;
+  AddBox(ignition::math::Vector3d(-1, -1, 0),
+      ignition::math::Vector3d(1, 1, 0.1), vertices, indices);
+  AddBox(ignition::math::Vector3d(-1, -1, 0),
+      ignition::math::Vector3d(-0.9, 1, 1), vertices, indices);
+  AddBox(ignition::math::Vector3d(0.9, -1, 0),
+      ignition::math::Vector3d(1, 1, 1), vertices, indices);
+  AddBox(ignition::math::Vector3d(-1, -1, 0),
+      ignition::math::Vector3d(1, -0.9, 1), vertices, indices);
+  AddBox(ignition::math::Vector3d(-1, 0.9, 0),
+      ignition::math::Vector3d(1, 1, 1), vertices, indices);
+
+  common::ConvexDecomposition decomposition;
+  EXPECT_EQ(16u, decomposition.MaxHulls());
+  decomposition.SetMaxHulls(0);
+  EXPECT_EQ(1u, decomposition.MaxHulls());
+  decomposition.SetMaxHulls(8);
+  decomposition.SetConcavity(0.05);
+  EXPECT_DOUBLE_EQ(0.05, decomposition.Concavity());
+
+  std::vector<common::ConvexHull> hulls;
+  ASSERT_TRUE(decomposition.Decompose(vertices.data(),
+        vertices.size() / 3, indices.data(), indices.size(), hulls));
+  EXPECT_GT(hulls.size(), 1u);
+  EXPECT_LE(hulls.size(), 8u);
+
+  // The hulls leave the inside of the bin empty
+  for (auto const &hull : hulls)
+    EXPECT_FALSE(Inside(hull, ignition::math::Vector3d(0, 0, 0.5)));
+
+  // Saved hulls load back unchanged
+  boost::filesystem::path path = boost::filesystem::temp_directory_path() /
+    boost::filesystem::unique_path("convex_decomposition_%%%%.hulls");
+  ASSERT_TRUE(common::ConvexDecomposition::Save(path.string(), hulls));
+
+  std::vector<common::ConvexHull> loaded;
+  ASSERT_TRUE(common::ConvexDecomposition::Load(path.string(), loaded));
+  ASSERT_EQ(hulls.size(), loaded.size());
+  for (size_t i = 0; i < hulls.size(); ++i)
+  {
+    EXPECT_EQ(hulls[i].vertices, loaded[i].vertices);
+    EXPECT_EQ(hulls[i].indices, loaded[i].indices);
+  }
+  boost::filesystem::remove(path);
+
+  EXPECT_FALSE(common::ConvexDecomposition::Load(path.string(), loaded));
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
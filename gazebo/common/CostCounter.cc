@@ -0,0 +1,212 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+
+#include "gazebo/common/CostCounter.hh"
+
+using namespace gazebo;
+using namespace common;
+
+/// \internal
+/// \brief Private data for the CostCounter class.
+class gazebo::common::CostCounterPrivate
+{
+  /// \brief Group of the counter.
+  public: std::string group;
+
+  /// \brief Name of the counter.
+  public: std::string name;
+
+  /// \brief Total time (nanoseconds).
+  public: std::atomic<uint64_t> time{0};
+
+  /// \brief Number of durations.
+  public: std::atomic<uint64_t> count{0};
+
+  /// \brief Number of allocations.
+  public: std::atomic<uint64_t> allocations{0};
+
+  /// \brief Bytes allocated.
+  public: std::atomic<uint64_t> allocationBytes{0};
+
+  /// \brief Counter to which the durations are added as well.
+  public: CostCounterPtr parent;
+};
+
+/// \brief Mutex of the registered counters.
+static std::mutex g_costMutex;
+
+/// \brief The registered counters.
+static std::vector<std::weak_ptr<CostCounter>> g_costCounters;
+
+/// \brief Counter made current in each thread.
+static thread_local CostCounterPtr g_currentCost;
+
+//////////////////////////////////////////////////
+CostCounter::CostCounter(const std::string &_group, const std::string &_name)
+  : dataPtr(new CostCounterPrivate)
+{
+  this->dataPtr->group = _group;
+  this->dataPtr->name = _name;
+}
+
+//////////////////////////////////////////////////
+CostCounter::~CostCounter()
+{
+}
+
+//////////////////////////////////////////////////
+CostCounterPtr CostCounter::Create(const std::string &_group,
+    const std::string &_name)
+{
+  std::lock_guard<std::mutex> lock(g_costMutex);
+  for (auto iter = g_costCounters.begin(); iter != g_costCounters.end();)
+  {
+    CostCounterPtr counter = iter->lock();
+    if (!counter)
+    {
+      iter = g_costCounters.erase(iter);
+      continue;
+    }
+    if (counter->Group() == _group && counter->Name() == _name)
+      return counter;
+    ++iter;
+  }
+
+  CostCounterPtr counter(new CostCounter(_group, _name));
+  g_costCounters.push_back(counter);
+  return counter;
+}
+
+//////////////////////////////////////////////////
+std::vector<CostCounterPtr> CostCounter::Counters()
+{
+  std::vector<CostCounterPtr> result;
+  std::lock_guard<std::mutex> lock(g_costMutex);
+  for (auto iter = g_costCounters.begin(); iter != g_costCounters.end();)
+  {
+    CostCounterPtr counter = iter->lock();
+    if (!counter)
+    {
+      iter = g_costCounters.erase(iter);
+      continue;
+    }
+    result.push_back(counter);
+    ++iter;
+  }
+  return result;
+}
+
+//////////////////////////////////////////////////
+CostCounterPtr CostCounter::Current()
+{
+  return g_currentCost;
+}
+
+//////////////////////////////////////////////////
+uint64_t CostCounter::Now()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+//////////////////////////////////////////////////
+const std::string &CostCounter::Group() const
+{
+  return this->dataPtr->group;
+}
+
+//////////////////////////////////////////////////
+const std::string &CostCounter::Name() const
+{
+  return this->dataPtr->name;
+}
+
+//////////////////////////////////////////////////
+void CostCounter::SetParent(const CostCounterPtr &_parent)
+{
+  // Don't make a cycle, which would make Add recurse forever
+  for (CostCounterPtr ancestor = _parent; ancestor;
+       ancestor = ancestor->Parent())
+  {
+    if (ancestor.get() == this)
+      return;
+  }
+  this->dataPtr->parent = _parent;
+}
+
+//////////////////////////////////////////////////
+CostCounterPtr CostCounter::Parent() const
+{
+  return this->dataPtr->parent;
+}
+
+//////////////////////////////////////////////////
+void CostCounter::Add(const uint64_t _nsec,
+    const AllocationCount &_allocations)
+{
+  this->dataPtr->time.fetch_add(_nsec, std::memory_order_relaxed);
+  this->dataPtr->count.fetch_add(1, std::memory_order_relaxed);
+  if (_allocations.count > 0)
+  {
+    this->dataPtr->allocations.fetch_add(_allocations.count,
+        std::memory_order_relaxed);
+    this->dataPtr->allocationBytes.fetch_add(_allocations.bytes,
+        std::memory_order_relaxed);
+  }
+
+  if (this->dataPtr->parent)
+    this->dataPtr->parent->Add(_nsec, _allocations);
+}
+
+//////////////////////////////////////////////////
+uint64_t CostCounter::Time() const
+{
+  return this->dataPtr->time.load(std::memory_order_relaxed);
+}
+
+//////////////////////////////////////////////////
+uint64_t CostCounter::Count() const
+{
+  return this->dataPtr->count.load(std::memory_order_relaxed);
+}
+
+//////////////////////////////////////////////////
+AllocationCount CostCounter::Allocations() const
+{
+  AllocationCount result;
+  result.count = this->dataPtr->allocations.load(std::memory_order_relaxed);
+  result.bytes =
+    this->dataPtr->allocationBytes.load(std::memory_order_relaxed);
+  return result;
+}
+
+//////////////////////////////////////////////////
+CostOwner::CostOwner(const CostCounterPtr &_counter)
+  : previous(g_currentCost)
+{
+  g_currentCost = _counter;
+}
+
+//////////////////////////////////////////////////
+CostOwner::~CostOwner()
+{
+  g_currentCost = this->previous;
+}
@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_COMMON_COSTCOUNTER_HH_
+#define GAZEBO_COMMON_COSTCOUNTER_HH_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gazebo/common/AllocationCounter.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace common
+  {
+    // Forward declare private data class.
+    class CostCounterPrivate;
+
+    class CostCounter;
+
+    /// \def CostCounterPtr
+    /// \brief Shared pointer to a CostCounter.
+    typedef std::shared_ptr<CostCounter> CostCounterPtr;
+
+    /// \addtogroup gazebo_common
+    /// \{
+
+    /// \class CostCounter CostCounter.hh common/common.hh
+    /// \brief Total time spent on behalf of an owner, such as a plugin or
+    /// a sensor container, kept since the counter was created.
+    ///
+    /// The counters are registered by group and name while they are
+    /// referenced, see Create and Counters. Adding a duration costs two
+    /// atomic operations, so a counter may be filled by several threads
+    /// while another one reads it.
+    ///
+    /// A counter can be made current in a thread with CostOwner. The event
+    /// callbacks connected while a counter is current are timed, and their
+    /// durations are added to it.
+    class GZ_COMMON_VISIBLE CostCounter
+    {
+      /// \brief Constructor. Use Create to make a registered counter.
+      /// \param[in] _group Group of the counter, e.g. "plugin".
+      /// \param[in] _name Name of the counter in its group.
+      public: CostCounter(const std::string &_group,
+                  const std::string &_name);
+
+      /// \brief Destructor.
+      public: virtual ~CostCounter();
+
+      /// \brief Get the registered counter of a group and name, creating
+      /// it if there is none.
+      /// \param[in] _group Group of the counter.
+      /// \param[in] _name Name of the counter in its group.
+      /// \return The counter, registered until it is no longer referenced.
+      public: static CostCounterPtr Create(const std::string &_group,
+                  const std::string &_name);
+
+      /// \brief Get the registered counters.
+      /// \return The counters that are still referenced, in the order
+      /// they were created.
+      public: static std::vector<CostCounterPtr> Counters();
+
+      /// \brief Get the counter made current in the calling thread.
+      /// \return The counter, null if there is none.
+      public: static CostCounterPtr Current();
+
+      /// \brief Get a steady clock reading, used to measure durations.
+      /// \return Time since an arbitrary epoch (nanoseconds).
+      public: static uint64_t Now();
+
+      /// \brief Get the group of the counter.
+      /// \return Group name.
+      public: const std::string &Group() const;
+
+      /// \brief Get the name of the counter.
+      /// \return Counter name.
+      public: const std::string &Name() const;
+
+      /// \brief Set the parent counter, to which the durations added to
+      /// this counter are added as well, e.g. the counter of the model of a
+      /// plugin. The parent must be set before the counter is filled.
+      /// \param[in] _parent Parent counter, null for none.
+      public: void SetParent(const CostCounterPtr &_parent);
+
+      /// \brief Get the parent counter.
+      /// \return The parent counter, null if there is none.
+      public: CostCounterPtr Parent() const;
+
+      /// \brief Add a duration, to this counter and to its parent.
+      /// \param[in] _nsec Duration (nanoseconds).
+      /// \param[in] _allocations Allocations made during the duration.
+      public: void Add(const uint64_t _nsec,
+                  const AllocationCount &_allocations = AllocationCount());
+
+      /// \brief Get the total of the durations added.
+      /// \return Total time (nanoseconds).
+      public: uint64_t Time() const;
+
+      /// \brief Get the number of durations added.
+      /// \return Number of durations.
+      public: uint64_t Count() const;
+
+      /// \brief Get the total of the allocations added.
+      /// \return Allocations, zero if they are not counted.
+      /// \sa AllocationCounter
+      public: AllocationCount Allocations() const;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<CostCounterPrivate> dataPtr;
+    };
+
+    /// \class CostOwner CostCounter.hh common/common.hh
+    /// \brief Makes a counter current in the calling thread while it is in
+    /// scope, see CostCounter::Current.
+    class GZ_COMMON_VISIBLE CostOwner
+    {
+      /// \brief Constructor.
+      /// \param[in] _counter Counter made current, may be null.
+      public: explicit CostOwner(const CostCounterPtr &_counter);
+
+      /// \brief Destructor, makes the previous counter current again.
+      public: ~CostOwner();
+
+      /// \brief Counter that was current before.
+      private: CostCounterPtr previous;
+    };
+    /// \}
+  }
+}
+#endif
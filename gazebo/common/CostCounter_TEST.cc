@@ -0,0 +1,152 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+
+#include "gazebo/common/CostCounter.hh"
+#include "gazebo/common/Event.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class CostCounterTest : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+TEST_F(CostCounterTest, Registry)
+{
+  common::CostCounterPtr a = common::CostCounter::Create("plugin", "a");
+  ASSERT_NE(nullptr, a);
+  EXPECT_EQ("plugin", a->Group());
+  EXPECT_EQ("a", a->Name());
+  EXPECT_EQ(0u, a->Time());
+  EXPECT_EQ(0u, a->Count());
+
+  // The same group and name give the same counter
+  EXPECT_EQ(a, common::CostCounter::Create("plugin", "a"));
+  common::CostCounterPtr b = common::CostCounter::Create("sensor", "a");
+  EXPECT_NE(a, b);
+
+  a->Add(10);
+  a->Add(5);
+  EXPECT_EQ(15u, a->Time());
+  EXPECT_EQ(2u, a->Count());
+  EXPECT_EQ(0u, a->Allocations().count);
+
+  common::AllocationCount allocations;
+  allocations.count = 3;
+  allocations.bytes = 64;
+  a->Add(1, allocations);
+  EXPECT_EQ(3u, a->Count());
+  EXPECT_EQ(3u, a->Allocations().count);
+  EXPECT_EQ(64u, a->Allocations().bytes);
+
+  auto counters = common::CostCounter::Counters();
+  ASSERT_EQ(2u, counters.size());
+  EXPECT_EQ(a, counters[0]);
+  EXPECT_EQ(b, counters[1]);
+
+  // Counters are registered while they are referenced
+  counters.clear();
+  b.reset();
+  counters = common::CostCounter::Counters();
+  ASSERT_EQ(1u, counters.size());
+  EXPECT_EQ(a, counters[0]);
+}
+
+/////////////////////////////////////////////////
+TEST_F(CostCounterTest, EventCallbacks)
+{
+  common::CostCounterPtr owner = common::CostCounter::Create("plugin", "b");
+  event::EventT<void (int)> evt;
+  int sum = 0;
+  std::vector<std::unique_ptr<int>> values;
+  auto slow = [&sum, &values](int _v)
+  {
+    const uint64_t start = common::CostCounter::Now();
+    while (common::CostCounter::Now() - start < 1000000u)
+      continue;
+    sum += _v;
+    values.emplace_back(new int(_v));
+  };
+
+  event::ConnectionPtr untimed = evt.Connect(slow);
+  event::ConnectionPtr timed;
+  {
+    common::CostOwner scope(owner);
+    EXPECT_EQ(owner, common::CostCounter::Current());
+    timed = evt.Connect(slow);
+  }
+  EXPECT_EQ(nullptr, common::CostCounter::Current());
+
+  evt(2);
+  evt(3);
+  EXPECT_EQ(10, sum);
+
+  // Only the callback connected by the owner is counted
+  EXPECT_EQ(2u, owner->Count());
+  EXPECT_GE(owner->Time(), 2000000u);
+  EXPECT_LT(owner->Time(), 1000000000u);
+
+  // The allocations of the counted callback, when they are counted
+  if (common::AllocationCounter::Available())
+  {
+    EXPECT_GE(owner->Allocations().count, 2u);
+  }
+  else
+  {
+    EXPECT_EQ(0u, owner->Allocations().count);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(CostCounterTest, Parent)
+{
+  common::CostCounterPtr model =
+    common::CostCounter::Create("model_plugin", "m");
+  common::CostCounterPtr plugin = common::CostCounter::Create("plugin", "p");
+  EXPECT_EQ(nullptr, plugin->Parent());
+
+  plugin->SetParent(model);
+  EXPECT_EQ(model, plugin->Parent());
+
+  // Durations are added to the parent as well
+  plugin->Add(7);
+  model->Add(3);
+  EXPECT_EQ(7u, plugin->Time());
+  EXPECT_EQ(1u, plugin->Count());
+  EXPECT_EQ(10u, model->Time());
+  EXPECT_EQ(2u, model->Count());
+
+  // A cycle is refused
+  model->SetParent(plugin);
+  EXPECT_EQ(nullptr, model->Parent());
+  plugin->SetParent(plugin);
+  EXPECT_EQ(model, plugin->Parent());
+
+  plugin->SetParent(nullptr);
+  plugin->Add(1);
+  EXPECT_EQ(10u, model->Time());
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -16,6 +16,9 @@
 */
 
 #include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <vector>
 #include <boost/filesystem.hpp>
 #include <gazebo/gazebo_config.h>
 
@@ -38,6 +41,119 @@ using namespace common;
 
 #ifdef HAVE_GDAL
 
+/// \brief Largest side of the DEMs loaded as a whole by default.
+static const unsigned int kMaxLoadedSide = 4097;
+
+/// \brief Default side of the tiles of larger DEMs.
+static const unsigned int kDefaultTileSize = 256;
+
+/// \brief Default maximum number of tiles of larger DEMs in memory.
+static const unsigned int kDefaultMaxTiles = 64;
+
+/// \brief Largest side of the coarse read that finds the elevation range
+/// of a tiled DEM.
+static const unsigned int kMaxRangeSide = 1024;
+
+//////////////////////////////////////////////////
+float DemPrivate::Value(const unsigned int _level, const unsigned int _x,
+    const unsigned int _y)
+{
+  if ((_x << _level) >= this->destWidth || (_y << _level) >= this->destHeight)
+    return 0;
+
+  const unsigned int tx = _x / this->tileSize;
+  const unsigned int ty = _y / this->tileSize;
+  DemTile *tile = this->lastTile;
+  if (!tile || tile->level != _level || tile->x != tx || tile->y != ty)
+  {
+    const auto key = std::make_tuple(_level, tx, ty);
+    auto iter = this->tileIndex.find(key);
+    if (iter != this->tileIndex.end())
+    {
+      this->tiles.splice(this->tiles.begin(), this->tiles, iter->second);
+    }
+    else
+    {
+      // Release the least recently used tile
+      if (this->tiles.size() >= std::max(this->maxTiles, 1u))
+      {
+        const DemTile &last = this->tiles.back();
+        this->tileIndex.erase(std::make_tuple(last.level, last.x, last.y));
+        this->tiles.pop_back();
+      }
+
+      this->tiles.emplace_front();
+      this->tiles.front().level = _level;
+      this->tiles.front().x = tx;
+      this->tiles.front().y = ty;
+      this->ReadTile(this->tiles.front());
+      this->tileIndex[key] = this->tiles.begin();
+    }
+    tile = &this->tiles.front();
+    this->lastTile = tile;
+  }
+
+  return tile->values[(_y % this->tileSize) * this->tileSize +
+    _x % this->tileSize];
+}
+
+//////////////////////////////////////////////////
+void DemPrivate::ReadTile(DemTile &_tile)
+{
+  const unsigned int size = this->tileSize;
+  _tile.values.assign(size * size, 0.0f);
+
+  // Part of the scaled raster covered by the tile. Each elevation of a
+  // level samples a block of 2^level elevations, which GDAL may read from
+  // an overview.
+  const unsigned int step = 1u << _tile.level;
+  const unsigned int x0 = _tile.x * size * step;
+  const unsigned int y0 = _tile.y * size * step;
+  const unsigned int width = std::min(size * step, this->destWidth - x0);
+  const unsigned int height = std::min(size * step, this->destHeight - y0);
+  const int bufWidth = (width + step - 1) / step;
+  const int bufHeight = (height + step - 1) / step;
+
+  // Window of the raster, in its own pixels
+  const double sx = this->dataSet->GetRasterXSize() /
+    static_cast<double>(this->destWidth);
+  const double sy = this->dataSet->GetRasterYSize() /
+    static_cast<double>(this->destHeight);
+  const double xOff = x0 * sx;
+  const double yOff = y0 * sy;
+  const double xSize = width * sx;
+  const double ySize = height * sy;
+  const int xMin = static_cast<int>(floor(xOff));
+  const int yMin = static_cast<int>(floor(yOff));
+  const int xMax = std::min(static_cast<int>(ceil(xOff + xSize)),
+      this->dataSet->GetRasterXSize());
+  const int yMax = std::min(static_cast<int>(ceil(yOff + ySize)),
+      this->dataSet->GetRasterYSize());
+
+#if GDAL_VERSION_NUM >= 2000000
+  GDALRasterIOExtraArg extraArg;
+  INIT_RASTERIO_EXTRA_ARG(extraArg);
+  extraArg.bFloatingPointWindowValidity = TRUE;
+  extraArg.dfXOff = xOff;
+  extraArg.dfYOff = yOff;
+  extraArg.dfXSize = xSize;
+  extraArg.dfYSize = ySize;
+  const CPLErr error = this->band->RasterIO(GF_Read, xMin, yMin,
+      std::max(xMax - xMin, 1), std::max(yMax - yMin, 1), &_tile.values[0],
+      bufWidth, bufHeight, GDT_Float32, sizeof(float), size * sizeof(float),
+      &extraArg);
+#else
+  const CPLErr error = this->band->RasterIO(GF_Read, xMin, yMin,
+      std::max(xMax - xMin, 1), std::max(yMax - yMin, 1), &_tile.values[0],
+      bufWidth, bufHeight, GDT_Float32, sizeof(float), size * sizeof(float));
+#endif
+  if (error != CE_None)
+  {
+    gzerr << "Failure calling RasterIO while reading a DEM tile at ("
+          << x0 << "," << y0 << ")\n";
+  }
+}
+
 //////////////////////////////////////////////////
 Dem::Dem()
   : dataPtr(new DemPrivate)
@@ -148,10 +264,44 @@ int Dem::Load(const std::string &_filename)
 
   this->dataPtr->side = std::max(width, height);
 
+  if (!this->dataPtr->tilesSet && this->dataPtr->side > kMaxLoadedSide)
+  {
+    this->dataPtr->tileSize = kDefaultTileSize;
+    this->dataPtr->maxTiles = kDefaultMaxTiles;
+  }
+
   // Preload the DEM's data
   if (this->LoadData() != 0)
     return -1;
 
+  // A tiled DEM finds its range with a coarse read of the raster, from an
+  // overview when the file has some
+  std::vector<float> coarse;
+  const std::vector<float> *values = &this->dataPtr->demData;
+  if (this->Tiled())
+  {
+    const unsigned int coarseWidth =
+      std::min(this->dataPtr->destWidth, kMaxRangeSide);
+    const unsigned int coarseHeight =
+      std::min(this->dataPtr->destHeight, kMaxRangeSide);
+    coarse.resize(coarseWidth * coarseHeight);
+    if (this->dataPtr->band->RasterIO(GF_Read, 0, 0, xSize, ySize,
+          &coarse[0], coarseWidth, coarseHeight, GDT_Float32, 0, 0) !=
+        CE_None)
+    {
+      gzerr << "Failure calling RasterIO while loading a DEM file\n";
+      return -1;
+    }
+
+    // As the padding of a loaded DEM
+    if (this->dataPtr->destWidth < this->dataPtr->side ||
+        this->dataPtr->destHeight < this->dataPtr->side)
+    {
+      coarse.push_back(0.0f);
+    }
+    values = &coarse;
+  }
+
   // Check for nodata value in dem data. This is used when computing the
   // min elevation. If nodata value is not defined, we assume it will be one
   // of the commonly used values such as -9999, -32768, etc.
@@ -165,7 +315,7 @@ int Dem::Load(const std::string &_filename)
 
   double min = ignition::math::MAX_D;
   double max = -ignition::math::MAX_D;
-  for (auto d : this->dataPtr->demData)
+  for (auto d : *values)
   {
     if (d < min && d > noDataValue)
       min = d;
@@ -194,9 +344,30 @@ double Dem::GetElevation(double _x, double _y)
            " x " << this->GetHeight() << "]\n");
   }
 
+  if (this->Tiled())
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    return this->dataPtr->Value(0, static_cast<unsigned int>(_x),
+        static_cast<unsigned int>(_y));
+  }
+
   return this->dataPtr->demData.at(_y * this->GetWidth() + _x);
 }
 
+//////////////////////////////////////////////////
+void Dem::SetTiles(const unsigned int _tileSize, const unsigned int _maxTiles)
+{
+  this->dataPtr->tileSize = _tileSize;
+  this->dataPtr->maxTiles = _maxTiles;
+  this->dataPtr->tilesSet = true;
+}
+
+//////////////////////////////////////////////////
+bool Dem::Tiled() const
+{
+  return this->dataPtr->tileSize > 0;
+}
+
 //////////////////////////////////////////////////
 float Dem::GetMinElevation() const
 {
@@ -290,6 +461,17 @@ void Dem::FillHeightMap(int _subSampling, unsigned int _vertSize,
     const ignition::math::Vector3d &_size,
     const ignition::math::Vector3d &_scale,
     bool _flipY, std::vector<float> &_heights)
+{
+  this->FillHeightMapTile(_subSampling, _vertSize, _size, _scale, _flipY,
+      0, 0, _vertSize, 1, _heights);
+}
+
+//////////////////////////////////////////////////
+void Dem::FillHeightMapTile(int _subSampling, unsigned int _vertSize,
+    const ignition::math::Vector3d &_size,
+    const ignition::math::Vector3d &_scale,
+    bool _flipY, unsigned int _x, unsigned int _y, unsigned int _tileSize,
+    unsigned int _stride, std::vector<float> &_heights)
 {
   if (_subSampling <= 0)
   {
@@ -297,34 +479,67 @@ void Dem::FillHeightMap(int _subSampling, unsigned int _vertSize,
     return;
   }
 
-  // Resize the vector to match the size of the vertices.
-  _heights.resize(_vertSize * _vertSize);
+  // Resize the vector to match the size of the tile.
+  _heights.resize(_tileSize * _tileSize);
 
-  // Iterate over all the vertices
-  for (unsigned int y = 0; y < _vertSize; ++y)
+  // A tiled DEM samples the level whose elevations are at most as far
+  // apart as the vertices, and its interpolation is then in that level.
+  const bool tiled = this->Tiled();
+  unsigned int level = 0;
+  if (tiled)
   {
-    double yf = y / static_cast<double>(_subSampling);
+    const unsigned int step = _stride / _subSampling;
+    while ((2u << level) <= step && ((this->dataPtr->side - 1) >> level) > 1)
+      ++level;
+  }
+  const double levelStep = 1u << level;
+  const double levelOffset = 0.5 * (levelStep - 1);
+  const unsigned int levelSide = ((this->dataPtr->side - 1) >> level) + 1;
+
+  std::unique_lock<std::mutex> lock(this->dataPtr->mutex, std::defer_lock);
+  if (tiled)
+    lock.lock();
+  auto value = [&](const unsigned int _vx, const unsigned int _vy) -> double
+  {
+    return tiled ? this->dataPtr->Value(level, _vx, _vy) :
+      this->dataPtr->demData[_vy * this->dataPtr->side + _vx];
+  };
+
+  // Iterate over the vertices of the tile
+  for (unsigned int i = 0; i < _tileSize; ++i)
+  {
+    // Row of the vertex, before flipping
+    unsigned int row = std::min(_y + i * _stride, _vertSize - 1);
+    unsigned int y = _flipY ? _vertSize - row - 1 : row;
+
+    double yf = std::max(
+        (y / static_cast<double>(_subSampling) - levelOffset) / levelStep,
+        0.0);
     unsigned int y1 = floor(yf);
     unsigned int y2 = ceil(yf);
-    if (y2 >= this->dataPtr->side)
-      y2 = this->dataPtr->side - 1;
+    if (y2 >= levelSide)
+      y2 = levelSide - 1;
     double dy = yf - y1;
 
-    for (unsigned int x = 0; x < _vertSize; ++x)
+    for (unsigned int j = 0; j < _tileSize; ++j)
     {
-      double xf = x / static_cast<double>(_subSampling);
+      unsigned int x = std::min(_x + j * _stride, _vertSize - 1);
+
+      double xf = std::max(
+          (x / static_cast<double>(_subSampling) - levelOffset) / levelStep,
+          0.0);
       unsigned int x1 = floor(xf);
       unsigned int x2 = ceil(xf);
-      if (x2 >= this->dataPtr->side)
-        x2 = this->dataPtr->side - 1;
+      if (x2 >= levelSide)
+        x2 = levelSide - 1;
       double dx = xf - x1;
 
-      double px1 = this->dataPtr->demData[y1 * this->dataPtr->side + x1];
-      double px2 = this->dataPtr->demData[y1 * this->dataPtr->side + x2];
+      double px1 = value(x1, y1);
+      double px2 = value(x2, y1);
       float h1 = (px1 - ((px1 - px2) * dx));
 
-      double px3 = this->dataPtr->demData[y2 * this->dataPtr->side + x1];
-      double px4 = this->dataPtr->demData[y2 * this->dataPtr->side + x2];
+      double px3 = value(x1, y2);
+      double px4 = value(x2, y2);
       float h2 = (px3 - ((px3 - px4) * dx));
 
       float h = this->dataPtr->minElevation +
@@ -341,10 +556,7 @@ void Dem::FillHeightMap(int _subSampling, unsigned int _vertSize,
         h = this->dataPtr->minElevation;
 
       // Store the height for future use
-      if (!_flipY)
-        _heights[y * _vertSize + x] = h;
-      else
-        _heights[(_vertSize - y - 1) * _vertSize + x] = h;
+      _heights[i * _tileSize + j] = h;
     }
   }
 }
@@ -382,6 +594,13 @@ int Dem::LoadData()
       destWidth = static_cast<float>(destHeight) / static_cast<float>(ratio);
     }
 
+    this->dataPtr->destWidth = destWidth;
+    this->dataPtr->destHeight = destHeight;
+
+    // Tiles are read on demand
+    if (this->Tiled())
+      return 0;
+
     // Read the whole raster data and convert it to a GDT_Float32 array.
     // In this step the DEM is scaled to destWidth x destHeight
     buffer.resize(destWidth * destHeight);
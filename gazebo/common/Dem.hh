@@ -54,6 +54,20 @@ namespace gazebo
       /// \return 0 when the operation succeeds to open a file.
       public: int Load(const std::string &_filename="");
 
+      /// \brief Read the elevations in tiles, on demand, rather than loading
+      /// all of them, to be called before Load. Load tiles the DEMs larger
+      /// than 4097 elevations on a side, with 256x256 tiles and at most 64
+      /// of them. Coarse heightmap tiles read coarse elevations, from the
+      /// overviews of the file when it has some.
+      /// \param[in] _tileSize Side of the tiles, 0 to load the whole DEM.
+      /// \param[in] _maxTiles Maximum number of tiles kept in memory.
+      public: void SetTiles(const unsigned int _tileSize,
+                  const unsigned int _maxTiles);
+
+      /// \brief Check whether the elevations are read in tiles.
+      /// \return True if the elevations are read in tiles.
+      public: bool Tiled() const;
+
       /// \brief Get the elevation of a terrain's point in meters.
       /// \param[in] _x X coordinate of the terrain.
       /// \param[in] _y Y coordinate of the terrain.
@@ -118,6 +132,16 @@ namespace gazebo
                   const bool _flipY,
                   std::vector<float> &_heights);
 
+      // Documentation inherited.
+      public: void FillHeightMapTile(const int _subSampling,
+                  const unsigned int _vertSize,
+                  const ignition::math::Vector3d &_size,
+                  const ignition::math::Vector3d &_scale,
+                  const bool _flipY, const unsigned int _x,
+                  const unsigned int _y, const unsigned int _tileSize,
+                  const unsigned int _stride,
+                  std::vector<float> &_heights);
+
       /// \brief Get the georeferenced coordinates (lat, long) of a terrain's
       /// pixel in WGS84.
       /// \param[in] _x X coordinate of the terrain.
@@ -23,6 +23,10 @@
 
 #ifdef HAVE_GDAL
 # include <gdal_priv.h>
+# include <list>
+# include <map>
+# include <mutex>
+# include <tuple>
 # include <vector>
 
 namespace gazebo
@@ -32,10 +36,40 @@ namespace gazebo
     /// \addtogroup gazebo_common Common
     /// \{
 
+    /// \brief A square block of elevations of a tiled DEM.
+    class DemTile
+    {
+      /// \brief Level of the tile, each of its elevations samples a block
+      /// of 2^level x 2^level elevations.
+      public: unsigned int level;
+
+      /// \brief Column of the tile.
+      public: unsigned int x;
+
+      /// \brief Row of the tile.
+      public: unsigned int y;
+
+      /// \brief Elevations, row by row, zero outside the raster.
+      public: std::vector<float> values;
+    };
+
     /// \class DemPrivate DemPrivate.hh common/common.hh
     /// \brief Private data for the Dem class.
     class GZ_COMMON_VISIBLE DemPrivate
     {
+      /// \brief Get an elevation of a tiled DEM, reading its tile if it
+      /// isn't cached. The mutex must be locked.
+      /// \param[in] _level Level of the elevation.
+      /// \param[in] _x Column of the elevation, in the level.
+      /// \param[in] _y Row of the elevation, in the level.
+      /// \return The elevation, zero in the padding.
+      public: float Value(const unsigned int _level, const unsigned int _x,
+                  const unsigned int _y);
+
+      /// \brief Read the elevations of a tile from the band.
+      /// \param[in,out] _tile The tile, whose level and position are set.
+      public: void ReadTile(DemTile &_tile);
+
       /// \brief A set of associated raster bands.
       public: GDALDataset *dataSet;
 
@@ -57,8 +91,38 @@ namespace gazebo
       /// \brief Maximum elevation in meters.
       public: double maxElevation;
 
-      /// \brief DEM data converted to be OGRE-compatible.
+      /// \brief DEM data converted to be OGRE-compatible. Empty if the DEM
+      /// is tiled.
       public: std::vector<float> demData;
+
+      /// \brief Width of the raster once scaled to the side.
+      public: unsigned int destWidth = 0;
+
+      /// \brief Height of the raster once scaled to the side.
+      public: unsigned int destHeight = 0;
+
+      /// \brief Side of the tiles, 0 to load the whole DEM.
+      public: unsigned int tileSize = 0;
+
+      /// \brief Maximum number of tiles in memory.
+      public: unsigned int maxTiles = 0;
+
+      /// \brief True once SetTiles was called.
+      public: bool tilesSet = false;
+
+      /// \brief Tiles in memory, most recently used first.
+      public: std::list<DemTile> tiles;
+
+      /// \brief Tiles in memory, indexed by level, column and row.
+      public: std::map<std::tuple<unsigned int, unsigned int, unsigned int>,
+              std::list<DemTile>::iterator> tileIndex;
+
+      /// \brief Tile of the last elevation, null if none.
+      public: DemTile *lastTile = nullptr;
+
+      /// \brief Protects the tiles and the band, which may be read from
+      /// several threads.
+      public: std::mutex mutex;
     };
     /// \}
   }
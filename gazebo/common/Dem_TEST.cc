@@ -17,6 +17,7 @@
 
 #include <boost/filesystem.hpp>
 #include <gtest/gtest.h>
+#include <vector>
 #include <ignition/math/Angle.hh>
 #include <ignition/math/Helpers.hh>
 #include <ignition/math/Vector3.hh>
@@ -167,6 +168,59 @@ TEST_F(DemTest, FillHeightmap)
   EXPECT_FLOAT_EQ(213.42966, elevations.at(elevations.size() / 2));
 }
 
+/////////////////////////////////////////////////
+TEST_F(DemTest, Tiles)
+{
+  boost::filesystem::path path = TEST_PATH;
+  path /= "data/dem_squared.tif";
+
+  common::Dem dem;
+  EXPECT_EQ(dem.Load(path.string()), 0);
+  EXPECT_FALSE(dem.Tiled());
+
+  // Tiles of 32x32 elevations, fewer than the DEM has
+  common::Dem tiled;
+  tiled.SetTiles(32, 3);
+  EXPECT_EQ(tiled.Load(path.string()), 0);
+  EXPECT_TRUE(tiled.Tiled());
+
+  EXPECT_EQ(dem.GetWidth(), tiled.GetWidth());
+  EXPECT_EQ(dem.GetHeight(), tiled.GetHeight());
+  EXPECT_FLOAT_EQ(dem.GetMinElevation(), tiled.GetMinElevation());
+  EXPECT_FLOAT_EQ(dem.GetMaxElevation(), tiled.GetMaxElevation());
+  for (unsigned int y = 0; y < dem.GetHeight(); y += 3)
+  {
+    for (unsigned int x = 0; x < dem.GetWidth(); x += 5)
+      EXPECT_FLOAT_EQ(dem.GetElevation(x, y), tiled.GetElevation(x, y));
+  }
+  ASSERT_ANY_THROW(tiled.GetElevation(0, tiled.GetHeight()));
+
+  const int subsampling = 2;
+  const unsigned int vertSize = (dem.GetWidth() * subsampling) - 1;
+  const ignition::math::Vector3d size(dem.GetWorldWidth(),
+      dem.GetWorldHeight(), dem.GetMaxElevation() - dem.GetMinElevation());
+  const ignition::math::Vector3d scale(size.X() / vertSize,
+      size.Y() / vertSize, 1.0);
+
+  // Full resolution heights match
+  std::vector<float> expected, heights;
+  dem.FillHeightMap(subsampling, vertSize, size, scale, true, expected);
+  tiled.FillHeightMap(subsampling, vertSize, size, scale, true, heights);
+  ASSERT_EQ(expected.size(), heights.size());
+  for (size_t i = 0; i < expected.size(); ++i)
+    EXPECT_FLOAT_EQ(expected[i], heights[i]);
+
+  // Coarse heights sample a coarse level, within the elevation range
+  tiled.FillHeightMapTile(subsampling, vertSize, size, scale, true, 0, 0,
+      33, 8, heights);
+  ASSERT_EQ(33u * 33u, heights.size());
+  for (auto const h : heights)
+  {
+    EXPECT_LE(tiled.GetMinElevation() - 1e-3, h);
+    EXPECT_GE(tiled.GetMaxElevation() + 1e-3, h);
+  }
+}
+
 /////////////////////////////////////////////////
 TEST_F(DemTest, NegDem)
 {
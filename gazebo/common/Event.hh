@@ -19,14 +19,15 @@
 
 #include <atomic>
 #include <functional>
-#include <list>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <vector>
 
 #include "gazebo/gazebo_config.h"
 #include "gazebo/common/Time.hh"
 #include "gazebo/common/CommonTypes.hh"
+#include "gazebo/common/CostCounter.hh"
 #include "gazebo/util/system.hh"
 
 #include "ignition/common/Profiler.hh"
@@ -110,6 +111,17 @@ namespace gazebo
       /// Disconnect when it goes out of scope.
       public: ConnectionPtr Connect(const std::function<T> &_subscriber);
 
+      /// \brief Connect a callback that only needs to run on some of the
+      /// signals of this event.
+      /// \param[in] _subscriber Pointer to a callback function.
+      /// \param[in] _period The callback is called on the first signal
+      /// and then once every _period signals. Zero and one call it on
+      /// every signal.
+      /// \return A Connection object, which will automatically call
+      /// Disconnect when it goes out of scope.
+      public: ConnectionPtr Connect(const std::function<T> &_subscriber,
+                                    const unsigned int _period);
+
       /// \brief Disconnect a callback to this event.
       /// \param[in] _id The id of the connection to disconnect.
       public: virtual void Disconnect(int _id);
@@ -272,15 +284,14 @@ namespace gazebo
       {
         IGN_PROFILE("Event::Signal");
 
-        this->Cleanup();
-
         this->SetSignaled(true);
-        for (const auto &iter: this->connections)
+        auto conns = std::atomic_load(&this->snapshot);
+        for (const auto &conn : *conns)
         {
-          if ((iter.second != NULL) && iter.second->on)
+          if (conn->on && conn->Due())
           {
             IGN_PROFILE_BEGIN("callback0");
-            iter.second->callback();
+            conn->Call();
             IGN_PROFILE_END();
           }
         }
@@ -293,15 +304,14 @@ namespace gazebo
       {
         IGN_PROFILE("Event::Signal");
 
-        this->Cleanup();
-
         this->SetSignaled(true);
-        for (const auto &iter: this->connections)
+        auto conns = std::atomic_load(&this->snapshot);
+        for (const auto &conn : *conns)
         {
-          if ((iter.second != NULL) && iter.second->on)
+          if (conn->on && conn->Due())
           {
             IGN_PROFILE_BEGIN("callback1");
-            iter.second->callback(_p);
+            conn->Call(_p);
             IGN_PROFILE_END();
           }
         }
@@ -315,15 +325,14 @@ namespace gazebo
       {
         IGN_PROFILE("Event::Signal");
 
-        this->Cleanup();
-
         this->SetSignaled(true);
-        for (const auto &iter: this->connections)
+        auto conns = std::atomic_load(&this->snapshot);
+        for (const auto &conn : *conns)
         {
-          if ((iter.second != NULL) && iter.second->on)
+          if (conn->on && conn->Due())
           {
             IGN_PROFILE_BEGIN("callback2");
-            iter.second->callback(_p1, _p2);
+            conn->Call(_p1, _p2);
             IGN_PROFILE_END();
           }
         }
@@ -338,15 +347,14 @@ namespace gazebo
       {
         IGN_PROFILE("Event::Signal");
 
-        this->Cleanup();
-
         this->SetSignaled(true);
-        for (const auto &iter: this->connections)
+        auto conns = std::atomic_load(&this->snapshot);
+        for (const auto &conn : *conns)
         {
-          if ((iter.second != NULL) && iter.second->on)
+          if (conn->on && conn->Due())
           {
             IGN_PROFILE_BEGIN("callback3");
-            iter.second->callback(_p1, _p2, _p3);
+            conn->Call(_p1, _p2, _p3);
             IGN_PROFILE_END();
           }
         }
@@ -363,15 +371,14 @@ namespace gazebo
       {
         IGN_PROFILE("Event::Signal");
 
-        this->Cleanup();
-
         this->SetSignaled(true);
-        for (const auto &iter: this->connections)
+        auto conns = std::atomic_load(&this->snapshot);
+        for (const auto &conn : *conns)
         {
-          if ((iter.second != NULL) && iter.second->on)
+          if (conn->on && conn->Due())
           {
             IGN_PROFILE_BEGIN("callback4");
-            iter.second->callback(_p1, _p2, _p3, _p4);
+            conn->Call(_p1, _p2, _p3, _p4);
             IGN_PROFILE_END();
           }
         }
@@ -390,15 +397,14 @@ namespace gazebo
       {
         IGN_PROFILE("Event::Signal");
 
-        this->Cleanup();
-
         this->SetSignaled(true);
-        for (const auto &iter: this->connections)
+        auto conns = std::atomic_load(&this->snapshot);
+        for (const auto &conn : *conns)
         {
-          if ((iter.second != NULL) && iter.second->on)
+          if (conn->on && conn->Due())
           {
             IGN_PROFILE_BEGIN("callback5");
-            iter.second->callback(_p1, _p2, _p3, _p4, _p5);
+            conn->Call(_p1, _p2, _p3, _p4, _p5);
             IGN_PROFILE_END();
           }
         }
@@ -418,15 +424,14 @@ namespace gazebo
       {
         IGN_PROFILE("Event::Signal");
 
-        this->Cleanup();
-
         this->SetSignaled(true);
-        for (const auto &iter: this->connections)
+        auto conns = std::atomic_load(&this->snapshot);
+        for (const auto &conn : *conns)
         {
-          if ((iter.second != NULL) && iter.second->on)
+          if (conn->on && conn->Due())
           {
             IGN_PROFILE_BEGIN("callback6");
-            iter.second->callback(_p1, _p2, _p3, _p4, _p5, _p6);
+            conn->Call(_p1, _p2, _p3, _p4, _p5, _p6);
             IGN_PROFILE_END();
           }
         }
@@ -447,15 +452,14 @@ namespace gazebo
       {
         IGN_PROFILE("Event::Signal");
 
-        this->Cleanup();
-
         this->SetSignaled(true);
-        for (const auto &iter: this->connections)
+        auto conns = std::atomic_load(&this->snapshot);
+        for (const auto &conn : *conns)
         {
-          if ((iter.second != NULL) && iter.second->on)
+          if (conn->on && conn->Due())
           {
             IGN_PROFILE_BEGIN("callback7");
-            iter.second->callback(_p1, _p2, _p3, _p4, _p5, _p6, _p7);
+            conn->Call(_p1, _p2, _p3, _p4, _p5, _p6, _p7);
             IGN_PROFILE_END();
           }
         }
@@ -478,15 +482,14 @@ namespace gazebo
       {
         IGN_PROFILE("Event::Signal");
 
-        this->Cleanup();
-
         this->SetSignaled(true);
-        for (const auto &iter: this->connections)
+        auto conns = std::atomic_load(&this->snapshot);
+        for (const auto &conn : *conns)
         {
-          if ((iter.second != NULL) && iter.second->on)
+          if (conn->on && conn->Due())
           {
             IGN_PROFILE_BEGIN("callback8");
-            iter.second->callback(_p1, _p2, _p3, _p4, _p5, _p6, _p7, _p8);
+            conn->Call(_p1, _p2, _p3, _p4, _p5, _p6, _p7, _p8);
             IGN_PROFILE_END();
           }
         }
@@ -511,15 +514,14 @@ namespace gazebo
       {
         IGN_PROFILE("Event::Signal");
 
-        this->Cleanup();
-
         this->SetSignaled(true);
-        for (const auto &iter: this->connections)
+        auto conns = std::atomic_load(&this->snapshot);
+        for (const auto &conn : *conns)
         {
-          if ((iter.second != NULL) && iter.second->on)
+          if (conn->on && conn->Due())
           {
             IGN_PROFILE_BEGIN("callback9");
-            iter.second->callback(
+            conn->Call(
                 _p1, _p2, _p3, _p4, _p5, _p6, _p7, _p8, _p9);
             IGN_PROFILE_END();
           }
@@ -546,36 +548,66 @@ namespace gazebo
       {
         IGN_PROFILE("Event::Signal");
 
-        this->Cleanup();
-
         this->SetSignaled(true);
-        for (const auto &iter: this->connections)
+        auto conns = std::atomic_load(&this->snapshot);
+        for (const auto &conn : *conns)
         {
-          if ((iter.second != NULL) && iter.second->on)
+          if (conn->on && conn->Due())
           {
             IGN_PROFILE_BEGIN("callback10");
-            iter.second->callback(
+            conn->Call(
                 _p1, _p2, _p3, _p4, _p5, _p6, _p7, _p8, _p9, _p10);
             IGN_PROFILE_END();
           }
         }
       }
 
-      /// \internal
-      /// \brief Removes queued connections.
-      /// We assume that this function is called from a Signal function.
-      private: void Cleanup();
+      /// \brief Rebuild the snapshot of the connections that is used by
+      /// the signal functions. Must be called with the mutex locked.
+      private: void UpdateSnapshot();
 
       /// \brief A private helper class used in maintaining connections.
       private: class EventConnection
       {
         /// \brief Constructor
-        public: EventConnection(const bool _on, const std::function<T> &_cb)
-                : callback(_cb)
+        public: EventConnection(const bool _on, const std::function<T> &_cb,
+                                const unsigned int _period = 1)
+                : callback(_cb), period(_period),
+                  cost(common::CostCounter::Current())
         {
           // Windows Visual Studio 2012 does not have atomic_bool constructor,
           // so we have to set "on" using operator=
           this->on = _on;
+          this->count = 0;
+        }
+
+        /// \brief Check whether the callback runs on the current signal.
+        /// \return True once every period calls.
+        public: bool Due()
+        {
+          return this->period <= 1 || (this->count++ % this->period) == 0;
+        }
+
+        /// \brief Call the callback, adding its duration and allocations
+        /// to the cost counter that was current when the callback was
+        /// connected. The counter is current during the call, so that the
+        /// callbacks connected by this one are counted too.
+        /// \param[in] _args Parameters of the callback.
+        public: template<typename... Args>
+                void Call(const Args &... _args)
+        {
+          if (!this->cost)
+          {
+            this->callback(_args...);
+            return;
+          }
+          common::CostOwner owner(this->cost);
+          const common::AllocationCount allocations =
+            common::AllocationCounter::Thread();
+          const uint64_t start = common::CostCounter::Now();
+          this->callback(_args...);
+          this->cost->Add(common::CostCounter::Now() - start,
+              common::AllocationCounter::Thread() - allocations);
         }
 
         /// \brief On/off value for the event callback
@@ -583,27 +615,41 @@ namespace gazebo
 
         /// \brief Callback function
         public: std::function<T> callback;
+
+        /// \brief Number of signals between two calls of the callback.
+        public: unsigned int period;
+
+        /// \brief Number of signals seen by the connection.
+        public: std::atomic<unsigned int> count;
+
+        /// \brief Counter of the time spent in the callback, may be null.
+        public: common::CostCounterPtr cost;
       };
 
       /// \def EvtConnectionMap
       /// \brief Event Connection map typedef.
-      typedef std::map<int, std::unique_ptr<EventConnection>> EvtConnectionMap;
+      typedef std::map<int, std::shared_ptr<EventConnection>> EvtConnectionMap;
+
+      /// \def EvtConnectionList
+      /// \brief Immutable list of connections used while signaling.
+      typedef std::vector<std::shared_ptr<EventConnection>> EvtConnectionList;
 
       /// \brief Array of connection callbacks.
       private: EvtConnectionMap connections;
 
-      /// \brief A thread lock.
-      private: mutable std::mutex mutex;
+      /// \brief Copy of the connections, replaced as a whole on every
+      /// change. Signals iterate it without taking the mutex, so a
+      /// callback may connect or disconnect while the event is signaled.
+      private: std::shared_ptr<const EvtConnectionList> snapshot;
 
-      /// \brief List of connections to remove
-      private: std::list<typename EvtConnectionMap::const_iterator>
-              connectionsToRemove;
+      /// \brief A thread lock that serializes changes to the connections.
+      private: mutable std::mutex mutex;
     };
 
     /// \brief Constructor.
     template<typename T>
     EventT<T>::EventT()
-    : Event()
+    : Event(), snapshot(std::make_shared<const EvtConnectionList>())
     {
     }
 
@@ -613,12 +659,23 @@ namespace gazebo
     {
       std::lock_guard<std::mutex> lock(this->mutex);
       this->connections.clear();
+      this->UpdateSnapshot();
     }
 
     /// \brief Adds a connection.
     /// \param[in] _subscriber the subscriber to connect.
     template<typename T>
     ConnectionPtr EventT<T>::Connect(const std::function<T> &_subscriber)
+    {
+      return this->Connect(_subscriber, 1);
+    }
+
+    /// \brief Adds a connection that is called once every _period signals.
+    /// \param[in] _subscriber the subscriber to connect.
+    /// \param[in] _period Number of signals between two calls.
+    template<typename T>
+    ConnectionPtr EventT<T>::Connect(const std::function<T> &_subscriber,
+        const unsigned int _period)
     {
       std::lock_guard<std::mutex> lock(this->mutex);
       int index = 0;
@@ -627,7 +684,9 @@ namespace gazebo
         auto const &iter = this->connections.rbegin();
         index = iter->first + 1;
       }
-      this->connections[index].reset(new EventConnection(true, _subscriber));
+      this->connections[index].reset(
+          new EventConnection(true, _subscriber, _period));
+      this->UpdateSnapshot();
       return ConnectionPtr(new Connection(this, index));
     }
 
@@ -651,21 +710,25 @@ namespace gazebo
 
       if (it != this->connections.end())
       {
+        // A signal that is in progress may still hold the connection in
+        // its snapshot, turning it off makes sure it is not called again.
         it->second->on = false;
-        this->connectionsToRemove.push_back(it);
+        this->connections.erase(it);
+        this->UpdateSnapshot();
       }
     }
 
     /////////////////////////////////////////////
-    /// \brief Erases all connections from connectionsToRemove.
+    /// \brief Publishes a new snapshot of the connections.
     template<typename T>
-    void EventT<T>::Cleanup()
+    void EventT<T>::UpdateSnapshot()
     {
-      std::lock_guard<std::mutex> lock(this->mutex);
-      // Remove all queue connections.
-      for (auto &conn : this->connectionsToRemove)
-        this->connections.erase(conn);
-      this->connectionsToRemove.clear();
+      auto conns = std::make_shared<EvtConnectionList>();
+      conns->reserve(this->connections.size());
+      for (auto const &conn : this->connections)
+        conns->push_back(conn.second);
+      std::atomic_store(&this->snapshot,
+          std::shared_ptr<const EvtConnectionList>(conns));
     }
     /// \}
   }
@@ -17,6 +17,7 @@
 
 #include <functional>
 #include <future>
+#include <list>
 #include <thread>
 #include <gtest/gtest.h>
 #include <gazebo/common/Time.hh>
@@ -59,10 +60,9 @@ void callbackDisconnect()
 // Used by the CallbackDisconnect test.
 void callbackDisconnect2()
 {
-  // This function should still be called, even though it was disconnected
-  // in the callDisconnect function. The mutex in Event.hh prevents
-  // a callback from deleting active connections until the event is
-  // complete.
+  // This function is not called, it was disconnected in the
+  // callbackDisconnect function. The signal keeps its snapshot of the
+  // connections alive until the event is complete.
   ASSERT_TRUE(true);
 }
 
@@ -222,6 +222,30 @@ TEST_F(EventTest, ManyChanges)
   EXPECT_EQ(g_callback1, 2);
 }
 
+/////////////////////////////////////////////////
+TEST_F(EventTest, Period)
+{
+  g_callback = 0;
+  g_callback1 = 0;
+
+  event::EventT<void ()> evt;
+  event::ConnectionPtr conn = evt.Connect(std::bind(&callback), 4);
+  event::ConnectionPtr conn1 = evt.Connect(std::bind(&callback1), 0);
+  EXPECT_EQ(2u, evt.ConnectionCount());
+
+  // The periodic callback runs on the first signal, then every 4th
+  for (unsigned int i = 0; i < 10; ++i)
+    evt();
+
+  EXPECT_EQ(g_callback, 3);
+  EXPECT_EQ(g_callback1, 10);
+
+  conn.reset();
+  evt();
+  EXPECT_EQ(g_callback, 3);
+  EXPECT_EQ(g_callback1, 11);
+}
+
 
 /////////////////////////////////////////////////
 // Race condition helper functions
@@ -32,10 +32,13 @@ EventT<void (std::string)> Events::deleteEntity;
 
 EventT<void (const common::UpdateInfo &)> Events::worldUpdateBegin;
 EventT<void (const common::UpdateInfo &)> Events::beforePhysicsUpdate;
+EventT<void (const common::UpdateInfo &)> Events::beforePhysicsSubstep;
 
 EventT<void ()> Events::worldUpdateEnd;
 EventT<void ()> Events::worldReset;
 EventT<void ()> Events::timeReset;
+EventT<void (const std::string &, const common::StrStr_M &)>
+    Events::scenarioReset;
 
 EventT<void ()> Events::preRender;
 EventT<void ()> Events::preRenderEnded;
@@ -120,6 +120,19 @@ namespace gazebo
               static ConnectionPtr ConnectBeforePhysicsUpdate(T _subscriber)
               { return beforePhysicsUpdate.Connect(_subscriber); }
 
+      //////////////////////////////////////////////////////////////////////////
+      /// \brief Connect a callback to the before physics substep signal
+      /// \param[in] _subscriber the subscriber to this event
+      /// \return a connection
+      ///
+      /// The signal is called before each integration substep, when the
+      /// physics engine takes several substeps per world update (see the
+      /// "substeps" physics parameter). Forces are cleared after every
+      /// substep, so controllers apply them again on each signal.
+      public: template<typename T>
+              static ConnectionPtr ConnectBeforePhysicsSubstep(T _subscriber)
+              { return beforePhysicsSubstep.Connect(_subscriber); }
+
       //////////////////////////////////////////////////////////////////////////
       /// \brief Connect a callback to the world update end signal
       /// \param[in] _subscriber the subscriber to this event
@@ -144,6 +157,14 @@ namespace gazebo
               static ConnectionPtr ConnectTimeReset(T _subscriber)
               { return timeReset.Connect(_subscriber); }
 
+      //////////////////////////////////////////////////////////////////////////
+      /// \brief Connect to the scenario reset signal
+      /// \param[in] _subscriber the subscriber to this event
+      /// \return a connection
+      public: template<typename T>
+              static ConnectionPtr ConnectScenarioReset(T _subscriber)
+              { return scenarioReset.Connect(_subscriber); }
+
       //////////////////////////////////////////////////////////////////////////
       /// \brief Connect to the remove sensor signal
       /// \param[in] _subscriber the subscriber to this event
@@ -250,6 +271,11 @@ namespace gazebo
       public: static EventT<void (const common::UpdateInfo &)>
                 beforePhysicsUpdate;
 
+      /// \brief An integration substep of the physics update is about to
+      /// run. The sim time is the start time of the substep.
+      public: static EventT<void (const common::UpdateInfo &)>
+                beforePhysicsSubstep;
+
       /// \brief World update has ended
       public: static EventT<void ()> worldUpdateEnd;
 
@@ -259,6 +285,14 @@ namespace gazebo
       /// \brief Time reset signal
       public: static EventT<void ()> timeReset;
 
+      /// \brief A scenario server restored the pristine state of a world,
+      /// see the --scenario-server option of gzserver. Plugins reset their
+      /// own state and apply the parameters of the new scenario.
+      /// * Parameter 1 (std::string): Name of the world.
+      /// * Parameter 2 (common::StrStr_M): Scenario parameters, by name.
+      public: static EventT<void (const std::string &,
+                  const common::StrStr_M &)> scenarioReset;
+
       /// \brief Pre-render
       public: static EventT<void ()> preRender;
 
@@ -17,6 +17,13 @@
 
 #include <gazebo/gazebo_config.h>
 
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <utility>
+
+#include <boost/filesystem.hpp>
+
 #ifdef HAVE_GDAL
 # pragma GCC diagnostic push
 # pragma GCC diagnostic ignored "-Wfloat-equal"
@@ -34,6 +41,32 @@
 using namespace gazebo;
 using namespace common;
 
+//////////////////////////////////////////////////
+void HeightmapData::FillHeightMapTile(int _subSampling,
+    unsigned int _vertSize, const ignition::math::Vector3d &_size,
+    const ignition::math::Vector3d &_scale, bool _flipY,
+    unsigned int _x, unsigned int _y, unsigned int _tileSize,
+    unsigned int _stride, std::vector<float> &_heights)
+{
+  // Fall back to cropping the whole table
+  std::vector<float> heights;
+  this->FillHeightMap(_subSampling, _vertSize, _size, _scale, _flipY,
+      heights);
+  if (heights.empty())
+    return;
+
+  _heights.resize(_tileSize * _tileSize);
+  for (unsigned int i = 0; i < _tileSize; ++i)
+  {
+    unsigned int row = std::min(_y + i * _stride, _vertSize - 1);
+    for (unsigned int j = 0; j < _tileSize; ++j)
+    {
+      unsigned int column = std::min(_x + j * _stride, _vertSize - 1);
+      _heights[i * _tileSize + j] = heights[row * _vertSize + column];
+    }
+  }
+}
+
 //////////////////////////////////////////////////
 HeightmapData *HeightmapDataLoader::LoadImageAsTerrain(
     const std::string &_filename)
@@ -103,3 +136,34 @@ HeightmapData *HeightmapDataLoader::LoadTerrainFile(
   return LoadImageAsTerrain(_filename);
 }
 #endif
+
+//////////////////////////////////////////////////
+std::shared_ptr<HeightmapData> HeightmapDataLoader::LoadTerrainFileShared(
+    const std::string &_filename)
+{
+  // Decoded files, with their modification time. The data is held by its
+  // users only.
+  static std::mutex mutex;
+  static std::map<std::string,
+    std::pair<std::time_t, std::weak_ptr<HeightmapData>>> loaded;
+
+  boost::system::error_code ec;
+  const std::time_t modified = boost::filesystem::last_write_time(
+      _filename, ec);
+
+  std::lock_guard<std::mutex> lock(mutex);
+  auto iter = loaded.find(_filename);
+  if (iter != loaded.end())
+  {
+    std::shared_ptr<HeightmapData> data = iter->second.second.lock();
+    if (data && iter->second.first == modified)
+      return data;
+  }
+
+  std::shared_ptr<HeightmapData> data(LoadTerrainFile(_filename));
+  if (data)
+    loaded[_filename] = std::make_pair(modified, data);
+  else if (iter != loaded.end())
+    loaded.erase(iter);
+  return data;
+}
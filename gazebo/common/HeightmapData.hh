@@ -18,6 +18,7 @@
 #ifndef GAZEBO_COMMON_HEIGHTMAPDATA_HH_
 #define GAZEBO_COMMON_HEIGHTMAPDATA_HH_
 
+#include <memory>
 #include <string>
 #include <vector>
 #include <ignition/math/Vector3.hh>
@@ -56,6 +57,27 @@ namespace gazebo
           const ignition::math::Vector3d &_scale, bool _flipY,
           std::vector<float> &_heights) = 0;
 
+      /// \brief Create a lookup table of the terrain's height over a square
+      /// tile of the vertices of FillHeightMap, without computing the
+      /// whole table.
+      /// \param[in] _subsampling Multiplier used to increase the resolution.
+      /// \param[in] _vertSize Number of points per row of the whole terrain.
+      /// \param[in] _size Real dimmensions of the terrain.
+      /// \param[in] _scale Vector3 used to scale the height.
+      /// \param[in] _flipY If true, it inverts the order of the rows.
+      /// \param[in] _x Column of the first vertex of the tile.
+      /// \param[in] _y Row of the first vertex of the tile.
+      /// \param[in] _tileSize Number of vertices per side of the tile.
+      /// \param[in] _stride Number of rows and columns between two vertices
+      /// of the tile, 1 for the full resolution.
+      /// \param[out] _heights The _tileSize * _tileSize heights of the tile,
+      /// row by row. Vertices past the edge of the terrain repeat the edge.
+      public: virtual void FillHeightMapTile(int _subSampling,
+          unsigned int _vertSize, const ignition::math::Vector3d &_size,
+          const ignition::math::Vector3d &_scale, bool _flipY,
+          unsigned int _x, unsigned int _y, unsigned int _tileSize,
+          unsigned int _stride, std::vector<float> &_heights);
+
       /// \brief Get the terrain's height.
       /// \return The terrain's height.
       public: virtual unsigned int GetHeight() const = 0;
@@ -82,6 +104,16 @@ namespace gazebo
       public: static HeightmapData *LoadTerrainFile(
           const std::string &_filename);
 
+      /// \brief Load a terrain file like LoadTerrainFile, sharing the
+      /// decoded data with the other users of the same file in this process,
+      /// e.g. the physics and the rendering heightmaps of a server with
+      /// sensors. The file is decoded again once it changed on disk, or once
+      /// the data was released by its last user.
+      /// \param[in] _filename The path to the terrain file.
+      /// \return The data, null if the file can't be loaded.
+      public: static std::shared_ptr<HeightmapData> LoadTerrainFileShared(
+          const std::string &_filename);
+
       /// \brief Load a DEM specified by _filename as a terrain file.
       /// \param[in] _filename The path to the terrain file.
       /// \return 0 when the operation succeeds to load a file or -1 when fails.
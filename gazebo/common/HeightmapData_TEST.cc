@@ -55,6 +55,29 @@ TEST_F(HeightmapDataLoaderTest, ImageHeightmap)
   EXPECT_NEAR(0.99607843, img->GetMaxElevation(), ELEVATION_TOL);
 }
 
+/////////////////////////////////////////////////
+TEST_F(HeightmapDataLoaderTest, Shared)
+{
+  const std::string path = common::find_file(
+      "file://media/materials/textures/heightmap_bowl.png");
+
+  // Users of the same file share the decoded data
+  std::shared_ptr<common::HeightmapData> data =
+    common::HeightmapDataLoader::LoadTerrainFileShared(path);
+  ASSERT_TRUE(data != nullptr);
+  EXPECT_EQ(data, common::HeightmapDataLoader::LoadTerrainFileShared(path));
+  EXPECT_EQ(129u, data->GetWidth());
+
+  // The data is decoded again once released
+  data.reset();
+  data = common::HeightmapDataLoader::LoadTerrainFileShared(path);
+  ASSERT_TRUE(data != nullptr);
+  EXPECT_TRUE(dynamic_cast<common::ImageHeightmap *>(data.get()) != nullptr);
+
+  EXPECT_TRUE(common::HeightmapDataLoader::LoadTerrainFileShared(
+        "/not/a/heightmap.png") == nullptr);
+}
+
 #ifdef HAVE_GDAL
 /////////////////////////////////////////////////
 TEST_F(HeightmapDataLoaderTest, DemHeightmap)
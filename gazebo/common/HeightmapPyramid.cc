@@ -0,0 +1,465 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/common/HeightmapPyramid.hh"
+
+using namespace gazebo;
+using namespace common;
+
+/// \brief A level of the pyramid.
+class HeightmapLevel
+{
+  /// \brief Number of vertices per side.
+  public: unsigned int side = 0;
+
+  /// \brief Heights, row by row.
+  public: std::vector<float> heights;
+};
+
+/// \brief Bounds of the heights of the cells of a level. A cell of level
+/// n covers 2^n x 2^n cells of level 0, and a cell of level 0 covers 2x2
+/// vertices.
+class HeightmapBounds
+{
+  /// \brief Number of cells per side.
+  public: unsigned int side = 0;
+
+  /// \brief Smallest height of each cell, row by row.
+  public: std::vector<float> min;
+
+  /// \brief Largest height of each cell, row by row.
+  public: std::vector<float> max;
+};
+
+/// \brief Private data for the HeightmapPyramid class.
+class gazebo::common::HeightmapPyramidPrivate
+{
+  /// \brief Filter a vertex of a level from the previous level.
+  /// \param[in] _level The level, at least 1.
+  /// \param[in] _x Column of the vertex.
+  /// \param[in] _y Row of the vertex.
+  public: void Filter(const unsigned int _level, const unsigned int _x,
+              const unsigned int _y);
+
+  /// \brief Compute the bounds of a cell.
+  /// \param[in] _level Level of the cell.
+  /// \param[in] _x Column of the cell.
+  /// \param[in] _y Row of the cell.
+  public: void Bound(const unsigned int _level, const unsigned int _x,
+              const unsigned int _y);
+
+  /// \brief Levels, finest first.
+  public: std::vector<HeightmapLevel> levels;
+
+  /// \brief Bounds of the cells, finest first. The last level has a
+  /// single cell.
+  public: std::vector<HeightmapBounds> bounds;
+};
+
+/////////////////////////////////////////////////
+/// \brief Bilinear interpolation in a level.
+/// \param[in] _level The level, with at least 2 vertices per side.
+/// \param[in] _u Column, in vertices of the level.
+/// \param[in] _v Row, in vertices of the level.
+/// \return The height.
+static inline float Bilinear(const HeightmapLevel &_level, float _u,
+    float _v)
+{
+  const float last = static_cast<float>(_level.side - 1);
+  _u = std::min(std::max(_u, 0.0f), last);
+  _v = std::min(std::max(_v, 0.0f), last);
+  const unsigned int x = std::min(static_cast<unsigned int>(_u),
+      _level.side - 2);
+  const unsigned int y = std::min(static_cast<unsigned int>(_v),
+      _level.side - 2);
+  const float fx = _u - x;
+  const float fy = _v - y;
+
+  const float *row = &_level.heights[y * _level.side + x];
+  const float h0 = row[0] + (row[1] - row[0]) * fx;
+  row += _level.side;
+  const float h1 = row[0] + (row[1] - row[0]) * fx;
+  return h0 + (h1 - h0) * fy;
+}
+
+/////////////////////////////////////////////////
+/// \brief Catmull-Rom weights.
+/// \param[in] _t Position between the second and third samples.
+/// \param[out] _w Weights of the four samples.
+static inline void CubicWeights(const float _t, float _w[4])
+{
+  const float t2 = _t * _t;
+  const float t3 = t2 * _t;
+  _w[0] = 0.5f * (-t3 + 2.0f * t2 - _t);
+  _w[1] = 0.5f * (3.0f * t3 - 5.0f * t2 + 2.0f);
+  _w[2] = 0.5f * (-3.0f * t3 + 4.0f * t2 + _t);
+  _w[3] = 0.5f * (t3 - t2);
+}
+
+/////////////////////////////////////////////////
+/// \brief Bicubic interpolation in a level.
+/// \param[in] _level The level, with at least 2 vertices per side.
+/// \param[in] _u Column, in vertices of the level.
+/// \param[in] _v Row, in vertices of the level.
+/// \return The height.
+static inline float Bicubic(const HeightmapLevel &_level, float _u,
+    float _v)
+{
+  const int last = static_cast<int>(_level.side) - 1;
+  _u = std::min(std::max(_u, 0.0f), static_cast<float>(last));
+  _v = std::min(std::max(_v, 0.0f), static_cast<float>(last));
+  const int x = std::min(static_cast<int>(_u), last - 1);
+  const int y = std::min(static_cast<int>(_v), last - 1);
+
+  float wx[4], wy[4];
+  CubicWeights(_u - x, wx);
+  CubicWeights(_v - y, wy);
+
+  float height = 0.0f;
+  for (int j = 0; j < 4; ++j)
+  {
+    const int row = std::min(std::max(y + j - 1, 0), last) * _level.side;
+    float h = 0.0f;
+    for (int i = 0; i < 4; ++i)
+    {
+      const int col = std::min(std::max(x + i - 1, 0), last);
+      h += wx[i] * _level.heights[row + col];
+    }
+    height += wy[j] * h;
+  }
+  return height;
+}
+
+/////////////////////////////////////////////////
+void HeightmapPyramidPrivate::Filter(const unsigned int _level,
+    const unsigned int _x, const unsigned int _y)
+{
+  // Tent filter of the 3x3 vertices around the vertex in the previous level
+  const HeightmapLevel &prev = this->levels[_level - 1];
+  const int last = static_cast<int>(prev.side) - 1;
+  const int cx = std::min(static_cast<int>(2 * _x), last);
+  const int cy = std::min(static_cast<int>(2 * _y), last);
+  static const float kWeights[3] = {0.25f, 0.5f, 0.25f};
+
+  float height = 0.0f;
+  for (int j = 0; j < 3; ++j)
+  {
+    const int row = std::min(std::max(cy + j - 1, 0), last) * prev.side;
+    for (int i = 0; i < 3; ++i)
+    {
+      const int col = std::min(std::max(cx + i - 1, 0), last);
+      height += kWeights[i] * kWeights[j] * prev.heights[row + col];
+    }
+  }
+
+  HeightmapLevel &level = this->levels[_level];
+  level.heights[_y * level.side + _x] = height;
+}
+
+/////////////////////////////////////////////////
+void HeightmapPyramidPrivate::Bound(const unsigned int _level,
+    const unsigned int _x, const unsigned int _y)
+{
+  float min = std::numeric_limits<float>::max();
+  float max = -std::numeric_limits<float>::max();
+  if (_level == 0)
+  {
+    // The vertices of the cell
+    const HeightmapLevel &level = this->levels[0];
+    for (unsigned int y = _y; y <= std::min(_y + 1, level.side - 1); ++y)
+    {
+      for (unsigned int x = _x; x <= std::min(_x + 1, level.side - 1); ++x)
+      {
+        min = std::min(min, level.heights[y * level.side + x]);
+        max = std::max(max, level.heights[y * level.side + x]);
+      }
+    }
+  }
+  else
+  {
+    // The cells of the previous level
+    const HeightmapBounds &prev = this->bounds[_level - 1];
+    for (unsigned int y = 2 * _y; y <= std::min(2 * _y + 1, prev.side - 1);
+        ++y)
+    {
+      for (unsigned int x = 2 * _x; x <= std::min(2 * _x + 1, prev.side - 1);
+          ++x)
+      {
+        min = std::min(min, prev.min[y * prev.side + x]);
+        max = std::max(max, prev.max[y * prev.side + x]);
+      }
+    }
+  }
+
+  HeightmapBounds &bounds = this->bounds[_level];
+  bounds.min[_y * bounds.side + _x] = min;
+  bounds.max[_y * bounds.side + _x] = max;
+}
+
+/////////////////////////////////////////////////
+HeightmapPyramid::HeightmapPyramid()
+  : dataPtr(new HeightmapPyramidPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+HeightmapPyramid::~HeightmapPyramid()
+{
+}
+
+/////////////////////////////////////////////////
+void HeightmapPyramid::Build(const std::vector<float> &_heights,
+    const unsigned int _side)
+{
+  this->dataPtr->levels.clear();
+  this->dataPtr->bounds.clear();
+  if (_side == 0)
+    return;
+
+  if (_heights.size() < static_cast<size_t>(_side) * _side)
+  {
+    gzerr << "Heightmap pyramid needs " << _side << "x" << _side
+          << " heights, got " << _heights.size() << "\n";
+    return;
+  }
+
+  HeightmapLevel first;
+  first.side = _side;
+  first.heights.assign(_heights.begin(), _heights.begin() + _side * _side);
+  this->dataPtr->levels.push_back(std::move(first));
+
+  // Each level has every other vertex of the previous one
+  while (this->dataPtr->levels.back().side > 2)
+  {
+    HeightmapLevel level;
+    level.side = this->dataPtr->levels.back().side / 2 + 1;
+    level.heights.resize(level.side * level.side);
+    this->dataPtr->levels.push_back(std::move(level));
+
+    const unsigned int index = this->dataPtr->levels.size() - 1;
+    const unsigned int side = this->dataPtr->levels.back().side;
+    for (unsigned int y = 0; y < side; ++y)
+    {
+      for (unsigned int x = 0; x < side; ++x)
+        this->dataPtr->Filter(index, x, y);
+    }
+  }
+
+  // Bounds, from the cells up to a single cell
+  unsigned int cells = std::max(_side - 1, 1u);
+  while (true)
+  {
+    HeightmapBounds bounds;
+    bounds.side = cells;
+    bounds.min.resize(cells * cells);
+    bounds.max.resize(cells * cells);
+    this->dataPtr->bounds.push_back(std::move(bounds));
+
+    const unsigned int index = this->dataPtr->bounds.size() - 1;
+    for (unsigned int y = 0; y < cells; ++y)
+    {
+      for (unsigned int x = 0; x < cells; ++x)
+        this->dataPtr->Bound(index, x, y);
+    }
+
+    if (cells == 1)
+      break;
+    cells = (cells + 1) / 2;
+  }
+}
+
+/////////////////////////////////////////////////
+unsigned int HeightmapPyramid::Side() const
+{
+  return this->dataPtr->levels.empty() ? 0 :
+    this->dataPtr->levels.front().side;
+}
+
+/////////////////////////////////////////////////
+unsigned int HeightmapPyramid::LevelCount() const
+{
+  return this->dataPtr->levels.size();
+}
+
+/////////////////////////////////////////////////
+void HeightmapPyramid::SetHeight(const unsigned int _x,
+    const unsigned int _y, const float _height)
+{
+  if (_x >= this->Side() || _y >= this->Side())
+    return;
+
+  HeightmapLevel &first = this->dataPtr->levels.front();
+  first.heights[_y * first.side + _x] = _height;
+
+  // Vertices of the coarser levels whose filter covers the changed ones
+  unsigned int minX = _x, maxX = _x, minY = _y, maxY = _y;
+  for (unsigned int i = 1; i < this->dataPtr->levels.size(); ++i)
+  {
+    const unsigned int last = this->dataPtr->levels[i].side - 1;
+    minX = minX > 0 ? (minX - 1) / 2 : 0;
+    minY = minY > 0 ? (minY - 1) / 2 : 0;
+    maxX = std::min((maxX + 1) / 2 + 1, last);
+    maxY = std::min((maxY + 1) / 2 + 1, last);
+    for (unsigned int y = minY; y <= maxY; ++y)
+    {
+      for (unsigned int x = minX; x <= maxX; ++x)
+        this->dataPtr->Filter(i, x, y);
+    }
+  }
+
+  // Cells that have the vertex, and the cells above them
+  const unsigned int last = this->dataPtr->bounds.front().side - 1;
+  minX = std::min(_x > 0 ? _x - 1 : 0, last);
+  minY = std::min(_y > 0 ? _y - 1 : 0, last);
+  maxX = std::min(_x, last);
+  maxY = std::min(_y, last);
+  for (unsigned int i = 0; i < this->dataPtr->bounds.size(); ++i)
+  {
+    if (i > 0)
+    {
+      minX /= 2;
+      minY /= 2;
+      maxX /= 2;
+      maxY /= 2;
+    }
+    for (unsigned int y = minY; y <= maxY; ++y)
+    {
+      for (unsigned int x = minX; x <= maxX; ++x)
+        this->dataPtr->Bound(i, x, y);
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+float HeightmapPyramid::Height(const double _x, const double _y,
+    const unsigned int _level, const Interpolation _interpolation) const
+{
+  if (this->dataPtr->levels.empty())
+    return 0.0f;
+
+  const unsigned int index = std::min(_level,
+      static_cast<unsigned int>(this->dataPtr->levels.size() - 1));
+  const HeightmapLevel &level = this->dataPtr->levels[index];
+  if (level.side < 2)
+    return level.heights[0];
+
+  const float scale = 1.0f / (1u << index);
+  if (_interpolation == BICUBIC)
+    return Bicubic(level, _x * scale, _y * scale);
+  return Bilinear(level, _x * scale, _y * scale);
+}
+
+/////////////////////////////////////////////////
+void HeightmapPyramid::Heights(const std::vector<float> &_x,
+    const std::vector<float> &_y, std::vector<float> &_heights,
+    const unsigned int _level, const Interpolation _interpolation) const
+{
+  const size_t count = std::min(_x.size(), _y.size());
+  _heights.resize(count);
+  if (this->dataPtr->levels.empty())
+  {
+    std::fill(_heights.begin(), _heights.end(), 0.0f);
+    return;
+  }
+
+  const unsigned int index = std::min(_level,
+      static_cast<unsigned int>(this->dataPtr->levels.size() - 1));
+  const HeightmapLevel &level = this->dataPtr->levels[index];
+  if (level.side < 2)
+  {
+    std::fill(_heights.begin(), _heights.end(), level.heights[0]);
+    return;
+  }
+
+  const float scale = 1.0f / (1u << index);
+  const float *x = _x.data();
+  const float *y = _y.data();
+  float *heights = _heights.data();
+  if (_interpolation == BICUBIC)
+  {
+    for (size_t i = 0; i < count; ++i)
+      heights[i] = Bicubic(level, x[i] * scale, y[i] * scale);
+  }
+  else
+  {
+    for (size_t i = 0; i < count; ++i)
+      heights[i] = Bilinear(level, x[i] * scale, y[i] * scale);
+  }
+}
+
+/////////////////////////////////////////////////
+bool HeightmapPyramid::Range(const double _minX, const double _minY,
+    const double _maxX, const double _maxY, float &_min, float &_max) const
+{
+  if (this->dataPtr->bounds.empty())
+    return false;
+
+  // Cells of level 0 that overlap the region
+  const int last = static_cast<int>(this->dataPtr->bounds.front().side) - 1;
+  auto cell = [last](const double _pos, const int _min)
+  {
+    return std::min(std::max(static_cast<int>(std::floor(_pos)), _min),
+        last);
+  };
+  const int minX = cell(_minX, 0);
+  const int minY = cell(_minY, 0);
+  const int maxX = cell(std::ceil(_maxX) - 1, minX);
+  const int maxY = cell(std::ceil(_maxY) - 1, minY);
+
+  // The finest level where the region spans at most 2x2 cells
+  unsigned int index = 0;
+  while (index + 1 < this->dataPtr->bounds.size() &&
+      ((maxX >> index) - (minX >> index) > 1 ||
+       (maxY >> index) - (minY >> index) > 1))
+  {
+    ++index;
+  }
+
+  const HeightmapBounds &bounds = this->dataPtr->bounds[index];
+  _min = std::numeric_limits<float>::max();
+  _max = -std::numeric_limits<float>::max();
+  for (int y = minY >> index; y <= (maxY >> index); ++y)
+  {
+    for (int x = minX >> index; x <= (maxX >> index); ++x)
+    {
+      _min = std::min(_min, bounds.min[y * bounds.side + x]);
+      _max = std::max(_max, bounds.max[y * bounds.side + x]);
+    }
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+float HeightmapPyramid::Min() const
+{
+  return this->dataPtr->bounds.empty() ? 0.0f :
+    this->dataPtr->bounds.back().min[0];
+}
+
+/////////////////////////////////////////////////
+float HeightmapPyramid::Max() const
+{
+  return this->dataPtr->bounds.empty() ? 0.0f :
+    this->dataPtr->bounds.back().max[0];
+}
@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_COMMON_HEIGHTMAPPYRAMID_HH_
+#define GAZEBO_COMMON_HEIGHTMAPPYRAMID_HH_
+
+#include <memory>
+#include <vector>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace common
+  {
+    // Forward declare private data class.
+    class HeightmapPyramidPrivate;
+
+    /// \addtogroup gazebo_common Common
+    /// \{
+
+    /// \class HeightmapPyramid HeightmapPyramid.hh common/common.hh
+    /// \brief Multiresolution pyramid of a square grid of heights, with
+    /// interpolated sampling and bounds of the heights of regions.
+    ///
+    /// Level 0 holds the heights. Each following level has half the
+    /// vertices per side, filtered from the previous level, so that a
+    /// coarse sampling doesn't alias. The pyramid also keeps the minimum
+    /// and maximum heights of blocks of cells, which bound the terrain of
+    /// a region for ray and broadphase culling.
+    ///
+    /// Positions are in vertices of level 0, x along the rows. Positions
+    /// outside the grid are clamped to it.
+    class GZ_COMMON_VISIBLE HeightmapPyramid
+    {
+      /// \brief Interpolation between the vertices.
+      public: enum Interpolation
+              {
+                /// \brief Bilinear interpolation of 2x2 vertices.
+                BILINEAR,
+
+                /// \brief Catmull-Rom interpolation of 4x4 vertices, smooth
+                /// across cells.
+                BICUBIC
+              };
+
+      /// \brief Constructor.
+      public: HeightmapPyramid();
+
+      /// \brief Destructor.
+      public: virtual ~HeightmapPyramid();
+
+      /// \brief Build the pyramid, replacing the previous heights.
+      /// \param[in] _heights Heights, row by row.
+      /// \param[in] _side Number of vertices per side.
+      public: void Build(const std::vector<float> &_heights,
+                  const unsigned int _side);
+
+      /// \brief Get the number of vertices per side of level 0.
+      /// \return Number of vertices per side, 0 if the pyramid is empty.
+      public: unsigned int Side() const;
+
+      /// \brief Get the number of levels.
+      /// \return Number of levels, 0 if the pyramid is empty.
+      public: unsigned int LevelCount() const;
+
+      /// \brief Set a height of level 0, updating the coarser levels and
+      /// the bounds.
+      /// \param[in] _x Column of the vertex.
+      /// \param[in] _y Row of the vertex.
+      /// \param[in] _height The height.
+      public: void SetHeight(const unsigned int _x, const unsigned int _y,
+                  const float _height);
+
+      /// \brief Sample the height at a position.
+      /// \param[in] _x X position.
+      /// \param[in] _y Y position.
+      /// \param[in] _level Level to sample, clamped to the coarsest one.
+      /// \param[in] _interpolation Interpolation between the vertices.
+      /// \return The height, 0 if the pyramid is empty.
+      public: float Height(const double _x, const double _y,
+                  const unsigned int _level = 0,
+                  const Interpolation _interpolation = BILINEAR) const;
+
+      /// \brief Sample the heights at many positions, e.g. the contacts of
+      /// the wheels of vehicles. The loop has no branches, so that the
+      /// compiler may vectorize it.
+      /// \param[in] _x X positions.
+      /// \param[in] _y Y positions, as many as X positions.
+      /// \param[out] _heights The heights.
+      /// \param[in] _level Level to sample, clamped to the coarsest one.
+      /// \param[in] _interpolation Interpolation between the vertices.
+      public: void Heights(const std::vector<float> &_x,
+                  const std::vector<float> &_y, std::vector<float> &_heights,
+                  const unsigned int _level = 0,
+                  const Interpolation _interpolation = BILINEAR) const;
+
+      /// \brief Get bounds of the heights of a region. The bounds are
+      /// conservative: they may be those of a slightly larger region.
+      /// \param[in] _minX Smallest X position of the region.
+      /// \param[in] _minY Smallest Y position of the region.
+      /// \param[in] _maxX Largest X position of the region.
+      /// \param[in] _maxY Largest Y position of the region.
+      /// \param[out] _min Lower bound of the heights.
+      /// \param[out] _max Upper bound of the heights.
+      /// \return False if the pyramid is empty.
+      public: bool Range(const double _minX, const double _minY,
+                  const double _maxX, const double _maxY,
+                  float &_min, float &_max) const;
+
+      /// \brief Get the smallest height.
+      /// \return The smallest height, 0 if the pyramid is empty.
+      public: float Min() const;
+
+      /// \brief Get the largest height.
+      /// \return The largest height, 0 if the pyramid is empty.
+      public: float Max() const;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<HeightmapPyramidPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,173 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "gazebo/common/HeightmapPyramid.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class HeightmapPyramidTest : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+/// \brief Heights of a wavy terrain.
+/// \param[in] _side Number of vertices per side.
+/// \return The heights.
+static std::vector<float> WavyHeights(const unsigned int _side)
+{
+  std::vector<float> heights(_side * _side);
+  for (unsigned int y = 0; y < _side; ++y)
+  {
+    for (unsigned int x = 0; x < _side; ++x)
+      heights[y * _side + x] = 3.0f * std::sin(0.2f * x) + 0.1f * y;
+  }
+  return heights;
+}
+
+/////////////////////////////////////////////////
+TEST_F(HeightmapPyramidTest, Sample)
+{
+  common::HeightmapPyramid pyramid;
+  EXPECT_EQ(0u, pyramid.Side());
+  EXPECT_FLOAT_EQ(0.0f, pyramid.Height(1, 1));
+  float min, max;
+  EXPECT_FALSE(pyramid.Range(0, 0, 1, 1, min, max));
+
+  // A tilted plane
+  const unsigned int side = 33;
+  std::vector<float> heights(side * side);
+  for (unsigned int y = 0; y < side; ++y)
+  {
+    for (unsigned int x = 0; x < side; ++x)
+      heights[y * side + x] = 0.5f * x + 2.0f * y;
+  }
+  pyramid.Build(heights, side);
+  EXPECT_EQ(side, pyramid.Side());
+  EXPECT_EQ(6u, pyramid.LevelCount());
+  EXPECT_FLOAT_EQ(0.0f, pyramid.Min());
+  EXPECT_FLOAT_EQ(80.0f, pyramid.Max());
+
+  // Both interpolations are exact on a plane, and clamp outside
+  for (auto const interpolation : {common::HeightmapPyramid::BILINEAR,
+      common::HeightmapPyramid::BICUBIC})
+  {
+    EXPECT_FLOAT_EQ(0.0f, pyramid.Height(-3, -1, 0, interpolation));
+    EXPECT_FLOAT_EQ(80.0f, pyramid.Height(40, 50, 0, interpolation));
+    EXPECT_NEAR(0.5 * 10.25 + 2.0 * 3.5,
+        pyramid.Height(10.25, 3.5, 0, interpolation), 1e-4);
+
+    // Coarse levels are filtered planes, away from the borders
+    EXPECT_NEAR(0.5 * 16 + 2.0 * 12,
+        pyramid.Height(16, 12, 2, interpolation), 1e-4);
+  }
+
+  // Batched sampling matches single samples
+  std::vector<float> xs, ys, batch;
+  for (int i = 0; i < 100; ++i)
+  {
+    xs.push_back(-2.0f + 0.37f * i);
+    ys.push_back(35.0f - 0.41f * i);
+  }
+  for (auto const interpolation : {common::HeightmapPyramid::BILINEAR,
+      common::HeightmapPyramid::BICUBIC})
+  {
+    for (unsigned int level = 0; level < 7; ++level)
+    {
+      pyramid.Heights(xs, ys, batch, level, interpolation);
+      ASSERT_EQ(xs.size(), batch.size());
+      for (size_t i = 0; i < xs.size(); ++i)
+      {
+        EXPECT_FLOAT_EQ(pyramid.Height(xs[i], ys[i], level, interpolation),
+            batch[i]);
+      }
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(HeightmapPyramidTest, Range)
+{
+  const unsigned int side = 65;
+  std::vector<float> heights = WavyHeights(side);
+  common::HeightmapPyramid pyramid;
+  pyramid.Build(heights, side);
+  EXPECT_FLOAT_EQ(*std::min_element(heights.begin(), heights.end()),
+      pyramid.Min());
+  EXPECT_FLOAT_EQ(*std::max_element(heights.begin(), heights.end()),
+      pyramid.Max());
+
+  // The bounds contain the heights of the region
+  const double regions[][4] = {{0, 0, 64, 64}, {3.5, 7.2, 4.1, 7.9},
+    {10, 20, 30, 22}, {-5, -5, 2, 2}, {60, 0, 70, 64}, {12, 12, 12, 12}};
+  for (auto const &region : regions)
+  {
+    float min, max;
+    ASSERT_TRUE(pyramid.Range(region[0], region[1], region[2], region[3],
+          min, max));
+    for (double y = std::max(region[1], 0.0);
+        y <= std::min(region[3], side - 1.0); y += 0.25)
+    {
+      for (double x = std::max(region[0], 0.0);
+          x <= std::min(region[2], side - 1.0); x += 0.25)
+      {
+        const float h = pyramid.Height(x, y);
+        EXPECT_LE(min, h);
+        EXPECT_GE(max, h);
+      }
+    }
+  }
+
+  // Setting heights updates the levels and the bounds as a rebuild does
+  pyramid.SetHeight(31, 17, 50.0f);
+  pyramid.SetHeight(0, 64, -20.0f);
+  pyramid.SetHeight(64, 0, 7.0f);
+  heights[17 * side + 31] = 50.0f;
+  heights[64 * side] = -20.0f;
+  heights[64] = 7.0f;
+  common::HeightmapPyramid rebuilt;
+  rebuilt.Build(heights, side);
+  EXPECT_FLOAT_EQ(rebuilt.Min(), pyramid.Min());
+  EXPECT_FLOAT_EQ(rebuilt.Max(), pyramid.Max());
+  for (unsigned int level = 0; level < pyramid.LevelCount(); ++level)
+  {
+    for (double y = 0; y < side; y += 1.5)
+    {
+      for (double x = 0; x < side; x += 1.5)
+      {
+        EXPECT_FLOAT_EQ(rebuilt.Height(x, y, level),
+            pyramid.Height(x, y, level));
+      }
+    }
+  }
+  float min, max, rebuiltMin, rebuiltMax;
+  EXPECT_TRUE(pyramid.Range(30, 16, 32, 18, min, max));
+  EXPECT_TRUE(rebuilt.Range(30, 16, 32, 18, rebuiltMin, rebuiltMax));
+  EXPECT_FLOAT_EQ(rebuiltMin, min);
+  EXPECT_FLOAT_EQ(rebuiltMax, max);
+  EXPECT_FLOAT_EQ(50.0f, max);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "gazebo/common/Histogram.hh"
+
+using namespace gazebo;
+using namespace common;
+
+/// \internal
+/// \brief Private data for the Histogram class.
+class gazebo::common::HistogramPrivate
+{
+  /// \brief Upper bound of the first bin.
+  public: double lowerBound;
+
+  /// \brief Number of values in each bin.
+  public: std::vector<std::atomic<uint64_t>> bins;
+
+  /// \brief Number of values.
+  public: std::atomic<uint64_t> count{0};
+
+  /// \brief Sum of the values.
+  public: std::atomic<double> sum{0.0};
+
+  /// \brief Largest value.
+  public: std::atomic<double> max{0.0};
+};
+
+//////////////////////////////////////////////////
+Histogram::Histogram(const double _lowerBound, const unsigned int _binCount)
+  : dataPtr(new HistogramPrivate)
+{
+  this->dataPtr->lowerBound = _lowerBound > 0 ? _lowerBound : 1e-6;
+  this->dataPtr->bins = std::vector<std::atomic<uint64_t>>(
+      std::max(1u, _binCount));
+  this->Reset();
+}
+
+//////////////////////////////////////////////////
+Histogram::~Histogram()
+{
+}
+
+//////////////////////////////////////////////////
+void Histogram::Add(const double _value)
+{
+  const double value = _value > 0 ? _value : 0.0;
+
+  // Bin i holds the values in [lowerBound * 2^(i-1), lowerBound * 2^i)
+  size_t bin = 0;
+  if (value >= this->dataPtr->lowerBound)
+  {
+    int exponent;
+    std::frexp(value / this->dataPtr->lowerBound, &exponent);
+    bin = std::min(static_cast<size_t>(exponent),
+        this->dataPtr->bins.size() - 1);
+  }
+
+  this->dataPtr->bins[bin].fetch_add(1, std::memory_order_relaxed);
+  this->dataPtr->count.fetch_add(1, std::memory_order_relaxed);
+
+  double sum = this->dataPtr->sum.load(std::memory_order_relaxed);
+  while (!this->dataPtr->sum.compare_exchange_weak(sum, sum + value,
+        std::memory_order_relaxed))
+  {
+  }
+
+  double max = this->dataPtr->max.load(std::memory_order_relaxed);
+  while (value > max && !this->dataPtr->max.compare_exchange_weak(max,
+        value, std::memory_order_relaxed))
+  {
+  }
+}
+
+//////////////////////////////////////////////////
+void Histogram::Reset()
+{
+  for (auto &bin : this->dataPtr->bins)
+    bin = 0;
+  this->dataPtr->count = 0;
+  this->dataPtr->sum = 0.0;
+  this->dataPtr->max = 0.0;
+}
+
+//////////////////////////////////////////////////
+uint64_t Histogram::Count() const
+{
+  return this->dataPtr->count;
+}
+
+//////////////////////////////////////////////////
+double Histogram::Sum() const
+{
+  return this->dataPtr->sum;
+}
+
+//////////////////////////////////////////////////
+double Histogram::Max() const
+{
+  return this->dataPtr->max;
+}
+
+//////////////////////////////////////////////////
+unsigned int Histogram::BinCount() const
+{
+  return static_cast<unsigned int>(this->dataPtr->bins.size());
+}
+
+//////////////////////////////////////////////////
+double Histogram::BinUpperBound(const unsigned int _bin) const
+{
+  if (_bin + 1 >= this->dataPtr->bins.size())
+    return std::numeric_limits<double>::infinity();
+  return std::ldexp(this->dataPtr->lowerBound, static_cast<int>(_bin));
+}
+
+//////////////////////////////////////////////////
+uint64_t Histogram::BinValue(const unsigned int _bin) const
+{
+  if (_bin >= this->dataPtr->bins.size())
+    return 0;
+  return this->dataPtr->bins[_bin];
+}
+
+//////////////////////////////////////////////////
+double Histogram::Quantile(const double _q) const
+{
+  uint64_t total = 0;
+  for (auto const &bin : this->dataPtr->bins)
+    total += bin;
+  if (total == 0)
+    return 0.0;
+
+  const double rank = std::min(std::max(_q, 0.0), 1.0) * total;
+  uint64_t count = 0;
+  for (unsigned int i = 0; i < this->dataPtr->bins.size(); ++i)
+  {
+    count += this->dataPtr->bins[i];
+    if (count > 0 && count >= rank)
+      return std::min(this->BinUpperBound(i), this->Max());
+  }
+  return this->Max();
+}
@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_COMMON_HISTOGRAM_HH_
+#define GAZEBO_COMMON_HISTOGRAM_HH_
+
+#include <cstdint>
+#include <memory>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace common
+  {
+    // Forward declare private data class.
+    class HistogramPrivate;
+
+    /// \addtogroup gazebo_common
+    /// \{
+
+    /// \class Histogram Histogram.hh common/common.hh
+    /// \brief Histogram of durations or other positive values, with bins
+    /// whose bounds grow by a factor of two.
+    ///
+    /// Adding a value costs a few atomic operations and takes no lock, so
+    /// a histogram may be filled by one thread while another one reads it.
+    /// The values are kept until Reset is called.
+    class GZ_COMMON_VISIBLE Histogram
+    {
+      /// \brief Constructor.
+      /// \param[in] _lowerBound Upper bound of the first bin. Values
+      /// smaller than it are counted in the first bin.
+      /// \param[in] _binCount Number of bins. The last bin counts the
+      /// values that are too large for the others.
+      public: explicit Histogram(const double _lowerBound = 1e-6,
+                  const unsigned int _binCount = 32);
+
+      /// \brief Destructor.
+      public: virtual ~Histogram();
+
+      /// \brief Add a value.
+      /// \param[in] _value The value, negative values count as zero.
+      public: void Add(const double _value);
+
+      /// \brief Remove all the values.
+      public: void Reset();
+
+      /// \brief Get the number of values added.
+      /// \return Number of values.
+      public: uint64_t Count() const;
+
+      /// \brief Get the sum of the values added.
+      /// \return Sum of the values.
+      public: double Sum() const;
+
+      /// \brief Get the largest value added.
+      /// \return Largest value, 0 if there are none.
+      public: double Max() const;
+
+      /// \brief Get the number of bins.
+      /// \return Number of bins.
+      public: unsigned int BinCount() const;
+
+      /// \brief Get the upper bound of a bin.
+      /// \param[in] _bin Index of the bin.
+      /// \return Upper bound of the bin, infinite for the last bin.
+      public: double BinUpperBound(const unsigned int _bin) const;
+
+      /// \brief Get the number of values counted in a bin.
+      /// \param[in] _bin Index of the bin.
+      /// \return Number of values in the bin, 0 if the index is invalid.
+      public: uint64_t BinValue(const unsigned int _bin) const;
+
+      /// \brief Estimate a quantile of the values, e.g. 0.99 for the 99th
+      /// percentile. The estimate is the upper bound of the bin holding
+      /// the quantile, capped by the largest value.
+      /// \param[in] _q Quantile, between 0 and 1.
+      /// \return Estimated quantile, 0 if there are no values.
+      public: double Quantile(const double _q) const;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<HistogramPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <cmath>
+
+#include "gazebo/common/Histogram.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class HistogramTest : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+TEST_F(HistogramTest, Bins)
+{
+  common::Histogram histogram(1.0, 4);
+  EXPECT_EQ(4u, histogram.BinCount());
+  EXPECT_DOUBLE_EQ(1.0, histogram.BinUpperBound(0));
+  EXPECT_DOUBLE_EQ(2.0, histogram.BinUpperBound(1));
+  EXPECT_DOUBLE_EQ(4.0, histogram.BinUpperBound(2));
+  EXPECT_TRUE(std::isinf(histogram.BinUpperBound(3)));
+
+  EXPECT_EQ(0u, histogram.Count());
+  EXPECT_DOUBLE_EQ(0.0, histogram.Quantile(0.5));
+
+  histogram.Add(-1.0);
+  histogram.Add(0.5);
+  histogram.Add(1.0);
+  histogram.Add(3.0);
+  histogram.Add(100.0);
+
+  EXPECT_EQ(5u, histogram.Count());
+  EXPECT_DOUBLE_EQ(104.5, histogram.Sum());
+  EXPECT_DOUBLE_EQ(100.0, histogram.Max());
+  EXPECT_EQ(2u, histogram.BinValue(0));
+  EXPECT_EQ(1u, histogram.BinValue(1));
+  EXPECT_EQ(1u, histogram.BinValue(2));
+  EXPECT_EQ(1u, histogram.BinValue(3));
+  EXPECT_EQ(0u, histogram.BinValue(4));
+
+  // Quantiles are estimated by the bin bounds
+  EXPECT_DOUBLE_EQ(1.0, histogram.Quantile(0.0));
+  EXPECT_DOUBLE_EQ(2.0, histogram.Quantile(0.5));
+  EXPECT_DOUBLE_EQ(4.0, histogram.Quantile(0.8));
+  EXPECT_DOUBLE_EQ(100.0, histogram.Quantile(1.0));
+
+  histogram.Reset();
+  EXPECT_EQ(0u, histogram.Count());
+  EXPECT_DOUBLE_EQ(0.0, histogram.Sum());
+  EXPECT_DOUBLE_EQ(0.0, histogram.Max());
+  EXPECT_EQ(0u, histogram.BinValue(3));
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
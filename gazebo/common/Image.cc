@@ -21,7 +21,21 @@
 
 #include <FreeImage.h>
 #include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__SSSE3__)
+  #include <tmmintrin.h>
+#elif defined(__SSE2__)
+  #include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+  #include <arm_neon.h>
+#endif
 
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/CommonIface.hh"
@@ -33,6 +47,255 @@ using namespace common;
 
 int Image::count = 0;
 
+//////////////////////////////////////////////////
+/// \brief Number of channels of an 8 bit pixel format.
+/// \param[in] _format The format.
+/// \return Number of channels, 0 if the format is not an 8 bit format.
+static unsigned int channelCount(const Image::PixelFormat _format)
+{
+  switch (_format)
+  {
+    case Image::L_INT8:
+      return 1;
+    case Image::RGB_INT8:
+    case Image::BGR_INT8:
+      return 3;
+    case Image::RGBA_INT8:
+    case Image::BGRA_INT8:
+      return 4;
+    default:
+      return 0;
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Convert pixels between 3 and 4 channels, optionally swapping the
+/// first and third channels. A 4th channel added is opaque.
+/// \param[in] _src Source pixels.
+/// \param[in] _srcChannels Channels of a source pixel, 3 or 4.
+/// \param[out] _dst Destination pixels.
+/// \param[in] _dstChannels Channels of a destination pixel, 3 or 4.
+/// \param[in] _swap True to swap the first and third channels.
+/// \param[in] _count Number of pixels.
+static void convertColor(const uint8_t *_src, const unsigned int _srcChannels,
+    uint8_t *_dst, const unsigned int _dstChannels, const bool _swap,
+    const size_t _count)
+{
+  const uint8_t first = _swap ? 2 : 0;
+  const uint8_t third = _swap ? 0 : 2;
+  size_t i = 0;
+
+#if defined(__SSSE3__)
+  // Each iteration converts 4 or 5 pixels with one shuffle. Up to 16 bytes
+  // are loaded and stored, the extra bytes are written again by the next
+  // iteration or the scalar tail, which also makes in place conversions
+  // safe when the pixels do not grow.
+  const size_t step = (_srcChannels == 3 && _dstChannels == 3) ? 5 : 4;
+  int8_t shuffle[16];
+  for (int k = 0; k < 16; ++k)
+    shuffle[k] = static_cast<int8_t>(0x80);
+  for (size_t p = 0; p < step; ++p)
+  {
+    shuffle[p * _dstChannels] = static_cast<int8_t>(p * _srcChannels + first);
+    shuffle[p * _dstChannels + 1] = static_cast<int8_t>(p * _srcChannels + 1);
+    shuffle[p * _dstChannels + 2] =
+        static_cast<int8_t>(p * _srcChannels + third);
+    if (_dstChannels == 4 && _srcChannels == 4)
+      shuffle[p * 4 + 3] = static_cast<int8_t>(p * 4 + 3);
+  }
+  if (step == 5)
+    shuffle[15] = 15;
+  const __m128i mask = _mm_loadu_si128(
+      reinterpret_cast<const __m128i *>(shuffle));
+  const __m128i alpha = (_srcChannels == 3 && _dstChannels == 4) ?
+      _mm_set1_epi32(static_cast<int>(0xff000000)) : _mm_setzero_si128();
+
+  // Keep the 16 byte loads and stores inside both buffers
+  for (; i * _srcChannels + 16 <= _count * _srcChannels &&
+         i * _dstChannels + 16 <= _count * _dstChannels; i += step)
+  {
+    const __m128i v = _mm_loadu_si128(
+        reinterpret_cast<const __m128i *>(_src + i * _srcChannels));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(_dst + i * _dstChannels),
+        _mm_or_si128(_mm_shuffle_epi8(v, mask), alpha));
+  }
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+  for (; i + 16 <= _count; i += 16)
+  {
+    uint8x16x4_t v;
+    if (_srcChannels == 3)
+    {
+      const uint8x16x3_t c = vld3q_u8(_src + i * 3);
+      v.val[0] = c.val[0];
+      v.val[1] = c.val[1];
+      v.val[2] = c.val[2];
+      v.val[3] = vdupq_n_u8(255);
+    }
+    else
+    {
+      v = vld4q_u8(_src + i * 4);
+    }
+
+    if (_swap)
+    {
+      const uint8x16_t tmp = v.val[0];
+      v.val[0] = v.val[2];
+      v.val[2] = tmp;
+    }
+
+    if (_dstChannels == 3)
+    {
+      uint8x16x3_t c;
+      c.val[0] = v.val[0];
+      c.val[1] = v.val[1];
+      c.val[2] = v.val[2];
+      vst3q_u8(_dst + i * 3, c);
+    }
+    else
+    {
+      vst4q_u8(_dst + i * 4, v);
+    }
+  }
+#endif
+
+  for (; i < _count; ++i)
+  {
+    const uint8_t *s = _src + i * _srcChannels;
+    const uint8_t c0 = s[first];
+    const uint8_t c1 = s[1];
+    const uint8_t c2 = s[third];
+    const uint8_t a = _srcChannels == 4 ? s[3] : 255;
+
+    uint8_t *d = _dst + i * _dstChannels;
+    d[0] = c0;
+    d[1] = c1;
+    d[2] = c2;
+    if (_dstChannels == 4)
+      d[3] = a;
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Convert color pixels to luminance, with the BT.601 weights.
+/// \param[in] _src Source pixels.
+/// \param[in] _channels Channels of a source pixel, 3 or 4.
+/// \param[in] _redFirst True if red is the first channel, false if blue is.
+/// \param[out] _dst Luminance of the pixels.
+/// \param[in] _count Number of pixels.
+static void convertMono(const uint8_t *_src, const unsigned int _channels,
+    const bool _redFirst, uint8_t *_dst, const size_t _count)
+{
+  // Weights of red, green and blue out of 256
+  const uint8_t wr = 77;
+  const uint8_t wg = 150;
+  const uint8_t wb = 29;
+  const uint8_t w0 = _redFirst ? wr : wb;
+  const uint8_t w2 = _redFirst ? wb : wr;
+  size_t i = 0;
+
+#if defined(__SSSE3__)
+  // Spread 4 pixels to 4 bytes each, then sum the weighted channels of each
+  // pixel with 16 bit multiplies.
+  int8_t shuffle[16];
+  for (int p = 0; p < 4; ++p)
+  {
+    for (int c = 0; c < 3; ++c)
+      shuffle[p * 4 + c] = static_cast<int8_t>(p * _channels + c);
+    shuffle[p * 4 + 3] = static_cast<int8_t>(0x80);
+  }
+  const __m128i mask = _mm_loadu_si128(
+      reinterpret_cast<const __m128i *>(shuffle));
+  const __m128i weights = _mm_setr_epi16(w0, wg, w2, 0, w0, wg, w2, 0);
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i half = _mm_set1_epi32(128);
+
+  for (; i + (_channels == 3 ? 6 : 4) <= _count; i += 4)
+  {
+    const __m128i v = _mm_shuffle_epi8(_mm_loadu_si128(
+        reinterpret_cast<const __m128i *>(_src + i * _channels)), mask);
+    const __m128i lo = _mm_madd_epi16(_mm_unpacklo_epi8(v, zero), weights);
+    const __m128i hi = _mm_madd_epi16(_mm_unpackhi_epi8(v, zero), weights);
+    __m128i sum = _mm_hadd_epi32(lo, hi);
+    sum = _mm_srli_epi32(_mm_add_epi32(sum, half), 8);
+    sum = _mm_packus_epi16(_mm_packs_epi32(sum, zero), zero);
+    const int32_t out = _mm_cvtsi128_si32(sum);
+    std::memcpy(_dst + i, &out, 4);
+  }
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+  for (; i + 16 <= _count; i += 16)
+  {
+    uint8x16_t c0, c1, c2;
+    if (_channels == 3)
+    {
+      const uint8x16x3_t v = vld3q_u8(_src + i * 3);
+      c0 = v.val[0];
+      c1 = v.val[1];
+      c2 = v.val[2];
+    }
+    else
+    {
+      const uint8x16x4_t v = vld4q_u8(_src + i * 4);
+      c0 = v.val[0];
+      c1 = v.val[1];
+      c2 = v.val[2];
+    }
+
+    uint16x8_t lo = vmull_u8(vget_low_u8(c0), vdup_n_u8(w0));
+    lo = vmlal_u8(lo, vget_low_u8(c1), vdup_n_u8(wg));
+    lo = vmlal_u8(lo, vget_low_u8(c2), vdup_n_u8(w2));
+    uint16x8_t hi = vmull_u8(vget_high_u8(c0), vdup_n_u8(w0));
+    hi = vmlal_u8(hi, vget_high_u8(c1), vdup_n_u8(wg));
+    hi = vmlal_u8(hi, vget_high_u8(c2), vdup_n_u8(w2));
+    vst1q_u8(_dst + i, vcombine_u8(vrshrn_n_u16(lo, 8), vrshrn_n_u16(hi, 8)));
+  }
+#endif
+
+  for (; i < _count; ++i)
+  {
+    const uint8_t *s = _src + i * _channels;
+    _dst[i] = static_cast<uint8_t>((w0 * s[0] + wg * s[1] + w2 * s[2] + 128)
+        >> 8);
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Source pixel and weight of a destination column or row, for a
+/// bilinear resize.
+class ResizeTap
+{
+  /// \brief First source pixel.
+  public: unsigned int first = 0;
+
+  /// \brief Second source pixel.
+  public: unsigned int second = 0;
+
+  /// \brief Weight of the second source pixel, out of 256.
+  public: unsigned int weight = 0;
+};
+
+//////////////////////////////////////////////////
+/// \brief Compute the bilinear taps of a resized dimension.
+/// \param[in] _size Source size.
+/// \param[in] _dstSize Destination size.
+/// \return The taps of each destination pixel.
+static std::vector<ResizeTap> resizeTaps(const unsigned int _size,
+    const unsigned int _dstSize)
+{
+  std::vector<ResizeTap> taps(_dstSize);
+  const double scale = static_cast<double>(_size) / _dstSize;
+  for (unsigned int i = 0; i < _dstSize; ++i)
+  {
+    // Align the centers of the pixels
+    const double pos = std::min(std::max((i + 0.5) * scale - 0.5, 0.0),
+        _size - 1.0);
+    taps[i].first = static_cast<unsigned int>(pos);
+    taps[i].second = std::min(taps[i].first + 1, _size - 1);
+    taps[i].weight = static_cast<unsigned int>(
+        std::lround((pos - taps[i].first) * 256));
+  }
+  return taps;
+}
+
 //////////////////////////////////////////////////
 Image::Image(const std::string &_filename)
 {
@@ -108,6 +371,105 @@ void Image::SavePNG(const std::string &_filename)
   FreeImage_Save(FIF_PNG, this->bitmap, _filename.c_str(), 0);
 }
 
+//////////////////////////////////////////////////
+bool Image::Encode(const std::string &_format, std::string &_data,
+    const int _quality) const
+{
+  if (!this->Valid())
+    return false;
+
+  const int quality = std::max(1, std::min(100, _quality));
+  FREE_IMAGE_FORMAT fif = FIF_UNKNOWN;
+  int flags = 0;
+  if (_format == "png")
+  {
+    fif = FIF_PNG;
+    flags = PNG_Z_BEST_SPEED;
+  }
+  else if (_format == "jpeg")
+  {
+    fif = FIF_JPEG;
+    flags = quality;
+  }
+#if FREEIMAGE_MAJOR_VERSION > 3 || FREEIMAGE_MINOR_VERSION >= 17
+  else if (_format == "webp")
+  {
+    fif = FIF_WEBP;
+    flags = quality;
+  }
+#endif
+  else
+  {
+    gzerr << "Unable to encode image as [" << _format << "]\n";
+    return false;
+  }
+
+  // JPEG has no alpha channel
+  FIBITMAP *bitmap = this->bitmap;
+  FIBITMAP *converted = nullptr;
+  if (fif == FIF_JPEG && FreeImage_GetBPP(bitmap) != 8 &&
+      FreeImage_GetBPP(bitmap) != 24)
+  {
+    converted = FreeImage_ConvertTo24Bits(bitmap);
+    bitmap = converted;
+  }
+
+  bool result = false;
+  FIMEMORY *memory = FreeImage_OpenMemory();
+  if (bitmap && memory && FreeImage_SaveToMemory(fif, bitmap, memory, flags))
+  {
+    BYTE *bytes = nullptr;
+    DWORD size = 0;
+    if (FreeImage_AcquireMemory(memory, &bytes, &size))
+    {
+      _data.assign(reinterpret_cast<const char *>(bytes), size);
+      result = true;
+    }
+  }
+
+  if (memory)
+    FreeImage_CloseMemory(memory);
+  if (converted)
+    FreeImage_Unload(converted);
+  return result;
+}
+
+//////////////////////////////////////////////////
+bool Image::Encode(const unsigned char *_pixels, const unsigned int _width,
+    const unsigned int _height, const PixelFormat _pixelFormat,
+    const std::string &_format, std::string &_data, const int _quality)
+{
+  const unsigned int channels = channelCount(_pixelFormat);
+  if (!_pixels || channels == 0 || _width == 0 || _height == 0)
+    return false;
+
+  // FreeImage keeps the color channels in the byte order of the platform,
+  // and SetFromData copies them as they are
+  PixelFormat bitmapFormat = _pixelFormat;
+  if (channels >= 3)
+  {
+#if FREEIMAGE_COLORORDER == FREEIMAGE_COLORORDER_BGR
+    bitmapFormat = channels == 3 ? BGR_INT8 : BGRA_INT8;
+#else
+    bitmapFormat = channels == 3 ? RGB_INT8 : RGBA_INT8;
+#endif
+  }
+
+  Image image;
+  if (bitmapFormat == _pixelFormat)
+  {
+    image.SetFromData(_pixels, _width, _height, bitmapFormat);
+  }
+  else
+  {
+    const size_t count = static_cast<size_t>(_width) * _height;
+    std::vector<unsigned char> pixels(count * channels);
+    ConvertPixels(_pixels, _pixelFormat, pixels.data(), bitmapFormat, count);
+    image.SetFromData(pixels.data(), _width, _height, bitmapFormat);
+  }
+  return image.Encode(_format, _data, _quality);
+}
+
 //////////////////////////////////////////////////
 void Image::SetFromData(const unsigned char *_data, unsigned int _width,
     unsigned int _height, PixelFormat _format)
@@ -237,6 +599,59 @@ void Image::GetDataImpl(unsigned char **_data, unsigned int &_count,
   }
 }
 
+//////////////////////////////////////////////////
+bool Image::Data(unsigned char *_data, const size_t _size) const
+{
+  if (!this->Valid() || !_data)
+    return false;
+
+  const unsigned int line = FreeImage_GetLine(this->bitmap);
+  if (_size < static_cast<size_t>(line) * FreeImage_GetHeight(this->bitmap))
+    return false;
+
+  FreeImage_ConvertToRawBits(reinterpret_cast<BYTE*>(_data), this->bitmap,
+      line, FreeImage_GetBPP(this->bitmap), FI_RGBA_RED_MASK,
+      FI_RGBA_GREEN_MASK, FI_RGBA_BLUE_MASK, true);
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool Image::RGBData(unsigned char *_data, const size_t _size) const
+{
+  if (!this->Valid() || !_data)
+    return false;
+
+  const unsigned int width = this->GetWidth();
+  const unsigned int height = this->GetHeight();
+  const size_t line = static_cast<size_t>(width) * 3;
+  if (_size < line * height)
+    return false;
+
+  const unsigned int bpp = this->GetBPP();
+  if (FreeImage_GetImageType(this->bitmap) == FIT_BITMAP &&
+      (bpp == 24 || bpp == 32))
+  {
+    // Copy the rows top down, dropping the alpha channel like
+    // FreeImage_ConvertTo24Bits
+    const Image::PixelFormat format = bpp == 24 ? RGB_INT8 : RGBA_INT8;
+    for (unsigned int y = 0; y < height; ++y)
+    {
+      ConvertPixels(FreeImage_GetScanLine(this->bitmap, height - 1 - y),
+          format, _data + y * line, RGB_INT8, width);
+    }
+    return true;
+  }
+
+  FIBITMAP *tmp = FreeImage_ConvertTo24Bits(this->bitmap);
+  if (!tmp)
+    return false;
+  FreeImage_ConvertToRawBits(reinterpret_cast<BYTE*>(_data), tmp,
+      FreeImage_GetLine(tmp), 24, FI_RGBA_RED_MASK, FI_RGBA_GREEN_MASK,
+      FI_RGBA_BLUE_MASK, true);
+  FreeImage_Unload(tmp);
+  return true;
+}
+
 //////////////////////////////////////////////////
 unsigned int Image::GetWidth() const
 {
@@ -370,8 +785,10 @@ ignition::math::Color Image::MaxColor() const
 void Image::Rescale(int _width, int _height)
 {
 #ifndef _WIN32
-  this->bitmap = FreeImage_Rescale(this->bitmap, _width, _height,
+  FIBITMAP *scaled = FreeImage_Rescale(this->bitmap, _width, _height,
       FILTER_LANCZOS3);
+  FreeImage_Unload(this->bitmap);
+  this->bitmap = scaled;
 #else
   gzerr << "Image::Rescale is not implemented on Windows.\n";
 #endif
@@ -454,3 +871,200 @@ Image::PixelFormat Image::ConvertPixelFormat(const std::string &_format)
 
   return UNKNOWN_PIXEL_FORMAT;
 }
+
+//////////////////////////////////////////////////
+bool Image::ConvertPixels(const unsigned char *_src,
+    const PixelFormat _srcFormat, unsigned char *_dst,
+    const PixelFormat _dstFormat, const size_t _count)
+{
+  const unsigned int srcChannels = channelCount(_srcFormat);
+  const unsigned int dstChannels = channelCount(_dstFormat);
+  if (srcChannels == 0 || dstChannels == 0)
+    return false;
+
+  if (_srcFormat == _dstFormat)
+  {
+    if (_src != _dst)
+      std::memmove(_dst, _src, _count * srcChannels);
+    return true;
+  }
+
+  // Luminance is not expanded to color
+  if (srcChannels == 1)
+    return false;
+
+  const bool srcRedFirst = _srcFormat == RGB_INT8 || _srcFormat == RGBA_INT8;
+  if (dstChannels == 1)
+  {
+    convertMono(_src, srcChannels, srcRedFirst, _dst, _count);
+    return true;
+  }
+
+  const bool dstRedFirst = _dstFormat == RGB_INT8 || _dstFormat == RGBA_INT8;
+  convertColor(_src, srcChannels, _dst, dstChannels,
+      srcRedFirst != dstRedFirst, _count);
+  return true;
+}
+
+//////////////////////////////////////////////////
+void Image::ConvertDepth(const float *_src, uint16_t *_dst,
+    const size_t _count, const float _scale)
+{
+  size_t i = 0;
+
+#if defined(__SSE2__)
+  const __m128 scale = _mm_set1_ps(_scale);
+  const __m128 zero = _mm_setzero_ps();
+  const __m128 max = _mm_set1_ps(65535.0f);
+  const __m128 half = _mm_set1_ps(0.5f);
+  const __m128i bias = _mm_set1_epi32(32768);
+  const __m128i unbias = _mm_set1_epi16(static_cast<int16_t>(0x8000));
+  for (; i + 8 <= _count; i += 8)
+  {
+    // _mm_max_ps returns its second operand for NaN
+    __m128 a = _mm_min_ps(_mm_max_ps(_mm_mul_ps(
+        _mm_loadu_ps(_src + i), scale), zero), max);
+    __m128 b = _mm_min_ps(_mm_max_ps(_mm_mul_ps(
+        _mm_loadu_ps(_src + i + 4), scale), zero), max);
+
+    // Pack to unsigned 16 bit with the signed pack of SSE2
+    const __m128i ia = _mm_sub_epi32(
+        _mm_cvttps_epi32(_mm_add_ps(a, half)), bias);
+    const __m128i ib = _mm_sub_epi32(
+        _mm_cvttps_epi32(_mm_add_ps(b, half)), bias);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(_dst + i),
+        _mm_xor_si128(_mm_packs_epi32(ia, ib), unbias));
+  }
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+  const float32x4_t half = vdupq_n_f32(0.5f);
+  for (; i + 8 <= _count; i += 8)
+  {
+    // The conversion saturates, and converts NaN to 0
+    const uint32x4_t a = vcvtq_u32_f32(vmlaq_n_f32(half,
+        vld1q_f32(_src + i), _scale));
+    const uint32x4_t b = vcvtq_u32_f32(vmlaq_n_f32(half,
+        vld1q_f32(_src + i + 4), _scale));
+    vst1q_u16(_dst + i, vcombine_u16(vqmovn_u32(a), vqmovn_u32(b)));
+  }
+#endif
+
+  for (; i < _count; ++i)
+  {
+    const float v = _src[i] * _scale;
+    if (!(v > 0.0f))
+      _dst[i] = 0;
+    else if (v >= 65535.0f)
+      _dst[i] = 65535;
+    else
+      _dst[i] = static_cast<uint16_t>(v + 0.5f);
+  }
+}
+
+//////////////////////////////////////////////////
+bool Image::Resize(const unsigned char *_src, const unsigned int _width,
+    const unsigned int _height, const unsigned int _channels,
+    unsigned char *_dst, const unsigned int _dstWidth,
+    const unsigned int _dstHeight, const ResizeFilter _filter)
+{
+  if (_width == 0 || _height == 0 || _channels == 0 || _dstWidth == 0 ||
+      _dstHeight == 0)
+  {
+    return false;
+  }
+
+  const size_t srcRow = static_cast<size_t>(_width) * _channels;
+  const size_t dstRow = static_cast<size_t>(_dstWidth) * _channels;
+
+  if (_filter == RESIZE_BOX)
+  {
+    // Average the source pixels covered by each destination pixel, at least
+    // one per axis so that upscaling repeats pixels
+    std::vector<uint32_t> sums(dstRow);
+    for (unsigned int y = 0; y < _dstHeight; ++y)
+    {
+      const unsigned int y0 = static_cast<unsigned int>(
+          static_cast<uint64_t>(y) * _height / _dstHeight);
+      const unsigned int y1 = std::max(y0 + 1, static_cast<unsigned int>(
+          static_cast<uint64_t>(y + 1) * _height / _dstHeight));
+
+      for (unsigned int x = 0; x < _dstWidth; ++x)
+      {
+        const unsigned int x0 = static_cast<unsigned int>(
+            static_cast<uint64_t>(x) * _width / _dstWidth);
+        const unsigned int x1 = std::max(x0 + 1, static_cast<unsigned int>(
+            static_cast<uint64_t>(x + 1) * _width / _dstWidth));
+        const uint32_t area = (x1 - x0) * (y1 - y0);
+
+        for (unsigned int c = 0; c < _channels; ++c)
+        {
+          uint32_t sum = 0;
+          for (unsigned int sy = y0; sy < y1; ++sy)
+          {
+            const unsigned char *row = _src + sy * srcRow + c;
+            for (unsigned int sx = x0; sx < x1; ++sx)
+              sum += row[sx * _channels];
+          }
+          _dst[y * dstRow + x * _channels + c] =
+              static_cast<unsigned char>((sum + area / 2) / area);
+        }
+      }
+    }
+    return true;
+  }
+
+  // Bilinear, filtering the rows horizontally then blending two rows
+  const std::vector<ResizeTap> columns = resizeTaps(_width, _dstWidth);
+  const std::vector<ResizeTap> rows = resizeTaps(_height, _dstHeight);
+  std::vector<uint16_t> first(dstRow);
+  std::vector<uint16_t> second(dstRow);
+  auto filterRow = [&](const unsigned int _row, std::vector<uint16_t> &_out)
+  {
+    const unsigned char *row = _src + _row * srcRow;
+    for (unsigned int x = 0; x < _dstWidth; ++x)
+    {
+      const ResizeTap &tap = columns[x];
+      const unsigned char *p0 = row + tap.first * _channels;
+      const unsigned char *p1 = row + tap.second * _channels;
+      for (unsigned int c = 0; c < _channels; ++c)
+      {
+        _out[x * _channels + c] = static_cast<uint16_t>(
+            p0[c] * (256 - tap.weight) + p1[c] * tap.weight);
+      }
+    }
+  };
+
+  unsigned int firstRow = _height;
+  unsigned int secondRow = _height;
+  for (unsigned int y = 0; y < _dstHeight; ++y)
+  {
+    const ResizeTap &tap = rows[y];
+
+    // Consecutive destination rows mostly share their source rows
+    if (firstRow != tap.first)
+    {
+      if (secondRow == tap.first)
+      {
+        std::swap(first, second);
+        std::swap(firstRow, secondRow);
+      }
+      else
+      {
+        filterRow(tap.first, first);
+        firstRow = tap.first;
+      }
+    }
+    if (secondRow != tap.second)
+    {
+      filterRow(tap.second, second);
+      secondRow = tap.second;
+    }
+
+    unsigned char *out = _dst + y * dstRow;
+    for (size_t i = 0; i < dstRow; ++i)
+    {
+      out[i] = static_cast<unsigned char>((first[i] * (256 - tap.weight) +
+          second[i] * tap.weight + 32768) >> 16);
+    }
+  }
+  return true;
+}
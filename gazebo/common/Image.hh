@@ -22,6 +22,8 @@
 #ifndef _IMAGE_HH_
 #define _IMAGE_HH_
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <ignition/math/Color.hh>
 
@@ -89,6 +91,17 @@ namespace gazebo
                 PIXEL_FORMAT_COUNT
               };
 
+      /// \brief Filters of Image::Resize.
+      public: enum ResizeFilter
+              {
+                /// \brief Average of the source pixels covered by each
+                /// destination pixel, suited to downscaling.
+                RESIZE_BOX,
+
+                /// \brief Bilinear interpolation of the source pixels.
+                RESIZE_BILINEAR
+              };
+
 
       /// \brief Convert a string to a Image::PixelFormat.
       /// \param[in] _format Pixel format string. \sa Image::PixelFormatNames
@@ -112,6 +125,35 @@ namespace gazebo
       /// \param[in] _filename The name of the saved image
       public: void SavePNG(const std::string &_filename);
 
+      /// \brief Encode the image in memory.
+      /// \param[in] _format Encoding, "png", "jpeg" or "webp". The webp
+      /// encoding needs FreeImage 3.17 or later.
+      /// \param[out] _data The encoded image.
+      /// \param[in] _quality Quality of the lossy encodings, from 1 to
+      /// 100.
+      /// \return False if the image is invalid or the encoding failed or
+      /// is not supported.
+      public: bool Encode(const std::string &_format, std::string &_data,
+                  const int _quality = 90) const;
+
+      /// \brief Encode 8 bit pixels in memory, with their channels in the
+      /// order given by the pixel format.
+      /// \param[in] _pixels Pixels, rows without padding, top row first.
+      /// \param[in] _width Width in pixels.
+      /// \param[in] _height Height in pixels.
+      /// \param[in] _pixelFormat L_INT8, RGB_INT8, BGR_INT8, RGBA_INT8 or
+      /// BGRA_INT8.
+      /// \param[in] _format Encoding, "png", "jpeg" or "webp".
+      /// \param[out] _data The encoded image.
+      /// \param[in] _quality Quality of the lossy encodings, from 1 to
+      /// 100.
+      /// \return False if the pixel format or the encoding is not
+      /// supported, or the encoding failed.
+      public: static bool Encode(const unsigned char *_pixels,
+                  const unsigned int _width, const unsigned int _height,
+                  const PixelFormat _pixelFormat, const std::string &_format,
+                  std::string &_data, const int _quality = 90);
+
       /// \brief Set the image from raw data
       /// \param[in] _data Pointer to the raw image data
       /// \param[in] _width Width in pixels
@@ -135,6 +177,65 @@ namespace gazebo
       public: void GetRGBData(unsigned char **_data,
                               unsigned int &_count) const;
 
+      /// \brief Copy the image into a caller provided buffer, in the
+      /// layout of GetData, without allocating.
+      /// \param[out] _data Buffer of at least GetPitch() * GetHeight()
+      /// bytes.
+      /// \param[in] _size Size of the buffer in bytes.
+      /// \return False if the image is invalid or the buffer is too small.
+      public: bool Data(unsigned char *_data, const size_t _size) const;
+
+      /// \brief Copy only the RGB data of the image into a caller provided
+      /// buffer, in the layout of GetRGBData. 24 and 32 bit images are
+      /// copied without allocating.
+      /// \param[out] _data Buffer of at least GetWidth() * GetHeight() * 3
+      /// bytes.
+      /// \param[in] _size Size of the buffer in bytes.
+      /// \return False if the image is invalid or the buffer is too small.
+      public: bool RGBData(unsigned char *_data, const size_t _size) const;
+
+      /// \brief Convert 8 bit pixels between formats, into a caller provided
+      /// buffer. The conversions between RGB_INT8, BGR_INT8, RGBA_INT8 and
+      /// BGRA_INT8, where an added alpha is opaque, and from any of these to
+      /// L_INT8 are supported, as well as copies. They use SSSE3 or NEON
+      /// when the compiler enables them.
+      /// \param[in] _src Source pixels.
+      /// \param[in] _srcFormat Format of the source pixels.
+      /// \param[out] _dst Destination pixels, which may be _src when the
+      /// pixel size does not grow.
+      /// \param[in] _dstFormat Format of the destination pixels.
+      /// \param[in] _count Number of pixels.
+      /// \return False if the conversion is not supported.
+      public: static bool ConvertPixels(const unsigned char *_src,
+                  const PixelFormat _srcFormat, unsigned char *_dst,
+                  const PixelFormat _dstFormat, const size_t _count);
+
+      /// \brief Convert depths to 16 bit values, e.g. millimeters for a
+      /// scale of 1000. Values are rounded and clamped to [0, 65535], and
+      /// NaN becomes 0.
+      /// \param[in] _src Depths.
+      /// \param[out] _dst Converted depths.
+      /// \param[in] _count Number of depths.
+      /// \param[in] _scale Factor applied to the depths.
+      public: static void ConvertDepth(const float *_src, uint16_t *_dst,
+                  const size_t _count, const float _scale = 1000.0f);
+
+      /// \brief Resize 8 bit pixels into a caller provided buffer.
+      /// \param[in] _src Source pixels, rows without padding.
+      /// \param[in] _width Source width.
+      /// \param[in] _height Source height.
+      /// \param[in] _channels Number of channels of a pixel.
+      /// \param[out] _dst Destination pixels, which must not overlap _src.
+      /// \param[in] _dstWidth Destination width.
+      /// \param[in] _dstHeight Destination height.
+      /// \param[in] _filter Resize filter.
+      /// \return False if a size is zero.
+      public: static bool Resize(const unsigned char *_src,
+                  const unsigned int _width, const unsigned int _height,
+                  const unsigned int _channels, unsigned char *_dst,
+                  const unsigned int _dstWidth, const unsigned int _dstHeight,
+                  const ResizeFilter _filter = RESIZE_BILINEAR);
+
       /// \brief Get the width
       /// \return The image width
       public: unsigned int GetWidth() const;
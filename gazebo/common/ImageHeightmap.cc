@@ -15,6 +15,8 @@
  *
  */
 
+#include <algorithm>
+
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/ImageHeightmap.hh"
@@ -36,6 +38,10 @@ int ImageHeightmap::Load(const std::string &_filename)
     return -1;
   }
 
+  this->data.resize(static_cast<size_t>(this->img.GetPitch()) *
+      this->img.GetHeight());
+  this->img.Data(this->data.data(), this->data.size());
+
   return 0;
 }
 
@@ -45,8 +51,19 @@ void ImageHeightmap::FillHeightMap(int _subSampling,
     const ignition::math::Vector3d &_scale, bool _flipY,
     std::vector<float> &_heights)
 {
-  // Resize the vector to match the size of the vertices.
-  _heights.resize(_vertSize * _vertSize);
+  this->FillHeightMapTile(_subSampling, _vertSize, _size, _scale, _flipY,
+      0, 0, _vertSize, 1, _heights);
+}
+
+//////////////////////////////////////////////////
+void ImageHeightmap::FillHeightMapTile(int _subSampling,
+    unsigned int _vertSize, const ignition::math::Vector3d &_size,
+    const ignition::math::Vector3d &_scale, bool _flipY,
+    unsigned int _x, unsigned int _y, unsigned int _tileSize,
+    unsigned int _stride, std::vector<float> &_heights)
+{
+  // Resize the vector to match the size of the tile.
+  _heights.resize(_tileSize * _tileSize);
 
   int imgHeight = this->GetHeight();
   int imgWidth = this->GetWidth();
@@ -59,13 +76,15 @@ void ImageHeightmap::FillHeightMap(int _subSampling,
   // Bytes per pixel
   unsigned int bpp = pitch / imgWidth;
 
-  unsigned char *data = nullptr;
-  unsigned int count;
-  this->img.GetData(&data, count);
+  const unsigned char *data = this->data.data();
 
-  // Iterate over all the vertices
-  for (unsigned int y = 0; y < _vertSize; ++y)
+  // Iterate over the vertices of the tile
+  for (unsigned int i = 0; i < _tileSize; ++i)
   {
+    // Row of the vertex, before flipping
+    unsigned int row = std::min(_y + i * _stride, _vertSize - 1);
+    unsigned int y = _flipY ? _vertSize - row - 1 : row;
+
     // yf ranges between 0 and 4
     double yf = y / static_cast<double>(_subSampling);
     int y1 = floor(yf);
@@ -74,8 +93,10 @@ void ImageHeightmap::FillHeightMap(int _subSampling,
       y2 = imgHeight-1;
     double dy = yf - y1;
 
-    for (unsigned int x = 0; x < _vertSize; ++x)
+    for (unsigned int j = 0; j < _tileSize; ++j)
     {
+      unsigned int x = std::min(_x + j * _stride, _vertSize - 1);
+
       double xf = x / static_cast<double>(_subSampling);
       int x1 = floor(xf);
       int x2 = ceil(xf);
@@ -100,14 +121,9 @@ void ImageHeightmap::FillHeightMap(int _subSampling,
         h = 1.0 - h;
 
       // Store the height for future use
-      if (!_flipY)
-        _heights[y * _vertSize + x] = h;
-      else
-        _heights[(_vertSize - y - 1) * _vertSize + x] = h;
+      _heights[i * _tileSize + j] = h;
     }
   }
-
-  delete [] data;
 }
 
 //////////////////////////////////////////////////
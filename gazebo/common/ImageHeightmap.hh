@@ -53,6 +53,13 @@ namespace gazebo
           const ignition::math::Vector3d &_scale, bool _flipY,
           std::vector<float> &_heights);
 
+      // Documentation inherited.
+      public: void FillHeightMapTile(int _subSampling, unsigned int _vertSize,
+          const ignition::math::Vector3d &_size,
+          const ignition::math::Vector3d &_scale, bool _flipY,
+          unsigned int _x, unsigned int _y, unsigned int _tileSize,
+          unsigned int _stride, std::vector<float> &_heights);
+
       /// \brief Get the full filename of the image
       /// \return The filename used to load the image
       public: std::string GetFilename() const;
@@ -68,6 +75,10 @@ namespace gazebo
 
       /// \brief Image containing the heightmap data.
       private: gazebo::common::Image img;
+
+      /// \brief Pixels of the image, copied once when it is loaded so that
+      /// filling tiles does not copy the image.
+      private: std::vector<unsigned char> data;
     };
     /// \}
   }
@@ -15,6 +15,7 @@
  *
 */
 
+#include <algorithm>
 #include <boost/filesystem.hpp>
 #include <gtest/gtest.h>
 
@@ -103,6 +104,49 @@ TEST_F(ImageHeightmapTest, FillHeightmap)
   EXPECT_NEAR(5.0, elevations.at(elevations.size() / 2), ELEVATION_TOL);
 }
 
+/////////////////////////////////////////////////
+TEST_F(ImageHeightmapTest, FillHeightmapTile)
+{
+  common::ImageHeightmap img;
+  std::string path;
+
+  path = "file://media/materials/textures/heightmap_bowl.png";
+  EXPECT_EQ(0, img.Load(path));
+
+  int subsampling = 2;
+  unsigned int vertSize = (img.GetWidth() * subsampling) - 1;
+  ignition::math::Vector3d size(129, 129, 10);
+  ignition::math::Vector3d scale(size.X() / vertSize, size.Y() / vertSize,
+      size.Z() / img.GetMaxElevation());
+
+  for (bool flipY : {false, true})
+  {
+    std::vector<float> elevations;
+    img.FillHeightMap(subsampling, vertSize, size, scale, flipY, elevations);
+
+    // A tile at every other vertex, which runs past the last column
+    const unsigned int x = 200;
+    const unsigned int y = 17;
+    const unsigned int tileSize = 33;
+    const unsigned int stride = 2;
+    std::vector<float> tile;
+    img.FillHeightMapTile(subsampling, vertSize, size, scale, flipY,
+        x, y, tileSize, stride, tile);
+    ASSERT_EQ(tileSize * tileSize, tile.size());
+
+    for (unsigned int i = 0; i < tileSize; ++i)
+    {
+      for (unsigned int j = 0; j < tileSize; ++j)
+      {
+        unsigned int row = std::min(y + i * stride, vertSize - 1);
+        unsigned int column = std::min(x + j * stride, vertSize - 1);
+        EXPECT_FLOAT_EQ(elevations[row * vertSize + column],
+            tile[i * tileSize + j]);
+      }
+    }
+  }
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
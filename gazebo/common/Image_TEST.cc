@@ -16,6 +16,11 @@
 */
 
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
 #include <ignition/math/Color.hh>
 
 #include "gazebo/common/Image.hh"
@@ -100,6 +105,149 @@ TEST_F(ImageTest, ConvertPixelFormat)
      Image::ConvertPixelFormat("BAYER_BGGR8"));
 }
 
+/////////////////////////////////////////////////
+TEST_F(ImageTest, ConvertPixels)
+{
+  using Image = gazebo::common::Image;
+
+  // Enough pixels to run both the vector and the scalar loops.
+  const size_t count = 37;
+  std::vector<unsigned char> rgb(count * 3);
+  for (size_t i = 0; i < rgb.size(); ++i)
+    rgb[i] = static_cast<unsigned char>(i * 7);
+
+  std::vector<unsigned char> bgr(count * 3);
+  EXPECT_TRUE(Image::ConvertPixels(rgb.data(), Image::RGB_INT8,
+      bgr.data(), Image::BGR_INT8, count));
+  std::vector<unsigned char> rgba(count * 4);
+  EXPECT_TRUE(Image::ConvertPixels(bgr.data(), Image::BGR_INT8,
+      rgba.data(), Image::RGBA_INT8, count));
+  std::vector<unsigned char> mono(count);
+  EXPECT_TRUE(Image::ConvertPixels(rgba.data(), Image::RGBA_INT8,
+      mono.data(), Image::L_INT8, count));
+
+  for (size_t i = 0; i < count; ++i)
+  {
+    const unsigned char *p = &rgb[i * 3];
+    EXPECT_EQ(p[0], bgr[i * 3 + 2]);
+    EXPECT_EQ(p[1], bgr[i * 3 + 1]);
+    EXPECT_EQ(p[2], bgr[i * 3]);
+    EXPECT_EQ(p[0], rgba[i * 4]);
+    EXPECT_EQ(p[1], rgba[i * 4 + 1]);
+    EXPECT_EQ(p[2], rgba[i * 4 + 2]);
+    EXPECT_EQ(255, rgba[i * 4 + 3]);
+    EXPECT_EQ((77 * p[0] + 150 * p[1] + 29 * p[2] + 128) >> 8, mono[i]);
+  }
+
+  // Converting in place when the pixels do not grow
+  std::vector<unsigned char> inPlace(rgba);
+  EXPECT_TRUE(Image::ConvertPixels(inPlace.data(), Image::RGBA_INT8,
+      inPlace.data(), Image::BGR_INT8, count));
+  EXPECT_TRUE(std::equal(bgr.begin(), bgr.end(), inPlace.begin()));
+
+  EXPECT_FALSE(Image::ConvertPixels(mono.data(), Image::L_INT8,
+      rgb.data(), Image::RGB_INT8, count));
+  EXPECT_FALSE(Image::ConvertPixels(rgb.data(), Image::RGB_INT8,
+      bgr.data(), Image::BAYER_RGGB8, count));
+}
+
+/////////////////////////////////////////////////
+TEST_F(ImageTest, ConvertDepth)
+{
+  using Image = gazebo::common::Image;
+
+  std::vector<float> depth = {0.0f, 1.0f, 0.0015f, -1.0f, NAN, INFINITY,
+      65.535f, 70.0f, 12.3456f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f,
+      9.0f};
+  std::vector<uint16_t> expected = {0, 1000, 2, 0, 0, 65535, 65535, 65535,
+      12346, 2000, 3000, 4000, 5000, 6000, 7000, 8000, 9000};
+  std::vector<uint16_t> out(depth.size());
+  Image::ConvertDepth(depth.data(), out.data(), depth.size());
+  EXPECT_EQ(expected, out);
+}
+
+/////////////////////////////////////////////////
+TEST_F(ImageTest, Resize)
+{
+  using Image = gazebo::common::Image;
+
+  std::vector<unsigned char> src(8 * 6 * 3);
+  for (size_t i = 0; i < src.size(); ++i)
+    src[i] = static_cast<unsigned char>(i % 251);
+
+  // Halving averages 2x2 blocks
+  std::vector<unsigned char> half(4 * 3 * 3);
+  EXPECT_TRUE(Image::Resize(src.data(), 8, 6, 3, half.data(), 4, 3,
+      Image::RESIZE_BOX));
+  EXPECT_EQ((src[0] + src[3] + src[24] + src[27] + 2) / 4, half[0]);
+
+  // The same size copies the image
+  std::vector<unsigned char> same(src.size());
+  EXPECT_TRUE(Image::Resize(src.data(), 8, 6, 3, same.data(), 8, 6));
+  EXPECT_EQ(src, same);
+
+  // Bilinear upsampling of a gradient
+  std::vector<unsigned char> gradient = {0, 200};
+  std::vector<unsigned char> up(4);
+  EXPECT_TRUE(Image::Resize(gradient.data(), 2, 1, 1, up.data(), 4, 1));
+  EXPECT_EQ(0, up[0]);
+  EXPECT_EQ(50, up[1]);
+  EXPECT_EQ(150, up[2]);
+  EXPECT_EQ(200, up[3]);
+
+  EXPECT_FALSE(Image::Resize(gradient.data(), 0, 1, 1, up.data(), 4, 1));
+}
+
+/////////////////////////////////////////////////
+TEST_F(ImageTest, RGBData)
+{
+  common::Image img;
+  EXPECT_EQ(0, img.Load("file://media/materials/textures/wood.jpg"));
+
+  unsigned char *data = nullptr;
+  unsigned int size = 0;
+  img.GetRGBData(&data, size);
+
+  std::vector<unsigned char> rgb(size);
+  EXPECT_FALSE(img.RGBData(rgb.data(), size - 1));
+  EXPECT_TRUE(img.RGBData(rgb.data(), size));
+  EXPECT_TRUE(std::equal(rgb.begin(), rgb.end(), data));
+  delete [] data;
+
+  std::vector<unsigned char> raw(img.GetPitch() * img.GetHeight());
+  EXPECT_TRUE(img.Data(raw.data(), raw.size()));
+}
+
+/////////////////////////////////////////////////
+TEST_F(ImageTest, Encode)
+{
+  common::Image img;
+  std::string data;
+  EXPECT_FALSE(img.Encode("png", data));
+
+  const unsigned int width = 16;
+  const unsigned int height = 8;
+  std::vector<unsigned char> pixels(width * height * 3);
+  for (size_t i = 0; i < pixels.size(); ++i)
+    pixels[i] = static_cast<unsigned char>(i * 7);
+  img.SetFromData(pixels.data(), width, height, common::Image::RGB_INT8);
+
+  // PNG signature
+  ASSERT_TRUE(img.Encode("png", data));
+  ASSERT_GT(data.size(), 8u);
+  EXPECT_EQ(std::string("\x89PNG", 4), data.substr(0, 4));
+
+  // JPEG start of image marker, lower quality gives fewer bytes
+  std::string high;
+  std::string low;
+  ASSERT_TRUE(img.Encode("jpeg", high, 100));
+  ASSERT_TRUE(img.Encode("jpeg", low, 10));
+  ASSERT_GT(low.size(), 2u);
+  EXPECT_EQ(std::string("\xFF\xD8", 2), low.substr(0, 2));
+  EXPECT_LT(low.size(), high.size());
+
+  EXPECT_FALSE(img.Encode("bmp", data));
+}
 
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
@@ -0,0 +1,577 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef _WIN32
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include "gazebo/common/CommonIface.hh"
+#include "gazebo/common/Console.hh"
+#include "gazebo/common/Material.hh"
+#include "gazebo/common/Mesh.hh"
+#include "gazebo/common/MeshCache.hh"
+
+using namespace gazebo;
+using namespace common;
+
+/// \brief Version of the cache files, to change with their layout or with
+/// the mesh loaders.
+static const uint32_t kCacheVersion = 1;
+
+/// \brief First bytes of a cache file.
+static const char kMagic[4] = {'G', 'Z', 'M', 'C'};
+
+/// \brief Written after the magic, to reject files of another byte order.
+static const uint32_t kByteOrder = 0x01020304;
+
+/////////////////////////////////////////////////
+/// \brief A read only file mapped in memory.
+class MappedFile
+{
+  /// \brief Constructor.
+  /// \param[in] _filename Path of the file.
+  public: explicit MappedFile(const std::string &_filename)
+          {
+#ifndef _WIN32
+            int fd = open(_filename.c_str(), O_RDONLY);
+            if (fd < 0)
+              return;
+
+            struct stat info;
+            if (fstat(fd, &info) == 0)
+            {
+              if (info.st_size == 0)
+              {
+                this->data = "";
+              }
+              else
+              {
+                void *mapping = mmap(nullptr, info.st_size, PROT_READ,
+                    MAP_PRIVATE, fd, 0);
+                if (mapping != MAP_FAILED)
+                {
+                  this->mapping = mapping;
+                  this->data = static_cast<const char *>(mapping);
+                  this->size = info.st_size;
+                }
+              }
+            }
+            close(fd);
+#else
+            std::ifstream file(_filename, std::ios::binary);
+            if (!file)
+              return;
+            this->buffer.assign(std::istreambuf_iterator<char>(file),
+                std::istreambuf_iterator<char>());
+            this->data = this->buffer.data();
+            this->size = this->buffer.size();
+#endif
+          }
+
+  /// \brief Destructor.
+  public: ~MappedFile()
+          {
+#ifndef _WIN32
+            if (this->mapping)
+              munmap(this->mapping, this->size);
+#endif
+          }
+
+  /// \brief Content of the file, null if it couldn't be read.
+  public: const char *data = nullptr;
+
+  /// \brief Size of the file.
+  public: size_t size = 0;
+
+  /// \brief The mapping, null for an empty file.
+  private: void *mapping = nullptr;
+
+  /// \brief Content of the file, where files aren't mapped.
+  private: std::string buffer;
+};
+
+/////////////////////////////////////////////////
+/// \brief Bytes of a mapped file, as given to get_sha1.
+class ByteRange
+{
+  /// \brief Get a byte.
+  /// \param[in] _i Index of the byte.
+  /// \return The byte.
+  public: const char &operator[](const size_t _i) const
+          {
+            return this->data[_i];
+          }
+
+  /// \brief Get the number of bytes.
+  /// \return Number of bytes.
+  public: size_t size() const
+          {
+            return this->count;
+          }
+
+  /// \brief First byte.
+  public: const char *data;
+
+  /// \brief Number of bytes.
+  public: size_t count;
+};
+
+/////////////////////////////////////////////////
+/// \brief Appends the fields of a cache file to a buffer.
+class CacheWriter
+{
+  /// \brief Append a plain value.
+  /// \param[in] _value The value.
+  public: template<typename T> void Pod(const T &_value)
+          {
+            this->buffer.append(reinterpret_cast<const char *>(&_value),
+                sizeof(_value));
+          }
+
+  /// \brief Append a string, preceded by its size.
+  /// \param[in] _value The string.
+  public: void String(const std::string &_value)
+          {
+            this->Pod(static_cast<uint32_t>(_value.size()));
+            this->buffer.append(_value);
+          }
+
+  /// \brief Append a color.
+  /// \param[in] _value The color.
+  public: void Color(const ignition::math::Color &_value)
+          {
+            this->Pod(_value.R());
+            this->Pod(_value.G());
+            this->Pod(_value.B());
+            this->Pod(_value.A());
+          }
+
+  /// \brief Content of the file.
+  public: std::string buffer;
+};
+
+/////////////////////////////////////////////////
+/// \brief Reads the fields of a cache file, checking its bounds.
+class CacheReader
+{
+  /// \brief Constructor.
+  /// \param[in] _data Content of the file.
+  /// \param[in] _size Size of the file.
+  public: CacheReader(const char *_data, const size_t _size)
+            : pos(_data), end(_data + _size)
+          {
+          }
+
+  /// \brief Read bytes.
+  /// \param[out] _out Destination of the bytes.
+  /// \param[in] _size Number of bytes.
+  /// \return False if the file is too short.
+  public: bool Bytes(void *_out, const size_t _size)
+          {
+            if (!this->ok || static_cast<size_t>(this->end - this->pos) < _size)
+            {
+              this->ok = false;
+              return false;
+            }
+            if (_size > 0)
+              std::memcpy(_out, this->pos, _size);
+            this->pos += _size;
+            return true;
+          }
+
+  /// \brief Read a plain value.
+  /// \return The value, zero if the file is too short.
+  public: template<typename T> T Pod()
+          {
+            T value{};
+            this->Bytes(&value, sizeof(value));
+            return value;
+          }
+
+  /// \brief Read a string.
+  /// \return The string.
+  public: std::string String()
+          {
+            const uint32_t size = this->Pod<uint32_t>();
+            if (!this->Fits(size, 1))
+              return std::string();
+            std::string value(this->pos, size);
+            this->pos += size;
+            return value;
+          }
+
+  /// \brief Read a color.
+  /// \return The color.
+  public: ignition::math::Color Color()
+          {
+            const float r = this->Pod<float>();
+            const float g = this->Pod<float>();
+            const float b = this->Pod<float>();
+            const float a = this->Pod<float>();
+            return ignition::math::Color(r, g, b, a);
+          }
+
+  /// \brief Check that the rest of the file holds a number of elements,
+  /// before they are allocated.
+  /// \param[in] _count Number of elements.
+  /// \param[in] _size Size of an element.
+  /// \return False if the file is too short.
+  public: bool Fits(const uint64_t _count, const size_t _size)
+          {
+            if (!this->ok ||
+                _count > static_cast<uint64_t>(this->end - this->pos) / _size)
+            {
+              this->ok = false;
+            }
+            return this->ok;
+          }
+
+  /// \brief Current position.
+  public: const char *pos;
+
+  /// \brief End of the file.
+  public: const char *end;
+
+  /// \brief False once a read failed.
+  public: bool ok = true;
+};
+
+/////////////////////////////////////////////////
+/// \brief Hash the content of a file.
+/// \param[in] _filename Path of the file.
+/// \return The hash, empty if the file couldn't be read.
+static std::string FileHash(const std::string &_filename)
+{
+  MappedFile file(_filename);
+  if (!file.data)
+    return std::string();
+  return get_sha1<ByteRange>(ByteRange{file.data, file.size});
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the material libraries of an OBJ file.
+/// \param[in] _filename Path of the OBJ file.
+/// \return Paths of the libraries.
+static std::vector<std::string> ObjMaterialLibraries(
+    const std::string &_filename)
+{
+  std::vector<std::string> libraries;
+  std::ifstream file(_filename);
+  const boost::filesystem::path dir =
+    boost::filesystem::path(_filename).parent_path();
+  std::string line;
+  while (std::getline(file, line))
+  {
+    if (line.compare(0, 7, "mtllib ") != 0)
+      continue;
+    line.erase(std::remove(line.begin(), line.end(), '\r'), line.end());
+
+    std::istringstream stream(line.substr(7));
+    std::string name;
+    while (stream >> name)
+      libraries.push_back((dir / name).string());
+  }
+  return libraries;
+}
+
+/// \brief Private data for the MeshCache class.
+class gazebo::common::MeshCachePrivate
+{
+  /// \brief Directory of the cache, empty if disabled.
+  public: std::string path;
+};
+
+/////////////////////////////////////////////////
+MeshCache::MeshCache()
+  : dataPtr(new MeshCachePrivate)
+{
+}
+
+/////////////////////////////////////////////////
+MeshCache::~MeshCache()
+{
+}
+
+/////////////////////////////////////////////////
+void MeshCache::SetPath(const std::string &_path)
+{
+  this->dataPtr->path = _path;
+}
+
+/////////////////////////////////////////////////
+std::string MeshCache::Path() const
+{
+  return this->dataPtr->path;
+}
+
+/////////////////////////////////////////////////
+std::string MeshCache::Key(const std::string &_filename) const
+{
+  if (this->dataPtr->path.empty())
+    return std::string();
+
+  const std::string hash = FileHash(_filename);
+  if (hash.empty())
+    return std::string();
+
+  // Texture paths are resolved from the location of the file, which is
+  // part of the key.
+  std::ostringstream key;
+  key << kCacheVersion << "\n" << _filename << "\n" << hash << "\n";
+
+  std::string extension = _filename.substr(_filename.rfind(".") + 1);
+  std::transform(extension.begin(), extension.end(), extension.begin(),
+      ::tolower);
+  if (extension == "obj")
+  {
+    for (auto const &library : ObjMaterialLibraries(_filename))
+      key << library << "\n" << FileHash(library) << "\n";
+  }
+
+  return get_sha1<std::string>(key.str());
+}
+
+/////////////////////////////////////////////////
+Mesh *MeshCache::Load(const std::string &_key) const
+{
+  if (_key.empty() || this->dataPtr->path.empty())
+    return nullptr;
+
+  const std::string filename =
+    (boost::filesystem::path(this->dataPtr->path) / (_key + ".mesh"))
+    .string();
+  MappedFile file(filename);
+  if (!file.data)
+    return nullptr;
+
+  CacheReader reader(file.data, file.size);
+  char magic[sizeof(kMagic)];
+  reader.Bytes(magic, sizeof(magic));
+  if (!reader.ok || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0 ||
+      reader.Pod<uint32_t>() != kByteOrder ||
+      reader.Pod<uint32_t>() != kCacheVersion)
+  {
+    return nullptr;
+  }
+
+  std::unique_ptr<Mesh> mesh(new Mesh);
+  mesh->SetPath(reader.String());
+
+  const uint32_t materialCount = reader.Pod<uint32_t>();
+  for (uint32_t i = 0; i < materialCount && reader.ok; ++i)
+  {
+    Material *material = new Material;
+    mesh->AddMaterial(material);
+    material->SetTextureImage(reader.String());
+    material->SetAmbient(reader.Color());
+    material->SetDiffuse(reader.Color());
+    material->SetSpecular(reader.Color());
+    material->SetEmissive(reader.Color());
+    material->SetTransparency(reader.Pod<double>());
+    material->SetShininess(reader.Pod<double>());
+    const double srcFactor = reader.Pod<double>();
+    const double dstFactor = reader.Pod<double>();
+    material->SetBlendFactors(srcFactor, dstFactor);
+    material->SetPointSize(reader.Pod<double>());
+
+    const uint32_t blendMode = reader.Pod<uint32_t>();
+    const uint32_t shadeMode = reader.Pod<uint32_t>();
+    if (blendMode >= Material::BLEND_COUNT ||
+        shadeMode >= Material::SHADE_COUNT)
+    {
+      return nullptr;
+    }
+    material->SetBlendMode(static_cast<Material::BlendMode>(blendMode));
+    material->SetShadeMode(static_cast<Material::ShadeMode>(shadeMode));
+    material->SetDepthWrite(reader.Pod<uint8_t>() != 0);
+    material->SetLighting(reader.Pod<uint8_t>() != 0);
+  }
+
+  const uint32_t subMeshCount = reader.Pod<uint32_t>();
+  for (uint32_t i = 0; i < subMeshCount && reader.ok; ++i)
+  {
+    SubMesh *subMesh = new SubMesh;
+    mesh->AddSubMesh(subMesh);
+    subMesh->SetName(reader.String());
+    const uint32_t primitiveType = reader.Pod<uint32_t>();
+    if (primitiveType > SubMesh::TRISTRIPS)
+      return nullptr;
+    subMesh->SetPrimitiveType(
+        static_cast<SubMesh::PrimitiveType>(primitiveType));
+    subMesh->SetMaterialIndex(reader.Pod<uint32_t>());
+
+    double values[3];
+    const uint32_t vertexCount = reader.Pod<uint32_t>();
+    if (!reader.Fits(vertexCount, sizeof(values)))
+      return nullptr;
+    subMesh->SetVertexCount(vertexCount);
+    for (uint32_t j = 0; j < vertexCount; ++j)
+    {
+      reader.Bytes(values, sizeof(values));
+      subMesh->SetVertex(j,
+          ignition::math::Vector3d(values[0], values[1], values[2]));
+    }
+
+    const uint32_t normalCount = reader.Pod<uint32_t>();
+    if (!reader.Fits(normalCount, sizeof(values)))
+      return nullptr;
+    subMesh->SetNormalCount(normalCount);
+    for (uint32_t j = 0; j < normalCount; ++j)
+    {
+      reader.Bytes(values, sizeof(values));
+      subMesh->SetNormal(j,
+          ignition::math::Vector3d(values[0], values[1], values[2]));
+    }
+
+    const uint32_t texCoordCount = reader.Pod<uint32_t>();
+    if (!reader.Fits(texCoordCount, 2 * sizeof(double)))
+      return nullptr;
+    subMesh->SetTexCoordCount(texCoordCount);
+    for (uint32_t j = 0; j < texCoordCount; ++j)
+    {
+      reader.Bytes(values, 2 * sizeof(double));
+      subMesh->SetTexCoord(j, ignition::math::Vector2d(values[0], values[1]));
+    }
+
+    const uint32_t indexCount = reader.Pod<uint32_t>();
+    if (!reader.Fits(indexCount, sizeof(uint32_t)))
+      return nullptr;
+    for (uint32_t j = 0; j < indexCount; ++j)
+      subMesh->AddIndex(reader.Pod<uint32_t>());
+  }
+
+  if (!reader.ok || reader.pos != reader.end)
+    return nullptr;
+  return mesh.release();
+}
+
+/////////////////////////////////////////////////
+bool MeshCache::Save(const std::string &_key, const Mesh &_mesh) const
+{
+  if (_key.empty() || this->dataPtr->path.empty() || _mesh.HasSkeleton())
+    return false;
+
+  CacheWriter writer;
+  writer.buffer.append(kMagic, sizeof(kMagic));
+  writer.Pod(kByteOrder);
+  writer.Pod(kCacheVersion);
+  writer.String(_mesh.GetPath());
+
+  writer.Pod(static_cast<uint32_t>(_mesh.GetMaterialCount()));
+  for (unsigned int i = 0; i < _mesh.GetMaterialCount(); ++i)
+  {
+    const Material *material = _mesh.GetMaterial(i);
+    writer.String(material->GetTextureImage());
+    writer.Color(material->Ambient());
+    writer.Color(material->Diffuse());
+    writer.Color(material->Specular());
+    writer.Color(material->Emissive());
+    writer.Pod(material->GetTransparency());
+    writer.Pod(material->GetShininess());
+    double srcFactor, dstFactor;
+    material->GetBlendFactors(srcFactor, dstFactor);
+    writer.Pod(srcFactor);
+    writer.Pod(dstFactor);
+    writer.Pod(material->GetPointSize());
+    writer.Pod(static_cast<uint32_t>(material->GetBlendMode()));
+    writer.Pod(static_cast<uint32_t>(material->GetShadeMode()));
+    writer.Pod(static_cast<uint8_t>(material->GetDepthWrite()));
+    writer.Pod(static_cast<uint8_t>(material->GetLighting()));
+  }
+
+  writer.Pod(static_cast<uint32_t>(_mesh.GetSubMeshCount()));
+  for (unsigned int i = 0; i < _mesh.GetSubMeshCount(); ++i)
+  {
+    const SubMesh *subMesh = _mesh.GetSubMesh(i);
+    if (subMesh->GetNodeAssignmentsCount() > 0)
+      return false;
+
+    writer.String(subMesh->GetName());
+    writer.Pod(static_cast<uint32_t>(subMesh->GetPrimitiveType()));
+    writer.Pod(static_cast<uint32_t>(subMesh->GetMaterialIndex()));
+
+    writer.Pod(static_cast<uint32_t>(subMesh->GetVertexCount()));
+    for (unsigned int j = 0; j < subMesh->GetVertexCount(); ++j)
+    {
+      const ignition::math::Vector3d v = subMesh->Vertex(j);
+      writer.Pod(v.X());
+      writer.Pod(v.Y());
+      writer.Pod(v.Z());
+    }
+
+    writer.Pod(static_cast<uint32_t>(subMesh->GetNormalCount()));
+    for (unsigned int j = 0; j < subMesh->GetNormalCount(); ++j)
+    {
+      const ignition::math::Vector3d n = subMesh->Normal(j);
+      writer.Pod(n.X());
+      writer.Pod(n.Y());
+      writer.Pod(n.Z());
+    }
+
+    writer.Pod(static_cast<uint32_t>(subMesh->GetTexCoordCount()));
+    for (unsigned int j = 0; j < subMesh->GetTexCoordCount(); ++j)
+    {
+      const ignition::math::Vector2d t = subMesh->TexCoord(j);
+      writer.Pod(t.X());
+      writer.Pod(t.Y());
+    }
+
+    writer.Pod(static_cast<uint32_t>(subMesh->GetIndexCount()));
+    for (unsigned int j = 0; j < subMesh->GetIndexCount(); ++j)
+      writer.Pod(static_cast<uint32_t>(subMesh->GetIndex(j)));
+  }
+
+  boost::system::error_code ec;
+  const boost::filesystem::path path =
+    boost::filesystem::path(this->dataPtr->path) / (_key + ".mesh");
+  boost::filesystem::create_directories(path.parent_path(), ec);
+
+  // Write to a temporary file first, other processes may read the cache.
+  const std::string tmpFilename = path.string() + ".tmp" +
+    boost::filesystem::unique_path("%%%%%%%%").string();
+  {
+    std::ofstream file(tmpFilename, std::ios::binary | std::ios::trunc);
+    file.write(writer.buffer.data(), writer.buffer.size());
+    if (!file)
+    {
+      gzwarn << "Unable to write mesh cache file[" << path.string() << "]\n";
+      file.close();
+      boost::filesystem::remove(tmpFilename, ec);
+      return false;
+    }
+  }
+
+  boost::filesystem::rename(tmpFilename, path, ec);
+  if (ec)
+  {
+    boost::filesystem::remove(tmpFilename, ec);
+    return false;
+  }
+  return true;
+}
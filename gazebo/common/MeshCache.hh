@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_COMMON_MESHCACHE_HH_
+#define GAZEBO_COMMON_MESHCACHE_HH_
+
+#include <memory>
+#include <string>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace common
+  {
+    // Forward declare private data class.
+    class MeshCachePrivate;
+    class Mesh;
+
+    /// \addtogroup gazebo_common Common
+    /// \{
+
+    /// \class MeshCache MeshCache.hh common/common.hh
+    /// \brief On-disk cache of parsed meshes, so that a mesh file is only
+    /// parsed once on a host.
+    ///
+    /// Cache files are named after a hash of the content of the mesh file,
+    /// and of the material libraries of OBJ files, so that an edited file
+    /// gets a new entry. A cache file is mapped in memory and read in one
+    /// pass; files are written to a temporary name and then renamed, so
+    /// that several processes may share the cache. Meshes with a skeleton
+    /// are not cached.
+    class GZ_COMMON_VISIBLE MeshCache
+    {
+      /// \brief Constructor.
+      public: MeshCache();
+
+      /// \brief Destructor.
+      public: virtual ~MeshCache();
+
+      /// \brief Set the directory of the cache.
+      /// \param[in] _path Path of the directory, empty to disable the
+      /// cache. The directory is created when needed.
+      public: void SetPath(const std::string &_path);
+
+      /// \brief Get the directory of the cache.
+      /// \return Path of the directory, empty if the cache is disabled.
+      public: std::string Path() const;
+
+      /// \brief Get the key of a mesh file, from its content.
+      /// \param[in] _filename Full path of the mesh file.
+      /// \return The key, empty if the cache is disabled or the file
+      /// couldn't be read.
+      public: std::string Key(const std::string &_filename) const;
+
+      /// \brief Load a mesh from the cache.
+      /// \param[in] _key Key of the mesh file, see Key().
+      /// \return The mesh, to be deleted by the caller, or null if it
+      /// isn't cached.
+      public: Mesh *Load(const std::string &_key) const;
+
+      /// \brief Save a mesh to the cache.
+      /// \param[in] _key Key of the mesh file, see Key().
+      /// \param[in] _mesh The mesh parsed from the file.
+      /// \return True if the mesh was saved.
+      public: bool Save(const std::string &_key, const Mesh &_mesh) const;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<MeshCachePrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include <boost/filesystem.hpp>
+
+#include "test_config.h"
+#include "gazebo/common/Material.hh"
+#include "gazebo/common/Mesh.hh"
+#include "gazebo/common/MeshCache.hh"
+#include "gazebo/common/OBJLoader.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class MeshCache : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+TEST_F(MeshCache, SaveLoad)
+{
+  const boost::filesystem::path dir =
+    boost::filesystem::temp_directory_path() /
+    boost::filesystem::unique_path("gazebo_mesh_cache_%%%%%%%%");
+  boost::filesystem::create_directories(dir);
+  const std::string source =
+    std::string(PROJECT_SOURCE_PATH) + "/test/data/box.obj";
+  const std::string filename = (dir / "box.obj").string();
+  boost::filesystem::copy_file(source, filename);
+  boost::filesystem::copy_file(
+      std::string(PROJECT_SOURCE_PATH) + "/test/data/box.mtl",
+      dir / "box.mtl");
+
+  // Disabled without a path
+  common::MeshCache cache;
+  EXPECT_TRUE(cache.Path().empty());
+  EXPECT_TRUE(cache.Key(filename).empty());
+
+  cache.SetPath((dir / "cache").string());
+  EXPECT_EQ((dir / "cache").string(), cache.Path());
+  const std::string key = cache.Key(filename);
+  EXPECT_FALSE(key.empty());
+  EXPECT_EQ(key, cache.Key(filename));
+  EXPECT_TRUE(cache.Key((dir / "missing.obj").string()).empty());
+  EXPECT_EQ(nullptr, cache.Load(key));
+
+  common::OBJLoader loader;
+  std::unique_ptr<common::Mesh> mesh(loader.Load(filename));
+  ASSERT_NE(nullptr, mesh);
+  ASSERT_LT(0u, mesh->GetSubMeshCount());
+  EXPECT_TRUE(cache.Save(key, *mesh));
+
+  std::unique_ptr<common::Mesh> cached(cache.Load(key));
+  ASSERT_NE(nullptr, cached);
+  EXPECT_EQ(mesh->GetPath(), cached->GetPath());
+  EXPECT_EQ(mesh->Min(), cached->Min());
+  EXPECT_EQ(mesh->Max(), cached->Max());
+  ASSERT_EQ(mesh->GetMaterialCount(), cached->GetMaterialCount());
+  for (unsigned int i = 0; i < mesh->GetMaterialCount(); ++i)
+  {
+    const common::Material *material = mesh->GetMaterial(i);
+    const common::Material *cachedMaterial = cached->GetMaterial(i);
+    EXPECT_EQ(material->GetTextureImage(),
+        cachedMaterial->GetTextureImage());
+    EXPECT_EQ(material->Ambient(), cachedMaterial->Ambient());
+    EXPECT_EQ(material->Diffuse(), cachedMaterial->Diffuse());
+    EXPECT_EQ(material->Specular(), cachedMaterial->Specular());
+    EXPECT_DOUBLE_EQ(material->GetTransparency(),
+        cachedMaterial->GetTransparency());
+    EXPECT_EQ(material->GetShadeMode(), cachedMaterial->GetShadeMode());
+  }
+
+  ASSERT_EQ(mesh->GetSubMeshCount(), cached->GetSubMeshCount());
+  for (unsigned int i = 0; i < mesh->GetSubMeshCount(); ++i)
+  {
+    const common::SubMesh *subMesh = mesh->GetSubMesh(i);
+    const common::SubMesh *cachedSubMesh = cached->GetSubMesh(i);
+    EXPECT_EQ(subMesh->GetName(), cachedSubMesh->GetName());
+    EXPECT_EQ(subMesh->GetPrimitiveType(),
+        cachedSubMesh->GetPrimitiveType());
+    EXPECT_EQ(subMesh->GetMaterialIndex(), cachedSubMesh->GetMaterialIndex());
+    ASSERT_EQ(subMesh->GetVertexCount(), cachedSubMesh->GetVertexCount());
+    ASSERT_EQ(subMesh->GetNormalCount(), cachedSubMesh->GetNormalCount());
+    ASSERT_EQ(subMesh->GetTexCoordCount(),
+        cachedSubMesh->GetTexCoordCount());
+    ASSERT_EQ(subMesh->GetIndexCount(), cachedSubMesh->GetIndexCount());
+    for (unsigned int j = 0; j < subMesh->GetVertexCount(); ++j)
+      EXPECT_EQ(subMesh->Vertex(j), cachedSubMesh->Vertex(j));
+    for (unsigned int j = 0; j < subMesh->GetNormalCount(); ++j)
+      EXPECT_EQ(subMesh->Normal(j), cachedSubMesh->Normal(j));
+    for (unsigned int j = 0; j < subMesh->GetTexCoordCount(); ++j)
+      EXPECT_EQ(subMesh->TexCoord(j), cachedSubMesh->TexCoord(j));
+    for (unsigned int j = 0; j < subMesh->GetIndexCount(); ++j)
+      EXPECT_EQ(subMesh->GetIndex(j), cachedSubMesh->GetIndex(j));
+  }
+
+  // Editing the file or its material library changes its key
+  {
+    std::ofstream file((dir / "box.mtl").string(), std::ios::app);
+    file << "# edited\n";
+  }
+  const std::string mtlKey = cache.Key(filename);
+  EXPECT_NE(key, mtlKey);
+  {
+    std::ofstream file(filename, std::ios::app);
+    file << "# edited\n";
+  }
+  EXPECT_NE(key, cache.Key(filename));
+  EXPECT_NE(mtlKey, cache.Key(filename));
+  EXPECT_EQ(nullptr, cache.Load(cache.Key(filename)));
+
+  // A truncated cache file is a miss
+  const boost::filesystem::path cacheFile = dir / "cache" / (key + ".mesh");
+  ASSERT_TRUE(boost::filesystem::exists(cacheFile));
+  boost::filesystem::resize_file(cacheFile,
+      boost::filesystem::file_size(cacheFile) / 2);
+  EXPECT_EQ(nullptr, cache.Load(key));
+
+  boost::filesystem::remove_all(dir);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
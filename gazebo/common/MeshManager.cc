@@ -16,13 +16,31 @@
  */
 
 #include <sys/stat.h>
-#include <string>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+#include <tbb/task_group.h>
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/filesystem.hpp>
 
 #include "gazebo/common/CommonIface.hh"
 #include "gazebo/common/Exception.hh"
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Mesh.hh"
+#include "gazebo/common/MeshCache.hh"
+#include "gazebo/common/SystemPaths.hh"
 #include "gazebo/common/ColladaLoader.hh"
 #include "gazebo/common/ColladaExporter.hh"
 #include "gazebo/common/STLLoader.hh"
@@ -40,9 +58,55 @@ namespace gazebo
 {
 namespace common
 {
+//////////////////////////////////////////////////
+/// \brief A mesh being loaded. The first thread to claim the load parses
+/// the file, the others wait on its future.
+class MeshLoad
+{
+  /// \brief Get a load that is already done.
+  /// \param[in] _mesh The mesh.
+  /// \return The load.
+  public: static std::shared_ptr<MeshLoad> Ready(const Mesh *_mesh);
+
+  /// \brief Path of the file.
+  public: std::string fullname;
+
+  /// \brief True once a thread took the load.
+  public: std::atomic<bool> claimed{false};
+
+  /// \brief Set by the thread that parses the file.
+  public: std::promise<const Mesh *> promise;
+
+  /// \brief Future of promise, shared by the waiters.
+  public: std::shared_future<const Mesh *> future;
+};
+
 //////////////////////////////////////////////////
 class MeshManagerPrivate
 {
+  /// \brief Find a mesh that is loaded or in flight.
+  /// \param[in] _filename Name of the mesh.
+  /// \return The load, null if the mesh is neither loaded nor in flight.
+  public: std::shared_ptr<MeshLoad> Find(const std::string &_filename) const;
+
+  /// \brief Find a mesh that is loaded or in flight, or else start a load.
+  /// \param[in] _filename Name of the mesh.
+  /// \param[in] _fullname Path of the file.
+  /// \return The load.
+  public: std::shared_ptr<MeshLoad> Register(const std::string &_filename,
+              const std::string &_fullname);
+
+  /// \brief Parse the file of a load that the calling thread claimed,
+  /// add the mesh and notify the waiters.
+  /// \param[in] _filename Name of the mesh.
+  /// \param[in] _load The load.
+  public: void Run(const std::string &_filename, MeshLoad &_load);
+
+  /// \brief Add a mesh to the dictionary.
+  /// \param[in] _name Name of the mesh.
+  /// \param[in] _mesh The mesh.
+  public: void Insert(const std::string &_name, Mesh *_mesh);
+
   /// \brief 3D mesh loader for COLLADA files
   public: ColladaLoader *colladaLoader = nullptr;
 
@@ -62,14 +126,156 @@ class MeshManagerPrivate
   /// \brief supported file extensions for meshes
   public: std::vector<std::string> fileExtensions;
 
-  /// \brief Mutex to protect from loading the same mesh in different threads
-  /// at the same time.
-  public: boost::mutex mutex;
+  /// \brief Loads in flight, indexed by name. A mesh is either loaded or
+  /// in flight, so that it is parsed once.
+  public: std::map<std::string, std::shared_ptr<MeshLoad> > loads;
+
+  /// \brief Parsed meshes on disk.
+  public: MeshCache cache;
+
+  /// \brief Asynchronous loads, see LoadAsync.
+  public: tbb::task_group tasks;
+
+  /// \brief Protects meshes, loads and tasks.
+  public: mutable std::mutex mutex;
 };
 
-// added here for ABI compatibility
-// TODO move to header / private class when merging forward.
-static OBJLoader objLoader;
+//////////////////////////////////////////////////
+/// \brief Parse a mesh file, with loaders of its own so that several files
+/// may be parsed at the same time.
+/// \param[in] _fullname Path of the file.
+/// \return The mesh, null if the format isn't supported or the file
+/// couldn't be parsed.
+static Mesh *ParseMesh(const std::string &_fullname)
+{
+  std::string extension = _fullname.substr(_fullname.rfind(".") + 1);
+  std::transform(extension.begin(), extension.end(),
+      extension.begin(), ::tolower);
+
+  if (extension == "stl" || extension == "stlb" || extension == "stla")
+  {
+    STLLoader loader;
+    return loader.Load(_fullname);
+  }
+  else if (extension == "dae")
+  {
+    ColladaLoader loader;
+    return loader.Load(_fullname);
+  }
+  else if (extension == "obj")
+  {
+    OBJLoader loader;
+    return loader.Load(_fullname);
+  }
+
+  gzerr << "Unsupported mesh format for file[" << _fullname << "]\n";
+  return nullptr;
+}
+
+//////////////////////////////////////////////////
+std::shared_ptr<MeshLoad> MeshLoad::Ready(const Mesh *_mesh)
+{
+  std::shared_ptr<MeshLoad> load(new MeshLoad);
+  load->claimed = true;
+  load->future = load->promise.get_future().share();
+  load->promise.set_value(_mesh);
+  return load;
+}
+
+//////////////////////////////////////////////////
+std::shared_ptr<MeshLoad> MeshManagerPrivate::Find(
+    const std::string &_filename) const
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  auto mesh = this->meshes.find(_filename);
+  if (mesh != this->meshes.end())
+    return MeshLoad::Ready(mesh->second);
+
+  auto load = this->loads.find(_filename);
+  if (load != this->loads.end())
+    return load->second;
+  return nullptr;
+}
+
+//////////////////////////////////////////////////
+std::shared_ptr<MeshLoad> MeshManagerPrivate::Register(
+    const std::string &_filename, const std::string &_fullname)
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+
+  // Another thread may have started while the file was resolved
+  auto mesh = this->meshes.find(_filename);
+  if (mesh != this->meshes.end())
+    return MeshLoad::Ready(mesh->second);
+
+  std::shared_ptr<MeshLoad> &load = this->loads[_filename];
+  if (!load)
+  {
+    load.reset(new MeshLoad);
+    load->fullname = _fullname;
+    load->future = load->promise.get_future().share();
+  }
+  return load;
+}
+
+//////////////////////////////////////////////////
+void MeshManagerPrivate::Run(const std::string &_filename, MeshLoad &_load)
+{
+  Mesh *mesh = nullptr;
+  std::exception_ptr error;
+  try
+  {
+    const std::string key = this->cache.Key(_load.fullname);
+    mesh = this->cache.Load(key);
+    if (!mesh)
+    {
+      mesh = ParseMesh(_load.fullname);
+      if (mesh)
+        this->cache.Save(key, *mesh);
+      else
+        gzerr << "Unable to load mesh[" << _load.fullname << "]\n";
+    }
+  }
+  catch(gazebo::common::Exception &e)
+  {
+    gzerr << "Error loading mesh[" << _load.fullname << "]\n";
+    gzerr << e << "\n";
+    error = std::current_exception();
+  }
+  catch(...)
+  {
+    error = std::current_exception();
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if (mesh)
+    {
+      // A mesh of the same name may have been added meanwhile
+      mesh->SetName(_filename);
+      auto inserted = this->meshes.insert(std::make_pair(_filename, mesh));
+      if (!inserted.second)
+      {
+        delete mesh;
+        mesh = inserted.first->second;
+      }
+    }
+    this->loads.erase(_filename);
+  }
+
+  // The waiters run once the mesh is in the dictionary
+  if (error)
+    _load.promise.set_exception(error);
+  else
+    _load.promise.set_value(mesh);
+}
+
+//////////////////////////////////////////////////
+void MeshManagerPrivate::Insert(const std::string &_name, Mesh *_mesh)
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  this->meshes.insert(std::make_pair(_name, _mesh));
+}
 
 //////////////////////////////////////////////////
 MeshManager::MeshManager()
@@ -78,6 +284,8 @@ MeshManager::MeshManager()
   this->dataPtr->colladaLoader = new ColladaLoader();
   this->dataPtr->colladaExporter = new ColladaExporter();
   this->dataPtr->stlLoader = new STLLoader();
+  this->dataPtr->cache.SetPath((boost::filesystem::path(
+      SystemPaths::Instance()->GetLogPath()) / "mesh_cache").string());
 
   // Create some basic shapes
   this->CreatePlane("unit_plane",
@@ -116,6 +324,8 @@ MeshManager::MeshManager()
 //////////////////////////////////////////////////
 MeshManager::~MeshManager()
 {
+  this->dataPtr->tasks.wait();
+
   delete this->dataPtr->colladaLoader;
   delete this->dataPtr->colladaExporter;
   delete this->dataPtr->stlLoader;
@@ -138,79 +348,118 @@ const Mesh *MeshManager::Load(const std::string &_filename)
     return nullptr;
   }
 
-  Mesh *mesh = nullptr;
+  std::shared_ptr<MeshLoad> load = this->dataPtr->Find(_filename);
+  if (!load)
+  {
+    const std::string fullname = common::find_file(_filename);
+    if (fullname.empty())
+    {
+      gzerr << "Unable to find file[" << _filename << "]\n";
+      return nullptr;
+    }
+    load = this->dataPtr->Register(_filename, fullname);
+  }
 
-  std::string extension;
+  // Parse in this thread, unless another thread already does
+  if (!load->claimed.exchange(true))
+    this->dataPtr->Run(_filename, *load);
+  return load->future.get();
+}
 
-  if (this->HasMesh(_filename))
+//////////////////////////////////////////////////
+std::shared_future<const Mesh *> MeshManager::LoadAsync(
+    const std::string &_filename)
+{
+  if (!this->IsValidFilename(_filename))
   {
-    return this->dataPtr->meshes[_filename];
-
-    // This breaks trimesh geom. Each new trimesh should have a unique name.
-    /*
-    // erase mesh from this->dataPtr->meshes.
-    // This allows a mesh to be modified and
-    // inserted into gazebo again without closing gazebo.
-    std::map<std::string, Mesh*>::iterator iter;
-    iter = this->dataPtr->meshes.find(_filename);
-    delete iter->second;
-    iter->second = nullptr;
-    this->dataPtr->meshes.erase(iter);
-    */
+    gzerr << "Invalid mesh filename extension[" << _filename << "]\n";
+    return MeshLoad::Ready(nullptr)->future;
   }
 
-  std::string fullname = common::find_file(_filename);
-
-  if (!fullname.empty())
+  std::shared_ptr<MeshLoad> load = this->dataPtr->Find(_filename);
+  if (!load)
   {
-    extension = fullname.substr(fullname.rfind(".")+1, fullname.size());
-    std::transform(extension.begin(), extension.end(),
-        extension.begin(), ::tolower);
-    MeshLoader *loader = nullptr;
-
-    if (extension == "stl" || extension == "stlb" || extension == "stla")
-      loader = this->dataPtr->stlLoader;
-    else if (extension == "dae")
-      loader = this->dataPtr->colladaLoader;
-    else if (extension == "obj")
-      loader = &objLoader;
-    else
+    // Resolve the file in this thread, SystemPaths isn't thread safe.
+    const std::string fullname = common::find_file(_filename);
+    if (fullname.empty())
     {
-      gzerr << "Unsupported mesh format for file[" << _filename << "]\n";
-      return nullptr;
+      gzerr << "Unable to find file[" << _filename << "]\n";
+      return MeshLoad::Ready(nullptr)->future;
     }
+    load = this->dataPtr->Register(_filename, fullname);
+  }
 
-    try
-    {
-      // This mutex prevents two threads from loading the same mesh at the
-      // same time.
-      boost::mutex::scoped_lock lock(this->dataPtr->mutex);
-      if (!this->HasMesh(_filename))
-      {
-        if ((mesh = loader->Load(fullname)) != nullptr)
+  if (!load->claimed)
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    MeshManagerPrivate *dataPtr = this->dataPtr;
+    this->dataPtr->tasks.run([dataPtr, _filename, load]()
         {
-          mesh->SetName(_filename);
-          this->dataPtr->meshes.insert(std::make_pair(_filename, mesh));
-        }
-        else
-          gzerr << "Unable to load mesh[" << fullname << "]\n";
-      }
-      else
-      {
-        mesh = this->dataPtr->meshes[_filename];
-      }
+          if (!load->claimed.exchange(true))
+            dataPtr->Run(_filename, *load);
+        });
+  }
+  return load->future;
+}
+
+//////////////////////////////////////////////////
+void MeshManager::Preload(const std::vector<std::string> &_filenames,
+    const unsigned int _threads)
+{
+  // Resolve the files in this thread, SystemPaths isn't thread safe.
+  std::vector<std::pair<std::string, std::shared_ptr<MeshLoad> > > loads;
+  std::set<std::string> names;
+  for (auto const &filename : _filenames)
+  {
+    if (!this->IsValidFilename(filename) || this->HasMesh(filename) ||
+        !names.insert(filename).second)
+    {
+      continue;
     }
-    catch(gazebo::common::Exception &e)
+
+    std::shared_ptr<MeshLoad> load = this->dataPtr->Find(filename);
+    if (!load)
     {
-      gzerr << "Error loading mesh[" << fullname << "]\n";
-      gzerr << e << "\n";
-      gzthrow(e);
+      std::string fullname = common::find_file(filename);
+      if (fullname.empty())
+        continue;
+      load = this->dataPtr->Register(filename, fullname);
     }
+    loads.push_back(std::make_pair(filename, load));
   }
-  else
-    gzerr << "Unable to find file[" << _filename << "]\n";
 
-  return mesh;
+  if (loads.empty())
+    return;
+
+  tbb::task_arena arena(std::max(_threads, 1u));
+  arena.execute([&]()
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, loads.size(), 1),
+        [&](const tbb::blocked_range<size_t> &_r)
+    {
+      for (size_t i = _r.begin(); i != _r.end(); ++i)
+      {
+        if (!loads[i].second->claimed.exchange(true))
+          this->dataPtr->Run(loads[i].first, *loads[i].second);
+      }
+    });
+  });
+
+  // Wait for the meshes that other threads were loading
+  for (auto const &load : loads)
+    load.second->future.wait();
+}
+
+//////////////////////////////////////////////////
+void MeshManager::SetCachePath(const std::string &_path)
+{
+  this->dataPtr->cache.SetPath(_path);
+}
+
+//////////////////////////////////////////////////
+std::string MeshManager::CachePath() const
+{
+  return this->dataPtr->cache.Path();
 }
 
 //////////////////////////////////////////////////
@@ -249,28 +498,32 @@ void MeshManager::GetMeshAABB(const Mesh *_mesh,
     ignition::math::Vector3d &_center,
     ignition::math::Vector3d &_minXYZ, ignition::math::Vector3d &_maxXYZ)
 {
-  if (this->HasMesh(_mesh->GetName()))
-    this->dataPtr->meshes[_mesh->GetName()]->GetAABB(_center, _minXYZ, _maxXYZ);
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  auto iter = this->dataPtr->meshes.find(_mesh->GetName());
+  if (iter != this->dataPtr->meshes.end())
+    iter->second->GetAABB(_center, _minXYZ, _maxXYZ);
 }
 
 //////////////////////////////////////////////////
 void MeshManager::GenSphericalTexCoord(const Mesh *_mesh,
     const ignition::math::Vector3d &_center)
 {
-  if (this->HasMesh(_mesh->GetName()))
-    this->dataPtr->meshes[_mesh->GetName()]->GenSphericalTexCoord(_center);
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  auto iter = this->dataPtr->meshes.find(_mesh->GetName());
+  if (iter != this->dataPtr->meshes.end())
+    iter->second->GenSphericalTexCoord(_center);
 }
 
 //////////////////////////////////////////////////
 void MeshManager::AddMesh(Mesh *_mesh)
 {
-  if (!this->HasMesh(_mesh->GetName()))
-    this->dataPtr->meshes[_mesh->GetName()] = _mesh;
+  this->dataPtr->Insert(_mesh->GetName(), _mesh);
 }
 
 //////////////////////////////////////////////////
 const Mesh *MeshManager::GetMesh(const std::string &_name) const
 {
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
   std::map<std::string, Mesh*>::const_iterator iter;
 
   iter = this->dataPtr->meshes.find(_name);
@@ -287,6 +540,7 @@ bool MeshManager::HasMesh(const std::string &_name) const
   if (_name.empty())
     return false;
 
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
   std::map<std::string, Mesh*>::const_iterator iter;
   iter = this->dataPtr->meshes.find(_name);
 
@@ -310,7 +564,7 @@ void MeshManager::CreateSphere(const std::string &name, float radius,
 
   Mesh *mesh = new Mesh();
   mesh->SetName(name);
-  this->dataPtr->meshes.insert(std::make_pair(name, mesh));
+  this->dataPtr->Insert(name, mesh);
 
   SubMesh *subMesh = new SubMesh();
   mesh->AddSubMesh(subMesh);
@@ -378,7 +632,7 @@ void MeshManager::CreatePlane(const std::string &_name,
 
   Mesh *mesh = new Mesh();
   mesh->SetName(_name);
-  this->dataPtr->meshes.insert(std::make_pair(_name, mesh));
+  this->dataPtr->Insert(_name, mesh);
 
   SubMesh *subMesh = new SubMesh();
   mesh->AddSubMesh(subMesh);
@@ -458,7 +712,7 @@ void MeshManager::CreateBox(const std::string &_name,
 
   Mesh *mesh = new Mesh();
   mesh->SetName(_name);
-  this->dataPtr->meshes.insert(std::make_pair(_name, mesh));
+  this->dataPtr->Insert(_name, mesh);
 
   SubMesh *subMesh = new SubMesh();
   mesh->AddSubMesh(subMesh);
@@ -759,7 +1013,7 @@ void MeshManager::CreateExtrudedPolyline(const std::string &_name,
     }
   }
 
-  this->dataPtr->meshes.insert(std::make_pair(_name, mesh));
+  this->dataPtr->Insert(_name, mesh);
   return;
 }
 
@@ -775,7 +1029,7 @@ void MeshManager::CreateCamera(const std::string &_name, float _scale)
 
   Mesh *mesh = new Mesh();
   mesh->SetName(_name);
-  this->dataPtr->meshes.insert(std::make_pair(_name, mesh));
+  this->dataPtr->Insert(_name, mesh);
 
   SubMesh *subMesh = new SubMesh();
   mesh->AddSubMesh(subMesh);
@@ -876,7 +1130,7 @@ void MeshManager::CreateCylinder(const std::string &name, float radius,
 
   Mesh *mesh = new Mesh();
   mesh->SetName(name);
-  this->dataPtr->meshes.insert(std::make_pair(name, mesh));
+  this->dataPtr->Insert(name, mesh);
 
   SubMesh *subMesh = new SubMesh();
   mesh->AddSubMesh(subMesh);
@@ -993,7 +1247,7 @@ void MeshManager::CreateCone(const std::string &name, float radius,
 
   Mesh *mesh = new Mesh();
   mesh->SetName(name);
-  this->dataPtr->meshes.insert(std::make_pair(name, mesh));
+  this->dataPtr->Insert(name, mesh);
 
   SubMesh *subMesh = new SubMesh();
   mesh->AddSubMesh(subMesh);
@@ -1110,7 +1364,7 @@ void MeshManager::CreateTube(const std::string &_name, float _innerRadius,
 
   Mesh *mesh = new Mesh();
   mesh->SetName(_name);
-  this->dataPtr->meshes.insert(std::make_pair(_name, mesh));
+  this->dataPtr->Insert(_name, mesh);
   SubMesh *subMesh = new SubMesh();
   mesh->AddSubMesh(subMesh);
 
@@ -1331,7 +1585,7 @@ void MeshManager::CreateBoolean(const std::string &_name, const Mesh *_m1,
   MeshCSG csg;
   Mesh *mesh = csg.CreateBoolean(_m1, _m2, _operation, _offset);
   mesh->SetName(_name);
-  this->dataPtr->meshes.insert(std::make_pair(_name, mesh));
+  this->dataPtr->Insert(_name, mesh);
 }
 #endif
 
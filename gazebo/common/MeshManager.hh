@@ -17,6 +17,7 @@
 #ifndef GAZEBO_COMMON_MESHMANAGER_HH_
 #define GAZEBO_COMMON_MESHMANAGER_HH_
 
+#include <future>
 #include <utility>
 #include <string>
 #include <vector>
@@ -57,11 +58,39 @@ namespace gazebo
       /// Destroys the collada loader, the stl loader and all the meshes
       private: virtual ~MeshManager();
 
-      /// \brief Load a mesh from a file
+      /// \brief Load a mesh from a file. Different files may be loaded by
+      /// several threads at the same time, and a thread loading a file that
+      /// is already in flight waits for that load.
       /// \param[in] _filename the path to the mesh
       /// \return a pointer to the created mesh
       public: const Mesh *Load(const std::string &_filename);
 
+      /// \brief Start loading a mesh on a worker thread, e.g. to prefetch
+      /// it before it is needed. A later Load of the same filename waits
+      /// for this load rather than parsing the file again.
+      /// \param[in] _filename the path to the mesh
+      /// \return Future of the mesh, null if it couldn't be loaded.
+      public: std::shared_future<const Mesh *> LoadAsync(
+                  const std::string &_filename);
+
+      /// \brief Load several mesh files concurrently, and wait for them.
+      /// Meshes that are already loaded are skipped.
+      /// \param[in] _filenames Filenames of the meshes, as given to Load.
+      /// \param[in] _threads Maximum number of threads to parse with.
+      public: void Preload(const std::vector<std::string> &_filenames,
+                  const unsigned int _threads);
+
+      /// \brief Set the directory where parsed meshes are cached, so that
+      /// a file is only parsed once on a host, see MeshCache. To be set
+      /// before meshes are loaded.
+      /// \param[in] _path Path of the directory, empty to disable the
+      /// cache. Defaults to mesh_cache in the log path.
+      public: void SetCachePath(const std::string &_path);
+
+      /// \brief Get the directory where parsed meshes are cached.
+      /// \return Path of the directory, empty if there is no cache.
+      public: std::string CachePath() const;
+
       /// \brief Export a mesh to a file
       /// \param[in] _mesh Pointer to the mesh to be exported
       /// \param[in] _filename Exported file's path and name
@@ -16,6 +16,9 @@
 */
 
 #include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include "test_config.h"
 #include "gazebo/common/Mesh.hh"
@@ -266,6 +269,90 @@ TEST_F(MeshManager, CreateExtrudedPolylineInvalid)
   EXPECT_TRUE(!common::MeshManager::Instance()->HasMesh(meshName));
 }
 
+/////////////////////////////////////////////////
+TEST_F(MeshManager, Preload)
+{
+  const std::string dae =
+    std::string(PROJECT_SOURCE_PATH) + "/test/data/box.dae";
+  const std::string obj =
+    std::string(PROJECT_SOURCE_PATH) + "/test/data/box.obj";
+  const std::string stl =
+    std::string(PROJECT_SOURCE_PATH) + "/test/data/twoFaces.stl";
+  const std::string missing =
+    std::string(PROJECT_SOURCE_PATH) + "/test/data/missing.dae";
+
+  common::MeshManager *manager = common::MeshManager::Instance();
+  EXPECT_FALSE(manager->HasMesh(dae));
+
+  // Duplicates, missing files and unknown extensions are skipped
+  manager->Preload({dae, obj, stl, dae, missing, "box.txt"}, 4);
+  EXPECT_TRUE(manager->HasMesh(dae));
+  EXPECT_TRUE(manager->HasMesh(obj));
+  EXPECT_TRUE(manager->HasMesh(stl));
+  EXPECT_FALSE(manager->HasMesh(missing));
+
+  // Loading returns the preloaded meshes
+  const common::Mesh *mesh = manager->GetMesh(dae);
+  ASSERT_NE(nullptr, mesh);
+  EXPECT_EQ(dae, mesh->GetName());
+  EXPECT_EQ(mesh, manager->Load(dae));
+  EXPECT_LT(0u, mesh->GetVertexCount());
+
+  // Preloading again keeps the same meshes
+  manager->Preload({dae}, 2);
+  EXPECT_EQ(mesh, manager->GetMesh(dae));
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshManager, LoadAsync)
+{
+  const std::string offset =
+    std::string(PROJECT_SOURCE_PATH) + "/test/data/box_offset.dae";
+  const std::string geoms =
+    std::string(PROJECT_SOURCE_PATH) + "/test/data/box_with_multiple_geoms.dae";
+  const std::string missing =
+    std::string(PROJECT_SOURCE_PATH) + "/test/data/missing.dae";
+
+  common::MeshManager *manager = common::MeshManager::Instance();
+  EXPECT_FALSE(manager->HasMesh(offset));
+  EXPECT_FALSE(manager->HasMesh(geoms));
+
+  // Concurrent requests for the same mesh share one load
+  std::shared_future<const common::Mesh *> first =
+    manager->LoadAsync(offset);
+  std::shared_future<const common::Mesh *> second =
+    manager->LoadAsync(geoms);
+  std::vector<std::thread> threads;
+  std::vector<const common::Mesh *> loaded(4, nullptr);
+  for (size_t i = 0; i < loaded.size(); ++i)
+  {
+    threads.push_back(std::thread([&, i]()
+        {
+          loaded[i] = manager->Load(i % 2 ? geoms : offset);
+        }));
+  }
+  for (auto &thread : threads)
+    thread.join();
+
+  const common::Mesh *mesh = first.get();
+  ASSERT_NE(nullptr, mesh);
+  EXPECT_EQ(offset, mesh->GetName());
+  EXPECT_EQ(mesh, manager->GetMesh(offset));
+  EXPECT_EQ(mesh, manager->LoadAsync(offset).get());
+  EXPECT_EQ(mesh, loaded[0]);
+  EXPECT_EQ(mesh, loaded[2]);
+
+  ASSERT_NE(nullptr, second.get());
+  EXPECT_EQ(second.get(), loaded[1]);
+  EXPECT_EQ(second.get(), loaded[3]);
+  EXPECT_NE(mesh, second.get());
+
+  // Missing files and unknown extensions give null
+  EXPECT_EQ(nullptr, manager->LoadAsync(missing).get());
+  EXPECT_EQ(nullptr, manager->LoadAsync("box.txt").get());
+  EXPECT_FALSE(manager->HasMesh(missing));
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
@@ -0,0 +1,493 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <queue>
+#include <set>
+#include <utility>
+
+#include <boost/filesystem.hpp>
+
+#include "gazebo/common/CommonIface.hh"
+#include "gazebo/common/Console.hh"
+#include "gazebo/common/Mesh.hh"
+#include "gazebo/common/MeshSimplifier.hh"
+
+using namespace gazebo;
+using namespace common;
+
+/// \brief Weight of the planes that keep open borders in place, relative
+/// to the planes of the triangles.
+static const double kBorderWeight = 100.0;
+
+/// \brief Minimum cosine of the angle between the normals of a triangle
+/// before and after a collapse.
+static const double kMinFlipCosine = 0.2;
+
+/// \brief Version of the cache files, to change with the algorithm.
+static const unsigned int kCacheVersion = 1;
+
+/// \brief Sum of squared distances to a set of planes, a symmetric 4x4
+/// matrix stored as its upper triangle.
+class Quadric
+{
+  /// \brief Add a plane.
+  /// \param[in] _n Unit normal of the plane.
+  /// \param[in] _d Offset of the plane, n.x + d = 0.
+  /// \param[in] _w Weight of the plane.
+  public: void AddPlane(const ignition::math::Vector3d &_n, const double _d,
+              const double _w)
+          {
+            const double x = _n.X(), y = _n.Y(), z = _n.Z();
+            this->q[0] += _w * x * x;
+            this->q[1] += _w * x * y;
+            this->q[2] += _w * x * z;
+            this->q[3] += _w * x * _d;
+            this->q[4] += _w * y * y;
+            this->q[5] += _w * y * z;
+            this->q[6] += _w * y * _d;
+            this->q[7] += _w * z * z;
+            this->q[8] += _w * z * _d;
+            this->q[9] += _w * _d * _d;
+          }
+
+  /// \brief Add another quadric.
+  /// \param[in] _other The quadric.
+  public: void Add(const Quadric &_other)
+          {
+            for (unsigned int i = 0; i < 10; ++i)
+              this->q[i] += _other.q[i];
+          }
+
+  /// \brief Error of a position.
+  /// \param[in] _v The position.
+  /// \return Weighted sum of the squared distances to the planes.
+  public: double Error(const ignition::math::Vector3d &_v) const
+          {
+            const double x = _v.X(), y = _v.Y(), z = _v.Z();
+            return this->q[0] * x * x + 2 * this->q[1] * x * y +
+              2 * this->q[2] * x * z + 2 * this->q[3] * x +
+              this->q[4] * y * y + 2 * this->q[5] * y * z +
+              2 * this->q[6] * y + this->q[7] * z * z +
+              2 * this->q[8] * z + this->q[9];
+          }
+
+  /// \brief Coefficients of the matrix.
+  private: double q[10] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+};
+
+/// \brief Candidate collapse of a vertex into a neighbor.
+struct Collapse
+{
+  /// \brief Error added by the collapse.
+  double cost;
+
+  /// \brief Vertex that is removed.
+  unsigned int from;
+
+  /// \brief Vertex that is kept.
+  unsigned int to;
+
+  /// \brief Versions of the vertices when the cost was computed.
+  unsigned int fromStamp, toStamp;
+
+  /// \brief Order of the queue, cheapest first.
+  bool operator<(const Collapse &_other) const
+  {
+    return this->cost > _other.cost;
+  }
+};
+
+/////////////////////////////////////////////////
+/// \brief Read simplified indices from the cache.
+/// \param[in] _filename Cache file.
+/// \param[in] _vertexCount Number of vertices of the mesh.
+/// \param[out] _indices The indices read.
+/// \return True if the file is valid.
+static bool ReadCache(const std::string &_filename,
+    const size_t _vertexCount, std::vector<unsigned int> &_indices)
+{
+  std::ifstream file(_filename, std::ios::binary);
+  if (!file)
+    return false;
+
+  uint64_t count = 0;
+  file.read(reinterpret_cast<char *>(&count), sizeof(count));
+  if (!file || count % 3 != 0 || count > (1ull << 32))
+    return false;
+
+  std::vector<uint32_t> indices(count);
+  if (count > 0)
+  {
+    file.read(reinterpret_cast<char *>(indices.data()),
+        count * sizeof(uint32_t));
+  }
+  if (!file)
+    return false;
+
+  for (auto const index : indices)
+  {
+    if (index >= _vertexCount)
+      return false;
+  }
+
+  _indices.assign(indices.begin(), indices.end());
+  return true;
+}
+
+/////////////////////////////////////////////////
+/// \brief Write simplified indices to the cache.
+/// \param[in] _filename Cache file.
+/// \param[in] _indices The indices.
+static void WriteCache(const std::string &_filename,
+    const std::vector<unsigned int> &_indices)
+{
+  boost::system::error_code ec;
+  boost::filesystem::path path(_filename);
+  boost::filesystem::create_directories(path.parent_path(), ec);
+
+  // Write to a temporary file first, other processes may read the cache
+  const std::string tmpFilename = _filename + ".tmp";
+  {
+    std::ofstream file(tmpFilename, std::ios::binary | std::ios::trunc);
+    if (!file)
+    {
+      gzwarn << "Unable to write mesh cache file[" << _filename << "]\n";
+      return;
+    }
+
+    const uint64_t count = _indices.size();
+    std::vector<uint32_t> indices(_indices.begin(), _indices.end());
+    file.write(reinterpret_cast<const char *>(&count), sizeof(count));
+    if (count > 0)
+    {
+      file.write(reinterpret_cast<const char *>(indices.data()),
+          count * sizeof(uint32_t));
+    }
+    if (!file)
+    {
+      gzwarn << "Unable to write mesh cache file[" << _filename << "]\n";
+      return;
+    }
+  }
+
+  boost::filesystem::rename(tmpFilename, path, ec);
+  if (ec)
+    boost::filesystem::remove(tmpFilename, ec);
+}
+
+/// \brief Private data for the MeshSimplifier class.
+class gazebo::common::MeshSimplifierPrivate
+{
+  /// \brief Directory of the cache, empty if disabled.
+  public: std::string cachePath;
+};
+
+/////////////////////////////////////////////////
+MeshSimplifier::MeshSimplifier()
+  : dataPtr(new MeshSimplifierPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+MeshSimplifier::~MeshSimplifier()
+{
+}
+
+/////////////////////////////////////////////////
+void MeshSimplifier::SetCachePath(const std::string &_path)
+{
+  this->dataPtr->cachePath = _path;
+}
+
+/////////////////////////////////////////////////
+std::string MeshSimplifier::CachePath() const
+{
+  return this->dataPtr->cachePath;
+}
+
+/////////////////////////////////////////////////
+std::vector<unsigned int> MeshSimplifier::Simplify(
+    const std::vector<ignition::math::Vector3d> &_vertices,
+    const std::vector<unsigned int> &_indices,
+    const size_t _triangles) const
+{
+  const size_t triangleCount = _indices.size() / 3;
+  if (_triangles >= triangleCount)
+    return _indices;
+
+  for (auto const index : _indices)
+  {
+    if (index >= _vertices.size())
+    {
+      gzerr << "Invalid vertex index[" << index << "], unable to simplify "
+            << "the mesh" << std::endl;
+      return _indices;
+    }
+  }
+
+  // Weld the vertices at the same position, the collapses work on the
+  // welded vertices
+  std::map<std::array<double, 3>, unsigned int> welded;
+  std::vector<unsigned int> weldedIndex(_vertices.size());
+  std::vector<unsigned int> weldedVertex;
+  std::vector<ignition::math::Vector3d> positions;
+  for (unsigned int i = 0; i < _vertices.size(); ++i)
+  {
+    const ignition::math::Vector3d &v = _vertices[i];
+    auto entry = welded.insert(std::make_pair(
+          std::array<double, 3>{{v.X(), v.Y(), v.Z()}},
+          static_cast<unsigned int>(positions.size())));
+    if (entry.second)
+    {
+      weldedVertex.push_back(i);
+      positions.push_back(v);
+    }
+    weldedIndex[i] = entry.first->second;
+  }
+
+  // Triangles, as welded vertices and as original vertices
+  std::vector<std::array<unsigned int, 3>> triangles(triangleCount);
+  std::vector<std::array<unsigned int, 3>> corners(triangleCount);
+  std::vector<bool> alive(triangleCount, false);
+  std::vector<std::vector<unsigned int>> vertexTriangles(positions.size());
+  std::vector<Quadric> quadrics(positions.size());
+  std::map<std::pair<unsigned int, unsigned int>,
+    std::pair<unsigned int, unsigned int>> edges;
+  size_t aliveCount = 0;
+
+  auto normal = [&](const std::array<unsigned int, 3> &_t)
+  {
+    return (positions[_t[1]] - positions[_t[0]]).Cross(
+        positions[_t[2]] - positions[_t[0]]);
+  };
+
+  for (unsigned int t = 0; t < triangleCount; ++t)
+  {
+    for (unsigned int k = 0; k < 3; ++k)
+    {
+      corners[t][k] = _indices[t * 3 + k];
+      triangles[t][k] = weldedIndex[corners[t][k]];
+    }
+
+    const auto &tri = triangles[t];
+    if (tri[0] == tri[1] || tri[1] == tri[2] || tri[0] == tri[2])
+      continue;
+
+    alive[t] = true;
+    ++aliveCount;
+
+    ignition::math::Vector3d n = normal(tri);
+    const double length = n.Length();
+    for (unsigned int k = 0; k < 3; ++k)
+    {
+      vertexTriangles[tri[k]].push_back(t);
+      if (length > 0)
+      {
+        quadrics[tri[k]].AddPlane(n / length,
+            -(n / length).Dot(positions[tri[0]]), length * 0.5);
+      }
+
+      auto key = std::make_pair(std::min(tri[k], tri[(k + 1) % 3]),
+          std::max(tri[k], tri[(k + 1) % 3]));
+      auto edge = edges.insert(std::make_pair(key, std::make_pair(0u, t)));
+      ++edge.first->second.first;
+    }
+  }
+
+  // Planes through the open borders, perpendicular to their triangle
+  for (auto const &edge : edges)
+  {
+    if (edge.second.first != 1)
+      continue;
+
+    const ignition::math::Vector3d &p0 = positions[edge.first.first];
+    const ignition::math::Vector3d &p1 = positions[edge.first.second];
+    ignition::math::Vector3d n = (p1 - p0).Cross(
+        normal(triangles[edge.second.second]));
+    const double length = n.Length();
+    if (length <= 0)
+      continue;
+    n /= length;
+
+    const double weight = kBorderWeight * (p1 - p0).SquaredLength();
+    quadrics[edge.first.first].AddPlane(n, -n.Dot(p0), weight);
+    quadrics[edge.first.second].AddPlane(n, -n.Dot(p0), weight);
+  }
+
+  std::vector<unsigned int> stamps(positions.size(), 0u);
+  std::vector<bool> removed(positions.size(), false);
+  std::priority_queue<Collapse> queue;
+  auto push = [&](const unsigned int _from, const unsigned int _to)
+  {
+    Quadric q = quadrics[_from];
+    q.Add(quadrics[_to]);
+    queue.push({q.Error(positions[_to]), _from, _to, stamps[_from],
+        stamps[_to]});
+  };
+
+  for (auto const &edge : edges)
+  {
+    push(edge.first.first, edge.first.second);
+    push(edge.first.second, edge.first.first);
+  }
+  edges.clear();
+
+  while (aliveCount > _triangles && !queue.empty())
+  {
+    const Collapse c = queue.top();
+    queue.pop();
+    if (removed[c.from] || removed[c.to] || c.fromStamp != stamps[c.from] ||
+        c.toStamp != stamps[c.to])
+    {
+      continue;
+    }
+
+    // The vertices must still share a triangle, and the other triangles
+    // must not flip
+    bool adjacent = false;
+    bool valid = true;
+    for (auto const t : vertexTriangles[c.from])
+    {
+      if (!alive[t])
+        continue;
+      auto tri = triangles[t];
+      if (tri[0] == c.to || tri[1] == c.to || tri[2] == c.to)
+      {
+        adjacent = true;
+        continue;
+      }
+
+      const ignition::math::Vector3d n0 = normal(tri);
+      for (auto &v : tri)
+      {
+        if (v == c.from)
+          v = c.to;
+      }
+      const ignition::math::Vector3d n1 = normal(tri);
+      if (n1.Dot(n0) <= kMinFlipCosine * n0.Length() * n1.Length())
+      {
+        valid = false;
+        break;
+      }
+    }
+    if (!adjacent || !valid)
+      continue;
+
+    // Collapse
+    std::vector<unsigned int> &kept = vertexTriangles[c.to];
+    for (auto const t : vertexTriangles[c.from])
+    {
+      if (!alive[t])
+        continue;
+      auto &tri = triangles[t];
+      if (tri[0] == c.to || tri[1] == c.to || tri[2] == c.to)
+      {
+        alive[t] = false;
+        --aliveCount;
+        continue;
+      }
+
+      for (unsigned int k = 0; k < 3; ++k)
+      {
+        if (tri[k] == c.from)
+        {
+          tri[k] = c.to;
+          corners[t][k] = weldedVertex[c.to];
+        }
+      }
+      kept.push_back(t);
+    }
+    vertexTriangles[c.from].clear();
+    removed[c.from] = true;
+    quadrics[c.to].Add(quadrics[c.from]);
+    ++stamps[c.to];
+
+    kept.erase(std::remove_if(kept.begin(), kept.end(),
+          [&alive](const unsigned int _t) {return !alive[_t];}), kept.end());
+
+    // The costs of the edges of the kept vertex changed
+    std::set<unsigned int> neighbors;
+    for (auto const t : kept)
+    {
+      for (auto const v : triangles[t])
+      {
+        if (v != c.to)
+          neighbors.insert(v);
+      }
+    }
+    for (auto const v : neighbors)
+    {
+      push(c.to, v);
+      push(v, c.to);
+    }
+  }
+
+  std::vector<unsigned int> result;
+  result.reserve(aliveCount * 3);
+  for (unsigned int t = 0; t < triangleCount; ++t)
+  {
+    if (alive[t])
+      result.insert(result.end(), corners[t].begin(), corners[t].end());
+  }
+  return result;
+}
+
+/////////////////////////////////////////////////
+std::vector<unsigned int> MeshSimplifier::Simplify(const SubMesh &_subMesh,
+    const std::vector<unsigned int> &_indices, const size_t _triangles) const
+{
+  std::vector<ignition::math::Vector3d> vertices(_subMesh.GetVertexCount());
+  for (unsigned int i = 0; i < vertices.size(); ++i)
+    vertices[i] = _subMesh.Vertex(i);
+
+  std::string cacheFile;
+  if (!this->dataPtr->cachePath.empty())
+  {
+    // The file is named after everything the result depends on
+    std::vector<double> key;
+    key.reserve(vertices.size() * 3 + _indices.size() + 2);
+    for (auto const &v : vertices)
+    {
+      key.push_back(v.X());
+      key.push_back(v.Y());
+      key.push_back(v.Z());
+    }
+    key.insert(key.end(), _indices.begin(), _indices.end());
+    key.push_back(static_cast<double>(_triangles));
+    key.push_back(kCacheVersion);
+
+    cacheFile = (boost::filesystem::path(this->dataPtr->cachePath) /
+        (get_sha1<std::vector<double>>(key) + ".lod")).string();
+
+    std::vector<unsigned int> cached;
+    if (ReadCache(cacheFile, vertices.size(), cached))
+      return cached;
+  }
+
+  std::vector<unsigned int> result =
+    this->Simplify(vertices, _indices, _triangles);
+
+  if (!cacheFile.empty())
+    WriteCache(cacheFile, result);
+
+  return result;
+}
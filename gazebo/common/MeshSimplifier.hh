@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_COMMON_MESHSIMPLIFIER_HH_
+#define GAZEBO_COMMON_MESHSIMPLIFIER_HH_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <ignition/math/Vector3.hh>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace common
+  {
+    // Forward declare private data class.
+    class MeshSimplifierPrivate;
+    class SubMesh;
+
+    /// \addtogroup gazebo_common Common
+    /// \{
+
+    /// \class MeshSimplifier MeshSimplifier.hh common/common.hh
+    /// \brief Reduces the number of triangles of a mesh by quadric error
+    /// edge collapses, to render distant meshes with less detail.
+    ///
+    /// Each collapse merges a vertex into a neighbor, so the simplified
+    /// triangles use a subset of the original vertices and may share their
+    /// vertex buffers. Vertices at the same position, e.g. at texture
+    /// seams, are collapsed together, so the mesh does not crack. Open
+    /// borders are preserved, and collapses that would flip a triangle are
+    /// rejected.
+    class GZ_COMMON_VISIBLE MeshSimplifier
+    {
+      /// \brief Constructor.
+      public: MeshSimplifier();
+
+      /// \brief Destructor.
+      public: virtual ~MeshSimplifier();
+
+      /// \brief Set a directory where the simplified triangles of sub
+      /// meshes are cached, so that a mesh is only simplified once.
+      /// \param[in] _path Path of the directory, empty to disable the
+      /// cache. The directory is created when needed.
+      public: void SetCachePath(const std::string &_path);
+
+      /// \brief Get the directory where the simplified triangles are
+      /// cached.
+      /// \return Path of the directory, empty if there is no cache.
+      public: std::string CachePath() const;
+
+      /// \brief Simplify a triangle list.
+      /// \param[in] _vertices Vertex positions.
+      /// \param[in] _indices Vertex indices, three per triangle.
+      /// \param[in] _triangles Number of triangles to keep.
+      /// \return Vertex indices of the simplified triangles, which may have
+      /// more triangles than asked if no valid collapse is left.
+      public: std::vector<unsigned int> Simplify(
+                  const std::vector<ignition::math::Vector3d> &_vertices,
+                  const std::vector<unsigned int> &_indices,
+                  const size_t _triangles) const;
+
+      /// \brief Simplify triangles of a sub mesh, using the cache.
+      /// \param[in] _subMesh Sub mesh with TRIANGLES primitives.
+      /// \param[in] _indices Vertex indices to simplify, e.g. the indices
+      /// of the sub mesh or of a previous simplification.
+      /// \param[in] _triangles Number of triangles to keep.
+      /// \return Vertex indices of the simplified triangles.
+      public: std::vector<unsigned int> Simplify(const SubMesh &_subMesh,
+                  const std::vector<unsigned int> &_indices,
+                  const size_t _triangles) const;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<MeshSimplifierPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <vector>
+#include <boost/filesystem.hpp>
+
+#include "gazebo/common/Mesh.hh"
+#include "gazebo/common/MeshSimplifier.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class MeshSimplifierTest : public gazebo::testing::AutoLogFixture { };
+
+/// \brief Number of quads per side of the test grid.
+static const unsigned int kGridSize = 40;
+
+/////////////////////////////////////////////////
+/// \brief Fill a flat square grid of triangles, in the z = 0 plane and
+/// facing +z.
+/// \param[out] _vertices Vertex positions.
+/// \param[out] _indices Vertex indices.
+static void Grid(std::vector<ignition::math::Vector3d> &_vertices,
+    std::vector<unsigned int> &_indices)
+{
+  for (unsigned int y = 0; y <= kGridSize; ++y)
+  {
+    for (unsigned int x = 0; x <= kGridSize; ++x)
+      _vertices.push_back(ignition::math::Vector3d(x * 0.1, y * 0.1, 0));
+  }
+
+  for (unsigned int y = 0; y < kGridSize; ++y)
+  {
+    for (unsigned int x = 0; x < kGridSize; ++x)
+    {
+      unsigned int i = y * (kGridSize + 1) + x;
+      _indices.insert(_indices.end(), {i, i + 1, i + kGridSize + 2});
+      _indices.insert(_indices.end(), {i, i + kGridSize + 2,
+          i + kGridSize + 1});
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshSimplifierTest, Plane)
+{
+  std::vector<ignition::math::Vector3d> vertices;
+  std::vector<unsigned int> indices;
+  Grid(vertices, indices);
+
+  common::MeshSimplifier simplifier;
+  EXPECT_TRUE(simplifier.CachePath().empty());
+
+  // Nothing to do
+  EXPECT_EQ(indices, simplifier.Simplify(vertices, indices,
+        indices.size() / 3));
+
+  std::vector<unsigned int> result =
+    simplifier.Simplify(vertices, indices, 100);
+  ASSERT_EQ(0u, result.size() % 3);
+  EXPECT_LE(result.size() / 3, 100u);
+  EXPECT_GT(result.size(), 0u);
+
+  // The triangles keep facing up, and the corners of the grid are kept
+  const unsigned int last = kGridSize + 1;
+  std::vector<bool> used(vertices.size(), false);
+  double area = 0;
+  for (unsigned int i = 0; i < result.size(); i += 3)
+  {
+    ASSERT_LT(result[i], vertices.size());
+    ASSERT_LT(result[i + 1], vertices.size());
+    ASSERT_LT(result[i + 2], vertices.size());
+    ignition::math::Vector3d n =
+      (vertices[result[i + 1]] - vertices[result[i]]).Cross(
+          vertices[result[i + 2]] - vertices[result[i]]);
+    EXPECT_GT(n.Z(), 0.0);
+    area += n.Z() * 0.5;
+    for (unsigned int k = 0; k < 3; ++k)
+      used[result[i + k]] = true;
+  }
+  EXPECT_TRUE(used[0]);
+  EXPECT_TRUE(used[last - 1]);
+  EXPECT_TRUE(used[last * kGridSize]);
+  EXPECT_TRUE(used[last * last - 1]);
+
+  // The simplified grid still covers the square
+  EXPECT_NEAR(kGridSize * kGridSize * 0.01, area, 1e-6);
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshSimplifierTest, Cache)
+{
+  std::vector<ignition::math::Vector3d> vertices;
+  std::vector<unsigned int> indices;
+  Grid(vertices, indices);
+
+  common::SubMesh subMesh;
+  for (auto const &v : vertices)
+    subMesh.AddVertex(v);
+  for (auto const i : indices)
+    subMesh.AddIndex(i);
+
+  boost::filesystem::path path = boost::filesystem::temp_directory_path() /
+    boost::filesystem::unique_path("gazebo_lod_%%%%%%%%");
+
+  common::MeshSimplifier simplifier;
+  simplifier.SetCachePath(path.string());
+  EXPECT_EQ(path.string(), simplifier.CachePath());
+
+  std::vector<unsigned int> expected =
+    simplifier.Simplify(vertices, indices, 200);
+
+  // The first call fills the cache, the second reads it
+  EXPECT_EQ(expected, simplifier.Simplify(subMesh, indices, 200));
+  ASSERT_TRUE(boost::filesystem::is_directory(path));
+  EXPECT_EQ(1, std::distance(boost::filesystem::directory_iterator(path),
+        boost::filesystem::directory_iterator()));
+  EXPECT_EQ(expected, simplifier.Simplify(subMesh, indices, 200));
+
+  // Another target is another cache entry
+  simplifier.Simplify(subMesh, indices, 300);
+  EXPECT_EQ(2, std::distance(boost::filesystem::directory_iterator(path),
+        boost::filesystem::directory_iterator()));
+
+  boost::filesystem::remove_all(path);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
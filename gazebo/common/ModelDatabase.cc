@@ -22,9 +22,18 @@
 #include <curl/curl.h>
 #include <fcntl.h>
 #include <sys/stat.h>
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
 #include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include <boost/algorithm/string/replace.hpp>
+#include <boost/algorithm/string/trim.hpp>
 #include <boost/bind/bind.hpp>
 #include <boost/filesystem.hpp>
 #include <boost/function.hpp>
@@ -36,7 +45,9 @@
 
 #include "gazebo/common/Time.hh"
 #include "gazebo/common/SystemPaths.hh"
+#include "gazebo/common/CommonIface.hh"
 #include "gazebo/common/Console.hh"
+#include "gazebo/common/FuelModelDatabase.hh"
 #include "gazebo/common/ModelDatabasePrivate.hh"
 #include "gazebo/common/ModelDatabase.hh"
 #include "gazebo/common/SemanticVersion.hh"
@@ -70,6 +81,10 @@ ModelDatabase::ModelDatabase()
   : dataPtr(new ModelDatabasePrivate)
 {
   this->dataPtr->updateCacheThread = nullptr;
+
+  char *cachePath = getenv("GAZEBO_MODEL_CACHE_PATH");
+  if (cachePath)
+    this->dataPtr->cachePath = cachePath;
   this->Start();
 }
 
@@ -77,6 +92,8 @@ ModelDatabase::ModelDatabase()
 ModelDatabase::~ModelDatabase()
 {
   this->Fini();
+  for (auto curl : this->dataPtr->curlHandles)
+    curl_easy_cleanup(curl);
   delete this->dataPtr;
   this->dataPtr = nullptr;
 }
@@ -436,82 +453,122 @@ std::string ModelDatabase::GetModelPath(const std::string &_uri,
 
     modelName = modelName.substr(startIndex, modelNameLen);
 
-    // Store downloaded .tar.gz and intermediate .tar files in temp location
-    boost::filesystem::path tmppath = boost::filesystem::temp_directory_path();
-    tmppath /= boost::filesystem::unique_path("gz_model-%%%%-%%%%-%%%%-%%%%");
-    std::string tarfilename = tmppath.string() + ".tar";
-    std::string tgzfilename = tarfilename + ".gz";
+    path = this->DownloadModel(_uri, modelName);
+    if (path.empty())
+      return std::string();
+  }
 
-    CURL *curl = curl_easy_init();
-    if (!curl)
+  return path + suffix;
+}
+
+/////////////////////////////////////////////////
+std::string ModelDatabase::DownloadModel(const std::string &_uri,
+    const std::string &_modelName)
+{
+  std::promise<std::string> promise;
+  std::shared_future<std::string> download;
+  bool downloading = false;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->downloadsMutex);
+    auto iter = this->dataPtr->downloads.find(_modelName);
+    if (iter != this->dataPtr->downloads.end())
     {
-      gzerr << "Unable to initialize libcurl\n";
-      return std::string();
+      download = iter->second;
+      downloading = true;
+    }
+    else
+    {
+      this->dataPtr->downloads[_modelName] = promise.get_future().share();
     }
+  }
 
-    curl_easy_setopt(curl, CURLOPT_URL,
-        (ModelDatabase::GetURI() + "/" +
-         modelName + "/model.tar.gz").c_str());
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, write_data);
+  // Wait for the download started by another thread
+  if (downloading)
+    return download.get();
 
-    bool retry = true;
-    int iterations = 0;
-    while (retry && iterations < 4)
-    {
-      retry = false;
-      iterations++;
+  std::string path;
+  try
+  {
+    path = this->DownloadModelImpl(_uri, _modelName);
+  }
+  catch(...)
+  {
+    gzerr << "Could not download model[" << _uri << "]\n";
+  }
 
-      FILE *fp = fopen(tgzfilename.c_str(), "wb");
-      if (!fp)
-      {
-        gzerr << "Could not download model[" << _uri << "] because we were"
-          << "unable to write to file[" << tgzfilename << "]."
-          << "Please fix file permissions.";
-        return std::string();
-      }
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->downloadsMutex);
+    this->dataPtr->downloads.erase(_modelName);
+  }
+  promise.set_value(path);
 
-      /// Download the model tarball
-      curl_easy_setopt(curl, CURLOPT_WRITEDATA, fp);
-      CURLcode success = curl_easy_perform(curl);
+  return path;
+}
 
-      if (success != CURLE_OK)
-      {
-        gzwarn << "Unable to connect to model database using ["
-               << _uri << "]\n";
-        retry = true;
-        continue;
-      }
+/////////////////////////////////////////////////
+std::string ModelDatabase::DownloadModelImpl(const std::string &_uri,
+    const std::string &_modelName)
+{
+  std::string path;
 
-      fclose(fp);
+  // Store downloaded .tar.gz and intermediate .tar files in temp location
+  boost::filesystem::path tmppath = boost::filesystem::temp_directory_path();
+  tmppath /= boost::filesystem::unique_path("gz_model-%%%%-%%%%-%%%%-%%%%");
+  std::string tarfilename = tmppath.string() + ".tar";
+  std::string tgzfilename = tarfilename + ".gz";
 
-      try
-      {
-        // Unzip model tarball
-        std::ifstream file(tgzfilename.c_str(),
-            std::ios_base::in | std::ios_base::binary);
-        std::ofstream out(tarfilename.c_str(),
-            std::ios_base::out | std::ios_base::binary);
-        boost::iostreams::filtering_streambuf<boost::iostreams::input> in;
-        in.push(boost::iostreams::gzip_decompressor());
-        in.push(file);
-        boost::iostreams::copy(in, out);
-      }
-      catch(...)
-      {
-        gzerr << "Failed to unzip model tarball. Trying again...\n";
-        retry = true;
-        continue;
-      }
+  const std::string url = ModelDatabase::GetURI() + "/" + _modelName +
+      "/model.tar.gz";
+
+  bool retry = true;
+  int iterations = 0;
+  while (retry && iterations < 4)
+  {
+    retry = false;
+    iterations++;
 
-      std::string outputPath = getenv("HOME");
-      outputPath += "/.gazebo/models";
+    /// Download the model tarball
+    std::string tarball = this->FetchTarball(url, tgzfilename);
+    if (tarball.empty())
+    {
+      gzwarn << "Unable to connect to model database using ["
+             << _uri << "]\n";
+      retry = true;
+      continue;
+    }
 
+    try
+    {
+      // Unzip model tarball
+      std::ifstream file(tarball.c_str(),
+          std::ios_base::in | std::ios_base::binary);
+      std::ofstream out(tarfilename.c_str(),
+          std::ios_base::out | std::ios_base::binary);
+      boost::iostreams::filtering_streambuf<boost::iostreams::input> in;
+      in.push(boost::iostreams::gzip_decompressor());
+      in.push(file);
+      boost::iostreams::copy(in, out);
+    }
+    catch(...)
+    {
+      gzerr << "Failed to unzip model tarball. Trying again...\n";
+      retry = true;
+      continue;
+    }
+
+    std::string outputPath = getenv("HOME");
+    outputPath += "/.gazebo/models";
+
+    {
+      std::lock_guard<std::mutex> lock(this->dataPtr->extractMutex);
 #ifndef _WIN32
       TAR *tar;
-      tar_open(&tar, const_cast<char*>(tarfilename.c_str()),
-          nullptr, O_RDONLY, 0644, TAR_GNU);
-
-      tar_extract_all(tar, const_cast<char*>(outputPath.c_str()));
+      if (tar_open(&tar, const_cast<char*>(tarfilename.c_str()),
+          nullptr, O_RDONLY, 0644, TAR_GNU) == 0)
+      {
+        tar_extract_all(tar, const_cast<char*>(outputPath.c_str()));
+        tar_close(tar);
+      }
 #else
       // Tar now is a built-in tool since Windows 10 build 17063.
       std::string cmdline = "tar xzf \"";
@@ -524,31 +581,315 @@ std::string ModelDatabase::GetModelPath(const std::string &_uri,
               << std::endl;
       }
 #endif
-      path = outputPath + "/" + modelName;
-      ModelDatabase::DownloadDependencies(path);
     }
+    path = outputPath + "/" + _modelName;
 
-    curl_easy_cleanup(curl);
-    if (retry)
+    // Files of the model may have been looked for before it was installed
+    SystemPaths::Instance()->ClearFindFileCache();
+    ModelDatabase::DownloadDependencies(path);
+  }
+
+  if (retry)
+  {
+    gzerr << "Could not download model[" << _uri << "]."
+      << "The model may be corrupt.\n";
+    path.clear();
+  }
+
+  // Clean up
+  try
+  {
+    boost::filesystem::remove(tarfilename);
+    boost::filesystem::remove(tgzfilename);
+  }
+  catch(...)
+  {
+    gzwarn << "Failed to remove temporary model files after download.";
+  }
+
+  return path;
+}
+
+/////////////////////////////////////////////////
+/// \brief Read a whole file.
+/// \param[in] _filename Path to the file.
+/// \param[out] _data Content of the file.
+/// \return True if the file was read.
+static bool readFile(const std::string &_filename, std::string &_data)
+{
+  std::ifstream file(_filename, std::ios_base::in | std::ios_base::binary);
+  if (!file)
+    return false;
+
+  std::ostringstream stream;
+  stream << file.rdbuf();
+  _data = stream.str();
+  return !file.bad();
+}
+
+/////////////////////////////////////////////////
+/// \brief Write a file in a directory shared by several users, through a
+/// temporary file renamed in place so that readers never see a partial file.
+/// \param[in] _filename Path to the file.
+/// \param[in] _data Content of the file.
+/// \return True if the file was written.
+static bool writeSharedFile(const boost::filesystem::path &_filename,
+    const std::string &_data)
+{
+  boost::system::error_code ec;
+  boost::filesystem::path tmp = _filename;
+  tmp += boost::filesystem::unique_path(".%%%%-%%%%.tmp", ec);
+  {
+    std::ofstream file(tmp.string(),
+        std::ios_base::out | std::ios_base::binary);
+    file.write(_data.data(), _data.size());
+    if (!file)
     {
-      gzerr << "Could not download model[" << _uri << "]."
-        << "The model may be corrupt.\n";
-      path.clear();
+      file.close();
+      boost::filesystem::remove(tmp, ec);
+      return false;
     }
+  }
 
-    // Clean up
-    try
+  boost::filesystem::permissions(tmp, boost::filesystem::owner_read |
+      boost::filesystem::owner_write | boost::filesystem::group_read |
+      boost::filesystem::others_read, ec);
+  boost::filesystem::rename(tmp, _filename, ec);
+  if (ec)
+  {
+    boost::filesystem::remove(tmp, ec);
+    return false;
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+std::string ModelDatabase::FetchTarball(const std::string &_url,
+    const std::string &_filename)
+{
+  boost::system::error_code ec;
+  const std::string cachePath = this->CachePath();
+  const std::string key = get_sha1(_url);
+  const boost::filesystem::path cachedTarball =
+      boost::filesystem::path(cachePath) / (key + ".tar.gz");
+  const boost::filesystem::path cachedChecksum =
+      boost::filesystem::path(cachePath) / (key + ".sha1");
+
+  // A cached tarball is used only if it matches the checksum written along
+  // with it, otherwise it is downloaded again.
+  if (!cachePath.empty() && boost::filesystem::exists(cachedChecksum, ec))
+  {
+    std::string data, checksum;
+    if (readFile(cachedChecksum.string(), checksum) &&
+        readFile(cachedTarball.string(), data) &&
+        get_sha1(data) == checksum)
     {
-      boost::filesystem::remove(tarfilename);
-      boost::filesystem::remove(tgzfilename);
+      return cachedTarball.string();
     }
-    catch(...)
+    gzwarn << "Ignoring corrupt cached model tarball[" << cachedTarball
+           << "]\n";
+  }
+
+  CURL *curl = this->dataPtr->AcquireCurl();
+  if (!curl)
+  {
+    gzerr << "Unable to initialize libcurl\n";
+    return std::string();
+  }
+
+  FILE *fp = fopen(_filename.c_str(), "wb");
+  if (!fp)
+  {
+    this->dataPtr->ReleaseCurl(curl);
+    gzerr << "Could not download model[" << _url << "] because we were"
+      << "unable to write to file[" << _filename << "]."
+      << "Please fix file permissions.";
+    return std::string();
+  }
+
+  curl_easy_setopt(curl, CURLOPT_URL, _url.c_str());
+  curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, write_data);
+  curl_easy_setopt(curl, CURLOPT_WRITEDATA, fp);
+  curl_easy_setopt(curl, CURLOPT_FAILONERROR, 1L);
+  curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE, 1L);
+  CURLcode success = curl_easy_perform(curl);
+  fclose(fp);
+  this->dataPtr->ReleaseCurl(curl);
+
+  if (success != CURLE_OK)
+    return std::string();
+
+  // Share the tarball with the other users of the machine
+  std::string data;
+  if (!cachePath.empty() && readFile(_filename, data))
+  {
+    boost::filesystem::create_directories(cachePath, ec);
+    if (writeSharedFile(cachedTarball, data))
+      writeSharedFile(cachedChecksum, get_sha1(data));
+  }
+
+  return _filename;
+}
+
+/////////////////////////////////////////////////
+CURL *ModelDatabasePrivate::AcquireCurl()
+{
+  std::unique_lock<std::mutex> lock(this->curlMutex);
+  this->curlCondition.wait(lock, [this]
+      {
+        return !this->curlHandles.empty() ||
+            this->curlHandleCount < this->maxConnections;
+      });
+
+  if (!this->curlHandles.empty())
+  {
+    CURL *curl = this->curlHandles.back();
+    this->curlHandles.pop_back();
+    return curl;
+  }
+
+  CURL *curl = curl_easy_init();
+  if (curl)
+    ++this->curlHandleCount;
+  return curl;
+}
+
+/////////////////////////////////////////////////
+void ModelDatabasePrivate::ReleaseCurl(CURL *_curl)
+{
+  {
+    std::lock_guard<std::mutex> lock(this->curlMutex);
+    if (this->curlHandleCount > this->maxConnections)
     {
-      gzwarn << "Failed to remove temporary model files after download.";
+      // The limit was lowered while the handle was in use
+      curl_easy_cleanup(_curl);
+      --this->curlHandleCount;
+    }
+    else
+    {
+      this->curlHandles.push_back(_curl);
     }
   }
+  this->curlCondition.notify_one();
+}
 
-  return path + suffix;
+/////////////////////////////////////////////////
+void ModelDatabase::SetMaxConnections(const unsigned int _count)
+{
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->curlMutex);
+    this->dataPtr->maxConnections = std::max(_count, 1u);
+    while (!this->dataPtr->curlHandles.empty() &&
+        this->dataPtr->curlHandleCount > this->dataPtr->maxConnections)
+    {
+      curl_easy_cleanup(this->dataPtr->curlHandles.back());
+      this->dataPtr->curlHandles.pop_back();
+      --this->dataPtr->curlHandleCount;
+    }
+  }
+  this->dataPtr->curlCondition.notify_all();
+}
+
+/////////////////////////////////////////////////
+unsigned int ModelDatabase::MaxConnections() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->curlMutex);
+  return this->dataPtr->maxConnections;
+}
+
+/////////////////////////////////////////////////
+void ModelDatabase::SetCachePath(const std::string &_path)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->cachePathMutex);
+  this->dataPtr->cachePath = _path;
+}
+
+/////////////////////////////////////////////////
+std::string ModelDatabase::CachePath() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->cachePathMutex);
+  return this->dataPtr->cachePath;
+}
+
+/////////////////////////////////////////////////
+void ModelDatabase::Prefetch(const std::vector<std::string> &_uris)
+{
+  std::vector<std::string> uris = _uris;
+  std::sort(uris.begin(), uris.end());
+  uris.erase(std::unique(uris.begin(), uris.end()), uris.end());
+  if (uris.empty())
+    return;
+
+  const std::string dbURI = ModelDatabase::GetURI();
+  std::atomic<size_t> next(0);
+  auto fetch = [&]()
+  {
+    for (size_t i = next++; i < uris.size(); i = next++)
+    {
+      const std::string &uri = uris[i];
+      if ((uri.compare(0, 7, "http://") == 0 ||
+           uri.compare(0, 8, "https://") == 0) &&
+          uri.compare(0, dbURI.size(), dbURI) != 0)
+      {
+        FuelModelDatabase::Instance()->ModelPath(uri);
+      }
+      else
+      {
+        this->GetModelPath(uri);
+      }
+    }
+  };
+
+  // The calling thread fetches too, the other threads are bounded by the
+  // number of connections.
+  const size_t threadCount = std::min<size_t>(uris.size(),
+      this->MaxConnections()) - 1;
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < threadCount; ++i)
+    threads.emplace_back(fetch);
+  fetch();
+  for (auto &thread : threads)
+    thread.join();
+}
+
+/////////////////////////////////////////////////
+/// \brief Collect the URIs of the models an SDF element includes.
+/// \param[in] _elem The element.
+/// \param[out] _uris The URIs.
+static void includedURIs(const TiXmlElement *_elem,
+    std::vector<std::string> &_uris)
+{
+  for (const TiXmlElement *child = _elem->FirstChildElement(); child;
+       child = child->NextSiblingElement())
+  {
+    if (std::string(child->Value()) == "include")
+    {
+      const TiXmlElement *uriXML = child->FirstChildElement("uri");
+      if (uriXML && uriXML->GetText())
+      {
+        std::string uri = uriXML->GetText();
+        boost::trim(uri);
+        if (uri.find("://") != std::string::npos)
+          _uris.push_back(uri);
+      }
+    }
+    else
+    {
+      includedURIs(child, _uris);
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+void ModelDatabase::PrefetchFile(const std::string &_filename)
+{
+  TiXmlDocument xmlDoc;
+  if (!xmlDoc.LoadFile(_filename) || !xmlDoc.RootElement())
+    return;
+
+  std::vector<std::string> uris;
+  includedURIs(xmlDoc.RootElement(), uris);
+  this->Prefetch(uris);
 }
 
 /////////////////////////////////////////////////
@@ -579,14 +920,14 @@ void ModelDatabase::DownloadDependencies(const std::string &_path)
     if (!dependXML)
       return;
 
+    std::vector<std::string> uris;
     for (TiXmlElement *depXML = dependXML->FirstChildElement("model");
          depXML; depXML = depXML->NextSiblingElement())
     {
       TiXmlElement *uriXML = depXML->FirstChildElement("uri");
-      if (uriXML)
+      if (uriXML && uriXML->GetText())
       {
-        // Download the model if it doesn't exist.
-        ModelDatabase::GetModelPath(uriXML->GetText());
+        uris.push_back(uriXML->GetText());
       }
       else
       {
@@ -594,6 +935,9 @@ void ModelDatabase::DownloadDependencies(const std::string &_path)
               << manifestPath << "]\n";
       }
     }
+
+    // Download the models that don't exist, concurrently.
+    this->Prefetch(uris);
   }
   else
     gzerr << "Unable to load manifest file[" << manifestPath << "]\n";
@@ -20,6 +20,7 @@
 #include <string>
 #include <map>
 #include <utility>
+#include <vector>
 
 #include <boost/function.hpp>
 #include "gazebo/common/Event.hh"
@@ -129,6 +130,38 @@ namespace gazebo
       /// \param[in] _path Path to a model.
       public: void DownloadDependencies(const std::string &_path);
 
+      /// \brief Download models concurrently, e.g. all the models a world
+      /// includes before loading it. Models found locally are skipped, and
+      /// http and https URIs which are not in this database are fetched
+      /// from Ignition Fuel.
+      /// \param[in] _uris URIs of the models.
+      public: void Prefetch(const std::vector<std::string> &_uris);
+
+      /// \brief Download the models included by an SDF file, see Prefetch.
+      /// \param[in] _filename Full path to the SDF file, e.g. a world file.
+      public: void PrefetchFile(const std::string &_filename);
+
+      /// \brief Set the maximum number of concurrent downloads. The default
+      /// is 8.
+      /// \param[in] _count Maximum number of connections, at least 1.
+      public: void SetMaxConnections(const unsigned int _count);
+
+      /// \brief Get the maximum number of concurrent downloads.
+      /// \return Maximum number of connections.
+      public: unsigned int MaxConnections() const;
+
+      /// \brief Set the directory where downloaded model tarballs are kept,
+      /// along with their checksum. The directory may be shared by the users
+      /// of a machine, it should only be writable by trusted users. The
+      /// default is the GAZEBO_MODEL_CACHE_PATH environment variable, the
+      /// cache is disabled if it is not set.
+      /// \param[in] _path The directory, empty to disable the cache.
+      public: void SetCachePath(const std::string &_path);
+
+      /// \brief Get the directory where downloaded model tarballs are kept.
+      /// \return The directory, empty if the cache is disabled.
+      public: std::string CachePath() const;
+
       /// \brief Returns true if the model exists on the database.
       ///
       /// \param[in] _modelName URI of the model (eg:
@@ -150,6 +183,29 @@ namespace gazebo
       /// no one else should use this function.
       private: bool UpdateModelCacheImpl();
 
+      /// \brief Download and install a model, or wait for the download in
+      /// progress of the same model.
+      /// \param[in] _uri URI of the model, for messages.
+      /// \param[in] _modelName Name of the model in the database.
+      /// \return Path to the model directory, empty on failure.
+      private: std::string DownloadModel(const std::string &_uri,
+                   const std::string &_modelName);
+
+      /// \brief Download and install a model.
+      /// \param[in] _uri URI of the model, for messages.
+      /// \param[in] _modelName Name of the model in the database.
+      /// \return Path to the model directory, empty on failure.
+      private: std::string DownloadModelImpl(const std::string &_uri,
+                   const std::string &_modelName);
+
+      /// \brief Get the tarball of a model, from the cache or else from the
+      /// database.
+      /// \param[in] _url URL of the tarball.
+      /// \param[in] _filename File to download the tarball to.
+      /// \return Path to the tarball, empty on failure.
+      private: std::string FetchTarball(const std::string &_url,
+                   const std::string &_filename);
+
       /// \brief Private data.
       private: ModelDatabasePrivate *dataPtr;
 
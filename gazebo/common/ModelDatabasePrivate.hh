@@ -17,9 +17,15 @@
 #ifndef _GAZEBO_MODELDATABSE_PRIVATE_HH_
 #define _GAZEBO_MODELDATABSE_PRIVATE_HH_
 
+#include <curl/curl.h>
+
+#include <condition_variable>
+#include <future>
 #include <list>
 #include <map>
+#include <mutex>
 #include <string>
+#include <vector>
 
 #include <boost/function.hpp>
 #include <boost/thread.hpp>
@@ -68,6 +74,51 @@ namespace gazebo
       /// calling ModelDatabase::GetModels()
       public: event::EventT<
                void (std::map<std::string, std::string>)> modelDBUpdated;
+
+      /// \brief Get a curl handle, waiting while maxConnections handles are
+      /// in use.
+      /// \return The handle, null if curl failed to create one.
+      public: CURL *AcquireCurl();
+
+      /// \brief Return a handle given by AcquireCurl, so that the next
+      /// download reuses its connection.
+      /// \param[in] _curl The handle.
+      public: void ReleaseCurl(CURL *_curl);
+
+      /// \brief Downloads in progress, indexed by model name. A model
+      /// requested again while it downloads waits for the same download.
+      public: std::map<std::string, std::shared_future<std::string>>
+              downloads;
+
+      /// \brief Protects downloads.
+      public: std::mutex downloadsMutex;
+
+      /// \brief Idle curl handles. Curl keeps the connections of a handle
+      /// open, so reusing handles avoids a new connection per model.
+      public: std::vector<CURL *> curlHandles;
+
+      /// \brief Number of curl handles created.
+      public: unsigned int curlHandleCount = 0;
+
+      /// \brief Maximum number of concurrent connections.
+      public: unsigned int maxConnections = 8;
+
+      /// \brief Protects curlHandles, curlHandleCount and maxConnections.
+      public: std::mutex curlMutex;
+
+      /// \brief Notified when a curl handle is released.
+      public: std::condition_variable curlCondition;
+
+      /// \brief Serializes the extraction of tarballs, libtar is not
+      /// thread safe.
+      public: std::mutex extractMutex;
+
+      /// \brief Directory of the downloaded tarballs, shared by the users of
+      /// the machine. Empty to disable the cache.
+      public: std::string cachePath;
+
+      /// \brief Protects cachePath.
+      public: std::mutex cachePathMutex;
     };
   }
 }
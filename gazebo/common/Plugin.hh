@@ -27,7 +27,14 @@
 #include <gazebo/gazebo_config.h>
 #include <dlfcn.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <functional>
 #include <list>
+#include <memory>
 #include <string>
 
 #include <sdf/sdf.hh>
@@ -36,7 +43,11 @@
 #include "gazebo/common/CommonTypes.hh"
 #include "gazebo/common/SystemPaths.hh"
 #include "gazebo/common/Console.hh"
+#include "gazebo/common/Events.hh"
 #include "gazebo/common/Exception.hh"
+#include "gazebo/common/PluginLibraryCache.hh"
+#include "gazebo/common/Time.hh"
+#include "gazebo/common/UpdateInfo.hh"
 
 #include "gazebo/physics/PhysicsTypes.hh"
 #include "gazebo/sensors/SensorTypes.hh"
@@ -107,7 +118,9 @@ namespace gazebo
             }
 
     /// \brief a class method that creates a plugin from a file name.
-    /// It locates the shared library and loads it dynamically.
+    /// It locates the shared library and loads it dynamically. The library
+    /// is kept in common::PluginLibraryCache, so that other plugins of the
+    /// same library are created without searching the plugin paths again.
     /// \param[in] _filename the path to the shared library.
     /// \param[in] _name short name of the plugin
     /// \return Shared Pointer to this class type
@@ -115,122 +128,22 @@ namespace gazebo
                 const std::string &_name)
             {
               TPtr result;
-              // PluginPtr result;
-              std::string filename(_filename);
-              std::list<std::string> pluginPaths =
-                common::SystemPaths::Instance()->GetPluginPaths();
-              std::ostringstream errorStream;
-
-              // helper function to find and dlopen a plugin file
-              // returns void * dlHandle
-              auto findAndDlopenPluginFile = [](
-                  const std::string &_pluginFilename,
-                  const std::list<std::string> &_pluginPaths,
-                  std::ostringstream &_errorStream) -> void *
+              common::PluginLibrary library;
+              if (!common::PluginLibraryCache::Instance()->Load(
+                    _filename, library))
               {
-                struct stat st;
-                bool found = false;
-                std::string fullname;
-                std::list<std::string>::const_iterator iter;
-
-                for (iter = _pluginPaths.begin();
-                     iter!= _pluginPaths.end(); ++iter)
-                {
-                  fullname = (*iter)+std::string("/")+_pluginFilename;
-                  fullname = boost::filesystem::path(fullname)
-                      .make_preferred().string();
-                  if (stat(fullname.c_str(), &st) == 0)
-                  {
-                    found = true;
-                    break;
-                  }
-                }
-
-                if (!found)
-                  fullname = _pluginFilename;
-
-                void *dlHandle = dlopen(fullname.c_str(), RTLD_LAZY|RTLD_GLOBAL);
-                if (!dlHandle)
-                {
-                  _errorStream << "Failed to load plugin " << fullname << ": "
-                    << dlerror() << "\n";
-                }
-                return dlHandle;
-              };
-
-              // This logic is to support different extensions on each OS
-              // see issue #800
-              //
-              // Linux: lib*.so
-              // macOS: lib*.so, lib*.dylib
-              // Windows: *.dll
-              //
-              // Assuming that most plugin names are specified as lib*.so,
-              // replace prefix and suffix depending on the OS.
-              // On macOS, first try the lib*.so name, then try lib*.dylib
-#ifdef _WIN32
-              {
-                // replace .so with .dll
-                size_t soSuffix = filename.rfind(".so");
-                if (soSuffix != std::string::npos)
-                {
-                  const std::string winSuffix(".dll");
-                  filename.replace(soSuffix, winSuffix.length(), winSuffix);
-                }
-                size_t libPrefix = filename.find("lib");
-                if (libPrefix == 0)
-                {
-                  // remove the lib prefix
-                  filename.erase(0, 3);
-                }
-              }
-#endif  // ifdef _WIN32
-
-              // Try to find and dlopen plugin with the following pattern:
-              // Linux: lib*.so
-              // macOS: lib*.so
-              // Windows: *.dll
-              void *dlHandle = findAndDlopenPluginFile(filename, pluginPaths,
-                                                       errorStream);
-#ifdef __APPLE__
-              if (!dlHandle)
-              {
-                // lib*.so file could not be found or opened, try lib*.dylib
-                size_t soSuffix = filename.rfind(".so");
-                if (soSuffix != std::string::npos)
-                {
-                  const std::string macSuffix(".dylib");
-                  filename.replace(soSuffix, macSuffix.length(), macSuffix);
-                }
-              }
-              // macOS: lib*.dylib
-              dlHandle = findAndDlopenPluginFile(filename, pluginPaths, errorStream);
-#endif  // ifdef __APPLE__
-
-              if (!dlHandle)
-              {
-                gzerr << errorStream.str();
                 return result;
               }
 
               fptr_union_t registerFunc;
-              const char *registerName = "RegisterPlugin";
-
-              registerFunc.ptr = dlsym(dlHandle, registerName);
-
-              if (!registerFunc.ptr)
-              {
-                gzerr << "Failed to resolve " << registerName
-                      << ": " << dlerror();
-                return result;
-              }
+              registerFunc.ptr = library.registerFunc;
 
               // Register the new controller.
               result.reset(registerFunc.func());
-              result->dlHandle = dlHandle;
+              result->dlHandle = library.handle;
 
               result->handleName = _name;
-              result->filename = filename;
+              result->filename = library.filename;
 
               return result;
             }
@@ -287,6 +200,132 @@ namespace gazebo
               this->LoadParam<std::string>(_sdf, _name, _target, _defaultValue);
             }
 
+    /// \brief Read the update rate of the plugin from the <update_rate>
+    /// element of its SDF, if there is one. Called before Load by the
+    /// entity that loads the plugin.
+    /// \param[in] _sdf The SDF element of the plugin.
+    /// \sa SetUpdateRate
+    public: void LoadUpdateRate(const sdf::ElementPtr &_sdf)
+            {
+              if (_sdf && _sdf->HasElement("update_rate"))
+                this->SetUpdateRate(_sdf->Get<double>("update_rate"));
+            }
+
+    /// \brief Set the rate of the callbacks that the plugin connected with
+    /// ConnectWorldUpdateBegin. The callbacks are scheduled on sim time,
+    /// each one with its own offset within the period so that the
+    /// callbacks of different plugins don't all run on the same step.
+    /// \param[in] _rate Rate in Hz of sim time. Zero runs the callbacks on
+    /// every world update.
+    public: void SetUpdateRate(const double _rate)
+            {
+              this->updateRate = std::max(0.0, _rate);
+            }
+
+    /// \brief Get the rate of the scheduled callbacks.
+    /// \return Rate in Hz of sim time, zero when they run on every world
+    /// update.
+    public: double UpdateRate() const
+            {
+              return this->updateRate;
+            }
+
+    /// \brief Get the wall time spent in the callbacks that the plugin
+    /// connected with ConnectWorldUpdateBegin.
+    /// \return Total wall time of the callbacks.
+    public: common::Time UpdateCost() const
+            {
+              return common::Time(
+                  std::chrono::duration<double>(this->updateCost).count());
+            }
+
+    /// \brief Get the number of times the callbacks that the plugin
+    /// connected with ConnectWorldUpdateBegin have run.
+    /// \return Number of callback runs.
+    public: uint64_t UpdateCount() const
+            {
+              return this->updateCount;
+            }
+
+    /// \brief Connect a callback to the world update begin event, running
+    /// it at the update rate of the plugin and recording its cost. Plugins
+    /// should use it instead of event::Events::ConnectWorldUpdateBegin to
+    /// honour the <update_rate> of their SDF.
+    /// \param[in] _subscriber Callback function.
+    /// \return Connection, the callback stops when it is destroyed.
+    /// \sa SetUpdateRate
+    protected: event::ConnectionPtr ConnectWorldUpdateBegin(
+                   const std::function<void (const common::UpdateInfo &)>
+                   &_subscriber)
+            {
+              // Offsets follow the golden ratio sequence, which stays evenly
+              // spread over the period whatever the number of callbacks.
+              static std::atomic<unsigned int> scheduled(0);
+              auto schedule = std::make_shared<UpdateSchedule>();
+              schedule->offset = std::fmod(scheduled++ * 0.6180339887, 1.0);
+
+              return event::Events::ConnectWorldUpdateBegin(
+                  [this, schedule, _subscriber](
+                      const common::UpdateInfo &_info)
+                  {
+                    if (!this->UpdateDue(*schedule, _info.simTime.Double()))
+                      return;
+
+                    auto start = std::chrono::steady_clock::now();
+                    _subscriber(_info);
+                    this->updateCost += std::chrono::steady_clock::now() -
+                        start;
+                    ++this->updateCount;
+                  });
+            }
+
+    /// \brief Schedule of one callback connected with
+    /// ConnectWorldUpdateBegin.
+    private: class UpdateSchedule
+             {
+               /// \brief Rate used to compute the next update, in Hz.
+               public: double rate = 0;
+
+               /// \brief Offset of the callback, as a fraction of the period.
+               public: double offset = 0;
+
+               /// \brief Sim time of the next update in seconds, negative
+               /// when it has to be computed.
+               public: double next = -1;
+             };
+
+    /// \brief Check whether a scheduled callback runs on this world update,
+    /// and advance its schedule if it does.
+    /// \param[in,out] _schedule Schedule of the callback.
+    /// \param[in] _simTime Current sim time in seconds.
+    /// \return True if the callback runs.
+    private: bool UpdateDue(UpdateSchedule &_schedule,
+                            const double _simTime) const
+             {
+               if (this->updateRate <= 0)
+                 return true;
+
+               const double period = 1.0 / this->updateRate;
+
+               // Start the schedule on the first update, when the rate changes
+               // and when sim time goes back (world reset).
+               if (_schedule.next < 0 || _schedule.rate != this->updateRate ||
+                   _simTime < _schedule.next - period)
+               {
+                 _schedule.rate = this->updateRate;
+                 _schedule.next = _simTime + _schedule.offset * period;
+               }
+
+               // Tolerate the rounding of sim time
+               if (_simTime + 1e-9 < _schedule.next)
+                 return false;
+
+               // Skip the updates that were missed, keeping the offset
+               _schedule.next += period *
+                   (std::floor((_simTime - _schedule.next) / period) + 1);
+               return true;
+             }
+
     /// \brief Type of plugin
     protected: PluginType type;
 
@@ -305,6 +344,16 @@ namespace gazebo
 
     /// \brief Handle used for closing the dynamic library.
     private: void *dlHandle;
+
+    /// \brief Rate of the scheduled callbacks in Hz, zero for every
+    /// world update.
+    private: double updateRate = 0;
+
+    /// \brief Wall time spent in the scheduled callbacks.
+    private: std::chrono::steady_clock::duration updateCost{0};
+
+    /// \brief Number of runs of the scheduled callbacks.
+    private: uint64_t updateCount = 0;
   };
 
   /// \class WorldPlugin Plugin.hh common/common.hh
@@ -0,0 +1,331 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <dlfcn.h>
+
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <list>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+#include <boost/filesystem.hpp>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/common/SystemPaths.hh"
+#include "gazebo/common/ThreadConfig.hh"
+#include "gazebo/common/PluginLibraryCache.hh"
+
+using namespace gazebo;
+using namespace common;
+
+namespace gazebo
+{
+  namespace common
+  {
+    /// \internal
+    /// \brief Result of loading a plugin library.
+    class PluginLibraryResult
+    {
+      /// \brief The library, valid if the error is empty.
+      public: PluginLibrary library;
+
+      /// \brief Errors of the attempts to load the library.
+      public: std::string error;
+    };
+
+    /// \internal
+    /// \brief Private data for PluginLibraryCache.
+    class PluginLibraryCachePrivate
+    {
+      /// \brief Cache key of a library.
+      /// \param[in] _filename Requested file name.
+      /// \param[in] _paths Plugin paths.
+      /// \return The key.
+      public: static std::string Key(const std::string &_filename,
+                  const std::list<std::string> &_paths);
+
+      /// \brief Find, open and resolve a library.
+      /// \param[in] _filename Requested file name.
+      /// \param[in] _paths Plugin paths.
+      /// \return The library or the errors.
+      public: static PluginLibraryResult Open(const std::string &_filename,
+                  const std::list<std::string> &_paths);
+
+      /// \brief Libraries loaded or being loaded, by key.
+      public: std::map<std::string,
+              std::shared_future<PluginLibraryResult>> libraries;
+
+      /// \brief Threads preloading libraries.
+      public: std::vector<std::thread> threads;
+
+      /// \brief Protects libraries and threads.
+      public: mutable std::mutex mutex;
+    };
+  }
+}
+
+/////////////////////////////////////////////////
+std::string PluginLibraryCachePrivate::Key(const std::string &_filename,
+    const std::list<std::string> &_paths)
+{
+  std::string key(_filename);
+  for (const auto &path : _paths)
+    key += "\n" + path;
+  return key;
+}
+
+/////////////////////////////////////////////////
+/// \brief Find a plugin file in the plugin paths and dlopen it.
+/// \param[in] _filename File name of the library.
+/// \param[in] _paths Plugin paths.
+/// \param[out] _error Stream receiving the error if the file can't be
+/// opened.
+/// \return The dlopen handle, or null on error.
+static void *findAndDlopenPluginFile(const std::string &_filename,
+    const std::list<std::string> &_paths, std::ostringstream &_error)
+{
+  struct stat st;
+  bool found = false;
+  std::string fullname;
+
+  for (const auto &path : _paths)
+  {
+    fullname = path + std::string("/") + _filename;
+    fullname = boost::filesystem::path(fullname).make_preferred().string();
+    if (stat(fullname.c_str(), &st) == 0)
+    {
+      found = true;
+      break;
+    }
+  }
+
+  if (!found)
+    fullname = _filename;
+
+  void *dlHandle = dlopen(fullname.c_str(), RTLD_LAZY|RTLD_GLOBAL);
+  if (!dlHandle)
+  {
+    _error << "Failed to load plugin " << fullname << ": "
+      << dlerror() << "\n";
+  }
+  return dlHandle;
+}
+
+/////////////////////////////////////////////////
+PluginLibraryResult PluginLibraryCachePrivate::Open(
+    const std::string &_filename, const std::list<std::string> &_paths)
+{
+  PluginLibraryResult result;
+  std::string filename(_filename);
+  std::ostringstream errorStream;
+
+  // This logic is to support different extensions on each OS
+  // see issue #800
+  //
+  // Linux: lib*.so
+  // macOS: lib*.so, lib*.dylib
+  // Windows: *.dll
+  //
+  // Assuming that most plugin names are specified as lib*.so,
+  // replace prefix and suffix depending on the OS.
+  // On macOS, first try the lib*.so name, then try lib*.dylib
+#ifdef _WIN32
+  {
+    // replace .so with .dll
+    size_t soSuffix = filename.rfind(".so");
+    if (soSuffix != std::string::npos)
+    {
+      const std::string winSuffix(".dll");
+      filename.replace(soSuffix, winSuffix.length(), winSuffix);
+    }
+    size_t libPrefix = filename.find("lib");
+    if (libPrefix == 0)
+    {
+      // remove the lib prefix
+      filename.erase(0, 3);
+    }
+  }
+#endif  // ifdef _WIN32
+
+  // Try to find and dlopen plugin with the following pattern:
+  // Linux: lib*.so
+  // macOS: lib*.so
+  // Windows: *.dll
+  void *dlHandle = findAndDlopenPluginFile(filename, _paths, errorStream);
+#ifdef __APPLE__
+  if (!dlHandle)
+  {
+    // lib*.so file could not be found or opened, try lib*.dylib
+    size_t soSuffix = filename.rfind(".so");
+    if (soSuffix != std::string::npos)
+    {
+      const std::string macSuffix(".dylib");
+      filename.replace(soSuffix, macSuffix.length(), macSuffix);
+    }
+    // macOS: lib*.dylib
+    dlHandle = findAndDlopenPluginFile(filename, _paths, errorStream);
+  }
+#endif  // ifdef __APPLE__
+
+  if (!dlHandle)
+  {
+    result.error = errorStream.str();
+    return result;
+  }
+
+  const char *registerName = "RegisterPlugin";
+  void *registerFunc = dlsym(dlHandle, registerName);
+  if (!registerFunc)
+  {
+    result.error = std::string("Failed to resolve ") + registerName + ": " +
+      dlerror() + "\n";
+    return result;
+  }
+
+  result.library.handle = dlHandle;
+  result.library.registerFunc = registerFunc;
+  result.library.filename = filename;
+  return result;
+}
+
+/////////////////////////////////////////////////
+PluginLibraryCache::PluginLibraryCache()
+  : dataPtr(new PluginLibraryCachePrivate)
+{
+}
+
+/////////////////////////////////////////////////
+PluginLibraryCache::~PluginLibraryCache()
+{
+  for (auto &thread : this->dataPtr->threads)
+    thread.join();
+}
+
+/////////////////////////////////////////////////
+bool PluginLibraryCache::Load(const std::string &_filename,
+    PluginLibrary &_library)
+{
+  const std::list<std::string> paths =
+    SystemPaths::Instance()->GetPluginPaths();
+  const std::string key = PluginLibraryCachePrivate::Key(_filename, paths);
+
+  std::shared_future<PluginLibraryResult> future;
+  bool opener = false;
+  std::promise<PluginLibraryResult> promise;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    auto iter = this->dataPtr->libraries.find(key);
+    if (iter != this->dataPtr->libraries.end())
+    {
+      future = iter->second;
+    }
+    else
+    {
+      future = promise.get_future().share();
+      this->dataPtr->libraries[key] = future;
+      opener = true;
+    }
+  }
+
+  // Open the library outside of the lock, so that other libraries can be
+  // found in the cache meanwhile.
+  if (opener)
+    promise.set_value(PluginLibraryCachePrivate::Open(_filename, paths));
+
+  const PluginLibraryResult &result = future.get();
+  if (!result.error.empty())
+  {
+    gzerr << result.error;
+
+    // Forget the failure so that the library is tried again next time.
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    auto iter = this->dataPtr->libraries.find(key);
+    if (iter != this->dataPtr->libraries.end() &&
+        iter->second.wait_for(std::chrono::seconds(0)) ==
+        std::future_status::ready && !iter->second.get().error.empty())
+    {
+      this->dataPtr->libraries.erase(iter);
+    }
+    return false;
+  }
+
+  _library = result.library;
+  return true;
+}
+
+/////////////////////////////////////////////////
+void PluginLibraryCache::Preload(const std::vector<std::string> &_filenames)
+{
+  const std::list<std::string> paths =
+    SystemPaths::Instance()->GetPluginPaths();
+
+  // Libraries, with their promises, that are not in the cache yet.
+  auto pending = std::make_shared<std::vector<
+    std::pair<std::string, std::promise<PluginLibraryResult>>>>();
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  for (const auto &filename : _filenames)
+  {
+    const std::string key = PluginLibraryCachePrivate::Key(filename, paths);
+    if (this->dataPtr->libraries.count(key))
+      continue;
+
+    pending->emplace_back(filename, std::promise<PluginLibraryResult>());
+    this->dataPtr->libraries[key] =
+      pending->back().second.get_future().share();
+  }
+
+  if (pending->empty())
+    return;
+
+  // Wait for the threads of earlier calls, which don't take the lock.
+  for (auto &thread : this->dataPtr->threads)
+    thread.join();
+  this->dataPtr->threads.clear();
+
+  // The loader serializes the dlopen calls themselves, but searching the
+  // plugin paths and reading the libraries from disk overlap.
+  const size_t threadCount = std::min<size_t>(pending->size(),
+      std::max(1u, std::thread::hardware_concurrency()));
+  auto next = std::make_shared<std::atomic<size_t>>(0);
+  for (size_t i = 0; i < threadCount; ++i)
+  {
+    this->dataPtr->threads.emplace_back([pending, next, paths]()
+    {
+      ThreadConfig::Instance()->Apply("world_plugins");
+      for (size_t index = (*next)++; index < pending->size();
+           index = (*next)++)
+      {
+        auto &library = (*pending)[index];
+        library.second.set_value(
+            PluginLibraryCachePrivate::Open(library.first, paths));
+      }
+    });
+  }
+}
+
+/////////////////////////////////////////////////
+size_t PluginLibraryCache::Size() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->libraries.size();
+}
@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_COMMON_PLUGINLIBRARYCACHE_HH_
+#define GAZEBO_COMMON_PLUGINLIBRARYCACHE_HH_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gazebo/common/SingletonT.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace common
+  {
+    // Forward declare private data class.
+    class PluginLibraryCachePrivate;
+  }
+}
+
+GZ_SINGLETON_DECLARE(GZ_COMMON_VISIBLE, gazebo, common, PluginLibraryCache)
+
+namespace gazebo
+{
+  namespace common
+  {
+    /// \addtogroup gazebo_common Common
+    /// \{
+
+    /// \brief A plugin shared library opened by PluginLibraryCache.
+    class GZ_COMMON_VISIBLE PluginLibrary
+    {
+      /// \brief Handle returned by dlopen.
+      public: void *handle = nullptr;
+
+      /// \brief Address of the RegisterPlugin function of the library.
+      public: void *registerFunc = nullptr;
+
+      /// \brief File name of the library, with the extension of the
+      /// platform.
+      public: std::string filename;
+    };
+
+    /// \class PluginLibraryCache PluginLibraryCache.hh common/common.hh
+    /// \brief Process wide cache of the plugin libraries opened by
+    /// PluginT::Create, so that a library used by many plugins is found in
+    /// the plugin paths and resolved only once.
+    ///
+    /// Libraries are keyed by the requested file name and the plugin paths
+    /// at the time of the request. Libraries that fail to load are not
+    /// cached, so that they are tried again.
+    class GZ_COMMON_VISIBLE PluginLibraryCache
+      : public SingletonT<PluginLibraryCache>
+    {
+      /// \brief Constructor.
+      private: PluginLibraryCache();
+
+      /// \brief Destructor, waits for the libraries being preloaded.
+      private: virtual ~PluginLibraryCache();
+
+      /// \brief Find a plugin library in the plugin paths, open it and
+      /// resolve its RegisterPlugin function, or get the library from the
+      /// cache. Waits if the library is being preloaded.
+      /// \param[in] _filename File name of the library, e.g. libFoo.so. The
+      /// prefix and extension are replaced as needed by the platform.
+      /// \param[out] _library The library.
+      /// \return True if the library was loaded, false with an error printed
+      /// otherwise.
+      public: bool Load(const std::string &_filename,
+                        PluginLibrary &_library);
+
+      /// \brief Start loading plugin libraries in background threads, so
+      /// that later calls to Load for them find them in the cache. Returns
+      /// without waiting. Errors are reported by the later calls to Load.
+      /// \param[in] _filenames File names of the libraries.
+      public: void Preload(const std::vector<std::string> &_filenames);
+
+      /// \brief Get the number of libraries in the cache, including those
+      /// being preloaded.
+      /// \return Number of libraries.
+      public: size_t Size() const;
+
+      /// \brief Allow the singleton to construct the cache.
+      private: friend class SingletonT<PluginLibraryCache>;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<PluginLibraryCachePrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
@@ -15,6 +15,9 @@
  *
 */
 
+#include <cmath>
+#include <vector>
+
 #include "gazebo/common/Plugin.hh"
 #include "test/util.hh"
 #include "test_config.h"
@@ -102,6 +105,116 @@ TEST_F(PluginTest, LoadVisualPlugin)
   EXPECT_EQ(plugin->GetHandle(), "pluginInterfaceTest");
 }
 
+/// \brief World plugin that counts its scheduled updates.
+class ScheduledPlugin : public WorldPlugin
+{
+  public: virtual void Load(physics::WorldPtr, sdf::ElementPtr) {}
+
+  /// \brief Connect a callback that records the steps it runs on.
+  public: void Connect(std::vector<int> &_steps)
+  {
+    this->connections.push_back(this->ConnectWorldUpdateBegin(
+        [&_steps](const common::UpdateInfo &_info)
+        {
+          _steps.push_back(static_cast<int>(
+              std::round(_info.simTime.Double() * 1000)));
+        }));
+  }
+
+  /// \brief Connections of the plugin.
+  public: std::vector<event::ConnectionPtr> connections;
+};
+
+/// \brief Signal the world update begin event at 1 kHz.
+/// \param[in] _start First step.
+/// \param[in] _count Number of steps.
+void SignalUpdates(const int _start, const int _count)
+{
+  common::UpdateInfo info;
+  for (int i = _start; i < _start + _count; ++i)
+  {
+    info.simTime = common::Time(i * 0.001);
+    event::Events::worldUpdateBegin(info);
+  }
+}
+
+TEST_F(PluginTest, UpdateRate)
+{
+  ScheduledPlugin plugin;
+  EXPECT_DOUBLE_EQ(0.0, plugin.UpdateRate());
+
+  sdf::ElementPtr sdf(new sdf::Element);
+  sdf->SetName("plugin");
+  sdf::ElementPtr rateElem = sdf->AddElement("update_rate");
+  rateElem->AddValue("double", "100", false);
+  plugin.LoadUpdateRate(sdf);
+  EXPECT_DOUBLE_EQ(100.0, plugin.UpdateRate());
+
+  std::vector<int> steps1, steps2;
+  plugin.Connect(steps1);
+  plugin.Connect(steps2);
+
+  SignalUpdates(0, 1000);
+  ASSERT_EQ(100u, steps1.size());
+  ASSERT_EQ(100u, steps2.size());
+  EXPECT_EQ(200u, plugin.UpdateCount());
+  EXPECT_LE(common::Time::Zero, plugin.UpdateCost());
+
+  // Updates keep the period, and the callbacks are staggered
+  for (size_t i = 1; i < steps1.size(); ++i)
+  {
+    EXPECT_EQ(10, steps1[i] - steps1[i-1]);
+    EXPECT_EQ(10, steps2[i] - steps2[i-1]);
+  }
+  EXPECT_NE(steps1[0] % 10, steps2[0] % 10);
+
+  // The schedule starts again after a reset of sim time
+  steps1.clear();
+  SignalUpdates(0, 100);
+  EXPECT_EQ(10u, steps1.size());
+
+  // Zero runs on every update
+  plugin.SetUpdateRate(0);
+  steps1.clear();
+  SignalUpdates(100, 50);
+  EXPECT_EQ(50u, steps1.size());
+}
+
+/////////////////////////////////////////////////
+TEST_F(PluginTest, LibraryCache)
+{
+  auto cache = common::PluginLibraryCache::Instance();
+
+  // Preload returns at once, Load waits for the library
+  cache->Preload({"libArrangePlugin.so", "libArrangePlugin.so"});
+  common::PluginLibrary first;
+  ASSERT_TRUE(cache->Load("libArrangePlugin.so", first));
+  EXPECT_NE(nullptr, first.handle);
+  EXPECT_NE(nullptr, first.registerFunc);
+  EXPECT_EQ(expectedFilename("ArrangePlugin"), first.filename);
+
+  // The second load comes from the cache
+  const size_t size = cache->Size();
+  common::PluginLibrary second;
+  ASSERT_TRUE(cache->Load("libArrangePlugin.so", second));
+  EXPECT_EQ(first.handle, second.handle);
+  EXPECT_EQ(first.registerFunc, second.registerFunc);
+  EXPECT_EQ(size, cache->Size());
+
+  // Plugins of the library share it
+  WorldPluginPtr plugin1 = WorldPlugin::Create("libArrangePlugin.so", "p1");
+  WorldPluginPtr plugin2 = WorldPlugin::Create("libArrangePlugin.so", "p2");
+  ASSERT_TRUE(plugin1 != nullptr);
+  ASSERT_TRUE(plugin2 != nullptr);
+  EXPECT_EQ(plugin1->GetFilename(), plugin2->GetFilename());
+  EXPECT_EQ(size, cache->Size());
+
+  // Failures are not cached
+  common::PluginLibrary missing;
+  EXPECT_FALSE(cache->Load("libNoSuchPlugin.so", missing));
+  EXPECT_EQ(size, cache->Size());
+}
+
 
 // TODO: The following test actually fails due to current unsafe implementation
 // of plugin loading.
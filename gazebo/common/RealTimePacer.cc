@@ -0,0 +1,218 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+#include "gazebo/common/RealTimePacer.hh"
+
+using namespace gazebo;
+using namespace common;
+
+/// \brief Clock of the deadlines. CLOCK_MONOTONIC on Linux.
+using PacerClock = std::chrono::steady_clock;
+
+/// \brief Length of a statistics window.
+static const PacerClock::duration kPacerWindow = std::chrono::seconds(1);
+
+/// \brief Private data for the RealTimePacer class.
+class gazebo::common::RealTimePacerPrivate
+{
+  /// \brief Add a sample to the current window, and complete the window
+  /// if it is over.
+  /// \param[in] _now Current time.
+  /// \param[in] _jitter Delay of the wake up after the deadline.
+  /// \param[in] _overrun Delay of the call after the deadline, 0 if the
+  /// call was on time.
+  public: void AddSample(const PacerClock::time_point _now,
+              const double _jitter, const double _overrun)
+          {
+            auto &current = this->current;
+            current.samples++;
+            current.jitterMean += _jitter;
+            current.jitterMax = std::max(current.jitterMax, _jitter);
+            if (_overrun > 0)
+            {
+              current.overruns++;
+              current.overrunMax = std::max(current.overrunMax, _overrun);
+            }
+
+            if (_now - this->windowStart < kPacerWindow)
+              return;
+
+            current.window =
+              std::chrono::duration<double>(_now - this->windowStart).count();
+            current.jitterMean /= current.samples;
+            {
+              std::lock_guard<std::mutex> lock(this->lastMutex);
+              this->last = current;
+            }
+            current = RealTimePacer::Statistics();
+            this->windowStart = _now;
+          }
+
+  /// \brief Time to spin before a deadline, in nanoseconds.
+  public: std::atomic<int64_t> spinNs{0};
+
+  /// \brief True if the next call to Wait sets the first deadline.
+  public: std::atomic<bool> reset{true};
+
+  /// \brief Current deadline.
+  public: PacerClock::time_point deadline;
+
+  /// \brief Start of the current window.
+  public: PacerClock::time_point windowStart;
+
+  /// \brief Statistics of the current window.
+  public: RealTimePacer::Statistics current;
+
+  /// \brief Statistics of the last completed window.
+  public: RealTimePacer::Statistics last;
+
+  /// \brief Mutex to protect last.
+  public: mutable std::mutex lastMutex;
+};
+
+/// \brief Sleep until a time.
+/// \param[in] _time The time.
+static void SleepUntil(const PacerClock::time_point _time)
+{
+#ifdef __linux__
+  // The steady clock of libstdc++ is CLOCK_MONOTONIC
+  const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      _time.time_since_epoch()).count();
+  struct timespec ts;
+  ts.tv_sec = ns / 1000000000;
+  ts.tv_nsec = ns % 1000000000;
+
+  // Sleep again when interrupted by a signal
+  while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) ==
+      EINTR)
+  {
+  }
+#else
+  std::this_thread::sleep_until(_time);
+#endif
+}
+
+//////////////////////////////////////////////////
+RealTimePacer::RealTimePacer()
+  : dataPtr(new RealTimePacerPrivate)
+{
+}
+
+//////////////////////////////////////////////////
+RealTimePacer::~RealTimePacer()
+{
+}
+
+//////////////////////////////////////////////////
+void RealTimePacer::SetSpinTime(const double _seconds)
+{
+  this->dataPtr->spinNs = static_cast<int64_t>(std::max(0.0, _seconds) * 1e9);
+}
+
+//////////////////////////////////////////////////
+double RealTimePacer::SpinTime() const
+{
+  return this->dataPtr->spinNs * 1e-9;
+}
+
+//////////////////////////////////////////////////
+void RealTimePacer::Reset()
+{
+  this->dataPtr->reset = true;
+}
+
+//////////////////////////////////////////////////
+bool RealTimePacer::Wait(const double _period)
+{
+  const PacerClock::time_point now = PacerClock::now();
+  if (this->dataPtr->reset.exchange(false))
+  {
+    this->dataPtr->deadline = now;
+    this->dataPtr->windowStart = now;
+    this->dataPtr->current = Statistics();
+    std::lock_guard<std::mutex> lock(this->dataPtr->lastMutex);
+    this->dataPtr->last = Statistics();
+    return true;
+  }
+
+  if (_period <= 0)
+  {
+    this->dataPtr->deadline = now;
+    return true;
+  }
+
+  const auto period = std::chrono::duration_cast<PacerClock::duration>(
+      std::chrono::duration<double>(_period));
+  this->dataPtr->deadline += period;
+
+  // Too late, follow the current time rather than stepping in a burst
+  if (now >= this->dataPtr->deadline)
+  {
+    const double overrun =
+      std::chrono::duration<double>(now - this->dataPtr->deadline).count();
+    if (now - this->dataPtr->deadline > period)
+      this->dataPtr->deadline = now;
+    this->dataPtr->AddSample(now, 0, overrun);
+    return false;
+  }
+
+  const PacerClock::time_point deadline = this->dataPtr->deadline;
+  const PacerClock::time_point spinStart =
+    deadline - std::chrono::nanoseconds(this->dataPtr->spinNs.load());
+  if (now < spinStart)
+    SleepUntil(spinStart);
+
+  PacerClock::time_point wake = PacerClock::now();
+  while (wake < deadline)
+    wake = PacerClock::now();
+
+  this->dataPtr->AddSample(wake,
+      std::chrono::duration<double>(wake - deadline).count(), 0);
+  return true;
+}
+
+//////////////////////////////////////////////////
+RealTimePacer::Statistics RealTimePacer::LastWindow() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->lastMutex);
+  return this->dataPtr->last;
+}
+
+//////////////////////////////////////////////////
+bool RealTimePacer::SetRealTimePriority(const int _priority)
+{
+#ifdef __linux__
+  struct sched_param param;
+  param.sched_priority = _priority;
+  return pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) == 0;
+#else
+  (void)_priority;
+  return false;
+#endif
+}
@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_COMMON_REALTIMEPACER_HH_
+#define GAZEBO_COMMON_REALTIMEPACER_HH_
+
+#include <cstdint>
+#include <memory>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace common
+  {
+    // Forward declare private data class
+    class RealTimePacerPrivate;
+
+    /// \addtogroup gazebo_common Common
+    /// \{
+
+    /// \class RealTimePacer RealTimePacer.hh common/common.hh
+    /// \brief Paces a loop to the wall clock with absolute deadlines. Each
+    /// call to Wait sleeps until the previous deadline plus the period, so
+    /// that the error of a wake up isn't carried over to the next ones. On
+    /// Linux the sleep is a clock_nanosleep with TIMER_ABSTIME on
+    /// CLOCK_MONOTONIC. The last part of the wait may be spent spinning,
+    /// which keeps a CPU busy but wakes up within microseconds of the
+    /// deadline.
+    ///
+    /// The delays of the wake ups after their deadline, the jitter, and
+    /// the iterations that ended after the next deadline, the overruns, are
+    /// gathered over windows of one second of wall time.
+    ///
+    /// Wait and Reset are called by the paced thread, the other functions
+    /// may be called from any thread.
+    class GZ_COMMON_VISIBLE RealTimePacer
+    {
+      /// \brief Statistics of the wake ups over a window.
+      public: class Statistics
+      {
+        /// \brief Length of the window in seconds.
+        public: double window = 0;
+
+        /// \brief Number of calls to Wait in the window.
+        public: uint64_t samples = 0;
+
+        /// \brief Mean delay of the wake ups after their deadline, in
+        /// seconds.
+        public: double jitterMean = 0;
+
+        /// \brief Largest delay of a wake up after its deadline, in
+        /// seconds.
+        public: double jitterMax = 0;
+
+        /// \brief Number of calls to Wait after their deadline.
+        public: uint64_t overruns = 0;
+
+        /// \brief Largest delay of a call to Wait after its deadline, in
+        /// seconds.
+        public: double overrunMax = 0;
+      };
+
+      /// \brief Constructor.
+      public: RealTimePacer();
+
+      /// \brief Destructor.
+      public: virtual ~RealTimePacer();
+
+      /// \brief Set how long to spin before each deadline, instead of
+      /// sleeping.
+      /// \param[in] _seconds Spin time in seconds, 0 to only sleep.
+      public: void SetSpinTime(const double _seconds);
+
+      /// \brief Get how long to spin before each deadline.
+      /// \return Spin time in seconds.
+      public: double SpinTime() const;
+
+      /// \brief Start over: the next call to Wait returns at once and sets
+      /// the first deadline, and the statistics are cleared.
+      public: void Reset();
+
+      /// \brief Wait for the deadline that follows the previous one by a
+      /// period. If the deadline passed more than a period ago, the missed
+      /// deadlines are dropped and the next ones follow the current time.
+      /// \param[in] _period Period in seconds, the call returns at once if
+      /// it isn't positive.
+      /// \return False if the deadline had passed.
+      public: bool Wait(const double _period);
+
+      /// \brief Get the statistics of the last completed window.
+      /// \return The statistics, empty before a window completed.
+      public: Statistics LastWindow() const;
+
+      /// \brief Ask the operating system to schedule the calling thread
+      /// with the SCHED_FIFO policy. This usually requires the
+      /// CAP_SYS_NICE capability or an rtprio limit.
+      /// \param[in] _priority Priority, from 1 to 99 on Linux.
+      /// \return False if the policy couldn't be set, or isn't supported.
+      public: static bool SetRealTimePriority(const int _priority);
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<RealTimePacerPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
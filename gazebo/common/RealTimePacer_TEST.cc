@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+#include "gazebo/common/RealTimePacer.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class RealTimePacerTest : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+TEST_F(RealTimePacerTest, Wait)
+{
+  common::RealTimePacer pacer;
+  EXPECT_DOUBLE_EQ(0.0, pacer.SpinTime());
+  pacer.SetSpinTime(0.0002);
+  EXPECT_DOUBLE_EQ(0.0002, pacer.SpinTime());
+  pacer.SetSpinTime(-1);
+  EXPECT_DOUBLE_EQ(0.0, pacer.SpinTime());
+  pacer.SetSpinTime(0.0002);
+
+  // No statistics before a window completed
+  EXPECT_EQ(0u, pacer.LastWindow().samples);
+
+  // The first call sets the first deadline
+  const auto start = std::chrono::steady_clock::now();
+  EXPECT_TRUE(pacer.Wait(0.002));
+
+  // The deadlines are absolute, the loop takes its periods in total
+  for (int i = 0; i < 600; ++i)
+    pacer.Wait(0.002);
+  const double elapsed = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start).count();
+  EXPECT_GE(elapsed, 1.2);
+
+  const common::RealTimePacer::Statistics stats = pacer.LastWindow();
+  EXPECT_GE(stats.window, 1.0);
+  EXPECT_GT(stats.samples, 0u);
+  EXPECT_GE(stats.jitterMean, 0.0);
+  EXPECT_GE(stats.jitterMax, stats.jitterMean);
+}
+
+/////////////////////////////////////////////////
+TEST_F(RealTimePacerTest, Overrun)
+{
+  common::RealTimePacer pacer;
+  EXPECT_TRUE(pacer.Wait(0.001));
+  EXPECT_TRUE(pacer.Wait(0.001));
+
+  // A loop iteration longer than the period misses the deadline
+  std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  EXPECT_FALSE(pacer.Wait(0.001));
+
+  // Complete the window
+  const auto start = std::chrono::steady_clock::now();
+  while (std::chrono::steady_clock::now() - start <
+      std::chrono::milliseconds(1100))
+  {
+    pacer.Wait(0.001);
+  }
+  const common::RealTimePacer::Statistics stats = pacer.LastWindow();
+  EXPECT_GE(stats.overruns, 1u);
+  EXPECT_GE(stats.overrunMax, 0.003);
+
+  // A period of zero doesn't wait
+  EXPECT_TRUE(pacer.Wait(0));
+
+  // Reset clears the statistics
+  pacer.Reset();
+  EXPECT_TRUE(pacer.Wait(0.001));
+  EXPECT_EQ(0u, pacer.LastWindow().samples);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,229 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_COMMON_SIMTIMENS_HH_
+#define GAZEBO_COMMON_SIMTIMENS_HH_
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+#include "gazebo/common/Time.hh"
+
+namespace gazebo
+{
+  namespace common
+  {
+    /// \addtogroup gazebo_common
+    /// \{
+
+    /// \class SimTimeNs SimTimeNs.hh common/common.hh
+    /// \brief Simulation time as a signed number of nanoseconds, for the
+    /// hot paths that schedule the world, the sensors and the time events.
+    /// The arithmetic is exact integer arithmetic, without the
+    /// normalization of common::Time or the rounding of double seconds, so
+    /// that a sum of steps compares exactly with an update period. Periods
+    /// given in seconds are rounded to the nearest nanosecond once, when
+    /// they are converted.
+    class SimTimeNs
+    {
+      /// \brief Number of nanoseconds in a second.
+      public: static constexpr int64_t kNsInSec = 1000000000;
+
+      /// \brief Constructor, a zero time.
+      public: constexpr SimTimeNs() = default;
+
+      /// \brief Constructor.
+      /// \param[in] _nsec Time in nanoseconds.
+      public: explicit constexpr SimTimeNs(const int64_t _nsec)
+              : nsec(_nsec)
+              {
+              }
+
+      /// \brief Constructor, exact.
+      /// \param[in] _time The time.
+      public: explicit SimTimeNs(const Time &_time)
+              : nsec(static_cast<int64_t>(_time.sec) * kNsInSec + _time.nsec)
+              {
+              }
+
+      /// \brief Get a time given in seconds.
+      /// \param[in] _sec Time in seconds.
+      /// \return The time, rounded to the nearest nanosecond.
+      public: static SimTimeNs FromSeconds(const double _sec)
+              {
+                return SimTimeNs(std::llround(_sec * kNsInSec));
+              }
+
+      /// \brief Get the largest time, e.g. for an event that never occurs.
+      /// \return The largest time.
+      public: static constexpr SimTimeNs Max()
+              {
+                return SimTimeNs(std::numeric_limits<int64_t>::max());
+              }
+
+      /// \brief Get the time in nanoseconds.
+      /// \return The time in nanoseconds.
+      public: constexpr int64_t Nanoseconds() const
+              {
+                return this->nsec;
+              }
+
+      /// \brief Get the time in seconds.
+      /// \return The time in seconds.
+      public: constexpr double Double() const
+              {
+                return static_cast<double>(this->nsec) * 1e-9;
+              }
+
+      /// \brief Get the time as a common::Time.
+      /// \return The time.
+      public: Time ToTime() const
+              {
+                // Round toward minus infinity so that nsec is positive
+                int64_t sec = this->nsec / kNsInSec;
+                int64_t rest = this->nsec % kNsInSec;
+                if (rest < 0)
+                {
+                  --sec;
+                  rest += kNsInSec;
+                }
+                return Time(static_cast<int32_t>(sec),
+                    static_cast<int32_t>(rest));
+              }
+
+      /// \brief Get the remainder of the division by a period, e.g. the
+      /// time elapsed since the last multiple of an update period.
+      /// \param[in] _period The period, positive.
+      /// \return The remainder, in [0, _period).
+      public: constexpr SimTimeNs Mod(const SimTimeNs &_period) const
+              {
+                return SimTimeNs(((this->nsec % _period.nsec) +
+                      _period.nsec) % _period.nsec);
+              }
+
+      /// \brief Addition operator.
+      /// \param[in] _other Time to add.
+      /// \return The sum.
+      public: constexpr SimTimeNs operator+(const SimTimeNs &_other) const
+              {
+                return SimTimeNs(this->nsec + _other.nsec);
+              }
+
+      /// \brief Subtraction operator.
+      /// \param[in] _other Time to subtract.
+      /// \return The difference.
+      public: constexpr SimTimeNs operator-(const SimTimeNs &_other) const
+              {
+                return SimTimeNs(this->nsec - _other.nsec);
+              }
+
+      /// \brief Negation operator.
+      /// \return The negated time.
+      public: constexpr SimTimeNs operator-() const
+              {
+                return SimTimeNs(-this->nsec);
+              }
+
+      /// \brief Multiplication operator.
+      /// \param[in] _factor Integer factor.
+      /// \return The product.
+      public: constexpr SimTimeNs operator*(const int64_t _factor) const
+              {
+                return SimTimeNs(this->nsec * _factor);
+              }
+
+      /// \brief Division operator, rounding toward zero.
+      /// \param[in] _divisor Integer divisor.
+      /// \return The quotient.
+      public: constexpr SimTimeNs operator/(const int64_t _divisor) const
+              {
+                return SimTimeNs(this->nsec / _divisor);
+              }
+
+      /// \brief Addition assignment operator.
+      /// \param[in] _other Time to add.
+      /// \return This time.
+      public: SimTimeNs &operator+=(const SimTimeNs &_other)
+              {
+                this->nsec += _other.nsec;
+                return *this;
+              }
+
+      /// \brief Subtraction assignment operator.
+      /// \param[in] _other Time to subtract.
+      /// \return This time.
+      public: SimTimeNs &operator-=(const SimTimeNs &_other)
+              {
+                this->nsec -= _other.nsec;
+                return *this;
+              }
+
+      /// \brief Equality operator.
+      /// \param[in] _other Time to compare with.
+      /// \return True if the times are equal.
+      public: constexpr bool operator==(const SimTimeNs &_other) const
+              {
+                return this->nsec == _other.nsec;
+              }
+
+      /// \brief Inequality operator.
+      /// \param[in] _other Time to compare with.
+      /// \return True if the times differ.
+      public: constexpr bool operator!=(const SimTimeNs &_other) const
+              {
+                return this->nsec != _other.nsec;
+              }
+
+      /// \brief Less than operator.
+      /// \param[in] _other Time to compare with.
+      /// \return True if this time is earlier.
+      public: constexpr bool operator<(const SimTimeNs &_other) const
+              {
+                return this->nsec < _other.nsec;
+              }
+
+      /// \brief Less than or equal operator.
+      /// \param[in] _other Time to compare with.
+      /// \return True if this time is not later.
+      public: constexpr bool operator<=(const SimTimeNs &_other) const
+              {
+                return this->nsec <= _other.nsec;
+              }
+
+      /// \brief Greater than operator.
+      /// \param[in] _other Time to compare with.
+      /// \return True if this time is later.
+      public: constexpr bool operator>(const SimTimeNs &_other) const
+              {
+                return this->nsec > _other.nsec;
+              }
+
+      /// \brief Greater than or equal operator.
+      /// \param[in] _other Time to compare with.
+      /// \return True if this time is not earlier.
+      public: constexpr bool operator>=(const SimTimeNs &_other) const
+              {
+                return this->nsec >= _other.nsec;
+              }
+
+      /// \brief Time in nanoseconds.
+      private: int64_t nsec = 0;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "gazebo/common/SimTimeNs.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class SimTimeNsTest : public gazebo::testing::AutoLogFixture { };
+
+// The arithmetic is usable in constant expressions
+static_assert((common::SimTimeNs(3) + common::SimTimeNs(4)) * 2 ==
+    common::SimTimeNs(14), "constexpr arithmetic");
+static_assert(common::SimTimeNs(7).Mod(common::SimTimeNs(3)) ==
+    common::SimTimeNs(1), "constexpr modulo");
+
+/////////////////////////////////////////////////
+TEST_F(SimTimeNsTest, Conversions)
+{
+  EXPECT_EQ(0, common::SimTimeNs().Nanoseconds());
+  EXPECT_EQ(1500000000, common::SimTimeNs(common::Time(1, 500000000))
+      .Nanoseconds());
+  EXPECT_EQ(-500000000, common::SimTimeNs(common::Time(-1, 500000000))
+      .Nanoseconds());
+
+  // Periods in seconds round to the nearest nanosecond
+  EXPECT_EQ(33333333, common::SimTimeNs::FromSeconds(1.0 / 30.0)
+      .Nanoseconds());
+  EXPECT_EQ(1000000, common::SimTimeNs::FromSeconds(0.001).Nanoseconds());
+  EXPECT_DOUBLE_EQ(2.25, common::SimTimeNs(2250000000).Double());
+
+  EXPECT_EQ(common::Time(2, 5), common::SimTimeNs(2000000005).ToTime());
+  EXPECT_EQ(common::Time(-1, 999999999), common::SimTimeNs(-1).ToTime());
+  EXPECT_EQ(common::Time(-3, 0), common::SimTimeNs(-3000000000).ToTime());
+
+  // Times beyond the range of a 32 bit nanosecond count
+  const common::Time big(100000, 123456789);
+  EXPECT_EQ(big, common::SimTimeNs(big).ToTime());
+}
+
+/////////////////////////////////////////////////
+TEST_F(SimTimeNsTest, Arithmetic)
+{
+  common::SimTimeNs t(1000);
+  t += common::SimTimeNs(500);
+  EXPECT_EQ(common::SimTimeNs(1500), t);
+  t -= common::SimTimeNs(2000);
+  EXPECT_EQ(common::SimTimeNs(-500), t);
+  EXPECT_EQ(common::SimTimeNs(500), -t);
+  EXPECT_EQ(common::SimTimeNs(-250), t / 2);
+
+  EXPECT_EQ(common::SimTimeNs(2), common::SimTimeNs(-1).Mod(
+        common::SimTimeNs(3)));
+  EXPECT_EQ(common::SimTimeNs(0), common::SimTimeNs(9).Mod(
+        common::SimTimeNs(3)));
+
+  EXPECT_LT(common::SimTimeNs(1), common::SimTimeNs(2));
+  EXPECT_LE(common::SimTimeNs(2), common::SimTimeNs(2));
+  EXPECT_GT(common::SimTimeNs::Max(), common::SimTimeNs(1));
+  EXPECT_NE(common::SimTimeNs(1), common::SimTimeNs(2));
+}
+
+/////////////////////////////////////////////////
+TEST_F(SimTimeNsTest, StepsMatchPeriod)
+{
+  // A thousand steps of a millisecond are exactly a second, which a sum
+  // of double steps is not
+  const common::SimTimeNs step = common::SimTimeNs::FromSeconds(0.001);
+  common::SimTimeNs sum;
+  double sumDouble = 0.0;
+  for (int i = 0; i < 1000; ++i)
+  {
+    sum += step;
+    sumDouble += 0.001;
+  }
+  EXPECT_EQ(common::SimTimeNs(common::Time::Second), sum);
+  EXPECT_NE(1.0, sumDouble);
+
+  // A 30 Hz sensor is due on the 34th step after its last update
+  const common::SimTimeNs period = common::SimTimeNs::FromSeconds(1 / 30.0);
+  EXPECT_LT(step * 33, period);
+  EXPECT_GE(step * 34, period);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
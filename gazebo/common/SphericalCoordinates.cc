@@ -14,7 +14,9 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
 #include <string>
+#include <vector>
 #include <math.h>
 
 #include "gazebo/common/Console.hh"
@@ -160,6 +162,14 @@ void SphericalCoordinates::SetSurfaceType(const SurfaceType &_type)
       gzerr << "Unknown surface type[" << this->dataPtr->surfaceType << "]\n";
       break;
   }
+
+  // Cache the ellipse terms of the position transforms
+  this->dataPtr->ellE2 = this->dataPtr->ellE * this->dataPtr->ellE;
+  this->dataPtr->ellB2OverA2 = (this->dataPtr->ellB * this->dataPtr->ellB) /
+    (this->dataPtr->ellA * this->dataPtr->ellA);
+  this->dataPtr->ellP2B =
+    this->dataPtr->ellP * this->dataPtr->ellP * this->dataPtr->ellB;
+  this->dataPtr->ellE2A = this->dataPtr->ellE2 * this->dataPtr->ellA;
 }
 
 //////////////////////////////////////////////////
@@ -289,117 +299,247 @@ void SphericalCoordinates::UpdateTransformationMatrix()
 }
 
 /////////////////////////////////////////////////
-ignition::math::Vector3d SphericalCoordinates::PositionTransform(
-    const ignition::math::Vector3d &_pos,
-    const CoordinateType &_in, const CoordinateType &_out) const
+/// \brief Check a coordinate type.
+/// \param[in] _type The coordinate type.
+/// \param[in] _velocity True if the type is of a velocity, which can not be
+/// spherical.
+/// \return True if the type is valid.
+static bool ValidType(const SphericalCoordinates::CoordinateType _type,
+    const bool _velocity)
 {
-  ignition::math::Vector3d tmp = _pos;
-
-  // Cache trig results
-  double cosLat = cos(_pos.X());
-  double sinLat = sin(_pos.X());
-  double cosLon = cos(_pos.Y());
-  double sinLon = sin(_pos.Y());
-
-  // Radius of planet curvature (meters)
-  double curvature = 1.0 -
-    this->dataPtr->ellE * this->dataPtr->ellE * sinLat * sinLat;
-  curvature = this->dataPtr->ellA / sqrt(curvature);
+  switch (_type)
+  {
+    case SphericalCoordinates::SPHERICAL:
+      return !_velocity;
+    case SphericalCoordinates::ECEF:
+    case SphericalCoordinates::GLOBAL:
+    case SphericalCoordinates::LOCAL:
+      return true;
+    default:
+      return false;
+  }
+}
 
-  // Convert whatever arrives to a more flexible ECEF coordinate
+/////////////////////////////////////////////////
+/// \brief Convert a position to the ECEF frame.
+/// \param[in] _sc Private data of the spherical coordinates.
+/// \param[in] _pos Position vector in frame defined by parameter _in.
+/// \param[in] _in Valid CoordinateType for input.
+/// \return The ECEF position.
+static inline ignition::math::Vector3d PositionToECEF(
+    const SphericalCoordinatesPrivate &_sc,
+    const ignition::math::Vector3d &_pos,
+    const SphericalCoordinates::CoordinateType _in)
+{
   switch (_in)
   {
-    // East, North, Up (ENU), note no break at end of case
-    case LOCAL:
-      {
-        tmp.X(-_pos.X() * this->dataPtr->cosHea + _pos.Y() *
-            this->dataPtr->sinHea);
-        tmp.Y(-_pos.X() * this->dataPtr->sinHea - _pos.Y() *
-            this->dataPtr->cosHea);
-      }
-      [[fallthrough]];
+    // East, North, Up (ENU)
+    case SphericalCoordinates::LOCAL:
+      return _sc.origin + _sc.rotGlobalToECEF * ignition::math::Vector3d(
+          -_pos.X() * _sc.cosHea + _pos.Y() * _sc.sinHea,
+          -_pos.X() * _sc.sinHea - _pos.Y() * _sc.cosHea,
+          _pos.Z());
 
-    case GLOBAL:
-      {
-        tmp = this->dataPtr->origin + this->dataPtr->rotGlobalToECEF * tmp;
-        break;
-      }
+    case SphericalCoordinates::GLOBAL:
+      return _sc.origin + _sc.rotGlobalToECEF * _pos;
 
-    case SPHERICAL:
+    case SphericalCoordinates::SPHERICAL:
       {
-        tmp.X((_pos.Z() + curvature) * cosLat * cosLon);
-        tmp.Y((_pos.Z() + curvature) * cosLat * sinLon);
-        tmp.Z(((this->dataPtr->ellB * this->dataPtr->ellB)/
-              (this->dataPtr->ellA * this->dataPtr->ellA) *
-              curvature + _pos.Z()) * sinLat);
-        break;
+        const double cosLat = cos(_pos.X());
+        const double sinLat = sin(_pos.X());
+        const double cosLon = cos(_pos.Y());
+        const double sinLon = sin(_pos.Y());
+
+        // Radius of planet curvature (meters)
+        const double curvature =
+          _sc.ellA / sqrt(1.0 - _sc.ellE2 * sinLat * sinLat);
+
+        return ignition::math::Vector3d(
+            (_pos.Z() + curvature) * cosLat * cosLon,
+            (_pos.Z() + curvature) * cosLat * sinLon,
+            (_sc.ellB2OverA2 * curvature + _pos.Z()) * sinLat);
       }
 
     // Do nothing
-    case ECEF:
-      break;
     default:
-      gzerr << "Invalid coordinate type[" << _in << "]\n";
       return _pos;
   }
+}
 
-  // Convert ECEF to the requested output coordinate system
+/////////////////////////////////////////////////
+/// \brief Convert an ECEF position to another frame.
+/// \param[in] _sc Private data of the spherical coordinates.
+/// \param[in] _ecef The ECEF position.
+/// \param[in] _out Valid CoordinateType for output.
+/// \return Position vector in frame defined by parameter _out.
+static inline ignition::math::Vector3d PositionFromECEF(
+    const SphericalCoordinatesPrivate &_sc,
+    const ignition::math::Vector3d &_ecef,
+    const SphericalCoordinates::CoordinateType _out)
+{
   switch (_out)
   {
-    case SPHERICAL:
+    case SphericalCoordinates::SPHERICAL:
       {
-        // Convert from ECEF to SPHERICAL
-        double p = sqrt(tmp.X() * tmp.X() + tmp.Y() * tmp.Y());
-        double theta = atan((tmp.Z() * this->dataPtr->ellA) /
-            (p * this->dataPtr->ellB));
+        // Convert from ECEF to SPHERICAL. The sine and cosine of the
+        // parametric latitude theta, and of the latitude, follow from their
+        // tangents without more trigonometric calls.
+        const double p = sqrt(_ecef.X() * _ecef.X() + _ecef.Y() * _ecef.Y());
+        const double pb = p * _sc.ellB;
+        const double za = _ecef.Z() * _sc.ellA;
+        const double r = sqrt(pb * pb + za * za);
+        const double sinTheta = za / r;
+        const double cosTheta = pb / r;
 
         // Calculate latitude and longitude
-        double lat = atan(
-            (tmp.Z() + std::pow(this->dataPtr->ellP, 2) * this->dataPtr->ellB *
-             std::pow(sin(theta), 3)) /
-            (p - std::pow(this->dataPtr->ellE, 2) *
-             this->dataPtr->ellA * std::pow(cos(theta), 3)));
-
-        double lon = atan2(tmp.Y(), tmp.X());
+        const double tanLat =
+          (_ecef.Z() + _sc.ellP2B * sinTheta * sinTheta * sinTheta) /
+          (p - _sc.ellE2A * cosTheta * cosTheta * cosTheta);
+        const double cos2Lat = 1.0 / (1.0 + tanLat * tanLat);
+        const double sin2Lat = tanLat * tanLat * cos2Lat;
 
         // Recalculate radius of planet curvature at the current latitude.
-        double nCurvature = 1.0 - std::pow(this->dataPtr->ellE, 2) *
-          std::pow(sin(lat), 2);
-        nCurvature = this->dataPtr->ellA / sqrt(nCurvature);
-
-        tmp.X(lat);
-        tmp.Y(lon);
+        const double nCurvature = _sc.ellA / sqrt(1.0 - _sc.ellE2 * sin2Lat);
 
-        // Now calculate Z
-        tmp.Z(p/cos(lat) - nCurvature);
-        break;
+        return ignition::math::Vector3d(atan(tanLat),
+            atan2(_ecef.Y(), _ecef.X()), p / sqrt(cos2Lat) - nCurvature);
       }
 
     // Convert from ECEF TO GLOBAL
-    case GLOBAL:
-      tmp = this->dataPtr->rotECEFToGlobal * (tmp - this->dataPtr->origin);
-      break;
+    case SphericalCoordinates::GLOBAL:
+      return _sc.rotECEFToGlobal * (_ecef - _sc.origin);
 
     // Convert from ECEF TO LOCAL
-    case LOCAL:
-      tmp = this->dataPtr->rotECEFToGlobal * (tmp - this->dataPtr->origin);
-
-      tmp = ignition::math::Vector3d(
-          tmp.X() * this->dataPtr->cosHea - tmp.Y() * this->dataPtr->sinHea,
-          tmp.X() * this->dataPtr->sinHea + tmp.Y() * this->dataPtr->cosHea,
-          tmp.Z());
-      break;
+    case SphericalCoordinates::LOCAL:
+      {
+        const ignition::math::Vector3d global =
+          _sc.rotECEFToGlobal * (_ecef - _sc.origin);
+        return ignition::math::Vector3d(
+            global.X() * _sc.cosHea - global.Y() * _sc.sinHea,
+            global.X() * _sc.sinHea + global.Y() * _sc.cosHea,
+            global.Z());
+      }
 
     // Return ECEF (do nothing)
-    case ECEF:
-      break;
+    default:
+      return _ecef;
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Convert a velocity to the ECEF frame.
+/// \param[in] _sc Private data of the spherical coordinates.
+/// \param[in] _vel Velocity vector in frame defined by parameter _in.
+/// \param[in] _in Valid CoordinateType for input, not SPHERICAL.
+/// \return The ECEF velocity.
+static inline ignition::math::Vector3d VelocityToECEF(
+    const SphericalCoordinatesPrivate &_sc,
+    const ignition::math::Vector3d &_vel,
+    const SphericalCoordinates::CoordinateType _in)
+{
+  switch (_in)
+  {
+    // ENU
+    case SphericalCoordinates::LOCAL:
+      return _sc.rotGlobalToECEF * ignition::math::Vector3d(
+          -_vel.X() * _sc.cosHea + _vel.Y() * _sc.sinHea,
+          -_vel.X() * _sc.sinHea - _vel.Y() * _sc.cosHea,
+          _vel.Z());
+
+    case SphericalCoordinates::GLOBAL:
+      return _sc.rotGlobalToECEF * _vel;
 
+    // Do nothing
     default:
-      gzerr << "Unknown coordinate type[" << _out << "]\n";
-      return _pos;
+      return _vel;
   }
+}
+
+/////////////////////////////////////////////////
+/// \brief Convert an ECEF velocity to another frame.
+/// \param[in] _sc Private data of the spherical coordinates.
+/// \param[in] _ecef The ECEF velocity.
+/// \param[in] _out Valid CoordinateType for output, not SPHERICAL.
+/// \return Velocity vector in frame defined by parameter _out.
+static inline ignition::math::Vector3d VelocityFromECEF(
+    const SphericalCoordinatesPrivate &_sc,
+    const ignition::math::Vector3d &_ecef,
+    const SphericalCoordinates::CoordinateType _out)
+{
+  switch (_out)
+  {
+    // Convert from ECEF to global
+    case SphericalCoordinates::GLOBAL:
+      return _sc.rotECEFToGlobal * _ecef;
 
-  return tmp;
+    // Convert from ECEF to local
+    case SphericalCoordinates::LOCAL:
+      {
+        const ignition::math::Vector3d global = _sc.rotECEFToGlobal * _ecef;
+        return ignition::math::Vector3d(
+            global.X() * _sc.cosHea - global.Y() * _sc.sinHea,
+            global.X() * _sc.sinHea + global.Y() * _sc.cosHea,
+            global.Z());
+      }
+
+    // ECEF, do nothing
+    default:
+      return _ecef;
+  }
+}
+
+/////////////////////////////////////////////////
+ignition::math::Vector3d SphericalCoordinates::PositionTransform(
+    const ignition::math::Vector3d &_pos,
+    const CoordinateType &_in, const CoordinateType &_out) const
+{
+  if (!ValidType(_in, false))
+  {
+    gzerr << "Invalid coordinate type[" << _in << "]\n";
+    return _pos;
+  }
+  if (!ValidType(_out, false))
+  {
+    gzerr << "Unknown coordinate type[" << _out << "]\n";
+    return _pos;
+  }
+
+  return PositionFromECEF(*this->dataPtr,
+      PositionToECEF(*this->dataPtr, _pos, _in), _out);
+}
+
+/////////////////////////////////////////////////
+void SphericalCoordinates::PositionTransform(
+    const std::vector<ignition::math::Vector3d> &_pos,
+    const CoordinateType &_in, const CoordinateType &_out,
+    std::vector<ignition::math::Vector3d> &_result) const
+{
+  _result.resize(_pos.size());
+  if (!ValidType(_in, false) || !ValidType(_out, false))
+  {
+    gzerr << "Invalid coordinate types[" << _in << ", " << _out << "]\n";
+    std::copy(_pos.begin(), _pos.end(), _result.begin());
+    return;
+  }
+
+  for (size_t i = 0; i < _pos.size(); ++i)
+  {
+    _result[i] = PositionFromECEF(*this->dataPtr,
+        PositionToECEF(*this->dataPtr, _pos[i], _in), _out);
+  }
+}
+
+//////////////////////////////////////////////////
+void SphericalCoordinates::SphericalFromLocal(
+    const std::vector<ignition::math::Vector3d> &_xyz,
+    std::vector<ignition::math::Vector3d> &_result) const
+{
+  this->PositionTransform(_xyz, LOCAL, SPHERICAL, _result);
+  for (auto &spherical : _result)
+  {
+    spherical.X(IGN_RTOD(spherical.X()));
+    spherical.Y(IGN_RTOD(spherical.Y()));
+  }
 }
 
 //////////////////////////////////////////////////
@@ -413,58 +553,39 @@ ignition::math::Vector3d SphericalCoordinates::VelocityTransform(
     gzwarn << "Spherical velocities are not supported";
     return _vel;
   }
+  if (!ValidType(_in, true) || !ValidType(_out, true))
+  {
+    gzerr << "Unknown coordinate types[" << _in << ", " << _out << "]\n";
+    return _vel;
+  }
 
-  // Intermediate data type
-  ignition::math::Vector3d tmp = _vel;
+  return VelocityFromECEF(*this->dataPtr,
+      VelocityToECEF(*this->dataPtr, _vel, _in), _out);
+}
 
-  // First, convert to an ECEF vector
-  switch (_in)
+//////////////////////////////////////////////////
+void SphericalCoordinates::VelocityTransform(
+    const std::vector<ignition::math::Vector3d> &_vel,
+    const CoordinateType &_in, const CoordinateType &_out,
+    std::vector<ignition::math::Vector3d> &_result) const
+{
+  _result.resize(_vel.size());
+  if (_in == SPHERICAL || _out == SPHERICAL)
   {
-    // ENU (note no break at end of case)
-    case LOCAL:
-      tmp.X(-_vel.X() * this->dataPtr->cosHea + _vel.Y() *
-            this->dataPtr->sinHea);
-      tmp.Y(-_vel.X() * this->dataPtr->sinHea - _vel.Y() *
-            this->dataPtr->cosHea);
-      [[fallthrough]];
-    // spherical
-    case GLOBAL:
-      tmp = this->dataPtr->rotGlobalToECEF * tmp;
-      break;
-    // Do nothing
-    case ECEF:
-      tmp = _vel;
-      break;
-    default:
-      gzerr << "Unknown coordinate type[" << _in << "]\n";
-      return _vel;
+    gzwarn << "Spherical velocities are not supported";
+    std::copy(_vel.begin(), _vel.end(), _result.begin());
+    return;
   }
-
-  // Then, convert to the request coordinate type
-  switch (_out)
+  if (!ValidType(_in, true) || !ValidType(_out, true))
   {
-    // ECEF, do nothing
-    case ECEF:
-      break;
-
-    // Convert from ECEF to global
-    case GLOBAL:
-      tmp = this->dataPtr->rotECEFToGlobal * tmp;
-      break;
-
-    // Convert from ECEF to local
-    case LOCAL:
-      tmp = this->dataPtr->rotECEFToGlobal * tmp;
-      tmp = ignition::math::Vector3d(
-          tmp.X() * this->dataPtr->cosHea - tmp.Y() * this->dataPtr->sinHea,
-          tmp.X() * this->dataPtr->sinHea + tmp.Y() * this->dataPtr->cosHea,
-          tmp.Z());
-      break;
-
-    default:
-      gzerr << "Unknown coordinate type[" << _out << "]\n";
-      return _vel;
+    gzerr << "Unknown coordinate types[" << _in << ", " << _out << "]\n";
+    std::copy(_vel.begin(), _vel.end(), _result.begin());
+    return;
   }
 
-  return tmp;
+  for (size_t i = 0; i < _vel.size(); ++i)
+  {
+    _result[i] = VelocityFromECEF(*this->dataPtr,
+        VelocityToECEF(*this->dataPtr, _vel[i], _in), _out);
+  }
 }
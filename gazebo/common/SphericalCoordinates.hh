@@ -18,6 +18,7 @@
 #define _GAZEBO_SPHERICALCOORDINATES_HH_
 
 #include <string>
+#include <vector>
 
 #include <ignition/math/Angle.hh>
 #include <ignition/math/Vector3.hh>
@@ -195,6 +196,40 @@ namespace gazebo
                   const ignition::math::Vector3d &_vel,
                   const CoordinateType &_in, const CoordinateType &_out) const;
 
+      /// \brief Convert a batch of positions between frames, see
+      /// PositionTransform. The frames are checked once for the batch.
+      /// \param[in] _pos Position vectors in frame defined by parameter _in
+      /// \param[in] _in  CoordinateType for input
+      /// \param[in] _out CoordinateType for output
+      /// \param[out] _result Transformed positions, in the order of _pos.
+      /// It may be _pos itself.
+      public: void PositionTransform(
+                  const std::vector<ignition::math::Vector3d> &_pos,
+                  const CoordinateType &_in, const CoordinateType &_out,
+                  std::vector<ignition::math::Vector3d> &_result) const;
+
+      /// \brief Convert a batch of velocities between frames, see
+      /// VelocityTransform. The frames are checked once for the batch.
+      /// \param[in] _vel Velocity vectors in frame defined by parameter _in
+      /// \param[in] _in  CoordinateType for input
+      /// \param[in] _out CoordinateType for output
+      /// \param[out] _result Transformed velocities, in the order of _vel.
+      /// It may be _vel itself.
+      public: void VelocityTransform(
+                  const std::vector<ignition::math::Vector3d> &_vel,
+                  const CoordinateType &_in, const CoordinateType &_out,
+                  std::vector<ignition::math::Vector3d> &_result) const;
+
+      /// \brief Convert a batch of Cartesian positions in the local frame
+      /// to geodetic positions, see SphericalFromLocal.
+      /// \param[in] _xyz Cartesian positions in Gazebo's world frame.
+      /// \param[out] _result Positions with components (latitude,
+      /// longitude, altitude), with the angles in degrees. It may be _xyz
+      /// itself.
+      public: void SphericalFromLocal(
+                  const std::vector<ignition::math::Vector3d> &_xyz,
+                  std::vector<ignition::math::Vector3d> &_result) const;
+
       /// \internal
       /// \brief Pointer to the private data
       private: SphericalCoordinatesPrivate *dataPtr;
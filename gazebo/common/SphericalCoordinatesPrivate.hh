@@ -70,6 +70,18 @@ namespace gazebo
       /// \brief Second eccentricity ellipse parameter
       public: double ellP;
 
+      /// \brief Square of the first eccentricity
+      public: double ellE2;
+
+      /// \brief Square of the ratio of the semi-minor and semi-major axes
+      public: double ellB2OverA2;
+
+      /// \brief Square of the second eccentricity times the semi-minor axis
+      public: double ellP2B;
+
+      /// \brief Square of the first eccentricity times the semi-major axis
+      public: double ellE2A;
+
       /// \brief Rotation matrix that moves ECEF to GLOBAL
       public: ignition::math::Matrix3d rotECEFToGlobal;
 
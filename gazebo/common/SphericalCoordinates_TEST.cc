@@ -16,6 +16,7 @@
 */
 
 #include <gtest/gtest.h>
+#include <vector>
 
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/SphericalCoordinates.hh"
@@ -252,6 +253,75 @@ TEST_F(SphericalCoordinatesTest, CoordinateTransforms)
   }
 }
 
+//////////////////////////////////////////////////
+// Test batch transforms
+TEST_F(SphericalCoordinatesTest, BatchTransform)
+{
+  common::SphericalCoordinates sc(common::SphericalCoordinates::EARTH_WGS84,
+      IGN_DTOR(37.3877349), IGN_DTOR(-122.0651166), 32.0, IGN_DTOR(30.0));
+
+  std::vector<ignition::math::Vector3d> local;
+  for (int i = 0; i < 50; ++i)
+    local.push_back(ignition::math::Vector3d(i * 37.0, -i * 21.0, i * 3.0));
+
+  const common::SphericalCoordinates::CoordinateType types[] = {
+    common::SphericalCoordinates::SPHERICAL,
+    common::SphericalCoordinates::ECEF,
+    common::SphericalCoordinates::GLOBAL,
+    common::SphericalCoordinates::LOCAL};
+
+  std::vector<ignition::math::Vector3d> result;
+  for (const auto out : types)
+  {
+    sc.PositionTransform(local, common::SphericalCoordinates::LOCAL, out,
+        result);
+    ASSERT_EQ(local.size(), result.size());
+    for (size_t i = 0; i < local.size(); ++i)
+    {
+      EXPECT_EQ(sc.PositionTransform(local[i],
+            common::SphericalCoordinates::LOCAL, out), result[i]);
+    }
+
+    // ECEF -> SPHERICAL -> ECEF, in place
+    if (out == common::SphericalCoordinates::ECEF)
+    {
+      std::vector<ignition::math::Vector3d> ecef = result;
+      sc.PositionTransform(result, out,
+          common::SphericalCoordinates::SPHERICAL, result);
+      sc.PositionTransform(result, common::SphericalCoordinates::SPHERICAL,
+          out, result);
+      for (size_t i = 0; i < ecef.size(); ++i)
+      {
+        EXPECT_NEAR(ecef[i].X(), result[i].X(), 1e-6);
+        EXPECT_NEAR(ecef[i].Y(), result[i].Y(), 1e-6);
+        EXPECT_NEAR(ecef[i].Z(), result[i].Z(), 1e-6);
+      }
+    }
+
+    if (out == common::SphericalCoordinates::SPHERICAL)
+      continue;
+
+    sc.VelocityTransform(local, common::SphericalCoordinates::LOCAL, out,
+        result);
+    ASSERT_EQ(local.size(), result.size());
+    for (size_t i = 0; i < local.size(); ++i)
+    {
+      EXPECT_EQ(sc.VelocityTransform(local[i],
+            common::SphericalCoordinates::LOCAL, out), result[i]);
+    }
+  }
+
+  sc.SphericalFromLocal(local, result);
+  ASSERT_EQ(local.size(), result.size());
+  for (size_t i = 0; i < local.size(); ++i)
+    EXPECT_EQ(sc.SphericalFromLocal(local[i]), result[i]);
+
+  // Spherical velocities are not supported
+  sc.VelocityTransform(local, common::SphericalCoordinates::LOCAL,
+      common::SphericalCoordinates::SPHERICAL, result);
+  EXPECT_EQ(local, result);
+}
+
 //////////////////////////////////////////////////
 // Test distance
 TEST_F(SphericalCoordinatesTest, Distance)
@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_COMMON_SPSCQUEUE_HH_
+#define GAZEBO_COMMON_SPSCQUEUE_HH_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace gazebo
+{
+  namespace common
+  {
+    /// \addtogroup gazebo_common Common
+    /// \{
+
+    /// \class SpscQueue SpscQueue.hh common/common.hh
+    /// \brief Bounded lock free queue with a single producer thread and a
+    /// single consumer thread. Push and Pop never block: Push fails when
+    /// the queue is full, and Pop when it is empty.
+    template<typename T>
+    class SpscQueue
+    {
+      /// \brief Constructor.
+      /// \param[in] _capacity Max number of values in the queue, at least 1.
+      public: explicit SpscQueue(const size_t _capacity)
+              : slots(std::max<size_t>(_capacity, 1) + 1)
+              {
+              }
+
+      /// \brief Get the max number of values in the queue.
+      /// \return The capacity.
+      public: size_t Capacity() const
+              {
+                return this->slots.size() - 1;
+              }
+
+      /// \brief Get the number of values in the queue. Exact when called
+      /// by the producer or the consumer while the other is idle.
+      /// \return Number of values.
+      public: size_t Size() const
+              {
+                const size_t tail = this->tail.load(std::memory_order_acquire);
+                const size_t head = this->head.load(std::memory_order_acquire);
+                return tail >= head ? tail - head
+                                    : tail + this->slots.size() - head;
+              }
+
+      /// \brief Check whether the queue is full. A full queue seen by the
+      /// producer stays full until the consumer pops a value.
+      /// \return True if Push would fail.
+      public: bool Full() const
+              {
+                const size_t tail = this->tail.load(std::memory_order_relaxed);
+                return this->Next(tail) ==
+                  this->head.load(std::memory_order_acquire);
+              }
+
+      /// \brief Add a value, from the producer thread.
+      /// \param[in] _value The value, moved into the queue on success.
+      /// \return False if the queue is full.
+      public: bool Push(T &&_value)
+              {
+                const size_t tail = this->tail.load(std::memory_order_relaxed);
+                const size_t next = this->Next(tail);
+                if (next == this->head.load(std::memory_order_acquire))
+                  return false;
+
+                this->slots[tail] = std::move(_value);
+                this->tail.store(next, std::memory_order_release);
+                return true;
+              }
+
+      /// \brief Remove the oldest value, from the consumer thread.
+      /// \param[out] _value The value, if the queue was not empty.
+      /// \return False if the queue is empty.
+      public: bool Pop(T &_value)
+              {
+                const size_t head = this->head.load(std::memory_order_relaxed);
+                if (head == this->tail.load(std::memory_order_acquire))
+                  return false;
+
+                _value = std::move(this->slots[head]);
+                this->slots[head] = T();
+                this->head.store(this->Next(head), std::memory_order_release);
+                return true;
+              }
+
+      /// \brief Get the slot after a slot.
+      /// \param[in] _index Index of the slot.
+      /// \return Index of the next slot.
+      private: size_t Next(const size_t _index) const
+               {
+                 return _index + 1 == this->slots.size() ? 0 : _index + 1;
+               }
+
+      /// \brief The slots, one more than the capacity so that a full queue
+      /// is told apart from an empty one.
+      private: std::vector<T> slots;
+
+      /// \brief Index of the oldest value, written by the consumer.
+      private: std::atomic<size_t> head{0};
+
+      /// \brief Index of the next free slot, written by the producer.
+      private: std::atomic<size_t> tail{0};
+    };
+    /// \}
+  }
+}
+#endif
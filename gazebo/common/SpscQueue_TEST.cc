@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "gazebo/common/SpscQueue.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class SpscQueueTest : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+TEST_F(SpscQueueTest, PushPop)
+{
+  common::SpscQueue<std::string> queue(3);
+  EXPECT_EQ(3u, queue.Capacity());
+  EXPECT_EQ(0u, queue.Size());
+  EXPECT_FALSE(queue.Full());
+
+  std::string value;
+  EXPECT_FALSE(queue.Pop(value));
+
+  EXPECT_TRUE(queue.Push("a"));
+  EXPECT_TRUE(queue.Push("b"));
+  EXPECT_TRUE(queue.Push("c"));
+  EXPECT_TRUE(queue.Full());
+  EXPECT_EQ(3u, queue.Size());
+
+  // A failed push keeps the value
+  std::string rejected = "d";
+  EXPECT_FALSE(queue.Push(std::move(rejected)));
+  EXPECT_EQ("d", rejected);
+
+  EXPECT_TRUE(queue.Pop(value));
+  EXPECT_EQ("a", value);
+  EXPECT_FALSE(queue.Full());
+
+  // Wrap around
+  EXPECT_TRUE(queue.Push("e"));
+  EXPECT_EQ(3u, queue.Size());
+  for (auto const &expected : {"b", "c", "e"})
+  {
+    EXPECT_TRUE(queue.Pop(value));
+    EXPECT_EQ(expected, value);
+  }
+  EXPECT_EQ(0u, queue.Size());
+  EXPECT_FALSE(queue.Pop(value));
+
+  // Values are released once popped
+  common::SpscQueue<std::shared_ptr<int>> pointers(1);
+  EXPECT_EQ(1u, pointers.Capacity());
+  auto pointer = std::make_shared<int>(1);
+  EXPECT_TRUE(pointers.Push(std::shared_ptr<int>(pointer)));
+  std::shared_ptr<int> popped;
+  EXPECT_TRUE(pointers.Pop(popped));
+  popped.reset();
+  EXPECT_EQ(1, pointer.use_count());
+}
+
+/////////////////////////////////////////////////
+TEST_F(SpscQueueTest, Threads)
+{
+  common::SpscQueue<int> queue(16);
+  const int count = 100000;
+
+  std::thread producer([&queue, count]()
+      {
+        for (int i = 0; i < count; ++i)
+        {
+          while (!queue.Push(int(i)))
+            std::this_thread::yield();
+        }
+      });
+
+  // The values arrive in order
+  int expected = 0;
+  while (expected < count)
+  {
+    int value;
+    if (queue.Pop(value))
+      EXPECT_EQ(expected++, value);
+    else
+      std::this_thread::yield();
+  }
+  producer.join();
+  EXPECT_EQ(0u, queue.Size());
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -15,9 +15,12 @@
  *
  */
 
+#include <chrono>
 #include <iostream>
 #include <fstream>
+#include <mutex>
 #include <sstream>
+#include <string>
 
 #include <boost/filesystem.hpp>
 #include <ignition/common/StringUtils.hh>
@@ -56,6 +59,9 @@ char pathDelimiter()
 /// TODO(chapulina): Move to member variable when porting forward
 std::vector<std::function<std::string (const std::string &)>> g_findFileCbs;
 
+/// \brief Time after which a file that was not found is looked for again.
+static const std::chrono::seconds kMissingFileLifetime(5);
+
 //////////////////////////////////////////////////
 SystemPaths::SystemPaths()
 {
@@ -303,9 +309,40 @@ std::string SystemPaths::GetWorldPathExtension()
   return "/worlds";
 }
 
+//////////////////////////////////////////////////
+static bool isAbsolute(const std::string &_filename)
+{
+  boost::filesystem::path path(_filename);
+  return path.is_absolute();
+}
+
+//////////////////////////////////////////////////
+/// \brief Get the key of a search in the find file cache.
+/// \param[in] _kind Kind of search.
+/// \param[in] _filename File or URI searched.
+/// \return The key.
+static std::string findFileKey(const std::string &_kind,
+    const std::string &_filename)
+{
+  std::string key = _kind + ":" + _filename;
+
+  // Relative names may be found from the working directory
+  if (!isAbsolute(_filename))
+  {
+    boost::system::error_code ec;
+    key += "\n" + boost::filesystem::current_path(ec).string();
+  }
+  return key;
+}
+
 //////////////////////////////////////////////////
 std::string SystemPaths::FindFileURI(const std::string &_uri)
 {
+  const std::string key = findFileKey("uri", _uri);
+  std::string cached;
+  if (this->CachedFile(key, cached))
+    return cached;
+
   int index = _uri.find("://");
   std::string prefix = _uri.substr(0, index);
   std::string suffix = _uri.substr(index + 3, _uri.size() - index - 3);
@@ -337,15 +374,10 @@ std::string SystemPaths::FindFileURI(const std::string &_uri)
     filename = this->FindFile(suffix);
   }
 
+  this->CacheFile(key, filename);
   return filename;
 }
 
-static bool isAbsolute(const std::string &_filename)
-{
-  boost::filesystem::path path(_filename);
-  return path.is_absolute();
-}
-
 //////////////////////////////////////////////////
 std::string SystemPaths::FindFile(const std::string &_filename,
                                   bool _searchLocalPath)
@@ -355,6 +387,23 @@ std::string SystemPaths::FindFile(const std::string &_filename,
   if (_filename.empty())
     return path.string();
 
+  // Pick up changes of GAZEBO_RESOURCE_PATH before trusting the cache
+  if (this->gazeboPathsFromEnv)
+    this->UpdateGazeboPaths();
+
+  const std::string key = findFileKey(_searchLocalPath ? "local" : "file",
+      _filename);
+  std::string cached;
+  if (this->CachedFile(key, cached))
+  {
+    if (cached.empty())
+    {
+      gzwarn << "File or path does not exist [] [" << _filename << "]"
+             << std::endl;
+    }
+    return cached;
+  }
+
   // Handle as URI
   if (_filename.find("://") != std::string::npos)
   {
@@ -458,23 +507,73 @@ std::string SystemPaths::FindFile(const std::string &_filename,
   {
     gzwarn << "File or path does not exist [" << path << "] ["
            << _filename << "]" << std::endl;
+    this->CacheFile(key, std::string());
     return std::string();
   }
 
+  this->CacheFile(key, path.string());
   return path.string();
 }
 
+/////////////////////////////////////////////////
+bool SystemPaths::CachedFile(const std::string &_key, std::string &_path)
+{
+  std::lock_guard<std::mutex> lock(this->foundFilesMutex);
+  auto iter = this->foundFiles.find(_key);
+  if (iter == this->foundFiles.end())
+    return false;
+
+  // A path found may have been removed since, and a file that was not
+  // found may have been created or downloaded since.
+  bool valid;
+  if (iter->second.first.empty())
+  {
+    valid = std::chrono::steady_clock::now() - iter->second.second <
+        kMissingFileLifetime;
+  }
+  else
+  {
+    valid = boost::filesystem::exists(iter->second.first);
+  }
+
+  if (!valid)
+  {
+    this->foundFiles.erase(iter);
+    return false;
+  }
+
+  _path = iter->second.first;
+  return true;
+}
+
+/////////////////////////////////////////////////
+void SystemPaths::CacheFile(const std::string &_key, const std::string &_path)
+{
+  std::lock_guard<std::mutex> lock(this->foundFilesMutex);
+  this->foundFiles[_key] =
+      std::make_pair(_path, std::chrono::steady_clock::now());
+}
+
+/////////////////////////////////////////////////
+void SystemPaths::ClearFindFileCache()
+{
+  std::lock_guard<std::mutex> lock(this->foundFilesMutex);
+  this->foundFiles.clear();
+}
+
 /////////////////////////////////////////////////
 void SystemPaths::AddFindFileCallback(
     std::function<std::string (const std::string &)> _cb)
 {
   g_findFileCbs.push_back(_cb);
+  this->ClearFindFileCache();
 }
 
 /////////////////////////////////////////////////
 void SystemPaths::ClearGazeboPaths()
 {
   this->gazeboPaths.clear();
+  this->ClearFindFileCache();
 }
 
 /////////////////////////////////////////////////
@@ -493,6 +592,7 @@ void SystemPaths::ClearPluginPaths()
 void SystemPaths::ClearModelPaths()
 {
   this->modelPaths.clear();
+  this->ClearFindFileCache();
 }
 
 /////////////////////////////////////////////////
@@ -559,7 +659,10 @@ void SystemPaths::InsertUnique(const std::string &_path,
                                std::list<std::string> &_list)
 {
   if (std::find(_list.begin(), _list.end(), _path) == _list.end())
+  {
     _list.push_back(_path);
+    this->ClearFindFileCache();
+  }
 }
 
 /////////////////////////////////////////////////
@@ -576,4 +679,5 @@ void SystemPaths::AddSearchPathSuffix(const std::string &_suffix)
     s += "/";
 
   this->suffixPaths.push_back(s);
+  this->ClearFindFileCache();
 }
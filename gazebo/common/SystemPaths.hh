@@ -29,8 +29,12 @@
 #endif
 
 #include <boost/filesystem.hpp>
+#include <chrono>
 #include <list>
+#include <map>
+#include <mutex>
 #include <string>
+#include <utility>
 
 #include "gazebo/common/CommonTypes.hh"
 #include "gazebo/common/Event.hh"
@@ -109,6 +113,11 @@ namespace gazebo
       /// \brief Find a file in the gazebo paths. If not found locally, all
       /// callbacks added with AddFindFileCallback will be called in order
       /// until found.
+      ///
+      /// Results are cached until the paths or callbacks change. A cached
+      /// path is checked to still exist before being returned, and a file
+      /// that was not found is looked for again after a few seconds, see
+      /// ClearFindFileCache.
       /// \param[in] _filename Name of the file to find.
       /// \param[in] _searchLocalPath True to search in the current working
       /// directory.
@@ -126,6 +135,10 @@ namespace gazebo
       public: void AddFindFileCallback(
                   std::function<std::string (const std::string &)> _cb);
 
+      /// \brief Forget the results of FindFile and FindFileURI, e.g. after
+      /// creating a file that was looked for before.
+      public: void ClearFindFileCache();
+
       /// \brief Add colon delimited paths to Gazebo install
       /// \param[in] _path the directory to add
       public: void AddGazeboPaths(const std::string &_path);
@@ -181,6 +194,18 @@ namespace gazebo
       private: void InsertUnique(const std::string &_path,
                                  std::list<std::string> &_list);
 
+      /// \brief Get a cached result of FindFile or FindFileURI.
+      /// \param[in] _key Key of the search.
+      /// \param[out] _path Full path found, empty if the file was not found.
+      /// \return True if a result was cached.
+      private: bool CachedFile(const std::string &_key, std::string &_path);
+
+      /// \brief Cache a result of FindFile or FindFileURI.
+      /// \param[in] _key Key of the search.
+      /// \param[in] _path Full path found, empty if the file was not found.
+      private: void CacheFile(const std::string &_key,
+                              const std::string &_path);
+
       /// \brief Paths to installed gazebo media files
       private: std::list<std::string> gazeboPaths;
 
@@ -219,6 +244,14 @@ namespace gazebo
 
       /// \brief Path to the instance temporary directory
       private: boost::filesystem::path tmpInstancePath;
+
+      /// \brief Results of FindFile and FindFileURI, with the time they
+      /// were found. An empty path is a file that was not found.
+      private: std::map<std::string, std::pair<std::string,
+               std::chrono::steady_clock::time_point>> foundFiles;
+
+      /// \brief Mutex to protect foundFiles.
+      private: std::mutex foundFilesMutex;
     };
     /// \}
   }
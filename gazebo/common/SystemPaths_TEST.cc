@@ -16,6 +16,8 @@
 */
 #include <gtest/gtest.h>
 
+#include <boost/filesystem.hpp>
+#include <fstream>
 #include <string>
 #include <vector>
 
@@ -90,6 +92,39 @@ TEST_F(SystemPathsTest, FindFile)
   }
 }
 
+//////////////////////////////////////////////////
+TEST_F(SystemPathsTest, FindFileCache)
+{
+  auto sysPaths = common::SystemPaths::Instance();
+
+  const boost::filesystem::path dir =
+      boost::filesystem::path(sysPaths->TmpPath()) /
+      boost::filesystem::unique_path("gazebo-find-%%%%%%");
+  const boost::filesystem::path file = dir / "find_file_cache.txt";
+  boost::filesystem::create_directories(dir);
+  sysPaths->AddGazeboPaths(dir.string());
+
+  // A file that is not found is remembered
+  EXPECT_EQ("", sysPaths->FindFile("find_file_cache.txt", false));
+  std::ofstream(file.string()) << "test";
+  EXPECT_EQ("", sysPaths->FindFile("find_file_cache.txt", false));
+
+  sysPaths->ClearFindFileCache();
+  EXPECT_EQ(file.string(), sysPaths->FindFile("find_file_cache.txt", false));
+  EXPECT_EQ(file.string(), sysPaths->FindFile("find_file_cache.txt", false));
+
+  // A file found is checked to still exist
+  boost::filesystem::remove(file);
+  EXPECT_EQ("", sysPaths->FindFile("find_file_cache.txt", false));
+
+  // Changing the paths clears the cache
+  std::ofstream(file.string()) << "test";
+  sysPaths->AddSearchPathSuffix("find_file_cache");
+  EXPECT_EQ(file.string(), sysPaths->FindFile("find_file_cache.txt", false));
+
+  boost::filesystem::remove_all(dir);
+}
+
 //////////////////////////////////////////////////
 TEST_F(SystemPathsTest, SystemPaths)
 {
@@ -0,0 +1,388 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#elif defined(__APPLE__)
+#include <pthread.h>
+#endif
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <sstream>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/common/ThreadConfig.hh"
+
+using namespace gazebo;
+using namespace common;
+
+/// \brief Placement of a thread.
+class ThreadPlacement
+{
+  /// \brief CPUs of the thread, empty if it isn't pinned.
+  public: std::vector<unsigned int> cpus;
+
+  /// \brief True to place the memory of the thread on the NUMA node of
+  /// its first CPU.
+  public: bool numa = false;
+};
+
+/// \brief Private data for the ThreadConfig class.
+class gazebo::common::ThreadConfigPrivate
+{
+  /// \brief Find the placement of a thread.
+  /// \param[in] _name Name of the thread.
+  /// \return The placement of the longest matching name, null if no
+  /// name matches.
+  public: const ThreadPlacement *Find(const std::string &_name) const
+          {
+            const ThreadPlacement *result = nullptr;
+            size_t length = 0;
+            for (const auto &entry : this->placements)
+            {
+              const std::string &key = entry.first;
+              const bool matches = key == _name ||
+                  (_name.size() > key.size() &&
+                   _name.compare(0, key.size(), key) == 0 &&
+                   _name[key.size()] == '_');
+              if (matches && (!result || key.size() > length))
+              {
+                result = &entry.second;
+                length = key.size();
+              }
+            }
+
+            if (!result)
+            {
+              auto iter = this->placements.find("*");
+              if (iter != this->placements.end())
+                result = &iter->second;
+            }
+            return result;
+          }
+
+  /// \brief Placements by thread name.
+  public: std::map<std::string, ThreadPlacement> placements;
+
+  /// \brief CPUs of the process when the configuration was first loaded,
+  /// given to the threads without a placement so that they don't keep the
+  /// placement of the thread that started them.
+  public: std::vector<unsigned int> processCpus;
+
+  /// \brief Protects placements.
+  public: mutable std::mutex mutex;
+};
+
+/////////////////////////////////////////////////
+/// \brief Trim the white space around a string.
+/// \param[in] _str The string.
+/// \return The trimmed string.
+static std::string Trim(const std::string &_str)
+{
+  const size_t first = _str.find_first_not_of(" \t\n");
+  if (first == std::string::npos)
+    return "";
+  const size_t last = _str.find_last_not_of(" \t\n");
+  return _str.substr(first, last - first + 1);
+}
+
+/////////////////////////////////////////////////
+/// \brief Find the NUMA node of a CPU.
+/// \param[in] _cpu The CPU.
+/// \param[out] _node The node.
+/// \return False if the node isn't known.
+static bool NumaNode(const unsigned int _cpu, unsigned int &_node)
+{
+#ifdef __linux__
+  // Each node lists its CPUs
+  for (unsigned int node = 0; node < 1024; ++node)
+  {
+    std::ifstream file("/sys/devices/system/node/node" +
+        std::to_string(node) + "/cpulist");
+    if (!file)
+      break;
+
+    std::string list;
+    std::getline(file, list);
+    std::vector<unsigned int> cpus;
+    if (ThreadConfig::ParseCpus(list, cpus) &&
+        std::binary_search(cpus.begin(), cpus.end(), _cpu))
+    {
+      _node = node;
+      return true;
+    }
+  }
+#else
+  (void)_cpu;
+  (void)_node;
+#endif
+  return false;
+}
+
+/////////////////////////////////////////////////
+/// \brief Prefer a NUMA node for the memory allocated by the calling
+/// thread.
+/// \param[in] _cpu A CPU of the node.
+/// \return False if the memory policy couldn't be set.
+static bool PreferNode(const unsigned int _cpu)
+{
+#if defined(__linux__) && defined(SYS_set_mempolicy)
+  unsigned int node;
+  if (!NumaNode(_cpu, node))
+  {
+    gzwarn << "NUMA node of CPU[" << _cpu << "] is unknown\n";
+    return false;
+  }
+
+  // MPOL_PREFERRED of linux/mempolicy.h, which isn't always installed
+  const int preferred = 1;
+  const size_t bits = 8 * sizeof(unsigned long);  // NOLINT(runtime/int)
+  std::vector<unsigned long> mask(node / bits + 1, 0);  // NOLINT
+  mask[node / bits] |= 1ul << (node % bits);
+  if (syscall(SYS_set_mempolicy, preferred, mask.data(),
+        mask.size() * bits + 1) != 0)
+  {
+    gzwarn << "Unable to place memory on NUMA node[" << node << "]\n";
+    return false;
+  }
+  return true;
+#else
+  (void)_cpu;
+  return false;
+#endif
+}
+
+/////////////////////////////////////////////////
+ThreadConfig::ThreadConfig()
+  : dataPtr(new ThreadConfigPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+ThreadConfig::~ThreadConfig()
+{
+}
+
+/////////////////////////////////////////////////
+bool ThreadConfig::Load(const std::string &_config)
+{
+  std::map<std::string, ThreadPlacement> placements;
+
+  std::istringstream stream(_config);
+  std::string entry;
+  while (std::getline(stream, entry, ';'))
+  {
+    entry = Trim(entry);
+    if (entry.empty())
+      continue;
+
+    const size_t equal = entry.find('=');
+    if (equal == std::string::npos)
+    {
+      gzerr << "Thread configuration[" << entry << "] isn't name=cpus\n";
+      return false;
+    }
+
+    const std::string name = Trim(entry.substr(0, equal));
+    std::string cpus = Trim(entry.substr(equal + 1));
+    ThreadPlacement placement;
+
+    const size_t colon = cpus.find(':');
+    if (colon != std::string::npos)
+    {
+      if (Trim(cpus.substr(colon + 1)) != "numa")
+      {
+        gzerr << "Thread configuration[" << entry << "] has an unknown "
+              << "option, only numa is supported\n";
+        return false;
+      }
+      placement.numa = true;
+      cpus = Trim(cpus.substr(0, colon));
+    }
+
+    if (name.empty() || !ParseCpus(cpus, placement.cpus) ||
+        placement.cpus.empty())
+    {
+      gzerr << "Thread configuration[" << entry << "] isn't name=cpus\n";
+      return false;
+    }
+    placements[name] = placement;
+  }
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+#ifdef __linux__
+  if (this->dataPtr->processCpus.empty())
+  {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0)
+    {
+      for (unsigned int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+      {
+        if (CPU_ISSET(cpu, &set))
+          this->dataPtr->processCpus.push_back(cpu);
+      }
+    }
+  }
+#endif
+  this->dataPtr->placements.swap(placements);
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool ThreadConfig::Apply(const std::string &_name)
+{
+  SetName(_name);
+
+  ThreadPlacement placement;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    const ThreadPlacement *found = this->dataPtr->Find(_name);
+    if (found)
+      placement = *found;
+    else if (!this->dataPtr->placements.empty())
+      placement.cpus = this->dataPtr->processCpus;
+  }
+
+  if (placement.cpus.empty())
+    return true;
+
+#ifdef __linux__
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (const unsigned int cpu : placement.cpus)
+  {
+    if (cpu < CPU_SETSIZE)
+      CPU_SET(cpu, &set);
+  }
+
+  if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0)
+  {
+    gzwarn << "Unable to pin thread[" << _name << "] to the configured "
+           << "CPUs\n";
+    return false;
+  }
+
+  if (placement.numa)
+    return PreferNode(placement.cpus.front());
+  return true;
+#else
+  gzwarn << "Threads can't be pinned to CPUs on this platform\n";
+  return false;
+#endif
+}
+
+/////////////////////////////////////////////////
+bool ThreadConfig::PlaceMemory(const std::string &_name) const
+{
+  unsigned int cpu;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    const ThreadPlacement *found = this->dataPtr->Find(_name);
+    if (!found || !found->numa)
+      return true;
+    cpu = found->cpus.front();
+  }
+  return PreferNode(cpu);
+}
+
+/////////////////////////////////////////////////
+std::vector<unsigned int> ThreadConfig::Cpus(const std::string &_name) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  const ThreadPlacement *found = this->dataPtr->Find(_name);
+  return found ? found->cpus : std::vector<unsigned int>();
+}
+
+/////////////////////////////////////////////////
+bool ThreadConfig::Numa(const std::string &_name) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  const ThreadPlacement *found = this->dataPtr->Find(_name);
+  return found && found->numa;
+}
+
+/////////////////////////////////////////////////
+bool ThreadConfig::SetName(const std::string &_name)
+{
+#ifdef __linux__
+  return pthread_setname_np(pthread_self(), _name.substr(0, 15).c_str()) == 0;
+#elif defined(__APPLE__)
+  return pthread_setname_np(_name.substr(0, 63).c_str()) == 0;
+#else
+  (void)_name;
+  return false;
+#endif
+}
+
+/////////////////////////////////////////////////
+bool ThreadConfig::ParseCpus(const std::string &_list,
+    std::vector<unsigned int> &_cpus)
+{
+  _cpus.clear();
+
+  std::istringstream stream(_list);
+  std::string item;
+  while (std::getline(stream, item, ','))
+  {
+    item = Trim(item);
+    if (item.empty() ||
+        item.find_first_not_of("0123456789-") != std::string::npos)
+    {
+      return false;
+    }
+
+    const size_t dash = item.find('-');
+    if (dash != std::string::npos &&
+        item.find('-', dash + 1) != std::string::npos)
+    {
+      return false;
+    }
+
+    try
+    {
+      unsigned long first, last;  // NOLINT(runtime/int)
+      if (dash == std::string::npos)
+      {
+        first = last = std::stoul(item);
+      }
+      else
+      {
+        first = std::stoul(item.substr(0, dash));
+        last = std::stoul(item.substr(dash + 1));
+      }
+
+      if (first > last || last >= 4096)
+        return false;
+      for (unsigned long cpu = first; cpu <= last; ++cpu)  // NOLINT
+        _cpus.push_back(static_cast<unsigned int>(cpu));
+    }
+    catch(...)
+    {
+      return false;
+    }
+  }
+
+  std::sort(_cpus.begin(), _cpus.end());
+  _cpus.erase(std::unique(_cpus.begin(), _cpus.end()), _cpus.end());
+  return true;
+}
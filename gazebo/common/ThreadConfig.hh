@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_COMMON_THREADCONFIG_HH_
+#define GAZEBO_COMMON_THREADCONFIG_HH_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gazebo/common/SingletonT.hh"
+#include "gazebo/util/system.hh"
+
+/// \brief Explicit instantiation for typed SingletonT.
+GZ_SINGLETON_DECLARE(GZ_COMMON_VISIBLE, gazebo, common, ThreadConfig)
+
+namespace gazebo
+{
+  namespace common
+  {
+    // Forward declare private data class
+    class ThreadConfigPrivate;
+
+    /// \addtogroup gazebo_common Common
+    /// \{
+
+    /// \class ThreadConfig ThreadConfig.hh common/common.hh
+    /// \brief Names the threads of the server and places them on CPUs and
+    /// NUMA nodes. Each thread calls Apply with its name when it starts:
+    /// the name is given to the operating system, and the thread is pinned
+    /// to the CPUs configured for it.
+    ///
+    /// The configuration is a list of entries separated by ';', each
+    /// `name=cpus` or `name=cpus:numa`, e.g. "world=2:numa;sensors=4-7;
+    /// *=8-15". The CPUs are a list of CPUs and ranges of CPUs, as given to
+    /// taskset. An entry applies to the thread of its name and to the
+    /// threads whose name starts with the name followed by '_', so
+    /// "sensors" applies to "sensors_image"; the longest matching name
+    /// wins, and "*" applies to every other thread. The threads without an
+    /// entry may run on any CPU of the process. With `:numa` the memory
+    /// allocated by the thread is preferably placed on the NUMA node of its
+    /// first CPU. Threads started by libraries, such as the workers of TBB,
+    /// keep the placement of the thread that started them.
+    ///
+    /// The names of the threads started by gazebo are "gzserver", "world",
+    /// "world_log", "world_factory", "world_plugins", "sensors_image",
+    /// "sensors_ray", "sensors_other", "io_<n>", "connections", "master",
+    /// "log_update", "log_write", "log_cleanup", "log_prefetch" and
+    /// "ode_island".
+    class GZ_COMMON_VISIBLE ThreadConfig : public SingletonT<ThreadConfig>
+    {
+      /// \brief Replace the configuration.
+      /// \param[in] _config The configuration, empty to clear it.
+      /// \return False if the configuration isn't valid, in which case the
+      /// previous configuration is kept.
+      public: bool Load(const std::string &_config);
+
+      /// \brief Name the calling thread and pin it to the CPUs configured
+      /// for its name.
+      /// \param[in] _name Name of the thread. The operating system keeps
+      /// the first 15 characters.
+      /// \return False if the thread couldn't be pinned.
+      public: bool Apply(const std::string &_name);
+
+      /// \brief Place the memory allocated by the calling thread on the
+      /// NUMA node of the first CPU configured for a thread. The server
+      /// places the memory of the world it loads on the node of the
+      /// "world" thread this way.
+      /// \param[in] _name Name of the thread.
+      /// \return False if the memory couldn't be placed.
+      public: bool PlaceMemory(const std::string &_name) const;
+
+      /// \brief Get the CPUs configured for a thread.
+      /// \param[in] _name Name of the thread.
+      /// \return The CPUs, empty if the thread isn't pinned.
+      public: std::vector<unsigned int> Cpus(const std::string &_name) const;
+
+      /// \brief Check whether the memory of a thread is placed on the NUMA
+      /// node of its CPUs.
+      /// \param[in] _name Name of the thread.
+      /// \return True if `:numa` is configured for the thread.
+      public: bool Numa(const std::string &_name) const;
+
+      /// \brief Give a name to the calling thread, without pinning it.
+      /// \param[in] _name Name of the thread, of which the operating
+      /// system keeps the first 15 characters.
+      /// \return False if the name couldn't be set.
+      public: static bool SetName(const std::string &_name);
+
+      /// \brief Parse a list of CPUs, e.g. "0-3,8".
+      /// \param[in] _list The list.
+      /// \param[out] _cpus The CPUs, sorted and without duplicates.
+      /// \return False if the list isn't valid.
+      public: static bool ParseCpus(const std::string &_list,
+                  std::vector<unsigned int> &_cpus);
+
+      /// \brief Constructor.
+      private: ThreadConfig();
+
+      /// \brief Destructor.
+      private: virtual ~ThreadConfig();
+
+      /// \brief This is a singleton class.
+      private: friend class SingletonT<ThreadConfig>;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<ThreadConfigPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include <thread>
+#include <vector>
+
+#include "gazebo/common/ThreadConfig.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class ThreadConfigTest : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+TEST_F(ThreadConfigTest, ParseCpus)
+{
+  std::vector<unsigned int> cpus;
+  EXPECT_TRUE(common::ThreadConfig::ParseCpus("3", cpus));
+  EXPECT_EQ(std::vector<unsigned int>({3}), cpus);
+
+  EXPECT_TRUE(common::ThreadConfig::ParseCpus("8, 0-2,1", cpus));
+  EXPECT_EQ(std::vector<unsigned int>({0, 1, 2, 8}), cpus);
+
+  EXPECT_FALSE(common::ThreadConfig::ParseCpus("2-1", cpus));
+  EXPECT_FALSE(common::ThreadConfig::ParseCpus("1-2-3", cpus));
+  EXPECT_FALSE(common::ThreadConfig::ParseCpus("a", cpus));
+  EXPECT_FALSE(common::ThreadConfig::ParseCpus("1,,2", cpus));
+  EXPECT_FALSE(common::ThreadConfig::ParseCpus("-1", cpus));
+}
+
+/////////////////////////////////////////////////
+TEST_F(ThreadConfigTest, Load)
+{
+  common::ThreadConfig *config = common::ThreadConfig::Instance();
+  EXPECT_TRUE(config->Load("world=2:numa; sensors=4-5 ;sensors_ray=6;*=7"));
+
+  EXPECT_EQ(std::vector<unsigned int>({2}), config->Cpus("world"));
+  EXPECT_TRUE(config->Numa("world"));
+  EXPECT_EQ(std::vector<unsigned int>({2}), config->Cpus("world_log"));
+  EXPECT_EQ(std::vector<unsigned int>({4, 5}),
+      config->Cpus("sensors_image"));
+  EXPECT_FALSE(config->Numa("sensors_image"));
+
+  // The longest name wins, other threads use *
+  EXPECT_EQ(std::vector<unsigned int>({6}), config->Cpus("sensors_ray"));
+  EXPECT_EQ(std::vector<unsigned int>({7}), config->Cpus("worlds"));
+  EXPECT_EQ(std::vector<unsigned int>({7}), config->Cpus("io_0"));
+
+  // Invalid configurations are rejected and keep the previous one
+  EXPECT_FALSE(config->Load("world"));
+  EXPECT_FALSE(config->Load("world=2:fast"));
+  EXPECT_FALSE(config->Load("=2"));
+  EXPECT_FALSE(config->Load("world="));
+  EXPECT_EQ(std::vector<unsigned int>({2}), config->Cpus("world"));
+
+  EXPECT_TRUE(config->Load(""));
+  EXPECT_TRUE(config->Cpus("world").empty());
+  EXPECT_FALSE(config->Numa("world"));
+}
+
+/////////////////////////////////////////////////
+TEST_F(ThreadConfigTest, Apply)
+{
+  common::ThreadConfig *config = common::ThreadConfig::Instance();
+
+#ifdef __linux__
+  // Pin to the first CPU the test may run on
+  cpu_set_t allowed;
+  ASSERT_EQ(0, sched_getaffinity(0, sizeof(allowed), &allowed));
+  unsigned int first = 0;
+  while (!CPU_ISSET(first, &allowed))
+    ++first;
+  EXPECT_TRUE(config->Load("test=" + std::to_string(first)));
+#endif
+
+  std::thread thread([config]()
+  {
+    EXPECT_TRUE(config->Apply("test_thread_with_a_long_name"));
+#ifdef __linux__
+    char name[16];
+    EXPECT_EQ(0, pthread_getname_np(pthread_self(), name, sizeof(name)));
+    EXPECT_EQ("test_thread_wit", std::string(name));
+
+    cpu_set_t set;
+    EXPECT_EQ(0, sched_getaffinity(0, sizeof(set), &set));
+    EXPECT_EQ(1, CPU_COUNT(&set));
+#endif
+  });
+  thread.join();
+
+  EXPECT_TRUE(config->Load(""));
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,252 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/common/Tracer.hh"
+#include "gazebo/common/TracerPrivate.hh"
+
+using namespace gazebo;
+using namespace common;
+
+const size_t Tracer::kBufferSize;
+std::atomic<bool> Tracer::enabled(false);
+
+/// \brief Buffer of the calling thread, created on its first span.
+static thread_local TraceBuffer *g_traceBuffer = nullptr;
+
+/////////////////////////////////////////////////
+/// \brief Write a string as a JSON string.
+/// \param[out] _out Stream to write to.
+/// \param[in] _str The string.
+static void WriteJsonString(std::ostream &_out, const std::string &_str)
+{
+  _out << '"';
+  for (const char c : _str)
+  {
+    if (c == '"' || c == '\\')
+      _out << '\\' << c;
+    else if (static_cast<unsigned char>(c) < 0x20)
+      _out << ' ';
+    else
+      _out << c;
+  }
+  _out << '"';
+}
+
+/////////////////////////////////////////////////
+TraceBuffer *TracerPrivate::Buffer()
+{
+  if (!g_traceBuffer)
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->buffers.emplace_back(new TraceBuffer(
+          static_cast<uint32_t>(this->buffers.size() + 1)));
+    g_traceBuffer = this->buffers.back().get();
+  }
+  return g_traceBuffer;
+}
+
+/////////////////////////////////////////////////
+Tracer::Tracer()
+  : dataPtr(new TracerPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+Tracer::~Tracer()
+{
+  enabled = false;
+}
+
+/////////////////////////////////////////////////
+void Tracer::SetEnabled(const bool _enable)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (_enable && !enabled)
+  {
+    this->dataPtr->startTicks = Now();
+    this->dataPtr->startTime = std::chrono::steady_clock::now();
+  }
+  enabled = _enable;
+}
+
+/////////////////////////////////////////////////
+uint32_t Tracer::SpanId(const std::string &_name)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  auto iter = this->dataPtr->ids.find(_name);
+  if (iter != this->dataPtr->ids.end())
+    return iter->second;
+
+  const uint32_t id = static_cast<uint32_t>(this->dataPtr->names.size());
+  this->dataPtr->names.push_back(_name);
+  this->dataPtr->ids[_name] = id;
+  return id;
+}
+
+/////////////////////////////////////////////////
+size_t Tracer::SpanCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->names.size();
+}
+
+/////////////////////////////////////////////////
+void Tracer::SetThreadName(const std::string &_name)
+{
+  TraceBuffer *buffer = this->dataPtr->Buffer();
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  buffer->name = _name;
+}
+
+/////////////////////////////////////////////////
+void Tracer::Record(const uint32_t _id, const uint64_t _start,
+    const uint64_t _end, const AllocationCount &_allocations)
+{
+  TraceBuffer *buffer = this->dataPtr->Buffer();
+
+  // Only this thread writes to the buffer, the count is published after
+  // the span for the readers.
+  const uint64_t count = buffer->count.load(std::memory_order_relaxed);
+  TraceEvent &event = buffer->events[count % kBufferSize];
+  event.start = _start;
+  event.end = _end;
+  event.id = _id;
+  event.allocations = static_cast<uint32_t>(_allocations.count);
+  event.allocationBytes = _allocations.bytes;
+  buffer->count.store(count + 1, std::memory_order_release);
+}
+
+/////////////////////////////////////////////////
+size_t Tracer::Write(std::ostream &_out) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  // Convert the timestamps to microseconds since the start of the trace.
+  const uint64_t startTicks = this->dataPtr->startTicks;
+  const uint64_t nowTicks = Now();
+  const double elapsed = std::chrono::duration<double, std::micro>(
+      std::chrono::steady_clock::now() - this->dataPtr->startTime).count();
+  const double ticksPerUs = elapsed > 0 && nowTicks > startTicks ?
+      (nowTicks - startTicks) / elapsed : 1.0;
+
+#ifdef _WIN32
+  const int pid = _getpid();
+#else
+  const int pid = getpid();
+#endif
+
+  const std::ios::fmtflags flags = _out.flags();
+  const std::streamsize precision = _out.precision();
+  _out << std::fixed << std::setprecision(3);
+
+  _out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  bool first = true;
+  size_t written = 0;
+  const bool allocations = AllocationCounter::Available();
+  std::vector<TraceEvent> events;
+  for (auto const &buffer : this->dataPtr->buffers)
+  {
+    if (!buffer->name.empty())
+    {
+      _out << (first ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\","
+        << "\"pid\":" << pid << ",\"tid\":" << buffer->thread
+        << ",\"args\":{\"name\":";
+      WriteJsonString(_out, buffer->name);
+      _out << "}}";
+      first = false;
+    }
+
+    // Copy the spans, then drop the ones the thread may have overwritten
+    // while they were copied.
+    const uint64_t count = buffer->count.load(std::memory_order_acquire);
+    uint64_t from = count > kBufferSize ? count - kBufferSize : 0;
+    events.clear();
+    for (uint64_t i = from; i < count; ++i)
+      events.push_back(buffer->events[i % kBufferSize]);
+
+    const uint64_t after = buffer->count.load(std::memory_order_acquire);
+    const uint64_t overwritten = after > kBufferSize ? after - kBufferSize : 0;
+    const size_t skip = static_cast<size_t>(
+        std::min<uint64_t>(events.size(),
+          overwritten > from ? overwritten - from : 0));
+
+    for (size_t i = skip; i < events.size(); ++i)
+    {
+      const TraceEvent &event = events[i];
+      if (event.start < startTicks || event.end < event.start ||
+          event.id >= this->dataPtr->names.size())
+      {
+        continue;
+      }
+
+      _out << (first ? "" : ",") << "\n{\"name\":";
+      WriteJsonString(_out, this->dataPtr->names[event.id]);
+      _out << ",\"cat\":\"gazebo\",\"ph\":\"X\",\"ts\":"
+        << (event.start - startTicks) / ticksPerUs
+        << ",\"dur\":" << (event.end - event.start) / ticksPerUs
+        << ",\"pid\":" << pid << ",\"tid\":" << buffer->thread;
+      if (allocations)
+      {
+        _out << ",\"args\":{\"allocations\":" << event.allocations
+          << ",\"bytes\":" << event.allocationBytes << "}";
+      }
+      _out << "}";
+      first = false;
+      ++written;
+    }
+  }
+  _out << "\n]}\n";
+
+  _out.flags(flags);
+  _out.precision(precision);
+
+  return written;
+}
+
+/////////////////////////////////////////////////
+bool Tracer::Dump(const std::string &_filename) const
+{
+  std::ofstream out(_filename);
+  if (!out.is_open())
+  {
+    gzerr << "Unable to open trace file[" << _filename << "]\n";
+    return false;
+  }
+
+  const size_t written = this->Write(out);
+  out.close();
+  if (!out)
+  {
+    gzerr << "Unable to write trace file[" << _filename << "]\n";
+    return false;
+  }
+
+  gzmsg << "Wrote " << written << " spans to trace file[" << _filename
+    << "]\n";
+  return true;
+}
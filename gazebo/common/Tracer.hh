@@ -0,0 +1,199 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_COMMON_TRACER_HH_
+#define GAZEBO_COMMON_TRACER_HH_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <chrono>
+#endif
+
+#include "gazebo/common/AllocationCounter.hh"
+#include "gazebo/common/SingletonT.hh"
+#include "gazebo/util/system.hh"
+
+/// \brief Explicit instantiation for typed SingletonT.
+GZ_SINGLETON_DECLARE(GZ_COMMON_VISIBLE, gazebo, common, Tracer)
+
+/// \brief Helpers to make unique variable names from the line of a macro.
+#define GZ_TRACE_CONCAT_IMPL(_a, _b) _a##_b
+#define GZ_TRACE_CONCAT(_a, _b) GZ_TRACE_CONCAT_IMPL(_a, _b)
+
+/// \brief Trace the rest of the current scope as a span. The name is a
+/// string literal, interned once per call site.
+/// \param[in] _name Name of the span, e.g. "physics::World::Step".
+/// \sa gazebo::common::Tracer
+#define GZ_TRACE_SCOPE(_name) \
+  static const uint32_t GZ_TRACE_CONCAT(gzTraceSpan, __LINE__) = \
+    gazebo::common::Tracer::Instance()->SpanId(_name); \
+  gazebo::common::TraceScope GZ_TRACE_CONCAT(gzTraceScope, __LINE__)( \
+      GZ_TRACE_CONCAT(gzTraceSpan, __LINE__))
+
+namespace gazebo
+{
+  namespace common
+  {
+    // Forward declare private data class
+    class TracerPrivate;
+
+    /// \addtogroup gazebo_common Common
+    /// \{
+
+    /// \class Tracer Tracer.hh common/common.hh
+    /// \brief Low overhead tracer of the spans of the hot paths, cheap
+    /// enough to stay compiled in. When it is disabled a span costs the
+    /// load of a flag. When it is enabled each thread writes its spans to
+    /// its own ring buffer without locking, with time stamp counter
+    /// timestamps. The spans are written on demand in the JSON trace event
+    /// format of Chrome, which Perfetto also opens.
+    ///
+    /// Spans are added with GZ_TRACE_SCOPE. Each ring buffer holds the
+    /// last kBufferSize spans of its thread. When the allocations are
+    /// counted, see AllocationCounter, each span also records the
+    /// allocations made by its thread while it ran.
+    class GZ_COMMON_VISIBLE Tracer : public SingletonT<Tracer>
+    {
+      /// \brief Number of spans kept for each thread.
+      public: static const size_t kBufferSize = 1 << 16;
+
+      /// \brief Check whether tracing is enabled.
+      /// \return True if the spans are recorded.
+      public: static bool Enabled()
+              {
+                return enabled.load(std::memory_order_relaxed);
+              }
+
+      /// \brief Enable or disable tracing. Enabling starts a new trace,
+      /// the spans recorded before are not written.
+      /// \param[in] _enable True to record the spans.
+      public: void SetEnabled(const bool _enable);
+
+      /// \brief Get the ID of a span name, registering it the first time.
+      /// \param[in] _name Name of the span.
+      /// \return ID of the name.
+      public: uint32_t SpanId(const std::string &_name);
+
+      /// \brief Get the number of span names registered.
+      /// \return Number of span names.
+      public: size_t SpanCount() const;
+
+      /// \brief Name the calling thread in the trace.
+      /// \param[in] _name Name of the thread.
+      public: void SetThreadName(const std::string &_name);
+
+      /// \brief Record a span of the calling thread.
+      /// \param[in] _id ID of the span name.
+      /// \param[in] _start Timestamp of the start of the span.
+      /// \param[in] _end Timestamp of the end of the span.
+      /// \param[in] _allocations Allocations made during the span.
+      /// \sa Now
+      public: void Record(const uint32_t _id, const uint64_t _start,
+                  const uint64_t _end,
+                  const AllocationCount &_allocations = AllocationCount());
+
+      /// \brief Write the spans of the current trace in the Chrome trace
+      /// event format. Spans recorded while writing may be missing.
+      /// \param[out] _out Stream to write to.
+      /// \return Number of spans written.
+      public: size_t Write(std::ostream &_out) const;
+
+      /// \brief Write the spans of the current trace to a file.
+      /// \param[in] _filename Path of the file.
+      /// \return True if the file was written.
+      /// \sa Write
+      public: bool Dump(const std::string &_filename) const;
+
+      /// \brief Get the current timestamp, from the time stamp counter of
+      /// the processor when available.
+      /// \return Timestamp, in ticks of an unspecified rate.
+      public: static uint64_t Now()
+              {
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+                return __rdtsc();
+#else
+                return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch())
+                  .count();
+#endif
+              }
+
+      /// \brief Constructor.
+      private: Tracer();
+
+      /// \brief Destructor.
+      private: virtual ~Tracer();
+
+      /// \brief True if the spans are recorded.
+      private: static std::atomic<bool> enabled;
+
+      /// \brief This is a singleton class.
+      private: friend class SingletonT<Tracer>;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<TracerPrivate> dataPtr;
+    };
+
+    /// \class TraceScope Tracer.hh common/common.hh
+    /// \brief Span recorded from its construction to its destruction, if
+    /// tracing was enabled at its construction.
+    /// \sa GZ_TRACE_SCOPE
+    class TraceScope
+    {
+      /// \brief Constructor.
+      /// \param[in] _id ID of the span name.
+      /// \sa Tracer::SpanId
+      public: explicit TraceScope(const uint32_t _id)
+              : id(_id), start(Tracer::Enabled() ? Tracer::Now() : 0)
+              {
+                if (this->start != 0)
+                  this->allocations = AllocationCounter::Thread();
+              }
+
+      /// \brief Destructor, records the span.
+      public: ~TraceScope()
+              {
+                if (this->start != 0)
+                {
+                  Tracer::Instance()->Record(this->id, this->start,
+                      Tracer::Now(),
+                      AllocationCounter::Thread() - this->allocations);
+                }
+              }
+
+      /// \brief ID of the span name.
+      private: const uint32_t id;
+
+      /// \brief Timestamp of the start of the span, 0 if not recorded.
+      private: const uint64_t start;
+
+      /// \brief Allocations of the thread at the start of the span.
+      private: AllocationCount allocations;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_COMMON_TRACERPRIVATE_HH_
+#define GAZEBO_COMMON_TRACERPRIVATE_HH_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gazebo/common/Tracer.hh"
+
+namespace gazebo
+{
+  namespace common
+  {
+    /// \internal
+    /// \brief A span recorded by a thread.
+    struct TraceEvent
+    {
+      /// \brief Timestamp of the start.
+      uint64_t start;
+
+      /// \brief Timestamp of the end.
+      uint64_t end;
+
+      /// \brief ID of the span name.
+      uint32_t id;
+
+      /// \brief Number of allocations made during the span.
+      uint32_t allocations;
+
+      /// \brief Bytes allocated during the span.
+      uint64_t allocationBytes;
+    };
+
+    /// \internal
+    /// \brief Ring buffer of the spans of a thread. Only its thread writes
+    /// to it.
+    class TraceBuffer
+    {
+      /// \brief Constructor.
+      /// \param[in] _thread Index of the thread in the trace.
+      public: explicit TraceBuffer(const uint32_t _thread)
+              : events(new TraceEvent[Tracer::kBufferSize]), thread(_thread)
+              {
+              }
+
+      /// \brief The spans, a ring of Tracer::kBufferSize spans.
+      public: std::unique_ptr<TraceEvent[]> events;
+
+      /// \brief Number of spans written since the buffer was created.
+      public: std::atomic<uint64_t> count{0};
+
+      /// \brief Index of the thread in the trace.
+      public: const uint32_t thread;
+
+      /// \brief Name of the thread, may be empty. Protected by the mutex
+      /// of the tracer.
+      public: std::string name;
+    };
+
+    /// \internal
+    /// \brief Private data for the Tracer class.
+    class TracerPrivate
+    {
+      /// \brief Get the buffer of the calling thread, creating it.
+      /// \return The buffer.
+      public: TraceBuffer *Buffer();
+
+      /// \brief Names of the spans, indexed by ID.
+      public: std::vector<std::string> names;
+
+      /// \brief ID of each span name.
+      public: std::map<std::string, uint32_t> ids;
+
+      /// \brief Buffers of the threads that recorded spans. Buffers are
+      /// kept until the tracer is destroyed.
+      public: std::vector<std::unique_ptr<TraceBuffer>> buffers;
+
+      /// \brief Timestamp when the current trace started.
+      public: uint64_t startTicks = 0;
+
+      /// \brief Steady clock time when the current trace started, to
+      /// convert the timestamps to microseconds.
+      public: std::chrono::steady_clock::time_point startTime;
+
+      /// \brief Protects the names and the list of buffers.
+      public: mutable std::mutex mutex;
+    };
+  }
+}
+#endif
@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "gazebo/common/Tracer.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class TracerTest : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+/// \brief Count the occurrences of a string.
+/// \param[in] _str String to search.
+/// \param[in] _sub String to count.
+/// \return Number of occurrences.
+static size_t Count(const std::string &_str, const std::string &_sub)
+{
+  size_t count = 0;
+  for (size_t pos = _str.find(_sub); pos != std::string::npos;
+       pos = _str.find(_sub, pos + 1))
+  {
+    ++count;
+  }
+  return count;
+}
+
+/////////////////////////////////////////////////
+/// \brief Function that records a span.
+static void TracedFunction()
+{
+  GZ_TRACE_SCOPE("TracerTest::TracedFunction");
+}
+
+/////////////////////////////////////////////////
+TEST_F(TracerTest, SpanId)
+{
+  common::Tracer *tracer = common::Tracer::Instance();
+  const uint32_t id = tracer->SpanId("TracerTest::SpanId");
+  EXPECT_EQ(id, tracer->SpanId("TracerTest::SpanId"));
+  EXPECT_NE(id, tracer->SpanId("TracerTest::OtherSpanId"));
+  EXPECT_LT(id, tracer->SpanCount());
+}
+
+/////////////////////////////////////////////////
+TEST_F(TracerTest, Write)
+{
+  common::Tracer *tracer = common::Tracer::Instance();
+
+  // Spans are not recorded while tracing is disabled
+  EXPECT_FALSE(common::Tracer::Enabled());
+  TracedFunction();
+  tracer->SetEnabled(true);
+  EXPECT_TRUE(common::Tracer::Enabled());
+
+  // Spans of two threads
+  tracer->SetThreadName("main");
+  for (int i = 0; i < 10; ++i)
+    TracedFunction();
+  std::thread thread([tracer]()
+      {
+        tracer->SetThreadName("worker");
+        for (int i = 0; i < 5; ++i)
+          TracedFunction();
+      });
+  thread.join();
+
+  tracer->SetEnabled(false);
+  TracedFunction();
+
+  std::ostringstream out;
+  EXPECT_EQ(15u, tracer->Write(out));
+  const std::string trace = out.str();
+  EXPECT_EQ(0u, trace.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["));
+  EXPECT_EQ(15u, Count(trace, "\"name\":\"TracerTest::TracedFunction\""));
+  EXPECT_EQ(15u, Count(trace, "\"ph\":\"X\""));
+  EXPECT_EQ(2u, Count(trace, "\"ph\":\"M\""));
+  EXPECT_NE(std::string::npos, trace.find("\"args\":{\"name\":\"worker\"}"));
+  EXPECT_EQ(trace.size() - 3, trace.rfind("]}\n"));
+
+  // The allocations of the spans, when they are counted
+  EXPECT_EQ(common::AllocationCounter::Available() ? 15u : 0u,
+      Count(trace, "\"args\":{\"allocations\":"));
+
+  // A new trace starts without the previous spans
+  tracer->SetEnabled(true);
+  TracedFunction();
+  tracer->SetEnabled(false);
+  std::ostringstream next;
+  EXPECT_EQ(1u, tracer->Write(next));
+}
+
+/////////////////////////////////////////////////
+TEST_F(TracerTest, RingBuffer)
+{
+  common::Tracer *tracer = common::Tracer::Instance();
+  tracer->SetEnabled(true);
+
+  // Only the last spans of a thread are kept
+  std::thread thread([]()
+      {
+        for (size_t i = 0; i < common::Tracer::kBufferSize + 100; ++i)
+          TracedFunction();
+      });
+  thread.join();
+  tracer->SetEnabled(false);
+
+  std::ostringstream out;
+  EXPECT_EQ(common::Tracer::kBufferSize, tracer->Write(out));
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -14,8 +14,14 @@
  * limitations under the License.
  *
 */
+#include <condition_variable>
+#include <deque>
 #include <mutex>
 #include <stdio.h>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 #include <gazebo/gazebo_config.h>
 
 #include <sys/types.h>
@@ -40,6 +46,7 @@ extern "C"
 #include <libavutil/opt.h>
 #include <libavutil/error.h>
 #include <libavutil/imgutils.h>
+#include <libavutil/pixdesc.h>
 
 #if defined(__linux__) && defined(HAVE_AVDEVICE)
 #include <libavdevice/avdevice.h>
@@ -58,9 +65,43 @@ using namespace common;
 #define AV_ERROR_MAX_STRING_SIZE 64
 #endif
 
+/// \brief A frame waiting to be encoded.
+class QueuedFrame
+{
+  /// \brief RGB pixels of the frame.
+  public: std::vector<unsigned char> data;
+
+  /// \brief Width of the frame.
+  public: unsigned int width = 0;
+
+  /// \brief Height of the frame.
+  public: unsigned int height = 0;
+};
+
 // Private data class
 class gazebo::common::VideoEncoderPrivate
 {
+#ifdef HAVE_FFMPEG
+  /// \brief Convert and encode a frame, and write its packets. Called by
+  /// the encoding thread.
+  /// \param[in] _frame RGB pixels of the frame.
+  /// \param[in] _width Width of the frame.
+  /// \param[in] _height Height of the frame.
+  /// \return True on success.
+  public: bool Encode(const unsigned char *_frame,
+              const unsigned int _width, const unsigned int _height);
+
+#if LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(57, 40, 101)
+  /// \brief Send a frame to the codec and write the packets it returns.
+  /// \param[in] _frame The frame, null to flush the codec.
+  public: void SendFrame(const AVFrame *_frame);
+#endif
+
+  /// \brief Encoding thread, encodes the queued frames until stopThread
+  /// is set and the queue is empty.
+  public: void Run();
+#endif
+
   /// \brief Name of the file which stores the video while it is being
   ///        recorded.
   public: std::string filename;
@@ -115,6 +156,29 @@ class gazebo::common::VideoEncoderPrivate
 
   /// \brief Mutex for thread safety.
   public: std::mutex mutex;
+
+  /// \brief Frames waiting to be encoded, protected by mutex.
+  public: std::deque<QueuedFrame> frames;
+
+  /// \brief Buffers of encoded frames, reused for the next frames.
+  public: std::vector<std::vector<unsigned char>> freeBuffers;
+
+  /// \brief Maximum number of frames waiting to be encoded. Frames added
+  /// while the queue is full are dropped.
+  public: size_t maxQueuedFrames = 16;
+
+  /// \brief Number of frames dropped because the queue was full.
+  public: uint64_t droppedFrames = 0;
+
+  /// \brief Notified when a frame is queued or the thread must stop.
+  public: std::condition_variable framesCondition;
+
+  /// \brief True to stop the encoding thread.
+  public: bool stopThread = false;
+
+  /// \brief Thread which converts and encodes the frames, so that
+  /// AddFrame only copies the frame.
+  public: std::thread thread;
 };
 
 /////////////////////////////////////////////////
@@ -150,7 +214,8 @@ bool VideoEncoder::Start(const std::string &_format,
                          const unsigned int _width,
                          const unsigned int _height,
                          const unsigned int _fps,
-                         const unsigned int _bitRate)
+                         const unsigned int _bitRate,
+                         const std::string &_encoder)
 {
   // Do not allow Start to be called more than once without Stop or Reset
   // being called first.
@@ -294,8 +359,56 @@ bool VideoEncoder::Start(const std::string &_format,
   }
 
   // find the video encoder
-  AVCodec *encoder = avcodec_find_encoder(
+  AVCodec *defaultEncoder = avcodec_find_encoder(
       this->dataPtr->formatCtx->oformat->video_codec);
+  AVCodec *encoder = defaultEncoder;
+
+  // A named encoder, e.g. the h264_nvenc hardware encoder, replaces the
+  // default encoder of the format.
+  std::string encoderName = _encoder;
+  if (encoderName.empty() && getenv("GAZEBO_VIDEO_ENCODER"))
+    encoderName = getenv("GAZEBO_VIDEO_ENCODER");
+  AVPixelFormat pixelFormat = AV_PIX_FMT_YUV420P;
+  if (!encoderName.empty())
+  {
+    AVCodec *namedEncoder = avcodec_find_encoder_by_name(encoderName.c_str());
+    if (!namedEncoder || namedEncoder->type != AVMEDIA_TYPE_VIDEO)
+    {
+      gzwarn << "Video encoder[" << encoderName << "] not found. "
+             << "Using the default encoder.\n";
+    }
+    else
+    {
+      encoder = namedEncoder;
+    }
+  }
+
+  // Pick the pixel format, frames are converted in system memory so
+  // encoders which only accept hardware frames are not supported.
+  if (encoder && encoder->pix_fmts)
+  {
+    bool found = false;
+    for (const AVPixelFormat *fmt = encoder->pix_fmts;
+         *fmt != AV_PIX_FMT_NONE && !found; ++fmt)
+    {
+      found = *fmt == AV_PIX_FMT_YUV420P;
+    }
+
+    if (!found)
+    {
+      const AVPixFmtDescriptor *desc = av_pix_fmt_desc_get(
+          encoder->pix_fmts[0]);
+      pixelFormat = encoder->pix_fmts[0];
+      if (!desc || (desc->flags & AV_PIX_FMT_FLAG_HWACCEL))
+      {
+        gzwarn << "Video encoder[" << encoder->name << "] requires hardware "
+               << "frames. Using the default encoder.\n";
+        encoder = defaultEncoder;
+        pixelFormat = AV_PIX_FMT_YUV420P;
+      }
+    }
+  }
+
   if (!encoder)
   {
     gzerr << "Codec for["
@@ -369,12 +482,11 @@ bool VideoEncoder::Start(const std::string &_format,
   // Emit one intra-frame every 10 frames
   this->dataPtr->codecCtx->gop_size = 10;
   this->dataPtr->codecCtx->max_b_frames = 1;
-  this->dataPtr->codecCtx->pix_fmt = AV_PIX_FMT_YUV420P;
+  this->dataPtr->codecCtx->pix_fmt = pixelFormat;
   this->dataPtr->codecCtx->thread_count = 5;
 
   // Set the codec id
-  this->dataPtr->codecCtx->codec_id =
-    this->dataPtr->formatCtx->oformat->video_codec;
+  this->dataPtr->codecCtx->codec_id = encoder->id;
 
   if (this->dataPtr->codecCtx->codec_id == AV_CODEC_ID_MPEG1VIDEO)
   {
@@ -403,6 +515,18 @@ bool VideoEncoder::Start(const std::string &_format,
     char errBuff[AV_ERROR_MAX_STRING_SIZE];
     av_strerror(ret, errBuff, AV_ERROR_MAX_STRING_SIZE);
 
+    // A hardware encoder fails to open without a suitable device
+    if (defaultEncoder &&
+        std::string(encoder->name) != std::string(defaultEncoder->name))
+    {
+      gzwarn << "Could not open video encoder[" << encoder->name << "]: "
+             << errBuff << ". Using the default encoder.\n";
+      const std::string defaultName = defaultEncoder->name;
+      this->Reset();
+      return this->Start(_format, _filename, _width, _height, _fps,
+          _bitRate, defaultName);
+    }
+
     gzerr << "Could not open video codec: " << errBuff
           << "Video encoding is not started\n";
     this->Reset();
@@ -496,7 +620,14 @@ bool VideoEncoder::Start(const std::string &_format,
     return false;
   }
 
-  this->dataPtr->encoding = true;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->encoding = true;
+    this->dataPtr->stopThread = false;
+    this->dataPtr->droppedFrames = 0;
+  }
+  this->dataPtr->thread = std::thread(&VideoEncoderPrivate::Run,
+      this->dataPtr.get());
   return true;
 }
 // #else for HAVE_FFMPEG version check
@@ -506,7 +637,8 @@ bool VideoEncoder::Start(const std::string &/*_format*/,
                          const unsigned int /*_width*/,
                          const unsigned int /*_height*/,
                          const unsigned int /*_fps*/,
-                         const unsigned int /*_bitRate*/)
+                         const unsigned int /*_bitRate*/,
+                         const std::string &/*_encoder*/)
 {
   gzwarn << "Encoding capability not available. "
       << "Please install libavcodec, libavformat and libswscale dev packages."
@@ -532,76 +664,57 @@ bool VideoEncoder::AddFrame(const unsigned char *_frame,
 
 #ifdef HAVE_FFMPEG
 /////////////////////////////////////////////////
-// This function supports ffmpeg2
-bool VideoEncoder::AddFrame(const unsigned char *_frame,
-    const unsigned int _width,
-    const unsigned int _height,
-    const std::chrono::steady_clock::time_point &_timestamp)
+bool VideoEncoderPrivate::Encode(const unsigned char *_frame,
+    const unsigned int _width, const unsigned int _height)
 {
-  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
-
-  if (!this->dataPtr->encoding)
-  {
-    gzerr << "Start encoding before adding a frame\n";
-    return false;
-  }
-
-  auto dt = _timestamp - this->dataPtr->timePrev;
-
-  // Skip frames that arrive faster than the video's fps
-  if (dt < std::chrono::duration<double>(1.0/this->dataPtr->fps))
-    return false;
-
-  this->dataPtr->timePrev = _timestamp;
-
   // Cause the sws to be recreated on image resize
-  if (this->dataPtr->swsCtx &&
-      (this->dataPtr->inWidth != _width || this->dataPtr->inHeight != _height))
+  if (this->swsCtx &&
+      (this->inWidth != _width || this->inHeight != _height))
   {
-    sws_freeContext(this->dataPtr->swsCtx);
-    this->dataPtr->swsCtx = nullptr;
+    sws_freeContext(this->swsCtx);
+    this->swsCtx = nullptr;
 
-    if (this->dataPtr->avInFrame)
+    if (this->avInFrame)
 #if LIBAVCODEC_VERSION_INT < AV_VERSION_INT(57, 24, 1)
-      av_free(this->dataPtr->avInFrame);
+      av_free(this->avInFrame);
 #else
-      av_frame_free(&this->dataPtr->avInFrame);
+      av_frame_free(&this->avInFrame);
 #endif
-    this->dataPtr->avInFrame = nullptr;
+    this->avInFrame = nullptr;
   }
 
-  if (!this->dataPtr->swsCtx)
+  if (!this->swsCtx)
   {
-    this->dataPtr->inWidth = _width;
-    this->dataPtr->inHeight = _height;
+    this->inWidth = _width;
+    this->inHeight = _height;
 
-    if (!this->dataPtr->avInFrame)
+    if (!this->avInFrame)
     {
 #if LIBAVCODEC_VERSION_INT < AV_VERSION_INT(57, 24, 1)
-      this->dataPtr->avInFrame = new AVPicture;
-      avpicture_alloc(this->dataPtr->avInFrame,
-          AV_PIX_FMT_RGB24, this->dataPtr->inWidth,
-          this->dataPtr->inHeight);
+      this->avInFrame = new AVPicture;
+      avpicture_alloc(this->avInFrame,
+          AV_PIX_FMT_RGB24, this->inWidth,
+          this->inHeight);
 #else
-      this->dataPtr->avInFrame = av_frame_alloc();
+      this->avInFrame = av_frame_alloc();
 
-      av_image_alloc(this->dataPtr->avInFrame->data,
-          this->dataPtr->avInFrame->linesize,
-          this->dataPtr->inWidth, this->dataPtr->inHeight,
+      av_image_alloc(this->avInFrame->data,
+          this->avInFrame->linesize,
+          this->inWidth, this->inHeight,
           AV_PIX_FMT_RGB24, 1);
 #endif
     }
 
-    this->dataPtr->swsCtx = sws_getContext(
-        this->dataPtr->inWidth,
-        this->dataPtr->inHeight,
+    this->swsCtx = sws_getContext(
+        this->inWidth,
+        this->inHeight,
         AV_PIX_FMT_RGB24,
-        this->dataPtr->codecCtx->width,
-        this->dataPtr->codecCtx->height,
-        this->dataPtr->codecCtx->pix_fmt,
+        this->codecCtx->width,
+        this->codecCtx->height,
+        this->codecCtx->pix_fmt,
         SWS_BICUBIC, nullptr, nullptr, nullptr);
 
-    if (this->dataPtr->swsCtx == nullptr)
+    if (this->swsCtx == nullptr)
     {
       gzerr << "Error while calling sws_getContext\n";
       return false;
@@ -609,17 +722,17 @@ bool VideoEncoder::AddFrame(const unsigned char *_frame,
   }
 
   // encode
-  memcpy(this->dataPtr->avInFrame->data[0], _frame,
-         this->dataPtr->inWidth * this->dataPtr->inHeight * 3);
+  memcpy(this->avInFrame->data[0], _frame,
+         this->inWidth * this->inHeight * 3);
 
-  sws_scale(this->dataPtr->swsCtx,
-      this->dataPtr->avInFrame->data,
-      this->dataPtr->avInFrame->linesize,
-      0, this->dataPtr->inHeight,
-      this->dataPtr->avOutFrame->data,
-      this->dataPtr->avOutFrame->linesize);
+  sws_scale(this->swsCtx,
+      this->avInFrame->data,
+      this->avInFrame->linesize,
+      0, this->inHeight,
+      this->avOutFrame->data,
+      this->avOutFrame->linesize);
 
-  this->dataPtr->avOutFrame->pts = this->dataPtr->frameCount++;
+  this->avOutFrame->pts = this->frameCount++;
 
 #if LIBAVCODEC_VERSION_INT < AV_VERSION_INT(57, 40, 101)
   int gotOutput = 0;
@@ -628,35 +741,36 @@ bool VideoEncoder::AddFrame(const unsigned char *_frame,
   avPacket.data = nullptr;
   avPacket.size = 0;
 
-  int ret = avcodec_encode_video2(this->dataPtr->codecCtx, &avPacket,
-      this->dataPtr->avOutFrame, &gotOutput);
+  int ret = avcodec_encode_video2(this->codecCtx, &avPacket,
+      this->avOutFrame, &gotOutput);
 
   if (ret >= 0 && gotOutput == 1)
   {
-    avPacket.stream_index = this->dataPtr->videoStream->index;
+    avPacket.stream_index = this->videoStream->index;
 
     // Scale timestamp appropriately.
     if (avPacket.pts != static_cast<int64_t>(AV_NOPTS_VALUE))
     {
       avPacket.pts = av_rescale_q(avPacket.pts,
-          this->dataPtr->codecCtx->time_base,
-          this->dataPtr->videoStream->time_base);
+          this->codecCtx->time_base,
+          this->videoStream->time_base);
     }
 
     if (avPacket.dts != static_cast<int64_t>(AV_NOPTS_VALUE))
     {
       avPacket.dts = av_rescale_q(
           avPacket.dts,
-          this->dataPtr->codecCtx->time_base,
-          this->dataPtr->videoStream->time_base);
+          this->codecCtx->time_base,
+          this->videoStream->time_base);
     }
 
     // Write frame to disk
-    ret = av_interleaved_write_frame(this->dataPtr->formatCtx, &avPacket);
+    ret = av_interleaved_write_frame(this->formatCtx, &avPacket);
 
     if (ret < 0)
     {
       gzerr << "Error writing frame" << std::endl;
+      av_packet_unref(&avPacket);
       return false;
     }
   }
@@ -665,51 +779,124 @@ bool VideoEncoder::AddFrame(const unsigned char *_frame,
 
 // #else for libavcodec version check
 #else
+  this->SendFrame(this->avOutFrame);
+#endif
+  return true;
+}
 
+#if LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(57, 40, 101)
+/////////////////////////////////////////////////
+void VideoEncoderPrivate::SendFrame(const AVFrame *_frame)
+{
   AVPacket *avPacket = av_packet_alloc();
-  av_init_packet(avPacket);
-
-  avPacket->data = nullptr;
-  avPacket->size = 0;
 
-  int ret = avcodec_send_frame(this->dataPtr->codecCtx,
-                               this->dataPtr->avOutFrame);
+  int ret = avcodec_send_frame(this->codecCtx, _frame);
 
   // This loop will retrieve and write available packets
   while (ret >= 0)
   {
-    ret = avcodec_receive_packet(this->dataPtr->codecCtx, avPacket);
-
-    // Potential performance improvement: Queue the packets and write in
-    // a separate thread.
+    ret = avcodec_receive_packet(this->codecCtx, avPacket);
     if (ret >= 0)
     {
-      avPacket->stream_index = this->dataPtr->videoStream->index;
+      avPacket->stream_index = this->videoStream->index;
 
       // Scale timestamp appropriately.
       if (avPacket->pts != static_cast<int64_t>(AV_NOPTS_VALUE))
       {
         avPacket->pts = av_rescale_q(avPacket->pts,
-            this->dataPtr->codecCtx->time_base,
-            this->dataPtr->videoStream->time_base);
+            this->codecCtx->time_base,
+            this->videoStream->time_base);
       }
 
       if (avPacket->dts != static_cast<int64_t>(AV_NOPTS_VALUE))
       {
         avPacket->dts = av_rescale_q(
             avPacket->dts,
-            this->dataPtr->codecCtx->time_base,
-            this->dataPtr->videoStream->time_base);
+            this->codecCtx->time_base,
+            this->videoStream->time_base);
       }
 
       // Write frame to disk
-      if (av_interleaved_write_frame(this->dataPtr->formatCtx, avPacket) < 0)
+      if (av_interleaved_write_frame(this->formatCtx, avPacket) < 0)
         gzerr << "Error writing frame" << std::endl;
     }
   }
 
-  av_packet_unref(avPacket);
+  av_packet_free(&avPacket);
+}
 #endif
+
+/////////////////////////////////////////////////
+void VideoEncoderPrivate::Run()
+{
+  std::unique_lock<std::mutex> lock(this->mutex);
+  while (true)
+  {
+    this->framesCondition.wait(lock, [this]
+        {
+          return !this->frames.empty() || this->stopThread;
+        });
+
+    // Stop once the queued frames are encoded
+    if (this->frames.empty())
+      break;
+
+    QueuedFrame frame = std::move(this->frames.front());
+    this->frames.pop_front();
+    lock.unlock();
+
+    this->Encode(frame.data.data(), frame.width, frame.height);
+
+    lock.lock();
+    this->freeBuffers.push_back(std::move(frame.data));
+  }
+}
+
+/////////////////////////////////////////////////
+// This function supports ffmpeg2
+bool VideoEncoder::AddFrame(const unsigned char *_frame,
+    const unsigned int _width,
+    const unsigned int _height,
+    const std::chrono::steady_clock::time_point &_timestamp)
+{
+  std::unique_lock<std::mutex> lock(this->dataPtr->mutex);
+
+  if (!this->dataPtr->encoding)
+  {
+    gzerr << "Start encoding before adding a frame\n";
+    return false;
+  }
+
+  auto dt = _timestamp - this->dataPtr->timePrev;
+
+  // Skip frames that arrive faster than the video's fps
+  if (dt < std::chrono::duration<double>(1.0/this->dataPtr->fps))
+    return false;
+
+  this->dataPtr->timePrev = _timestamp;
+
+  // Drop the frame rather than stall the caller when the encoding thread
+  // falls behind
+  if (this->dataPtr->frames.size() >= this->dataPtr->maxQueuedFrames)
+  {
+    ++this->dataPtr->droppedFrames;
+    return false;
+  }
+
+  // The frame is copied to a recycled buffer, the caller may reuse _frame
+  QueuedFrame frame;
+  if (!this->dataPtr->freeBuffers.empty())
+  {
+    frame.data = std::move(this->dataPtr->freeBuffers.back());
+    this->dataPtr->freeBuffers.pop_back();
+  }
+  frame.data.assign(_frame, _frame + _width * _height * 3);
+  frame.width = _width;
+  frame.height = _height;
+  this->dataPtr->frames.push_back(std::move(frame));
+
+  lock.unlock();
+  this->dataPtr->framesCondition.notify_one();
   return true;
 }
 // #else for HAVE_FFMPEG check
@@ -730,8 +917,35 @@ bool VideoEncoder::AddFrame(const unsigned char */*_frame*/,
 bool VideoEncoder::Stop()
 {
 #ifdef HAVE_FFMPEG
-  if (this->dataPtr->encoding && this->dataPtr->formatCtx)
+  // Let the encoding thread finish the queued frames
+  bool wasEncoding;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    wasEncoding = this->dataPtr->encoding;
+    this->dataPtr->encoding = false;
+    this->dataPtr->stopThread = true;
+  }
+  this->dataPtr->framesCondition.notify_all();
+  if (this->dataPtr->thread.joinable())
+    this->dataPtr->thread.join();
+
+  if (this->dataPtr->droppedFrames > 0)
+  {
+    gzwarn << "Video encoding dropped " << this->dataPtr->droppedFrames
+           << " frames because it could not keep up.\n";
+    this->dataPtr->droppedFrames = 0;
+  }
+  this->dataPtr->freeBuffers.clear();
+
+  if (wasEncoding && this->dataPtr->formatCtx)
+  {
+#if LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(57, 40, 101)
+    // Write the frames the codec still holds, e.g. for b-frames
+    if (this->dataPtr->codecCtx)
+      this->dataPtr->SendFrame(nullptr);
+#endif
     av_write_trailer(this->dataPtr->formatCtx);
+  }
 
 #if LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(57, 24, 1)
   if (this->dataPtr->codecCtx)
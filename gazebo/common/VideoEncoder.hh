@@ -67,6 +67,12 @@ namespace gazebo
       /// the _format is "v4l2". If blank, a default temporary file is used.
       /// However, the "v4l2" _format must be accompanied with a video
       /// loopback device filename.
+      /// \param[in] _encoder Name of the libavcodec encoder to use instead
+      /// of the default encoder of the format, e.g. "h264_nvenc" to encode
+      /// on an NVIDIA GPU. If blank, the GAZEBO_VIDEO_ENCODER environment
+      /// variable is used when set. Encoders which only accept frames in GPU
+      /// memory, such as VAAPI encoders, are not supported. The default
+      /// encoder is used if the encoder is not available.
       /// \return True on success
       public: bool Start(
                 const std::string &_format = VIDEO_ENCODER_FORMAT_DEFAULT,
@@ -74,10 +80,11 @@ namespace gazebo
                 const unsigned int _width = VIDEO_ENCODER_WIDTH_DEFAULT,
                 const unsigned int _height = VIDEO_ENCODER_HEIGHT_DEFAULT,
                 const unsigned int _fps = VIDEO_ENCODER_FPS_DEFAULT,
-                const unsigned int _bitRate = VIDEO_ENCODER_BITRATE_DEFAULT);
+                const unsigned int _bitRate = VIDEO_ENCODER_BITRATE_DEFAULT,
+                const std::string &_encoder = "");
 
-      /// \brief Stop the encoder. The SaveToFile function also calls this
-      /// function.
+      /// \brief Stop the encoder, after encoding the frames that were
+      /// added. The SaveToFile function also calls this function.
       /// \return True on success.
       public: bool Stop();
 
@@ -94,12 +101,15 @@ namespace gazebo
                             const unsigned int _width,
                             const unsigned int _height);
 
-      /// \brief Add a single timestamped frame to be encoded
+      /// \brief Add a single timestamped frame to be encoded. The frame is
+      /// copied, then converted and encoded by a separate thread.
       /// \param[in] _frame Image buffer to be encoded
       /// \param[in] _width Input frame width
       /// \param[in] _height Input frame height
       /// \param[in] _timestamp Timestamp of the image frame
-      /// \return True on success.
+      /// \return True on success. False if the frame was skipped to match
+      /// the frame rate, or dropped because the encoding thread is too far
+      /// behind.
       public: bool AddFrame(const unsigned char *_frame,
                   const unsigned int _width,
                   const unsigned int _height,
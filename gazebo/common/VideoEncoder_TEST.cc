@@ -15,6 +15,11 @@
 */
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <vector>
+
 #include "gazebo/common/CommonIface.hh"
 #include "gazebo/common/VideoEncoder.hh"
 #include "test/util.hh"
@@ -57,6 +62,39 @@ TEST_F(VideoEncoderTest, StartStop)
 #endif
 }
 
+/////////////////////////////////////////////////
+TEST_F(VideoEncoderTest, AddFrame)
+{
+  VideoEncoder video;
+  std::vector<unsigned char> frame(64 * 48 * 3, 128);
+  EXPECT_FALSE(video.AddFrame(frame.data(), 64, 48));
+
+#ifdef HAVE_FFMPEG
+  // An unknown encoder falls back to the default encoder of the format
+  const std::string filename = common::cwd() + "/TMP_RECORDING.mp4";
+  EXPECT_TRUE(video.Start("mp4", "", 64, 48, 25, 0, "no_such_encoder"));
+
+  auto time = std::chrono::steady_clock::now();
+  for (int i = 0; i < 10; ++i)
+  {
+    time += std::chrono::milliseconds(40);
+    EXPECT_TRUE(video.AddFrame(frame.data(), 64, 48, time));
+  }
+
+  // Frames faster than the frame rate are skipped
+  EXPECT_FALSE(video.AddFrame(frame.data(), 64, 48, time));
+
+  // Stop waits for the queued frames
+  EXPECT_TRUE(video.Stop());
+  EXPECT_FALSE(video.IsEncoding());
+  std::ifstream file(filename, std::ios::binary | std::ios::ate);
+  EXPECT_GT(static_cast<std::streamoff>(file.tellg()), 0);
+
+  video.Reset();
+  EXPECT_FALSE(common::exists(filename));
+#endif
+}
+
 /////////////////////////////////////////////////
 TEST_F(VideoEncoderTest, Exists)
 {
@@ -0,0 +1,418 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "gazebo/common/Mesh.hh"
+#include "gazebo/common/VoxelVolume.hh"
+
+namespace gazebo
+{
+  namespace common
+  {
+    /// \internal
+    /// \brief Private data for VoxelVolume.
+    class VoxelVolumePrivate
+    {
+      /// \brief Get the grid of a solid.
+      /// \param[in] _box Bounds of the solid.
+      /// \param[in] _voxelSize Requested edge length of a voxel.
+      /// \param[out] _count Number of voxels along each axis.
+      public: void Grid(const ignition::math::AxisAlignedBox &_box,
+                  const double _voxelSize, unsigned int _count[3]);
+
+      /// \brief Build the voxels of a closed triangle soup.
+      /// \param[in] _vertices Vertices of the triangles, three by three.
+      /// \param[in] _voxelSize Edge length of a voxel.
+      /// \return False if there are no triangles.
+      public: bool Build(const std::vector<ignition::math::Vector3d>
+                  &_vertices, const double _voxelSize);
+
+      /// \brief Add a voxel.
+      /// \param[in] _center Center of the voxel.
+      public: void Add(const ignition::math::Vector3d &_center);
+
+      /// \brief Compute the centroid once the voxels are added.
+      public: void Finish();
+
+      /// \brief Edge length of a voxel.
+      public: double voxelSize = 0.0;
+
+      /// \brief Minimum corner of the grid.
+      public: ignition::math::Vector3d origin;
+
+      /// \brief Coordinates of the voxel centers in the solid frame.
+      public: std::vector<double> x, y, z;
+
+      /// \brief Center of volume in the solid frame.
+      public: ignition::math::Vector3d centroid;
+    };
+  }
+}
+
+using namespace gazebo;
+using namespace common;
+
+const unsigned int VoxelVolume::kMaxCells;
+
+//////////////////////////////////////////////////
+void VoxelVolumePrivate::Grid(const ignition::math::AxisAlignedBox &_box,
+    const double _voxelSize, unsigned int _count[3])
+{
+  const ignition::math::Vector3d size = _box.Max() - _box.Min();
+  double voxelSize = std::max(_voxelSize, 1e-6);
+
+  // Grow the voxels until the grid is small enough
+  for (;;)
+  {
+    double cells = 1.0;
+    for (int i = 0; i < 3; ++i)
+      cells *= std::max(1.0, std::ceil(size[i] / voxelSize));
+
+    if (cells <= VoxelVolume::kMaxCells)
+      break;
+    voxelSize *= std::cbrt(cells / VoxelVolume::kMaxCells) * 1.01;
+  }
+
+  // Center the grid on the bounds
+  for (int i = 0; i < 3; ++i)
+  {
+    _count[i] = static_cast<unsigned int>(
+        std::max(1.0, std::ceil(size[i] / voxelSize)));
+  }
+  this->voxelSize = voxelSize;
+  this->origin = 0.5 * (_box.Min() + _box.Max()) - 0.5 * voxelSize *
+    ignition::math::Vector3d(_count[0], _count[1], _count[2]);
+
+  this->x.clear();
+  this->y.clear();
+  this->z.clear();
+}
+
+//////////////////////////////////////////////////
+void VoxelVolumePrivate::Add(const ignition::math::Vector3d &_center)
+{
+  this->x.push_back(_center.X());
+  this->y.push_back(_center.Y());
+  this->z.push_back(_center.Z());
+}
+
+//////////////////////////////////////////////////
+void VoxelVolumePrivate::Finish()
+{
+  this->centroid = ignition::math::Vector3d::Zero;
+  if (this->x.empty())
+    return;
+
+  for (size_t i = 0; i < this->x.size(); ++i)
+  {
+    this->centroid += ignition::math::Vector3d(this->x[i], this->y[i],
+        this->z[i]);
+  }
+  this->centroid /= static_cast<double>(this->x.size());
+}
+
+//////////////////////////////////////////////////
+bool VoxelVolumePrivate::Build(
+    const std::vector<ignition::math::Vector3d> &_vertices,
+    const double _voxelSize)
+{
+  const size_t triangleCount = _vertices.size() / 3;
+  if (triangleCount == 0)
+    return false;
+
+  ignition::math::Vector3d min = _vertices[0];
+  ignition::math::Vector3d max = _vertices[0];
+  for (auto const &v : _vertices)
+  {
+    min.Min(v);
+    max.Max(v);
+  }
+
+  unsigned int count[3];
+  this->Grid(ignition::math::AxisAlignedBox(min, max), _voxelSize, count);
+  const double size = this->voxelSize;
+
+  // Bin the triangles by the rows of voxels along X that they may cross
+  std::vector<std::vector<size_t>> rows(count[1] * count[2]);
+  for (size_t t = 0; t < triangleCount; ++t)
+  {
+    const ignition::math::Vector3d *tri = &_vertices[3 * t];
+    double lo[2], hi[2];
+    for (int a = 0; a < 2; ++a)
+    {
+      lo[a] = std::min({tri[0][a + 1], tri[1][a + 1], tri[2][a + 1]});
+      hi[a] = std::max({tri[0][a + 1], tri[1][a + 1], tri[2][a + 1]});
+    }
+
+    const int j0 = std::max(0, static_cast<int>(
+          std::floor((lo[0] - this->origin.Y()) / size - 0.5)));
+    const int j1 = std::min(static_cast<int>(count[1]) - 1,
+        static_cast<int>(std::ceil((hi[0] - this->origin.Y()) / size - 0.5)));
+    const int k0 = std::max(0, static_cast<int>(
+          std::floor((lo[1] - this->origin.Z()) / size - 0.5)));
+    const int k1 = std::min(static_cast<int>(count[2]) - 1,
+        static_cast<int>(std::ceil((hi[1] - this->origin.Z()) / size - 0.5)));
+
+    for (int k = k0; k <= k1; ++k)
+    {
+      for (int j = j0; j <= j1; ++j)
+        rows[k * count[1] + j].push_back(t);
+    }
+  }
+
+  // Cast a ray along X through the centers of each row, and fill the
+  // voxels between entries and exits of the mesh. The rays are offset by
+  // a tiny amount so they do not cross the edges shared by triangles.
+  std::vector<double> hits;
+  for (unsigned int k = 0; k < count[2]; ++k)
+  {
+    const double zc = this->origin.Z() + (k + 0.5) * size;
+    const double zr = zc + 1.31e-7 * size;
+    for (unsigned int j = 0; j < count[1]; ++j)
+    {
+      const double yc = this->origin.Y() + (j + 0.5) * size;
+      const double yr = yc + 0.97e-7 * size;
+
+      hits.clear();
+      for (auto t : rows[k * count[1] + j])
+      {
+        const ignition::math::Vector3d &a = _vertices[3 * t];
+        const ignition::math::Vector3d &b = _vertices[3 * t + 1];
+        const ignition::math::Vector3d &c = _vertices[3 * t + 2];
+
+        // Barycentric coordinates of the row in the YZ projection
+        const double w0 = (b.Y() - yr) * (c.Z() - zr) -
+          (c.Y() - yr) * (b.Z() - zr);
+        const double w1 = (c.Y() - yr) * (a.Z() - zr) -
+          (a.Y() - yr) * (c.Z() - zr);
+        const double w2 = (a.Y() - yr) * (b.Z() - zr) -
+          (b.Y() - yr) * (a.Z() - zr);
+        const double area = w0 + w1 + w2;
+        if (std::fabs(area) < 1e-18)
+          continue;
+
+        if ((w0 >= 0 && w1 >= 0 && w2 >= 0) ||
+            (w0 <= 0 && w1 <= 0 && w2 <= 0))
+        {
+          hits.push_back((w0 * a.X() + w1 * b.X() + w2 * c.X()) / area);
+        }
+      }
+
+      std::sort(hits.begin(), hits.end());
+      for (size_t h = 0; h + 1 < hits.size(); h += 2)
+      {
+        const int i0 = std::max(0, static_cast<int>(
+              std::ceil((hits[h] - this->origin.X()) / size - 0.5)));
+        const int i1 = std::min(static_cast<int>(count[0]) - 1,
+            static_cast<int>(
+              std::floor((hits[h + 1] - this->origin.X()) / size - 0.5)));
+        for (int i = i0; i <= i1; ++i)
+        {
+          this->Add(ignition::math::Vector3d(
+                this->origin.X() + (i + 0.5) * size, yc, zc));
+        }
+      }
+    }
+  }
+
+  this->Finish();
+  return true;
+}
+
+//////////////////////////////////////////////////
+/// \brief Add the triangles of a submesh to a triangle soup.
+/// \param[in] _subMesh The submesh.
+/// \param[in] _scale Scale of the submesh.
+/// \param[in,out] _vertices The triangle soup.
+static void AddTriangles(const SubMesh &_subMesh,
+    const ignition::math::Vector3d &_scale,
+    std::vector<ignition::math::Vector3d> &_vertices)
+{
+  if (_subMesh.GetPrimitiveType() != SubMesh::TRIANGLES)
+    return;
+
+  for (unsigned int i = 0; i + 2 < _subMesh.GetIndexCount(); i += 3)
+  {
+    for (unsigned int v = 0; v < 3; ++v)
+    {
+      _vertices.push_back(
+          _subMesh.Vertex(_subMesh.GetIndex(i + v)) * _scale);
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+VoxelVolume::VoxelVolume()
+: dataPtr(new VoxelVolumePrivate)
+{
+}
+
+//////////////////////////////////////////////////
+VoxelVolume::~VoxelVolume()
+{
+}
+
+//////////////////////////////////////////////////
+void VoxelVolume::Build(const ignition::math::AxisAlignedBox &_box,
+    const double _voxelSize, const InsideFunction &_inside)
+{
+  unsigned int count[3];
+  this->dataPtr->Grid(_box, _voxelSize, count);
+
+  const double size = this->dataPtr->voxelSize;
+  const ignition::math::Vector3d &origin = this->dataPtr->origin;
+  for (unsigned int k = 0; k < count[2]; ++k)
+  {
+    for (unsigned int j = 0; j < count[1]; ++j)
+    {
+      for (unsigned int i = 0; i < count[0]; ++i)
+      {
+        const ignition::math::Vector3d center = origin + size *
+          ignition::math::Vector3d(i + 0.5, j + 0.5, k + 0.5);
+        if (_inside(center))
+          this->dataPtr->Add(center);
+      }
+    }
+  }
+  this->dataPtr->Finish();
+}
+
+//////////////////////////////////////////////////
+bool VoxelVolume::Build(const Mesh &_mesh,
+    const ignition::math::Vector3d &_scale, const double _voxelSize)
+{
+  std::vector<ignition::math::Vector3d> vertices;
+  for (unsigned int i = 0; i < _mesh.GetSubMeshCount(); ++i)
+    AddTriangles(*_mesh.GetSubMesh(i), _scale, vertices);
+
+  return this->dataPtr->Build(vertices, _voxelSize);
+}
+
+//////////////////////////////////////////////////
+bool VoxelVolume::Build(const SubMesh &_subMesh,
+    const ignition::math::Vector3d &_scale, const double _voxelSize)
+{
+  std::vector<ignition::math::Vector3d> vertices;
+  AddTriangles(_subMesh, _scale, vertices);
+
+  return this->dataPtr->Build(vertices, _voxelSize);
+}
+
+//////////////////////////////////////////////////
+size_t VoxelVolume::VoxelCount() const
+{
+  return this->dataPtr->x.size();
+}
+
+//////////////////////////////////////////////////
+double VoxelVolume::VoxelSize() const
+{
+  return this->dataPtr->voxelSize;
+}
+
+//////////////////////////////////////////////////
+double VoxelVolume::Volume() const
+{
+  const double size = this->dataPtr->voxelSize;
+  return this->dataPtr->x.size() * size * size * size;
+}
+
+//////////////////////////////////////////////////
+ignition::math::Vector3d VoxelVolume::Centroid() const
+{
+  return this->dataPtr->centroid;
+}
+
+//////////////////////////////////////////////////
+double VoxelVolume::Submerged(const ignition::math::Pose3d &_pose,
+    const double _level, ignition::math::Vector3d &_centroid) const
+{
+  const size_t n = this->dataPtr->x.size();
+  const double *x = this->dataPtr->x.data();
+  const double *y = this->dataPtr->y.data();
+  const double *z = this->dataPtr->z.data();
+
+  // Height of the voxel centers in voxel units, below the surface
+  const ignition::math::Vector3d ex =
+    _pose.Rot().RotateVector(ignition::math::Vector3d::UnitX);
+  const ignition::math::Vector3d ey =
+    _pose.Rot().RotateVector(ignition::math::Vector3d::UnitY);
+  const ignition::math::Vector3d ez =
+    _pose.Rot().RotateVector(ignition::math::Vector3d::UnitZ);
+  const double inv = 1.0 / this->dataPtr->voxelSize;
+  const double kx = -ex.Z() * inv;
+  const double ky = -ey.Z() * inv;
+  const double kz = -ez.Z() * inv;
+  const double k0 = (_level - _pose.Pos().Z()) * inv + 0.5;
+
+  // A branch free loop, so the compiler vectorizes it. The submerged part
+  // of a voxel crossed by the surface is centered (1 - f) / 2 voxels below
+  // the voxel center.
+  double sum = 0.0, sumX = 0.0, sumY = 0.0, sumZ = 0.0, sumDown = 0.0;
+  for (size_t i = 0; i < n; ++i)
+  {
+    double f = k0 + kx * x[i] + ky * y[i] + kz * z[i];
+    f = std::min(1.0, std::max(0.0, f));
+    sum += f;
+    sumX += f * x[i];
+    sumY += f * y[i];
+    sumZ += f * z[i];
+    sumDown += f * (1.0 - f);
+  }
+
+  if (sum <= 0.0)
+    return 0.0;
+
+  const double size = this->dataPtr->voxelSize;
+  _centroid = _pose.CoordPositionAdd(
+      ignition::math::Vector3d(sumX, sumY, sumZ) / sum);
+  _centroid.Z() -= 0.5 * size * sumDown / sum;
+  return sum * size * size * size;
+}
+
+//////////////////////////////////////////////////
+double VoxelVolume::Submerged(const ignition::math::Pose3d &_pose,
+    const HeightFunction &_height, ignition::math::Vector3d &_centroid) const
+{
+  const size_t n = this->dataPtr->x.size();
+  const double inv = 1.0 / this->dataPtr->voxelSize;
+
+  double sum = 0.0, sumDown = 0.0;
+  ignition::math::Vector3d sumPos;
+  for (size_t i = 0; i < n; ++i)
+  {
+    const ignition::math::Vector3d local(this->dataPtr->x[i],
+        this->dataPtr->y[i], this->dataPtr->z[i]);
+    const ignition::math::Vector3d world = _pose.CoordPositionAdd(local);
+    double f = (_height(world.X(), world.Y()) - world.Z()) * inv + 0.5;
+    f = std::min(1.0, std::max(0.0, f));
+    sum += f;
+    sumPos += f * local;
+    sumDown += f * (1.0 - f);
+  }
+
+  if (sum <= 0.0)
+    return 0.0;
+
+  const double size = this->dataPtr->voxelSize;
+  _centroid = _pose.CoordPositionAdd(sumPos / sum);
+  _centroid.Z() -= 0.5 * size * sumDown / sum;
+  return sum * size * size * size;
+}
@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_COMMON_VOXELVOLUME_HH_
+#define GAZEBO_COMMON_VOXELVOLUME_HH_
+
+#include <functional>
+#include <memory>
+
+#include <ignition/math/AxisAlignedBox.hh>
+#include <ignition/math/Pose3.hh>
+#include <ignition/math/Vector3.hh>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace common
+  {
+    class Mesh;
+    class SubMesh;
+
+    // Forward declare private data class.
+    class VoxelVolumePrivate;
+
+    /// \addtogroup gazebo_common
+    /// \{
+
+    /// \class VoxelVolume VoxelVolume.hh common/common.hh
+    /// \brief A solid approximated by cubic voxels, used to compute the
+    /// volume and center of volume of the part of the solid below a fluid
+    /// surface.
+    ///
+    /// The voxel centers are kept in contiguous coordinate arrays, so the
+    /// submerged volume of many voxels is computed in one pass without
+    /// branches. A voxel crossed by the surface counts for the fraction of
+    /// its height below the surface. The voxels are read only once built,
+    /// so one volume may be shared by several threads.
+    class GZ_COMMON_VISIBLE VoxelVolume
+    {
+      /// \brief Function telling whether a point of the solid frame is
+      /// inside the solid.
+      public: typedef std::function<bool (const ignition::math::Vector3d &)>
+              InsideFunction;
+
+      /// \brief Function giving the height of the fluid surface at a
+      /// point of the world XY plane.
+      public: typedef std::function<double (const double _x,
+                  const double _y)> HeightFunction;
+
+      /// \brief Maximum number of grid cells of a solid. Larger solids use
+      /// larger voxels.
+      public: static const unsigned int kMaxCells = 1u << 21;
+
+      /// \brief Constructor, for an empty volume.
+      public: VoxelVolume();
+
+      /// \brief Destructor.
+      public: virtual ~VoxelVolume();
+
+      /// \brief Build the voxels of a solid from a test of its points.
+      /// \param[in] _box Bounds of the solid, in the solid frame.
+      /// \param[in] _voxelSize Edge length of a voxel.
+      /// \param[in] _inside Test of the voxel centers.
+      public: void Build(const ignition::math::AxisAlignedBox &_box,
+                  const double _voxelSize, const InsideFunction &_inside);
+
+      /// \brief Build the voxels of a closed triangle mesh, by casting a
+      /// ray through each row of voxels.
+      /// \param[in] _mesh The mesh.
+      /// \param[in] _scale Scale of the mesh.
+      /// \param[in] _voxelSize Edge length of a voxel.
+      /// \return False if the mesh has no triangles.
+      public: bool Build(const Mesh &_mesh,
+                  const ignition::math::Vector3d &_scale,
+                  const double _voxelSize);
+
+      /// \brief Build the voxels of a closed triangle submesh.
+      /// \param[in] _subMesh The submesh.
+      /// \param[in] _scale Scale of the submesh.
+      /// \param[in] _voxelSize Edge length of a voxel.
+      /// \return False if the submesh has no triangles.
+      public: bool Build(const SubMesh &_subMesh,
+                  const ignition::math::Vector3d &_scale,
+                  const double _voxelSize);
+
+      /// \brief Get the number of voxels.
+      /// \return Number of voxels inside the solid.
+      public: size_t VoxelCount() const;
+
+      /// \brief Get the edge length of a voxel, which may be larger than
+      /// the one requested to build the volume.
+      /// \return Edge length of a voxel.
+      public: double VoxelSize() const;
+
+      /// \brief Get the volume of the solid.
+      /// \return Volume of the voxels.
+      public: double Volume() const;
+
+      /// \brief Get the center of volume of the solid.
+      /// \return Center of volume in the solid frame.
+      public: ignition::math::Vector3d Centroid() const;
+
+      /// \brief Get the part of the solid below a horizontal fluid surface.
+      /// \param[in] _pose Pose of the solid in the world frame.
+      /// \param[in] _level Height of the fluid surface.
+      /// \param[out] _centroid Center of the submerged volume in the world
+      /// frame, unchanged if nothing is submerged.
+      /// \return Submerged volume.
+      public: double Submerged(const ignition::math::Pose3d &_pose,
+                  const double _level,
+                  ignition::math::Vector3d &_centroid) const;
+
+      /// \brief Get the part of the solid below an uneven fluid surface,
+      /// such as a heightfield or waves.
+      /// \param[in] _pose Pose of the solid in the world frame.
+      /// \param[in] _height Height of the fluid surface.
+      /// \param[out] _centroid Center of the submerged volume in the world
+      /// frame, unchanged if nothing is submerged.
+      /// \return Submerged volume.
+      public: double Submerged(const ignition::math::Pose3d &_pose,
+                  const HeightFunction &_height,
+                  ignition::math::Vector3d &_centroid) const;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<VoxelVolumePrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,173 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <cmath>
+
+#include <ignition/math/Pose3.hh>
+
+#include "gazebo/common/Mesh.hh"
+#include "gazebo/common/VoxelVolume.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class VoxelVolumeTest : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+/// \brief Build the voxels of a box.
+/// \param[in] _size Size of the box.
+/// \param[in] _voxelSize Edge length of a voxel.
+/// \param[out] _volume The voxels.
+static void BuildBox(const ignition::math::Vector3d &_size,
+    const double _voxelSize, common::VoxelVolume &_volume)
+{
+  _volume.Build(ignition::math::AxisAlignedBox(-0.5 * _size, 0.5 * _size),
+      _voxelSize, [](const ignition::math::Vector3d &) {return true;});
+}
+
+/////////////////////////////////////////////////
+TEST_F(VoxelVolumeTest, Box)
+{
+  common::VoxelVolume volume;
+  EXPECT_EQ(0u, volume.VoxelCount());
+  EXPECT_DOUBLE_EQ(0.0, volume.Volume());
+
+  BuildBox(ignition::math::Vector3d(2, 1, 0.5), 0.1, volume);
+  EXPECT_EQ(20u * 10u * 5u, volume.VoxelCount());
+  EXPECT_NEAR(1.0, volume.Volume(), 1e-9);
+  EXPECT_NEAR(0.0, volume.Centroid().Length(), 1e-9);
+
+  // Above the surface
+  ignition::math::Vector3d centroid(7, 7, 7);
+  EXPECT_DOUBLE_EQ(0.0, volume.Submerged(
+        ignition::math::Pose3d(0, 0, 1, 0, 0, 0), 0.0, centroid));
+  EXPECT_EQ(ignition::math::Vector3d(7, 7, 7), centroid);
+
+  // Fully submerged
+  EXPECT_NEAR(1.0, volume.Submerged(
+        ignition::math::Pose3d(1, 2, -1, 0, 0, 0), 0.0, centroid), 1e-9);
+  EXPECT_NEAR(0.0, centroid.Distance(ignition::math::Vector3d(1, 2, -1)),
+      1e-9);
+
+  // Half submerged, the surface crossing voxels
+  for (double level : {0.0, 0.03, -0.11})
+  {
+    const ignition::math::Pose3d pose(0, 0, 0.5, 0, 0, 0.3);
+    const double depth = level + 0.5 - (pose.Pos().Z() - 0.25);
+    EXPECT_NEAR(2.0 * depth, volume.Submerged(pose, level + 0.5, centroid),
+        1e-9);
+    EXPECT_NEAR(0.0, centroid.X(), 1e-9);
+    EXPECT_NEAR(0.0, centroid.Y(), 1e-9);
+    EXPECT_NEAR(0.25 + 0.5 * depth, centroid.Z(), 1e-9);
+  }
+
+  // Turned on its side, the long edge vertical
+  const ignition::math::Pose3d side(0, 0, 0, 0, -IGN_PI / 2.0, 0);
+  EXPECT_NEAR(0.25, volume.Submerged(side, -0.5, centroid), 1e-9);
+  EXPECT_NEAR(-0.75, centroid.Z(), 1e-9);
+
+  // A flat heightfield gives the same result as a plane
+  EXPECT_NEAR(0.25, volume.Submerged(side,
+        [](const double, const double) {return -0.5;}, centroid), 1e-9);
+  EXPECT_NEAR(-0.75, centroid.Z(), 1e-9);
+
+  // A sloped heightfield
+  const double slope = volume.Submerged(ignition::math::Pose3d::Zero,
+        [](const double _x, const double) {return 0.1 * _x;}, centroid);
+  EXPECT_NEAR(0.5, slope, 1e-3);
+  EXPECT_GT(centroid.X(), 0.0);
+}
+
+/////////////////////////////////////////////////
+TEST_F(VoxelVolumeTest, Sphere)
+{
+  const double radius = 0.5;
+  common::VoxelVolume volume;
+  volume.Build(ignition::math::AxisAlignedBox(
+        ignition::math::Vector3d(-radius, -radius, -radius),
+        ignition::math::Vector3d(radius, radius, radius)), 0.02,
+      [radius](const ignition::math::Vector3d &_p)
+      {
+        return _p.Length() <= radius;
+      });
+
+  const double sphere = 4.0 / 3.0 * IGN_PI * std::pow(radius, 3);
+  EXPECT_NEAR(sphere, volume.Volume(), sphere * 0.01);
+
+  // Half submerged
+  ignition::math::Vector3d centroid;
+  EXPECT_NEAR(sphere / 2.0, volume.Submerged(ignition::math::Pose3d::Zero,
+        0.0, centroid), sphere * 0.01);
+  EXPECT_NEAR(-3.0 / 8.0 * radius, centroid.Z(), 0.01);
+}
+
+/////////////////////////////////////////////////
+TEST_F(VoxelVolumeTest, MaxCells)
+{
+  common::VoxelVolume volume;
+  BuildBox(ignition::math::Vector3d(100, 100, 100), 0.01, volume);
+  EXPECT_LE(volume.VoxelCount(), common::VoxelVolume::kMaxCells);
+  EXPECT_GT(volume.VoxelSize(), 0.01);
+  EXPECT_NEAR(1e6, volume.Volume(), 1e6 * 0.05);
+}
+
+/////////////////////////////////////////////////
+TEST_F(VoxelVolumeTest, Mesh)
+{
+  // A closed unit cube, two triangles per face, facing outward
+  common::SubMesh *subMesh = new common::SubMesh();
+  subMesh->SetPrimitiveType(common::SubMesh::TRIANGLES);
+  for (int i = 0; i < 8; ++i)
+  {
+    subMesh->AddVertex((i & 1) ? 0.5 : -0.5, (i & 2) ? 0.5 : -0.5,
+        (i & 4) ? 0.5 : -0.5);
+  }
+  const unsigned int faces[12][3] = {
+    {0, 2, 1}, {1, 2, 3}, {4, 5, 6}, {5, 7, 6},
+    {0, 1, 4}, {1, 5, 4}, {2, 6, 3}, {3, 6, 7},
+    {0, 4, 2}, {2, 4, 6}, {1, 3, 5}, {3, 7, 5}};
+  for (auto const &face : faces)
+  {
+    for (auto index : face)
+      subMesh->AddIndex(index);
+  }
+
+  common::Mesh mesh;
+  mesh.AddSubMesh(subMesh);
+
+  common::VoxelVolume volume;
+  EXPECT_TRUE(volume.Build(mesh, ignition::math::Vector3d(2, 1, 1), 0.1));
+  EXPECT_NEAR(2.0, volume.Volume(), 0.1);
+  EXPECT_NEAR(0.0, volume.Centroid().Length(), 1e-3);
+
+  ignition::math::Vector3d centroid;
+  EXPECT_NEAR(1.0, volume.Submerged(ignition::math::Pose3d::Zero, 0.0,
+        centroid), 0.05);
+  EXPECT_NEAR(-0.25, centroid.Z(), 1e-2);
+
+  // No triangles
+  common::Mesh empty;
+  EXPECT_FALSE(volume.Build(empty, ignition::math::Vector3d::One, 0.1));
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -50,14 +50,32 @@ void help()
   << "  -r [ --record ]               Record state data.\n"
   << "  --record_encoding arg (=zlib) Compression encoding format for log "
   << "data \n"
-  << "                                (zlib|bz2|txt).\n"
+  << "                                (zlib|bz2|zstd|lz4|txt).\n"
   << "  --record_path arg             Absolute path in which to store "
   << "state data.\n"
   << "  --record_period arg (=-1)     Recording period (seconds).\n"
   << "  --record_filter arg           Recording filter (supports wildcard and "
   << "regular expression).\n"
+  << "  --record_keyframe_period arg (=0)\n"
+  << "                                Recording keyframe period (seconds). "
+  << "States in\n"
+  << "                                between keyframes only have the "
+  << "models that\n"
+  << "                                changed.\n"
   << "  --record_resources           Recording with model meshes and "
   << "materials.\n"
+  << "  --record_queue arg (=0)      Number of states queued for "
+  << "recording, so that\n"
+  << "                                the simulation does not wait for the "
+  << "recording\n"
+  << "                                thread.\n"
+  << "  --record_queue_block          Wait for the recording thread when "
+  << "the recording\n"
+  << "                                queue is full, instead of dropping "
+  << "states.\n"
+  << "  --record_topic arg            Record the messages of a topic with "
+  << "the state\n"
+  << "                                (may be repeated).\n"
   << "  --seed arg                    Start with a given random number seed.\n"
   << "  --iters arg                   Number of iterations to simulate.\n"
   << "  --minimal_comms               Reduce the TCP/IP traffic output by "
@@ -70,6 +88,9 @@ void help()
   << "                                the world file.\n"
   << "  --lockstep                    Lockstep simulation so sensor update "
   <<                                  "rates are respected.\n"
+  << "  --lockstep-pipeline           Lockstep simulation with the rendering "
+  <<                                  "sensors one\n"
+  << "                                pose snapshot behind physics.\n"
   << "\n";
 }
 
@@ -14,15 +14,21 @@
  * limitations under the License.
  *
  */
+#include <memory>
+
 #include <sdf/sdf.hh>
 
 #include "gazebo/transport/TransportIface.hh"
 #include "gazebo/common/Plugin.hh"
 #include "gazebo/common/CommonIface.hh"
 #include "gazebo/common/ModelDatabase.hh"
+#include "gazebo/util/TracerService.hh"
 #include "gazebo/gazebo_config.h"
 #include "gazebo_shared.hh"
 
+/// \brief Services controlling the tracer of the process.
+static std::unique_ptr<gazebo::util::TracerService> g_tracerService;
+
 /////////////////////////////////////////////////
 void gazebo_shared::printVersion()
 {
@@ -85,6 +91,15 @@ bool gazebo_shared::setup(const std::string &_prefix, int _argc, char **_argv,
   // Run transport loop. Starts a thread
   gazebo::transport::run();
 
+  // Advertise the tracer services, e.g. /gazebo/server/tracer/enable
+  if (!g_tracerService)
+  {
+    std::string name = _prefix;
+    if (!name.empty() && name.back() == '-')
+      name.pop_back();
+    g_tracerService.reset(new gazebo::util::TracerService(name));
+  }
+
   // Init all system plugins
   for (std::vector<gazebo::SystemPluginPtr>::iterator iter = _plugins.begin();
        iter != _plugins.end(); ++iter)
@@ -20,6 +20,7 @@
 #include <math.h>
 
 #include <ignition/common/Profiler.hh>
+#include <ignition/math/Helpers.hh>
 #include <ignition/math/Matrix4.hh>
 #include <ignition/math/Pose3.hh>
 
@@ -65,7 +66,10 @@ GLWidget::GLWidget(QWidget *_parent)
   this->dataPtr->copyEntityName = "";
   this->dataPtr->modelEditorEnabled = false;
 
+  // A precise timer paces the frames at the render rate, a coarse timer
+  // may fire up to 5% of the period late.
   this->dataPtr->updateTimer = new QTimer(this);
+  this->dataPtr->updateTimer->setTimerType(Qt::PreciseTimer);
   connect(this->dataPtr->updateTimer, SIGNAL(timeout()),
   this, SLOT(update()));
 
@@ -281,6 +285,17 @@ void GLWidget::moveEvent(QMoveEvent *_e)
 /////////////////////////////////////////////////
 void GLWidget::paintEvent(QPaintEvent *_e)
 {
+  {
+    IGN_PROFILE("gui::GLWidget::paintEvent scene commands");
+    std::deque<std::function<void()>> commands;
+    {
+      std::lock_guard<std::mutex> lock(this->dataPtr->sceneCommandMutex);
+      commands.swap(this->dataPtr->sceneCommands);
+    }
+    for (auto &command : commands)
+      command();
+  }
+
   rendering::UserCameraPtr cam = gui::get_active_camera();
   if (cam && cam->Initialized())
   {
@@ -299,6 +314,9 @@ void GLWidget::paintEvent(QPaintEvent *_e)
       IGN_PROFILE("gui::GLWidget::paintEvent post-render");
       event::Events::postRender();
     }
+
+    if (this->dataPtr->hoverPending)
+      this->UpdateHoverCursor();
   }
   else
   {
@@ -723,15 +741,32 @@ void GLWidget::OnMouseMoveNormal()
   if (!this->dataPtr->userCamera)
     return;
 
-  rendering::VisualPtr vis = this->dataPtr->userCamera->Visual(
-      this->dataPtr->mouseEvent.Pos());
+  // Picking on every move would stall on the GPU, so the visual under the
+  // mouse is read back a frame later and the cursor set then
+  this->dataPtr->userCamera->RequestVisual(this->dataPtr->mouseEvent.Pos());
+  this->dataPtr->hoverPending = true;
+
+  this->dataPtr->userCamera->HandleMouseEvent(this->dataPtr->mouseEvent);
+}
+
+/////////////////////////////////////////////////
+void GLWidget::UpdateHoverCursor()
+{
+  if (!this->dataPtr->userCamera || this->dataPtr->state != "select")
+  {
+    this->dataPtr->hoverPending = false;
+    return;
+  }
+
+  bool pending = false;
+  rendering::VisualPtr vis =
+      this->dataPtr->userCamera->RequestedVisual(pending);
+  this->dataPtr->hoverPending = pending;
 
   if (vis && !vis->IsPlane())
     QApplication::setOverrideCursor(Qt::PointingHandCursor);
   else
     QApplication::setOverrideCursor(Qt::ArrowCursor);
-
-  this->dataPtr->userCamera->HandleMouseEvent(this->dataPtr->mouseEvent);
 }
 
 /////////////////////////////////////////////////
@@ -921,6 +956,20 @@ void GLWidget::ViewScene(rendering::ScenePtr _scene)
   // client side heightmap configuration
   _scene->SetHeightmapLOD(gazebo::gui::getINIProperty<int>("heightmap.lod", 0));
 
+  // Parse the meshes of new visuals on worker threads and spread the
+  // creation of the visuals over several frames, so that loading a large
+  // world doesn't freeze the interface. A budget set by the world is kept.
+  if (ignition::math::equal(_scene->VisualBudget(), 0.0))
+  {
+    _scene->SetVisualBudget(gazebo::gui::getINIProperty<double>(
+        "rendering.visual_budget", 0.008));
+  }
+
+  // Optionally trade rendering quality for frame time, e.g. on a laptop
+  // GPU connected to a large remote simulation
+  this->dataPtr->userCamera->SetFrameBudget(
+      gazebo::gui::getINIProperty<double>("rendering.frame_budget", 0.0));
+
   // Update at the camera's update rate
   this->dataPtr->updateTimer->start(
       static_cast<int>(
@@ -936,6 +985,18 @@ void GLWidget::SetRenderRate(double _renderRate)
         std::round(1000.0 / _renderRate))));
 }
 
+/////////////////////////////////////////////////
+void GLWidget::QueueSceneCommand(const std::function<void()> &_command)
+{
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->sceneCommandMutex);
+    this->dataPtr->sceneCommands.push_back(_command);
+  }
+
+  // Make sure a frame runs the command even if rendering is paused
+  QMetaObject::invokeMethod(this, "update", Qt::QueuedConnection);
+}
+
 /////////////////////////////////////////////////
 rendering::ScenePtr GLWidget::Scene() const
 {
@@ -1296,7 +1357,13 @@ void GLWidget::OnSetSelectedEntity(const std::string &_name,
 /////////////////////////////////////////////////
 void GLWidget::OnRequest(ConstRequestPtr &_msg)
 {
-  if (_msg->request() == "entity_delete")
+  if (_msg->request() != "entity_delete")
+    return;
+
+  // Called from a transport thread, the manipulator and the paste action
+  // are updated with the next frame on the GUI thread.
+  const std::string name = _msg->data();
+  this->QueueSceneCommand([this, name]()
   {
     std::lock_guard<std::mutex> lock(this->dataPtr->selectedVisMutex);
     if (!this->dataPtr->selectedVisuals.empty())
@@ -1306,7 +1373,7 @@ void GLWidget::OnRequest(ConstRequestPtr &_msg)
           it != this->dataPtr->selectedVisuals.end();
           ++it)
       {
-        if ((*it)->Name() == _msg->data())
+        if ((*it)->Name() == name)
         {
           ModelManipulator::Instance()->Detach();
           this->dataPtr->selectedVisuals.erase(it);
@@ -1315,12 +1382,12 @@ void GLWidget::OnRequest(ConstRequestPtr &_msg)
       }
     }
 
-    if (this->dataPtr->copyEntityName == _msg->data())
+    if (this->dataPtr->copyEntityName == name)
     {
       this->dataPtr->copyEntityName = "";
       g_pasteAct->setEnabled(false);
     }
-  }
+  });
 }
 
 /////////////////////////////////////////////////
@@ -17,6 +17,7 @@
 #ifndef GAZEBO_GUI_GLWIDGET_HH_
 #define GAZEBO_GUI_GLWIDGET_HH_
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -78,6 +79,13 @@ namespace gazebo
       /// \param[in] _renderRate Updated render rate
       public: void SetRenderRate(double _renderRate);
 
+      /// \brief Queue a scene edit to run on the GUI thread at the start of
+      /// the next frame, before the scene is updated and rendered. This may
+      /// be called from any thread, e.g. from a transport callback, which
+      /// must not edit the scene directly.
+      /// \param[in] _command Function editing the scene.
+      public: void QueueSceneCommand(const std::function<void()> &_command);
+
       signals: void clicked();
 
       /// \brief QT signal to notify when we received a selection msg.
@@ -120,6 +128,10 @@ namespace gazebo
       /// \brief Process a normal mouse move event.
       private: void OnMouseMoveNormal();
 
+      /// \brief Set the cursor from the visual found under the mouse by the
+      /// last hover request.
+      private: void UpdateHoverCursor();
+
       /// \brief Process a make object mouse move event.
       private: void OnMouseMoveMakeEntity();
 
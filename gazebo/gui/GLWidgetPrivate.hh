@@ -17,6 +17,8 @@
 #ifndef _GAZEBO_GUI_GLWIDGET_PRIVATE_HH_
 #define _GAZEBO_GUI_GLWIDGET_PRIVATE_HH_
 
+#include <deque>
+#include <functional>
 #include <mutex>
 #include <string>
 #include <vector>
@@ -115,8 +117,17 @@ namespace gazebo
       /// \brief Timer used to update the render window.
       public: QTimer *updateTimer = nullptr;
 
+      /// \brief Scene edits to run at the start of the next frame.
+      public: std::deque<std::function<void()>> sceneCommands;
+
+      /// \brief Mutex to protect sceneCommands.
+      public: std::mutex sceneCommandMutex;
+
       /// \brief Time when the last wheel event was processed
       public: common::Time lastWheelEventTime;
+
+      /// \brief True if the cursor waits for the result of a hover request.
+      public: bool hoverPending = false;
     };
   }
 }
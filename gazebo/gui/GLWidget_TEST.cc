@@ -15,6 +15,8 @@
  *
 */
 #include <boost/filesystem.hpp>
+#include <thread>
+#include <vector>
 #include "gazebo/common/KeyEvent.hh"
 #include "gazebo/msgs/msgs.hh"
 #include "gazebo/transport/transport.hh"
@@ -92,5 +94,61 @@ void GLWidget_TEST::SelectObject()
   delete mainWindow;
 }
 
+/////////////////////////////////////////////////
+void GLWidget_TEST::SceneCommands()
+{
+  this->resMaxPercentChange = 5.0;
+  this->shareMaxPercentChange = 2.0;
+
+  this->Load("worlds/empty.world", false, false, false);
+
+  gazebo::gui::MainWindow *mainWindow = new gazebo::gui::MainWindow();
+  QVERIFY(mainWindow != nullptr);
+
+  mainWindow->Load();
+  mainWindow->Init();
+  mainWindow->show();
+
+  this->ProcessEventsAndDraw(mainWindow);
+
+  gazebo::gui::GLWidget *glWidget =
+      mainWindow->findChild<gazebo::gui::GLWidget *>("GLWidget");
+  QVERIFY(glWidget != nullptr);
+
+  // Queue commands from another thread
+  const std::thread::id guiThread = std::this_thread::get_id();
+  std::vector<int> order;
+  bool onGuiThread = true;
+  std::thread thread([&]()
+  {
+    for (int i = 0; i < 10; ++i)
+    {
+      glWidget->QueueSceneCommand([&, i]()
+      {
+        onGuiThread = onGuiThread && std::this_thread::get_id() == guiThread;
+        order.push_back(i);
+      });
+    }
+  });
+  thread.join();
+
+  int sleep = 0;
+  int maxSleep = 50;
+  while (order.size() < 10u && sleep < maxSleep)
+  {
+    QCoreApplication::processEvents();
+    QTest::qWait(10);
+    sleep++;
+  }
+
+  QVERIFY(order.size() == 10u);
+  for (int i = 0; i < 10; ++i)
+    QCOMPARE(order[i], i);
+  QVERIFY(onGuiThread);
+
+  mainWindow->close();
+  delete mainWindow;
+}
+
 // Generate a main function for the test
 QTEST_MAIN(GLWidget_TEST)
@@ -27,6 +27,10 @@ class GLWidget_TEST : public QTestFixture
 
   /// \brief Test selecting an object.
   private slots: void SelectObject();
+
+  /// \brief Test that scene commands queued from another thread run in
+  /// order on the GUI thread.
+  private slots: void SceneCommands();
 };
 
 #endif
@@ -22,6 +22,7 @@
 #endif
 
 #include <signal.h>
+#include <vector>
 #include <boost/program_options.hpp>
 #include <boost/property_tree/ini_parser.hpp>
 
@@ -35,6 +36,7 @@
 #include "gazebo/common/ModelDatabase.hh"
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Plugin.hh"
+#include "gazebo/common/Tracer.hh"
 #include "gazebo/common/CommonTypes.hh"
 #include "gazebo/gui/SplashScreen.hh"
 #include "gazebo/gui/MainWindow.hh"
@@ -87,6 +89,10 @@ Q_DECLARE_METATYPE(std::string)
 // qRegisterMetaType is also required, see below.
 Q_DECLARE_METATYPE(std::set<std::string>)
 
+// This makes it possible to use std::vector<float> in QT signals and slots.
+// qRegisterMetaType is also required, see below.
+Q_DECLARE_METATYPE(std::vector<float>)
+
 // This makes it possible to use ignition::msgs::JointCmd in signals and slots.
 // qRegisterMetaType is also required, see below.
 Q_DECLARE_METATYPE(ignition::msgs::JointCmd)
@@ -384,6 +390,7 @@ unsigned int gui::get_entity_id(const std::string &_name)
 bool gui::run(int _argc, char **_argv)
 {
   IGN_PROFILE_THREAD_NAME("gzclient");
+  common::Tracer::Instance()->SetThreadName("gzclient");
 
   // Initialize the informational logger. This will log warnings, and errors.
   gzLogInit("client-", "gzclient.log");
@@ -509,6 +516,10 @@ bool gui::register_metatypes()
   // slots. Q_DECLARE_METATYPE is also required, see above.
   qRegisterMetaType< std::set<std::string> >();
 
+  // Register std::vector<float> as a type that can be used in signals and
+  // slots. Q_DECLARE_METATYPE is also required, see above.
+  qRegisterMetaType< std::vector<float> >();
+
   // Register ignition::msgs::JointCmd as a type that can be used in signals and
   // slots. Q_DECLARE_METATYPE is also required, see above.
   qRegisterMetaType<ignition::msgs::JointCmd>();
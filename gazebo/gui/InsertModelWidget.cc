@@ -14,9 +14,12 @@
  * limitations under the License.
  *
  */
+#include <algorithm>
 #include <functional>
 #include <fstream>
 #include <cstdlib>
+#include <list>
+#include <sstream>
 
 #include <boost/bind/bind.hpp>
 #include <boost/filesystem.hpp>
@@ -46,6 +49,12 @@
 using namespace gazebo;
 using namespace gui;
 
+#ifdef _WIN32
+# define HOMEDIR "HOMEPATH"
+#else
+# define HOMEDIR "HOME"
+#endif
+
 static bool gInsertModelWidgetDeleted = false;
 
 /////////////////////////////////////////////////
@@ -87,6 +96,19 @@ InsertModelWidget::InsertModelWidget(QWidget *_parent)
   // Create a system path watcher
   this->dataPtr->watcher = new QFileSystemWatcher();
 
+  // Local paths are scanned by a background thread, so that large model
+  // libraries don't delay the window. The models found by the previous
+  // session are listed while the paths are scanned again.
+  const char *home = getenv(HOMEDIR);
+  if (home)
+  {
+    this->dataPtr->indexFilename = (boost::filesystem::path(home) /
+        ".gazebo" / "model_paths.index").string();
+  }
+  this->LoadIndex();
+  this->dataPtr->scanThread =
+      std::thread(&InsertModelWidget::RunScanThread, this);
+
   // Update the list of models on the local system.
   this->UpdateAllLocalPaths();
 
@@ -113,11 +135,11 @@ InsertModelWidget::InsertModelWidget(QWidget *_parent)
     size_t pos2 = additionalPaths.find(delim);
     while (pos2 != std::string::npos)
     {
-      this->UpdateLocalPath(additionalPaths.substr(pos1, pos2-pos1));
+      this->QueueLocalPath(additionalPaths.substr(pos1, pos2-pos1));
       pos1 = pos2+1;
       pos2 = additionalPaths.find(delim, pos2+1);
     }
-    this->UpdateLocalPath(additionalPaths.substr(pos1,
+    this->QueueLocalPath(additionalPaths.substr(pos1,
           additionalPaths.size()-pos1));
   }
 
@@ -133,16 +155,29 @@ InsertModelWidget::InsertModelWidget(QWidget *_parent)
           common::SystemPaths::Instance()->updateModelRequest.Connect(
             boost::bind(&InsertModelWidget::OnModelUpdateRequest, this, _1)));
 
-  // Non-blocking call to get all the models in the database.
-  this->dataPtr->getModelsConnection =
-    common::ModelDatabase::Instance()->GetModels(
-        boost::bind(&InsertModelWidget::OnModels, this, _1));
-
   // Use a signal/slot to populate the Ignition Fuel servers within the QT
   // thread.
   this->connect(this, SIGNAL(UpdateFuel(const std::string &)),
       this, SLOT(OnUpdateFuel(const std::string &)));
 
+  // The online databases are requested when the widget is first shown.
+}
+
+/////////////////////////////////////////////////
+void InsertModelWidget::showEvent(QShowEvent *_event)
+{
+  QWidget::showEvent(_event);
+
+  if (this->dataPtr->onlineRequested)
+    return;
+  this->dataPtr->onlineRequested = true;
+
+  // Non-blocking call to get all the models in the database.
+  using namespace boost::placeholders;
+  this->dataPtr->getModelsConnection =
+    common::ModelDatabase::Instance()->GetModels(
+        boost::bind(&InsertModelWidget::OnModels, this, _1));
+
   // Populate the list of Ignition Fuel servers.
   this->PopulateFuelServers();
 
@@ -170,7 +205,7 @@ void InsertModelWidget::HandleButton()
     common::SystemPaths::Instance()->AddModelPaths(
       selected[0].toStdString());
 
-    this->UpdateLocalPath(selected[0].toStdString());
+    this->QueueLocalPath(selected[0].toStdString());
   }
 }
 
@@ -178,6 +213,16 @@ void InsertModelWidget::HandleButton()
 InsertModelWidget::~InsertModelWidget()
 {
   gInsertModelWidgetDeleted = true;
+
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->scanMutex);
+    this->dataPtr->scanStop = true;
+  }
+  this->dataPtr->scanCondition.notify_all();
+  if (this->dataPtr->scanThread.joinable())
+    this->dataPtr->scanThread.join();
+  this->SaveIndex();
+
   delete this->dataPtr->watcher;
   delete this->dataPtr;
   this->dataPtr = NULL;
@@ -326,116 +371,330 @@ void InsertModelWidget::UpdateLocalPath(const std::string &_path)
   if (_path.empty())
     return;
 
-  boost::filesystem::path dir(_path);
-  bool pathExists = this->IsPathAccessible(dir);
+  // Create the tree item first, so the path is watched during the scan.
+  this->LocalPathItem(_path);
+
+  std::vector<LocalModelEntry> indexed;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->scanMutex);
+    auto iter = this->dataPtr->modelIndex.find(_path);
+    if (iter != this->dataPtr->modelIndex.end())
+      indexed = iter->second;
+  }
+
+  std::vector<LocalModelEntry> models = this->ScanLocalPath(_path, indexed);
+
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->scanMutex);
+    this->dataPtr->modelIndex[_path] = models;
+
+    // An older background scan of the path must not replace this one.
+    this->dataPtr->scanResults.erase(_path);
+  }
+
+  this->PopulateLocalPath(_path, models);
+}
+
+/////////////////////////////////////////////////
+void InsertModelWidget::QueueLocalPath(const std::string &_path)
+{
+  if (_path.empty())
+    return;
+
+  QTreeWidgetItem *topItem = this->LocalPathItem(_path);
+
+  std::vector<LocalModelEntry> indexed;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->scanMutex);
+    auto iter = this->dataPtr->modelIndex.find(_path);
+    if (iter != this->dataPtr->modelIndex.end())
+      indexed = iter->second;
+
+    if (std::find(this->dataPtr->scanQueue.begin(),
+          this->dataPtr->scanQueue.end(), _path) ==
+        this->dataPtr->scanQueue.end())
+    {
+      this->dataPtr->scanQueue.push_back(_path);
+    }
+  }
+  this->dataPtr->scanCondition.notify_one();
+
+  // List the models found by the previous scan until this one is done.
+  if (topItem->childCount() == 0 && !indexed.empty())
+    this->PopulateLocalPath(_path, indexed);
+}
 
+/////////////////////////////////////////////////
+QTreeWidgetItem *InsertModelWidget::LocalPathItem(const std::string &_path)
+{
   QString qpath = QString::fromStdString(_path);
-  QTreeWidgetItem *topItem = NULL;
 
   QList<QTreeWidgetItem *> matchList =
     this->dataPtr->fileTreeWidget->findItems(qpath, Qt::MatchExactly);
+  if (!matchList.empty())
+    return matchList.first();
 
   // Create a top-level tree item for the path
-  if (matchList.empty())
+  QTreeWidgetItem *topItem = new QTreeWidgetItem(
+      static_cast<QTreeWidgetItem*>(0), QStringList(qpath));
+  this->dataPtr->fileTreeWidget->addTopLevelItem(topItem);
+  this->dataPtr->localFilenameCache.insert(_path);
+
+  // Add the new path to the directory watcher
+  if (this->IsPathAccessible(boost::filesystem::path(_path)))
+    this->dataPtr->watcher->addPath(qpath);
+
+  return topItem;
+}
+
+/////////////////////////////////////////////////
+std::vector<LocalModelEntry> InsertModelWidget::ScanLocalPath(
+    const std::string &_path,
+    const std::vector<LocalModelEntry> &_indexed) const
+{
+  std::vector<LocalModelEntry> models;
+
+  boost::filesystem::path dir(_path);
+  if (!this->IsPathAccessible(dir) || !boost::filesystem::is_directory(dir))
+    return models;
+
+  std::vector<boost::filesystem::path> paths;
+
+  // Get all the paths in alphabetical order
+  try
+  {
+    std::copy(boost::filesystem::directory_iterator(dir),
+        boost::filesystem::directory_iterator(),
+        std::back_inserter(paths));
+  }
+  catch(boost::filesystem::filesystem_error & e)
+  {
+    gzerr << "Not loading models in: " << _path << " ("
+          << e.what() << ")" << std::endl;
+    return models;
+  }
+
+  std::sort(paths.begin(), paths.end());
+
+  std::map<std::string, const LocalModelEntry *> indexed;
+  for (auto const &entry : _indexed)
+    indexed[entry.dir] = &entry;
+
+  // Iterate over all the models in the current gazebo path
+  for (auto const &dIter : paths)
   {
-    topItem = new QTreeWidgetItem(
-        static_cast<QTreeWidgetItem*>(0), QStringList(qpath));
-    this->dataPtr->fileTreeWidget->addTopLevelItem(topItem);
-    this->dataPtr->localFilenameCache.insert(_path);
+    if (this->dataPtr->scanStop)
+      break;
+
+    boost::filesystem::path fullPath = _path / dIter.filename();
+    boost::filesystem::path manifest = fullPath;
 
-    // Add the new path to the directory watcher
-    if (pathExists)
+    if (!boost::filesystem::is_directory(fullPath))
     {
-      this->dataPtr->watcher->addPath(qpath);
+      if (dIter.filename() != "database.config")
+      {
+        gzlog << "Invalid filename or directory[" << fullPath
+          << "] in GAZEBO_MODEL_PATH. It's not a good idea to put extra "
+          << "files in a GAZEBO_MODEL_PATH because the file structure may"
+          << " be modified by Gazebo.\n";
+      }
+      continue;
     }
-  }
-  else
-    topItem = matchList.first();
 
-  // Remove current items.
-  topItem->takeChildren();
+    manifest /= GZ_MODEL_MANIFEST_FILENAME;
 
-  if (pathExists && boost::filesystem::is_directory(dir))
-  {
-    std::vector<boost::filesystem::path> paths;
+    // Check if the manifest does not exists
+    if (!this->IsPathAccessible(manifest))
+    {
+      gzerr << "Missing " << GZ_MODEL_MANIFEST_FILENAME << " for model "
+        << dIter << "\n";
 
-    // Get all the paths in alphabetical order
+      manifest = manifest / "manifest.xml";
+    }
+
+    if (!this->IsPathAccessible(manifest) || manifest == fullPath)
+    {
+      gzlog << "model.config file is missing in directory["
+            << fullPath << "]\n";
+      continue;
+    }
+
+    LocalModelEntry entry;
+    entry.dir = fullPath.string();
     try
     {
-      std::copy(boost::filesystem::directory_iterator(dir),
-          boost::filesystem::directory_iterator(),
-          std::back_inserter(paths));
+      entry.manifestTime = boost::filesystem::last_write_time(manifest);
     }
-    catch(boost::filesystem::filesystem_error & e)
+    catch(boost::filesystem::filesystem_error &)
     {
-      gzerr << "Not loading models in: " << _path << " ("
-            << e.what() << ")" << std::endl;
-      return;
+      entry.manifestTime = 0;
     }
 
-    std::sort(paths.begin(), paths.end());
+    // Reuse the name of an unchanged manifest
+    auto indexedIter = indexed.find(entry.dir);
+    if (entry.manifestTime != 0 && indexedIter != indexed.end() &&
+        indexedIter->second->manifestTime == entry.manifestTime)
+    {
+      models.push_back(*indexedIter->second);
+      continue;
+    }
 
-    // Iterate over all the models in the current gazebo path
-    for (std::vector<boost::filesystem::path>::iterator dIter = paths.begin();
-        dIter != paths.end(); ++dIter)
+    TiXmlDocument xmlDoc;
+    if (xmlDoc.LoadFile(manifest.string()))
     {
-      std::string modelName;
-      boost::filesystem::path fullPath = _path / dIter->filename();
-      boost::filesystem::path manifest = fullPath;
+      TiXmlElement *modelXML = xmlDoc.FirstChildElement("model");
+      if (!modelXML || !modelXML->FirstChildElement("name"))
+        gzerr << "No model name in manifest[" << manifest << "]\n";
+      else
+        entry.name = modelXML->FirstChildElement("name")->GetText();
+      models.push_back(entry);
+    }
+  }
 
-      if (!boost::filesystem::is_directory(fullPath))
-      {
-        if (dIter->filename() != "database.config")
+  return models;
+}
+
+/////////////////////////////////////////////////
+void InsertModelWidget::PopulateLocalPath(const std::string &_path,
+    const std::vector<LocalModelEntry> &_models)
+{
+  QTreeWidgetItem *topItem = this->LocalPathItem(_path);
+
+  // Remove current items.
+  qDeleteAll(topItem->takeChildren());
+
+  QList<QTreeWidgetItem *> childItems;
+  for (auto const &model : _models)
+  {
+    // Add a child item for the model
+    QTreeWidgetItem *childItem = new QTreeWidgetItem(
+        QStringList(QString::fromStdString(model.name)));
+
+    childItem->setData(0, Qt::UserRole,
+        QVariant((std::string("file://") + model.dir).c_str()));
+
+    childItems.append(childItem);
+    this->dataPtr->localFilenameCache.insert(model.dir);
+  }
+  topItem->addChildren(childItems);
+
+  // Make all top-level items expanded. Trying to reduce mouse clicks.
+  this->dataPtr->fileTreeWidget->expandItem(topItem);
+}
+
+/////////////////////////////////////////////////
+void InsertModelWidget::RunScanThread()
+{
+  std::unique_lock<std::mutex> lock(this->dataPtr->scanMutex);
+  while (true)
+  {
+    this->dataPtr->scanCondition.wait(lock, [this]
         {
-          gzlog << "Invalid filename or directory[" << fullPath
-            << "] in GAZEBO_MODEL_PATH. It's not a good idea to put extra "
-            << "files in a GAZEBO_MODEL_PATH because the file structure may"
-            << " be modified by Gazebo.\n";
-        }
-        continue;
-      }
+          return this->dataPtr->scanStop || !this->dataPtr->scanQueue.empty();
+        });
+    if (this->dataPtr->scanStop)
+      return;
 
-      manifest /= GZ_MODEL_MANIFEST_FILENAME;
+    std::string path = this->dataPtr->scanQueue.front();
+    this->dataPtr->scanQueue.pop_front();
+    std::vector<LocalModelEntry> indexed = this->dataPtr->modelIndex[path];
 
-      // Check if the manifest does not exists
-      if (!this->IsPathAccessible(manifest))
-      {
-        gzerr << "Missing " << GZ_MODEL_MANIFEST_FILENAME << " for model "
-          << (*dIter) << "\n";
+    // Scan without holding the lock, which may take a while on network
+    // storage.
+    lock.unlock();
+    std::vector<LocalModelEntry> models = this->ScanLocalPath(path, indexed);
+    lock.lock();
 
-        manifest = manifest / "manifest.xml";
-      }
+    if (this->dataPtr->scanStop)
+      return;
 
-       if (!this->IsPathAccessible(manifest) || manifest == fullPath)
-      {
-        gzlog << "model.config file is missing in directory["
-              << fullPath << "]\n";
-        continue;
-      }
+    this->dataPtr->modelIndex[path] = models;
+    this->dataPtr->scanResults[path] = models;
 
-      TiXmlDocument xmlDoc;
-      if (xmlDoc.LoadFile(manifest.string()))
-      {
-        TiXmlElement *modelXML = xmlDoc.FirstChildElement("model");
-        if (!modelXML || !modelXML->FirstChildElement("name"))
-          gzerr << "No model name in manifest[" << manifest << "]\n";
-        else
-          modelName = modelXML->FirstChildElement("name")->GetText();
-        // Add a child item for the model
-        QTreeWidgetItem *childItem = new QTreeWidgetItem(topItem,
-            QStringList(QString::fromStdString(modelName)));
+    // Add the models in the QT thread.
+    QMetaObject::invokeMethod(this, "OnLocalPathsScanned",
+        Qt::QueuedConnection);
+  }
+}
 
-        childItem->setData(0, Qt::UserRole,
-            QVariant((std::string("file://") + fullPath.string()).c_str()));
+/////////////////////////////////////////////////
+void InsertModelWidget::OnLocalPathsScanned()
+{
+  std::map<std::string, std::vector<LocalModelEntry>> results;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->scanMutex);
+    results.swap(this->dataPtr->scanResults);
+  }
 
-        this->dataPtr->fileTreeWidget->addTopLevelItem(childItem);
-        this->dataPtr->localFilenameCache.insert(fullPath.string());
-      }
+  boost::mutex::scoped_lock lock(this->dataPtr->mutex);
+  for (auto const &result : results)
+    this->PopulateLocalPath(result.first, result.second);
+}
+
+/////////////////////////////////////////////////
+void InsertModelWidget::LoadIndex()
+{
+  if (this->dataPtr->indexFilename.empty())
+    return;
+
+  // The index doesn't exist before the first session.
+  std::ifstream ifs(this->dataPtr->indexFilename.c_str());
+  if (!ifs.is_open())
+    return;
+
+  // Each line is: path, model directory, manifest time and model name,
+  // separated by tabs.
+  std::string line;
+  while (std::getline(ifs, line))
+  {
+    std::istringstream stream(line);
+    std::string path;
+    std::string time;
+    LocalModelEntry entry;
+    if (!std::getline(stream, path, '\t') ||
+        !std::getline(stream, entry.dir, '\t') ||
+        !std::getline(stream, time, '\t'))
+    {
+      continue;
     }
+    std::getline(stream, entry.name);
+
+    try
+    {
+      entry.manifestTime = boost::lexical_cast<std::time_t>(time);
+    }
+    catch(boost::bad_lexical_cast &)
+    {
+      continue;
+    }
+
+    this->dataPtr->modelIndex[path].push_back(entry);
   }
+}
 
-  // Make all top-level items expanded. Trying to reduce mouse clicks.
-  this->dataPtr->fileTreeWidget->expandItem(topItem);
+/////////////////////////////////////////////////
+void InsertModelWidget::SaveIndex() const
+{
+  if (this->dataPtr->indexFilename.empty())
+    return;
+
+  std::ofstream ofs(this->dataPtr->indexFilename.c_str(),
+      std::ios::out | std::ios::trunc);
+  if (!ofs.is_open())
+  {
+    gzlog << "Unable to save the model path index["
+          << this->dataPtr->indexFilename << "]\n";
+    return;
+  }
+
+  for (auto const &path : this->dataPtr->modelIndex)
+  {
+    for (auto const &entry : path.second)
+    {
+      ofs << path.first << '\t' << entry.dir << '\t' << entry.manifestTime
+          << '\t' << entry.name << '\n';
+    }
+  }
 }
 
 /////////////////////////////////////////////////
@@ -449,7 +708,7 @@ void InsertModelWidget::UpdateAllLocalPaths()
       iter != gazeboPaths.end(); ++iter)
   {
     // This is the full model path
-    this->UpdateLocalPath((*iter));
+    this->QueueLocalPath((*iter));
   }
 }
 
@@ -457,12 +716,14 @@ void InsertModelWidget::UpdateAllLocalPaths()
 void InsertModelWidget::OnDirectoryChanged(const QString &_path)
 {
   boost::mutex::scoped_lock lock(this->dataPtr->mutex);
-  this->UpdateLocalPath(_path.toStdString());
+  this->QueueLocalPath(_path.toStdString());
 }
 
 /////////////////////////////////////////////////
 void InsertModelWidget::OnModelUpdateRequest(const std::string &_path)
 {
+  // Paths added while running are scanned right away, so their models are
+  // listed when SystemPaths::AddModelPathsUpdate returns.
   boost::mutex::scoped_lock lock(this->dataPtr->mutex);
   this->UpdateLocalPath(_path);
 }
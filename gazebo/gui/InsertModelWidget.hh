@@ -42,6 +42,7 @@ namespace gazebo
   {
     // Forward declaration.
     class InsertModelWidgetPrivate;
+    class LocalModelEntry;
 
     class GZ_GUI_VISIBLE InsertModelWidget : public QWidget
     {
@@ -56,6 +57,11 @@ namespace gazebo
       /// \brief Check if input path is in the fileTreeWidget.
       public: bool LocalPathInFileWidget(const std::string &_path);
 
+      /// \brief Request the models of the online databases the first time
+      /// the widget is shown.
+      /// \param[in] _event The show event.
+      protected: virtual void showEvent(QShowEvent *_event);
+
       /// \brief Callback triggered when the ModelDatabase has returned
       /// the list of models.
       /// \param[in] _models The map of all models in the database.
@@ -91,19 +97,59 @@ namespace gazebo
       /// \brief QT callback when addPathButton is clicked.
       private slots: void HandleButton();
 
+      /// \brief Add the models of the paths scanned by the background
+      /// thread to the tree widget.
+      private slots: void OnLocalPathsScanned();
+
       /// \brief check if path exists with special care to filesystem
       /// permissions
       /// \param[in] _path The path to check.
       private: static bool IsPathAccessible
         (const boost::filesystem::path &_path);
 
-      /// \brief Update the list of models on the local system.
+      /// \brief Queue all the model paths of the local system to be scanned.
       private: void UpdateAllLocalPaths();
 
-      /// \brief Update a specific path.
+      /// \brief Update a specific path, scanning it right away.
       /// \param[in] _path The path to update.
       private: void UpdateLocalPath(const std::string &_path);
 
+      /// \brief Queue a path to be scanned by the background thread. The
+      /// models of the path stored in the index are listed until the scan
+      /// is done.
+      /// \param[in] _path The path to update.
+      private: void QueueLocalPath(const std::string &_path);
+
+      /// \brief Get the top-level tree item of a path, creating it and
+      /// watching the path if it is new.
+      /// \param[in] _path The path.
+      /// \return The tree item of the path.
+      private: QTreeWidgetItem *LocalPathItem(const std::string &_path);
+
+      /// \brief Find the models in a path.
+      /// \param[in] _path The path to scan.
+      /// \param[in] _indexed The models of the path found by the previous
+      /// scan, whose manifests are not parsed again if unchanged.
+      /// \return The models found, sorted by directory.
+      private: std::vector<LocalModelEntry> ScanLocalPath(
+                   const std::string &_path,
+                   const std::vector<LocalModelEntry> &_indexed) const;
+
+      /// \brief Replace the models listed under a path.
+      /// \param[in] _path The path.
+      /// \param[in] _models The models of the path.
+      private: void PopulateLocalPath(const std::string &_path,
+                   const std::vector<LocalModelEntry> &_models);
+
+      /// \brief Scan the queued paths until the widget is destroyed.
+      private: void RunScanThread();
+
+      /// \brief Load the index of local models saved by a previous session.
+      private: void LoadIndex();
+
+      /// \brief Save the index of local models.
+      private: void SaveIndex() const;
+
       /// \brief Populate the model tree widget with the list of all available
       /// Ignition Fuel servers providing models.
       private: void InitializeFuelServers();
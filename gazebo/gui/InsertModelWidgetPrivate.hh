@@ -17,10 +17,16 @@
 #ifndef GAZEBO_GUI_INSERTMODELWIDGETPRIVATE_HH_
 #define GAZEBO_GUI_INSERTMODELWIDGETPRIVATE_HH_
 
+#include <atomic>
+#include <condition_variable>
+#include <ctime>
+#include <deque>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
+#include <thread>
 #include <vector>
 #include <boost/thread/mutex.hpp>
 
@@ -54,6 +60,19 @@ namespace gazebo
       public: std::vector<ignition::fuel_tools::ModelIdentifier> modelBuffer;
     };
 
+    /// \brief A model found in a local model path.
+    class LocalModelEntry
+    {
+      /// \brief Full path of the model directory.
+      public: std::string dir;
+
+      /// \brief Name of the model read from its manifest.
+      public: std::string name;
+
+      /// \brief Last write time of the manifest when it was parsed.
+      public: std::time_t manifestTime = 0;
+    };
+
     /// \brief Private class attributes for InsertModelWidget.
     class InsertModelWidgetPrivate
     {
@@ -85,6 +104,33 @@ namespace gazebo
 
       /// \brief A client for using Ignition Fuel services.
       public: std::unique_ptr<ignition::fuel_tools::FuelClient> fuelClient;
+
+      /// \brief True once the online databases have been requested.
+      public: bool onlineRequested = false;
+
+      /// \brief Thread scanning the queued local paths.
+      public: std::thread scanThread;
+
+      /// \brief Mutex to protect the scan queue, results and index.
+      public: std::mutex scanMutex;
+
+      /// \brief Notified when a path is queued or the thread must stop.
+      public: std::condition_variable scanCondition;
+
+      /// \brief Paths waiting to be scanned.
+      public: std::deque<std::string> scanQueue;
+
+      /// \brief Set to stop the scan thread.
+      public: std::atomic<bool> scanStop{false};
+
+      /// \brief Models of the paths scanned but not yet added to the tree.
+      public: std::map<std::string, std::vector<LocalModelEntry>> scanResults;
+
+      /// \brief Models of each scanned path, saved between sessions.
+      public: std::map<std::string, std::vector<LocalModelEntry>> modelIndex;
+
+      /// \brief File the index is saved to, empty to not save it.
+      public: std::string indexFilename;
     };
   }
 }
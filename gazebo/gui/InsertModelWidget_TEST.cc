@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <string>
+
+#include "gazebo/common/SystemPaths.hh"
+#include "gazebo/gui/InsertModelWidget.hh"
+#include "gazebo/gui/InsertModelWidget_TEST.hh"
+
+#include "test_config.h"
+
+/////////////////////////////////////////////////
+void InsertModelWidget_TEST::LocalPaths()
+{
+  this->Load("worlds/empty.world");
+
+  const std::string scanPath =
+      PROJECT_SOURCE_PATH "/test/models/test_nested_urdf";
+  gazebo::common::SystemPaths::Instance()->AddModelPaths(scanPath);
+
+  gazebo::gui::InsertModelWidget *insertModelWidget =
+      new gazebo::gui::InsertModelWidget;
+
+  // The path is listed right away, while its models are found by the
+  // background scan.
+  QVERIFY(insertModelWidget->LocalPathInFileWidget(scanPath));
+
+  auto tree = insertModelWidget->findChildren<QTreeWidget *>();
+  QVERIFY(tree.size() == 1u);
+
+  int sleep = 0;
+  int maxSleep = 50;
+  while (tree[0]->findItems(QString("model_urdf"),
+      Qt::MatchContains | Qt::MatchRecursive).empty() && sleep < maxSleep)
+  {
+    QCoreApplication::processEvents();
+    QTest::qWait(100);
+    ++sleep;
+  }
+  QVERIFY(sleep < maxSleep);
+  QVERIFY(insertModelWidget->LocalPathInFileWidget(
+      scanPath + "/model_urdf"));
+
+  // A path added while running is scanned right away.
+  const std::string addedPath = PROJECT_SOURCE_PATH "/test/models/testdb";
+  gazebo::common::SystemPaths::Instance()->AddModelPathsUpdate(addedPath);
+  QVERIFY(insertModelWidget->LocalPathInFileWidget(addedPath));
+  QVERIFY(!tree[0]->findItems(QString("cococan"),
+      Qt::MatchContains | Qt::MatchRecursive).empty());
+
+  delete insertModelWidget;
+}
+
+// Generate a main function for the test
+QTEST_MAIN(InsertModelWidget_TEST)
@@ -138,6 +138,8 @@ LogPlayWidget::LogPlayWidget(QWidget *_parent)
       SLOT(SetStartTime(common::Time)));
   connect(this, SIGNAL(SetEndTime(common::Time)), this->dataPtr->view,
       SLOT(SetEndTime(common::Time)));
+  connect(this, SIGNAL(SetActivity(std::vector<float>)), this->dataPtr->view,
+      SLOT(SetActivity(std::vector<float>)));
 
   // Current time fields
   // Day edit
@@ -317,11 +319,7 @@ void LogPlayWidget::SetPaused(const bool _paused)
     emit HidePause();
 
     // Check if there are pending steps and publish now that it's paused
-    if (this->dataPtr->pendingStep != 0)
-    {
-      this->PublishMultistep(this->dataPtr->pendingStep);
-      this->dataPtr->pendingStep = 0;
-    }
+    this->SendPendingControls();
   }
   else
   {
@@ -349,31 +347,29 @@ void LogPlayWidget::OnPause()
 /////////////////////////////////////////////////
 void LogPlayWidget::OnStepForward()
 {
-  if (this->dataPtr->paused)
-  {
-    this->PublishMultistep(this->dataPtr->stepSpin->value());
-  }
   // Only step after it's paused, to sync with server
-  else
-  {
+  if (!this->dataPtr->paused)
     this->OnPause();
+
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->controlMutex);
     this->dataPtr->pendingStep += this->dataPtr->stepSpin->value();
   }
+  this->SendPendingControls();
 }
 
 /////////////////////////////////////////////////
 void LogPlayWidget::OnStepBack()
 {
-  if (this->dataPtr->paused)
-  {
-    this->PublishMultistep(-this->dataPtr->stepSpin->value());
-  }
   // Only step after it's paused, to sync with server
-  else
-  {
+  if (!this->dataPtr->paused)
     this->OnPause();
+
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->controlMutex);
     this->dataPtr->pendingStep += -this->dataPtr->stepSpin->value();
   }
+  this->SendPendingControls();
 }
 
 /////////////////////////////////////////////////
@@ -395,9 +391,42 @@ void LogPlayWidget::OnForward()
 /////////////////////////////////////////////////
 void LogPlayWidget::OnSeek(const common::Time &_time)
 {
-  msgs::LogPlaybackControl msg;
-  msgs::Set(msg.mutable_seek(), _time);
-  this->dataPtr->logPlaybackControlPub->Publish(msg);
+  // Replace the pending seek, only the latest target matters
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->controlMutex);
+    this->dataPtr->seekPending = true;
+    this->dataPtr->seekTarget = _time;
+  }
+  this->SendPendingControls();
+}
+
+/////////////////////////////////////////////////
+void LogPlayWidget::SendPendingControls()
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->controlMutex);
+
+  // Wait for the server to apply the previous request
+  if (this->dataPtr->awaitingServer)
+    return;
+
+  if (this->dataPtr->seekPending)
+  {
+    msgs::LogPlaybackControl msg;
+    msgs::Set(msg.mutable_seek(), this->dataPtr->seekTarget);
+    this->dataPtr->logPlaybackControlPub->Publish(msg);
+    this->dataPtr->seekPending = false;
+  }
+  else if (this->dataPtr->paused && this->dataPtr->pendingStep != 0)
+  {
+    this->PublishMultistep(this->dataPtr->pendingStep);
+    this->dataPtr->pendingStep = 0;
+  }
+  else
+    return;
+
+  this->dataPtr->awaitingServer = true;
+  this->dataPtr->sentWallTime = common::Time::GetWallTime();
+  this->dataPtr->sentTime = this->dataPtr->currentTime;
 }
 
 /////////////////////////////////////////////////
@@ -434,7 +463,22 @@ void LogPlayWidget::EmitSetCurrentTime(const common::Time &_time)
   if (this->dataPtr->endTime != common::Time::Zero)
     time = std::min(time, this->dataPtr->endTime);
 
-  this->dataPtr->currentTime = time;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->controlMutex);
+    this->dataPtr->currentTime = time;
+
+    // The server applied the last request once the time changes. A request
+    // that doesn't change the time, such as a step at the end of the log,
+    // is considered applied after a while.
+    if (this->dataPtr->awaitingServer &&
+        (time != this->dataPtr->sentTime ||
+         common::Time::GetWallTime() - this->dataPtr->sentWallTime >
+         common::Time(1, 0)))
+    {
+      this->dataPtr->awaitingServer = false;
+    }
+  }
+  this->SendPendingControls();
 
   // Enable/disable buttons
   this->dataPtr->stepBackButton->setEnabled(time != this->dataPtr->startTime);
@@ -550,6 +594,16 @@ void LogPlayWidget::EmitSetEndTime(const common::Time &_time)
   this->dataPtr->hourSeparator->setVisible(!this->dataPtr->lessThan1h);
 }
 
+/////////////////////////////////////////////////
+void LogPlayWidget::EmitSetActivity(const std::vector<float> &_activity)
+{
+  if (_activity == this->dataPtr->activity)
+    return;
+
+  this->dataPtr->activity = _activity;
+  this->SetActivity(_activity);
+}
+
 /////////////////////////////////////////////////
 void LogPlayWidget::PublishMultistep(const int _step)
 {
@@ -639,6 +693,41 @@ void LogPlayView::SetEndTime(const common::Time &_time)
     this->DrawTimeline();
 }
 
+/////////////////////////////////////////////////
+void LogPlayView::SetActivity(const std::vector<float> &_activity)
+{
+  if (this->dataPtr->activityItem)
+  {
+    this->scene()->removeItem(this->dataPtr->activityItem);
+    delete this->dataPtr->activityItem;
+    this->dataPtr->activityItem = nullptr;
+  }
+
+  if (_activity.empty())
+    return;
+
+  // Bars under the time line, as tall as the activity of their interval
+  double left = this->dataPtr->margin;
+  double width = this->dataPtr->sceneWidth - 2 * this->dataPtr->margin;
+  double base = this->dataPtr->sceneHeight/2;
+  double height = this->dataPtr->sceneHeight/2 - 20;
+
+  QPainterPath path(QPointF(left, base));
+  for (size_t i = 0; i < _activity.size(); ++i)
+  {
+    double y = base + height * std::min(std::max(_activity[i], 0.0f), 1.0f);
+    path.lineTo(left + width * i / _activity.size(), y);
+    path.lineTo(left + width * (i + 1) / _activity.size(), y);
+  }
+  path.lineTo(left + width, base);
+  path.closeSubpath();
+
+  this->dataPtr->activityItem = new QGraphicsPathItem(path);
+  this->dataPtr->activityItem->setPen(Qt::NoPen);
+  this->dataPtr->activityItem->setBrush(QColor(50, 50, 50, 100));
+  this->scene()->addItem(this->dataPtr->activityItem);
+}
+
 /////////////////////////////////////////////////
 void LogPlayView::DrawTimeline()
 {
@@ -773,7 +862,14 @@ void LogPlayView::mouseMoveEvent(QMouseEvent *_event)
       newPos.setX(this->dataPtr->sceneWidth - this->dataPtr->margin);
 
     newPos.setY(this->dataPtr->sceneHeight/2);
-    this->dataPtr->currentTimeItem->setPos(newPos);
+
+    // Seek while scrubbing. Seeks are merged by the widget until the
+    // server has applied the previous one.
+    if (newPos != this->dataPtr->currentTimeItem->pos())
+    {
+      this->dataPtr->currentTimeItem->setPos(newPos);
+      this->Seek(this->CurrentItemTime());
+    }
   }
 }
 
@@ -782,20 +878,22 @@ void LogPlayView::mouseReleaseEvent(QMouseEvent */*_event*/)
 {
   // Send time seek if releasing current time item
   if (this->dataPtr->currentTimeItem->isSelected())
-  {
-    double relPos =
-        (this->dataPtr->currentTimeItem->pos().x() - this->dataPtr->margin) /
-        (this->dataPtr->sceneWidth - 2 * this->dataPtr->margin);
+    this->Seek(this->CurrentItemTime());
 
-    common::Time totalTime = this->dataPtr->endTime - this->dataPtr->startTime;
+  this->scene()->clearSelection();
+  QApplication::setOverrideCursor(QCursor(Qt::ArrowCursor));
+}
 
-    common::Time seekTime = (totalTime * relPos) + this->dataPtr->startTime;
+/////////////////////////////////////////////////
+common::Time LogPlayView::CurrentItemTime() const
+{
+  double relPos =
+      (this->dataPtr->currentTimeItem->pos().x() - this->dataPtr->margin) /
+      (this->dataPtr->sceneWidth - 2 * this->dataPtr->margin);
 
-    this->Seek(seekTime);
-  }
+  common::Time totalTime = this->dataPtr->endTime - this->dataPtr->startTime;
 
-  this->scene()->clearSelection();
-  QApplication::setOverrideCursor(QCursor(Qt::ArrowCursor));
+  return (totalTime * relPos) + this->dataPtr->startTime;
 }
 
 /////////////////////////////////////////////////
@@ -17,6 +17,8 @@
 #ifndef GAZEBO_GUI_LOGPLAYWIDGET_HH_
 #define GAZEBO_GUI_LOGPLAYWIDGET_HH_
 
+#include <vector>
+
 #include "gazebo/common/Time.hh"
 #include "gazebo/gui/qt.h"
 #include "gazebo/gui/TimePanel.hh"
@@ -64,6 +66,12 @@ namespace gazebo
       /// \param[in] _time End time.
       public: void EmitSetEndTime(const common::Time &_time);
 
+      /// \brief Emit signal to set the activity overview of the log, if it
+      /// changed.
+      /// \param[in] _activity Activity over equal time intervals of the log,
+      /// from 0 to 1.
+      public: void EmitSetActivity(const std::vector<float> &_activity);
+
       /// \brief Play simulation.
       public slots: void OnPlay();
 
@@ -137,10 +145,20 @@ namespace gazebo
       /// \param[in] _time End time.
       signals: void SetEndTime(const common::Time &_time);
 
+      /// \brief Qt signal used to set the activity overview in the view.
+      /// \param[in] _activity Activity over equal time intervals of the log.
+      signals: void SetActivity(const std::vector<float> &_activity);
+
       /// \brief Publish a multistep message.
       /// \param[in] _step Number of steps.
       private: void PublishMultistep(const int _step);
 
+      /// \brief Send the latest pending seek, or else the pending steps,
+      /// unless the server has not applied the previous one yet. Requests
+      /// made meanwhile are merged, so that scrubbing and stepping never send
+      /// requests faster than the server processes them.
+      private: void SendPendingControls();
+
       /// \brief Helper function to prepare each of the buttons.
       /// \param[in] _button Pointer to the button.
       /// \param[in] _icon Icon uri.
@@ -175,6 +193,11 @@ namespace gazebo
       /// \param[in] _time End time.
       public slots: void SetEndTime(const common::Time &_time);
 
+      /// \brief Draw the activity overview of the log under the timeline.
+      /// \param[in] _activity Activity over equal time intervals of the log,
+      /// from 0 to 1.
+      public slots: void SetActivity(const std::vector<float> &_activity);
+
       /// \brief Draw the timeline.
       public slots: void DrawTimeline();
 
@@ -191,6 +214,10 @@ namespace gazebo
       // Documentation inherited
       protected: void mouseMoveEvent(QMouseEvent *_event);
 
+      /// \brief Get the log time at the position of the current time item.
+      /// \return The time.
+      private: common::Time CurrentItemTime() const;
+
       /// \internal
       /// \brief Pointer to private data.
       private: LogPlayViewPrivate *dataPtr;
@@ -17,6 +17,9 @@
 #ifndef _GAZEBO_LOG_PLAY_WIDGET_PRIVATE_HH_
 #define _GAZEBO_LOG_PLAY_WIDGET_PRIVATE_HH_
 
+#include <mutex>
+#include <vector>
+
 #include "gazebo/gui/qt.h"
 
 namespace gazebo
@@ -99,6 +102,29 @@ namespace gazebo
       /// \brief Number of steps pending to be published once the simulation
       /// is paused.
       public: int pendingStep = 0;
+
+      /// \brief True if a seek is pending to be published.
+      public: bool seekPending = false;
+
+      /// \brief Target of the pending seek.
+      public: common::Time seekTarget;
+
+      /// \brief True while the server has not applied the last seek or
+      /// steps sent.
+      public: bool awaitingServer = false;
+
+      /// \brief Wall time when the last seek or steps were sent.
+      public: common::Time sentWallTime;
+
+      /// \brief Current time when the last seek or steps were sent.
+      public: common::Time sentTime;
+
+      /// \brief Mutex to protect the pending controls, which are updated
+      /// by the QT thread and by world statistics.
+      public: std::mutex controlMutex;
+
+      /// \brief Activity overview of the log.
+      public: std::vector<float> activity;
     };
 
     /// \class LogPlayViewPrivate LogPlayViewPrivate.hh
@@ -131,6 +157,9 @@ namespace gazebo
 
       /// \brief Whether the timeline has already been drawn.
       public: bool timelineDrawn = false;
+
+      /// \brief Item which shows the activity overview of the log.
+      public: QGraphicsPathItem *activityItem = nullptr;
      };
   }
 }
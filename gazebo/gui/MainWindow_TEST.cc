@@ -200,6 +200,70 @@ void MainWindow_TEST::Selection()
   delete mainWindow;
 }
 
+/////////////////////////////////////////////////
+void MainWindow_TEST::AsyncSelection()
+{
+  this->resMaxPercentChange = 5.0;
+  this->shareMaxPercentChange = 2.0;
+
+  this->Load("worlds/shapes.world", false, false, false);
+
+  gazebo::gui::MainWindow *mainWindow = new gazebo::gui::MainWindow();
+  QVERIFY(mainWindow != NULL);
+  // Create the main window.
+  mainWindow->Load();
+  mainWindow->Init();
+  mainWindow->show();
+
+  this->ProcessEventsAndDraw(mainWindow);
+
+  // Get the user camera and scene
+  gazebo::rendering::UserCameraPtr cam = gazebo::gui::get_active_camera();
+  QVERIFY(cam != NULL);
+
+  gazebo::gui::GLWidget *glWidget =
+    mainWindow->findChild<gazebo::gui::GLWidget *>("GLWidget");
+  QVERIFY(glWidget != NULL);
+
+  ignition::math::Vector2i glWidgetCenter(
+      glWidget->width()*0.5, glWidget->height()*0.5);
+
+  // nothing was requested yet
+  bool pending = true;
+  QVERIFY(cam->RequestedVisual(pending) == NULL);
+  QVERIFY(!pending);
+
+  // the request completes after frames are drawn, and gets the box
+  cam->RequestVisual(ignition::math::Vector2i(0, 0));
+  cam->RequestVisual(glWidgetCenter);
+  cam->RequestedVisual(pending);
+  QVERIFY(pending);
+
+  this->ProcessEventsAndDraw(mainWindow);
+
+  gazebo::rendering::VisualPtr vis = cam->RequestedVisual(pending);
+  QVERIFY(!pending);
+  QVERIFY(vis != NULL);
+  QVERIFY(vis->GetRootVisual()->Name() == "box");
+
+  // matches the synchronous selection
+  QVERIFY(cam->Visual(glWidgetCenter) == vis);
+
+  // look upwards, there is nothing in the middle of the window
+  ignition::math::Quaterniond pitch90(ignition::math::Vector3d(0, -1.57, 0));
+  cam->SetWorldRotation(pitch90);
+  cam->RequestVisual(glWidgetCenter);
+
+  this->ProcessEventsAndDraw(mainWindow);
+
+  QVERIFY(cam->RequestedVisual(pending) == NULL);
+  QVERIFY(!pending);
+
+  cam->Fini();
+  mainWindow->close();
+  delete mainWindow;
+}
+
 /////////////////////////////////////////////////
 void MainWindow_TEST::SceneDestruction()
 {
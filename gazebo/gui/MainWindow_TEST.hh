@@ -40,6 +40,9 @@ class MainWindow_TEST : public QTestFixture
   /// \brief Test user camera entity selection
   private slots: void Selection();
 
+  /// \brief Test user camera entity selection with asynchronous readback
+  private slots: void AsyncSelection();
+
   /// \brief Test user camera frames per second
   private slots: void UserCameraFPS();
 
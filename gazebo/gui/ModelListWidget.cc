@@ -14,6 +14,8 @@
  * limitations under the License.
  *
  */
+#include <QScreen>
+#include <cmath>
 #include <functional>
 
 #include <google/protobuf/descriptor.h>
@@ -83,10 +85,16 @@ ModelListWidget::ModelListWidget(QWidget *_parent)
       QAbstractItemView::SelectRows);
   this->dataPtr->modelTreeWidget->setVerticalScrollMode(
       QAbstractItemView::ScrollPerPixel);
+  // All rows have the same height, which lets the view lay out and paint
+  // only the visible rows of large worlds.
+  this->dataPtr->modelTreeWidget->setUniformRowHeights(true);
 
   connect(this->dataPtr->modelTreeWidget, SIGNAL(itemClicked(QTreeWidgetItem *,
       int)),
           this, SLOT(OnModelSelection(QTreeWidgetItem *, int)));
+  connect(this->dataPtr->modelTreeWidget,
+      SIGNAL(itemExpanded(QTreeWidgetItem *)),
+      this, SLOT(OnItemExpanded(QTreeWidgetItem *)));
   connect(this->dataPtr->modelTreeWidget,
       SIGNAL(customContextMenuRequested(const QPoint &)),
       this, SLOT(OnCustomContextMenu(const QPoint &)));
@@ -154,7 +162,18 @@ ModelListWidget::ModelListWidget(QWidget *_parent)
         std::bind(&ModelListWidget::OnSetSelectedEntity, this,
           std::placeholders::_1, std::placeholders::_2)));
 
-  QTimer::singleShot(500, this, SLOT(Update()));
+  // Process the received messages once per displayed frame, so that the
+  // updates that arrive in between are coalesced.
+  double refreshRate = 60.0;
+  QScreen *screen = QGuiApplication::primaryScreen();
+  if (screen && screen->refreshRate() > 0)
+    refreshRate = screen->refreshRate();
+
+  this->dataPtr->updateTimer = new QTimer(this);
+  connect(this->dataPtr->updateTimer, SIGNAL(timeout()),
+      this, SLOT(Update()));
+  this->dataPtr->updateTimer->start(
+      static_cast<int>(std::ceil(1000.0 / refreshRate)));
 }
 
 /////////////////////////////////////////////////
@@ -257,21 +276,8 @@ void ModelListWidget::OnSetSelectedEntity(const std::string &_name,
       this->dataPtr->lightsItem);
     if (mItem)
     {
-      if (mItem->data(3, Qt::UserRole).toString().toStdString() == "Plugin")
-      {
-        std::string pluginInfoService("/physics/info/plugin");
-        ignition::msgs::StringMsg req;
-        req.set_data(this->dataPtr->selectedEntityName);
-
-        this->dataPtr->ignNode.Request(pluginInfoService, req,
-            &ModelListWidget::OnPluginInfo, this);
-      }
-      else if (this->dataPtr->requestPub)
-      {
-        this->dataPtr->requestMsg = msgs::CreateRequest("entity_info",
-            this->dataPtr->selectedEntityName);
-        this->dataPtr->requestPub->Publish(*this->dataPtr->requestMsg);
-      }
+      this->RequestEntityInfo(mItem);
+      this->PopulateModelItem(mItem);
       this->dataPtr->modelTreeWidget->setCurrentItem(mItem);
       mItem->setExpanded(!mItem->isExpanded());
     }
@@ -304,37 +310,90 @@ void ModelListWidget::OnSetSelectedEntity(const std::string &_name,
   }
 }
 
+/////////////////////////////////////////////////
+void ModelListWidget::RequestEntityInfo(const QTreeWidgetItem *_item)
+{
+  // Don't ask the server for entity details nobody looks at, e.g. while
+  // entities are selected in the render window with the tab hidden.
+  if (!this->isVisible())
+  {
+    this->dataPtr->entityInfoPending = true;
+    return;
+  }
+  this->dataPtr->entityInfoPending = false;
+
+  if (_item->data(3, Qt::UserRole).toString().toStdString() == "Plugin")
+  {
+    std::string pluginInfoService("/physics/info/plugin");
+    ignition::msgs::StringMsg req;
+    req.set_data(this->dataPtr->selectedEntityName);
+
+    this->dataPtr->ignNode.Request(pluginInfoService, req,
+        &ModelListWidget::OnPluginInfo, this);
+  }
+  else if (this->dataPtr->requestPub)
+  {
+    this->dataPtr->requestMsg = msgs::CreateRequest("entity_info",
+        this->dataPtr->selectedEntityName);
+    this->dataPtr->requestPub->Publish(*this->dataPtr->requestMsg);
+  }
+}
+
+/////////////////////////////////////////////////
+void ModelListWidget::showEvent(QShowEvent *_event)
+{
+  QWidget::showEvent(_event);
+
+  if (!this->dataPtr->entityInfoPending)
+    return;
+
+  this->dataPtr->entityInfoPending = false;
+  if (this->dataPtr->selectedEntityName.empty())
+    return;
+
+  QTreeWidgetItem *item = this->ListItem(this->dataPtr->selectedEntityName,
+      this->dataPtr->modelsItem);
+  if (item)
+    this->RequestEntityInfo(item);
+}
+
 /////////////////////////////////////////////////
 void ModelListWidget::Update()
 {
-  if (!this->dataPtr->fillTypes.empty())
   {
     std::lock_guard<std::mutex> lock(*this->dataPtr->propMutex);
-    this->dataPtr->fillingPropertyTree = true;
-    this->dataPtr->propTreeBrowser->clear();
+    if (!this->dataPtr->fillTypes.empty())
+    {
+      // Only the latest response is shown, filling the tree with the older
+      // ones would be undone right away.
+      const std::string fillType = this->dataPtr->fillTypes.back();
+      this->dataPtr->fillTypes.clear();
 
-    if (this->dataPtr->fillTypes[0] == "Model")
-      this->FillPropertyTree(this->dataPtr->modelMsg, nullptr);
-    else if (this->dataPtr->fillTypes[0] == "Link")
-      this->FillPropertyTree(this->dataPtr->linkMsg, nullptr);
-    else if (this->dataPtr->fillTypes[0] == "Joint")
-      this->FillPropertyTree(this->dataPtr->jointMsg, nullptr);
-    else if (this->dataPtr->fillTypes[0] == "Plugin")
-      this->FillPropertyTree(this->dataPtr->pluginMsg, nullptr);
-    else if (this->dataPtr->fillTypes[0] == "Scene")
-      this->FillPropertyTree(this->dataPtr->sceneMsg, nullptr);
-    else if (this->dataPtr->fillTypes[0] == "Physics")
-      this->FillPropertyTree(this->dataPtr->physicsMsg, nullptr);
-    else if (this->dataPtr->fillTypes[0] == "Atmosphere")
-      this->FillPropertyTree(this->dataPtr->atmosphereMsg, nullptr);
-    else if (this->dataPtr->fillTypes[0] == "Wind")
-      this->FillPropertyTree(this->dataPtr->windMsg, nullptr);
-    else if (this->dataPtr->fillTypes[0] == "Light")
-      this->FillPropertyTree(this->dataPtr->lightMsg, nullptr);
-    else if (this->dataPtr->fillTypes[0] == "Spherical Coordinates")
-      this->FillPropertyTree(this->dataPtr->sphericalCoordMsg, nullptr);
-    this->dataPtr->fillingPropertyTree = false;
-    this->dataPtr->fillTypes.pop_front();
+      this->dataPtr->fillingPropertyTree = true;
+      this->dataPtr->propTreeBrowser->clear();
+
+      if (fillType == "Model")
+        this->FillPropertyTree(this->dataPtr->modelMsg, nullptr);
+      else if (fillType == "Link")
+        this->FillPropertyTree(this->dataPtr->linkMsg, nullptr);
+      else if (fillType == "Joint")
+        this->FillPropertyTree(this->dataPtr->jointMsg, nullptr);
+      else if (fillType == "Plugin")
+        this->FillPropertyTree(this->dataPtr->pluginMsg, nullptr);
+      else if (fillType == "Scene")
+        this->FillPropertyTree(this->dataPtr->sceneMsg, nullptr);
+      else if (fillType == "Physics")
+        this->FillPropertyTree(this->dataPtr->physicsMsg, nullptr);
+      else if (fillType == "Atmosphere")
+        this->FillPropertyTree(this->dataPtr->atmosphereMsg, nullptr);
+      else if (fillType == "Wind")
+        this->FillPropertyTree(this->dataPtr->windMsg, nullptr);
+      else if (fillType == "Light")
+        this->FillPropertyTree(this->dataPtr->lightMsg, nullptr);
+      else if (fillType == "Spherical Coordinates")
+        this->FillPropertyTree(this->dataPtr->sphericalCoordMsg, nullptr);
+      this->dataPtr->fillingPropertyTree = false;
+    }
   }
 
   if (!this->dataPtr->modelTreeWidget->currentItem())
@@ -346,7 +405,6 @@ void ModelListWidget::Update()
   this->ProcessRemoveEntity();
   this->ProcessModelMsgs();
   this->ProcessLightMsgs();
-  QTimer::singleShot(1000, this, SLOT(Update()));
 }
 
 /////////////////////////////////////////////////
@@ -370,139 +428,209 @@ void ModelListWidget::OnLightUpdate(const msgs::Light &_msg)
 /////////////////////////////////////////////////
 void ModelListWidget::ProcessModelMsgs()
 {
-  std::lock_guard<std::mutex> lock(*this->dataPtr->receiveMutex);
-  QFont subheaderFont;
-  subheaderFont.setBold(true);
+  ModelListWidgetPrivate::ModelMsgs_L modelMsgs;
+  {
+    std::lock_guard<std::mutex> lock(*this->dataPtr->receiveMutex);
+    modelMsgs.swap(this->dataPtr->modelMsgs);
+  }
+
+  if (modelMsgs.empty())
+    return;
+
+  // New items are added at once, which is much faster than adding them one
+  // by one when a scene with many models is received.
+  QList<QTreeWidgetItem *> newItems;
 
-  for (auto iter = this->dataPtr->modelMsgs.begin();
-       iter != this->dataPtr->modelMsgs.end(); ++iter)
+  for (const auto &msg : modelMsgs)
   {
-    std::string name = (*iter).name();
+    const bool deleted = msg.has_deleted() && msg.deleted();
 
-    QTreeWidgetItem *listItem = this->ListItem((*iter).name(),
-                                                  this->dataPtr->modelsItem);
+    QTreeWidgetItem *listItem = this->ListItem(msg.name(),
+        this->dataPtr->modelsItem);
 
     if (!listItem)
     {
-      if (!(*iter).has_deleted() || !(*iter).deleted())
-      {
-        // Create an item for the model name
-        QTreeWidgetItem *topItem = new QTreeWidgetItem(
-            this->dataPtr->modelsItem,
-            QStringList(QString("%1").arg(QString::fromStdString(name))));
+      if (!deleted)
+        newItems.push_back(this->CreateModelItem(msg));
+    }
+    else if (deleted)
+    {
+      newItems.removeOne(listItem);
+      this->RemoveListItem(listItem);
+    }
+    else
+    {
+      listItem->setText(0, msg.name().c_str());
+      listItem->setData(1, Qt::UserRole, QVariant(msg.name().c_str()));
+    }
+  }
 
-        topItem->setData(0, Qt::UserRole, QVariant((*iter).name().c_str()));
-        this->dataPtr->modelTreeWidget->addTopLevelItem(topItem);
+  this->dataPtr->modelsItem->addChildren(newItems);
+}
 
-        if ((*iter).link_size() > 0)
-        {
-          // Create subheader for links
-          QTreeWidgetItem *linkHeaderItem = new QTreeWidgetItem(topItem,
-          QStringList(QString("%1").arg(QString::fromStdString("LINKS"))));
-          linkHeaderItem->setFont(0, subheaderFont);
-          linkHeaderItem->setFlags(Qt::NoItemFlags);
-          this->dataPtr->modelTreeWidget->addTopLevelItem(linkHeaderItem);
-        }
+/////////////////////////////////////////////////
+QTreeWidgetItem *ModelListWidget::CreateModelItem(const msgs::Model &_msg)
+{
+  // Create an item for the model name
+  QTreeWidgetItem *topItem = new QTreeWidgetItem(
+      static_cast<QTreeWidgetItem *>(nullptr),
+      QStringList(QString("%1").arg(QString::fromStdString(_msg.name()))));
 
-        for (int i = 0; i < (*iter).link_size(); ++i)
-        {
-          std::string linkName = (*iter).link(i).name();
-
-          // get unscoped name by stripping parent
-          int index = linkName.find(name) + name.length() + 2;
-          std::string linkNameShort = linkName.substr(index,
-                                                      linkName.size() - index);
-
-          QTreeWidgetItem *linkItem = new QTreeWidgetItem(topItem,
-              QStringList(QString("%1").arg(
-                  QString::fromStdString(linkNameShort))));
-
-          linkItem->setData(0, Qt::UserRole, QVariant(linkName.c_str()));
-          linkItem->setData(1, Qt::UserRole, QVariant((*iter).name().c_str()));
-          linkItem->setData(2, Qt::UserRole, QVariant((*iter).id()));
-          linkItem->setData(3, Qt::UserRole, QVariant("Link"));
-          this->dataPtr->modelTreeWidget->addTopLevelItem(linkItem);
-        }
+  topItem->setData(0, Qt::UserRole, QVariant(_msg.name().c_str()));
+  this->dataPtr->modelItems[_msg.name()] = topItem;
 
-        if ((*iter).joint_size() > 0)
-        {
-          // Create subheader for joints
-          QTreeWidgetItem *jointHeaderItem = new QTreeWidgetItem(topItem,
-          QStringList(QString("%1").arg(QString::fromStdString("JOINTS"))));
-          jointHeaderItem->setFont(0, subheaderFont);
-          jointHeaderItem->setFlags(Qt::NoItemFlags);
-          this->dataPtr->modelTreeWidget->addTopLevelItem(jointHeaderItem);
-        }
+  if (_msg.link_size() == 0 && _msg.joint_size() == 0 &&
+      _msg.plugin_size() == 0)
+  {
+    return topItem;
+  }
 
-        for (int i = 0; i < (*iter).joint_size(); ++i)
-        {
-          std::string jointName = (*iter).joint(i).name();
+  // Keep only what the child items need until the model is expanded
+  msgs::Model &children = this->dataPtr->unpopulatedModels[_msg.name()];
+  children.Clear();
+  children.set_name(_msg.name());
+  children.set_id(_msg.id());
+  for (int i = 0; i < _msg.link_size(); ++i)
+    children.add_link()->set_name(_msg.link(i).name());
+  for (int i = 0; i < _msg.joint_size(); ++i)
+    children.add_joint()->set_name(_msg.joint(i).name());
+  for (int i = 0; i < _msg.plugin_size(); ++i)
+    children.add_plugin()->set_name(_msg.plugin(i).name());
 
-          // get unscoped name by stripping parent
-          int index = jointName.find(name) + name.length() + 2;
-          std::string jointNameShort = jointName.substr(
-              index, jointName.size() - index);
+  topItem->setChildIndicatorPolicy(QTreeWidgetItem::ShowIndicator);
 
-          QTreeWidgetItem *jointItem = new QTreeWidgetItem(topItem,
-              QStringList(QString("%1").arg(
-                  QString::fromStdString(jointNameShort))));
+  return topItem;
+}
 
-          jointItem->setData(0, Qt::UserRole, QVariant(jointName.c_str()));
-          jointItem->setData(3, Qt::UserRole, QVariant("Joint"));
-          this->dataPtr->modelTreeWidget->addTopLevelItem(jointItem);
-        }
+/////////////////////////////////////////////////
+void ModelListWidget::OnItemExpanded(QTreeWidgetItem *_item)
+{
+  if (_item && _item->parent() == this->dataPtr->modelsItem)
+    this->PopulateModelItem(_item);
+}
 
-        if ((*iter).plugin_size() > 0)
-        {
-          // Create subheader for plugins
-          QTreeWidgetItem *pluginHeaderItem = new QTreeWidgetItem(topItem,
-          QStringList(QString("%1").arg("PLUGINS")));
-          pluginHeaderItem->setFont(0, subheaderFont);
-          pluginHeaderItem->setFlags(Qt::NoItemFlags);
-          this->dataPtr->modelTreeWidget->addTopLevelItem(pluginHeaderItem);
-        }
+/////////////////////////////////////////////////
+void ModelListWidget::PopulateModelItem(QTreeWidgetItem *_item)
+{
+  std::string name = _item->data(0, Qt::UserRole).toString().toStdString();
 
-        for (int i = 0; i < (*iter).plugin_size(); ++i)
-        {
-          std::string pluginName = (*iter).plugin(i).name();
+  auto iter = this->dataPtr->unpopulatedModels.find(name);
+  if (iter == this->dataPtr->unpopulatedModels.end())
+    return;
 
-          QTreeWidgetItem *pluginItem = new QTreeWidgetItem(topItem,
-              QStringList(QString("%1").arg(
-                  QString::fromStdString(pluginName))));
+  msgs::Model msg;
+  msg.Swap(&iter->second);
+  this->dataPtr->unpopulatedModels.erase(iter);
 
-          common::URI pluginUri;
-          pluginUri.SetScheme("data");
+  QFont subheaderFont;
+  subheaderFont.setBold(true);
 
-          pluginUri.Path().PushBack("world");
-          pluginUri.Path().PushBack(gui::get_world());
-          pluginUri.Path().PushBack("model");
-          pluginUri.Path().PushBack((*iter).name());
-          pluginUri.Path().PushBack("plugin");
-          pluginUri.Path().PushBack(pluginName);
+  QList<QTreeWidgetItem *> items;
 
-          pluginItem->setData(0, Qt::UserRole,
-              QVariant(pluginUri.Str().c_str()));
-          pluginItem->setData(3, Qt::UserRole, QVariant("Plugin"));
+  if (msg.link_size() > 0)
+  {
+    // Create subheader for links
+    QTreeWidgetItem *linkHeaderItem = new QTreeWidgetItem(
+        static_cast<QTreeWidgetItem *>(nullptr),
+        QStringList(QString("%1").arg(QString::fromStdString("LINKS"))));
+    linkHeaderItem->setFont(0, subheaderFont);
+    linkHeaderItem->setFlags(Qt::NoItemFlags);
+    items.push_back(linkHeaderItem);
+  }
 
-          this->dataPtr->modelTreeWidget->addTopLevelItem(pluginItem);
-        }
-      }
-    }
-    else
-    {
-      if ((*iter).has_deleted() && (*iter).deleted())
-      {
-        int i = this->dataPtr->modelsItem->indexOfChild(listItem);
-        this->dataPtr->modelsItem->takeChild(i);
-      }
-      else
-      {
-        listItem->setText(0, (*iter).name().c_str());
-        listItem->setData(1, Qt::UserRole, QVariant((*iter).name().c_str()));
-      }
-    }
+  for (int i = 0; i < msg.link_size(); ++i)
+  {
+    std::string linkName = msg.link(i).name();
+
+    // get unscoped name by stripping parent
+    int index = linkName.find(name) + name.length() + 2;
+    std::string linkNameShort = linkName.substr(index,
+                                                linkName.size() - index);
+
+    QTreeWidgetItem *linkItem = new QTreeWidgetItem(
+        static_cast<QTreeWidgetItem *>(nullptr),
+        QStringList(QString("%1").arg(
+            QString::fromStdString(linkNameShort))));
+
+    linkItem->setData(0, Qt::UserRole, QVariant(linkName.c_str()));
+    linkItem->setData(1, Qt::UserRole, QVariant(name.c_str()));
+    linkItem->setData(2, Qt::UserRole, QVariant(msg.id()));
+    linkItem->setData(3, Qt::UserRole, QVariant("Link"));
+    this->dataPtr->modelItems[linkName] = linkItem;
+    items.push_back(linkItem);
+  }
+
+  if (msg.joint_size() > 0)
+  {
+    // Create subheader for joints
+    QTreeWidgetItem *jointHeaderItem = new QTreeWidgetItem(
+        static_cast<QTreeWidgetItem *>(nullptr),
+        QStringList(QString("%1").arg(QString::fromStdString("JOINTS"))));
+    jointHeaderItem->setFont(0, subheaderFont);
+    jointHeaderItem->setFlags(Qt::NoItemFlags);
+    items.push_back(jointHeaderItem);
+  }
+
+  for (int i = 0; i < msg.joint_size(); ++i)
+  {
+    std::string jointName = msg.joint(i).name();
+
+    // get unscoped name by stripping parent
+    int index = jointName.find(name) + name.length() + 2;
+    std::string jointNameShort = jointName.substr(
+        index, jointName.size() - index);
+
+    QTreeWidgetItem *jointItem = new QTreeWidgetItem(
+        static_cast<QTreeWidgetItem *>(nullptr),
+        QStringList(QString("%1").arg(
+            QString::fromStdString(jointNameShort))));
+
+    jointItem->setData(0, Qt::UserRole, QVariant(jointName.c_str()));
+    jointItem->setData(3, Qt::UserRole, QVariant("Joint"));
+    this->dataPtr->modelItems[jointName] = jointItem;
+    items.push_back(jointItem);
+  }
+
+  if (msg.plugin_size() > 0)
+  {
+    // Create subheader for plugins
+    QTreeWidgetItem *pluginHeaderItem = new QTreeWidgetItem(
+        static_cast<QTreeWidgetItem *>(nullptr),
+        QStringList(QString("%1").arg("PLUGINS")));
+    pluginHeaderItem->setFont(0, subheaderFont);
+    pluginHeaderItem->setFlags(Qt::NoItemFlags);
+    items.push_back(pluginHeaderItem);
+  }
+
+  for (int i = 0; i < msg.plugin_size(); ++i)
+  {
+    std::string pluginName = msg.plugin(i).name();
+
+    QTreeWidgetItem *pluginItem = new QTreeWidgetItem(
+        static_cast<QTreeWidgetItem *>(nullptr),
+        QStringList(QString("%1").arg(
+            QString::fromStdString(pluginName))));
+
+    common::URI pluginUri;
+    pluginUri.SetScheme("data");
+
+    pluginUri.Path().PushBack("world");
+    pluginUri.Path().PushBack(gui::get_world());
+    pluginUri.Path().PushBack("model");
+    pluginUri.Path().PushBack(name);
+    pluginUri.Path().PushBack("plugin");
+    pluginUri.Path().PushBack(pluginName);
+
+    pluginItem->setData(0, Qt::UserRole,
+        QVariant(pluginUri.Str().c_str()));
+    pluginItem->setData(3, Qt::UserRole, QVariant("Plugin"));
+    this->dataPtr->modelItems[pluginUri.Str()] = pluginItem;
+    items.push_back(pluginItem);
   }
-  this->dataPtr->modelMsgs.clear();
+
+  _item->addChildren(items);
+  _item->setChildIndicatorPolicy(
+      QTreeWidgetItem::DontShowIndicatorWhenChildless);
 }
 
 /////////////////////////////////////////////////
@@ -613,7 +741,8 @@ void ModelListWidget::RemoveEntity(const std::string &_name)
     QTreeWidgetItem *listItem = this->ListItem(_name, items[i]);
     if (listItem)
     {
-      items[i]->takeChild(items[i]->indexOfChild(listItem));
+      if (listItem->parent() == items[i])
+        this->RemoveListItem(listItem);
       this->dataPtr->propTreeBrowser->clear();
       this->dataPtr->selectedEntityName.clear();
       this->dataPtr->sdfElement.reset();
@@ -627,33 +756,59 @@ void ModelListWidget::RemoveEntity(const std::string &_name)
 QTreeWidgetItem *ModelListWidget::ListItem(const std::string &_name,
                                               QTreeWidgetItem *_parent)
 {
-  QTreeWidgetItem *listItem = nullptr;
+  auto &items = _parent == this->dataPtr->lightsItem ?
+      this->dataPtr->lightItems : this->dataPtr->modelItems;
 
-  // Find an existing element with the name from the message
-  for (int i = 0; i < _parent->childCount() && !listItem; ++i)
-  {
-    QTreeWidgetItem *item = _parent->child(i);
-    std::string listData = item->data(0, Qt::UserRole).toString().toStdString();
+  auto iter = items.find(_name);
+  if (iter != items.end())
+    return iter->second;
 
-    if (listData == _name)
-    {
-      listItem = item;
-      break;
-    }
+  if (_parent != this->dataPtr->modelsItem)
+    return nullptr;
 
-    for (int j = 0; j < item->childCount(); j++)
+  // The item may be a link or joint of a model that was not expanded yet,
+  // create the children of the models in its scope.
+  bool populated = false;
+  for (size_t pos = _name.find("::"); pos != std::string::npos;
+       pos = _name.find("::", pos + 2))
+  {
+    auto modelIter = items.find(_name.substr(0, pos));
+    if (modelIter != items.end() && this->dataPtr->unpopulatedModels.count(
+          _name.substr(0, pos)) > 0)
     {
-      QTreeWidgetItem *childItem = item->child(j);
-      listData = childItem->data(0, Qt::UserRole).toString().toStdString();
-      if (listData == _name)
-      {
-        listItem = childItem;
-        break;
-      }
+      this->PopulateModelItem(modelIter->second);
+      populated = true;
     }
   }
 
-  return listItem;
+  if (populated)
+  {
+    iter = items.find(_name);
+    if (iter != items.end())
+      return iter->second;
+  }
+
+  return nullptr;
+}
+
+/////////////////////////////////////////////////
+void ModelListWidget::RemoveListItem(QTreeWidgetItem *_item)
+{
+  auto &items = _item->parent() == this->dataPtr->lightsItem ?
+      this->dataPtr->lightItems : this->dataPtr->modelItems;
+
+  std::string name = _item->data(0, Qt::UserRole).toString().toStdString();
+  items.erase(name);
+  this->dataPtr->unpopulatedModels.erase(name);
+
+  for (int i = 0; i < _item->childCount(); ++i)
+  {
+    items.erase(
+        _item->child(i)->data(0, Qt::UserRole).toString().toStdString());
+  }
+
+  // Deleting the item removes it and its children from the tree
+  delete _item;
 }
 
 /////////////////////////////////////////////////
@@ -2904,6 +3059,9 @@ void ModelListWidget::InitTransport(const std::string &_name)
 void ModelListWidget::ResetTree()
 {
   this->dataPtr->modelTreeWidget->clear();
+  this->dataPtr->modelItems.clear();
+  this->dataPtr->lightItems.clear();
+  this->dataPtr->unpopulatedModels.clear();
 
   // Create the top level of items in the tree widget
   {
@@ -3382,10 +3540,13 @@ void ModelListWidget::FillPropertyTree(const msgs::Light &_msg,
 /////////////////////////////////////////////////
 void ModelListWidget::ProcessLightMsgs()
 {
-  std::lock_guard<std::mutex> lock(*this->dataPtr->receiveMutex);
+  ModelListWidgetPrivate::LightMsgs_L lightMsgs;
+  {
+    std::lock_guard<std::mutex> lock(*this->dataPtr->receiveMutex);
+    lightMsgs.swap(this->dataPtr->lightMsgs);
+  }
 
-  for (auto iter = this->dataPtr->lightMsgs.begin();
-       iter != this->dataPtr->lightMsgs.end(); ++iter)
+  for (auto iter = lightMsgs.begin(); iter != lightMsgs.end(); ++iter)
   {
     std::string name = (*iter).name();
 
@@ -3399,14 +3560,13 @@ void ModelListWidget::ProcessLightMsgs()
           QStringList(QString("%1").arg(QString::fromStdString(name))));
 
       item->setData(0, Qt::UserRole, QVariant((*iter).name().c_str()));
-      this->dataPtr->modelTreeWidget->addTopLevelItem(item);
+      this->dataPtr->lightItems[name] = item;
     }
     else
     {
       listItem->setData(0, Qt::UserRole, QVariant((*iter).name().c_str()));
     }
   }
-  this->dataPtr->lightMsgs.clear();
 }
 
 /////////////////////////////////////////////////
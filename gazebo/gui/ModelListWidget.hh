@@ -49,6 +49,17 @@ namespace gazebo
       private slots: void OnPropertyChanged(QtProperty *_item);
       private slots: void OnCustomContextMenu(const QPoint &_pt);
       private slots: void OnCurrentPropertyChanged(QtBrowserItem *_item);
+
+      /// \brief Called when an item of the model tree is expanded, creates
+      /// the link, joint and plugin items of a model on first expansion.
+      /// \param[in] _item The expanded item.
+      private slots: void OnItemExpanded(QTreeWidgetItem *_item);
+
+      /// \brief Request the entity info that was deferred while the widget
+      /// was hidden.
+      /// \param[in] _event The show event.
+      protected: virtual void showEvent(QShowEvent *_event);
+
       private: void OnSetSelectedEntity(const std::string &_name,
                                         const std::string &_mode);
       private: void OnResponse(ConstResponsePtr &_msg);
@@ -115,6 +126,28 @@ namespace gazebo
       private: QTreeWidgetItem *ListItem(const std::string &_name,
                                          QTreeWidgetItem *_parent);
 
+      /// \brief Create the tree item of a model. The items of its links,
+      /// joints and plugins are only created when the model item is
+      /// expanded, see PopulateModelItem.
+      /// \param[in] _msg Message of the model.
+      /// \return The new item, without a parent.
+      private: QTreeWidgetItem *CreateModelItem(const msgs::Model &_msg);
+
+      /// \brief Create the link, joint and plugin items of a model item if
+      /// they were not created yet.
+      /// \param[in] _item The model item.
+      private: void PopulateModelItem(QTreeWidgetItem *_item);
+
+      /// \brief Remove an item and its children from the tree and delete
+      /// them.
+      /// \param[in] _item The item to remove.
+      private: void RemoveListItem(QTreeWidgetItem *_item);
+
+      /// \brief Request the info of the selected entity from the server.
+      /// The request is deferred until the widget is shown.
+      /// \param[in] _item Tree item of the selected entity.
+      private: void RequestEntityInfo(const QTreeWidgetItem *_item);
+
       private: void FillPropertyTree(const msgs::Model &_msg,
                                      QtProperty *_parent);
 
@@ -19,6 +19,7 @@
 
 #include <string>
 #include <list>
+#include <map>
 #include <vector>
 #include <deque>
 #include <sdf/sdf.hh>
@@ -102,6 +103,25 @@ namespace gazebo
       typedef std::list<std::string> RemoveEntity_L;
       public: RemoveEntity_L removeEntityList;
 
+      /// \brief Items under the models item, indexed by the name stored in
+      /// their data: models, and the links, joints and plugins of the
+      /// populated models.
+      public: std::map<std::string, QTreeWidgetItem *> modelItems;
+
+      /// \brief Items under the lights item, indexed by light name.
+      public: std::map<std::string, QTreeWidgetItem *> lightItems;
+
+      /// \brief Names of the links, joints and plugins of the models whose
+      /// items were not expanded yet, indexed by model name.
+      public: std::map<std::string, msgs::Model> unpopulatedModels;
+
+      /// \brief Timer running Update at the display refresh rate.
+      public: QTimer *updateTimer = nullptr;
+
+      /// \brief True if the entity info request was deferred because the
+      /// widget was hidden.
+      public: bool entityInfoPending = false;
+
       public: msgs::Model modelMsg;
       public: msgs::Link linkMsg;
       public: msgs::Scene sceneMsg;
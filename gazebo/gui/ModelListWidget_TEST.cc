@@ -16,6 +16,7 @@
 */
 #include <boost/filesystem.hpp>
 #include <memory>
+#include "gazebo/common/Events.hh"
 #include "gazebo/common/SystemPaths.hh"
 #include "gazebo/msgs/msgs.hh"
 #include "gazebo/transport/TransportIface.hh"
@@ -377,6 +378,98 @@ void ModelListWidget_TEST::ModelsTree()
   modelListWidget = nullptr;
 }
 
+/////////////////////////////////////////////////
+void ModelListWidget_TEST::LazyModelItems()
+{
+  this->Load("worlds/empty.world");
+
+  gazebo::gui::ModelListWidget *modelListWidget
+      = new gazebo::gui::ModelListWidget;
+  QCoreApplication::processEvents();
+
+  QTreeWidget *modelTreeWidget = modelListWidget->findChild<QTreeWidget *>(
+      "modelTreeWidget");
+  QVERIFY(modelTreeWidget != nullptr);
+
+  QList<QTreeWidgetItem *> treeModelItems =
+      modelTreeWidget->findItems(tr("Models"), Qt::MatchExactly);
+  QCOMPARE(treeModelItems.size(), 1);
+  QTreeWidgetItem *modelsItem = treeModelItems.front();
+
+  // Send many models with two links and a joint each
+  int modelCount = 1000;
+  for (int i = 0; i < modelCount; ++i)
+  {
+    gazebo::msgs::Model msg;
+    std::string name = "model_" + std::to_string(i);
+    msg.set_name(name);
+    msg.set_id(i + 1);
+    for (int j = 0; j < 2; ++j)
+    {
+      auto link = msg.add_link();
+      link->set_id(i * 10 + j);
+      link->set_name(name + "::link_" + std::to_string(j));
+    }
+    msg.add_joint()->set_name(name + "::joint");
+    gazebo::gui::Events::modelUpdate(msg);
+  }
+
+  int maxSleep = 10;
+  int sleep = 0;
+  while (modelsItem->childCount() < modelCount && sleep < maxSleep)
+  {
+    QCoreApplication::processEvents();
+    QTest::qWait(100);
+    sleep++;
+  }
+  QCOMPARE(modelsItem->childCount(), modelCount);
+
+  // The models have no child items yet, but can be expanded
+  for (int i = 0; i < modelCount; ++i)
+  {
+    QTreeWidgetItem *item = modelsItem->child(i);
+    QCOMPARE(item->childCount(), 0);
+    QCOMPARE(item->childIndicatorPolicy(), QTreeWidgetItem::ShowIndicator);
+  }
+
+  // Expanding a model creates its links and joints, with their subheaders
+  QTreeWidgetItem *modelItem = modelsItem->child(10);
+  QCOMPARE(modelItem->text(0), tr("model_10"));
+  modelItem->setExpanded(true);
+  QCOMPARE(modelItem->childCount(), 5);
+  QCOMPARE(modelItem->child(1)->text(0), tr("link_0"));
+  QCOMPARE(modelItem->child(2)->text(0), tr("link_1"));
+  QCOMPARE(modelItem->child(4)->text(0), tr("joint"));
+
+  // Selecting a link of a model that was not expanded finds its item
+  modelItem = modelsItem->child(20);
+  QCOMPARE(modelItem->childCount(), 0);
+  gazebo::event::Events::setSelectedEntity("model_20::link_1", "normal");
+  QCOMPARE(modelItem->childCount(), 5);
+  QVERIFY(modelTreeWidget->currentItem() != nullptr);
+  QCOMPARE(modelTreeWidget->currentItem()->data(0, Qt::UserRole).toString(),
+      tr("model_20::link_1"));
+  gazebo::event::Events::setSelectedEntity("", "normal");
+
+  // Delete a model
+  gazebo::msgs::Model msg;
+  msg.set_name("model_10");
+  msg.set_deleted(true);
+  gazebo::gui::Events::modelUpdate(msg);
+
+  sleep = 0;
+  while (modelsItem->childCount() == modelCount && sleep < maxSleep)
+  {
+    QCoreApplication::processEvents();
+    QTest::qWait(100);
+    sleep++;
+  }
+  QCOMPARE(modelsItem->childCount(), modelCount - 1);
+  QCOMPARE(modelsItem->child(10)->text(0), tr("model_11"));
+
+  delete modelListWidget;
+}
+
 /////////////////////////////////////////////////
 void ModelListWidget_TEST::ModelProperties()
 {
@@ -103,6 +103,10 @@ class ModelListWidget_TEST : public QTestFixture
   /// \brief Test that the model widget item contains all models in the world.
   private slots: void ModelsTree();
 
+  /// \brief Test that the link and joint items of a model are only created
+  /// when the model is expanded or one of its links is selected.
+  private slots: void LazyModelItems();
+
   /// \brief Test that the property browser displays correct model properties.
   /// The test then modifies the properties, refresh the property browser, and
   /// verify the changes are set.
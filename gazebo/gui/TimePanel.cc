@@ -17,6 +17,7 @@
 #include <functional>
 #include <mutex>
 #include <sstream>
+#include <vector>
 
 #include <boost/lexical_cast.hpp>
 
@@ -270,6 +271,11 @@ void TimePanel::OnStats(ConstWorldStatisticsPtr &_msg)
     // Set end time in text and in ms
     this->dataPtr->logPlayWidget->EmitSetEndTime(
         msgs::Convert(_msg->log_playback_stats().end_time()));
+
+    // Set the activity overview of the timeline
+    auto const &activity = _msg->log_playback_stats().activity();
+    this->dataPtr->logPlayWidget->EmitSetActivity(
+        std::vector<float>(activity.begin(), activity.end()));
   }
 }
 
@@ -15,6 +15,7 @@
  *
 */
 
+#include <algorithm>
 #include <map>
 
 #include <ignition/math/Helpers.hh>
@@ -342,9 +343,15 @@ void IncrementalPlot::Update()
   if (this->dataPtr->curves.empty())
     return;
 
+  // Draw at most a few points per pixel column
+  const unsigned int width =
+      static_cast<unsigned int>(std::max(1, this->canvas()->width()));
+
   ignition::math::Vector2d lastPoint;
   for (auto &curve : this->dataPtr->curves)
   {
+    curve.second->SetPixelWidth(width);
+
     if (!curve.second->Active())
       continue;
 
@@ -359,12 +366,6 @@ void IncrementalPlot::Update()
     {
       continue;
     }
-
-    ignition::math::Vector2d minPt = curve.second->Min();
-    ignition::math::Vector2d maxPt = curve.second->Max();
-
-    this->dataPtr->directPainter->drawSeries(curve.second->Curve(),
-      pointCount - 1, pointCount - 1);
   }
 
   // get x axis lower and upper bounds
@@ -15,6 +15,12 @@
  *
 */
 
+#include <cmath>
+#include <vector>
+
+#include <ignition/math/Helpers.hh>
+
+#include "gazebo/gui/plot/qwt_gazebo.h"
 #include "gazebo/gui/plot/PlottingTypes.hh"
 #include "gazebo/gui/plot/PlotCurve.hh"
 #include "gazebo/gui/plot/IncrementalPlot.hh"
@@ -236,5 +242,54 @@ void IncrementalPlot_TEST::SetCurveLabel()
   delete plot;
 }
 
+/////////////////////////////////////////////////
+void IncrementalPlot_TEST::Decimation()
+{
+  this->resMaxPercentChange = 5.0;
+  this->shareMaxPercentChange = 2.0;
+
+  this->Load("worlds/empty.world");
+
+  // Create a new plot
+  gazebo::gui::IncrementalPlot *plot =
+      new gazebo::gui::IncrementalPlot(nullptr);
+  QVERIFY(plot != nullptr);
+  plot->resize(400, 300);
+  plot->show();
+
+  gazebo::gui::PlotCurveWeakPtr curve = plot->AddCurve("curve01");
+  auto c = curve.lock();
+  QVERIFY(c != nullptr);
+
+  // 10 seconds of a 1 kHz variable, with a spike the plot must show
+  std::vector<ignition::math::Vector2d> points;
+  for (unsigned int i = 0; i < 10000u; ++i)
+  {
+    double y = std::sin(i * 0.01);
+    if (i == 5555u)
+      y = 100.0;
+    points.push_back(ignition::math::Vector2d(i * 0.001, y));
+  }
+  plot->AddPoints(c->Id(), points);
+  QCOMPARE(c->Size(), 10000u);
+
+  plot->Update();
+
+  // At most the first, min, max and last points of each pixel column, and
+  // a point on each side of the plot, are drawn
+  unsigned int width = static_cast<unsigned int>(plot->canvas()->width());
+  QVERIFY(c->DrawnSize() > 0u);
+  QVERIFY(c->DrawnSize() <= 4u * width + 2u);
+  QVERIFY(ignition::math::equal(c->Max().Y(), 100.0));
+
+  bool spike = false;
+  QwtPlotCurve *qwtCurve = c->Curve();
+  for (size_t i = 0; i < qwtCurve->dataSize(); ++i)
+    spike = spike || ignition::math::equal(qwtCurve->sample(i).y(), 100.0);
+  QVERIFY(spike);
+
+  delete plot;
+}
+
 // Generate a main function for the test
 QTEST_MAIN(IncrementalPlot_TEST)
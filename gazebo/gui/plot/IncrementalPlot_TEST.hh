@@ -35,5 +35,8 @@ class IncrementalPlot_TEST : public QTestFixture
 
   /// \brief Test changing the curve label.
   private slots: void SetCurveLabel();
+
+  /// \brief Test that the points drawn are bounded by the plot width
+  private slots: void Decimation();
 };
 #endif
@@ -36,6 +36,11 @@
 using namespace gazebo;
 using namespace gui;
 
+/// \brief Maximum rate of introspection updates. This is two updates per
+/// pixel column of a 2000 pixel wide plot showing the default period of 10
+/// seconds, so faster updates could not be seen.
+static const uint64_t kMaxUpdateRate = 400u;
+
 namespace gazebo
 {
   namespace gui
@@ -255,9 +260,12 @@ void IntrospectionCurveHandler::SetupIntrospection()
     return;
   }
 
-  // Subscribe to custom introspection topic for receiving updates.
+  // Subscribe to custom introspection topic for receiving updates, at a
+  // rate the plots can display.
+  ignition::transport::SubscribeOptions opts;
+  opts.SetMsgsPerSec(kMaxUpdateRate);
   if (!this->dataPtr->ignNode.Subscribe(this->dataPtr->introspectFilterTopic,
-      &IntrospectionCurveHandler::OnIntrospection, this))
+      &IntrospectionCurveHandler::OnIntrospection, this, opts))
   {
     gzerr << "Error subscribing to introspection manager" << std::endl;
     return;
@@ -14,7 +14,10 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
+#include <cmath>
 #include <map>
+#include <vector>
 #include <ignition/math/Color.hh>
 
 #include "gazebo/common/Assert.hh"
@@ -50,8 +53,13 @@ namespace gazebo
           Colors[ColorGroupCount][ColorCount];
     };
 
-    /// \brief A class that manages curve data
-    class CurveData: public QwtArraySeriesData<QPointF>
+    /// \brief A class that manages curve data. The samples are kept in a
+    /// ring buffer of bounded size. Qwt draws a view of the samples in the
+    /// visible x range, decimated to at most four samples (first, minimum,
+    /// maximum and last) per pixel column, which preserves the extremes of
+    /// the curve while bounding the number of drawn points by the width of
+    /// the plot.
+    class CurveData: public QwtSeriesData<QPointF>
     {
       public: CurveData()
               {}
@@ -74,36 +82,42 @@ namespace gazebo
 #endif
                }
 
-      private: inline const QVector<QPointF>& SamplesRef() const
-               {
-#ifdef QWT_VERSION_LT_620
-                 return this->d_samples;
-#else
-                 return this->m_samples;
-#endif
-               }
+      /// \brief Get the number of samples drawn.
+      /// \return Number of samples in the view.
+      public: virtual size_t size() const
+              {
+                this->UpdateView();
+                return this->view.size();
+              }
 
-      private: inline QVector<QPointF>& SamplesRef()
-               {
-#ifdef QWT_VERSION_LT_620
-                 return this->d_samples;
-#else
-                 return this->m_samples;
-#endif
-               }
+      /// \brief Get a sample of the view.
+      /// \param[in] _i Index of the sample in the view.
+      /// \return The sample.
+      public: virtual QPointF sample(size_t _i) const
+              {
+                this->UpdateView();
+                return this->view[_i];
+              }
+
+      /// \brief Set the area of the plot that is drawn.
+      /// \param[in] _rect The area, in plot coordinates.
+      public: virtual void setRectOfInterest(const QRectF &_rect)
+              {
+                if (_rect == this->rectOfInterest)
+                  return;
+
+                this->rectOfInterest = _rect;
+                this->viewDirty = true;
+              }
 
       /// \brief Bounding rectangle accessor. This create the object
       /// if it does not already exist or is too small.
       /// \return Bounding box of the sample.
       public: virtual QRectF boundingRect() const
               {
-                if (this->BoundingRect().width() < 0.0)
+                if (this->BoundingRect().width() < 0.0 || this->boundsDirty)
                 {
-#ifdef QWT_VERSION_LT_620
-                  this->d_boundingRect = qwtBoundingRect(*this);
-#else
-                  this->cachedBoundingRect = qwtBoundingRect(*this);
-#endif
+                  this->UpdateBoundingRect();
                 }
 
                 // set a minimum bounding box height
@@ -132,16 +146,33 @@ namespace gazebo
       /// \param[in] _point Point to add.
       public: inline void Add(const QPointF &_point)
               {
-                this->SamplesRef() += _point;
+                this->viewDirty = true;
+
+                const size_t count = this->samples.size();
+                if (count > 0 && _point.x() < this->Sample(count - 1).x())
+                  this->monotonic = false;
 
-                if (this->SamplesRef().size() > maxSampleSize)
+                if (count < this->historySize)
+                {
+                  this->samples.push_back(_point);
+                }
+                else
                 {
-                  // remove sample window
-                  // update bounding rect?
-                  this->SamplesRef().remove(0, windowSize);
+                  // Overwrite the oldest sample. The bounds only need to
+                  // be computed again if it was on the bounding rect.
+                  const QPointF old = this->samples[this->start];
+                  this->samples[this->start] = _point;
+                  this->start = (this->start + 1) % count;
+
+                  const QRectF &rect = this->BoundingRect();
+                  if (old.x() <= rect.left() || old.x() >= rect.right() ||
+                      old.y() <= rect.top() || old.y() >= rect.bottom())
+                  {
+                    this->boundsDirty = true;
+                  }
                 }
 
-                if (this->SamplesRef().size() == 1)
+                if (this->samples.size() == 1)
                 {
                   // init bounding rect
                   this->BoundingRect().setTopLeft(_point);
@@ -163,8 +194,12 @@ namespace gazebo
       /// \brief Clear the sample data.
       public: void Clear()
               {
-                this->SamplesRef().clear();
-                this->SamplesRef().squeeze();
+                std::vector<QPointF>().swap(this->samples);
+                std::vector<QPointF>().swap(this->view);
+                this->start = 0;
+                this->monotonic = true;
+                this->boundsDirty = false;
+                this->viewDirty = true;
                 this->BoundingRect() = QRectF(0.0, 0.0, -1.0, -1.0);
               }
 
@@ -172,14 +207,225 @@ namespace gazebo
       /// \return A vector of same points.
       public: QVector<QPointF> Samples() const
               {
-                return this->SamplesRef();
+                QVector<QPointF> result;
+                result.reserve(static_cast<int>(this->samples.size()));
+                for (size_t i = 0; i < this->samples.size(); ++i)
+                  result.push_back(this->Sample(i));
+                return result;
+              }
+
+      /// \brief Get the number of samples stored.
+      /// \return Number of samples.
+      public: size_t SampleCount() const
+              {
+                return this->samples.size();
+              }
+
+      /// \brief Get a sample, from the oldest to the newest.
+      /// \param[in] _i Index of the sample.
+      /// \return The sample.
+      public: const QPointF &Sample(const size_t _i) const
+              {
+                size_t index = this->start + _i;
+                if (index >= this->samples.size())
+                  index -= this->samples.size();
+                return this->samples[index];
+              }
+
+      /// \brief Set the number of samples stored, dropping the oldest
+      /// samples if there are more.
+      /// \param[in] _size Maximum number of samples.
+      public: void SetHistorySize(const size_t _size)
+              {
+                QVector<QPointF> all = this->Samples();
+                const int first = std::max(0,
+                    all.size() - static_cast<int>(std::max<size_t>(_size, 1)));
+
+                this->historySize = std::max<size_t>(_size, 1);
+                this->Clear();
+                this->samples.reserve(std::min<size_t>(this->historySize,
+                    all.size() - first));
+                for (int i = first; i < all.size(); ++i)
+                  this->Add(all[i]);
+              }
+
+      /// \brief Get the number of samples stored.
+      /// \return Maximum number of samples.
+      public: size_t HistorySize() const
+              {
+                return this->historySize;
+              }
+
+      /// \brief Set the number of pixel columns the curve is drawn on.
+      /// \param[in] _width Width in pixels, 0 to draw all samples.
+      public: void SetPixelWidth(const unsigned int _width)
+              {
+                if (_width == this->pixelWidth)
+                  return;
+
+                this->pixelWidth = _width;
+                this->viewDirty = true;
               }
 
-      /// \brief maxium sample size of this curve.
-      private: int maxSampleSize = 11000;
+      /// \brief Compute the bounding rect of all the samples.
+      private: void UpdateBoundingRect() const
+               {
+                 QRectF rect(0.0, 0.0, -1.0, -1.0);
+                 if (!this->samples.empty())
+                 {
+                   double minX = this->samples[0].x();
+                   double maxX = minX;
+                   double minY = this->samples[0].y();
+                   double maxY = minY;
+                   for (const auto &pt : this->samples)
+                   {
+                     minX = std::min(minX, pt.x());
+                     maxX = std::max(maxX, pt.x());
+                     minY = std::min(minY, pt.y());
+                     maxY = std::max(maxY, pt.y());
+                   }
+                   rect.setCoords(minX, minY, maxX, maxY);
+                 }
+
+#ifdef QWT_VERSION_LT_620
+                 this->d_boundingRect = rect;
+#else
+                 this->cachedBoundingRect = rect;
+#endif
+                 this->boundsDirty = false;
+               }
 
-      /// \brief Size of samples to remove when maxSampleSize is reached.
-      private: int windowSize = 1000;
+      /// \brief Update the samples drawn, if the samples, the rect of
+      /// interest or the pixel width changed.
+      private: void UpdateView() const
+               {
+                 if (!this->viewDirty)
+                   return;
+                 this->viewDirty = false;
+                 this->view.clear();
+
+                 const size_t count = this->samples.size();
+                 const double x0 = this->rectOfInterest.left();
+                 const double x1 = this->rectOfInterest.right();
+
+                 // The view can only be searched and decimated if the
+                 // samples are sorted by x
+                 if (!this->monotonic || this->pixelWidth == 0u ||
+                     !(x1 > x0))
+                 {
+                   this->view.reserve(count);
+                   for (size_t i = 0; i < count; ++i)
+                     this->view.push_back(this->Sample(i));
+                   return;
+                 }
+
+                 // Find the visible samples, plus one on each side so that
+                 // the lines reach the edges of the plot
+                 size_t first = this->LowerBound(x0);
+                 size_t last = this->LowerBound(x1);
+                 if (first > 0)
+                   --first;
+                 if (last >= count)
+                   last = count - 1;
+                 if (count == 0 || first > last)
+                   return;
+
+                 const size_t maxCount = 4u * this->pixelWidth;
+                 if (last - first + 1 <= maxCount)
+                 {
+                   this->view.reserve(last - first + 1);
+                   for (size_t i = first; i <= last; ++i)
+                     this->view.push_back(this->Sample(i));
+                   return;
+                 }
+
+                 // Keep the first, minimum, maximum and last samples of
+                 // each pixel column
+                 this->view.reserve(maxCount + 2);
+                 const double columnWidth = (x1 - x0) / this->pixelWidth;
+                 size_t i = first;
+                 while (i <= last)
+                 {
+                   const double column =
+                       std::floor((this->Sample(i).x() - x0) / columnWidth);
+                   size_t indices[4] = {i, i, i, i};
+                   double minY = this->Sample(i).y();
+                   double maxY = minY;
+
+                   for (++i; i <= last; ++i)
+                   {
+                     const QPointF &pt = this->Sample(i);
+                     if (std::floor((pt.x() - x0) / columnWidth) != column)
+                       break;
+
+                     if (pt.y() < minY)
+                     {
+                       minY = pt.y();
+                       indices[1] = i;
+                     }
+                     if (pt.y() > maxY)
+                     {
+                       maxY = pt.y();
+                       indices[2] = i;
+                     }
+                     indices[3] = i;
+                   }
+
+                   std::sort(indices, indices + 4);
+                   for (int k = 0; k < 4; ++k)
+                   {
+                     if (k == 0 || indices[k] != indices[k - 1])
+                       this->view.push_back(this->Sample(indices[k]));
+                   }
+                 }
+               }
+
+      /// \brief Find the first sample not before an x value, in samples
+      /// sorted by x.
+      /// \param[in] _x The x value.
+      /// \return Index of the sample, the number of samples if none.
+      private: size_t LowerBound(const double _x) const
+               {
+                 size_t low = 0;
+                 size_t high = this->samples.size();
+                 while (low < high)
+                 {
+                   const size_t mid = low + (high - low) / 2;
+                   if (this->Sample(mid).x() < _x)
+                     low = mid + 1;
+                   else
+                     high = mid;
+                 }
+                 return low;
+               }
+
+      /// \brief Ring buffer of samples.
+      private: std::vector<QPointF> samples;
+
+      /// \brief Index of the oldest sample in the ring buffer.
+      private: size_t start = 0;
+
+      /// \brief Maximum number of samples stored.
+      private: size_t historySize = 11000;
+
+      /// \brief True while the samples are sorted by x.
+      private: bool monotonic = true;
+
+      /// \brief True if an evicted sample was on the bounding rect.
+      private: mutable bool boundsDirty = false;
+
+      /// \brief Number of pixel columns of the plot, 0 to draw all
+      /// samples.
+      private: unsigned int pixelWidth = 0;
+
+      /// \brief Area of the plot that is drawn.
+      private: QRectF rectOfInterest;
+
+      /// \brief Samples drawn.
+      private: mutable std::vector<QPointF> view;
+
+      /// \brief True if the view needs to be computed again.
+      private: mutable bool viewDirty = true;
     };
 
 
@@ -395,7 +641,7 @@ void PlotCurve::SetAge(const unsigned int _age)
 /////////////////////////////////////////////////
 unsigned int PlotCurve::Size() const
 {
-  return static_cast<unsigned int>(this->dataPtr->curveData->samples().size());
+  return static_cast<unsigned int>(this->dataPtr->curveData->SampleCount());
 }
 
 /////////////////////////////////////////////////
@@ -415,17 +661,54 @@ ignition::math::Vector2d PlotCurve::Max()
 /////////////////////////////////////////////////
 ignition::math::Vector2d PlotCurve::Point(const unsigned int _index) const
 {
-  if (_index >= static_cast<unsigned int>(
-      this->dataPtr->curveData->samples().size()))
+  if (_index >= this->dataPtr->curveData->SampleCount())
   {
     return ignition::math::Vector2d(ignition::math::NAN_D,
         ignition::math::NAN_D);
   }
 
-  const QPointF &pt = this->dataPtr->curveData->samples()[_index];
+  const QPointF &pt = this->dataPtr->curveData->Sample(_index);
   return ignition::math::Vector2d(pt.x(), pt.y());
 }
 
+/////////////////////////////////////////////////
+std::vector<ignition::math::Vector2d> PlotCurve::Points() const
+{
+  std::vector<ignition::math::Vector2d> points;
+  const size_t count = this->dataPtr->curveData->SampleCount();
+  points.reserve(count);
+  for (size_t i = 0; i < count; ++i)
+  {
+    const QPointF &pt = this->dataPtr->curveData->Sample(i);
+    points.push_back(ignition::math::Vector2d(pt.x(), pt.y()));
+  }
+  return points;
+}
+
+/////////////////////////////////////////////////
+unsigned int PlotCurve::DrawnSize() const
+{
+  return static_cast<unsigned int>(this->dataPtr->curveData->size());
+}
+
+/////////////////////////////////////////////////
+void PlotCurve::SetHistorySize(const unsigned int _size)
+{
+  this->dataPtr->curveData->SetHistorySize(_size);
+}
+
+/////////////////////////////////////////////////
+unsigned int PlotCurve::HistorySize() const
+{
+  return static_cast<unsigned int>(this->dataPtr->curveData->HistorySize());
+}
+
+/////////////////////////////////////////////////
+void PlotCurve::SetPixelWidth(const unsigned int _width)
+{
+  this->dataPtr->curveData->SetPixelWidth(_width);
+}
+
 /////////////////////////////////////////////////
 QwtPlotCurve *PlotCurve::Curve()
 {
@@ -121,6 +121,26 @@ namespace gazebo
       /// \return Curve sample points
       public: std::vector<ignition::math::Vector2d> Points() const;
 
+      /// \brief Set the number of points kept by the curve. The oldest
+      /// points are dropped when more are added.
+      /// \param[in] _size Maximum number of points, 11000 by default.
+      public: void SetHistorySize(const unsigned int _size);
+
+      /// \brief Get the number of points kept by the curve.
+      /// \return Maximum number of points.
+      public: unsigned int HistorySize() const;
+
+      /// \brief Set the width of the plot the curve is drawn on. The points
+      /// drawn are decimated to the first, minimum, maximum and last points
+      /// of each pixel column.
+      /// \param[in] _width Width in pixels, 0 to draw all points.
+      public: void SetPixelWidth(const unsigned int _width);
+
+      /// \brief Get the number of points drawn in the visible range of the
+      /// plot, after decimation.
+      /// \return Number of points drawn.
+      public: unsigned int DrawnSize() const;
+
       /// \internal
       /// \brief Get the internal QwtPlotCurve object.
       /// \return QwtPlotCurve object.
@@ -133,5 +133,46 @@ void PlotCurve_TEST::AddPoint()
   delete plotCurve;
 }
 
+/////////////////////////////////////////////////
+void PlotCurve_TEST::HistorySize()
+{
+  this->resMaxPercentChange = 5.0;
+  this->shareMaxPercentChange = 2.0;
+
+  this->Load("worlds/empty.world");
+
+  gazebo::gui::PlotCurve *plotCurve = new gazebo::gui::PlotCurve("curve01");
+  QVERIFY(plotCurve != nullptr);
+  QCOMPARE(plotCurve->HistorySize(), 11000u);
+
+  plotCurve->SetHistorySize(5u);
+  QCOMPARE(plotCurve->HistorySize(), 5u);
+
+  // only the newest points are kept
+  for (unsigned int i = 0; i < 12u; ++i)
+    plotCurve->AddPoint(ignition::math::Vector2d(i, i * i));
+  QCOMPARE(plotCurve->Size(), 5u);
+  for (unsigned int i = 0; i < 5u; ++i)
+  {
+    QCOMPARE(plotCurve->Point(i),
+        ignition::math::Vector2d(7 + i, (7 + i) * (7 + i)));
+  }
+
+  std::vector<ignition::math::Vector2d> points = plotCurve->Points();
+  QCOMPARE(points.size(), size_t(5));
+  QCOMPARE(points.back(), ignition::math::Vector2d(11, 121));
+
+  // the bounds only cover the points kept
+  QCOMPARE(plotCurve->Min(), ignition::math::Vector2d(7, 49));
+  QCOMPARE(plotCurve->Max(), ignition::math::Vector2d(11, 121));
+
+  // shrinking the history drops the oldest points
+  plotCurve->SetHistorySize(2u);
+  QCOMPARE(plotCurve->Size(), 2u);
+  QCOMPARE(plotCurve->Point(0), ignition::math::Vector2d(10, 100));
+
+  delete plotCurve;
+}
+
 // Generate a main function for the test
 QTEST_MAIN(PlotCurve_TEST)
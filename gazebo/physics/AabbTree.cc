@@ -0,0 +1,431 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <utility>
+
+#include "gazebo/physics/AabbTree.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \internal
+    /// \brief A node of the tree.
+    class AabbTreeNode
+    {
+      /// \brief Minimum corner of the node.
+      public: double min[3];
+
+      /// \brief Maximum corner of the node.
+      public: double max[3];
+
+      /// \brief Index of the first child of an inner node, whose second
+      /// child follows it; or index of the first box of a leaf.
+      public: uint32_t first = 0;
+
+      /// \brief Number of boxes of a leaf, zero for an inner node.
+      public: uint32_t count = 0;
+    };
+
+    /// \internal
+    /// \brief Private data for AabbTree.
+    class AabbTreePrivate
+    {
+      /// \brief Build the nodes of a range of boxes.
+      /// \param[in] _node Index of the node to build.
+      /// \param[in] _first First item of the range in the box order.
+      /// \param[in] _count Number of items of the range.
+      public: void Build(const uint32_t _node, const uint32_t _first,
+                  const uint32_t _count);
+
+      /// \brief Maximum number of boxes of a leaf.
+      public: static const uint32_t kLeafSize = 4;
+
+      /// \brief Nodes, the root first.
+      public: std::vector<AabbTreeNode> nodes;
+
+      /// \brief Indices of the bounded boxes, in leaf order.
+      public: std::vector<uint32_t> order;
+
+      /// \brief Bounds of the bounded boxes, six values per box.
+      public: std::vector<double> bounds;
+
+      /// \brief Indices of the boxes with infinite bounds.
+      public: std::vector<uint32_t> unbounded;
+
+      /// \brief Number of boxes.
+      public: size_t size = 0;
+    };
+  }
+}
+
+using namespace gazebo;
+using namespace physics;
+
+/////////////////////////////////////////////////
+/// \brief Intersect a ray with a box.
+/// \param[in] _min Minimum corner of the box.
+/// \param[in] _max Maximum corner of the box.
+/// \param[in] _start Start of the ray.
+/// \param[in] _invDir Inverse of the direction of the ray.
+/// \param[in] _length Length of the ray.
+/// \param[out] _entry Distance at which the ray enters the box.
+/// \return True if the ray crosses the box.
+static bool RayBox(const double *_min, const double *_max,
+    const double *_start, const double *_invDir, const double _length,
+    double &_entry)
+{
+  double near = 0.0;
+  double far = _length;
+  for (int i = 0; i < 3; ++i)
+  {
+    double t1 = (_min[i] - _start[i]) * _invDir[i];
+    double t2 = (_max[i] - _start[i]) * _invDir[i];
+
+    // A ray parallel to the slab, starting on its boundary, gives NaN
+    if (std::isnan(t1) || std::isnan(t2))
+      continue;
+
+    near = std::max(near, std::min(t1, t2));
+    far = std::min(far, std::max(t1, t2));
+  }
+  _entry = near;
+  return near <= far;
+}
+
+//////////////////////////////////////////////////
+void AabbTreePrivate::Build(const uint32_t _node, const uint32_t _first,
+    const uint32_t _count)
+{
+  // Bounds of the boxes, and of their centers
+  double centerMin[3];
+  double centerMax[3];
+  for (int i = 0; i < 3; ++i)
+  {
+    this->nodes[_node].min[i] = std::numeric_limits<double>::max();
+    this->nodes[_node].max[i] = -std::numeric_limits<double>::max();
+    centerMin[i] = std::numeric_limits<double>::max();
+    centerMax[i] = -std::numeric_limits<double>::max();
+  }
+
+  for (uint32_t k = _first; k < _first + _count; ++k)
+  {
+    const double *box = &this->bounds[6 * this->order[k]];
+    for (int i = 0; i < 3; ++i)
+    {
+      this->nodes[_node].min[i] = std::min(this->nodes[_node].min[i], box[i]);
+      this->nodes[_node].max[i] =
+        std::max(this->nodes[_node].max[i], box[i + 3]);
+      const double center = 0.5 * (box[i] + box[i + 3]);
+      centerMin[i] = std::min(centerMin[i], center);
+      centerMax[i] = std::max(centerMax[i], center);
+    }
+  }
+
+  if (_count <= kLeafSize)
+  {
+    this->nodes[_node].first = _first;
+    this->nodes[_node].count = _count;
+    return;
+  }
+
+  // Split at the median center along the longest axis
+  int axis = 0;
+  for (int i = 1; i < 3; ++i)
+  {
+    if (centerMax[i] - centerMin[i] > centerMax[axis] - centerMin[axis])
+      axis = i;
+  }
+
+  const uint32_t half = _count / 2;
+  std::nth_element(this->order.begin() + _first,
+      this->order.begin() + _first + half,
+      this->order.begin() + _first + _count,
+      [this, axis](const uint32_t _a, const uint32_t _b)
+      {
+        return this->bounds[6 * _a + axis] + this->bounds[6 * _a + axis + 3] <
+          this->bounds[6 * _b + axis] + this->bounds[6 * _b + axis + 3];
+      });
+
+  const uint32_t child = static_cast<uint32_t>(this->nodes.size());
+  this->nodes[_node].first = child;
+  this->nodes[_node].count = 0;
+  this->nodes.resize(this->nodes.size() + 2);
+
+  this->Build(child, _first, half);
+  this->Build(child + 1, _first + half, _count - half);
+}
+
+//////////////////////////////////////////////////
+AabbTree::AabbTree()
+: dataPtr(new AabbTreePrivate)
+{
+}
+
+//////////////////////////////////////////////////
+AabbTree::~AabbTree()
+{
+}
+
+//////////////////////////////////////////////////
+void AabbTree::Build(
+    const std::vector<ignition::math::AxisAlignedBox> &_boxes)
+{
+  this->dataPtr->nodes.clear();
+  this->dataPtr->order.clear();
+  this->dataPtr->unbounded.clear();
+  this->dataPtr->bounds.assign(6 * _boxes.size(), 0.0);
+  this->dataPtr->size = _boxes.size();
+
+  for (size_t i = 0; i < _boxes.size(); ++i)
+  {
+    const ignition::math::Vector3d &min = _boxes[i].Min();
+    const ignition::math::Vector3d &max = _boxes[i].Max();
+    double *box = &this->dataPtr->bounds[6 * i];
+    box[0] = min.X();
+    box[1] = min.Y();
+    box[2] = min.Z();
+    box[3] = max.X();
+    box[4] = max.Y();
+    box[5] = max.Z();
+
+    bool finite = true;
+    for (int j = 0; j < 6; ++j)
+      finite = finite && std::isfinite(box[j]);
+
+    if (finite)
+      this->dataPtr->order.push_back(static_cast<uint32_t>(i));
+    else
+      this->dataPtr->unbounded.push_back(static_cast<uint32_t>(i));
+  }
+
+  if (!this->dataPtr->order.empty())
+  {
+    this->dataPtr->nodes.resize(1);
+    this->dataPtr->Build(0, 0,
+        static_cast<uint32_t>(this->dataPtr->order.size()));
+  }
+}
+
+//////////////////////////////////////////////////
+void AabbTree::Refit(
+    const std::vector<ignition::math::AxisAlignedBox> &_boxes)
+{
+  if (_boxes.size() != this->dataPtr->size)
+  {
+    this->Build(_boxes);
+    return;
+  }
+
+  for (size_t i = 0; i < _boxes.size(); ++i)
+  {
+    const ignition::math::Vector3d &min = _boxes[i].Min();
+    const ignition::math::Vector3d &max = _boxes[i].Max();
+    double *box = &this->dataPtr->bounds[6 * i];
+    box[0] = min.X();
+    box[1] = min.Y();
+    box[2] = min.Z();
+    box[3] = max.X();
+    box[4] = max.Y();
+    box[5] = max.Z();
+  }
+
+  // A box that became, or stopped being, unbounded changes the structure
+  size_t unbounded = 0;
+  for (size_t i = 0; i < _boxes.size(); ++i)
+  {
+    bool finite = true;
+    for (int j = 0; j < 6; ++j)
+      finite = finite && std::isfinite(this->dataPtr->bounds[6 * i + j]);
+    if (!finite)
+    {
+      if (unbounded >= this->dataPtr->unbounded.size() ||
+          this->dataPtr->unbounded[unbounded] != i)
+      {
+        this->Build(_boxes);
+        return;
+      }
+      ++unbounded;
+    }
+  }
+  if (unbounded != this->dataPtr->unbounded.size())
+  {
+    this->Build(_boxes);
+    return;
+  }
+
+  // Children follow their parent, so a reverse pass refits them first
+  for (size_t n = this->dataPtr->nodes.size(); n-- > 0;)
+  {
+    AabbTreeNode &node = this->dataPtr->nodes[n];
+    for (int i = 0; i < 3; ++i)
+    {
+      node.min[i] = std::numeric_limits<double>::max();
+      node.max[i] = -std::numeric_limits<double>::max();
+    }
+
+    if (node.count > 0)
+    {
+      for (uint32_t k = node.first; k < node.first + node.count; ++k)
+      {
+        const double *box = &this->dataPtr->bounds[6 * this->dataPtr->order[k]];
+        for (int i = 0; i < 3; ++i)
+        {
+          node.min[i] = std::min(node.min[i], box[i]);
+          node.max[i] = std::max(node.max[i], box[i + 3]);
+        }
+      }
+    }
+    else
+    {
+      for (uint32_t c = node.first; c < node.first + 2; ++c)
+      {
+        const AabbTreeNode &child = this->dataPtr->nodes[c];
+        for (int i = 0; i < 3; ++i)
+        {
+          node.min[i] = std::min(node.min[i], child.min[i]);
+          node.max[i] = std::max(node.max[i], child.max[i]);
+        }
+      }
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+size_t AabbTree::Size() const
+{
+  return this->dataPtr->size;
+}
+
+//////////////////////////////////////////////////
+void AabbTree::Raycast(const ignition::math::Vector3d &_start,
+    const ignition::math::Vector3d &_dir, const double _length,
+    const VisitFunction &_visit) const
+{
+  double length = _length;
+  for (auto index : this->dataPtr->unbounded)
+    length = _visit(index, length);
+
+  if (this->dataPtr->nodes.empty())
+    return;
+
+  const double start[3] = {_start.X(), _start.Y(), _start.Z()};
+  const double invDir[3] = {1.0 / _dir.X(), 1.0 / _dir.Y(), 1.0 / _dir.Z()};
+
+  // Nodes to visit, with the distance at which the ray enters them
+  std::pair<uint32_t, double> stack[64];
+  int top = 0;
+
+  double entry;
+  const AabbTreeNode &root = this->dataPtr->nodes[0];
+  if (!RayBox(root.min, root.max, start, invDir, length, entry))
+    return;
+  stack[top++] = std::make_pair(0u, entry);
+
+  while (top > 0)
+  {
+    const std::pair<uint32_t, double> item = stack[--top];
+    if (item.second > length)
+      continue;
+
+    const AabbTreeNode &node = this->dataPtr->nodes[item.first];
+    if (node.count > 0)
+    {
+      for (uint32_t k = node.first; k < node.first + node.count; ++k)
+      {
+        const uint32_t index = this->dataPtr->order[k];
+        const double *box = &this->dataPtr->bounds[6 * index];
+        if (RayBox(box, box + 3, start, invDir, length, entry))
+          length = _visit(index, length);
+      }
+      continue;
+    }
+
+    // Push the farthest child first, to visit the nearest one first
+    double entries[2];
+    bool hits[2];
+    for (int c = 0; c < 2; ++c)
+    {
+      const AabbTreeNode &child = this->dataPtr->nodes[node.first + c];
+      hits[c] = RayBox(child.min, child.max, start, invDir, length,
+          entries[c]);
+    }
+
+    const int nearest = (hits[0] && hits[1] && entries[1] < entries[0]) ?
+      1 : 0;
+    for (int c : {1 - nearest, nearest})
+    {
+      if (hits[c] && top < 64)
+        stack[top++] = std::make_pair(node.first + c, entries[c]);
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+void AabbTree::Query(const OverlapFunction &_overlaps,
+    const std::function<void (const size_t _index)> &_visit) const
+{
+  auto toBox = [](const double *_min, const double *_max)
+  {
+    return ignition::math::AxisAlignedBox(
+        ignition::math::Vector3d(_min[0], _min[1], _min[2]),
+        ignition::math::Vector3d(_max[0], _max[1], _max[2]));
+  };
+
+  for (auto index : this->dataPtr->unbounded)
+  {
+    const double *box = &this->dataPtr->bounds[6 * index];
+    if (_overlaps(toBox(box, box + 3)))
+      _visit(index);
+  }
+
+  if (this->dataPtr->nodes.empty())
+    return;
+
+  uint32_t stack[64];
+  int top = 0;
+  stack[top++] = 0;
+
+  while (top > 0)
+  {
+    const AabbTreeNode &node = this->dataPtr->nodes[stack[--top]];
+    if (!_overlaps(toBox(node.min, node.max)))
+      continue;
+
+    if (node.count > 0)
+    {
+      for (uint32_t k = node.first; k < node.first + node.count; ++k)
+      {
+        const uint32_t index = this->dataPtr->order[k];
+        const double *box = &this->dataPtr->bounds[6 * index];
+        if (_overlaps(toBox(box, box + 3)))
+          _visit(index);
+      }
+      continue;
+    }
+
+    if (top < 63)
+    {
+      stack[top++] = node.first;
+      stack[top++] = node.first + 1;
+    }
+  }
+}
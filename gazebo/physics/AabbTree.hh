@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_AABBTREE_HH_
+#define GAZEBO_PHYSICS_AABBTREE_HH_
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <ignition/math/AxisAlignedBox.hh>
+#include <ignition/math/Vector3.hh>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    // Forward declare private data class.
+    class AabbTreePrivate;
+
+    /// \addtogroup gazebo_physics
+    /// \{
+
+    /// \class AabbTree AabbTree.hh physics/physics.hh
+    /// \brief Bounding volume hierarchy of axis aligned boxes, used to find
+    /// the objects that a ray may hit or that overlap a region.
+    ///
+    /// The tree is built once and is then read only: it may be queried by
+    /// several threads at the same time. Boxes with infinite bounds, such as
+    /// the boxes of planes, are tested by every query.
+    class GZ_PHYSICS_VISIBLE AabbTree
+    {
+      /// \brief Function called for a box crossed by a ray.
+      /// \param[in] _index Index of the box given to Build.
+      /// \param[in] _length Current length of the ray.
+      /// \return New length of the ray, e.g. the distance to a hit of the
+      /// object in the box, which prunes the boxes further away.
+      public: typedef std::function<double (const size_t _index,
+                  const double _length)> VisitFunction;
+
+      /// \brief Function testing a box against a query region.
+      /// \param[in] _box The box.
+      /// \return True if the box may overlap the region.
+      public: typedef std::function<bool (
+                  const ignition::math::AxisAlignedBox &_box)> OverlapFunction;
+
+      /// \brief Constructor.
+      public: AabbTree();
+
+      /// \brief Destructor.
+      public: virtual ~AabbTree();
+
+      /// \brief Build the tree, replacing the previous boxes.
+      /// \param[in] _boxes The boxes.
+      public: void Build(
+                  const std::vector<ignition::math::AxisAlignedBox> &_boxes);
+
+      /// \brief Update the bounds of the boxes, keeping the tree structure,
+      /// which is faster than Build while the boxes move little. The tree is
+      /// built again if the number of boxes, or the set of boxes with
+      /// infinite bounds, changed.
+      /// \param[in] _boxes The boxes, in the order given to Build.
+      public: void Refit(
+                  const std::vector<ignition::math::AxisAlignedBox> &_boxes);
+
+      /// \brief Get the number of boxes.
+      /// \return Number of boxes given to Build.
+      public: size_t Size() const;
+
+      /// \brief Visit the boxes crossed by a ray segment, roughly nearest
+      /// first.
+      /// \param[in] _start Start of the ray.
+      /// \param[in] _dir Unit direction of the ray.
+      /// \param[in] _length Length of the ray.
+      /// \param[in] _visit Function called for each box crossed before the
+      /// current length of the ray.
+      public: void Raycast(const ignition::math::Vector3d &_start,
+                  const ignition::math::Vector3d &_dir, const double _length,
+                  const VisitFunction &_visit) const;
+
+      /// \brief Visit the boxes that overlap a region, in no particular
+      /// order.
+      /// \param[in] _overlaps Function testing whether a box may overlap
+      /// the region, called for the nodes of the tree and for each box.
+      /// \param[in] _visit Function called with the index of each box that
+      /// overlaps the region.
+      public: void Query(const OverlapFunction &_overlaps,
+                  const std::function<void (const size_t _index)> &_visit)
+                  const;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<AabbTreePrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,225 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <set>
+#include <vector>
+
+#include <ignition/math/Helpers.hh>
+
+#include "gazebo/physics/AabbTree.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class AabbTreeTest : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+/// \brief Get the boxes of a 10x10x10 grid of unit cubes, one in two
+/// omitted.
+/// \return The boxes.
+static std::vector<ignition::math::AxisAlignedBox> GridBoxes()
+{
+  std::vector<ignition::math::AxisAlignedBox> boxes;
+  for (int x = 0; x < 10; ++x)
+  {
+    for (int y = 0; y < 10; ++y)
+    {
+      for (int z = 0; z < 10; ++z)
+      {
+        if ((x + y + z) % 2)
+          continue;
+        boxes.push_back(ignition::math::AxisAlignedBox(
+              ignition::math::Vector3d(2 * x, 2 * y, 2 * z),
+              ignition::math::Vector3d(2 * x + 1, 2 * y + 1, 2 * z + 1)));
+      }
+    }
+  }
+  return boxes;
+}
+
+/////////////////////////////////////////////////
+TEST_F(AabbTreeTest, Raycast)
+{
+  std::vector<ignition::math::AxisAlignedBox> boxes = GridBoxes();
+  physics::AabbTree tree;
+  tree.Build(boxes);
+  EXPECT_EQ(boxes.size(), tree.Size());
+
+  // A ray along the first row of boxes, which visits all of them
+  std::set<size_t> visited;
+  tree.Raycast(ignition::math::Vector3d(-1, 0.5, 0.5),
+      ignition::math::Vector3d::UnitX, 100,
+      [&visited](const size_t _index, const double _length)
+      {
+        visited.insert(_index);
+        return _length;
+      });
+
+  std::set<size_t> expected;
+  for (size_t i = 0; i < boxes.size(); ++i)
+  {
+    if (boxes[i].Min().Y() < 0.5 && boxes[i].Min().Z() < 0.5)
+      expected.insert(i);
+  }
+  EXPECT_EQ(5u, expected.size());
+  EXPECT_EQ(expected, visited);
+
+  // Hitting the first box prunes the others
+  visited.clear();
+  tree.Raycast(ignition::math::Vector3d(-1, 0.5, 0.5),
+      ignition::math::Vector3d::UnitX, 100,
+      [&](const size_t _index, const double _length)
+      {
+        visited.insert(_index);
+        return std::min(_length, boxes[_index].Min().X() + 1);
+      });
+  EXPECT_LE(visited.size(), 2u);
+  bool first = false;
+  for (auto index : visited)
+  {
+    EXPECT_LE(boxes[index].Min().X(), 2.0);
+    first = first || boxes[index].Min().X() < 1.0;
+  }
+  EXPECT_TRUE(first);
+
+  // A short ray, between two boxes
+  visited.clear();
+  tree.Raycast(ignition::math::Vector3d(1.2, 0.5, 0.5),
+      ignition::math::Vector3d::UnitX, 0.5,
+      [&visited](const size_t _index, const double _length)
+      {
+        visited.insert(_index);
+        return _length;
+      });
+  EXPECT_TRUE(visited.empty());
+}
+
+/////////////////////////////////////////////////
+TEST_F(AabbTreeTest, Unbounded)
+{
+  std::vector<ignition::math::AxisAlignedBox> boxes;
+  boxes.push_back(ignition::math::AxisAlignedBox(
+        ignition::math::Vector3d(-ignition::math::INF_D,
+          -ignition::math::INF_D, -ignition::math::INF_D),
+        ignition::math::Vector3d(ignition::math::INF_D,
+          ignition::math::INF_D, 0)));
+
+  physics::AabbTree tree;
+  tree.Build(boxes);
+
+  // Boxes with infinite bounds are always visited
+  unsigned int count = 0;
+  tree.Raycast(ignition::math::Vector3d(0, 0, 10),
+      ignition::math::Vector3d::UnitZ, 1,
+      [&count](const size_t, const double _length)
+      {
+        ++count;
+        return _length;
+      });
+  EXPECT_EQ(1u, count);
+
+  // An empty tree visits nothing
+  tree.Build({});
+  EXPECT_EQ(0u, tree.Size());
+  tree.Raycast(ignition::math::Vector3d::Zero,
+      ignition::math::Vector3d::UnitZ, 1,
+      [&count](const size_t, const double _length)
+      {
+        ++count;
+        return _length;
+      });
+  EXPECT_EQ(1u, count);
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the indices of the boxes that overlap a box, by brute force.
+/// \param[in] _boxes The boxes.
+/// \param[in] _region The box to overlap.
+/// \return The indices.
+static std::set<size_t> Overlapping(
+    const std::vector<ignition::math::AxisAlignedBox> &_boxes,
+    const ignition::math::AxisAlignedBox &_region)
+{
+  std::set<size_t> result;
+  for (size_t i = 0; i < _boxes.size(); ++i)
+  {
+    if (_boxes[i].Intersects(_region))
+      result.insert(i);
+  }
+  return result;
+}
+
+/////////////////////////////////////////////////
+TEST_F(AabbTreeTest, Query)
+{
+  std::vector<ignition::math::AxisAlignedBox> boxes = GridBoxes();
+  physics::AabbTree tree;
+  tree.Build(boxes);
+
+  auto query = [&tree](const ignition::math::AxisAlignedBox &_region)
+  {
+    std::set<size_t> visited;
+    tree.Query(
+        [&_region](const ignition::math::AxisAlignedBox &_box)
+        {
+          return _box.Intersects(_region);
+        },
+        [&visited](const size_t _index)
+        {
+          EXPECT_TRUE(visited.insert(_index).second);
+        });
+    return visited;
+  };
+
+  const ignition::math::AxisAlignedBox region(
+      ignition::math::Vector3d(3.5, 2.5, -1),
+      ignition::math::Vector3d(8, 6, 5));
+  std::set<size_t> expected = Overlapping(boxes, region);
+  EXPECT_FALSE(expected.empty());
+  EXPECT_EQ(expected, query(region));
+
+  // Nothing outside of the grid
+  EXPECT_TRUE(query(ignition::math::AxisAlignedBox(
+          ignition::math::Vector3d(30, 30, 30),
+          ignition::math::Vector3d(31, 31, 31))).empty());
+
+  // Moved boxes are found once refit
+  for (auto &box : boxes)
+    box = box + ignition::math::Vector3d(0, 0, 100);
+  tree.Refit(boxes);
+  EXPECT_EQ(boxes.size(), tree.Size());
+  EXPECT_TRUE(query(region).empty());
+  const ignition::math::AxisAlignedBox moved(
+      region.Min() + ignition::math::Vector3d(0, 0, 100),
+      region.Max() + ignition::math::Vector3d(0, 0, 100));
+  EXPECT_EQ(expected, query(moved));
+
+  // A changed number of boxes builds the tree again
+  boxes.resize(10);
+  tree.Refit(boxes);
+  EXPECT_EQ(10u, tree.Size());
+  EXPECT_EQ(Overlapping(boxes, moved), query(moved));
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -17,7 +17,13 @@
 #include <sstream>
 #include <limits>
 #include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
 
+#include "gazebo/common/BakedSkeletonAnimation.hh"
 #include "gazebo/common/BVHLoader.hh"
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/KeyFrame.hh"
@@ -35,6 +41,48 @@
 
 #include "gazebo/transport/Node.hh"
 
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \brief A skeleton animation baked for the skin of an actor.
+    class ActorTrack
+    {
+      /// \brief Animation that was baked.
+      public: const common::SkeletonAnimation *source = nullptr;
+
+      /// \brief Transforms of the bones, by handle, shared with the actors
+      /// that play the same animation on the same skin.
+      public: std::shared_ptr<common::BakedSkeletonAnimation> baked;
+
+      /// \brief Translations to align a BVH animation to the skin, by handle.
+      public: std::vector<ignition::math::Matrix4d> translationAligner;
+
+      /// \brief Rotations to align a BVH animation to the skin, by handle.
+      public: std::vector<ignition::math::Matrix4d> rotationAligner;
+    };
+
+    /// \brief A bone of the skin of an actor, looked up once.
+    class ActorBone
+    {
+      /// \brief Link of the bone.
+      public: LinkPtr link;
+
+      /// \brief Link of the parent bone, null for the root.
+      public: LinkPtr parentLink;
+
+      /// \brief Handle of the parent bone, -1 for the root.
+      public: int parent = -1;
+
+      /// \brief True for the root bone of the skeleton.
+      public: bool root = false;
+
+      /// \brief Length of the offset of the bone from its parent in the skin.
+      public: double offsetLength = 0.0;
+    };
+  }
+}
+
 /// \brief Private data for Actor class
 class gazebo::physics::ActorPrivate
 {
@@ -49,13 +97,35 @@ class gazebo::physics::ActorPrivate
   public: std::map<std::string, ignition::math::Matrix4d>
       rotationAligner;
 
-  /// \brief Last animated frame
-  public: std::map<std::string, ignition::math::Matrix4d> lastFrame;
+  /// \brief Skeleton animations baked for the skin, by animation name.
+  public: std::map<std::string, ActorTrack> tracks;
+
+  /// \brief Track of the last animated frame, null before the first one.
+  public: const ActorTrack *lastTrack = nullptr;
+
+  /// \brief Last animated frame, the transform of each bone by handle.
+  public: std::vector<ignition::math::Matrix4d> lastFrame;
+
+  /// \brief Bones of the skin, by handle.
+  public: std::vector<ActorBone> bones;
+
+  /// \brief World transforms of the bones set by SetPose, by handle.
+  public: std::vector<ignition::math::Matrix4d> boneWorld;
 
-  /// \brief Last map associating skeleton nodes from skin and animation
-  public: std::map<std::string, std::string> lastSkelMap;
+  /// \brief Whether each bone's world transform was set by SetPose in
+  /// the current frame, by handle.
+  public: std::vector<bool> boneDone;
 };
 
+/// \brief Baked skeleton animations shared by the actors, by animation and
+/// skin skeleton.
+static std::map<std::pair<const gazebo::common::SkeletonAnimation *,
+    const gazebo::common::Skeleton *>,
+    std::weak_ptr<gazebo::common::BakedSkeletonAnimation>> g_bakedAnimations;
+
+/// \brief Mutex to protect g_bakedAnimations.
+static std::mutex g_bakedAnimationsMutex;
+
 using namespace gazebo;
 using namespace physics;
 using namespace common;
@@ -514,6 +584,60 @@ void Actor::LoadAnimation(sdf::ElementPtr _sdf)
   this->skelAnimation[animName] = skel->GetAnimation(0);
   this->interpolateX[animName] = _sdf->Get<bool>("interpolate_x");
   this->skelNodesMap[animName] = skelMap;
+  this->BakeAnimation(animName);
+}
+
+//////////////////////////////////////////////////
+void Actor::BakeAnimation(const std::string &_name)
+{
+  SkeletonAnimation *skelAnim = this->skelAnimation[_name];
+  if (!skelAnim || !this->skeleton)
+    return;
+
+  // Animation node of each skin node, by handle
+  auto &skelMap = this->skelNodesMap[_name];
+  std::vector<std::string> nodes(this->skeleton->GetNumNodes());
+  for (unsigned int i = 0; i < nodes.size(); ++i)
+    nodes[i] = skelMap[this->skeleton->GetNodeByHandle(i)->GetName()];
+
+  ActorTrack &track = this->dataPtr->tracks[_name];
+  track.source = skelAnim;
+  {
+    std::lock_guard<std::mutex> lock(g_bakedAnimationsMutex);
+    auto key = std::make_pair(
+        static_cast<const SkeletonAnimation *>(skelAnim),
+        static_cast<const Skeleton *>(this->skeleton));
+    track.baked = g_bakedAnimations[key].lock();
+    if (!track.baked)
+    {
+      track.baked.reset(new BakedSkeletonAnimation(*skelAnim, nodes));
+      g_bakedAnimations[key] = track.baked;
+    }
+
+    // Forget the animations that no actor plays anymore
+    for (auto iter = g_bakedAnimations.begin();
+         iter != g_bakedAnimations.end();)
+    {
+      if (iter->second.expired())
+        iter = g_bakedAnimations.erase(iter);
+      else
+        ++iter;
+    }
+  }
+
+  track.translationAligner.assign(nodes.size(),
+      ignition::math::Matrix4d::Identity);
+  track.rotationAligner.assign(nodes.size(),
+      ignition::math::Matrix4d::Identity);
+  if (this->dataPtr->bvhFile)
+  {
+    for (unsigned int i = 0; i < nodes.size(); ++i)
+    {
+      track.translationAligner[i] =
+        this->dataPtr->translationAligner[nodes[i]];
+      track.rotationAligner[i] = this->dataPtr->rotationAligner[nodes[i]];
+    }
+  }
 }
 
 //////////////////////////////////////////////////
@@ -676,8 +800,7 @@ void Actor::Update()
   common::Time currentTime = this->world->SimTime();
   if (!this->active)
   {
-    this->SetPose(this->dataPtr->lastFrame, this->dataPtr->lastSkelMap,
-                  currentTime.Double());
+    this->SetPose(currentTime.Double());
     return;
   }
 
@@ -698,8 +821,7 @@ void Actor::Update()
     // waiting for delayed start
     if (this->scriptTime < 0)
     {
-      this->SetPose(this->dataPtr->lastFrame, this->dataPtr->lastSkelMap,
-                    currentTime.Double());
+      this->SetPose(currentTime.Double());
       return;
     }
 
@@ -783,35 +905,33 @@ void Actor::Update()
     return;
   }
 
-  auto skelMap = this->skelNodesMap[tinfo->type];
+  // Bake animations which were set after loading, e.g. by a plugin
+  auto trackIter = this->dataPtr->tracks.find(tinfo->type);
+  if (trackIter == this->dataPtr->tracks.end() ||
+      trackIter->second.source != skelAnim)
+  {
+    this->BakeAnimation(tinfo->type);
+    trackIter = this->dataPtr->tracks.find(tinfo->type);
+  }
+  const ActorTrack &track = trackIter->second;
 
-  std::map<std::string, ignition::math::Matrix4d> frame;
-  if (!this->customTrajectoryInfo)
+  const unsigned int rootHandle = this->skeleton->GetRootNode()->GetHandle();
+  std::vector<ignition::math::Matrix4d> &frame = this->dataPtr->lastFrame;
+  if (!this->customTrajectoryInfo && this->interpolateX[tinfo->type] &&
+      this->trajectories.find(tinfo->id) != this->trajectories.end())
   {
-    if (this->interpolateX[tinfo->type] &&
-          this->trajectories.find(tinfo->id) != this->trajectories.end())
-    {
-      frame = skelAnim->PoseAtX(this->pathLength,
-                skelMap[this->skeleton->GetRootNode()->GetName()]);
-    }
-    else
-    {
-      frame = skelAnim->PoseAt(this->scriptTime);
-    }
+    track.baked->PoseAtX(this->pathLength, rootHandle, frame);
   }
   else
   {
-    frame = skelAnim->PoseAt(this->scriptTime);
+    track.baked->PoseAt(this->scriptTime, frame);
   }
 
   this->lastTraj = tinfo->id;
 
   ignition::math::Matrix4d rootTrans = ignition::math::Matrix4d::Identity;
-  auto iter = frame.find(skelMap[this->skeleton->GetRootNode()->GetName()]);
-  if (iter != frame.end())
-  {
-    rootTrans = frame[skelMap[this->skeleton->GetRootNode()->GetName()]];
-  }
+  if (track.baked->HasNode(rootHandle))
+    rootTrans = frame[rootHandle];
 
   ignition::math::Vector3d rootPos = rootTrans.Translation();
   ignition::math::Quaterniond rootRot = rootTrans.Rotation();
@@ -852,23 +972,51 @@ void Actor::Update()
   // workaround for rotation bug
   rootM.SetTranslation(rootM.Translation() * this->skinScale);
 
-  frame[skelMap[this->skeleton->GetRootNode()->GetName()]] = rootM;
+  frame[rootHandle] = rootM;
+  this->dataPtr->lastTrack = &track;
 
-  this->dataPtr->lastFrame = frame;
-  this->dataPtr->lastSkelMap = skelMap;
-
-  this->SetPose(frame, skelMap, currentTime.Double());
+  this->SetPose(currentTime.Double());
 }
 
 //////////////////////////////////////////////////
-void Actor::SetPose(std::map<std::string, ignition::math::Matrix4d> _frame,
-    std::map<std::string, std::string> _skelMap, const double _time)
+void Actor::SetPose(const double _time)
 {
+  const unsigned int nodeCount = this->skeleton->GetNumNodes();
+
+  // Look up the links of the bones once
+  auto &bones = this->dataPtr->bones;
+  if (bones.size() != nodeCount)
+  {
+    bones.assign(nodeCount, ActorBone());
+    for (unsigned int i = 0; i < nodeCount; ++i)
+    {
+      SkeletonNode *bone = this->skeleton->GetNodeByHandle(i);
+      SkeletonNode *parentBone = bone->GetParent();
+      bones[i].link = this->GetChildLink(bone->GetName());
+      bones[i].root = (parentBone == nullptr);
+      bones[i].offsetLength = bone->Transform().Translation().Length();
+      if (parentBone)
+      {
+        bones[i].parent = parentBone->GetHandle();
+        bones[i].parentLink = this->GetChildLink(parentBone->GetName());
+      }
+    }
+    this->dataPtr->boneWorld.assign(nodeCount,
+        ignition::math::Matrix4d::Identity);
+  }
+  this->dataPtr->boneDone.assign(nodeCount, false);
+
+  // Only build the message if someone listens to it
+  const bool publish = this->bonePosePub &&
+    this->bonePosePub->HasConnections();
+
   msgs::PoseAnimation msg;
-  msg.set_model_name(this->visualName);
-  msg.set_model_id(this->visualId);
+  if (publish)
+  {
+    msg.set_model_name(this->visualName);
+    msg.set_model_id(this->visualId);
+  }
 
-  ignition::math::Matrix4d modelTrans(ignition::math::Matrix4d::Identity);
   ignition::math::Pose3d mainLinkPose;
 
   if (this->customTrajectoryInfo)
@@ -877,33 +1025,31 @@ void Actor::SetPose(std::map<std::string, ignition::math::Matrix4d> _frame,
     mainLinkPose.Rot() = this->worldPose.Rot();
   }
 
-  for (unsigned int i = 0; i < this->skeleton->GetNumNodes(); ++i)
+  const ActorTrack *track = this->dataPtr->lastTrack;
+  const auto &frame = this->dataPtr->lastFrame;
+
+  for (unsigned int i = 0; i < nodeCount; ++i)
   {
+    const ActorBone &actorBone = bones[i];
     SkeletonNode *bone = this->skeleton->GetNodeByHandle(i);
-    SkeletonNode *parentBone = bone->GetParent();
     ignition::math::Matrix4d transform(ignition::math::Matrix4d::Identity);
 
-    if (_frame.find(_skelMap[bone->GetName()]) != _frame.end())
+    if (track && i < frame.size() &&
+        (track->baked->HasNode(i) || actorBone.root))
     {
+      transform = frame[i];
       if (this->dataPtr->bvhFile)
       {
-        std::string tempStr(_skelMap[bone->GetName()]);
-        transform = _frame[tempStr];
-
-        if (bone->GetName() != this->skeleton->GetRootNode()->GetName())
+        if (!actorBone.root)
         {
           ignition::math::Vector3d bvhOffset = transform.Translation();
-          ignition::math::Vector3d daeOffset = bone->Transform().Translation();
           // scale bvh offset to dae link length
-          transform.SetTranslation(daeOffset.Length() * bvhOffset.Normalize());
+          transform.SetTranslation(
+              actorBone.offsetLength * bvhOffset.Normalize());
         }
 
-        transform = this->dataPtr->translationAligner[tempStr] * transform *
-            this->dataPtr->rotationAligner[tempStr];
-      }
-      else
-      {
-        transform = _frame[_skelMap[bone->GetName()]];
+        transform = track->translationAligner[i] * transform *
+            track->rotationAligner[i];
       }
     }
     else
@@ -911,7 +1057,6 @@ void Actor::SetPose(std::map<std::string, ignition::math::Matrix4d> _frame,
       transform = bone->Transform();
     }
 
-    LinkPtr currentLink = this->GetChildLink(bone->GetName());
     ignition::math::Pose3d bonePose = transform.Pose();
     if (!bonePose.IsFinite())
     {
@@ -920,59 +1065,93 @@ void Actor::SetPose(std::map<std::string, ignition::math::Matrix4d> _frame,
       bonePose.Correct();
     }
 
-    msgs::Pose *bone_pose = msg.add_pose();
-    bone_pose->set_name(bone->GetName());
+    msgs::Pose *bone_pose = nullptr;
+    if (publish)
+    {
+      bone_pose = msg.add_pose();
+      bone_pose->set_name(bone->GetName());
+    }
 
-    if (!parentBone)
+    if (actorBone.root)
     {
-      bone_pose->mutable_position()->CopyFrom(
-          msgs::Convert(ignition::math::Vector3d()));
-      bone_pose->mutable_orientation()->CopyFrom(msgs::Convert(
-          ignition::math::Quaterniond()));
+      if (publish)
+      {
+        bone_pose->mutable_position()->CopyFrom(
+            msgs::Convert(ignition::math::Vector3d()));
+        bone_pose->mutable_orientation()->CopyFrom(msgs::Convert(
+            ignition::math::Quaterniond()));
+      }
       if (!this->customTrajectoryInfo)
         mainLinkPose = bonePose;
     }
     else
     {
-      bone_pose->mutable_position()->CopyFrom(msgs::Convert(bonePose.Pos()));
-      bone_pose->mutable_orientation()->CopyFrom(msgs::Convert(bonePose.Rot()));
-      LinkPtr parentLink = this->GetChildLink(parentBone->GetName());
-      auto parentPose = parentLink->WorldPose();
-      ignition::math::Matrix4d parentTrans(parentPose);
-      transform = parentTrans * transform;
-    }
+      if (publish)
+      {
+        bone_pose->mutable_position()->CopyFrom(
+            msgs::Convert(bonePose.Pos()));
+        bone_pose->mutable_orientation()->CopyFrom(
+            msgs::Convert(bonePose.Rot()));
+      }
 
-    msgs::Pose *link_pose = msg.add_pose();
-    link_pose->set_name(currentLink->GetScopedName());
-    link_pose->set_id(currentLink->GetId());
-    ignition::math::Pose3d linkPose = transform.Pose() - mainLinkPose;
-    link_pose->mutable_position()->CopyFrom(msgs::Convert(linkPose.Pos()));
-    link_pose->mutable_orientation()->CopyFrom(msgs::Convert(linkPose.Rot()));
-    currentLink->SetWorldPose(transform.Pose(), true, false);
-  }
+      // Parents come before their children, so their world transform is
+      // usually known already
+      const int parent = actorBone.parent;
+      if (this->dataPtr->boneDone[parent])
+      {
+        transform = this->dataPtr->boneWorld[parent] * transform;
+      }
+      else
+      {
+        ignition::math::Matrix4d parentTrans(
+            actorBone.parentLink->WorldPose());
+        transform = parentTrans * transform;
+      }
+    }
 
-  msgs::Time *stamp = msg.add_time();
-  stamp->CopyFrom(msgs::Convert(_time));
+    this->dataPtr->boneWorld[i] = transform;
+    this->dataPtr->boneDone[i] = true;
 
-  msgs::Pose *model_pose = msg.add_pose();
-  model_pose->set_name(this->GetScopedName());
-  model_pose->set_id(this->GetId());
-  if (!this->customTrajectoryInfo)
-  {
-    model_pose->mutable_position()->CopyFrom(msgs::Convert(mainLinkPose.Pos()));
-    model_pose->mutable_orientation()->CopyFrom(
-        msgs::Convert(mainLinkPose.Rot()));
+    const ignition::math::Pose3d worldPose = transform.Pose();
+    if (publish)
+    {
+      msgs::Pose *link_pose = msg.add_pose();
+      link_pose->set_name(actorBone.link->GetScopedName());
+      link_pose->set_id(actorBone.link->GetId());
+      ignition::math::Pose3d linkPose = worldPose - mainLinkPose;
+      link_pose->mutable_position()->CopyFrom(msgs::Convert(linkPose.Pos()));
+      link_pose->mutable_orientation()->CopyFrom(
+          msgs::Convert(linkPose.Rot()));
+    }
+    actorBone.link->SetWorldPose(worldPose, true, false);
   }
-  else
+
+  if (publish)
   {
-    model_pose->mutable_position()->CopyFrom(
-        msgs::Convert(this->worldPose.Pos()));
-    model_pose->mutable_orientation()->CopyFrom(
-        msgs::Convert(this->worldPose.Rot()));
-  }
+    msgs::Time *stamp = msg.add_time();
+    stamp->CopyFrom(msgs::Convert(_time));
+
+    msgs::Pose *model_pose = msg.add_pose();
+    model_pose->set_name(this->GetScopedName());
+    model_pose->set_id(this->GetId());
+    if (!this->customTrajectoryInfo)
+    {
+      model_pose->mutable_position()->CopyFrom(
+          msgs::Convert(mainLinkPose.Pos()));
+      model_pose->mutable_orientation()->CopyFrom(
+          msgs::Convert(mainLinkPose.Rot()));
+    }
+    else
+    {
+      model_pose->mutable_position()->CopyFrom(
+          msgs::Convert(this->worldPose.Pos()));
+      model_pose->mutable_orientation()->CopyFrom(
+          msgs::Convert(this->worldPose.Rot()));
+    }
 
-  if (this->bonePosePub && this->bonePosePub->HasConnections())
     this->bonePosePub->Publish(msg);
+  }
+
   if (!this->customTrajectoryInfo)
     this->SetWorldPose(mainLinkPose, true, false);
 }
@@ -277,15 +277,16 @@ namespace gazebo
       /// \param[in] _sdf SDF element containing the trajectory script.
       private: void LoadScript(sdf::ElementPtr _sdf);
 
+      /// \brief Bake an animation for the skin, or share the animation baked
+      /// by another actor with the same skin.
+      /// \param[in] _name Name of the animation.
+      private: void BakeAnimation(const std::string &_name);
+
       /// \brief Set the actor's pose. This sets the pose for each bone in the
-      /// skeleton and also the actor's pose in the world.
-      /// \param[in] _frame Each frame name and transform.
-      /// \param[in] _skelMap Map of bone relationships.
+      /// skeleton from the last animated frame, and also the actor's pose in
+      /// the world.
       /// \param[in] _time Time over which to animate the set pose.
-      private: void SetPose(
-                   std::map<std::string, ignition::math::Matrix4d> _frame,
-                   std::map<std::string, std::string> _skelMap,
-                   const double _time);
+      private: void SetPose(const double _time);
 
       /// \brief Pointer to the actor's mesh.
       protected: const common::Mesh *mesh = nullptr;
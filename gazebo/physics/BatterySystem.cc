@@ -0,0 +1,314 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <ignition/common/Profiler.hh>
+
+#include "gazebo/common/Assert.hh"
+#include "gazebo/common/Battery.hh"
+#include "gazebo/common/Console.hh"
+#include "gazebo/common/Time.hh"
+#include "gazebo/msgs/msgs.hh"
+#include "gazebo/transport/Node.hh"
+#include "gazebo/transport/Publisher.hh"
+
+#include "gazebo/physics/BatterySystem.hh"
+#include "gazebo/physics/PhysicsEngine.hh"
+#include "gazebo/physics/World.hh"
+
+using namespace gazebo;
+using namespace physics;
+
+/// \internal
+/// \brief Private data for the BatterySystem class. The states of the
+/// batteries are kept as a structure of arrays, all of the same size.
+class gazebo::physics::BatterySystemPrivate
+{
+  /// \brief Constructor.
+  /// \param[in] _world Reference to the world.
+  public: explicit BatterySystemPrivate(World &_world)
+          : world(_world)
+          {
+          }
+
+  /// \brief Reference to the world.
+  public: World &world;
+
+  /// \brief Index in the arrays of each battery identifier.
+  public: std::unordered_map<uint32_t, size_t> indices;
+
+  /// \brief Identifier of each battery.
+  public: std::vector<uint32_t> ids;
+
+  /// \brief The batteries.
+  public: std::vector<common::BatteryPtr> batteries;
+
+  /// \brief Scoped name of each battery.
+  public: std::vector<std::string> names;
+
+  /// \brief Parameters of each battery.
+  public: std::vector<BatterySystem::LinearBattery> params;
+
+  /// \brief Charge of each battery in Ah.
+  public: std::vector<double> charges;
+
+  /// \brief Smoothed current of each battery in A.
+  public: std::vector<double> currents;
+
+  /// \brief Total power load of each battery in W, gathered by Update.
+  public: std::vector<double> powerLoads;
+
+  /// \brief Voltage of each battery in V, gathered and computed by Update.
+  public: std::vector<double> voltages;
+
+  /// \brief Identifier of the next battery.
+  public: uint32_t nextId = 0;
+
+  /// \brief Mutex to protect the arrays.
+  public: mutable std::mutex mutex;
+
+  /// \brief Updates per second of sim time, zero to update on every
+  /// step.
+  public: double updateRate = 0.0;
+
+  /// \brief Sim time of the last update.
+  public: common::Time lastUpdateTime;
+
+  /// \brief True if the batteries have not been updated yet.
+  public: bool firstUpdate = true;
+
+  /// \brief Message of the published states, kept to reuse its storage.
+  public: msgs::BatteryStates statesMsg;
+
+  // Transport is declared last.
+  /// \brief Node for communication.
+  public: transport::NodePtr node;
+
+  /// \brief Publisher of the battery states.
+  public: transport::PublisherPtr statesPub;
+};
+
+//////////////////////////////////////////////////
+BatterySystem::BatterySystem(World &_world)
+  : dataPtr(new BatterySystemPrivate(_world))
+{
+  this->dataPtr->node = transport::NodePtr(new transport::Node());
+  this->dataPtr->node->Init(this->dataPtr->world.Name());
+  this->dataPtr->statesPub =
+    this->dataPtr->node->Advertise<msgs::BatteryStates>("~/battery/states");
+}
+
+//////////////////////////////////////////////////
+BatterySystem::~BatterySystem()
+{
+  this->dataPtr->statesPub.reset();
+  // Must call fini on node to remove it from topic manager.
+  this->dataPtr->node->Fini();
+}
+
+//////////////////////////////////////////////////
+uint32_t BatterySystem::AddLinearBattery(const common::BatteryPtr &_battery,
+    const std::string &_name, const LinearBattery &_params)
+{
+  GZ_ASSERT(_battery, "Battery is null");
+
+  // The voltage is now only set by Update
+  _battery->SetUpdateFunc(nullptr);
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  const uint32_t id = this->dataPtr->nextId++;
+  this->dataPtr->indices[id] = this->dataPtr->ids.size();
+  this->dataPtr->ids.push_back(id);
+  this->dataPtr->batteries.push_back(_battery);
+  this->dataPtr->names.push_back(_name);
+  this->dataPtr->params.push_back(_params);
+  this->dataPtr->charges.push_back(_params.q0);
+  this->dataPtr->currents.push_back(0.0);
+  this->dataPtr->powerLoads.push_back(0.0);
+  this->dataPtr->voltages.push_back(0.0);
+  return id;
+}
+
+//////////////////////////////////////////////////
+bool BatterySystem::RemoveLinearBattery(const uint32_t _id)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  auto iter = this->dataPtr->indices.find(_id);
+  if (iter == this->dataPtr->indices.end())
+  {
+    gzerr << "Invalid linear battery id[" << _id << "]\n";
+    return false;
+  }
+
+  // Move the last battery into the place of the removed one
+  const size_t index = iter->second;
+  const size_t last = this->dataPtr->ids.size() - 1;
+  this->dataPtr->indices.erase(iter);
+  if (index != last)
+  {
+    this->dataPtr->ids[index] = this->dataPtr->ids[last];
+    this->dataPtr->batteries[index] = this->dataPtr->batteries[last];
+    this->dataPtr->names[index] = this->dataPtr->names[last];
+    this->dataPtr->params[index] = this->dataPtr->params[last];
+    this->dataPtr->charges[index] = this->dataPtr->charges[last];
+    this->dataPtr->currents[index] = this->dataPtr->currents[last];
+    this->dataPtr->indices[this->dataPtr->ids[index]] = index;
+  }
+  this->dataPtr->ids.pop_back();
+  this->dataPtr->batteries.pop_back();
+  this->dataPtr->names.pop_back();
+  this->dataPtr->params.pop_back();
+  this->dataPtr->charges.pop_back();
+  this->dataPtr->currents.pop_back();
+  this->dataPtr->powerLoads.pop_back();
+  this->dataPtr->voltages.pop_back();
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool BatterySystem::ResetLinearBattery(const uint32_t _id)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  auto iter = this->dataPtr->indices.find(_id);
+  if (iter == this->dataPtr->indices.end())
+  {
+    gzerr << "Invalid linear battery id[" << _id << "]\n";
+    return false;
+  }
+
+  this->dataPtr->charges[iter->second] =
+    this->dataPtr->params[iter->second].q0;
+  this->dataPtr->currents[iter->second] = 0.0;
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool BatterySystem::Charge(const uint32_t _id, double &_charge) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  auto iter = this->dataPtr->indices.find(_id);
+  if (iter == this->dataPtr->indices.end())
+  {
+    gzerr << "Invalid linear battery id[" << _id << "]\n";
+    return false;
+  }
+
+  _charge = this->dataPtr->charges[iter->second];
+  return true;
+}
+
+//////////////////////////////////////////////////
+size_t BatterySystem::LinearBatteryCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->ids.size();
+}
+
+//////////////////////////////////////////////////
+void BatterySystem::SetUpdateRate(const double _rate)
+{
+  this->dataPtr->updateRate = std::max(0.0, _rate);
+}
+
+//////////////////////////////////////////////////
+double BatterySystem::UpdateRate() const
+{
+  return this->dataPtr->updateRate;
+}
+
+//////////////////////////////////////////////////
+void BatterySystem::Update(const common::UpdateInfo &_info)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  const size_t count = this->dataPtr->ids.size();
+  if (count == 0)
+    return;
+
+  // Keep the voltages between updates at a lower rate
+  double dt = (_info.simTime - this->dataPtr->lastUpdateTime).Double();
+  if (this->dataPtr->updateRate > 0 && !this->dataPtr->firstUpdate &&
+      dt >= 0 && dt < 1.0 / this->dataPtr->updateRate)
+  {
+    return;
+  }
+
+  // Integrate over one step on the first update, and after the sim time
+  // was reset
+  if (this->dataPtr->firstUpdate || dt <= 0)
+    dt = this->dataPtr->world.Physics()->GetMaxStepSize();
+  this->dataPtr->lastUpdateTime = _info.simTime;
+  this->dataPtr->firstUpdate = false;
+
+  IGN_PROFILE("BatterySystem::Update");
+
+  // Gather the loads, the only pass that reads the batteries
+  double *powerLoads = this->dataPtr->powerLoads.data();
+  double *voltages = this->dataPtr->voltages.data();
+  for (size_t i = 0; i < count; ++i)
+  {
+    powerLoads[i] = this->dataPtr->batteries[i]->TotalPowerLoad();
+    voltages[i] = this->dataPtr->batteries[i]->Voltage();
+  }
+
+  // Linear model of LinearBatteryPlugin. The current filter is integrated
+  // exactly, so that it stays stable when the update period is long.
+  const BatterySystem::LinearBattery *params = this->dataPtr->params.data();
+  double *charges = this->dataPtr->charges.data();
+  double *currents = this->dataPtr->currents.data();
+  for (size_t i = 0; i < count; ++i)
+  {
+    // A depleted battery stays depleted
+    if (std::fabs(voltages[i]) < 1e-3)
+    {
+      voltages[i] = 0.0;
+      continue;
+    }
+
+    const double current = powerLoads[i] / voltages[i];
+    const double k = params[i].tau > 0 ?
+      1.0 - std::exp(-dt / params[i].tau) : 1.0;
+    currents[i] += k * (current - currents[i]);
+    charges[i] -= GZ_SEC_TO_HOUR(dt * currents[i]);
+
+    const double charged = params[i].c > 0 ? charges[i] / params[i].c : 0.0;
+    voltages[i] = params[i].e0 + params[i].e1 * (1.0 - charged) -
+      params[i].r * currents[i];
+  }
+
+  for (size_t i = 0; i < count; ++i)
+    this->dataPtr->batteries[i]->SetVoltage(voltages[i]);
+
+  if (!this->dataPtr->statesPub->HasConnections())
+    return;
+
+  msgs::BatteryStates &msg = this->dataPtr->statesMsg;
+  msg.Clear();
+  msgs::Set(msg.mutable_stamp(), _info.simTime);
+  for (size_t i = 0; i < count; ++i)
+  {
+    msg.add_name(this->dataPtr->names[i]);
+    msg.add_voltage(std::max(0.0, voltages[i]));
+    msg.add_current(currents[i]);
+    msg.add_state_of_charge(params[i].c > 0 ?
+        std::max(0.0, std::min(1.0, charges[i] / params[i].c)) : 0.0);
+  }
+  this->dataPtr->statesPub->Publish(msg);
+}
@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_BATTERYSYSTEM_HH_
+#define GAZEBO_PHYSICS_BATTERYSYSTEM_HH_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "gazebo/common/CommonTypes.hh"
+#include "gazebo/common/UpdateInfo.hh"
+#include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    // Forward declare private data class.
+    class BatterySystemPrivate;
+
+    /// \addtogroup gazebo_physics
+    /// \{
+
+    /// \class BatterySystem BatterySystem.hh physics/physics.hh
+    /// \brief Updates the voltage of many linear batteries in one pass.
+    ///
+    /// The linear battery model is the model of LinearBatteryPlugin: the
+    /// open circuit voltage falls linearly with the charge, and the current
+    /// drawn by the consumers is low-pass filtered. The states of the
+    /// batteries are kept in dense arrays, which are updated at once by
+    /// Update, instead of calling a function per battery on every step.
+    /// The voltages are written back to the common::Battery objects, whose
+    /// own update function is removed, and the states are published in
+    /// one msgs::BatteryStates message on ~/battery/states.
+    class GZ_PHYSICS_VISIBLE BatterySystem
+    {
+      /// \brief Parameters of a linear battery.
+      public: class LinearBattery
+      {
+        /// \brief Constant coefficient of the open circuit voltage in
+        /// volts.
+        public: double e0 = 0.0;
+
+        /// \brief Linear coefficient of the open circuit voltage in volts,
+        /// E = e0 + e1 * (1 - q / c).
+        public: double e1 = 0.0;
+
+        /// \brief Initial charge in Ah.
+        public: double q0 = 0.0;
+
+        /// \brief Capacity in Ah.
+        public: double c = 0.0;
+
+        /// \brief Inner resistance in ohms.
+        public: double r = 0.0;
+
+        /// \brief Characteristic time of the current filter in seconds.
+        public: double tau = 0.0;
+      };
+
+      /// \brief Constructor.
+      /// \param[in] _world Reference to the world.
+      public: explicit BatterySystem(World &_world);
+
+      /// \brief Destructor.
+      public: virtual ~BatterySystem();
+
+      /// \brief Add a battery updated with the linear model. The update
+      /// function of the battery is removed.
+      /// \param[in] _battery The battery.
+      /// \param[in] _name Scoped name of the battery in the published
+      /// states.
+      /// \param[in] _params Parameters of the model.
+      /// \return Identifier of the battery in the system.
+      public: uint32_t AddLinearBattery(const common::BatteryPtr &_battery,
+                  const std::string &_name, const LinearBattery &_params);
+
+      /// \brief Remove a battery added by AddLinearBattery.
+      /// \param[in] _id Identifier of the battery.
+      /// \return False if the identifier wasn't found.
+      public: bool RemoveLinearBattery(const uint32_t _id);
+
+      /// \brief Give a battery its initial charge back, and clear its
+      /// current.
+      /// \param[in] _id Identifier of the battery.
+      /// \return False if the identifier wasn't found.
+      public: bool ResetLinearBattery(const uint32_t _id);
+
+      /// \brief Get the charge of a battery.
+      /// \param[in] _id Identifier of the battery.
+      /// \param[out] _charge Charge in Ah.
+      /// \return False if the identifier wasn't found.
+      public: bool Charge(const uint32_t _id, double &_charge) const;
+
+      /// \brief Get the number of batteries.
+      /// \return Number of batteries added and not removed.
+      public: size_t LinearBatteryCount() const;
+
+      /// \brief Set the rate at which the batteries are updated. The
+      /// charge drawn between updates is integrated over the elapsed sim
+      /// time.
+      /// \param[in] _rate Updates per second of sim time, zero or negative
+      /// to update on every step.
+      public: void SetUpdateRate(const double _rate);
+
+      /// \brief Get the rate at which the batteries are updated.
+      /// \return Updates per second of sim time, zero if updated on every
+      /// step.
+      public: double UpdateRate() const;
+
+      /// \brief Update the batteries, if due. The world calls it once per
+      /// step.
+      /// \param[in] _info Update information of the step.
+      public: void Update(const common::UpdateInfo &_info);
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<BatterySystemPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
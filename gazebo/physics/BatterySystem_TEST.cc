@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+
+#include "gazebo/common/Battery.hh"
+#include "gazebo/physics/BatterySystem.hh"
+#include "gazebo/physics/PhysicsEngine.hh"
+#include "gazebo/physics/World.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+
+class BatterySystemTest : public ServerFixture
+{
+};
+
+/////////////////////////////////////////////////
+TEST_F(BatterySystemTest, LinearBatteries)
+{
+  this->Load("worlds/empty.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+  const double dt = world->Physics()->GetMaxStepSize();
+
+  physics::BatterySystem &system = world->Batteries();
+  EXPECT_EQ(0u, system.LinearBatteryCount());
+  EXPECT_DOUBLE_EQ(0.0, system.UpdateRate());
+
+  // A battery with a constant voltage, so that the charge drawn is known
+  common::BatteryPtr battery(new common::Battery());
+  battery->SetVoltage(12.0);
+  const uint32_t consumer = battery->AddConsumer();
+  EXPECT_TRUE(battery->SetPowerLoad(consumer, 6.0));
+
+  physics::BatterySystem::LinearBattery params;
+  params.e0 = 12.0;
+  params.q0 = 1.0;
+  params.c = 1.0;
+  const uint32_t id = system.AddLinearBattery(battery, "battery", params);
+  EXPECT_EQ(1u, system.LinearBatteryCount());
+
+  // The battery isn't updated by its own function anymore
+  battery->Update();
+  EXPECT_DOUBLE_EQ(12.0, battery->Voltage());
+
+  // Half an ampere is drawn on every step
+  const int steps = 100;
+  world->Step(steps);
+  double charge = 0;
+  EXPECT_TRUE(system.Charge(id, charge));
+  EXPECT_NEAR(1.0 - steps * dt * 0.5 / 3600.0, charge, 1e-12);
+  EXPECT_DOUBLE_EQ(12.0, battery->Voltage());
+
+  // The voltage falls with the charge and the current
+  EXPECT_TRUE(system.RemoveLinearBattery(id));
+  EXPECT_FALSE(system.RemoveLinearBattery(id));
+  battery->SetVoltage(12.0);
+  params.e1 = 1.0;
+  params.r = 0.1;
+  params.tau = 0.01;
+  const uint32_t id2 = system.AddLinearBattery(battery, "battery", params);
+  EXPECT_NE(id, id2);
+  world->Step(steps);
+  EXPECT_LT(battery->Voltage(), 12.0);
+  EXPECT_GT(battery->Voltage(), 11.0);
+
+  // At a lower rate the voltage is kept between updates
+  system.SetUpdateRate(10);
+  EXPECT_DOUBLE_EQ(10.0, system.UpdateRate());
+  world->Step(1);
+  EXPECT_TRUE(system.Charge(id2, charge));
+  const double voltage = battery->Voltage();
+  world->Step(static_cast<unsigned int>(0.05 / dt));
+  double charge2 = 0;
+  EXPECT_TRUE(system.Charge(id2, charge2));
+  EXPECT_DOUBLE_EQ(charge, charge2);
+  EXPECT_DOUBLE_EQ(voltage, battery->Voltage());
+
+  // The charge of the whole period is drawn by the next update
+  world->Step(static_cast<unsigned int>(0.06 / dt));
+  EXPECT_TRUE(system.Charge(id2, charge2));
+  EXPECT_LT(charge2, charge);
+
+  // Reset gives the charge back
+  EXPECT_TRUE(system.ResetLinearBattery(id2));
+  EXPECT_TRUE(system.Charge(id2, charge));
+  EXPECT_DOUBLE_EQ(1.0, charge);
+
+  EXPECT_TRUE(system.RemoveLinearBattery(id2));
+  EXPECT_EQ(0u, system.LinearBatteryCount());
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -338,9 +338,16 @@ void Collision::ProcessMsg(const msgs::Collision &_msg)
   {
     this->link->SetEnabled(true);
     this->surface->ProcessMsg(_msg.surface());
+    if (_msg.surface().has_collide_bitmask())
+      this->OnCollideBitmaskChange();
   }
 }
 
+//////////////////////////////////////////////////
+void Collision::OnCollideBitmaskChange()
+{
+}
+
 /////////////////////////////////////////////////
 msgs::Visual Collision::CreateCollisionVisual()
 {
@@ -205,6 +205,11 @@ namespace gazebo
       public: virtual std::optional<sdf::SemanticPose> SDFSemanticPose()
                   const override;
 
+      /// \brief Called by ProcessMsg after the collide bitmask of the
+      /// surface changed, so that an engine filtering pairs with it in the
+      /// broadphase can update. Does nothing by default.
+      protected: virtual void OnCollideBitmaskChange();
+
       /// \brief Helper function used to create a collision visual message.
       /// \return Visual message for a collision.
       private: msgs::Visual CreateCollisionVisual();
@@ -19,6 +19,8 @@
  * Date: 10 Nov 2009
  */
 
+#include <algorithm>
+
 #include "gazebo/physics/physics.hh"
 #include "gazebo/physics/Collision.hh"
 #include "gazebo/physics/Contact.hh"
@@ -29,12 +31,13 @@ using namespace physics;
 
 //////////////////////////////////////////////////
 Contact::Contact()
+  : collision1(nullptr), collision2(nullptr), count(0)
 {
-  this->count = 0;
 }
 
 //////////////////////////////////////////////////
 Contact::Contact(const Contact &_c)
+  : collision1(nullptr), collision2(nullptr), count(0)
 {
   *this = _c;
 }
@@ -52,13 +55,15 @@ Contact &Contact::operator =(const Contact &_contact)
   this->collision2 = _contact.collision2;
 
   this->count = _contact.count;
-  for (int i = 0; i < MAX_CONTACT_JOINTS; i++)
-  {
-    this->wrench[i] = _contact.wrench[i];
-    this->positions[i] = _contact.positions[i];
-    this->normals[i] = _contact.normals[i];
-    this->depths[i] = _contact.depths[i];
-  }
+  this->SetCapacity(this->count);
+  std::copy(_contact.wrench.begin(), _contact.wrench.begin() + this->count,
+      this->wrench.begin());
+  std::copy(_contact.positions.begin(),
+      _contact.positions.begin() + this->count, this->positions.begin());
+  std::copy(_contact.normals.begin(),
+      _contact.normals.begin() + this->count, this->normals.begin());
+  std::copy(_contact.depths.begin(), _contact.depths.begin() + this->count,
+      this->depths.begin());
 
   this->time = _contact.time;
 
@@ -85,6 +90,7 @@ Contact &Contact::operator =(const msgs::Contact &_contact)
            << "contact collision pointers will be NULL";
   }
 
+  this->SetCapacity(_contact.position_size());
   for (int j = 0; j < _contact.position_size(); ++j)
   {
     this->positions[j] = msgs::ConvertIgn(_contact.position(j));
@@ -119,6 +125,24 @@ void Contact::Reset()
   this->count = 0;
 }
 
+//////////////////////////////////////////////////
+void Contact::SetCapacity(const unsigned int _count)
+{
+  if (_count <= this->depths.size())
+    return;
+
+  this->wrench.resize(_count);
+  this->positions.resize(_count);
+  this->normals.resize(_count);
+  this->depths.resize(_count, 0.0);
+}
+
+//////////////////////////////////////////////////
+unsigned int Contact::Capacity() const
+{
+  return static_cast<unsigned int>(this->depths.size());
+}
+
 //////////////////////////////////////////////////
 std::string Contact::DebugString() const
 {
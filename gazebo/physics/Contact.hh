@@ -27,10 +27,10 @@
 #include "gazebo/physics/PhysicsTypes.hh"
 #include "gazebo/util/system.hh"
 
-// For the sake of efficiency, use fixed size arrays for collision
 // MAX_COLLIDE_RETURNS limits contact detection, needs to be large
 //                      for proper contact dynamics.
-// MAX_CONTACT_JOINTS truncates <max_contacts> specified in SDF
+// MAX_CONTACT_JOINTS truncates <max_contacts> specified in SDF, and bounds
+//                    the number of points of a Contact.
 #define MAX_COLLIDE_RETURNS 250
 #define MAX_CONTACT_JOINTS 250
 
@@ -78,6 +78,16 @@ namespace gazebo
       /// \brief Reset to default values.
       public: void Reset();
 
+      /// \brief Make room for a number of contact points. The arrays hold
+      /// at least that many elements afterwards. They never shrink, so a
+      /// contact that is reused every step stops allocating.
+      /// \param[in] _count Number of contact points.
+      public: void SetCapacity(const unsigned int _count);
+
+      /// \brief Get the number of contact points the arrays can hold.
+      /// \return Size of the arrays.
+      public: unsigned int Capacity() const;
+
       /// \brief Pointer to the first collision object
       public: Collision *collision1;
 
@@ -88,18 +98,20 @@ namespace gazebo
       /// All forces and torques are in the world frame.
       /// All forces and torques are relative to the center of mass of the
       /// respective links that the collision elments are attached to.
-      public: JointWrench wrench[MAX_CONTACT_JOINTS];
+      /// \sa SetCapacity
+      public: std::vector<JointWrench> wrench;
 
       /// \brief Array of force positions.
-      public: ignition::math::Vector3d positions[MAX_CONTACT_JOINTS];
+      public: std::vector<ignition::math::Vector3d> positions;
 
       /// \brief Array of force normals.
-      public: ignition::math::Vector3d normals[MAX_CONTACT_JOINTS];
+      public: std::vector<ignition::math::Vector3d> normals;
 
       /// \brief Array of contact depths
-      public: double depths[MAX_CONTACT_JOINTS];
+      public: std::vector<double> depths;
 
-      /// \brief Length of all the arrays.
+      /// \brief Number of contact points in the arrays, which may be less
+      /// than the size of the arrays.
       public: int count;
 
       /// \brief Time at which the contact occurred.
@@ -14,6 +14,8 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
+
 #include <boost/algorithm/string.hpp>
 
 #include "gazebo/transport/Node.hh"
@@ -36,6 +38,9 @@ ContactManager::ContactManager()
   this->contactIndex = 0;
   this->customMutex = new boost::recursive_mutex();
   this->neverDropContacts = false;
+  this->publishDecimation = 1;
+  this->publishCount = 0;
+  this->unresolvedFilters = false;
 }
 
 /////////////////////////////////////////////////
@@ -62,6 +67,7 @@ ContactManager::~ContactManager()
     }
   }
   this->customContactPublishers.clear();
+  this->collisionPublishers.clear();
   delete this->customMutex;
   this->customMutex = NULL;
 
@@ -92,6 +98,25 @@ bool ContactManager::NeverDropContacts() const
   return this->neverDropContacts;
 }
 
+/////////////////////////////////////////////////
+void ContactManager::SetPublishDecimation(const unsigned int _decimation)
+{
+  this->publishDecimation = std::max(_decimation, 1u);
+}
+
+/////////////////////////////////////////////////
+unsigned int ContactManager::PublishDecimation() const
+{
+  return this->publishDecimation;
+}
+
+/////////////////////////////////////////////////
+bool ContactManager::DefaultTopicDue() const
+{
+  return this->contactPub && this->contactPub->HasConnections() &&
+    this->publishCount % this->publishDecimation == 0;
+}
+
 /////////////////////////////////////////////////
 bool ContactManager::SubscribersConnected(Collision *_collision1,
                                           Collision *_collision2) const
@@ -99,13 +124,14 @@ bool ContactManager::SubscribersConnected(Collision *_collision1,
   if (this->contactPub->HasConnections()) return true;
 
   boost::recursive_mutex::scoped_lock lock(*this->customMutex);
-  boost::unordered_map<std::string, ContactPublisher *>::const_iterator iter;
-  for (iter = this->customContactPublishers.begin();
-       iter != this->customContactPublishers.end(); ++iter)
+  if (this->unresolvedFilters)
   {
-    // A model can simply be loaded later, so check the collisionNames as well.
-    if (!iter->second->collisionNames.empty())
+    boost::unordered_map<std::string, ContactPublisher *>::const_iterator iter;
+    for (iter = this->customContactPublishers.begin();
+         iter != this->customContactPublishers.end(); ++iter)
     {
+      // A model can simply be loaded later, so check the collisionNames as
+      // well.
       std::vector<std::string>::const_iterator it;
       for (it = iter->second->collisionNames.begin();
            it != iter->second->collisionNames.end(); ++it)
@@ -117,23 +143,20 @@ bool ContactManager::SubscribersConnected(Collision *_collision1,
         }
         // We could do the same transformation which is done in
         // GetCustomPublishers() here (insert collisions which now have been
-        // loaded), but this would remove the const qualifier of this function.
-        // It would however speed up repeated calls of this function without
-        // a call of NewContact() or GetCustomPublishers() in between.
+        // loaded), but this would remove the const qualifier of this
+        // function. It would however speed up repeated calls of this
+        // function without a call of NewContact() or GetCustomPublishers()
+        // in between.
       }
     }
-
-    // only reason _collision1 or _collision1 cannot be const parameters
-    // is that compiler can't find const pointers in unordered set
-    if (iter->second->collisions.find(_collision1) !=
-        iter->second->collisions.end() ||
-        iter->second->collisions.find(_collision2) !=
-        iter->second->collisions.end())
-    {
-      return true;
-    }
   }
-  return false;
+
+  // only reason _collision1 or _collision1 cannot be const parameters
+  // is that compiler can't find const pointers in unordered map
+  return this->collisionPublishers.find(_collision1) !=
+      this->collisionPublishers.end() ||
+      this->collisionPublishers.find(_collision2) !=
+      this->collisionPublishers.end();
 }
 
 /////////////////////////////////////////////////
@@ -142,47 +165,70 @@ void ContactManager::GetCustomPublishers(Collision *_collision1,
                      std::vector<ContactPublisher*> &_publishers)
 {
   boost::recursive_mutex::scoped_lock lock(*this->customMutex);
-  boost::unordered_map<std::string, ContactPublisher *>::iterator iter;
-  for (iter = this->customContactPublishers.begin();
-       iter != this->customContactPublishers.end(); ++iter)
+
+  // A model can simply be loaded later, so convert ones that are not yet
+  // found
+  if (this->unresolvedFilters)
+    this->ResolveFilterCollisions();
+
+  for (Collision *collision : {_collision1, _collision2})
   {
-    // A model can simply be loaded later, so convert ones that are not yet
-    // found
-    if (!iter->second->collisionNames.empty())
+    auto iter = this->collisionPublishers.find(collision);
+    if (iter == this->collisionPublishers.end())
+      continue;
+
+    for (ContactPublisher *contactPublisher : iter->second)
     {
-      std::vector<std::string>::iterator it;
-      for (it = iter->second->collisionNames.begin();
-          it != iter->second->collisionNames.end();)
+      GZ_ASSERT(contactPublisher->publisher != NULL,
+                "ContactPublisher must have a valid publisher");
+      if ((!_getOnlyConnected || contactPublisher->callback ||
+           contactPublisher->publisher->HasConnections()) &&
+          std::find(_publishers.begin(), _publishers.end(),
+            contactPublisher) == _publishers.end())
       {
-        Collision *col = boost::dynamic_pointer_cast<Collision>(
-            this->world->BaseByName(*it)).get();
-        if (!col)
-        {
-          ++it;
-          continue;
-        }
-        it = iter->second->collisionNames.erase(it);
-        iter->second->collisions.insert(col);
+        _publishers.push_back(contactPublisher);
       }
     }
+  }
+}
 
-    // only reason _collision1 or _collision1 cannot be const parameters
-    // is that compiler can't find const pointers in unordered set
-    if (iter->second->collisions.find(_collision1) !=
-        iter->second->collisions.end() ||
-        iter->second->collisions.find(_collision2) !=
-        iter->second->collisions.end())
+/////////////////////////////////////////////////
+void ContactManager::ResolveFilterCollisions()
+{
+  this->unresolvedFilters = false;
+
+  boost::unordered_map<std::string, ContactPublisher *>::iterator iter;
+  for (iter = this->customContactPublishers.begin();
+       iter != this->customContactPublishers.end(); ++iter)
+  {
+    std::vector<std::string>::iterator it;
+    for (it = iter->second->collisionNames.begin();
+        it != iter->second->collisionNames.end();)
     {
-      GZ_ASSERT(iter->second->publisher != NULL,
-                "ContactPublisher must have a valid publisher");
-      if (!_getOnlyConnected || iter->second->publisher->HasConnections())
+      Collision *col = boost::dynamic_pointer_cast<Collision>(
+          this->world->BaseByName(*it)).get();
+      if (!col)
       {
-        _publishers.push_back(iter->second);
+        ++it;
+        continue;
       }
+      it = iter->second->collisionNames.erase(it);
+      this->AddFilterCollision(iter->second, col);
     }
+
+    if (!iter->second->collisionNames.empty())
+      this->unresolvedFilters = true;
   }
 }
 
+/////////////////////////////////////////////////
+void ContactManager::AddFilterCollision(ContactPublisher *_publisher,
+    Collision *_collision)
+{
+  if (_publisher->collisions.insert(_collision).second)
+    this->collisionPublishers[_collision].push_back(_publisher);
+}
+
 /////////////////////////////////////////////////
 Contact *ContactManager::NewContact(Collision *_collision1,
                                     Collision *_collision2,
@@ -207,7 +253,7 @@ Contact *ContactManager::NewContact(Collision *_collision1,
                             getOnlyConnected, publishers);
 
   if (this->NeverDropContacts() ||
-      this->contactPub->HasConnections() ||
+      this->DefaultTopicDue() ||
       !publishers.empty())
   {
     // Get or create a contact feedback object.
@@ -228,7 +274,11 @@ Contact *ContactManager::NewContact(Collision *_collision1,
   if (!result)
     return result;
 
+  // Make room for as many points as the engines keep by default, the
+  // smallest <max_contacts> of the two collisions.
   result->count = 0;
+  result->SetCapacity(std::min({static_cast<unsigned int>(MAX_CONTACT_JOINTS),
+        _collision1->GetMaxContacts(), _collision2->GetMaxContacts()}));
   result->collision1 = _collision1;
   result->collision2 = _collision2;
   result->time = _time;
@@ -296,21 +346,22 @@ void ContactManager::PublishContacts()
   }
 
   // publish to default topic, ~/physics/contacts
-  if (!transport::getMinimalComms())
+  if (!transport::getMinimalComms() && this->DefaultTopicDue())
   {
-    msgs::Contacts msg;
+    this->contactsMsg.Clear();
     for (unsigned int i = 0; i < this->contactIndex; ++i)
     {
       if (this->contacts[i]->count == 0)
         continue;
 
-      msgs::Contact *contactMsg = msg.add_contact();
+      msgs::Contact *contactMsg = this->contactsMsg.add_contact();
       this->contacts[i]->FillMsg(*contactMsg);
     }
 
-    msgs::Set(msg.mutable_time(), this->world->SimTime());
-    this->contactPub->Publish(msg);
+    msgs::Set(this->contactsMsg.mutable_time(), this->world->SimTime());
+    this->contactPub->Publish(this->contactsMsg);
   }
+  ++this->publishCount;
 
   // publish to other custom topics
   boost::recursive_mutex::scoped_lock lock(*this->customMutex);
@@ -319,18 +370,45 @@ void ContactManager::PublishContacts()
       iter != this->customContactPublishers.end(); ++iter)
   {
     ContactPublisher *contactPublisher = iter->second;
-    msgs::Contacts msg2;
+
+    // Deliver the contacts to the in-process consumer without the topic
+    if (contactPublisher->callback)
+    {
+      boost::shared_ptr<msgs::Contacts> msg(new msgs::Contacts);
+      for (auto const &contact : contactPublisher->contacts)
+      {
+        if (contact->count != 0)
+          contact->FillMsg(*msg->add_contact());
+      }
+      msgs::Set(msg->mutable_time(), this->world->SimTime());
+
+      ConstContactsPtr constMsg(msg);
+      contactPublisher->callback(constMsg);
+
+      if (contactPublisher->publisher->HasConnections())
+        contactPublisher->publisher->Publish(*msg);
+      contactPublisher->contacts.clear();
+      continue;
+    }
+
+    if (!contactPublisher->publisher->HasConnections())
+    {
+      contactPublisher->contacts.clear();
+      continue;
+    }
+
+    this->contactsMsg.Clear();
     for (unsigned int j = 0;
         j < contactPublisher->contacts.size(); ++j)
     {
       if (contactPublisher->contacts[j]->count == 0)
         continue;
 
-      msgs::Contact *contactMsg = msg2.add_contact();
+      msgs::Contact *contactMsg = this->contactsMsg.add_contact();
       contactPublisher->contacts[j]->FillMsg(*contactMsg);
     }
-    msgs::Set(msg2.mutable_time(), this->world->SimTime());
-    contactPublisher->publisher->Publish(msg2);
+    msgs::Set(this->contactsMsg.mutable_time(), this->world->SimTime());
+    contactPublisher->publisher->Publish(this->contactsMsg);
     contactPublisher->contacts.clear();
   }
 }
@@ -364,17 +442,17 @@ std::string ContactManager::CreateFilter(const std::string &_name,
   ContactPublisher *contactPublisher = new ContactPublisher;
   contactPublisher->publisher = this->node->Advertise<msgs::Contacts>(topic);
 
-  std::map<std::string, physics::CollisionPtr>::const_iterator iter;
-  for (iter = _collisions.begin(); iter != _collisions.end(); ++iter)
-  {
-    Collision *col = iter->second.get();
-    if (col)
-      contactPublisher->collisions.insert(col);
-  }
-
   {
     boost::recursive_mutex::scoped_lock lock(*this->customMutex);
     this->customContactPublishers[name] = contactPublisher;
+
+    std::map<std::string, physics::CollisionPtr>::const_iterator iter;
+    for (iter = _collisions.begin(); iter != _collisions.end(); ++iter)
+    {
+      Collision *col = iter->second.get();
+      if (col)
+        this->AddFilterCollision(contactPublisher, col);
+    }
   }
 
   return topic;
@@ -419,6 +497,8 @@ std::string ContactManager::CreateFilter(const std::string &_name,
 
     // Let it know about collisions not yet found.
     this->customContactPublishers[name]->collisionNames = collisionNames;
+    if (!collisionNames.empty())
+      this->unresolvedFilters = true;
   }
 
   return topic;
@@ -436,15 +516,44 @@ void ContactManager::RemoveFilter(const std::string &_name)
   if (iter != customContactPublishers.end())
   {
     ContactPublisher *contactPublisher = iter->second;
+    for (auto const &col : contactPublisher->collisions)
+    {
+      auto publishers = this->collisionPublishers.find(col);
+      if (publishers == this->collisionPublishers.end())
+        continue;
+
+      publishers->second.erase(std::remove(publishers->second.begin(),
+            publishers->second.end(), contactPublisher),
+          publishers->second.end());
+      if (publishers->second.empty())
+        this->collisionPublishers.erase(publishers);
+    }
     contactPublisher->contacts.clear();
     contactPublisher->collisionNames.clear();
     contactPublisher->collisions.clear();
+    contactPublisher->callback = nullptr;
     contactPublisher->publisher->Fini();
     contactPublisher->publisher.reset();
     this->customContactPublishers.erase(iter);
   }
 }
 
+/////////////////////////////////////////////////
+bool ContactManager::SetFilterCallback(const std::string &_name,
+    const std::function<void(ConstContactsPtr &)> &_callback)
+{
+  std::string name = _name;
+  boost::replace_all(name, "::", "/");
+
+  boost::recursive_mutex::scoped_lock lock(*this->customMutex);
+  auto iter = this->customContactPublishers.find(name);
+  if (iter == this->customContactPublishers.end())
+    return false;
+
+  iter->second->callback = _callback;
+  return true;
+}
+
 /////////////////////////////////////////////////
 unsigned int ContactManager::GetFilterCount()
 {
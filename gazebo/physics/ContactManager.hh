@@ -18,6 +18,7 @@
 #ifndef GAZEBO_PHYSICS_CONTACTMANAGER_HH_
 #define GAZEBO_PHYSICS_CONTACTMANAGER_HH_
 
+#include <functional>
 #include <vector>
 #include <string>
 #include <map>
@@ -56,6 +57,11 @@ namespace gazebo
       /// \brief A list of contacts associated to the collisions.
       public: std::vector<Contact *> contacts;
 
+      /// \brief Optional in-process consumer of the filtered contacts,
+      /// e.g. a ContactSensor. It receives the contacts without going
+      /// through the publisher.
+      public: std::function<void(ConstContactsPtr &)> callback;
+
       // Place ignition::transport objects at the end of this file to
       // guarantee they are destructed first.
 
@@ -117,6 +123,20 @@ namespace gazebo
       /// If SetNeverDropContacts() was never called, this will return false.
       public: bool NeverDropContacts() const;
 
+      /// \brief Set the decimation of the default contacts topic,
+      /// ~/physics/contacts. Contacts are published to the topic on one of
+      /// every _decimation calls of PublishContacts. Contacts of the other
+      /// steps are not collected for the topic. Custom filter topics are
+      /// not decimated.
+      /// \param[in] _decimation Decimation, 1 publishes every step. Zero is
+      /// treated as one.
+      public: void SetPublishDecimation(const unsigned int _decimation);
+
+      /// \brief Get the decimation of the default contacts topic.
+      /// \return Decimation of ~/physics/contacts.
+      /// \sa SetPublishDecimation
+      public: unsigned int PublishDecimation() const;
+
       /// \brief Returns true if any subscribers are connected
       /// which would be interested in contact details of either collision
       /// \e _collision1 or \e collision2, given that they have been loaded
@@ -160,6 +180,7 @@ namespace gazebo
       public: void Clear();
 
       /// \brief Publish all contacts in a msgs::Contacts message.
+      /// Messages are only built for topics with subscribers.
       public: void PublishContacts();
 
       /// \brief Set the contact count to zero.
@@ -191,6 +212,16 @@ namespace gazebo
                   const std::map<std::string, physics::CollisionPtr>
                   &_collisions);
 
+      /// \brief Deliver the contacts of a filter directly to a callback in
+      /// the physics thread, instead of only through the filter topic.
+      /// The filter topic is still published when it has subscribers.
+      /// \param[in] _name Filter name.
+      /// \param[in] _callback Callback that receives the contacts of each
+      /// step, or an empty function to stop the delivery.
+      /// \return False if the filter does not exist.
+      public: bool SetFilterCallback(const std::string &_name,
+                  const std::function<void(ConstContactsPtr &)> &_callback);
+
       /// \brief Remove a contacts filter and the associated custom publisher
       /// param[in] _name Filter name.
       public: void RemoveFilter(const std::string &_name);
@@ -215,6 +246,22 @@ namespace gazebo
                        Collision *_collision2, const bool _getOnlyConnected,
                        std::vector<ContactPublisher*> &_publishers);
 
+      /// \brief Convert the collision names of the filters into
+      /// collisions, for collisions that have been loaded since.
+      private: void ResolveFilterCollisions();
+
+      /// \brief Add a collision to a filter and to the per collision index
+      /// of the filters.
+      /// \param[in] _publisher The filter.
+      /// \param[in] _collision Collision to monitor.
+      private: void AddFilterCollision(ContactPublisher *_publisher,
+                   Collision *_collision);
+
+      /// \brief Check if ~/physics/contacts is published on this step.
+      /// \return True if the default topic has subscribers and is not
+      /// decimated on this step.
+      private: bool DefaultTopicDue() const;
+
       private: std::vector<Contact*> contacts;
 
       private: unsigned int contactIndex;
@@ -236,6 +283,25 @@ namespace gazebo
       /// \brief Mutex to protect the list of custom publishers.
       private: boost::recursive_mutex *customMutex;
 
+      /// \brief Custom publishers by monitored collision, so contacts are
+      /// matched to filters with one lookup per collision.
+      private: boost::unordered_map<Collision *,
+               std::vector<ContactPublisher *> > collisionPublishers;
+
+      /// \brief True if any filter has collision names that were not
+      /// converted to collisions yet.
+      private: bool unresolvedFilters;
+
+      /// \brief Message reused for every publication, so its contacts
+      /// keep their allocations between steps.
+      private: msgs::Contacts contactsMsg;
+
+      /// \brief Decimation of the default contacts topic.
+      private: unsigned int publishDecimation;
+
+      /// \brief Number of PublishContacts calls, used for decimation.
+      private: uint64_t publishCount;
+
       // Place ignition::transport objects at the end of this file to
       // guarantee they are destructed first.
 
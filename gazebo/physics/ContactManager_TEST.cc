@@ -15,6 +15,8 @@
  *
 */
 
+#include <atomic>
+
 #include "gazebo/physics/ContactManager.hh"
 #include "gazebo/test/ServerFixture.hh"
 
@@ -24,6 +26,15 @@ class ContactManagerTest : public ServerFixture
 {
 };
 
+/// \brief Number of messages received on ~/physics/contacts.
+static std::atomic<int> g_contactsReceived(0);
+
+/////////////////////////////////////////////////
+void OnContacts(ConstContactsPtr &/*_msg*/)
+{
+  ++g_contactsReceived;
+}
+
 /////////////////////////////////////////////////
 TEST_F(ContactManagerTest, CreateFilter)
 {
@@ -194,6 +205,99 @@ TEST_F(ContactManagerTest, NeverDropContacts)
   }
 }
 
+/////////////////////////////////////////////////
+TEST_F(ContactManagerTest, PublishDecimation)
+{
+  Load("test/worlds/box.world", true);
+
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  physics::PhysicsEnginePtr physics = world->Physics();
+  ASSERT_TRUE(physics != nullptr);
+
+  physics::ContactManager *manager = physics->GetContactManager();
+  ASSERT_TRUE(manager != nullptr);
+  EXPECT_EQ(1u, manager->PublishDecimation());
+
+  EXPECT_TRUE(physics->SetParam("contact_publish_decimation", 4));
+  EXPECT_EQ(4u, manager->PublishDecimation());
+  EXPECT_EQ(4, boost::any_cast<int>(
+      physics->GetParam("contact_publish_decimation")));
+  EXPECT_FALSE(physics->SetParam("contact_publish_decimation", 0));
+  EXPECT_EQ(4u, manager->PublishDecimation());
+
+  transport::NodePtr node(new transport::Node());
+  node->Init();
+  transport::SubscriberPtr sub =
+    node->Subscribe("~/physics/contacts", &OnContacts);
+
+  // contacts are only collected on the steps that are published
+  int stepsWithContacts = 0;
+  for (int i = 0; i < 16; ++i)
+  {
+    world->Step(1);
+    if (manager->GetContactCount() > 0)
+      ++stepsWithContacts;
+  }
+  EXPECT_EQ(4, stepsWithContacts);
+
+  for (int i = 0; i < 50 && g_contactsReceived < 4; ++i)
+    common::Time::MSleep(10);
+  EXPECT_EQ(4, g_contactsReceived);
+}
+
+/////////////////////////////////////////////////
+TEST_F(ContactManagerTest, FilterCallback)
+{
+  Load("test/worlds/box.world", true);
+
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  physics::PhysicsEnginePtr physics = world->Physics();
+  ASSERT_TRUE(physics != nullptr);
+
+  physics::ContactManager *manager = physics->GetContactManager();
+  ASSERT_TRUE(manager != nullptr);
+
+  // the filter callback can only be set for existing filters
+  EXPECT_FALSE(manager->SetFilterCallback("box_filter", nullptr));
+
+  // one collision of the filter is loaded later
+  std::vector<std::string> collisions = {"box::link::collision",
+      "box2::link::collision"};
+  manager->CreateFilter("box_filter", collisions);
+
+  int received = 0;
+  int contacts = 0;
+  EXPECT_TRUE(manager->SetFilterCallback("box_filter",
+      [&](ConstContactsPtr &_msg)
+      {
+        ++received;
+        contacts += _msg->contact_size();
+        for (int i = 0; i < _msg->contact_size(); ++i)
+        {
+          EXPECT_TRUE(
+              _msg->contact(i).collision1() == "box::link::collision" ||
+              _msg->contact(i).collision2() == "box::link::collision");
+        }
+      }));
+
+  // the contacts are delivered directly, on every step, without any
+  // subscriber to the filter topic
+  world->Step(10);
+  EXPECT_EQ(10, received);
+  EXPECT_GT(contacts, 0);
+
+  EXPECT_TRUE(manager->SetFilterCallback("box_filter", nullptr));
+  world->Step(10);
+  EXPECT_EQ(10, received);
+
+  manager->RemoveFilter("box_filter");
+  EXPECT_FALSE(manager->HasFilter("box_filter"));
+}
+
 int main(int argc, char **argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
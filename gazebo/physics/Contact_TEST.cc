@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "gazebo/physics/Contact.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class ContactTest : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+TEST_F(ContactTest, Capacity)
+{
+  physics::Contact contact;
+  EXPECT_EQ(0, contact.count);
+  EXPECT_EQ(0u, contact.Capacity());
+
+  contact.SetCapacity(4);
+  EXPECT_EQ(4u, contact.Capacity());
+  EXPECT_EQ(4u, contact.wrench.size());
+  EXPECT_EQ(4u, contact.positions.size());
+  EXPECT_EQ(4u, contact.normals.size());
+  EXPECT_EQ(4u, contact.depths.size());
+
+  // The arrays never shrink
+  contact.SetCapacity(2);
+  EXPECT_EQ(4u, contact.Capacity());
+
+  // Reset keeps the storage
+  contact.count = 3;
+  contact.Reset();
+  EXPECT_EQ(0, contact.count);
+  EXPECT_EQ(4u, contact.Capacity());
+}
+
+/////////////////////////////////////////////////
+TEST_F(ContactTest, Copy)
+{
+  physics::Contact contact;
+  contact.SetCapacity(10);
+  contact.count = 2;
+  for (int i = 0; i < contact.count; ++i)
+  {
+    contact.positions[i].Set(i, 0, 0);
+    contact.normals[i].Set(0, 0, 1);
+    contact.depths[i] = 0.1 * i;
+    contact.wrench[i].body1Force.Set(0, 0, i);
+  }
+
+  // Only the contact points in use are copied
+  physics::Contact copy(contact);
+  EXPECT_EQ(2, copy.count);
+  EXPECT_EQ(2u, copy.Capacity());
+  for (int i = 0; i < copy.count; ++i)
+  {
+    EXPECT_EQ(contact.positions[i], copy.positions[i]);
+    EXPECT_EQ(contact.normals[i], copy.normals[i]);
+    EXPECT_DOUBLE_EQ(contact.depths[i], copy.depths[i]);
+    EXPECT_EQ(contact.wrench[i].body1Force, copy.wrench[i].body1Force);
+  }
+
+  // Assigning keeps the larger arrays of the destination
+  physics::Contact other;
+  other.SetCapacity(5);
+  other = contact;
+  EXPECT_EQ(2, other.count);
+  EXPECT_EQ(5u, other.Capacity());
+  EXPECT_EQ(contact.positions[1], other.positions[1]);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
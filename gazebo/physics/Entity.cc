@@ -676,6 +676,12 @@ const ignition::math::Pose3d &Entity::DirtyPose() const
   return this->dirtyPose;
 }
 
+//////////////////////////////////////////////////
+void Entity::_ApplyDirtyPose()
+{
+  (*this.*setWorldPoseFunc)(this->dirtyPose, false, true);
+}
+
 //////////////////////////////////////////////////
 ignition::math::AxisAlignedBox Entity::CollisionBoundingBox() const
 {
@@ -227,6 +227,15 @@ namespace gazebo
       /// \return The dirty pose of the entity.
       public: const ignition::math::Pose3d &DirtyPose() const;
 
+      /// \internal
+      /// \brief Propagate the dirty pose set by the physics engine to the
+      /// entity and its parent models, without notifying the physics
+      /// engine. Same as SetWorldPose(DirtyPose(), false), except that the
+      /// caller must hold World::WorldPoseMutex and must publish the pose
+      /// of the parent model once the mutex is released. This lets the
+      /// world apply all the dirty poses of a step under one lock.
+      public: void _ApplyDirtyPose();
+
       /// \brief This function is called when the entity's
       /// (or one of its parents) pose of the parent has changed.
       protected: virtual void OnPoseChange() = 0;
@@ -17,17 +17,16 @@
 #include <functional>
 #include <map>
 #include <mutex>
+#include <string>
 #include <vector>
 
+#include <boost/weak_ptr.hpp>
 #include <ignition/math/Helpers.hh>
 #include <ignition/math/Pose3.hh>
 
-#include "gazebo/msgs/msgs.hh"
-
 #include "gazebo/common/Events.hh"
 
-#include "gazebo/transport/Node.hh"
-#include "gazebo/transport/Subscriber.hh"
+#include "gazebo/msgs/msgs.hh"
 
 #include "gazebo/physics/ContactManager.hh"
 #include "gazebo/physics/World.hh"
@@ -46,13 +45,20 @@ using namespace physics;
 /// \brief Private data class for Gripper
 class gazebo::physics::GripperPrivate
 {
-  /// \brief Callback used when the gripper contacts an object.
+  /// \brief Callback used by the contact manager with the contacts of the
+  /// gripper links.
   /// \param[in] _msg Message that contains contact information.
   public: void OnContacts(ConstContactsPtr &_msg);
 
-  /// \brief Update the gripper.
+  /// \brief Update the gripper, once per world update.
   public: void OnUpdate();
 
+  /// \brief Get a collision by scoped name, looking it up in the world
+  /// only the first time.
+  /// \param[in] _name Scoped name of the collision.
+  /// \return The collision, null if not found.
+  public: CollisionPtr CollisionByName(const std::string &_name);
+
   /// \brief Attach an object to the gripper.
   public: void HandleAttach();
 
@@ -74,12 +80,17 @@ class gazebo::physics::GripperPrivate
   /// \brief The base link for the gripper.
   public: physics::LinkPtr palmLink;
 
-  /// \brief All our connections.
-  public: std::vector<event::ConnectionPtr> connections;
-
   /// \brief The collisions for the links in the gripper.
   public: std::map<std::string, physics::CollisionPtr> collisions;
 
+  /// \brief Collisions in contact with the gripper links, by scoped name.
+  /// They are weak, so that the collisions of deleted models are released.
+  public: std::map<std::string, boost::weak_ptr<physics::Collision>>
+          contactCollisions;
+
+  /// \brief Connection to the world update end event.
+  public: event::ConnectionPtr updateConnection;
+
   /// \brief The current contacts.
   public: std::vector<msgs::Contact> contacts;
 
@@ -99,10 +110,10 @@ class gazebo::physics::GripperPrivate
   /// \brief Current index into the diff array.
   public: int diffIndex;
 
-  /// \brief Rate at which to update the gripper.
+  /// \brief Sim time period at which to update the gripper.
   public: common::Time updateRate;
 
-  /// \brief Previous time when the gripper was updated.
+  /// \brief Previous sim time when the gripper was updated.
   public: common::Time prevUpdateTime;
 
   /// \brief Number of iterations the gripper was contacting the same
@@ -124,12 +135,6 @@ class gazebo::physics::GripperPrivate
 
   /// \brief Name of the gripper.
   public: std::string name;
-
-  /// \brief Node for communication.
-  public: transport::NodePtr node;
-
-  /// \brief Subscription to contact messages from the physics engine.
-  public: transport::SubscriberPtr contactSub;
 };
 
 /////////////////////////////////////////////////
@@ -145,30 +150,30 @@ Gripper::Gripper(ModelPtr _model) : dataPtr(new GripperPrivate)
   this->dataPtr->attached = false;
 
   this->dataPtr->updateRate = common::Time(0, common::Time::SecToNano(0.75));
-
-  this->dataPtr->node = transport::NodePtr(new transport::Node());
 }
 
 /////////////////////////////////////////////////
 Gripper::~Gripper()
 {
-  if (this->dataPtr->world && this->dataPtr->world->Running())
+  this->dataPtr->updateConnection.reset();
+
+  if (this->dataPtr->world && this->dataPtr->world->Physics())
   {
     physics::ContactManager *mgr =
         this->dataPtr->world->Physics()->GetContactManager();
-    mgr->RemoveFilter(this->Name());
+    if (this->dataPtr->world->Running())
+      mgr->RemoveFilter(this->Name());
+    else
+      mgr->SetFilterCallback(this->Name(), nullptr);
   }
 
   this->dataPtr->model.reset();
   this->dataPtr->world.reset();
-  this->dataPtr->connections.clear();
 }
 
 /////////////////////////////////////////////////
 void Gripper::Load(sdf::ElementPtr _sdf)
 {
-  this->dataPtr->node->Init(this->dataPtr->world->Name());
-
   this->dataPtr->name = _sdf->Get<std::string>("name");
   this->dataPtr->fixedJoint =
       this->dataPtr->world->Physics()->CreateJoint("fixed",
@@ -214,26 +219,24 @@ void Gripper::Load(sdf::ElementPtr _sdf)
 
   if (!this->dataPtr->collisions.empty())
   {
-    // request the contact manager to publish messages to a custom topic for
-    // this sensor
+    // request the contact manager to filter the contacts of the gripper
+    // links, and to hand them directly to this gripper
     physics::ContactManager *mgr =
         this->dataPtr->world->Physics()->GetContactManager();
-    std::string topic = mgr->CreateFilter(this->Name(),
-        this->dataPtr->collisions);
-    if (!this->dataPtr->contactSub)
-    {
-      this->dataPtr->contactSub = this->dataPtr->node->Subscribe(topic,
-          &GripperPrivate::OnContacts, this->dataPtr.get());
-    }
+    mgr->CreateFilter(this->Name(), this->dataPtr->collisions);
+    mgr->SetFilterCallback(this->Name(),
+        std::bind(&GripperPrivate::OnContacts, this->dataPtr.get(),
+          std::placeholders::_1));
   }
-  this->dataPtr->connections.push_back(event::Events::ConnectWorldUpdateEnd(
-          std::bind(&GripperPrivate::OnUpdate, this->dataPtr.get())));
+
+  this->dataPtr->updateConnection = event::Events::ConnectWorldUpdateEnd(
+      std::bind(&GripperPrivate::OnUpdate, this->dataPtr.get()));
 }
 
 /////////////////////////////////////////////////
 void Gripper::Init()
 {
-  this->dataPtr->prevUpdateTime = common::Time::GetWallTime();
+  this->dataPtr->prevUpdateTime = this->dataPtr->world->SimTime();
   this->dataPtr->zeroCount = 0;
   this->dataPtr->posCount = 0;
   this->dataPtr->attached = false;
@@ -254,11 +257,23 @@ bool Gripper::IsAttached() const
 /////////////////////////////////////////////////
 void GripperPrivate::OnUpdate()
 {
-  if (common::Time::GetWallTime() - this->prevUpdateTime < this->updateRate)
+  const common::Time simTime = this->world->SimTime();
+
+  std::lock_guard<std::mutex> lock(this->mutexContacts);
+
+  // Nothing can change while the gripper holds nothing and touches too
+  // little, so idle grippers skip the grasp check
+  if (!this->attached && this->posCount == 0 &&
+      this->contacts.size() < this->minContactCount)
   {
+    this->contacts.clear();
+    this->prevUpdateTime = simTime;
     return;
   }
 
+  if (simTime - this->prevUpdateTime < this->updateRate)
+    return;
+
   // @todo: should package the decision into a function
   if (this->contacts.size() >= this->minContactCount)
   {
@@ -280,12 +295,9 @@ void GripperPrivate::OnUpdate()
     this->HandleDetach();
   }
 
-  {
-    std::lock_guard<std::mutex> lock(this->mutexContacts);
-    this->contacts.clear();
-  }
+  this->contacts.clear();
 
-  this->prevUpdateTime = common::Time::GetWallTime();
+  this->prevUpdateTime = simTime;
 }
 
 /////////////////////////////////////////////////
@@ -301,10 +313,8 @@ void GripperPrivate::HandleAttach()
   std::map<std::string, int> contactCounts;
   std::map<std::string, int>::iterator iter;
 
-  // This function is only called from the OnUpdate function so
-  // the call to contacts.clear() is not going to happen in
-  // parallel with the reads in the following code, no mutex
-  // needed.
+  // This function is only called from the OnUpdate function, which
+  // holds the contacts mutex.
   for (unsigned int i = 0; i < this->contacts.size(); ++i)
   {
     std::string name1 = this->contacts[i].collision1();
@@ -312,15 +322,13 @@ void GripperPrivate::HandleAttach()
 
     if (this->collisions.find(name1) == this->collisions.end())
     {
-      cc[name1] = boost::dynamic_pointer_cast<Collision>(
-          this->world->EntityByName(name1));
+      cc[name1] = this->CollisionByName(name1);
       contactCounts[name1] += 1;
     }
 
     if (this->collisions.find(name2) == this->collisions.end())
     {
-      cc[name2] = boost::dynamic_pointer_cast<Collision>(
-          this->world->EntityByName(name2));
+      cc[name2] = this->CollisionByName(name2);
       contactCounts[name2] += 1;
     }
   }
@@ -375,10 +383,10 @@ void GripperPrivate::OnContacts(ConstContactsPtr &_msg)
 {
   for (int i = 0; i < _msg->contact_size(); ++i)
   {
-    CollisionPtr collision1 = boost::dynamic_pointer_cast<Collision>(
-        this->world->EntityByName(_msg->contact(i).collision1()));
-    CollisionPtr collision2 = boost::dynamic_pointer_cast<Collision>(
-        this->world->EntityByName(_msg->contact(i).collision2()));
+    CollisionPtr collision1 =
+      this->CollisionByName(_msg->contact(i).collision1());
+    CollisionPtr collision2 =
+      this->CollisionByName(_msg->contact(i).collision2());
 
     if ((collision1 && !collision1->IsStatic()) &&
         (collision2 && !collision2->IsStatic()))
@@ -389,6 +397,30 @@ void GripperPrivate::OnContacts(ConstContactsPtr &_msg)
   }
 }
 
+/////////////////////////////////////////////////
+CollisionPtr GripperPrivate::CollisionByName(const std::string &_name)
+{
+  auto iter = this->collisions.find(_name);
+  if (iter != this->collisions.end())
+    return iter->second;
+
+  auto contactIter = this->contactCollisions.find(_name);
+  if (contactIter != this->contactCollisions.end())
+  {
+    // The collision may have been removed since
+    CollisionPtr collision = contactIter->second.lock();
+    if (collision && collision->GetLink())
+      return collision;
+    this->contactCollisions.erase(contactIter);
+  }
+
+  CollisionPtr collision = boost::dynamic_pointer_cast<Collision>(
+      this->world->EntityByName(_name));
+  if (collision)
+    this->contactCollisions[_name] = collision;
+  return collision;
+}
+
 /////////////////////////////////////////////////
 void GripperPrivate::ResetDiffs()
 {
@@ -17,6 +17,7 @@
 #include <algorithm>
 #include <cmath>
 #include <string>
+#include <vector>
 #include <ignition/math/Helpers.hh>
 #include <gazebo/gazebo_config.h>
 
@@ -81,7 +82,9 @@ void HeightmapShape::OnRequest(ConstRequestPtr &_msg)
 //////////////////////////////////////////////////
 int HeightmapShape::LoadTerrainFile(const std::string &_filename)
 {
-  this->heightmapData = common::HeightmapDataLoader::LoadTerrainFile(_filename);
+  this->sharedHeightmapData =
+    common::HeightmapDataLoader::LoadTerrainFileShared(_filename);
+  this->heightmapData = this->sharedHeightmapData.get();
   if (!this->heightmapData)
   {
     gzerr << "Unable to load heightmap data" << std::endl;
@@ -256,8 +259,71 @@ void HeightmapShape::Init()
   else
     this->scale.Z() = fabs(terrainSize.Z()) / heightmapSizeZ;
 
+  // Large heightmaps load their heights in tiles, on demand
+  if (this->sdf->HasElement("ignition:tiles"))
+  {
+    if (this->TilesSupported())
+    {
+      sdf::ElementPtr elem = this->sdf->GetElement("ignition:tiles");
+      unsigned int tileSize = 129;
+      unsigned int maxTiles = 64;
+      if (elem->HasElement("size"))
+        tileSize = elem->Get<unsigned int>("size");
+      if (elem->HasElement("max_tiles"))
+        maxTiles = elem->Get<unsigned int>("max_tiles");
+
+      common::HeightmapData *data = this->heightmapData;
+      const int sampling = this->subSampling;
+      const unsigned int size = this->vertSize;
+      const bool flip = this->flipY;
+      const ignition::math::Vector3d heightScale = this->scale;
+      this->tileCache.reset(new HeightmapTileCache(this->vertSize, tileSize,
+            maxTiles, [=](unsigned int _x, unsigned int _y,
+              unsigned int _tileSize, unsigned int _stride,
+              std::vector<float> &_heights)
+            {
+              data->FillHeightMapTile(sampling, size, terrainSize,
+                  heightScale, flip, _x, _y, _tileSize, _stride, _heights);
+            }));
+
+      if (elem->HasElement("lod_distance"))
+      {
+        this->tileCache->SetLodDistance(
+            elem->Get<unsigned int>("lod_distance"));
+      }
+      if (elem->HasElement("max_lod"))
+        this->tileCache->SetMaxLod(elem->Get<unsigned int>("max_lod"));
+      return;
+    }
+
+    gzwarn << "The physics engine doesn't support tiled heightmaps, "
+           << "loading all the heights of [" << this->GetURI() << "]\n";
+  }
+
   // Construct the heightmap lookup table
   this->FillHeightfield(this->heights);
+  this->pyramid.Build(
+      std::vector<float>(this->heights.begin(), this->heights.end()),
+      this->vertSize);
+}
+
+//////////////////////////////////////////////////
+bool HeightmapShape::TilesSupported() const
+{
+  return false;
+}
+
+//////////////////////////////////////////////////
+void HeightmapShape::FillOverview(std::vector<float> &_heights) const
+{
+  // Sample the whole heightmap with a power of two stride
+  unsigned int stride = 1;
+  while ((this->vertSize - 1) / stride + 1 > 257)
+    stride *= 2;
+
+  this->heightmapData->FillHeightMapTile(this->subSampling, this->vertSize,
+      this->Size(), this->scale, this->flipY, 0, 0,
+      (this->vertSize - 1) / stride + 1, stride, _heights);
 }
 
 //////////////////////////////////////////////////
@@ -309,6 +375,13 @@ void HeightmapShape::FillHeights(msgs::Geometry &_msg) const
   {
     for (unsigned int x = 0; x < this->vertSize; ++x)
     {
+      if (this->tileCache)
+      {
+        _msg.mutable_heightmap()->add_heights(
+            this->tileCache->Height(x, this->vertSize - y - 1));
+        continue;
+      }
+
       int index = (this->vertSize - y - 1) * this->vertSize + x;
       _msg.mutable_heightmap()->add_heights(this->heights[index]);
     }
@@ -330,6 +403,9 @@ ignition::math::Vector2i HeightmapShape::VertexCount() const
 /////////////////////////////////////////////////
 HeightmapShape::HeightType HeightmapShape::GetHeight(int _x, int _y) const
 {
+  if (this->tileCache)
+    return this->tileCache->Height(_x, _y);
+
   int index =  _y * this->vertSize + _x;
   if (_x < 0 || _y < 0 || index >= static_cast<int>(this->heights.size()))
     return 0.0;
@@ -340,6 +416,12 @@ HeightmapShape::HeightType HeightmapShape::GetHeight(int _x, int _y) const
 /////////////////////////////////////////////////
 void HeightmapShape::SetHeight(int _x, int _y, HeightmapShape::HeightType _h)
 {
+  if (this->tileCache)
+  {
+    gzerr << "SetHeight is not supported by tiled heightmaps" << std::endl;
+    return;
+  }
+
   int index =  _y * this->vertSize + _x;
   if (_x < 0 || _y < 0 || index >= static_cast<int>(this->heights.size()))
   {
@@ -349,12 +431,80 @@ void HeightmapShape::SetHeight(int _x, int _y, HeightmapShape::HeightType _h)
   }
 
   this->heights[index] = _h;
+  this->pyramid.SetHeight(_x, _y, _h);
+}
+
+/////////////////////////////////////////////////
+HeightmapShape::HeightType HeightmapShape::InterpolatedHeight(
+    const double _x, const double _y,
+    const common::HeightmapPyramid::Interpolation _interpolation) const
+{
+  if (!this->tileCache)
+    return this->pyramid.Height(_x, _y, 0, _interpolation);
+
+  const double last = this->vertSize - 1.0;
+  const double x = ignition::math::clamp(_x, 0.0, last);
+  const double y = ignition::math::clamp(_y, 0.0, last);
+  const int x1 = std::min(static_cast<int>(x), static_cast<int>(last) - 1);
+  const int y1 = std::min(static_cast<int>(y), static_cast<int>(last) - 1);
+  const double dx = x - x1;
+  const double dy = y - y1;
+  const double h1 = this->GetHeight(x1, y1) +
+    (this->GetHeight(x1 + 1, y1) - this->GetHeight(x1, y1)) * dx;
+  const double h2 = this->GetHeight(x1, y1 + 1) +
+    (this->GetHeight(x1 + 1, y1 + 1) - this->GetHeight(x1, y1 + 1)) * dx;
+  return h1 + (h2 - h1) * dy;
+}
+
+/////////////////////////////////////////////////
+void HeightmapShape::InterpolatedHeights(const std::vector<float> &_x,
+    const std::vector<float> &_y, std::vector<float> &_heights,
+    const common::HeightmapPyramid::Interpolation _interpolation) const
+{
+  if (!this->tileCache)
+  {
+    this->pyramid.Heights(_x, _y, _heights, 0, _interpolation);
+    return;
+  }
+
+  _heights.resize(std::min(_x.size(), _y.size()));
+  for (size_t i = 0; i < _heights.size(); ++i)
+    _heights[i] = this->InterpolatedHeight(_x[i], _y[i]);
+}
+
+/////////////////////////////////////////////////
+bool HeightmapShape::HeightRange(const double _minX, const double _minY,
+    const double _maxX, const double _maxY, HeightType &_min,
+    HeightType &_max) const
+{
+  float min, max;
+  if (this->tileCache ||
+      !this->pyramid.Range(_minX, _minY, _maxX, _maxY, min, max))
+  {
+    return false;
+  }
+  _min = min;
+  _max = max;
+  return true;
 }
 
 /////////////////////////////////////////////////
 HeightmapShape::HeightType HeightmapShape::GetMaxHeight() const
 {
   HeightType max = -std::numeric_limits<HeightType>::max();
+  if (this->tileCache)
+  {
+    // Tiled heightmaps only give an estimate
+    std::vector<float> overview;
+    this->FillOverview(overview);
+    for (auto h : overview)
+      max = std::max(max, static_cast<HeightType>(h));
+    return max;
+  }
+
+  if (this->pyramid.Side() > 0)
+    return this->pyramid.Max();
+
   for (unsigned int i = 0; i < this->heights.size(); ++i)
   {
     if (this->heights[i] > max)
@@ -368,6 +518,19 @@ HeightmapShape::HeightType HeightmapShape::GetMaxHeight() const
 HeightmapShape::HeightType HeightmapShape::GetMinHeight() const
 {
   HeightType min = std::numeric_limits<HeightType>::max();
+  if (this->tileCache)
+  {
+    // Tiled heightmaps only give an estimate
+    std::vector<float> overview;
+    this->FillOverview(overview);
+    for (auto h : overview)
+      min = std::min(min, static_cast<HeightType>(h));
+    return min;
+  }
+
+  if (this->pyramid.Side() > 0)
+    return this->pyramid.Min();
+
   for (unsigned int i = 0; i < this->heights.size(); ++i)
   {
     if (this->heights[i] < min)
@@ -408,6 +571,10 @@ common::Image HeightmapShape::GetImage() const
       // Normalize height value
       height = (this->GetHeight(sx, sy) - minHeight) / maxHeight;
 
+      // The range of the heights of a tiled heightmap is an estimate
+      if (this->tileCache)
+        height = ignition::math::clamp(height, 0.0, 1.0);
+
       GZ_ASSERT(height <= 1.0, "Normalized terrain height > 1.0");
       GZ_ASSERT(height >= 0.0, "Normalized terrain height < 0.0");
 
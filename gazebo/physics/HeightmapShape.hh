@@ -17,6 +17,7 @@
 #ifndef GAZEBO_PHYSICS_HEIGHTMAPSHAPE_HH_
 #define GAZEBO_PHYSICS_HEIGHTMAPSHAPE_HH_
 
+#include <memory>
 #include <string>
 #include <vector>
 #include <ignition/transport/Node.hh>
@@ -25,8 +26,10 @@
 
 #include "gazebo/common/ImageHeightmap.hh"
 #include "gazebo/common/HeightmapData.hh"
+#include "gazebo/common/HeightmapPyramid.hh"
 #include "gazebo/common/Dem.hh"
 #include "gazebo/transport/TransportTypes.hh"
+#include "gazebo/physics/HeightmapTileCache.hh"
 #include "gazebo/physics/PhysicsTypes.hh"
 #include "gazebo/physics/Shape.hh"
 #include "gazebo/util/system.hh"
@@ -89,6 +92,40 @@ namespace gazebo
       /// \return The height at a the specified location.
       public: HeightType GetHeight(int _x, int _y) const;
 
+      /// \brief Sample the height between the vertices.
+      /// \param[in] _x Column, in vertices.
+      /// \param[in] _y Row, in vertices.
+      /// \param[in] _interpolation Interpolation between the vertices.
+      /// Tiled heightmaps are always interpolated bilinearly.
+      /// \return The height.
+      public: HeightType InterpolatedHeight(const double _x, const double _y,
+                  const common::HeightmapPyramid::Interpolation
+                  _interpolation = common::HeightmapPyramid::BILINEAR) const;
+
+      /// \brief Sample the heights at many positions, e.g. under the wheels
+      /// of vehicles, faster than one by one.
+      /// \param[in] _x Columns, in vertices.
+      /// \param[in] _y Rows, in vertices.
+      /// \param[out] _heights The heights.
+      /// \param[in] _interpolation Interpolation between the vertices.
+      public: void InterpolatedHeights(const std::vector<float> &_x,
+                  const std::vector<float> &_y, std::vector<float> &_heights,
+                  const common::HeightmapPyramid::Interpolation
+                  _interpolation = common::HeightmapPyramid::BILINEAR) const;
+
+      /// \brief Get conservative bounds of the heights of a region, e.g. to
+      /// cull rays or broadphase pairs that pass above it.
+      /// \param[in] _minX Smallest column of the region, in vertices.
+      /// \param[in] _minY Smallest row of the region, in vertices.
+      /// \param[in] _maxX Largest column of the region, in vertices.
+      /// \param[in] _maxY Largest row of the region, in vertices.
+      /// \param[out] _min Lower bound of the heights.
+      /// \param[out] _max Upper bound of the heights.
+      /// \return False if there are no bounds, e.g. for tiled heightmaps.
+      public: bool HeightRange(const double _minX, const double _minY,
+                  const double _maxX, const double _maxY,
+                  HeightType &_min, HeightType &_max) const;
+
       /// \brief Sets a height value at a position.
       /// \param[in] _x X position.
       /// \param[in] _y Y position.
@@ -149,15 +186,37 @@ namespace gazebo
       /// \brief Version of FillHeightfield() for double vectors.
       public: void FillHeightfield(std::vector<double>& heights);
 
+      /// \brief Whether the physics engine can collide with a tiled
+      /// heightmap, which has no lookup table of heights: it must only
+      /// read the heights through GetHeight.
+      /// \return True if the heightmap can be tiled.
+      protected: virtual bool TilesSupported() const;
+
+      /// \brief Fill a coarse table of the heights of a tiled heightmap.
+      /// \param[out] _heights At most 257 * 257 heights.
+      private: void FillOverview(std::vector<float> &_heights) const;
+
       /// \brief Lookup table of heights.
       protected: std::vector<HeightType> heights;
 
+      /// \brief Levels and bounds of the lookup table of heights, empty
+      /// for tiled heightmaps.
+      protected: common::HeightmapPyramid pyramid;
+
+      /// \brief Tiles of heights, loaded on demand, which replace the
+      /// lookup table when the heightmap has an <ignition:tiles> element.
+      protected: std::unique_ptr<HeightmapTileCache> tileCache;
+
       /// \brief Image used to generate the heights.
       protected: common::ImageHeightmap img;
 
       /// \brief HeightmapData used to generate the heights.
       protected: common::HeightmapData *heightmapData;
 
+      /// \brief Owner of heightmapData, which is shared with the rendering
+      /// heightmaps of the same file.
+      protected: std::shared_ptr<common::HeightmapData> sharedHeightmapData;
+
       /// \brief Size of the height lookup table.
       protected: unsigned int vertSize;
 
@@ -0,0 +1,285 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+#include <ignition/math/Helpers.hh>
+
+#include "gazebo/physics/HeightmapTileCache.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \internal
+    /// \brief A loaded tile.
+    class HeightmapTile
+    {
+      /// \brief Heights of the tile, row by row.
+      public: std::vector<float> heights;
+
+      /// \brief Number of heights per side.
+      public: unsigned int size = 0;
+
+      /// \brief Number of vertices between two heights.
+      public: unsigned int stride = 1;
+
+      /// \brief Position of the tile in the usage list.
+      public: std::list<uint64_t>::iterator usage;
+    };
+
+    /// \internal
+    /// \brief Private data for HeightmapTileCache.
+    class HeightmapTileCachePrivate
+    {
+      /// \brief Get the level of detail of a tile. The mutex must be
+      /// locked.
+      /// \param[in] _tileX Column of the tile.
+      /// \param[in] _tileY Row of the tile.
+      /// \return Level of detail.
+      public: unsigned int Lod(const unsigned int _tileX,
+                  const unsigned int _tileY) const
+              {
+                // The whole terrain is coarse when nothing is around
+                if (this->focus.empty())
+                  return this->maxLod;
+
+                // Chebyshev distance, in tiles, to the nearest focus point
+                const double span = this->tileSize - 1;
+                double distance = std::numeric_limits<double>::max();
+                for (auto const &point : this->focus)
+                {
+                  const double dx = std::abs(
+                      std::floor(point.X() / span) - _tileX);
+                  const double dy = std::abs(
+                      std::floor(point.Y() / span) - _tileY);
+                  distance = std::min(distance, std::max(dx, dy));
+                }
+
+                const double lod = std::floor(distance / this->lodDistance);
+                if (lod >= this->maxLod)
+                  return this->maxLod;
+                return static_cast<unsigned int>(lod);
+              }
+
+      /// \brief Number of vertices per side of the heightmap.
+      public: unsigned int vertSize = 0;
+
+      /// \brief Number of vertices per side of a tile.
+      public: unsigned int tileSize = 0;
+
+      /// \brief Number of tiles per side of the heightmap.
+      public: unsigned int tileCount = 0;
+
+      /// \brief Maximum number of loaded tiles.
+      public: unsigned int maxTiles = 1;
+
+      /// \brief Distance between two levels of detail, in tiles.
+      public: unsigned int lodDistance = 2;
+
+      /// \brief Coarsest level of detail.
+      public: unsigned int maxLod = 0;
+
+      /// \brief Function that fills the heights of a tile.
+      public: HeightmapTileCache::FillFunction fill;
+
+      /// \brief Focus points, in vertex coordinates.
+      public: std::vector<ignition::math::Vector2d> focus;
+
+      /// \brief Loaded tiles, by key.
+      public: std::unordered_map<uint64_t, HeightmapTile> tiles;
+
+      /// \brief Keys of the loaded tiles, the most recently used first.
+      public: std::list<uint64_t> usage;
+
+      /// \brief Mutex that protects the tiles and the focus.
+      public: mutable std::mutex mutex;
+    };
+  }
+}
+
+using namespace gazebo;
+using namespace physics;
+
+//////////////////////////////////////////////////
+HeightmapTileCache::HeightmapTileCache(const unsigned int _vertSize,
+    const unsigned int _tileSize, const unsigned int _maxTiles,
+    FillFunction _fill)
+: dataPtr(new HeightmapTileCachePrivate)
+{
+  this->dataPtr->vertSize = _vertSize;
+  this->dataPtr->tileSize =
+    ignition::math::roundUpPowerOfTwo(std::max(_tileSize, 3u) - 1) + 1;
+  this->dataPtr->maxTiles = std::max(_maxTiles, 1u);
+  this->dataPtr->fill = std::move(_fill);
+
+  const unsigned int span = this->dataPtr->tileSize - 1;
+  this->dataPtr->tileCount =
+    std::max((std::max(_vertSize, 1u) - 1 + span - 1) / span, 1u);
+
+  // Default to four levels of detail below the full resolution
+  this->SetMaxLod(4);
+}
+
+//////////////////////////////////////////////////
+HeightmapTileCache::~HeightmapTileCache()
+{
+}
+
+//////////////////////////////////////////////////
+float HeightmapTileCache::Height(const int _x, const int _y)
+{
+  if (_x < 0 || _y < 0 || _x >= static_cast<int>(this->dataPtr->vertSize) ||
+      _y >= static_cast<int>(this->dataPtr->vertSize))
+  {
+    return 0.0;
+  }
+
+  const unsigned int span = this->dataPtr->tileSize - 1;
+  const unsigned int tileX =
+    std::min(static_cast<unsigned int>(_x) / span,
+        this->dataPtr->tileCount - 1);
+  const unsigned int tileY =
+    std::min(static_cast<unsigned int>(_y) / span,
+        this->dataPtr->tileCount - 1);
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  const unsigned int lod = this->dataPtr->Lod(tileX, tileY);
+  const uint64_t key = (static_cast<uint64_t>(tileX) << 40) |
+    (static_cast<uint64_t>(tileY) << 8) | lod;
+
+  auto iter = this->dataPtr->tiles.find(key);
+  if (iter != this->dataPtr->tiles.end())
+  {
+    // Mark the tile as the most recently used
+    this->dataPtr->usage.splice(this->dataPtr->usage.begin(),
+        this->dataPtr->usage, iter->second.usage);
+  }
+  else
+  {
+    // Release the least recently used tiles
+    while (this->dataPtr->tiles.size() >= this->dataPtr->maxTiles)
+    {
+      this->dataPtr->tiles.erase(this->dataPtr->usage.back());
+      this->dataPtr->usage.pop_back();
+    }
+
+    HeightmapTile tile;
+    tile.stride = 1u << lod;
+    tile.size = span / tile.stride + 1;
+    this->dataPtr->fill(tileX * span, tileY * span, tile.size, tile.stride,
+        tile.heights);
+    tile.heights.resize(tile.size * tile.size, 0.0f);
+
+    this->dataPtr->usage.push_front(key);
+    tile.usage = this->dataPtr->usage.begin();
+    iter = this->dataPtr->tiles.emplace(key, std::move(tile)).first;
+  }
+
+  // Interpolate between the vertices of a coarse tile
+  const HeightmapTile &tile = iter->second;
+  const unsigned int u = _x - tileX * span;
+  const unsigned int v = _y - tileY * span;
+  const unsigned int i0 = std::min(v / tile.stride, tile.size - 1);
+  const unsigned int j0 = std::min(u / tile.stride, tile.size - 1);
+  const unsigned int i1 = std::min(i0 + 1, tile.size - 1);
+  const unsigned int j1 = std::min(j0 + 1, tile.size - 1);
+  const float dy = (v - i0 * tile.stride) / static_cast<float>(tile.stride);
+  const float dx = (u - j0 * tile.stride) / static_cast<float>(tile.stride);
+
+  const float h1 = tile.heights[i0 * tile.size + j0] * (1.0f - dx) +
+    tile.heights[i0 * tile.size + j1] * dx;
+  const float h2 = tile.heights[i1 * tile.size + j0] * (1.0f - dx) +
+    tile.heights[i1 * tile.size + j1] * dx;
+  return h1 * (1.0f - dy) + h2 * dy;
+}
+
+//////////////////////////////////////////////////
+void HeightmapTileCache::SetFocus(
+    const std::vector<ignition::math::Vector2d> &_points)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->focus = _points;
+}
+
+//////////////////////////////////////////////////
+void HeightmapTileCache::SetLodDistance(const unsigned int _tiles)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->lodDistance = std::max(_tiles, 1u);
+}
+
+//////////////////////////////////////////////////
+unsigned int HeightmapTileCache::LodDistance() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->lodDistance;
+}
+
+//////////////////////////////////////////////////
+void HeightmapTileCache::SetMaxLod(const unsigned int _lod)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  // A tile keeps at least its corners
+  unsigned int coarsest = 0;
+  while ((2u << coarsest) <= this->dataPtr->tileSize - 1)
+    ++coarsest;
+  this->dataPtr->maxLod = std::min(_lod, coarsest);
+}
+
+//////////////////////////////////////////////////
+unsigned int HeightmapTileCache::MaxLod() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->maxLod;
+}
+
+//////////////////////////////////////////////////
+unsigned int HeightmapTileCache::Lod(const unsigned int _tileX,
+    const unsigned int _tileY) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->Lod(_tileX, _tileY);
+}
+
+//////////////////////////////////////////////////
+unsigned int HeightmapTileCache::TileSize() const
+{
+  return this->dataPtr->tileSize;
+}
+
+//////////////////////////////////////////////////
+unsigned int HeightmapTileCache::MaxTiles() const
+{
+  return this->dataPtr->maxTiles;
+}
+
+//////////////////////////////////////////////////
+unsigned int HeightmapTileCache::TileCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return static_cast<unsigned int>(this->dataPtr->tiles.size());
+}
@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_HEIGHTMAPTILECACHE_HH_
+#define GAZEBO_PHYSICS_HEIGHTMAPTILECACHE_HH_
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <ignition/math/Vector2.hh>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    // Forward declare private data class.
+    class HeightmapTileCachePrivate;
+
+    /// \addtogroup gazebo_physics
+    /// \{
+
+    /// \class HeightmapTileCache HeightmapTileCache.hh physics/physics.hh
+    /// \brief Loads the heights of a large heightmap in square tiles, on
+    /// demand, instead of keeping the whole height table in memory.
+    ///
+    /// Neighbouring tiles share their edge vertices. The tiles near the
+    /// focus points, usually the active links, are loaded at the full
+    /// resolution; the level of detail of a tile drops by one, halving its
+    /// resolution, every LodDistance tiles away from the nearest focus
+    /// point. When more than MaxTiles tiles are loaded, the least recently
+    /// used tiles are released. The cache is thread safe.
+    class GZ_PHYSICS_VISIBLE HeightmapTileCache
+    {
+      /// \brief Function that fills the heights of a tile, see
+      /// common::HeightmapData::FillHeightMapTile.
+      /// \param[in] _x Column of the first vertex of the tile.
+      /// \param[in] _y Row of the first vertex of the tile.
+      /// \param[in] _tileSize Number of vertices per side of the tile.
+      /// \param[in] _stride Number of rows and columns between two vertices
+      /// of the tile.
+      /// \param[out] _heights The heights of the tile, row by row.
+      public: typedef std::function<void (unsigned int _x, unsigned int _y,
+                  unsigned int _tileSize, unsigned int _stride,
+                  std::vector<float> &_heights)> FillFunction;
+
+      /// \brief Constructor.
+      /// \param[in] _vertSize Number of vertices per side of the heightmap.
+      /// \param[in] _tileSize Number of vertices per side of a tile, 2^n+1.
+      /// Other sizes are rounded up.
+      /// \param[in] _maxTiles Maximum number of loaded tiles, at least one.
+      /// \param[in] _fill Function that fills the heights of a tile.
+      public: HeightmapTileCache(const unsigned int _vertSize,
+                  const unsigned int _tileSize, const unsigned int _maxTiles,
+                  FillFunction _fill);
+
+      /// \brief Destructor.
+      public: virtual ~HeightmapTileCache();
+
+      /// \brief Get the height at a vertex, loading its tile if needed.
+      /// \param[in] _x Column of the vertex.
+      /// \param[in] _y Row of the vertex.
+      /// \return The height, or zero if the vertex is out of bounds.
+      public: float Height(const int _x, const int _y);
+
+      /// \brief Set the points around which the tiles are loaded at the
+      /// full resolution.
+      /// \param[in] _points Points, in vertex coordinates: (column, row).
+      public: void SetFocus(
+                  const std::vector<ignition::math::Vector2d> &_points);
+
+      /// \brief Set the distance between two levels of detail.
+      /// \param[in] _tiles Distance, in tiles, at least one.
+      public: void SetLodDistance(const unsigned int _tiles);
+
+      /// \brief Get the distance between two levels of detail.
+      /// \return Distance, in tiles.
+      public: unsigned int LodDistance() const;
+
+      /// \brief Set the coarsest level of detail. Level n keeps one vertex
+      /// out of 2^n along each side of a tile.
+      /// \param[in] _lod Coarsest level, at most log2(TileSize() - 1).
+      public: void SetMaxLod(const unsigned int _lod);
+
+      /// \brief Get the coarsest level of detail.
+      /// \return Coarsest level.
+      public: unsigned int MaxLod() const;
+
+      /// \brief Get the level of detail of a tile, given the focus points.
+      /// \param[in] _tileX Column of the tile.
+      /// \param[in] _tileY Row of the tile.
+      /// \return Level of detail, zero for the full resolution.
+      public: unsigned int Lod(const unsigned int _tileX,
+                  const unsigned int _tileY) const;
+
+      /// \brief Get the number of vertices per side of a tile.
+      /// \return Number of vertices.
+      public: unsigned int TileSize() const;
+
+      /// \brief Get the maximum number of loaded tiles.
+      /// \return Maximum number of tiles.
+      public: unsigned int MaxTiles() const;
+
+      /// \brief Get the number of loaded tiles.
+      /// \return Number of tiles.
+      public: unsigned int TileCount() const;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<HeightmapTileCachePrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
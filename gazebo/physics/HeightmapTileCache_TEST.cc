@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <vector>
+
+#include "gazebo/physics/HeightmapTileCache.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class HeightmapTileCacheTest : public gazebo::testing::AutoLogFixture { };
+
+/// \brief Number of vertices per side of the test heightmap.
+static const unsigned int kVertSize = 257;
+
+/////////////////////////////////////////////////
+/// \brief Height of a vertex of the test heightmap, a tilted plane.
+/// \param[in] _x Column of the vertex.
+/// \param[in] _y Row of the vertex.
+/// \return The height.
+static float PlaneHeight(const unsigned int _x, const unsigned int _y)
+{
+  return 0.5f * std::min(_x, kVertSize - 1) + 2.0f * std::min(_y,
+      kVertSize - 1);
+}
+
+/////////////////////////////////////////////////
+TEST_F(HeightmapTileCacheTest, Height)
+{
+  unsigned int fills = 0;
+  physics::HeightmapTileCache cache(kVertSize, 60, 4,
+      [&fills](unsigned int _x, unsigned int _y, unsigned int _tileSize,
+        unsigned int _stride, std::vector<float> &_heights)
+      {
+        ++fills;
+        _heights.resize(_tileSize * _tileSize);
+        for (unsigned int i = 0; i < _tileSize; ++i)
+        {
+          for (unsigned int j = 0; j < _tileSize; ++j)
+          {
+            _heights[i * _tileSize + j] =
+              PlaneHeight(_x + j * _stride, _y + i * _stride);
+          }
+        }
+      });
+
+  // The tile size is rounded up to 2^n+1
+  EXPECT_EQ(65u, cache.TileSize());
+  EXPECT_EQ(4u, cache.MaxTiles());
+  EXPECT_EQ(4u, cache.MaxLod());
+  EXPECT_EQ(0u, cache.TileCount());
+
+  // Out of bounds
+  EXPECT_FLOAT_EQ(0.0f, cache.Height(-1, 3));
+  EXPECT_FLOAT_EQ(0.0f, cache.Height(3, kVertSize));
+  EXPECT_EQ(0u, fills);
+
+  // Without focus all the tiles are coarse, which is exact on a plane
+  EXPECT_EQ(4u, cache.Lod(0, 0));
+  for (unsigned int y = 0; y < kVertSize; y += 7)
+  {
+    for (unsigned int x = 0; x < kVertSize; x += 5)
+      EXPECT_NEAR(PlaneHeight(x, y), cache.Height(x, y), 1e-3);
+  }
+  EXPECT_FLOAT_EQ(PlaneHeight(256, 256), cache.Height(256, 256));
+
+  // Least recently used tiles were released
+  EXPECT_EQ(4u, cache.TileCount());
+  EXPECT_EQ(16u, fills);
+
+  // Cached tiles are reused
+  fills = 0;
+  cache.Height(256, 256);
+  cache.Height(200, 250);
+  EXPECT_EQ(0u, fills);
+
+  // Levels of detail
+  cache.SetLodDistance(0);
+  EXPECT_EQ(1u, cache.LodDistance());
+  cache.SetMaxLod(10);
+  EXPECT_EQ(6u, cache.MaxLod());
+  cache.SetLodDistance(2);
+  cache.SetMaxLod(2);
+  cache.SetFocus({ignition::math::Vector2d(10, 70)});
+  EXPECT_EQ(0u, cache.Lod(0, 1));
+  EXPECT_EQ(0u, cache.Lod(1, 0));
+  EXPECT_EQ(1u, cache.Lod(2, 1));
+  EXPECT_EQ(1u, cache.Lod(3, 3));
+  EXPECT_EQ(2u, cache.Lod(0, 5));
+
+  // A new level of detail loads the tile again
+  fills = 0;
+  EXPECT_FLOAT_EQ(PlaneHeight(10, 70), cache.Height(10, 70));
+  EXPECT_EQ(1u, fills);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -31,6 +31,52 @@
 using namespace gazebo;
 using namespace physics;
 
+/////////////////////////////////////////////////
+/// \brief Set a force or target of a joint, flagging the command layout if
+/// the joint had none.
+/// \param[in,out] _data Private data of the controller.
+/// \param[in,out] _values Forces or targets, by joint name.
+/// \param[in] _name Scoped name of the joint.
+/// \param[in] _value Force or target.
+static void SetCommand(JointControllerPrivate &_data,
+    std::map<std::string, double> &_values, const std::string &_name,
+    const double _value)
+{
+  auto result = _values.insert(std::make_pair(_name, _value));
+  if (result.second)
+    _data.layoutDirty = true;
+  else
+    result.first->second = _value;
+}
+
+/////////////////////////////////////////////////
+/// \brief Build the commands for forces or targets. Commands of joints
+/// that are not in the controller are left out.
+/// \param[in] _data Private data of the controller.
+/// \param[in] _values Forces or targets, by joint name.
+/// \param[in] _pids PID controllers by joint name, null for forces.
+/// \param[out] _cmds The commands, in the order of _values.
+static void BuildCommands(JointControllerPrivate &_data,
+    const std::map<std::string, double> &_values,
+    std::map<std::string, common::PID> *_pids,
+    std::vector<JointControllerCommand> &_cmds)
+{
+  _cmds.clear();
+  _cmds.reserve(_values.size());
+  for (auto const &value : _values)
+  {
+    auto joint = _data.joints.find(value.first);
+    if (joint == _data.joints.end() || !joint->second)
+      continue;
+
+    JointControllerCommand cmd;
+    cmd.joint = joint->second.get();
+    cmd.pid = _pids ? &(*_pids)[value.first] : nullptr;
+    cmd.value = &value.second;
+    _cmds.push_back(cmd);
+  }
+}
+
 /////////////////////////////////////////////////
 JointController::JointController(ModelPtr _model)
   : dataPtr(new JointControllerPrivate)
@@ -69,6 +115,7 @@ JointController::~JointController()
 /////////////////////////////////////////////////
 void JointController::AddJoint(JointPtr _joint)
 {
+  this->dataPtr->layoutDirty = true;
   this->dataPtr->joints[_joint->GetScopedName()] = _joint;
   this->dataPtr->posPids[_joint->GetScopedName()].Init(
       1, 0.1, 0.01, 1, -1, 1000, -1000);
@@ -81,6 +128,7 @@ void JointController::RemoveJoint(Joint *_joint)
 {
   if (_joint)
   {
+    this->dataPtr->layoutDirty = true;
     this->dataPtr->joints.erase(_joint->GetScopedName());
     this->dataPtr->posPids.erase(_joint->GetScopedName());
     this->dataPtr->velPids.erase(_joint->GetScopedName());
@@ -94,6 +142,7 @@ void JointController::Reset()
   this->dataPtr->positions.clear();
   this->dataPtr->velocities.clear();
   this->dataPtr->forces.clear();
+  this->dataPtr->layoutDirty = true;
 
   std::map<std::string, common::PID>::iterator iter;
 
@@ -124,47 +173,37 @@ void JointController::Update()
   // TODO: fix this when World::ResetTime is improved
   if (stepTime > 0)
   {
-    IGN_PROFILE_BEGIN("forces");
-    if (!this->dataPtr->forces.empty())
+    // The commands point into the maps, and are only rebuilt when entries
+    // are added or removed, so that the loops below look up no names.
+    if (this->dataPtr->layoutDirty)
     {
-      std::map<std::string, double>::iterator iter;
-      for (iter = this->dataPtr->forces.begin();
-          iter != this->dataPtr->forces.end(); ++iter)
-      {
-        this->dataPtr->joints[iter->first]->SetForce(0, iter->second);
-      }
+      BuildCommands(*this->dataPtr, this->dataPtr->forces, nullptr,
+          this->dataPtr->forceCmds);
+      BuildCommands(*this->dataPtr, this->dataPtr->positions,
+          &this->dataPtr->posPids, this->dataPtr->positionCmds);
+      BuildCommands(*this->dataPtr, this->dataPtr->velocities,
+          &this->dataPtr->velPids, this->dataPtr->velocityCmds);
+      this->dataPtr->layoutDirty = false;
     }
+
+    IGN_PROFILE_BEGIN("forces");
+    for (auto const &cmd : this->dataPtr->forceCmds)
+      cmd.joint->SetForce(0, *cmd.value);
     IGN_PROFILE_END();
 
     IGN_PROFILE_BEGIN("positions");
-    if (!this->dataPtr->positions.empty())
+    for (auto const &cmd : this->dataPtr->positionCmds)
     {
-      std::map<std::string, double>::iterator iter;
-
-      for (iter = this->dataPtr->positions.begin();
-           iter != this->dataPtr->positions.end(); ++iter)
-      {
-        double cmd = this->dataPtr->posPids[iter->first].Update(
-            this->dataPtr->joints[iter->first]->Position(0) -
-            iter->second, stepTime);
-        this->dataPtr->joints[iter->first]->SetForce(0, cmd);
-      }
+      cmd.joint->SetForce(0, cmd.pid->Update(
+            cmd.joint->Position(0) - *cmd.value, stepTime));
     }
     IGN_PROFILE_END();
 
     IGN_PROFILE_BEGIN("velocities");
-    if (!this->dataPtr->velocities.empty())
+    for (auto const &cmd : this->dataPtr->velocityCmds)
     {
-      std::map<std::string, double>::iterator iter;
-
-      for (iter = this->dataPtr->velocities.begin();
-           iter != this->dataPtr->velocities.end(); ++iter)
-      {
-        double cmd = this->dataPtr->velPids[iter->first].Update(
-            this->dataPtr->joints[iter->first]->GetVelocity(0) - iter->second,
-            stepTime);
-        this->dataPtr->joints[iter->first]->SetForce(0, cmd);
-      }
+      cmd.joint->SetForce(0, cmd.pid->Update(
+            cmd.joint->GetVelocity(0) - *cmd.value, stepTime));
     }
     IGN_PROFILE_END();
   }
@@ -250,6 +289,8 @@ void JointController::OnJointCommand(const ignition::msgs::JointCmd &_msg)
   {
     if (_msg.reset())
     {
+      this->dataPtr->layoutDirty = true;
+
       if (this->dataPtr->forces.find(_msg.name()) !=
           this->dataPtr->forces.end())
       {
@@ -272,7 +313,10 @@ void JointController::OnJointCommand(const ignition::msgs::JointCmd &_msg)
     }
 
     if (_msg.has_force_optional())
-      this->dataPtr->forces[_msg.name()] = _msg.force_optional().data();
+    {
+      SetCommand(*this->dataPtr, this->dataPtr->forces, _msg.name(),
+          _msg.force_optional().data());
+    }
 
     if (_msg.has_position())
     {
@@ -491,7 +535,8 @@ bool JointController::SetPositionTarget(const std::string &_jointName,
   if (this->dataPtr->posPids.find(_jointName) !=
       this->dataPtr->posPids.end())
   {
-    this->dataPtr->positions[_jointName] = _target;
+    SetCommand(*this->dataPtr, this->dataPtr->positions, _jointName,
+        _target);
     result = true;
   }
 
@@ -520,7 +565,8 @@ bool JointController::SetVelocityTarget(const std::string &_jointName,
   if (this->dataPtr->velPids.find(_jointName) !=
       this->dataPtr->velPids.end())
   {
-    this->dataPtr->velocities[_jointName] = _target;
+    SetCommand(*this->dataPtr, this->dataPtr->velocities, _jointName,
+        _target);
     result = true;
   }
 
@@ -536,7 +582,7 @@ bool JointController::SetForce(const std::string &_jointName,
   if (this->dataPtr->joints.find(_jointName) !=
       this->dataPtr->joints.end())
   {
-    this->dataPtr->forces[_jointName] = _force;
+    SetCommand(*this->dataPtr, this->dataPtr->forces, _jointName, _force);
     result = true;
   }
 
@@ -19,6 +19,7 @@
 
 #include <string>
 #include <map>
+#include <vector>
 #include <ignition/transport.hh>
 
 #include "gazebo/transport/TransportTypes.hh"
@@ -30,6 +31,20 @@ namespace gazebo
 {
   namespace physics
   {
+    /// \brief A command of the dense layout that JointController::Update
+    /// iterates, pointing into the maps of JointControllerPrivate.
+    class JointControllerCommand
+    {
+      /// \brief The joint.
+      public: Joint *joint = nullptr;
+
+      /// \brief PID controller, null for a force command.
+      public: common::PID *pid = nullptr;
+
+      /// \brief Force or target value.
+      public: const double *value = nullptr;
+    };
+
     class JointControllerPrivate
     {
       /// \brief Model to control.
@@ -68,6 +83,19 @@ namespace gazebo
 
       /// \brief Last time the controller was updated.
       public: common::Time prevUpdateTime;
+
+      /// \brief Force commands, in the order of the forces map.
+      public: std::vector<JointControllerCommand> forceCmds;
+
+      /// \brief Position commands, in the order of the positions map.
+      public: std::vector<JointControllerCommand> positionCmds;
+
+      /// \brief Velocity commands, in the order of the velocities map.
+      public: std::vector<JointControllerCommand> velocityCmds;
+
+      /// \brief True if entries were added to or removed from the maps
+      /// since the commands were built.
+      public: bool layoutDirty = true;
     };
   }
 }
@@ -16,9 +16,13 @@
 */
 
 #include <boost/algorithm/string.hpp>
+#include <atomic>
 #include <functional>
 #include <mutex>
+#include <set>
 #include <sstream>
+#include <string>
+#include <unordered_map>
 
 #include "gazebo/transport/TransportIface.hh"
 #include "gazebo/transport/TransportTypes.hh"
@@ -55,6 +59,10 @@ class gazebo::physics::LinkPrivate
   /// \brief This flag is used to trigger the enabled
   public: bool enabled = false;
 
+  /// \brief True if the physics engine put the link to sleep. Written by
+  /// the physics engine, possibly from its worker threads.
+  public: std::atomic<bool> asleep{false};
+
   /// \brief Names of all the sensors attached to the link.
   public: std::vector<std::string> sensors;
 
@@ -97,8 +105,25 @@ class gazebo::physics::LinkPrivate
   /// \brief Wind velocity.
   public: ignition::math::Vector3d windLinearVel;
 
-  /// \brief Update connection to calculate wind velocity.
-  public: event::ConnectionPtr updateConnection;
+  /// \brief True if the wind velocity is updated by the world's wind.
+  public: bool windEnabled = false;
+
+  /// \brief True if the velocities below are used by the accessors, see
+  /// Link::CacheKinematics. Cleared from other threads, e.g. by a plugin
+  /// setting the velocity.
+  public: std::atomic<bool> kinematicsCached{false};
+
+  /// \brief Cached linear velocity of the link origin in the world frame.
+  public: ignition::math::Vector3d worldLinearVel;
+
+  /// \brief Cached angular velocity in the world frame.
+  public: ignition::math::Vector3d worldAngularVel;
+
+  /// \brief Cached linear velocity of the link origin in the link frame.
+  public: ignition::math::Vector3d relativeLinearVel;
+
+  /// \brief Cached angular velocity in the link frame.
+  public: ignition::math::Vector3d relativeAngularVel;
 
   /// \brief All the attached batteries.
   public: std::vector<common::BatteryPtr> batteries;
@@ -117,6 +142,18 @@ class gazebo::physics::LinkPrivate
 
   /// \brief SDF Link DOM object
   public: const sdf::Link *linkSDFDom = nullptr;
+
+  /// \brief True if the visual elements were dropped from the SDF of the
+  /// link, see Link::CompactSDF.
+  public: bool sdfCompact = false;
+
+  /// \brief Scale of the link when its visual elements were dropped.
+  public: ignition::math::Vector3d sdfCompactScale =
+          ignition::math::Vector3d::One;
+
+  /// \brief Geometries of the dropped visual elements, by scoped visual
+  /// name. The visual messages may not hold the scaled geometries.
+  public: std::unordered_map<std::string, msgs::Geometry> sdfCompactGeoms;
 };
 
 using namespace gazebo;
@@ -344,7 +381,11 @@ void Link::Init()
 //////////////////////////////////////////////////
 void Link::Fini()
 {
-  this->dataPtr->updateConnection.reset();
+  if (this->dataPtr->windEnabled)
+  {
+    this->world->Wind().RemoveLink(this);
+    this->dataPtr->windEnabled = false;
+  }
 
   this->dataPtr->attachedModels.clear();
   this->dataPtr->parentJoints.clear();
@@ -587,9 +628,19 @@ void Link::SetLaserRetro(float _retro)
 void Link::Update(const common::UpdateInfo & /*_info*/)
 {
   IGN_PROFILE("Link::Update");
+  // Notify the changes of the sleep state raised by the last step. The
+  // cached state is used instead of GetEnabled, which races with loading.
+  const bool awake = !this->dataPtr->asleep;
+  if (awake != this->dataPtr->enabled)
+  {
+    this->dataPtr->enabled = awake;
+    this->dataPtr->enabledSignal(awake);
+  }
+
 #ifdef HAVE_OPENAL
+  // A sleeping link doesn't move its audio
   IGN_PROFILE_BEGIN("audio");
-  if (this->dataPtr->audioSink)
+  if (awake && this->dataPtr->audioSink)
   {
     this->dataPtr->audioSink->SetPose(this->WorldPose());
     this->dataPtr->audioSink->SetVelocity(this->WorldLinearVel());
@@ -597,7 +648,7 @@ void Link::Update(const common::UpdateInfo & /*_info*/)
 
   // Update all the audio sources
   for (std::vector<util::OpenALSourcePtr>::iterator iter =
-      this->dataPtr->audioSources.begin(); iter !=
+      this->dataPtr->audioSources.begin(); awake && iter !=
       this->dataPtr->audioSources.end(); ++iter)
   {
     (*iter)->SetPose(this->WorldPose());
@@ -606,13 +657,6 @@ void Link::Update(const common::UpdateInfo & /*_info*/)
   IGN_PROFILE_END();
 #endif
 
-  // FIXME: race condition on factory-based model loading!!!!!
-   /*if (this->GetEnabled() != this->dataPtr->enabled)
-   {
-     this->dataPtr->enabled = this->GetEnabled();
-     this->dataPtr->enabledSignal(this->dataPtr->enabled);
-   }*/
-
   IGN_PROFILE_BEGIN("wrenches");
   if (!this->IsStatic() && !this->dataPtr->wrenchMsgs.empty())
   {
@@ -642,6 +686,9 @@ void Link::Update(const common::UpdateInfo & /*_info*/)
 //////////////////////////////////////////////////
 void Link::UpdateWind(const common::UpdateInfo & /*_info*/)
 {
+  if (this->dataPtr->asleep)
+    return;
+
   this->dataPtr->windLinearVel = this->world->Wind().WorldLinearVel(this);
 }
 
@@ -756,12 +803,18 @@ ignition::math::Pose3d Link::WorldCoGPose() const
 //////////////////////////////////////////////////
 ignition::math::Vector3d Link::RelativeLinearVel() const
 {
+  if (this->dataPtr->kinematicsCached)
+    return this->dataPtr->relativeLinearVel;
+
   return this->WorldPose().Rot().RotateVectorReverse(this->WorldLinearVel());
 }
 
 //////////////////////////////////////////////////
 ignition::math::Vector3d Link::RelativeAngularVel() const
 {
+  if (this->dataPtr->kinematicsCached)
+    return this->dataPtr->relativeAngularVel;
+
   return this->WorldPose().Rot().RotateVectorReverse(this->WorldAngularVel());
 }
 
@@ -796,9 +849,11 @@ ignition::math::Vector3d Link::WorldAngularAccel() const
   // L: angular momentum of CoG in world frame
   // w: angular velocity in world frame
   // return I^-1 * (T - w x L)
+  const ignition::math::Vector3d angularVel =
+      this->dataPtr->kinematicsCached ?
+      this->dataPtr->worldAngularVel : this->WorldAngularVel();
   return this->WorldInertiaMatrix().Inverse() *
-    (this->WorldTorque() -
-     this->WorldAngularVel().Cross(this->WorldAngularMomentum()));
+    (this->WorldTorque() - angularVel.Cross(this->WorldAngularMomentum()));
 }
 
 //////////////////////////////////////////////////
@@ -849,9 +904,9 @@ void Link::SetWindMode(const bool _mode)
 {
   this->sdf->GetElement("enable_wind")->Set(_mode);
 
-  if (!this->WindMode() && this->dataPtr->updateConnection)
+  if (!this->WindMode() && this->dataPtr->windEnabled)
     this->SetWindEnabled(false);
-  else if (this->WindMode() && !this->dataPtr->updateConnection)
+  else if (this->WindMode() && !this->dataPtr->windEnabled)
     this->SetWindEnabled(true);
 }
 
@@ -860,17 +915,25 @@ void Link::SetWindEnabled(const bool _enable)
 {
   if (_enable)
   {
-    this->dataPtr->updateConnection = event::Events::ConnectWorldUpdateBegin(
-        std::bind(&Link::UpdateWind, this, std::placeholders::_1));
+    // The world's wind updates the velocity of all its links in one pass
+    this->world->Wind().AddLink(this);
+    this->dataPtr->windEnabled = true;
   }
   else
   {
-    this->dataPtr->updateConnection.reset();
+    this->world->Wind().RemoveLink(this);
+    this->dataPtr->windEnabled = false;
     // Make sure wind velocity is null
     this->dataPtr->windLinearVel.Set(0, 0, 0);
   }
 }
 
+//////////////////////////////////////////////////
+void Link::SetWorldWindLinearVel(const ignition::math::Vector3d &_vel)
+{
+  this->dataPtr->windLinearVel = _vel;
+}
+
 //////////////////////////////////////////////////
 const ignition::math::Vector3d Link::WorldWindLinearVel() const
 {
@@ -1168,6 +1231,8 @@ void Link::DetachAllStaticModels()
 //////////////////////////////////////////////////
 void Link::OnPoseChange()
 {
+  this->ClearKinematicsCache();
+
   ignition::math::Pose3d p;
   for (unsigned int i = 0; i < this->dataPtr->attachedModels.size(); i++)
   {
@@ -1475,6 +1540,50 @@ void Link::SetScale(const ignition::math::Vector3d &_scale)
   this->scale = _scale;
 }
 
+//////////////////////////////////////////////////
+/// \brief Scale the geometry of a visual element.
+/// \param[in] _visualElem The visual element.
+/// \param[in] _scale New scale of the link.
+/// \param[in] _oldScale Scale of the link the geometry was sized for.
+static void ScaleVisualGeomSDF(sdf::ElementPtr _visualElem,
+    const ignition::math::Vector3d &_scale,
+    const ignition::math::Vector3d &_oldScale)
+{
+  sdf::ElementPtr geomElem = _visualElem->GetElement("geometry");
+
+  if (geomElem->HasElement("box"))
+  {
+    ignition::math::Vector3d size =
+        geomElem->GetElement("box")->Get<ignition::math::Vector3d>("size");
+    geomElem->GetElement("box")->GetElement("size")->Set(
+        _scale/_oldScale*size);
+  }
+  else if (geomElem->HasElement("sphere"))
+  {
+    // update radius the same way as collision shapes
+    double radius = geomElem->GetElement("sphere")->Get<double>("radius");
+    double newRadius = _scale.Max();
+    double oldRadius = _oldScale.Max();
+    geomElem->GetElement("sphere")->GetElement("radius")->Set(
+        newRadius/oldRadius*radius);
+  }
+  else if (geomElem->HasElement("cylinder"))
+  {
+    // update radius the same way as collision shapes
+    double radius = geomElem->GetElement("cylinder")->Get<double>("radius");
+    double newRadius = std::max(_scale.X(), _scale.Y());
+    double oldRadius = std::max(_oldScale.X(), _oldScale.Y());
+
+    double length = geomElem->GetElement("cylinder")->Get<double>("length");
+    geomElem->GetElement("cylinder")->GetElement("radius")->Set(
+        newRadius/oldRadius*radius);
+    geomElem->GetElement("cylinder")->GetElement("length")->Set(
+        _scale.Z()/_oldScale.Z()*length);
+  }
+  else if (geomElem->HasElement("mesh"))
+    geomElem->GetElement("mesh")->GetElement("scale")->Set(_scale);
+}
+
 //////////////////////////////////////////////////
 void Link::UpdateVisualGeomSDF(const ignition::math::Vector3d &_scale)
 {
@@ -1484,44 +1593,83 @@ void Link::UpdateVisualGeomSDF(const ignition::math::Vector3d &_scale)
     sdf::ElementPtr visualElem = this->sdf->GetElement("visual");
     while (visualElem)
     {
-      sdf::ElementPtr geomElem = visualElem->GetElement("geometry");
+      ScaleVisualGeomSDF(visualElem, _scale, this->scale);
+      visualElem = visualElem->GetNextElement("visual");
+    }
+  }
+}
 
-      if (geomElem->HasElement("box"))
-      {
-        ignition::math::Vector3d size =
-            geomElem->GetElement("box")->Get<ignition::math::Vector3d>("size");
-        geomElem->GetElement("box")->GetElement("size")->Set(
-            _scale/this->scale*size);
-      }
-      else if (geomElem->HasElement("sphere"))
-      {
-        // update radius the same way as collision shapes
-        double radius = geomElem->GetElement("sphere")->Get<double>("radius");
-        double newRadius = _scale.Max();
-        double oldRadius = std::max(this->scale.Z(),
-            std::max(this->scale.X(), this->scale.Y()));
-        geomElem->GetElement("sphere")->GetElement("radius")->Set(
-            newRadius/oldRadius*radius);
-      }
-      else if (geomElem->HasElement("cylinder"))
-      {
-        // update radius the same way as collision shapes
-        double radius = geomElem->GetElement("cylinder")->Get<double>("radius");
-        double newRadius = std::max(_scale.X(), _scale.Y());
-        double oldRadius = std::max(this->scale.X(), this->scale.Y());
-
-        double length = geomElem->GetElement("cylinder")->Get<double>("length");
-        geomElem->GetElement("cylinder")->GetElement("radius")->Set(
-            newRadius/oldRadius*radius);
-        geomElem->GetElement("cylinder")->GetElement("length")->Set(
-            _scale.Z()/this->scale.Z()*length);
-      }
-      else if (geomElem->HasElement("mesh"))
-        geomElem->GetElement("mesh")->GetElement("scale")->Set(_scale);
+//////////////////////////////////////////////////
+void Link::CompactSDF()
+{
+  if (!this->sdf->HasElement("visual"))
+    return;
+
+  // Elements given back by UpdateParameters join the regenerated ones, so
+  // all of them are sized for the current scale.
+  this->ExpandSDF();
+
+  // Pick up the pose and geometry edits of the elements first
+  this->UpdateVisualMsg();
 
+  const std::string linkName = this->GetScopedName();
+  sdf::ElementPtr visualElem = this->sdf->GetElement("visual");
+  while (visualElem)
+  {
+    sdf::ElementPtr nextElem = visualElem->GetNextElement("visual");
+    this->dataPtr->sdfCompactGeoms[linkName + "::" +
+        visualElem->Get<std::string>("name")] =
+        msgs::GeometryFromSDF(visualElem->GetElement("geometry"));
+    this->sdf->RemoveChild(visualElem);
+    visualElem = nextElem;
+  }
+
+  this->dataPtr->sdfCompactScale = this->scale;
+  this->dataPtr->sdfCompact = true;
+}
+
+//////////////////////////////////////////////////
+void Link::ExpandSDF()
+{
+  if (!this->dataPtr->sdfCompact)
+    return;
+
+  // Elements given back by UpdateParameters are kept as they are
+  std::set<std::string> names;
+  if (this->sdf->HasElement("visual"))
+  {
+    sdf::ElementPtr visualElem = this->sdf->GetElement("visual");
+    while (visualElem)
+    {
+      names.insert(visualElem->Get<std::string>("name"));
       visualElem = visualElem->GetNextElement("visual");
     }
   }
+
+  const std::string prefix = this->GetScopedName() + "::";
+  for (auto const &iter : this->visuals)
+  {
+    msgs::Visual msg = iter.second;
+    if (msg.name().compare(0, prefix.size(), prefix) == 0)
+      msg.set_name(msg.name().substr(prefix.size()));
+    if (names.count(msg.name()) > 0)
+      continue;
+
+    auto geom = this->dataPtr->sdfCompactGeoms.find(iter.second.name());
+    if (geom != this->dataPtr->sdfCompactGeoms.end())
+      msg.mutable_geometry()->CopyFrom(geom->second);
+
+    sdf::ElementPtr visualElem = this->sdf->AddElement("visual");
+    msgs::VisualToSDF(msg, visualElem);
+    if (geom != this->dataPtr->sdfCompactGeoms.end())
+    {
+      ScaleVisualGeomSDF(visualElem, this->scale,
+          this->dataPtr->sdfCompactScale);
+    }
+  }
+
+  this->dataPtr->sdfCompactGeoms.clear();
+  this->dataPtr->sdfCompact = false;
 }
 
 //////////////////////////////////////////////////
@@ -1918,9 +2066,64 @@ void Link::RegisterIntrospectionItems()
 /////////////////////////////////////////////////
 ignition::math::Vector3d Link::WorldLinearVel() const
 {
+  if (this->dataPtr->kinematicsCached)
+    return this->dataPtr->worldLinearVel;
+
   return this->WorldLinearVel(ignition::math::Vector3d::Zero);
 }
 
+/////////////////////////////////////////////////
+bool Link::Asleep() const
+{
+  return this->dataPtr->asleep;
+}
+
+/////////////////////////////////////////////////
+void Link::Wake()
+{
+  if (!this->dataPtr->asleep)
+    return;
+
+  this->SetEnabled(true);
+  this->dataPtr->asleep = false;
+}
+
+/////////////////////////////////////////////////
+void Link::SetAsleep(const bool _asleep)
+{
+  this->dataPtr->asleep = _asleep;
+}
+
+/////////////////////////////////////////////////
+void Link::CacheKinematics()
+{
+  // The accessors query the engine while the cache is filled
+  this->dataPtr->kinematicsCached = false;
+
+  const ignition::math::Quaterniond rot = this->WorldPose().Rot();
+  this->dataPtr->worldLinearVel =
+      this->WorldLinearVel(ignition::math::Vector3d::Zero);
+  this->dataPtr->worldAngularVel = this->WorldAngularVel();
+  this->dataPtr->relativeLinearVel =
+      rot.RotateVectorReverse(this->dataPtr->worldLinearVel);
+  this->dataPtr->relativeAngularVel =
+      rot.RotateVectorReverse(this->dataPtr->worldAngularVel);
+
+  this->dataPtr->kinematicsCached = true;
+}
+
+/////////////////////////////////////////////////
+void Link::ClearKinematicsCache()
+{
+  this->dataPtr->kinematicsCached = false;
+}
+
+/////////////////////////////////////////////////
+bool Link::KinematicsCached() const
+{
+  return this->dataPtr->kinematicsCached;
+}
+
 /////////////////////////////////////////////////
 event::ConnectionPtr Link::ConnectEnabled(
     std::function<void (bool)> _subscriber)
@@ -96,6 +96,42 @@ namespace gazebo
       /// \return True if the link is enabled.
       public: virtual bool GetEnabled() const = 0;
 
+      /// \brief Check whether the physics engine put the link to sleep
+      /// because it came to rest. A sleeping link is skipped by the
+      /// per-step updates, such as the wind, until it is woken up by a
+      /// contact, a force or Wake. Only ODE puts links to sleep, when
+      /// auto disabling is allowed.
+      /// \return True if the link is asleep.
+      /// \sa ConnectEnabled
+      public: bool Asleep() const;
+
+      /// \brief Wake up the link, if it is asleep.
+      public: void Wake();
+
+      /// \brief Mark the link as asleep or awake. This is called by the
+      /// physics engine while it steps, possibly from several threads.
+      /// \param[in] _asleep True if the link fell asleep.
+      public: void SetAsleep(const bool _asleep);
+
+      /// \brief Store the velocities of the link after a physics step, so
+      /// that WorldLinearVel(), RelativeLinearVel, RelativeAngularVel and
+      /// WorldAngularAccel don't query the physics engine and transform
+      /// the velocities again on every call. The stored velocities are used
+      /// until ClearKinematicsCache is called. The world calls this for
+      /// the awake links after each physics step.
+      /// \sa KinematicsCached
+      public: void CacheKinematics();
+
+      /// \brief Drop the velocities stored by CacheKinematics, so that they
+      /// are queried from the physics engine again. This is called when
+      /// the pose or the velocity of the link is set, and by the world for
+      /// the links that it doesn't cache, such as the sleeping links.
+      public: void ClearKinematicsCache();
+
+      /// \brief Check whether the velocities of the link are cached.
+      /// \return True if the velocities stored by CacheKinematics are used.
+      public: bool KinematicsCached() const;
+
       /// \brief Set whether this entity has been selected by the user
       /// through the gui
       /// \param[in] _set True to set the link as selected.
@@ -377,7 +413,13 @@ namespace gazebo
       public: double GetAngularDamping() const;
 
       /// \TODO Implement this function.
-      /// \brief Set whether this body is in the kinematic state.
+      /// \brief Set whether this body is in the kinematic state. A
+      /// kinematic link is moved by the velocity or pose it is given and
+      /// ignores gravity, forces and contacts, while it pushes dynamic links
+      /// as if its mass were infinite. ODE keeps a kinematic link that no
+      /// joint or contact attaches to a dynamic link out of the islands and
+      /// the solver. Bullet takes the pose of a kinematic link in every step
+      /// instead of its velocity.
       /// \param[in] _kinematic True to make the link kinematic only.
       public: virtual void SetKinematic(const bool &_kinematic);
 
@@ -407,9 +449,12 @@ namespace gazebo
       /// bounds.
       public: std::string GetSensorName(unsigned int _index) const;
 
-      /// \brief Connect to the add entity signal
+      /// \brief Connect to the signal raised when the link falls asleep,
+      /// with false, or wakes up, with true. The signal is raised at the
+      /// beginning of the step that follows the change.
       /// \param[in] _subscriber Subsciber callback function.
       /// \return Pointer to the connection, which must be kept in scope.
+      /// \sa Asleep
       public: event::ConnectionPtr ConnectEnabled(
           std::function<void (bool)> _subscriber);
 
@@ -561,8 +606,13 @@ namespace gazebo
       /// \param[in] _enable True to enable the wind.
       public: void SetWindEnabled(const bool _enable);
 
+      /// \brief Set this link's wind velocity in the world coordinate
+      /// frame. Called by Wind::Update for the links with wind enabled.
+      /// \param[in] _vel The wind velocity.
+      public: void SetWorldWindLinearVel(const ignition::math::Vector3d &_vel);
+
       /// \brief Returns this link's wind velocity in the world coordinate
-      /// frame.
+      /// frame. The velocity isn't updated while the link is asleep.
       /// \return this link's wind velocity.
       public: const ignition::math::Vector3d WorldWindLinearVel() const;
 
@@ -624,6 +674,16 @@ namespace gazebo
       /// \return a map of unique ID to visual message
       public: const Visuals_M &Visuals() const;
 
+      /// \brief Drop the visual elements from the SDF of the link. The
+      /// visuals are then kept only as messages, which is much smaller
+      /// than the element trees, until ExpandSDF regenerates the elements.
+      /// \sa World::SetCompactSDFEnabled
+      public: void CompactSDF();
+
+      /// \brief Regenerate the visual elements dropped by CompactSDF from
+      /// the visual messages, with the current poses and scale.
+      public: void ExpandSDF();
+
       /// \brief Publish timestamped link data such as velocity.
       private: void PublishData();
 
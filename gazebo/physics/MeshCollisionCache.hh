@@ -0,0 +1,141 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_MESHCOLLISIONCACHE_HH_
+#define GAZEBO_PHYSICS_MESHCOLLISIONCACHE_HH_
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+
+#include <ignition/math/Vector3.hh>
+
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \addtogroup gazebo_physics
+    /// \{
+
+    /// \class MeshCollisionCache MeshCollisionCache.hh physics/physics.hh
+    /// \brief Shares the collision data that a physics engine builds from a
+    /// triangle mesh between all the collisions that use the same mesh.
+    ///
+    /// Entries are keyed by the content of the mesh and its scale, see
+    /// Key, so that copies of a model share the data no matter where the
+    /// mesh was loaded from. The cache only holds weak references: the data
+    /// is released when the last collision that uses it is destroyed.
+    template<typename T>
+    class MeshCollisionCache
+    {
+      /// \brief Get the data of a mesh, building it if it isn't cached.
+      /// \param[in] _key Key of the mesh, see Key.
+      /// \param[in] _create Function that builds the data. It is only
+      /// called on a cache miss. A null result is not cached.
+      /// \return The shared data.
+      public: std::shared_ptr<T> Get(const std::string &_key,
+                  const std::function<std::shared_ptr<T>()> &_create)
+              {
+                std::lock_guard<std::mutex> lock(this->mutex);
+                auto iter = this->entries.find(_key);
+                if (iter != this->entries.end())
+                {
+                  std::shared_ptr<T> data = iter->second.lock();
+                  if (data)
+                    return data;
+                }
+
+                // Drop the entries of meshes that are no longer used
+                for (auto it = this->entries.begin();
+                     it != this->entries.end();)
+                {
+                  if (it->second.expired())
+                    it = this->entries.erase(it);
+                  else
+                    ++it;
+                }
+
+                std::shared_ptr<T> data = _create();
+                if (data)
+                  this->entries[_key] = data;
+                return data;
+              }
+
+      /// \brief Get the number of meshes whose data is in use.
+      /// \return Number of cached meshes.
+      public: size_t Size() const
+              {
+                std::lock_guard<std::mutex> lock(this->mutex);
+                size_t size = 0;
+                for (auto const &entry : this->entries)
+                {
+                  if (!entry.second.expired())
+                    ++size;
+                }
+                return size;
+              }
+
+      /// \brief Compute the key of a mesh from its vertex and index
+      /// arrays, as returned by common::Mesh::FillArrays, and its scale.
+      /// \param[in] _vertices Vertex array, three values per vertex.
+      /// \param[in] _numVertices Number of vertices.
+      /// \param[in] _indices Index array.
+      /// \param[in] _numIndices Number of indices.
+      /// \param[in] _scale Scale applied to the vertices.
+      /// \return Key of the mesh.
+      public: static std::string Key(const float *_vertices,
+                  const unsigned int _numVertices, const int *_indices,
+                  const unsigned int _numIndices,
+                  const ignition::math::Vector3d &_scale)
+              {
+                // 64 bit FNV-1a hash of the arrays
+                uint64_t hash = 14695981039346656037ULL;
+                auto add = [&hash](const void *_data, const size_t _size)
+                {
+                  auto bytes = static_cast<const unsigned char *>(_data);
+                  for (size_t i = 0; i < _size; ++i)
+                  {
+                    hash ^= bytes[i];
+                    hash *= 1099511628211ULL;
+                  }
+                };
+                if (_vertices)
+                  add(_vertices, 3 * _numVertices * sizeof(_vertices[0]));
+                if (_indices)
+                  add(_indices, _numIndices * sizeof(_indices[0]));
+
+                std::ostringstream stream;
+                stream.precision(17);
+                stream << std::hex << hash << std::dec
+                       << ':' << _numVertices << ':' << _numIndices
+                       << ':' << _scale;
+                return stream.str();
+              }
+
+      /// \brief Mutex that protects the entries.
+      private: mutable std::mutex mutex;
+
+      /// \brief Cached data, by key.
+      private: std::map<std::string, std::weak_ptr<T>> entries;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+
+#include "gazebo/physics/MeshCollisionCache.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class MeshCollisionCacheTest : public gazebo::testing::AutoLogFixture { };
+
+typedef physics::MeshCollisionCache<int> IntCache;
+
+//////////////////////////////////////////////////
+TEST_F(MeshCollisionCacheTest, Key)
+{
+  float vertices[] = {0, 0, 0, 1, 0, 0, 0, 1, 0};
+  int indices[] = {0, 1, 2};
+  const ignition::math::Vector3d scale(1, 2, 3);
+
+  const std::string key = IntCache::Key(vertices, 3, indices, 3, scale);
+  EXPECT_EQ(key, IntCache::Key(vertices, 3, indices, 3, scale));
+
+  // Scale, vertices and indices are all part of the key
+  EXPECT_NE(key, IntCache::Key(vertices, 3, indices, 3,
+        ignition::math::Vector3d::One));
+
+  float moved[] = {0, 0, 0, 1, 0, 0, 0, 2, 0};
+  EXPECT_NE(key, IntCache::Key(moved, 3, indices, 3, scale));
+
+  int flipped[] = {0, 2, 1};
+  EXPECT_NE(key, IntCache::Key(vertices, 3, flipped, 3, scale));
+}
+
+//////////////////////////////////////////////////
+TEST_F(MeshCollisionCacheTest, Get)
+{
+  IntCache cache;
+  int created = 0;
+  auto create = [&created]()
+  {
+    ++created;
+    return std::make_shared<int>(created);
+  };
+
+  auto a = cache.Get("a", create);
+  auto a2 = cache.Get("a", create);
+  ASSERT_NE(nullptr, a);
+  EXPECT_EQ(a, a2);
+  EXPECT_EQ(1, created);
+  EXPECT_EQ(1u, cache.Size());
+
+  auto b = cache.Get("b", create);
+  EXPECT_NE(a, b);
+  EXPECT_EQ(2, created);
+  EXPECT_EQ(2u, cache.Size());
+
+  // Data is released with its last user and built again on demand
+  a.reset();
+  a2.reset();
+  EXPECT_EQ(1u, cache.Size());
+  a = cache.Get("a", create);
+  EXPECT_EQ(3, *a);
+
+  // Null data is not cached
+  auto none = cache.Get("none", []() { return std::shared_ptr<int>(); });
+  EXPECT_EQ(nullptr, none);
+  EXPECT_EQ(2u, cache.Size());
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -43,6 +43,17 @@ MeshShape::~MeshShape()
 {
 }
 
+//////////////////////////////////////////////////
+void MeshShape::Load(sdf::ElementPtr _sdf)
+{
+  Shape::Load(_sdf);
+
+  const std::string filename = common::find_file(common::asFullPath(
+      this->sdf->Get<std::string>("uri"), this->sdf->FilePath()));
+  if (!filename.empty() && filename != "__default__")
+    common::MeshManager::Instance()->LoadAsync(filename);
+}
+
 //////////////////////////////////////////////////
 void MeshShape::Init()
 {
@@ -45,6 +45,11 @@ namespace gazebo
       /// \brief Update the tri mesh.
       public: virtual void Update() {}
 
+      /// \brief Load the shape, and start loading its mesh on a worker
+      /// thread, so that meshes load in parallel until Init needs them.
+      /// \param[in] _sdf SDF values of the mesh.
+      public: virtual void Load(sdf::ElementPtr _sdf);
+
       /// \copydoc Shape::Init()
       public: virtual void Init();
 
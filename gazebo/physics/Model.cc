@@ -33,6 +33,7 @@
 #include "gazebo/common/Events.hh"
 #include "gazebo/common/Exception.hh"
 #include "gazebo/common/Console.hh"
+#include "gazebo/common/CostCounter.hh"
 #include "gazebo/common/CommonIface.hh"
 #include "gazebo/common/CommonTypes.hh"
 #include "gazebo/common/SdfFrameSemantics.hh"
@@ -379,8 +380,6 @@ void Model::Update()
     iter = this->jointAnimations.begin();
     while (iter != this->jointAnimations.end())
     {
-      iter->second->GetInterpolatedKeyFrame(kf);
-
       iter->second->AddTime(
           (this->world->SimTime() - this->prevAnimationTime).Double());
 
@@ -597,6 +596,26 @@ const sdf::Model *Model::GetSDFDom() const
   return this->modelSDFDom;
 }
 
+//////////////////////////////////////////////////
+void Model::CompactSDF()
+{
+  for (auto const &link : this->links)
+    link->CompactSDF();
+
+  for (auto const &model : this->models)
+    model->CompactSDF();
+}
+
+//////////////////////////////////////////////////
+void Model::ExpandSDF()
+{
+  for (auto const &link : this->links)
+    link->ExpandSDF();
+
+  for (auto const &model : this->models)
+    model->ExpandSDF();
+}
+
 //////////////////////////////////////////////////
 const sdf::ElementPtr Model::UnscaledSDF()
 {
@@ -1151,6 +1170,20 @@ void Model::LoadPlugin(sdf::ElementPtr _sdf)
 
     ModelPtr myself = boost::static_pointer_cast<Model>(shared_from_this());
 
+    // The time spent in the event callbacks connected by the plugin is
+    // reported in the statistics breakdown, per plugin and per model.
+    if (!this->pluginCost)
+    {
+      this->pluginCost = common::CostCounter::Create("model_plugin",
+          this->GetScopedName());
+    }
+    common::CostCounterPtr cost = common::CostCounter::Create("plugin",
+          this->GetScopedName() + "::" + pluginName);
+    cost->SetParent(this->pluginCost);
+    common::CostOwner owner(cost);
+
+    plugin->LoadUpdateRate(_sdf);
+
     try
     {
       plugin->Load(myself, _sdf);
@@ -1457,6 +1490,37 @@ void Model::SetEnabled(bool _enabled)
   }
 }
 
+/////////////////////////////////////////////////
+bool Model::Asleep() const
+{
+  bool hasLinks = false;
+  for (auto const &link : this->links)
+  {
+    if (!link->Asleep())
+      return false;
+    hasLinks = true;
+  }
+
+  for (auto const &model : this->models)
+  {
+    if (!model->Asleep())
+      return false;
+    hasLinks = true;
+  }
+
+  return hasLinks;
+}
+
+/////////////////////////////////////////////////
+void Model::Wake()
+{
+  for (auto const &link : this->links)
+    link->Wake();
+
+  for (auto const &model : this->models)
+    model->Wake();
+}
+
 /////////////////////////////////////////////////
 void Model::SetLinkWorldPose(const ignition::math::Pose3d &_pose,
     std::string _linkName)
@@ -1869,3 +1933,41 @@ std::optional<sdf::SemanticPose> Model::SDFSemanticPose() const
   }
   return std::nullopt;
 }
+
+//////////////////////////////////////////////////
+void Model::AddContacts(const unsigned int _points, const unsigned int _rows)
+{
+  this->contactCount.fetch_add(_points, std::memory_order_relaxed);
+  this->contactRowCount.fetch_add(_rows, std::memory_order_relaxed);
+}
+
+//////////////////////////////////////////////////
+uint64_t Model::ContactCount() const
+{
+  return this->contactCount.load(std::memory_order_relaxed);
+}
+
+//////////////////////////////////////////////////
+uint64_t Model::ContactRowCount() const
+{
+  return this->contactRowCount.load(std::memory_order_relaxed);
+}
+
+//////////////////////////////////////////////////
+unsigned int Model::JointRowCount() const
+{
+  unsigned int rows = 0;
+  for (auto const &joint : this->joints)
+  {
+    const unsigned int dof = joint->DOF();
+    if (dof < 6)
+      rows += 6 - dof;
+  }
+  return rows;
+}
+
+//////////////////////////////////////////////////
+common::CostCounterPtr Model::PluginCost() const
+{
+  return this->pluginCost;
+}
@@ -17,6 +17,7 @@
 #ifndef GAZEBO_PHYSICS_MODEL_HH_
 #define GAZEBO_PHYSICS_MODEL_HH_
 
+#include <atomic>
 #include <string>
 #include <map>
 #include <mutex>
@@ -25,6 +26,7 @@
 #include <boost/thread/recursive_mutex.hpp>
 
 #include "gazebo/common/CommonTypes.hh"
+#include "gazebo/common/CostCounter.hh"
 #include "gazebo/physics/PhysicsTypes.hh"
 #include "gazebo/physics/ModelState.hh"
 #include "gazebo/physics/Entity.hh"
@@ -100,6 +102,15 @@ namespace gazebo
       /// \return The SDF element.
       public: virtual const sdf::ElementPtr UnscaledSDF();
 
+      /// \brief Drop the visual elements from the SDF of the links of the
+      /// model and of its nested models.
+      /// \sa Link::CompactSDF
+      public: void CompactSDF();
+
+      /// \brief Regenerate the visual elements dropped by CompactSDF.
+      /// \sa Link::ExpandSDF
+      public: void ExpandSDF();
+
       /// \brief Remove a child.
       /// \param[in] _child Remove a child entity.
       public: virtual void RemoveChild(EntityPtr _child);
@@ -317,6 +328,16 @@ namespace gazebo
       /// \param[in] _enabled True to enable all the links.
       public: void SetEnabled(bool _enabled);
 
+      /// \brief Check whether all the links of the model, including the
+      /// links of nested models, are asleep.
+      /// \return True if the model is asleep. False if it has no links.
+      /// \sa Link::Asleep
+      public: bool Asleep() const;
+
+      /// \brief Wake up all the links of the model, including the links of
+      /// nested models.
+      public: void Wake();
+
       /// \brief Set the Pose of the entire Model by specifying
       /// desired Pose of a Link within the Model.  Doing so, keeps
       /// the configuration of the Model unchanged, i.e. all Joint angles
@@ -485,6 +506,34 @@ namespace gazebo
       // Documentation inherited.
       public: std::optional<sdf::SemanticPose> SDFSemanticPose() const override;
 
+      /// \brief Charge contacts of the collisions of this model, called by
+      /// the physics engine for the cost breakdown of the world statistics.
+      /// \param[in] _points Number of contact points.
+      /// \param[in] _rows Estimated number of constraint rows given to the
+      /// solver for the points.
+      public: void AddContacts(const unsigned int _points,
+                  const unsigned int _rows);
+
+      /// \brief Get the number of contact points charged to this model.
+      /// \return Contact points since the model was loaded.
+      public: uint64_t ContactCount() const;
+
+      /// \brief Get the number of contact constraint rows charged to this
+      /// model.
+      /// \return Constraint rows since the model was loaded.
+      public: uint64_t ContactRowCount() const;
+
+      /// \brief Get an estimate of the number of constraint rows that the
+      /// joints of this model give to the solver in each step, six minus
+      /// the degrees of freedom of each joint, without the nested models.
+      /// \return Constraint rows per step.
+      public: unsigned int JointRowCount() const;
+
+      /// \brief Get the counter of the time spent in the event callbacks
+      /// of the plugins of this model, without the nested models.
+      /// \return The counter, null before a plugin was loaded.
+      public: common::CostCounterPtr PluginCost() const;
+
       /// \brief Callback when the pose of the model has been changed.
       protected: virtual void OnPoseChange() override;
 
@@ -567,6 +616,16 @@ namespace gazebo
 
       /// \brief SDF Model DOM object
       private: const sdf::Model *modelSDFDom = nullptr;
+
+      /// \brief Counter of the time spent by the plugins of this model,
+      /// parent of the counter of each plugin.
+      private: common::CostCounterPtr pluginCost;
+
+      /// \brief Contact points charged to this model.
+      private: std::atomic<uint64_t> contactCount{0};
+
+      /// \brief Contact constraint rows charged to this model.
+      private: std::atomic<uint64_t> contactRowCount{0};
     };
     /// \}
   }
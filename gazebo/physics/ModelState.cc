@@ -39,7 +39,7 @@ ModelState::ModelState(const ModelPtr _model, const common::Time &_realTime,
   this->scale = _model->Scale();
 
   // Copy all the links
-  const Link_V links = _model->GetLinks();
+  const Link_V &links = _model->GetLinks();
   for (Link_V::const_iterator iter = links.begin(); iter != links.end(); ++iter)
   {
     this->linkStates.insert(std::make_pair((*iter)->GetName(),
@@ -72,7 +72,7 @@ ModelState::ModelState(const ModelPtr _model)
   this->scale = _model->Scale();
 
   // Copy all the links
-  const Link_V links = _model->GetLinks();
+  const Link_V &links = _model->GetLinks();
   for (Link_V::const_iterator iter = links.begin(); iter != links.end(); ++iter)
   {
     this->linkStates.insert(std::make_pair((*iter)->GetName(),
@@ -122,7 +122,7 @@ void ModelState::Load(const ModelPtr _model, const common::Time &_realTime,
 
   // Load all the links
   this->linkStates.clear();
-  const Link_V links = _model->GetLinks();
+  const Link_V &links = _model->GetLinks();
   for (Link_V::const_iterator iter = links.begin(); iter != links.end(); ++iter)
   {
     this->linkStates[(*iter)->GetName()].Load(*iter, _realTime, _simTime,
@@ -150,6 +150,24 @@ double MultiRayShape::GetRetro(unsigned int _index)
   return this->rays[_index]->GetRetro();
 }
 
+//////////////////////////////////////////////////
+void MultiRayShape::Ranges(std::vector<double> &_ranges) const
+{
+  _ranges.resize(this->rays.size());
+
+  // Add min range, because we measured from min range.
+  for (size_t i = 0; i < this->rays.size(); ++i)
+    _ranges[i] = this->minRange + this->rays[i]->GetLength();
+}
+
+//////////////////////////////////////////////////
+void MultiRayShape::Retros(std::vector<double> &_retros) const
+{
+  _retros.resize(this->rays.size());
+  for (size_t i = 0; i < this->rays.size(); ++i)
+    _retros[i] = this->rays[i]->GetRetro();
+}
+
 //////////////////////////////////////////////////
 int MultiRayShape::GetFiducial(unsigned int _index)
 {
@@ -75,6 +75,17 @@ namespace gazebo
       /// \return Retro value for the ray.
       public: double GetRetro(unsigned int _index);
 
+      /// \brief Get the detected ranges of all the rays, cheaper than
+      /// calling GetRange for each ray.
+      /// \param[out] _ranges Range of each ray, resized to the number of
+      /// rays.
+      public: void Ranges(std::vector<double> &_ranges) const;
+
+      /// \brief Get the detected retro (intensity) values of all the rays.
+      /// \param[out] _retros Retro value of each ray, resized to the number
+      /// of rays.
+      public: void Retros(std::vector<double> &_retros) const;
+
       /// \brief Get detected fiducial value for a ray.
       /// \param[in] _index Index of the ray.
       /// \return Fiducial value for the ray.
@@ -15,6 +15,12 @@
  *
 */
 
+#include <algorithm>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include <boost/lexical_cast.hpp>
 
 #include <sdf/sdf.hh>
@@ -27,9 +33,11 @@
 #include "gazebo/transport/TransportIface.hh"
 #include "gazebo/transport/Node.hh"
 
+#include "gazebo/physics/Collision.hh"
 #include "gazebo/physics/ContactManager.hh"
 #include "gazebo/physics/Link.hh"
 #include "gazebo/physics/Model.hh"
+#include "gazebo/physics/RayShape.hh"
 #include "gazebo/physics/World.hh"
 #include "gazebo/physics/PhysicsEngine.hh"
 #include "gazebo/physics/PresetManager.hh"
@@ -37,6 +45,9 @@
 using namespace gazebo;
 using namespace physics;
 
+/// \brief Prefix of custom SDF elements that hold physics parameters.
+static const std::string kCustomPrefix = "ignition:";
+
 //////////////////////////////////////////////////
 PhysicsEngine::PhysicsEngine(WorldPtr _world)
   : world(_world)
@@ -192,6 +203,41 @@ void PhysicsEngine::SetMaxStepSize(double _stepSize)
   this->maxStepSize = _stepSize;
 }
 
+//////////////////////////////////////////////////
+void PhysicsEngine::CastRays(const std::vector<RayQuery> &_rays,
+    std::vector<RayQueryResult> &_results)
+{
+  _results.assign(_rays.size(), RayQueryResult());
+  if (_rays.empty())
+    return;
+
+  RayShapePtr ray = boost::dynamic_pointer_cast<RayShape>(
+      this->CreateShape("ray", CollisionPtr()));
+  if (!ray)
+  {
+    gzerr << "Unable to create a ray shape\n";
+    return;
+  }
+
+  for (size_t i = 0; i < _rays.size(); ++i)
+  {
+    double dist;
+    std::string entityName;
+    ray->SetPoints(_rays[i].start, _rays[i].end);
+    ray->GetIntersection(dist, entityName);
+    if (entityName.empty())
+      continue;
+
+    _results[i].distance = dist;
+    _results[i].collision = entityName;
+
+    CollisionPtr collision = boost::dynamic_pointer_cast<Collision>(
+        this->world->EntityByName(entityName));
+    if (collision)
+      _results[i].retro = collision->GetLaserRetro();
+  }
+}
+
 //////////////////////////////////////////////////
 void PhysicsEngine::SetAutoDisableFlag(bool /*_autoDisable*/)
 {
@@ -211,6 +257,9 @@ void PhysicsEngine::OnRequest(ConstRequestPtr &/*_msg*/)
 void PhysicsEngine::OnPhysicsMsg(ConstPhysicsPtr &_msg)
 {
   this->world->PresetMgr()->CurrentProfile(_msg->profile_name());
+
+  if (_msg->has_model_update_threads())
+    this->world->SetModelUpdateThreads(_msg->model_update_threads());
 }
 
 //////////////////////////////////////////////////
@@ -243,6 +292,27 @@ bool PhysicsEngine::SetParam(const std::string &_key,
       this->world->SetMagneticField(
           any_cast<ignition::math::Vector3d>(copy));
     }
+    else if (_key == "model_update_threads")
+    {
+      int threads = param_cast<int>(_value);
+      this->world->SetModelUpdateThreads(
+          static_cast<unsigned int>(std::max(threads, 0)));
+    }
+    else if (_key == "contact_publish_decimation")
+    {
+      int decimation = param_cast<int>(_value);
+      if (decimation < 1)
+      {
+        gzerr << "contact_publish_decimation must be positive\n";
+        return false;
+      }
+      this->contactManager->SetPublishDecimation(decimation);
+    }
+    else if (_key.compare(0, kCustomPrefix.size(), kCustomPrefix) == 0)
+    {
+      // Custom SDF element, look up the parameter without the prefix.
+      return this->SetParam(_key.substr(kCustomPrefix.size()), _value);
+    }
     else
     {
       gzwarn << "SetParam failed for [" << _key << "] in physics engine "
@@ -295,6 +365,12 @@ bool PhysicsEngine::GetParam(const std::string &_key,
     _value = this->world->Gravity();
   else if (_key == "magnetic_field")
     _value = this->world->MagneticField();
+  else if (_key == "model_update_threads")
+    _value = static_cast<int>(this->world->ModelUpdateThreads());
+  else if (_key == "contact_publish_decimation")
+    _value = static_cast<int>(this->contactManager->PublishDecimation());
+  else if (_key.compare(0, kCustomPrefix.size(), kCustomPrefix) == 0)
+    return this->GetParam(_key.substr(kCustomPrefix.size()), _value);
   else
   {
     gzwarn << "GetParam failed for [" << _key << "] in physics engine "
@@ -305,6 +381,57 @@ bool PhysicsEngine::GetParam(const std::string &_key,
   return true;
 }
 
+//////////////////////////////////////////////////
+bool PhysicsEngine::SetParams(const std::map<std::string, boost::any> &_params)
+{
+  // Check every key, and keep the current values to undo a partial change.
+  std::vector<std::pair<std::string, boost::any>> previous;
+  previous.reserve(_params.size());
+  for (auto const &param : _params)
+  {
+    boost::any value;
+    if (!this->GetParam(param.first, value))
+      return false;
+    previous.emplace_back(param.first, value);
+  }
+
+  boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
+  size_t count = 0;
+  for (auto const &param : _params)
+  {
+    if (!this->SetParam(param.first, param.second))
+      break;
+    ++count;
+  }
+
+  if (count == _params.size())
+    return true;
+
+  gzerr << "Unable to set parameter [" << previous[count].first
+        << "], restoring the previous parameters\n";
+  for (size_t i = 0; i < count; ++i)
+    this->SetParam(previous[i].first, previous[i].second);
+  return false;
+}
+
+//////////////////////////////////////////////////
+void PhysicsEngine::ResolveParam(const std::string &_key,
+    PhysicsParamSetter &_setter, PhysicsParamGetter &_getter)
+{
+  std::string key = _key;
+  if (key.compare(0, kCustomPrefix.size(), kCustomPrefix) == 0)
+    key = key.substr(kCustomPrefix.size());
+
+  _setter = [this, key](const boost::any &_value)
+  {
+    return this->SetParam(key, _value);
+  };
+  _getter = [this, key](boost::any &_value)
+  {
+    return this->GetParam(key, _value);
+  };
+}
+
 //////////////////////////////////////////////////
 ContactManager *PhysicsEngine::GetContactManager() const
 {
@@ -19,13 +19,22 @@
 
 #include <boost/thread/recursive_mutex.hpp>
 #include <boost/any.hpp>
+#include <boost/lexical_cast.hpp>
+#include <any>
+#include <map>
 #include <string>
+#include <type_traits>
+#include <typeinfo>
+#include <vector>
 #include <ignition/transport/Node.hh>
 
 #include "gazebo/transport/TransportTypes.hh"
 #include "gazebo/msgs/msgs.hh"
 
+#include "gazebo/common/Console.hh"
+#include "gazebo/physics/PhysicsParam.hh"
 #include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/physics/RayQuery.hh"
 #include "gazebo/util/system.hh"
 
 namespace gazebo
@@ -61,6 +70,23 @@ namespace gazebo
       /// \brief Rest the physics engine.
       public: virtual void Reset() {}
 
+      /// \brief Save the engine state that is not reachable through the
+      /// world entities, such as solver warm start data. Called by
+      /// World::Snapshot after the entity state has been captured.
+      /// \param[in] _handle Handle of the world snapshot.
+      public: virtual void SaveSnapshot(const uint32_t /*_handle*/) {}
+
+      /// \brief Restore the engine state saved with SaveSnapshot. Called by
+      /// World::Restore after the entity state has been restored.
+      /// \param[in] _handle Handle of the world snapshot.
+      /// \return False if no engine state was saved for the handle.
+      public: virtual bool RestoreSnapshot(const uint32_t /*_handle*/)
+              {return true;}
+
+      /// \brief Release the engine state saved with SaveSnapshot.
+      /// \param[in] _handle Handle of the world snapshot.
+      public: virtual void ReleaseSnapshot(const uint32_t /*_handle*/) {}
+
       /// \brief Init the engine for threads.
       public: virtual void InitForThread() = 0;
 
@@ -163,6 +189,14 @@ namespace gazebo
       public: virtual JointPtr CreateJoint(const std::string &_type,
                                            ModelPtr _parent = ModelPtr()) = 0;
 
+      /// \brief Find the closest hit of each ray of a batch against the
+      /// collisions of the world. Rays do not hit other rays. The default
+      /// implementation tests the rays one by one with a RayShape.
+      /// \param[in] _rays Ray segments, in the world frame.
+      /// \param[out] _results Closest hit of each ray, in the same order.
+      public: virtual void CastRays(const std::vector<RayQuery> &_rays,
+                  std::vector<RayQueryResult> &_results);
+
 
       /// \brief Set the gravity vector.
       /// \param[in] _gravity New gravity vector.
@@ -215,6 +249,16 @@ namespace gazebo
       ///          (defined but not used in ode).
       ///       -# "max_step_size" (double) - maximum physics step size when
       ///          physics update step must return.
+      ///       -# "model_update_threads" (int) - number of threads used to
+      ///          update models, see World::SetModelUpdateThreads.
+      ///       -# "contact_publish_decimation" (int) - publish contacts to
+      ///          ~/physics/contacts on one of every n steps, see
+      ///          ContactManager::SetPublishDecimation.
+      ///
+      /// Parameters that are not part of the SDFormat specification can be
+      /// set from the physics SDF with custom elements that use the
+      /// "ignition:" prefix, e.g. <ignition:model_update_threads>. The prefix
+      /// is removed before the parameter is looked up.
       ///
       /// \param[in] _value The value to set to
       /// \return true if SetParam is successful, false if operation fails.
@@ -235,9 +279,57 @@ namespace gazebo
       public: virtual bool GetParam(const std::string &_key,
                   boost::any &_value) const;
 
+      /// \brief Resolve a parameter once and get a typed handle to it, for
+      /// callers that set or get the same parameter often.
+      /// \param[in] _key Key of the parameter, see SetParam.
+      /// \return Handle to the parameter, invalid if the key is unknown or
+      /// if the parameter is not of type T.
+      /// \sa PhysicsParam
+      public: template<typename T>
+              PhysicsParam<T> ParamHandle(const std::string &_key)
+              {
+                boost::any value;
+                if (!this->GetParam(_key, value))
+                  return PhysicsParam<T>();
+
+                if (value.type() != typeid(T))
+                {
+                  gzerr << "Parameter [" << _key << "] of physics engine "
+                        << this->GetType() << " is of type ["
+                        << value.type().name() << "]\n";
+                  return PhysicsParam<T>();
+                }
+
+                PhysicsParamSetter setter;
+                PhysicsParamGetter getter;
+                this->ResolveParam(_key, setter, getter);
+                return PhysicsParam<T>(_key, setter, getter);
+              }
+
+      /// \brief Set several parameters as a whole. All the keys are checked
+      /// first, then the values are set under the physics update mutex so
+      /// that no physics update sees part of them. If a value can't be set,
+      /// the parameters that were already set get their previous values
+      /// back.
+      /// \param[in] _params Values of the parameters, by key.
+      /// \return True if all the parameters were set.
+      /// \sa SetParam
+      public: bool SetParams(const std::map<std::string, boost::any> &_params);
+
       /// \brief Debug print out of the physic engine state.
       public: virtual void DebugPrint() const = 0;
 
+      /// \brief Resolve the functions that set and get a parameter, used by
+      /// ParamHandle. The default goes through SetParam and GetParam with
+      /// the key resolved once. Engines override it for parameters that
+      /// are changed often, to skip the string dispatch.
+      /// \param[in] _key Key of the parameter, known to GetParam.
+      /// \param[out] _setter Function that sets the parameter.
+      /// \param[out] _getter Function that gets the parameter.
+      protected: virtual void ResolveParam(const std::string &_key,
+                     PhysicsParamSetter &_setter,
+                     PhysicsParamGetter &_getter);
+
       /// \brief Get a pointer to the world.
       /// \return Pointer to the world.
       public: WorldPtr World() const;
@@ -280,6 +372,38 @@ namespace gazebo
         }
       }
 
+      /// \brief Helper function for performing casts of parameter values
+      /// that may come from custom SDF elements, e.g.
+      /// <ignition:narrow_phase_threads>. The values of such elements are
+      /// stored as strings, which are converted with boost::lexical_cast.
+      /// Boolean strings may also be "true" or "false", as in SDF.
+      /// Any other value is cast with PhysicsEngine::any_cast.
+      /// \param[in] _value Value to cast to type T.
+      /// \return Value cast to type T.
+      public:
+      template <typename T>
+      static T param_cast(const boost::any &_value)
+      {
+        const std::string *str = boost::any_cast<std::string>(&_value);
+        const std::any *value = boost::any_cast<std::any>(&_value);
+        if (!str && value)
+          str = std::any_cast<std::string>(value);
+
+        if (str)
+        {
+          if constexpr (std::is_same<T, bool>::value)
+          {
+            if (*str == "true")
+              return true;
+            if (*str == "false")
+              return false;
+          }
+          return boost::lexical_cast<T>(*str);
+        }
+
+        return any_cast<T>(_value);
+      }
+
       /// \brief virtual callback for gztopic "~/request".
       /// \param[in] _msg Request message.
       protected: virtual void OnRequest(ConstRequestPtr &_msg);
@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_PHYSICSPARAM_HH_
+#define GAZEBO_PHYSICS_PHYSICSPARAM_HH_
+
+#include <functional>
+#include <string>
+#include <utility>
+
+#include <boost/any.hpp>
+
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \addtogroup gazebo_physics
+    /// \{
+
+    /// \def PhysicsParamSetter
+    /// \brief Function that sets a resolved physics parameter.
+    typedef std::function<bool (const boost::any &)> PhysicsParamSetter;
+
+    /// \def PhysicsParamGetter
+    /// \brief Function that gets a resolved physics parameter.
+    typedef std::function<bool (boost::any &)> PhysicsParamGetter;
+
+    /// \class PhysicsParam PhysicsParam.hh physics/physics.hh
+    /// \brief Typed handle to a parameter of a physics engine.
+    ///
+    /// The key of the parameter is looked up once by
+    /// PhysicsEngine::ParamHandle, setting and getting the parameter through
+    /// the handle then skips the string dispatch of SetParam and GetParam.
+    /// A handle is only valid as long as the physics engine that created it.
+    template<typename T>
+    class PhysicsParam
+    {
+      /// \brief Constructor of an invalid handle.
+      public: PhysicsParam() = default;
+
+      /// \brief Constructor.
+      /// \param[in] _key Key of the parameter.
+      /// \param[in] _setter Function that sets the parameter.
+      /// \param[in] _getter Function that gets the parameter.
+      public: PhysicsParam(const std::string &_key,
+                  PhysicsParamSetter _setter, PhysicsParamGetter _getter)
+              : key(_key), setter(std::move(_setter)),
+                getter(std::move(_getter))
+              {
+              }
+
+      /// \brief Check whether the handle refers to a parameter.
+      /// \return True if the parameter was resolved.
+      public: bool Valid() const
+              {
+                return this->setter && this->getter;
+              }
+
+      /// \brief Get the key of the parameter.
+      /// \return Key given to PhysicsEngine::ParamHandle.
+      public: const std::string &Key() const
+              {
+                return this->key;
+              }
+
+      /// \brief Set the parameter.
+      /// \param[in] _value New value.
+      /// \return True if the value was set.
+      public: bool Set(const T &_value) const
+              {
+                return this->setter && this->setter(boost::any(_value));
+              }
+
+      /// \brief Get the parameter.
+      /// \param[out] _value Current value.
+      /// \return True if the value was read.
+      public: bool Get(T &_value) const
+              {
+                boost::any value;
+                if (!this->getter || !this->getter(value))
+                  return false;
+
+                const T *typed = boost::any_cast<T>(&value);
+                if (!typed)
+                  return false;
+                _value = *typed;
+                return true;
+              }
+
+      /// \brief Key of the parameter.
+      private: std::string key;
+
+      /// \brief Sets the parameter.
+      private: PhysicsParamSetter setter;
+
+      /// \brief Gets the parameter.
+      private: PhysicsParamGetter getter;
+    };
+    /// \}
+  }
+}
+#endif
@@ -73,6 +73,13 @@ bool Preset::SetAllPhysicsParameters(PhysicsEnginePtr _physicsEngine) const
   }
   else
   {
+    // Apply the preset as a whole when possible
+    std::map<std::string, boost::any> params = this->dataPtr->parameterMap;
+    params.erase("type");
+    if (_physicsEngine->SetParams(params))
+      return result;
+
+    // Otherwise set the parameters one by one, reporting each failure
     for (auto const &param : this->dataPtr->parameterMap)
     {
       // disable params we know can't be set
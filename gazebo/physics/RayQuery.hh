@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_RAYQUERY_HH_
+#define GAZEBO_PHYSICS_RAYQUERY_HH_
+
+#include <string>
+
+#include <ignition/math/Helpers.hh>
+#include <ignition/math/Vector3.hh>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \addtogroup gazebo_physics
+    /// \{
+
+    /// \class RayQuery RayQuery.hh physics/physics.hh
+    /// \brief A ray segment of a batched ray query, see
+    /// PhysicsEngine::CastRays.
+    class GZ_PHYSICS_VISIBLE RayQuery
+    {
+      /// \brief Start of the ray, in the world frame.
+      public: ignition::math::Vector3d start;
+
+      /// \brief End of the ray, in the world frame.
+      public: ignition::math::Vector3d end;
+    };
+
+    /// \class RayQueryResult RayQuery.hh physics/physics.hh
+    /// \brief The closest hit of a ray query.
+    class GZ_PHYSICS_VISIBLE RayQueryResult
+    {
+      /// \brief Check whether the ray hit a collision.
+      /// \return True if the ray hit a collision.
+      public: bool Hit() const
+              {
+                return !this->collision.empty();
+              }
+
+      /// \brief Distance from the start of the ray to the hit, infinite if
+      /// nothing was hit.
+      public: double distance = ignition::math::INF_D;
+
+      /// \brief Scoped name of the collision hit, empty if nothing was hit.
+      public: std::string collision;
+
+      /// \brief Laser retro value of the collision hit.
+      public: double retro = 0.0;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,152 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+
+#include "gazebo/physics/StateHasher.hh"
+
+using namespace gazebo;
+using namespace physics;
+
+/// \brief Primes of xxHash64.
+static const uint64_t kPrime1 = 11400714785074694791ULL;
+static const uint64_t kPrime2 = 14029467366897019727ULL;
+static const uint64_t kPrime3 = 1609587929392839161ULL;
+static const uint64_t kPrime4 = 9650029242287828579ULL;
+
+/// \brief Rotate the bits of a word left.
+/// \param[in] _x The word.
+/// \param[in] _r Number of bits, between 1 and 63.
+/// \return The rotated word.
+static inline uint64_t RotateLeft(const uint64_t _x, const int _r)
+{
+  return (_x << _r) | (_x >> (64 - _r));
+}
+
+/// \brief Get the bits of a value.
+/// \param[in] _value The value.
+/// \return The bits.
+static inline uint64_t Bits(const double _value)
+{
+  uint64_t bits;
+  std::memcpy(&bits, &_value, sizeof(bits));
+  return bits;
+}
+
+//////////////////////////////////////////////////
+StateHasher::StateHasher()
+{
+  this->Reset();
+}
+
+//////////////////////////////////////////////////
+void StateHasher::Reset()
+{
+  this->lanes = {{kPrime1 + kPrime2, kPrime2, 0, 0 - kPrime1}};
+  this->tailCount = 0;
+  this->count = 0;
+}
+
+//////////////////////////////////////////////////
+uint64_t StateHasher::Round(uint64_t _lane, const uint64_t _bits)
+{
+  _lane += _bits * kPrime2;
+  _lane = RotateLeft(_lane, 31);
+  return _lane * kPrime1;
+}
+
+//////////////////////////////////////////////////
+void StateHasher::Add(const double *_values, const size_t _count)
+{
+  size_t i = 0;
+  this->count += _count;
+
+  // Complete the pending block first.
+  while (this->tailCount > 0 && i < _count)
+  {
+    this->tail[this->tailCount++] = Bits(_values[i++]);
+    if (this->tailCount == this->tail.size())
+    {
+      for (size_t j = 0; j < this->lanes.size(); ++j)
+        this->lanes[j] = Round(this->lanes[j], this->tail[j]);
+      this->tailCount = 0;
+    }
+  }
+
+  // Whole blocks, with the lanes updated independently.
+  uint64_t l0 = this->lanes[0];
+  uint64_t l1 = this->lanes[1];
+  uint64_t l2 = this->lanes[2];
+  uint64_t l3 = this->lanes[3];
+  for (; i + 4 <= _count; i += 4)
+  {
+    l0 = Round(l0, Bits(_values[i]));
+    l1 = Round(l1, Bits(_values[i + 1]));
+    l2 = Round(l2, Bits(_values[i + 2]));
+    l3 = Round(l3, Bits(_values[i + 3]));
+  }
+  this->lanes = {{l0, l1, l2, l3}};
+
+  for (; i < _count; ++i)
+    this->tail[this->tailCount++] = Bits(_values[i]);
+}
+
+//////////////////////////////////////////////////
+void StateHasher::Add(const double _value)
+{
+  this->Add(&_value, 1);
+}
+
+//////////////////////////////////////////////////
+uint64_t StateHasher::Digest() const
+{
+  uint64_t h = RotateLeft(this->lanes[0], 1) +
+    RotateLeft(this->lanes[1], 7) +
+    RotateLeft(this->lanes[2], 12) +
+    RotateLeft(this->lanes[3], 18);
+
+  for (const uint64_t lane : this->lanes)
+  {
+    h ^= Round(0, lane);
+    h = h * kPrime1 + kPrime4;
+  }
+
+  h += this->count * sizeof(double);
+
+  for (size_t i = 0; i < this->tailCount; ++i)
+  {
+    h ^= Round(0, this->tail[i]);
+    h = RotateLeft(h, 27) * kPrime1 + kPrime4;
+  }
+
+  h ^= h >> 33;
+  h *= kPrime2;
+  h ^= h >> 29;
+  h *= kPrime3;
+  h ^= h >> 32;
+  return h;
+}
+
+//////////////////////////////////////////////////
+std::string StateHasher::ToString(const uint64_t _digest)
+{
+  std::ostringstream stream;
+  stream << std::hex << std::setw(16) << std::setfill('0') << _digest;
+  return stream.str();
+}
@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_STATEHASHER_HH_
+#define GAZEBO_PHYSICS_STATEHASHER_HH_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \addtogroup gazebo_physics
+    /// \{
+
+    /// \class StateHasher StateHasher.hh physics/physics.hh
+    /// \brief Fast 64 bit hash of a sequence of state values, used by
+    /// World::StateDigest to compare runs.
+    ///
+    /// The bits of the values are hashed, so values that compare equal but
+    /// differ in their bits, such as 0 and -0, give different digests. The
+    /// values are mixed into four independent lanes, in the style of
+    /// xxHash64, so the loop over a block of values has no dependency
+    /// between its lanes and can be vectorized by the compiler. The digest
+    /// only depends on the sequence of values, not on how it is split
+    /// between calls to Add.
+    class GZ_PHYSICS_VISIBLE StateHasher
+    {
+      /// \brief Constructor.
+      public: StateHasher();
+
+      /// \brief Restart the hash of an empty sequence.
+      public: void Reset();
+
+      /// \brief Append values to the hashed sequence.
+      /// \param[in] _values The values.
+      /// \param[in] _count Number of values.
+      public: void Add(const double *_values, const size_t _count);
+
+      /// \brief Append a value to the hashed sequence.
+      /// \param[in] _value The value.
+      public: void Add(const double _value);
+
+      /// \brief Get the digest of the values added so far.
+      /// \return The digest.
+      public: uint64_t Digest() const;
+
+      /// \brief Format a digest as 16 hexadecimal digits.
+      /// \param[in] _digest The digest.
+      /// \return The digits.
+      public: static std::string ToString(const uint64_t _digest);
+
+      /// \brief Mix the bits of a value into the sum of a lane.
+      /// \param[in] _lane Sum of the lane.
+      /// \param[in] _bits Bits of the value.
+      /// \return New sum of the lane.
+      private: static uint64_t Round(uint64_t _lane, const uint64_t _bits);
+
+      /// \brief Sums of the lanes.
+      private: std::array<uint64_t, 4> lanes;
+
+      /// \brief Values that did not fill a block of four yet.
+      private: std::array<uint64_t, 4> tail;
+
+      /// \brief Number of values in tail.
+      private: size_t tailCount = 0;
+
+      /// \brief Number of values added.
+      private: uint64_t count = 0;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include "gazebo/physics/StateHasher.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class StateHasherTest : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+TEST_F(StateHasherTest, Sequence)
+{
+  std::vector<double> values;
+  for (int i = 0; i < 11; ++i)
+    values.push_back(i * 0.25 - 1.0);
+
+  physics::StateHasher all;
+  all.Add(values.data(), values.size());
+
+  // The digest doesn't depend on how the sequence is split
+  physics::StateHasher single;
+  for (const double value : values)
+    single.Add(value);
+  EXPECT_EQ(all.Digest(), single.Digest());
+
+  physics::StateHasher split;
+  split.Add(values.data(), 3);
+  split.Add(values.data() + 3, values.size() - 3);
+  EXPECT_EQ(all.Digest(), split.Digest());
+
+  // Any change of the sequence changes the digest
+  physics::StateHasher shorter;
+  shorter.Add(values.data(), values.size() - 1);
+  EXPECT_NE(all.Digest(), shorter.Digest());
+
+  std::swap(values[0], values[1]);
+  physics::StateHasher swapped;
+  swapped.Add(values.data(), values.size());
+  EXPECT_NE(all.Digest(), swapped.Digest());
+
+  // Reset starts over
+  split.Reset();
+  physics::StateHasher empty;
+  EXPECT_EQ(empty.Digest(), split.Digest());
+  EXPECT_NE(empty.Digest(), all.Digest());
+}
+
+/////////////////////////////////////////////////
+TEST_F(StateHasherTest, Bits)
+{
+  // The bits are hashed, not the value
+  physics::StateHasher zero;
+  zero.Add(0.0);
+  physics::StateHasher negativeZero;
+  negativeZero.Add(-0.0);
+  EXPECT_NE(zero.Digest(), negativeZero.Digest());
+
+  physics::StateHasher next;
+  next.Add(std::nextafter(0.0, 1.0));
+  EXPECT_NE(zero.Digest(), next.Digest());
+}
+
+/////////////////////////////////////////////////
+TEST_F(StateHasherTest, ToString)
+{
+  EXPECT_EQ("0000000000000000", physics::StateHasher::ToString(0));
+  EXPECT_EQ("00000000000000ff", physics::StateHasher::ToString(255));
+  EXPECT_EQ("ffffffffffffffff",
+      physics::StateHasher::ToString(0xFFFFFFFFFFFFFFFFULL));
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cmath>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/physics/StepSizeController.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \internal
+    /// \brief Private data for StepSizeController.
+    class StepSizeControllerPrivate
+    {
+      /// \brief Smallest step size.
+      public: double minStepSize = 0.0001;
+
+      /// \brief Largest step size.
+      public: double maxStepSize = 0.004;
+
+      /// \brief Velocity tolerance.
+      public: double velocityTolerance = 0.1;
+
+      /// \brief Penetration tolerance.
+      public: double penetrationTolerance = 0.01;
+    };
+  }
+}
+
+using namespace gazebo;
+using namespace physics;
+
+/// \brief Fraction of the step that brings the error to one, kept to
+/// avoid shrinking again right after.
+static const double kSafety = 0.9;
+
+/// \brief Largest factor by which a step shrinks.
+static const double kMaxShrink = 0.2;
+
+/// \brief Largest factor by which a step grows.
+static const double kMaxGrowth = 1.1;
+
+/// \brief Error below which a step grows.
+static const double kGrowthError = 0.5;
+
+//////////////////////////////////////////////////
+StepSizeController::StepSizeController()
+: dataPtr(new StepSizeControllerPrivate)
+{
+}
+
+//////////////////////////////////////////////////
+StepSizeController::~StepSizeController()
+{
+}
+
+//////////////////////////////////////////////////
+double StepSizeController::MinStepSize() const
+{
+  return this->dataPtr->minStepSize;
+}
+
+//////////////////////////////////////////////////
+double StepSizeController::MaxStepSize() const
+{
+  return this->dataPtr->maxStepSize;
+}
+
+//////////////////////////////////////////////////
+bool StepSizeController::SetBounds(const double _min, const double _max)
+{
+  const double minStep = std::min(_min, _max);
+  const double maxStep = std::max(_min, _max);
+  if (minStep <= 0)
+  {
+    gzerr << "Step size bounds must be positive, got [" << _min << ", "
+          << _max << "]" << std::endl;
+    return false;
+  }
+
+  this->dataPtr->minStepSize = minStep;
+  this->dataPtr->maxStepSize = maxStep;
+  return true;
+}
+
+//////////////////////////////////////////////////
+double StepSizeController::VelocityTolerance() const
+{
+  return this->dataPtr->velocityTolerance;
+}
+
+//////////////////////////////////////////////////
+void StepSizeController::SetVelocityTolerance(const double _tolerance)
+{
+  this->dataPtr->velocityTolerance = std::max(0.0, _tolerance);
+}
+
+//////////////////////////////////////////////////
+double StepSizeController::PenetrationTolerance() const
+{
+  return this->dataPtr->penetrationTolerance;
+}
+
+//////////////////////////////////////////////////
+void StepSizeController::SetPenetrationTolerance(const double _tolerance)
+{
+  this->dataPtr->penetrationTolerance = std::max(0.0, _tolerance);
+}
+
+//////////////////////////////////////////////////
+double StepSizeController::Error(const double _velocityChange,
+    const double _penetration) const
+{
+  double error = 0;
+  if (this->dataPtr->velocityTolerance > 0)
+  {
+    error = std::max(error,
+        std::abs(_velocityChange) / this->dataPtr->velocityTolerance);
+  }
+  if (this->dataPtr->penetrationTolerance > 0)
+  {
+    error = std::max(error,
+        std::max(0.0, _penetration) / this->dataPtr->penetrationTolerance);
+  }
+  return error;
+}
+
+//////////////////////////////////////////////////
+double StepSizeController::NextStepSize(const double _step,
+    const double _velocityChange, const double _penetration) const
+{
+  const double error = this->Error(_velocityChange, _penetration);
+
+  double step = _step;
+  if (error > 1)
+    step *= std::max(kMaxShrink, kSafety / error);
+  else if (error < kGrowthError)
+    step *= kMaxGrowth;
+
+  return std::min(std::max(step, this->dataPtr->minStepSize),
+      this->dataPtr->maxStepSize);
+}
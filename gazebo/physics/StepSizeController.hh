@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_STEPSIZECONTROLLER_HH_
+#define GAZEBO_PHYSICS_STEPSIZECONTROLLER_HH_
+
+#include <memory>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    // Forward declare private data class.
+    class StepSizeControllerPrivate;
+
+    /// \addtogroup gazebo_physics
+    /// \{
+
+    /// \class StepSizeController StepSizeController.hh physics/physics.hh
+    /// \brief Chooses the size of the next physics step from the error
+    /// measured in the last one, see World::SetAdaptiveStep.
+    ///
+    /// The error of a step is its largest ratio of a measure to its
+    /// tolerance: the change of link velocity that gravity does not
+    /// explain, and the depth of the contacts. The step shrinks when the
+    /// error is above one, e.g. on an impact, and grows slowly while it
+    /// stays well below one, always within the bounds.
+    class GZ_PHYSICS_VISIBLE StepSizeController
+    {
+      /// \brief Constructor.
+      public: StepSizeController();
+
+      /// \brief Destructor.
+      public: virtual ~StepSizeController();
+
+      /// \brief Get the smallest step size.
+      /// \return Step size in seconds.
+      public: double MinStepSize() const;
+
+      /// \brief Get the largest step size.
+      /// \return Step size in seconds.
+      public: double MaxStepSize() const;
+
+      /// \brief Set the bounds of the step size. The bounds are swapped if
+      /// _min is greater than _max.
+      /// \param[in] _min Smallest step size in seconds, must be positive.
+      /// \param[in] _max Largest step size in seconds.
+      /// \return False if _min is not positive.
+      public: bool SetBounds(const double _min, const double _max);
+
+      /// \brief Get the velocity tolerance.
+      /// \return Largest change of link velocity in a step, in m/s, not
+      /// counting gravity.
+      public: double VelocityTolerance() const;
+
+      /// \brief Set the velocity tolerance. Zero ignores the velocity.
+      /// \param[in] _tolerance Change of link velocity in m/s.
+      public: void SetVelocityTolerance(const double _tolerance);
+
+      /// \brief Get the penetration tolerance.
+      /// \return Largest contact depth in meters.
+      public: double PenetrationTolerance() const;
+
+      /// \brief Set the penetration tolerance. Zero ignores the contacts.
+      /// \param[in] _tolerance Contact depth in meters.
+      public: void SetPenetrationTolerance(const double _tolerance);
+
+      /// \brief Compute the error of a step.
+      /// \param[in] _velocityChange Largest change of link velocity in the
+      /// step, not counting gravity.
+      /// \param[in] _penetration Largest contact depth after the step.
+      /// \return Error of the step, one at the tolerances.
+      public: double Error(const double _velocityChange,
+                  const double _penetration) const;
+
+      /// \brief Compute the size of the next step.
+      /// \param[in] _step Size of the last step.
+      /// \param[in] _velocityChange Largest change of link velocity in the
+      /// last step, not counting gravity.
+      /// \param[in] _penetration Largest contact depth after the last step.
+      /// \return Size of the next step, within the bounds.
+      public: double NextStepSize(const double _step,
+                  const double _velocityChange,
+                  const double _penetration) const;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<StepSizeControllerPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
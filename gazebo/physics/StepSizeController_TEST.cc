@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "gazebo/physics/StepSizeController.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class StepSizeControllerTest : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+TEST_F(StepSizeControllerTest, Bounds)
+{
+  physics::StepSizeController controller;
+
+  EXPECT_FALSE(controller.SetBounds(0, 0.01));
+  EXPECT_FALSE(controller.SetBounds(0.01, -1));
+
+  // Swapped bounds
+  EXPECT_TRUE(controller.SetBounds(0.01, 0.001));
+  EXPECT_DOUBLE_EQ(0.001, controller.MinStepSize());
+  EXPECT_DOUBLE_EQ(0.01, controller.MaxStepSize());
+
+  controller.SetVelocityTolerance(-1);
+  EXPECT_DOUBLE_EQ(0, controller.VelocityTolerance());
+  controller.SetPenetrationTolerance(0.02);
+  EXPECT_DOUBLE_EQ(0.02, controller.PenetrationTolerance());
+}
+
+/////////////////////////////////////////////////
+TEST_F(StepSizeControllerTest, NextStepSize)
+{
+  physics::StepSizeController controller;
+  EXPECT_TRUE(controller.SetBounds(0.0005, 0.004));
+  controller.SetVelocityTolerance(0.1);
+  controller.SetPenetrationTolerance(0.01);
+
+  EXPECT_DOUBLE_EQ(0.5, controller.Error(0.05, 0.002));
+  EXPECT_DOUBLE_EQ(2.0, controller.Error(-0.05, 0.02));
+
+  // Quiet steps grow up to the largest step
+  double step = 0.001;
+  for (int i = 0; i < 100; ++i)
+    step = controller.NextStepSize(step, 0, 0.001);
+  EXPECT_DOUBLE_EQ(0.004, step);
+
+  // Errors close to one keep the step
+  EXPECT_DOUBLE_EQ(0.002, controller.NextStepSize(0.002, 0.08, 0));
+
+  // An impact shrinks the step, by a bounded factor
+  EXPECT_DOUBLE_EQ(0.002 * 0.9 / 2, controller.NextStepSize(0.002, 0.2, 0));
+  EXPECT_DOUBLE_EQ(0.004 * 0.2, controller.NextStepSize(0.004, 100, 0));
+  EXPECT_DOUBLE_EQ(0.0005, controller.NextStepSize(0.001, 100, 0));
+
+  // A deep contact shrinks it too, unless contacts are ignored
+  EXPECT_GT(0.002, controller.NextStepSize(0.002, 0, 0.05));
+  controller.SetPenetrationTolerance(0);
+  EXPECT_LT(0.002, controller.NextStepSize(0.002, 0, 0.05));
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
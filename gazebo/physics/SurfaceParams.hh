@@ -197,7 +197,10 @@ namespace gazebo
       public: unsigned int collideWithoutContactBitmask;
 
       /// \brief Custom collision filtering. Will override
-      /// collideWithoutContact.
+      /// collideWithoutContact. ODE also maps it onto the category and
+      /// collide bits of the collision to prune pairs in the broadphase, so
+      /// a change after the collision loaded should go through
+      /// Collision::ProcessMsg.
       public: unsigned int collideBitmask;
     };
     /// \}
@@ -14,11 +14,16 @@
  * limitations under the License.
  *
  */
+#include <algorithm>
+
 #include <boost/algorithm/string.hpp>
 #include <boost/range/adaptor/reversed.hpp>
 
 #include "gazebo/transport/transport.hh"
 
+#include "gazebo/physics/Light.hh"
+#include "gazebo/physics/Link.hh"
+#include "gazebo/physics/Model.hh"
 #include "gazebo/physics/World.hh"
 #include "gazebo/physics/WorldState.hh"
 
@@ -40,11 +45,79 @@ UserCmd::UserCmd(const unsigned int _id,
   this->dataPtr->world = _world;
   this->dataPtr->description = _description;
   this->dataPtr->type = _type;
+  this->dataPtr->time = common::Time::GetWallTime();
 
   // Record current world state
   this->dataPtr->startState = WorldState(this->dataPtr->world);
 }
 
+/////////////////////////////////////////////////
+UserCmd::UserCmd(const unsigned int _id,
+                 physics::WorldPtr _world,
+                 const std::string &_description,
+                 const msgs::UserCmd::Type &_type,
+                 const std::vector<std::string> &_entities)
+  : dataPtr(new UserCmdPrivate())
+{
+  this->dataPtr->id = _id;
+  this->dataPtr->world = _world;
+  this->dataPtr->description = _description;
+  this->dataPtr->type = _type;
+  this->dataPtr->time = common::Time::GetWallTime();
+  this->dataPtr->partial = true;
+
+  this->dataPtr->entities = _entities;
+  std::sort(this->dataPtr->entities.begin(), this->dataPtr->entities.end());
+  this->dataPtr->entities.erase(std::unique(this->dataPtr->entities.begin(),
+      this->dataPtr->entities.end()), this->dataPtr->entities.end());
+
+  // Record the current state of the affected entities only
+  this->dataPtr->Capture(this->dataPtr->startModels,
+      this->dataPtr->startLights);
+}
+
+/////////////////////////////////////////////////
+void UserCmdPrivate::Capture(
+    std::vector<std::pair<std::string, ModelState>> &_models,
+    std::vector<std::pair<std::string, LightState>> &_lights) const
+{
+  _models.clear();
+  _lights.clear();
+  for (auto const &name : this->entities)
+  {
+    if (ModelPtr model = this->world->ModelByName(name))
+    {
+      _models.push_back(std::make_pair(name, ModelState(model)));
+    }
+    else if (LightPtr light = this->world->LightByName(name))
+    {
+      _lights.push_back(std::make_pair(name, LightState(light,
+          this->world->RealTime(), this->world->SimTime(),
+          this->world->Iterations())));
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+void UserCmdPrivate::Apply(
+    const std::vector<std::pair<std::string, ModelState>> &_models,
+    const std::vector<std::pair<std::string, LightState>> &_lights) const
+{
+  for (auto const &state : _models)
+  {
+    if (ModelPtr model = this->world->ModelByName(state.first))
+    {
+      model->ResetPhysicsStates();
+      model->SetState(state.second);
+    }
+  }
+  for (auto const &state : _lights)
+  {
+    if (LightPtr light = this->world->LightByName(state.first))
+      light->SetState(state.second);
+  }
+}
+
 /////////////////////////////////////////////////
 UserCmd::~UserCmd()
 {
@@ -59,6 +132,15 @@ UserCmd::~UserCmd()
 /////////////////////////////////////////////////
 void UserCmd::Undo()
 {
+  if (this->dataPtr->partial)
+  {
+    this->dataPtr->Capture(this->dataPtr->endModels,
+        this->dataPtr->endLights);
+    this->dataPtr->Apply(this->dataPtr->startModels,
+        this->dataPtr->startLights);
+    return;
+  }
+
   // Record / override the state for redo
   this->dataPtr->endState = WorldState(this->dataPtr->world);
 
@@ -72,6 +154,12 @@ void UserCmd::Undo()
 /////////////////////////////////////////////////
 void UserCmd::Redo()
 {
+  if (this->dataPtr->partial)
+  {
+    this->dataPtr->Apply(this->dataPtr->endModels, this->dataPtr->endLights);
+    return;
+  }
+
   // Reset physics states for the whole world
   this->dataPtr->world->ResetPhysicsStates();
 
@@ -97,6 +185,23 @@ msgs::UserCmd::Type UserCmd::Type() const
   return this->dataPtr->type;
 }
 
+/////////////////////////////////////////////////
+bool UserCmd::Merge(const UserCmd &_cmd)
+{
+  if (!this->dataPtr->partial || !_cmd.dataPtr->partial ||
+      this->dataPtr->type != _cmd.dataPtr->type ||
+      this->dataPtr->entities != _cmd.dataPtr->entities ||
+      _cmd.dataPtr->time - this->dataPtr->time > common::Time(1.0))
+  {
+    return false;
+  }
+
+  // The start state stays the one of this command, the end state is
+  // recorded on undo.
+  this->dataPtr->time = _cmd.dataPtr->time;
+  return true;
+}
+
 /////////////////////////////////////////////////
 UserCmdManager::UserCmdManager(const WorldPtr _world)
   : dataPtr(new UserCmdManagerPrivate())
@@ -157,12 +262,45 @@ UserCmdManager::~UserCmdManager()
 /////////////////////////////////////////////////
 void UserCmdManager::OnUserCmdMsg(ConstUserCmdPtr &_msg)
 {
-  // Generate unique id
-  unsigned int id = this->dataPtr->idCounter++;
+  // Models and lights affected by the command. Other commands, such as
+  // world resets, record the whole world.
+  std::vector<std::string> entities;
+  if (_msg->type() == msgs::UserCmd::MOVING ||
+      _msg->type() == msgs::UserCmd::SCALING)
+  {
+    for (int i = 0; i < _msg->model_size(); ++i)
+      entities.push_back(_msg->model(i).name());
+    for (int i = 0; i < _msg->light_size(); ++i)
+      entities.push_back(_msg->light(i).name());
+  }
+  else if (_msg->type() == msgs::UserCmd::WRENCH)
+  {
+    LinkPtr link = boost::dynamic_pointer_cast<Link>(
+        this->dataPtr->world->EntityByName(_msg->entity_name()));
+    if (link)
+      entities.push_back(link->GetModel()->GetScopedName());
+  }
 
   // Create command
-  UserCmdPtr cmd(new UserCmd(id, this->dataPtr->world, _msg->description(),
-      _msg->type()));
+  UserCmdPtr cmd;
+  if (entities.empty())
+  {
+    cmd.reset(new UserCmd(this->dataPtr->idCounter, this->dataPtr->world,
+        _msg->description(), _msg->type()));
+  }
+  else
+  {
+    cmd.reset(new UserCmd(this->dataPtr->idCounter, this->dataPtr->world,
+        _msg->description(), _msg->type(), entities));
+  }
+
+  // A continuous drag sends a command for each step: they are merged into
+  // the previous command, so that a single undo reverts the whole drag.
+  bool merged = this->dataPtr->redoCmds.empty() &&
+      !this->dataPtr->undoCmds.empty() &&
+      this->dataPtr->undoCmds.back()->Merge(*cmd);
+  if (!merged)
+    this->dataPtr->idCounter++;
 
   // Forward message after we've saved the current state
   switch (_msg->type())
@@ -221,7 +359,8 @@ void UserCmdManager::OnUserCmdMsg(ConstUserCmdPtr &_msg)
   }
 
   // Add it to undo list
-  this->dataPtr->undoCmds.push_back(cmd);
+  if (!merged)
+    this->dataPtr->undoCmds.push_back(cmd);
 
   // Clear redo list
   this->dataPtr->redoCmds.clear();
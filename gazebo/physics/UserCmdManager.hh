@@ -18,6 +18,7 @@
 #define GAZEBO_PHYSICS_USERCMDMANAGER_HH_
 
 #include <string>
+#include <vector>
 
 #include "gazebo/transport/TransportTypes.hh"
 
@@ -45,6 +46,22 @@ namespace gazebo
                       const std::string &_description,
                       const msgs::UserCmd::Type &_type);
 
+      /// \brief Constructor of a command that only affects some models and
+      /// lights. Only their state is recorded, which is much cheaper than
+      /// recording the whole world.
+      /// \param[in] _id Unique ID for this command
+      /// \param[in] _world Pointer to the world
+      /// \param[in] _description Description for the command, such as
+      /// "Rotate box", "Delete sphere", etc.
+      /// \param[in] _type Type of command, such as MOVING, DELETING, etc.
+      /// \param[in] _entities Scoped names of the affected models and
+      /// lights.
+      public: UserCmd(const unsigned int _id,
+                      physics::WorldPtr _world,
+                      const std::string &_description,
+                      const msgs::UserCmd::Type &_type,
+                      const std::vector<std::string> &_entities);
+
       /// \brief Destructor
       public: virtual ~UserCmd();
 
@@ -66,6 +83,17 @@ namespace gazebo
       /// \return Command type
       public: msgs::UserCmd::Type Type() const;
 
+      /// \brief Merge a command that follows this one into it, such as the
+      /// next step of a continuous drag. This command then undoes to its own
+      /// start state and redoes to the state after the merged command.
+      /// Commands are merged if they have the same type and affect the same
+      /// models and lights, and if the command follows this one (or the last
+      /// command merged into it) within a second.
+      /// \param[in] _cmd The following command.
+      /// \return True if the command was merged, false if it stays a
+      /// separate command.
+      public: bool Merge(const UserCmd &_cmd);
+
       /// \internal
       /// \brief Pointer to private data.
       protected: UserCmdPrivate *dataPtr;
@@ -18,11 +18,15 @@
 #define _GAZEBO_USER_CMD_MANAGER_PRIVATE_HH_
 
 #include <string>
+#include <utility>
 #include <vector>
 #include <sdf/sdf.hh>
 
+#include "gazebo/common/Time.hh"
 #include "gazebo/transport/Node.hh"
 #include "gazebo/transport/Subscriber.hh"
+#include "gazebo/physics/LightState.hh"
+#include "gazebo/physics/ModelState.hh"
 #include "gazebo/physics/PhysicsTypes.hh"
 
 namespace gazebo
@@ -35,9 +39,54 @@ namespace gazebo
     /// \brief Private data for the UserCmdManager class
     class UserCmdPrivate
     {
+      /// \brief Record the state of the affected models and lights.
+      /// \param[out] _models State of each model, by scoped name.
+      /// \param[out] _lights State of each light, by name.
+      public: void Capture(
+                  std::vector<std::pair<std::string, ModelState>> &_models,
+                  std::vector<std::pair<std::string, LightState>> &_lights)
+                  const;
+
+      /// \brief Set the state of the affected models and lights.
+      /// \param[in] _models State of each model, by scoped name.
+      /// \param[in] _lights State of each light, by name.
+      public: void Apply(
+                  const std::vector<std::pair<std::string, ModelState>>
+                  &_models,
+                  const std::vector<std::pair<std::string, LightState>>
+                  &_lights) const;
+
       /// \brief Pointer to the world.
       public: WorldPtr world;
 
+      /// \brief True if only the entities are recorded, false to record
+      /// the whole world.
+      public: bool partial = false;
+
+      /// \brief Sorted scoped names of the affected models and lights, if
+      /// partial.
+      public: std::vector<std::string> entities;
+
+      /// \brief State of the affected models when the command was
+      /// executed.
+      public: std::vector<std::pair<std::string, ModelState>> startModels;
+
+      /// \brief State of the affected lights when the command was
+      /// executed.
+      public: std::vector<std::pair<std::string, LightState>> startLights;
+
+      /// \brief State of the affected models the last time the user
+      /// triggered undo.
+      public: std::vector<std::pair<std::string, ModelState>> endModels;
+
+      /// \brief State of the affected lights the last time the user
+      /// triggered undo.
+      public: std::vector<std::pair<std::string, LightState>> endLights;
+
+      /// \brief Wall time of the command, or of the last command merged
+      /// into it.
+      public: common::Time time;
+
       /// \brief Whole world state the moment the user command was executed.
       public: WorldState startState;
 
@@ -19,6 +19,7 @@
 
 #include "gazebo/test/ServerFixture.hh"
 #include "gazebo/test/helper_physics_generator.hh"
+#include "gazebo/physics/Model.hh"
 #include "gazebo/physics/UserCmdManager.hh"
 
 using namespace gazebo;
@@ -61,6 +62,55 @@ TEST_F(UserCmdManagerTest, CreateCmd)
   manager = NULL;
 }
 
+/////////////////////////////////////////////////
+TEST_F(UserCmdManagerTest, EntityCmd)
+{
+  Load("worlds/shapes.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != NULL);
+
+  physics::ModelPtr box = world->ModelByName("box");
+  physics::ModelPtr sphere = world->ModelByName("sphere");
+  ASSERT_TRUE(box != NULL);
+  ASSERT_TRUE(sphere != NULL);
+
+  const ignition::math::Pose3d boxStart = box->WorldPose();
+  const ignition::math::Pose3d sphereStart = sphere->WorldPose();
+
+  // Only the box is recorded
+  physics::UserCmd cmd(1, world, "Move box", msgs::UserCmd::MOVING,
+      {"box"});
+  const ignition::math::Pose3d boxEnd(5, 0, 0.5, 0, 0, 0);
+  box->SetWorldPose(boxEnd);
+  sphere->SetWorldPose(ignition::math::Pose3d(0, 5, 0.5, 0, 0, 0));
+
+  // Undo only moves the box back
+  cmd.Undo();
+  EXPECT_EQ(boxStart, box->WorldPose());
+  EXPECT_NE(sphereStart, sphere->WorldPose());
+
+  cmd.Redo();
+  EXPECT_EQ(boxEnd, box->WorldPose());
+
+  // The next step of a drag merges, other commands don't
+  physics::UserCmd next(2, world, "Move box", msgs::UserCmd::MOVING,
+      {"box"});
+  physics::UserCmd other(3, world, "Move sphere", msgs::UserCmd::MOVING,
+      {"sphere"});
+  physics::UserCmd scale(4, world, "Scale box", msgs::UserCmd::SCALING,
+      {"box"});
+  physics::UserCmd whole(5, world, "Move box", msgs::UserCmd::MOVING);
+  EXPECT_TRUE(cmd.Merge(next));
+  EXPECT_FALSE(cmd.Merge(other));
+  EXPECT_FALSE(cmd.Merge(scale));
+  EXPECT_FALSE(cmd.Merge(whole));
+
+  // The merged command undoes to the start of the first one
+  box->SetWorldPose(ignition::math::Pose3d(7, 0, 0.5, 0, 0, 0));
+  cmd.Undo();
+  EXPECT_EQ(boxStart, box->WorldPose());
+}
+
 int main(int argc, char **argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
@@ -15,9 +15,13 @@
  *
 */
 
+#include <algorithm>
 #include <functional>
+#include <mutex>
+#include <vector>
 #include <boost/lexical_cast.hpp>
 #include <sdf/sdf.hh>
+#include <ignition/common/Profiler.hh>
 
 #include <ignition/math/Vector3.hh>
 
@@ -25,6 +29,7 @@
 #include "gazebo/transport/TransportTypes.hh"
 
 #include "gazebo/physics/Entity.hh"
+#include "gazebo/physics/Link.hh"
 #include "gazebo/physics/PhysicsTypes.hh"
 #include "gazebo/physics/Wind.hh"
 #include "gazebo/physics/World.hh"
@@ -57,6 +62,38 @@ namespace gazebo
       public: std::function< ignition::math::Vector3d (
                   const Wind *, const Entity *)> linearVelFunc;
 
+      /// \brief True if linearVelFunc is the default, uniform, function.
+      public: bool defaultLinearVelFunc = true;
+
+      /// \brief The function used to calculate the wind velocity at the
+      /// positions of all the links at once, may be empty.
+      public: Wind::LinearVelFieldFunc linearVelFieldFunc;
+
+      /// \brief Links whose wind velocity is updated by Update.
+      public: std::vector<Link *> links;
+
+      /// \brief Mutex to protect links.
+      public: std::mutex linksMutex;
+
+      /// \brief Awake links of the current update.
+      public: std::vector<Link *> awakeLinks;
+
+      /// \brief World positions of awakeLinks.
+      public: std::vector<ignition::math::Vector3d> positions;
+
+      /// \brief Wind velocities at positions.
+      public: std::vector<ignition::math::Vector3d> velocities;
+
+      /// \brief Updates per second of sim time, zero to update on every
+      /// step.
+      public: double updateRate = 0.0;
+
+      /// \brief Sim time of the last update.
+      public: common::Time lastUpdateTime;
+
+      /// \brief True if the links have not been updated yet.
+      public: bool firstUpdate = true;
+
       // Transport is declared last.
       /// \brief Node for communication.
       public: transport::NodePtr node;
@@ -95,6 +132,7 @@ Wind::Wind(World &_world, sdf::ElementPtr _sdf)
 
   this->SetLinearVelFunc(std::bind(&Wind::LinearVelDefault, this,
         std::placeholders::_1, std::placeholders::_2));
+  this->dataPtr->defaultLinearVelFunc = true;
 }
 
 //////////////////////////////////////////////////
@@ -200,6 +238,10 @@ void Wind::Load(sdf::ElementPtr _sdf)
 {
   if (_sdf && _sdf->HasElement("linear_velocity"))
     this->SetLinearVel(_sdf->Get<ignition::math::Vector3d>("linear_velocity"));
+
+  const std::string kElementName = "ignition:update_rate";
+  if (_sdf && _sdf->HasElement(kElementName))
+    this->SetUpdateRate(_sdf->Get<double>(kElementName));
 }
 
 /////////////////////////////////////////////////
@@ -239,4 +281,96 @@ void Wind::SetLinearVelFunc(std::function< ignition::math::Vector3d (
     const Wind *, const Entity *_entity) > _linearVelFunc)
 {
   this->dataPtr->linearVelFunc = _linearVelFunc;
+  this->dataPtr->defaultLinearVelFunc = false;
+}
+
+/////////////////////////////////////////////////
+void Wind::SetLinearVelFieldFunc(
+    const LinearVelFieldFunc &_linearVelFieldFunc)
+{
+  this->dataPtr->linearVelFieldFunc = _linearVelFieldFunc;
+}
+
+/////////////////////////////////////////////////
+void Wind::SetUpdateRate(const double _rate)
+{
+  this->dataPtr->updateRate = std::max(0.0, _rate);
+}
+
+/////////////////////////////////////////////////
+double Wind::UpdateRate() const
+{
+  return this->dataPtr->updateRate;
+}
+
+/////////////////////////////////////////////////
+void Wind::AddLink(Link *_link)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->linksMutex);
+  auto &links = this->dataPtr->links;
+  if (std::find(links.begin(), links.end(), _link) == links.end())
+    links.push_back(_link);
+
+  // Give the new link its wind velocity on the next step
+  this->dataPtr->firstUpdate = true;
+}
+
+/////////////////////////////////////////////////
+void Wind::RemoveLink(Link *_link)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->linksMutex);
+  auto &links = this->dataPtr->links;
+  links.erase(std::remove(links.begin(), links.end(), _link), links.end());
+}
+
+/////////////////////////////////////////////////
+void Wind::Update(const common::UpdateInfo &_info)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->linksMutex);
+  if (this->dataPtr->links.empty())
+    return;
+
+  // Keep the velocities between updates at a lower rate
+  if (this->dataPtr->updateRate > 0 && !this->dataPtr->firstUpdate &&
+      (_info.simTime - this->dataPtr->lastUpdateTime).Double() <
+      1.0 / this->dataPtr->updateRate)
+  {
+    return;
+  }
+  this->dataPtr->lastUpdateTime = _info.simTime;
+  this->dataPtr->firstUpdate = false;
+
+  IGN_PROFILE("Wind::Update");
+
+  auto &awakeLinks = this->dataPtr->awakeLinks;
+  auto &positions = this->dataPtr->positions;
+  auto &velocities = this->dataPtr->velocities;
+  awakeLinks.clear();
+  positions.clear();
+  for (auto link : this->dataPtr->links)
+  {
+    if (link->Asleep())
+      continue;
+    awakeLinks.push_back(link);
+    positions.push_back(link->WorldPose().Pos());
+  }
+  velocities.resize(awakeLinks.size());
+
+  if (this->dataPtr->linearVelFieldFunc)
+  {
+    this->dataPtr->linearVelFieldFunc(this, positions, velocities);
+  }
+  else if (this->dataPtr->defaultLinearVelFunc)
+  {
+    // The default wind is uniform
+    std::fill(velocities.begin(), velocities.end(), this->LinearVel());
+  }
+  else
+  {
+    for (size_t i = 0; i < awakeLinks.size(); ++i)
+      velocities[i] = this->dataPtr->linearVelFunc(this, awakeLinks[i]);
+  }
+
+  for (size_t i = 0; i < awakeLinks.size(); ++i)
+    awakeLinks[i]->SetWorldWindLinearVel(velocities[i]);
 }
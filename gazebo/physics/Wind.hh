@@ -20,8 +20,10 @@
 #include <string>
 #include <functional>
 #include <memory>
+#include <vector>
 #include <boost/any.hpp>
 
+#include "gazebo/common/UpdateInfo.hh"
 #include "gazebo/msgs/msgs.hh"
 #include "gazebo/physics/PhysicsTypes.hh"
 #include "gazebo/util/system.hh"
@@ -38,8 +40,20 @@ namespace gazebo
 
     /// \class Wind Wind.hh physics/physics.hh
     /// \brief Base class for wind.
+    ///
+    /// The wind velocity of all the links affected by the wind is updated in
+    /// one pass per step, see Update.
     class GZ_PHYSICS_VISIBLE Wind
     {
+      /// \brief Function computing the wind velocity at many points at
+      /// once. The parameters are a pointer to the wind, the world
+      /// positions of the points, and the wind velocities to fill, already
+      /// sized as the positions.
+      public: typedef std::function<void (const Wind *_wind,
+                  const std::vector<ignition::math::Vector3d> &_positions,
+                  std::vector<ignition::math::Vector3d> &_velocities)>
+              LinearVelFieldFunc;
+
       /// \brief Default constructor.
       /// \param[in] _world Reference to the world.
       /// \param[in] _sdf SDF element parameters for the wind.
@@ -114,6 +128,40 @@ namespace gazebo
       public: void SetLinearVelFunc(std::function< ignition::math::Vector3d (
           const Wind *_wind, const Entity *_entity) > _linearVelFunc);
 
+      /// \brief Setup a function to compute the wind field at the positions
+      /// of all the links in one call, used instead of the function set by
+      /// SetLinearVelFunc for the links.
+      /// \param[in] _linearVelFieldFunc The function, or an empty function
+      /// to use the function set by SetLinearVelFunc again.
+      public: void SetLinearVelFieldFunc(
+                  const LinearVelFieldFunc &_linearVelFieldFunc);
+
+      /// \brief Set the rate at which the wind velocity of the links is
+      /// updated. The links keep their wind velocity between updates.
+      /// \param[in] _rate Updates per second of sim time, zero or negative
+      /// to update on every step.
+      public: void SetUpdateRate(const double _rate);
+
+      /// \brief Get the rate at which the wind velocity of the links is
+      /// updated.
+      /// \return Updates per second of sim time, zero if updated on every
+      /// step.
+      public: double UpdateRate() const;
+
+      /// \brief Add a link whose wind velocity is updated by Update.
+      /// \param[in] _link The link, which must be removed before it is
+      /// deleted.
+      public: void AddLink(Link *_link);
+
+      /// \brief Remove a link added by AddLink.
+      /// \param[in] _link The link.
+      public: void RemoveLink(Link *_link);
+
+      /// \brief Update the wind velocity of the awake links added by
+      /// AddLink, if due. The world calls it once per step.
+      /// \param[in] _info Update information of the step.
+      public: void Update(const common::UpdateInfo &_info);
+
       /// \brief Get the global wind velocity, ignoring the entity.
       /// \param[in] _wind Reference to the wind.
       /// \param[in] _entity Pointer to an entity at which location the wind
@@ -15,6 +15,7 @@
  *
 */
 #include <memory>
+#include <vector>
 
 #include "gazebo/test/ServerFixture.hh"
 #include "gazebo/msgs/msgs.hh"
@@ -44,6 +45,9 @@ class WindTest : public ServerFixture
   /// \brief Test setting up function to compute the wind.
   public: void WindSetLinearVelFunc();
 
+  /// \brief Test the update of the wind velocity of the links.
+  public: void WindUpdateLinks();
+
   /// \brief Incoming wind message.
   public: static msgs::Wind windPubMsg;
 
@@ -221,6 +225,71 @@ TEST_F(WindTest, WindSetLinearVelFunc)
   WindSetLinearVelFunc();
 }
 
+/////////////////////////////////////////////////
+void WindTest::WindUpdateLinks()
+{
+  Load("worlds/wind_demo.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != NULL);
+
+  physics::ModelPtr model = world->ModelByName("wind_demo_model");
+  ASSERT_TRUE(model != NULL);
+  physics::Link_V links = model->GetLinks();
+  ASSERT_FALSE(links.empty());
+
+  physics::Wind &wind = world->Wind();
+  EXPECT_DOUBLE_EQ(0.0, wind.UpdateRate());
+
+  // The field function is called once for all the links
+  int calls = 0;
+  wind.SetLinearVelFieldFunc(
+      [&calls](const physics::Wind *,
+        const std::vector<ignition::math::Vector3d> &_positions,
+        std::vector<ignition::math::Vector3d> &_velocities)
+      {
+        ++calls;
+        EXPECT_EQ(_positions.size(), _velocities.size());
+        for (auto &vel : _velocities)
+          vel.Set(calls, 0, 0);
+      });
+
+  world->Step(1);
+  EXPECT_EQ(1, calls);
+  for (auto const &link : links)
+    EXPECT_EQ(ignition::math::Vector3d(1, 0, 0), link->WorldWindLinearVel());
+
+  // At a lower rate the links keep their velocity between updates
+  const double stepSize = world->Physics()->GetMaxStepSize();
+  wind.SetUpdateRate(0.4 / stepSize);
+  EXPECT_DOUBLE_EQ(0.4 / stepSize, wind.UpdateRate());
+  world->Step(2);
+  EXPECT_EQ(1, calls);
+  for (auto const &link : links)
+    EXPECT_EQ(ignition::math::Vector3d(1, 0, 0), link->WorldWindLinearVel());
+  world->Step(4);
+  EXPECT_EQ(3, calls);
+  for (auto const &link : links)
+    EXPECT_EQ(ignition::math::Vector3d(3, 0, 0), link->WorldWindLinearVel());
+
+  // Disabling the wind clears the velocity
+  wind.SetUpdateRate(-1);
+  EXPECT_DOUBLE_EQ(0.0, wind.UpdateRate());
+  world->SetWindEnabled(false);
+  calls = 0;
+  world->Step(1);
+  EXPECT_EQ(0, calls);
+  for (auto const &link : links)
+    EXPECT_EQ(ignition::math::Vector3d::Zero, link->WorldWindLinearVel());
+
+  wind.SetLinearVelFieldFunc(nullptr);
+}
+
+/////////////////////////////////////////////////
+TEST_F(WindTest, WindUpdateLinks)
+{
+  WindUpdateLinks();
+}
+
 int main(int argc, char **argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
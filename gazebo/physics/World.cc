@@ -22,10 +22,16 @@
 
 #include <sdf/sdf.hh>
 
+#include <algorithm>
+#include <chrono>
 #include <deque>
+#include <functional>
 #include <list>
+#include <map>
+#include <numeric>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <boost/algorithm/string/predicate.hpp>
@@ -52,12 +58,20 @@
 #include "gazebo/common/CommonIface.hh"
 #include "gazebo/common/Events.hh"
 #include "gazebo/common/Exception.hh"
+#include "gazebo/common/MeshManager.hh"
 #include "gazebo/common/Console.hh"
+#include "gazebo/common/CostCounter.hh"
 #include "gazebo/common/Plugin.hh"
+#include "gazebo/common/PluginLibraryCache.hh"
 #include "gazebo/common/SdfFrameSemantics.hh"
+#include "gazebo/common/SystemPaths.hh"
+#include "gazebo/common/SpscQueue.hh"
+#include "gazebo/common/ThreadConfig.hh"
 #include "gazebo/common/Time.hh"
+#include "gazebo/common/Tracer.hh"
 #include "gazebo/common/URI.hh"
 
+#include "gazebo/msgs/MsgFactory.hh"
 #include "gazebo/msgs/msgs.hh"
 
 #include "gazebo/util/OpenAL.hh"
@@ -65,6 +79,7 @@
 #include "gazebo/util/IntrospectionManager.hh"
 #include "gazebo/util/LogRecord.hh"
 
+#include "gazebo/physics/BatterySystem.hh"
 #include "gazebo/physics/Road.hh"
 #include "gazebo/physics/RayShape.hh"
 #include "gazebo/physics/Joint.hh"
@@ -74,6 +89,8 @@
 #include "gazebo/physics/Atmosphere.hh"
 #include "gazebo/physics/AtmosphereFactory.hh"
 #include "gazebo/physics/PresetManager.hh"
+#include "gazebo/physics/StateHasher.hh"
+#include "gazebo/physics/StepSizeController.hh"
 #include "gazebo/physics/UserCmdManager.hh"
 #include "gazebo/physics/Model.hh"
 #include "gazebo/physics/Light.hh"
@@ -84,6 +101,7 @@
 #include "gazebo/common/SphericalCoordinates.hh"
 
 #include "gazebo/physics/Collision.hh"
+#include "gazebo/physics/Contact.hh"
 #include "gazebo/physics/ContactManager.hh"
 #include "gazebo/physics/Population.hh"
 
@@ -94,20 +112,356 @@ using namespace physics;
 /// This will be replaced with a class member variable in Gazebo 3.0
 bool g_clearModels;
 
+/// \brief Deferred side effects of the model partition that the calling
+/// thread is updating. Null outside of World::ModelUpdateTBB.
+static thread_local ModelUpdateDeferred *g_modelUpdateDeferred = nullptr;
+
+/// \brief Wall time between the states played when fast-forwarding a log,
+/// about the period of the frames displayed by the clients.
+static const common::Time kLogPlayFastForwardPeriod(0, 16666667);
+
+/// \brief Names of the phases of the world steps, see WorldStepPhase.
+static const char *kStepPhaseNames[STEP_PHASE_COUNT] =
+{
+  "lockMutex",
+  "loadPlugins",
+  "publishWorldStats",
+  "waitForSensors",
+  "sleep",
+  "logPlayback",
+  "worldUpdateMutex",
+  "reset",
+  "worldUpdateBegin",
+  "modelUpdate",
+  "updateCollision",
+  "logWait",
+  "beforePhysicsUpdate",
+  "updatePhysics",
+  "setWorldPose",
+  "updateStepSize",
+  "stateDigest",
+  "sensorOffload",
+  "logRecordNotify",
+  "publishContacts",
+  "worldUpdateEnd",
+  "introspection",
+  "processMessages",
+  "clearModels"
+};
+
+/// \brief Number of one second samples in the window of the step cost
+/// breakdown.
+static const size_t kStepCostWindow = 5;
+
 class ModelUpdate_TBB
 {
-  public: explicit ModelUpdate_TBB(Model_V *_models) : models(_models) {}
+  public: ModelUpdate_TBB(std::vector<Model_V> *_partitions,
+              std::vector<ModelUpdateDeferred> *_deferred)
+          : partitions(_partitions), deferred(_deferred) {}
   public: void operator() (const tbb::blocked_range<size_t> &_r) const
   {
     for (size_t i = _r.begin(); i != _r.end(); i++)
     {
-      (*models)[i]->Update();
+      // Restore the previous buffer afterwards, the scheduler may run
+      // another partition on this thread while a model waits on nested work.
+      ModelUpdateDeferred *prevDeferred = g_modelUpdateDeferred;
+      g_modelUpdateDeferred = &(*this->deferred)[i];
+
+      for (auto &model : (*this->partitions)[i])
+        model->Update();
+
+      g_modelUpdateDeferred = prevDeferred;
     }
   }
 
-  private: Model_V *models;
+  private: std::vector<Model_V> *partitions;
+  private: std::vector<ModelUpdateDeferred> *deferred;
 };
 
+/// \brief Count the joints of a model, including nested models.
+/// \param[in] _model Model to count the joints of.
+/// \return Number of joints.
+static unsigned int ModelJointCount(const ModelPtr &_model)
+{
+  unsigned int count = _model->GetJointCount();
+  for (auto const &nested : _model->NestedModels())
+    count += ModelJointCount(nested);
+  return count;
+}
+
+/// \brief Collect the joints of a model, including nested models.
+/// \param[in] _model Model to get the joints from.
+/// \param[out] _joints Joints are appended to this list.
+static void ModelJoints(const ModelPtr &_model, Joint_V &_joints)
+{
+  _joints.insert(_joints.end(), _model->GetJoints().begin(),
+      _model->GetJoints().end());
+  for (auto const &nested : _model->NestedModels())
+    ModelJoints(nested, _joints);
+}
+
+/// \brief Check that an element of the name or id index is still part
+/// of the world. Removed elements lose their parent, but may be kept
+/// alive by other owners.
+/// \param[in] _base Element of the index.
+/// \return True if the element can be returned by a lookup.
+static bool IndexEntryValid(const BasePtr &_base)
+{
+  return _base && _base->GetParent();
+}
+
+/// \brief Build the pose layout of a model: the model followed by its
+/// nested models in breadth first order.
+/// \param[in] _model Top level model.
+/// \param[out] _layout Layout to fill, previous content is discarded.
+static void BuildPoseLayout(Model *_model,
+    std::vector<PoseLayoutEntry> &_layout)
+{
+  _layout.clear();
+  _layout.push_back({_model, 0, 0});
+  for (size_t i = 0; i < _layout.size(); ++i)
+  {
+    Model *m = _layout[i].model;
+    _layout[i].linkCount = m->GetLinks().size();
+    _layout[i].nestedCount = m->NestedModels().size();
+    for (auto const &nested : m->NestedModels())
+      _layout.push_back({nested.get(), 0, 0});
+  }
+}
+
+/// \brief Check that a pose layout still matches its models. Entries are
+/// visited parent first, so a nested model is never accessed after its
+/// parent changed.
+/// \param[in] _layout Layout to check.
+/// \return True if the number of links and nested models are unchanged.
+static bool PoseLayoutValid(const std::vector<PoseLayoutEntry> &_layout)
+{
+  if (_layout.empty())
+    return false;
+
+  for (auto const &entry : _layout)
+  {
+    if (entry.model->GetLinks().size() != entry.linkCount ||
+        entry.model->NestedModels().size() != entry.nestedCount)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+/// \brief Append a pose to a pose message.
+/// \param[in] _entity Entity whose relative pose is written.
+/// \param[in] _names True to also write the scoped name of the entity.
+/// \param[out] _msg Message to append to.
+static void AddPose(const Entity &_entity, const bool _names,
+    msgs::PosesStamped &_msg)
+{
+  msgs::Pose *poseMsg = _msg.add_pose();
+  if (_names)
+    poseMsg->set_name(_entity.GetScopedName());
+  poseMsg->set_id(_entity.GetId());
+  msgs::Set(poseMsg, _entity.RelativePose());
+}
+
+/// \brief Add the world poses of a model, of its links and of its nested
+/// models to the state published to the sensor workers.
+/// \param[in] _model The model.
+/// \param[out] _msg Message to add the poses to.
+static void AddSensorOffloadPoses(const Model &_model,
+    msgs::PosesStamped &_msg)
+{
+  msgs::Pose *poseMsg = _msg.add_pose();
+  poseMsg->set_name(_model.GetScopedName());
+  msgs::Set(poseMsg, _model.WorldPose());
+
+  for (auto const &link : _model.GetLinks())
+  {
+    poseMsg = _msg.add_pose();
+    poseMsg->set_name(link->GetScopedName());
+    msgs::Set(poseMsg, link->WorldPose());
+  }
+
+  for (auto const &model : _model.NestedModels())
+    AddSensorOffloadPoses(*model, _msg);
+}
+
+/// \brief Write a pose into a message of the scene snapshot.
+/// \param[in] _pose The pose.
+/// \param[out] _msg Message to write to.
+/// \param[in,out] _changed Set to true if the message changed.
+static void SetScenePose(const ignition::math::Pose3d &_pose,
+    msgs::Pose &_msg, bool &_changed)
+{
+  if (msgs::ConvertIgn(_msg) != _pose)
+  {
+    msgs::Set(&_msg, _pose);
+    _changed = true;
+  }
+}
+
+/// \brief Refresh the poses of a model message of the scene snapshot, and
+/// of its links and nested models.
+/// \param[in] _model The model.
+/// \param[in,out] _msg Message filled by Model::FillMsg.
+/// \param[in,out] _changed Set to true if the message changed.
+/// \return False if the links or nested models of the model changed, in
+/// which case the message must be filled again.
+static bool RefreshScenePoses(const Model &_model, msgs::Model &_msg,
+    bool &_changed)
+{
+  const Link_V &links = _model.GetLinks();
+  const Model_V &nested = _model.NestedModels();
+  if (static_cast<int>(links.size()) != _msg.link_size() ||
+      static_cast<int>(nested.size()) != _msg.model_size())
+  {
+    return false;
+  }
+
+  const ignition::math::Pose3d pose = _model.RelativePose();
+  SetScenePose(pose, *_msg.mutable_pose(), _changed);
+  if (_msg.visual_size() > 0)
+    SetScenePose(pose, *_msg.mutable_visual(0)->mutable_pose(), _changed);
+
+  for (size_t i = 0; i < links.size(); ++i)
+  {
+    msgs::Link &linkMsg = *_msg.mutable_link(i);
+    if (linkMsg.id() != links[i]->GetId())
+      return false;
+
+    const ignition::math::Pose3d linkPose = links[i]->RelativePose();
+    SetScenePose(linkPose, *linkMsg.mutable_pose(), _changed);
+    if (linkMsg.visual_size() > 0)
+    {
+      SetScenePose(linkPose, *linkMsg.mutable_visual(0)->mutable_pose(),
+          _changed);
+    }
+  }
+
+  for (size_t i = 0; i < nested.size(); ++i)
+  {
+    if (!RefreshScenePoses(*nested[i], *_msg.mutable_model(i), _changed))
+      return false;
+  }
+  return true;
+}
+
+/// \brief Append the models of an entity and of its descendants to the
+/// scene snapshot. Entries of the previous snapshot are reused unless
+/// their model was marked dirty or changed its links or nested models.
+/// \param[in] _entity The entity.
+/// \param[in,out] _data World data holding the previous snapshot entries.
+/// \param[in,out] _models Entries of the new snapshot, by model id.
+/// \param[in,out] _out Serialized scene to append to.
+static void AppendSceneModels(const BasePtr &_entity, WorldPrivate &_data,
+    std::unordered_map<uint32_t, SceneModelEntry> &_models,
+    std::string &_out)
+{
+  if (_entity->HasType(Entity::MODEL))
+  {
+    const ModelPtr model = boost::static_pointer_cast<Model>(_entity);
+    const uint32_t id = model->GetId();
+
+    SceneModelEntry entry;
+    auto cached = _data.sceneModels.find(id);
+    bool fill = cached == _data.sceneModels.end() ||
+        _data.sceneDirtyModels.count(id) > 0;
+    if (!fill)
+    {
+      entry = std::move(cached->second);
+      bool changed = false;
+      fill = !RefreshScenePoses(*model, *entry.msg.mutable_model(0),
+          changed);
+      if (!fill && changed)
+        entry.msg.SerializePartialToString(&entry.data);
+    }
+
+    if (fill)
+    {
+      entry.msg.Clear();
+      model->FillMsg(*entry.msg.add_model());
+      entry.msg.SerializePartialToString(&entry.data);
+    }
+
+    _out += entry.data;
+    _models[id] = std::move(entry);
+  }
+
+  for (unsigned int i = 0; i < _entity->GetChildCount(); ++i)
+    AppendSceneModels(_entity->GetChild(i), _data, _models, _out);
+}
+
+/// \brief Collect the mesh files and plugin libraries used by an element
+/// and its descendants.
+/// \param[in] _elem The element.
+/// \param[out] _meshes Mesh filenames, as MeshShape gives them to the mesh
+/// manager.
+/// \param[out] _plugins Plugin library filenames.
+static void CollectLoadFiles(const sdf::ElementPtr &_elem,
+    std::vector<std::string> &_meshes, std::vector<std::string> &_plugins)
+{
+  if (_elem->GetName() == "mesh" && _elem->HasElement("uri"))
+  {
+    const std::string uri = common::asFullPath(
+        _elem->Get<std::string>("uri"), _elem->FilePath());
+    const std::string filename = common::find_file(uri);
+    if (!filename.empty())
+      _meshes.push_back(filename);
+  }
+  else if (_elem->GetName() == "plugin" && _elem->HasAttribute("filename"))
+  {
+    _plugins.push_back(_elem->Get<std::string>("filename"));
+  }
+
+  for (sdf::ElementPtr child = _elem->GetFirstElement(); child;
+       child = child->GetNextElement())
+  {
+    CollectLoadFiles(child, _meshes, _plugins);
+  }
+}
+
+/// \brief Write a state captured by the log worker as a log frame.
+/// \param[in] _logState The state.
+/// \param[out] _stream Stream to write to.
+static void WriteLogState(const WorldLogState &_logState,
+    std::ostream &_stream)
+{
+  _stream << "<sdf version='" << SDF_VERSION << "'>";
+  if (_logState.delta)
+    _stream << util::LogRecord::DeltaFrameMarker();
+  _stream << _logState.digest << _logState.state << "</sdf>";
+}
+
+/// \brief Get the log marker of the last state digest.
+/// \param[in] _data The world data.
+/// \return The marker, empty if no digest was computed.
+static std::string StateDigestMarker(WorldPrivate &_data)
+{
+  std::lock_guard<std::mutex> lock(_data.stateDigestMutex);
+  if (_data.stateDigestIterations == 0)
+    return std::string();
+  return util::LogRecord::DigestFrameMarker(_data.stateDigestIterations,
+      _data.stateDigest);
+}
+
+/// \brief Drop or regenerate the visual elements of the SDF of all the
+/// models, see World::SetCompactSDFEnabled.
+/// \param[in] _data The world data.
+/// \param[in] _compact True to drop the elements, false to regenerate
+/// them.
+static void SetModelsCompactSDF(WorldPrivate &_data, const bool _compact)
+{
+  for (auto const &model : _data.models)
+  {
+    if (!model)
+      continue;
+    if (_compact)
+      model->CompactSDF();
+    else
+      model->ExpandSDF();
+  }
+}
+
 //////////////////////////////////////////////////
 World::World(const std::string &_name)
   : dataPtr(new WorldPrivate)
@@ -290,9 +644,19 @@ void World::Load(sdf::ElementPtr _sdf)
 
   this->dataPtr->responsePub = this->dataPtr->node->Advertise<msgs::Response>(
       "~/response");
+  this->dataPtr->factoryResponsePub =
+    this->dataPtr->node->Advertise<msgs::Response>("~/factory/response");
   this->dataPtr->statPub =
     this->dataPtr->node->Advertise<msgs::WorldStatistics>(
         "~/world_stats", 100, 5);
+  this->dataPtr->transportStatsPub =
+    this->dataPtr->node->Advertise<msgs::TransportStatistics>(
+        "~/transport/stats", 1, 1);
+  this->dataPtr->breakdownPub =
+    this->dataPtr->node->Advertise<msgs::WorldStatisticsBreakdown>(
+        "~/world_stats/breakdown", 1, 1);
+  this->dataPtr->stateDigestPub =
+    this->dataPtr->node->Advertise<msgs::StateDigest>("~/state_digest");
   this->dataPtr->modelPub = this->dataPtr->node->Advertise<msgs::Model>(
       "~/model/info");
   this->dataPtr->lightPub = this->dataPtr->node->Advertise<msgs::Light>(
@@ -357,6 +721,17 @@ void World::Load(sdf::ElementPtr _sdf)
 
   this->dataPtr->wind->Load(windElem);
 
+  // The batteries of the models register while they load
+  this->dataPtr->batterySystem.reset(new BatterySystem(*this));
+  {
+    const std::string kElementName = "ignition:battery_update_rate";
+    if (this->dataPtr->sdf->HasElement(kElementName))
+    {
+      this->dataPtr->batterySystem->SetUpdateRate(
+          this->dataPtr->sdf->Get<double>(kElementName));
+    }
+  }
+
   // This should come after loading physics engine
   sdf::ElementPtr atmosphereElem = this->dataPtr->sdf->GetElement("atmosphere");
 
@@ -392,6 +767,30 @@ void World::Load(sdf::ElementPtr _sdf)
   this->dataPtr->rootElement->SetName(this->Name());
   this->dataPtr->rootElement->SetWorld(shared_from_this());
 
+  // Prefetch the meshes and plugin libraries concurrently. The entities
+  // are still created one by one below, in the order of the SDF.
+  {
+    const std::string kElementName = "ignition:load_threads";
+    if (this->dataPtr->sdf->HasElement(kElementName))
+    {
+      this->dataPtr->loadThreads =
+        this->dataPtr->sdf->Get<unsigned int>(kElementName);
+    }
+
+    if (this->dataPtr->loadThreads > 1)
+    {
+      std::vector<std::string> meshes;
+      std::vector<std::string> plugins;
+      CollectLoadFiles(this->dataPtr->sdf, meshes, plugins);
+
+      // The plugins find their libraries in the cache when they load
+      common::PluginLibraryCache::Instance()->Preload(plugins);
+
+      common::MeshManager::Instance()->Preload(meshes,
+          this->dataPtr->loadThreads);
+    }
+  }
+
   // A special order is necessary when loading a world that contains state
   // information. The joints must be created last, otherwise they get
   // initialized improperly.
@@ -403,13 +802,143 @@ void World::Load(sdf::ElementPtr _sdf)
       this->ModelByIndex(i)->LoadJoints();
   }
 
-  // TODO: Performance test to see if TBB model updating is necessary
-  // Choose threaded or unthreaded model updating depending on the number of
-  // models in the scene
-  // if (this->ModelCount() < 20)
-  this->dataPtr->modelUpdateFunc = &World::ModelUpdateSingleLoop;
-  // else
-  // this->dataPtr->modelUpdateFunc = &World::ModelUpdateTBB;
+  // Choose threaded or unthreaded model updating. Models are updated in a
+  // single loop unless more than one model update thread is requested.
+  {
+    const std::string kElementName = "ignition:model_update_threads";
+    unsigned int modelUpdateThreads = 0;
+    if (this->dataPtr->sdf->HasElement(kElementName))
+    {
+      modelUpdateThreads =
+        this->dataPtr->sdf->Get<unsigned int>(kElementName);
+    }
+    this->SetModelUpdateThreads(modelUpdateThreads);
+  }
+
+  // Throughput mode for batch simulation.
+  {
+    const std::string kModeElement = "ignition:throughput_mode";
+    if (this->dataPtr->sdf->HasElement(kModeElement))
+    {
+      this->SetThroughputMode(
+          this->dataPtr->sdf->Get<bool>(kModeElement));
+    }
+
+    const std::string kPeriodElement = "ignition:message_period";
+    if (this->dataPtr->sdf->HasElement(kPeriodElement))
+    {
+      this->SetMessagePeriod(
+          this->dataPtr->sdf->Get<unsigned int>(kPeriodElement));
+    }
+  }
+
+  // Names may be left out of the pose messages when all subscribers
+  // identify entities by id.
+  {
+    const std::string kElementName = "ignition:publish_pose_names";
+    if (this->dataPtr->sdf->HasElement(kElementName))
+    {
+      this->SetPublishPoseNames(
+          this->dataPtr->sdf->Get<bool>(kElementName));
+    }
+  }
+
+  // A digest of the state may be computed after every step, to compare
+  // runs.
+  {
+    const std::string kElementName = "ignition:state_digest";
+    if (this->dataPtr->sdf->HasElement(kElementName))
+    {
+      this->SetStateDigestEnabled(
+          this->dataPtr->sdf->Get<bool>(kElementName));
+    }
+  }
+
+  // The visual elements of the models may be dropped after load.
+  {
+    const std::string kElementName = "ignition:compact_sdf";
+    if (this->dataPtr->sdf->HasElement(kElementName))
+    {
+      this->SetCompactSDFEnabled(
+          this->dataPtr->sdf->Get<bool>(kElementName));
+    }
+  }
+
+  // Factory messages may be read on a worker thread.
+  {
+    const std::string kElementName = "ignition:async_factory";
+    if (this->dataPtr->sdf->HasElement(kElementName))
+    {
+      this->SetAsyncFactory(
+          this->dataPtr->sdf->Get<bool>(kElementName));
+    }
+  }
+
+  // The step size may adapt to the simulation, within bounds.
+  {
+    const double stepSize = this->dataPtr->physicsEngine->GetMaxStepSize();
+    double minStepSize = 0.1 * stepSize;
+    double maxStepSize = 4.0 * stepSize;
+
+    const std::string kMinElement = "ignition:adaptive_min_step_size";
+    if (this->dataPtr->sdf->HasElement(kMinElement))
+      minStepSize = this->dataPtr->sdf->Get<double>(kMinElement);
+
+    const std::string kMaxElement = "ignition:adaptive_max_step_size";
+    if (this->dataPtr->sdf->HasElement(kMaxElement))
+      maxStepSize = this->dataPtr->sdf->Get<double>(kMaxElement);
+
+    if (stepSize > 0 || minStepSize > 0)
+      this->dataPtr->stepController.SetBounds(minStepSize, maxStepSize);
+
+    const std::string kVelocityElement =
+      "ignition:adaptive_velocity_tolerance";
+    if (this->dataPtr->sdf->HasElement(kVelocityElement))
+    {
+      this->dataPtr->stepController.SetVelocityTolerance(
+          this->dataPtr->sdf->Get<double>(kVelocityElement));
+    }
+
+    const std::string kPenetrationElement =
+      "ignition:adaptive_penetration_tolerance";
+    if (this->dataPtr->sdf->HasElement(kPenetrationElement))
+    {
+      this->dataPtr->stepController.SetPenetrationTolerance(
+          this->dataPtr->sdf->Get<double>(kPenetrationElement));
+    }
+
+    const std::string kElementName = "ignition:adaptive_step";
+    if (this->dataPtr->sdf->HasElement(kElementName))
+    {
+      this->SetAdaptiveStep(
+          this->dataPtr->sdf->Get<bool>(kElementName));
+    }
+  }
+
+  // The steps may be paced with absolute deadlines, for hardware in the
+  // loop runs.
+  {
+    const std::string kSpinElement = "ignition:real_time_spin";
+    if (this->dataPtr->sdf->HasElement(kSpinElement))
+    {
+      this->dataPtr->pacer.SetSpinTime(
+          this->dataPtr->sdf->Get<double>(kSpinElement));
+    }
+
+    const std::string kPriorityElement = "ignition:real_time_priority";
+    if (this->dataPtr->sdf->HasElement(kPriorityElement))
+    {
+      this->SetRealTimePriority(
+          this->dataPtr->sdf->Get<int>(kPriorityElement));
+    }
+
+    const std::string kElementName = "ignition:real_time_pacing";
+    if (this->dataPtr->sdf->HasElement(kElementName))
+    {
+      this->SetRealTimePacing(
+          this->dataPtr->sdf->Get<bool>(kElementName));
+    }
+  }
 
   event::Events::worldCreated(this->Name());
 
@@ -483,9 +1012,6 @@ void World::Init(UpdateScenePosesFunc _func)
   this->dataPtr->presetManager = PresetManagerPtr(
       new PresetManager(this->dataPtr->physicsEngine, this->dataPtr->sdf));
 
-  this->dataPtr->testRay = boost::dynamic_pointer_cast<RayShape>(
-      this->Physics()->CreateShape("ray", CollisionPtr()));
-
   this->dataPtr->prevStates[0].SetWorld(shared_from_this());
   this->dataPtr->prevStates[1].SetWorld(shared_from_this());
 
@@ -530,6 +1056,9 @@ void World::Init(UpdateScenePosesFunc _func)
 
   this->dataPtr->updateScenePoses = _func;
 
+  // Connecting clients are served this snapshot until the world updates.
+  this->UpdateSceneSnapshot();
+
   this->dataPtr->initialized = true;
 
   // Mark the world initialization
@@ -586,6 +1115,7 @@ void World::Stop()
 //////////////////////////////////////////////////
 void World::RunLoop()
 {
+  common::ThreadConfig::Instance()->Apply("world");
   this->dataPtr->physicsEngine->InitForThread();
 
   this->dataPtr->startTime = common::Time::GetWallTime();
@@ -625,6 +1155,11 @@ void World::RunLoop()
   }
 
   this->dataPtr->stop = true;
+  {
+    std::lock_guard<std::recursive_mutex> lock(
+        this->dataPtr->worldUpdateMutex);
+    this->dataPtr->stepCondition.notify_all();
+  }
 
   if (this->dataPtr->logThread)
   {
@@ -642,16 +1177,48 @@ void World::RunLoop()
 //////////////////////////////////////////////////
 void World::LogStep()
 {
+  this->dataPtr->stepCosts.Start();
   {
     std::lock_guard<std::recursive_mutex> lk(this->dataPtr->worldUpdateMutex);
+    this->dataPtr->stepCosts.Lap(STEP_UPDATE_LOCK);
 
     if (!this->IsPaused() || this->dataPtr->stepInc != 0)
     {
       if (!this->IsPaused() && this->dataPtr->stepInc == 0)
         this->dataPtr->stepInc = 1;
 
+      // Fast-forward when stepping several frames, or when playing faster
+      // than real time: only the last state of each interval is played.
+      const bool fastForward = !this->dataPtr->logPlayResync &&
+          (this->dataPtr->stepInc > 1 || (this->dataPtr->stepInc == 1 &&
+           !this->IsPaused() && this->dataPtr->logPlayRealTimeFactor > 1.0 &&
+           this->dataPtr->logLastStatePlayedRealTime != common::Time(0)));
+
       std::string data;
-      if (!util::LogPlay::Instance()->Step(this->dataPtr->stepInc, data))
+      std::vector<std::string> skipped;
+      unsigned int steps = 1;
+      if (fastForward)
+      {
+        unsigned int maxSteps = 0;
+        common::Time until = common::Time::Maximum();
+        if (this->dataPtr->stepInc > 1)
+          maxSteps = this->dataPtr->stepInc;
+        else
+        {
+          const common::Time elapsed = std::max(kLogPlayFastForwardPeriod,
+              common::Time::GetWallTime() -
+              this->dataPtr->logLastStatePlayedRealTime);
+          until = this->dataPtr->logLastStatePlayedSimTime +
+              common::Time(elapsed.Double() *
+                  this->dataPtr->logPlayRealTimeFactor);
+        }
+        steps = util::LogPlay::Instance()->FastForward(maxSteps, until, data,
+            skipped);
+      }
+      else if (!util::LogPlay::Instance()->Step(this->dataPtr->stepInc, data))
+        steps = 0;
+
+      if (steps == 0)
       {
         // There are no more chunks, time to exit.
         this->SetPaused(true);
@@ -659,6 +1226,9 @@ void World::LogStep()
       }
       else
       {
+        const bool resync = !fastForward && (this->dataPtr->logPlayResync ||
+            this->dataPtr->stepInc != 1);
+        this->dataPtr->logPlayResync = false;
         this->dataPtr->stepInc = 1;
 
         this->dataPtr->logPlayStateSDF->Clear();
@@ -666,6 +1236,46 @@ void World::LogStep()
 
         this->dataPtr->logPlayState.Load(this->dataPtr->logPlayStateSDF);
 
+        // The skipped frames that the state depends on are merged into it,
+        // without setting the state of each of them. Entities are inserted
+        // and deleted in the order they were recorded.
+        if (!skipped.empty())
+        {
+          WorldState state;
+          for (auto const &frame : skipped)
+          {
+            this->dataPtr->logPlayStateSDF->Clear();
+            sdf::readString(frame, this->dataPtr->logPlayStateSDF);
+            state.Merge(WorldState(this->dataPtr->logPlayStateSDF));
+            if (!state.Insertions().empty() || !state.Deletions().empty())
+            {
+              this->SetState(state);
+              state = WorldState();
+            }
+          }
+          state.Merge(this->dataPtr->logPlayState);
+          this->dataPtr->logPlayState = state;
+        }
+
+        // A delta frame only has the models and lights that changed since
+        // the frame before it. If that frame was not the last one played,
+        // the state is rebuilt from the keyframe of the delta frame.
+        if (resync && util::LogPlay::IsDeltaFrame(data))
+        {
+          std::vector<std::string> frames;
+          if (util::LogPlay::Instance()->FramesSinceKeyframe(frames))
+          {
+            WorldState state;
+            for (auto const &frame : frames)
+            {
+              this->dataPtr->logPlayStateSDF->Clear();
+              sdf::readString(frame, this->dataPtr->logPlayStateSDF);
+              state.Merge(WorldState(this->dataPtr->logPlayStateSDF));
+            }
+            this->dataPtr->logPlayState = state;
+          }
+        }
+
         // If it's the first step, we're going back in time or
         // rt factor is close to zero, don't sleep.
         if ((this->dataPtr->logPlayRealTimeFactor > 1e-5) &&
@@ -693,24 +1303,63 @@ void World::LogStep()
         if (!util::LogPlay::Instance()->HasIterations())
         {
           this->dataPtr->logPlayState.SetIterations(
-            this->dataPtr->iterations + 1);
+            this->dataPtr->iterations + steps);
+        }
+
+        // Publish the messages recorded since the previous state. None are
+        // published when jumping in the log.
+        if (!resync && util::LogPlay::Instance()->HasTopics())
+        {
+          this->PublishLogTopics(this->dataPtr->logLastStatePlayedSimTime,
+              this->dataPtr->logPlayState.GetSimTime());
         }
 
         this->dataPtr->logLastStatePlayedRealTime = common::Time::GetWallTime();
         this->dataPtr->logLastStatePlayedSimTime =
             this->dataPtr->logPlayState.GetSimTime();
         this->SetState(this->dataPtr->logPlayState);
+        this->dataPtr->stepCosts.Lap(STEP_LOG_PLAYBACK);
         this->Update();
       }
 
       if (this->dataPtr->stepInc > 0)
         this->dataPtr->stepInc--;
     }
+    this->dataPtr->stepCondition.notify_all();
   }
+  this->dataPtr->stepCosts.Lap(STEP_LOG_PLAYBACK);
 
   this->PublishWorldStats();
+  this->dataPtr->stepCosts.Lap(STEP_PUBLISH_STATS);
 
   this->ProcessMessages();
+  this->dataPtr->stepCosts.Lap(STEP_PROCESS_MESSAGES);
+}
+
+//////////////////////////////////////////////////
+void World::PublishLogTopics(const common::Time &_from,
+    const common::Time &_to)
+{
+  std::vector<util::LogPlayMessage> recorded;
+  if (!util::LogPlay::Instance()->TopicMessages(_from, _to, recorded))
+    return;
+
+  for (auto const &msg : recorded)
+  {
+    auto &pub = this->dataPtr->logPlayTopicPubs[msg.topic];
+    if (!pub)
+      pub = this->dataPtr->node->Advertise(msg.topic, msg.type);
+
+    boost::shared_ptr<google::protobuf::Message> protoMsg =
+      msgs::MsgFactory::NewMsg(msg.type);
+    if (!protoMsg || !protoMsg->ParseFromString(msg.data))
+    {
+      gzwarn << "Unable to play a recorded message of type[" << msg.type
+        << "] on topic[" << msg.topic << "]\n";
+      continue;
+    }
+    pub->Publish(*protoMsg);
+  }
 }
 
 //////////////////////////////////////////////////
@@ -737,10 +1386,13 @@ void World::Step()
   DIAG_TIMER_START("World::Step");
 
   IGN_PROFILE("World::Step");
+  GZ_TRACE_SCOPE("physics::World::Step");
+  this->dataPtr->stepCosts.Start();
 
   IGN_PROFILE_BEGIN("lockMutex");
   std::lock_guard<std::mutex> lock(this->dataPtr->stepMutex);
   IGN_PROFILE_END();
+  this->dataPtr->stepCosts.Lap(STEP_LOCK);
 
   IGN_PROFILE_BEGIN("loadPlugins");
   /// need this because ODE does not call dxReallocateWorldProcessContext()
@@ -754,12 +1406,26 @@ void World::Step()
   }
 
   IGN_PROFILE_END();
+  this->dataPtr->stepCosts.Lap(STEP_LOAD_PLUGINS);
   DIAG_TIMER_LAP("World::Step", "loadPlugins");
 
+  // In throughput mode a running world skips wall clock throttling. When
+  // paused it falls through to the throttled path below, so that it does
+  // not spin.
+  if (this->dataPtr->throughputMode &&
+      (!this->IsPaused() || this->dataPtr->stepInc > 0 ||
+       this->dataPtr->needsReset))
+  {
+    this->ThroughputStep();
+    DIAG_TIMER_STOP("World::Step");
+    return;
+  }
+
   IGN_PROFILE_BEGIN("publishWorldStats");
   // Send statistics about the world simulation
   this->PublishWorldStats();
   IGN_PROFILE_END();
+  this->dataPtr->stepCosts.Lap(STEP_PUBLISH_STATS);
 
   DIAG_TIMER_LAP("World::Step", "publishWorldStats");
 
@@ -768,37 +1434,60 @@ void World::Step()
     this->dataPtr->waitForSensors(this->dataPtr->simTime.Double(),
         this->dataPtr->physicsEngine->GetMaxStepSize());
   IGN_PROFILE_END();
+  this->dataPtr->stepCosts.Lap(STEP_WAIT_SENSORS);
+
+  // The scheduling policy is set by the thread it applies to
+  if (this->dataPtr->realTimePriorityPending.exchange(false) &&
+      !common::RealTimePacer::SetRealTimePriority(
+        this->dataPtr->realTimePriority))
+  {
+    gzwarn << "Unable to schedule the world thread with SCHED_FIFO priority["
+           << this->dataPtr->realTimePriority << "], the CAP_SYS_NICE "
+           << "capability or an rtprio limit may be missing.\n";
+  }
 
   IGN_PROFILE_BEGIN("sleepOffset");
   double updatePeriod = this->dataPtr->physicsEngine->GetUpdatePeriod();
-  // sleep here to get the correct update rate
-  common::Time tmpTime = common::Time::GetWallTime();
-  common::Time sleepTime = this->dataPtr->prevStepWallTime +
-    common::Time(updatePeriod) - tmpTime - this->dataPtr->sleepOffset;
-
-  common::Time actualSleep;
-  if (sleepTime > 0)
+  if (this->dataPtr->realTimePacing)
   {
-    common::Time::Sleep(sleepTime);
-    actualSleep = common::Time::GetWallTime() - tmpTime;
+    // Wait for an absolute deadline, the sleep error isn't carried over
+    this->dataPtr->pacer.Wait(updatePeriod);
   }
   else
-    sleepTime = 0;
+  {
+    // sleep here to get the correct update rate
+    common::Time tmpTime = common::Time::GetWallTime();
+    common::Time sleepTime = this->dataPtr->prevStepWallTime +
+      common::Time(updatePeriod) - tmpTime - this->dataPtr->sleepOffset;
+
+    common::Time actualSleep;
+    if (sleepTime > 0)
+    {
+      common::Time::Sleep(sleepTime);
+      actualSleep = common::Time::GetWallTime() - tmpTime;
+    }
+    else
+      sleepTime = 0;
 
-  // exponentially avg out
-  this->dataPtr->sleepOffset = (actualSleep - sleepTime) * 0.01 +
-                      this->dataPtr->sleepOffset * 0.99;
+    // exponentially avg out
+    this->dataPtr->sleepOffset = (actualSleep - sleepTime) * 0.01 +
+                        this->dataPtr->sleepOffset * 0.99;
+  }
 
   IGN_PROFILE_END();
+  this->dataPtr->stepCosts.Lap(STEP_SLEEP);
   DIAG_TIMER_LAP("World::Step", "sleepOffset");
 
   IGN_PROFILE_BEGIN("worldUpdateMutex");
   // throttling update rate, with sleepOffset as tolerance
-  // the tolerance is needed as the sleep time is not exact
-  if (common::Time::GetWallTime() - this->dataPtr->prevStepWallTime +
+  // the tolerance is needed as the sleep time is not exact. The pacer has
+  // already waited for the deadline of the step.
+  if (this->dataPtr->realTimePacing ||
+      common::Time::GetWallTime() - this->dataPtr->prevStepWallTime +
       this->dataPtr->sleepOffset >= common::Time(updatePeriod))
   {
     std::lock_guard<std::recursive_mutex> lock(this->dataPtr->worldUpdateMutex);
+    this->dataPtr->stepCosts.Lap(STEP_UPDATE_LOCK);
 
     DIAG_TIMER_LAP("World::Step", "worldUpdateMutex");
 
@@ -810,7 +1499,7 @@ void World::Step()
         || this->dataPtr->needsReset)
     {
       // query timestep to allow dynamic time step size updates
-      this->dataPtr->simTime += stepTime;
+      this->dataPtr->simTime += common::SimTimeNs::FromSeconds(stepTime);
       this->dataPtr->iterations++;
       this->Update();
 
@@ -818,6 +1507,7 @@ void World::Step()
 
       if (this->IsPaused() && this->dataPtr->stepInc > 0)
         this->dataPtr->stepInc--;
+      this->dataPtr->stepCondition.notify_all();
     }
     else
     {
@@ -832,10 +1522,12 @@ void World::Step()
   IGN_PROFILE_BEGIN("IntrospectionManager->NotifyUpdates");
   gazebo::util::IntrospectionManager::Instance()->NotifyUpdates();
   IGN_PROFILE_END();
+  this->dataPtr->stepCosts.Lap(STEP_INTROSPECTION);
 
   IGN_PROFILE_BEGIN("ProcessMessages");
   this->ProcessMessages();
   IGN_PROFILE_END();
+  this->dataPtr->stepCosts.Lap(STEP_PROCESS_MESSAGES);
 
   DIAG_TIMER_STOP("World::Step");
 
@@ -843,6 +1535,7 @@ void World::Step()
   if (g_clearModels)
     this->ClearModels();
   IGN_PROFILE_END();
+  this->dataPtr->stepCosts.Lap(STEP_CLEAR_MODELS);
 }
 
 //////////////////////////////////////////////////
@@ -854,38 +1547,579 @@ void World::Step(const unsigned int _steps)
     this->SetPaused(true);
   }
 
-  {
-    std::lock_guard<std::recursive_mutex> lock(this->dataPtr->worldUpdateMutex);
-    this->dataPtr->stepInc = _steps;
-  }
+  std::unique_lock<std::recursive_mutex> lock(
+      this->dataPtr->worldUpdateMutex);
+  this->dataPtr->stepInc = _steps;
 
-  // block on completion
-  bool wait = true;
-  while (wait)
+  // block on completion, woken by the run loop after each step. The
+  // timeout covers a stop flag set without the lock.
+  while (this->dataPtr->stepInc != 0 && !this->dataPtr->stop)
   {
-    common::Time::NSleep(1);
-    std::lock_guard<std::recursive_mutex> lock(this->dataPtr->worldUpdateMutex);
-    if (this->dataPtr->stepInc == 0 || this->dataPtr->stop)
-      wait = false;
+    this->dataPtr->stepCondition.wait_for(lock,
+        std::chrono::milliseconds(10));
   }
 }
 
 //////////////////////////////////////////////////
-void World::Update()
+void World::ThroughputStep()
 {
-  DIAG_TIMER_START("World::Update");
+  if (this->dataPtr->waitForSensors)
+  {
+    this->dataPtr->waitForSensors(this->dataPtr->simTime.Double(),
+        this->dataPtr->physicsEngine->GetMaxStepSize());
+  }
+  this->dataPtr->stepCosts.Lap(STEP_WAIT_SENSORS);
 
-  IGN_PROFILE("World::Update");
-  IGN_PROFILE_BEGIN("needsReset");
-  if (this->dataPtr->needsReset)
   {
-    if (this->dataPtr->resetAll)
+    std::lock_guard<std::recursive_mutex> lock(this->dataPtr->worldUpdateMutex);
+    this->dataPtr->stepCosts.Lap(STEP_UPDATE_LOCK);
+
+    this->dataPtr->simTime += common::SimTimeNs::FromSeconds(
+        this->dataPtr->physicsEngine->GetMaxStepSize());
+    this->dataPtr->iterations++;
+    this->Update();
+
+    if (this->IsPaused() && this->dataPtr->stepInc > 0)
+      this->dataPtr->stepInc--;
+    this->dataPtr->stepCondition.notify_all();
+  }
+
+  // Everything that does not advance the simulation is only done once per
+  // message period.
+  if (++this->dataPtr->throughputCount >= this->dataPtr->messagePeriod)
+  {
+    this->dataPtr->throughputCount = 0;
+
+    IGN_PROFILE_BEGIN("publishWorldStats");
+    this->PublishWorldStats();
+    IGN_PROFILE_END();
+    this->dataPtr->stepCosts.Lap(STEP_PUBLISH_STATS);
+
+    IGN_PROFILE_BEGIN("IntrospectionManager->NotifyUpdates");
+    gazebo::util::IntrospectionManager::Instance()->NotifyUpdates();
+    IGN_PROFILE_END();
+    this->dataPtr->stepCosts.Lap(STEP_INTROSPECTION);
+
+    IGN_PROFILE_BEGIN("ProcessMessages");
+    this->ProcessMessages();
+    IGN_PROFILE_END();
+    this->dataPtr->stepCosts.Lap(STEP_PROCESS_MESSAGES);
+  }
+
+  if (g_clearModels)
+    this->ClearModels();
+  this->dataPtr->stepCosts.Lap(STEP_CLEAR_MODELS);
+}
+
+//////////////////////////////////////////////////
+bool World::ThroughputMode() const
+{
+  return this->dataPtr->throughputMode;
+}
+
+//////////////////////////////////////////////////
+void World::SetThroughputMode(const bool _enable)
+{
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->worldUpdateMutex);
+  this->dataPtr->throughputMode = _enable;
+  this->dataPtr->throughputCount = 0;
+}
+
+//////////////////////////////////////////////////
+unsigned int World::MessagePeriod() const
+{
+  return this->dataPtr->messagePeriod;
+}
+
+//////////////////////////////////////////////////
+void World::SetMessagePeriod(const unsigned int _steps)
+{
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->worldUpdateMutex);
+  this->dataPtr->messagePeriod = std::max(1u, _steps);
+}
+
+//////////////////////////////////////////////////
+uint64_t World::StateDigest() const
+{
+  // The buffers are kept by each thread, so that the digest of every step
+  // doesn't allocate.
+  thread_local std::vector<const Link *> links;
+  thread_local std::vector<const Joint *> joints;
+  thread_local std::vector<const Model *> models;
+  thread_local std::vector<double> values;
+  links.clear();
+  joints.clear();
+  models.clear();
+  values.clear();
+
+  for (auto const &model : this->dataPtr->models)
+    models.push_back(model.get());
+  for (size_t i = 0; i < models.size(); ++i)
+  {
+    for (auto const &link : models[i]->GetLinks())
+      links.push_back(link.get());
+    for (auto const &joint : models[i]->GetJoints())
+      joints.push_back(joint.get());
+    for (auto const &nested : models[i]->NestedModels())
+      models.push_back(nested.get());
+  }
+
+  auto byId = [](const Base *_a, const Base *_b)
+  {
+    return _a->GetId() < _b->GetId();
+  };
+  std::sort(links.begin(), links.end(), byId);
+  std::sort(joints.begin(), joints.end(), byId);
+
+  values.reserve(links.size() * 14);
+  for (const Link *link : links)
+  {
+    const ignition::math::Pose3d &pose = link->WorldPose();
+    const ignition::math::Vector3d linearVel = link->WorldLinearVel();
+    const ignition::math::Vector3d angularVel = link->WorldAngularVel();
+    values.insert(values.end(), {static_cast<double>(link->GetId()),
+        pose.Pos().X(), pose.Pos().Y(), pose.Pos().Z(),
+        pose.Rot().W(), pose.Rot().X(), pose.Rot().Y(), pose.Rot().Z(),
+        linearVel.X(), linearVel.Y(), linearVel.Z(),
+        angularVel.X(), angularVel.Y(), angularVel.Z()});
+  }
+
+  for (const Joint *joint : joints)
+  {
+    values.push_back(static_cast<double>(joint->GetId()));
+    for (unsigned int i = 0; i < joint->DOF(); ++i)
+    {
+      values.push_back(joint->Position(i));
+      values.push_back(joint->GetVelocity(i));
+    }
+  }
+
+  StateHasher hasher;
+  hasher.Add(values.data(), values.size());
+  return hasher.Digest();
+}
+
+//////////////////////////////////////////////////
+bool World::StateDigestEnabled() const
+{
+  return this->dataPtr->stateDigestEnabled;
+}
+
+//////////////////////////////////////////////////
+void World::SetStateDigestEnabled(const bool _enable)
+{
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->worldUpdateMutex);
+  this->dataPtr->stateDigestEnabled = _enable;
+  if (!_enable)
+  {
+    // The log frames stop carrying a digest.
+    std::lock_guard<std::mutex> digestLock(this->dataPtr->stateDigestMutex);
+    this->dataPtr->stateDigestIterations = 0;
+  }
+}
+
+//////////////////////////////////////////////////
+bool World::SensorOffloadEnabled() const
+{
+  return this->dataPtr->sensorOffload;
+}
+
+//////////////////////////////////////////////////
+void World::SetSensorOffloadEnabled(const bool _enable)
+{
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->worldUpdateMutex);
+  this->dataPtr->sensorOffload = _enable;
+  if (_enable && !this->dataPtr->sensorOffloadPub)
+  {
+    this->dataPtr->sensorOffloadPub =
+        this->dataPtr->ignNode.Advertise<msgs::PosesStamped>(
+        "/gazebo/" + this->Name() + "/sensor_offload/state");
+  }
+}
+
+//////////////////////////////////////////////////
+bool World::SensorOffloadFollower() const
+{
+  return this->dataPtr->sensorOffloadFollower;
+}
+
+//////////////////////////////////////////////////
+void World::SetSensorOffloadFollower(const bool _enable)
+{
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->worldUpdateMutex);
+  if (_enable == this->dataPtr->sensorOffloadFollower)
+    return;
+
+  this->dataPtr->sensorOffloadFollower = _enable;
+  const std::string topic = "/gazebo/" + this->Name() +
+      "/sensor_offload/state";
+  if (_enable)
+  {
+    // The poses and the sim time only come from the primary
+    this->SetPaused(true);
+    this->SetPhysicsEnabled(false);
+    if (!this->dataPtr->ignNode.Subscribe(topic,
+        &World::OnSensorOffload, this))
+    {
+      gzerr << "Unable to subscribe to [" << topic << "]\n";
+    }
+  }
+  else
+  {
+    this->dataPtr->ignNode.Unsubscribe(topic);
+  }
+}
+
+//////////////////////////////////////////////////
+void World::PublishSensorOffload()
+{
+  msgs::PosesStamped &msg = this->dataPtr->sensorOffloadMsg;
+  msg.Clear();
+  msgs::Set(msg.mutable_time(), this->SimTime());
+  for (auto const &model : this->dataPtr->models)
+  {
+    if (model)
+      AddSensorOffloadPoses(*model, msg);
+  }
+  this->dataPtr->sensorOffloadPub.Publish(msg);
+}
+
+//////////////////////////////////////////////////
+void World::OnSensorOffload(const msgs::PosesStamped &_msg)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->sensorOffloadMutex);
+  this->dataPtr->sensorOffloadFrame = _msg;
+  this->dataPtr->sensorOffloadFrameNew = true;
+}
+
+//////////////////////////////////////////////////
+void World::ApplySensorOffload()
+{
+  msgs::PosesStamped frame;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->sensorOffloadMutex);
+    if (!this->dataPtr->sensorOffloadFrameNew)
+      return;
+    frame.Swap(&this->dataPtr->sensorOffloadFrame);
+    this->dataPtr->sensorOffloadFrameNew = false;
+  }
+
+  // The poses published below are stamped with the sim time of the
+  // primary, which the rendering sensors stamp their data with
+  this->SetSimTime(msgs::Convert(frame.time()));
+
+  // Models come before their links, which then get their exact pose
+  for (auto const &pose : frame.pose())
+  {
+    EntityPtr entity = this->EntityByName(pose.name());
+    if (entity)
+      entity->SetWorldPose(msgs::ConvertIgn(pose),
+          entity->HasType(Base::MODEL));
+  }
+}
+
+//////////////////////////////////////////////////
+bool World::CompactSDFEnabled() const
+{
+  return this->dataPtr->compactSDF;
+}
+
+//////////////////////////////////////////////////
+void World::SetCompactSDFEnabled(const bool _enable)
+{
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->worldUpdateMutex);
+  this->dataPtr->compactSDF = _enable;
+  if (_enable)
+    this->dataPtr->sdfCompactPending = true;
+  else
+    SetModelsCompactSDF(*this->dataPtr, false);
+}
+
+//////////////////////////////////////////////////
+void World::UpdateStateDigest()
+{
+  const uint64_t digest = this->StateDigest();
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->stateDigestMutex);
+    this->dataPtr->stateDigest = digest;
+    this->dataPtr->stateDigestIterations = this->dataPtr->iterations;
+  }
+
+  if (this->dataPtr->stateDigestPub &&
+      this->dataPtr->stateDigestPub->HasConnections())
+  {
+    msgs::StateDigest msg;
+    msgs::Set(msg.mutable_sim_time(), this->SimTime());
+    msg.set_iterations(this->dataPtr->iterations);
+    msg.set_digest(digest);
+    this->dataPtr->stateDigestPub->Publish(msg);
+  }
+}
+
+//////////////////////////////////////////////////
+bool World::AdaptiveStep() const
+{
+  return this->dataPtr->adaptiveStep;
+}
+
+//////////////////////////////////////////////////
+void World::SetAdaptiveStep(const bool _enable)
+{
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->worldUpdateMutex);
+  if (_enable == this->dataPtr->adaptiveStep)
+    return;
+
+  ContactManager *contactManager =
+    this->dataPtr->physicsEngine->GetContactManager();
+  if (_enable)
+  {
+    this->dataPtr->nominalStepSize =
+      this->dataPtr->physicsEngine->GetMaxStepSize();
+    this->dataPtr->nominalNeverDropContacts =
+      contactManager->NeverDropContacts();
+
+    // The contact depths are only known when the contacts are kept
+    contactManager->SetNeverDropContacts(true);
+  }
+  else
+  {
+    this->dataPtr->physicsEngine->SetMaxStepSize(
+        this->dataPtr->nominalStepSize);
+    contactManager->SetNeverDropContacts(
+        this->dataPtr->nominalNeverDropContacts);
+  }
+
+  this->dataPtr->linkVelocities.clear();
+  this->dataPtr->adaptiveStep = _enable;
+}
+
+//////////////////////////////////////////////////
+StepSizeController &World::StepController() const
+{
+  return this->dataPtr->stepController;
+}
+
+//////////////////////////////////////////////////
+bool World::RealTimePacing() const
+{
+  return this->dataPtr->realTimePacing;
+}
+
+//////////////////////////////////////////////////
+void World::SetRealTimePacing(const bool _enable)
+{
+  if (_enable == this->dataPtr->realTimePacing)
+    return;
+
+  // The first deadline is set by the next step
+  if (_enable)
+    this->dataPtr->pacer.Reset();
+  this->dataPtr->realTimePacing = _enable;
+}
+
+//////////////////////////////////////////////////
+common::RealTimePacer &World::Pacer() const
+{
+  return this->dataPtr->pacer;
+}
+
+//////////////////////////////////////////////////
+int World::RealTimePriority() const
+{
+  return this->dataPtr->realTimePriority;
+}
+
+//////////////////////////////////////////////////
+void World::SetRealTimePriority(const int _priority)
+{
+  this->dataPtr->realTimePriority = _priority;
+  this->dataPtr->realTimePriorityPending = _priority > 0;
+}
+
+//////////////////////////////////////////////////
+/// \brief Get the largest change of link velocity in a step that gravity
+/// does not explain, and store the new link velocities.
+/// \param[in] _model Model whose links, and nested models' links, to check.
+/// \param[in] _gravityChange Change of velocity due to gravity in the step.
+/// \param[in] _last Velocities of the links after the previous step.
+/// \param[out] _current Velocities of the links after this step.
+/// \return The largest change of velocity.
+static double VelocityChange(const ModelPtr &_model,
+    const ignition::math::Vector3d &_gravityChange,
+    const std::unordered_map<uint32_t, ignition::math::Vector3d> &_last,
+    std::unordered_map<uint32_t, ignition::math::Vector3d> &_current)
+{
+  double change = 0;
+  if (_model->IsStatic())
+    return change;
+
+  for (const auto &link : _model->GetLinks())
+  {
+    const ignition::math::Vector3d vel = link->WorldLinearVel();
+    _current[link->GetId()] = vel;
+
+    auto last = _last.find(link->GetId());
+    if (last == _last.end() || link->Asleep())
+      continue;
+
+    // A link may fall freely or rest on another, both are smooth
+    double linkChange = (vel - last->second).Length();
+    if (link->GetGravityMode())
+    {
+      linkChange = std::min(linkChange,
+          (vel - last->second - _gravityChange).Length());
+    }
+    change = std::max(change, linkChange);
+  }
+
+  for (const auto &nested : _model->NestedModels())
+  {
+    change = std::max(change,
+        VelocityChange(nested, _gravityChange, _last, _current));
+  }
+
+  return change;
+}
+
+//////////////////////////////////////////////////
+void World::CacheLinkKinematics()
+{
+  // The buffers are kept, so that the cache of every step doesn't
+  // allocate.
+  thread_local std::vector<Link *> links;
+  thread_local std::vector<const Model *> models;
+  links.clear();
+  models.clear();
+
+  for (const auto &model : this->dataPtr->models)
+    models.push_back(model.get());
+  for (size_t i = 0; i < models.size(); ++i)
+  {
+    for (const auto &link : models[i]->GetLinks())
+      links.push_back(link.get());
+    for (const auto &nested : models[i]->NestedModels())
+      models.push_back(nested.get());
+  }
+
+  for (Link *link : links)
+  {
+    // A link that fell asleep in the step would keep the velocities it
+    // had before, static links have none to cache.
+    if (link->Asleep() || link->IsStatic())
+      link->ClearKinematicsCache();
+    else
+      link->CacheKinematics();
+  }
+}
+
+//////////////////////////////////////////////////
+void World::UpdateStepSize()
+{
+  const double stepSize = this->dataPtr->physicsEngine->GetMaxStepSize();
+
+  std::unordered_map<uint32_t, ignition::math::Vector3d> velocities;
+  velocities.reserve(this->dataPtr->linkVelocities.size());
+  double velocityChange = 0;
+  for (const auto &model : this->dataPtr->models)
+  {
+    velocityChange = std::max(velocityChange, VelocityChange(model,
+          this->Gravity() * stepSize, this->dataPtr->linkVelocities,
+          velocities));
+  }
+  this->dataPtr->linkVelocities.swap(velocities);
+
+  double penetration = 0;
+  ContactManager *contactManager =
+    this->dataPtr->physicsEngine->GetContactManager();
+  for (unsigned int i = 0; i < contactManager->GetContactCount(); ++i)
+  {
+    const Contact *contact = contactManager->GetContact(i);
+    for (int j = 0; j < contact->count; ++j)
+      penetration = std::max(penetration, contact->depths[j]);
+  }
+
+  const double nextStepSize = this->dataPtr->stepController.NextStepSize(
+      stepSize, velocityChange, penetration);
+  if (!ignition::math::equal(nextStepSize, stepSize))
+    this->dataPtr->physicsEngine->SetMaxStepSize(nextStepSize);
+}
+
+//////////////////////////////////////////////////
+bool World::Advance(const unsigned int _steps)
+{
+  if (this->dataPtr->thread)
+  {
+    gzerr << "Unable to advance world [" << this->Name()
+          << "], it is running in its own thread" << std::endl;
+    return false;
+  }
+
+  // World::Update waits for the log worker, which only runs in RunLoop.
+  if (util::LogRecord::Instance()->Running())
+  {
+    gzerr << "Unable to advance world [" << this->Name()
+          << "] while log recording is active" << std::endl;
+    return false;
+  }
+
+  this->dataPtr->stepCosts.Start();
+  std::lock_guard<std::mutex> lock(this->dataPtr->stepMutex);
+  this->dataPtr->stepCosts.Lap(STEP_LOCK);
+
+  // The calling thread may differ between calls.
+  this->dataPtr->physicsEngine->InitForThread();
+
+  if (!this->dataPtr->pluginsLoaded && this->SensorsInitialized())
+  {
+    this->LoadPlugins();
+    this->dataPtr->pluginsLoaded = true;
+  }
+  this->dataPtr->stepCosts.Lap(STEP_LOAD_PLUGINS);
+
+  {
+    std::lock_guard<std::recursive_mutex> lk(this->dataPtr->worldUpdateMutex);
+    this->dataPtr->stepCosts.Lap(STEP_UPDATE_LOCK);
+    for (unsigned int i = 0; i < _steps && !this->dataPtr->stop; ++i)
+    {
+      this->dataPtr->simTime += common::SimTimeNs::FromSeconds(
+          this->dataPtr->physicsEngine->GetMaxStepSize());
+      this->dataPtr->iterations++;
+      this->Update();
+    }
+  }
+
+  this->PublishWorldStats();
+  this->dataPtr->stepCosts.Lap(STEP_PUBLISH_STATS);
+  gazebo::util::IntrospectionManager::Instance()->NotifyUpdates();
+  this->dataPtr->stepCosts.Lap(STEP_INTROSPECTION);
+  this->ProcessMessages();
+  this->dataPtr->stepCosts.Lap(STEP_PROCESS_MESSAGES);
+
+  if (g_clearModels)
+    this->ClearModels();
+  this->dataPtr->stepCosts.Lap(STEP_CLEAR_MODELS);
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+void World::Update()
+{
+  DIAG_TIMER_START("World::Update");
+
+  IGN_PROFILE("World::Update");
+  GZ_TRACE_SCOPE("physics::World::Update");
+  IGN_PROFILE_BEGIN("needsReset");
+  if (this->dataPtr->needsReset)
+  {
+    if (this->dataPtr->resetAll)
       this->Reset();
     else if (this->dataPtr->resetTimeOnly)
       this->ResetTime();
     else if (this->dataPtr->resetModelOnly)
       this->ResetEntities(Base::MODEL);
     this->dataPtr->needsReset = false;
+    this->dataPtr->stepCosts.Lap(UPDATE_RESET);
     return;
   }
   IGN_PROFILE_END();
@@ -894,25 +2128,44 @@ void World::Update()
   IGN_PROFILE_BEGIN("worldUpdateBegin");
   this->dataPtr->updateInfo.simTime = this->SimTime();
   this->dataPtr->updateInfo.realTime = this->RealTime();
+
+  // Wind velocity of all the links, ready for the world update plugins
+  if (this->dataPtr->enableWind && this->dataPtr->wind)
+    this->dataPtr->wind->Update(this->dataPtr->updateInfo);
+
   event::Events::worldUpdateBegin(this->dataPtr->updateInfo);
   IGN_PROFILE_END();
+  this->dataPtr->stepCosts.Lap(UPDATE_BEGIN);
   DIAG_TIMER_LAP("World::Update", "Events::worldUpdateBegin");
 
   IGN_PROFILE_BEGIN("Update");
   // Update all the models
   (*this.*dataPtr->modelUpdateFunc)();
+
+  // The batteries, after the consumers of the model plugins set their loads
+  if (this->dataPtr->batterySystem)
+    this->dataPtr->batterySystem->Update(this->dataPtr->updateInfo);
   IGN_PROFILE_END();
+  this->dataPtr->stepCosts.Lap(UPDATE_MODELS);
   DIAG_TIMER_LAP("World::Update", "Model::Update");
 
   IGN_PROFILE_BEGIN("UpdateCollision");
   // This must be called before PhysicsEngine::UpdatePhysics for ODE.
   this->dataPtr->physicsEngine->UpdateCollision();
   IGN_PROFILE_END();
+  this->dataPtr->stepCosts.Lap(UPDATE_COLLISION);
   DIAG_TIMER_LAP("World::Update", "PhysicsEngine::UpdateCollision");
 
   IGN_PROFILE_BEGIN("beforePhysicsUpdate");
-  // Wait for logging to finish, if it's running.
-  if (util::LogRecord::Instance()->Running())
+  // Create the recording queue when the logger starts, and remove it when
+  // the logger stops.
+  const unsigned int logQueueSize = util::LogRecord::Instance()->Running() ?
+      util::LogRecord::Instance()->QueueSize() : 0;
+  if ((logQueueSize > 0) != (this->dataPtr->logQueue != nullptr))
+    this->ResetLogQueue(logQueueSize);
+
+  // Wait for logging to finish, if it's running without a queue.
+  if (util::LogRecord::Instance()->Running() && !this->dataPtr->logQueue)
   {
     std::unique_lock<std::mutex> lock(this->dataPtr->logMutex);
 
@@ -925,6 +2178,7 @@ void World::Update()
       this->dataPtr->logContinueCondition.wait(lock);
     }
   }
+  this->dataPtr->stepCosts.Lap(UPDATE_LOG_WAIT);
 
   // Give clients a possibility to react to collisions before the physics
   // gets updated.
@@ -932,6 +2186,7 @@ void World::Update()
   event::Events::beforePhysicsUpdate(this->dataPtr->updateInfo);
 
   IGN_PROFILE_END();
+  this->dataPtr->stepCosts.Lap(UPDATE_BEFORE_PHYSICS);
   DIAG_TIMER_LAP("World::Update", "Events::beforePhysicsUpdate");
 
   // Update the physics engine
@@ -942,6 +2197,7 @@ void World::Update()
     this->dataPtr->physicsEngine->UpdatePhysics();
 
     IGN_PROFILE_END();
+    this->dataPtr->stepCosts.Lap(UPDATE_PHYSICS);
     DIAG_TIMER_LAP("World::Update", "PhysicsEngine::UpdatePhysics");
 
     // do this after physics update as
@@ -953,23 +2209,73 @@ void World::Update()
       boost::recursive_mutex::scoped_lock plock(
           *this->Physics()->GetPhysicsUpdateMutex());
 
-      for (auto &dirtyEntity : this->dataPtr->dirtyPoses)
+      // apply all the poses under one lock, instead of locking for each
+      // entity in Entity::SetWorldPose
       {
-        dirtyEntity->SetWorldPose(dirtyEntity->DirtyPose(), false);
+        std::lock_guard<std::mutex> poseLock(
+            this->dataPtr->setWorldPoseMutex);
+        for (auto &dirtyEntity : this->dataPtr->dirtyPoses)
+          dirtyEntity->_ApplyDirtyPose();
       }
 
+      // publish the moved models, as Entity::SetWorldPose does after it
+      // releases the lock
+      for (auto &dirtyEntity : this->dataPtr->dirtyPoses)
+        this->PublishModelPose(dirtyEntity->GetParentModel());
+
       this->dataPtr->dirtyPoses.clear();
       IGN_PROFILE_END();
+
+      // The sensors and plugins read the velocities of the same links
+      // several times before the next step.
+      IGN_PROFILE_BEGIN("CacheLinkKinematics");
+      this->CacheLinkKinematics();
+      IGN_PROFILE_END();
     }
+    this->dataPtr->stepCosts.Lap(UPDATE_POSES);
 
     DIAG_TIMER_LAP("World::Update", "SetWorldPose(dirtyPoses)");
+
+    if (this->dataPtr->adaptiveStep)
+    {
+      IGN_PROFILE_BEGIN("UpdateStepSize");
+      this->UpdateStepSize();
+      IGN_PROFILE_END();
+      this->dataPtr->stepCosts.Lap(UPDATE_STEP_SIZE);
+    }
+  }
+
+  // The digest is computed before the state is captured for the log, so
+  // that both are of the same step.
+  if (this->dataPtr->stateDigestEnabled)
+  {
+    IGN_PROFILE_BEGIN("UpdateStateDigest");
+    this->UpdateStateDigest();
+    IGN_PROFILE_END();
+    this->dataPtr->stepCosts.Lap(UPDATE_STATE_DIGEST);
+  }
+
+  // The sensor workers render the state of this step, the next step waits
+  // for them in lockstep.
+  if (this->dataPtr->sensorOffload)
+  {
+    IGN_PROFILE_BEGIN("PublishSensorOffload");
+    this->PublishSensorOffload();
+    IGN_PROFILE_END();
+    this->dataPtr->stepCosts.Lap(UPDATE_SENSOR_OFFLOAD);
   }
 
   IGN_PROFILE_BEGIN("LogRecordNotify");
   // Only update state information if logging data.
   if (util::LogRecord::Instance()->Running())
+  {
+    util::LogRecord::Instance()->SetSimTime(this->SimTime());
+    if (this->dataPtr->logQueue)
+      this->QueueLogState();
     this->dataPtr->logCondition.notify_one();
+  }
   IGN_PROFILE_END();
+  this->dataPtr->stepCosts.Lap(UPDATE_LOG_NOTIFY);
   DIAG_TIMER_LAP("World::Update", "LogRecordNotify");
 
   IGN_PROFILE_BEGIN("PublishContacts");
@@ -977,11 +2283,13 @@ void World::Update()
   this->dataPtr->physicsEngine->GetContactManager()->PublishContacts();
 
   IGN_PROFILE_END();
+  this->dataPtr->stepCosts.Lap(UPDATE_CONTACTS);
   DIAG_TIMER_LAP("World::Update", "ContactManager::PublishContacts");
 
   event::Events::worldUpdateEnd();
 
   gazebo::util::IntrospectionManager::Instance()->Update();
+  this->dataPtr->stepCosts.Lap(UPDATE_END);
 
   DIAG_TIMER_STOP("World::Update");
 }
@@ -999,6 +2307,9 @@ void World::Fini()
   util::OpenAL::Instance()->Fini();
 #endif
 
+  // Stop reading factory messages
+  this->SetAsyncFactory(false);
+
   // Clean transport
   {
     // Clear subscribers first
@@ -1024,7 +2335,11 @@ void World::Fini()
     this->dataPtr->posePub.reset();
     this->dataPtr->guiPub.reset();
     this->dataPtr->responsePub.reset();
+    this->dataPtr->factoryResponsePub.reset();
     this->dataPtr->statPub.reset();
+    this->dataPtr->transportStatsPub.reset();
+    this->dataPtr->breakdownPub.reset();
+    this->dataPtr->stateDigestPub.reset();
     this->dataPtr->modelPub.reset();
     this->dataPtr->lightPub.reset();
     this->dataPtr->lightFactoryPub.reset();
@@ -1038,12 +2353,22 @@ void World::Fini()
 
   this->dataPtr->sdf.reset();
 
-  this->dataPtr->testRay.reset();
   this->dataPtr->plugins.clear();
 
   this->dataPtr->publishModelPoses.clear();
   this->dataPtr->publishModelScales.clear();
   this->dataPtr->publishLightPoses.clear();
+  this->dataPtr->poseLayouts.clear();
+  this->dataPtr->snapshots.clear();
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->indexMutex);
+    this->dataPtr->nameIndex.clear();
+    this->dataPtr->idIndex.clear();
+  }
+
+  this->dataPtr->modelPartitions.clear();
+  this->dataPtr->serialModelUpdates.clear();
+  this->dataPtr->modelUpdateDeferred.clear();
 
   // Clean entities
   for (auto &model : this->dataPtr->models)
@@ -1074,7 +2399,11 @@ void World::Fini()
   }
   this->dataPtr->prevStates[0].SetWorld(WorldPtr());
   this->dataPtr->prevStates[1].SetWorld(WorldPtr());
-  this->dataPtr->prevUnfilteredState.SetWorld(WorldPtr());
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->logEventMutex);
+    this->dataPtr->logInsertions.clear();
+    this->dataPtr->logDeletions.clear();
+  }
   this->dataPtr->logPlayState.SetWorld(WorldPtr());
   this->dataPtr->states[0].clear();
   this->dataPtr->states[1].clear();
@@ -1084,6 +2413,7 @@ void World::Fini()
 
   this->dataPtr->atmosphere.reset();
   this->dataPtr->wind.reset();
+  this->dataPtr->batterySystem.reset();
 
   // Engine shouldn't outlive world
   if (this->dataPtr->physicsEngine)
@@ -1153,6 +2483,12 @@ Wind &World::Wind() const
   return *this->dataPtr->wind;
 }
 
+//////////////////////////////////////////////////
+BatterySystem &World::Batteries() const
+{
+  return *this->dataPtr->batterySystem;
+}
+
 //////////////////////////////////////////////////
 Atmosphere &World::Atmosphere() const
 {
@@ -1206,17 +2542,58 @@ void World::SetMagneticField(const ignition::math::Vector3d &_mag)
 //////////////////////////////////////////////////
 BasePtr World::BaseByName(const std::string &_name) const
 {
-  if (this->dataPtr->rootElement)
-    return this->dataPtr->rootElement->GetByName(_name);
-  else
+  if (!this->dataPtr->rootElement)
     return BasePtr();
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->indexMutex);
+
+  auto iter = this->dataPtr->nameIndex.find(_name);
+  if (iter != this->dataPtr->nameIndex.end())
+  {
+    BasePtr base = iter->second.lock();
+    if (IndexEntryValid(base) && base->GetScopedName() == _name)
+      return base;
+    this->dataPtr->nameIndex.erase(iter);
+  }
+
+  BasePtr result = this->dataPtr->rootElement->GetByName(_name);
+
+  // Only scoped names are indexed, plain names may be ambiguous.
+  if (result && result != this->dataPtr->rootElement &&
+      result->GetScopedName() == _name)
+  {
+    this->dataPtr->nameIndex[_name] = result;
+  }
+  return result;
+}
+
+/////////////////////////////////////////////////
+BasePtr World::BaseById(const uint32_t _id) const
+{
+  if (!this->dataPtr->rootElement)
+    return BasePtr();
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->indexMutex);
+
+  auto iter = this->dataPtr->idIndex.find(_id);
+  if (iter != this->dataPtr->idIndex.end())
+  {
+    BasePtr base = iter->second.lock();
+    if (IndexEntryValid(base))
+      return base;
+    this->dataPtr->idIndex.erase(iter);
+  }
+
+  BasePtr result = this->dataPtr->rootElement->GetByIdRecursive(_id);
+  if (result && result != this->dataPtr->rootElement)
+    this->dataPtr->idIndex[_id] = result;
+  return result;
 }
 
 /////////////////////////////////////////////////
 ModelPtr World::ModelById(unsigned int _id) const
 {
-  return boost::dynamic_pointer_cast<Model>(
-      this->dataPtr->rootElement->GetByIdRecursive(_id));
+  return boost::dynamic_pointer_cast<Model>(this->BaseById(_id));
 }
 
 //////////////////////////////////////////////////
@@ -1278,6 +2655,9 @@ ModelPtr World::LoadModel(sdf::ElementPtr _sdf , BasePtr _parent)
 
   this->PublishModelPose(model);
   this->dataPtr->models.push_back(model);
+  this->dataPtr->sdfCompactPending = true;
+  if (model)
+    this->LogInsertion(model->GetName());
   return model;
 }
 
@@ -1303,6 +2683,7 @@ LightPtr World::LoadLight(const sdf::ElementPtr &_sdf, const BasePtr &_parent)
   light->SetWorld(shared_from_this());
   light->Load(_sdf);
   this->dataPtr->lights.push_back(light);
+  this->LogInsertion(light->GetName());
 
   // msg should contain scoped name (consistent with other entities)
   msg->set_name(light->GetScopedName());
@@ -1333,6 +2714,7 @@ ActorPtr World::LoadActor(sdf::ElementPtr _sdf , BasePtr _parent)
   this->EnableAllModels();
   this->PublishModelPose(actor);
   this->dataPtr->models.push_back(actor);
+  this->LogInsertion(actor->GetName());
 
   return actor;
 }
@@ -1420,13 +2802,134 @@ ModelPtr World::ModelByIndex(const unsigned int _index) const
     return ModelPtr();
   }
 
-  return this->dataPtr->models[_index];
+  return this->dataPtr->models[_index];
+}
+
+//////////////////////////////////////////////////
+Model_V World::Models() const
+{
+  return this->dataPtr->models;
+}
+
+//////////////////////////////////////////////////
+/// \brief Append models and their nested models, depth first.
+/// \param[in] _models The models.
+/// \param[in,out] _all The list to append to.
+static void AppendModels(const Model_V &_models, Model_V &_all)
+{
+  for (auto const &model : _models)
+  {
+    _all.push_back(model);
+    AppendModels(model->NestedModels(), _all);
+  }
+}
+
+//////////////////////////////////////////////////
+Model_V World::ModelsOverlapping(const std::function<bool (
+    const ignition::math::AxisAlignedBox &_box)> &_overlaps) const
+{
+  IGN_PROFILE("World::ModelsOverlapping");
+  std::lock_guard<std::mutex> lock(this->dataPtr->modelIndexMutex);
+
+  // Refresh the bounding boxes once per iteration. The boxes of static
+  // models that did not move are kept.
+  if (!this->dataPtr->modelIndexValid ||
+      this->dataPtr->modelIndexIteration != this->dataPtr->iterations)
+  {
+    Model_V models;
+    AppendModels(this->dataPtr->models, models);
+
+    std::vector<Model *> ids(models.size());
+    for (size_t i = 0; i < models.size(); ++i)
+      ids[i] = models[i].get();
+    const bool same = this->dataPtr->modelIndexValid &&
+      ids == this->dataPtr->modelIndexIds;
+
+    this->dataPtr->modelIndexBoxes.resize(models.size());
+    this->dataPtr->modelIndexPoses.resize(models.size());
+    for (size_t i = 0; i < models.size(); ++i)
+    {
+      const ignition::math::Pose3d pose = models[i]->WorldPose();
+      if (same && models[i]->IsStatic() &&
+          pose == this->dataPtr->modelIndexPoses[i])
+      {
+        continue;
+      }
+      this->dataPtr->modelIndexBoxes[i] = models[i]->BoundingBox();
+      this->dataPtr->modelIndexPoses[i] = pose;
+    }
+
+    if (same)
+    {
+      this->dataPtr->modelIndex.Refit(this->dataPtr->modelIndexBoxes);
+    }
+    else
+    {
+      this->dataPtr->modelIndex.Build(this->dataPtr->modelIndexBoxes);
+      this->dataPtr->modelIndexModels.assign(models.begin(), models.end());
+      this->dataPtr->modelIndexIds = ids;
+    }
+    this->dataPtr->modelIndexIteration = this->dataPtr->iterations;
+    this->dataPtr->modelIndexValid = true;
+  }
+
+  std::vector<size_t> indices;
+  this->dataPtr->modelIndex.Query(_overlaps,
+      [&indices](const size_t _index)
+      {
+        indices.push_back(_index);
+      });
+  std::sort(indices.begin(), indices.end());
+
+  Model_V result;
+  result.reserve(indices.size());
+  for (auto index : indices)
+  {
+    ModelPtr model = this->dataPtr->modelIndexModels[index].lock();
+    if (model)
+      result.push_back(model);
+  }
+  return result;
+}
+
+//////////////////////////////////////////////////
+Model_V World::ModelsInBox(const ignition::math::AxisAlignedBox &_box) const
+{
+  return this->ModelsOverlapping(
+      [&_box](const ignition::math::AxisAlignedBox &_b)
+      {
+        return _b.Intersects(_box);
+      });
+}
+
+//////////////////////////////////////////////////
+Model_V World::ModelsInSphere(const ignition::math::Vector3d &_center,
+    const double _radius) const
+{
+  const double radiusSquared = _radius * _radius;
+  return this->ModelsOverlapping(
+      [&_center, radiusSquared](const ignition::math::AxisAlignedBox &_b)
+      {
+        // Squared distance from the center to the closest point of the box
+        double distance = 0.0;
+        for (unsigned int i = 0; i < 3; ++i)
+        {
+          const double d = std::max(std::max(_b.Min()[i] - _center[i],
+                _center[i] - _b.Max()[i]), 0.0);
+          distance += d * d;
+        }
+        return distance <= radiusSquared;
+      });
 }
 
 //////////////////////////////////////////////////
-Model_V World::Models() const
+Model_V World::ModelsInFrustum(const ignition::math::Frustum &_frustum) const
 {
-  return this->dataPtr->models;
+  return this->ModelsOverlapping(
+      [&_frustum](const ignition::math::AxisAlignedBox &_b)
+      {
+        return _frustum.Contains(_b);
+      });
 }
 
 //////////////////////////////////////////////////
@@ -1438,7 +2941,7 @@ Light_V World::Lights() const
 //////////////////////////////////////////////////
 void World::ResetTime()
 {
-  this->dataPtr->simTime = common::Time(0);
+  this->dataPtr->simTime = common::SimTimeNs();
   this->dataPtr->pauseTime = common::Time(0);
   this->dataPtr->startTime = common::Time::GetWallTime();
   this->dataPtr->realTimeOffset = common::Time(0);
@@ -1485,6 +2988,99 @@ void World::Reset()
   this->SetPaused(currentlyPaused);
 }
 
+//////////////////////////////////////////////////
+uint32_t World::Snapshot()
+{
+  std::lock_guard<std::recursive_mutex> lk(this->dataPtr->worldUpdateMutex);
+  boost::recursive_mutex::scoped_lock plock(
+      *this->dataPtr->physicsEngine->GetPhysicsUpdateMutex());
+
+  const uint32_t handle = this->dataPtr->nextSnapshot++;
+  WorldSnapshot &snapshot = this->dataPtr->snapshots[handle];
+  snapshot.simTime = this->dataPtr->simTime;
+  snapshot.iterations = this->dataPtr->iterations;
+
+  // Breadth first, so that a model is restored before its nested models.
+  Model_V models = this->dataPtr->models;
+  for (size_t i = 0; i < models.size(); ++i)
+  {
+    ModelPtr model = models[i];
+    snapshot.models.push_back({model, model->WorldPose()});
+
+    for (auto const &link : model->GetLinks())
+    {
+      snapshot.links.push_back({link, link->WorldPose(),
+          link->WorldCoGLinearVel(), link->WorldAngularVel(),
+          link->WorldForce(), link->WorldTorque()});
+    }
+
+    models.insert(models.end(), model->NestedModels().begin(),
+        model->NestedModels().end());
+  }
+
+  this->dataPtr->physicsEngine->SaveSnapshot(handle);
+  return handle;
+}
+
+//////////////////////////////////////////////////
+bool World::Restore(const uint32_t _handle)
+{
+  std::lock_guard<std::recursive_mutex> lk(this->dataPtr->worldUpdateMutex);
+  boost::recursive_mutex::scoped_lock plock(
+      *this->dataPtr->physicsEngine->GetPhysicsUpdateMutex());
+
+  auto iter = this->dataPtr->snapshots.find(_handle);
+  if (iter == this->dataPtr->snapshots.end())
+  {
+    gzerr << "Unknown world snapshot [" << _handle << "]" << std::endl;
+    return false;
+  }
+  const WorldSnapshot &snapshot = iter->second;
+
+  for (auto const &modelSnapshot : snapshot.models)
+  {
+    if (ModelPtr model = modelSnapshot.model.lock())
+      model->SetWorldPose(modelSnapshot.pose, true);
+  }
+
+  for (auto const &linkSnapshot : snapshot.links)
+  {
+    if (LinkPtr link = linkSnapshot.link.lock())
+    {
+      link->SetWorldPose(linkSnapshot.pose);
+      link->SetLinearVel(linkSnapshot.linearVel);
+      link->SetAngularVel(linkSnapshot.angularVel);
+      link->SetForce(linkSnapshot.force);
+      link->SetTorque(linkSnapshot.torque);
+    }
+  }
+
+  // The engine restores its internal state last, so that it overrides
+  // anything derived from the entity poses above.
+  this->dataPtr->physicsEngine->RestoreSnapshot(_handle);
+
+  const bool timeReset = snapshot.simTime < this->dataPtr->simTime;
+  this->dataPtr->simTime = snapshot.simTime;
+  this->dataPtr->iterations = snapshot.iterations;
+
+  // Sensors reset their last update time when time goes backwards.
+  if (timeReset)
+    event::Events::timeReset();
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+void World::ReleaseSnapshot(const uint32_t _handle)
+{
+  std::lock_guard<std::recursive_mutex> lk(this->dataPtr->worldUpdateMutex);
+  boost::recursive_mutex::scoped_lock plock(
+      *this->dataPtr->physicsEngine->GetPhysicsUpdateMutex());
+
+  this->dataPtr->snapshots.erase(_handle);
+  this->dataPtr->physicsEngine->ReleaseSnapshot(_handle);
+}
+
 //////////////////////////////////////////////////
 void World::OnStep()
 {
@@ -1501,6 +3097,12 @@ void World::PrintEntityTree()
 
 //////////////////////////////////////////////////
 gazebo::common::Time World::SimTime() const
+{
+  return this->dataPtr->simTime.ToTime();
+}
+
+//////////////////////////////////////////////////
+common::SimTimeNs World::SimTimeNs() const
 {
   return this->dataPtr->simTime;
 }
@@ -1508,7 +3110,7 @@ gazebo::common::Time World::SimTime() const
 //////////////////////////////////////////////////
 void World::SetSimTime(const common::Time &_t)
 {
-  this->dataPtr->simTime = _t;
+  this->dataPtr->simTime = common::SimTimeNs(_t);
 }
 
 //////////////////////////////////////////////////
@@ -1579,8 +3181,24 @@ void World::SetPaused(const bool _p)
 //////////////////////////////////////////////////
 void World::OnFactoryMsg(ConstFactoryPtr &_msg)
 {
+  this->QueueFactoryMsg(*_msg);
+}
+
+//////////////////////////////////////////////////
+void World::QueueFactoryMsg(const msgs::Factory &_msg)
+{
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->factoryMutex);
+    if (this->dataPtr->factoryThread)
+    {
+      this->dataPtr->factoryPending.push_back(_msg);
+      this->dataPtr->factoryCondition.notify_one();
+      return;
+    }
+  }
+
   std::lock_guard<std::recursive_mutex> lock(this->dataPtr->receiveMutex);
-  this->dataPtr->factoryMsgs.push_back(*_msg);
+  this->dataPtr->factoryMsgs.push_back(_msg);
 }
 
 //////////////////////////////////////////////////
@@ -1640,8 +3258,21 @@ void World::ProcessPlaybackControlMsgs()
 {
   std::lock_guard<std::recursive_mutex> lock(this->dataPtr->worldUpdateMutex);
 
-  for (auto const &msg : this->dataPtr->playbackControlMsgs)
+  // Only the last seek of a batch is done, since scrubbing the timeline
+  // may send seeks faster than they are processed.
+  auto lastSeek = this->dataPtr->playbackControlMsgs.end();
+  for (auto iter = this->dataPtr->playbackControlMsgs.begin();
+       iter != this->dataPtr->playbackControlMsgs.end(); ++iter)
+  {
+    if (iter->has_seek())
+      lastSeek = iter;
+  }
+
+  for (auto iter = this->dataPtr->playbackControlMsgs.begin();
+       iter != this->dataPtr->playbackControlMsgs.end(); ++iter)
   {
+    auto const &msg = *iter;
+
     if (msg.has_pause())
       this->SetPaused(msg.pause());
 
@@ -1653,17 +3284,19 @@ void World::ProcessPlaybackControlMsgs()
       this->dataPtr->stepInc += msg.multi_step();
     }
 
-    if (msg.has_seek())
+    if (msg.has_seek() && iter == lastSeek)
     {
       common::Time targetSimTime = msgs::Convert(msg.seek());
       util::LogPlay::Instance()->Seek(targetSimTime);
       this->dataPtr->stepInc = 1;
+      this->dataPtr->logPlayResync = true;
     }
 
     if (msg.has_rewind() && msg.rewind())
     {
       util::LogPlay::Instance()->Rewind();
       this->dataPtr->stepInc = 1;
+      this->dataPtr->logPlayResync = true;
       if (!util::LogPlay::Instance()->HasIterations())
         this->dataPtr->iterations = 0;
     }
@@ -1672,6 +3305,7 @@ void World::ProcessPlaybackControlMsgs()
     {
       util::LogPlay::Instance()->Forward();
       this->dataPtr->stepInc = -1;
+      this->dataPtr->logPlayResync = true;
       this->SetPaused(true);
       // ToDo: Update iterations if the log doesn't have it.
     }
@@ -1721,37 +3355,274 @@ void World::OnModelMsg(ConstModelPtr &_msg)
 }
 
 //////////////////////////////////////////////////
-void World::BuildSceneMsg(msgs::Scene &_scene, BasePtr _entity)
+void World::UpdateSceneSnapshot()
+{
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->receiveMutex);
+  if (!this->dataPtr->rootElement)
+    return;
+
+  // The lights are few and cheap to fill, so only the models are cached.
+  msgs::Scene scene(this->dataPtr->sceneMsg);
+  scene.clear_model();
+  scene.clear_light();
+  for (unsigned int i = 0; i < this->dataPtr->rootElement->GetChildCount();
+       ++i)
+  {
+    BasePtr child = this->dataPtr->rootElement->GetChild(i);
+    if (child->HasType(Entity::LIGHT))
+    {
+      boost::static_pointer_cast<physics::Light>(child)->FillMsg(
+          *scene.add_light());
+    }
+  }
+
+  auto data = std::make_shared<std::string>();
+  scene.SerializeToString(data.get());
+
+  std::unordered_map<uint32_t, SceneModelEntry> models;
+  AppendSceneModels(this->dataPtr->rootElement, *this->dataPtr, models,
+      *data);
+  this->dataPtr->sceneModels.swap(models);
+  this->dataPtr->sceneDirtyModels.clear();
+
+  {
+    std::lock_guard<std::mutex> snapshotLock(
+        this->dataPtr->sceneSnapshotMutex);
+    this->dataPtr->sceneSnapshot = data;
+    ++this->dataPtr->sceneSnapshotCount;
+  }
+  this->dataPtr->sceneSnapshotCondition.notify_all();
+}
+
+//////////////////////////////////////////////////
+void World::SceneModelDirty(const Model *_model)
+{
+  if (!_model)
+    return;
+
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->receiveMutex);
+  this->dataPtr->sceneDirtyModels.insert(_model->GetId());
+
+  // The message of a model includes its nested models.
+  for (BasePtr base = _model->GetParent();
+       base && base->HasType(Entity::MODEL); base = base->GetParent())
+  {
+    this->dataPtr->sceneDirtyModels.insert(base->GetId());
+  }
+}
+
+
+//////////////////////////////////////////////////
+void World::ModelUpdateTBB()
+{
+  unsigned int jointCount = 0;
+  for (auto const &model : this->dataPtr->models)
+    jointCount += ModelJointCount(model);
+
+  // Joints created at runtime may couple previously independent models.
+  if (this->dataPtr->modelPartitionsDirty ||
+      this->dataPtr->modelPartitionChildCount !=
+      this->dataPtr->rootElement->GetChildCount() ||
+      this->dataPtr->modelPartitionJointCount != jointCount)
+  {
+    this->UpdateModelPartitions();
+    this->dataPtr->modelPartitionJointCount = jointCount;
+  }
+
+  this->dataPtr->modelUpdateArena->execute([this]()
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0,
+        this->dataPtr->modelPartitions.size()),
+        ModelUpdate_TBB(&this->dataPtr->modelPartitions,
+          &this->dataPtr->modelUpdateDeferred));
+  });
+
+  // Merge the deferred side effects in partition order, so the result does
+  // not depend on how the partitions were scheduled.
+  for (auto &deferred : this->dataPtr->modelUpdateDeferred)
+  {
+    this->dataPtr->dirtyPoses.insert(this->dataPtr->dirtyPoses.end(),
+        deferred.dirtyPoses.begin(), deferred.dirtyPoses.end());
+    deferred.dirtyPoses.clear();
+
+    for (auto &model : deferred.publishModelPoses)
+      this->PublishModelPose(model);
+    deferred.publishModelPoses.clear();
+  }
+
+  // Actors animate their links kinematically, update them serially.
+  for (auto &child : this->dataPtr->serialModelUpdates)
+    child->Update();
+}
+
+//////////////////////////////////////////////////
+void World::UpdateModelPartitions()
 {
-  if (_entity)
+  this->dataPtr->modelPartitionsDirty = false;
+  this->dataPtr->modelPartitions.clear();
+  this->dataPtr->serialModelUpdates.clear();
+
+  Model_V models;
+  std::map<Model *, size_t> modelIndex;
+  for (unsigned int i = 0; i < this->dataPtr->rootElement->GetChildCount();
+       ++i)
+  {
+    BasePtr child = this->dataPtr->rootElement->GetChild(i);
+    if (child->HasType(Base::MODEL) && !child->HasType(Base::ACTOR))
+    {
+      modelIndex[static_cast<Model *>(child.get())] = models.size();
+      models.push_back(boost::static_pointer_cast<Model>(child));
+    }
+    else
+      this->dataPtr->serialModelUpdates.push_back(child);
+  }
+  this->dataPtr->modelPartitionChildCount =
+    this->dataPtr->rootElement->GetChildCount();
+
+  // Union-find over the models, joined by every joint that connects links
+  // of two different models.
+  std::vector<size_t> parents(models.size());
+  std::iota(parents.begin(), parents.end(), 0);
+  auto findRoot = [&parents](size_t _index)
+  {
+    while (parents[_index] != _index)
+    {
+      parents[_index] = parents[parents[_index]];
+      _index = parents[_index];
+    }
+    return _index;
+  };
+
+  for (size_t i = 0; i < models.size(); ++i)
   {
-    if (_entity->HasType(Entity::MODEL))
+    Joint_V joints;
+    ModelJoints(models[i], joints);
+    for (auto const &joint : joints)
     {
-      msgs::Model *modelMsg = _scene.add_model();
-      boost::static_pointer_cast<Model>(_entity)->FillMsg(*modelMsg);
+      for (auto const &link : {joint->GetParent(), joint->GetChild()})
+      {
+        if (!link)
+          continue;
+
+        auto iter = modelIndex.find(link->GetParentModel().get());
+        if (iter != modelIndex.end())
+          parents[findRoot(iter->second)] = findRoot(i);
+      }
     }
-    else if (_entity->HasType(Entity::LIGHT) &&
-        _entity->GetParent() == this->dataPtr->rootElement)
+  }
+
+  // Build the partitions in model order to keep the merge deterministic.
+  std::map<size_t, size_t> partitionIndex;
+  for (size_t i = 0; i < models.size(); ++i)
+  {
+    size_t root = findRoot(i);
+    auto iter = partitionIndex.find(root);
+    if (iter == partitionIndex.end())
     {
-      msgs::Light *lightMsg = _scene.add_light();
-      boost::static_pointer_cast<physics::Light>(_entity)->FillMsg(*lightMsg);
+      iter = partitionIndex.insert(
+          std::make_pair(root, this->dataPtr->modelPartitions.size())).first;
+      this->dataPtr->modelPartitions.push_back(Model_V());
     }
+    this->dataPtr->modelPartitions[iter->second].push_back(models[i]);
+  }
 
-    for (unsigned int i = 0; i < _entity->GetChildCount(); ++i)
+  this->dataPtr->modelUpdateDeferred.clear();
+  this->dataPtr->modelUpdateDeferred.resize(
+      this->dataPtr->modelPartitions.size());
+}
+
+//////////////////////////////////////////////////
+bool World::PublishPoseNames() const
+{
+  return this->dataPtr->publishPoseNames;
+}
+
+//////////////////////////////////////////////////
+void World::SetPublishPoseNames(const bool _names)
+{
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->receiveMutex);
+  this->dataPtr->publishPoseNames = _names;
+}
+
+//////////////////////////////////////////////////
+bool World::AsyncFactory() const
+{
+  return this->dataPtr->asyncFactory;
+}
+
+//////////////////////////////////////////////////
+void World::SetAsyncFactory(const bool _enable)
+{
+  std::thread *thread = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->factoryMutex);
+    this->dataPtr->asyncFactory = _enable;
+    if (_enable && !this->dataPtr->factoryThread)
     {
-      this->BuildSceneMsg(_scene, _entity->GetChild(i));
+      // Messages received before are read first, so that they keep their
+      // order
+      {
+        std::lock_guard<std::recursive_mutex> receiveLock(
+            this->dataPtr->receiveMutex);
+        this->dataPtr->factoryPending.splice(
+            this->dataPtr->factoryPending.begin(),
+            this->dataPtr->factoryMsgs);
+      }
+      this->dataPtr->factoryStop = false;
+      this->dataPtr->factoryThread =
+        new std::thread(std::bind(&World::FactoryWorker, this));
+      return;
     }
+
+    if (_enable || !this->dataPtr->factoryThread)
+      return;
+
+    thread = this->dataPtr->factoryThread;
+    this->dataPtr->factoryThread = nullptr;
+    this->dataPtr->factoryStop = true;
+    this->dataPtr->factoryCondition.notify_all();
   }
+
+  thread->join();
+  delete thread;
+
+  // Messages the thread didn't get to are read in the world update. They
+  // come after the messages it did read, which ProcessFactoryMsgs handles
+  // first.
+  std::lock_guard<std::mutex> lock(this->dataPtr->factoryMutex);
+  std::lock_guard<std::recursive_mutex> receiveLock(
+      this->dataPtr->receiveMutex);
+  this->dataPtr->factoryMsgs.splice(this->dataPtr->factoryMsgs.begin(),
+      this->dataPtr->factoryPending);
 }
 
+//////////////////////////////////////////////////
+unsigned int World::ModelUpdateThreads() const
+{
+  return this->dataPtr->modelUpdateThreads;
+}
 
 //////////////////////////////////////////////////
-// void World::ModelUpdateTBB()
-// {
-//   tbb::parallel_for (tbb::blocked_range<size_t>(0,
-//   this->dataPtr->models.size(), 10),
-//       ModelUpdate_TBB(&this->dataPtr->models));
-// }
+void World::SetModelUpdateThreads(const unsigned int _threads)
+{
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->worldUpdateMutex);
+
+  this->dataPtr->modelUpdateThreads = _threads;
+  if (_threads > 1)
+  {
+    this->dataPtr->modelUpdateArena.reset(new tbb::task_arena(_threads));
+    this->dataPtr->modelPartitionsDirty = true;
+    this->dataPtr->modelUpdateFunc = &World::ModelUpdateTBB;
+  }
+  else
+  {
+    this->dataPtr->modelUpdateFunc = &World::ModelUpdateSingleLoop;
+    this->dataPtr->modelUpdateArena.reset();
+    this->dataPtr->modelPartitions.clear();
+    this->dataPtr->serialModelUpdates.clear();
+    this->dataPtr->modelUpdateDeferred.clear();
+  }
+}
 
 //////////////////////////////////////////////////
 void World::ModelUpdateSingleLoop()
@@ -1805,6 +3676,11 @@ void World::LoadPlugin(const std::string &_filename,
             << "Plugin filename[" << _filename << "] name[" << _name << "]\n";
       return;
     }
+    // The time spent in the event callbacks connected by the plugin is
+    // reported in the statistics breakdown.
+    common::CostOwner owner(common::CostCounter::Create("plugin", _name));
+
+    plugin->LoadUpdateRate(_sdf);
     plugin->Load(shared_from_this(), _sdf);
     this->dataPtr->plugins.push_back(plugin);
 
@@ -1892,8 +3768,7 @@ void World::ProcessRequestMsgs()
     }
     else if (requestMsg.request() == "entity_info")
     {
-      BasePtr entity(
-        this->dataPtr->rootElement->GetByName(requestMsg.data()));
+      BasePtr entity(this->BaseByName(requestMsg.data()));
       if (entity)
       {
         if (entity->HasType(Base::MODEL))
@@ -1989,12 +3864,14 @@ void World::ProcessRequestMsgs()
     }
     else if (requestMsg.request() == "scene_info")
     {
-      this->dataPtr->sceneMsg.clear_model();
-      this->dataPtr->sceneMsg.clear_light();
-      this->BuildSceneMsg(this->dataPtr->sceneMsg, this->dataPtr->rootElement);
-
-      std::string *serializedData = response.mutable_serialized_data();
-      this->dataPtr->sceneMsg.SerializeToString(serializedData);
+      // Only the models that changed since the last snapshot are filled.
+      this->UpdateSceneSnapshot();
+      {
+        std::lock_guard<std::mutex> snapshotLock(
+            this->dataPtr->sceneSnapshotMutex);
+        if (this->dataPtr->sceneSnapshot)
+          response.set_serialized_data(*this->dataPtr->sceneSnapshot);
+      }
       response.set_type(this->dataPtr->sceneMsg.GetTypeName());
 
       for (auto road : this->dataPtr->roads)
@@ -2042,6 +3919,7 @@ void World::ProcessModelMsgs()
     else
     {
       model->ProcessMsg(modelMsg);
+      this->SceneModelDirty(model.get());
 
       // May 30, 2013: The following code was removed because it has a
       // major performance impact when dragging complex object via the GUI.
@@ -2147,102 +4025,225 @@ void World::ProcessLightFactoryMsgs()
   }
 }
 
+//////////////////////////////////////////////////
+/// \brief Check if the SDF of a factory message is a string or a file,
+/// which can be read without the world.
+/// \param[in] _msg The factory message.
+/// \return True if the message has an SDF string or filename.
+static bool HasFactorySDF(const msgs::Factory &_msg)
+{
+  return (_msg.has_sdf() && !_msg.sdf().empty()) ||
+    (_msg.has_sdf_filename() && !_msg.sdf_filename().empty());
+}
+
+//////////////////////////////////////////////////
+/// \brief Read the SDF string or file of a factory message.
+/// \param[in] _msg The factory message.
+/// \param[in] _sdf SDF to read into.
+/// \return True on success.
+static bool ReadFactorySDF(const msgs::Factory &_msg, sdf::SDFPtr _sdf)
+{
+  if (_msg.has_sdf() && !_msg.sdf().empty())
+  {
+    // SDF Parsing happens here
+    if (!sdf::readString(_msg.sdf(), _sdf))
+    {
+      gzerr << "Unable to read sdf string[" << _msg.sdf() << "]\n";
+      return false;
+    }
+    return true;
+  }
+
+  std::string filename;
+  // If http(s), look at Fuel
+  auto uri = ignition::common::URI(_msg.sdf_filename());
+  if (uri.Valid() && (uri.Scheme() == "https" || uri.Scheme() == "http"))
+  {
+    filename = common::FuelModelDatabase::Instance()->ModelFile(
+        _msg.sdf_filename());
+  }
+  // Otherwise, look at database
+  else
+  {
+    filename = common::ModelDatabase::Instance()->GetModelFile(
+        _msg.sdf_filename());
+  }
+
+  if (!sdf::readFile(filename, _sdf))
+  {
+    gzerr << "Unable to read sdf file [" << filename << "]\n";
+    return false;
+  }
+
+  common::convertToFullPaths(_sdf->Root());
+  return true;
+}
+
+//////////////////////////////////////////////////
+/// \brief Publish the result of a factory message.
+/// \param[in] _pub Publisher of ~/factory/response.
+/// \param[in] _success True if the entity was inserted or edited.
+/// \param[in] _type Type of the entity: model, light or actor. Empty if
+/// unknown.
+/// \param[in] _name Name of the entity. Empty if unknown.
+static void PublishFactoryResponse(const transport::PublisherPtr &_pub,
+    const bool _success, const std::string &_type, const std::string &_name)
+{
+  if (!_pub || !_pub->HasConnections())
+    return;
+
+  msgs::Response response;
+  response.set_id(-1);
+  response.set_request("factory");
+  response.set_response(_success ? "success" : "failure");
+  response.set_type(_type);
+  response.set_serialized_data(_name);
+  _pub->Publish(response);
+}
+
+//////////////////////////////////////////////////
+void World::FactoryWorker()
+{
+  common::ThreadConfig::Instance()->Apply("world_factory");
+  std::unique_lock<std::mutex> lock(this->dataPtr->factoryMutex);
+  while (!this->dataPtr->factoryStop)
+  {
+    if (this->dataPtr->factoryPending.empty())
+    {
+      this->dataPtr->factoryCondition.wait(lock);
+      continue;
+    }
+
+    msgs::Factory factoryMsg = this->dataPtr->factoryPending.front();
+    this->dataPtr->factoryPending.pop_front();
+
+    // Messages that need the world, like clones, are passed on as they are
+    FactoryRequest request;
+    request.msg = factoryMsg;
+    if (HasFactorySDF(factoryMsg))
+    {
+      lock.unlock();
+      sdf::SDFPtr factorySDF(new sdf::SDF);
+      sdf::initFile("root.sdf", factorySDF);
+      const bool valid = ReadFactorySDF(factoryMsg, factorySDF);
+
+      // Start parsing the meshes and opening the plugin libraries, so that
+      // they are ready, or at least under way, when the world thread
+      // creates the entity.
+      if (valid)
+      {
+        std::vector<std::string> meshes;
+        std::vector<std::string> plugins;
+        CollectLoadFiles(factorySDF->Root(), meshes, plugins);
+        for (auto const &mesh : meshes)
+          common::MeshManager::Instance()->LoadAsync(mesh);
+        common::PluginLibraryCache::Instance()->Preload(plugins);
+        request.sdf = factorySDF;
+      }
+      request.valid = valid;
+      lock.lock();
+    }
+
+    // The world thread publishes the response of invalid messages too, in
+    // order and without this lock
+    this->dataPtr->factoryReady.push_back(std::move(request));
+  }
+}
+
 //////////////////////////////////////////////////
 void World::ProcessFactoryMsgs()
 {
   IGN_PROFILE("World::ProcessFactoryMsgs");
   std::list<sdf::ElementPtr> modelsToLoad, lightsToLoad;
 
-  std::list<msgs::Factory> factoryMsgsCopy;
+  // Messages read by the factory thread come first, they were received
+  // before the others.
+  std::list<FactoryRequest> factoryMsgsCopy;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->factoryMutex);
+    factoryMsgsCopy.swap(this->dataPtr->factoryReady);
+  }
   {
     std::lock_guard<std::recursive_mutex> lock(this->dataPtr->receiveMutex);
 
-    std::copy(this->dataPtr->factoryMsgs.begin(),
-      this->dataPtr->factoryMsgs.end(),
-      std::back_inserter(factoryMsgsCopy));
+    for (auto const &factoryMsg : this->dataPtr->factoryMsgs)
+    {
+      factoryMsgsCopy.emplace_back();
+      factoryMsgsCopy.back().msg = factoryMsg;
+    }
     this->dataPtr->factoryMsgs.clear();
   }
 
-  for (auto const &factoryMsg : factoryMsgsCopy)
-  {
+  const transport::PublisherPtr &responsePub =
+    this->dataPtr->factoryResponsePub;
 
-    this->dataPtr->factorySDF->Clear();
+  for (auto const &factory : factoryMsgsCopy)
+  {
+    const msgs::Factory &factoryMsg = factory.msg;
+    sdf::SDFPtr factorySDF = factory.sdf;
 
-    if (factoryMsg.has_sdf() && !factoryMsg.sdf().empty())
+    if (!factory.valid)
     {
-      // SDF Parsing happens here
-      if (!sdf::readString(factoryMsg.sdf(), this->dataPtr->factorySDF))
-      {
-        gzerr << "Unable to read sdf string[" << factoryMsg.sdf() << "]\n";
-        continue;
-      }
+      PublishFactoryResponse(responsePub, false, "", "");
+      continue;
     }
-    else if (factoryMsg.has_sdf_filename() &&
-            !factoryMsg.sdf_filename().empty())
+
+    if (!factorySDF)
     {
-      std::string filename;
-      // If http(s), look at Fuel
-      auto uri = ignition::common::URI(factoryMsg.sdf_filename());
-      if (uri.Valid() && (uri.Scheme() == "https" || uri.Scheme() == "http"))
+      factorySDF = this->dataPtr->factorySDF;
+      factorySDF->Clear();
+
+      if (HasFactorySDF(factoryMsg))
       {
-        filename = common::FuelModelDatabase::Instance()->ModelFile(
-            factoryMsg.sdf_filename());
+        if (!ReadFactorySDF(factoryMsg, factorySDF))
+        {
+          PublishFactoryResponse(responsePub, false, "", "");
+          continue;
+        }
       }
-      // Otherwise, look at database
-      else
+      else if (factoryMsg.has_clone_model_name())
       {
-        filename = common::ModelDatabase::Instance()->GetModelFile(
-            factoryMsg.sdf_filename());
-      }
+        ModelPtr model = this->ModelByName(factoryMsg.clone_model_name());
+        if (!model)
+        {
+          gzerr << "Unable to clone model[" << factoryMsg.clone_model_name()
+            << "]. Model not found.\n";
+          PublishFactoryResponse(responsePub, false, "model", "");
+          continue;
+        }
 
-      if (!sdf::readFile(filename, this->dataPtr->factorySDF))
-      {
-        gzerr << "Unable to read sdf file [" << filename << "]\n";
-        continue;
-      }
+        factorySDF->Root()->InsertElement(model->GetSDF()->Clone());
 
-      common::convertToFullPaths(this->dataPtr->factorySDF->Root());
-    }
-    else if (factoryMsg.has_clone_model_name())
-    {
-      ModelPtr model = this->ModelByName(factoryMsg.clone_model_name());
-      if (!model)
+        std::string newName = model->GetName() + "_clone";
+        newName = this->UniqueModelName(newName);
+
+        factorySDF->Root()->GetElement("model")->GetAttribute(
+            "name")->Set(newName);
+      }
+      else
       {
-        gzerr << "Unable to clone model[" << factoryMsg.clone_model_name()
-          << "]. Model not found.\n";
+        gzerr << "Unable to load sdf from factory message."
+          << "No SDF or SDF filename specified.\n";
+        PublishFactoryResponse(responsePub, false, "", "");
         continue;
       }
-
-      this->dataPtr->factorySDF->Root()->InsertElement(
-          model->GetSDF()->Clone());
-
-      std::string newName = model->GetName() + "_clone";
-      newName = this->UniqueModelName(newName);
-
-      this->dataPtr->factorySDF->Root()->GetElement("model")->GetAttribute(
-          "name")->Set(newName);
-    }
-    else
-    {
-      gzerr << "Unable to load sdf from factory message."
-        << "No SDF or SDF filename specified.\n";
-      continue;
     }
 
     if (factoryMsg.has_edit_name())
     {
-      BasePtr base(
-        this->dataPtr->rootElement->GetByName(factoryMsg.edit_name()));
+      BasePtr base(this->BaseByName(factoryMsg.edit_name()));
       if (base)
       {
         sdf::ElementPtr elem;
-        if (this->dataPtr->factorySDF->Root()->GetName() == "sdf")
-          elem = this->dataPtr->factorySDF->Root()->GetFirstElement();
+        if (factorySDF->Root()->GetName() == "sdf")
+          elem = factorySDF->Root()->GetFirstElement();
         else
-          elem = this->dataPtr->factorySDF->Root();
+          elem = factorySDF->Root();
 
         base->UpdateParameters(elem);
       }
+      PublishFactoryResponse(responsePub, base != nullptr, "",
+          factoryMsg.edit_name());
     }
     else
     {
@@ -2250,12 +4251,13 @@ void World::ProcessFactoryMsgs()
       bool isModel = false;
       bool isLight = false;
 
-      sdf::ElementPtr elem = this->dataPtr->factorySDF->Root()->Clone();
+      sdf::ElementPtr elem = factorySDF->Root()->Clone();
 
       if (!elem)
       {
         gzerr << "Invalid SDF:";
-        this->dataPtr->factorySDF->Root()->PrintValues("");
+        factorySDF->Root()->PrintValues("");
+        PublishFactoryResponse(responsePub, false, "", "");
         continue;
       }
 
@@ -2280,7 +4282,8 @@ void World::ProcessFactoryMsgs()
       else
       {
         gzerr << "Unable to find a model, light, or actor in:\n";
-        this->dataPtr->factorySDF->Root()->PrintValues("");
+        factorySDF->Root()->PrintValues("");
+        PublishFactoryResponse(responsePub, false, "", "");
         continue;
       }
 
@@ -2296,6 +4299,8 @@ void World::ProcessFactoryMsgs()
         ActorPtr actor = this->LoadActor(elem, this->dataPtr->rootElement);
         actor->Init();
         actor->LoadPlugins();
+        PublishFactoryResponse(responsePub, true, "actor",
+            actor->GetName());
       }
       else if (isModel)
       {
@@ -2304,6 +4309,7 @@ void World::ProcessFactoryMsgs()
         if (entityName.empty())
         {
           gzerr << "Can't load model with empty name" << std::endl;
+          PublishFactoryResponse(responsePub, false, "model", "");
           continue;
         }
 
@@ -2316,6 +4322,7 @@ void World::ProcessFactoryMsgs()
             gzwarn << "A model named [" << entityName << "] already exists "
                   << "and allow_renaming is false. Model won't be inserted."
                   << std::endl;
+            PublishFactoryResponse(responsePub, false, "model", entityName);
             continue;
           }
 
@@ -2335,6 +4342,7 @@ void World::ProcessFactoryMsgs()
   // Load models
   for (auto const &elem : modelsToLoad)
   {
+    const std::string name = elem->Get<std::string>("name");
     try
     {
       std::lock_guard<std::mutex> lock(this->dataPtr->factoryDeleteMutex);
@@ -2345,26 +4353,83 @@ void World::ProcessFactoryMsgs()
         model->Init();
         model->LoadPlugins(this->dataPtr->modelPluginLoadingTimeout);
       }
+      PublishFactoryResponse(responsePub, model != nullptr, "model", name);
     }
     catch(...)
     {
       gzerr << "Loading model from factory message failed\n";
+      PublishFactoryResponse(responsePub, false, "model", name);
+    }
+  }
+
+  // Instantiate model templates
+  std::list<std::pair<sdf::ElementPtr, std::vector<ModelInstance> > >
+    modelInstances;
+  {
+    std::lock_guard<std::recursive_mutex> lock(this->dataPtr->receiveMutex);
+    modelInstances.swap(this->dataPtr->modelInstances);
+  }
+
+  for (auto const &templateInstances : modelInstances)
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->factoryDeleteMutex);
+    for (auto const &instance : templateInstances.second)
+    {
+      // Each model keeps and updates its own DOM, so it gets a copy of the
+      // template rather than a parse of its string.
+      sdf::ElementPtr elem = templateInstances.first->Clone();
+      std::string name = instance.name;
+      if (name.empty() || this->ModelByName(name))
+      {
+        name = this->UniqueModelName(name.empty() ?
+            elem->Get<std::string>("name") : name);
+      }
+      elem->GetAttribute("name")->Set(name);
+      elem->GetElement("pose")->Set(instance.pose);
+      elem->SetParent(this->dataPtr->sdf);
+      elem->GetParent()->InsertElement(elem);
+
+      try
+      {
+        ModelPtr model = this->LoadModel(elem, this->dataPtr->rootElement);
+        if (model != nullptr)
+        {
+          model->Init();
+          model->LoadPlugins(this->dataPtr->modelPluginLoadingTimeout);
+          if (instance.scale != ignition::math::Vector3d::One)
+            model->SetScale(instance.scale, true);
+
+          // Only the template keeps its visual elements, instead of every
+          // instance until the next update.
+          if (this->dataPtr->compactSDF)
+            model->CompactSDF();
+        }
+        PublishFactoryResponse(responsePub, model != nullptr, "model", name);
+      }
+      catch(...)
+      {
+        gzerr << "Loading model instance [" << name << "] failed\n";
+        PublishFactoryResponse(responsePub, false, "model", name);
+      }
     }
   }
 
   // Load lights
   for (auto const &elem : lightsToLoad)
   {
+    const std::string name = elem->Get<std::string>("name");
     try
     {
       std::lock_guard<std::mutex> lock(this->dataPtr->factoryDeleteMutex);
 
       LightPtr light = this->LoadLight(elem, this->dataPtr->rootElement);
       light->Init();
+      PublishFactoryResponse(responsePub, true, "light", name);
     }
     catch(...)
     {
       gzerr << "Loading light from factory message failed\n";
+      PublishFactoryResponse(responsePub, false, "light", name);
     }
   }
 }
@@ -2384,17 +4449,15 @@ ModelPtr World::ModelBelowPoint(const ignition::math::Vector3d &_pt) const
 //////////////////////////////////////////////////
 EntityPtr World::EntityBelowPoint(const ignition::math::Vector3d &_pt) const
 {
-  std::string entityName;
-  double dist;
-  ignition::math::Vector3d end;
-
-  end = _pt;
-  end.Z() -= 1000;
+  std::vector<RayQuery> rays(1);
+  rays[0].start = _pt;
+  rays[0].end = _pt;
+  rays[0].end.Z() -= 1000;
 
+  std::vector<RayQueryResult> results;
   this->dataPtr->physicsEngine->InitForThread();
-  this->dataPtr->testRay->SetPoints(_pt, end);
-  this->dataPtr->testRay->GetIntersection(dist, entityName);
-  return this->EntityByName(entityName);
+  this->dataPtr->physicsEngine->CastRays(rays, results);
+  return this->EntityByName(results[0].collision);
 }
 
 //////////////////////////////////////////////////
@@ -2532,28 +4595,48 @@ void World::SetState(const WorldState &_state)
 //////////////////////////////////////////////////
 void World::InsertModelFile(const std::string &_sdfFilename)
 {
-  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->receiveMutex);
   msgs::Factory msg;
   msg.set_sdf_filename(_sdfFilename);
-  this->dataPtr->factoryMsgs.push_back(msg);
+  this->QueueFactoryMsg(msg);
 }
 
 //////////////////////////////////////////////////
 void World::InsertModelSDF(const sdf::SDF &_sdf)
 {
-  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->receiveMutex);
   msgs::Factory msg;
   msg.set_sdf(_sdf.ToString());
-  this->dataPtr->factoryMsgs.push_back(msg);
+  this->QueueFactoryMsg(msg);
 }
 
 //////////////////////////////////////////////////
 void World::InsertModelString(const std::string &_sdfString)
 {
-  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->receiveMutex);
   msgs::Factory msg;
   msg.set_sdf(_sdfString);
-  this->dataPtr->factoryMsgs.push_back(msg);
+  this->QueueFactoryMsg(msg);
+}
+
+//////////////////////////////////////////////////
+void World::InsertModelInstances(sdf::ElementPtr _model,
+    const std::vector<ModelInstance> &_instances)
+{
+  if (_model && _model->GetName() != "model")
+    _model = _model->HasElement("model") ? _model->GetElement("model") :
+      sdf::ElementPtr();
+
+  if (!_model)
+  {
+    gzerr << "Unable to insert model instances, the template has no model\n";
+    return;
+  }
+
+  if (_instances.empty())
+    return;
+
+  // Copy the template, the caller may change it afterwards
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->receiveMutex);
+  this->dataPtr->modelInstances.push_back(
+      std::make_pair(_model->Clone(), _instances));
 }
 
 //////////////////////////////////////////////////
@@ -2586,6 +4669,13 @@ void World::DisableAllModels()
 //////////////////////////////////////////////////
 void World::UpdateStateSDF()
 {
+  // The dropped elements are regenerated until the next update
+  if (this->dataPtr->compactSDF)
+  {
+    SetModelsCompactSDF(*this->dataPtr, false);
+    this->dataPtr->sdfCompactPending = true;
+  }
+
   this->dataPtr->sdf->Update();
   sdf::ElementPtr stateElem = this->dataPtr->sdf->GetElement("state");
   stateElem->ClearElements();
@@ -2621,6 +4711,13 @@ void World::LogModelResources()
     }
   };
 
+  // The resources are found in the visual elements
+  if (this->dataPtr->compactSDF)
+  {
+    SetModelsCompactSDF(*this->dataPtr, false);
+    this->dataPtr->sdfCompactPending = true;
+  }
+
   // record model resources if option is enabled.
   for (auto const &model : this->dataPtr->models)
   {
@@ -2713,12 +4810,8 @@ bool World::OnLog(std::ostringstream &_stream)
       std::lock_guard<std::mutex> lock(this->dataPtr->logBufferMutex);
       this->dataPtr->currentStateBuffer ^= 1;
     }
-    for (auto const &worldState : this->dataPtr->states[bufferIndex])
-    {
-      _stream << "<sdf version='" << SDF_VERSION << "'>"
-              << worldState
-              << "</sdf>";
-    }
+    for (auto const &logState : this->dataPtr->states[bufferIndex])
+      WriteLogState(logState, _stream);
 
     this->dataPtr->states[bufferIndex].clear();
   }
@@ -2730,22 +4823,16 @@ bool World::OnLog(std::ostringstream &_stream)
     std::lock_guard<std::mutex> lock(this->dataPtr->logBufferMutex);
 
     // Output any data that may have been pushed onto the queue
-    for (size_t i = 0;
-        i < this->dataPtr->states[this->dataPtr->currentStateBuffer^1].size();
-        ++i)
+    for (auto const &logState :
+        this->dataPtr->states[this->dataPtr->currentStateBuffer^1])
     {
-      _stream << "<sdf version='" << SDF_VERSION << "'>"
-        << this->dataPtr->states[this->dataPtr->currentStateBuffer^1][i]
-        << "</sdf>";
+      WriteLogState(logState, _stream);
     }
 
-    for (size_t i = 0;
-        i < this->dataPtr->states[this->dataPtr->currentStateBuffer].size();
-        ++i)
+    for (auto const &logState :
+        this->dataPtr->states[this->dataPtr->currentStateBuffer])
     {
-      _stream << "<sdf version='" << SDF_VERSION << "'>"
-        << this->dataPtr->states[this->dataPtr->currentStateBuffer][i]
-        << "</sdf>";
+      WriteLogState(logState, _stream);
     }
 
     // Clear everything.
@@ -2754,6 +4841,8 @@ bool World::OnLog(std::ostringstream &_stream)
     this->dataPtr->stateToggle = 0;
     this->dataPtr->prevStates[0] = WorldState();
     this->dataPtr->prevStates[1] = WorldState();
+    this->dataPtr->logKeyframeState = WorldState();
+    this->dataPtr->logKeyframeNeeded = true;
   }
 
   this->LogModelResources();
@@ -2764,6 +4853,10 @@ bool World::OnLog(std::ostringstream &_stream)
 //////////////////////////////////////////////////
 void World::ProcessMessages()
 {
+  // The poses of the primary are published below as if they moved here
+  if (this->dataPtr->sensorOffloadFollower)
+    this->ApplySensorOffload();
+
   {
     std::lock_guard<std::recursive_mutex> lock(this->dataPtr->receiveMutex);
 
@@ -2774,7 +4867,11 @@ void World::ProcessMessages()
         (this->dataPtr->poseLocalPub &&
          this->dataPtr->poseLocalPub->HasConnections()))
     {
-      msgs::PosesStamped msg;
+      // Reuse the message of the previous step. Clear keeps the pose
+      // sub-messages around, so add_pose does not allocate.
+      msgs::PosesStamped &msg = this->dataPtr->posesMsg;
+      msg.Clear();
+      const bool names = this->dataPtr->publishPoseNames;
 
       // Time stamp this PosesStamped message
       msgs::Set(msg.mutable_time(), this->SimTime());
@@ -2784,44 +4881,27 @@ void World::ProcessMessages()
       {
         for (auto const &model : this->dataPtr->publishModelPoses)
         {
-          std::list<ModelPtr> modelList;
-          modelList.push_back(model);
-          while (!modelList.empty())
-          {
-            ModelPtr m = modelList.front();
-            modelList.pop_front();
-            msgs::Pose *poseMsg = msg.add_pose();
+          // The layout is only rebuilt when the model gains or loses links
+          // or nested models.
+          auto &layout = this->dataPtr->poseLayouts[model.get()];
+          if (!PoseLayoutValid(layout))
+            BuildPoseLayout(model.get(), layout);
 
+          for (auto const &entry : layout)
+          {
             // Publish the model's relative pose
-            poseMsg->set_name(m->GetScopedName());
-            poseMsg->set_id(m->GetId());
-            msgs::Set(poseMsg, m->RelativePose());
+            AddPose(*entry.model, names, msg);
 
             // Publish each of the model's child links relative poses
-            Link_V links = m->GetLinks();
-            for (auto const &link : links)
-            {
-              poseMsg = msg.add_pose();
-              poseMsg->set_name(link->GetScopedName());
-              poseMsg->set_id(link->GetId());
-              msgs::Set(poseMsg, link->RelativePose());
-            }
-
-            // add all nested models to the queue
-            Model_V models = m->NestedModels();
-            for (auto const &n : models)
-              modelList.push_back(n);
+            for (auto const &link : entry.model->GetLinks())
+              AddPose(*link, names, msg);
           }
         }
 
         for (auto const &light : this->dataPtr->publishLightPoses)
         {
-          msgs::Pose *poseMsg = msg.add_pose();
-
           // Publish the light's pose
-          poseMsg->set_name(light->GetScopedName());
-          poseMsg->set_id(light->GetId());
-          msgs::Set(poseMsg, light->RelativePose());
+          AddPose(*light, names, msg);
         }
 
         if (this->dataPtr->posePub && this->dataPtr->posePub->HasConnections())
@@ -2866,8 +4946,7 @@ void World::ProcessMessages()
             modelList.pop_front();
 
             // add all nested models to the queue
-            Model_V models = m->NestedModels();
-            for (auto const &n : models)
+            for (auto const &n : m->NestedModels())
               modelList.push_back(n);
 
             // Publish the model's scale and visual geometry data at the same
@@ -2876,8 +4955,7 @@ void World::ProcessMessages()
             msgs::Model msg;
             msg.set_name(m->GetScopedName());
             msg.set_id(m->GetId());
-            Link_V links = m->GetLinks();
-            for (auto l : links)
+            for (auto const &l : m->GetLinks())
             {
               msgs::Link *linkMsg = msg.add_link();
               linkMsg->set_id(l->GetId());
@@ -2929,6 +5007,17 @@ void World::ProcessMessages()
     this->ProcessLightModifyMsgs();
     this->dataPtr->prevProcessMsgsTime = common::Time::GetWallTime();
   }
+
+  if (this->dataPtr->sceneRequested.exchange(false))
+    this->UpdateSceneSnapshot();
+
+  // Plugins read the SDF of their model while loading, so the models are
+  // compacted once the plugins are loaded.
+  if (this->dataPtr->compactSDF && this->dataPtr->pluginsLoaded &&
+      this->dataPtr->sdfCompactPending.exchange(false))
+  {
+    SetModelsCompactSDF(*this->dataPtr, true);
+  }
 }
 
 //////////////////////////////////////////////////
@@ -2954,13 +5043,220 @@ void World::PublishWorldStats()
     msgs::Set(logStats.mutable_end_time(),
         util::LogPlay::Instance()->LogEndTime());
 
+    // The overview only depends on the frame index, so it is computed once
+    if (!this->dataPtr->logPlayActivitySet)
+    {
+      util::LogPlay::Instance()->Activity(100u,
+          this->dataPtr->logPlayActivity);
+      this->dataPtr->logPlayActivitySet = true;
+    }
+    for (auto const activity : this->dataPtr->logPlayActivity)
+      logStats.add_activity(activity);
+
     this->dataPtr->worldStatsMsg.mutable_log_playback_stats()->CopyFrom(
         logStats);
   }
 
+  if (this->dataPtr->realTimePacing)
+  {
+    const common::RealTimePacer::Statistics pacing =
+      this->dataPtr->pacer.LastWindow();
+    msgs::RealTimePacingStatistics *pacingMsg =
+      this->dataPtr->worldStatsMsg.mutable_real_time_pacing_stats();
+    pacingMsg->set_window(pacing.window);
+    pacingMsg->set_samples(pacing.samples);
+    pacingMsg->set_jitter_mean(pacing.jitterMean);
+    pacingMsg->set_jitter_max(pacing.jitterMax);
+    pacingMsg->set_overruns(pacing.overruns);
+    pacingMsg->set_overrun_max(pacing.overrunMax);
+  }
+
   if (this->dataPtr->statPub && this->dataPtr->statPub->HasConnections())
     this->dataPtr->statPub->Publish(this->dataPtr->worldStatsMsg);
   this->dataPtr->prevStatTime = common::Time::GetWallTime();
+
+  // The transport counters are gathered once per second, when listened to
+  if (this->dataPtr->transportStatsPub &&
+      this->dataPtr->transportStatsPub->HasConnections() &&
+      this->dataPtr->prevStatTime -
+      this->dataPtr->prevTransportStatsTime >= common::Time(1, 0))
+  {
+    msgs::TransportStatistics transportStats;
+    transport::getStats(transportStats);
+    this->dataPtr->transportStatsPub->Publish(transportStats);
+    this->dataPtr->prevTransportStatsTime = this->dataPtr->prevStatTime;
+  }
+
+  this->PublishStatsBreakdown();
+}
+
+//////////////////////////////////////////////////
+void World::PublishStatsBreakdown()
+{
+  // The costs are sampled once per second even without subscribers, so
+  // that a new subscriber gets a full window.
+  auto &samples = this->dataPtr->stepCostSamples;
+  if (!samples.empty() &&
+      this->dataPtr->prevStatTime - samples.back().wallTime <
+      common::Time(1, 0))
+  {
+    return;
+  }
+
+  WorldStepCostSample sample;
+  sample.wallTime = this->dataPtr->prevStatTime;
+  sample.iterations = this->dataPtr->iterations;
+  sample.steps = this->dataPtr->stepCosts;
+  for (auto const &counter : common::CostCounter::Counters())
+  {
+    auto &total = sample.counters[{counter->Group(), counter->Name()}];
+    total.first += counter->Time();
+    total.second += counter->Count();
+    sample.counterAllocations[{counter->Group(), counter->Name()}] +=
+      counter->Allocations();
+  }
+
+  // The contacts and joints of each model, nested ones included
+  std::function<void (const Model_V &)> sampleModels =
+    [&](const Model_V &_models)
+  {
+    for (auto const &model : _models)
+    {
+      sample.models[model->GetScopedName()] = {{model->ContactCount(),
+          model->ContactRowCount(), model->JointRowCount()}};
+      sampleModels(model->NestedModels());
+    }
+  };
+  sampleModels(this->dataPtr->models);
+
+  samples.push_back(std::move(sample));
+  while (samples.size() > kStepCostWindow + 1)
+    samples.pop_front();
+
+  if (samples.size() < 2 || !this->dataPtr->breakdownPub ||
+      !this->dataPtr->breakdownPub->HasConnections())
+  {
+    return;
+  }
+
+  const WorldStepCostSample &first = samples.front();
+  const WorldStepCostSample &last = samples.back();
+
+  msgs::WorldStatisticsBreakdown msg;
+  msgs::Set(msg.mutable_window(), last.wallTime - first.wallTime);
+  msgs::Set(msg.mutable_sim_time(), this->SimTime());
+  msg.set_iterations(last.iterations >= first.iterations ?
+      last.iterations - first.iterations : 0);
+
+  const bool allocations = common::AllocationCounter::Available();
+  for (unsigned int i = 0; i < STEP_PHASE_COUNT; ++i)
+  {
+    const uint64_t count = last.steps.count[i] - first.steps.count[i];
+    if (count == 0)
+      continue;
+    auto cost = msg.add_phase();
+    cost->set_name(kStepPhaseNames[i]);
+    cost->set_time((last.steps.time[i] - first.steps.time[i]) * 1e-9);
+    cost->set_count(count);
+    if (allocations)
+    {
+      const common::AllocationCount made =
+        last.steps.allocations[i] - first.steps.allocations[i];
+      cost->set_allocations(made.count);
+      cost->set_allocation_bytes(made.bytes);
+    }
+  }
+
+  // Counters created during the window count from zero
+  for (auto const &total : last.counters)
+  {
+    auto iter = first.counters.find(total.first);
+    uint64_t time = total.second.first;
+    uint64_t count = total.second.second;
+    common::AllocationCount made = last.counterAllocations.at(total.first);
+    if (iter != first.counters.end() && iter->second.first <= time &&
+        iter->second.second <= count)
+    {
+      time -= iter->second.first;
+      count -= iter->second.second;
+      made = made - first.counterAllocations.at(total.first);
+    }
+
+    msgs::WorldStatisticsBreakdown::Cost *cost = nullptr;
+    if (total.first.first == "plugin")
+      cost = msg.add_plugin();
+    else if (total.first.first == "sensor")
+      cost = msg.add_sensor();
+    else
+      continue;
+    cost->set_name(total.first.second);
+    cost->set_time(time * 1e-9);
+    cost->set_count(count);
+    if (allocations)
+    {
+      cost->set_allocations(made.count);
+      cost->set_allocation_bytes(made.bytes);
+    }
+  }
+
+  // Costs per model: the time of the plugin and sensor counters of the
+  // model, and its contacts and estimated solver rows. The joint rows are
+  // those of the last sample, for each iteration of the window.
+  std::map<std::string, msgs::WorldStatisticsBreakdown::ModelCost>
+    modelCosts;
+  auto windowTime = [&](const std::string &_group, const std::string &_name)
+  {
+    auto iterLast = last.counters.find({_group, _name});
+    if (iterLast == last.counters.end())
+      return 0.0;
+    uint64_t time = iterLast->second.first;
+    auto iterFirst = first.counters.find({_group, _name});
+    if (iterFirst != first.counters.end() && iterFirst->second.first <= time)
+      time -= iterFirst->second.first;
+    return time * 1e-9;
+  };
+  for (auto const &total : last.counters)
+  {
+    if (total.first.first != "model_plugin" &&
+        total.first.first != "model_sensor")
+    {
+      continue;
+    }
+    auto &cost = modelCosts[total.first.second];
+    cost.set_name(total.first.second);
+    if (total.first.first == "model_plugin")
+      cost.set_plugin_time(windowTime(total.first.first, total.first.second));
+    else
+      cost.set_sensor_time(windowTime(total.first.first, total.first.second));
+  }
+  for (auto const &total : last.models)
+  {
+    std::array<uint64_t, 3> counts = total.second;
+    auto iter = first.models.find(total.first);
+    if (iter != first.models.end() && iter->second[0] <= counts[0] &&
+        iter->second[1] <= counts[1])
+    {
+      counts[0] -= iter->second[0];
+      counts[1] -= iter->second[1];
+    }
+    const uint64_t rows = counts[1] + counts[2] * msg.iterations();
+    if (counts[0] == 0 && rows == 0)
+      continue;
+    auto &cost = modelCosts[total.first];
+    cost.set_name(total.first);
+    cost.set_contacts(counts[0]);
+    cost.set_solver_rows(rows);
+  }
+  for (auto const &cost : modelCosts)
+  {
+    if (cost.second.plugin_time() > 0 || cost.second.sensor_time() > 0 ||
+        cost.second.contacts() > 0 || cost.second.solver_rows() > 0)
+    {
+      *msg.add_model() = cost.second;
+    }
+  }
+
+  this->dataPtr->breakdownPub->Publish(msg);
 }
 
 //////////////////////////////////////////////////
@@ -2972,6 +5268,12 @@ bool World::IsLoaded() const
 //////////////////////////////////////////////////
 void World::PublishModelPose(physics::ModelPtr _model)
 {
+  if (g_modelUpdateDeferred)
+  {
+    g_modelUpdateDeferred->publishModelPoses.push_back(_model);
+    return;
+  }
+
   std::lock_guard<std::recursive_mutex> lock(this->dataPtr->receiveMutex);
 
   // Only add if the model name is not in the list
@@ -2985,6 +5287,7 @@ void World::PublishModelScale(physics::ModelPtr _model)
 
   // Only add if the model name is not in the list
   this->dataPtr->publishModelScales.insert(_model);
+  this->SceneModelDirty(_model.get());
 }
 
 //////////////////////////////////////////////////
@@ -2997,96 +5300,284 @@ void World::PublishLightPose(const physics::LightPtr _light)
 }
 
 //////////////////////////////////////////////////
-void World::LogWorker()
+void World::ResetLogQueue(const unsigned int _size)
 {
-  std::unique_lock<std::mutex> lock(this->dataPtr->logMutex);
+  std::lock_guard<std::mutex> lock(this->dataPtr->logMutex);
+  if (_size > 0)
+  {
+    this->dataPtr->logQueue.reset(new common::SpscQueue<WorldLogState>(_size));
+    this->dataPtr->logQueuedTime = -1.0;
+    this->dataPtr->logDropped = 0;
+    util::LogRecord::Instance()->SetQueueStatus(0, 0, common::Time::Zero);
+  }
+  else
+  {
+    // The queued states that were not recorded are dropped.
+    this->dataPtr->logQueue.reset();
+  }
+}
 
-  WorldPtr self = shared_from_this();
-  this->dataPtr->logPrevIteration = this->dataPtr->iterations;
+//////////////////////////////////////////////////
+void World::QueueLogState()
+{
+  const common::Time simTime = this->SimTime();
+  bool insertDelete;
+  {
+    std::lock_guard<std::mutex> eLock(this->dataPtr->logEventMutex);
+    insertDelete = !this->dataPtr->logInsertions.empty() ||
+        !this->dataPtr->logDeletions.empty();
+  }
 
-  GZ_ASSERT(self, "Self pointer to World is invalid");
+  // Throttle state capture based on log recording frequency.
+  if (this->dataPtr->logQueuedTime >= 0 && !insertDelete &&
+      simTime.Double() - this->dataPtr->logQueuedTime <
+      util::LogRecord::Instance()->Period())
+  {
+    return;
+  }
+
+  if (this->dataPtr->logQueue->Full())
+  {
+    if (util::LogRecord::Instance()->DropOnOverflow())
+    {
+      // The insertions and deletions go with the next state queued.
+      ++this->dataPtr->logDropped;
+      return;
+    }
 
-  // Init the prevUnfilteredState
-  this->dataPtr->prevUnfilteredState.Load(self);
+    std::unique_lock<std::mutex> lock(this->dataPtr->logMutex);
+    this->dataPtr->logContinueCondition.wait(lock, [this]
+        {
+          return !this->dataPtr->logQueue->Full() || this->dataPtr->stop;
+        });
+    if (this->dataPtr->stop)
+      return;
+  }
 
-  while (!this->dataPtr->stop)
+  // Capture the filtered state, a copy of the states of the models and
+  // lights without their SDF, which the log worker needs.
+  WorldState state;
+  {
+    std::lock_guard<std::mutex> dLock(this->dataPtr->entityDeleteMutex);
+    state.LoadWithFilter(shared_from_this(),
+        util::LogRecord::Instance()->Filter());
+  }
+  {
+    std::lock_guard<std::mutex> eLock(this->dataPtr->logEventMutex);
+    state.SetInsertions(this->dataPtr->logInsertions);
+    state.SetDeletions(this->dataPtr->logDeletions);
+    this->dataPtr->logInsertions.clear();
+    this->dataPtr->logDeletions.clear();
+  }
+
+  // Only this thread pushes, so the queue has room.
+  WorldLogState logState;
+  logState.state = std::move(state);
+  logState.digest = StateDigestMarker(*this->dataPtr);
+  this->dataPtr->logQueue->Push(std::move(logState));
+  this->dataPtr->logQueuedTime = simTime.Double();
+}
+
+//////////////////////////////////////////////////
+void World::RecordLogState(const WorldPtr &_self, WorldState *_snapshot,
+    const std::string &_digest)
+{
+  // The digest of the step the state is captured after.
+  const std::string digest = _snapshot ? _digest :
+      StateDigestMarker(*this->dataPtr);
+
+  // Insertions and deletions are recorded by the world as they happen,
+  // which avoids capturing and diffing the unfiltered world state every
+  // iteration. A queued state has those that happened before its capture.
+  std::vector<std::string> insertions;
+  std::vector<std::string> deletions;
+  if (_snapshot)
+  {
+    insertions = _snapshot->Insertions();
+    deletions = _snapshot->Deletions();
+  }
+  else
+  {
+    std::lock_guard<std::mutex> eLock(this->dataPtr->logEventMutex);
+    std::swap(insertions, this->dataPtr->logInsertions);
+    std::swap(deletions, this->dataPtr->logDeletions);
+  }
+
+  if (!insertions.empty())
   {
-    // get unfiltered world state
-    WorldState unfilteredState;
+    // Replace the names of the inserted entities with their SDF.
+    std::lock_guard<std::mutex> dLock(this->dataPtr->entityDeleteMutex);
+    std::vector<std::string> insertionsSDF;
+    insertionsSDF.reserve(insertions.size());
+    for (auto const &name : insertions)
     {
-      std::lock_guard<std::mutex> dLock(this->dataPtr->entityDeleteMutex);
-      unfilteredState.Load(self);
+      if (ModelPtr model = this->ModelByName(name))
+        insertionsSDF.push_back(model->UnscaledSDF()->ToString(""));
+      else if (LightPtr light = this->LightByName(name))
+        insertionsSDF.push_back(light->GetSDF()->ToString(""));
     }
+    insertions = std::move(insertionsSDF);
+  }
+  bool insertDelete = !insertions.empty() || !deletions.empty();
+
+  // Throttle state capture based on log recording frequency. Queued
+  // states were throttled when captured.
+  auto simTime = _snapshot ? _snapshot->GetSimTime() : this->SimTime();
+  if (_snapshot || (simTime - this->dataPtr->logLastStateTime >=
+      util::LogRecord::Instance()->Period()) || insertDelete)
+  {
+    int currState = (this->dataPtr->stateToggle + 1) % 2;
 
-    // compute world state diff and find out about insertions and deletions
-    std::vector<std::string> insertions;
-    std::vector<std::string> deletions;
-    bool insertDelete = false;
+    // compute diff for filtered states
+    if (_snapshot)
+      this->dataPtr->prevStates[currState] = std::move(*_snapshot);
+    else
+    {
+      std::string filterStr = util::LogRecord::Instance()->Filter();
+      std::lock_guard<std::mutex> dLock(this->dataPtr->entityDeleteMutex);
+      this->dataPtr->prevStates[currState].LoadWithFilter(_self, filterStr);
+    }
+    WorldState diffState = this->dataPtr->prevStates[currState] -
+        this->dataPtr->prevStates[this->dataPtr->stateToggle];
+    this->dataPtr->logPrevIteration = this->dataPtr->iterations;
 
+    if (!diffState.IsZero() || insertDelete)
     {
-      WorldState unfilteredDiffState = unfilteredState -
-          this->dataPtr->prevUnfilteredState;
-      if (!unfilteredDiffState.IsZero())
+      this->dataPtr->stateToggle = currState;
       {
-        insertions = unfilteredDiffState.Insertions();
-        deletions = unfilteredDiffState.Deletions();
-        insertDelete = !insertions.empty() || !deletions.empty();
+        // Store the entire current state (instead of the diffState). A slow
+        // moving link may never be captured if only diff state is recorded.
+        std::lock_guard<std::mutex> bLock(this->dataPtr->logBufferMutex);
+
+        this->dataPtr->prevStates[currState].SetInsertions(insertions);
+        this->dataPtr->prevStates[currState].SetDeletions(deletions);
+
+        WorldLogState logState;
+        logState.state = this->dataPtr->prevStates[currState];
+        logState.digest = digest;
+
+        // Between keyframes, store the models and lights that changed
+        // since the state a player has, rather than since the previous
+        // capture, for the same reason.
+        const double keyframePeriod =
+            util::LogRecord::Instance()->KeyframePeriod();
+        if (keyframePeriod > 0 && !this->dataPtr->logKeyframeNeeded &&
+            simTime >= this->dataPtr->logKeyframeTime &&
+            simTime - this->dataPtr->logKeyframeTime < keyframePeriod)
+        {
+          logState.state.RemoveUnchanged(this->dataPtr->logKeyframeState);
+          logState.delta = true;
+          this->dataPtr->logKeyframeState.Merge(logState.state);
+        }
+        else
+        {
+          this->dataPtr->logKeyframeState = logState.state;
+          this->dataPtr->logKeyframeTime = simTime;
+          this->dataPtr->logKeyframeNeeded = false;
+        }
+
+        this->dataPtr->states[this->dataPtr->currentStateBuffer].push_back(
+            std::move(logState));
+
+        // Tell the logger to update, once the number of states exceeds 1000
+        if (this->dataPtr->states[this->dataPtr->currentStateBuffer].size() >
+            1000)
+        {
+          util::LogRecord::Instance()->Notify();
+        }
       }
     }
-    this->dataPtr->prevUnfilteredState = unfilteredState;
 
-    // Throttle state capture based on log recording frequency.
-    auto simTime = this->SimTime();
-    if ((simTime - this->dataPtr->logLastStateTime >=
-        util::LogRecord::Instance()->Period()) || insertDelete)
-    {
-      int currState = (this->dataPtr->stateToggle + 1) % 2;
+    this->dataPtr->logLastStateTime = simTime;
+  }
+}
 
-      std::string filterStr = util::LogRecord::Instance()->Filter();
-      // compute diff for filtered states
+//////////////////////////////////////////////////
+void World::LogWorker()
+{
+  common::ThreadConfig::Instance()->Apply("world_log");
+  std::unique_lock<std::mutex> lock(this->dataPtr->logMutex);
+
+  WorldPtr self = shared_from_this();
+  this->dataPtr->logPrevIteration = this->dataPtr->iterations;
+
+  GZ_ASSERT(self, "Self pointer to World is invalid");
+
+  // Entities loaded before the worker started are part of the first
+  // recorded state, they are not insertions.
+  {
+    std::lock_guard<std::mutex> eLock(this->dataPtr->logEventMutex);
+    this->dataPtr->logInsertions.clear();
+    this->dataPtr->logDeletions.clear();
+  }
+
+  while (!this->dataPtr->stop)
+  {
+    if (this->dataPtr->logQueue)
+    {
+      // The states were captured by the simulation.
+      WorldLogState snapshot;
+      bool recorded = false;
+      while (this->dataPtr->logQueue->Pop(snapshot))
       {
-        std::lock_guard<std::mutex> dLock(this->dataPtr->entityDeleteMutex);
-        this->dataPtr->prevStates[currState].LoadWithFilter(self, filterStr);
+        const common::Time time = snapshot.state.GetSimTime();
+        this->RecordLogState(self, &snapshot.state, snapshot.digest);
+        util::LogRecord::Instance()->SetQueueStatus(
+            this->dataPtr->logQueue->Size(), this->dataPtr->logDropped,
+            std::max(0.0, this->dataPtr->logQueuedTime - time.Double()));
+        recorded = true;
       }
-      WorldState diffState = this->dataPtr->prevStates[currState] -
-          this->dataPtr->prevStates[this->dataPtr->stateToggle];
-      this->dataPtr->logPrevIteration = this->dataPtr->iterations;
 
-      if (!diffState.IsZero() || insertDelete)
+      if (!recorded)
       {
-        this->dataPtr->stateToggle = currState;
-        {
-          // Store the entire current state (instead of the diffState). A slow
-          // moving link may never be captured if only diff state is recorded.
-          std::lock_guard<std::mutex> bLock(this->dataPtr->logBufferMutex);
-
-          this->dataPtr->prevStates[currState].SetInsertions(insertions);
-          this->dataPtr->prevStates[currState].SetDeletions(deletions);
-          this->dataPtr->states[this->dataPtr->currentStateBuffer].push_back(
-              this->dataPtr->prevStates[currState]);
-
-          // Tell the logger to update, once the number of states exceeds 1000
-          if (this->dataPtr->states[this->dataPtr->currentStateBuffer].size() >
-              1000)
-          {
-            util::LogRecord::Instance()->Notify();
-          }
-        }
+        util::LogRecord::Instance()->SetQueueStatus(0,
+            this->dataPtr->logDropped, common::Time::Zero);
       }
-
-      this->dataPtr->logLastStateTime = simTime;
     }
+    else
+      this->RecordLogState(self, nullptr);
 
     this->dataPtr->logContinueCondition.notify_all();
 
-    // Wait until there is work to be done.
-    this->dataPtr->logCondition.wait(lock);
+    // Wait until there is work to be done. The simulation does not lock
+    // the mutex to queue states, so a notification may be missed.
+    if (this->dataPtr->logQueue)
+    {
+      this->dataPtr->logCondition.wait_for(lock,
+          std::chrono::milliseconds(10));
+    }
+    else
+      this->dataPtr->logCondition.wait(lock);
   }
 
   // Make sure nothing is blocked by this thread.
   this->dataPtr->logContinueCondition.notify_all();
 }
 
+//////////////////////////////////////////////////
+void World::LogInsertion(const std::string &_name)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->logEventMutex);
+  this->dataPtr->logInsertions.push_back(_name);
+}
+
+//////////////////////////////////////////////////
+void World::LogDeletion(const std::string &_name)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->logEventMutex);
+
+  // An entity that is deleted before the log worker saw its insertion
+  // never made it into the log.
+  auto &insertions = this->dataPtr->logInsertions;
+  auto it = std::find(insertions.begin(), insertions.end(), _name);
+  if (it != insertions.end())
+  {
+    insertions.erase(it);
+    return;
+  }
+  this->dataPtr->logDeletions.push_back(_name);
+}
+
 /////////////////////////////////////////////////
 uint32_t World::Iterations() const
 {
@@ -3103,17 +5594,13 @@ void World::RemoveModel(const std::string &_name)
 
   // Remove all the dirty poses from the delete entity.
   {
-    for (auto entity = this->dataPtr->dirtyPoses.begin();
-             entity != this->dataPtr->dirtyPoses.end(); ++entity)
-    {
-      if ((*entity)->GetName() == _name ||
-         ((*entity)->GetParent() && (*entity)->GetParent()->GetName() == _name))
-      {
-        this->dataPtr->dirtyPoses.erase(entity++);
-      }
-      else
-        ++entity;
-    }
+    auto &dirtyPoses = this->dataPtr->dirtyPoses;
+    dirtyPoses.erase(std::remove_if(dirtyPoses.begin(), dirtyPoses.end(),
+        [&_name](Entity *_entity)
+        {
+          return _entity->GetName() == _name ||
+            (_entity->GetParent() && _entity->GetParent()->GetName() == _name);
+        }), dirtyPoses.end());
   }
 
   // Remove from SDF
@@ -3150,6 +5637,7 @@ void World::RemoveModel(const std::string &_name)
     {
       if ((*model)->GetName() == _name || (*model)->GetScopedName() == _name)
       {
+        this->LogDeletion((*model)->GetName());
         this->dataPtr->models.erase(model);
         this->dataPtr->rootElement->RemoveChild(_name);
         break;
@@ -3172,6 +5660,7 @@ void World::RemoveModel(const std::string &_name)
           // list
           (*light)->GetParent()->RemoveChild(*light);
         }
+        this->LogDeletion((*light)->GetName());
         this->dataPtr->lights.erase(light);
         break;
       }
@@ -3190,9 +5679,14 @@ void World::RemoveModel(const std::string &_name)
     }
   }
 
+  // The partitions may still reference the removed entity.
+  this->dataPtr->modelPartitionsDirty = true;
+
   // Cleanup the publishModelPoses list.
   {
     std::lock_guard<std::recursive_mutex> lock2(this->dataPtr->receiveMutex);
+    // The cached pose layouts may point to the removed model.
+    this->dataPtr->poseLayouts.clear();
     for (auto model = this->dataPtr->publishModelPoses.begin();
              model != this->dataPtr->publishModelPoses.end(); ++model)
     {
@@ -3272,8 +5766,7 @@ void World::SetWindEnabled(const bool _enable)
 
   for (auto const &model : this->dataPtr->models)
   {
-    Link_V links = model->GetLinks();
-    for (auto const &link : links)
+    for (auto const &link : model->GetLinks())
     {
       if (link->WindMode())
         link->SetWindEnabled(this->dataPtr->enableWind);
@@ -3297,6 +5790,11 @@ void World::SetAtmosphereEnabled(const bool _enable)
 void World::_AddDirty(Entity *_entity)
 {
   GZ_ASSERT(_entity != nullptr, "_entity is nullptr");
+  if (g_modelUpdateDeferred)
+  {
+    g_modelUpdateDeferred->dirtyPoses.push_back(_entity);
+    return;
+  }
   this->dataPtr->dirtyPoses.push_back(_entity);
 }
 
@@ -3406,14 +5904,27 @@ bool World::PluginInfoService(const ignition::msgs::StringMsg &_req,
 //////////////////////////////////////////////////
 bool World::SceneInfoService(msgs::Scene &_res)
 {
-  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->receiveMutex);
+  // The world thread rebuilds the snapshot on its next update, so the
+  // entities are not accessed from this thread. A world that does not
+  // update serves the last snapshot.
+  std::shared_ptr<const std::string> snapshot;
+  {
+    std::unique_lock<std::mutex> snapshotLock(
+        this->dataPtr->sceneSnapshotMutex);
+    const uint64_t count = this->dataPtr->sceneSnapshotCount;
+    this->dataPtr->sceneRequested = true;
+    this->dataPtr->sceneSnapshotCondition.wait_for(snapshotLock,
+        std::chrono::seconds(1), [&]()
+        {
+          return this->dataPtr->sceneSnapshotCount != count;
+        });
+    snapshot = this->dataPtr->sceneSnapshot;
+  }
 
-  // Copy implementation from ProcessRequestMsgs
-  this->dataPtr->sceneMsg.clear_model();
-  this->dataPtr->sceneMsg.clear_light();
-  this->BuildSceneMsg(this->dataPtr->sceneMsg, this->dataPtr->rootElement);
+  if (!snapshot || !_res.ParseFromString(*snapshot))
+    return false;
 
-  _res = this->dataPtr->sceneMsg;
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->receiveMutex);
 
   for (auto road : this->dataPtr->roads)
   {
@@ -17,6 +17,7 @@
 #ifndef GAZEBO_PHYSICS_WORLD_HH_
 #define GAZEBO_PHYSICS_WORLD_HH_
 
+#include <functional>
 #include <vector>
 #include <list>
 #include <set>
@@ -26,6 +27,10 @@
 
 #include <boost/enable_shared_from_this.hpp>
 
+#include <ignition/math/AxisAlignedBox.hh>
+#include <ignition/math/Frustum.hh>
+#include <ignition/math/Pose3.hh>
+#include <ignition/math/Vector3.hh>
 #include <sdf/sdf.hh>
 
 #include "gazebo/transport/TransportTypes.hh"
@@ -35,6 +40,7 @@
 #include "gazebo/common/CommonTypes.hh"
 #include "gazebo/common/UpdateInfo.hh"
 #include "gazebo/common/Event.hh"
+#include "gazebo/common/SimTimeNs.hh"
 #include "gazebo/common/URI.hh"
 
 #include "gazebo/physics/Base.hh"
@@ -60,10 +66,27 @@ namespace gazebo
   {
     /// Forward declare private data class.
     class WorldPrivate;
+    class StepSizeController;
 
     /// \addtogroup gazebo_physics
     /// \{
 
+    /// \class ModelInstance World.hh physics/physics.hh
+    /// \brief Overrides of one model created from a template by
+    /// World::InsertModelInstances.
+    class GZ_PHYSICS_VISIBLE ModelInstance
+    {
+      /// \brief Name of the model. A unique name is generated if a model
+      /// with this name exists.
+      public: std::string name;
+
+      /// \brief Pose of the model.
+      public: ignition::math::Pose3d pose;
+
+      /// \brief Scale of the model.
+      public: ignition::math::Vector3d scale = ignition::math::Vector3d::One;
+    };
+
     /// \class World World.hh physics/physics.hh
     /// \brief The world provides access to all other object within a simulated
     /// environment.
@@ -156,6 +179,13 @@ namespace gazebo
       /// \return Reference to the wind.
       public: physics::Wind &Wind() const;
 
+      /// \brief Get a reference to the battery system, which updates the
+      /// linear batteries of the models in one pass. The update rate can
+      /// be set with the <ignition:battery_update_rate> element of the
+      /// world SDF.
+      /// \return Reference to the battery system.
+      public: BatterySystem &Batteries() const;
+
       /// \brief Return the spherical coordinates converter.
       /// \return Pointer to the spherical coordinates converter.
       public: common::SphericalCoordinatesPtr SphericalCoords() const;
@@ -195,6 +225,31 @@ namespace gazebo
       /// \return A list of all the Models in the world.
       public: Model_V Models() const;
 
+      /// \brief Get the models and nested models whose bounding box
+      /// overlaps a box. The world keeps the bounding boxes in a bounding
+      /// volume hierarchy, refreshed once per world iteration, so that many
+      /// queries in the same iteration cost little.
+      /// \param[in] _box The box, in the world frame.
+      /// \return The models, parents before their nested models.
+      public: Model_V ModelsInBox(
+                  const ignition::math::AxisAlignedBox &_box) const;
+
+      /// \brief Get the models and nested models whose bounding box
+      /// overlaps a sphere, see ModelsInBox.
+      /// \param[in] _center Center of the sphere, in the world frame.
+      /// \param[in] _radius Radius of the sphere.
+      /// \return The models, parents before their nested models.
+      public: Model_V ModelsInSphere(const ignition::math::Vector3d &_center,
+                  const double _radius) const;
+
+      /// \brief Get the models and nested models whose bounding box
+      /// overlaps a frustum, as tested by ignition::math::Frustum::Contains,
+      /// see ModelsInBox.
+      /// \param[in] _frustum The frustum, in the world frame.
+      /// \return The models, parents before their nested models.
+      public: Model_V ModelsInFrustum(
+                  const ignition::math::Frustum &_frustum) const;
+
       /// \brief Get the number of lights.
       /// \return The number of lights in the World.
       public: unsigned int LightCount() const;
@@ -215,6 +270,30 @@ namespace gazebo
       /// \brief Reset time and model poses, configurations in simulation.
       public: void Reset();
 
+      /// \brief Take an in-memory snapshot of the simulation state. The
+      /// snapshot holds the simulation time and iteration count, the pose
+      /// of every model and the pose, velocity, force and torque of every
+      /// link. The physics engine adds its own state, such as the ODE body
+      /// state and contact warm start data. Restoring a snapshot does not
+      /// reload any SDF, which makes it much cheaper than Reset or
+      /// SetState for frequent resets.
+      /// \return Handle of the snapshot, to be passed to Restore.
+      /// \sa Restore
+      /// \sa ReleaseSnapshot
+      public: uint32_t Snapshot();
+
+      /// \brief Restore a snapshot taken with Snapshot. Entities that were
+      /// removed since the snapshot was taken are skipped, entities that
+      /// were inserted keep their current state. Plugins are not reset.
+      /// The snapshot stays valid and can be restored again.
+      /// \param[in] _handle Handle returned by Snapshot.
+      /// \return False if the handle is unknown.
+      public: bool Restore(const uint32_t _handle);
+
+      /// \brief Release the memory held by a snapshot.
+      /// \param[in] _handle Handle returned by Snapshot.
+      public: void ReleaseSnapshot(const uint32_t _handle);
+
       /// \brief Print Entity tree.
       /// Prints alls the entities to stdout.
       public: void PrintEntityTree();
@@ -224,6 +303,11 @@ namespace gazebo
       /// \return The current simulation time
       public: common::Time SimTime() const;
 
+      /// \brief Get the world simulation time in nanoseconds, for exact
+      /// scheduling on the hot paths.
+      /// \return The current simulation time.
+      public: common::SimTimeNs SimTimeNs() const;
+
       /// \brief Set the sim time.
       /// \param[in] _t The new simulation time
       public: void SetSimTime(const common::Time &_t);
@@ -250,11 +334,21 @@ namespace gazebo
 
       /// \brief Get an element by name.
       /// Searches the list of entities, and return a pointer to the model
-      /// with a matching _name.
+      /// with a matching _name. Scoped names that were found before are
+      /// resolved from a hash index instead of searching the entity tree.
       /// \param[in] _name The name of the Model to find.
       /// \return A pointer to the entity, or NULL if no entity was found.
       public: BasePtr BaseByName(const std::string &_name) const;
 
+      /// \brief Get an element by id. The id of an element never changes
+      /// and is never reused, so it can be kept as a handle by code that
+      /// looks up the same element often. Lookups are resolved from a hash
+      /// index after the first one.
+      /// \param[in] _id Id of the element, see Base::GetId.
+      /// \return A pointer to the element, or NULL if no element has the
+      /// id, e.g. because it was removed.
+      public: BasePtr BaseById(const uint32_t _id) const;
+
       /// \brief Get a model by name.
       /// This function is the same as BaseByName, but limits the search to
       /// only models.
@@ -313,6 +407,17 @@ namespace gazebo
       /// \param[in] _sdf A reference to an SDF object.
       public: void InsertModelSDF(const sdf::SDF &_sdf);
 
+      /// \brief Insert many models from one SDF model template.
+      /// The template is parsed once; each model is loaded from a copy of
+      /// its DOM with the name, pose and scale of an instance. Meshes and
+      /// mesh collision data are shared between the models. The models
+      /// are inserted together at the next message processing step.
+      /// \param[in] _model A <model> element, or an <sdf> element that
+      /// contains one.
+      /// \param[in] _instances Overrides of each model to insert.
+      public: void InsertModelInstances(sdf::ElementPtr _model,
+                  const std::vector<ModelInstance> &_instances);
+
       /// \brief Return a version of the name with "<world_name>::" removed
       /// \param[in] _name Usually the name of an entity.
       /// \return The stripped world name.
@@ -332,6 +437,180 @@ namespace gazebo
       /// \param[in] _steps The number of steps the World should take.
       public: void Step(const unsigned int _steps);
 
+      /// \brief Get whether the world is stepped in throughput mode.
+      /// \return True if throughput mode is enabled.
+      /// \sa SetThroughputMode
+      public: bool ThroughputMode() const;
+
+      /// \brief Enable or disable throughput mode. In throughput mode a
+      /// world that is not paused is stepped as fast as possible: the real
+      /// time update rate is ignored and no wall clock time is read while
+      /// stepping. World statistics are published and incoming messages
+      /// are processed only once every MessagePeriod steps. A paused world
+      /// is throttled as usual. The default can be set with the
+      /// <ignition:throughput_mode> element of the world SDF.
+      /// \param[in] _enable True to enable throughput mode.
+      public: void SetThroughputMode(const bool _enable);
+
+      /// \brief Get the number of steps between message processing in
+      /// throughput mode.
+      /// \return Number of steps.
+      /// \sa SetMessagePeriod
+      public: unsigned int MessagePeriod() const;
+
+      /// \brief Set the number of steps between message processing in
+      /// throughput mode. The default can be set with the
+      /// <ignition:message_period> element of the world SDF.
+      /// \param[in] _steps Number of steps, values below one are
+      /// treated as one.
+      public: void SetMessagePeriod(const unsigned int _steps);
+
+      /// \brief Compute a digest of the state of the world: the world
+      /// poses and the linear and angular velocities of the links, and the
+      /// positions and velocities of the joints, in id order. Two runs that
+      /// give the same digests after each step have followed the same
+      /// trajectory, bit for bit.
+      /// \return The digest.
+      /// \sa StateHasher
+      public: uint64_t StateDigest() const;
+
+      /// \brief Get whether a state digest is computed after every step.
+      /// \return True if state digests are enabled.
+      /// \sa SetStateDigestEnabled
+      public: bool StateDigestEnabled() const;
+
+      /// \brief Enable or disable the state digest of every step. When
+      /// enabled, the digest is computed after the physics update,
+      /// published on ~/state_digest and written in the frames of the
+      /// recorded logs, where 'gz log --diff-digest' compares them. The
+      /// default can be set with the <ignition:state_digest> element of the
+      /// world SDF.
+      /// \param[in] _enable True to enable the state digests.
+      public: void SetStateDigestEnabled(const bool _enable);
+
+      /// \brief Get whether the state is published to sensor workers.
+      /// \return True if sensor offload is enabled.
+      /// \sa SetSensorOffloadEnabled
+      public: bool SensorOffloadEnabled() const;
+
+      /// \brief Publish the world poses of all the models and links,
+      /// stamped with the sim time, after every step on the
+      /// /gazebo/<world>/sensor_offload/state ignition transport topic,
+      /// which may reach other hosts. Sensor workers follow it to render
+      /// the image sensors of this world.
+      /// \param[in] _enable True to publish the state.
+      /// \sa SetSensorOffloadFollower
+      /// \sa sensors::SensorManager::SetOffloadPrimary
+      public: void SetSensorOffloadEnabled(const bool _enable);
+
+      /// \brief Get whether the world follows the state of a primary.
+      /// \return True if the world is a sensor offload follower.
+      /// \sa SetSensorOffloadFollower
+      public: bool SensorOffloadFollower() const;
+
+      /// \brief Follow the state that a world of the same name publishes
+      /// when SetSensorOffloadEnabled is enabled. The world is paused and
+      /// its physics disabled. The poses and the sim time of the latest
+      /// state are applied when messages are processed.
+      /// \param[in] _enable True to follow the primary.
+      /// \sa sensors::SensorManager::SetOffloadWorker
+      public: void SetSensorOffloadFollower(const bool _enable);
+
+      /// \brief Get whether the visual elements of the models are dropped
+      /// from the SDF after load.
+      /// \return True if compact SDF mode is enabled.
+      /// \sa SetCompactSDFEnabled
+      public: bool CompactSDFEnabled() const;
+
+      /// \brief Enable or disable compact SDF mode. In this mode the
+      /// visual elements of the links are dropped from the retained SDF
+      /// once the model plugins are loaded, and the visuals are kept only
+      /// as messages. The elements are regenerated on demand by
+      /// UpdateStateSDF, and so by SDF and Save, and dropped again on the
+      /// next world update. Code that reads the visual elements of a model
+      /// should call Model::ExpandSDF first. The default can be set with
+      /// the <ignition:compact_sdf> element of the world SDF.
+      /// \param[in] _enable True to enable compact SDF mode.
+      public: void SetCompactSDFEnabled(const bool _enable);
+
+      /// \brief Get whether the step size adapts to the simulation.
+      /// \return True if adaptive step mode is enabled.
+      /// \sa SetAdaptiveStep
+      public: bool AdaptiveStep() const;
+
+      /// \brief Enable or disable adaptive step mode. In this mode the max
+      /// step size of the physics engine is chosen by StepController after
+      /// every step: it grows while the links move smoothly and the
+      /// contacts are shallow, and shrinks on impacts. The sim time
+      /// advances by the chosen step, so sensors and timers keyed off sim
+      /// time stay correct. Contacts are always computed while enabled.
+      /// Disabling restores the step size in use when the mode was
+      /// enabled. The default can be set with the <ignition:adaptive_step>
+      /// element of the world SDF, and the bounds and tolerances with
+      /// <ignition:adaptive_min_step_size>,
+      /// <ignition:adaptive_max_step_size>,
+      /// <ignition:adaptive_velocity_tolerance> and
+      /// <ignition:adaptive_penetration_tolerance>. The bounds default to a
+      /// tenth and four times the max step size of the physics engine.
+      /// \param[in] _enable True to enable adaptive step mode.
+      public: void SetAdaptiveStep(const bool _enable);
+
+      /// \brief Get the controller that chooses the step size in adaptive
+      /// step mode, to change its bounds and tolerances.
+      /// \return The step size controller.
+      /// \sa SetAdaptiveStep
+      public: StepSizeController &StepController() const;
+
+      /// \brief Get whether the steps are paced with absolute deadlines.
+      /// \return True if real time pacing mode is enabled.
+      /// \sa SetRealTimePacing
+      public: bool RealTimePacing() const;
+
+      /// \brief Enable or disable real time pacing mode, meant for hardware
+      /// in the loop runs. In this mode each step waits for a deadline
+      /// that follows the previous one by the update period of the physics
+      /// engine, instead of sleeping for the time the previous step left,
+      /// and the wake up jitter and the overruns are reported in the
+      /// real_time_pacing_stats of the world statistics. The spin time of
+      /// the pacer trades a CPU for a smaller jitter. The default can be set
+      /// with the <ignition:real_time_pacing> element of the world SDF, and
+      /// the spin time in seconds with <ignition:real_time_spin>.
+      /// Throughput mode takes precedence while the world runs.
+      /// \param[in] _enable True to enable real time pacing mode.
+      /// \sa SetRealTimePriority
+      public: void SetRealTimePacing(const bool _enable);
+
+      /// \brief Get the pacer of real time pacing mode, to change its spin
+      /// time or read its statistics.
+      /// \return The pacer.
+      /// \sa SetRealTimePacing
+      public: common::RealTimePacer &Pacer() const;
+
+      /// \brief Get the SCHED_FIFO priority requested for the world thread.
+      /// \return The priority, 0 if none was requested.
+      /// \sa SetRealTimePriority
+      public: int RealTimePriority() const;
+
+      /// \brief Request the SCHED_FIFO policy for the world thread, which is
+      /// applied by the world thread before its next step. This usually
+      /// requires the CAP_SYS_NICE capability, a warning is printed if the
+      /// policy can't be set. The default can be set with the
+      /// <ignition:real_time_priority> element of the world SDF.
+      /// \param[in] _priority Priority, from 1 to 99 on Linux. 0 doesn't
+      /// change the policy of the thread.
+      public: void SetRealTimePriority(const int _priority);
+
+      /// \brief Step the world forward in the calling thread and return
+      /// when done. Unlike Step, the world is not throttled to the real
+      /// time update rate and the pause state is ignored. Incoming messages
+      /// are processed and statistics are published once, after the last
+      /// step. This is meant for worlds that are initialized but not
+      /// running, e.g. worlds stepped by a WorldBatch.
+      /// \param[in] _steps The number of steps to take.
+      /// \return False if the world is running in its own thread, or if
+      /// log recording is active, which requires the run loop.
+      public: bool Advance(const unsigned int _steps);
+
       /// \brief Load a plugin
       /// \param[in] _filename The filename of the plugin.
       /// \param[in] _name A unique name for the plugin.
@@ -372,6 +651,58 @@ namespace gazebo
       /// \param[in] _enable True to enable the atmosphere model.
       public: void SetAtmosphereEnabled(const bool _enable);
 
+      /// \brief Get whether entity names are written to the pose
+      /// messages published on ~/pose/info and ~/pose/local/info.
+      /// \return True if names are published along with the ids.
+      /// \sa SetPublishPoseNames
+      public: bool PublishPoseNames() const;
+
+      /// \brief Set whether entity names are written to the published
+      /// pose messages. Subscribers that already know the scene, such as
+      /// rendering::Scene, only need the entity ids. Leaving the names out
+      /// avoids building a scoped name string for every pose every step.
+      /// The default can be set with the <ignition:publish_pose_names>
+      /// element of the world SDF.
+      /// \param[in] _names True to publish names, false for ids only.
+      public: void SetPublishPoseNames(const bool _names);
+
+      /// \brief Get whether factory messages are read asynchronously.
+      /// \return True if the SDF of factory messages is read on a worker
+      /// thread.
+      /// \sa SetAsyncFactory
+      public: bool AsyncFactory() const;
+
+      /// \brief Enable or disable the asynchronous factory. When enabled,
+      /// the SDF strings and files of ~/factory messages are parsed, and
+      /// their model:// URIs resolved, on a worker thread. Only the
+      /// insertion of the entities happens in the world update, so a spawn
+      /// doesn't stall the simulation while a model is read or downloaded.
+      /// Messages are still handled in the order they were received. The
+      /// default can be set with the <ignition:async_factory> element of
+      /// the world SDF.
+      /// \param[in] _enable True to enable the asynchronous factory.
+      public: void SetAsyncFactory(const bool _enable);
+
+      /// \brief Get the number of threads used to update models.
+      /// \return Number of model update threads. A value of zero or one
+      /// means models are updated serially.
+      /// \sa SetModelUpdateThreads
+      public: unsigned int ModelUpdateThreads() const;
+
+      /// \brief Set the number of threads used to update models during
+      /// World::Update. When more than one thread is requested, top level
+      /// models are grouped into kinematically independent partitions
+      /// (models connected by a joint are kept in the same partition) and
+      /// the partitions are updated in parallel. Side effects that touch
+      /// the world, such as dirty pose and pose publication requests, are
+      /// collected per partition and merged serially afterwards. Actors
+      /// and other non-model entities are always updated serially.
+      /// The default can be set with the
+      /// <ignition:model_update_threads> element of the world SDF.
+      /// \param[in] _threads Number of threads, zero or one to disable
+      /// parallel model updates.
+      public: void SetModelUpdateThreads(const unsigned int _threads);
+
       /// \brief Update the state SDF value from the current state.
       public: void UpdateStateSDF();
 
@@ -515,9 +846,34 @@ namespace gazebo
       /// \brief Step the world once.
       private: void Step();
 
-      /// \brief Step the world once by reading from a log file.
+      /// \brief Step the world once in throughput mode.
+      /// \sa SetThroughputMode
+      private: void ThroughputStep();
+
+      /// \brief Step the world once by reading from a log file. When
+      /// stepping several frames, or playing faster than real time, the
+      /// frames in between are skipped and only the last state is set.
+      /// \sa util::LogPlay::FastForward
       private: void LogStep();
 
+      /// \brief Publish the messages of the topics recorded with the log
+      /// file being played.
+      /// \param[in] _from Simulation time of the previous state played,
+      /// excluded.
+      /// \param[in] _to Simulation time of the state played, included.
+      private: void PublishLogTopics(const common::Time &_from,
+                   const common::Time &_to);
+
+      /// \brief Choose the size of the next step from the last one, in
+      /// adaptive step mode.
+      /// \sa SetAdaptiveStep
+      private: void UpdateStepSize();
+
+      /// \brief Cache the velocities of the awake links after a physics
+      /// step, and clear the caches of the other links.
+      /// \sa Link::CacheKinematics
+      private: void CacheLinkKinematics();
+
       /// \brief Update the world.
       private: void Update();
 
@@ -540,11 +896,29 @@ namespace gazebo
       /// \param[in] _msg The request message.
       private: void OnRequest(ConstRequestPtr &_msg);
 
-      /// \brief Construct a scene message from the known world state
-      /// \param[out] _scene Scene message to build.
-      /// \param[in] _entity Pointer to entity from which to build the scene
-      /// message.
-      private: void BuildSceneMsg(msgs::Scene &_scene, BasePtr _entity);
+      /// \brief Rebuild the pre-serialized scene snapshot if the scene
+      /// changed or the snapshot was served since it was built. Only the
+      /// models that were inserted or modified are filled again, the
+      /// other ones just get their poses refreshed.
+      private: void UpdateSceneSnapshot();
+
+      /// \brief Compute and publish the state digest of the last step.
+      private: void UpdateStateDigest();
+
+      /// \brief Publish the state of the last step to the sensor workers.
+      private: void PublishSensorOffload();
+
+      /// \brief Called when the primary published its state.
+      /// \param[in] _msg The state.
+      private: void OnSensorOffload(const msgs::PosesStamped &_msg);
+
+      /// \brief Apply the last state received from the primary.
+      private: void ApplySensorOffload();
+
+      /// \brief Mark the scene snapshot entry of a model and of the models
+      /// that contain it out of date.
+      /// \param[in] _model The model.
+      private: void SceneModelDirty(const Model *_model);
 
       /// \brief Logs joint information.
       /// \param[in] _msg Incoming joint message.
@@ -554,6 +928,16 @@ namespace gazebo
       /// \param[in] _data The factory message.
       private: void OnFactoryMsg(ConstFactoryPtr &_data);
 
+      /// \brief Queue a factory message, for the factory thread if it
+      /// runs, or else for the next world update.
+      /// \param[in] _msg The factory message.
+      private: void QueueFactoryMsg(const msgs::Factory &_msg);
+
+      /// \brief Read the SDF of the pending factory messages. Used by the
+      /// factory thread.
+      /// \sa SetAsyncFactory
+      private: void FactoryWorker();
+
       /// \brief Called when a model message is received.
       /// \param[in] _msg The model message.
       private: void OnModelMsg(ConstModelPtr &_msg);
@@ -561,6 +945,10 @@ namespace gazebo
       /// \brief TBB version of model updating.
       private: void ModelUpdateTBB();
 
+      /// \brief Rebuild the partitions of kinematically coupled models
+      /// used by World::ModelUpdateTBB.
+      private: void UpdateModelPartitions();
+
       /// \brief Single loop version of model updating.
       private: void ModelUpdateSingleLoop();
 
@@ -573,6 +961,14 @@ namespace gazebo
       /// \param[in] _model Pointer to the model to get the data from.
       private: void FillModelMsg(msgs::Model &_msg, ModelPtr _model);
 
+      /// \brief Get the models and nested models whose bounding box may
+      /// overlap a region, refreshing the bounding boxes if needed.
+      /// \param[in] _overlaps Function testing a box against the region.
+      /// \return The models, parents before their nested models.
+      private: Model_V ModelsOverlapping(const std::function<bool (
+                   const ignition::math::AxisAlignedBox &_box)> &_overlaps)
+                   const;
+
       /// \brief Process all received entity messages.
       /// Must only be called from the World::ProcessMessages function.
       private: void ProcessEntityMsgs();
@@ -614,9 +1010,42 @@ namespace gazebo
       /// \brief Publish the world stats message.
       private: void PublishWorldStats();
 
+      /// \brief Sample the real time spent in the phases of the steps, the
+      /// plugins and the sensor containers once per second, and publish
+      /// the costs over the last seconds on ~/world_stats/breakdown.
+      private: void PublishStatsBreakdown();
+
       /// \brief Thread function for logging state data.
       private: void LogWorker();
 
+      /// \brief Record a state for the log, called by the log worker.
+      /// \param[in] _self Pointer to this world.
+      /// \param[in] _snapshot State captured by QueueLogState, moved from.
+      /// Null to capture the current state.
+      /// \param[in] _digest State digest marker of the captured state,
+      /// ignored without _snapshot.
+      private: void RecordLogState(const WorldPtr &_self,
+                   WorldState *_snapshot, const std::string &_digest = "");
+
+      /// \brief Capture the state to record and queue it for the log
+      /// worker, with a recording queue.
+      /// \sa util::LogRecord::QueueSize
+      private: void QueueLogState();
+
+      /// \brief Create or remove the recording queue.
+      /// \param[in] _size Capacity of the queue, 0 to remove it.
+      private: void ResetLogQueue(const unsigned int _size);
+
+      /// \brief Record the insertion of a model or light for the log
+      /// worker.
+      /// \param[in] _name Name of the inserted entity.
+      private: void LogInsertion(const std::string &_name);
+
+      /// \brief Record the deletion of a model or light for the log
+      /// worker.
+      /// \param[in] _name Name of the deleted entity.
+      private: void LogDeletion(const std::string &_name);
+
       /// \brief Register items in the introspection service.
       private: void RegisterIntrospectionItems();
 
@@ -0,0 +1,434 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+
+#include <ignition/math/Pose3.hh>
+#include <ignition/math/Vector3.hh>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/common/Events.hh"
+#include "gazebo/common/Exception.hh"
+#include "gazebo/physics/Collision.hh"
+#include "gazebo/physics/Contact.hh"
+#include "gazebo/physics/ContactManager.hh"
+#include "gazebo/physics/Joint.hh"
+#include "gazebo/physics/Link.hh"
+#include "gazebo/physics/PhysicsEngine.hh"
+#include "gazebo/physics/PhysicsIface.hh"
+#include "gazebo/physics/World.hh"
+#include "gazebo/physics/WorldArrays.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \internal
+    /// \brief Private data for the WorldArrays class
+    class WorldArraysPrivate
+    {
+      /// \brief Apply the held efforts and wrenches, before each physics
+      /// update of the world.
+      /// \param[in] _info Update information.
+      public: void OnBeforePhysicsUpdate(const common::UpdateInfo &_info)
+      {
+        if (_info.worldName != this->world->Name())
+          return;
+
+        std::lock_guard<std::mutex> lock(this->mutex);
+        if (!this->efforts.empty())
+        {
+          for (size_t i = 0; i < this->joints.size(); ++i)
+          {
+            if (this->joints[i])
+              this->joints[i]->SetForce(0, this->efforts[i]);
+          }
+        }
+        if (!this->wrenches.empty())
+        {
+          for (size_t i = 0; i < this->links.size(); ++i)
+          {
+            if (!this->links[i])
+              continue;
+            const double *w = &this->wrenches[i * 6];
+            this->links[i]->AddForce(
+                ignition::math::Vector3d(w[0], w[1], w[2]));
+            this->links[i]->AddTorque(
+                ignition::math::Vector3d(w[3], w[4], w[5]));
+          }
+        }
+      }
+
+      /// \brief The world.
+      public: WorldPtr world;
+
+      /// \brief The joints, null if not found.
+      public: std::vector<JointPtr> joints;
+
+      /// \brief The links, null if not found.
+      public: std::vector<LinkPtr> links;
+
+      /// \brief Index of each link, to summarize the contacts.
+      public: std::unordered_map<const Link *, size_t> linkIndices;
+
+      /// \brief Held joint efforts, empty if none.
+      public: std::vector<double> efforts;
+
+      /// \brief Held link wrenches, six values per link, empty if none.
+      public: std::vector<double> wrenches;
+
+      /// \brief Protects the held commands.
+      public: std::mutex mutex;
+
+      /// \brief Connection to the before physics update event.
+      public: event::ConnectionPtr updateConnection;
+
+      /// \brief NeverDropContacts value before EnableContacts.
+      public: bool neverDropContacts = false;
+
+      /// \brief True while the contacts are recorded.
+      public: bool contacts = false;
+    };
+  }
+}
+
+using namespace gazebo;
+using namespace physics;
+
+//////////////////////////////////////////////////
+WorldArrays::WorldArrays(WorldPtr _world,
+    const std::vector<std::string> &_joints,
+    const std::vector<std::string> &_links)
+  : dataPtr(new WorldArraysPrivate)
+{
+  this->dataPtr->world = _world;
+
+  for (auto const &name : _joints)
+  {
+    JointPtr joint = boost::dynamic_pointer_cast<Joint>(
+        _world->BaseByName(name));
+    if (!joint)
+      gzerr << "Unable to find joint [" << name << "]\n";
+    this->dataPtr->joints.push_back(joint);
+  }
+
+  for (auto const &name : _links)
+  {
+    LinkPtr link = boost::dynamic_pointer_cast<Link>(
+        _world->EntityByName(name));
+    if (!link)
+      gzerr << "Unable to find link [" << name << "]\n";
+    else
+      this->dataPtr->linkIndices[link.get()] = this->dataPtr->links.size();
+    this->dataPtr->links.push_back(link);
+  }
+
+  this->dataPtr->updateConnection =
+      event::Events::ConnectBeforePhysicsUpdate(
+      std::bind(&WorldArraysPrivate::OnBeforePhysicsUpdate,
+        this->dataPtr.get(), std::placeholders::_1));
+}
+
+//////////////////////////////////////////////////
+WorldArrays::~WorldArrays()
+{
+  this->dataPtr->updateConnection.reset();
+  this->EnableContacts(false);
+}
+
+//////////////////////////////////////////////////
+size_t WorldArrays::JointCount() const
+{
+  return this->dataPtr->joints.size();
+}
+
+//////////////////////////////////////////////////
+size_t WorldArrays::LinkCount() const
+{
+  return this->dataPtr->links.size();
+}
+
+//////////////////////////////////////////////////
+bool WorldArrays::Resolved() const
+{
+  return std::find(this->dataPtr->joints.begin(),
+      this->dataPtr->joints.end(), nullptr) == this->dataPtr->joints.end() &&
+      std::find(this->dataPtr->links.begin(),
+      this->dataPtr->links.end(), nullptr) == this->dataPtr->links.end();
+}
+
+//////////////////////////////////////////////////
+void WorldArrays::SetJointEfforts(const double *_efforts)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->efforts.assign(_efforts,
+      _efforts + this->dataPtr->joints.size());
+}
+
+//////////////////////////////////////////////////
+void WorldArrays::SetJointPositions(const double *_positions)
+{
+  for (size_t i = 0; i < this->dataPtr->joints.size(); ++i)
+  {
+    if (this->dataPtr->joints[i])
+      this->dataPtr->joints[i]->SetPosition(0, _positions[i]);
+  }
+}
+
+//////////////////////////////////////////////////
+void WorldArrays::SetJointVelocities(const double *_velocities)
+{
+  for (size_t i = 0; i < this->dataPtr->joints.size(); ++i)
+  {
+    if (this->dataPtr->joints[i])
+      this->dataPtr->joints[i]->SetVelocity(0, _velocities[i]);
+  }
+}
+
+//////////////////////////////////////////////////
+void WorldArrays::SetLinkWrenches(const double *_wrenches)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->wrenches.assign(_wrenches,
+      _wrenches + this->dataPtr->links.size() * 6);
+}
+
+//////////////////////////////////////////////////
+void WorldArrays::ClearCommands()
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->efforts.clear();
+  this->dataPtr->wrenches.clear();
+}
+
+//////////////////////////////////////////////////
+void WorldArrays::EnableContacts(const bool _enable)
+{
+  if (_enable == this->dataPtr->contacts)
+    return;
+
+  ContactManager *manager =
+      this->dataPtr->world->Physics()->GetContactManager();
+  if (_enable)
+  {
+    this->dataPtr->neverDropContacts = manager->NeverDropContacts();
+    manager->SetNeverDropContacts(true);
+  }
+  else
+  {
+    manager->SetNeverDropContacts(this->dataPtr->neverDropContacts);
+  }
+  this->dataPtr->contacts = _enable;
+}
+
+//////////////////////////////////////////////////
+bool WorldArrays::Step(const unsigned int _steps)
+{
+  if (!this->dataPtr->world->Running())
+    return this->dataPtr->world->Advance(_steps);
+
+  if (!this->dataPtr->world->IsPaused())
+  {
+    gzerr << "Unable to step world [" << this->dataPtr->world->Name()
+          << "], it runs and is not paused\n";
+    return false;
+  }
+  this->dataPtr->world->Step(_steps);
+  return true;
+}
+
+//////////////////////////////////////////////////
+void WorldArrays::LinkPoses(double *_poses) const
+{
+  for (auto const &link : this->dataPtr->links)
+  {
+    const ignition::math::Pose3d pose =
+        link ? link->WorldPose() : ignition::math::Pose3d::Zero;
+    *_poses++ = pose.Pos().X();
+    *_poses++ = pose.Pos().Y();
+    *_poses++ = pose.Pos().Z();
+    *_poses++ = link ? pose.Rot().W() : 0.0;
+    *_poses++ = pose.Rot().X();
+    *_poses++ = pose.Rot().Y();
+    *_poses++ = pose.Rot().Z();
+  }
+}
+
+//////////////////////////////////////////////////
+void WorldArrays::LinkTwists(double *_twists) const
+{
+  for (auto const &link : this->dataPtr->links)
+  {
+    const ignition::math::Vector3d linear =
+        link ? link->WorldLinearVel() : ignition::math::Vector3d::Zero;
+    const ignition::math::Vector3d angular =
+        link ? link->WorldAngularVel() : ignition::math::Vector3d::Zero;
+    *_twists++ = linear.X();
+    *_twists++ = linear.Y();
+    *_twists++ = linear.Z();
+    *_twists++ = angular.X();
+    *_twists++ = angular.Y();
+    *_twists++ = angular.Z();
+  }
+}
+
+//////////////////////////////////////////////////
+void WorldArrays::JointStates(double *_positions, double *_velocities,
+    double *_efforts) const
+{
+  for (size_t i = 0; i < this->dataPtr->joints.size(); ++i)
+  {
+    const JointPtr &joint = this->dataPtr->joints[i];
+    if (_positions)
+      _positions[i] = joint ? joint->Position(0) : 0.0;
+    if (_velocities)
+      _velocities[i] = joint ? joint->GetVelocity(0) : 0.0;
+    if (_efforts)
+      _efforts[i] = joint ? joint->GetForce(0) : 0.0;
+  }
+}
+
+//////////////////////////////////////////////////
+void WorldArrays::ContactSummaries(double *_summaries) const
+{
+  std::fill(_summaries, _summaries + this->dataPtr->links.size() * 2, 0.0);
+
+  ContactManager *manager =
+      this->dataPtr->world->Physics()->GetContactManager();
+  // The contact pool keeps the contacts of earlier steps past the count
+  for (unsigned int c = 0; c < manager->GetContactCount(); ++c)
+  {
+    const Contact *contact = manager->GetContact(c);
+    for (int side = 0; side < 2; ++side)
+    {
+      const Collision *collision =
+          side == 0 ? contact->collision1 : contact->collision2;
+      if (!collision)
+        continue;
+
+      auto iter = this->dataPtr->linkIndices.find(collision->GetLink().get());
+      if (iter == this->dataPtr->linkIndices.end())
+        continue;
+
+      double *summary = &_summaries[iter->second * 2];
+      summary[0] += contact->count;
+      for (int i = 0; i < contact->count; ++i)
+      {
+        summary[1] += side == 0 ?
+            contact->wrench[i].body1Force.Length() :
+            contact->wrench[i].body2Force.Length();
+      }
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+void *gz_world_arrays_create(const char *_world,
+    const char **_joints, size_t _jointCount,
+    const char **_links, size_t _linkCount)
+{
+  const std::string name = _world ? _world : "";
+  if (!physics::has_world(name))
+  {
+    gzerr << "Unable to find world [" << name << "]\n";
+    return nullptr;
+  }
+
+  return new WorldArrays(physics::get_world(name),
+      std::vector<std::string>(_joints, _joints + _jointCount),
+      std::vector<std::string>(_links, _links + _linkCount));
+}
+
+//////////////////////////////////////////////////
+void gz_world_arrays_destroy(void *_handle)
+{
+  delete static_cast<WorldArrays *>(_handle);
+}
+
+//////////////////////////////////////////////////
+void gz_world_arrays_set_joint_efforts(void *_handle,
+    const double *_efforts)
+{
+  static_cast<WorldArrays *>(_handle)->SetJointEfforts(_efforts);
+}
+
+//////////////////////////////////////////////////
+void gz_world_arrays_set_joint_positions(void *_handle,
+    const double *_positions)
+{
+  static_cast<WorldArrays *>(_handle)->SetJointPositions(_positions);
+}
+
+//////////////////////////////////////////////////
+void gz_world_arrays_set_joint_velocities(void *_handle,
+    const double *_velocities)
+{
+  static_cast<WorldArrays *>(_handle)->SetJointVelocities(_velocities);
+}
+
+//////////////////////////////////////////////////
+void gz_world_arrays_set_link_wrenches(void *_handle,
+    const double *_wrenches)
+{
+  static_cast<WorldArrays *>(_handle)->SetLinkWrenches(_wrenches);
+}
+
+//////////////////////////////////////////////////
+void gz_world_arrays_clear_commands(void *_handle)
+{
+  static_cast<WorldArrays *>(_handle)->ClearCommands();
+}
+
+//////////////////////////////////////////////////
+void gz_world_arrays_enable_contacts(void *_handle, int _enable)
+{
+  static_cast<WorldArrays *>(_handle)->EnableContacts(_enable != 0);
+}
+
+//////////////////////////////////////////////////
+int gz_world_arrays_step(void *_handle, unsigned int _steps)
+{
+  return static_cast<WorldArrays *>(_handle)->Step(_steps) ? 1 : 0;
+}
+
+//////////////////////////////////////////////////
+void gz_world_arrays_link_poses(void *_handle, double *_poses)
+{
+  static_cast<WorldArrays *>(_handle)->LinkPoses(_poses);
+}
+
+//////////////////////////////////////////////////
+void gz_world_arrays_link_twists(void *_handle, double *_twists)
+{
+  static_cast<WorldArrays *>(_handle)->LinkTwists(_twists);
+}
+
+//////////////////////////////////////////////////
+void gz_world_arrays_joint_states(void *_handle,
+    double *_positions, double *_velocities, double *_efforts)
+{
+  static_cast<WorldArrays *>(_handle)->JointStates(
+      _positions, _velocities, _efforts);
+}
+
+//////////////////////////////////////////////////
+void gz_world_arrays_contact_summaries(void *_handle, double *_summaries)
+{
+  static_cast<WorldArrays *>(_handle)->ContactSummaries(_summaries);
+}
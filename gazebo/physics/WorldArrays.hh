@@ -0,0 +1,203 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_WORLDARRAYS_HH_
+#define GAZEBO_PHYSICS_WORLDARRAYS_HH_
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    // Forward declare private data class.
+    class WorldArraysPrivate;
+
+    /// \addtogroup gazebo_physics
+    /// \{
+
+    /// \class WorldArrays WorldArrays.hh physics/physics.hh
+    /// \brief Commands and reads a fixed set of joints and links of a
+    /// world through contiguous arrays, in process, e.g. to step a world
+    /// from a reinforcement learning loop without transport round trips.
+    ///
+    /// The joints and links are looked up once, by scoped name, and keep
+    /// the order given to the constructor in every array. Joint values are
+    /// those of the first axis. A joint or link that was not found is
+    /// skipped by the setters and reads as zeros.
+    ///
+    /// Efforts and wrenches are held: they are applied before every
+    /// physics update until they are set again or cleared. The C functions
+    /// at the end of this file expose the same interface to other
+    /// languages, e.g. to Python through ctypes.
+    class GZ_PHYSICS_VISIBLE WorldArrays
+    {
+      /// \brief Constructor.
+      /// \param[in] _world The world.
+      /// \param[in] _joints Scoped names of the joints.
+      /// \param[in] _links Scoped names of the links.
+      public: WorldArrays(WorldPtr _world,
+                  const std::vector<std::string> &_joints,
+                  const std::vector<std::string> &_links);
+
+      /// \brief Destructor.
+      public: virtual ~WorldArrays();
+
+      /// \brief Get the number of joints.
+      /// \return Number of joints given to the constructor.
+      public: size_t JointCount() const;
+
+      /// \brief Get the number of links.
+      /// \return Number of links given to the constructor.
+      public: size_t LinkCount() const;
+
+      /// \brief Check whether all the joints and links were found.
+      /// \return True if every name was found in the world.
+      public: bool Resolved() const;
+
+      /// \brief Hold the efforts of the joints.
+      /// \param[in] _efforts One effort per joint.
+      public: void SetJointEfforts(const double *_efforts);
+
+      /// \brief Set the positions of the joints, moving their child links.
+      /// \param[in] _positions One position per joint.
+      public: void SetJointPositions(const double *_positions);
+
+      /// \brief Set the velocities of the joints.
+      /// \param[in] _velocities One velocity per joint.
+      public: void SetJointVelocities(const double *_velocities);
+
+      /// \brief Hold the wrenches applied to the links.
+      /// \param[in] _wrenches Six values per link: the force and the torque,
+      /// in the world frame.
+      public: void SetLinkWrenches(const double *_wrenches);
+
+      /// \brief Stop applying the held efforts and wrenches.
+      public: void ClearCommands();
+
+      /// \brief Record the contacts of every step, needed by
+      /// ContactSummaries. Contacts are otherwise only kept while the
+      /// contact topic has subscribers.
+      /// \param[in] _enable True to record the contacts.
+      public: void EnableContacts(const bool _enable);
+
+      /// \brief Step the world. A world running in its own thread is
+      /// stepped with World::Step, it must be paused. Other worlds are
+      /// stepped in the calling thread with World::Advance.
+      /// \param[in] _steps Number of steps.
+      /// \return False if the world could not be stepped.
+      public: bool Step(const unsigned int _steps);
+
+      /// \brief Read the poses of the links.
+      /// \param[out] _poses Seven values per link: the position and the
+      /// rotation as a quaternion (w, x, y, z), in the world frame.
+      public: void LinkPoses(double *_poses) const;
+
+      /// \brief Read the velocities of the links.
+      /// \param[out] _twists Six values per link: the linear velocity of
+      /// the link origin and the angular velocity, in the world frame.
+      public: void LinkTwists(double *_twists) const;
+
+      /// \brief Read the states of the joints. Any of the arrays may be
+      /// null.
+      /// \param[out] _positions One position per joint.
+      /// \param[out] _velocities One velocity per joint.
+      /// \param[out] _efforts One effort per joint, as last commanded.
+      public: void JointStates(double *_positions, double *_velocities,
+                  double *_efforts) const;
+
+      /// \brief Summarize the contacts of the last step, see
+      /// EnableContacts.
+      /// \param[out] _summaries Two values per link: the number of contact
+      /// points and the sum of the magnitudes of their forces on the link.
+      public: void ContactSummaries(double *_summaries) const;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<WorldArraysPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+
+extern "C"
+{
+  /// \brief Create a WorldArrays of a world of this process.
+  /// \param[in] _world Name of the world, or null for the first world.
+  /// \param[in] _joints Scoped names of the joints.
+  /// \param[in] _jointCount Number of joints.
+  /// \param[in] _links Scoped names of the links.
+  /// \param[in] _linkCount Number of links.
+  /// \return Handle to pass to the other functions, null if the world was
+  /// not found.
+  GZ_PHYSICS_VISIBLE void *gz_world_arrays_create(const char *_world,
+      const char **_joints, size_t _jointCount,
+      const char **_links, size_t _linkCount);
+
+  /// \brief Destroy a handle created by gz_world_arrays_create.
+  GZ_PHYSICS_VISIBLE void gz_world_arrays_destroy(void *_handle);
+
+  /// \sa gazebo::physics::WorldArrays::SetJointEfforts
+  GZ_PHYSICS_VISIBLE void gz_world_arrays_set_joint_efforts(void *_handle,
+      const double *_efforts);
+
+  /// \sa gazebo::physics::WorldArrays::SetJointPositions
+  GZ_PHYSICS_VISIBLE void gz_world_arrays_set_joint_positions(void *_handle,
+      const double *_positions);
+
+  /// \sa gazebo::physics::WorldArrays::SetJointVelocities
+  GZ_PHYSICS_VISIBLE void gz_world_arrays_set_joint_velocities(
+      void *_handle, const double *_velocities);
+
+  /// \sa gazebo::physics::WorldArrays::SetLinkWrenches
+  GZ_PHYSICS_VISIBLE void gz_world_arrays_set_link_wrenches(void *_handle,
+      const double *_wrenches);
+
+  /// \sa gazebo::physics::WorldArrays::ClearCommands
+  GZ_PHYSICS_VISIBLE void gz_world_arrays_clear_commands(void *_handle);
+
+  /// \sa gazebo::physics::WorldArrays::EnableContacts
+  GZ_PHYSICS_VISIBLE void gz_world_arrays_enable_contacts(void *_handle,
+      int _enable);
+
+  /// \sa gazebo::physics::WorldArrays::Step
+  /// \return 1 on success, 0 otherwise.
+  GZ_PHYSICS_VISIBLE int gz_world_arrays_step(void *_handle,
+      unsigned int _steps);
+
+  /// \sa gazebo::physics::WorldArrays::LinkPoses
+  GZ_PHYSICS_VISIBLE void gz_world_arrays_link_poses(void *_handle,
+      double *_poses);
+
+  /// \sa gazebo::physics::WorldArrays::LinkTwists
+  GZ_PHYSICS_VISIBLE void gz_world_arrays_link_twists(void *_handle,
+      double *_twists);
+
+  /// \sa gazebo::physics::WorldArrays::JointStates
+  GZ_PHYSICS_VISIBLE void gz_world_arrays_joint_states(void *_handle,
+      double *_positions, double *_velocities, double *_efforts);
+
+  /// \sa gazebo::physics::WorldArrays::ContactSummaries
+  GZ_PHYSICS_VISIBLE void gz_world_arrays_contact_summaries(void *_handle,
+      double *_summaries);
+}
+#endif
@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <vector>
+
+#include "gazebo/physics/Collision.hh"
+#include "gazebo/physics/Contact.hh"
+#include "gazebo/physics/ContactManager.hh"
+#include "gazebo/physics/Link.hh"
+#include "gazebo/physics/Model.hh"
+#include "gazebo/physics/PhysicsEngine.hh"
+#include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/physics/World.hh"
+#include "gazebo/physics/WorldArrays.hh"
+#include "gazebo/test/ServerFixture.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class WorldArraysTest : public ServerFixture {};
+
+//////////////////////////////////////////////////
+/// \brief Read links and apply held wrenches through the arrays.
+TEST_F(WorldArraysTest, Links)
+{
+  this->Load("worlds/shapes.world", true);
+  auto world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+
+  physics::WorldArrays arrays(world, {}, {"box::link", "sphere::link"});
+  EXPECT_TRUE(arrays.Resolved());
+  EXPECT_EQ(0u, arrays.JointCount());
+  EXPECT_EQ(2u, arrays.LinkCount());
+
+  // Poses match the links
+  std::vector<double> poses(14);
+  arrays.LinkPoses(poses.data());
+  auto box = world->ModelByName("box")->GetLink("link");
+  ASSERT_NE(nullptr, box);
+  EXPECT_DOUBLE_EQ(box->WorldPose().Pos().X(), poses[0]);
+  EXPECT_DOUBLE_EQ(box->WorldPose().Pos().Z(), poses[2]);
+  EXPECT_DOUBLE_EQ(box->WorldPose().Rot().W(), poses[3]);
+
+  // The boxes rest on the ground
+  arrays.EnableContacts(true);
+  EXPECT_TRUE(arrays.Step(10));
+  std::vector<double> summaries(4);
+  arrays.ContactSummaries(summaries.data());
+  EXPECT_GT(summaries[0], 0.0);
+  EXPECT_GT(summaries[1], 0.0);
+
+  // A held upward force larger than the weight lifts the box
+  std::vector<double> wrenches(12, 0.0);
+  wrenches[2] = 2 * box->GetInertial()->Mass() * 9.8;
+  arrays.SetLinkWrenches(wrenches.data());
+  EXPECT_TRUE(arrays.Step(100));
+
+  std::vector<double> twists(12);
+  arrays.LinkTwists(twists.data());
+  EXPECT_GT(twists[2], 0.1);
+  arrays.LinkPoses(poses.data());
+  EXPECT_GT(poses[2], 0.52);
+
+  // The sphere got no force
+  EXPECT_NEAR(0.0, twists[8], 1e-3);
+
+  // The box no longer touches the ground, so there are fewer contacts than
+  // in the previous steps. Only the contacts of the last step are summed.
+  arrays.ContactSummaries(summaries.data());
+  EXPECT_DOUBLE_EQ(0.0, summaries[0]);
+  EXPECT_DOUBLE_EQ(0.0, summaries[1]);
+
+  physics::ContactManager *manager = world->Physics()->GetContactManager();
+  double spherePoints = 0;
+  for (unsigned int i = 0; i < manager->GetContactCount(); ++i)
+  {
+    const physics::Contact *contact = manager->GetContact(i);
+    if (contact->collision1->GetModel()->GetName() == "sphere" ||
+        contact->collision2->GetModel()->GetName() == "sphere")
+    {
+      spherePoints += contact->count;
+    }
+  }
+  EXPECT_GT(spherePoints, 0.0);
+  EXPECT_DOUBLE_EQ(spherePoints, summaries[2]);
+  arrays.ClearCommands();
+}
+
+//////////////////////////////////////////////////
+/// \brief Names that are not found read as zeros.
+TEST_F(WorldArraysTest, Unresolved)
+{
+  this->Load("worlds/shapes.world", true);
+  auto world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+
+  physics::WorldArrays arrays(world, {"no_joint"}, {"no_model::link"});
+  EXPECT_FALSE(arrays.Resolved());
+
+  double effort = 10;
+  arrays.SetJointEfforts(&effort);
+  double position = 1, velocity = 1;
+  arrays.JointStates(&position, &velocity, &effort);
+  EXPECT_DOUBLE_EQ(0.0, position);
+  EXPECT_DOUBLE_EQ(0.0, velocity);
+  EXPECT_DOUBLE_EQ(0.0, effort);
+
+  // The C interface on the same world
+  const char *link = "box::link";
+  void *handle = gz_world_arrays_create("default", nullptr, 0, &link, 1);
+  ASSERT_NE(nullptr, handle);
+  EXPECT_EQ(1, gz_world_arrays_step(handle, 1));
+  double pose[7];
+  gz_world_arrays_link_poses(handle, pose);
+  EXPECT_DOUBLE_EQ(1.0, pose[3]);
+  gz_world_arrays_destroy(handle);
+
+  EXPECT_EQ(nullptr, gz_world_arrays_create("none", nullptr, 0, nullptr, 0));
+}
+
+//////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <thread>
+
+#include "gazebo/physics/PhysicsIface.hh"
+#include "gazebo/physics/World.hh"
+#include "gazebo/physics/WorldBatch.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \internal
+    /// \brief Private data for the WorldBatch class
+    class WorldBatchPrivate
+    {
+      /// \brief Worlds of the batch.
+      public: std::vector<WorldPtr> worlds;
+
+      /// \brief Number of threads of the pool.
+      public: unsigned int threads = 1;
+
+      /// \brief Pool that steps the worlds.
+      public: std::unique_ptr<tbb::task_arena> arena;
+    };
+  }
+}
+
+using namespace gazebo;
+using namespace physics;
+
+//////////////////////////////////////////////////
+WorldBatch::WorldBatch(const std::vector<WorldPtr> &_worlds,
+    const unsigned int _threads)
+  : dataPtr(new WorldBatchPrivate)
+{
+  this->dataPtr->worlds = _worlds;
+  this->dataPtr->threads = _threads;
+  if (this->dataPtr->threads == 0)
+    this->dataPtr->threads = std::max(1u, std::thread::hardware_concurrency());
+  this->dataPtr->arena.reset(new tbb::task_arena(this->dataPtr->threads));
+}
+
+//////////////////////////////////////////////////
+WorldBatch::~WorldBatch()
+{
+}
+
+//////////////////////////////////////////////////
+std::vector<WorldPtr> WorldBatch::CreateWorlds(const sdf::ElementPtr &_sdf,
+    const unsigned int _count)
+{
+  std::vector<WorldPtr> worlds;
+  const std::string name = _sdf->Get<std::string>("name");
+  for (unsigned int i = 0; i < _count; ++i)
+  {
+    sdf::ElementPtr worldSDF = _sdf->Clone();
+    worldSDF->GetAttribute("name")->Set(name + "_" + std::to_string(i));
+
+    WorldPtr world = create_world();
+    load_world(world, worldSDF);
+    init_world(world, nullptr);
+    worlds.push_back(world);
+  }
+  return worlds;
+}
+
+//////////////////////////////////////////////////
+const std::vector<WorldPtr> &WorldBatch::Worlds() const
+{
+  return this->dataPtr->worlds;
+}
+
+//////////////////////////////////////////////////
+unsigned int WorldBatch::Threads() const
+{
+  return this->dataPtr->threads;
+}
+
+//////////////////////////////////////////////////
+bool WorldBatch::Step(const unsigned int _steps)
+{
+  std::atomic<bool> result(true);
+  auto &worlds = this->dataPtr->worlds;
+
+  // One world per task, the worlds are independent of each other.
+  this->dataPtr->arena->execute([&]()
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, worlds.size(), 1),
+        [&](const tbb::blocked_range<size_t> &_r)
+        {
+          for (size_t i = _r.begin(); i != _r.end(); ++i)
+          {
+            if (!worlds[i]->Advance(_steps))
+              result = false;
+          }
+        });
+  });
+
+  return result;
+}
+
+//////////////////////////////////////////////////
+void WorldBatch::States(std::vector<WorldState> &_states) const
+{
+  auto &worlds = this->dataPtr->worlds;
+  _states.resize(worlds.size());
+
+  this->dataPtr->arena->execute([&]()
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, worlds.size(), 1),
+        [&](const tbb::blocked_range<size_t> &_r)
+        {
+          for (size_t i = _r.begin(); i != _r.end(); ++i)
+            _states[i].Load(worlds[i]);
+        });
+  });
+}
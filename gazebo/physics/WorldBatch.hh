@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_WORLDBATCH_HH_
+#define GAZEBO_PHYSICS_WORLDBATCH_HH_
+
+#include <memory>
+#include <vector>
+
+#include <sdf/sdf.hh>
+
+#include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/physics/WorldState.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    // Forward declare private data class.
+    class WorldBatchPrivate;
+
+    /// \addtogroup gazebo_physics
+    /// \{
+
+    /// \class WorldBatch WorldBatch.hh physics/physics.hh
+    /// \brief Steps a group of worlds in lockstep on a shared pool of
+    /// threads.
+    ///
+    /// The worlds must be loaded and initialized, but not running (see
+    /// World::Run). Each call to Step advances every world by the same
+    /// number of iterations with World::Advance, spreading the worlds over
+    /// the threads of the pool, and returns once all of them are done.
+    /// This avoids one thread, and one wall clock throttle, per world.
+    ///
+    /// Plugins that connect to the global world update events are
+    /// signalled by every world of the batch, possibly concurrently.
+    class GZ_PHYSICS_VISIBLE WorldBatch
+    {
+      /// \brief Constructor.
+      /// \param[in] _worlds Worlds to step.
+      /// \param[in] _threads Number of threads of the pool. Zero uses one
+      /// thread per hardware core.
+      public: explicit WorldBatch(const std::vector<WorldPtr> &_worlds,
+                                  const unsigned int _threads = 0);
+
+      /// \brief Destructor.
+      public: virtual ~WorldBatch();
+
+      /// \brief Create, load and initialize copies of a world. The copies
+      /// are named after the world in the SDF, with a "_<index>" suffix.
+      /// \param[in] _sdf SDF of the world to copy.
+      /// \param[in] _count Number of copies.
+      /// \return The new worlds.
+      public: static std::vector<WorldPtr> CreateWorlds(
+                  const sdf::ElementPtr &_sdf, const unsigned int _count);
+
+      /// \brief Get the worlds of the batch.
+      /// \return The worlds, in the order given to the constructor.
+      public: const std::vector<WorldPtr> &Worlds() const;
+
+      /// \brief Get the number of threads of the pool.
+      /// \return Number of threads.
+      public: unsigned int Threads() const;
+
+      /// \brief Step every world of the batch. Blocks until all the worlds
+      /// have taken the steps.
+      /// \param[in] _steps Number of steps each world takes.
+      /// \return False if any world could not be advanced.
+      /// \sa World::Advance
+      public: bool Step(const unsigned int _steps = 1);
+
+      /// \brief Capture the state of every world. The states are captured
+      /// in parallel on the pool.
+      /// \param[out] _states One state per world, in the order of Worlds().
+      public: void States(std::vector<WorldState> &_states) const;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<WorldBatchPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
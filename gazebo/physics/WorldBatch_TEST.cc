@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <vector>
+
+#include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/physics/World.hh"
+#include "gazebo/physics/WorldBatch.hh"
+#include "gazebo/physics/WorldState.hh"
+#include "gazebo/test/ServerFixture.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class WorldBatchTest : public ServerFixture {};
+
+//////////////////////////////////////////////////
+/// \brief Step copies of a world in lockstep.
+TEST_F(WorldBatchTest, Step)
+{
+  this->Load("worlds/shapes.world", true);
+  auto world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+
+  auto worlds = physics::WorldBatch::CreateWorlds(world->SDF(), 3);
+  ASSERT_EQ(3u, worlds.size());
+  EXPECT_EQ("default_0", worlds[0]->Name());
+  EXPECT_EQ("default_2", worlds[2]->Name());
+
+  physics::WorldBatch batch(worlds, 2);
+  EXPECT_EQ(2u, batch.Threads());
+  EXPECT_EQ(worlds, batch.Worlds());
+
+  EXPECT_TRUE(batch.Step(100));
+  for (auto const &w : worlds)
+  {
+    EXPECT_EQ(100u, w->Iterations());
+    EXPECT_DOUBLE_EQ(100 * w->Physics()->GetMaxStepSize(),
+        w->SimTime().Double());
+  }
+
+  // Identical worlds stay identical
+  std::vector<physics::WorldState> states;
+  batch.States(states);
+  ASSERT_EQ(3u, states.size());
+  for (auto const &state : states)
+  {
+    EXPECT_EQ(100u, state.GetIterations());
+    EXPECT_EQ(states[0].GetModelState("box").Pose(),
+        state.GetModelState("box").Pose());
+  }
+
+  // The world of the fixture runs in its own thread and can't be batched
+  physics::WorldBatch running({world});
+  EXPECT_FALSE(running.Step());
+}
+
+//////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -17,21 +17,35 @@
 #ifndef GAZEBO_PHYSICS_WORLDPRIVATE_HH_
 #define GAZEBO_PHYSICS_WORLDPRIVATE_HH_
 
+#include <array>
 #include <atomic>
 #include <deque>
 #include <vector>
 #include <list>
+#include <map>
 #include <memory>
 #include <set>
 #include <sdf/sdf.hh>
 #include <string>
 #include <mutex>
 #include <thread>
+#include <unordered_map>
+#include <utility>
 #include <condition_variable>
 
+#include <boost/weak_ptr.hpp>
+#include <tbb/task_arena.h>
+
+#include <ignition/math/Pose3.hh>
+#include <ignition/math/Vector3.hh>
 #include <ignition/transport.hh>
 
+#include "gazebo/common/AllocationCounter.hh"
+#include "gazebo/common/CostCounter.hh"
 #include "gazebo/common/Event.hh"
+#include "gazebo/common/RealTimePacer.hh"
+#include "gazebo/common/SimTimeNs.hh"
+#include "gazebo/common/SpscQueue.hh"
 #include "gazebo/common/Time.hh"
 #include "gazebo/common/URI.hh"
 
@@ -39,13 +53,286 @@
 
 #include "gazebo/transport/TransportTypes.hh"
 
+#include "gazebo/physics/AabbTree.hh"
 #include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/physics/StepSizeController.hh"
+#include "gazebo/physics/World.hh"
 #include "gazebo/physics/WorldState.hh"
 
 namespace gazebo
 {
   namespace physics
   {
+    /// \brief World side effects generated while a partition of models
+    /// is being updated in parallel. They are merged into the world
+    /// serially once all partitions have been updated.
+    class ModelUpdateDeferred
+    {
+      /// \brief Entities passed to World::_AddDirty.
+      public: std::vector<Entity *> dirtyPoses;
+
+      /// \brief Models passed to World::PublishModelPose.
+      public: std::vector<ModelPtr> publishModelPoses;
+    };
+
+    /// \brief One model of the cached pose layout of a top level model.
+    /// The layout lists the model and its nested models in the order the
+    /// poses are written to the pose message, together with the child
+    /// counts that were seen when the layout was built.
+    class PoseLayoutEntry
+    {
+      /// \brief The model, or one of its nested models.
+      public: Model *model = nullptr;
+
+      /// \brief Number of links of the model when the layout was built.
+      public: size_t linkCount = 0;
+
+      /// \brief Number of nested models when the layout was built.
+      public: size_t nestedCount = 0;
+    };
+
+    /// \brief Cached part of the scene snapshot for one model.
+    class SceneModelEntry
+    {
+      /// \brief Scene message holding only the model message.
+      public: msgs::Scene msg;
+
+      /// \brief Partial serialization of msg. Serialized messages can be
+      /// concatenated, so the snapshot is the serialized scene without
+      /// models followed by the data of each model.
+      public: std::string data;
+    };
+
+    /// \brief State of a model in a world snapshot.
+    class ModelSnapshot
+    {
+      /// \brief The model. Expired if the model was removed.
+      public: boost::weak_ptr<Model> model;
+
+      /// \brief World pose of the model.
+      public: ignition::math::Pose3d pose;
+    };
+
+    /// \brief State of a link in a world snapshot.
+    class LinkSnapshot
+    {
+      /// \brief The link. Expired if the link was removed.
+      public: boost::weak_ptr<Link> link;
+
+      /// \brief World pose of the link.
+      public: ignition::math::Pose3d pose;
+
+      /// \brief Linear velocity of the link in the world frame.
+      public: ignition::math::Vector3d linearVel;
+
+      /// \brief Angular velocity of the link in the world frame.
+      public: ignition::math::Vector3d angularVel;
+
+      /// \brief Force on the link in the world frame.
+      public: ignition::math::Vector3d force;
+
+      /// \brief Torque on the link in the world frame.
+      public: ignition::math::Vector3d torque;
+    };
+
+    /// \brief State captured by World::Snapshot.
+    class WorldSnapshot
+    {
+      /// \brief Simulation time.
+      public: common::SimTimeNs simTime;
+
+      /// \brief Iteration count.
+      public: uint64_t iterations = 0;
+
+      /// \brief Models, parents before their nested models.
+      public: std::vector<ModelSnapshot> models;
+
+      /// \brief Links of all the models.
+      public: std::vector<LinkSnapshot> links;
+    };
+
+    /// \brief A world state captured by the log worker.
+    class WorldLogState
+    {
+      /// \brief The state.
+      public: WorldState state;
+
+      /// \brief True if the state only has the models and lights that
+      /// changed since the previous state, see LogRecord::KeyframePeriod.
+      public: bool delta = false;
+
+      /// \brief State digest marker of the frame, empty unless the world
+      /// computes state digests, see LogRecord::DigestFrameMarker.
+      public: std::string digest;
+    };
+
+    /// \brief Phases of the world steps, in the order they run, which are
+    /// timed for the statistics breakdown.
+    enum WorldStepPhase
+    {
+      /// \brief Waiting for the step mutex.
+      STEP_LOCK,
+
+      /// \brief Loading the plugins.
+      STEP_LOAD_PLUGINS,
+
+      /// \brief Publishing the world statistics.
+      STEP_PUBLISH_STATS,
+
+      /// \brief Waiting for the sensors.
+      STEP_WAIT_SENSORS,
+
+      /// \brief Sleeping to keep the update rate.
+      STEP_SLEEP,
+
+      /// \brief Reading the next state of a log being played.
+      STEP_LOG_PLAYBACK,
+
+      /// \brief Waiting for the world update mutex.
+      STEP_UPDATE_LOCK,
+
+      /// \brief Resetting the world.
+      UPDATE_RESET,
+
+      /// \brief The worldUpdateBegin event and the wind.
+      UPDATE_BEGIN,
+
+      /// \brief Updating the models.
+      UPDATE_MODELS,
+
+      /// \brief PhysicsEngine::UpdateCollision.
+      UPDATE_COLLISION,
+
+      /// \brief Waiting for the log worker.
+      UPDATE_LOG_WAIT,
+
+      /// \brief The beforePhysicsUpdate event.
+      UPDATE_BEFORE_PHYSICS,
+
+      /// \brief PhysicsEngine::UpdatePhysics.
+      UPDATE_PHYSICS,
+
+      /// \brief Applying the poses changed by the physics engine.
+      UPDATE_POSES,
+
+      /// \brief Choosing the step size in adaptive step mode.
+      UPDATE_STEP_SIZE,
+
+      /// \brief Computing the state digest, when enabled.
+      UPDATE_STATE_DIGEST,
+
+      /// \brief Publishing the state to the sensor workers, when enabled.
+      UPDATE_SENSOR_OFFLOAD,
+
+      /// \brief Queueing the state for the log worker.
+      UPDATE_LOG_NOTIFY,
+
+      /// \brief Publishing the contacts.
+      UPDATE_CONTACTS,
+
+      /// \brief The worldUpdateEnd event and the introspection update.
+      UPDATE_END,
+
+      /// \brief Notifying the introspection subscribers.
+      STEP_INTROSPECTION,
+
+      /// \brief Processing the incoming messages.
+      STEP_PROCESS_MESSAGES,
+
+      /// \brief Removing the models requested by ClearModels.
+      STEP_CLEAR_MODELS,
+
+      /// \brief Number of phases.
+      STEP_PHASE_COUNT
+    };
+
+    /// \brief Real time spent in the phases of the world steps, and the
+    /// allocations of the world thread in each phase, kept since the world
+    /// was created. The phases are laps on a single timeline, so each
+    /// clock reading ends a phase and starts the next one.
+    class WorldStepCosts
+    {
+      /// \brief Start the timeline, at the start of a step.
+      public: void Start()
+              {
+                this->mark = common::CostCounter::Now();
+                this->allocationMark = common::AllocationCounter::Thread();
+              }
+
+      /// \brief End a phase, which started at the end of the previous one.
+      /// \param[in] _phase The phase.
+      public: void Lap(const WorldStepPhase _phase)
+              {
+                const uint64_t now = common::CostCounter::Now();
+                this->time[_phase] += now - this->mark;
+                ++this->count[_phase];
+                this->mark = now;
+
+                const common::AllocationCount allocated =
+                  common::AllocationCounter::Thread();
+                this->allocations[_phase] += allocated - this->allocationMark;
+                this->allocationMark = allocated;
+              }
+
+      /// \brief Total time of each phase (nanoseconds).
+      public: std::array<uint64_t, STEP_PHASE_COUNT> time{};
+
+      /// \brief Number of times each phase ended.
+      public: std::array<uint64_t, STEP_PHASE_COUNT> count{};
+
+      /// \brief Allocations made in each phase, zero if they are not
+      /// counted.
+      public: std::array<common::AllocationCount, STEP_PHASE_COUNT>
+              allocations{};
+
+      /// \brief Clock reading at the end of the last phase (nanoseconds).
+      public: uint64_t mark = 0;
+
+      /// \brief Allocations of the thread at the end of the last phase.
+      public: common::AllocationCount allocationMark;
+    };
+
+    /// \brief A factory message handled by the factory thread.
+    class FactoryRequest
+    {
+      /// \brief The factory message.
+      public: msgs::Factory msg;
+
+      /// \brief The SDF read, null for messages that need the world, such
+      /// as model clones.
+      public: sdf::SDFPtr sdf;
+
+      /// \brief False if the SDF of the message couldn't be read.
+      public: bool valid = true;
+    };
+
+    /// \brief Totals of the step costs and of the cost counters at a point
+    /// in time. The breakdown is the difference of two samples.
+    class WorldStepCostSample
+    {
+      /// \brief Wall time of the sample.
+      public: common::Time wallTime;
+
+      /// \brief World iterations.
+      public: uint64_t iterations = 0;
+
+      /// \brief Totals of the phases.
+      public: WorldStepCosts steps;
+
+      /// \brief Total time and count of the cost counters, by group and
+      /// name.
+      public: std::map<std::pair<std::string, std::string>,
+              std::pair<uint64_t, uint64_t>> counters;
+
+      /// \brief Allocations of the cost counters, by group and name.
+      public: std::map<std::pair<std::string, std::string>,
+              common::AllocationCount> counterAllocations;
+
+      /// \brief Totals of the contact points, contact constraint rows and
+      /// joint constraint rows per step of each model, by scoped name.
+      public: std::map<std::string, std::array<uint64_t, 3>> models;
+    };
+
     /// \brief Private data class for World.
     class WorldPrivate
     {
@@ -58,6 +345,10 @@ namespace gazebo
       /// \brief Unique pointer the wind. The world owns this pointer.
       public: std::unique_ptr<Wind> wind;
 
+      /// \brief Unique pointer the battery system. The world owns this
+      /// pointer.
+      public: std::unique_ptr<BatterySystem> batterySystem;
+
       /// \brief Unique pointer the atmosphere model.
       /// The world owns this pointer.
       public: std::unique_ptr<Atmosphere> atmosphere;
@@ -77,8 +368,9 @@ namespace gazebo
       /// \brief Name of the world.
       public: std::string name;
 
-      /// \brief Current simulation time.
-      public: common::Time simTime;
+      /// \brief Current simulation time, in nanoseconds so that the steps
+      /// add up exactly.
+      public: common::SimTimeNs simTime;
 
       /// \brief Amount of time simulation has been paused.
       public: common::Time pauseTime;
@@ -92,6 +384,10 @@ namespace gazebo
       /// \brief Number of steps in increment by.
       public: int stepInc;
 
+      /// \brief Notified, with worldUpdateMutex, after each step and when
+      /// the run loop ends, to wake World::Step(unsigned int).
+      public: std::condition_variable_any stepCondition;
+
       /// \brief All the event connections.
       public: event::Connection_V connections;
 
@@ -101,6 +397,15 @@ namespace gazebo
       /// \brief Publisher for world statistics messages.
       public: transport::PublisherPtr statPub;
 
+      /// \brief Publisher for the transport counters of the server.
+      public: transport::PublisherPtr transportStatsPub;
+
+      /// \brief Publisher for the cost breakdown of the world steps.
+      public: transport::PublisherPtr breakdownPub;
+
+      /// \brief Publisher for the state digests.
+      public: transport::PublisherPtr stateDigestPub;
+
       /// \brief Publisher for request response messages.
       public: transport::PublisherPtr responsePub;
 
@@ -155,12 +460,74 @@ namespace gazebo
       /// \brief Outgoing scene message.
       public: msgs::Scene sceneMsg;
 
+      /// \brief Scene snapshot entries of the models, by model id.
+      /// Protected by receiveMutex.
+      public: std::unordered_map<uint32_t, SceneModelEntry> sceneModels;
+
+      /// \brief Ids of the models whose scene snapshot entry must be
+      /// filled again. Protected by receiveMutex.
+      public: std::set<uint32_t> sceneDirtyModels;
+
+      /// \brief Set by SceneInfoService to have the world thread rebuild
+      /// the scene snapshot on its next update.
+      public: std::atomic_bool sceneRequested{false};
+
+      /// \brief Pre-serialized scene, served to new clients without
+      /// touching the entities. Protected by sceneSnapshotMutex.
+      public: std::shared_ptr<const std::string> sceneSnapshot;
+
+      /// \brief Number of scene snapshots built. Protected by
+      /// sceneSnapshotMutex.
+      public: uint64_t sceneSnapshotCount = 0;
+
+      /// \brief Mutex to protect sceneSnapshot and sceneSnapshotCount.
+      public: std::mutex sceneSnapshotMutex;
+
+      /// \brief Notified when a scene snapshot was built.
+      public: std::condition_variable sceneSnapshotCondition;
+
       /// \brief Function pointer to the model update function.
       public: void (World::*modelUpdateFunc)();
 
+      /// \brief Number of threads used by World::ModelUpdateTBB.
+      public: unsigned int modelUpdateThreads = 0;
+
+      /// \brief Task arena that bounds the model update concurrency.
+      public: std::unique_ptr<tbb::task_arena> modelUpdateArena;
+
+      /// \brief Groups of kinematically coupled models that can be
+      /// updated independently of each other.
+      public: std::vector<Model_V> modelPartitions;
+
+      /// \brief Children of the root element that must be updated in the
+      /// world thread, such as actors and lights.
+      public: Base_V serialModelUpdates;
+
+      /// \brief Deferred side effects, one entry per model partition.
+      public: std::vector<ModelUpdateDeferred> modelUpdateDeferred;
+
+      /// \brief True when the model partitions must be rebuilt.
+      public: std::atomic_bool modelPartitionsDirty{true};
+
+      /// \brief Number of root children when the partitions were built.
+      public: unsigned int modelPartitionChildCount = 0;
+
+      /// \brief Number of joints when the partitions were built.
+      public: unsigned int modelPartitionJointCount = 0;
+
       /// \brief Last time a world statistics message was sent.
       public: common::Time prevStatTime;
 
+      /// \brief Last time a transport statistics message was sent.
+      public: common::Time prevTransportStatsTime;
+
+      /// \brief Real time spent in the phases of the world steps.
+      public: WorldStepCosts stepCosts;
+
+      /// \brief Samples of the step costs taken once per second, oldest
+      /// first, covering the window of the breakdown.
+      public: std::deque<WorldStepCostSample> stepCostSamples;
+
       /// \brief Time at which pause started.
       public: common::Time pauseStartTime;
 
@@ -211,6 +578,41 @@ namespace gazebo
       /// \brief Factory message buffer.
       public: std::list<msgs::Factory> factoryMsgs;
 
+      /// \brief Read the SDF of factory messages on the factory thread.
+      public: bool asyncFactory = false;
+
+      /// \brief Thread that reads the SDF of factory messages.
+      public: std::thread *factoryThread = nullptr;
+
+      /// \brief Protects the factory queues and factoryStop.
+      public: std::mutex factoryMutex;
+
+      /// \brief Wakes up the factory thread.
+      public: std::condition_variable factoryCondition;
+
+      /// \brief Factory messages waiting for the factory thread.
+      public: std::list<msgs::Factory> factoryPending;
+
+      /// \brief Factory messages handled by the factory thread, in the
+      /// order they were received. Their responses are published by the
+      /// world thread, so that they keep the same order.
+      public: std::list<FactoryRequest> factoryReady;
+
+      /// \brief True to stop the factory thread.
+      public: bool factoryStop = false;
+
+      /// \brief Publisher of the result of factory messages.
+      public: transport::PublisherPtr factoryResponsePub;
+
+      /// \brief Model templates waiting to be instantiated, with the
+      /// overrides of each instance. Protected by receiveMutex.
+      public: std::list<std::pair<sdf::ElementPtr,
+              std::vector<ModelInstance> > > modelInstances;
+
+      /// \brief Number of threads used to prefetch the meshes and plugin
+      /// libraries of the world while it loads, zero to load serially.
+      public: unsigned int loadThreads = 0;
+
       /// \brief Model message buffer.
       public: std::list<msgs::Model> modelMsgs;
 
@@ -250,9 +652,6 @@ namespace gazebo
       /// \brief True to enable the atmosphere model.
       public: bool enableAtmosphere;
 
-      /// \brief Ray used to test for collisions when placing entities.
-      public: RayShapePtr testRay;
-
       /// \brief True if the plugins have been loaded.
       public: bool pluginsLoaded;
 
@@ -266,7 +665,7 @@ namespace gazebo
       public: common::Time processMsgsPeriod;
 
       /// \brief Alternating buffer of states.
-      public: std::deque<WorldState> states[2];
+      public: std::deque<WorldLogState> states[2];
 
       /// \brief Keep track of current state buffer being updated
       public: int currentStateBuffer;
@@ -274,9 +673,35 @@ namespace gazebo
       /// \brief Buffer of prev states
       public: WorldState prevStates[2];
 
-      /// \brief Previous unfiltered state. Used for determining insertions
-      /// and deletions
-      public: WorldState prevUnfilteredState;
+      /// \brief The state a log player has after playing the states
+      /// recorded since the last keyframe. Delta states are taken against it.
+      public: WorldState logKeyframeState;
+
+      /// \brief Simulation time of the last keyframe recorded.
+      public: common::Time logKeyframeTime;
+
+      /// \brief True if the next state recorded is a keyframe.
+      public: bool logKeyframeNeeded = true;
+
+      /// \brief True if the next state played from a log file does not
+      /// follow the previous one, e.g. after a seek, in which case a delta
+      /// state is rebuilt from its keyframe.
+      public: bool logPlayResync = true;
+
+      /// \brief Publishers of the topics recorded with a log file, by
+      /// topic.
+      public: std::map<std::string, transport::PublisherPtr> logPlayTopicPubs;
+
+      /// \brief Names of the models and lights inserted since the log
+      /// worker last ran. Protected by logEventMutex.
+      public: std::vector<std::string> logInsertions;
+
+      /// \brief Names of the models and lights deleted since the log
+      /// worker last ran. Protected by logEventMutex.
+      public: std::vector<std::string> logDeletions;
+
+      /// \brief Mutex to protect logInsertions and logDeletions.
+      public: std::mutex logEventMutex;
 
       /// \brief Int used to toggle between prevStates
       public: int stateToggle;
@@ -294,6 +719,126 @@ namespace gazebo
       /// \brief The list of models that need to publish their pose.
       public: std::set<ModelPtr> publishModelPoses;
 
+      /// \brief Pose message reused by ProcessMessages, so that the pose
+      /// sub-messages are allocated once instead of every step.
+      public: msgs::PosesStamped posesMsg;
+
+      /// \brief Cached pose layout of each top level model that has
+      /// published its pose. Cleared when a model is removed.
+      public: std::unordered_map<const Model *,
+              std::vector<PoseLayoutEntry>> poseLayouts;
+
+      /// \brief Publish entity names along with the pose ids.
+      public: bool publishPoseNames = true;
+
+      /// \brief True to step without wall clock throttling.
+      public: bool throughputMode = false;
+
+      /// \brief Number of steps between message processing in throughput
+      /// mode.
+      public: unsigned int messagePeriod = 1;
+
+      /// \brief Steps taken since messages were last processed in
+      /// throughput mode.
+      public: unsigned int throughputCount = 0;
+
+      /// \brief True to pace the steps with absolute deadlines.
+      public: std::atomic<bool> realTimePacing{false};
+
+      /// \brief Paces the steps in real time pacing mode.
+      public: common::RealTimePacer pacer;
+
+      /// \brief SCHED_FIFO priority requested for the world thread, 0 for
+      /// none.
+      public: std::atomic<int> realTimePriority{0};
+
+      /// \brief True if the world thread must apply realTimePriority.
+      public: std::atomic<bool> realTimePriorityPending{false};
+
+      /// \brief Chooses the step size in adaptive step mode.
+      public: StepSizeController stepController;
+
+      /// \brief True to choose the step size from the last step.
+      public: bool adaptiveStep = false;
+
+      /// \brief Max step size of the physics engine when adaptive step
+      /// mode was enabled, restored when it is disabled.
+      public: double nominalStepSize = 0;
+
+      /// \brief NeverDropContacts of the contact manager when adaptive step
+      /// mode was enabled, restored when it is disabled.
+      public: bool nominalNeverDropContacts = false;
+
+      /// \brief True to compute a state digest after every step.
+      public: bool stateDigestEnabled = false;
+
+      /// \brief Digest of the state after the last step, see
+      /// World::SetStateDigestEnabled. Protected by stateDigestMutex.
+      public: uint64_t stateDigest = 0;
+
+      /// \brief Iterations when stateDigest was computed, 0 if it was not.
+      /// Protected by stateDigestMutex.
+      public: uint64_t stateDigestIterations = 0;
+
+      /// \brief Mutex to protect the last state digest, which the log
+      /// worker reads.
+      public: std::mutex stateDigestMutex;
+
+      /// \brief True to drop the visual elements of the models from the
+      /// SDF, see World::SetCompactSDFEnabled.
+      public: bool compactSDF = false;
+
+      /// \brief True if models were loaded or their visual elements were
+      /// regenerated since the models were last compacted.
+      public: std::atomic_bool sdfCompactPending{false};
+
+      /// \brief True to publish the state to the sensor workers after
+      /// every step, see World::SetSensorOffloadEnabled.
+      public: bool sensorOffload = false;
+
+      /// \brief True to follow the state published by a primary, see
+      /// World::SetSensorOffloadFollower.
+      public: bool sensorOffloadFollower = false;
+
+      /// \brief Publisher of the state to the sensor workers.
+      public: ignition::transport::Node::Publisher sensorOffloadPub;
+
+      /// \brief State published to the sensor workers, reused every step.
+      public: msgs::PosesStamped sensorOffloadMsg;
+
+      /// \brief Last state received from the primary. Protected by
+      /// sensorOffloadMutex.
+      public: msgs::PosesStamped sensorOffloadFrame;
+
+      /// \brief True if sensorOffloadFrame was not applied yet. Protected
+      /// by sensorOffloadMutex.
+      public: bool sensorOffloadFrameNew = false;
+
+      /// \brief Mutex to protect the state received from the primary.
+      public: std::mutex sensorOffloadMutex;
+
+      /// \brief Linear velocities of the links after the last step, by
+      /// link id, used in adaptive step mode.
+      public: std::unordered_map<uint32_t, ignition::math::Vector3d>
+              linkVelocities;
+
+      /// \brief Elements found by World::BaseByName, by scoped name. The
+      /// entries are checked on use, stale entries are replaced.
+      public: std::unordered_map<std::string, boost::weak_ptr<Base>>
+              nameIndex;
+
+      /// \brief Elements found by World::BaseById, by id.
+      public: std::unordered_map<uint32_t, boost::weak_ptr<Base>> idIndex;
+
+      /// \brief Mutex to protect nameIndex and idIndex.
+      public: std::mutex indexMutex;
+
+      /// \brief Snapshots taken with World::Snapshot, by handle.
+      public: std::map<uint32_t, WorldSnapshot> snapshots;
+
+      /// \brief Handle of the next snapshot.
+      public: uint32_t nextSnapshot = 1;
+
       /// \brief The list of models that need to publish their scale.
       public: std::set<ModelPtr> publishModelScales;
 
@@ -322,6 +867,18 @@ namespace gazebo
       /// \brief Real time value set from a log file.
       public: common::Time logRealTime;
 
+      /// \brief States captured by the simulation for the log worker, with
+      /// a recording queue. Set by the physics thread with logMutex locked.
+      public: std::unique_ptr<common::SpscQueue<WorldLogState>> logQueue;
+
+      /// \brief Simulation time in seconds of the newest state queued, < 0
+      /// before the first.
+      public: std::atomic<double> logQueuedTime{-1.0};
+
+      /// \brief Number of states dropped because the recording queue was
+      /// full.
+      public: std::atomic<uint64_t> logDropped{0};
+
       /// \brief Mutex to protect the log worker thread.
       public: std::mutex logMutex;
 
@@ -346,8 +903,36 @@ namespace gazebo
 
       /// \brief when physics engine makes an update and changes a link pose,
       /// this flag is set to trigger Entity::SetWorldPose on the
-      /// physics::Link in World::Update.
-      public: std::list<Entity*> dirtyPoses;
+      /// physics::Link in World::Update. A vector keeps the entities
+      /// contiguous and reuses its storage every step.
+      public: std::vector<Entity*> dirtyPoses;
+
+      /// \brief Bounding volume hierarchy of the bounding boxes of
+      /// modelIndexModels, see World::ModelsInBox.
+      public: AabbTree modelIndex;
+
+      /// \brief The models and nested models of modelIndex, depth first.
+      public: std::vector<boost::weak_ptr<Model>> modelIndexModels;
+
+      /// \brief Raw pointers of modelIndexModels, used to detect changes of
+      /// the set of models.
+      public: std::vector<Model *> modelIndexIds;
+
+      /// \brief Bounding boxes of modelIndexModels.
+      public: std::vector<ignition::math::AxisAlignedBox> modelIndexBoxes;
+
+      /// \brief World poses of modelIndexModels when their bounding box was
+      /// computed.
+      public: std::vector<ignition::math::Pose3d> modelIndexPoses;
+
+      /// \brief Iteration at which modelIndex was refreshed.
+      public: uint64_t modelIndexIteration = 0;
+
+      /// \brief True once modelIndex has been built.
+      public: bool modelIndexValid = false;
+
+      /// \brief Mutex protecting the model index.
+      public: std::mutex modelIndexMutex;
 
       /// \brief Class to manage preset simulation parameter profiles.
       public: PresetManagerPtr presetManager;
@@ -371,6 +956,13 @@ namespace gazebo
       /// \brief Log play real time factor
       public: double logPlayRealTimeFactor;
 
+      /// \brief Activity overview of the log file played, sent with the
+      /// world statistics.
+      public: std::vector<float> logPlayActivity;
+
+      /// \brief True once logPlayActivity has been computed.
+      public: bool logPlayActivitySet = false;
+
       /// \brief URI of this world.
       public: common::URI uri;
 
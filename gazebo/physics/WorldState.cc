@@ -149,8 +149,7 @@ void WorldState::Load(const WorldPtr _world)
 
   // Add states for all the lights
   this->lightStates.clear();
-  Light_V lights = _world->Lights();
-  for (const auto &light : lights)
+  for (const auto &light : _world->Lights())
   {
     this->lightStates[light->GetName()].Load(light, this->realTime,
         this->simTime, this->iterations);
@@ -433,6 +432,61 @@ bool WorldState::IsZero() const
   return result;
 }
 
+/////////////////////////////////////////////////
+void WorldState::RemoveUnchanged(const WorldState &_state)
+{
+  for (auto iter = this->modelStates.begin();
+       iter != this->modelStates.end();)
+  {
+    auto ref = _state.modelStates.find(iter->first);
+    if (ref != _state.modelStates.end() &&
+        (iter->second - ref->second).IsZero())
+    {
+      iter = this->modelStates.erase(iter);
+    }
+    else
+      ++iter;
+  }
+
+  for (auto iter = this->lightStates.begin();
+       iter != this->lightStates.end();)
+  {
+    auto ref = _state.lightStates.find(iter->first);
+    if (ref != _state.lightStates.end() &&
+        (iter->second - ref->second).IsZero())
+    {
+      iter = this->lightStates.erase(iter);
+    }
+    else
+      ++iter;
+  }
+}
+
+/////////////////////////////////////////////////
+void WorldState::Merge(const WorldState &_state)
+{
+  this->name = _state.name;
+  this->simTime = _state.simTime;
+  this->realTime = _state.realTime;
+  this->wallTime = _state.wallTime;
+  this->iterations = _state.iterations;
+
+  for (auto const &deletion : _state.deletions)
+  {
+    this->modelStates.erase(deletion);
+    this->lightStates.erase(deletion);
+  }
+
+  for (auto const &model : _state.modelStates)
+    this->modelStates[model.first] = model.second;
+
+  for (auto const &light : _state.lightStates)
+    this->lightStates[light.first] = light.second;
+
+  this->insertions = _state.insertions;
+  this->deletions = _state.deletions;
+}
+
 /////////////////////////////////////////////////
 WorldState &WorldState::operator=(const WorldState &_state)
 {
@@ -167,6 +167,20 @@ namespace gazebo
       /// \return True if the values in the state are zero.
       public: bool IsZero() const;
 
+      /// \brief Remove the model and light states that did not change since
+      /// a reference state, i.e. whose difference with it is zero. The
+      /// states the reference does not have are kept.
+      /// \param[in] _state The reference state.
+      public: void RemoveUnchanged(const WorldState &_state);
+
+      /// \brief Apply a state that follows this one, such as a state from
+      /// which RemoveUnchanged removed the unchanged models and lights. Its
+      /// model and light states replace or are added to those of this state,
+      /// the states of the entities it deleted are removed, and its times,
+      /// insertions and deletions replace those of this state.
+      /// \param[in] _state The state that follows this one.
+      public: void Merge(const WorldState &_state);
+
       /// \brief Populate a state SDF element with data from the object.
       /// \param[out] _sdf SDF element to populate.
       public: void FillSDF(sdf::ElementPtr _sdf);
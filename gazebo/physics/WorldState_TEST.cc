@@ -358,3 +358,70 @@ TEST_F(WorldStateTest, Times)
   EXPECT_EQ(worldState.GetWallTime(), common::Time(2));
   EXPECT_EQ(worldState.GetRealTime(), common::Time(3));
 }
+
+//////////////////////////////////////////////////
+/// \brief Create a world state from the SDF of its content.
+/// \param[in] _content Models and lights of the state.
+/// \param[in] _simTime Simulation time of the state, in seconds.
+/// \return The world state.
+static physics::WorldState StateFromString(const std::string &_content,
+    const int _simTime)
+{
+  std::ostringstream sdfStr;
+  sdfStr << "<sdf version ='" << SDF_VERSION << "'>"
+    << "<world name='default'>"
+    << "<state world_name='default'>"
+    << "<sim_time>" << _simTime << " 0</sim_time>"
+    << _content
+    << "</state>"
+    << "</world>"
+    << "</sdf>";
+
+  sdf::SDFPtr worldSDF(new sdf::SDF);
+  worldSDF->SetFromString(sdfStr.str());
+  return physics::WorldState(
+      worldSDF->Root()->GetElement("world")->GetElement("state"));
+}
+
+//////////////////////////////////////////////////
+TEST_F(WorldStateTest, RemoveUnchangedMerge)
+{
+  physics::WorldState keyframe = StateFromString(
+      "<model name='model_1'><pose>1 0 0 0 0 0</pose></model>"
+      "<model name='model_2'><pose>2 0 0 0 0 0</pose></model>"
+      "<light name='sun'><pose>0 0 10 0 0 0</pose></light>", 1);
+
+  physics::WorldState state = StateFromString(
+      "<model name='model_1'><pose>1 0 0 0 0 0</pose></model>"
+      "<model name='model_2'><pose>2 1 0 0 0 0</pose></model>"
+      "<model name='model_3'><pose>3 0 0 0 0 0</pose></model>"
+      "<light name='sun'><pose>0 0 10 0 0 0</pose></light>", 2);
+
+  // Only the moved and the new models are left
+  physics::WorldState delta = state;
+  delta.RemoveUnchanged(keyframe);
+  EXPECT_EQ(2u, delta.GetModelStateCount());
+  EXPECT_TRUE(delta.HasModelState("model_2"));
+  EXPECT_TRUE(delta.HasModelState("model_3"));
+  EXPECT_EQ(0u, delta.LightStateCount());
+  EXPECT_EQ(common::Time(2), delta.GetSimTime());
+
+  // Applying the delta to the keyframe gives the state back
+  physics::WorldState rebuilt = keyframe;
+  rebuilt.Merge(delta);
+  EXPECT_EQ(3u, rebuilt.GetModelStateCount());
+  EXPECT_EQ(1u, rebuilt.LightStateCount());
+  EXPECT_EQ(common::Time(2), rebuilt.GetSimTime());
+  EXPECT_TRUE((rebuilt - state).IsZero());
+  EXPECT_EQ(ignition::math::Pose3d(2, 1, 0, 0, 0, 0),
+      rebuilt.GetModelState("model_2").Pose());
+
+  // Deleted entities are removed
+  physics::WorldState deletion = StateFromString("", 3);
+  deletion.SetDeletions({"model_1", "sun"});
+  rebuilt.Merge(deletion);
+  EXPECT_EQ(2u, rebuilt.GetModelStateCount());
+  EXPECT_FALSE(rebuilt.HasModelState("model_1"));
+  EXPECT_EQ(0u, rebuilt.LightStateCount());
+  EXPECT_EQ(2u, rebuilt.Deletions().size());
+}
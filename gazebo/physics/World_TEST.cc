@@ -15,8 +15,17 @@
  *
 */
 
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+#include <ignition/transport/Node.hh>
+
+#include "gazebo/common/RealTimePacer.hh"
 #include "gazebo/physics/PhysicsTypes.hh"
 #include "gazebo/physics/World.hh"
+#include "gazebo/physics/WorldState.hh"
 #include "gazebo/test/ServerFixture.hh"
 #include "test/util.hh"
 
@@ -216,6 +225,725 @@ TEST_F(WorldTest, Stop)
   EXPECT_TRUE(world->Running());
 }
 
+//////////////////////////////////////////////////
+/// \brief Check that parallel model updates give the same result as
+/// serial model updates.
+TEST_F(WorldTest, ModelUpdateThreads)
+{
+  this->Load("worlds/joints.world", true);
+  auto world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+
+  // Parallel model updates are disabled by default
+  EXPECT_EQ(0u, world->ModelUpdateThreads());
+
+  // Take a few serial steps and record the resulting state
+  world->Step(100);
+  physics::WorldState serialState(world);
+  world->Reset();
+
+  world->SetModelUpdateThreads(4);
+  EXPECT_EQ(4u, world->ModelUpdateThreads());
+
+  auto physics = world->Physics();
+  ASSERT_NE(nullptr, physics);
+  EXPECT_EQ(4, boost::any_cast<int>(
+      physics->GetParam("model_update_threads")));
+
+  world->Step(100);
+  physics::WorldState parallelState(world);
+
+  EXPECT_EQ(serialState.GetIterations(), parallelState.GetIterations());
+  EXPECT_EQ(serialState.GetModelStateCount(),
+      parallelState.GetModelStateCount());
+  for (auto const &model : world->Models())
+  {
+    EXPECT_EQ(serialState.GetModelState(model->GetName()).Pose(),
+        parallelState.GetModelState(model->GetName()).Pose());
+  }
+
+  EXPECT_TRUE(physics->SetParam("model_update_threads", 0));
+  EXPECT_EQ(0u, world->ModelUpdateThreads());
+}
+
+//////////////////////////////////////////////////
+/// \brief Check that restoring a snapshot replays the same motion.
+TEST_F(WorldTest, SnapshotRestore)
+{
+  this->Load("worlds/shapes.world", true);
+  auto world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+
+  auto physics = world->Physics();
+  ASSERT_NE(nullptr, physics);
+  EXPECT_TRUE(physics->SetParam("contact_warm_start", true));
+
+  auto box = world->ModelByName("box");
+  ASSERT_NE(nullptr, box);
+
+  world->Step(50);
+  box->SetLinearVel(ignition::math::Vector3d(1, 0.5, 2));
+  box->SetAngularVel(ignition::math::Vector3d(0, 0, 3));
+
+  const common::Time snapshotTime = world->SimTime();
+  const uint32_t snapshotIterations = world->Iterations();
+  const ignition::math::Pose3d snapshotPose = box->WorldPose();
+  uint32_t handle = world->Snapshot();
+
+  world->Step(200);
+  const ignition::math::Pose3d endPose = box->WorldPose();
+  EXPECT_NE(snapshotPose, endPose);
+
+  // Restoring brings back the time and the poses
+  EXPECT_TRUE(world->Restore(handle));
+  EXPECT_EQ(snapshotTime, world->SimTime());
+  EXPECT_EQ(snapshotIterations, world->Iterations());
+  EXPECT_TRUE(snapshotPose.Pos().Equal(box->WorldPose().Pos(), 1e-9));
+
+  // The same motion is simulated again, and the snapshot can be restored
+  // more than once.
+  for (int i = 0; i < 2; ++i)
+  {
+    world->Step(200);
+    EXPECT_TRUE(endPose.Pos().Equal(box->WorldPose().Pos(), 1e-6));
+    EXPECT_TRUE(world->Restore(handle));
+  }
+
+  world->ReleaseSnapshot(handle);
+  EXPECT_FALSE(world->Restore(handle));
+}
+
+//////////////////////////////////////////////////
+/// \brief Check that throughput mode ignores the real time update rate.
+TEST_F(WorldTest, ThroughputMode)
+{
+  this->Load("worlds/shapes.world", true);
+  auto world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+
+  EXPECT_FALSE(world->ThroughputMode());
+  EXPECT_EQ(1u, world->MessagePeriod());
+
+  world->SetMessagePeriod(0);
+  EXPECT_EQ(1u, world->MessagePeriod());
+  world->SetMessagePeriod(100);
+  EXPECT_EQ(100u, world->MessagePeriod());
+
+  // Throttle to 50 steps per second
+  auto physics = world->Physics();
+  ASSERT_NE(nullptr, physics);
+  physics->SetRealTimeUpdateRate(50);
+
+  world->SetThroughputMode(true);
+  EXPECT_TRUE(world->ThroughputMode());
+
+  const uint32_t start = world->Iterations();
+  world->SetPaused(false);
+  common::Time::MSleep(1000);
+  world->SetPaused(true);
+
+  // Many more steps than the update rate allows
+  EXPECT_GT(world->Iterations() - start, 500u);
+
+  world->SetThroughputMode(false);
+  EXPECT_FALSE(world->ThroughputMode());
+}
+
+//////////////////////////////////////////////////
+/// \brief Check the steps paced with absolute deadlines.
+TEST_F(WorldTest, RealTimePacing)
+{
+  this->Load("worlds/shapes.world", true);
+  auto world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+
+  EXPECT_FALSE(world->RealTimePacing());
+  EXPECT_EQ(0, world->RealTimePriority());
+
+  // Pace at 200 steps per second
+  auto physics = world->Physics();
+  ASSERT_NE(nullptr, physics);
+  physics->SetRealTimeUpdateRate(200);
+
+  world->Pacer().SetSpinTime(0.0001);
+  world->SetRealTimePacing(true);
+  EXPECT_TRUE(world->RealTimePacing());
+
+  const uint32_t start = world->Iterations();
+  world->SetPaused(false);
+  common::Time::MSleep(1500);
+  world->SetPaused(true);
+
+  // The update rate is kept, within the margin of a loaded machine
+  const uint32_t steps = world->Iterations() - start;
+  EXPECT_GT(steps, 150u);
+  EXPECT_LT(steps, 400u);
+
+  // A window of statistics completed
+  const common::RealTimePacer::Statistics stats =
+    world->Pacer().LastWindow();
+  EXPECT_GT(stats.samples, 0u);
+  EXPECT_GE(stats.window, 1.0);
+  EXPECT_GE(stats.jitterMax, stats.jitterMean);
+
+  world->SetRealTimePacing(false);
+  EXPECT_FALSE(world->RealTimePacing());
+}
+
+//////////////////////////////////////////////////
+/// \brief Check name and id lookups across model removal.
+TEST_F(WorldTest, NameIndex)
+{
+  this->Load("worlds/shapes.world", true);
+  auto world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+
+  auto box = world->ModelByName("box");
+  ASSERT_NE(nullptr, box);
+  auto link = box->GetLink("link");
+  ASSERT_NE(nullptr, link);
+
+  // Repeated lookups give the same result
+  for (int i = 0; i < 2; ++i)
+  {
+    EXPECT_EQ(box, world->BaseByName("box"));
+    EXPECT_EQ(link, world->EntityByName("box::link"));
+    EXPECT_EQ(box, world->BaseById(box->GetId()));
+    EXPECT_EQ(link, world->BaseById(link->GetId()));
+  }
+
+  // Plain names are still found
+  EXPECT_NE(nullptr, world->BaseByName("link"));
+
+  // Removed entities are not returned, even though they are still alive
+  const uint32_t boxId = box->GetId();
+  world->RemoveModel("box");
+  EXPECT_EQ(nullptr, world->BaseByName("box"));
+  EXPECT_EQ(nullptr, world->BaseByName("box::link"));
+  EXPECT_EQ(nullptr, world->BaseById(boxId));
+  EXPECT_EQ(nullptr, world->BaseById(link->GetId()));
+  EXPECT_NE(nullptr, world->ModelByName("sphere"));
+}
+
+//////////////////////////////////////////////////
+static std::mutex g_posesMutex;
+static msgs::PosesStamped g_posesMsg;
+static int g_posesReceived = 0;
+
+/////////////////////////////////////////////////
+void OnPoses(ConstPosesStampedPtr &_msg)
+{
+  std::lock_guard<std::mutex> lock(g_posesMutex);
+  g_posesMsg.CopyFrom(*_msg);
+  ++g_posesReceived;
+}
+
+//////////////////////////////////////////////////
+/// \brief Check that pose messages can be published without names.
+TEST_F(WorldTest, PublishPoseNames)
+{
+  this->Load("worlds/shapes.world", true);
+  auto world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+
+  // Names are published by default
+  EXPECT_TRUE(world->PublishPoseNames());
+
+  auto sub = this->node->Subscribe("~/pose/info", &OnPoses);
+
+  auto waitForPoses = [&world]()
+  {
+    {
+      std::lock_guard<std::mutex> lock(g_posesMutex);
+      g_posesReceived = 0;
+    }
+    for (int i = 0; i < 100; ++i)
+    {
+      // Spinning the box makes physics move it, which publishes its pose
+      auto link = world->ModelByName("box")->GetLink();
+      link->SetEnabled(true);
+      link->SetAngularVel(ignition::math::Vector3d(0, 0, 1));
+      world->Step(1);
+      common::Time::MSleep(10);
+
+      std::lock_guard<std::mutex> lock(g_posesMutex);
+      if (g_posesReceived > 0 && g_posesMsg.pose_size() > 0)
+        return true;
+    }
+    return false;
+  };
+
+  ASSERT_TRUE(waitForPoses());
+  {
+    std::lock_guard<std::mutex> lock(g_posesMutex);
+    for (auto const &pose : g_posesMsg.pose())
+    {
+      EXPECT_TRUE(pose.has_id());
+      EXPECT_FALSE(pose.name().empty());
+    }
+  }
+
+  world->SetPublishPoseNames(false);
+  EXPECT_FALSE(world->PublishPoseNames());
+
+  ASSERT_TRUE(waitForPoses());
+  {
+    std::lock_guard<std::mutex> lock(g_posesMutex);
+    for (auto const &pose : g_posesMsg.pose())
+    {
+      EXPECT_TRUE(pose.has_id());
+      EXPECT_TRUE(pose.name().empty());
+    }
+  }
+}
+
+static std::mutex g_factoryMutex;
+static std::vector<msgs::Response> g_factoryResponses;
+
+//////////////////////////////////////////////////
+void OnFactoryResponse(ConstResponsePtr &_msg)
+{
+  std::lock_guard<std::mutex> lock(g_factoryMutex);
+  g_factoryResponses.push_back(*_msg);
+}
+
+//////////////////////////////////////////////////
+/// \brief Test spawning models with the asynchronous factory.
+TEST_F(WorldTest, AsyncFactory)
+{
+  this->Load("worlds/blank.world", true);
+  auto world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+
+  EXPECT_FALSE(world->AsyncFactory());
+  world->SetAsyncFactory(true);
+  EXPECT_TRUE(world->AsyncFactory());
+
+  auto sub = this->node->Subscribe("~/factory/response", &OnFactoryResponse);
+  common::Time::MSleep(100);
+
+  auto modelSDF = [](const std::string &_name)
+  {
+    msgs::Model msg;
+    msg.set_name(_name);
+    msg.add_link();
+    msg.mutable_link(0)->set_name("l");
+    return "<sdf version='" + std::string(SDF_VERSION) + "'>"
+      + msgs::ModelToSDF(msg)->ToString("") + "</sdf>";
+  };
+
+  auto waitForResponses = [](const size_t _count)
+  {
+    for (int i = 0; i < 50; ++i)
+    {
+      {
+        std::lock_guard<std::mutex> lock(g_factoryMutex);
+        if (g_factoryResponses.size() >= _count)
+          return;
+      }
+      common::Time::MSleep(100);
+    }
+  };
+
+  // Messages are handled in order
+  msgs::Factory facMsg;
+  facMsg.set_sdf(modelSDF("first"));
+  this->factoryPub->Publish(facMsg);
+  facMsg.set_sdf(modelSDF("second"));
+  this->factoryPub->Publish(facMsg);
+  waitForResponses(2u);
+
+  // Clones go through the factory thread too
+  facMsg.Clear();
+  facMsg.set_clone_model_name("first");
+  this->factoryPub->Publish(facMsg);
+  facMsg.Clear();
+  facMsg.set_sdf("<sdf version='1.6'><model");
+  this->factoryPub->Publish(facMsg);
+  waitForResponses(4u);
+
+  EXPECT_NE(nullptr, world->ModelByName("first"));
+  EXPECT_NE(nullptr, world->ModelByName("second"));
+  EXPECT_NE(nullptr, world->ModelByName("first_clone"));
+  EXPECT_EQ(3u, world->ModelCount());
+
+  {
+    std::lock_guard<std::mutex> lock(g_factoryMutex);
+    ASSERT_EQ(4u, g_factoryResponses.size());
+
+    // The responses keep the order of the messages, the invalid one
+    // included
+    for (auto const &response : g_factoryResponses)
+      EXPECT_EQ("factory", response.request());
+    EXPECT_EQ("first", g_factoryResponses[0].serialized_data());
+    EXPECT_EQ("second", g_factoryResponses[1].serialized_data());
+    EXPECT_EQ("first_clone", g_factoryResponses[2].serialized_data());
+    for (unsigned int i = 0; i < 3u; ++i)
+    {
+      EXPECT_EQ("success", g_factoryResponses[i].response());
+      EXPECT_EQ("model", g_factoryResponses[i].type());
+    }
+    EXPECT_EQ("failure", g_factoryResponses[3].response());
+    g_factoryResponses.clear();
+  }
+
+  world->SetAsyncFactory(false);
+  EXPECT_FALSE(world->AsyncFactory());
+
+  // Messages queued before the factory thread starts are handled before
+  // the ones it reads
+  world->InsertModelString(modelSDF("third"));
+  world->SetAsyncFactory(true);
+  world->InsertModelString(modelSDF("fourth"));
+  waitForResponses(2u);
+  {
+    std::lock_guard<std::mutex> lock(g_factoryMutex);
+    ASSERT_EQ(2u, g_factoryResponses.size());
+    EXPECT_EQ("third", g_factoryResponses[0].serialized_data());
+    EXPECT_EQ("fourth", g_factoryResponses[1].serialized_data());
+  }
+  world->SetAsyncFactory(false);
+}
+
+//////////////////////////////////////////////////
+/// \brief Test inserting models from a template.
+TEST_F(WorldTest, InsertModelInstances)
+{
+  this->Load("worlds/blank.world", true);
+  auto world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+
+  msgs::Model msg;
+  msg.set_name("box");
+  msg.add_link();
+  msg.mutable_link(0)->set_name("link");
+  auto collision = msg.mutable_link(0)->add_collision();
+  collision->set_name("collision");
+  collision->mutable_geometry()->set_type(msgs::Geometry::BOX);
+  msgs::Set(collision->mutable_geometry()->mutable_box()->mutable_size(),
+      ignition::math::Vector3d::One);
+  sdf::ElementPtr modelSDF = msgs::ModelToSDF(msg);
+
+  std::vector<physics::ModelInstance> instances(3);
+  for (size_t i = 0; i < instances.size(); ++i)
+  {
+    instances[i].name = "box_" + std::to_string(i);
+    instances[i].pose.Pos().Set(2.0 * i, 1, 0.5);
+  }
+  instances[2].scale.Set(2, 2, 2);
+
+  // A name that is taken is made unique
+  instances.push_back(instances[0]);
+
+  world->InsertModelInstances(modelSDF, instances);
+
+  for (int i = 0; i < 50 && world->ModelCount() < 4u; ++i)
+  {
+    world->Step(1);
+    common::Time::MSleep(10);
+  }
+  ASSERT_EQ(4u, world->ModelCount());
+
+  for (size_t i = 0; i < 3; ++i)
+  {
+    auto model = world->ModelByName(instances[i].name);
+    ASSERT_NE(nullptr, model);
+    EXPECT_EQ(instances[i].pose, model->WorldPose());
+    EXPECT_EQ(instances[i].scale, model->Scale());
+    EXPECT_NE(nullptr, model->GetLink("link"));
+  }
+  EXPECT_NE(nullptr, world->ModelByName("box_0_0"));
+
+  // The template isn't a model
+  world->InsertModelInstances(sdf::ElementPtr(new sdf::Element), instances);
+  world->Step(1);
+  EXPECT_EQ(4u, world->ModelCount());
+}
+
+//////////////////////////////////////////////////
+/// \brief Test that the scene snapshot served to new clients follows model
+/// insertion, motion and removal.
+TEST_F(WorldTest, SceneInfoSnapshot)
+{
+  this->Load("worlds/empty.world", true);
+  auto world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+
+  ignition::transport::Node node;
+  auto sceneModel = [&node](const std::string &_name, msgs::Model &_model)
+  {
+    msgs::Scene scene;
+    bool result = false;
+    EXPECT_TRUE(node.Request("/scene_info", 5000u, scene, result));
+    EXPECT_TRUE(result);
+    for (auto const &model : scene.model())
+    {
+      if (model.name() == _name)
+      {
+        _model = model;
+        return true;
+      }
+    }
+    return false;
+  };
+
+  msgs::Model modelMsg;
+  EXPECT_FALSE(sceneModel("box", modelMsg));
+
+  this->SpawnBox("box", ignition::math::Vector3d::One,
+      ignition::math::Vector3d(1, 2, 0.5), ignition::math::Vector3d::Zero);
+  ASSERT_TRUE(sceneModel("box", modelMsg));
+  EXPECT_EQ(ignition::math::Vector3d(1, 2, 0.5),
+      msgs::ConvertIgn(modelMsg.pose()).Pos());
+  ASSERT_EQ(1, modelMsg.link_size());
+  EXPECT_GT(modelMsg.link(0).visual_size(), 0);
+
+  // A moved model keeps its entry, with the new pose
+  auto model = world->ModelByName("box");
+  ASSERT_NE(nullptr, model);
+  model->SetWorldPose(ignition::math::Pose3d(3, 4, 0.5, 0, 0, 0));
+  world->Step(1);
+  ASSERT_TRUE(sceneModel("box", modelMsg));
+  EXPECT_EQ(ignition::math::Vector3d(3, 4, 0.5),
+      msgs::ConvertIgn(modelMsg.pose()).Pos());
+  ASSERT_EQ(1, modelMsg.link_size());
+  EXPECT_GT(modelMsg.link(0).visual_size(), 0);
+
+  world->RemoveModel("box");
+  EXPECT_FALSE(sceneModel("box", modelMsg));
+}
+
+static std::mutex g_digestMutex;
+static std::vector<msgs::StateDigest> g_digests;
+
+//////////////////////////////////////////////////
+void OnStateDigest(ConstStateDigestPtr &_msg)
+{
+  std::lock_guard<std::mutex> lock(g_digestMutex);
+  g_digests.push_back(*_msg);
+}
+
+//////////////////////////////////////////////////
+/// \brief Test the state digest of the world.
+TEST_F(WorldTest, StateDigest)
+{
+  this->Load("worlds/shapes.world", true);
+  auto world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+
+  EXPECT_FALSE(world->StateDigestEnabled());
+
+  // The digest only changes with the state
+  const uint64_t digest = world->StateDigest();
+  EXPECT_EQ(digest, world->StateDigest());
+
+  auto model = world->ModelByName("box");
+  ASSERT_NE(nullptr, model);
+  const ignition::math::Pose3d pose = model->WorldPose();
+  model->SetWorldPose(pose + ignition::math::Pose3d(0, 0, 1e-9, 0, 0, 0));
+  EXPECT_NE(digest, world->StateDigest());
+  model->SetWorldPose(pose);
+  EXPECT_EQ(digest, world->StateDigest());
+
+  // Each step publishes its digest once enabled
+  auto sub = this->node->Subscribe("~/state_digest", &OnStateDigest);
+  world->SetStateDigestEnabled(true);
+  EXPECT_TRUE(world->StateDigestEnabled());
+
+  bool received = false;
+  for (int i = 0; i < 100 && !received; ++i)
+  {
+    world->Step(1);
+    common::Time::MSleep(10);
+    std::lock_guard<std::mutex> lock(g_digestMutex);
+    received = !g_digests.empty();
+  }
+  ASSERT_TRUE(received);
+  {
+    std::lock_guard<std::mutex> lock(g_digestMutex);
+    EXPECT_GT(g_digests.back().iterations(), 0u);
+    EXPECT_LE(g_digests.back().iterations(), world->Iterations());
+  }
+
+  // The published digest is the one of the step
+  world->SetStateDigestEnabled(false);
+  common::Time::MSleep(100);
+  {
+    std::lock_guard<std::mutex> lock(g_digestMutex);
+    EXPECT_EQ(world->Iterations(), g_digests.back().iterations());
+    EXPECT_EQ(world->StateDigest(), g_digests.back().digest());
+    g_digests.clear();
+  }
+
+  // Disabled digests are not published
+  world->Step(10);
+  common::Time::MSleep(100);
+  std::lock_guard<std::mutex> lock(g_digestMutex);
+  EXPECT_TRUE(g_digests.empty());
+}
+
+//////////////////////////////////////////////////
+std::mutex g_offloadMutex;
+static std::vector<msgs::PosesStamped> g_offloadStates;
+
+/////////////////////////////////////////////////
+void OnSensorOffload(const msgs::PosesStamped &_msg)
+{
+  std::lock_guard<std::mutex> lock(g_offloadMutex);
+  g_offloadStates.push_back(_msg);
+}
+
+//////////////////////////////////////////////////
+TEST_F(WorldTest, SensorOffload)
+{
+  this->Load("worlds/shapes.world", true);
+  auto world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+
+  EXPECT_FALSE(world->SensorOffloadEnabled());
+  EXPECT_FALSE(world->SensorOffloadFollower());
+
+  auto model = world->ModelByName("box");
+  ASSERT_NE(nullptr, model);
+
+  // Each step publishes the world poses, stamped with the sim time
+  const std::string topic = "/gazebo/default/sensor_offload/state";
+  ignition::transport::Node node;
+  ASSERT_TRUE(node.Subscribe(topic, &OnSensorOffload));
+  world->SetSensorOffloadEnabled(true);
+  EXPECT_TRUE(world->SensorOffloadEnabled());
+
+  bool received = false;
+  for (int i = 0; i < 100 && !received; ++i)
+  {
+    world->Step(1);
+    common::Time::MSleep(10);
+    std::lock_guard<std::mutex> lock(g_offloadMutex);
+    received = !g_offloadStates.empty();
+  }
+  ASSERT_TRUE(received);
+  world->SetSensorOffloadEnabled(false);
+  {
+    std::lock_guard<std::mutex> lock(g_offloadMutex);
+    const msgs::PosesStamped &msg = g_offloadStates.back();
+    EXPECT_GT(msgs::Convert(msg.time()), common::Time::Zero);
+
+    bool hasModel = false;
+    bool hasLink = false;
+    for (auto const &pose : msg.pose())
+    {
+      if (pose.name() == "box")
+      {
+        hasModel = true;
+        EXPECT_EQ(model->WorldPose(), msgs::ConvertIgn(pose));
+      }
+      hasLink = hasLink || pose.name() == "box::link";
+    }
+    EXPECT_TRUE(hasModel);
+    EXPECT_TRUE(hasLink);
+  }
+
+  // A follower takes the poses and the sim time of the primary
+  world->SetSensorOffloadFollower(true);
+  EXPECT_TRUE(world->SensorOffloadFollower());
+  EXPECT_TRUE(world->IsPaused());
+
+  msgs::PosesStamped state;
+  msgs::Set(state.mutable_time(), common::Time(12.5));
+  msgs::Pose *poseMsg = state.add_pose();
+  poseMsg->set_name("box");
+  const ignition::math::Pose3d pose(1, 2, 3, 0, 0, 0);
+  msgs::Set(poseMsg, pose);
+
+  auto pub = node.Advertise<msgs::PosesStamped>(topic);
+  for (int i = 0; i < 100 && model->WorldPose() != pose; ++i)
+  {
+    pub.Publish(state);
+    common::Time::MSleep(10);
+  }
+  EXPECT_EQ(pose, model->WorldPose());
+  EXPECT_EQ(common::Time(12.5), world->SimTime());
+
+  world->SetSensorOffloadFollower(false);
+  EXPECT_FALSE(world->SensorOffloadFollower());
+}
+
+//////////////////////////////////////////////////
+TEST_F(WorldTest, CompactSDF)
+{
+  this->Load("worlds/shapes.world", true);
+  auto world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+
+  EXPECT_FALSE(world->CompactSDFEnabled());
+
+  auto model = world->ModelByName("box");
+  ASSERT_NE(nullptr, model);
+  auto link = model->GetLink("link");
+  ASSERT_NE(nullptr, link);
+  ASSERT_TRUE(link->GetSDF()->HasElement("visual"));
+  const size_t visualCount = link->Visuals().size();
+  EXPECT_EQ(1u, visualCount);
+
+  // The visual elements are dropped on the next update
+  world->SetCompactSDFEnabled(true);
+  EXPECT_TRUE(world->CompactSDFEnabled());
+  for (int i = 0; i < 100 && link->GetSDF()->HasElement("visual"); ++i)
+  {
+    world->Step(1);
+    common::Time::MSleep(10);
+  }
+  EXPECT_FALSE(link->GetSDF()->HasElement("visual"));
+  EXPECT_EQ(visualCount, link->Visuals().size());
+
+  // They are regenerated with the current pose and scale
+  uint32_t visualId = 0;
+  ASSERT_TRUE(link->VisualId("visual", visualId));
+  const ignition::math::Pose3d pose(0.1, 0.2, 0.3, 0, 0, 0);
+  EXPECT_TRUE(link->SetVisualPose(visualId, pose));
+  model->SetScale(ignition::math::Vector3d(2, 3, 4));
+
+  boost::filesystem::path pathOut(boost::filesystem::current_path());
+  boost::filesystem::create_directories(pathOut /
+      boost::filesystem::path("tmp"));
+  const std::string filenameOut = pathOut.string() +
+      "/tmp/world_compact_sdf.world";
+  world->Save(filenameOut);
+
+  sdf::SDFPtr sdf(new sdf::SDF);
+  ASSERT_TRUE(sdf::init(sdf));
+  ASSERT_TRUE(sdf::readFile(filenameOut, sdf));
+  sdf::ElementPtr modelElem =
+      sdf->Root()->GetElement("world")->GetElement("model");
+  while (modelElem && modelElem->Get<std::string>("name") != "box")
+    modelElem = modelElem->GetNextElement("model");
+  ASSERT_NE(nullptr, modelElem);
+  sdf::ElementPtr linkElem = modelElem->GetElement("link");
+  ASSERT_TRUE(linkElem->HasElement("visual"));
+  sdf::ElementPtr visualElem = linkElem->GetElement("visual");
+  EXPECT_EQ("visual", visualElem->Get<std::string>("name"));
+  EXPECT_EQ(pose, visualElem->Get<ignition::math::Pose3d>("pose"));
+  EXPECT_EQ(ignition::math::Vector3d(2, 3, 4),
+      visualElem->GetElement("geometry")->GetElement("box")->Get<
+      ignition::math::Vector3d>("size"));
+  EXPECT_EQ(nullptr, visualElem->GetNextElement("visual"));
+
+  // And dropped again
+  for (int i = 0; i < 100 && link->GetSDF()->HasElement("visual"); ++i)
+  {
+    world->Step(1);
+    common::Time::MSleep(10);
+  }
+  EXPECT_FALSE(link->GetSDF()->HasElement("visual"));
+
+  // Disabling regenerates them for good
+  world->SetCompactSDFEnabled(false);
+  EXPECT_TRUE(link->GetSDF()->HasElement("visual"));
+  world->Step(10);
+  common::Time::MSleep(100);
+  EXPECT_TRUE(link->GetSDF()->HasElement("visual"));
+}
+
 //////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
@@ -74,8 +74,9 @@ void BulletLink::Init()
 
   GZ_ASSERT(this->inertial != nullptr, "Inertial pointer is null");
   // The bullet dynamics solver checks for zero mass to identify static and
-  // kinematic bodies.
-  if (this->IsStatic() || this->GetKinematic())
+  // kinematic bodies. A kinematic body keeps its inertial, so that it can
+  // become dynamic again.
+  if (this->IsStatic())
   {
     this->inertial->SetMass(0);
     this->inertial->SetInertiaMatrix(0, 0, 0, 0, 0, 0);
@@ -143,10 +144,12 @@ void BulletLink::Init()
     this->compoundShape = new btEmptyShape();
 
   // Create a construction info object
+  const bool kinematic = this->GetKinematic();
+  const double mass = kinematic ? 0.0 : this->inertial->Mass();
   btRigidBody::btRigidBodyConstructionInfo
-      rigidLinkCI(this->inertial->Mass(), this->motionState.get(),
-      this->compoundShape, BulletTypes::ConvertVector3(
-      this->inertial->PrincipalMoments()));
+      rigidLinkCI(mass, this->motionState.get(),
+      this->compoundShape, kinematic ? btVector3(0, 0, 0) :
+      BulletTypes::ConvertVector3(this->inertial->PrincipalMoments()));
 
   rigidLinkCI.m_linearDamping = this->GetLinearDamping();
   rigidLinkCI.m_angularDamping = this->GetAngularDamping();
@@ -168,7 +171,7 @@ void BulletLink::Init()
   // auto size = this->BoundingBox().Size();
   // this->rigidLink->setCcdSweptSphereRadius(size.GetMax()*0.8);
 
-  if (this->inertial->Mass() <= 0.0)
+  if (mass <= 0.0)
     this->rigidLink->setCollisionFlags(btCollisionObject::CF_KINEMATIC_OBJECT);
 
   btDynamicsWorld *bulletWorld = this->bulletPhysics->GetDynamicsWorld();
@@ -193,7 +196,7 @@ void BulletLink::Init()
 
   // Only use auto disable if no joints and no sensors are present
   this->rigidLink->setActivationState(DISABLE_DEACTIVATION);
-  if (this->GetModel()->GetAutoDisable() &&
+  if (!kinematic && this->GetModel()->GetAutoDisable() &&
       this->GetModel()->GetJointCount() == 0 &&
       this->GetSensorCount() == 0)
   {
@@ -234,7 +237,8 @@ void BulletLink::Fini()
 /////////////////////////////////////////////////////////////////////
 void BulletLink::UpdateMass()
 {
-  if (this->rigidLink && this->inertial)
+  // A kinematic body has no mass for the solver
+  if (this->rigidLink && this->inertial && !this->GetKinematic())
   {
     if (this->inertial->ProductsOfInertia() != ignition::math::Vector3d::Zero)
     {
@@ -360,6 +364,8 @@ void BulletLink::SetEnabled(bool /*_enable*/) const
 //////////////////////////////////////////////////
 void BulletLink::SetLinearVel(const ignition::math::Vector3d &_vel)
 {
+  this->ClearKinematicsCache();
+
   if (!this->rigidLink)
   {
     gzlog << "Bullet rigid body for link [" << this->GetName() << "]"
@@ -434,6 +440,8 @@ ignition::math::Vector3d BulletLink::WorldLinearVel(
 //////////////////////////////////////////////////
 void BulletLink::SetAngularVel(const ignition::math::Vector3d &_vel)
 {
+  this->ClearKinematicsCache();
+
   if (!this->rigidLink)
   {
     gzlog << "Bullet rigid body for link [" << this->GetName() << "]"
@@ -668,3 +676,47 @@ void BulletLink::SetLinkStatic(bool /*_static*/)
 {
   gzlog << "To be implemented\n";
 }
+
+//////////////////////////////////////////////////
+void BulletLink::SetKinematic(const bool &_state)
+{
+  this->sdf->GetElement("kinematic")->Set(_state);
+
+  // Init creates the rigid body from the SDF value
+  if (!this->rigidLink)
+    return;
+
+  int flags = this->rigidLink->getCollisionFlags();
+  if (_state == ((flags & btCollisionObject::CF_KINEMATIC_OBJECT) != 0))
+    return;
+
+  // Bullet takes the pose of a kinematic object from its motion state in
+  // every step, and leaves it out of the constraint solver.
+  if (_state)
+  {
+    flags |= btCollisionObject::CF_KINEMATIC_OBJECT;
+    this->rigidLink->setCollisionFlags(flags);
+    this->rigidLink->setMassProps(0, btVector3(0, 0, 0));
+    this->rigidLink->setActivationState(DISABLE_DEACTIVATION);
+  }
+  else
+  {
+    flags &= ~btCollisionObject::CF_KINEMATIC_OBJECT;
+    this->rigidLink->setCollisionFlags(flags);
+    this->UpdateMass();
+  }
+  this->rigidLink->updateInertiaTensor();
+
+  // The world sorts the bodies by type when they are added
+  this->RemoveAndAddBody();
+  this->SetGravityMode(this->sdf->Get<bool>("gravity"));
+}
+
+//////////////////////////////////////////////////
+bool BulletLink::GetKinematic() const
+{
+  if (!this->rigidLink)
+    return this->sdf->Get<bool>("kinematic");
+
+  return this->rigidLink->isKinematicObject();
+}
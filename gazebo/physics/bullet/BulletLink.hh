@@ -159,6 +159,12 @@ namespace gazebo
       // Documentation inherited
       public: virtual void SetLinkStatic(bool _static);
 
+      // Documentation inherited.
+      public: virtual void SetKinematic(const bool &_state);
+
+      // Documentation inherited.
+      public: virtual bool GetKinematic() const;
+
       // Documentation inherited.
       public: virtual void UpdateMass();
 
@@ -15,16 +15,46 @@
  *
 */
 
+#include <string>
+
 #include "gazebo/common/Mesh.hh"
 
+#include "gazebo/physics/MeshCollisionCache.hh"
 #include "gazebo/physics/bullet/BulletTypes.hh"
 #include "gazebo/physics/bullet/BulletCollision.hh"
 #include "gazebo/physics/bullet/BulletPhysics.hh"
 #include "gazebo/physics/bullet/BulletMesh.hh"
 
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \internal
+    /// \brief Bullet triangle mesh and the GImpact shape built from it.
+    class BulletMeshData
+    {
+      /// \brief Destructor.
+      public: ~BulletMeshData()
+              {
+                delete this->shape;
+                delete this->triMesh;
+              }
+
+      /// \brief Triangles of the mesh.
+      public: btTriangleMesh *triMesh = nullptr;
+
+      /// \brief Collision shape.
+      public: btGImpactMeshShape *shape = nullptr;
+    };
+  }
+}
+
 using namespace gazebo;
 using namespace physics;
 
+/// \brief Collision shapes of all the Bullet meshes of the process.
+static MeshCollisionCache<BulletMeshData> g_meshCache;
+
 //////////////////////////////////////////////////
 BulletMesh::BulletMesh()
 {
@@ -82,37 +112,45 @@ void BulletMesh::CreateMesh(float *_vertices, int *_indices,
     unsigned int _numVertices, unsigned int _numIndices,
     BulletCollisionPtr _collision, const ignition::math::Vector3d &_scale)
 {
-  btTriangleMesh *mTriMesh = new btTriangleMesh();
-
-  // Scale the vertex data
-  for (unsigned int j = 0;  j < _numVertices; ++j)
-  {
-    _vertices[j*3+0] = _vertices[j*3+0] * _scale.X();
-    _vertices[j*3+1] = _vertices[j*3+1] * _scale.Y();
-    _vertices[j*3+2] = _vertices[j*3+2] * _scale.Z();
-  }
+  const std::string key = MeshCollisionCache<BulletMeshData>::Key(
+      _vertices, _numVertices, _indices, _numIndices, _scale);
 
-  // Create the Bullet trimesh
-  for (unsigned int j = 0; j < _numIndices; j += 3)
+  // Reuse the GImpact shape of an identical mesh
+  this->meshData = g_meshCache.Get(key, [&]()
   {
-    btVector3 bv0(_vertices[_indices[j]*3+0],
-                  _vertices[_indices[j]*3+1],
-                  _vertices[_indices[j]*3+2]);
-
-    btVector3 bv1(_vertices[_indices[j+1]*3+0],
-                  _vertices[_indices[j+1]*3+1],
-                  _vertices[_indices[j+1]*3+2]);
-
-    btVector3 bv2(_vertices[_indices[j+2]*3+0],
-                  _vertices[_indices[j+2]*3+1],
-                  _vertices[_indices[j+2]*3+2]);
-
-    mTriMesh->addTriangle(bv0, bv1, bv2);
-  }
-
-  btGImpactMeshShape *gimpactMeshShape =
-    new btGImpactMeshShape(mTriMesh);
-  gimpactMeshShape->updateBound();
-
-  _collision->SetCollisionShape(gimpactMeshShape);
+    std::shared_ptr<BulletMeshData> data(new BulletMeshData);
+    data->triMesh = new btTriangleMesh();
+
+    // Scale the vertex data
+    for (unsigned int j = 0;  j < _numVertices; ++j)
+    {
+      _vertices[j*3+0] = _vertices[j*3+0] * _scale.X();
+      _vertices[j*3+1] = _vertices[j*3+1] * _scale.Y();
+      _vertices[j*3+2] = _vertices[j*3+2] * _scale.Z();
+    }
+
+    // Create the Bullet trimesh
+    for (unsigned int j = 0; j < _numIndices; j += 3)
+    {
+      btVector3 bv0(_vertices[_indices[j]*3+0],
+                    _vertices[_indices[j]*3+1],
+                    _vertices[_indices[j]*3+2]);
+
+      btVector3 bv1(_vertices[_indices[j+1]*3+0],
+                    _vertices[_indices[j+1]*3+1],
+                    _vertices[_indices[j+1]*3+2]);
+
+      btVector3 bv2(_vertices[_indices[j+2]*3+0],
+                    _vertices[_indices[j+2]*3+1],
+                    _vertices[_indices[j+2]*3+2]);
+
+      data->triMesh->addTriangle(bv0, bv1, bv2);
+    }
+
+    data->shape = new btGImpactMeshShape(data->triMesh);
+    data->shape->updateBound();
+    return data;
+  });
+
+  _collision->SetCollisionShape(this->meshData->shape);
 }
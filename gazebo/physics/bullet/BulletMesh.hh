@@ -18,6 +18,8 @@
 #ifndef GAZEBO_PHYSICS_BULLET_BULLETMESH_HH_
 #define GAZEBO_PHYSICS_BULLET_BULLETMESH_HH_
 
+#include <memory>
+
 #include <ignition/math/Vector3.hh>
 
 #include "gazebo/physics/bullet/BulletTypes.hh"
@@ -27,11 +29,18 @@ namespace gazebo
 {
   namespace physics
   {
+    // Forward declare private data class.
+    class BulletMeshData;
+
     /// \ingroup gazebo_physics
     /// \addtogroup gazebo_physics_bullet Bullet Physics
     /// \{
 
     /// \brief Triangle mesh collision helper class
+    ///
+    /// The GImpact shape, and the tree that Bullet builds for it, are shared
+    /// by all the meshes with the same vertices, indices and scale; see
+    /// MeshCollisionCache.
     class GZ_PHYSICS_VISIBLE BulletMesh
     {
       /// \brief Constructor
@@ -67,6 +76,10 @@ namespace gazebo
                    unsigned int _numVertices, unsigned int _numIndices,
                    BulletCollisionPtr _collision,
                    const ignition::math::Vector3d &_scale);
+
+      /// \brief Collision shape, shared with the other meshes that use the
+      /// same vertices.
+      private: std::shared_ptr<BulletMeshData> meshData;
     };
     /// \}
   }
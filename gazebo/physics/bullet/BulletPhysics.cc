@@ -15,7 +15,14 @@
  *
 */
 
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_reduce.h>
+#include <tbb/task_arena.h>
+
 #include <algorithm>
+#include <functional>
+#include <memory>
 #include <string>
 
 #include <ignition/common/Profiler.hh>
@@ -58,6 +65,7 @@
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Exception.hh"
+#include "gazebo/common/Tracer.hh"
 
 #include "gazebo/physics/bullet/BulletPhysics.hh"
 #include "gazebo/physics/bullet/BulletSurfaceParams.hh"
@@ -179,6 +187,7 @@ void UpdateContacts(btDynamicsWorld *_world, btScalar _timeStep)
 
     if (!contactFeedback)
       continue;
+    contactFeedback->SetCapacity(numContacts);
 
     auto body1Pose = link1->WorldPose();
     auto body2Pose = link2->WorldPose();
@@ -258,17 +267,102 @@ bool ContactProcessed(btManifoldPoint &/*_cp*/, void * /*_body0*/,
   return true;
 }
 
+#ifdef LIBBULLET_VERSION_GE_288
+/// \brief Bullet task scheduler that runs the parallel loops of the
+/// multithreaded dynamics world on TBB.
+class BulletTaskScheduler : public btITaskScheduler
+{
+  /// \brief Constructor
+  public: BulletTaskScheduler()
+          : btITaskScheduler("GazeboTBB")
+  {
+    this->setNumThreads(1);
+  }
+
+  // Documentation inherited
+  public: int getMaxNumThreads() const override
+  {
+    return BT_MAX_THREAD_COUNT;
+  }
+
+  // Documentation inherited
+  public: int getNumThreads() const override
+  {
+    return this->numThreads;
+  }
+
+  // Documentation inherited
+  public: void setNumThreads(int _numThreads) override
+  {
+    this->numThreads = std::max(1, std::min(_numThreads, BT_MAX_THREAD_COUNT));
+    this->arena.reset(new tbb::task_arena(this->numThreads));
+  }
+
+  // Documentation inherited
+  public: void parallelFor(int _begin, int _end, int _grainSize,
+                           const btIParallelForBody &_body) override
+  {
+    this->arena->execute([&]()
+    {
+      tbb::parallel_for(tbb::blocked_range<int>(_begin, _end,
+            std::max(1, _grainSize)),
+          [&](const tbb::blocked_range<int> &_r)
+          {
+            _body.forLoop(_r.begin(), _r.end());
+          });
+    });
+  }
+
+  // Documentation inherited
+  public: btScalar parallelSum(int _begin, int _end, int _grainSize,
+                               const btIParallelSumBody &_body) override
+  {
+    btScalar sum = 0;
+    this->arena->execute([&]()
+    {
+      sum = tbb::parallel_reduce(tbb::blocked_range<int>(_begin, _end,
+            std::max(1, _grainSize)), btScalar(0),
+          [&](const tbb::blocked_range<int> &_r, btScalar _init)
+          {
+            return _init + _body.sumLoop(_r.begin(), _r.end());
+          },
+          std::plus<btScalar>());
+    });
+    return sum;
+  }
+
+  /// \brief Number of threads.
+  private: int numThreads = 1;
+
+  /// \brief Threads that run the loops.
+  private: std::unique_ptr<tbb::task_arena> arena;
+};
+
+/// \brief Task scheduler shared by the multithreaded Bullet worlds, Bullet
+/// only has one active scheduler.
+static BulletTaskScheduler g_taskScheduler;
+#endif
+
 //////////////////////////////////////////////////
 BulletPhysics::BulletPhysics(WorldPtr _world)
     : PhysicsEngine(_world)
 {
-  // This function currently follows the pattern of bullet/Demos/HelloWorld
+  this->collisionConfig = nullptr;
+  this->dispatcher = nullptr;
+  this->broadPhase = nullptr;
+  this->solver = nullptr;
+  this->dynamicsWorld = nullptr;
+  this->CreateDynamicsWorld();
 
-  // Default setup for memory and collisions
-  this->collisionConfig = new btDefaultCollisionConfiguration();
+  // Set random seed for physics engine based on gazebo's random seed.
+  // Note: this was moved from physics::PhysicsEngine constructor.
+  this->SetSeed(ignition::math::Rand::Seed());
+}
 
-  // Default collision dispatcher, a multi-threaded dispatcher may be available
-  this->dispatcher = new btCollisionDispatcher(this->collisionConfig);
+//////////////////////////////////////////////////
+void BulletPhysics::CreateDynamicsWorld()
+{
+  // This function currently follows the pattern of bullet/Demos/HelloWorld
 
   // Broadphase collision detection uses axis-aligned bounding boxes (AABB)
   // to detect pairs of objects that may be in contact.
@@ -282,15 +376,47 @@ BulletPhysics::BulletPhysics(WorldPtr _world)
   // Here we are using btDbvtBroadphase.
   this->broadPhase = new btDbvtBroadphase();
 
-  // Create btSequentialImpulseConstraintSolver, the default constraint solver.
-  // Note that a multi-threaded solver may be available.
-  this->solver = new btSequentialImpulseConstraintSolver;
+#ifdef LIBBULLET_VERSION_GE_288
+  if (this->threads > 1)
+  {
+    g_taskScheduler.setNumThreads(static_cast<int>(this->threads));
+    btSetTaskScheduler(&g_taskScheduler);
+
+    // Large pools, so that the dispatcher threads don't have to fall back on
+    // the allocator.
+    btDefaultCollisionConstructionInfo info;
+    info.m_defaultMaxPersistentManifoldPoolSize = 80000;
+    info.m_defaultMaxCollisionAlgorithmPoolSize = 80000;
+    this->collisionConfig = new btDefaultCollisionConfiguration(info);
+
+    // The narrow phase runs on the threads of the scheduler, and the
+    // islands are solved by a pool of sequential impulse solvers.
+    this->dispatcher = new btCollisionDispatcherMt(this->collisionConfig);
+    btConstraintSolverPoolMt *solverPool =
+        new btConstraintSolverPoolMt(static_cast<int>(this->threads));
+    this->solver = solverPool;
+    this->dynamicsWorld = new btDiscreteDynamicsWorldMt(this->dispatcher,
+        this->broadPhase, solverPool, nullptr, this->collisionConfig);
+  }
+  else
+#endif
+  {
+    // Default setup for memory and collisions
+    this->collisionConfig = new btDefaultCollisionConfiguration();
+
+    // Default collision dispatcher
+    this->dispatcher = new btCollisionDispatcher(this->collisionConfig);
 
-  // Create a btDiscreteDynamicsWorld, which is used for discrete rigid bodies.
-  // An alternative is btSoftRigidDynamicsWorld, which handles both soft and
-  // rigid bodies.
-  this->dynamicsWorld = new btDiscreteDynamicsWorld(this->dispatcher,
-      this->broadPhase, this->solver, this->collisionConfig);
+    // Create btSequentialImpulseConstraintSolver, the default constraint
+    // solver.
+    this->solver = new btSequentialImpulseConstraintSolver;
+
+    // Create a btDiscreteDynamicsWorld, which is used for discrete rigid
+    // bodies. An alternative is btSoftRigidDynamicsWorld, which handles both
+    // soft and rigid bodies.
+    this->dynamicsWorld = new btDiscreteDynamicsWorld(this->dispatcher,
+        this->broadPhase, this->solver, this->collisionConfig);
+  }
 
   btOverlapFilterCallback *filterCallback = new CollisionFilter();
   btOverlappingPairCache* pairCache = this->dynamicsWorld->getPairCache();
@@ -302,14 +428,37 @@ BulletPhysics::BulletPhysics(WorldPtr _world)
   gContactAddedCallback = ContactCallback;
   gContactProcessedCallback = ContactProcessed;
 
+  // The tick callback runs on the stepping thread, after the parallel parts
+  // of the step, so the contact feedback doesn't need locking.
   this->dynamicsWorld->setInternalTickCallback(
       InternalTickCallback, static_cast<void *>(this));
 
-  // Set random seed for physics engine based on gazebo's random seed.
-  // Note: this was moved from physics::PhysicsEngine constructor.
-  this->SetSeed(ignition::math::Rand::Seed());
+  btGImpactCollisionAlgorithm::registerAlgorithm(this->dispatcher);
+}
 
-  btGImpactCollisionAlgorithm::registerAlgorithm(dispatcher);
+//////////////////////////////////////////////////
+void BulletPhysics::DestroyDynamicsWorld()
+{
+  // Delete in reverse-order of creation
+  if (this->dynamicsWorld)
+    delete this->dynamicsWorld;
+  this->dynamicsWorld = nullptr;
+
+  if (this->solver)
+    delete this->solver;
+  this->solver = nullptr;
+
+  if (this->broadPhase)
+    delete this->broadPhase;
+  this->broadPhase = nullptr;
+
+  if (this->dispatcher)
+    delete this->dispatcher;
+  this->dispatcher = nullptr;
+
+  if (this->collisionConfig)
+    delete this->collisionConfig;
+  this->collisionConfig = nullptr;
 }
 
 //////////////////////////////////////////////////
@@ -323,6 +472,31 @@ void BulletPhysics::Load(sdf::ElementPtr _sdf)
 {
   PhysicsEngine::Load(_sdf);
 
+  // The number of threads is a custom element, read it from the SDF that
+  // is given since it has no description.
+  if (_sdf->HasElement("bullet") &&
+      _sdf->GetElement("bullet")->HasElement("ignition:threads"))
+  {
+    const int threadCount =
+        _sdf->GetElement("bullet")->Get<int>("ignition:threads");
+    if (threadCount < 1)
+    {
+      gzerr << "Bullet threads must be positive, using one thread\n";
+    }
+    else if (static_cast<unsigned int>(threadCount) != this->threads)
+    {
+#ifdef LIBBULLET_VERSION_GE_288
+      // No body has been added yet, the world can be replaced.
+      this->DestroyDynamicsWorld();
+      this->threads = static_cast<unsigned int>(threadCount);
+      this->CreateDynamicsWorld();
+#else
+      gzwarn << "The multithreaded Bullet world needs Bullet 2.88 or newer, "
+             << "using one thread\n";
+#endif
+    }
+  }
+
   sdf::ElementPtr bulletElem = this->sdf->GetElement("bullet");
 
   auto g = this->world->Gravity();
@@ -425,6 +599,7 @@ void BulletPhysics::OnRequest(ConstRequestPtr &_msg)
     physicsMsg.set_real_time_update_rate(this->realTimeUpdateRate);
     physicsMsg.set_real_time_factor(this->targetRealTimeFactor);
     physicsMsg.set_max_step_size(this->maxStepSize);
+    physicsMsg.set_model_update_threads(this->world->ModelUpdateThreads());
 
     response.set_type(physicsMsg.GetTypeName());
     physicsMsg.SerializeToString(serializedData);
@@ -488,6 +663,7 @@ void BulletPhysics::OnPhysicsMsg(ConstPhysicsPtr &_msg)
 void BulletPhysics::UpdateCollision()
 {
   IGN_PROFILE("BulletPhysics:UpdateCollision");
+  GZ_TRACE_SCOPE("physics::BulletPhysics::UpdateCollision");
 
   this->contactManager->ResetCount();
 
@@ -520,6 +696,7 @@ void BulletPhysics::UpdateCollision()
 void BulletPhysics::UpdatePhysics()
 {
   IGN_PROFILE("BulletPhysics:UpdatePhysics");
+  GZ_TRACE_SCOPE("physics::BulletPhysics::UpdatePhysics");
 
   // need to lock, otherwise might conflict with world resetting
   boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
@@ -533,26 +710,7 @@ void BulletPhysics::UpdatePhysics()
 //////////////////////////////////////////////////
 void BulletPhysics::Fini()
 {
-  // Delete in reverse-order of creation
-  if (this->dynamicsWorld)
-    delete this->dynamicsWorld;
-  this->dynamicsWorld = nullptr;
-
-  if (this->solver)
-    delete this->solver;
-  this->solver = nullptr;
-
-  if (this->broadPhase)
-    delete this->broadPhase;
-  this->broadPhase = nullptr;
-
-  if (this->dispatcher)
-    delete this->dispatcher;
-  this->dispatcher = nullptr;
-
-  if (this->collisionConfig)
-    delete this->collisionConfig;
-  this->collisionConfig = nullptr;
+  this->DestroyDynamicsWorld();
 
   PhysicsEngine::Fini();
 }
@@ -659,6 +817,17 @@ bool BulletPhysics::SetParam(const std::string &_key, const boost::any &_value)
       double value = any_cast<double>(_value);
       bulletElem->GetElement("solver")->GetElement("min_step_size")->Set(value);
     }
+    else if (_key == "threads")
+    {
+      // The dynamics world is created with its threads
+      int value = any_cast<int>(_value);
+      if (value < 1 || static_cast<unsigned int>(value) != this->threads)
+      {
+        gzerr << "Bullet threads can only be set in the SDF of the world, "
+              << "with <bullet><ignition:threads>\n";
+        return false;
+      }
+    }
     else
     {
       return PhysicsEngine::SetParam(_key, _value);
@@ -721,6 +890,8 @@ bool BulletPhysics::GetParam(const std::string &_key, boost::any &_value) const
     _value = this->sdf->GetElement("max_contacts")->Get<int>();
   else if (_key == "min_step_size")
     _value = bulletElem->GetElement("solver")->Get<double>("min_step_size");
+  else if (_key == "threads")
+    _value = static_cast<int>(this->threads);
   else
   {
     return PhysicsEngine::GetParam(_key, _value);
@@ -172,12 +172,23 @@ namespace gazebo
       // Documentation inherited
       public: virtual void SetSORPGSIters(unsigned int iters);
 
+      /// \brief Create the Bullet dynamics world, multithreaded if more
+      /// than one thread is requested and supported.
+      private: void CreateDynamicsWorld();
+
+      /// \brief Delete the Bullet dynamics world.
+      private: void DestroyDynamicsWorld();
+
       private: btBroadphaseInterface *broadPhase;
       private: btDefaultCollisionConfiguration *collisionConfig;
       private: btCollisionDispatcher *dispatcher;
-      private: btSequentialImpulseConstraintSolver *solver;
+      private: btConstraintSolver *solver;
       private: btDiscreteDynamicsWorld *dynamicsWorld;
 
+      /// \brief Number of threads of the dynamics world, one for the
+      /// single threaded world.
+      private: unsigned int threads = 1;
+
       private: common::Time lastUpdateTime;
 
       /// \brief The type of the solver.
@@ -267,6 +267,31 @@ TEST_F(BulletPhysics_TEST, PhysicsMsgParam)
   PhysicsMsgParam();
 }
 
+/////////////////////////////////////////////////
+/// Test that the number of threads is fixed at load time
+TEST_F(BulletPhysics_TEST, Threads)
+{
+  Load("worlds/empty.world", true, "bullet");
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  physics::PhysicsEnginePtr physics = world->Physics();
+  ASSERT_TRUE(physics != nullptr);
+
+  EXPECT_EQ(1, boost::any_cast<int>(physics->GetParam("threads")));
+  EXPECT_TRUE(physics->SetParam("threads", 1));
+  EXPECT_FALSE(physics->SetParam("threads", 4));
+  EXPECT_EQ(1, boost::any_cast<int>(physics->GetParam("threads")));
+
+  // Boxes still come to rest on the ground
+  SpawnBox("box", ignition::math::Vector3d::One,
+      ignition::math::Vector3d(0, 0, 1));
+  world->Step(1000);
+  physics::ModelPtr model = world->ModelByName("box");
+  ASSERT_TRUE(model != nullptr);
+  EXPECT_NEAR(0.5, model->WorldPose().Pos().Z(), 0.02);
+}
+
 /////////////////////////////////////////////////
 /// Main
 int main(int argc, char **argv)
@@ -352,6 +352,8 @@ bool DARTLink::GetEnabled() const
 //////////////////////////////////////////////////
 void DARTLink::SetLinearVel(const ignition::math::Vector3d &_vel)
 {
+  this->ClearKinematicsCache();
+
   if (!this->dataPtr->IsInitialized())
   {
     this->dataPtr->Cache("WorldLinearVel",
@@ -419,6 +421,8 @@ void DARTLink::SetLinearVel(const ignition::math::Vector3d &_vel)
 //////////////////////////////////////////////////
 void DARTLink::SetAngularVel(const ignition::math::Vector3d &_vel)
 {
+  this->ClearKinematicsCache();
+
   if (!this->dataPtr->IsInitialized())
   {
     this->dataPtr->Cache("WorldAngularVel",
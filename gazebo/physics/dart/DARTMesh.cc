@@ -15,9 +15,13 @@
  *
 */
 
+#include <memory>
+#include <string>
+
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/Mesh.hh"
 
+#include "gazebo/physics/MeshCollisionCache.hh"
 #include "gazebo/physics/dart/DARTCollision.hh"
 #include "gazebo/physics/dart/DARTPhysics.hh"
 #include "gazebo/physics/dart/DARTMesh.hh"
@@ -27,6 +31,9 @@
 using namespace gazebo;
 using namespace physics;
 
+/// \brief Mesh shapes of all the DART meshes of the process.
+static MeshCollisionCache<dart::dynamics::MeshShape> g_meshCache;
+
 //////////////////////////////////////////////////
 DARTMesh::DARTMesh() : dataPtr(new DARTMeshPrivate())
 {
@@ -87,43 +94,51 @@ void DARTMesh::CreateMesh(float *_vertices, int *_indices,
 {
   GZ_ASSERT(_collision, "DART collision is null");
 
-  // Create new aiScene (aiMesh)
-  aiScene *assimpScene = new aiScene;
-  aiMesh *assimpMesh = new aiMesh;
-  assimpScene->mNumMeshes = 1;
-  assimpScene->mMeshes = new aiMesh*[1];
-  assimpScene->mMeshes[0] = assimpMesh;
-  assimpScene->mRootNode = new aiNode();
-
-  // Set _vertices and normals
-  assimpMesh->mNumVertices = _numVertices;
-  assimpMesh->mVertices = new aiVector3D[_numVertices];
-  assimpMesh->mNormals = new aiVector3D[_numVertices];
-  aiVector3D itAIVector3d;
-
-  for (unsigned int i = 0; i < _numVertices; ++i)
-  {
-    itAIVector3d.Set(_vertices[i*3 + 0], _vertices[i*3 + 1],
-      _vertices[i*3 + 2]);
-    assimpMesh->mVertices[i] = itAIVector3d;
-    assimpMesh->mNormals[i]  = itAIVector3d;
-  }
-
-  // Set faces
-  assimpMesh->mNumFaces = _numIndices/3;
-  assimpMesh->mFaces = new aiFace[assimpMesh->mNumFaces];
-  for (unsigned int i = 0; i < assimpMesh->mNumFaces; ++i)
+  const std::string key = MeshCollisionCache<dart::dynamics::MeshShape>::Key(
+      _vertices, _numVertices, _indices, _numIndices, _scale);
+
+  // Shape nodes of identical meshes share the same shape
+  dart::dynamics::ShapePtr dtMeshShape = g_meshCache.Get(key, [&]()
   {
-    aiFace* itAIFace = &assimpMesh->mFaces[i];
-    itAIFace->mNumIndices = 3;
-    itAIFace->mIndices = new unsigned int[3];
-    itAIFace->mIndices[0] = _indices[i*3 + 0];
-    itAIFace->mIndices[1] = _indices[i*3 + 1];
-    itAIFace->mIndices[2] = _indices[i*3 + 2];
-  }
-
-  dart::dynamics::ShapePtr dtMeshShape(new dart::dynamics::MeshShape(
-      DARTTypes::ConvVec3(_scale), assimpScene));
+    // Create new aiScene (aiMesh)
+    aiScene *assimpScene = new aiScene;
+    aiMesh *assimpMesh = new aiMesh;
+    assimpScene->mNumMeshes = 1;
+    assimpScene->mMeshes = new aiMesh*[1];
+    assimpScene->mMeshes[0] = assimpMesh;
+    assimpScene->mRootNode = new aiNode();
+
+    // Set _vertices and normals
+    assimpMesh->mNumVertices = _numVertices;
+    assimpMesh->mVertices = new aiVector3D[_numVertices];
+    assimpMesh->mNormals = new aiVector3D[_numVertices];
+    aiVector3D itAIVector3d;
+
+    for (unsigned int i = 0; i < _numVertices; ++i)
+    {
+      itAIVector3d.Set(_vertices[i*3 + 0], _vertices[i*3 + 1],
+        _vertices[i*3 + 2]);
+      assimpMesh->mVertices[i] = itAIVector3d;
+      assimpMesh->mNormals[i]  = itAIVector3d;
+    }
+
+    // Set faces
+    assimpMesh->mNumFaces = _numIndices/3;
+    assimpMesh->mFaces = new aiFace[assimpMesh->mNumFaces];
+    for (unsigned int i = 0; i < assimpMesh->mNumFaces; ++i)
+    {
+      aiFace* itAIFace = &assimpMesh->mFaces[i];
+      itAIFace->mNumIndices = 3;
+      itAIFace->mIndices = new unsigned int[3];
+      itAIFace->mIndices[0] = _indices[i*3 + 0];
+      itAIFace->mIndices[1] = _indices[i*3 + 1];
+      itAIFace->mIndices[2] = _indices[i*3 + 2];
+    }
+
+    return std::make_shared<dart::dynamics::MeshShape>(
+        DARTTypes::ConvVec3(_scale), assimpScene);
+  });
+
   GZ_ASSERT(_collision->DARTBodyNode(),
             "DART _collision->DARTBodyNode() is null");
 
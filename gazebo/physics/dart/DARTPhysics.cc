@@ -18,6 +18,12 @@
 // required for HAVE_DART_BULLET define
 #include <gazebo/gazebo_config.h>
 
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include <algorithm>
+#include <vector>
+
 #ifdef HAVE_DART_BULLET
 #include <dart/collision/bullet/bullet.hpp>
 #endif
@@ -30,6 +36,7 @@
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Exception.hh"
+#include "gazebo/common/Tracer.hh"
 
 #include "gazebo/transport/Publisher.hh"
 
@@ -352,6 +359,9 @@ static void RetrieveDARTCollisions(
     dart::dynamics::BodyNode *dtBodyNode2 = dartLink2->DARTBodyNode();
 
     contactFeedback->count = 0;
+    contactFeedback->SetCapacity(std::min(
+          static_cast<unsigned int>(dtContacts.size()),
+          static_cast<unsigned int>(MAX_CONTACT_JOINTS)));
 
     std::deque<const dart::collision::Contact*>::const_iterator contIt;
     int contNum = 0;
@@ -415,6 +425,7 @@ static void RetrieveDARTCollisions(
 void DARTPhysics::UpdateCollision()
 {
   IGN_PROFILE("DARTPhysics::UpdateCollision");
+  GZ_TRACE_SCOPE("physics::DARTPhysics::UpdateCollision");
   IGN_PROFILE_BEGIN("UpdateCollision");
 
   if (!this->world->PhysicsEnabled())
@@ -436,10 +447,81 @@ void DARTPhysics::UpdateCollision()
   IGN_PROFILE_END();
 }
 
+//////////////////////////////////////////////////
+/// \brief Step a DART world the way dart::simulation::World::step does,
+/// running the dynamics of the skeletons concurrently. The skeletons only
+/// interact through the constraint solver, which groups the constrained
+/// skeletons into islands and runs on the calling thread.
+/// \param[in] _world World to step.
+/// \param[in] _arena Threads that run the dynamics of the skeletons.
+/// \param[in] _resetCommand True to clear the forces and commands after
+/// the step.
+static void StepSkeletons(dart::simulation::World &_world,
+    tbb::task_arena &_arena, const bool _resetCommand)
+{
+  const double dt = _world.getTimeStep();
+
+  std::vector<dart::dynamics::Skeleton *> skeletons;
+  skeletons.reserve(_world.getNumSkeletons());
+  for (std::size_t i = 0; i < _world.getNumSkeletons(); ++i)
+  {
+    dart::dynamics::Skeleton *skel = _world.getSkeleton(i).get();
+    if (skel->isMobile())
+      skeletons.push_back(skel);
+  }
+
+  // Integrate the velocities of the unconstrained skeletons
+  _arena.execute([&]()
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, skeletons.size(), 1),
+        [&](const tbb::blocked_range<size_t> &_r)
+        {
+          for (size_t i = _r.begin(); i != _r.end(); ++i)
+          {
+            skeletons[i]->computeForwardDynamics();
+            skeletons[i]->integrateVelocities(dt);
+          }
+        });
+  });
+
+  // Detect the active constraints and compute their impulses
+  _world.getConstraintSolver()->solve();
+
+  // Apply the impulses and integrate the positions
+  _arena.execute([&]()
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, skeletons.size(), 1),
+        [&](const tbb::blocked_range<size_t> &_r)
+        {
+          for (size_t i = _r.begin(); i != _r.end(); ++i)
+          {
+            dart::dynamics::Skeleton *skel = skeletons[i];
+            if (skel->isImpulseApplied())
+            {
+              skel->computeImpulseForwardDynamics();
+              skel->setImpulseApplied(false);
+            }
+
+            skel->integratePositions(dt);
+
+            if (_resetCommand)
+            {
+              skel->clearInternalForces();
+              skel->clearExternalForces();
+              skel->resetCommands();
+            }
+          }
+        });
+  });
+
+  _world.setTime(_world.getTime() + dt);
+}
+
 //////////////////////////////////////////////////
 void DARTPhysics::UpdatePhysics()
 {
   IGN_PROFILE("DARTPhysics::UpdatePhysics");
+  GZ_TRACE_SCOPE("physics::DARTPhysics::UpdatePhysics");
   IGN_PROFILE_BEGIN("Update");
 
   // need to lock, otherwise might conflict with world resetting
@@ -448,8 +530,16 @@ void DARTPhysics::UpdatePhysics()
   // common::Time currTime =  this->world->GetRealTime();
 
   this->dataPtr->dtWorld->setTimeStep(this->maxStepSize);
-  this->dataPtr->dtWorld->step(
+  if (this->dataPtr->skeletonArena)
+  {
+    StepSkeletons(*this->dataPtr->dtWorld, *this->dataPtr->skeletonArena,
         this->dataPtr->resetAllForcesAfterSimulationStep);
+  }
+  else
+  {
+    this->dataPtr->dtWorld->step(
+          this->dataPtr->resetAllForcesAfterSimulationStep);
+  }
 
   // Update all the transformation of DART's links to gazebo's links
   // TODO: How to visit all the links in the world?
@@ -706,6 +796,10 @@ bool DARTPhysics::GetParam(const std::string &_key, boost::any &_value) const
   {
     _value = dartElem->GetElement("solver")->Get<double>("min_step_size");
   }
+  else if (_key == "skeleton_threads")
+  {
+    _value = static_cast<int>(this->dataPtr->skeletonThreads);
+  }
   else
   {
     return PhysicsEngine::GetParam(_key, _value);
@@ -741,6 +835,22 @@ bool DARTPhysics::SetParam(const std::string &_key, const boost::any &_value)
       this->dataPtr->resetAllForcesAfterSimulationStep =
           any_cast<bool>(_value);
     }
+    else if (_key == "skeleton_threads")
+    {
+      int value = any_cast<int>(_value);
+      if (value < 0)
+      {
+        gzerr << "skeleton_threads must not be negative\n";
+        return false;
+      }
+
+      boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
+      this->dataPtr->skeletonThreads = value;
+      if (value > 1)
+        this->dataPtr->skeletonArena.reset(new tbb::task_arena(value));
+      else
+        this->dataPtr->skeletonArena.reset();
+    }
     else if (_key == "collision_detector")
     {
       // set collision detector
@@ -844,6 +954,7 @@ void DARTPhysics::OnRequest(ConstRequestPtr &_msg)
     physicsMsg.set_real_time_update_rate(this->realTimeUpdateRate);
     physicsMsg.set_real_time_factor(this->targetRealTimeFactor);
     physicsMsg.set_max_step_size(this->maxStepSize);
+    physicsMsg.set_model_update_threads(this->world->ModelUpdateThreads());
 
     response.set_type(physicsMsg.GetTypeName());
     physicsMsg.SerializeToString(serializedData);
@@ -18,6 +18,10 @@
 #ifndef _GAZEBO_DARTPHYSICS_PRIVATE_HH_
 #define _GAZEBO_DARTPHYSICS_PRIVATE_HH_
 
+#include <tbb/task_arena.h>
+
+#include <memory>
+
 #include "gazebo/physics/dart/dart_inc.h"
 
 namespace gazebo
@@ -50,6 +54,14 @@ namespace gazebo
       /// and torques (both internal and external) after completing a simulation
       /// step. Default value is true.
       public: bool resetAllForcesAfterSimulationStep;
+
+      /// \brief Number of threads that run the dynamics of the skeletons,
+      /// zero or one to use dart::simulation::World::step.
+      public: unsigned int skeletonThreads = 0;
+
+      /// \brief Threads that run the dynamics of the skeletons, null when
+      /// the world steps on its own.
+      public: std::unique_ptr<tbb::task_arena> skeletonArena;
     };
   }
 }
@@ -24,6 +24,7 @@
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/Console.hh"
 
+#include "gazebo/physics/World.hh"
 #include "gazebo/physics/ode/ODESurfaceParams.hh"
 #include "gazebo/physics/ode/ODEPhysics.hh"
 #include "gazebo/physics/ode/ODELink.hh"
@@ -49,7 +50,13 @@ ODECollision::ODECollision(LinkPtr _link)
 //////////////////////////////////////////////////
 ODECollision::~ODECollision()
 {
-  if (this->collisionId)
+  if (!this->compoundIds.empty())
+  {
+    for (auto id : this->compoundIds)
+      dGeomDestroy(id);
+    dSpaceDestroy(this->spaceId);
+  }
+  else if (this->collisionId)
     dGeomDestroy(this->collisionId);
   this->collisionId = nullptr;
 
@@ -117,6 +124,9 @@ void ODECollision::SetCollision(dGeomID _collisionId, bool _placeable)
     GZ_ASSERT(dGeomGetSpace(this->collisionId) != 0, "Collision ID is null");
   }
 
+  this->ApplyCollideBitmask();
+  this->UpdateSpaceBits();
+
   if (this->collisionId && this->placeable)
   {
     if (this->IsStatic())
@@ -132,6 +142,40 @@ void ODECollision::SetCollision(dGeomID _collisionId, bool _placeable)
   dGeomSetData(this->collisionId, this);
 }
 
+//////////////////////////////////////////////////
+void ODECollision::SetCompound(const std::vector<dGeomID> &_collisionIds,
+    bool _placeable)
+{
+  GZ_ASSERT(!_collisionIds.empty(), "A compound needs at least one part");
+  GZ_ASSERT(this->compoundIds.empty(), "Collision is already a compound");
+
+  // The space of the parts inherits the collision bits of the space it is
+  // added to. Its data marks it as a compound for the collision callback.
+  const dGeomID parent = (dGeomID)this->spaceId;
+  dSpaceID space = dSimpleSpaceCreate(this->spaceId);
+  dGeomSetCategoryBits((dGeomID)space, dGeomGetCategoryBits(parent));
+  dGeomSetCollideBits((dGeomID)space, dGeomGetCollideBits(parent));
+  dGeomSetData((dGeomID)space, this);
+  this->SetSpaceId(space);
+
+  this->compoundIds = _collisionIds;
+  for (auto id : this->compoundIds)
+  {
+    dGeomSetCategoryBits(id, dGeomGetCategoryBits(parent));
+    dGeomSetCollideBits(id, dGeomGetCollideBits(parent));
+    dSpaceAdd(space, id);
+    dGeomSetData(id, this);
+  }
+
+  this->SetCollision(this->compoundIds[0], _placeable);
+}
+
+//////////////////////////////////////////////////
+const std::vector<dGeomID> &ODECollision::CompoundIds() const
+{
+  return this->compoundIds;
+}
+
 //////////////////////////////////////////////////
 dGeomID ODECollision::GetCollisionId() const
 {
@@ -156,8 +200,9 @@ void ODECollision::SetCategoryBits(unsigned int _bits)
 {
   if (this->collisionId)
     dGeomSetCategoryBits(this->collisionId, _bits);
-  if (this->spaceId)
-    dGeomSetCategoryBits((dGeomID)this->spaceId, _bits);
+  for (auto id : this->compoundIds)
+    dGeomSetCategoryBits(id, _bits);
+  this->UpdateSpaceBits();
 }
 
 //////////////////////////////////////////////////
@@ -165,8 +210,72 @@ void ODECollision::SetCollideBits(unsigned int _bits)
 {
   if (this->collisionId)
     dGeomSetCollideBits(this->collisionId, _bits);
-  if (this->spaceId)
-    dGeomSetCollideBits((dGeomID)this->spaceId, _bits);
+  for (auto id : this->compoundIds)
+    dGeomSetCollideBits(id, _bits);
+  this->UpdateSpaceBits();
+}
+
+//////////////////////////////////////////////////
+void ODECollision::OnCollideBitmaskChange()
+{
+  this->ApplyCollideBitmask();
+}
+
+//////////////////////////////////////////////////
+void ODECollision::ApplyCollideBitmask()
+{
+  if (!this->collisionId || this->IsStatic())
+    return;
+
+  // Collide modes, sensors and plugins set their own bits
+  const unsigned long category = dGeomGetCategoryBits(this->collisionId);
+  if (category != GZ_ALL_COLLIDE &&
+      (this->bitmaskBits == 0 || category != this->bitmaskBits))
+  {
+    return;
+  }
+
+  // The mask is shifted above the fixed and sensor bits. The fixed bit in
+  // the category and the sensor bit in the collide bits keep the pairs with
+  // static collisions and rays, which GenerateContacts filters later.
+  const unsigned int mask = this->surface->collideBitmask;
+  if (mask < 0xFFFF)
+  {
+    this->bitmaskBits = (static_cast<unsigned long>(mask) << 2) |
+        GZ_FIXED_COLLIDE;
+    this->SetCategoryBits(this->bitmaskBits);
+    this->SetCollideBits((static_cast<unsigned long>(mask) << 2) |
+        GZ_SENSOR_COLLIDE);
+  }
+  else if (this->bitmaskBits != 0)
+  {
+    this->bitmaskBits = 0;
+    this->SetCategoryBits(GZ_ALL_COLLIDE);
+    this->SetCollideBits(GZ_ALL_COLLIDE);
+  }
+}
+
+//////////////////////////////////////////////////
+void ODECollision::UpdateSpaceBits()
+{
+  // A space passes the broadphase for any pair one of its geoms passes.
+  // The top space, which has no parent, is never tested.
+  for (dSpaceID space = this->spaceId;
+       space && dGeomGetSpace((dGeomID)space);
+       space = dGeomGetSpace((dGeomID)space))
+  {
+    unsigned long category = 0;
+    unsigned long collide = 0;
+    const int count = dSpaceGetNumGeoms(space);
+    for (int i = 0; i < count; ++i)
+    {
+      const dGeomID geom = dSpaceGetGeom(space, i);
+      category |= dGeomGetCategoryBits(geom);
+      collide |= dGeomGetCollideBits(geom);
+    }
+    dGeomSetCategoryBits((dGeomID)space, category);
+    dGeomSetCollideBits((dGeomID)space, collide);
+  }
 }
 
 //////////////////////////////////////////////////
@@ -176,7 +285,10 @@ ignition::math::AxisAlignedBox ODECollision::BoundingBox() const
   memset(aabb, 0, 6 * sizeof(dReal));
 
   // if (this->collisionId && this->type != Shape::PLANE)
-  dGeomGetAABB(this->collisionId, aabb);
+  if (!this->compoundIds.empty())
+    dGeomGetAABB((dGeomID)this->spaceId, aabb);
+  else
+    dGeomGetAABB(this->collisionId, aabb);
 
   ignition::math::AxisAlignedBox box(
       ignition::math::Vector3d(aabb[0], aabb[2], aabb[4]),
@@ -227,6 +339,21 @@ void ODECollision::OnPoseChangeGlobal()
   dGeomSetPosition(this->collisionId, localPose.Pos().X(),
       localPose.Pos().Y(), localPose.Pos().Z());
   dGeomSetQuaternion(this->collisionId, q);
+
+  // The parts of a compound share the pose of the collision
+  for (size_t i = 1; i < this->compoundIds.size(); ++i)
+  {
+    dGeomSetPosition(this->compoundIds[i], localPose.Pos().X(),
+        localPose.Pos().Y(), localPose.Pos().Z());
+    dGeomSetQuaternion(this->compoundIds[i], q);
+  }
+
+  // The engine refits the tree of the merged static collisions
+  if (this->world && this->world->Physics())
+  {
+    boost::static_pointer_cast<ODEPhysics>(
+        this->world->Physics())->OnStaticPoseChange();
+  }
 }
 
 /////////////////////////////////////////////////
@@ -254,6 +381,14 @@ void ODECollision::OnPoseChangeRelative()
   dGeomSetOffsetPosition(this->collisionId,
       localPose.Pos().X(), localPose.Pos().Y(), localPose.Pos().Z());
   dGeomSetOffsetQuaternion(this->collisionId, q);
+
+  // The parts of a compound share the pose of the collision
+  for (size_t i = 1; i < this->compoundIds.size(); ++i)
+  {
+    dGeomSetOffsetPosition(this->compoundIds[i],
+        localPose.Pos().X(), localPose.Pos().Y(), localPose.Pos().Z());
+    dGeomSetOffsetQuaternion(this->compoundIds[i], q);
+  }
 }
 
 /////////////////////////////////////////////////
@@ -22,6 +22,8 @@
 #ifndef _ODECOLLISION_HH_
 #define _ODECOLLISION_HH_
 
+#include <vector>
+
 #include "gazebo/physics/ode/ode_inc.h"
 
 #include "gazebo/physics/PhysicsTypes.hh"
@@ -57,6 +59,20 @@ namespace gazebo
       /// \param[in] _placeable True to make the object movable.
       public: void SetCollision(dGeomID _collisionId, bool _placeable);
 
+      /// \brief Make this a compound of several ODE objects, such as the
+      /// convex parts of a decomposed mesh. The parts are put in a space of
+      /// their own, which takes part in the broadphase as a single object,
+      /// and the first part becomes the collision id.
+      /// \param[in] _collisionIds ODE ids of the parts, which must not be
+      /// in a space yet. This takes ownership of the parts.
+      /// \param[in] _placeable True to make the parts movable.
+      public: void SetCompound(const std::vector<dGeomID> &_collisionIds,
+                  bool _placeable);
+
+      /// \brief Get the parts of a compound collision.
+      /// \return ODE ids of the parts, empty if this isn't a compound.
+      public: const std::vector<dGeomID> &CompoundIds() const;
+
       /// \brief Return the collision id.
       /// \return The collision id.
       public: dGeomID GetCollisionId() const;
@@ -90,6 +106,19 @@ namespace gazebo
       /// \return Dynamically casted pointer to ODESurfaceParams.
       public: ODESurfaceParamsPtr GetODESurface() const;
 
+      // Documentation inherited.
+      protected: virtual void OnCollideBitmaskChange() override;
+
+      /// \brief Map the collide bitmask of the surface onto the category and
+      /// collide bits, so that the broadphase prunes the pairs whose masks
+      /// do not overlap. The bits set by collide modes, sensors and plugins
+      /// are left alone.
+      private: void ApplyCollideBitmask();
+
+      /// \brief Set the bits of the spaces holding this collision to the
+      /// union of the bits of their geoms.
+      private: void UpdateSpaceBits();
+
       /// \brief Used when this is static to set the posse.
       private: void OnPoseChangeGlobal();
 
@@ -105,6 +134,13 @@ namespace gazebo
       /// \brief ID for the collision.
       protected: dGeomID collisionId;
 
+      /// \brief Parts of a compound collision, see SetCompound.
+      private: std::vector<dGeomID> compoundIds;
+
+      /// \brief Category bits set by ApplyCollideBitmask, zero if the bits
+      /// do not encode the collide bitmask.
+      private: unsigned long bitmaskBits = 0;
+
       /// \brief Function used to set the pose of the ODE object.
       private: void (ODECollision::*onPoseChangeFunc)();
     };
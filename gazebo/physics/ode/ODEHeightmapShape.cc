@@ -14,7 +14,13 @@
  * limitations under the License.
  *
 */
+#include <functional>
+
+#include "gazebo/common/Events.hh"
 #include "gazebo/common/Exception.hh"
+#include "gazebo/physics/Link.hh"
+#include "gazebo/physics/Model.hh"
+#include "gazebo/physics/World.hh"
 #include "gazebo/physics/ode/ODECollision.hh"
 #include "gazebo/physics/ode/ODEHeightmapShape.hh"
 
@@ -108,25 +114,48 @@ void ODEHeightmapShape::Init()
   // Step 2: Create the ODE heightfield collision
   this->odeData = dGeomHeightfieldDataCreate();
 
-
-  // Step 3: Setup a callback method for ODE
-  setOdeHeightfieldDetails(
-      this->odeData,
-      this->heights.data(),
-      // in meters
-      this->Size().X(),
-      // in meters
-      this->Size().Y(),
-      // number of vertices
-      this->vertSize,
-      // vertical (z-axis) offset
-      this->Pos().Z(),
-      // vertical thickness for closing the height map mesh
-      1.0);
-
-  // Step 4: Restrict the bounds of the AABB to improve efficiency
-  dGeomHeightfieldDataSetBounds(this->odeData, this->GetMinHeight(),
-      this->GetMaxHeight());
+  if (this->tileCache)
+  {
+    // Step 3: ODE reads the heights of a tiled heightmap through the
+    // callback, and the tiles follow the links. The range of the heights
+    // isn't known, so the AABB keeps its infinite default bounds.
+    dGeomHeightfieldDataBuildCallback(
+        this->odeData,
+        this,
+        &ODEHeightmapShape::GetHeightCallback,
+        this->Size().X(),  // width (in meters)
+        this->Size().Y(),  // height (in meters)
+        this->vertSize,    // width (sampling size)
+        this->vertSize,    // height (sampling size)
+        1.0,               // vertical (z-axis) scaling
+        this->Pos().Z(),   // vertical (z-axis) offset
+        1.0,               // vertical thickness
+        0);                // wrap mode
+
+    this->updateConnection = event::Events::ConnectWorldUpdateBegin(
+        std::bind(&ODEHeightmapShape::OnWorldUpdateBegin, this));
+  }
+  else
+  {
+    // Step 3: Setup a callback method for ODE
+    setOdeHeightfieldDetails(
+        this->odeData,
+        this->heights.data(),
+        // in meters
+        this->Size().X(),
+        // in meters
+        this->Size().Y(),
+        // number of vertices
+        this->vertSize,
+        // vertical (z-axis) offset
+        this->Pos().Z(),
+        // vertical thickness for closing the height map mesh
+        1.0);
+
+    // Step 4: Restrict the bounds of the AABB to improve efficiency
+    dGeomHeightfieldDataSetBounds(this->odeData, this->GetMinHeight(),
+        this->GetMaxHeight());
+  }
 
   oParent->SetCollision(dCreateHeightfield(0, this->odeData, 1), false);
   oParent->SetStatic(true);
@@ -160,3 +189,44 @@ void ODEHeightmapShape::Init()
   // dGeomSetOffsetQuaternion(oParent->getCollisionId(), q);
   dGeomSetQuaternion(oParent->GetCollisionId(), q);
 }
+
+//////////////////////////////////////////////////
+bool ODEHeightmapShape::TilesSupported() const
+{
+  return true;
+}
+
+//////////////////////////////////////////////////
+void ODEHeightmapShape::OnWorldUpdateBegin()
+{
+  std::vector<ignition::math::Vector2d> points;
+  for (auto const &model : this->collisionParent->GetWorld()->Models())
+    this->AddFocus(model, points);
+
+  this->tileCache->SetFocus(points);
+}
+
+//////////////////////////////////////////////////
+void ODEHeightmapShape::AddFocus(const ModelPtr &_model,
+    std::vector<ignition::math::Vector2d> &_points) const
+{
+  if (_model->IsStatic())
+    return;
+
+  // Same frame as the heightfield geom, which has Y up
+  ignition::math::Pose3d pose = this->collisionParent->WorldPose();
+  pose.Rot() = pose.Rot() * ignition::math::Quaterniond(IGN_DTOR(90), 0, 0);
+
+  const double span = this->vertSize - 1;
+  for (auto const &link : _model->GetLinks())
+  {
+    ignition::math::Vector3d local = pose.Rot().RotateVectorReverse(
+        link->WorldPose().Pos() - pose.Pos());
+    _points.emplace_back(
+        (local.X() / this->Size().X() + 0.5) * span,
+        (local.Z() / this->Size().Y() + 0.5) * span);
+  }
+
+  for (auto const &nested : _model->NestedModels())
+    this->AddFocus(nested, _points);
+}
@@ -19,6 +19,7 @@
 
 #include <vector>
 
+#include "gazebo/common/Event.hh"
 #include "gazebo/physics/HeightmapShape.hh"
 #include "gazebo/physics/ode/ODEPhysics.hh"
 #include "gazebo/physics/Collision.hh"
@@ -44,6 +45,20 @@ namespace gazebo
       // Documentation inerited.
       public: virtual void Init();
 
+      // Documentation inherited.
+      protected: virtual bool TilesSupported() const;
+
+      /// \brief Move the full resolution tiles of a tiled heightmap to the
+      /// links of the dynamic models, before each step.
+      private: void OnWorldUpdateBegin();
+
+      /// \brief Add the positions of the links of a model, and of its
+      /// nested models, in vertex coordinates.
+      /// \param[in] _model The model.
+      /// \param[in,out] _points The positions.
+      private: void AddFocus(const ModelPtr &_model,
+                   std::vector<ignition::math::Vector2d> &_points) const;
+
       /// \brief Called by ODE to get the height at a vertex.
       /// \param[in] _data Pointer to the heightmap data.
       /// \param[in] _x X location.
@@ -52,6 +67,10 @@ namespace gazebo
 
       /// \brief The heightmap data.
       private: dHeightfieldDataID odeData;
+
+      /// \brief Connection to the world update begin event of a tiled
+      /// heightmap.
+      private: event::ConnectionPtr updateConnection;
     };
     /// \}
   }
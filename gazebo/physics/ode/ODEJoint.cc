@@ -632,6 +632,7 @@ void ODEJoint::Reset()
     gzerr << "ODE Joint ID is invalid\n";
 
   this->forceAppliedTime = common::Time::Zero;
+  this->wrenchCached = false;
 
   Joint::Reset();
 }
@@ -645,12 +646,23 @@ void ODEJoint::CacheForceTorque()
 //////////////////////////////////////////////////
 JointWrench ODEJoint::GetForceTorque(unsigned int /*_index*/)
 {
+  const uint64_t iterations = this->world ? this->world->Iterations() : 0;
+  if (this->feedbackOnDemand)
+    this->feedbackReadIteration = iterations;
+
+  // The feedback only changes in a step
+  if (this->wrenchCached && this->wrenchIteration == iterations)
+    return this->wrench;
+
   // Note that:
   // f2, t2 are the force torque measured on parent body's cg
   // f1, t1 are the force torque measured on child body's cg
   dJointFeedback *fb = this->GetFeedback();
   if (fb)
   {
+    this->wrenchCached = true;
+    this->wrenchIteration = iterations;
+
     // kind of backwards here, body1 (parent) corresponds go f2, t2
     // and body2 (child) corresponds go f1, t1
     this->wrench.body2Force.Set(fb->f1[0], fb->f1[1], fb->f1[2]);
@@ -834,15 +846,40 @@ JointWrench ODEJoint::GetForceTorque(unsigned int /*_index*/)
     }
     this->wrench = this->wrench - wrenchAppliedWorld;
   }
-  else
+  else if (this->jointId && this->world && this->world->Physics())
   {
-    // forgot to set provide_feedback?
-    gzwarn << "GetForceTorque: forgot to set <provide_feedback>?\n";
+    // Enable the feedback until it is no longer read, the wrench is
+    // available after the next step.
+    this->AttachFeedback();
+    this->feedbackOnDemand = true;
+    this->feedbackReadIteration = iterations;
+    boost::static_pointer_cast<ODEPhysics>(this->world->Physics())->
+      AddFeedbackOnDemand(
+          boost::static_pointer_cast<ODEJoint>(shared_from_this()));
   }
 
   return this->wrench;
 }
 
+//////////////////////////////////////////////////
+bool ODEJoint::ReleaseIdleFeedback(const uint64_t _iterations)
+{
+  // Number of steps that an on demand feedback is kept without a read
+  static const uint64_t kIdleIterations = 100;
+
+  if (!this->feedbackOnDemand)
+    return true;
+
+  if (_iterations - this->feedbackReadIteration < kIdleIterations)
+    return false;
+
+  if (this->jointId)
+    dJointSetFeedback(this->jointId, nullptr);
+  this->feedbackOnDemand = false;
+  this->wrenchCached = false;
+  return true;
+}
+
 //////////////////////////////////////////////////
 bool ODEJoint::UsesImplicitSpringDamper()
 {
@@ -1092,31 +1129,43 @@ void ODEJoint::SetStiffnessDamping(unsigned int _index,
 void ODEJoint::SetProvideFeedback(bool _enable)
 {
   Joint::SetProvideFeedback(_enable);
+  this->feedbackOnDemand = false;
 
   if (this->provideFeedback)
   {
-    if (this->feedback == nullptr)
-    {
-      this->feedback = new dJointFeedback;
-      this->feedback->f1[0] = 0;
-      this->feedback->f1[1] = 0;
-      this->feedback->f1[2] = 0;
-      this->feedback->t1[0] = 0;
-      this->feedback->t1[1] = 0;
-      this->feedback->t1[2] = 0;
-      this->feedback->f2[0] = 0;
-      this->feedback->f2[1] = 0;
-      this->feedback->f2[2] = 0;
-      this->feedback->t2[0] = 0;
-      this->feedback->t2[1] = 0;
-      this->feedback->t2[2] = 0;
-    }
+    this->AttachFeedback();
+  }
+  else if (this->jointId)
+  {
+    dJointSetFeedback(this->jointId, nullptr);
+    this->wrenchCached = false;
+  }
+}
 
-    if (this->jointId)
-      dJointSetFeedback(this->jointId, this->feedback);
-    else
-      gzerr << "ODE Joint ID is invalid\n";
+//////////////////////////////////////////////////
+void ODEJoint::AttachFeedback()
+{
+  if (this->feedback == nullptr)
+  {
+    this->feedback = new dJointFeedback;
+    this->feedback->f1[0] = 0;
+    this->feedback->f1[1] = 0;
+    this->feedback->f1[2] = 0;
+    this->feedback->t1[0] = 0;
+    this->feedback->t1[1] = 0;
+    this->feedback->t1[2] = 0;
+    this->feedback->f2[0] = 0;
+    this->feedback->f2[1] = 0;
+    this->feedback->f2[2] = 0;
+    this->feedback->t2[0] = 0;
+    this->feedback->t2[1] = 0;
+    this->feedback->t2[2] = 0;
   }
+
+  if (this->jointId)
+    dJointSetFeedback(this->jointId, this->feedback);
+  else
+    gzerr << "ODE Joint ID is invalid\n";
 }
 
 //////////////////////////////////////////////////
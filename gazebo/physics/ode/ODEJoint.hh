@@ -241,9 +241,23 @@ namespace gazebo
       // Documentation inherited.
       public: virtual void SetProvideFeedback(bool _enable) override;
 
-      // Documentation inherited.
+      /// \brief Get the force and torque of the joint, see
+      /// Joint::GetForceTorque. A joint without <provide_feedback> gets its
+      /// feedback on demand: the first call enables it, so the wrench is
+      /// zero until the next step, and it is disabled again once the
+      /// wrench was not read for a number of steps. The wrench is
+      /// converted to the link frames once per world iteration.
+      /// \param[in] _index Not used right now
+      /// \return The force and torque at the joint.
       public: virtual JointWrench GetForceTorque(unsigned int _index) override;
 
+      /// \brief Disable the feedback enabled on demand by GetForceTorque if
+      /// the wrench was not read lately. Called by ODEPhysics after each
+      /// step.
+      /// \param[in] _iterations Current number of world iterations.
+      /// \return True if the joint no longer has feedback on demand.
+      public: bool ReleaseIdleFeedback(const uint64_t _iterations);
+
       // Documentation inherited.
       public: virtual void SetForce(unsigned int _index, double _force)
             override;
@@ -266,6 +280,9 @@ namespace gazebo
       protected: virtual void SetForceImpl(
                      unsigned int _index, double _force) = 0;
 
+      /// \brief Allocate the feedback data if needed and give it to ODE.
+      private: void AttachFeedback();
+
       /// \brief Save external forces applied to this Joint.
       /// \param[in] _index Index of the axis.
       /// \param[in] _force Force value.
@@ -280,6 +297,20 @@ namespace gazebo
       /// \brief Feedback data for this joint
       private: dJointFeedback *feedback;
 
+      /// \brief True if the feedback was enabled by GetForceTorque rather
+      /// than by SetProvideFeedback.
+      private: bool feedbackOnDemand = false;
+
+      /// \brief World iteration of the last GetForceTorque call.
+      private: uint64_t feedbackReadIteration = 0;
+
+      /// \brief World iteration of the wrench of the last GetForceTorque
+      /// call, valid if wrenchCached is true.
+      private: uint64_t wrenchIteration = 0;
+
+      /// \brief True if the wrench of wrenchIteration was computed.
+      private: bool wrenchCached = false;
+
       /// \brief CFM for joint's limit constraint
       private: double stopCFM;
 
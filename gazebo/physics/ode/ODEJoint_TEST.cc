@@ -122,6 +122,55 @@ TEST_F(ODEJoint_TEST, ImplicitDamping)
         << "]\n";
 }
 
+////////////////////////////////////////////////////////////////////////
+// Test that GetForceTorque enables the feedback of a joint on demand,
+// and that it is disabled once the joint is no longer read
+////////////////////////////////////////////////////////////////////////
+TEST_F(ODEJoint_TEST, FeedbackOnDemand)
+{
+  Load("worlds/implicit_damping_test.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  physics::ModelPtr model = world->ModelByName("model_1");
+  ASSERT_TRUE(model != nullptr);
+  physics::ODEJointPtr joint =
+    boost::dynamic_pointer_cast<physics::ODEJoint>(model->GetJoint("joint_0"));
+  ASSERT_TRUE(joint != nullptr);
+  EXPECT_TRUE(joint->GetFeedback() == nullptr);
+
+  // The first read enables the feedback, the next step fills it
+  physics::JointWrench wrench = joint->GetForceTorque(0u);
+  EXPECT_EQ(ignition::math::Vector3d::Zero, wrench.body2Force);
+  EXPECT_TRUE(joint->GetFeedback() != nullptr);
+
+  world->Step(1);
+  wrench = joint->GetForceTorque(0u);
+  EXPECT_GT(wrench.body2Force.Length(), 0.0);
+
+  // Reads in the same step get the same wrench
+  physics::JointWrench again = joint->GetForceTorque(0u);
+  EXPECT_EQ(wrench.body2Force, again.body2Force);
+  EXPECT_EQ(wrench.body1Torque, again.body1Torque);
+
+  // Still enabled while read
+  for (int i = 0; i < 150; ++i)
+  {
+    world->Step(1);
+    joint->GetForceTorque(0u);
+  }
+  EXPECT_TRUE(joint->GetFeedback() != nullptr);
+
+  // Disabled once idle
+  world->Step(150);
+  EXPECT_TRUE(joint->GetFeedback() == nullptr);
+
+  // Explicit feedback is kept
+  joint->SetProvideFeedback(true);
+  world->Step(150);
+  EXPECT_TRUE(joint->GetFeedback() != nullptr);
+}
+
 int main(int argc, char **argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
@@ -101,6 +101,8 @@ void ODELink::Init()
         if (g->IsPlaceable() && g->GetCollisionId())
         {
           dGeomSetBody(g->GetCollisionId(), this->linkId);
+          for (auto id : g->CompoundIds())
+            dGeomSetBody(id, this->linkId);
         }
       }
     }
@@ -133,8 +135,11 @@ void ODELink::Init()
 }
 
 //////////////////////////////////////////////////
-void ODELink::DisabledCallback(dBodyID /*_id*/)
+void ODELink::DisabledCallback(dBodyID _id)
 {
+  // Called when auto disabling puts the body to sleep
+  ODELink *self = static_cast<ODELink*>(dBodyGetData(_id));
+  self->SetAsleep(true);
 }
 
 //////////////////////////////////////////////////
@@ -145,6 +150,10 @@ void ODELink::MoveCallback(dBodyID _id)
   ODELink *self = static_cast<ODELink*>(dBodyGetData(_id));
   // self->poseMutex->lock();
 
+  // Only enabled bodies move, so the body woke up if it was asleep
+  if (self->Asleep())
+    self->SetAsleep(false);
+
   p = dBodyGetPosition(_id);
   r = dBodyGetQuaternion(_id);
 
@@ -422,6 +431,8 @@ void ODELink::UpdateMass()
 //////////////////////////////////////////////////
 void ODELink::SetLinearVel(const ignition::math::Vector3d &_vel)
 {
+  this->ClearKinematicsCache();
+
   if (this->linkId)
   {
     dBodySetLinearVel(this->linkId, _vel.X(), _vel.Y(), _vel.Z());
@@ -509,6 +520,8 @@ ignition::math::Vector3d ODELink::WorldCoGLinearVel() const
 //////////////////////////////////////////////////
 void ODELink::SetAngularVel(const ignition::math::Vector3d &_vel)
 {
+  this->ClearKinematicsCache();
+
   if (this->linkId)
   {
     dBodySetAngularVel(this->linkId, _vel.X(), _vel.Y(), _vel.Z());
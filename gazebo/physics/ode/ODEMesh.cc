@@ -14,36 +14,126 @@
  * limitations under the License.
  *
 */
+#include <functional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include "gazebo/common/CommonIface.hh"
 #include "gazebo/common/Mesh.hh"
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/Console.hh"
+#include "gazebo/common/SystemPaths.hh"
 
+#include "gazebo/physics/MeshCollisionCache.hh"
 #include "gazebo/physics/ode/ODECollision.hh"
 #include "gazebo/physics/ode/ODEPhysics.hh"
 #include "gazebo/physics/ode/ODEMesh.hh"
 
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \internal
+    /// \brief ODE triangle mesh data, with the scaled arrays it refers to.
+    class ODEMeshData
+    {
+      /// \brief Destructor.
+      public: ~ODEMeshData()
+              {
+                if (this->odeData)
+                  dGeomTriMeshDataDestroy(this->odeData);
+                delete [] this->vertices;
+                delete [] this->indices;
+              }
+
+      /// \brief Array of vertex values.
+      public: float *vertices = nullptr;
+
+      /// \brief Array of index values.
+      public: int *indices = nullptr;
+
+      /// \brief ODE trimesh data.
+      public: dTriMeshDataID odeData = nullptr;
+    };
+
+    /// \internal
+    /// \brief ODE convex data of the hulls of a decomposed mesh. ODE
+    /// refers to the arrays, it doesn't copy them.
+    class ODEConvexData
+    {
+      /// \brief Arrays of a hull, in the layout of dCreateConvex.
+      public: class Hull
+      {
+        /// \brief Four values per face: the outward normal and the
+        /// distance of the face to the origin.
+        public: std::vector<dReal> planes;
+
+        /// \brief Three values per vertex.
+        public: std::vector<dReal> points;
+
+        /// \brief Four values per face: the number of vertices, three,
+        /// and the vertex indices.
+        public: std::vector<unsigned int> polygons;
+      };
+
+      /// \brief The hulls.
+      public: std::vector<Hull> hulls;
+    };
+  }
+}
+
 using namespace gazebo;
 using namespace physics;
 
+/// \brief Trimesh data of all the ODE meshes of the process.
+static MeshCollisionCache<ODEMeshData> g_meshCache;
+
+/// \brief Convex data of all the decomposed ODE meshes of the process.
+static MeshCollisionCache<ODEConvexData> g_convexCache;
+
+/////////////////////////////////////////////////
+/// \brief Get the path of the file where the hulls of a mesh are cached.
+/// \param[in] _key Key of the mesh and of the decomposition parameters.
+/// \return Path of the cache file.
+static boost::filesystem::path ConvexCachePath(const std::string &_key)
+{
+#ifndef _WIN32
+  const char *homePath = common::getEnv("HOME");
+#else
+  const char *homePath = common::getEnv("HOMEPATH");
+#endif
+
+  boost::filesystem::path path;
+  if (!homePath)
+    path = common::SystemPaths::Instance()->TmpPath() + "/gazebo";
+  else
+    path = boost::filesystem::path(homePath) / ".gazebo";
+
+  std::ostringstream filename;
+  filename << std::hex << std::hash<std::string>()(_key) << ".hulls";
+  return path / "convex_decomposition" / filename.str();
+}
+
 //////////////////////////////////////////////////
 ODEMesh::ODEMesh()
 {
-  this->odeData = nullptr;
-  this->vertices = nullptr;
-  this->indices = nullptr;
 }
 
 //////////////////////////////////////////////////
 ODEMesh::~ODEMesh()
 {
-  delete [] this->vertices;
-  delete [] this->indices;
-  dGeomTriMeshDataDestroy(this->odeData);
 }
 
 //////////////////////////////////////////////////
 void ODEMesh::Update()
 {
+  // Only triangle meshes need the last transform
+  if (!this->meshData)
+    return;
+
   /// FIXME: use below to update trimesh geometry for collision without
   // using above Ogre codes
   // tell the tri-tri collider the current transform of the trimesh --
@@ -89,15 +179,16 @@ void ODEMesh::Init(const common::SubMesh *_subMesh, ODECollisionPtr _collision,
   unsigned int numVertices = _subMesh->GetVertexCount();
   unsigned int numIndices = _subMesh->GetIndexCount();
 
-  this->vertices = nullptr;
-  this->indices = nullptr;
+  float *vertices = nullptr;
+  int *indices = nullptr;
 
   // Get all the vertex and index data
-  _subMesh->FillArrays(&this->vertices, &this->indices);
+  _subMesh->FillArrays(&vertices, &indices);
 
   this->collisionId = _collision->GetCollisionId();
 
-  this->CreateMesh(numVertices, numIndices, _collision, _scale);
+  this->CreateMesh(vertices, indices, numVertices, numIndices, _collision,
+      _scale);
 }
 
 //////////////////////////////////////////////////
@@ -110,46 +201,194 @@ void ODEMesh::Init(const common::Mesh *_mesh, ODECollisionPtr _collision,
   unsigned int numVertices = _mesh->GetVertexCount();
   unsigned int numIndices = _mesh->GetIndexCount();
 
-  this->vertices = nullptr;
-  this->indices = nullptr;
+  float *vertices = nullptr;
+  int *indices = nullptr;
 
   // Get all the vertex and index data
-  _mesh->FillArrays(&this->vertices, &this->indices);
+  _mesh->FillArrays(&vertices, &indices);
 
   this->collisionId = _collision->GetCollisionId();
-  this->CreateMesh(numVertices, numIndices, _collision, _scale);
+  this->CreateMesh(vertices, indices, numVertices, numIndices, _collision,
+      _scale);
 }
 
 //////////////////////////////////////////////////
-void ODEMesh::CreateMesh(unsigned int _numVertices, unsigned int _numIndices,
-    ODECollisionPtr _collision, const ignition::math::Vector3d &_scale)
+bool ODEMesh::InitConvex(const common::SubMesh *_subMesh,
+    const common::Mesh *_mesh, ODECollisionPtr _collision,
+    const ignition::math::Vector3d &_scale,
+    const common::ConvexDecomposition &_decomposition)
 {
-  /// This will hold the vertex data of the triangle mesh
-  if (this->odeData == nullptr)
-    this->odeData = dGeomTriMeshDataCreate();
+  if (!_subMesh && !_mesh)
+    return false;
+
+  unsigned int numVertices = 0;
+  unsigned int numIndices = 0;
+  float *vertices = nullptr;
+  int *indices = nullptr;
 
-  // Scale the vertex data
-  for (unsigned int j = 0;  j < _numVertices; j++)
+  // Get all the vertex and index data
+  if (_subMesh)
+  {
+    numVertices = _subMesh->GetVertexCount();
+    numIndices = _subMesh->GetIndexCount();
+    _subMesh->FillArrays(&vertices, &indices);
+  }
+  else
   {
-    this->vertices[j*3+0] = this->vertices[j*3+0] * _scale.X();
-    this->vertices[j*3+1] = this->vertices[j*3+1] * _scale.Y();
-    this->vertices[j*3+2] = this->vertices[j*3+2] * _scale.Z();
+    numVertices = _mesh->GetVertexCount();
+    numIndices = _mesh->GetIndexCount();
+    _mesh->FillArrays(&vertices, &indices);
   }
 
-  // Build the ODE triangle mesh
-  dGeomTriMeshDataBuildSingle(this->odeData,
-      this->vertices, 3*sizeof(this->vertices[0]), _numVertices,
-      this->indices, _numIndices, 3*sizeof(this->indices[0]));
+  std::ostringstream key;
+  key << MeshCollisionCache<ODEConvexData>::Key(
+      vertices, numVertices, indices, numIndices, _scale)
+    << ':' << _decomposition.MaxHulls() << ':' << _decomposition.Concavity();
+
+  // Reuse the hulls of an identical mesh, from memory or from disk
+  this->convexData = g_convexCache.Get(key.str(), [&]()
+  {
+    std::shared_ptr<ODEConvexData> data;
+
+    std::vector<common::ConvexHull> hulls;
+    const boost::filesystem::path path = ConvexCachePath(key.str());
+    if (!common::ConvexDecomposition::Load(path.string(), hulls))
+    {
+      // Scale the vertex data
+      for (unsigned int j = 0; j < numVertices; ++j)
+      {
+        vertices[j*3+0] = vertices[j*3+0] * _scale.X();
+        vertices[j*3+1] = vertices[j*3+1] * _scale.Y();
+        vertices[j*3+2] = vertices[j*3+2] * _scale.Z();
+      }
+
+      if (!_decomposition.Decompose(vertices, numVertices, indices,
+            numIndices, hulls))
+      {
+        return data;
+      }
+
+      boost::system::error_code ec;
+      boost::filesystem::create_directories(path.parent_path(), ec);
+      if (ec || !common::ConvexDecomposition::Save(path.string(), hulls))
+      {
+        gzwarn << "Unable to cache the convex decomposition of a mesh in ["
+               << path.string() << "]\n";
+      }
+    }
+
+    data.reset(new ODEConvexData);
+    for (auto const &hull : hulls)
+    {
+      ODEConvexData::Hull odeHull;
+      for (auto const &vertex : hull.vertices)
+      {
+        odeHull.points.push_back(vertex.X());
+        odeHull.points.push_back(vertex.Y());
+        odeHull.points.push_back(vertex.Z());
+      }
+
+      for (size_t i = 0; i + 2 < hull.indices.size(); i += 3)
+      {
+        const auto &a = hull.vertices[hull.indices[i]];
+        const auto &b = hull.vertices[hull.indices[i+1]];
+        const auto &c = hull.vertices[hull.indices[i+2]];
+        ignition::math::Vector3d normal = (b - a).Cross(c - a);
+        normal.Normalize();
+
+        odeHull.planes.push_back(normal.X());
+        odeHull.planes.push_back(normal.Y());
+        odeHull.planes.push_back(normal.Z());
+        odeHull.planes.push_back(normal.Dot(a));
+
+        odeHull.polygons.push_back(3);
+        odeHull.polygons.push_back(hull.indices[i]);
+        odeHull.polygons.push_back(hull.indices[i+1]);
+        odeHull.polygons.push_back(hull.indices[i+2]);
+      }
+      data->hulls.push_back(odeHull);
+    }
+    return data;
+  });
+
+  delete [] vertices;
+  delete [] indices;
+
+  if (!this->convexData || this->convexData->hulls.empty())
+  {
+    this->convexData.reset();
+    return false;
+  }
+
+  std::vector<dGeomID> parts;
+  for (auto &hull : this->convexData->hulls)
+  {
+    parts.push_back(dCreateConvex(0, hull.planes.data(),
+          hull.planes.size() / 4, hull.points.data(), hull.points.size() / 3,
+          hull.polygons.data()));
+  }
+  _collision->SetCompound(parts, true);
+  this->collisionId = _collision->GetCollisionId();
+
+  memset(this->transform, 0, 32*sizeof(dReal));
+  this->transformIndex = 0;
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+void ODEMesh::CreateMesh(float *&_vertices, int *&_indices,
+    unsigned int _numVertices, unsigned int _numIndices,
+    ODECollisionPtr _collision, const ignition::math::Vector3d &_scale)
+{
+  const std::string key = MeshCollisionCache<ODEMeshData>::Key(
+      _vertices, _numVertices, _indices, _numIndices, _scale);
+
+  // Reuse the trimesh data, and its OPCODE tree, of an identical mesh
+  this->meshData = g_meshCache.Get(key, [&]()
+  {
+    /// This will hold the vertex data of the triangle mesh
+    std::shared_ptr<ODEMeshData> data(new ODEMeshData);
+    data->odeData = dGeomTriMeshDataCreate();
+
+    // The trimesh data refers to the arrays, it doesn't copy them
+    data->vertices = _vertices;
+    data->indices = _indices;
+    _vertices = nullptr;
+    _indices = nullptr;
+
+    // Scale the vertex data
+    for (unsigned int j = 0;  j < _numVertices; j++)
+    {
+      data->vertices[j*3+0] = data->vertices[j*3+0] * _scale.X();
+      data->vertices[j*3+1] = data->vertices[j*3+1] * _scale.Y();
+      data->vertices[j*3+2] = data->vertices[j*3+2] * _scale.Z();
+    }
+
+    // Build the ODE triangle mesh
+    dGeomTriMeshDataBuildSingle(data->odeData,
+        data->vertices, 3*sizeof(data->vertices[0]), _numVertices,
+        data->indices, _numIndices, 3*sizeof(data->indices[0]));
+
+    return data;
+  });
+
+  // The arrays are not needed when the data was cached
+  delete [] _vertices;
+  delete [] _indices;
+  _vertices = nullptr;
+  _indices = nullptr;
 
   if (_collision->GetCollisionId() == nullptr)
   {
     _collision->SetSpaceId(dSimpleSpaceCreate(_collision->GetSpaceId()));
     _collision->SetCollision(dCreateTriMesh(_collision->GetSpaceId(),
-          this->odeData, 0, 0, 0), true);
+          this->meshData->odeData, 0, 0, 0), true);
   }
   else
   {
-    dGeomTriMeshSetData(_collision->GetCollisionId(), this->odeData);
+    dGeomTriMeshSetData(_collision->GetCollisionId(),
+        this->meshData->odeData);
   }
 
   memset(this->transform, 0, 32*sizeof(dReal));
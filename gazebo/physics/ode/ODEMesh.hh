@@ -18,8 +18,11 @@
 #ifndef GAZEBO_PHYSICS_ODE_ODEMESH_HH_
 #define GAZEBO_PHYSICS_ODE_ODEMESH_HH_
 
+#include <memory>
+
 #include <ignition/math/Vector3.hh>
 
+#include "gazebo/common/ConvexDecomposition.hh"
 #include "gazebo/physics/ode/ODETypes.hh"
 #include "gazebo/physics/ode/ode_inc.h"
 #include "gazebo/physics/MeshShape.hh"
@@ -29,10 +32,18 @@ namespace gazebo
 {
   namespace physics
   {
+    // Forward declare private data classes.
+    class ODEConvexData;
+    class ODEMeshData;
+
     /// \addtogroup gazebo_physics_ode
     /// \{
 
     /// \brief Triangle mesh helper class.
+    ///
+    /// The ODE triangle mesh data, and the OPCODE tree that ODE builds from
+    /// it, are shared by all the meshes with the same vertices, indices and
+    /// scale; see MeshCollisionCache.
     class GZ_PHYSICS_VISIBLE ODEMesh
     {
       /// \brief Constructor.
@@ -57,15 +68,37 @@ namespace gazebo
                       ODECollisionPtr _collision,
                       const ignition::math::Vector3d &_scale);
 
+      /// \brief Create a compound of convex hulls that approximates a
+      /// concave mesh, instead of a triangle mesh. The hulls are cached on
+      /// disk, in ~/.gazebo/convex_decomposition, so that a mesh is only
+      /// decomposed once.
+      /// \param[in] _subMesh Pointer to the submesh, or null to use _mesh.
+      /// \param[in] _mesh Pointer to the mesh, used if _subMesh is null.
+      /// \param[in] _collision Pointer to the collision object.
+      /// \param[in] _scale Scaling factor.
+      /// \param[in] _decomposition Parameters of the decomposition.
+      /// \return False if the mesh could not be decomposed, in which case
+      /// no collision shape was created.
+      public: bool InitConvex(const common::SubMesh *_subMesh,
+                  const common::Mesh *_mesh, ODECollisionPtr _collision,
+                  const ignition::math::Vector3d &_scale,
+                  const common::ConvexDecomposition &_decomposition);
+
       /// \brief Update the collision mesh.
       public: virtual void Update();
 
       /// \brief Helper function to create the collision shape.
+      /// \param[in,out] _vertices Array of vertex values. The mesh takes
+      /// ownership of the array and sets the pointer to null.
+      /// \param[in,out] _indices Array of index values. The mesh takes
+      /// ownership of the array and sets the pointer to null.
       /// \param[in] _numVertices Number of vertices.
       /// \param[in] _numIndices Number of indices.
       /// \param[in] _collision Pointer to the collision object.
-      private: void CreateMesh(unsigned int _numVertices,
-                   unsigned int _numIndices, ODECollisionPtr _collision,
+      /// \param[in] _scale Scaling factor.
+      private: void CreateMesh(float *&_vertices, int *&_indices,
+                   unsigned int _numVertices, unsigned int _numIndices,
+                   ODECollisionPtr _collision,
                    const ignition::math::Vector3d &_scale);
 
       /// \brief Transform matrix.
@@ -74,14 +107,13 @@ namespace gazebo
       /// \brief Transform matrix index.
       private: int transformIndex;
 
-      /// \brief Array of vertex values.
-      private: float *vertices;
-
-      /// \brief Array of index values.
-      private: int *indices;
+      /// \brief ODE trimesh data, shared with the other meshes that use
+      /// the same vertices.
+      private: std::shared_ptr<ODEMeshData> meshData;
 
-      /// \brief ODE trimesh data.
-      private: dTriMeshDataID odeData;
+      /// \brief ODE convex data of a decomposed mesh, shared with the
+      /// other meshes that use the same vertices.
+      private: std::shared_ptr<ODEConvexData> convexData;
 
       /// \brief The collision id that this mesh is attached to.
       private: dGeomID collisionId;
@@ -17,6 +17,7 @@
 #include "gazebo/common/Mesh.hh"
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/Console.hh"
+#include "gazebo/common/ConvexDecomposition.hh"
 
 #include "gazebo/physics/ode/ODEMesh.hh"
 #include "gazebo/physics/ode/ODECollision.hh"
@@ -57,6 +58,34 @@ void ODEMeshShape::Init()
   if (!this->mesh)
     return;
 
+  // Approximate a concave mesh by convex hulls, which collide faster and
+  // more robustly than a triangle mesh
+  if (this->sdf->HasElement("ignition:convex_decomposition"))
+  {
+    sdf::ElementPtr elem =
+      this->sdf->GetElement("ignition:convex_decomposition");
+
+    common::ConvexDecomposition decomposition;
+    if (elem->HasElement("max_convex_hulls"))
+    {
+      decomposition.SetMaxHulls(
+          elem->Get<unsigned int>("max_convex_hulls"));
+    }
+    if (elem->HasElement("concavity"))
+      decomposition.SetConcavity(elem->Get<double>("concavity"));
+
+    if (this->odeMesh->InitConvex(this->submesh, this->mesh,
+          boost::static_pointer_cast<ODECollision>(this->collisionParent),
+          this->sdf->Get<ignition::math::Vector3d>("scale"), decomposition))
+    {
+      return;
+    }
+
+    gzwarn << "Unable to decompose the mesh of collision ["
+           << this->collisionParent->GetScopedName()
+           << "], using a triangle mesh\n";
+  }
+
   if (this->submesh)
   {
     this->odeMesh->Init(this->submesh,
@@ -14,7 +14,8 @@
  * limitations under the License.
  *
  */
-#include "gazebo/common/Assert.hh"
+#include <vector>
+
 #include "gazebo/common/Exception.hh"
 
 #include "gazebo/physics/World.hh"
@@ -50,8 +51,6 @@ ODEMultiRayShape::ODEMultiRayShape(CollisionPtr _parent)
 ODEMultiRayShape::ODEMultiRayShape(PhysicsEnginePtr _physicsEngine)
 : MultiRayShape(_physicsEngine)
 {
-  this->defaultUpdate = false;
-
   this->SetName("ODE Multiray Shape");
 
   // Create a space to contain the ray space
@@ -88,119 +87,21 @@ void ODEMultiRayShape::UpdateRays()
   if (ode == nullptr)
     gzthrow("Invalid physics engine. Must use ODE.");
 
-  // Do we need to lock the physics engine here? YES!
-  // especially when spawning models with sensors
-  {
-    boost::recursive_mutex::scoped_lock lock(*ode->GetPhysicsUpdateMutex());
-
-    // Do collision detection
-    dSpaceCollide2((dGeomID) (this->superSpaceId),
-        (dGeomID) (ode->GetSpaceId()),
-        this, &UpdateCallback);
-  }
-}
-
-//////////////////////////////////////////////////
-void ODEMultiRayShape::UpdateCallback(void *_data, dGeomID _o1, dGeomID _o2)
-{
-  dContactGeom contact;
-  ODEMultiRayShape *self = nullptr;
+  std::vector<RayQuery> queries(this->rays.size());
+  for (size_t i = 0; i < this->rays.size(); ++i)
+    this->rays[i]->GlobalPoints(queries[i].start, queries[i].end);
 
-  self = static_cast<ODEMultiRayShape*>(_data);
+  // All the rays are cast in one batch, which locks the physics engine
+  std::vector<RayQueryResult> results;
+  ode->CastRays(queries, results);
 
-  // Check space
-  if (dGeomIsSpace(_o1) || dGeomIsSpace(_o2))
-  {
-    if (dGeomGetSpace(_o1) == self->superSpaceId ||
-        dGeomGetSpace(_o2) == self->superSpaceId)
-    {
-      dSpaceCollide2(_o1, _o2, self, &UpdateCallback);
-    }
-
-    if (dGeomGetSpace(_o1) == self->raySpaceId ||
-        dGeomGetSpace(_o2) == self->raySpaceId)
-    {
-      dSpaceCollide2(_o1, _o2, self, &UpdateCallback);
-    }
-  }
-  else
+  for (size_t i = 0; i < this->rays.size(); ++i)
   {
-    ODECollision *collision1 = nullptr;
-    ODECollision *collision2 = nullptr;
-    dGeomID rayId = 0;
-
-    // Get pointers to the underlying collisions
-    if (dGeomGetClass(_o1) == dGeomTransformClass)
-    {
-      collision1 = static_cast<ODECollision*>(
-          dGeomGetData(dGeomTransformGetGeom(_o1)));
-    }
-    else
-    {
-      collision1 = static_cast<ODECollision*>(dGeomGetData(_o1));
-    }
-
-    if (dGeomGetClass(_o2) == dGeomTransformClass)
-    {
-      collision2 =
-        static_cast<ODECollision*>(dGeomGetData(dGeomTransformGetGeom(_o2)));
-    }
-    else
-    {
-      collision2 = static_cast<ODECollision*>(dGeomGetData(_o2));
-    }
-
-    ODECollision *rayCollision = nullptr;
-    ODECollision *hitCollision = nullptr;
-
-    // Figure out which one is a ray; note that this assumes
-    // that the ODE dRayClass is used *soley* by the RayCollision.
-    if (dGeomGetClass(_o1) == dRayClass)
-    {
-      rayCollision = collision1;
-      rayId = _o1;
-      hitCollision = collision2;
-      dGeomRaySetParams(_o1, 0, 0);
-      dGeomRaySetClosestHit(_o1, 1);
-    }
-    else if (dGeomGetClass(_o2) == dRayClass)
-    {
-      GZ_ASSERT(rayCollision == nullptr, "rayCollision is not null");
-      rayCollision = collision2;
-      hitCollision = collision1;
-      rayId = _o2;
-      dGeomRaySetParams(_o2, 0, 0);
-      dGeomRaySetClosestHit(_o2, 1);
-    }
-
-    if (!self->defaultUpdate || (rayCollision && hitCollision))
+    if (results[i].Hit() && results[i].distance < this->rays[i]->GetLength())
     {
-      int n = dCollide(_o1, _o2, 1, &contact, sizeof(contact));
-
-      if (n > 0 && self->defaultUpdate)
-      {
-        RayShape *shape = self->defaultUpdate ?
-          boost::static_pointer_cast<RayShape>(rayCollision->GetShape()).get() :
-          static_cast<RayShape*>(dGeomGetData(rayId));
-
-        if (shape && hitCollision && contact.depth < shape->GetLength())
-        {
-          // gzerr << "ODEMultiRayShape UpdateCallback dSpaceCollide2 "
-          //      << " depth[" << contact.depth << "]"
-          //      << " position[" << contact.pos[0]
-          //        << ", " << contact.pos[1]
-          //        << ", " << contact.pos[2]
-          //        << ", " << "]"
-          //      << " ray[" << rayCollision->GetScopedName() << "]"
-          //      << " pose[" << rayCollision->GetWorldPose() << "]"
-          //      << " hit[" << hitCollision->GetScopedName() << "]"
-          //      << " pose[" << hitCollision->GetWorldPose() << "]"
-          //      << "\n";
-          shape->SetLength(contact.depth);
-          shape->SetRetro(hitCollision->GetLaserRetro());
-          shape->SetCollisionName(hitCollision->GetScopedName());
-        }
-      }
+      this->rays[i]->SetLength(results[i].distance);
+      this->rays[i]->SetRetro(results[i].retro);
+      this->rays[i]->SetCollisionName(results[i].collision);
     }
   }
 }
@@ -44,13 +44,6 @@ namespace gazebo
       // Documentation inherited.
       public: virtual void UpdateRays();
 
-      /// \brief Ray-intersection callback.
-      /// \param[in] _data Pointer to user data.
-      /// \param[in] _o1 First geom to check for collisions.
-      /// \param[in] _o2 Second geom to check for collisions.
-      private: static void UpdateCallback(void *_data, dGeomID _o1,
-                                          dGeomID _o2);
-
       /// \brief Add a ray to the collision.
       /// \param[in] _start Start of a ray.
       /// \param[in] _end End of a ray.
@@ -62,10 +55,6 @@ namespace gazebo
 
       /// \brief Ray space for collision detector.
       private: dSpaceID raySpaceId;
-
-      /// \brief Helper to get the correct ray shape in the UpdateCallback
-      /// function.
-      private: bool defaultUpdate = true;
     };
     /// \}
   }
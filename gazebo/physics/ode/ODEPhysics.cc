@@ -21,6 +21,7 @@
 #include <sdf/sdf.hh>
 
 #include <algorithm>
+#include <cmath>
 #include <map>
 #include <string>
 #include <utility>
@@ -30,15 +31,20 @@
 #include <ignition/math/Vector3.hh>
 #include <ignition/common/Profiler.hh>
 
+#include "gazebo/gazebo_config.h"
 #include "gazebo/util/Diagnostics.hh"
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/Console.hh"
+#include "gazebo/common/Events.hh"
 #include "gazebo/common/Exception.hh"
+#include "gazebo/common/ThreadConfig.hh"
+#include "gazebo/common/Tracer.hh"
 #include "gazebo/common/Time.hh"
 #include "gazebo/common/Timer.hh"
 
 #include "gazebo/transport/Publisher.hh"
 
+#include "gazebo/physics/AabbTree.hh"
 #include "gazebo/physics/PhysicsTypes.hh"
 #include "gazebo/physics/PhysicsFactory.hh"
 #include "gazebo/physics/World.hh"
@@ -51,6 +57,7 @@
 
 #include "gazebo/physics/ode/ODECollision.hh"
 #include "gazebo/physics/ode/ODELink.hh"
+#include "gazebo/physics/ode/ODEJoint.hh"
 #include "gazebo/physics/ode/ODEScrewJoint.hh"
 #include "gazebo/physics/ode/ODEHingeJoint.hh"
 #include "gazebo/physics/ode/ODEGearboxJoint.hh"
@@ -75,6 +82,10 @@
 
 #include "gazebo/physics/ode/ODEPhysicsPrivate.hh"
 
+#ifdef HAVE_PARALLEL_QUICKSTEP
+#include <parallel_quickstep.h>
+#endif
+
 using namespace gazebo;
 using namespace physics;
 
@@ -98,33 +109,6 @@ class ContactUpdate_TBB
 };
 */
 
-class Colliders_TBB
-{
-  public: Colliders_TBB(
-              std::vector<std::pair<ODECollision*, ODECollision*> > *_colliders,
-              ODEPhysics *_engine,
-              dContactGeom* _contactCollisions) :
-    colliders(_colliders),
-              engine(_engine), contactCollisions(_contactCollisions)
-  {
-    // dAllocateODEDataForThread(dAllocateMaskAll);
-  }
-
-  public: void operator() (const tbb::blocked_range<size_t> &_r) const
-  {
-    for (size_t i = _r.begin(); i != _r.end(); i++)
-    {
-      ODECollision *collision1 = (*this->colliders)[i].first;
-      ODECollision *collision2 = (*this->colliders)[i].second;
-      this->engine->Collide(collision1, collision2, contactCollisions);
-    }
-  }
-
-  private: std::vector< std::pair<ODECollision*, ODECollision*> > *colliders;
-  private: ODEPhysics *engine;
-  private: dContactGeom* contactCollisions;
-};
-
 //////////////////////////////////////////////////
 extern "C" void dMessageQuiet(int, const char *, va_list)
 {
@@ -144,8 +128,8 @@ ODEPhysics::ODEPhysics(WorldPtr _world)
 
   this->dataPtr->worldId = dWorldCreate();
 
-  this->dataPtr->spaceId = dHashSpaceCreate(0);
-  dHashSpaceSetLevels(this->dataPtr->spaceId, -2, 8);
+  this->dataPtr->spaceId = nullptr;
+  this->CreateSpace();
 
   this->dataPtr->contactGroup = dJointGroupCreate(0);
 
@@ -278,6 +262,7 @@ void ODEPhysics::OnRequest(ConstRequestPtr &_msg)
     physicsMsg.set_real_time_update_rate(this->realTimeUpdateRate);
     physicsMsg.set_real_time_factor(this->targetRealTimeFactor);
     physicsMsg.set_max_step_size(this->maxStepSize);
+    physicsMsg.set_model_update_threads(this->world->ModelUpdateThreads());
 
     response.set_type(physicsMsg.GetTypeName());
     physicsMsg.SerializeToString(serializedData);
@@ -348,6 +333,9 @@ void ODEPhysics::OnPhysicsMsg(ConstPhysicsPtr &_msg)
 //////////////////////////////////////////////////
 void ODEPhysics::Init()
 {
+  // The model spaces exist now, so the hash levels can be picked from
+  // their sizes.
+  this->UpdateHashLevels();
 }
 
 //////////////////////////////////////////////////
@@ -362,9 +350,11 @@ void ODEPhysics::UpdateCollision()
 {
   DIAG_TIMER_START("ODEPhysics::UpdateCollision");
   IGN_PROFILE("ODEPhysics:UpdateCollision");
+  GZ_TRACE_SCOPE("physics::ODEPhysics::UpdateCollision");
   IGN_PROFILE_BEGIN("dSpaceCollide");
 
   boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
+  this->UpdateContactCache();
   dJointGroupEmpty(this->dataPtr->contactGroup);
 
   unsigned int i = 0;
@@ -375,6 +365,14 @@ void ODEPhysics::UpdateCollision()
   // Reset the contact count
   this->contactManager->ResetCount();
 
+  // Merge the static collisions of new models
+  if (this->dataPtr->mergeStatic)
+  {
+    if (this->dataPtr->staticMergePending)
+      this->MergeStatic();
+    this->UpdateStaticTree();
+  }
+
   // Do collision detection; this will add contacts to the contact group
   dSpaceCollide(this->dataPtr->spaceId, this, CollisionCallback);
   DIAG_TIMER_LAP("ODEPhysics::UpdateCollision", "dSpaceCollide");
@@ -382,10 +380,19 @@ void ODEPhysics::UpdateCollision()
 
   IGN_PROFILE_BEGIN("collideShapes");
   // Generate non-trimesh collisions.
-  for (i = 0; i < this->dataPtr->collidersCount; ++i)
+  if (this->dataPtr->narrowPhaseArena && this->dataPtr->collidersCount > 1)
+  {
+    this->CollideParallel(this->dataPtr->colliders,
+        this->dataPtr->collidersCount);
+  }
+  else
   {
-    this->Collide(this->dataPtr->colliders[i].first,
-        this->dataPtr->colliders[i].second, this->dataPtr->contactCollisions);
+    for (i = 0; i < this->dataPtr->collidersCount; ++i)
+    {
+      this->Collide(this->dataPtr->colliders[i].first,
+          this->dataPtr->colliders[i].second,
+          this->dataPtr->contactCollisions);
+    }
   }
   DIAG_TIMER_LAP("ODEPhysics::UpdateCollision", "collideShapes");
   IGN_PROFILE_END();
@@ -393,12 +400,22 @@ void ODEPhysics::UpdateCollision()
 
   IGN_PROFILE_BEGIN("collideTrimeshes");
   // Generate trimesh collision.
-  // This must happen in this thread sequentially
-  for (i = 0; i < this->dataPtr->trimeshCollidersCount; ++i)
+  // This happens in this thread sequentially, unless each narrow phase
+  // thread is allowed to use its own OPCODE collider cache.
+  if (this->dataPtr->narrowPhaseArena && this->dataPtr->parallelTrimesh &&
+      this->dataPtr->trimeshCollidersCount > 1)
   {
-    ODECollision *collision1 = this->dataPtr->trimeshColliders[i].first;
-    ODECollision *collision2 = this->dataPtr->trimeshColliders[i].second;
-    this->Collide(collision1, collision2, this->dataPtr->contactCollisions);
+    this->CollideParallel(this->dataPtr->trimeshColliders,
+        this->dataPtr->trimeshCollidersCount);
+  }
+  else
+  {
+    for (i = 0; i < this->dataPtr->trimeshCollidersCount; ++i)
+    {
+      ODECollision *collision1 = this->dataPtr->trimeshColliders[i].first;
+      ODECollision *collision2 = this->dataPtr->trimeshColliders[i].second;
+      this->Collide(collision1, collision2, this->dataPtr->contactCollisions);
+    }
   }
   DIAG_TIMER_LAP("UpdateCollision", "collideTrimeshes");
   IGN_PROFILE_END();
@@ -411,44 +428,84 @@ void ODEPhysics::UpdatePhysics()
 {
   DIAG_TIMER_START("ODEPhysics::UpdatePhysics");
   IGN_PROFILE("ODEPhysics:UpdatePhysics");
+  GZ_TRACE_SCOPE("physics::ODEPhysics::UpdatePhysics");
 
   // need to lock, otherwise might conflict with world resetting
   {
     boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
 
     // Update the dynamical model
-    (*(this->dataPtr->physicsStepFunc))
-      (this->dataPtr->worldId, this->maxStepSize);
+    const unsigned int substeps = this->dataPtr->substeps;
+    if (substeps <= 1)
+    {
+      (*(this->dataPtr->physicsStepFunc))
+        (this->dataPtr->worldId, this->maxStepSize);
+    }
+    else
+    {
+      // The contact joints stay in the contact group until the next
+      // collision update, so every substep integrates with them.
+      const double dt = this->maxStepSize / substeps;
+      const common::Time simTime = this->world->SimTime();
+
+      common::UpdateInfo info;
+      info.worldName = this->world->Name();
+      info.realTime = this->world->RealTime();
+      for (unsigned int i = 0; i < substeps; ++i)
+      {
+        info.simTime = simTime + common::Time(i * dt);
+        event::Events::beforePhysicsSubstep(info);
 
-    ignition::math::Vector3d f1, f2, t1, t2;
+        (*(this->dataPtr->physicsStepFunc))(this->dataPtr->worldId, dt);
+      }
+    }
 
-    // Set the joint contact feedback for each contact.
+    // Stop the on demand joint feedback that is no longer read
+    const uint64_t iterations = this->world->Iterations();
+    auto &joints = this->dataPtr->feedbackJoints;
+    joints.erase(std::remove_if(joints.begin(), joints.end(),
+          [iterations](const boost::weak_ptr<ODEJoint> &_joint)
+          {
+            ODEJointPtr joint = _joint.lock();
+            return !joint || joint->ReleaseIdleFeedback(iterations);
+          }), joints.end());
+
+    // Set the joint contact feedback for each contact. Feedback only
+    // exists for contacts that the ContactManager hands out, i.e. contacts
+    // that are consumed by a sensor, a custom publisher or a subscriber.
     for (unsigned int i = 0; i < this->dataPtr->jointFeedbackIndex; ++i)
     {
-      Contact *contactFeedback = this->dataPtr->jointFeedbacks[i]->contact;
+      const ODEJointFeedback *jointFeedback = this->dataPtr->jointFeedbacks[i];
+      if (jointFeedback->count <= 0)
+        continue;
+
+      Contact *contactFeedback = jointFeedback->contact;
       Collision *col1 = contactFeedback->collision1;
       Collision *col2 = contactFeedback->collision2;
 
       GZ_ASSERT(col1 != nullptr, "Collision 1 is null");
       GZ_ASSERT(col2 != nullptr, "Collision 2 is null");
 
-      for (int j = 0; j < this->dataPtr->jointFeedbacks[i]->count; ++j)
+      // The link rotations are the same for all the contact points.
+      const ignition::math::Quaterniond rot1 =
+        col1->GetLink()->WorldPose().Rot();
+      const ignition::math::Quaterniond rot2 =
+        col2->GetLink()->WorldPose().Rot();
+
+      for (int j = 0; j < jointFeedback->count; ++j)
       {
-        dJointFeedback fb = this->dataPtr->jointFeedbacks[i]->feedbacks[j];
-        f1.Set(fb.f1[0], fb.f1[1], fb.f1[2]);
-        f2.Set(fb.f2[0], fb.f2[1], fb.f2[2]);
-        t1.Set(fb.t1[0], fb.t1[1], fb.t1[2]);
-        t2.Set(fb.t2[0], fb.t2[1], fb.t2[2]);
+        const dJointFeedback &fb = jointFeedback->feedbacks[j];
+        JointWrench &wrench = contactFeedback->wrench[j];
 
         // set force torque in link frame
-        this->dataPtr->jointFeedbacks[i]->contact->wrench[j].body1Force =
-             col1->GetLink()->WorldPose().Rot().RotateVectorReverse(f1);
-        this->dataPtr->jointFeedbacks[i]->contact->wrench[j].body2Force =
-             col2->GetLink()->WorldPose().Rot().RotateVectorReverse(f2);
-        this->dataPtr->jointFeedbacks[i]->contact->wrench[j].body1Torque =
-             col1->GetLink()->WorldPose().Rot().RotateVectorReverse(t1);
-        this->dataPtr->jointFeedbacks[i]->contact->wrench[j].body2Torque =
-             col2->GetLink()->WorldPose().Rot().RotateVectorReverse(t2);
+        wrench.body1Force = rot1.RotateVectorReverse(
+            ignition::math::Vector3d(fb.f1[0], fb.f1[1], fb.f1[2]));
+        wrench.body2Force = rot2.RotateVectorReverse(
+            ignition::math::Vector3d(fb.f2[0], fb.f2[1], fb.f2[2]));
+        wrench.body1Torque = rot1.RotateVectorReverse(
+            ignition::math::Vector3d(fb.t1[0], fb.t1[1], fb.t1[2]));
+        wrench.body2Torque = rot2.RotateVectorReverse(
+            ignition::math::Vector3d(fb.t2[0], fb.t2[1], fb.t2[2]));
       }
     }
   }
@@ -464,6 +521,9 @@ void ODEPhysics::Fini()
   if (this->dataPtr->contactGroup)
     dJointGroupDestroy(this->dataPtr->contactGroup);
   this->dataPtr->contactGroup = nullptr;
+  this->dataPtr->contactJoints.clear();
+  this->dataPtr->contactCache.clear();
+  this->dataPtr->snapshots.clear();
 
   // Delete all the joint feedbacks.
   for (auto iter = this->dataPtr->jointFeedbacks.begin();
@@ -494,6 +554,124 @@ void ODEPhysics::Reset()
   boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
   // Very important to clear out the contact group
   dJointGroupEmpty(this->dataPtr->contactGroup);
+  this->dataPtr->contactJoints.clear();
+  this->dataPtr->contactCache.clear();
+  this->dataPtr->contactCacheRestored = false;
+}
+
+//////////////////////////////////////////////////
+void ODEPhysics::SaveSnapshot(const uint32_t _handle)
+{
+  boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
+
+  ODESnapshot &snapshot = this->dataPtr->snapshots[_handle];
+  snapshot.bodies.clear();
+
+  Model_V models = this->world->Models();
+  for (size_t i = 0; i < models.size(); ++i)
+  {
+    ModelPtr model = models[i];
+    for (auto const &link : model->GetLinks())
+    {
+      ODELinkPtr odeLink = boost::dynamic_pointer_cast<ODELink>(link);
+      dBodyID body = odeLink ? odeLink->GetODEId() : nullptr;
+      if (!body)
+        continue;
+
+      ODEBodySnapshot bodySnapshot;
+      bodySnapshot.link = odeLink;
+      for (int j = 0; j < 3; ++j)
+      {
+        bodySnapshot.pos[j] = dBodyGetPosition(body)[j];
+        bodySnapshot.linearVel[j] = dBodyGetLinearVel(body)[j];
+        bodySnapshot.angularVel[j] = dBodyGetAngularVel(body)[j];
+        bodySnapshot.force[j] = dBodyGetForce(body)[j];
+        bodySnapshot.torque[j] = dBodyGetTorque(body)[j];
+      }
+      for (int j = 0; j < 4; ++j)
+        bodySnapshot.quat[j] = dBodyGetQuaternion(body)[j];
+      bodySnapshot.enabled = dBodyIsEnabled(body);
+      snapshot.bodies.push_back(bodySnapshot);
+    }
+    models.insert(models.end(), model->NestedModels().begin(),
+        model->NestedModels().end());
+  }
+
+  // The contact joints of the last step are what the next step warm
+  // starts from. Their joints are destroyed by the next step, so only
+  // the multipliers are kept.
+  snapshot.contactCache.clear();
+  if (this->dataPtr->contactWarmStart)
+  {
+    if (this->dataPtr->contactCacheRestored)
+    {
+      snapshot.contactCache = this->dataPtr->contactCache;
+    }
+    else
+    {
+      snapshot.contactCache = this->dataPtr->contactJoints;
+      for (auto &pair : snapshot.contactCache)
+      {
+        for (auto &contact : pair.second)
+        {
+          dJointGetLambda(contact.joint, contact.lambda, contact.lambdaErp);
+          contact.joint = nullptr;
+        }
+      }
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+bool ODEPhysics::RestoreSnapshot(const uint32_t _handle)
+{
+  boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
+
+  auto iter = this->dataPtr->snapshots.find(_handle);
+  if (iter == this->dataPtr->snapshots.end())
+    return false;
+  const ODESnapshot &snapshot = iter->second;
+
+  // Write the bodies directly, so that the restored state is bit exact
+  // and does not depend on how the links convert their poses.
+  for (auto const &bodySnapshot : snapshot.bodies)
+  {
+    ODELinkPtr odeLink = bodySnapshot.link.lock();
+    dBodyID body = odeLink ? odeLink->GetODEId() : nullptr;
+    if (!body)
+      continue;
+
+    dBodySetPosition(body, bodySnapshot.pos[0], bodySnapshot.pos[1],
+        bodySnapshot.pos[2]);
+    dBodySetQuaternion(body, bodySnapshot.quat);
+    dBodySetLinearVel(body, bodySnapshot.linearVel[0],
+        bodySnapshot.linearVel[1], bodySnapshot.linearVel[2]);
+    dBodySetAngularVel(body, bodySnapshot.angularVel[0],
+        bodySnapshot.angularVel[1], bodySnapshot.angularVel[2]);
+    dBodySetForce(body, bodySnapshot.force[0], bodySnapshot.force[1],
+        bodySnapshot.force[2]);
+    dBodySetTorque(body, bodySnapshot.torque[0], bodySnapshot.torque[1],
+        bodySnapshot.torque[2]);
+    if (bodySnapshot.enabled)
+      dBodyEnable(body);
+    else
+      dBodyDisable(body);
+  }
+
+  if (this->dataPtr->contactWarmStart)
+  {
+    this->dataPtr->contactCache = snapshot.contactCache;
+    this->dataPtr->contactCacheRestored = true;
+  }
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+void ODEPhysics::ReleaseSnapshot(const uint32_t _handle)
+{
+  boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
+  this->dataPtr->snapshots.erase(_handle);
 }
 
 //////////////////////////////////////////////////
@@ -513,6 +691,7 @@ LinkPtr ODEPhysics::CreateLink(ModelPtr _parent)
 
   link->SetSpaceId(this->dataPtr->spaces[_parent->GetName()]);
   link->SetWorld(_parent->GetWorld());
+  this->dataPtr->staticMergePending = true;
 
   return link;
 }
@@ -931,11 +1110,27 @@ void ODEPhysics::SetStepType(const std::string &_type)
     this->dataPtr->physicsStepFunc = &dWorldQuickStep;
   else if (this->dataPtr->stepType == "world")
     this->dataPtr->physicsStepFunc = &dWorldStep;
+  else if (this->dataPtr->stepType == "parallel_quick")
+  {
+#ifdef HAVE_PARALLEL_QUICKSTEP
+    this->dataPtr->physicsStepFunc = &dWorldParallelQuickStep;
+#else
+    gzerr << "Step type[parallel_quick] requires gazebo built with "
+          << "ENABLE_PARALLEL_QUICKSTEP, using quick instead" << std::endl;
+    this->dataPtr->physicsStepFunc = &dWorldQuickStep;
+#endif
+  }
   else
     gzerr << "Invalid step type[" << this->dataPtr->stepType
           << "]" << std::endl;
 }
 
+//////////////////////////////////////////////////
+void ODEPhysics::AddFeedbackOnDemand(ODEJointPtr _joint)
+{
+  this->dataPtr->feedbackJoints.push_back(_joint);
+}
+
 //////////////////////////////////////////////////
 void ODEPhysics::SetGravity(const ignition::math::Vector3d &_gravity)
 {
@@ -948,18 +1143,69 @@ void ODEPhysics::SetGravity(const ignition::math::Vector3d &_gravity)
 void ODEPhysics::CollisionCallback(void *_data, dGeomID _o1, dGeomID _o2)
 {
   IGN_PROFILE("ODEPhysics::CollisionCallback");
-  dBodyID b1 = dGeomGetBody(_o1);
-  dBodyID b2 = dGeomGetBody(_o2);
+
+  // Get a pointer to the physics engine
+  ODEPhysics *self = static_cast<ODEPhysics*>(_data);
+
+  // The merged static collisions are found with their tree
+  const dGeomID staticSpace = (dGeomID)self->dataPtr->staticSpaceId;
+  if (staticSpace && (_o1 == staticSpace || _o2 == staticSpace))
+  {
+    self->CollideStatic(_o1 == staticSpace ? _o2 : _o1);
+    return;
+  }
+
+  // The space of a compound collision stands for a single collision, it is
+  // marked by its data.
+  ODECollision *compound1 = dGeomIsSpace(_o1) ?
+    static_cast<ODECollision*>(dGeomGetData(_o1)) : nullptr;
+  ODECollision *compound2 = dGeomIsSpace(_o2) ?
+    static_cast<ODECollision*>(dGeomGetData(_o2)) : nullptr;
+
+  dBodyID b1 = dGeomGetBody(compound1 ? compound1->GetCollisionId() : _o1);
+  dBodyID b2 = dGeomGetBody(compound2 ? compound2->GetCollisionId() : _o2);
 
   // exit without doing anything if the two bodies are connected by a joint
   if (b1 && b2 && dAreConnectedExcluding(b1, b2, dJointTypeContact))
     return;
 
-  // Get a pointer to the physics engine
-  ODEPhysics *self = static_cast<ODEPhysics*>(_data);
+  const bool space1 = dGeomIsSpace(_o1) && !compound1;
+  const bool space2 = dGeomIsSpace(_o2) && !compound2;
 
   // Check if either are spaces
-  if (dGeomIsSpace(_o1) || dGeomIsSpace(_o2))
+  if ((space1 && compound2) || (compound1 && space2))
+  {
+    // Don't descend into the compound, collide it with each object of the
+    // other space instead
+    dGeomID compound = space1 ? _o2 : _o1;
+    dSpaceID space = reinterpret_cast<dSpaceID>(space1 ? _o1 : _o2);
+
+    dReal aabb[6];
+    dGeomGetAABB(compound, aabb);
+    const auto category = dGeomGetCategoryBits(compound);
+    const auto collide = dGeomGetCollideBits(compound);
+    for (int i = 0; i < dSpaceGetNumGeoms(space); ++i)
+    {
+      dGeomID geom = dSpaceGetGeom(space, i);
+
+      // Same bitmask test as the broadphase of the spaces
+      if (!(category & dGeomGetCollideBits(geom)) &&
+          !(dGeomGetCategoryBits(geom) & collide))
+      {
+        continue;
+      }
+
+      dReal other[6];
+      dGeomGetAABB(geom, other);
+      if (aabb[0] <= other[1] && other[0] <= aabb[1] &&
+          aabb[2] <= other[3] && other[2] <= aabb[3] &&
+          aabb[4] <= other[5] && other[4] <= aabb[5])
+      {
+        CollisionCallback(_data, geom, compound);
+      }
+    }
+  }
+  else if (space1 || space2)
   {
     dSpaceCollide2(_o1, _o2, self, &CollisionCallback);
   }
@@ -969,26 +1215,32 @@ void ODEPhysics::CollisionCallback(void *_data, dGeomID _o1, dGeomID _o2)
     ODECollision *collision2 = nullptr;
 
     // Get pointers to the underlying collisions
-    if (dGeomGetClass(_o1) == dGeomTransformClass)
+    if (compound1)
+      collision1 = compound1;
+    else if (dGeomGetClass(_o1) == dGeomTransformClass)
       collision1 =
         static_cast<ODECollision*>(dGeomGetData(dGeomTransformGetGeom(_o1)));
     else
       collision1 = static_cast<ODECollision*>(dGeomGetData(_o1));
 
-    if (dGeomGetClass(_o2) == dGeomTransformClass)
+    if (compound2)
+      collision2 = compound2;
+    else if (dGeomGetClass(_o2) == dGeomTransformClass)
       collision2 =
         static_cast<ODECollision*>(dGeomGetData(dGeomTransformGetGeom(_o2)));
     else
       collision2 = static_cast<ODECollision*>(dGeomGetData(_o2));
 
-    // Exit if both bodies are not enabled
+    // Exit if both bodies are not enabled, or if neither body responds to
+    // contacts, i.e. both are kinematic or static
     if (dGeomGetCategoryBits(_o1) != GZ_SENSOR_COLLIDE &&
         dGeomGetCategoryBits(_o2) != GZ_SENSOR_COLLIDE &&
         !self->contactManager->NeverDropContacts() &&
         !self->contactManager->SubscribersConnected(collision1, collision2) &&
         ((b1 && b2 && !dBodyIsEnabled(b1) && !dBodyIsEnabled(b2)) ||
         (!b2 && b1 && !dBodyIsEnabled(b1)) ||
-        (!b1 && b2 && !dBodyIsEnabled(b2))))
+        (!b1 && b2 && !dBodyIsEnabled(b2)) ||
+        ((!b1 || dBodyIsKinematic(b1)) && (!b2 || dBodyIsKinematic(b2)))))
     {
       return;
     }
@@ -996,9 +1248,12 @@ void ODEPhysics::CollisionCallback(void *_data, dGeomID _o1, dGeomID _o2)
     // Make sure both collision pointers are valid.
     if (collision1 && collision2)
     {
-      // Add either a tri-mesh collider or a regular collider.
-      if (collision1->HasType(Base::MESH_SHAPE) ||
-          collision2->HasType(Base::MESH_SHAPE))
+      // Add either a tri-mesh collider or a regular collider. The convex
+      // parts of a decomposed mesh use the regular colliders.
+      if ((collision1->HasType(Base::MESH_SHAPE) &&
+           collision1->CompoundIds().empty()) ||
+          (collision2->HasType(Base::MESH_SHAPE) &&
+           collision2->CompoundIds().empty()))
         self->AddTrimeshCollider(collision1, collision2);
       else
       {
@@ -1012,11 +1267,26 @@ void ODEPhysics::CollisionCallback(void *_data, dGeomID _o1, dGeomID _o2)
 //////////////////////////////////////////////////
 void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
                          dContactGeom *_contactCollisions)
+{
+  unsigned int numc = this->GenerateContacts(_collision1, _collision2,
+      _contactCollisions);
+
+  // Return if no contacts.
+  if (numc == 0)
+    return;
+
+  this->CreateContactJoints(_collision1, _collision2, _contactCollisions,
+      numc);
+}
+
+//////////////////////////////////////////////////
+unsigned int ODEPhysics::GenerateContacts(ODECollision *_collision1,
+    ODECollision *_collision2, dContactGeom *_contactCollisions)
 {
   // Filter collisions based on collide bitmask.
   if ((_collision1->GetSurface()->collideBitmask &
         _collision2->GetSurface()->collideBitmask) == 0)
-    return;
+    return 0;
 
   // Filter collisions based on contact bitmask if collide_without_contact is
   // on.The bitmask is set mainly for speed improvements otherwise a collision
@@ -1028,26 +1298,13 @@ void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
     if ((_collision1->GetSurface()->collideWithoutContactBitmask &
          _collision2->GetSurface()->collideWithoutContactBitmask) == 0)
     {
-      return;
+      return 0;
     }
   }
 
-  /*
-  if (_collision1->GetCollisionId() && _collision2->GetCollisionId())
-  {
-    const dVector3 *pos1 =
-      (const dVector3*)dGeomGetPosition(_collision1->GetCollisionId());
-    const dVector3 *pos2 =
-      (const dVector3*)dGeomGetPosition(_collision2->GetCollisionId());
-    std::cout << "1[" << (*pos1)[0]<< " " << (*pos1)[1] << " "
-              << (*pos1)[2] << "] "
-      << "2[" << (*pos2)[0]<< " " << (*pos2)[1] << " " << (*pos2)[2] << "]\n";
-  }*/
-
   unsigned int numc = 0;
-  dContact contact;
 
-  // maxCollide must less than the size of this->dataPtr->indices
+  // maxCollide must less than MAX_CONTACT_JOINTS
   // Check the header
   unsigned int maxCollide = MAX_CONTACT_JOINTS;
 
@@ -1063,34 +1320,90 @@ void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
     maxCollide = _collision2->GetMaxContacts();
 
   // Generate the contacts
-  numc = dCollide(_collision1->GetCollisionId(), _collision2->GetCollisionId(),
-      MAX_COLLIDE_RETURNS, _contactCollisions, sizeof(_contactCollisions[0]));
-
-  // Return if no contacts.
-  if (numc == 0)
-    return;
-
-  // Store the indices of the contacts.
-  for (int i = 0; i < MAX_CONTACT_JOINTS; i++)
-    this->dataPtr->indices[i] = i;
+  const std::vector<dGeomID> &parts1 = _collision1->CompoundIds();
+  const std::vector<dGeomID> &parts2 = _collision2->CompoundIds();
+  if (parts1.empty() && parts2.empty())
+  {
+    numc = dCollide(_collision1->GetCollisionId(),
+        _collision2->GetCollisionId(), MAX_COLLIDE_RETURNS,
+        _contactCollisions, sizeof(_contactCollisions[0]));
+  }
+  else
+  {
+    // Collide the parts of compounds pairwise
+    const dGeomID id1 = _collision1->GetCollisionId();
+    const dGeomID id2 = _collision2->GetCollisionId();
+    const dGeomID *geoms1 = parts1.empty() ? &id1 : parts1.data();
+    const dGeomID *geoms2 = parts2.empty() ? &id2 : parts2.data();
+    const size_t count1 = parts1.empty() ? 1u : parts1.size();
+    const size_t count2 = parts2.empty() ? 1u : parts2.size();
+
+    for (size_t i = 0; i < count1 && numc < MAX_COLLIDE_RETURNS; ++i)
+    {
+      dReal aabb1[6];
+      dGeomGetAABB(geoms1[i], aabb1);
+      for (size_t j = 0; j < count2 && numc < MAX_COLLIDE_RETURNS; ++j)
+      {
+        dReal aabb2[6];
+        dGeomGetAABB(geoms2[j], aabb2);
+        if (aabb1[0] > aabb2[1] || aabb2[0] > aabb1[1] ||
+            aabb1[2] > aabb2[3] || aabb2[2] > aabb1[3] ||
+            aabb1[4] > aabb2[5] || aabb2[4] > aabb1[5])
+        {
+          continue;
+        }
+
+        numc += dCollide(geoms1[i], geoms2[j], MAX_COLLIDE_RETURNS - numc,
+            _contactCollisions + numc, sizeof(_contactCollisions[0]));
+      }
+    }
+  }
 
-  // Choose only the best contacts if too many were generated.
+  // Choose only the best contacts if too many were generated. The deepest
+  // of the extra contacts replaces the last selected contact.
   if (maxCollide > 0 && numc > maxCollide)
   {
+    unsigned int deepest = maxCollide-1;
     double max = _contactCollisions[maxCollide-1].depth;
     for (unsigned int i = maxCollide; i < numc; ++i)
     {
       if (_contactCollisions[i].depth > max)
       {
         max = _contactCollisions[i].depth;
-        this->dataPtr->indices[maxCollide-1] = i;
+        deepest = i;
       }
     }
+    _contactCollisions[maxCollide-1] = _contactCollisions[deepest];
 
     // Make sure numc has the valid number of contacts.
     numc = maxCollide;
   }
 
+  return numc;
+}
+
+//////////////////////////////////////////////////
+/// \brief Get the number of constraint rows of a contact joint, as counted
+/// by dxJointContact::getInfo1.
+/// \param[in] _contact The contact.
+/// \return Number of rows.
+static unsigned int ContactRows(const dContact &_contact)
+{
+  unsigned int rows = 1;
+  if ((_contact.surface.mode & dContactMu2) || _contact.surface.mu > 0)
+    rows += 2;
+  if (_contact.surface.mode & dContactMu3)
+    ++rows;
+  return rows;
+}
+
+//////////////////////////////////////////////////
+void ODEPhysics::CreateContactJoints(ODECollision *_collision1,
+    ODECollision *_collision2, const dContactGeom *_contactCollisions,
+    const unsigned int _count)
+{
+  dContact contact;
+
   // Set the contact surface parameter flags.
   contact.surface.mode = dContactBounce |
                          dContactMu2 |
@@ -1178,12 +1491,12 @@ void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
   contact.surface.slip3 = surf1->slipTorsion + surf2->slipTorsion;
   // The slip parameter acts like a damper at each contact point
   // so the total damping for each collision is multiplied by the
-  // number of contact points (numc).
-  // To eliminate this dependence on numc, the inverse damping
-  // is multipled by numc.
-  contact.surface.slip1 *= numc;
-  contact.surface.slip2 *= numc;
-  contact.surface.slip3 *= numc;
+  // number of contact points (_count).
+  // To eliminate this dependence on _count, the inverse damping
+  // is multipled by _count.
+  contact.surface.slip1 *= _count;
+  contact.surface.slip2 *= _count;
+  contact.surface.slip3 *= _count;
 
   // Combine torsional friction patch radius values
   contact.surface.patch_radius =
@@ -1285,36 +1598,79 @@ void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
     this->dataPtr->jointFeedbackIndex++;
     jointFeedback->count = 0;
     jointFeedback->contact = contactFeedback;
+    if (jointFeedback->feedbacks.size() < _count)
+      jointFeedback->feedbacks.resize(_count);
+    contactFeedback->SetCapacity(_count);
+  }
+
+  // Let the contact surface functions of the two collisions adjust a copy
+  // of the contacts.
+  dContact *surfaceContacts = nullptr;
+  auto &callbacks = this->dataPtr->contactSurfaceCallbacks;
+  if (!callbacks.empty())
+  {
+    auto callback1 = callbacks.find(_collision1);
+    auto callback2 = callbacks.find(_collision2);
+    if (callback1 != callbacks.end() || callback2 != callbacks.end())
+    {
+      auto &buffer = this->dataPtr->surfaceContacts;
+      if (buffer.size() < _count)
+        buffer.resize(_count);
+      surfaceContacts = buffer.data();
+
+      for (unsigned int j = 0; j < _count; ++j)
+      {
+        surfaceContacts[j] = contact;
+        surfaceContacts[j].geom = _contactCollisions[j];
+      }
+
+      if (callback1 != callbacks.end())
+        callback1->second(_collision1, _collision2, surfaceContacts, _count);
+      if (callback2 != callbacks.end())
+        callback2->second(_collision2, _collision1, surfaceContacts, _count);
+    }
   }
 
+  const bool attach = !_collision1->GetSurface()->collideWithoutContact &&
+    !_collision2->GetSurface()->collideWithoutContact;
+  unsigned int rows = 0;
+
   // Create a joint for each contact
-  for (unsigned int j = 0; j < numc; ++j)
+  for (unsigned int j = 0; j < _count; ++j)
   {
-    contact.geom = _contactCollisions[this->dataPtr->indices[j]];
+    if (!surfaceContacts)
+      contact.geom = _contactCollisions[j];
+    if (attach)
+      rows += ContactRows(surfaceContacts ? surfaceContacts[j] : contact);
 
     // Create the contact joint. This introduces the contact constraint to
     // ODE
     dJointID contactJoint = dJointCreateContact(this->dataPtr->worldId,
-      this->dataPtr->contactGroup, &contact);
+      this->dataPtr->contactGroup,
+      surfaceContacts ? &surfaceContacts[j] : &contact);
+
+    if (this->dataPtr->contactWarmStart)
+      this->WarmStartContact(_collision1, _collision2, contactJoint,
+          _contactCollisions[j]);
 
     // Store contact information.
     if (contactFeedback && jointFeedback)
     {
       // Store the contact depth
       contactFeedback->depths[j] =
-        _contactCollisions[this->dataPtr->indices[j]].depth;
+        _contactCollisions[j].depth;
 
       // Store the contact position
       contactFeedback->positions[j].Set(
-          _contactCollisions[this->dataPtr->indices[j]].pos[0],
-          _contactCollisions[this->dataPtr->indices[j]].pos[1],
-          _contactCollisions[this->dataPtr->indices[j]].pos[2]);
+          _contactCollisions[j].pos[0],
+          _contactCollisions[j].pos[1],
+          _contactCollisions[j].pos[2]);
 
       // Store the contact normal
       contactFeedback->normals[j].Set(
-          _contactCollisions[this->dataPtr->indices[j]].normal[0],
-          _contactCollisions[this->dataPtr->indices[j]].normal[1],
-          _contactCollisions[this->dataPtr->indices[j]].normal[2]);
+          _contactCollisions[j].normal[0],
+          _contactCollisions[j].normal[1],
+          _contactCollisions[j].normal[2]);
 
       // Set the joint feedback.
       dJointSetFeedback(contactJoint, &(jointFeedback->feedbacks[j]));
@@ -1325,10 +1681,742 @@ void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
     }
 
     // Attach the contact joint if collideWithoutContact flags aren't set.
-    if (!_collision1->GetSurface()->collideWithoutContact &&
-        !_collision2->GetSurface()->collideWithoutContact)
+    if (attach)
       dJointAttach(contactJoint, b1, b2);
   }
+
+  // Charge the contacts to the models of the collisions, for the cost
+  // breakdown of the world statistics.
+  ModelPtr model1 = _collision1->GetModel();
+  ModelPtr model2 = _collision2->GetModel();
+  if (model1)
+    model1->AddContacts(_count, rows);
+  if (model2 && model2 != model1)
+    model2->AddContacts(_count, rows);
+}
+
+/////////////////////////////////////////////////
+void ODEPhysics::SetContactSurfaceCallback(ODECollision *_collision,
+    const ContactSurfaceCallback &_callback)
+{
+  if (_callback)
+    this->dataPtr->contactSurfaceCallbacks[_collision] = _callback;
+  else
+    this->dataPtr->contactSurfaceCallbacks.erase(_collision);
+}
+
+/////////////////////////////////////////////////
+/// \brief Check if dCollide may be called for a geom from several threads.
+/// Heightfields keep temporary buffers in the geom, and triangle meshes
+/// (e.g. polylines) use the OPCODE collider cache of the calling thread,
+/// which only exists in threads that allocated their ODE data.
+/// \param[in] _collision Collision to check.
+/// \param[in] _trimesh True if triangle meshes may run concurrently.
+/// \return True if the narrow phase for the collision must run serially.
+static bool SerialNarrowPhase(ODECollision *_collision, const bool _trimesh)
+{
+  int geomClass = dGeomGetClass(_collision->GetCollisionId());
+  return (!_trimesh && geomClass == dTriMeshClass) ||
+    geomClass == dHeightfieldClass;
+}
+
+/////////////////////////////////////////////////
+void ODEPhysics::CollideParallel(
+    const std::vector<std::pair<ODECollision *, ODECollision *> > &_colliders,
+    const unsigned int _count)
+{
+  const bool trimesh = this->dataPtr->parallelTrimesh;
+
+  for (auto &buffer : this->dataPtr->narrowPhaseBuffers)
+  {
+    buffer.colliders.clear();
+    buffer.contacts.clear();
+  }
+
+  // Generate the contacts of the colliders that can run concurrently.
+  this->dataPtr->narrowPhaseArena->execute([&]()
+  {
+    tbb::parallel_for(tbb::blocked_range<unsigned int>(0, _count),
+        [&](const tbb::blocked_range<unsigned int> &_r)
+    {
+      // Give this thread its own collider caches. This does nothing if
+      // they were allocated before.
+      if (trimesh)
+        dAllocateODEDataForThread(dAllocateMaskAll);
+
+      ODENarrowPhaseBuffer &buffer = this->dataPtr->narrowPhaseBuffers.local();
+      for (unsigned int i = _r.begin(); i != _r.end(); ++i)
+      {
+        ODECollision *collision1 = _colliders[i].first;
+        ODECollision *collision2 = _colliders[i].second;
+        if (SerialNarrowPhase(collision1, trimesh) ||
+            SerialNarrowPhase(collision2, trimesh))
+        {
+          continue;
+        }
+
+        unsigned int numc = this->GenerateContacts(collision1, collision2,
+            buffer.scratch);
+        if (numc == 0)
+          continue;
+
+        ODEColliderContacts contacts;
+        contacts.colliderIndex = i;
+        contacts.offset = buffer.contacts.size();
+        contacts.count = numc;
+        buffer.colliders.push_back(contacts);
+        buffer.contacts.insert(buffer.contacts.end(), buffer.scratch,
+            buffer.scratch + numc);
+      }
+    });
+  });
+
+  // Merge the per thread contacts in collider order.
+  this->dataPtr->narrowPhaseContacts.clear();
+  for (auto const &buffer : this->dataPtr->narrowPhaseBuffers)
+  {
+    for (auto const &contacts : buffer.colliders)
+    {
+      this->dataPtr->narrowPhaseContacts.push_back(
+          std::make_pair(&contacts, buffer.contacts.data()));
+    }
+  }
+  std::sort(this->dataPtr->narrowPhaseContacts.begin(),
+      this->dataPtr->narrowPhaseContacts.end(),
+      [](const std::pair<const ODEColliderContacts *,
+             const dContactGeom *> &_a,
+         const std::pair<const ODEColliderContacts *,
+             const dContactGeom *> &_b)
+      {
+        return _a.first->colliderIndex < _b.first->colliderIndex;
+      });
+
+  // Create the contact joints in the same order as the serial narrow phase.
+  // Colliders that can't run concurrently are collided here.
+  auto merged = this->dataPtr->narrowPhaseContacts.begin();
+  for (unsigned int i = 0; i < _count; ++i)
+  {
+    ODECollision *collision1 = _colliders[i].first;
+    ODECollision *collision2 = _colliders[i].second;
+
+    if (SerialNarrowPhase(collision1, trimesh) ||
+        SerialNarrowPhase(collision2, trimesh))
+    {
+      this->Collide(collision1, collision2, this->dataPtr->contactCollisions);
+    }
+    else if (merged != this->dataPtr->narrowPhaseContacts.end() &&
+             merged->first->colliderIndex == i)
+    {
+      this->CreateContactJoints(collision1, collision2,
+          merged->second + merged->first->offset, merged->first->count);
+      ++merged;
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the geom that holds the collision data of a geom.
+/// \param[in] _geom A geom, possibly a transform.
+/// \return The transformed geom of a transform, or _geom.
+static dGeomID RayTarget(dGeomID _geom)
+{
+  if (dGeomGetClass(_geom) == dGeomTransformClass)
+    return dGeomTransformGetGeom(_geom);
+  return _geom;
+}
+
+/////////////////////////////////////////////////
+/// \brief Collect the geoms of a space that a sensor ray may hit, with
+/// their bounding boxes. Geoms that can't be collided from several threads
+/// are collected separately.
+/// \param[in] _spaceId Space to collect.
+/// \param[in] _trimesh True if triangle meshes may run concurrently.
+/// \param[out] _geoms Parallel and serial geoms.
+/// \param[out] _boxes Bounding boxes of the geoms.
+static void CollectRayTargets(dSpaceID _spaceId, const bool _trimesh,
+    std::vector<dGeomID> *_geoms,
+    std::vector<ignition::math::AxisAlignedBox> *_boxes)
+{
+  const int count = dSpaceGetNumGeoms(_spaceId);
+  for (int i = 0; i < count; ++i)
+  {
+    dGeomID geom = dSpaceGetGeom(_spaceId, i);
+    if (!dGeomIsEnabled(geom))
+      continue;
+
+    // Same test as the broad phase, against the bits of a sensor ray
+    if (!((dGeomGetCategoryBits(geom) & ~GZ_SENSOR_COLLIDE) ||
+          (dGeomGetCollideBits(geom) & GZ_SENSOR_COLLIDE)))
+    {
+      continue;
+    }
+
+    if (dGeomIsSpace(geom))
+    {
+      CollectRayTargets((dSpaceID)geom, _trimesh, _geoms, _boxes);
+      continue;
+    }
+
+    dGeomID target = RayTarget(geom);
+    if (!target || dGeomGetClass(target) == dRayClass ||
+        !dGeomGetData(target))
+    {
+      continue;
+    }
+
+    const int geomClass = dGeomGetClass(target);
+    const int serial = ((!_trimesh && geomClass == dTriMeshClass) ||
+        geomClass == dHeightfieldClass) ? 1 : 0;
+
+    dReal aabb[6];
+    dGeomGetAABB(geom, aabb);
+    _geoms[serial].push_back(geom);
+    _boxes[serial].push_back(ignition::math::AxisAlignedBox(
+          ignition::math::Vector3d(aabb[0], aabb[2], aabb[4]),
+          ignition::math::Vector3d(aabb[1], aabb[3], aabb[5])));
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Find the closest hit of a ray in a tree of geoms.
+/// \param[in] _tree Tree of the bounding boxes of the geoms.
+/// \param[in] _geoms Geoms of the tree.
+/// \param[in] _rayId Ray geom to collide with.
+/// \param[in] _query The ray.
+/// \param[in,out] _result Closest hit so far, updated on a closer hit.
+/// \param[in,out] _hit Geom of the closest hit so far.
+static void CastRay(const AabbTree &_tree, const std::vector<dGeomID> &_geoms,
+    dGeomID _rayId, const RayQuery &_query, RayQueryResult &_result,
+    dGeomID &_hit)
+{
+  ignition::math::Vector3d dir = _query.end - _query.start;
+  const double length = std::min(dir.Length(), _result.distance);
+  if (length <= 0.0)
+    return;
+  dir.Normalize();
+
+  dGeomRaySet(_rayId, _query.start.X(), _query.start.Y(), _query.start.Z(),
+      dir.X(), dir.Y(), dir.Z());
+
+  _tree.Raycast(_query.start, dir, length,
+      [&](const size_t _index, const double _length)
+      {
+        dContactGeom contact;
+        dGeomRaySetLength(_rayId, _length);
+        if (dCollide(_rayId, _geoms[_index], 1, &contact,
+              sizeof(contact)) > 0 && contact.depth < _length)
+        {
+          _result.distance = contact.depth;
+          _hit = _geoms[_index];
+          return static_cast<double>(contact.depth);
+        }
+        return _length;
+      });
+}
+
+/////////////////////////////////////////////////
+void ODEPhysics::CastRays(const std::vector<RayQuery> &_rays,
+    std::vector<RayQueryResult> &_results)
+{
+  _results.assign(_rays.size(), RayQueryResult());
+  if (_rays.empty())
+    return;
+
+  boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
+
+  const bool trimesh = this->dataPtr->parallelTrimesh;
+
+  // Update the bounds of the geoms that moved since the last collision
+  // pass, then build a tree of the geoms that can be collided concurrently
+  // and a tree of the others.
+  dSpaceClean(this->dataPtr->spaceId);
+  std::vector<dGeomID> geoms[2];
+  std::vector<ignition::math::AxisAlignedBox> boxes[2];
+  CollectRayTargets(this->dataPtr->spaceId, trimesh, geoms, boxes);
+
+  AabbTree trees[2];
+  trees[0].Build(boxes[0]);
+  trees[1].Build(boxes[1]);
+
+  // One ray geom per chunk of rays, created here since geoms shouldn't be
+  // created concurrently.
+  const size_t threads = this->dataPtr->narrowPhaseArena ?
+    this->dataPtr->narrowPhaseThreads : 1;
+  const size_t grain = std::max<size_t>(1, _rays.size() / (threads * 4));
+  const size_t chunks = (_rays.size() + grain - 1) / grain;
+
+  std::vector<dGeomID> rayIds(threads > 1 ? chunks : 1);
+  for (auto &rayId : rayIds)
+  {
+    rayId = dCreateRay(0, 1.0);
+    dGeomRaySetParams(rayId, 0, 0);
+    dGeomRaySetClosestHit(rayId, 1);
+  }
+
+  std::vector<dGeomID> hits(_rays.size(), nullptr);
+
+  if (!geoms[0].empty())
+  {
+    if (threads > 1 && chunks > 1)
+    {
+      this->dataPtr->narrowPhaseArena->execute([&]()
+      {
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, chunks),
+            [&](const tbb::blocked_range<size_t> &_r)
+        {
+          // Give this thread its own collider caches. This does nothing
+          // if they were allocated before.
+          if (trimesh)
+            dAllocateODEDataForThread(dAllocateMaskAll);
+
+          for (size_t c = _r.begin(); c != _r.end(); ++c)
+          {
+            const size_t end = std::min(_rays.size(), (c + 1) * grain);
+            for (size_t i = c * grain; i < end; ++i)
+            {
+              CastRay(trees[0], geoms[0], rayIds[c], _rays[i],
+                  _results[i], hits[i]);
+            }
+          }
+        });
+      });
+    }
+    else
+    {
+      for (size_t i = 0; i < _rays.size(); ++i)
+        CastRay(trees[0], geoms[0], rayIds[0], _rays[i], _results[i], hits[i]);
+    }
+  }
+
+  // Heightfields, and triangle meshes unless each thread has its own
+  // collider cache, are collided in this thread.
+  if (!geoms[1].empty())
+  {
+    for (size_t i = 0; i < _rays.size(); ++i)
+      CastRay(trees[1], geoms[1], rayIds[0], _rays[i], _results[i], hits[i]);
+  }
+
+  for (auto rayId : rayIds)
+    dGeomDestroy(rayId);
+
+  for (size_t i = 0; i < _rays.size(); ++i)
+  {
+    if (!hits[i])
+      continue;
+
+    ODECollision *collision =
+      static_cast<ODECollision *>(dGeomGetData(RayTarget(hits[i])));
+    _results[i].collision = collision->GetScopedName();
+    _results[i].retro = collision->GetLaserRetro();
+  }
+}
+
+/////////////////////////////////////////////////
+void ODEPhysics::UpdateContactCache()
+{
+  if (!this->dataPtr->contactWarmStart)
+    return;
+
+  // A restored snapshot already provides the cache for this step.
+  if (this->dataPtr->contactCacheRestored)
+  {
+    this->dataPtr->contactCacheRestored = false;
+    this->dataPtr->contactJoints.clear();
+    return;
+  }
+
+  // Save the multipliers of the last step before the joints are destroyed.
+  for (auto &pair : this->dataPtr->contactJoints)
+  {
+    for (auto &contact : pair.second)
+      dJointGetLambda(contact.joint, contact.lambda, contact.lambdaErp);
+  }
+
+  this->dataPtr->contactCache.swap(this->dataPtr->contactJoints);
+  this->dataPtr->contactJoints.clear();
+}
+
+/////////////////////////////////////////////////
+void ODEPhysics::WarmStartContact(ODECollision *_collision1,
+    ODECollision *_collision2, dJointID _joint,
+    const dContactGeom &_contactGeom)
+{
+  // Contacts closer than this are the same contact, if their features match.
+  static const double kTolerance = 1e-2;
+
+  ODECachedContact contact;
+  contact.joint = _joint;
+  contact.pos.Set(_contactGeom.pos[0], _contactGeom.pos[1],
+      _contactGeom.pos[2]);
+  contact.side1 = _contactGeom.side1;
+  contact.side2 = _contactGeom.side2;
+
+  auto key = std::make_pair(_collision1, _collision2);
+  auto iter = this->dataPtr->contactCache.find(key);
+  if (iter != this->dataPtr->contactCache.end())
+  {
+    const ODECachedContact *match = nullptr;
+    double matchDist = kTolerance * kTolerance;
+    for (auto const &cached : iter->second)
+    {
+      double dist = (cached.pos - contact.pos).SquaredLength();
+      if (cached.side1 == contact.side1 && cached.side2 == contact.side2 &&
+          dist < matchDist)
+      {
+        match = &cached;
+        matchDist = dist;
+      }
+    }
+
+    if (match)
+      dJointSetLambda(_joint, match->lambda, match->lambdaErp);
+  }
+
+  this->dataPtr->contactJoints[key].push_back(contact);
+}
+
+/////////////////////////////////////////////////
+/// \brief Name and place a thread of the ODE island thread pool.
+static void InitIslandThread(void * /*_data*/)
+{
+  common::ThreadConfig::Instance()->Apply("ode_island");
+}
+
+/////////////////////////////////////////////////
+/// \brief Convert an axis order string to a dSAP_AXES value.
+/// \param[in] _order Axis order, e.g. "xyz".
+/// \param[out] _axes The dSAP_AXES value.
+/// \return False if the axis order is invalid.
+static bool SapAxes(const std::string &_order, int &_axes)
+{
+  static const std::map<std::string, int> kAxes =
+  {
+    {"xyz", dSAP_AXES_XYZ},
+    {"xzy", dSAP_AXES_XZY},
+    {"yxz", dSAP_AXES_YXZ},
+    {"yzx", dSAP_AXES_YZX},
+    {"zxy", dSAP_AXES_ZXY},
+    {"zyx", dSAP_AXES_ZYX}
+  };
+
+  auto iter = kAxes.find(_order);
+  if (iter == kAxes.end())
+    return false;
+
+  _axes = iter->second;
+  return true;
+}
+
+/////////////////////////////////////////////////
+void ODEPhysics::CreateSpace()
+{
+  dSpaceID space;
+  if (this->dataPtr->broadphase == "simple")
+  {
+    space = dSimpleSpaceCreate(0);
+  }
+  else if (this->dataPtr->broadphase == "sap")
+  {
+    int axes = dSAP_AXES_XYZ;
+    SapAxes(this->dataPtr->sapAxisOrder, axes);
+    space = dSweepAndPruneSpaceCreate(0, axes);
+  }
+  else if (this->dataPtr->broadphase == "quadtree")
+  {
+    const ignition::math::Vector3d &c = this->dataPtr->quadtreeCenter;
+    const ignition::math::Vector3d &e = this->dataPtr->quadtreeExtents;
+    dVector3 center = {c.X(), c.Y(), c.Z(), 0};
+    dVector3 extents = {e.X(), e.Y(), e.Z(), 0};
+    space = dQuadTreeSpaceCreate(0, center, extents,
+        this->dataPtr->quadtreeDepth);
+  }
+  else
+  {
+    space = dHashSpaceCreate(0);
+  }
+
+  // Move the model spaces to the new space.
+  if (this->dataPtr->spaceId)
+  {
+    while (dSpaceGetNumGeoms(this->dataPtr->spaceId) > 0)
+    {
+      dGeomID geom = dSpaceGetGeom(this->dataPtr->spaceId, 0);
+      dSpaceRemove(this->dataPtr->spaceId, geom);
+      dSpaceAdd(space, geom);
+    }
+    dSpaceSetCleanup(this->dataPtr->spaceId, 0);
+    dSpaceDestroy(this->dataPtr->spaceId);
+  }
+
+  this->dataPtr->spaceId = space;
+  this->UpdateHashLevels();
+}
+
+/////////////////////////////////////////////////
+void ODEPhysics::UpdateHashLevels()
+{
+  if (this->dataPtr->broadphase != "hash" || !this->dataPtr->spaceId)
+    return;
+
+  int minLevel = this->dataPtr->hashMinLevel;
+  int maxLevel = this->dataPtr->hashMaxLevel;
+
+  if (this->dataPtr->hashAutoLevels)
+  {
+    // Sizes of the finite geoms in the top level space, which are
+    // usually the model spaces.
+    std::vector<double> sizes;
+    for (int i = 0; i < dSpaceGetNumGeoms(this->dataPtr->spaceId); ++i)
+    {
+      // The static space spans all the static models
+      dGeomID geom = dSpaceGetGeom(this->dataPtr->spaceId, i);
+      if (geom == (dGeomID)this->dataPtr->staticSpaceId)
+        continue;
+
+      dReal aabb[6];
+      dGeomGetAABB(geom, aabb);
+      double size = std::max(aabb[1] - aabb[0],
+          std::max(aabb[3] - aabb[2], aabb[5] - aabb[4]));
+      if (size > 0 && std::isfinite(size))
+        sizes.push_back(size);
+    }
+
+    if (!sizes.empty())
+    {
+      // Small cells for all but the smallest 10% of the geoms, and large
+      // enough cells for the largest geom. Infinite geoms, e.g. planes,
+      // are tested against everything regardless of the levels.
+      std::sort(sizes.begin(), sizes.end());
+      maxLevel = static_cast<int>(std::ceil(std::log2(sizes.back())));
+      minLevel = static_cast<int>(
+          std::floor(std::log2(sizes[sizes.size() / 10])));
+      minLevel = std::min(minLevel, maxLevel);
+    }
+  }
+
+  dHashSpaceSetLevels(this->dataPtr->spaceId, minLevel, maxLevel);
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the collision of a geom of a link space.
+/// \param[in] _geom A geom, a compound space or the space of a triangle
+/// mesh.
+/// \return The collision, or null if the geom holds no single collision.
+static ODECollision *SpaceChildCollision(dGeomID _geom)
+{
+  if (dGeomGetData(_geom))
+    return static_cast<ODECollision *>(dGeomGetData(_geom));
+
+  if (dGeomGetClass(_geom) == dGeomTransformClass)
+  {
+    return static_cast<ODECollision *>(
+        dGeomGetData(dGeomTransformGetGeom(_geom)));
+  }
+
+  // The space of a triangle mesh holds the mesh only
+  if (dGeomIsSpace(_geom) && dSpaceGetNumGeoms((dSpaceID)_geom) == 1)
+  {
+    return static_cast<ODECollision *>(
+        dGeomGetData(dSpaceGetGeom((dSpaceID)_geom, 0)));
+  }
+
+  return nullptr;
+}
+
+/////////////////////////////////////////////////
+/// \brief Set the bits of a space to the union of the bits of its geoms,
+/// like ODECollision does for the spaces of its geoms.
+/// \param[in] _space The space.
+static void SetSpaceBits(dSpaceID _space)
+{
+  unsigned long category = 0;
+  unsigned long collide = 0;
+  for (int i = 0; i < dSpaceGetNumGeoms(_space); ++i)
+  {
+    const dGeomID geom = dSpaceGetGeom(_space, i);
+    category |= dGeomGetCategoryBits(geom);
+    collide |= dGeomGetCollideBits(geom);
+  }
+  dGeomSetCategoryBits((dGeomID)_space, category);
+  dGeomSetCollideBits((dGeomID)_space, collide);
+}
+
+/////////////////////////////////////////////////
+void ODEPhysics::MergeStatic()
+{
+  this->dataPtr->staticMergePending = false;
+
+  const dSpaceID top = this->dataPtr->spaceId;
+  if (!this->dataPtr->staticSpaceId)
+    this->dataPtr->staticSpaceId = dSimpleSpaceCreate(top);
+  const dSpaceID merged = this->dataPtr->staticSpaceId;
+
+  bool changed = false;
+  for (int i = 0; i < dSpaceGetNumGeoms(top); ++i)
+  {
+    // Model and link spaces only, compound spaces carry their collision
+    const dGeomID geom = dSpaceGetGeom(top, i);
+    if (geom == (dGeomID)merged || !dGeomIsSpace(geom) || dGeomGetData(geom))
+      continue;
+
+    // Collect the geoms first, since moving a geom changes the indices
+    const dSpaceID space = (dSpaceID)geom;
+    std::vector<dGeomID> children(dSpaceGetNumGeoms(space));
+    for (size_t j = 0; j < children.size(); ++j)
+      children[j] = dSpaceGetGeom(space, j);
+
+    bool moved = false;
+    for (auto child : children)
+    {
+      // Collide modes, sensors and plugins change the bits of the
+      // collisions that need the broadphase.
+      ODECollision *collision = SpaceChildCollision(child);
+      if (!collision || !collision->IsStatic() ||
+          dGeomGetCategoryBits(child) != GZ_FIXED_COLLIDE)
+      {
+        continue;
+      }
+
+      dSpaceRemove(space, child);
+      dSpaceAdd(merged, child);
+      if (collision->GetSpaceId() == space)
+        collision->SetSpaceId(merged);
+      moved = true;
+    }
+
+    if (moved)
+    {
+      SetSpaceBits(space);
+      changed = true;
+    }
+  }
+
+  if (changed)
+  {
+    SetSpaceBits(merged);
+    this->dataPtr->staticRebuild = true;
+  }
+}
+
+/////////////////////////////////////////////////
+void ODEPhysics::UnmergeStatic()
+{
+  const dSpaceID merged = this->dataPtr->staticSpaceId;
+  if (!merged)
+    return;
+
+  while (dSpaceGetNumGeoms(merged) > 0)
+  {
+    const dGeomID geom = dSpaceGetGeom(merged, 0);
+    ODECollision *collision = SpaceChildCollision(geom);
+    const dSpaceID space = boost::static_pointer_cast<ODELink>(
+        collision->GetLink())->GetSpaceId();
+
+    dSpaceRemove(merged, geom);
+    dSpaceAdd(space, geom);
+    if (collision->GetSpaceId() == merged)
+      collision->SetSpaceId(space);
+    SetSpaceBits(space);
+  }
+
+  dSpaceDestroy(merged);
+  this->dataPtr->staticSpaceId = nullptr;
+  this->dataPtr->staticGeoms.clear();
+  this->dataPtr->staticTree.Build({});
+}
+
+/////////////////////////////////////////////////
+void ODEPhysics::UpdateStaticTree()
+{
+  const dSpaceID merged = this->dataPtr->staticSpaceId;
+  if (!merged)
+    return;
+
+  // The geoms of removed collisions leave the space when destroyed
+  const size_t count = dSpaceGetNumGeoms(merged);
+  const bool rebuild = this->dataPtr->staticRebuild ||
+      count != this->dataPtr->staticGeoms.size();
+  if (!rebuild && !this->dataPtr->staticRefit)
+    return;
+
+  // A refit keeps the order of the geoms, which moved geoms change in the
+  // space.
+  std::vector<dGeomID> &geoms = this->dataPtr->staticGeoms;
+  if (rebuild)
+  {
+    geoms.resize(count);
+    for (size_t i = 0; i < count; ++i)
+      geoms[i] = dSpaceGetGeom(merged, i);
+  }
+
+  dSpaceClean(merged);
+  std::vector<ignition::math::AxisAlignedBox> boxes(count);
+  for (size_t i = 0; i < count; ++i)
+  {
+    dReal aabb[6];
+    dGeomGetAABB(geoms[i], aabb);
+    boxes[i] = ignition::math::AxisAlignedBox(
+        ignition::math::Vector3d(aabb[0], aabb[2], aabb[4]),
+        ignition::math::Vector3d(aabb[1], aabb[3], aabb[5]));
+  }
+
+  if (rebuild)
+    this->dataPtr->staticTree.Build(boxes);
+  else
+    this->dataPtr->staticTree.Refit(boxes);
+
+  SetSpaceBits(merged);
+  this->dataPtr->staticRebuild = false;
+  this->dataPtr->staticRefit = false;
+}
+
+/////////////////////////////////////////////////
+void ODEPhysics::CollideStatic(dGeomID _geom)
+{
+  if (!dGeomIsEnabled(_geom))
+    return;
+
+  // Collide the geoms of a space one by one, compounds are handled by the
+  // collision callback.
+  if (dGeomIsSpace(_geom) && !dGeomGetData(_geom))
+  {
+    const dSpaceID space = (dSpaceID)_geom;
+    dSpaceClean(space);
+    for (int i = 0; i < dSpaceGetNumGeoms(space); ++i)
+      this->CollideStatic(dSpaceGetGeom(space, i));
+    return;
+  }
+
+  dReal aabb[6];
+  dGeomGetAABB(_geom, aabb);
+  const ignition::math::AxisAlignedBox box(
+      ignition::math::Vector3d(aabb[0], aabb[2], aabb[4]),
+      ignition::math::Vector3d(aabb[1], aabb[3], aabb[5]));
+  const unsigned long category = dGeomGetCategoryBits(_geom);
+  const unsigned long collide = dGeomGetCollideBits(_geom);
+
+  this->dataPtr->staticTree.Query(
+      [&box](const ignition::math::AxisAlignedBox &_box)
+      {
+        return box.Intersects(_box);
+      },
+      [&](const size_t _index)
+      {
+        // Same test as the broadphase
+        const dGeomID geom = this->dataPtr->staticGeoms[_index];
+        if (dGeomIsEnabled(geom) &&
+            ((category & dGeomGetCollideBits(geom)) ||
+             (dGeomGetCategoryBits(geom) & collide)))
+        {
+          CollisionCallback(this, _geom, geom);
+        }
+      });
+}
+
+/////////////////////////////////////////////////
+void ODEPhysics::OnStaticPoseChange()
+{
+  this->dataPtr->staticRefit = true;
 }
 
 /////////////////////////////////////////////////
@@ -1554,6 +2642,139 @@ bool ODEPhysics::SetParam(const std::string &_key, const boost::any &_value)
         return false;
       }
       dWorldSetIslandThreads(this->dataPtr->worldId, value);
+      dWorldInitIslandThreads(this->dataPtr->worldId, &InitIslandThread,
+          nullptr);
+    }
+    else if (_key == "narrow_phase_threads")
+    {
+      int value = param_cast<int>(_value);
+      if (value < 0)
+      {
+        gzerr << "narrow_phase_threads must not be negative\n";
+        return false;
+      }
+
+      boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
+      this->dataPtr->narrowPhaseThreads = value;
+      if (value > 1)
+        this->dataPtr->narrowPhaseArena.reset(new tbb::task_arena(value));
+      else
+        this->dataPtr->narrowPhaseArena.reset();
+    }
+    else if (_key == "broadphase")
+    {
+      std::string value = param_cast<std::string>(_value);
+      if (value != "simple" && value != "hash" && value != "sap" &&
+          value != "quadtree")
+      {
+        gzerr << "Invalid broadphase [" << value << "], must be one of "
+              << "simple, hash, sap or quadtree\n";
+        return false;
+      }
+
+      boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
+      if (value != this->dataPtr->broadphase)
+      {
+        this->dataPtr->broadphase = value;
+        this->CreateSpace();
+      }
+    }
+    else if (_key == "hash_min_level" || _key == "hash_max_level")
+    {
+      int value = param_cast<int>(_value);
+
+      boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
+      if (_key == "hash_min_level")
+        this->dataPtr->hashMinLevel = value;
+      else
+        this->dataPtr->hashMaxLevel = value;
+      this->UpdateHashLevels();
+    }
+    else if (_key == "hash_auto_levels")
+    {
+      boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
+      this->dataPtr->hashAutoLevels = param_cast<bool>(_value);
+      this->UpdateHashLevels();
+    }
+    else if (_key == "sap_axis_order")
+    {
+      std::string value = param_cast<std::string>(_value);
+      int axes;
+      if (!SapAxes(value, axes))
+      {
+        gzerr << "Invalid sap_axis_order [" << value << "]\n";
+        return false;
+      }
+
+      boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
+      this->dataPtr->sapAxisOrder = value;
+      if (this->dataPtr->broadphase == "sap")
+        this->CreateSpace();
+    }
+    else if (_key == "quadtree_center" || _key == "quadtree_extents" ||
+             _key == "quadtree_depth")
+    {
+      boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
+      if (_key == "quadtree_center")
+      {
+        this->dataPtr->quadtreeCenter =
+          param_cast<ignition::math::Vector3d>(_value);
+      }
+      else if (_key == "quadtree_extents")
+      {
+        this->dataPtr->quadtreeExtents =
+          param_cast<ignition::math::Vector3d>(_value);
+      }
+      else
+      {
+        int value = param_cast<int>(_value);
+        if (value < 1)
+        {
+          gzerr << "quadtree_depth must be positive\n";
+          return false;
+        }
+        this->dataPtr->quadtreeDepth = value;
+      }
+
+      if (this->dataPtr->broadphase == "quadtree")
+        this->CreateSpace();
+    }
+    else if (_key == "contact_warm_start")
+    {
+      boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
+      this->dataPtr->contactWarmStart = param_cast<bool>(_value);
+      if (!this->dataPtr->contactWarmStart)
+      {
+        this->dataPtr->contactJoints.clear();
+        this->dataPtr->contactCache.clear();
+        this->dataPtr->contactCacheRestored = false;
+      }
+    }
+    else if (_key == "substeps")
+    {
+      int value = param_cast<int>(_value);
+      if (value < 1)
+      {
+        gzerr << "substeps must be positive\n";
+        return false;
+      }
+
+      boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
+      this->dataPtr->substeps = static_cast<unsigned int>(value);
+    }
+    else if (_key == "parallel_trimesh")
+    {
+      boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
+      this->dataPtr->parallelTrimesh = param_cast<bool>(_value);
+    }
+    else if (_key == "merge_static")
+    {
+      boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
+      this->dataPtr->mergeStatic = param_cast<bool>(_value);
+      if (this->dataPtr->mergeStatic)
+        this->MergeStatic();
+      else
+        this->UnmergeStatic();
     }
     else if (_key == "ode_quiet")
     {
@@ -1584,9 +2805,95 @@ bool ODEPhysics::SetParam(const std::string &_key, const boost::any &_value)
           << e.what() << std::endl;
     return false;
   }
+  catch(boost::bad_lexical_cast &e)
+  {
+    gzerr << "SetParam(" << _key << ") bad lexical_cast: "
+          << e.what() << std::endl;
+    return false;
+  }
   return true;
 }
 
+//////////////////////////////////////////////////
+/// \brief Make the functions of a solver parameter that is stored in an
+/// SDF element and passed to an ODE world function.
+/// \param[in] _elem SDF element of the parameter.
+/// \param[in] _worldId ODE world.
+/// \param[in] _func ODE function that sets the parameter.
+/// \param[out] _setter Function that sets the parameter.
+/// \param[out] _getter Function that gets the parameter.
+template<typename T, typename F>
+static void ResolveWorldParam(sdf::ElementPtr _elem, dWorldID _worldId,
+    F _func, PhysicsParamSetter &_setter, PhysicsParamGetter &_getter)
+{
+  _setter = [_elem, _worldId, _func](const boost::any &_value)
+  {
+    const T *value = boost::any_cast<T>(&_value);
+    if (!value)
+      return false;
+    _elem->Set(*value);
+    _func(_worldId, *value);
+    return true;
+  };
+  _getter = [_elem](boost::any &_value)
+  {
+    _value = _elem->Get<T>();
+    return true;
+  };
+}
+
+//////////////////////////////////////////////////
+void ODEPhysics::ResolveParam(const std::string &_key,
+    PhysicsParamSetter &_setter, PhysicsParamGetter &_getter)
+{
+  // The solver parameters that adaptive controllers change every few steps
+  // get functions of their own, the others go through SetParam/GetParam.
+  sdf::ElementPtr odeElem = this->sdf->GetElement("ode");
+  sdf::ElementPtr solverElem = odeElem->GetElement("solver");
+  sdf::ElementPtr constraintsElem = odeElem->GetElement("constraints");
+  dWorldID worldId = this->dataPtr->worldId;
+
+  if (_key == "cfm")
+  {
+    ResolveWorldParam<double>(constraintsElem->GetElement("cfm"), worldId,
+        &dWorldSetCFM, _setter, _getter);
+  }
+  else if (_key == "erp")
+  {
+    ResolveWorldParam<double>(constraintsElem->GetElement("erp"), worldId,
+        &dWorldSetERP, _setter, _getter);
+  }
+  else if (_key == "iters")
+  {
+    ResolveWorldParam<int>(solverElem->GetElement("iters"), worldId,
+        &dWorldSetQuickStepNumIterations, _setter, _getter);
+  }
+  else if (_key == "precon_iters")
+  {
+    ResolveWorldParam<int>(solverElem->GetElement("precon_iters"), worldId,
+        &dWorldSetQuickStepPreconIterations, _setter, _getter);
+  }
+  else if (_key == "sor")
+  {
+    ResolveWorldParam<double>(solverElem->GetElement("sor"), worldId,
+        &dWorldSetQuickStepW, _setter, _getter);
+  }
+  else if (_key == "contact_max_correcting_vel")
+  {
+    ResolveWorldParam<double>(
+        constraintsElem->GetElement("contact_max_correcting_vel"), worldId,
+        &dWorldSetContactMaxCorrectingVel, _setter, _getter);
+  }
+  else if (_key == "contact_surface_layer")
+  {
+    ResolveWorldParam<double>(
+        constraintsElem->GetElement("contact_surface_layer"), worldId,
+        &dWorldSetContactSurfaceLayer, _setter, _getter);
+  }
+  else
+    PhysicsEngine::ResolveParam(_key, _setter, _getter);
+}
+
 //////////////////////////////////////////////////
 boost::any ODEPhysics::GetParam(const std::string &_key) const
 {
@@ -1662,6 +2969,46 @@ bool ODEPhysics::GetParam(const std::string &_key, boost::any &_value) const
     _value = this->GetFrictionModel();
   else if (_key == "island_threads")
     _value = dWorldGetIslandThreads(this->dataPtr->worldId);
+  else if (_key == "island_times")
+  {
+    // The step writes the times, copy them under the physics lock
+    boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
+    std::vector<double> times(
+        dWorldGetIslandTimes(this->dataPtr->worldId, nullptr, 0));
+    dWorldGetIslandTimes(this->dataPtr->worldId, times.data(),
+        static_cast<int>(times.size()));
+    _value = times;
+  }
+  else if (_key == "narrow_phase_threads")
+    _value = static_cast<int>(this->dataPtr->narrowPhaseThreads);
+  else if (_key == "parallel_trimesh")
+    _value = this->dataPtr->parallelTrimesh;
+  else if (_key == "merge_static")
+    _value = this->dataPtr->mergeStatic;
+  else if (_key == "contact_warm_start")
+    _value = this->dataPtr->contactWarmStart;
+  else if (_key == "substeps")
+    _value = static_cast<int>(this->dataPtr->substeps);
+  else if (_key == "broadphase")
+    _value = this->dataPtr->broadphase;
+  else if (_key == "hash_min_level" || _key == "hash_max_level")
+  {
+    int minLevel = this->dataPtr->hashMinLevel;
+    int maxLevel = this->dataPtr->hashMaxLevel;
+    if (this->dataPtr->broadphase == "hash" && this->dataPtr->spaceId)
+      dHashSpaceGetLevels(this->dataPtr->spaceId, &minLevel, &maxLevel);
+    _value = _key == "hash_min_level" ? minLevel : maxLevel;
+  }
+  else if (_key == "hash_auto_levels")
+    _value = this->dataPtr->hashAutoLevels;
+  else if (_key == "sap_axis_order")
+    _value = this->dataPtr->sapAxisOrder;
+  else if (_key == "quadtree_center")
+    _value = this->dataPtr->quadtreeCenter;
+  else if (_key == "quadtree_extents")
+    _value = this->dataPtr->quadtreeExtents;
+  else if (_key == "quadtree_depth")
+    _value = this->dataPtr->quadtreeDepth;
   else if (_key == "ode_quiet")
     _value = dGetMessageHandler() != 0;
   else if (_key == "world_step_solver")
@@ -19,8 +19,10 @@
 
 #include <tbb/spin_mutex.h>
 #include <tbb/concurrent_vector.h>
+#include <functional>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include <boost/thread/thread.hpp>
 
@@ -108,6 +110,15 @@ namespace gazebo
       // Documentation inherited
       public: virtual void Reset();
 
+      // Documentation inherited
+      public: virtual void SaveSnapshot(const uint32_t _handle);
+
+      // Documentation inherited
+      public: virtual bool RestoreSnapshot(const uint32_t _handle);
+
+      // Documentation inherited
+      public: virtual void ReleaseSnapshot(const uint32_t _handle);
+
       // Documentation inherited
       public: virtual void InitForThread();
 
@@ -139,6 +150,15 @@ namespace gazebo
       public: virtual JointPtr CreateJoint(const std::string &_type,
                                            ModelPtr _parent);
 
+      /// \brief Find the closest hit of each ray of a batch. The rays are
+      /// tested against a bounding volume hierarchy of the geoms of the
+      /// world, and are spread over the narrow phase threads when
+      /// narrow_phase_threads is greater than one.
+      /// \param[in] _rays Ray segments, in the world frame.
+      /// \param[out] _results Closest hit of each ray, in the same order.
+      public: virtual void CastRays(const std::vector<RayQuery> &_rays,
+                  std::vector<RayQueryResult> &_results);
+
       // Documentation inherited
       public: virtual void SetGravity(const ignition::math::Vector3d &_gravity);
 
@@ -271,15 +291,46 @@ namespace gazebo
       public: static World_Solver_Type
               ConvertWorldStepSolverType(const std::string &_solverType);
 
-      /// \brief Get the step type (quick, world).
+      /// \brief Get the step type (quick, world, parallel_quick).
       /// \return The step type.
       public: virtual std::string GetStepType() const;
 
-      /// \brief Set the step type (quick, world).
-      /// \param[in] _type The step type (quick or world).
+      /// \brief Set the step type (quick, world, parallel_quick).
+      /// The parallel_quick step solves the constraints of each island with
+      /// the parallel quickstep kernels, and is available when gazebo is
+      /// built with ENABLE_PARALLEL_QUICKSTEP; otherwise quick is used.
+      /// Its rms_error, constraint_residual and num_contacts parameters are
+      /// reported like the quick step ones.
+      /// \param[in] _type The step type (quick, world or parallel_quick).
       public: virtual void SetStepType(const std::string &_type);
 
 
+      /// \brief Function that adjusts the contacts of a collision before
+      /// their contact joints are created, see SetContactSurfaceCallback.
+      /// \param[in] _collision The collision the function was set for.
+      /// \param[in] _other The other collision of the pair.
+      /// \param[in,out] _contacts The contacts between the two collisions.
+      /// The surface parameters and fdir1 of each contact may be changed,
+      /// the geometry must be kept since it is also reported to the
+      /// contact manager.
+      /// \param[in] _count Number of contacts.
+      public: typedef std::function<void (ODECollision *_collision,
+                  ODECollision *_other, dContact *_contacts,
+                  const unsigned int _count)> ContactSurfaceCallback;
+
+      /// \brief Set a function called with the contacts of a collision in
+      /// each step, after the surface parameters were combined and before
+      /// the contact joints are created. This lets a plugin change the
+      /// contacts of its own collisions directly, instead of searching the
+      /// contacts of the whole world. The function is called from the
+      /// physics update thread, so it must be set and removed from that
+      /// thread too, e.g. in the Load or Init function of a plugin.
+      /// \param[in] _collision The collision.
+      /// \param[in] _callback The function, or an empty function to remove
+      /// the function of the collision.
+      public: void SetContactSurfaceCallback(ODECollision *_collision,
+                  const ContactSurfaceCallback &_callback);
+
       /// \brief Collide two collision objects.
       /// \param[in] _collision1 First collision object.
       /// \param[in] _collision2 Second collision object.
@@ -287,6 +338,16 @@ namespace gazebo
       public: void Collide(ODECollision *_collision1, ODECollision *_collision2,
                            dContactGeom *_contactCollisions);
 
+      /// \brief Tell the engine that a static collision moved, so that the
+      /// tree of the merged static collisions is refit before the next
+      /// collision pass. See the "merge_static" parameter.
+      public: void OnStaticPoseChange();
+
+      /// \brief Track a joint whose feedback GetForceTorque enabled on
+      /// demand, so that it is disabled once the joint is no longer read.
+      /// \param[in] _joint The joint.
+      public: void AddFeedbackOnDemand(ODEJointPtr _joint);
+
       /// \brief process joint feedbacks.
       /// \param[in] _feedback ODE Joint Contact feedback information.
       public: void ProcessJointFeedback(ODEJointFeedback *_feedback);
@@ -295,6 +356,11 @@ namespace gazebo
 
       protected: virtual void OnPhysicsMsg(ConstPhysicsPtr &_msg);
 
+      // Documentation inherited
+      protected: virtual void ResolveParam(const std::string &_key,
+                     PhysicsParamSetter &_setter,
+                     PhysicsParamGetter &_getter);
+
       /// \brief Primary collision callback.
       /// \param[in] _data Pointer to user data.
       /// \param[in] _o1 First geom to check for collisions.
@@ -303,6 +369,52 @@ namespace gazebo
                                              dGeomID _o2);
 
 
+      /// \brief Save the constraint multipliers of the contact joints of the
+      /// last step, so they can warm start the contact joints of this step.
+      /// Must be called before the contact group is emptied.
+      private: void UpdateContactCache();
+
+      /// \brief Warm start a new contact joint from the matching contact
+      /// joint of the last step, i.e. the closest contact of the same
+      /// collision pair and features, and remember the joint for the next
+      /// step.
+      /// \param[in] _collision1 First collision object.
+      /// \param[in] _collision2 Second collision object.
+      /// \param[in] _joint The new contact joint.
+      /// \param[in] _contactGeom Contact of the joint.
+      private: void WarmStartContact(ODECollision *_collision1,
+                   ODECollision *_collision2, dJointID _joint,
+                   const dContactGeom &_contactGeom);
+
+      /// \brief Create the top level collision space from the broadphase
+      /// parameters. Geoms of the previous top level space, if any, are
+      /// moved to the new space.
+      private: void CreateSpace();
+
+      /// \brief Set the levels of the top level hash space, either from
+      /// the configured levels or from the sizes of the geoms in the space.
+      /// Does nothing unless the broadphase is "hash".
+      private: void UpdateHashLevels();
+
+      /// \brief Move the static collisions of the model spaces to the
+      /// static space, which the broadphase sees as a single object. Only
+      /// collisions with the default static collide bits are moved.
+      private: void MergeStatic();
+
+      /// \brief Move the merged static collisions back to the spaces of
+      /// their links, and destroy the static space.
+      private: void UnmergeStatic();
+
+      /// \brief Build or refit the tree of the merged static collisions
+      /// if geoms were merged, removed or moved since the last pass.
+      private: void UpdateStaticTree();
+
+      /// \brief Collide a geom, or the geoms of a space, with the merged
+      /// static collisions whose bounding boxes it overlaps.
+      /// \param[in] _geom Geom or space paired with the static space by
+      /// the broadphase.
+      private: void CollideStatic(dGeomID _geom);
+
       /// \brief Create a triangle mesh object collider.
       /// \param[in] _collision1 The first collision object.
       /// \param[in] _collision2 The second collision object.
@@ -315,6 +427,40 @@ namespace gazebo
       private: void AddCollider(ODECollision *_collision1,
                                 ODECollision *_collision2);
 
+      /// \brief Generate the contacts between two collision objects.
+      /// This does not modify the physics engine, and may be called
+      /// concurrently for colliders that do not involve triangle meshes or
+      /// heightmaps.
+      /// \param[in] _collision1 First collision object.
+      /// \param[in] _collision2 Second collision object.
+      /// \param[in,out] _contactCollisions Array of MAX_COLLIDE_RETURNS
+      /// contacts. The selected contacts are moved to the front.
+      /// \return Number of selected contacts.
+      private: unsigned int GenerateContacts(ODECollision *_collision1,
+                   ODECollision *_collision2,
+                   dContactGeom *_contactCollisions);
+
+      /// \brief Create the contact joints, and contact feedback, for
+      /// contacts generated by ODEPhysics::GenerateContacts.
+      /// \param[in] _collision1 First collision object.
+      /// \param[in] _collision2 Second collision object.
+      /// \param[in] _contactCollisions Array of contacts.
+      /// \param[in] _count Number of contacts in the array.
+      private: void CreateContactJoints(ODECollision *_collision1,
+                   ODECollision *_collision2,
+                   const dContactGeom *_contactCollisions,
+                   const unsigned int _count);
+
+      /// \brief Run the narrow phase of a list of colliders on the
+      /// narrow phase threads. Contact joints are created afterwards in
+      /// collider order, so the result matches the serial narrow phase.
+      /// \param[in] _colliders Colliders to collide.
+      /// \param[in] _count Number of valid colliders in _colliders.
+      private: void CollideParallel(
+                   const std::vector<std::pair<ODECollision *,
+                   ODECollision *> > &_colliders,
+                   const unsigned int _count);
+
       /// \internal
       /// \brief Private data pointer.
       private: ODEPhysicsPrivate *dataPtr;
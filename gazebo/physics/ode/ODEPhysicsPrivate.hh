@@ -18,12 +18,23 @@
 #ifndef _ODEPHYSICS_PRIVATE_HH_
 #define _ODEPHYSICS_PRIVATE_HH_
 
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/task_arena.h>
+
+#include <boost/weak_ptr.hpp>
+
 #include <map>
+#include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <utility>
 
+#include <ignition/math/Vector3.hh>
+
+#include "gazebo/physics/AabbTree.hh"
 #include "gazebo/physics/Contact.hh"
+#include "gazebo/physics/ode/ODEPhysics.hh"
 #include "gazebo/physics/ode/ODETypes.hh"
 
 namespace gazebo
@@ -41,8 +52,100 @@ namespace gazebo
       /// \brief Number of elements in feedbacks array.
       public: int count;
 
-      /// \brief Contact joint feedback information.
-      public: dJointFeedback feedbacks[MAX_CONTACT_JOINTS];
+      /// \brief Contact joint feedback information. It is only resized
+      /// between steps, since the contact joints point into it.
+      public: std::vector<dJointFeedback> feedbacks;
+    };
+
+    /// \brief A contact joint of the last step, which is used to warm
+    /// start a matching contact joint of the next step.
+    class ODECachedContact
+    {
+      /// \brief The contact joint. Only valid until the contact group is
+      /// emptied.
+      public: dJointID joint;
+
+      /// \brief World position of the contact.
+      public: ignition::math::Vector3d pos;
+
+      /// \brief Feature of the first geom, e.g. a triangle index.
+      public: int side1;
+
+      /// \brief Feature of the second geom.
+      public: int side2;
+
+      /// \brief Constraint multipliers computed for the joint.
+      public: dReal lambda[6];
+
+      /// \brief Constraint multipliers of the erp rows.
+      public: dReal lambdaErp[6];
+    };
+
+    /// \brief Contacts generated by the narrow phase for one collider.
+    class ODEColliderContacts
+    {
+      /// \brief Index of the collider in ODEPhysicsPrivate::colliders.
+      public: unsigned int colliderIndex;
+
+      /// \brief Index of the first contact in
+      /// ODENarrowPhaseBuffer::contacts.
+      public: size_t offset;
+
+      /// \brief Number of contacts.
+      public: unsigned int count;
+    };
+
+    /// \brief Per thread buffers of the parallel narrow phase.
+    class ODENarrowPhaseBuffer
+    {
+      /// \brief Scratch buffer passed to dCollide.
+      public: dContactGeom scratch[MAX_COLLIDE_RETURNS];
+
+      /// \brief Colliders that generated contacts in this thread.
+      public: std::vector<ODEColliderContacts> colliders;
+
+      /// \brief Contacts referenced by the entries in colliders.
+      public: std::vector<dContactGeom> contacts;
+    };
+
+    /// \brief State of an ODE body in a world snapshot.
+    class ODEBodySnapshot
+    {
+      /// \brief The link that owns the body. Expired if the link was
+      /// removed.
+      public: boost::weak_ptr<ODELink> link;
+
+      /// \brief Position of the body.
+      public: dReal pos[3];
+
+      /// \brief Orientation of the body as a quaternion.
+      public: dReal quat[4];
+
+      /// \brief Linear velocity of the body.
+      public: dReal linearVel[3];
+
+      /// \brief Angular velocity of the body.
+      public: dReal angularVel[3];
+
+      /// \brief Accumulated force on the body.
+      public: dReal force[3];
+
+      /// \brief Accumulated torque on the body.
+      public: dReal torque[3];
+
+      /// \brief True if the body is enabled.
+      public: bool enabled;
+    };
+
+    /// \brief Engine state saved by ODEPhysics::SaveSnapshot.
+    class ODESnapshot
+    {
+      /// \brief State of all the bodies.
+      public: std::vector<ODEBodySnapshot> bodies;
+
+      /// \brief Contact warm start data for the step after the snapshot.
+      public: std::map<std::pair<ODECollision *, ODECollision *>,
+              std::vector<ODECachedContact> > contactCache;
     };
 
     class ODEPhysicsPrivate
@@ -65,9 +168,88 @@ namespace gazebo
       /// \brief Physics step function.
       public: int (*physicsStepFunc)(dxWorld*, dReal);
 
+      /// \brief True to warm start contact joints from matching contact
+      /// joints of the previous step.
+      public: bool contactWarmStart = false;
+
+      /// \brief Number of integration substeps per world update. The contact
+      /// joints of the collision update are reused by all the substeps.
+      public: unsigned int substeps = 1;
+
+      /// \brief Contact joints created in this step, by collision pair.
+      public: std::map<std::pair<ODECollision *, ODECollision *>,
+              std::vector<ODECachedContact> > contactJoints;
+
+      /// \brief Contact joints of the previous step, by collision pair. The
+      /// collision pointers are only compared, never dereferenced.
+      public: std::map<std::pair<ODECollision *, ODECollision *>,
+              std::vector<ODECachedContact> > contactCache;
+
+      /// \brief True if contactCache was restored from a snapshot and
+      /// must not be replaced by the contact joints of the last step.
+      public: bool contactCacheRestored = false;
+
+      /// \brief Engine state of the world snapshots, by handle.
+      public: std::map<uint32_t, ODESnapshot> snapshots;
+
+      /// \brief Type of the top level collision space: "simple", "hash",
+      /// "sap" or "quadtree".
+      public: std::string broadphase = "hash";
+
+      /// \brief Configured minimum level of the hash space. A cell of level
+      /// n has a size of 2^n.
+      public: int hashMinLevel = -2;
+
+      /// \brief Configured maximum level of the hash space.
+      public: int hashMaxLevel = 8;
+
+      /// \brief True to pick the hash space levels from the sizes of the
+      /// geoms in the top level space, instead of the configured levels.
+      public: bool hashAutoLevels = false;
+
+      /// \brief Axis order of the sweep and prune space, e.g. "xyz".
+      public: std::string sapAxisOrder = "xyz";
+
+      /// \brief Center of the quadtree space.
+      public: ignition::math::Vector3d quadtreeCenter =
+              ignition::math::Vector3d::Zero;
+
+      /// \brief Half extents of the quadtree space.
+      public: ignition::math::Vector3d quadtreeExtents =
+              ignition::math::Vector3d(500, 500, 500);
+
+      /// \brief Depth of the quadtree space.
+      public: int quadtreeDepth = 6;
+
       /// \brief All the collsiion spaces.
       public: std::map<std::string, dSpaceID> spaces;
 
+      /// \brief True to merge the collisions of static models into one
+      /// space, whose geoms are found with staticTree rather than by the
+      /// top level broadphase.
+      public: bool mergeStatic = false;
+
+      /// \brief Space of the merged static collisions, a child of the top
+      /// level space. Null unless mergeStatic is true.
+      public: dSpaceID staticSpaceId = nullptr;
+
+      /// \brief Geoms of the static space, in the order of staticTree.
+      public: std::vector<dGeomID> staticGeoms;
+
+      /// \brief Tree of the bounding boxes of staticGeoms.
+      public: AabbTree staticTree;
+
+      /// \brief True if links were created since the static collisions
+      /// were merged.
+      public: bool staticMergePending = false;
+
+      /// \brief True if geoms were merged since staticTree was built.
+      public: bool staticRebuild = false;
+
+      /// \brief True if a static collision moved since staticTree was
+      /// refit.
+      public: bool staticRefit = false;
+
       /// \brief All the normal colliders.
       public: std::vector< std::pair<ODECollision*, ODECollision*> > colliders;
 
@@ -78,9 +260,6 @@ namespace gazebo
       /// \brief Array of contact collisions.
       public: dContactGeom contactCollisions[MAX_COLLIDE_RETURNS];
 
-      /// \brief Indices used during creation of contact joints.
-      public: int indices[MAX_CONTACT_JOINTS];
-
       /// \brief Current index into the contactFeedbacks buffer
       public: unsigned int jointFeedbackIndex;
 
@@ -92,6 +271,38 @@ namespace gazebo
 
       /// \brief Maximum number of contact points per collision pair.
       public: unsigned int maxContacts;
+
+      /// \brief Number of threads used for the narrow phase of the normal
+      /// colliders. Zero or one runs the narrow phase in the physics thread.
+      public: unsigned int narrowPhaseThreads = 0;
+
+      /// \brief True to also run the triangle mesh colliders on the narrow
+      /// phase threads. Each thread then uses its own OPCODE collider
+      /// cache.
+      public: bool parallelTrimesh = false;
+
+      /// \brief Task arena that bounds the narrow phase concurrency.
+      public: std::unique_ptr<tbb::task_arena> narrowPhaseArena;
+
+      /// \brief Narrow phase buffers, one per worker thread.
+      public: tbb::enumerable_thread_specific<ODENarrowPhaseBuffer>
+              narrowPhaseBuffers;
+
+      /// \brief Contacts of all narrow phase threads, sorted by collider
+      /// index before contact joints are created.
+      public: std::vector<std::pair<const ODEColliderContacts *,
+              const dContactGeom *> > narrowPhaseContacts;
+
+      /// \brief Contact surface functions, by collision.
+      public: std::unordered_map<const ODECollision *,
+              ODEPhysics::ContactSurfaceCallback> contactSurfaceCallbacks;
+
+      /// \brief Contacts passed to the contact surface functions, reused
+      /// by all the collision pairs.
+      public: std::vector<dContact> surfaceContacts;
+
+      /// \brief Joints whose feedback GetForceTorque enabled on demand.
+      public: std::vector<boost::weak_ptr<ODEJoint> > feedbackJoints;
     };
   }
 }
@@ -16,9 +16,14 @@
 */
 
 #include <gtest/gtest.h>
+#include <cmath>
+#include <map>
+#include <string>
+#include <vector>
 
 #include "gazebo/physics/physics.hh"
 #include "gazebo/physics/PhysicsEngine.hh"
+#include "gazebo/physics/ode/ODECollision.hh"
 #include "gazebo/physics/ode/ODEPhysics.hh"
 #include "gazebo/physics/ode/ODETypes.hh"
 #include "gazebo/test/ServerFixture.hh"
@@ -320,6 +325,61 @@ TEST_F(ODEPhysics_TEST, PhysicsParam)
     }
   }
 
+  // Test narrow_phase_threads
+  {
+    // narrow_phase_threads should be 0 by default
+    int narrowPhaseThreads = 1;
+    EXPECT_NO_THROW(narrowPhaseThreads =
+      boost::any_cast<int>(odePhysics->GetParam("narrow_phase_threads")));
+    EXPECT_EQ(0, narrowPhaseThreads);
+
+    // try enabling threads, then disabling
+    std::vector<int> threads = {1, 2, 4, 0};
+    for (auto const narrowPhaseThreadsSet : threads)
+    {
+      EXPECT_TRUE(odePhysics->SetParam("narrow_phase_threads",
+          narrowPhaseThreadsSet));
+      EXPECT_NO_THROW(narrowPhaseThreads =
+        boost::any_cast<int>(odePhysics->GetParam("narrow_phase_threads")));
+      EXPECT_EQ(narrowPhaseThreadsSet, narrowPhaseThreads);
+    }
+
+    // values of custom SDF elements are strings
+    EXPECT_TRUE(odePhysics->SetParam("ignition:narrow_phase_threads",
+        std::string("3")));
+    EXPECT_NO_THROW(narrowPhaseThreads = boost::any_cast<int>(
+        odePhysics->GetParam("ignition:narrow_phase_threads")));
+    EXPECT_EQ(3, narrowPhaseThreads);
+
+    EXPECT_FALSE(odePhysics->SetParam("narrow_phase_threads", -1));
+    EXPECT_FALSE(odePhysics->SetParam("narrow_phase_threads",
+        std::string("two")));
+    odePhysics->SetParam("narrow_phase_threads", 0);
+  }
+
+  // Test parallel_trimesh
+  {
+    // parallel_trimesh should be off by default
+    bool parallelTrimesh = true;
+    EXPECT_NO_THROW(parallelTrimesh =
+      boost::any_cast<bool>(odePhysics->GetParam("parallel_trimesh")));
+    EXPECT_FALSE(parallelTrimesh);
+
+    EXPECT_TRUE(odePhysics->SetParam("parallel_trimesh", true));
+    EXPECT_NO_THROW(parallelTrimesh =
+      boost::any_cast<bool>(odePhysics->GetParam("parallel_trimesh")));
+    EXPECT_TRUE(parallelTrimesh);
+
+    // values of custom SDF elements are strings
+    EXPECT_TRUE(odePhysics->SetParam("ignition:parallel_trimesh",
+        std::string("false")));
+    EXPECT_NO_THROW(parallelTrimesh =
+      boost::any_cast<bool>(odePhysics->GetParam("parallel_trimesh")));
+    EXPECT_FALSE(parallelTrimesh);
+    EXPECT_FALSE(odePhysics->SetParam("parallel_trimesh",
+        std::string("maybe")));
+  }
+
   // Test ode_quiet
   // convenient for disabling LCP internal error messages from world solver
   {
@@ -490,6 +550,459 @@ TEST_F(ODEPhysics_TEST, PhysicsMsgParam)
   PhysicsMsgParam();
 }
 
+/////////////////////////////////////////////////
+/// Test typed parameter handles and setting parameters as a whole
+TEST_F(ODEPhysics_TEST, ParamHandle)
+{
+  Load("worlds/empty.world", true, "ode");
+  WorldPtr world = get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  PhysicsEnginePtr physics = world->Physics();
+  ASSERT_TRUE(physics != nullptr);
+
+  // Parameter with a function of its own
+  PhysicsParam<int> iters = physics->ParamHandle<int>("iters");
+  ASSERT_TRUE(iters.Valid());
+  EXPECT_EQ("iters", iters.Key());
+  EXPECT_TRUE(iters.Set(33));
+  int itersValue = 0;
+  EXPECT_TRUE(iters.Get(itersValue));
+  EXPECT_EQ(33, itersValue);
+  EXPECT_EQ(33, boost::any_cast<int>(physics->GetParam("iters")));
+
+  PhysicsParam<double> sor = physics->ParamHandle<double>("sor");
+  ASSERT_TRUE(sor.Valid());
+  EXPECT_TRUE(sor.Set(1.1));
+  EXPECT_DOUBLE_EQ(1.1, boost::any_cast<double>(physics->GetParam("sor")));
+
+  // Parameter that goes through SetParam
+  PhysicsParam<bool> warmStart =
+      physics->ParamHandle<bool>("ignition:contact_warm_start");
+  ASSERT_TRUE(warmStart.Valid());
+  EXPECT_TRUE(warmStart.Set(true));
+  bool warmStartValue = false;
+  EXPECT_TRUE(warmStart.Get(warmStartValue));
+  EXPECT_TRUE(warmStartValue);
+  EXPECT_TRUE(warmStart.Set(false));
+
+  // Unknown key and wrong type
+  EXPECT_FALSE(physics->ParamHandle<int>("no_such_param").Valid());
+  EXPECT_FALSE(physics->ParamHandle<int>("sor").Valid());
+  EXPECT_FALSE(PhysicsParam<int>().Set(1));
+
+  // Set a preset as a whole
+  std::map<std::string, boost::any> params;
+  params["iters"] = 20;
+  params["sor"] = 1.3;
+  params["erp"] = 0.3;
+  EXPECT_TRUE(physics->SetParams(params));
+  EXPECT_EQ(20, boost::any_cast<int>(physics->GetParam("iters")));
+  EXPECT_DOUBLE_EQ(1.3, boost::any_cast<double>(physics->GetParam("sor")));
+  EXPECT_DOUBLE_EQ(0.3, boost::any_cast<double>(physics->GetParam("erp")));
+
+  // Nothing changes when a key is unknown or a value can't be set
+  params["iters"] = 40;
+  params["no_such_param"] = 1;
+  EXPECT_FALSE(physics->SetParams(params));
+  EXPECT_EQ(20, boost::any_cast<int>(physics->GetParam("iters")));
+
+  params.erase("no_such_param");
+  params["sor"] = std::string("bad");
+  EXPECT_FALSE(physics->SetParams(params));
+  EXPECT_EQ(20, boost::any_cast<int>(physics->GetParam("iters")));
+  EXPECT_DOUBLE_EQ(1.3, boost::any_cast<double>(physics->GetParam("sor")));
+}
+
+/////////////////////////////////////////////////
+/// Test the broadphase parameters, and that boxes rest on the ground with
+/// each broadphase
+TEST_F(ODEPhysics_TEST, Broadphase)
+{
+  Load("worlds/empty.world", true, "ode");
+  WorldPtr world = get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  PhysicsEnginePtr physics = world->Physics();
+  ASSERT_TRUE(physics != nullptr);
+
+  // the default top level space is a hash space
+  std::string broadphase;
+  EXPECT_NO_THROW(broadphase =
+      boost::any_cast<std::string>(physics->GetParam("broadphase")));
+  EXPECT_EQ("hash", broadphase);
+  EXPECT_EQ(-2, boost::any_cast<int>(physics->GetParam("hash_min_level")));
+  EXPECT_EQ(8, boost::any_cast<int>(physics->GetParam("hash_max_level")));
+
+  EXPECT_FALSE(physics->SetParam("broadphase", std::string("octree")));
+  EXPECT_FALSE(physics->SetParam("sap_axis_order", std::string("xxy")));
+  EXPECT_FALSE(physics->SetParam("quadtree_depth", 0));
+  EXPECT_TRUE(physics->SetParam("sap_axis_order", std::string("yxz")));
+  EXPECT_TRUE(physics->SetParam("ignition:quadtree_extents",
+      std::string("20 20 20")));
+  EXPECT_EQ(ignition::math::Vector3d(20, 20, 20),
+      boost::any_cast<ignition::math::Vector3d>(
+        physics->GetParam("quadtree_extents")));
+
+  for (unsigned int i = 0; i < 4; ++i)
+  {
+    SpawnBox("box_" + std::to_string(i), ignition::math::Vector3d::One,
+        ignition::math::Vector3d(i * 2.0, 0, 1.0));
+  }
+
+  // pick the hash levels from the sizes of the boxes
+  EXPECT_TRUE(physics->SetParam("hash_auto_levels", true));
+  int minLevel = boost::any_cast<int>(physics->GetParam("hash_min_level"));
+  int maxLevel = boost::any_cast<int>(physics->GetParam("hash_max_level"));
+  EXPECT_LE(minLevel, maxLevel);
+  EXPECT_GE(minLevel, -1);
+  EXPECT_LE(maxLevel, 2);
+
+  // the configured levels are used again without auto-tuning
+  EXPECT_TRUE(physics->SetParam("hash_auto_levels", false));
+  EXPECT_EQ(-2, boost::any_cast<int>(physics->GetParam("hash_min_level")));
+  EXPECT_EQ(8, boost::any_cast<int>(physics->GetParam("hash_max_level")));
+
+  std::vector<std::string> broadphases = {"sap", "quadtree", "simple",
+      "hash"};
+  for (auto const &type : broadphases)
+  {
+    EXPECT_TRUE(physics->SetParam("broadphase", type));
+    EXPECT_EQ(type,
+        boost::any_cast<std::string>(physics->GetParam("broadphase")));
+
+    world->Reset();
+    world->Step(1000);
+    for (unsigned int i = 0; i < 4; ++i)
+    {
+      ModelPtr model = world->ModelByName("box_" + std::to_string(i));
+      ASSERT_TRUE(model != nullptr);
+      EXPECT_NEAR(0.5, model->WorldPose().Pos().Z(), 0.01) << type;
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+/// Test that a box stack rests on the ground with contact warm starting
+/// and fewer solver iterations
+TEST_F(ODEPhysics_TEST, ContactWarmStart)
+{
+  Load("worlds/empty.world", true, "ode");
+  WorldPtr world = get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  PhysicsEnginePtr physics = world->Physics();
+  ASSERT_TRUE(physics != nullptr);
+
+  // contact warm starting should be off by default
+  bool warmStart = true;
+  EXPECT_NO_THROW(warmStart =
+      boost::any_cast<bool>(physics->GetParam("contact_warm_start")));
+  EXPECT_FALSE(warmStart);
+
+  EXPECT_TRUE(physics->SetParam("ignition:contact_warm_start",
+      std::string("true")));
+  EXPECT_NO_THROW(warmStart =
+      boost::any_cast<bool>(physics->GetParam("contact_warm_start")));
+  EXPECT_TRUE(warmStart);
+
+  int iters = boost::any_cast<int>(physics->GetParam("iters"));
+  EXPECT_TRUE(physics->SetParam("iters", iters / 2));
+
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    SpawnBox("box_" + std::to_string(i), ignition::math::Vector3d::One,
+        ignition::math::Vector3d(0, 0, 0.5 + i * 1.01));
+  }
+
+  world->Step(2000);
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    ModelPtr model = world->ModelByName("box_" + std::to_string(i));
+    ASSERT_TRUE(model != nullptr);
+    EXPECT_NEAR(0.5 + i, model->WorldPose().Pos().Z(), 0.02);
+    EXPECT_NEAR(0.0, model->WorldPose().Pos().X(), 0.02);
+    EXPECT_NEAR(0.0, model->WorldPose().Pos().Y(), 0.02);
+  }
+
+  EXPECT_TRUE(physics->SetParam("contact_warm_start", false));
+}
+
+/////////////////////////////////////////////////
+/// Test that separate islands step on the island threads and report their
+/// times
+TEST_F(ODEPhysics_TEST, IslandTimes)
+{
+  Load("worlds/empty.world", true, "ode");
+  WorldPtr world = get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  PhysicsEnginePtr physics = world->Physics();
+  ASSERT_TRUE(physics != nullptr);
+  EXPECT_TRUE(physics->SetParam("island_threads", 2));
+
+  // Boxes apart from each other, each one is an island with its contacts
+  const unsigned int boxCount = 5;
+  for (unsigned int i = 0; i < boxCount; ++i)
+  {
+    SpawnBox("box_" + std::to_string(i), ignition::math::Vector3d::One,
+        ignition::math::Vector3d(i * 3.0, 0, 0.5));
+  }
+
+  world->Step(500);
+  for (unsigned int i = 0; i < boxCount; ++i)
+  {
+    ModelPtr model = world->ModelByName("box_" + std::to_string(i));
+    ASSERT_TRUE(model != nullptr);
+    EXPECT_NEAR(0.5, model->WorldPose().Pos().Z(), 0.01);
+  }
+
+  std::vector<double> times;
+  EXPECT_NO_THROW(times = boost::any_cast<std::vector<double>>(
+      physics->GetParam("island_times")));
+  EXPECT_EQ(boxCount, times.size());
+  for (auto const time : times)
+    EXPECT_GE(time, 0.0);
+
+  EXPECT_TRUE(physics->SetParam("island_threads", 0));
+}
+
+/////////////////////////////////////////////////
+/// Test that a kinematic box moves with its velocity, ignores gravity and
+/// stays out of the islands while it touches nothing dynamic
+TEST_F(ODEPhysics_TEST, KinematicLink)
+{
+  Load("worlds/empty.world", true, "ode");
+  WorldPtr world = get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  PhysicsEnginePtr physics = world->Physics();
+  ASSERT_TRUE(physics != nullptr);
+
+  SpawnBox("platform", ignition::math::Vector3d::One,
+      ignition::math::Vector3d(0, 0, 2));
+  ModelPtr model = world->ModelByName("platform");
+  ASSERT_TRUE(model != nullptr);
+  LinkPtr link = model->GetLink();
+  ASSERT_TRUE(link != nullptr);
+
+  link->SetKinematic(true);
+  EXPECT_TRUE(link->GetKinematic());
+  link->SetLinearVel(ignition::math::Vector3d(1, 0, 0));
+
+  world->Step(1000);
+  const double t = world->SimTime().Double();
+  EXPECT_NEAR(t, model->WorldPose().Pos().X(), 1e-3);
+  EXPECT_NEAR(2.0, model->WorldPose().Pos().Z(), 1e-6);
+
+  std::vector<double> times;
+  EXPECT_NO_THROW(times = boost::any_cast<std::vector<double>>(
+      physics->GetParam("island_times")));
+  EXPECT_TRUE(times.empty());
+
+  // A dynamic box lands on the platform and rides along with it
+  const double x = model->WorldPose().Pos().X();
+  SpawnBox("box", ignition::math::Vector3d(0.2, 0.2, 0.2),
+      ignition::math::Vector3d(x + 0.1, 0, 2.7));
+  world->Step(500);
+  ModelPtr box = world->ModelByName("box");
+  ASSERT_TRUE(box != nullptr);
+  EXPECT_NEAR(2.6, box->WorldPose().Pos().Z(), 0.01);
+  EXPECT_NEAR(1.0, box->WorldLinearVel().X(), 0.05);
+  EXPECT_NEAR(2.0, model->WorldPose().Pos().Z(), 1e-6);
+
+  link->SetKinematic(false);
+  EXPECT_FALSE(link->GetKinematic());
+}
+
+/////////////////////////////////////////////////
+/// Test that collide bitmasks which do not overlap prune the pair in the
+/// broadphase, while the ground still holds both boxes
+TEST_F(ODEPhysics_TEST, CollideBitmaskBroadphase)
+{
+  Load("worlds/empty.world", true, "ode");
+  WorldPtr world = get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  SpawnBox("lower", ignition::math::Vector3d::One,
+      ignition::math::Vector3d(0, 0, 0.5));
+  SpawnBox("upper", ignition::math::Vector3d::One,
+      ignition::math::Vector3d(0, 0, 1.6));
+
+  std::map<std::string, unsigned int> masks = {{"lower", 0x1},
+      {"upper", 0x2}};
+  for (auto const &mask : masks)
+  {
+    ModelPtr model = world->ModelByName(mask.first);
+    ASSERT_TRUE(model != nullptr);
+    CollisionPtr coll = model->GetLink()->GetCollisions()[0];
+    msgs::Collision msg;
+    msg.set_id(coll->GetId());
+    msg.set_name(coll->GetName());
+    msg.mutable_surface()->set_collide_bitmask(mask.second);
+    coll->ProcessMsg(msg);
+
+    ODECollisionPtr odeColl =
+        boost::dynamic_pointer_cast<ODECollision>(coll);
+    ASSERT_TRUE(odeColl != nullptr);
+    EXPECT_EQ((mask.second << 2) | GZ_FIXED_COLLIDE,
+        dGeomGetCategoryBits(odeColl->GetCollisionId()));
+    EXPECT_EQ((mask.second << 2) | GZ_SENSOR_COLLIDE,
+        dGeomGetCollideBits(odeColl->GetCollisionId()));
+  }
+
+  // The upper box falls through the lower one onto the ground
+  world->Step(1000);
+  for (auto const &mask : masks)
+  {
+    ModelPtr model = world->ModelByName(mask.first);
+    EXPECT_NEAR(0.5, model->WorldPose().Pos().Z(), 0.01);
+  }
+}
+
+/////////////////////////////////////////////////
+/// Test that merged static collisions still hold boxes, follow a moved
+/// static model and can be unmerged again
+TEST_F(ODEPhysics_TEST, MergeStatic)
+{
+  Load("worlds/empty.world", true, "ode");
+  WorldPtr world = get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  PhysicsEnginePtr physics = world->Physics();
+  ASSERT_TRUE(physics != nullptr);
+  EXPECT_FALSE(boost::any_cast<bool>(physics->GetParam("merge_static")));
+  EXPECT_TRUE(physics->SetParam("merge_static", true));
+  EXPECT_TRUE(boost::any_cast<bool>(physics->GetParam("merge_static")));
+
+  // Static models spawned after the merge are merged as well
+  for (unsigned int i = 0; i < 4; ++i)
+  {
+    SpawnBox("shelf_" + std::to_string(i), ignition::math::Vector3d::One,
+        ignition::math::Vector3d(i * 3.0, 0, 0.5),
+        ignition::math::Vector3d::Zero, true);
+  }
+  SpawnBox("box", ignition::math::Vector3d::One,
+      ignition::math::Vector3d(3, 0, 1.6));
+
+  world->Step(500);
+  ModelPtr box = world->ModelByName("box");
+  ASSERT_TRUE(box != nullptr);
+  EXPECT_NEAR(1.5, box->WorldPose().Pos().Z(), 0.01);
+
+  // The box falls to the ground once its shelf moved away
+  ModelPtr shelf = world->ModelByName("shelf_1");
+  ASSERT_TRUE(shelf != nullptr);
+  shelf->SetWorldPose(ignition::math::Pose3d(3, 5, 0.5, 0, 0, 0));
+  world->Step(1000);
+  EXPECT_NEAR(0.5, box->WorldPose().Pos().Z(), 0.01);
+
+  // The ground still holds the box without the merge
+  EXPECT_TRUE(physics->SetParam("merge_static", false));
+  world->Step(100);
+  EXPECT_NEAR(0.5, box->WorldPose().Pos().Z(), 0.01);
+}
+
+/////////////////////////////////////////////////
+/// Test that substeps signal the substep event and keep the box resting
+TEST_F(ODEPhysics_TEST, Substeps)
+{
+  Load("worlds/empty.world", true, "ode");
+  WorldPtr world = get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  PhysicsEnginePtr physics = world->Physics();
+  ASSERT_TRUE(physics != nullptr);
+
+  EXPECT_EQ(1, boost::any_cast<int>(physics->GetParam("substeps")));
+  EXPECT_FALSE(physics->SetParam("substeps", 0));
+  EXPECT_TRUE(physics->SetParam("substeps", 4));
+  EXPECT_EQ(4, boost::any_cast<int>(physics->GetParam("substeps")));
+
+  std::vector<common::Time> times;
+  event::ConnectionPtr conn = event::Events::ConnectBeforePhysicsSubstep(
+      [&times](const common::UpdateInfo &_info)
+      {
+        times.push_back(_info.simTime);
+      });
+
+  SpawnBox("box", ignition::math::Vector3d::One,
+      ignition::math::Vector3d(0, 0, 0.5));
+  times.clear();
+
+  const double dt = physics->GetMaxStepSize();
+  world->Step(10);
+  ASSERT_EQ(40u, times.size());
+  for (size_t i = 1; i < times.size(); ++i)
+    EXPECT_NEAR(dt / 4, (times[i] - times[i-1]).Double(), 1e-6);
+
+  world->Step(1000);
+  ModelPtr model = world->ModelByName("box");
+  ASSERT_TRUE(model != nullptr);
+  EXPECT_NEAR(0.5, model->WorldPose().Pos().Z(), 0.01);
+
+  EXPECT_TRUE(physics->SetParam("substeps", 1));
+  times.clear();
+  world->Step(10);
+  EXPECT_TRUE(times.empty());
+}
+
+/////////////////////////////////////////////////
+/// Test that a contact surface function changes the contacts of its
+/// collision, and is no longer called once removed
+TEST_F(ODEPhysics_TEST, ContactSurfaceCallback)
+{
+  Load("worlds/empty.world", true, "ode");
+  WorldPtr world = get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  ODEPhysicsPtr physics =
+      boost::dynamic_pointer_cast<ODEPhysics>(world->Physics());
+  ASSERT_TRUE(physics != nullptr);
+
+  SpawnBox("box", ignition::math::Vector3d::One,
+      ignition::math::Vector3d(0, 0, 0.5));
+  ModelPtr model = world->ModelByName("box");
+  ASSERT_TRUE(model != nullptr);
+  ODECollisionPtr collision = boost::dynamic_pointer_cast<ODECollision>(
+      model->GetLink()->GetCollisions()[0]);
+  ASSERT_TRUE(collision != nullptr);
+
+  world->Step(100);
+  EXPECT_NEAR(0.0, model->WorldPose().Pos().X(), 1e-3);
+
+  // move the surface of the box along the x axis, like a conveyor belt
+  unsigned int calls = 0;
+  bool ownCollision = true;
+  physics->SetContactSurfaceCallback(collision.get(),
+      [&](ODECollision *_collision, ODECollision * /*_other*/,
+          dContact *_contacts, const unsigned int _count)
+      {
+        ++calls;
+        ownCollision = ownCollision && _collision == collision.get();
+        for (unsigned int i = 0; i < _count; ++i)
+        {
+          _contacts[i].fdir1[0] = 1;
+          _contacts[i].fdir1[1] = 0;
+          _contacts[i].fdir1[2] = 0;
+          _contacts[i].surface.mode |= dContactFDir1 | dContactMotion1;
+          _contacts[i].surface.motion1 = 0.5;
+        }
+      });
+
+  world->Step(500);
+  EXPECT_GT(calls, 0u);
+  EXPECT_TRUE(ownCollision);
+  EXPECT_GT(std::abs(model->WorldPose().Pos().X()), 0.1);
+  EXPECT_NEAR(0.5, model->WorldPose().Pos().Z(), 0.01);
+
+  physics->SetContactSurfaceCallback(collision.get(),
+      ODEPhysics::ContactSurfaceCallback());
+  calls = 0;
+  world->Step(10);
+  EXPECT_EQ(0u, calls);
+}
+
 /////////////////////////////////////////////////
 /// Main
 int main(int argc, char **argv)
@@ -141,9 +141,8 @@ void SimbodyLink::ProcessSetGravityMode()
       this->simbodyPhysics->gravity.setBodyIsExcluded(
         this->simbodyPhysics->integ->updAdvancedState(),
         this->masterMobod, !this->gravityMode);
-      // realize system after changing gravity mode
-      this->simbodyPhysics->system.realize(
-        this->simbodyPhysics->integ->getState(), SimTK::Stage::Velocity);
+      // realize system after changing gravity mode, before the next read
+      this->simbodyPhysics->RequestRealize(SimTK::Stage::Velocity);
       this->gravityModeDirty = false;
     }
     else
@@ -160,7 +159,7 @@ bool SimbodyLink::GetGravityMode() const
   if (this->physicsInitialized)
   {
     return this->simbodyPhysics->gravity.getBodyIsExcluded(
-      this->simbodyPhysics->integ->getState(), this->masterMobod);
+      this->simbodyPhysics->RealizedState(), this->masterMobod);
   }
   else
   {
@@ -231,9 +230,8 @@ void SimbodyLink::OnPoseChange()
       //    this->simbodyPhysics->integ->updAdvancedState(),
       //    SimbodyPhysics::Pose2Transform(relPose));
     }
-    // realize system after updating Q's
-    this->simbodyPhysics->system.realize(
-      this->simbodyPhysics->integ->getState(), SimTK::Stage::Position);
+    // realize system after updating Q's, before the next read
+    this->simbodyPhysics->RequestRealize(SimTK::Stage::Position);
   }
 }
 
@@ -311,9 +309,8 @@ void SimbodyLink::ProcessSetLinkStatic()
       this->masterMobod.unlock(
        this->simbodyPhysics->integ->updAdvancedState());
 
-    // re-realize
-    this->simbodyPhysics->system.realize(
-      this->simbodyPhysics->integ->getAdvancedState(), SimTK::Stage::Velocity);
+    // re-realize before the next read
+    this->simbodyPhysics->RequestRealize(SimTK::Stage::Velocity);
   }
   else
   {
@@ -331,11 +328,12 @@ void SimbodyLink::SetEnabled(bool /*_enable*/) const
 //////////////////////////////////////////////////
 void SimbodyLink::SetLinearVel(const ignition::math::Vector3d & _vel)
 {
+  this->ClearKinematicsCache();
+
   this->masterMobod.setUToFitLinearVelocity(
     this->simbodyPhysics->integ->updAdvancedState(),
     SimbodyPhysics::Vector3ToVec3(_vel));
-  this->simbodyPhysics->system.realize(
-    this->simbodyPhysics->integ->getAdvancedState(), SimTK::Stage::Velocity);
+  this->simbodyPhysics->RequestRealize(SimTK::Stage::Velocity);
 }
 
 //////////////////////////////////////////////////
@@ -352,7 +350,7 @@ ignition::math::Vector3d SimbodyLink::WorldLinearVel(
       *this->world->Physics()->GetPhysicsUpdateMutex());
     v = SimbodyPhysics::Vec3ToVector3Ign(
       this->masterMobod.findStationVelocityInGround(
-      this->simbodyPhysics->integ->getState(), station));
+      this->simbodyPhysics->RealizedState(), station));
   }
   else
     gzwarn << "SimbodyLink::WorldLinearVel: simbody physics"
@@ -379,11 +377,11 @@ ignition::math::Vector3d SimbodyLink::WorldLinearVel(
       *this->world->Physics()->GetPhysicsUpdateMutex());
 
     const SimTK::Rotation &R_WL = this->masterMobod.getBodyRotation(
-      this->simbodyPhysics->integ->getState());
+      this->simbodyPhysics->RealizedState());
     SimTK::Vec3 p_B(~R_WL * p_W);
     v = SimbodyPhysics::Vec3ToVector3Ign(
       this->masterMobod.findStationVelocityInGround(
-      this->simbodyPhysics->integ->getState(), p_B));
+      this->simbodyPhysics->RealizedState(), p_B));
   }
   else
     gzwarn << "SimbodyLink::WorldLinearVel: simbody physics"
@@ -403,10 +401,10 @@ ignition::math::Vector3d SimbodyLink::WorldCoGLinearVel() const
     boost::recursive_mutex::scoped_lock lock(
       *this->world->Physics()->GetPhysicsUpdateMutex());
     SimTK::Vec3 station = this->masterMobod.getBodyMassCenterStation(
-       this->simbodyPhysics->integ->getState());
+       this->simbodyPhysics->RealizedState());
     v = SimbodyPhysics::Vec3ToVector3Ign(
       this->masterMobod.findStationVelocityInGround(
-      this->simbodyPhysics->integ->getState(), station));
+      this->simbodyPhysics->RealizedState(), station));
   }
   else
     gzwarn << "SimbodyLink::WorldCoGLinearVel: simbody physics"
@@ -418,11 +416,12 @@ ignition::math::Vector3d SimbodyLink::WorldCoGLinearVel() const
 //////////////////////////////////////////////////
 void SimbodyLink::SetAngularVel(const ignition::math::Vector3d &_vel)
 {
+  this->ClearKinematicsCache();
+
   this->masterMobod.setUToFitAngularVelocity(
     this->simbodyPhysics->integ->updAdvancedState(),
     SimbodyPhysics::Vector3ToVec3(_vel));
-  this->simbodyPhysics->system.realize(
-    this->simbodyPhysics->integ->getAdvancedState(), SimTK::Stage::Velocity);
+  this->simbodyPhysics->RequestRealize(SimTK::Stage::Velocity);
 }
 
 //////////////////////////////////////////////////
@@ -433,7 +432,7 @@ ignition::math::Vector3d SimbodyLink::WorldAngularVel() const
     *this->world->Physics()->GetPhysicsUpdateMutex());
   SimTK::Vec3 w =
     this->masterMobod.getBodyAngularVelocity(
-    this->simbodyPhysics->integ->getState());
+    this->simbodyPhysics->RealizedState());
   return SimbodyPhysics::Vec3ToVector3Ign(w);
 }
 
@@ -451,7 +450,7 @@ void SimbodyLink::SetForce(const ignition::math::Vector3d &_force)
 ignition::math::Vector3d SimbodyLink::WorldForce() const
 {
   SimTK::SpatialVec sv = this->simbodyPhysics->discreteForces.getOneBodyForce(
-    this->simbodyPhysics->integ->getState(), this->masterMobod);
+    this->simbodyPhysics->RealizedState(), this->masterMobod);
 
   // get translational component
   SimTK::Vec3 f = sv[1];
@@ -473,7 +472,7 @@ void SimbodyLink::SetTorque(const ignition::math::Vector3d &_torque)
 ignition::math::Vector3d SimbodyLink::WorldTorque() const
 {
   SimTK::SpatialVec sv = this->simbodyPhysics->discreteForces.getOneBodyForce(
-    this->simbodyPhysics->integ->getState(), this->masterMobod);
+    this->simbodyPhysics->RealizedState(), this->masterMobod);
 
   // get rotational component
   SimTK::Vec3 t = sv[0];
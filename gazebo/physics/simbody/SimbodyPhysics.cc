@@ -56,6 +56,7 @@
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Exception.hh"
+#include "gazebo/common/Tracer.hh"
 
 #include "gazebo/transport/Publisher.hh"
 
@@ -199,6 +200,7 @@ void SimbodyPhysics::OnRequest(ConstRequestPtr &_msg)
     physicsMsg.set_real_time_update_rate(this->realTimeUpdateRate);
     physicsMsg.set_real_time_factor(this->targetRealTimeFactor);
     physicsMsg.set_max_step_size(this->maxStepSize);
+    physicsMsg.set_model_update_threads(this->world->ModelUpdateThreads());
 
     response.set_type(physicsMsg.GetTypeName());
     physicsMsg.SerializeToString(serializedData);
@@ -251,6 +253,8 @@ void SimbodyPhysics::OnPhysicsMsg(ConstPhysicsPtr &_msg)
 //////////////////////////////////////////////////
 void SimbodyPhysics::Reset()
 {
+  // The topology of the system is kept, only the state is reinitialized
+  this->pendingRealizeStage = SimTK::Stage::Empty;
   this->integ->initialize(this->system.getDefaultState());
 
   // restore potentially user run-time modified gravity
@@ -268,7 +272,7 @@ void SimbodyPhysics::InitModel(const physics::ModelPtr _model)
 {
   // Before building a new system, transfer all joints in existing
   // models, save Simbody joint states in Gazebo Model.
-  const SimTK::State& currentState = this->integ->getState();
+  const SimTK::State& currentState = this->RealizedState();
   double stateTime = 0;
   bool simbodyStateSaved = false;
 
@@ -371,6 +375,7 @@ void SimbodyPhysics::InitModel(const physics::ModelPtr _model)
   }
 
   // initialize integrator from state
+  this->pendingRealizeStage = SimTK::Stage::Empty;
   this->integ->initialize(state);
 
   // mark links as initialized
@@ -413,13 +418,14 @@ void SimbodyPhysics::InitForThread()
 void SimbodyPhysics::UpdateCollision()
 {
   IGN_PROFILE("SimbodyPhysics::UpdateCollision");
+  GZ_TRACE_SCOPE("physics::SimbodyPhysics::UpdateCollision");
   IGN_PROFILE_BEGIN("UpdateCollision");
   boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
 
   this->contactManager->ResetCount();
 
   // Get all contacts from Simbody
-  const SimTK::State &state = this->integ->getState();
+  const SimTK::State &state = this->RealizedState();
 
   // The tracker cannot generate a snapshot without a subsystem
   if (state.getNumSubsystems() == 0)
@@ -518,6 +524,8 @@ void SimbodyPhysics::UpdateCollision()
               }
               // gzerr << "count: " << count << "\n";
 
+              contactFeedback->SetCapacity(count + 1);
+
               // get detail
               const SimTK::ContactDetail &detail = patch.getContactDetail(i);
               // get contact information from simbody and
@@ -644,6 +652,7 @@ void SimbodyPhysics::UpdateCollision()
 void SimbodyPhysics::UpdatePhysics()
 {
   IGN_PROFILE("SimbodyPhysics::UpdatePhysics");
+  GZ_TRACE_SCOPE("physics::SimbodyPhysics::UpdatePhysics");
   IGN_PROFILE_BEGIN("UpdatePhysics");
 
   // need to lock, otherwise might conflict with world resetting
@@ -652,7 +661,7 @@ void SimbodyPhysics::UpdatePhysics()
   common::Time currTime =  this->world->RealTime();
 
   // Simbody cannot step the integrator without a subsystem
-  const SimTK::State &s = this->integ->getState();
+  const SimTK::State &s = this->RealizedState();
   if (s.getNumSubsystems() == 0)
     return;
 
@@ -685,11 +694,11 @@ void SimbodyPhysics::UpdatePhysics()
 
   // pushing new entity pose into dirtyPoses for visualization
   physics::Model_V models = this->world->Models();
-  for (physics::Model_V::iterator mi = models.begin();
+  for (physics::Model_V::const_iterator mi = models.begin();
        mi != models.end(); ++mi)
   {
-    physics::Link_V links = (*mi)->GetLinks();
-    for (physics::Link_V::iterator lx = links.begin();
+    const physics::Link_V &links = (*mi)->GetLinks();
+    for (physics::Link_V::const_iterator lx = links.begin();
          lx != links.end(); ++lx)
     {
       physics::SimbodyLinkPtr simbodyLink =
@@ -701,8 +710,8 @@ void SimbodyPhysics::UpdatePhysics()
         boost::static_pointer_cast<Entity>(*lx).get());
     }
 
-    physics::Joint_V joints = (*mi)->GetJoints();
-    for (physics::Joint_V::iterator jx = joints.begin();
+    const physics::Joint_V &joints = (*mi)->GetJoints();
+    for (physics::Joint_V::const_iterator jx = joints.begin();
          jx != joints.end(); ++jx)
     {
       SimbodyJointPtr simbodyJoint =
@@ -808,6 +817,31 @@ JointPtr SimbodyPhysics::CreateJoint(const std::string &_type,
   return joint;
 }
 
+//////////////////////////////////////////////////
+void SimbodyPhysics::RequestRealize(const SimTK::Stage &_stage)
+{
+  if (_stage > this->pendingRealizeStage)
+    this->pendingRealizeStage = _stage;
+}
+
+//////////////////////////////////////////////////
+void SimbodyPhysics::RealizePending()
+{
+  if (this->pendingRealizeStage == SimTK::Stage::Empty)
+    return;
+
+  this->system.realize(this->integ->getAdvancedState(),
+      this->pendingRealizeStage);
+  this->pendingRealizeStage = SimTK::Stage::Empty;
+}
+
+//////////////////////////////////////////////////
+const SimTK::State &SimbodyPhysics::RealizedState()
+{
+  this->RealizePending();
+  return this->integ->getState();
+}
+
 //////////////////////////////////////////////////
 void SimbodyPhysics::SetGravity(const ignition::math::Vector3d &_gravity)
 {
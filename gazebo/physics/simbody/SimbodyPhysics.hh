@@ -93,6 +93,23 @@ namespace gazebo
       /// \brief Register a joint with the dynamics world
       public: SimTK::MultibodySystem *GetDynamicsWorld() const;
 
+      /// \brief Request a realization of the state of the integrator after
+      /// it was modified. Requests are accumulated and the state is
+      /// realized once, up to the highest stage requested, before it is
+      /// read or stepped. This lets many pose and velocity changes, e.g.
+      /// when teleporting models, share a single realization.
+      /// \param[in] _stage Stage the state must be realized to.
+      public: void RequestRealize(const SimTK::Stage &_stage);
+
+      /// \brief Realize the state of the integrator up to the highest
+      /// stage requested with RequestRealize, if any.
+      public: void RealizePending();
+
+      /// \brief Get the state of the integrator, realized up to the
+      /// stages requested with RequestRealize.
+      /// \return State of the integrator.
+      public: const SimTK::State &RealizedState();
+
       // Documentation inherited
       public: virtual void SetGravity(const ignition::math::Vector3d &_gravity);
 
@@ -282,6 +299,10 @@ namespace gazebo
       ///   SimTK::RungeKutta2Integrator(system)
       ///   SimTK::SemiExplicitEuler2Integrator(system)
       private: std::string integratorType;
+
+      /// \brief Highest stage requested with RequestRealize since the
+      /// state was last realized.
+      private: SimTK::Stage pendingRealizeStage = SimTK::Stage::Empty;
     };
   /// \}
   }
@@ -73,7 +73,7 @@ double SimbodyUniversalJoint::GetVelocity(unsigned int _index) const
         this->simbodyPhysics->simbodyPhysicsInitialized)
     {
       return this->mobod.getOneU(
-        this->simbodyPhysics->integ->getState(),
+        this->simbodyPhysics->RealizedState(),
         SimTK::MobilizerUIndex(_index));
     }
     else
@@ -100,8 +100,7 @@ void SimbodyUniversalJoint::SetVelocity(unsigned int _index,
     this->mobod.setOneU(
       this->simbodyPhysics->integ->updAdvancedState(),
       SimTK::MobilizerUIndex(_index), _rate);
-    this->simbodyPhysics->system.realize(
-      this->simbodyPhysics->integ->getAdvancedState(), SimTK::Stage::Velocity);
+    this->simbodyPhysics->RequestRealize(SimTK::Stage::Velocity);
   }
   else
   {
@@ -135,11 +134,11 @@ ignition::math::Vector3d SimbodyUniversalJoint::GlobalAxis(
       {
         // express X-axis of X_IF in world frame
         const SimTK::Transform &X_IF = this->mobod.getInboardFrame(
-          this->simbodyPhysics->integ->getState());
+          this->simbodyPhysics->RealizedState());
 
         SimTK::Vec3 x_W(
           this->mobod.getParentMobilizedBody().expressVectorInGroundFrame(
-          this->simbodyPhysics->integ->getState(), X_IF.x()));
+          this->simbodyPhysics->RealizedState(), X_IF.x()));
 
         return SimbodyPhysics::Vec3ToVector3Ign(x_W);
       }
@@ -147,11 +146,11 @@ ignition::math::Vector3d SimbodyUniversalJoint::GlobalAxis(
       {
         // express Y-axis of X_OM in world frame
         const SimTK::Transform &X_OM = this->mobod.getOutboardFrame(
-          this->simbodyPhysics->integ->getState());
+          this->simbodyPhysics->RealizedState());
 
         SimTK::Vec3 y_W(
           this->mobod.expressVectorInGroundFrame(
-          this->simbodyPhysics->integ->getState(), X_OM.y()));
+          this->simbodyPhysics->RealizedState(), X_OM.y()));
 
         return SimbodyPhysics::Vec3ToVector3Ign(y_W);
       }
@@ -202,7 +201,7 @@ double SimbodyUniversalJoint::PositionImpl(const unsigned int _index) const
       if (!this->mobod.isEmptyHandle())
       {
         return this->mobod.getOneQ(
-          this->simbodyPhysics->integ->getState(), _index);
+          this->simbodyPhysics->RealizedState(), _index);
       }
       else
       {
@@ -15,8 +15,19 @@
  *
 */
 
+#include <algorithm>
+#include <chrono>
 #include <sstream>
 
+#if defined(HAVE_OPENGL) && defined(__linux__)
+  #define GL_GLEXT_PROTOTYPES
+  #include <GL/gl.h>
+  #include <GL/glext.h>
+  #if defined(GL_PIXEL_PACK_BUFFER)
+    #define GAZEBO_CAMERA_PBO
+  #endif
+#endif
+
 #include <boost/algorithm/string.hpp>
 #include <boost/filesystem.hpp>
 #include <boost/format.hpp>
@@ -37,6 +48,7 @@
 #include "gazebo/common/Events.hh"
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Exception.hh"
+#include "gazebo/common/Tracer.hh"
 #include "gazebo/common/VideoEncoder.hh"
 
 #include "gazebo/rendering/ogre_gazebo.h"
@@ -56,6 +68,219 @@ using namespace rendering;
 
 unsigned int CameraPrivate::cameraCounter = 0;
 
+namespace gazebo
+{
+  namespace rendering
+  {
+    /// \brief Measures the culling of the scene for a camera: the time the
+    /// scene manager takes to find the visible objects, and the number of
+    /// renderables it queued, counted once per pass. The shadow maps are
+    /// not included.
+    class CameraCullingListener
+      : public Ogre::SceneManager::Listener,
+        public Ogre::QueuedRenderableVisitor
+    {
+      /// \brief Constructor.
+      /// \param[in] _camera Camera whose views are measured.
+      public: explicit CameraCullingListener(Ogre::Camera *_camera)
+              : camera(_camera)
+      {
+      }
+
+      // Documentation inherited
+      public: virtual void preFindVisibleObjects(Ogre::SceneManager *,
+                  Ogre::SceneManager::IlluminationRenderStage _irs,
+                  Ogre::Viewport *_viewport)
+              {
+                this->measuring = _irs == Ogre::SceneManager::IRS_NONE &&
+                  _viewport && _viewport->getCamera() == this->camera;
+                if (this->measuring)
+                  this->start = std::chrono::steady_clock::now();
+              }
+
+      // Documentation inherited
+      public: virtual void postFindVisibleObjects(
+                  Ogre::SceneManager *_manager,
+                  Ogre::SceneManager::IlluminationRenderStage,
+                  Ogre::Viewport *)
+              {
+                if (!this->measuring)
+                  return;
+                this->measuring = false;
+                this->cullingTime = std::chrono::duration<double>(
+                    std::chrono::steady_clock::now() - this->start).count();
+
+                // The collections fall back to the mode they are sorted in
+                const auto mode =
+                  Ogre::QueuedRenderableCollection::OM_PASS_GROUP;
+                this->queued = 0;
+                auto groups =
+                  _manager->getRenderQueue()->_getQueueGroupIterator();
+                while (groups.hasMoreElements())
+                {
+                  auto priorities = groups.getNext()->getIterator();
+                  while (priorities.hasMoreElements())
+                  {
+                    Ogre::RenderPriorityGroup *group = priorities.getNext();
+                    group->getSolidsBasic().acceptVisitor(this, mode);
+                    group->getSolidsDiffuseSpecular().acceptVisitor(this,
+                        mode);
+                    group->getSolidsDecal().acceptVisitor(this, mode);
+                    group->getSolidsNoShadowReceive().acceptVisitor(this,
+                        mode);
+                    group->getTransparentsUnsorted().acceptVisitor(this,
+                        mode);
+                    group->getTransparents().acceptVisitor(this, mode);
+                  }
+                }
+              }
+
+      // Documentation inherited
+      public: virtual void visit(Ogre::RenderablePass *)
+              {
+                ++this->queued;
+              }
+
+      // Documentation inherited
+      public: virtual bool visit(const Ogre::Pass *)
+              {
+                return true;
+              }
+
+      // Documentation inherited
+      public: virtual void visit(Ogre::Renderable *)
+              {
+                ++this->queued;
+              }
+
+      /// \brief Camera whose views are measured.
+      public: Ogre::Camera *camera;
+
+      /// \brief True between the start and the end of a search for the
+      /// visible objects of the camera.
+      public: bool measuring = false;
+
+      /// \brief Start of the search.
+      public: std::chrono::steady_clock::time_point start;
+
+      /// \brief Duration of the last search, in seconds.
+      public: double cullingTime = 0.0;
+
+      /// \brief Number of renderables queued by the last search.
+      public: unsigned int queued = 0;
+    };
+
+    /// \brief Listener that points the Bayer compositor at the image of a
+    /// camera, and sets the position of the red pixels of the mosaic.
+    class BayerCompositorListener
+      : public Ogre::CompositorInstance::Listener
+    {
+      /// \brief Constructor.
+      /// \param[in] _textureName Name of the RGB texture of the camera.
+      /// \param[in] _width Image width.
+      /// \param[in] _height Image height.
+      /// \param[in] _format Gazebo image format, one of BAYER_*.
+      public: BayerCompositorListener(const std::string &_textureName,
+                  const unsigned int _width, const unsigned int _height,
+                  const std::string &_format)
+              : textureName(_textureName), size(_width, _height)
+      {
+        // Column and row parity of the red pixels, as in
+        // Camera::ConvertRGBToBAYER
+        if (_format == "BAYER_BGGR8")
+          this->redOffset = Ogre::Vector2(1, 1);
+        else if (_format == "BAYER_GBRG8")
+          this->redOffset = Ogre::Vector2(1, 0);
+        else if (_format == "BAYER_GRBG8")
+          this->redOffset = Ogre::Vector2(0, 1);
+        else
+          this->redOffset = Ogre::Vector2(0, 0);
+      }
+
+      /// \brief Callback that OGRE will invoke for us on each render call
+      /// \param[in] _passID OGRE material pass ID.
+      /// \param[in] _mat Pointer to OGRE material.
+      public: virtual void notifyMaterialRender(unsigned int _passId,
+                                                Ogre::MaterialPtr &_mat)
+      {
+        GZ_ASSERT(!_mat.isNull(), "Null OGRE material");
+        Ogre::Technique *technique = _mat->getTechnique(0);
+        GZ_ASSERT(technique, "Null OGRE material technique");
+        Ogre::Pass *pass = technique->getPass(_passId);
+        GZ_ASSERT(pass, "Null OGRE material pass");
+
+        // These parameters are declared in
+        // media/materials/programs/camera_bayer_fs.glsl
+        Ogre::TextureUnitState *unit = pass->getTextureUnitState(0);
+        if (unit->getTextureName() != this->textureName)
+          unit->setTextureName(this->textureName);
+
+        Ogre::GpuProgramParametersSharedPtr params =
+            pass->getFragmentProgramParameters();
+        GZ_ASSERT(!params.isNull(), "Null OGRE material GPU parameters");
+        params->setNamedConstant("size", this->size);
+        params->setNamedConstant("redOffset", this->redOffset);
+      }
+
+      /// \brief Name of the RGB texture of the camera.
+      private: std::string textureName;
+
+      /// \brief Image size in pixels.
+      private: Ogre::Vector2 size;
+
+      /// \brief Column and row parity of the red pixels.
+      private: Ogre::Vector2 redOffset;
+    };
+  }
+}
+
+#ifdef GAZEBO_CAMERA_PBO
+//////////////////////////////////////////////////
+/// \brief Get the OpenGL format and type of a pixel format, in the byte
+/// order of Ogre::PixelUtil memory.
+/// \param[in] _format The pixel format.
+/// \param[out] _glFormat The OpenGL format.
+/// \param[out] _glType The OpenGL type.
+/// \return False if the format is not supported.
+static bool GLPixelFormat(const Ogre::PixelFormat _format, GLenum &_glFormat,
+    GLenum &_glType)
+{
+  switch (_format)
+  {
+    case Ogre::PF_BYTE_RGB:
+      _glFormat = GL_RGB;
+      _glType = GL_UNSIGNED_BYTE;
+      return true;
+    case Ogre::PF_BYTE_BGR:
+      _glFormat = GL_BGR;
+      _glType = GL_UNSIGNED_BYTE;
+      return true;
+    case Ogre::PF_BYTE_RGBA:
+      _glFormat = GL_RGBA;
+      _glType = GL_UNSIGNED_BYTE;
+      return true;
+    case Ogre::PF_BYTE_BGRA:
+      _glFormat = GL_BGRA;
+      _glType = GL_UNSIGNED_BYTE;
+      return true;
+    case Ogre::PF_L8:
+      _glFormat = GL_RED;
+      _glType = GL_UNSIGNED_BYTE;
+      return true;
+    case Ogre::PF_L16:
+      _glFormat = GL_RED;
+      _glType = GL_UNSIGNED_SHORT;
+      return true;
+    case Ogre::PF_FLOAT32_R:
+      _glFormat = GL_RED;
+      _glType = GL_FLOAT;
+      return true;
+    default:
+      return false;
+  }
+}
+#endif
+
 //////////////////////////////////////////////////
 Camera::Camera(const std::string &_name, ScenePtr _scene,
                bool _autoRender)
@@ -129,6 +354,18 @@ Camera::~Camera()
 //////////////////////////////////////////////////
 void Camera::Load(sdf::ElementPtr _sdf)
 {
+  const std::string kElementName = "ignition:readback_latency";
+  if (_sdf->HasElement(kElementName))
+    this->SetReadbackLatency(_sdf->Get<unsigned int>(kElementName));
+
+  const std::string kConversionName = "ignition:gpu_conversion";
+  if (_sdf->HasElement(kConversionName))
+    this->SetGpuImageConversion(_sdf->Get<bool>(kConversionName));
+
+  const std::string kLodBiasName = "ignition:lod_bias";
+  if (_sdf->HasElement(kLodBiasName))
+    this->SetLodBias(_sdf->Get<double>(kLodBiasName));
+
   this->sdf->Copy(_sdf);
   this->Load();
 }
@@ -354,6 +591,14 @@ void Camera::Fini()
 {
   this->dataPtr->videoEncoder.Reset();
 
+#ifdef GAZEBO_CAMERA_PBO
+  if (this->dataPtr->pbos[0] != 0)
+    glDeleteBuffers(2, this->dataPtr->pbos);
+#endif
+  this->dataPtr->pbos[0] = this->dataPtr->pbos[1] = 0;
+  this->dataPtr->pboSize = 0;
+  this->dataPtr->pboPending = false;
+
   if (this->saveFrameBuffer)
     delete [] this->saveFrameBuffer;
   this->saveFrameBuffer = NULL;
@@ -375,6 +620,26 @@ void Camera::Fini()
   if (this->viewport && this->scene)
     RTShaderSystem::DetachViewport(this->viewport, this->scene);
 
+  if (this->dataPtr->bayerTexture)
+  {
+    Ogre::RenderTarget *bayerTarget =
+        this->dataPtr->bayerTexture->getBuffer()->getRenderTarget();
+    if (this->dataPtr->bayerInstance)
+    {
+      this->dataPtr->bayerInstance->removeListener(
+          this->dataPtr->bayerListener.get());
+      Ogre::CompositorManager::getSingleton().removeCompositor(
+          bayerTarget->getViewport(0), "CameraBayer/Mosaic");
+    }
+    bayerTarget->removeAllViewports();
+    Ogre::TextureManager::getSingleton().remove(
+        this->dataPtr->bayerTexture->getName());
+  }
+  this->dataPtr->bayerInstance = nullptr;
+  this->dataPtr->bayerTexture = nullptr;
+  this->dataPtr->bayerListener.reset();
+  this->dataPtr->bayerSetup = false;
+
   if (this->renderTarget)
     this->renderTarget->removeAllViewports();
   this->renderTarget = NULL;
@@ -383,6 +648,13 @@ void Camera::Fini()
     Ogre::TextureManager::getSingleton().remove(this->renderTexture->getName());
   this->renderTexture = NULL;
 
+  if (this->dataPtr->cullingListener)
+  {
+    this->scene->OgreSceneManager()->removeListener(
+        this->dataPtr->cullingListener.get());
+    this->dataPtr->cullingListener.reset();
+  }
+
   if (this->camera)
   {
     this->scene->OgreSceneManager()->destroyCamera(this->scopedUniqueName);
@@ -555,6 +827,7 @@ void Camera::Update()
 void Camera::Render(const bool _force)
 {
   IGN_PROFILE("rendering::Camera::Render");
+  GZ_TRACE_SCOPE("rendering::Camera::Render");
   if (this->initialized && (_force ||
        common::Time::GetWallTime() - this->lastRenderWallTime >=
         this->dataPtr->renderPeriod))
@@ -575,7 +848,9 @@ void Camera::RenderImpl()
     }
     {
       IGN_PROFILE("rendering::Camera::RenderImpl update");
+      const bool reused = this->scene->BeginCameraRender(this->viewport);
       this->renderTarget->update();
+      this->scene->EndCameraRender(this->viewport, reused);
     }
     {
       IGN_PROFILE("rendering::Camera::RenderImpl post-render");
@@ -594,6 +869,33 @@ void Camera::ReadPixelBuffer()
     unsigned int width = this->ImageWidth();
     unsigned int height = this->ImageHeight();
 
+    // A Bayer mosaic rendered on the GPU is read at one byte per pixel
+    this->dataPtr->gpuBayerFrame = this->GpuBayerReady();
+    if (this->dataPtr->gpuBayerFrame)
+    {
+      IGN_PROFILE("rendering::Camera::ReadPixelBuffer bayer");
+      Ogre::RenderTarget *bayerTarget =
+          this->dataPtr->bayerTexture->getBuffer()->getRenderTarget();
+      bayerTarget->update();
+
+      size = Ogre::PixelUtil::getMemorySize(width, height, 1, Ogre::PF_L8);
+      if (!this->bayerFrameBuffer)
+        this->bayerFrameBuffer = new unsigned char[size];
+
+      if (this->dataPtr->readbackLatency > 0 &&
+          this->ReadPixelBufferAsync(this->dataPtr->bayerTexture,
+            Ogre::PF_L8, this->bayerFrameBuffer, size))
+      {
+        return;
+      }
+
+      this->dataPtr->readbackReady = true;
+      Ogre::PixelBox box(width, height, 1, Ogre::PF_L8,
+          this->bayerFrameBuffer);
+      bayerTarget->copyContentsToMemory(box);
+      return;
+    }
+
     // Get access to the buffer and make an image and write it to file
     size = Ogre::PixelUtil::getMemorySize(width, height, 1,
         static_cast<Ogre::PixelFormat>(this->imageFormat));
@@ -602,6 +904,17 @@ void Camera::ReadPixelBuffer()
     if (!this->saveFrameBuffer)
       this->saveFrameBuffer = new unsigned char[size];
 
+    // Only for cameras that render into their texture
+    if (this->dataPtr->readbackLatency > 0 && this->renderTexture &&
+        this->renderTexture->getBuffer()->getRenderTarget() ==
+        this->renderTarget &&
+        this->ReadPixelBufferAsync(this->renderTexture, this->imageFormat,
+          this->saveFrameBuffer, size))
+    {
+      return;
+    }
+
+    this->dataPtr->readbackReady = true;
     memset(this->saveFrameBuffer, 128, size);
 
     Ogre::PixelBox box(width, height, 1,
@@ -654,6 +967,219 @@ void Camera::ReadPixelBuffer()
   }
 }
 
+//////////////////////////////////////////////////
+bool Camera::ReadPixelBufferAsync(Ogre::Texture *_texture,
+    const int _format, unsigned char *_dst, const size_t _size)
+{
+#ifdef GAZEBO_CAMERA_PBO
+  // Only with OpenGL
+  GLenum glFormat, glType;
+  if (!GLPixelFormat(static_cast<Ogre::PixelFormat>(_format),
+        glFormat, glType) ||
+      Ogre::Root::getSingleton().getRenderSystem()->getName().find(
+        "OpenGL") == std::string::npos)
+  {
+    return false;
+  }
+
+  IGN_PROFILE("rendering::Camera::ReadPixelBufferAsync");
+
+  // (Re)create the buffers for the image size
+  if (this->dataPtr->pbos[0] == 0 || this->dataPtr->pboSize != _size)
+  {
+    if (this->dataPtr->pbos[0] != 0)
+      glDeleteBuffers(2, this->dataPtr->pbos);
+    glGenBuffers(2, this->dataPtr->pbos);
+    for (auto pbo : this->dataPtr->pbos)
+    {
+      glBindBuffer(GL_PIXEL_PACK_BUFFER, pbo);
+      glBufferData(GL_PIXEL_PACK_BUFFER, _size, nullptr, GL_STREAM_READ);
+    }
+    this->dataPtr->pboSize = _size;
+    this->dataPtr->pboIndex = 0;
+    this->dataPtr->pboPending = false;
+  }
+
+  GLint alignment;
+  glGetIntegerv(GL_PACK_ALIGNMENT, &alignment);
+  glPixelStorei(GL_PACK_ALIGNMENT, 1);
+
+  // Start the copy of this frame, which returns without waiting
+  GLuint texId = 0;
+  _texture->getCustomAttribute("GLID", &texId);
+  glBindTexture(GL_TEXTURE_2D, texId);
+  glBindBuffer(GL_PIXEL_PACK_BUFFER,
+      this->dataPtr->pbos[this->dataPtr->pboIndex]);
+  glGetTexImage(GL_TEXTURE_2D, 0, glFormat, glType, nullptr);
+
+  // Copy the previous frame, which had a whole frame to arrive
+  this->dataPtr->readbackReady = false;
+  if (this->dataPtr->pboPending)
+  {
+    glBindBuffer(GL_PIXEL_PACK_BUFFER,
+        this->dataPtr->pbos[1 - this->dataPtr->pboIndex]);
+    const void *data = glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
+    if (data)
+    {
+      memcpy(_dst, data, _size);
+      glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+      this->dataPtr->readbackReady = true;
+    }
+  }
+
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+  glBindTexture(GL_TEXTURE_2D, 0);
+  glPixelStorei(GL_PACK_ALIGNMENT, alignment);
+
+  this->dataPtr->pboPending = true;
+  this->dataPtr->pboIndex = 1 - this->dataPtr->pboIndex;
+  return true;
+#else
+  (void)_texture;
+  (void)_format;
+  (void)_dst;
+  (void)_size;
+  return false;
+#endif
+}
+
+//////////////////////////////////////////////////
+void Camera::SetReadbackLatency(const unsigned int _frames)
+{
+  if (_frames > 1)
+  {
+    gzwarn << "Readback latency of camera[" << this->Name() << "] is "
+      << "limited to 1 frame" << std::endl;
+  }
+  this->dataPtr->readbackLatency = std::min(_frames, 1u);
+  this->dataPtr->pboPending = false;
+}
+
+//////////////////////////////////////////////////
+unsigned int Camera::ReadbackLatency() const
+{
+  return this->dataPtr->readbackLatency;
+}
+
+//////////////////////////////////////////////////
+void Camera::SetGpuImageConversion(const bool _enabled)
+{
+  this->dataPtr->gpuConversion = _enabled;
+}
+
+//////////////////////////////////////////////////
+bool Camera::GpuImageConversion() const
+{
+  return this->dataPtr->gpuConversion;
+}
+
+//////////////////////////////////////////////////
+void Camera::SetLodBias(const double _bias)
+{
+  if (!(_bias > 0))
+  {
+    gzerr << "Invalid level of detail bias[" << _bias
+          << "], it must be positive" << std::endl;
+    return;
+  }
+
+  this->dataPtr->lodBias = _bias;
+  if (this->camera)
+    this->camera->setLodBias(_bias);
+}
+
+//////////////////////////////////////////////////
+double Camera::LodBias() const
+{
+  return this->dataPtr->lodBias;
+}
+
+//////////////////////////////////////////////////
+bool Camera::GpuBayerReady()
+{
+  const std::string format = this->ImageFormat();
+  if (!this->dataPtr->gpuConversion ||
+      (format != "BAYER_RGGB8" && format != "BAYER_BGGR8" &&
+       format != "BAYER_GBRG8" && format != "BAYER_GRBG8"))
+  {
+    return false;
+  }
+
+  // Saved and encoded frames need the RGB image
+  if (this->captureDataOnce || this->dataPtr->videoEncoder.IsEncoding() ||
+      (this->sdf->HasElement("save") &&
+       this->sdf->GetElement("save")->Get<bool>("enabled")))
+  {
+    return false;
+  }
+
+  if (!this->dataPtr->bayerSetup)
+  {
+    this->dataPtr->bayerSetup = true;
+
+    // Only for cameras that render into their texture
+    if (!this->renderTexture || !this->renderTarget ||
+        this->renderTexture->getBuffer()->getRenderTarget() !=
+        this->renderTarget)
+    {
+      return false;
+    }
+
+    if (!Ogre::CompositorManager::getSingleton().resourceExists(
+          "CameraBayer/Mosaic"))
+    {
+      gzwarn << "Bayer compositor not found, camera[" << this->Name()
+        << "] converts its image on the CPU" << std::endl;
+      return false;
+    }
+
+    this->dataPtr->bayerTexture =
+      (Ogre::TextureManager::getSingleton().createManual(
+        this->renderTexture->getName() + "_bayer",
+        "General",
+        Ogre::TEX_TYPE_2D,
+        this->ImageWidth(),
+        this->ImageHeight(),
+        0,
+        Ogre::PF_L8,
+        Ogre::TU_RENDERTARGET)).getPointer();
+
+    // The compositor draws a quad only, the scene is not rendered again
+    Ogre::RenderTarget *bayerTarget =
+        this->dataPtr->bayerTexture->getBuffer()->getRenderTarget();
+    bayerTarget->setAutoUpdated(false);
+    Ogre::Viewport *vp = bayerTarget->addViewport(this->camera);
+    vp->setClearEveryFrame(false);
+    vp->setShadowsEnabled(false);
+    vp->setOverlaysEnabled(false);
+    vp->setSkiesEnabled(false);
+    vp->setVisibilityMask(0);
+
+    this->dataPtr->bayerInstance =
+      Ogre::CompositorManager::getSingleton().addCompositor(vp,
+          "CameraBayer/Mosaic");
+    if (!this->dataPtr->bayerInstance)
+    {
+      gzwarn << "Unable to add the Bayer compositor, camera["
+        << this->Name() << "] converts its image on the CPU" << std::endl;
+      bayerTarget->removeAllViewports();
+      Ogre::TextureManager::getSingleton().remove(
+          this->dataPtr->bayerTexture->getName());
+      this->dataPtr->bayerTexture = nullptr;
+      return false;
+    }
+
+    this->dataPtr->bayerListener.reset(new BayerCompositorListener(
+          this->renderTexture->getName(), this->ImageWidth(),
+          this->ImageHeight(), format));
+    this->dataPtr->bayerInstance->addListener(
+        this->dataPtr->bayerListener.get());
+    this->dataPtr->bayerInstance->setEnabled(true);
+  }
+
+  return this->dataPtr->bayerTexture != nullptr;
+}
+
 //////////////////////////////////////////////////
 common::Time Camera::LastRenderWallTime() const
 {
@@ -664,6 +1190,7 @@ common::Time Camera::LastRenderWallTime() const
 void Camera::PostRender()
 {
   IGN_PROFILE("rendering::Camera::PostRender");
+  GZ_TRACE_SCOPE("rendering::Camera::PostRender");
   this->ReadPixelBuffer();
 
   // Only record last render time if data was actually generated
@@ -671,7 +1198,9 @@ void Camera::PostRender()
   if (this->newData)
     this->lastRenderWallTime = common::Time::GetWallTime();
 
-  if (this->newData && (this->captureData || this->captureDataOnce ||
+  // With an asynchronous readback the first frame has no data yet
+  if (this->newData && this->dataPtr->readbackReady &&
+      (this->captureData || this->captureDataOnce ||
       this->dataPtr->videoEncoder.IsEncoding()))
   {
     unsigned int width = this->ImageWidth();
@@ -695,7 +1224,12 @@ void Camera::PostRender()
     }
 
     // do last minute conversion if Bayer pattern is requested, go from R8G8B8
-    if ((this->ImageFormat() == "BAYER_RGGB8") ||
+    if (this->dataPtr->gpuBayerFrame)
+    {
+      // Already converted on the GPU
+      buffer = this->bayerFrameBuffer;
+    }
+    else if ((this->ImageFormat() == "BAYER_RGGB8") ||
          (this->ImageFormat() == "BAYER_BGGR8") ||
          (this->ImageFormat() == "BAYER_GBRG8") ||
          (this->ImageFormat() == "BAYER_GRBG8"))
@@ -1030,6 +1564,28 @@ int Camera::OgrePixelFormat(const std::string &_format)
   return result;
 }
 
+//////////////////////////////////////////////////
+bool Camera::HasFrameListeners() const
+{
+  return this->newImageFrame.ConnectionCount() > 0 || this->captureDataOnce ||
+    this->dataPtr->videoEncoder.IsEncoding() ||
+    (this->sdf->HasElement("save") &&
+     this->sdf->GetElement("save")->Get<bool>("enabled"));
+}
+
+//////////////////////////////////////////////////
+void Camera::SetShadowsEnabled(const bool _enabled)
+{
+  if (this->viewport)
+    this->viewport->setShadowsEnabled(_enabled);
+}
+
+//////////////////////////////////////////////////
+bool Camera::ShadowsEnabled() const
+{
+  return this->viewport && this->viewport->getShadowsEnabled();
+}
+
 //////////////////////////////////////////////////
 void Camera::EnableSaveFrame(const bool _enable)
 {
@@ -1523,6 +2079,12 @@ void Camera::CreateCamera()
   this->cameraNode = this->sceneNode->createChildSceneNode(
       this->scopedUniqueName + "_cameraNode");
   this->cameraNode->attachObject(this->camera);
+  this->camera->setLodBias(this->dataPtr->lodBias);
+
+  this->dataPtr->cullingListener.reset(
+      new CameraCullingListener(this->camera));
+  this->scene->OgreSceneManager()->addListener(
+      this->dataPtr->cullingListener.get());
 
   if (this->sdf->HasElement("projection_type"))
     this->SetProjectionType(this->sdf->Get<std::string>("projection_type"));
@@ -2064,6 +2626,35 @@ unsigned int Camera::TriangleCount() const
 #endif
 }
 
+//////////////////////////////////////////////////
+unsigned int Camera::BatchCount() const
+{
+  if (!this->renderTarget)
+    return 0u;
+
+#if OGRE_VERSION_MAJOR == 1 && OGRE_VERSION_MINOR >= 11
+  return this->renderTarget->getStatistics().batchCount;
+#else
+  return this->renderTarget->getBatchCount();
+#endif
+}
+
+//////////////////////////////////////////////////
+unsigned int Camera::VisibleObjectCount() const
+{
+  if (!this->dataPtr->cullingListener)
+    return 0u;
+  return this->dataPtr->cullingListener->queued;
+}
+
+//////////////////////////////////////////////////
+double Camera::CullingTime() const
+{
+  if (!this->dataPtr->cullingListener)
+    return 0.0;
+  return this->dataPtr->cullingListener->cullingTime;
+}
+
 //////////////////////////////////////////////////
 bool Camera::SetProjectionType(const std::string &_type)
 {
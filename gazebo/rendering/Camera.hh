@@ -401,6 +401,21 @@ namespace gazebo
       /// \return True if the camera is set to capture data.
       public: bool CaptureData() const;
 
+      /// \brief Check whether the frames of the camera are used: callbacks
+      /// connected to its new frames, frames saved to disk or a video being
+      /// recorded.
+      /// \return True if the frames are used.
+      public: virtual bool HasFrameListeners() const;
+
+      /// \brief Enable or disable shadows in the images of the camera.
+      /// \param[in] _enabled True to render shadows.
+      public: void SetShadowsEnabled(const bool _enabled);
+
+      /// \brief Check whether shadows are rendered in the images of the
+      /// camera.
+      /// \return True if shadows are rendered.
+      public: bool ShadowsEnabled() const;
+
       /// \brief Set the save frame pathname
       /// \param[in] _pathname Directory in which to store saved image frames
       public: void SetSaveFramePathname(const std::string &_pathname);
@@ -442,6 +457,23 @@ namespace gazebo
       /// \return The current triangle count
       public: virtual unsigned int TriangleCount() const;
 
+      /// \brief Get the number of draw calls of the last frame.
+      /// \return The current batch count
+      public: virtual unsigned int BatchCount() const;
+
+      /// \brief Get the number of objects that passed the culling of the
+      /// last render of the camera, counted as renderables queued once per
+      /// pass, shadow maps excluded. It is not updated while the camera
+      /// reuses the visible objects found for another camera with the same
+      /// view in the frame.
+      /// \return The number of visible objects.
+      public: unsigned int VisibleObjectCount() const;
+
+      /// \brief Get the time the scene manager took to find the visible
+      /// objects in the last render of the camera.
+      /// \return The culling time in seconds.
+      public: double CullingTime() const;
+
       /// \brief Set the aspect ratio
       /// \param[in] _ratio The aspect ratio (width / height) in pixels
       public: void SetAspectRatio(float _ratio);
@@ -599,6 +631,48 @@ namespace gazebo
       /// \return Direction the camera is facing
       public: ignition::math::Vector3d Direction() const;
 
+      /// \brief Set the number of frames by which the image data lags the
+      /// rendering. With a latency of one frame, the pixels of a frame are
+      /// copied to a pixel buffer object while the next frame renders, so
+      /// the readback does not stall the render thread. This needs the
+      /// OpenGL render system, other render systems read synchronously.
+      /// \param[in] _frames 0 to read the image of each frame synchronously,
+      /// 1 to read it one frame later.
+      public: void SetReadbackLatency(const unsigned int _frames);
+
+      /// \brief Get the number of frames by which the image data lags the
+      /// rendering.
+      /// \return 0 or 1.
+      /// \sa SetReadbackLatency
+      public: unsigned int ReadbackLatency() const;
+
+      /// \brief Set whether the image is converted to its output format on
+      /// the GPU. For the BAYER_* formats a final shader pass writes the
+      /// mosaic into a single channel texture, which is read back instead of
+      /// the RGB image. Frames that are saved or encoded to video still use
+      /// the CPU conversion, since they need the RGB image.
+      /// \param[in] _enabled True to convert the image on the GPU.
+      public: void SetGpuImageConversion(const bool _enabled);
+
+      /// \brief Get whether the image is converted to its output format on
+      /// the GPU.
+      /// \return True if the conversion is done on the GPU.
+      /// \sa SetGpuImageConversion
+      public: bool GpuImageConversion() const;
+
+      /// \brief Set the bias applied to the distances at which meshes
+      /// switch to a lower level of detail, see Scene::SetMeshLod. It may
+      /// also be set with <ignition:lod_bias> in the camera SDF.
+      /// \param[in] _bias Greater than 1 to keep more detail, smaller than
+      /// 1 to switch to lower details closer to the camera.
+      public: void SetLodBias(const double _bias);
+
+      /// \brief Get the bias applied to the distances at which meshes
+      /// switch to a lower level of detail.
+      /// \return The bias, 1 by default.
+      /// \sa SetLodBias
+      public: double LodBias() const;
+
       /// \brief Connect to the new image signal
       /// \param[in] _subscriber Callback that is called when a new image is
       /// generated
@@ -774,6 +848,22 @@ namespace gazebo
       /// \brief Read image data from pixel buffer
       protected: void ReadPixelBuffer();
 
+      /// \brief Start reading the image data of this frame into a pixel
+      /// buffer object, and copy the data of the previous frame.
+      /// \param[in] _texture Texture to read.
+      /// \param[in] _format Pixel format of the image data.
+      /// \param[out] _dst Buffer that receives the image data.
+      /// \param[in] _size Size of the image data in bytes.
+      /// \return False if pixel buffer objects are not supported.
+      private: bool ReadPixelBufferAsync(Ogre::Texture *_texture,
+          const int _format, unsigned char *_dst, const size_t _size);
+
+      /// \brief Check whether the image of this frame is converted to a
+      /// Bayer mosaic on the GPU, creating the render target of the
+      /// conversion the first time.
+      /// \return True if the Bayer mosaic is rendered on the GPU.
+      private: bool GpuBayerReady();
+
       /// \brief Implementation of the Camera::TrackVisual call
       /// \param[in] _visualName Name of the visual to track
       /// \return True if able to track the visual
@@ -18,6 +18,7 @@
 #define GAZEBO_RENDERING_CAMERAPRIVATE_HH_
 
 #include <deque>
+#include <memory>
 #include <mutex>
 #include <utility>
 #include <list>
@@ -31,12 +32,17 @@
 namespace Ogre
 {
   class CompositorInstance;
+  class Texture;
 }
 
 namespace gazebo
 {
   namespace rendering
   {
+    // Forward declare the listener of the Bayer compositor.
+    class BayerCompositorListener;
+    class CameraCullingListener;
+
     /// \brief Private data for the Camera class
     class GZ_RENDERING_VISIBLE CameraPrivate
     {
@@ -117,6 +123,50 @@ namespace gazebo
 
       /// \brief Fixed axis to yaw around.
       public: ignition::math::Vector3d yawFixedAxis;
+
+      /// \brief Number of frames by which the image data lags the rendering.
+      public: unsigned int readbackLatency = 0;
+
+      /// \brief True if saveFrameBuffer holds a frame to deliver.
+      public: bool readbackReady = false;
+
+      /// \brief Pixel buffer objects of the asynchronous readback.
+      public: unsigned int pbos[2] = {0, 0};
+
+      /// \brief Size of each pixel buffer object in bytes.
+      public: size_t pboSize = 0;
+
+      /// \brief Pixel buffer object that receives the current frame.
+      public: unsigned int pboIndex = 0;
+
+      /// \brief True if the other pixel buffer object holds a frame.
+      public: bool pboPending = false;
+
+      /// \brief True to convert the image to its output format on the GPU.
+      public: bool gpuConversion = false;
+
+      /// \brief Bias applied to the level of detail distances.
+      public: double lodBias = 1.0;
+
+      /// \brief True once the render target of the Bayer conversion was
+      /// created, or failed to be.
+      public: bool bayerSetup = false;
+
+      /// \brief True if the image of the current frame is a Bayer mosaic
+      /// rendered on the GPU.
+      public: bool gpuBayerFrame = false;
+
+      /// \brief Single channel texture that receives the Bayer mosaic.
+      public: Ogre::Texture *bayerTexture = nullptr;
+
+      /// \brief Compositor that renders the Bayer mosaic.
+      public: Ogre::CompositorInstance *bayerInstance = nullptr;
+
+      /// \brief Listener that sets the parameters of the Bayer shader.
+      public: std::unique_ptr<BayerCompositorListener> bayerListener;
+
+      /// \brief Listener that measures the culling of the camera views.
+      public: std::unique_ptr<CameraCullingListener> cullingListener;
     };
   }
 }
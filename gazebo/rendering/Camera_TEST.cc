@@ -281,6 +281,63 @@ TEST_F(Camera_TEST, Create)
   }
 }
 
+/////////////////////////////////////////////////
+TEST_F(Camera_TEST, CullingStatistics)
+{
+  Load("worlds/empty.world");
+
+  gazebo::rendering::ScenePtr scene = gazebo::rendering::get_scene("default");
+
+  if (!scene)
+    scene = gazebo::rendering::create_scene("default", false);
+  ASSERT_TRUE(scene != nullptr);
+
+  rendering::CameraPtr camera =
+      scene->CreateCamera("test_camera_culling", false);
+  ASSERT_TRUE(camera != nullptr);
+
+  std::stringstream ss;
+  ss << "<sdf version='" << SDF_VERSION << "'>"
+     << "  <camera>"
+     << "    <horizontal_fov>1.0</horizontal_fov>"
+     << "    <image>"
+     << "      <width>320</width>"
+     << "      <height>240</height>"
+     << "    </image>"
+     << "  </camera>"
+     << "</sdf>";
+  sdf::ElementPtr cameraSDF(new sdf::Element);
+  sdf::initFile("camera.sdf", cameraSDF);
+  sdf::readString(ss.str(), cameraSDF);
+  camera->Load(cameraSDF);
+  camera->Init();
+  camera->SetCaptureData(true);
+  camera->CreateRenderTexture("test_camera_culling_texture");
+
+  // Nothing was rendered yet
+  EXPECT_EQ(0u, camera->VisibleObjectCount());
+  EXPECT_DOUBLE_EQ(0.0, camera->CullingTime());
+  EXPECT_EQ(0u, camera->BatchCount());
+
+  // A box in front of the camera
+  rendering::VisualPtr box(
+      new rendering::Visual("culling_box", scene->WorldVisual()));
+  box->Load();
+  box->AttachMesh("unit_box");
+  box->SetWorldPosition(ignition::math::Vector3d(0, 0, 0.5));
+  camera->SetWorldPose(ignition::math::Pose3d(-5, 0, 0.5, 0, 0, 0));
+
+  camera->Update();
+  camera->Render(true);
+  camera->PostRender();
+
+  EXPECT_GT(camera->VisibleObjectCount(), 0u);
+  EXPECT_GE(camera->CullingTime(), 0.0);
+  EXPECT_GT(camera->BatchCount(), 0u);
+
+  scene->RemoveCamera(camera->Name());
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
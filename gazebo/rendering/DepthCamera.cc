@@ -279,9 +279,10 @@ void DepthCamera::CreateDepthTexture(const std::string &_textureName)
         this->dataPtr->pcdTarget->addViewport(this->camera);
     this->dataPtr->pcdViewport->setClearEveryFrame(true);
 
-    auto const &ignBG = this->scene->BackgroundColor();
+    // Pixels without geometry get a zero depth, which is below the near
+    // clip and so marks an invalid point
     this->dataPtr->pcdViewport->setBackgroundColour(
-        Conversions::Convert(ignBG));
+        Ogre::ColourValue(0, 0, 0, 0));
     this->dataPtr->pcdViewport->setOverlaysEnabled(false);
     this->dataPtr->pcdViewport->setShadowsEnabled(false);
     this->dataPtr->pcdViewport->setVisibilityMask(
@@ -445,8 +446,6 @@ void DepthCamera::PostRender()
       if (!this->dataPtr->pcdBuffer)
         this->dataPtr->pcdBuffer = new float[width * height * 4];
 
-      memset(this->dataPtr->pcdBuffer, 0, width * height * 4);
-
       Ogre::Box pcd_src_box(0, 0, width, height);
       Ogre::PixelBox pcd_dst_box(width, height,
           1, Ogre::PF_FLOAT32_RGBA, this->dataPtr->pcdBuffer);
@@ -712,6 +711,16 @@ event::ConnectionPtr DepthCamera::ConnectNewNormalsPointCloud(
   return this->dataPtr->newNormalsPointCloud.Connect(_subscriber);
 }
 
+/////////////////////////////////////////////////
+bool DepthCamera::HasFrameListeners() const
+{
+  return Camera::HasFrameListeners() ||
+    this->dataPtr->newDepthFrame.ConnectionCount() > 0 ||
+    this->dataPtr->newRGBPointCloud.ConnectionCount() > 0 ||
+    this->dataPtr->newReflectanceFrame.ConnectionCount() > 0 ||
+    this->dataPtr->newNormalsPointCloud.ConnectionCount() > 0;
+}
+
 /////////////////////////////////////////////////
 ReflectanceMaterialSwitcher::ReflectanceMaterialSwitcher(
   ScenePtr _scene, Ogre::Viewport* _viewport)
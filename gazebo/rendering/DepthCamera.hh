@@ -96,6 +96,9 @@ namespace gazebo
       /// \param[in] _target Pointer to the render target
       public: virtual void SetDepthTarget(Ogre::RenderTarget *_target);
 
+      // Documentation inherited
+      public: virtual bool HasFrameListeners() const;
+
       /// \brief Connect a to the new depth image signal
       /// \param[in] _subscriber Subscriber callback function
       /// \return Pointer to the new Connection. This must be kept in scope
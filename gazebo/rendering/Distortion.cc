@@ -14,6 +14,18 @@
  * limitations under the License.
  *
 */
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include <cstring>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
 #include <sdf/sdf.hh>
 
 #include <ignition/math/Helpers.hh>
@@ -29,6 +41,94 @@ namespace gazebo
 {
   namespace rendering
   {
+    /// \brief Parameters a distortion map is computed from.
+    class DistortionMapKey
+    {
+      /// \brief Compare with another key, to order the map cache.
+      /// \param[in] _other The other key.
+      /// \return True if this key orders before the other.
+      public: bool operator<(const DistortionMapKey &_other) const
+              {
+                return std::tie(this->k1, this->k2, this->k3, this->p1,
+                    this->p2, this->center[0], this->center[1], this->side,
+                    this->fov, this->legacyMode) <
+                    std::tie(_other.k1, _other.k2, _other.k3, _other.p1,
+                    _other.p2, _other.center[0], _other.center[1],
+                    _other.side, _other.fov, _other.legacyMode);
+              }
+
+      /// \brief Name of the Ogre texture holding the map.
+      /// \return A name unique to the parameters.
+      public: std::string TextureName() const
+              {
+                std::ostringstream stream;
+                stream << std::setprecision(17) << "DistortionMap/" << this->k1
+                    << "_" << this->k2 << "_" << this->k3 << "_" << this->p1
+                    << "_" << this->p2 << "_" << this->center.X() << "_"
+                    << this->center.Y() << "_" << this->side << "_"
+                    << this->fov << "_" << this->legacyMode;
+                return stream.str();
+              }
+
+      /// \brief Radial distortion coefficient k1.
+      public: double k1 = 0;
+
+      /// \brief Radial distortion coefficient k2.
+      public: double k2 = 0;
+
+      /// \brief Radial distortion coefficient k3.
+      public: double k3 = 0;
+
+      /// \brief Tangential distortion coefficient p1.
+      public: double p1 = 0;
+
+      /// \brief Tangential distortion coefficient p2.
+      public: double p2 = 0;
+
+      /// \brief Lens center used for distortion.
+      public: ignition::math::Vector2d center;
+
+      /// \brief Side of the square map in pixels.
+      public: unsigned int side = 0;
+
+      /// \brief Largest field of view of the camera in radians.
+      public: double fov = 0;
+
+      /// \brief Whether the legacy distortion mode is used.
+      public: bool legacyMode = true;
+    };
+
+    /// \brief Mapping of distorted to undistorted normalized pixels of a
+    /// square texture.
+    class DistortionMap
+    {
+      /// \brief Get a value of the map.
+      /// \param[in] _x Column of the value.
+      /// \param[in] _y Row of the value.
+      /// \return The value, or (-1, -1) if the index is out of bounds.
+      public: ignition::math::Vector2d ValueClamped(const int _x,
+                  const int _y) const
+              {
+                if (_x < 0 || _x >= static_cast<int>(this->side) ||
+                    _y < 0 || _y >= static_cast<int>(this->side))
+                {
+                  return ignition::math::Vector2d(-1, -1);
+                }
+                return this->values[_y * this->side + _x];
+              }
+
+      /// \brief Get the RGB texels of the distortion texture, with the
+      /// pixels no value maps to interpolated from their neighbors.
+      /// \return Three floats per pixel, row by row.
+      public: std::vector<float> Texels() const;
+
+      /// \brief Side of the square map in pixels.
+      public: unsigned int side = 0;
+
+      /// \brief Values of the map, row by row.
+      public: std::vector<ignition::math::Vector2d> values;
+    };
+
     /// \brief Private data for the Distortion class
     class DistortionPrivate : public Ogre::CompositorInstance::Listener
     {
@@ -80,8 +180,9 @@ namespace gazebo
       /// \brief Connection for the pre render event.
       public: event::ConnectionPtr preRenderConnection;
 
-      /// \brief Mapping of distorted to undistorted normalized pixels
-      public: std::vector<ignition::math::Vector2d> distortionMap;
+      /// \brief Mapping of distorted to undistorted normalized pixels,
+      /// shared with the cameras that have the same lens and resolution.
+      public: std::shared_ptr<const DistortionMap> distortionMap;
 
       /// \brief Width of distortion texture map
       public: unsigned int distortionTexWidth;
@@ -113,8 +214,247 @@ namespace gazebo
     };
   }
 }
+/// \brief Mutex protecting the distortion map cache.
+static std::mutex g_distortionMapMutex;
+
+/// \brief Distortion maps in use, shared by the cameras with the same
+/// parameters. An entry expires with the last camera using it.
+static std::map<DistortionMapKey, std::weak_ptr<const DistortionMap>>
+    g_distortionMaps;
+
+//////////////////////////////////////////////////
+static std::shared_ptr<const DistortionMap> ComputeDistortionMap(
+    const DistortionMapKey &_key)
+{
+  auto map = std::make_shared<DistortionMap>();
+  map->side = _key.side;
+
+  const double focalLength = _key.side / (2 * tan(_key.fov / 2));
+  const unsigned int imageSize = _key.side * _key.side;
+  const double stepSize = 1.0 / _key.side;
+
+  // Half step-size vector to add to the value being placed in distortion map.
+  // Necessary for compositor to correctly interpolate pixel values.
+  const auto halfTexelSize =
+      0.5 * ignition::math::Vector2d(stepSize, stepSize);
+
+  // Distort every pixel, which is independent of the other pixels
+  std::vector<ignition::math::Vector2d> distorted(imageSize);
+  tbb::parallel_for(tbb::blocked_range<unsigned int>(0, _key.side),
+      [&](const tbb::blocked_range<unsigned int> &_rows)
+  {
+    for (unsigned int mapRow = _rows.begin(); mapRow != _rows.end(); ++mapRow)
+    {
+      for (unsigned int mapCol = 0; mapCol < _key.side; ++mapCol)
+      {
+        const ignition::math::Vector2d normalizedLocation(
+            mapCol * stepSize, mapRow * stepSize);
+        if (_key.legacyMode)
+        {
+          distorted[mapRow * _key.side + mapCol] = Distortion::Distort(
+              normalizedLocation, _key.center,
+              _key.k1, _key.k2, _key.k3, _key.p1, _key.p2);
+        }
+        else
+        {
+          distorted[mapRow * _key.side + mapCol] = Distortion::Distort(
+              normalizedLocation, _key.center,
+              _key.k1, _key.k2, _key.k3, _key.p1, _key.p2,
+              _key.side, focalLength);
+        }
+      }
+    }
+  });
+
+  // initialize distortion map
+  const auto unsetPixelVector = ignition::math::Vector2d(-1, -1);
+  map->values.assign(imageSize, unsetPixelVector);
+
+  const ignition::math::Vector2d distortionCenterCoordinates(
+      _key.center.X() * _key.side, _key.center.Y() * _key.side);
+
+  // Scatter the pixels to their distorted location, in order since pixels
+  // may land on the same location
+  for (unsigned int mapRow = 0; mapRow < _key.side; ++mapRow)
+  {
+    for (unsigned int mapCol = 0; mapCol < _key.side; ++mapCol)
+    {
+      const ignition::math::Vector2d &distortedLocation =
+          distorted[mapRow * _key.side + mapCol];
+
+      // compute the index in the distortion map
+      const unsigned int distortedCol =
+          round(distortedLocation.X() * _key.side);
+      const unsigned int distortedRow =
+          round(distortedLocation.Y() * _key.side);
+
+      // Note that the following makes sure that, for significant distortions,
+      // there is not a problem where the distorted image seems to fold over
+      // itself. This is accomplished by favoring pixels closer to the center
+      // of distortion, and this change applies to both the legacy and
+      // nonlegacy distortion modes.
+
+      // Make sure the distorted pixel is within the texture dimensions.
+      // Otherwise the mapping is outside of the image bounds, which is
+      // expected and normal to ensure no black borders.
+      if (distortedCol >= _key.side || distortedRow >= _key.side)
+        continue;
+
+      const unsigned int distortedIdx = distortedRow * _key.side +
+          distortedCol;
+      const ignition::math::Vector2d normalizedLocation(
+          mapCol * stepSize, mapRow * stepSize);
+
+      // check if the index has already been set
+      if (map->values[distortedIdx] != unsetPixelVector)
+      {
+        // grab current coordinates that map to this destination
+        const ignition::math::Vector2d currDistortedCoordinates =
+            map->values[distortedIdx] * _key.side;
+
+        // grab new coordinates to map to
+        const ignition::math::Vector2d newDistortedCoordinates(
+            mapCol, mapRow);
+
+        // use the new mapping if it is closer to the center of the distortion
+        if (newDistortedCoordinates.Distance(distortionCenterCoordinates) <
+            currDistortedCoordinates.Distance(distortionCenterCoordinates))
+        {
+          map->values[distortedIdx] = normalizedLocation + halfTexelSize;
+        }
+      }
+      else
+      {
+        map->values[distortedIdx] = normalizedLocation + halfTexelSize;
+      }
+    }
+  }
+
+  return map;
+}
+
 //////////////////////////////////////////////////
-Distortion::Distortion()
+static std::shared_ptr<const DistortionMap> CachedDistortionMap(
+    const DistortionMapKey &_key)
+{
+  // Computing under the lock keeps cameras loaded together from computing
+  // the same map twice
+  std::lock_guard<std::mutex> lock(g_distortionMapMutex);
+  std::shared_ptr<const DistortionMap> map = g_distortionMaps[_key].lock();
+  if (!map)
+  {
+    map = ComputeDistortionMap(_key);
+    g_distortionMaps[_key] = map;
+  }
+
+  // Drop the expired entries
+  for (auto it = g_distortionMaps.begin(); it != g_distortionMaps.end();)
+  {
+    if (it->second.expired())
+      it = g_distortionMaps.erase(it);
+    else
+      ++it;
+  }
+  return map;
+}
+
+//////////////////////////////////////////////////
+std::vector<float> DistortionMap::Texels() const
+{
+  std::vector<float> texels(this->values.size() * 3);
+
+  // Rows are independent, each reads the map and writes its own texels
+  tbb::parallel_for(tbb::blocked_range<unsigned int>(0, this->side),
+      [&](const tbb::blocked_range<unsigned int> &_rows)
+  {
+    for (unsigned int i = _rows.begin(); i != _rows.end(); ++i)
+    {
+      float *pDest = texels.data() + i * this->side * 3;
+      for (unsigned int j = 0; j < this->side; ++j)
+      {
+        const ignition::math::Vector2d &vec = this->values[i*this->side+j];
+
+        // perform interpolation on-the-fly:
+        // check for empty mapping within the region and correct it by
+        // interpolating the eight neighboring distortion map values.
+
+        if (vec.X() < -0.5 && vec.Y() < -0.5)
+        {
+          ignition::math::Vector2d left = this->ValueClamped(j-1, i);
+          ignition::math::Vector2d right = this->ValueClamped(j+1, i);
+          ignition::math::Vector2d bottom = this->ValueClamped(j, i+1);
+          ignition::math::Vector2d top = this->ValueClamped(j, i-1);
+
+          ignition::math::Vector2d topLeft = this->ValueClamped(j-1, i-1);
+          ignition::math::Vector2d topRight = this->ValueClamped(j+1, i-1);
+          ignition::math::Vector2d bottomLeft = this->ValueClamped(j-1, i+1);
+          ignition::math::Vector2d bottomRight = this->ValueClamped(j+1, i+1);
+
+          ignition::math::Vector2d interpolated;
+          double divisor = 0;
+          if (right.X() > -0.5)
+          {
+            divisor++;
+            interpolated += right;
+          }
+          if (left.X() > -0.5)
+          {
+            divisor++;
+            interpolated += left;
+          }
+          if (top.X() > -0.5)
+          {
+            divisor++;
+            interpolated += top;
+          }
+          if (bottom.X() > -0.5)
+          {
+            divisor++;
+            interpolated += bottom;
+          }
+
+          if (bottomRight.X() > -0.5)
+          {
+            divisor += 0.707;
+            interpolated += bottomRight * 0.707;
+          }
+          if (bottomLeft.X() > -0.5)
+          {
+            divisor += 0.707;
+            interpolated += bottomLeft * 0.707;
+          }
+          if (topRight.X() > -0.5)
+          {
+            divisor += 0.707;
+            interpolated += topRight * 0.707;
+          }
+          if (topLeft.X() > -0.5)
+          {
+            divisor += 0.707;
+            interpolated += topLeft * 0.707;
+          }
+
+          if (divisor > 0.5)
+          {
+            interpolated /= divisor;
+          }
+          *pDest++ = ignition::math::clamp(interpolated.X(), 0.0, 1.0);
+          *pDest++ = ignition::math::clamp(interpolated.Y(), 0.0, 1.0);
+        }
+        else
+        {
+          *pDest++ = vec.X();
+          *pDest++ = vec.Y();
+        }
+
+        // Z coordinate
+        *pDest++ = 0;
+      }
+    }
+  });
+  return texels;
+}
+
   : dataPtr(new DistortionPrivate)
 {
 }
@@ -157,14 +497,9 @@ void Distortion::Load(sdf::ElementPtr _sdf)
 ignition::math::Vector2d
     Distortion::DistortionMapValueClamped(const int x, const int y) const
 {
-  if (x < 0 || x >= static_cast<int>(this->dataPtr->distortionTexWidth) ||
-      y < 0 || y >= static_cast<int>(this->dataPtr->distortionTexHeight))
-  {
+  if (!this->dataPtr->distortionMap)
     return ignition::math::Vector2d(-1, -1);
-  }
-  ignition::math::Vector2d res =
-      this->dataPtr->distortionMap[y*this->dataPtr->distortionTexWidth+x];
-  return res;
+  return this->dataPtr->distortionMap->ValueClamped(x, y);
 }
 
 //////////////////////////////////////////////////
@@ -187,128 +522,24 @@ void Distortion::SetCamera(CameraPtr _camera)
   }
 
   // seems to work best with a square distortion map texture
-  unsigned int texSide = _camera->ImageHeight() > _camera->ImageWidth() ?
+  DistortionMapKey key;
+  key.k1 = this->dataPtr->k1;
+  key.k2 = this->dataPtr->k2;
+  key.k3 = this->dataPtr->k3;
+  key.p1 = this->dataPtr->p1;
+  key.p2 = this->dataPtr->p2;
+  key.center = this->dataPtr->lensCenter;
+  key.side = _camera->ImageHeight() > _camera->ImageWidth() ?
       _camera->ImageHeight() : _camera->ImageWidth();
-  // calculate focal length from largest fov
-  const double fov = _camera->ImageHeight() > _camera->ImageWidth() ?
+  // the largest fov sets the focal length
+  key.fov = _camera->ImageHeight() > _camera->ImageWidth() ?
       _camera->VFOV().Radian() : _camera->HFOV().Radian();
-  const double focalLength = texSide/(2*tan(fov/2));
-  this->dataPtr->distortionTexWidth = texSide;
-  this->dataPtr->distortionTexHeight = texSide;
-  unsigned int imageSize =
-      this->dataPtr->distortionTexWidth * this->dataPtr->distortionTexHeight;
-  double colStepSize = 1.0 / this->dataPtr->distortionTexWidth;
-  double rowStepSize = 1.0 / this->dataPtr->distortionTexHeight;
-
-  // Half step-size vector to add to the value being placed in distortion map.
-  // Necessary for compositor to correctly interpolate pixel values.
-  const auto halfTexelSize =
-      0.5 * ignition::math::Vector2d(rowStepSize, colStepSize);
+  key.legacyMode = this->dataPtr->legacyMode;
 
-  // initialize distortion map
-  this->dataPtr->distortionMap.resize(imageSize);
-  for (unsigned int i = 0; i < this->dataPtr->distortionMap.size(); ++i)
-  {
-    this->dataPtr->distortionMap[i] = -1;
-  }
-
-  ignition::math::Vector2d distortionCenterCoordinates(
-      this->dataPtr->lensCenter.X() * this->dataPtr->distortionTexWidth,
-      this->dataPtr->lensCenter.Y() * this->dataPtr->distortionTexWidth);
-
-  // declare variables before the loop
-  const auto unsetPixelVector =  ignition::math::Vector2d(-1, -1);
-  ignition::math::Vector2d normalizedLocation,
-      distortedLocation,
-      newDistortedCoordinates,
-      currDistortedCoordinates;
-  unsigned int distortedIdx,
-      distortedCol,
-      distortedRow;
-  double normalizedColLocation, normalizedRowLocation;
-
-  // fill the distortion map
-  for (unsigned int mapRow = 0; mapRow < this->dataPtr->distortionTexHeight;
-    ++mapRow)
-  {
-    normalizedRowLocation = mapRow*rowStepSize;
-    for (unsigned int mapCol = 0; mapCol < this->dataPtr->distortionTexWidth;
-      ++mapCol)
-    {
-      normalizedColLocation = mapCol*colStepSize;
-
-      normalizedLocation[0] = normalizedColLocation;
-      normalizedLocation[1] = normalizedRowLocation;
-
-      if (this->dataPtr->legacyMode)
-      {
-        distortedLocation = this->Distort(
-            normalizedLocation,
-            this->dataPtr->lensCenter,
-            this->dataPtr->k1, this->dataPtr->k2, this->dataPtr->k3,
-            this->dataPtr->p1, this->dataPtr->p2);
-      }
-      else
-      {
-        distortedLocation = this->Distort(
-            normalizedLocation,
-            this->dataPtr->lensCenter,
-            this->dataPtr->k1, this->dataPtr->k2, this->dataPtr->k3,
-            this->dataPtr->p1, this->dataPtr->p2,
-            this->dataPtr->distortionTexWidth,
-            focalLength);
-      }
-
-      // compute the index in the distortion map
-      distortedCol = round(distortedLocation.X() * 
-        this->dataPtr->distortionTexWidth);
-      distortedRow = round(distortedLocation.Y() *
-        this->dataPtr->distortionTexHeight);
-
-      // Note that the following makes sure that, for significant distortions,
-      // there is not a problem where the distorted image seems to fold over
-      // itself. This is accomplished by favoring pixels closer to the center
-      // of distortion, and this change applies to both the legacy and
-      // nonlegacy distortion modes.
-
-      // Make sure the distorted pixel is within the texture dimensions
-      if (distortedCol < this->dataPtr->distortionTexWidth &&
-          distortedRow < this->dataPtr->distortionTexHeight)
-      {
-        distortedIdx = distortedRow * this->dataPtr->distortionTexWidth +
-          distortedCol;
-
-        // check if the index has already been set
-        if (this->dataPtr->distortionMap[distortedIdx] != unsetPixelVector)
-        {
-          // grab current coordinates that map to this destination
-          currDistortedCoordinates =
-            this->dataPtr->distortionMap[distortedIdx] *
-            this->dataPtr->distortionTexWidth;
-
-          // grab new coordinates to map to
-          newDistortedCoordinates[0] = mapCol;
-          newDistortedCoordinates[1] = mapRow;
-
-          // use the new mapping if it is closer to the center of the distortion
-          if (newDistortedCoordinates.Distance(distortionCenterCoordinates) <
-              currDistortedCoordinates.Distance(distortionCenterCoordinates))
-          {
-            this->dataPtr->distortionMap[distortedIdx] = normalizedLocation +
-              halfTexelSize;
-          }
-        }
-        else
-        {
-          this->dataPtr->distortionMap[distortedIdx] = normalizedLocation +
-            halfTexelSize;
-        }
-      }
-      // else: mapping is outside of the image bounds.
-      // This is expected and normal to ensure
-      // no black borders; carry on
-    }
-  }
+  // Cameras with the same lens and resolution share the map and texture
+  this->dataPtr->distortionMap = CachedDistortionMap(key);
+  this->dataPtr->distortionTexWidth = key.side;
+  this->dataPtr->distortionTexHeight = key.side;
 
   // set up the distortion instance
   this->dataPtr->distortionMaterial =
@@ -318,128 +549,32 @@ void Distortion::SetCamera(CameraPtr _camera)
       this->dataPtr->distortionMaterial->clone(
           "Gazebo/" + _camera->Name() + "_CameraDistortionMap");
 
-  // create the distortion map texture for the distortion instance
-  std::string texName = _camera->Name() + "_distortionTex";
+  // create the distortion map texture, unless another camera did
+  const std::string texName = key.TextureName();
   this->dataPtr->distortionTexture =
-      Ogre::TextureManager::getSingleton().createManual(
-          texName,
-          "General",
-          Ogre::TEX_TYPE_2D,
-          this->dataPtr->distortionTexWidth,
-          this->dataPtr->distortionTexHeight,
-          0,
-          Ogre::PF_FLOAT32_RGB);
-  Ogre::HardwarePixelBufferSharedPtr pixelBuffer =
-      this->dataPtr->distortionTexture->getBuffer();
-
-  // fill the distortion map, while interpolating to fill dead pixels
-  pixelBuffer->lock(Ogre::HardwareBuffer::HBL_NORMAL);
-  const Ogre::PixelBox &pixelBox = pixelBuffer->getCurrentLock();
-
-#if OGRE_VERSION_MAJOR > 1 || OGRE_VERSION_MINOR >= 11
-  // Ogre 1.11 changed Ogre::PixelBox::data from void* to uchar*, hence
-  // reinterpret_cast is required here. static_cast is not allowed between
-  // pointers of unrelated types (see, for instance, Standard § 3.9.1
-  // Fundamental types)
-  float *pDest = reinterpret_cast<float *>(pixelBox.data);
-#else
-  float *pDest = static_cast<float *>(pixelBox.data);
-#endif
-
-  for (unsigned int i = 0; i < this->dataPtr->distortionTexHeight; ++i)
+      Ogre::TextureManager::getSingleton().getByName(texName);
+  if (this->dataPtr->distortionTexture.isNull())
   {
-    for (unsigned int j = 0; j < this->dataPtr->distortionTexWidth; ++j)
-    {
-      ignition::math::Vector2d vec =
-          this->dataPtr->distortionMap[i*this->dataPtr->distortionTexWidth+j];
-
-      // perform interpolation on-the-fly:
-      // check for empty mapping within the region and correct it by
-      // interpolating the eight neighboring distortion map values.
-
-      if (vec.X() < -0.5 && vec.Y() < -0.5)
-      {
-        ignition::math::Vector2d left =
-            this->DistortionMapValueClamped(j-1, i);
-        ignition::math::Vector2d right =
-            this->DistortionMapValueClamped(j+1, i);
-        ignition::math::Vector2d bottom =
-            this->DistortionMapValueClamped(j, i+1);
-        ignition::math::Vector2d top =
-            this->DistortionMapValueClamped(j, i-1);
-
-        ignition::math::Vector2d topLeft =
-            this->DistortionMapValueClamped(j-1, i-1);
-        ignition::math::Vector2d topRight =
-            this->DistortionMapValueClamped(j+1, i-1);
-        ignition::math::Vector2d bottomLeft =
-            this->DistortionMapValueClamped(j-1, i+1);
-        ignition::math::Vector2d bottomRight =
-            this->DistortionMapValueClamped(j+1, i+1);
-
-
-        ignition::math::Vector2d interpolated;
-        double divisor = 0;
-        if (right.X() > -0.5)
-        {
-          divisor++;
-          interpolated += right;
-        }
-        if (left.X() > -0.5)
-        {
-          divisor++;
-          interpolated += left;
-        }
-        if (top.X() > -0.5)
-        {
-          divisor++;
-          interpolated += top;
-        }
-        if (bottom.X() > -0.5)
-        {
-          divisor++;
-          interpolated += bottom;
-        }
-
-        if (bottomRight.X() > -0.5)
-        {
-          divisor += 0.707;
-          interpolated += bottomRight * 0.707;
-        }
-        if (bottomLeft.X() > -0.5)
-        {
-          divisor += 0.707;
-          interpolated += bottomLeft * 0.707;
-        }
-        if (topRight.X() > -0.5)
-        {
-          divisor += 0.707;
-          interpolated += topRight * 0.707;
-        }
-        if (topLeft.X() > -0.5)
-        {
-          divisor += 0.707;
-          interpolated += topLeft * 0.707;
-        }
-
-        if (divisor > 0.5)
-        {
-          interpolated /= divisor;
-        }
-        *pDest++ = ignition::math::clamp(interpolated.X(), 0.0, 1.0);
-        *pDest++ = ignition::math::clamp(interpolated.Y(), 0.0, 1.0);
-      }
-      else
-      {
-        *pDest++ = vec.X();
-        *pDest++ = vec.Y();
-      }
-
-      // Z coordinate
-      *pDest++ = 0;
-    }
+    this->dataPtr->distortionTexture =
+        Ogre::TextureManager::getSingleton().createManual(
+            texName,
+            "General",
+            Ogre::TEX_TYPE_2D,
+            this->dataPtr->distortionTexWidth,
+            this->dataPtr->distortionTexHeight,
+            0,
+            Ogre::PF_FLOAT32_RGB);
+    Ogre::HardwarePixelBufferSharedPtr pixelBuffer =
+        this->dataPtr->distortionTexture->getBuffer();
+
+    const std::vector<float> texels =
+        this->dataPtr->distortionMap->Texels();
+
+    pixelBuffer->lock(Ogre::HardwareBuffer::HBL_NORMAL);
+    const Ogre::PixelBox &pixelBox = pixelBuffer->getCurrentLock();
+    memcpy(pixelBox.data, texels.data(), texels.size() * sizeof(float));
+    pixelBuffer->unlock();
   }
-  pixelBuffer->unlock();
 
   this->CalculateAndApplyDistortionScale();
 
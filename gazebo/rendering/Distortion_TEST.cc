@@ -17,12 +17,14 @@
 
 #include <gtest/gtest.h>
 #include <string>
+#include <vector>
 #include <stdlib.h>
 
 #include "gazebo/rendering/RenderingIface.hh"
 #include "gazebo/test/ServerFixture.hh"
 #include "gazebo/rendering/Distortion.hh"
 #include "gazebo/rendering/Camera.hh"
+#include "gazebo/rendering/ogre_gazebo.h"
 
 #include "test/util.hh"
 
@@ -116,6 +118,51 @@ TEST_F(Distortion_TEST, DistortionModelBasics)
   EXPECT_DOUBLE_EQ(distortion.Center().Y(), 0.5);
 }
 
+/////////////////////////////////////////////////
+/// \brief Count the distortion map textures.
+/// \return Number of textures created for distortion maps.
+unsigned int DistortionTextureCount()
+{
+  unsigned int count = 0;
+  auto it = Ogre::TextureManager::getSingleton().getResourceIterator();
+  while (it.hasMoreElements())
+  {
+    if (it.getNext()->getName().find("DistortionMap/") == 0)
+      ++count;
+  }
+  return count;
+}
+
+/////////////////////////////////////////////////
+TEST_F(Distortion_TEST, SharedDistortionMap)
+{
+  Load("worlds/empty.world");
+
+  rendering::ScenePtr scene = rendering::get_scene("default");
+  if (!scene)
+    scene = rendering::create_scene("default", false);
+  ASSERT_NE(nullptr, scene);
+
+  const unsigned int initialCount = DistortionTextureCount();
+
+  // Cameras with the same lens and resolution share one texture, other
+  // lenses get their own
+  std::vector<double> k1s = {-0.1, -0.1, -0.2};
+  for (unsigned int i = 0; i < k1s.size(); ++i)
+  {
+    sdf::ElementPtr cameraSDF = CreateDistortionSDFElement(
+        k1s[i], -0.05, -0.01, 0, 0, 0.5, 0.5)->GetParent();
+    rendering::CameraPtr camera =
+        scene->CreateCamera("distorted_cam_" + std::to_string(i), false);
+    ASSERT_NE(nullptr, camera);
+    camera->Load(cameraSDF);
+    camera->Init();
+    camera->CreateRenderTexture("distorted_tex_" + std::to_string(i));
+    EXPECT_NE(nullptr, camera->LensDistortion());
+  }
+  EXPECT_EQ(initialCount + 2u, DistortionTextureCount());
+}
+
 int main(int argc, char **argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
@@ -16,7 +16,9 @@
 */
 #include <math.h>
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
 #include <sstream>
 #include <ignition/common/Profiler.hh>
 #include <ignition/math/Color.hh>
@@ -35,10 +37,42 @@ enum {POSITION_BINDING, TEXCOORD_BINDING};
 /// \brief Private implementation
 class gazebo::rendering::DynamicLinesPrivate
 {
+  /// \brief Mark points as changed since the buffers were last filled.
+  /// \param[in] _begin Index of the first changed point.
+  /// \param[in] _end One past the index of the last changed point.
+  public: void MarkDirty(const size_t _begin, const size_t _end)
+          {
+            this->dirtyBegin = std::min(this->dirtyBegin, _begin);
+            this->dirtyEnd = std::max(this->dirtyEnd, _end);
+          }
+
   /// \brief list of colors at each point
   public: std::vector<ignition::math::Color> colors;
+
+  /// \brief Index of the first point changed since the buffers were last
+  /// filled.
+  public: size_t dirtyBegin = std::numeric_limits<size_t>::max();
+
+  /// \brief One past the index of the last point changed since the
+  /// buffers were last filled.
+  public: size_t dirtyEnd = 0;
+
+  /// \brief True if points moved or were removed, so that the bounding box
+  /// must be computed again instead of grown.
+  public: bool boxDirty = false;
 };
 
+/// \brief Check whether two points are exactly equal. The tolerance of
+/// Vector3d's equality operator would miss small moves.
+/// \param[in] _a First point.
+/// \param[in] _b Second point.
+/// \return True if all the coordinates are equal.
+static bool SamePoint(const ignition::math::Vector3d &_a,
+    const ignition::math::Vector3d &_b)
+{
+  return _a.X() == _b.X() && _a.Y() == _b.Y() && _a.Z() == _b.Z();
+}
+
 /////////////////////////////////////////////////
 DynamicLines::DynamicLines(RenderOpType opType)
   : dataPtr(new DynamicLinesPrivate)
@@ -72,6 +106,7 @@ void DynamicLines::AddPoint(const ignition::math::Vector3d &_pt,
 {
   this->points.push_back(_pt);
   this->dataPtr->colors.push_back(_color);
+  this->dataPtr->MarkDirty(this->points.size() - 1, this->points.size());
   this->dirty = true;
 }
 
@@ -93,8 +128,12 @@ void DynamicLines::SetPoint(const unsigned int _index,
     return;
   }
 
-  this->points[_index] = _value;
+  if (SamePoint(this->points[_index], _value))
+    return;
 
+  this->points[_index] = _value;
+  this->dataPtr->MarkDirty(_index, _index + 1);
+  this->dataPtr->boxDirty = true;
   this->dirty = true;
 }
 
@@ -102,10 +141,51 @@ void DynamicLines::SetPoint(const unsigned int _index,
 void DynamicLines::SetColor(const unsigned int _index,
                             const ignition::math::Color &_color)
 {
+  if (_index >= this->dataPtr->colors.size())
+  {
+    gzerr << "Color index[" << _index << "] is out of bounds[0-"
+           << this->dataPtr->colors.size()-1 << "]\n";
+    return;
+  }
+
+  if (this->dataPtr->colors[_index] == _color)
+    return;
+
   this->dataPtr->colors[_index] = _color;
+  this->dataPtr->MarkDirty(_index, _index + 1);
   this->dirty = true;
 }
 
+/////////////////////////////////////////////////
+void DynamicLines::SetPoints(const std::vector<ignition::math::Vector3d> &_pts,
+    const std::vector<ignition::math::Color> &_colors)
+{
+  const bool hasColors = _colors.size() == _pts.size();
+
+  // Removed points are dropped by the vertex count, nothing is written
+  if (_pts.size() < this->points.size())
+  {
+    this->points.resize(_pts.size());
+    this->dataPtr->colors.resize(_pts.size());
+    this->dataPtr->boxDirty = true;
+    this->dirty = true;
+  }
+
+  for (size_t i = 0; i < this->points.size(); ++i)
+  {
+    this->SetPoint(i, _pts[i]);
+    this->SetColor(i, hasColors ? _colors[i] : ignition::math::Color::White);
+  }
+
+  this->points.reserve(_pts.size());
+  this->dataPtr->colors.reserve(_pts.size());
+  for (size_t i = this->points.size(); i < _pts.size(); ++i)
+  {
+    this->AddPoint(_pts[i],
+        hasColors ? _colors[i] : ignition::math::Color::White);
+  }
+}
+
 /////////////////////////////////////////////////
 ignition::math::Vector3d DynamicLines::Point(
     const unsigned int _index) const
@@ -133,6 +213,8 @@ unsigned int DynamicLines::GetPointCount() const
 void DynamicLines::Clear()
 {
   this->points.clear();
+  this->dataPtr->colors.clear();
+  this->dataPtr->boxDirty = true;
   this->dirty = true;
 }
 
@@ -140,7 +222,7 @@ void DynamicLines::Clear()
 void DynamicLines::Update()
 {
   IGN_PROFILE("rendering::DynamicLines::Update");
-  if (this->dirty && this->points.size() > 1)
+  if (this->dirty)
     this->FillHardwareBuffers();
 }
 
@@ -157,50 +239,82 @@ void DynamicLines::CreateVertexDeclaration()
 /////////////////////////////////////////////////
 void DynamicLines::FillHardwareBuffers()
 {
-  int size = this->points.size();
+  const size_t size = this->points.size();
+  const size_t capacity = this->vertexBufferCapacity;
   this->PrepareHardwareBuffers(size, 0);
 
+  // New buffers hold nothing yet, fill them completely
+  if (this->vertexBufferCapacity != capacity)
+  {
+    this->dataPtr->dirtyBegin = 0;
+    this->dataPtr->dirtyEnd = size;
+  }
+  const size_t begin = this->dataPtr->dirtyBegin;
+  const size_t end = std::min(this->dataPtr->dirtyEnd, size);
+
   if (!size)
   {
     this->mBox.setExtents(Ogre::Vector3::ZERO, Ogre::Vector3::ZERO);
-    this->dirty = false;
+  }
+  else if (this->dataPtr->boxDirty)
+  {
+    this->mBox.setNull();
+    for (const auto &pt : this->points)
+      this->mBox.merge(Conversions::Convert(pt));
+  }
+  else
+  {
+    for (size_t i = begin; i < end; ++i)
+      this->mBox.merge(Conversions::Convert(this->points[i]));
   }
 
-  Ogre::HardwareVertexBufferSharedPtr vbuf =
-    this->mRenderOp.vertexData->vertexBufferBinding->getBuffer(0);
-
-  Ogre::Real *prPos =
-    static_cast<Ogre::Real*>(vbuf->lock(Ogre::HardwareBuffer::HBL_NORMAL));
+  // Write the changed range only
+  if (begin < end)
   {
-    for (int i = 0; i < size; i++)
+    const size_t count = end - begin;
+    const Ogre::HardwareBuffer::LockOptions options = count == size ?
+        Ogre::HardwareBuffer::HBL_DISCARD : Ogre::HardwareBuffer::HBL_NORMAL;
+
+    Ogre::HardwareVertexBufferSharedPtr vbuf =
+      this->mRenderOp.vertexData->vertexBufferBinding->getBuffer(0);
+
+    Ogre::Real *prPos = static_cast<Ogre::Real*>(vbuf->lock(
+          begin * vbuf->getVertexSize(), count * vbuf->getVertexSize(),
+          options));
+    for (size_t i = begin; i < end; ++i)
     {
       *prPos++ = this->points[i].X();
       *prPos++ = this->points[i].Y();
       *prPos++ = this->points[i].Z();
-
-      this->mBox.merge(Conversions::Convert(this->points[i]));
     }
+    vbuf->unlock();
+
+    // Update the colors
+    Ogre::HardwareVertexBufferSharedPtr cbuf =
+      this->mRenderOp.vertexData->vertexBufferBinding->getBuffer(1);
+
+    Ogre::RGBA *colorArrayBuffer = static_cast<Ogre::RGBA*>(cbuf->lock(
+          begin * cbuf->getVertexSize(), count * cbuf->getVertexSize(),
+          options));
+    Ogre::RenderSystem *renderSystemForVertex =
+          Ogre::Root::getSingleton().getRenderSystem();
+    for (size_t i = begin; i < end; ++i)
+    {
+      Ogre::ColourValue color = Conversions::Convert(this->dataPtr->colors[i]);
+      renderSystemForVertex->convertColourValue(color,
+          &colorArrayBuffer[i - begin]);
+    }
+    cbuf->unlock();
   }
-  vbuf->unlock();
-
-  // Update the colors
-  Ogre::HardwareVertexBufferSharedPtr cbuf =
-    this->mRenderOp.vertexData->vertexBufferBinding->getBuffer(1);
-
-  Ogre::RGBA *colorArrayBuffer =
-        static_cast<Ogre::RGBA*>(cbuf->lock(Ogre::HardwareBuffer::HBL_DISCARD));
-  Ogre::RenderSystem *renderSystemForVertex =
-        Ogre::Root::getSingleton().getRenderSystem();
-  for (int i = 0; i < size; ++i)
-  {
-    Ogre::ColourValue color = Conversions::Convert(this->dataPtr->colors[i]);
-    renderSystemForVertex->convertColourValue(color, &colorArrayBuffer[i]);
-  }
-  cbuf->unlock();
 
   // need to update after mBox change, otherwise the lines goes in and out
   // of scope based on old mBox
-  this->getParentSceneNode()->needUpdate();
+  if (this->getParentSceneNode())
+    this->getParentSceneNode()->needUpdate();
 
+  this->dataPtr->dirtyBegin = std::numeric_limits<size_t>::max();
+  this->dataPtr->dirtyEnd = 0;
+  // The box of no points holds the origin, the first point replaces it
+  this->dataPtr->boxDirty = !size;
   this->dirty = false;
 }
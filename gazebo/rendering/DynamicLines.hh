@@ -84,6 +84,15 @@ namespace gazebo
       public: void SetColor(const unsigned int _index,
                             const ignition::math::Color &_color);
 
+      /// \brief Replace the point list. Only the points that differ from the
+      /// current ones are written to the hardware buffers on Update, so
+      /// a long list that changes a little is cheap to update.
+      /// \param[in] _pts The new points.
+      /// \param[in] _colors Color of each point. White is used for all the
+      /// points if the size differs from the number of points.
+      public: void SetPoints(const std::vector<ignition::math::Vector3d> &_pts,
+                  const std::vector<ignition::math::Color> &_colors = {});
+
       /// \brief Return the location of an existing point in the point list
       /// \param[in] _index Number of the point to return
       /// \return ignition::math::Vector3d value of the point. A vector of
@@ -147,10 +147,12 @@ void DynamicRenderable::PrepareHardwareBuffers(size_t vertexCount,
     while (newVertCapacity < vertexCount)
       newVertCapacity <<= 1;
   }
-  else if (vertexCount < this->vertexBufferCapacity>>1)
+  else if (vertexCount < this->vertexBufferCapacity>>2)
   {
-    // Make capacity the previous power of two
-    while (vertexCount < newVertCapacity>>1)
+    // Shrink well below the capacity only, and keep room to grow twice,
+    // so that a count changing around a power of two doesn't reallocate
+    // the buffer every frame
+    while (vertexCount < newVertCapacity>>2)
       newVertCapacity >>= 1;
   }
 
@@ -203,10 +205,10 @@ void DynamicRenderable::PrepareHardwareBuffers(size_t vertexCount,
       while (newIndexCapacity < indexCount)
         newIndexCapacity <<= 1;
     }
-    else if (indexCount < newIndexCapacity>>1)
+    else if (indexCount < newIndexCapacity>>2)
     {
-      // Make capacity the previous power of two
-      while (indexCount < newIndexCapacity>>1)
+      // Shrink the same way as the vertex buffer
+      while (indexCount < newIndexCapacity>>2)
         newIndexCapacity >>= 1;
     }
 
@@ -84,7 +84,10 @@ namespace gazebo
        ///    fillHardwareBuffers().  It guarantees that the hardware buffers
        ///    are large enough to hold at least the requested number of
        ///    vertices and indices (if using indices).  The buffers are
-       ///    possibly reallocated to achieve this.
+       ///    possibly reallocated to achieve this. Capacities are powers
+       ///    of two, and a buffer shrinks only below a quarter of its
+       ///    capacity, so counts that vary from frame to frame keep their
+       ///    buffers. The contents of reallocated buffers are undefined.
        /// \par The vertex and index count in the render operation are set to
        ///      the values of vertexCount and indexCount respectively.
        /// \param[in] _vertexCount The number of vertices the buffer must hold.
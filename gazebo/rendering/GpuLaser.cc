@@ -57,7 +57,7 @@ GpuLaser::GpuLaser(const std::string &_namePrefix, ScenePtr _scene,
   dataPtr(new GpuLaserPrivate)
 {
   this->dataPtr->laserBuffer = NULL;
-  this->dataPtr->laserScan = NULL;
+  this->dataPtr->laserBufferSize = 0;
   this->dataPtr->matFirstPass = NULL;
   this->dataPtr->matSecondPass = NULL;
   for (int i = 0; i < 3; ++i)
@@ -128,8 +128,7 @@ void GpuLaser::Fini()
 
   delete [] this->dataPtr->laserBuffer;
   this->dataPtr->laserBuffer = nullptr;
-  delete [] this->dataPtr->laserScan;
-  this->dataPtr->laserScan = nullptr;
+  this->dataPtr->laserBufferSize = 0;
 
   Camera::Fini();
 }
@@ -241,35 +240,27 @@ void GpuLaser::PostRender()
     unsigned int width = this->dataPtr->secondPassViewport->getActualWidth();
     unsigned int height = this->dataPtr->secondPassViewport->getActualHeight();
 
-    // Get access to the buffer and make an image and write it to file
+    // Get access to the buffer of the second pass
     pixelBuffer = this->dataPtr->secondPassTexture->getBuffer();
 
-    size_t size = Ogre::PixelUtil::getMemorySize(
-                    width, height, 1, Ogre::PF_FLOAT32_RGB);
-
-    // Blit the depth buffer if needed
-    if (!this->dataPtr->laserBuffer)
-      this->dataPtr->laserBuffer = new float[size];
-
-    memset(this->dataPtr->laserBuffer, 255, size);
+    // The blit overwrites every element, and the same buffer is handed to
+    // the iterators and to the newLaserFrame subscribers, so it is neither
+    // cleared nor copied.
+    size_t len = static_cast<size_t>(width) * height * 3;
+    if (!this->dataPtr->laserBuffer || this->dataPtr->laserBufferSize != len)
+    {
+      delete [] this->dataPtr->laserBuffer;
+      this->dataPtr->laserBuffer = new float[len];
+      this->dataPtr->laserBufferSize = len;
+    }
 
     Ogre::PixelBox dstBox(width, height,
         1, Ogre::PF_FLOAT32_RGB, this->dataPtr->laserBuffer);
 
     pixelBuffer->blitToMemory(dstBox);
 
-    if (!this->dataPtr->laserScan)
-    {
-      int len = this->dataPtr->w2nd * this->dataPtr->h2nd * 3;
-      this->dataPtr->laserScan = new float[len];
-    }
-
-    memcpy(this->dataPtr->laserScan, this->dataPtr->laserBuffer,
-           this->dataPtr->w2nd * this->dataPtr->h2nd * 3 *
-           sizeof(this->dataPtr->laserScan[0]));
-
-    this->dataPtr->newLaserFrame(this->dataPtr->laserScan, this->dataPtr->w2nd,
-        this->dataPtr->h2nd, 3, "BLABLA");
+    this->dataPtr->newLaserFrame(this->dataPtr->laserBuffer, width,
+        height, 3, "BLABLA");
   }
 
   this->newData = false;
@@ -888,7 +879,13 @@ void GpuLaser::SetRayCountRatio(const double _rayCountRatio)
   this->rayCountRatio = _rayCountRatio;
 }
 
-//////////////////////////////////////////////////
+/////////////////////////////////////////////////
+bool GpuLaser::HasFrameListeners() const
+{
+  return this->dataPtr->newLaserFrame.ConnectionCount() > 0;
+}
+
+/////////////////////////////////////////////////
 event::ConnectionPtr GpuLaser::ConnectNewLaserFrame(
     std::function<void (const float *_frame, unsigned int _width,
     unsigned int _height, unsigned int _depth,
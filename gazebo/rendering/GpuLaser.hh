@@ -96,6 +96,9 @@ namespace gazebo
       /// \brief Return an iterator to one past the end of the laser data
       public: DataIter LaserDataEnd() const;
 
+      // Documentation inherited
+      public: virtual bool HasFrameListeners() const;
+
       /// \brief Connect to a laser frame signal
       /// \param[in] _subscriber Callback that is called when a new image is
       /// generated
@@ -59,11 +59,12 @@ namespace gazebo
                    unsigned int _height, unsigned int _depth,
                    const std::string &_format)> newLaserFrame;
 
-      /// \brief Raw buffer of laser data.
+      /// \brief Laser data read back from the second pass, also handed to
+      /// the newLaserFrame event.
       public: float *laserBuffer;
 
-      /// \brief Outgoing laser data, used by newLaserFrame event.
-      public: float *laserScan;
+      /// \brief Number of floats of laserBuffer.
+      public: size_t laserBufferSize;
 
       /// \brief Pointer to Ogre material for the first rendering pass.
       public: Ogre::Material *matFirstPass;
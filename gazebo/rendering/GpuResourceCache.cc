@@ -0,0 +1,300 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <map>
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/common/MeshManager.hh"
+#include "gazebo/rendering/ogre_gazebo.h"
+#include "gazebo/rendering/GpuResourceCache.hh"
+
+using namespace gazebo;
+using namespace rendering;
+
+/// \brief Number of frames between two scans of the resources in use,
+/// while the usage is within the budget.
+static const uint64_t kScanInterval = 30;
+
+/////////////////////////////////////////////////
+/// \brief Check whether anything but the resource system refers to a
+/// resource.
+/// \param[in] _res The resource.
+/// \param[in] _extra References held by the caller.
+/// \return True if the resource is in use.
+static bool InUse(const Ogre::ResourcePtr &_res, const long _extra)
+{
+#if OGRE_VERSION_MAJOR == 1 && OGRE_VERSION_MINOR >= 11
+  const long count = _res.use_count();
+#else
+  const long count = _res.useCount();
+#endif
+  return count > static_cast<long>(
+      Ogre::ResourceGroupManager::RESOURCE_SYSTEM_NUM_REFERENCE_COUNTS) +
+      _extra;
+}
+
+namespace gazebo
+{
+  namespace rendering
+  {
+    /// \internal
+    /// \brief Private data for the GpuResourceCache class.
+    class GpuResourceCachePrivate
+    {
+      /// \brief Record the frame in which each resource of a manager was
+      /// last seen in use.
+      /// \param[in] _manager The resource manager.
+      /// \param[in,out] _lastUse Frame of the last use by resource name.
+      public: void Scan(Ogre::ResourceManager &_manager,
+                  std::map<std::string, uint64_t> &_lastUse);
+
+      /// \brief Memory budget in bytes, 0 for no budget.
+      public: size_t budget = 0;
+
+      /// \brief Number of calls to Update.
+      public: uint64_t frame = 0;
+
+      /// \brief Frame of the last scan.
+      public: uint64_t lastScan = 0;
+
+      /// \brief Frame in which each texture was last used.
+      public: std::map<std::string, uint64_t> textureUse;
+
+      /// \brief Frame in which each mesh was last used.
+      public: std::map<std::string, uint64_t> meshUse;
+
+      /// \brief Number of resources released.
+      public: uint64_t evictionCount = 0;
+
+      /// \brief True if the budget was exceeded by resources in use, and
+      /// a warning was printed.
+      public: bool warned = false;
+    };
+  }
+}
+
+/////////////////////////////////////////////////
+void GpuResourceCachePrivate::Scan(Ogre::ResourceManager &_manager,
+    std::map<std::string, uint64_t> &_lastUse)
+{
+  std::map<std::string, uint64_t> lastUse;
+  Ogre::ResourceManager::ResourceMapIterator it =
+    _manager.getResourceIterator();
+  while (it.hasMoreElements())
+  {
+    const Ogre::ResourcePtr *res = it.peekNextValuePtr();
+    it.moveNext();
+
+    // Resources seen for the first time count as just used
+    auto previous = _lastUse.find((*res)->getName());
+    if (InUse(*res, 0) || previous == _lastUse.end())
+      lastUse[(*res)->getName()] = this->frame;
+    else
+      lastUse[(*res)->getName()] = previous->second;
+  }
+
+  // Forget the resources that were removed
+  _lastUse.swap(lastUse);
+}
+
+/////////////////////////////////////////////////
+GpuResourceCache::GpuResourceCache()
+  : dataPtr(new GpuResourceCachePrivate)
+{
+}
+
+/////////////////////////////////////////////////
+GpuResourceCache::~GpuResourceCache()
+{
+}
+
+/////////////////////////////////////////////////
+void GpuResourceCache::SetBudget(const size_t _bytes)
+{
+  this->dataPtr->budget = _bytes;
+  this->dataPtr->warned = false;
+}
+
+/////////////////////////////////////////////////
+size_t GpuResourceCache::Budget() const
+{
+  return this->dataPtr->budget;
+}
+
+/////////////////////////////////////////////////
+size_t GpuResourceCache::Usage() const
+{
+  return Ogre::TextureManager::getSingleton().getMemoryUsage() +
+    Ogre::MeshManager::getSingleton().getMemoryUsage();
+}
+
+/////////////////////////////////////////////////
+size_t GpuResourceCache::Update()
+{
+  ++this->dataPtr->frame;
+
+  // Without a budget nothing is ever released
+  if (!this->dataPtr->budget)
+    return 0;
+
+  const size_t usage = this->Usage();
+  const bool over = usage > this->dataPtr->budget;
+  if (!over)
+    this->dataPtr->warned = false;
+
+  // Scan every frame while resources can be released only
+  if ((!over || this->dataPtr->warned) &&
+      this->dataPtr->frame - this->dataPtr->lastScan < kScanInterval)
+  {
+    return 0;
+  }
+
+  Ogre::TextureManager &textures = Ogre::TextureManager::getSingleton();
+  Ogre::MeshManager &meshes = Ogre::MeshManager::getSingleton();
+  this->dataPtr->Scan(textures, this->dataPtr->textureUse);
+  this->dataPtr->Scan(meshes, this->dataPtr->meshUse);
+  this->dataPtr->lastScan = this->dataPtr->frame;
+
+  if (!over)
+    return 0;
+
+  // Unreferenced resources, least recently used first
+  std::vector<std::tuple<uint64_t, Ogre::ResourceManager *, std::string>>
+    candidates;
+  for (auto const &use : this->dataPtr->textureUse)
+  {
+    if (use.second != this->dataPtr->frame)
+      candidates.push_back(std::make_tuple(use.second, &textures, use.first));
+  }
+  for (auto const &use : this->dataPtr->meshUse)
+  {
+    if (use.second != this->dataPtr->frame)
+      candidates.push_back(std::make_tuple(use.second, &meshes, use.first));
+  }
+  std::sort(candidates.begin(), candidates.end());
+
+  for (auto const &candidate : candidates)
+  {
+    if (this->Usage() <= this->dataPtr->budget)
+      break;
+
+    Ogre::ResourceManager *manager = std::get<1>(candidate);
+    const std::string &name = std::get<2>(candidate);
+    Ogre::ResourcePtr res = manager->getResourceByName(name);
+    if (res.isNull() || !res->isLoaded() || InUse(res, 1))
+      continue;
+
+    if (res->isReloadable())
+    {
+      // Loaded again by the next user
+      res->unload();
+    }
+    else if (manager == &meshes &&
+        common::MeshManager::Instance()->HasMesh(name))
+    {
+      // Created again by the next Visual::InsertMesh
+      manager->remove(res);
+      this->dataPtr->meshUse.erase(name);
+    }
+    else
+    {
+      continue;
+    }
+    ++this->dataPtr->evictionCount;
+  }
+
+  const size_t newUsage = this->Usage();
+  if (newUsage > this->dataPtr->budget && !this->dataPtr->warned)
+  {
+    gzwarn << "Textures and meshes use " << newUsage / (1024 * 1024)
+           << " MB, over the budget of "
+           << this->dataPtr->budget / (1024 * 1024)
+           << " MB, and are all in use.\n";
+    this->dataPtr->warned = true;
+  }
+
+  return usage > newUsage ? usage - newUsage : 0;
+}
+
+/////////////////////////////////////////////////
+uint64_t GpuResourceCache::EvictionCount() const
+{
+  return this->dataPtr->evictionCount;
+}
+
+/////////////////////////////////////////////////
+size_t GpuResourceCache::SceneUsage(Ogre::SceneManager *_manager,
+    const std::vector<Ogre::Texture *> &_renderTextures)
+{
+  if (!_manager)
+    return 0;
+
+  // Resources already counted
+  std::set<std::string> counted;
+  size_t usage = 0;
+
+  Ogre::SceneManager::MovableObjectIterator it =
+    _manager->getMovableObjectIterator("Entity");
+  while (it.hasMoreElements())
+  {
+    Ogre::Entity *entity = static_cast<Ogre::Entity *>(it.getNext());
+
+    const Ogre::MeshPtr &mesh = entity->getMesh();
+    if (!mesh.isNull() && counted.insert("mesh:" + mesh->getName()).second)
+      usage += mesh->getSize();
+
+    for (unsigned int i = 0; i < entity->getNumSubEntities(); ++i)
+    {
+      const Ogre::MaterialPtr &material =
+        entity->getSubEntity(i)->getMaterial();
+      if (material.isNull() || !material->getBestTechnique())
+        continue;
+
+      Ogre::Technique *technique = material->getBestTechnique();
+      for (unsigned int p = 0; p < technique->getNumPasses(); ++p)
+      {
+        Ogre::Pass *pass = technique->getPass(p);
+        for (unsigned int t = 0; t < pass->getNumTextureUnitStates(); ++t)
+        {
+          Ogre::TextureUnitState *state = pass->getTextureUnitState(t);
+          for (unsigned int f = 0; f < state->getNumFrames(); ++f)
+          {
+            const Ogre::TexturePtr &texture = state->_getTexturePtr(f);
+            if (!texture.isNull() && texture->isLoaded() &&
+                counted.insert("texture:" + texture->getName()).second)
+            {
+              usage += texture->getSize();
+            }
+          }
+        }
+      }
+    }
+  }
+
+  for (auto const texture : _renderTextures)
+  {
+    if (texture && counted.insert("texture:" + texture->getName()).second)
+      usage += texture->getSize();
+  }
+
+  return usage;
+}
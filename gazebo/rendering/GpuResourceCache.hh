@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_RENDERING_GPURESOURCECACHE_HH_
+#define GAZEBO_RENDERING_GPURESOURCECACHE_HH_
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "gazebo/util/system.hh"
+
+namespace Ogre
+{
+  class SceneManager;
+  class Texture;
+}
+
+namespace gazebo
+{
+  namespace rendering
+  {
+    // Forward declare private data class.
+    class GpuResourceCachePrivate;
+
+    /// \addtogroup gazebo_rendering
+    /// \{
+
+    /// \class GpuResourceCache GpuResourceCache.hh rendering/rendering.hh
+    /// \brief Keeps the textures and meshes loaded by all the scenes of the
+    /// process within a memory budget.
+    ///
+    /// Ogre keeps a single copy of each texture and mesh, named after its
+    /// URI, which all the scenes of the process share. A resource is
+    /// referenced while an entity or a loaded material uses it, and stays
+    /// loaded after its last user is gone. When the memory used goes over
+    /// the budget, the unreferenced resources are released, the least
+    /// recently used first:
+    /// - textures read from files are unloaded, and are loaded again by the
+    /// next material that uses them.
+    /// - meshes of the common::MeshManager are removed, and are created
+    /// again by the next Visual that inserts them.
+    /// Resources created by hand, such as render textures, are never
+    /// released.
+    class GZ_RENDERING_VISIBLE GpuResourceCache
+    {
+      /// \brief Constructor.
+      public: GpuResourceCache();
+
+      /// \brief Destructor.
+      public: virtual ~GpuResourceCache();
+
+      /// \brief Set the memory budget of textures and meshes.
+      /// \param[in] _bytes The budget in bytes, 0 for no budget.
+      public: void SetBudget(const size_t _bytes);
+
+      /// \brief Get the memory budget of textures and meshes.
+      /// \return The budget in bytes, 0 if there is no budget.
+      public: size_t Budget() const;
+
+      /// \brief Get the memory used by the loaded textures and meshes.
+      /// \return Memory used in bytes.
+      public: size_t Usage() const;
+
+      /// \brief Record which resources are in use, and release the least
+      /// recently used ones while the usage is over the budget. The render
+      /// engine calls this after each frame.
+      /// \return Number of bytes released.
+      public: size_t Update();
+
+      /// \brief Get the number of resources released since the cache was
+      /// created.
+      /// \return Number of resources.
+      public: uint64_t EvictionCount() const;
+
+      /// \brief Get the memory used by the meshes and textures drawn by a
+      /// scene manager. A resource shared by several scenes is counted in
+      /// each of them.
+      /// \param[in] _manager The scene manager.
+      /// \param[in] _renderTextures Render textures of the cameras of the
+      /// scene, which are counted too.
+      /// \return Memory used in bytes.
+      public: static size_t SceneUsage(Ogre::SceneManager *_manager,
+                  const std::vector<Ogre::Texture *> &_renderTextures);
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<GpuResourceCachePrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include "gazebo/common/MeshManager.hh"
+#include "gazebo/rendering/ogre_gazebo.h"
+#include "gazebo/rendering/GpuResourceCache.hh"
+#include "gazebo/rendering/RenderEngine.hh"
+#include "gazebo/rendering/RenderingIface.hh"
+#include "gazebo/rendering/Scene.hh"
+#include "gazebo/rendering/Visual.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+class GpuResourceCache_TEST : public RenderingFixture
+{
+};
+
+/////////////////////////////////////////////////
+TEST_F(GpuResourceCache_TEST, Evict)
+{
+  Load("worlds/empty.world");
+
+  gazebo::rendering::ScenePtr scene = gazebo::rendering::get_scene();
+  ASSERT_NE(scene, nullptr);
+
+  // The engine has no budget by default
+  rendering::RenderEngine *engine = rendering::RenderEngine::Instance();
+  EXPECT_EQ(0u, engine->GpuMemoryBudget());
+  engine->SetGpuMemoryBudget(512u * 1024 * 1024);
+  EXPECT_EQ(512u * 1024 * 1024, engine->GpuMemoryBudget());
+  engine->SetGpuMemoryBudget(0u);
+
+  rendering::GpuResourceCache cache;
+  EXPECT_EQ(0u, cache.Budget());
+  EXPECT_EQ(engine->GpuMemoryUsage(), cache.Usage());
+
+  const std::string meshName = "gpu_resource_cache_box";
+  common::MeshManager::Instance()->CreateBox(meshName,
+      ignition::math::Vector3d::One, ignition::math::Vector2d::One);
+
+  // The mesh of a visual counts in its scene
+  size_t sceneUsage = rendering::GpuResourceCache::SceneUsage(
+      scene->OgreSceneManager(), {});
+  rendering::VisualPtr box(new rendering::Visual("box", scene->WorldVisual()));
+  box->Load();
+  box->AttachMesh(meshName);
+  ASSERT_TRUE(Ogre::MeshManager::getSingleton().resourceExists(meshName));
+  Ogre::MeshPtr mesh = Ogre::MeshManager::getSingleton().getByName(meshName);
+  EXPECT_EQ(sceneUsage + mesh->getSize(),
+      rendering::GpuResourceCache::SceneUsage(
+        scene->OgreSceneManager(), {}));
+  mesh.setNull();
+
+  // Resources in use are kept, even over the budget
+  cache.SetBudget(1u);
+  EXPECT_EQ(1u, cache.Budget());
+  cache.Update();
+  EXPECT_TRUE(Ogre::MeshManager::getSingleton().resourceExists(meshName));
+
+  // The mesh is released once unused
+  box->Fini();
+  box.reset();
+  uint64_t evictions = cache.EvictionCount();
+  cache.Update();
+  EXPECT_GT(cache.EvictionCount(), evictions);
+  EXPECT_FALSE(Ogre::MeshManager::getSingleton().resourceExists(meshName));
+
+  // and created again when needed
+  box.reset(new rendering::Visual("box2", scene->WorldVisual()));
+  box->Load();
+  box->AttachMesh(meshName);
+  EXPECT_TRUE(Ogre::MeshManager::getSingleton().resourceExists(meshName));
+
+  // Nothing is released without a budget
+  box->Fini();
+  box.reset();
+  cache.SetBudget(0u);
+  evictions = cache.EvictionCount();
+  EXPECT_EQ(0u, cache.Update());
+  EXPECT_EQ(evictions, cache.EvictionCount());
+  EXPECT_TRUE(Ogre::MeshManager::getSingleton().resourceExists(meshName));
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -15,7 +15,10 @@
  *
 */
 
+#include <algorithm>
+#include <atomic>
 #include <memory>
+#include <thread>
 
 #include <string.h>
 #include <math.h>
@@ -56,8 +59,8 @@ using Ogre::LOW_LOD;
 
 const double HeightmapPrivate::loadRadiusFactor = 1.0;
 const double HeightmapPrivate::holdRadiusFactor = 1.15;
+const double HeightmapPrivate::streamingRadiusFactor = 1.5;
 const boost::filesystem::path HeightmapPrivate::pagingDirname = "paging";
-const boost::filesystem::path HeightmapPrivate::hashFilename = "gzterrain.SHA1";
 
 static std::string glslVersion = "130";
 static std::string vpInStr = "in";
@@ -72,10 +75,7 @@ Heightmap::Heightmap(ScenePtr _scene)
 {
   this->dataPtr->scene = _scene;
 
-  this->dataPtr->terrainIdx = 0;
   this->dataPtr->useTerrainPaging = false;
-  this->dataPtr->terrainHashChanged = true;
-  this->dataPtr->terrainsImported = true;
 
   this->dataPtr->gzPagingDir =
       common::SystemPaths::Instance()->GetLogPath() /
@@ -235,6 +235,38 @@ common::Image Heightmap::Image() const
   return result;
 }
 
+/////////////////////////////////////////////////
+/// \brief Copy a tile of a square heightmap split in _n * _n tiles. The
+/// vertices shared with the next tiles are replaced by copies of the last
+/// row and column of the tile.
+/// \param[in] _heightmap Heights of the heightmap.
+/// \param[in] _n Number of tiles along a side.
+/// \param[in] _index Index of the tile, row major.
+/// \param[out] _tile Heights of the tile.
+static void CopyTile(const std::vector<float> &_heightmap, const int _n,
+    const int _index, std::vector<float> &_tile)
+{
+  const int width = sqrt(_heightmap.size());
+  const int newWidth = 1 + (width - 1) / _n;
+  const int row0 = (_index / _n) * (newWidth - 1);
+  const int col0 = (_index % _n) * (newWidth - 1);
+
+  _tile.clear();
+  _tile.reserve(newWidth * newWidth);
+  for (int row = 0; row < newWidth - 1; ++row)
+  {
+    auto start = _heightmap.begin() + (row0 + row) * width + col0;
+    _tile.insert(_tile.end(), start, start + newWidth - 1);
+
+    // Copy last value into the last column
+    _tile.push_back(_tile.back());
+  }
+
+  // Copy the last row
+  std::vector<float> lastRow(_tile.end() - newWidth, _tile.end());
+  _tile.insert(_tile.end(), lastRow.begin(), lastRow.end());
+}
+
 //////////////////////////////////////////////////
 void Heightmap::SplitHeights(const std::vector<float> &_heightmap,
     const int _n, std::vector<std::vector<float> > &_v)
@@ -243,110 +275,64 @@ void Heightmap::SplitHeights(const std::vector<float> &_heightmap,
   GZ_ASSERT(_n == 4 || _n == 16,
       "Invalid number of terrain divisions (it should be 4 or 16)");
 
-  int count = 0;
-  int width = sqrt(_heightmap.size());
-  int newWidth = 1 + (width - 1) / sqrt(_n);
-
   // Memory allocation
   _v.resize(_n);
 
-  for (int tileR = 0; tileR < sqrt(_n); ++tileR)
-  {
-    int tileIndex = tileR * sqrt(_n);
-    for (int row = 0; row < newWidth - 1; ++row)
-    {
-      for (int tileC = 0; tileC < sqrt(_n); ++tileC)
-      {
-        for (int col = 0; col < newWidth - 1; ++col)
-        {
-          _v[tileIndex].push_back(_heightmap[count]);
-          ++count;
-        }
-        // Copy last value into the last column
-        _v[tileIndex].push_back(_v[tileIndex].back());
-
-        tileIndex = tileR * sqrt(_n) +
-            (tileIndex + 1) % static_cast<int>(sqrt(_n));
-      }
-      ++count;
-    }
-    // Copy the last row
-    for (int i = 0; i < sqrt(_n); ++i)
-    {
-      tileIndex = tileR * sqrt(_n) + i;
-      std::vector<float> lastRow(_v[tileIndex].end() - newWidth,
-          _v[tileIndex].end());
-      _v[tileIndex].insert(_v[tileIndex].end(),
-          lastRow.begin(), lastRow.end());
-    }
-  }
+  for (int i = 0; i < _n; ++i)
+    CopyTile(_heightmap, sqrt(_n), i, _v[i]);
 }
 
 //////////////////////////////////////////////////
-void Heightmap::UpdateTerrainHash(const std::string &_hash,
-    const boost::filesystem::path &_terrainDir)
+void Heightmap::PrepareTiles(const boost::filesystem::path &_prefix,
+    const int _n)
 {
-  std::ofstream terrainHashFile;
-  boost::filesystem::path terrainHashFullPath;
+  const int sqrtN = sqrt(_n);
+  const std::string worldSize =
+    std::to_string(this->dataPtr->terrainSize.X() / sqrtN);
 
-  // Create the subdirectories if they do not exist
-  boost::filesystem::create_directories(_terrainDir);
+  if (this->dataPtr->splitTerrain)
+    this->dataPtr->subTerrains.resize(_n);
+  this->dataPtr->tiles.resize(_n);
 
-  terrainHashFullPath = _terrainDir / this->dataPtr->hashFilename;
-
-  // Update the terrain hash
-  terrainHashFile.open(terrainHashFullPath.string().c_str());
-
-  // Throw an error if we couldn't open the file for writing.
-  if (terrainHashFile.is_open())
+  // Tiles are taken in turn by the workers. Splitting and hashing the
+  // heights of a large DEM takes seconds on a single thread.
+  std::atomic<int> next(0);
+  auto prepare = [&]()
   {
-    terrainHashFile << _hash;
-    terrainHashFile.close();
-  }
-  else
-  {
-    gzerr << "Unable to open file for creating a terrain hash: [" +
-        terrainHashFullPath.string() + "]\n";
-  }
-}
-
-//////////////////////////////////////////////////
-bool Heightmap::PrepareTerrain(
-    const boost::filesystem::path &_terrainDirPath)
-{
-  std::string heightmapHash;
-  boost::filesystem::path terrainHashFullPath;
-  bool updateHash = true;
+    for (int i = next++; i < _n; i = next++)
+    {
+      const std::vector<float> *heights = &this->dataPtr->heights;
+      if (this->dataPtr->splitTerrain)
+      {
+        CopyTile(this->dataPtr->heights, sqrtN, i,
+            this->dataPtr->subTerrains[i]);
+        heights = &this->dataPtr->subTerrains[i];
+      }
 
-  // Compute the original heightmap's image.
-  heightmapHash = common::get_sha1<std::vector<float> >(this->dataPtr->heights);
+      // The cache file is named after the content of the tile, so that a
+      // change of the heightmap only imports the tiles that changed
+      HeightmapTile &tile = this->dataPtr->tiles[i];
+      tile.x = i % sqrtN;
+      tile.y = i / sqrtN;
+      tile.filename = _prefix.string() + "_" + common::get_sha1<std::string>(
+          common::get_sha1<std::vector<float> >(*heights) + worldSize) +
+        ".dat";
+      tile.imported = !boost::filesystem::exists(tile.filename);
 
-  // Check if the terrain hash exists
-  terrainHashFullPath = _terrainDirPath / this->dataPtr->hashFilename;
-  if (boost::filesystem::exists(terrainHashFullPath))
-  {
-    try
-    {
-      // Read the terrain hash
-      std::ifstream in(terrainHashFullPath.string().c_str());
-      std::stringstream buffer;
-      buffer << in.rdbuf();
-      std::string terrainHash(buffer.str());
-      updateHash = terrainHash != heightmapHash;
+      // The heights of the cached tiles are not needed anymore
+      if (!tile.imported && this->dataPtr->splitTerrain)
+        std::vector<float>().swap(this->dataPtr->subTerrains[i]);
     }
-    catch(std::ifstream::failure &e)
-    {
-      gzerr << "Terrain paging error: Unable to read terrain hash\n";
-    }
-  }
-
-  // Update the terrain hash and split the terrain into small pieces
-  if (updateHash)
-  {
-    this->UpdateTerrainHash(heightmapHash, _terrainDirPath);
-  }
+  };
 
-  return updateHash;
+  const int threads = std::min(_n,
+      std::max(static_cast<int>(std::thread::hardware_concurrency()), 1));
+  std::vector<std::thread> workers;
+  for (int i = 1; i < threads; ++i)
+    workers.push_back(std::thread(prepare));
+  prepare();
+  for (auto &worker : workers)
+    worker.join();
 }
 
 //////////////////////////////////////////////////
@@ -395,8 +381,10 @@ void Heightmap::Load()
   // try loading heightmap data locally
   if (!this->dataPtr->filename.empty())
   {
-    this->dataPtr->heightmapData = common::HeightmapDataLoader::LoadTerrainFile(
-        this->dataPtr->filename);
+    this->dataPtr->sharedHeightmapData =
+      common::HeightmapDataLoader::LoadTerrainFileShared(
+          this->dataPtr->filename);
+    this->dataPtr->heightmapData = this->dataPtr->sharedHeightmapData.get();
 
     if (this->dataPtr->heightmapData)
     {
@@ -493,9 +481,11 @@ void Heightmap::Load()
     return;
   }
 
+  // Heights received from the server are cached at the top level, their
+  // file names only depend on their content
   boost::filesystem::path imgPath;
   boost::filesystem::path terrainName;
-  boost::filesystem::path terrainDirPath;
+  boost::filesystem::path terrainDirPath = this->dataPtr->gzPagingDir;
   boost::filesystem::path prefix;
   if (!this->dataPtr->filename.empty())
   {
@@ -592,17 +582,21 @@ void Heightmap::Load()
     }
   }
 
-  this->dataPtr->terrainHashChanged = this->PrepareTerrain(terrainDirPath);
+  boost::system::error_code ec;
+  boost::filesystem::create_directories(terrainDirPath, ec);
+  if (ec)
+  {
+    gzerr << "Unable to create the terrain cache directory ["
+          << terrainDirPath.string() << "]: " << ec.message() << std::endl;
+  }
+
+  gzmsg << "Loading heightmap: " << terrainName.string() << std::endl;
+  common::Time time = common::Time::GetWallTime();
+
+  this->PrepareTiles(prefix, nTerrains);
 
   if (this->dataPtr->useTerrainPaging)
   {
-    if (this->dataPtr->terrainHashChanged)
-    {
-      // Split the terrain. Every subterrain will be saved on disk and paged
-      this->SplitHeights(this->dataPtr->heights, nTerrains,
-          this->dataPtr->subTerrains);
-    }
-
     this->dataPtr->pageManager = OGRE_NEW Ogre::PageManager();
     this->dataPtr->pageManager->setPageProvider(
         &this->dataPtr->dummyPageProvider);
@@ -620,87 +614,170 @@ void Heightmap::Load()
           this->dataPtr->scene->GetUserCamera(i)->OgreCamera());
     }
 
+    // While streaming, only the pages around the cameras are loaded
+    double loadRadius =
+      this->dataPtr->loadRadiusFactor * this->dataPtr->terrainSize.X();
+    if (this->dataPtr->streaming)
+    {
+      loadRadius = this->dataPtr->streamingRadiusFactor *
+        this->dataPtr->terrainSize.X() / sqrtN;
+    }
+
     this->dataPtr->terrainPaging =
         OGRE_NEW Ogre::TerrainPaging(this->dataPtr->pageManager);
     this->dataPtr->world = this->dataPtr->pageManager->createWorld();
-    this->dataPtr->terrainPaging->createWorldSection(
+    auto section = this->dataPtr->terrainPaging->createWorldSection(
         this->dataPtr->world, this->dataPtr->terrainGroup,
-        this->dataPtr->loadRadiusFactor * this->dataPtr->terrainSize.X(),
-        this->dataPtr->holdRadiusFactor * this->dataPtr->terrainSize.X(),
+        loadRadius, this->dataPtr->holdRadiusFactor * loadRadius,
         0, 0, sqrtN - 1, sqrtN - 1);
+#if OGRE_VERSION_MAJOR > 1 || OGRE_VERSION_MINOR >= 9
+    section->setDefiner(OGRE_NEW TerrainTileDefiner());
+#else
+    (void)section;
+    if (this->dataPtr->streaming)
+    {
+      gzwarn << "Heightmap streaming requires Ogre 1.9, the terrain pages "
+             << "will all be loaded" << std::endl;
+      this->dataPtr->streaming = false;
+    }
+#endif
   }
 
-  gzmsg << "Loading heightmap: " << terrainName.string() << std::endl;
-  common::Time time = common::Time::GetWallTime();
-
   for (int y = 0; y <= sqrtN - 1; ++y)
     for (int x = 0; x <= sqrtN - 1; ++x)
       this->DefineTerrain(x, y);
 
+  // The terrain group keeps a copy of the heights of the imported tiles
+  this->dataPtr->subTerrains.clear();
+
   // use gazebo shaders
   this->CreateMaterial();
 
-  // Sync load since we want everything in place when we start
-  this->dataPtr->terrainGroup->loadAllTerrains(true);
+  // Sync load since we want everything in place when we start, unless the
+  // terrain is streamed. The paging then loads the pages around the
+  // cameras.
+  if (!this->dataPtr->streaming)
+    this->dataPtr->terrainGroup->loadAllTerrains(true);
+  else if (!this->dataPtr->useTerrainPaging)
+    this->dataPtr->terrainGroup->loadAllTerrains(false);
 
   gzmsg << "Heightmap loaded. Process took: "
         <<  (common::Time::GetWallTime() - time).Double()
         << " seconds" << std::endl;
 
-  // Calculate blend maps
-  if (this->dataPtr->terrainsImported)
+  this->dataPtr->connections.push_back(
+      event::Events::ConnectPreRender(
+      std::bind(&Heightmap::UpdateTiles, this)));
+}
+
+///////////////////////////////////////////////////
+void Heightmap::UpdateTiles()
+{
+  // Page the terrain around the cameras created since Load
+  if (this->dataPtr->streaming && this->dataPtr->pageManager)
   {
-    Ogre::TerrainGroup::TerrainIterator ti =
-      this->dataPtr->terrainGroup->getTerrainIterator();
-    while (ti.hasMoreElements())
+    for (unsigned int i = 0; i < this->dataPtr->scene->CameraCount(); ++i)
+    {
+      Ogre::Camera *camera = this->dataPtr->scene->GetCamera(i)->OgreCamera();
+      if (camera && !this->dataPtr->pageManager->hasCamera(camera))
+        this->dataPtr->pageManager->addCamera(camera);
+    }
+    for (unsigned int i = 0; i < this->dataPtr->scene->UserCameraCount();
+        ++i)
     {
-      Ogre::Terrain *t = ti.getNext()->instance;
-      this->InitBlendMaps(t);
+      Ogre::Camera *camera =
+        this->dataPtr->scene->GetUserCamera(i)->OgreCamera();
+      if (camera && !this->dataPtr->pageManager->hasCamera(camera))
+        this->dataPtr->pageManager->addCamera(camera);
     }
   }
 
-  this->dataPtr->terrainGroup->freeTemporaryResources();
-
-  // save the terrain once its loaded
-  if (this->dataPtr->terrainsImported)
+  bool blended = false;
+  bool saved = false;
+  for (auto &tile : this->dataPtr->tiles)
   {
-    this->dataPtr->connections.push_back(
-        event::Events::ConnectPreRender(
-        std::bind(&Heightmap::SaveHeightmap, this)));
-  }
-}
+    if (!tile.imported || tile.saved)
+      continue;
 
-///////////////////////////////////////////////////
-void Heightmap::SaveHeightmap()
-{
-  if (this->dataPtr->terrainsImported &&
-      !this->dataPtr->terrainGroup->isDerivedDataUpdateInProgress())
-  {
-    // check to see if all terrains have been loaded before saving
-    Ogre::TerrainGroup::TerrainIterator ti =
-      this->dataPtr->terrainGroup->getTerrainIterator();
-    while (ti.hasMoreElements())
+    Ogre::Terrain *terrain =
+      this->dataPtr->terrainGroup->getTerrain(tile.x, tile.y);
+    // An unloaded page gets its blend maps again once loaded
+    if (!terrain)
+      tile.blended = false;
+    if (!terrain || !terrain->isLoaded())
+      continue;
+
+    // Calculate blend maps
+    if (!tile.blended)
     {
-      Ogre::Terrain *t = ti.getNext()->instance;
-      if (!t->isLoaded())
-        return;
+      this->InitBlendMaps(terrain);
+      tile.blended = true;
+      blended = true;
+      continue;
     }
 
-    // saving an ogre terrain data file can take quite some time for large dems.
-    gzmsg << "Saving heightmap cache data to " << (this->dataPtr->gzPagingDir /
-        boost::filesystem::path(this->dataPtr->filename).stem()).string()
-        << std::endl;
+    // Saving an ogre terrain data file can take quite some time for large
+    // dems, so a single tile is saved per frame
+    if (saved || terrain->isDerivedDataUpdateInProgress())
+      continue;
+
+    gzmsg << "Saving heightmap cache data to " << tile.filename << std::endl;
     common::Time time = common::Time::GetWallTime();
 
-    this->dataPtr->terrainGroup->saveAllTerrains(true);
+    // Saved to a temporary file first, so that the cache never holds a
+    // partial tile
+    const std::string tmpFilename = tile.filename + ".tmp";
+    terrain->save(tmpFilename);
+    boost::system::error_code ec;
+    boost::filesystem::rename(tmpFilename, tile.filename, ec);
+    if (ec)
+    {
+      gzerr << "Unable to save heightmap cache data to [" << tile.filename
+            << "]: " << ec.message() << std::endl;
+    }
+    else
+    {
+      // A page loaded again reads the cache instead of importing the
+      // heights, which releases the heights of the tile
+      this->dataPtr->terrainGroup->defineTerrain(tile.x, tile.y,
+          tile.filename);
+    }
 
     gzmsg << "Heightmap cache data saved. Process took: "
           << (common::Time::GetWallTime() - time).Double() << " seconds."
           << std::endl;
 
-    this->dataPtr->terrainsImported = false;
-    this->dataPtr->connections.clear();
+    tile.saved = true;
+    saved = true;
   }
+
+  if (blended)
+    this->dataPtr->terrainGroup->freeTemporaryResources();
+}
+
+///////////////////////////////////////////////////
+void Heightmap::SetStreaming(const bool _enabled)
+{
+  this->dataPtr->streaming = _enabled;
+}
+
+///////////////////////////////////////////////////
+bool Heightmap::Streaming() const
+{
+  return this->dataPtr->streaming;
+}
+
+///////////////////////////////////////////////////
+bool Heightmap::Ready() const
+{
+  for (auto const &tile : this->dataPtr->tiles)
+  {
+    Ogre::Terrain *terrain =
+      this->dataPtr->terrainGroup->getTerrain(tile.x, tile.y);
+    if (terrain && (!terrain->isLoaded() || (tile.imported && !tile.blended)))
+      return false;
+  }
+  return true;
 }
 
 ///////////////////////////////////////////////////
@@ -832,40 +909,25 @@ void Heightmap::SetWireframe(const bool _show)
 /////////////////////////////////////////////////
 void Heightmap::DefineTerrain(const int _x, const int _y)
 {
-  Ogre::String filename = this->dataPtr->terrainGroup->generateFilename(_x, _y);
+  const int sqrtN = sqrt(this->dataPtr->tiles.size());
+  const int index = _y * sqrtN + _x;
+  const HeightmapTile &tile = this->dataPtr->tiles[index];
 
-  bool resourceExists =
-      Ogre::ResourceGroupManager::getSingleton().resourceExists(
-      this->dataPtr->terrainGroup->getResourceGroup(), filename);
-
-  if (resourceExists && !this->dataPtr->terrainHashChanged)
+  if (!tile.imported)
   {
-    gzmsg << "Loading heightmap cache data: " << filename << std::endl;
+    gzmsg << "Loading heightmap cache data: " << tile.filename << std::endl;
 
-    this->dataPtr->terrainGroup->defineTerrain(_x, _y);
-    this->dataPtr->terrainsImported = false;
+    this->dataPtr->terrainGroup->defineTerrain(_x, _y, tile.filename);
+  }
+  else if (this->dataPtr->splitTerrain)
+  {
+    this->dataPtr->terrainGroup->defineTerrain(_x, _y,
+        &this->dataPtr->subTerrains[index][0]);
   }
   else
   {
-    if (this->dataPtr->splitTerrain)
-    {
-      // generate the subterrains if needed
-      if (this->dataPtr->subTerrains.empty())
-      {
-        this->SplitHeights(this->dataPtr->heights,
-            this->dataPtr->numTerrainSubdivisions,
-            this->dataPtr->subTerrains);
-      }
-
-      this->dataPtr->terrainGroup->defineTerrain(_x, _y,
-          &this->dataPtr->subTerrains[this->dataPtr->terrainIdx][0]);
-      ++this->dataPtr->terrainIdx;
-    }
-    else
-    {
-      this->dataPtr->terrainGroup->defineTerrain(_x, _y,
-          &this->dataPtr->heights[0]);
-    }
+    this->dataPtr->terrainGroup->defineTerrain(_x, _y,
+        &this->dataPtr->heights[0]);
   }
 }
 
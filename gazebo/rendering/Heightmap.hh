@@ -219,6 +219,22 @@ namespace gazebo
       /// \return True if the heightmap terrain casts shadows
       public: bool CastShadows() const;
 
+      /// \brief Load the terrain in the background instead of blocking Load.
+      /// With terrain paging, only the pages around the cameras are then
+      /// loaded, and the pages far from all the cameras are unloaded. It
+      /// must be set before Load.
+      /// \param[in] _enabled True to stream the terrain.
+      public: void SetStreaming(const bool _enabled);
+
+      /// \brief Check whether the terrain is loaded in the background.
+      /// \return True if the terrain is streamed.
+      public: bool Streaming() const;
+
+      /// \brief Check whether the terrain finished loading, i.e. no terrain
+      /// page is loading and the loaded pages have their blend maps.
+      /// \return True if the terrain is ready.
+      public: bool Ready() const;
+
       /// \brief Create terrain material generator. There are two types:
       /// custom material generator that support user material scripts,
       /// and a default material generator that uses our own glsl shader
@@ -252,26 +268,18 @@ namespace gazebo
       /// \param[in] _enabled True to enable shadows.
       private: void SetupShadows(const bool _enabled);
 
-      /// \brief Update the hash of a terrain file. The hash will be written in
-      /// a file called gzterrain.SHA1 . This method will be used when the
-      /// paging is enabled and the terrain is loaded for the first time or if
-      /// the heightmap's image has been modified.
-      /// \param[in] _hash New hash value
-      /// \param[in] _terrainDir Directory where the terrain hash and the
-      /// terrain pages are stored. Ex: $TMP/gazebo-paging/heigthmap_bowl
-      private: void UpdateTerrainHash(const std::string &_hash,
-          const boost::filesystem::path &_terrainDir);
-
-      /// \brief Checks if the terrain was previously loaded by comparing its
-      /// hash against the one stored in the terrain directory
-      /// \param[in] _terrainDirPath Path to the directory containing the
-      /// terrain files and hash.
-      /// \return True if the terrain requires to regenerate the terrain files.
-      private: bool PrepareTerrain(
-          const boost::filesystem::path &_terrainDirPath);
-
-      /// \brief Save the heightmap tiles to disk
-      private: void SaveHeightmap();
+      /// \brief Split the heights into tiles, and look for the cache file of
+      /// each tile, named after the hash of the tile. The tiles are prepared
+      /// by a pool of worker threads.
+      /// \param[in] _prefix Path and prefix of the cache files.
+      /// \param[in] _n Number of tiles.
+      private: void PrepareTiles(const boost::filesystem::path &_prefix,
+          const int _n);
+
+      /// \brief Set the blend maps of the imported tiles that finished
+      /// loading, save them to the cache, one per frame, and page the
+      /// terrain around the cameras created since Load while streaming.
+      private: void UpdateTiles();
 
       /// \internal
       /// \brief Pointer to private data.
@@ -17,6 +17,7 @@
 #ifndef _GAZEBO_RENDERING_HEIGHTMAPPRIVATE_HH_
 #define _GAZEBO_RENDERING_HEIGHTMAPPRIVATE_HH_
 
+#include <memory>
 #include <string>
 #include <vector>
 #include <boost/filesystem.hpp>
@@ -354,6 +355,53 @@ namespace gazebo
       }
     };
 
+#if OGRE_VERSION_MAJOR > 1 || OGRE_VERSION_MINOR >= 9
+    /// \internal
+    /// \brief Keeps the definitions of the terrain pages. Heightmap::Load
+    /// defines every page, from the cache or from the heights, while the
+    /// default definer would define the pages again from the default file
+    /// names.
+    class TerrainTileDefiner :
+      public Ogre::TerrainPagedWorldSection::TerrainDefiner
+    {
+      /// \brief Define a page that was not defined yet.
+      /// \param[in] _group The terrain group.
+      /// \param[in] _x X index of the page.
+      /// \param[in] _y Y index of the page.
+      public: virtual void define(Ogre::TerrainGroup *_group, long _x,
+                  long _y)
+      {
+        if (!_group->getTerrainDefinition(_x, _y))
+          _group->defineTerrain(_x, _y);
+      }
+    };
+#endif
+
+    /// \internal
+    /// \brief A tile of the terrain group and its file in the terrain cache.
+    class HeightmapTile
+    {
+      /// \brief Index of the tile along x.
+      public: long x = 0;
+
+      /// \brief Index of the tile along y.
+      public: long y = 0;
+
+      /// \brief Path of the cache file of the tile, named after the hash of
+      /// the heights and size of the tile.
+      public: std::string filename;
+
+      /// \brief True if the tile is imported from the heights, false if it
+      /// is loaded from its cache file.
+      public: bool imported = false;
+
+      /// \brief True once the blend maps of the imported tile were set.
+      public: bool blended = false;
+
+      /// \brief True once the imported tile was saved to the cache.
+      public: bool saved = false;
+    };
+
     /// \internal
     /// \brief Private data for the Heightmap class
     class HeightmapPrivate
@@ -371,9 +419,10 @@ namespace gazebo
       /// depends on the terrain size.
       public: static const double holdRadiusFactor;
 
-      /// \brief Hash file name that should be present for every terrain file
-      /// loaded using paging.
-      public: static const boost::filesystem::path hashFilename;
+      /// \brief While streaming, the load radius is this multiplier applied
+      /// to the size of a terrain page, so that the page under a camera and
+      /// its eight neighbours are loaded.
+      public: static const double streamingRadiusFactor;
 
       /// \brief Name of the top level directory where all the paging info is
       /// stored
@@ -402,9 +451,6 @@ namespace gazebo
       /// \brief Group of terrains.
       public: Ogre::TerrainGroup *terrainGroup;
 
-      /// \brief True if the terrain was imported.
-      public: bool terrainsImported;
-
       /// \brief The diffuse textures.
       public: std::vector<std::string> diffuseTextures;
 
@@ -441,17 +487,20 @@ namespace gazebo
       /// \brief Collection of world content
       public: Ogre::PagedWorld *world;
 
-      /// \brief Collection of terrains. Every terrain might be paged.
+      /// \brief Collection of terrains. Every terrain might be paged. The
+      /// heights are released once the terrains are defined.
       public: std::vector<std::vector<float> > subTerrains;
 
-      /// \brief Used to iterate over all the terrains
-      public: int terrainIdx;
+      /// \brief The tiles of the terrain group, indexed by y * n + x, with n
+      /// the number of tiles along a side.
+      public: std::vector<HeightmapTile> tiles;
 
       /// \brief Flag that enables/disables the terrain paging
       public: bool useTerrainPaging;
 
-      /// \brief True if the terrain's hash does not match the image's hash
-      public: bool terrainHashChanged;
+      /// \brief True to load the terrain in the background, and only around
+      /// the cameras when paging.
+      public: bool streaming = false;
 
       /// \brief Name of custom material to use for the terrain. If empty,
       /// default material with glsl shader will be used.
@@ -463,6 +512,10 @@ namespace gazebo
       /// \brief Pointer to heightmap data
       public: common::HeightmapData *heightmapData = nullptr;
 
+      /// \brief Owner of heightmapData, which is shared with the physics
+      /// heightmaps of the same file.
+      public: std::shared_ptr<common::HeightmapData> sharedHeightmapData;
+
       /// \brief Number of samples per heightmap datum
       public: unsigned int sampling = 2u;
 
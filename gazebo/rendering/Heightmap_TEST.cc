@@ -114,6 +114,34 @@ TEST_F(Heightmap_TEST, LOD)
   EXPECT_EQ(heightmap->LOD(), 0u);
 }
 
+/////////////////////////////////////////////////
+/// \brief Test terrain's streaming API
+TEST_F(Heightmap_TEST, Streaming)
+{
+  Load("worlds/empty.world");
+
+  gazebo::rendering::ScenePtr scene = gazebo::rendering::get_scene("default");
+  ASSERT_TRUE(scene != nullptr);
+
+  gazebo::rendering::Heightmap *heightmap =
+      new gazebo::rendering::Heightmap(scene);
+
+  // Nothing is loading before Load
+  EXPECT_FALSE(heightmap->Streaming());
+  EXPECT_TRUE(heightmap->Ready());
+  heightmap->SetStreaming(true);
+  EXPECT_TRUE(heightmap->Streaming());
+  heightmap->SetStreaming(false);
+  EXPECT_FALSE(heightmap->Streaming());
+
+  EXPECT_FALSE(scene->HeightmapStreaming());
+  scene->SetHeightmapStreaming(true);
+  EXPECT_TRUE(scene->HeightmapStreaming());
+  scene->SetHeightmapStreaming(false);
+
+  delete heightmap;
+}
+
 #ifdef HAVE_GDAL
 /////////////////////////////////////////////////
 /// \brief Test Loading a terrain from a DEM file
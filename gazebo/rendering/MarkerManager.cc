@@ -64,6 +64,14 @@ class gazebo::rendering::MarkerManagerPrivate
   /// \param[in] _req The marker message.
   public: void OnMarkerMsg(const ignition::msgs::Marker &_req);
 
+  /// \brief Callback that receives many marker messages in one request,
+  /// which is cheaper than a request per marker.
+  /// \param[in] _req The marker messages, processed in order.
+  /// \param[out] _rep Set to true.
+  /// \return True.
+  public: bool OnMarkerArrayMsg(const ignition::msgs::Marker_V &_req,
+              ignition::msgs::Boolean &_rep);
+
   /// \brief Service callback that returns a list of markers.
   /// \param[out] _rep Service reply
   /// \return True on success.
@@ -142,6 +150,13 @@ bool MarkerManager::Init(Scene *_scene)
     gzerr << "Unable to advertise to the /marker service.\n";
   }
 
+  // Advertise to the marker array service
+  if (!this->dataPtr->node.Advertise("/marker_array",
+        &MarkerManagerPrivate::OnMarkerArrayMsg, this->dataPtr.get()))
+  {
+    gzerr << "Unable to advertise to the /marker_array service.\n";
+  }
+
   this->dataPtr->gznode = transport::NodePtr(new transport::Node());
   this->dataPtr->gznode->Init();
 
@@ -333,6 +348,17 @@ void MarkerManagerPrivate::OnMarkerMsg(const ignition::msgs::Marker &_req)
   this->markerMsgs.push_back(_req);
 }
 
+/////////////////////////////////////////////////
+bool MarkerManagerPrivate::OnMarkerArrayMsg(
+    const ignition::msgs::Marker_V &_req, ignition::msgs::Boolean &_rep)
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  this->markerMsgs.insert(this->markerMsgs.end(), _req.marker().begin(),
+      _req.marker().end());
+  _rep.set_data(true);
+  return true;
+}
+
 /////////////////////////////////////////////////
 bool MarkerManagerPrivate::OnList(ignition::msgs::Marker_V &_rep)
 {
@@ -14,9 +14,13 @@
  * limitations under the License.
  *
 */
+#include <vector>
+
 #include <ignition/common/Profiler.hh>
 
 #include "gazebo/common/Console.hh"
+#include "gazebo/common/Mesh.hh"
+#include "gazebo/common/MeshManager.hh"
 #include "gazebo/rendering/RenderEvents.hh"
 #include "gazebo/rendering/DynamicLines.hh"
 #include "gazebo/rendering/Scene.hh"
@@ -47,8 +51,39 @@ class gazebo::rendering::MarkerVisualPrivate : public VisualPrivate
 
   /// \brief True when the marker has already been loaded.
   public: bool loaded = false;
+
+  /// \brief Name of the mesh drawn at each point of a shape list, empty if
+  /// the marker isn't a shape list.
+  public: std::string shapeMesh;
+
+  /// \brief Points of the shapes of a shape list.
+  public: std::vector<ignition::math::Vector3d> shapePoints;
+
+  /// \brief Colors of the shapes of a shape list, empty to use white.
+  public: std::vector<ignition::math::Color> shapeColors;
+
+  /// \brief Size of the shapes of a shape list.
+  public: ignition::math::Vector3d shapeScale = ignition::math::Vector3d::One;
 };
 
+/////////////////////////////////////////////////
+/// \brief Get the colors of the points of a marker message.
+/// \param[in] _msg The marker message.
+/// \return The diffuse color of each material, or no colors if the
+/// message doesn't have one material per point.
+static std::vector<ignition::math::Color> PointColors(
+    const ignition::msgs::Marker &_msg)
+{
+  std::vector<ignition::math::Color> colors;
+  if (_msg.materials_size() != _msg.point_size())
+    return colors;
+
+  colors.reserve(_msg.materials_size());
+  for (const auto &material : _msg.materials())
+    colors.push_back(ignition::msgs::Convert(material.diffuse()));
+  return colors;
+}
+
 /////////////////////////////////////////////////
 MarkerVisual::MarkerVisual(const std::string &_name, VisualPtr _vis)
 : Visual(*new MarkerVisualPrivate, _name, _vis, false)
@@ -92,12 +127,12 @@ void MarkerVisual::AddModify(const ignition::msgs::Marker &_msg)
     switch (_msg.type())
     {
       case ignition::msgs::Marker::BOX:
-        this->DetachObjects();
-        this->AttachMesh("unit_box");
+        this->Shape(_msg, "unit_box");
+        dynamicRenderableCalled = true;
         break;
       case ignition::msgs::Marker::CYLINDER:
-        this->DetachObjects();
-        this->AttachMesh("unit_cylinder");
+        this->Shape(_msg, "unit_cylinder");
+        dynamicRenderableCalled = true;
         break;
       case ignition::msgs::Marker::LINE_STRIP:
       case ignition::msgs::Marker::LINE_LIST:
@@ -105,12 +140,13 @@ void MarkerVisual::AddModify(const ignition::msgs::Marker &_msg)
       case ignition::msgs::Marker::TRIANGLE_FAN:
       case ignition::msgs::Marker::TRIANGLE_LIST:
       case ignition::msgs::Marker::TRIANGLE_STRIP:
+        this->dPtr->shapeMesh.clear();
         this->DynamicRenderable(_msg);
         dynamicRenderableCalled = true;
         break;
       case ignition::msgs::Marker::SPHERE:
-        this->DetachObjects();
-        this->AttachMesh("unit_sphere");
+        this->Shape(_msg, "unit_sphere");
+        dynamicRenderableCalled = true;
         break;
       case ignition::msgs::Marker::TEXT:
         this->Text(_msg);
@@ -127,8 +163,8 @@ void MarkerVisual::AddModify(const ignition::msgs::Marker &_msg)
     this->ProcessMaterialMsg(_msg.material());
   }
 
-  // Scale the visual
-  if (_msg.has_scale())
+  // Scale the visual, the scale of a shape list sizes each shape instead
+  if (_msg.has_scale() && this->dPtr->shapeMesh.empty())
   {
     this->SetScale(ignition::math::Vector3d(
         _msg.scale().x(), _msg.scale().y(), _msg.scale().z()));
@@ -170,7 +206,12 @@ void MarkerVisual::AddModify(const ignition::msgs::Marker &_msg)
   rendering::Events::newLayer(_msg.layer());
   this->SetLayer(_msg.layer());
 
-  if (!dynamicRenderableCalled &&
+  if (!dynamicRenderableCalled && !this->dPtr->shapeMesh.empty() &&
+      (_msg.point_size() || _msg.has_scale()))
+  {
+    this->ShapeList(_msg);
+  }
+  else if (!dynamicRenderableCalled &&
       _msg.point_size() && this->dPtr->dynamicRenderable)
   {
     this->DynamicRenderable(_msg);
@@ -283,19 +324,118 @@ void MarkerVisual::DynamicRenderable(const ignition::msgs::Marker &_msg)
       };
     }
 
-    // We make the assumption that the presence of points means the existing
-    // points should be removed.
-    if (_msg.point_size() > 0)
-      this->dPtr->dynamicRenderable->Clear();
   }
 
-  for (int i = 0; i < _msg.point_size(); ++i)
+  if (!this->dPtr->dynamicRenderable)
+    return;
+
+  // A shape set before may have detached the renderable
+  this->AttachObject(this->dPtr->dynamicRenderable.get());
+
+  // We make the assumption that the presence of points means the existing
+  // points should be replaced. Only the points that changed are uploaded.
+  if (_msg.point_size() > 0)
+  {
+    std::vector<ignition::math::Vector3d> points;
+    points.reserve(_msg.point_size());
+    for (const auto &pt : _msg.point())
+      points.push_back(ignition::msgs::Convert(pt));
+
+    this->dPtr->dynamicRenderable->SetPoints(points, PointColors(_msg));
+  }
+}
+
+/////////////////////////////////////////////////
+void MarkerVisual::Shape(const ignition::msgs::Marker &_msg,
+    const std::string &_meshName)
+{
+  this->DetachObjects();
+
+  if (_msg.point_size() > 0)
   {
-    this->dPtr->dynamicRenderable->AddPoint(
-        ignition::math::Vector3d(_msg.point(i).x(),
-                                 _msg.point(i).y(),
-                                 _msg.point(i).z()));
+    // The points place the shapes, the visual itself isn't scaled
+    this->dPtr->shapeMesh = _meshName;
+    this->SetScale(ignition::math::Vector3d::One);
+    this->ShapeList(_msg);
+    return;
   }
+
+  this->dPtr->shapeMesh.clear();
+  if (this->dPtr->dynamicRenderable)
+    this->DeleteDynamicLine(this->dPtr->dynamicRenderable.release());
+  this->AttachMesh(_meshName);
+}
+
+/////////////////////////////////////////////////
+void MarkerVisual::ShapeList(const ignition::msgs::Marker &_msg)
+{
+  IGN_PROFILE("rendering::MarkerVisual::ShapeList");
+
+  if (_msg.has_scale())
+    this->dPtr->shapeScale = ignition::msgs::Convert(_msg.scale());
+
+  if (_msg.point_size() > 0)
+  {
+    this->dPtr->shapePoints.clear();
+    this->dPtr->shapePoints.reserve(_msg.point_size());
+    for (const auto &pt : _msg.point())
+      this->dPtr->shapePoints.push_back(ignition::msgs::Convert(pt));
+    this->dPtr->shapeColors = PointColors(_msg);
+  }
+
+  const common::Mesh *mesh =
+    common::MeshManager::Instance()->GetMesh(this->dPtr->shapeMesh);
+  if (!mesh)
+  {
+    gzerr << "Unable to find mesh[" << this->dPtr->shapeMesh << "]\n";
+    return;
+  }
+
+  // Triangles of the scaled shape
+  std::vector<ignition::math::Vector3d> triangles;
+  for (unsigned int i = 0; i < mesh->GetSubMeshCount(); ++i)
+  {
+    const common::SubMesh *subMesh = mesh->GetSubMesh(i);
+    if (subMesh->GetPrimitiveType() != common::SubMesh::TRIANGLES)
+      continue;
+
+    for (unsigned int j = 0; j < subMesh->GetIndexCount(); ++j)
+    {
+      triangles.push_back(subMesh->Vertex(subMesh->GetIndex(j)) *
+          this->dPtr->shapeScale);
+    }
+  }
+
+  // Copy the shape to each point
+  const bool hasColors = !this->dPtr->shapeColors.empty();
+  std::vector<ignition::math::Vector3d> vertices;
+  std::vector<ignition::math::Color> colors;
+  vertices.reserve(triangles.size() * this->dPtr->shapePoints.size());
+  if (hasColors)
+    colors.reserve(vertices.capacity());
+  for (size_t i = 0; i < this->dPtr->shapePoints.size(); ++i)
+  {
+    for (const auto &v : triangles)
+    {
+      vertices.push_back(this->dPtr->shapePoints[i] + v);
+      if (hasColors)
+        colors.push_back(this->dPtr->shapeColors[i]);
+    }
+  }
+
+  if (!this->dPtr->dynamicRenderable)
+  {
+    this->dPtr->dynamicRenderable.reset(
+        this->CreateDynamicLine(rendering::RENDERING_TRIANGLE_LIST));
+  }
+  else
+  {
+    this->dPtr->dynamicRenderable->SetOperationType(
+        rendering::RENDERING_TRIANGLE_LIST);
+    this->AttachObject(this->dPtr->dynamicRenderable.get());
+  }
+
+  this->dPtr->dynamicRenderable->SetPoints(vertices, colors);
 }
 
 /////////////////////////////////////////////////
@@ -342,15 +482,25 @@ void MarkerVisual::FillMsg(ignition::msgs::Marker &_msg)
   if (this->GetParent())
     _msg.set_parent(this->GetParent()->Name());
 
-  // Set the scale
-  ignition::msgs::Set(_msg.mutable_scale(), this->dataPtr->scale);
-
-  // Add points, if present
-  for (unsigned int count = 0; this->dPtr->dynamicRenderable &&
-      count < this->dPtr->dynamicRenderable->GetPointCount(); ++count)
+  // A shape list reports its points rather than its vertices
+  if (!this->dPtr->shapeMesh.empty())
+  {
+    ignition::msgs::Set(_msg.mutable_scale(), this->dPtr->shapeScale);
+    for (const auto &pt : this->dPtr->shapePoints)
+      ignition::msgs::Set(_msg.add_point(), pt);
+  }
+  else
   {
-    ignition::msgs::Set(_msg.add_point(),
-        this->dPtr->dynamicRenderable->Point(count));
+    // Set the scale
+    ignition::msgs::Set(_msg.mutable_scale(), this->dataPtr->scale);
+
+    // Add points, if present
+    for (unsigned int count = 0; this->dPtr->dynamicRenderable &&
+        count < this->dPtr->dynamicRenderable->GetPointCount(); ++count)
+    {
+      ignition::msgs::Set(_msg.add_point(),
+          this->dPtr->dynamicRenderable->Point(count));
+    }
   }
 
   this->FillMaterialMsg(*(_msg.mutable_material()));
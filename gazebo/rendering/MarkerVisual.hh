@@ -69,6 +69,20 @@ namespace gazebo
       /// \param[in] _msg The message that defines what to add or modify
       private: void DynamicRenderable(const ignition::msgs::Marker &_msg);
 
+      /// \brief Set a box, cylinder or sphere marker. The shape is drawn at
+      /// each point of the message, if it has points.
+      /// \param[in] _msg The message that defines what to add or modify
+      /// \param[in] _meshName Name of the unit mesh of the shape.
+      private: void Shape(const ignition::msgs::Marker &_msg,
+                   const std::string &_meshName);
+
+      /// \brief Add or modify a shape list, which draws a shape at each
+      /// point with a single renderable. The scale is the size of each
+      /// shape, and the materials of the message, if there is one per
+      /// point, give the vertex color of each shape.
+      /// \param[in] _msg The message that defines what to add or modify
+      private: void ShapeList(const ignition::msgs::Marker &_msg);
+
       /// \brief Add or modify movable text.
       /// \param[in] _msg The message that defines what to add or modify
       private: void Text(const ignition::msgs::Marker &_msg);
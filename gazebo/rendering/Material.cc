@@ -182,11 +182,15 @@ void Material::Update(const gazebo::common::Material *_mat)
   if (!_mat->GetTextureImage().empty() &&
       pass->getTextureUnitState(_mat->GetTextureImage()) == NULL)
   {
+    // Load the compressed copy of the texture if it's cached. The unit
+    // keeps the name of the image.
+    const std::string texture =
+      RenderEngine::Instance()->CachedTexture(_mat->GetTextureImage());
+
     // Make sure to add the path to the texture image.
-    RenderEngine::Instance()->AddResourcePath(_mat->GetTextureImage());
-    Ogre::TextureUnitState *texState = pass->createTextureUnitState(
-        _mat->GetTextureImage());
-    texState->setTextureName(_mat->GetTextureImage());
+    RenderEngine::Instance()->AddResourcePath(texture);
+    Ogre::TextureUnitState *texState = pass->createTextureUnitState(texture);
+    texState->setTextureName(texture);
     texState->setName(_mat->GetTextureImage());
   }
 }
@@ -0,0 +1,216 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "gazebo/rendering/PoseMailbox.hh"
+
+using namespace gazebo;
+using namespace rendering;
+
+/// \brief Ids below this value are kept in a vector indexed by id, the
+/// others in a map.
+static const uint32_t kDenseIdLimit = 1u << 20;
+
+/// \brief Poses written between two calls to Take.
+class PoseBuffer
+{
+  /// \brief Write a pose.
+  /// \param[in] _id Id of the visual.
+  /// \param[in] _pose Pose of the visual.
+  /// \param[in] _replace False to keep a pose already written.
+  public: void Write(const uint32_t _id, const ignition::math::Pose3d &_pose,
+              const bool _replace = true)
+          {
+            if (_id >= kDenseIdLimit)
+            {
+              if (_replace)
+                this->sparse[_id] = _pose;
+              else
+                this->sparse.insert(std::make_pair(_id, _pose));
+              return;
+            }
+
+            if (_id >= this->dirty.size())
+            {
+              this->poses.resize(_id + 1);
+              this->dirty.resize(_id + 1, false);
+            }
+
+            if (!this->dirty[_id])
+            {
+              this->dirty[_id] = true;
+              this->ids.push_back(_id);
+            }
+            else if (!_replace)
+              return;
+
+            this->poses[_id] = _pose;
+          }
+
+  /// \brief Remove the poses, keeping the memory allocated.
+  public: void Clear()
+          {
+            for (auto const id : this->ids)
+              this->dirty[id] = false;
+            this->ids.clear();
+            this->sparse.clear();
+          }
+
+  /// \brief Get the number of poses.
+  /// \return Number of poses.
+  public: size_t Count() const
+          {
+            return this->ids.size() + this->sparse.size();
+          }
+
+  /// \brief Poses indexed by id, valid where dirty is true.
+  public: std::vector<ignition::math::Pose3d> poses;
+
+  /// \brief True for the ids written.
+  public: std::vector<bool> dirty;
+
+  /// \brief Ids written below kDenseIdLimit, in write order.
+  public: std::vector<uint32_t> ids;
+
+  /// \brief Poses of ids above kDenseIdLimit.
+  public: std::unordered_map<uint32_t, ignition::math::Pose3d> sparse;
+};
+
+/// \brief Private data for the PoseMailbox class.
+class gazebo::rendering::PoseMailboxPrivate
+{
+  /// \brief Protects back and time. Held for one message at most.
+  public: mutable std::mutex mutex;
+
+  /// \brief Buffer being written.
+  public: PoseBuffer back;
+
+  /// \brief Buffer being taken, only used by Take.
+  public: PoseBuffer front;
+
+  /// \brief Serializes the calls to Take.
+  public: std::mutex takeMutex;
+
+  /// \brief Time stamp of the last poses written.
+  public: common::Time time;
+};
+
+/////////////////////////////////////////////////
+PoseMailbox::PoseMailbox()
+  : dataPtr(new PoseMailboxPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+PoseMailbox::~PoseMailbox()
+{
+}
+
+/////////////////////////////////////////////////
+void PoseMailbox::Write(const uint32_t _id,
+    const ignition::math::Pose3d &_pose)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->back.Write(_id, _pose);
+}
+
+/////////////////////////////////////////////////
+void PoseMailbox::Write(const msgs::PosesStamped &_msg)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  for (int i = 0; i < _msg.pose_size(); ++i)
+  {
+    const msgs::Pose &pose = _msg.pose(i);
+    if (pose.has_id())
+      this->dataPtr->back.Write(pose.id(), msgs::ConvertIgn(pose));
+  }
+  this->dataPtr->time = msgs::Convert(_msg.time());
+}
+
+/////////////////////////////////////////////////
+void PoseMailbox::SetTime(const common::Time &_time)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->time = _time;
+}
+
+/////////////////////////////////////////////////
+common::Time PoseMailbox::Time() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->time;
+}
+
+/////////////////////////////////////////////////
+common::Time PoseMailbox::Take(const ApplyFunction &_apply)
+{
+  std::lock_guard<std::mutex> takeLock(this->dataPtr->takeMutex);
+
+  PoseBuffer &front = this->dataPtr->front;
+  common::Time time;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    std::swap(this->dataPtr->back, front);
+    time = this->dataPtr->time;
+  }
+
+  // Apply the poses without holding the lock, so that writers are not
+  // blocked by the rendering thread.
+  std::vector<std::pair<uint32_t, ignition::math::Pose3d>> held;
+  for (auto const id : front.ids)
+  {
+    if (!_apply(id, front.poses[id]))
+      held.push_back(std::make_pair(id, front.poses[id]));
+  }
+  for (auto const &p : front.sparse)
+  {
+    if (!_apply(p.first, p.second))
+      held.push_back(p);
+  }
+  front.Clear();
+
+  // Held poses are written back, unless a newer pose arrived meanwhile.
+  if (!held.empty())
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    for (auto const &p : held)
+      this->dataPtr->back.Write(p.first, p.second, false);
+  }
+
+  return time;
+}
+
+/////////////////////////////////////////////////
+void PoseMailbox::Clear()
+{
+  std::lock_guard<std::mutex> takeLock(this->dataPtr->takeMutex);
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->back.Clear();
+  this->dataPtr->front.Clear();
+  this->dataPtr->time = common::Time::Zero;
+}
+
+/////////////////////////////////////////////////
+size_t PoseMailbox::Count() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->back.Count();
+}
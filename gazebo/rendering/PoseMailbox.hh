@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_RENDERING_POSEMAILBOX_HH_
+#define GAZEBO_RENDERING_POSEMAILBOX_HH_
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+#include <ignition/math/Pose3.hh>
+
+#include "gazebo/common/Time.hh"
+#include "gazebo/msgs/msgs.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace rendering
+  {
+    // Forward declare private data class.
+    class PoseMailboxPrivate;
+
+    /// \addtogroup gazebo_rendering
+    /// \{
+
+    /// \class PoseMailbox PoseMailbox.hh rendering/rendering.hh
+    /// \brief Hands the poses of visuals from the threads that receive
+    /// them to the rendering thread.
+    ///
+    /// The poses are kept in two buffers of slots indexed by visual id:
+    /// writers fill the back buffer, and Take swaps the buffers and applies
+    /// the front one without holding the lock. A pose written twice before
+    /// Take only keeps its last value, and only numeric data is copied.
+    class GZ_RENDERING_VISIBLE PoseMailbox
+    {
+      /// \brief Function applying a pose taken from the mailbox.
+      /// \param[in] _id Id of the visual.
+      /// \param[in] _pose Pose of the visual.
+      /// \return False to hold the pose until the next Take, e.g. if the
+      /// visual does not exist yet.
+      public: typedef std::function<bool (const uint32_t _id,
+                  const ignition::math::Pose3d &_pose)> ApplyFunction;
+
+      /// \brief Constructor.
+      public: PoseMailbox();
+
+      /// \brief Destructor.
+      public: virtual ~PoseMailbox();
+
+      /// \brief Write the pose of a visual, replacing a pose not taken yet.
+      /// \param[in] _id Id of the visual.
+      /// \param[in] _pose Pose of the visual.
+      public: void Write(const uint32_t _id,
+                  const ignition::math::Pose3d &_pose);
+
+      /// \brief Write the poses of a message, and its time stamp.
+      /// \param[in] _msg The poses.
+      public: void Write(const msgs::PosesStamped &_msg);
+
+      /// \brief Set the time stamp of the poses.
+      /// \param[in] _time Sim time of the poses.
+      public: void SetTime(const common::Time &_time);
+
+      /// \brief Get the time stamp of the last poses written.
+      /// \return Sim time of the poses.
+      public: common::Time Time() const;
+
+      /// \brief Take the poses written since the last call.
+      /// \param[in] _apply Function called for each pose.
+      /// \return Time stamp of the poses taken.
+      public: common::Time Take(const ApplyFunction &_apply);
+
+      /// \brief Remove all the poses, and reset the time stamp.
+      public: void Clear();
+
+      /// \brief Get the number of poses not taken yet.
+      /// \return Number of poses.
+      public: size_t Count() const;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<PoseMailboxPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <map>
+
+#include "gazebo/rendering/PoseMailbox.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class PoseMailboxTest : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+TEST_F(PoseMailboxTest, WriteTake)
+{
+  rendering::PoseMailbox mailbox;
+  EXPECT_EQ(0u, mailbox.Count());
+
+  const ignition::math::Pose3d pose1(1, 2, 3, 0, 0, 0);
+  const ignition::math::Pose3d pose2(4, 5, 6, 0, 0, 0);
+  const uint32_t sparseId = 1u << 30;
+
+  // The last pose written is kept
+  mailbox.Write(7, pose1);
+  mailbox.Write(7, pose2);
+  mailbox.Write(3, pose1);
+  mailbox.Write(sparseId, pose2);
+  mailbox.SetTime(common::Time(2, 5));
+  EXPECT_EQ(3u, mailbox.Count());
+
+  std::map<uint32_t, ignition::math::Pose3d> taken;
+  common::Time time = mailbox.Take(
+      [&taken](const uint32_t _id, const ignition::math::Pose3d &_pose)
+      {
+        taken[_id] = _pose;
+        return true;
+      });
+  EXPECT_EQ(common::Time(2, 5), time);
+  EXPECT_EQ(3u, taken.size());
+  EXPECT_EQ(pose2, taken[7]);
+  EXPECT_EQ(pose1, taken[3]);
+  EXPECT_EQ(pose2, taken[sparseId]);
+  EXPECT_EQ(0u, mailbox.Count());
+
+  // Nothing left to take, the time stamp is kept
+  taken.clear();
+  time = mailbox.Take(
+      [&taken](const uint32_t _id, const ignition::math::Pose3d &_pose)
+      {
+        taken[_id] = _pose;
+        return true;
+      });
+  EXPECT_TRUE(taken.empty());
+  EXPECT_EQ(common::Time(2, 5), time);
+
+  mailbox.Write(3, pose1);
+  mailbox.Clear();
+  EXPECT_EQ(0u, mailbox.Count());
+  EXPECT_EQ(common::Time::Zero, mailbox.Time());
+}
+
+/////////////////////////////////////////////////
+TEST_F(PoseMailboxTest, Hold)
+{
+  rendering::PoseMailbox mailbox;
+  const ignition::math::Pose3d pose1(1, 2, 3, 0, 0, 0);
+  const ignition::math::Pose3d pose2(4, 5, 6, 0, 0, 0);
+
+  // A pose that is not applied is held for the next Take
+  mailbox.Write(1, pose1);
+  mailbox.Write(2, pose1);
+  mailbox.Take(
+      [&mailbox, &pose2](const uint32_t _id,
+        const ignition::math::Pose3d &/*_pose*/)
+      {
+        // A newer pose arrives while taking
+        if (_id == 2)
+          mailbox.Write(2, pose2);
+        return false;
+      });
+  EXPECT_EQ(2u, mailbox.Count());
+
+  std::map<uint32_t, ignition::math::Pose3d> taken;
+  mailbox.Take(
+      [&taken](const uint32_t _id, const ignition::math::Pose3d &_pose)
+      {
+        taken[_id] = _pose;
+        return true;
+      });
+  EXPECT_EQ(pose1, taken[1]);
+  EXPECT_EQ(pose2, taken[2]);
+}
+
+/////////////////////////////////////////////////
+TEST_F(PoseMailboxTest, Message)
+{
+  rendering::PoseMailbox mailbox;
+
+  msgs::PosesStamped msg;
+  msgs::Set(msg.mutable_time(), common::Time(10, 20));
+  msgs::Pose *pose = msg.add_pose();
+  pose->set_id(4);
+  msgs::Set(pose, ignition::math::Pose3d(1, 0, 0, 0, 0, 0));
+  // Poses without an id are ignored
+  msgs::Set(msg.add_pose(), ignition::math::Pose3d(2, 0, 0, 0, 0, 0));
+
+  mailbox.Write(msg);
+  EXPECT_EQ(1u, mailbox.Count());
+  EXPECT_EQ(common::Time(10, 20), mailbox.Time());
+
+  uint32_t id = 0;
+  mailbox.Take(
+      [&id](const uint32_t _id, const ignition::math::Pose3d &_pose)
+      {
+        id = _id;
+        EXPECT_EQ(ignition::math::Pose3d(1, 0, 0, 0, 0, 0), _pose);
+        return true;
+      });
+  EXPECT_EQ(4u, id);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -14,6 +14,7 @@
  * limitations under the License.
  *
 */
+#include <cstdlib>
 #include <string>
 #include <iostream>
 #include <functional>
@@ -35,12 +36,18 @@
 
 #include "gazebo/gazebo_config.h"
 
+#ifdef HAVE_EGL
+# include <EGL/egl.h>
+# include <EGL/eglext.h>
+#endif
+
 #include <ignition/common/Profiler.hh>
 
 #include "gazebo/common/CommonIface.hh"
 #include "gazebo/common/Events.hh"
 #include "gazebo/common/Exception.hh"
 #include "gazebo/common/Console.hh"
+#include "gazebo/common/Tracer.hh"
 #include "gazebo/common/SystemPaths.hh"
 
 #include "gazebo/rendering/ogre_gazebo.h"
@@ -52,6 +59,9 @@
 #include "gazebo/rendering/RenderTypes.hh"
 #include "gazebo/rendering/RenderEngine.hh"
 #include "gazebo/rendering/RenderEnginePrivate.hh"
+#include "gazebo/rendering/RenderingIface.hh"
+
+#include "gazebo/transport/TransportIface.hh"
 
 using namespace gazebo;
 using namespace rendering;
@@ -144,8 +154,26 @@ void RenderEngine::Load()
   // testing, this is a hard requirement by Apple. We also need it to
   // properly initialize GLWidget and UserCameras. See the GLWidget
   // constructor.
-  this->dataPtr->windowManager->CreateWindow(
-      std::to_string(this->dummyWindowId), 1, 1);
+  if (this->OffScreen())
+  {
+    // The window wraps the current EGL context, which Ogre's GL render
+    // system only supports when it is built with EGL
+    try
+    {
+      this->dataPtr->windowManager->CreateWindow("", 1, 1);
+    }
+    catch(common::Exception &)
+    {
+      gzerr << "Unable to render off screen, the OGRE GL render system "
+            << "must be built with EGL support. Rendering will be disabled\n";
+      return;
+    }
+  }
+  else
+  {
+    this->dataPtr->windowManager->CreateWindow(
+        std::to_string(this->dummyWindowId), 1, 1);
+  }
 
   this->CheckSystemCapabilities();
 }
@@ -264,6 +292,7 @@ unsigned int RenderEngine::SceneCount() const
 void RenderEngine::PreRender()
 {
   IGN_PROFILE("rendering::RenderEngine::PreRender");
+  GZ_TRACE_SCOPE("rendering::RenderEngine::PreRender");
   this->dataPtr->root->_fireFrameStarted();
 }
 
@@ -271,17 +300,68 @@ void RenderEngine::PreRender()
 void RenderEngine::Render()
 {
   IGN_PROFILE("rendering::RenderEngine::Render");
+  GZ_TRACE_SCOPE("rendering::RenderEngine::Render");
 }
 
 //////////////////////////////////////////////////
 void RenderEngine::PostRender()
 {
   IGN_PROFILE("rendering::RenderEngine::PostRender");
+  GZ_TRACE_SCOPE("rendering::RenderEngine::PostRender");
   // _fireFrameRenderingQueued was here for CEGUI to work. Leaving because
   // it shouldn't harm anything, and we don't want to introduce
   // a regression.
   this->dataPtr->root->_fireFrameRenderingQueued();
   this->dataPtr->root->_fireFrameEnded();
+
+  if (this->dataPtr->resourceCache)
+    this->dataPtr->resourceCache->Update();
+}
+
+//////////////////////////////////////////////////
+void RenderEngine::SetGpuMemoryBudget(const size_t _bytes)
+{
+  if (!this->dataPtr->resourceCache)
+  {
+    gzerr << "RenderEngine is not initialized\n";
+    return;
+  }
+  this->dataPtr->resourceCache->SetBudget(_bytes);
+}
+
+//////////////////////////////////////////////////
+size_t RenderEngine::GpuMemoryBudget() const
+{
+  if (!this->dataPtr->resourceCache)
+    return 0;
+  return this->dataPtr->resourceCache->Budget();
+}
+
+//////////////////////////////////////////////////
+size_t RenderEngine::GpuMemoryUsage() const
+{
+  if (!this->dataPtr->resourceCache)
+    return 0;
+  return this->dataPtr->resourceCache->Usage();
+}
+
+//////////////////////////////////////////////////
+void RenderEngine::SetTextureCachePath(const std::string &_path)
+{
+  this->dataPtr->textureCache.SetPath(_path);
+}
+
+//////////////////////////////////////////////////
+std::string RenderEngine::TextureCachePath() const
+{
+  return this->dataPtr->textureCache.Path();
+}
+
+//////////////////////////////////////////////////
+std::string RenderEngine::CachedTexture(const std::string &_filename)
+{
+  const std::string cached = this->dataPtr->textureCache.Texture(_filename);
+  return cached.empty() ? _filename : cached;
 }
 
 //////////////////////////////////////////////////
@@ -309,6 +389,26 @@ void RenderEngine::Init()
   // init the resources
   Ogre::ResourceGroupManager::getSingleton().initialiseAllResourceGroups();
 
+  this->dataPtr->resourceCache.reset(new GpuResourceCache);
+  const char *budgetEnv = std::getenv("GAZEBO_GPU_MEMORY_BUDGET");
+  if (budgetEnv)
+  {
+    try
+    {
+      this->SetGpuMemoryBudget(
+          static_cast<size_t>(std::stoul(budgetEnv)) * 1024 * 1024);
+    }
+    catch(...)
+    {
+      gzerr << "Invalid GAZEBO_GPU_MEMORY_BUDGET[" << budgetEnv
+            << "], the budget must be a number of megabytes\n";
+    }
+  }
+
+  const char *textureCacheEnv = std::getenv("GAZEBO_TEXTURE_CACHE_PATH");
+  if (textureCacheEnv)
+    this->SetTextureCachePath(textureCacheEnv);
+
   Ogre::MaterialManager::getSingleton().setDefaultTextureFiltering(
       Ogre::TFO_ANISOTROPIC);
 
@@ -333,6 +433,7 @@ void RenderEngine::Fini()
     return;
 
   this->dataPtr->connections.clear();
+  this->dataPtr->resourceCache.reset();
 
   RTShaderSystem::Instance()->Fini();
 
@@ -391,6 +492,22 @@ void RenderEngine::Fini()
   }
 # endif
 
+#ifdef HAVE_EGL
+  if (this->dataPtr->eglDisplay)
+  {
+    EGLDisplay display = static_cast<EGLDisplay>(this->dataPtr->eglDisplay);
+    eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    eglDestroyContext(display,
+        static_cast<EGLContext>(this->dataPtr->eglContext));
+    eglDestroySurface(display,
+        static_cast<EGLSurface>(this->dataPtr->eglSurface));
+    eglTerminate(display);
+    this->dataPtr->eglDisplay = nullptr;
+    this->dataPtr->eglSurface = nullptr;
+    this->dataPtr->eglContext = nullptr;
+  }
+#endif
+
   this->dataPtr->initialized = false;
 }
 
@@ -733,6 +850,110 @@ void RenderEngine::SetupRenderSystem()
   this->dataPtr->root->setRenderSystem(renderSys);
 }
 
+#ifdef HAVE_EGL
+/// \brief Device index that picks the device from the master port, see
+/// rendering::set_render_device.
+static const int kAutoRenderDevice = -1;
+
+/////////////////////////////////////////////////
+/// \brief Create an off-screen EGL context on a GPU device, which needs no
+/// X server, and make it current.
+/// \param[in] _device Index of the device, or kAutoRenderDevice.
+/// \param[out] _data Render engine data receiving the EGL objects.
+/// \return True if the context was created.
+static bool CreateDeviceContext(const int _device, RenderEnginePrivate &_data)
+{
+  auto queryDevices = reinterpret_cast<PFNEGLQUERYDEVICESEXTPROC>(
+      eglGetProcAddress("eglQueryDevicesEXT"));
+  auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(
+      eglGetProcAddress("eglGetPlatformDisplayEXT"));
+  if (!queryDevices || !getPlatformDisplay)
+  {
+    gzerr << "EGL does not support device enumeration\n";
+    return false;
+  }
+
+  const EGLint maxDevices = 32;
+  EGLDeviceEXT devices[maxDevices];
+  EGLint deviceCount = 0;
+  if (!queryDevices(maxDevices, devices, &deviceCount) || deviceCount == 0)
+  {
+    gzerr << "No EGL device found\n";
+    return false;
+  }
+
+  int device = _device;
+  if (device == kAutoRenderDevice)
+  {
+    // The servers of a node have different master ports, so servers on
+    // consecutive ports render on different devices
+    std::string host;
+    unsigned int port = 0;
+    transport::get_master_uri(host, port);
+    device = static_cast<int>(port % static_cast<unsigned int>(deviceCount));
+  }
+
+  if (device < 0 || device >= deviceCount)
+  {
+    gzerr << "Invalid render device[" << device << "], found "
+          << deviceCount << " EGL devices\n";
+    return false;
+  }
+
+  EGLDisplay display = getPlatformDisplay(EGL_PLATFORM_DEVICE_EXT,
+      devices[device], nullptr);
+  if (display == EGL_NO_DISPLAY || !eglInitialize(display, nullptr, nullptr))
+  {
+    gzerr << "Unable to initialize EGL device[" << device << "]\n";
+    return false;
+  }
+
+  const EGLint configAttribs[] = {
+    EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+    EGL_RED_SIZE, 8, EGL_GREEN_SIZE, 8, EGL_BLUE_SIZE, 8,
+    EGL_DEPTH_SIZE, 16, EGL_STENCIL_SIZE, 8,
+    EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+    EGL_NONE};
+  EGLConfig config;
+  EGLint configCount = 0;
+  if (!eglChooseConfig(display, configAttribs, &config, 1, &configCount) ||
+      configCount == 0 || !eglBindAPI(EGL_OPENGL_API))
+  {
+    gzerr << "Unable to find an EGL config for OpenGL\n";
+    eglTerminate(display);
+    return false;
+  }
+
+  // The sensors render to textures, the surface is only needed to make the
+  // context current
+  const EGLint surfaceAttribs[] = {EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE};
+  EGLSurface surface = eglCreatePbufferSurface(display, config,
+      surfaceAttribs);
+  EGLContext context = eglCreateContext(display, config, EGL_NO_CONTEXT,
+      nullptr);
+  if (surface == EGL_NO_SURFACE || context == EGL_NO_CONTEXT ||
+      !eglMakeCurrent(display, surface, surface, context))
+  {
+    gzerr << "Unable to create EGL context\n";
+    if (context != EGL_NO_CONTEXT)
+      eglDestroyContext(display, context);
+    if (surface != EGL_NO_SURFACE)
+      eglDestroySurface(display, surface);
+    eglTerminate(display);
+    return false;
+  }
+
+  _data.eglDisplay = display;
+  _data.eglSurface = surface;
+  _data.eglContext = context;
+  _data.renderDevice = device;
+
+  gzmsg << "Rendering off screen on EGL device[" << device << "] of "
+        << deviceCount << "\n";
+  return true;
+}
+#endif
+
 /////////////////////////////////////////////////
 bool RenderEngine::CreateContext()
 {
@@ -741,13 +962,55 @@ bool RenderEngine::CreateContext()
 #if defined __APPLE__ || _WIN32
   this->dummyDisplay = 0;
 #else
+  // A GPU device chosen by index is rendered to without an X server, which
+  // lets several servers of a node use different GPUs
+  std::string device = rendering::render_device();
+  if (device.empty())
+  {
+    const char *deviceEnv = std::getenv("GAZEBO_RENDER_DEVICE");
+    if (deviceEnv)
+      device = deviceEnv;
+  }
+#ifdef HAVE_EGL
+  if (!device.empty())
+  {
+    int index = kAutoRenderDevice;
+    if (device != "auto")
+    {
+      try
+      {
+        index = std::stoi(device);
+      }
+      catch(...)
+      {
+        gzerr << "Invalid render device[" << device
+              << "], using device 0\n";
+        index = 0;
+      }
+    }
+    return CreateDeviceContext(index, *this->dataPtr);
+  }
+#else
+  if (!device.empty())
+  {
+    gzwarn << "The render device is ignored, Gazebo was built without "
+           << "EGL\n";
+  }
+#endif
+
   try
   {
     this->dummyDisplay = XOpenDisplay(0);
     if (!this->dummyDisplay)
     {
+#ifdef HAVE_EGL
+      gzmsg << "Can't open display: " << XDisplayName(0)
+            << ", rendering off screen\n";
+      return CreateDeviceContext(0, *this->dataPtr);
+#else
       gzerr << "Can't open display: " << XDisplayName(0) << "\n";
       return false;
+#endif
     }
 
     int screen = DefaultScreen(this->dummyDisplay);
@@ -864,6 +1127,18 @@ WindowManagerPtr RenderEngine::GetWindowManager() const
   return this->dataPtr->windowManager;
 }
 
+/////////////////////////////////////////////////
+bool RenderEngine::OffScreen() const
+{
+  return this->dataPtr->eglDisplay != nullptr;
+}
+
+/////////////////////////////////////////////////
+int RenderEngine::RenderDevice() const
+{
+  return this->dataPtr->renderDevice;
+}
+
 /////////////////////////////////////////////////
 Ogre::Root *RenderEngine::Root() const
 {
@@ -132,10 +132,63 @@ namespace gazebo
       /// \return Pointer to the Ogre root object.
       public: Ogre::Root *Root() const;
 
+      /// \brief Check whether the rendering context is an off-screen EGL
+      /// context on a GPU device, which needs no X server. It is used when
+      /// the GAZEBO_RENDER_DEVICE environment variable gives the index of
+      /// the device, or when no X display can be opened.
+      /// \return True if rendering off screen.
+      /// \sa rendering::set_render_device
+      public: bool OffScreen() const;
+
+      /// \brief Get the index of the GPU device of the off-screen context.
+      /// \return Index of the EGL device, -1 if not rendering off screen.
+      /// \sa OffScreen
+      public: int RenderDevice() const;
+
       /// \brief Get a list of all supported FSAA levels for this render system
       /// \return a list of FSAA levels
       public: std::vector<unsigned int> FSAALevels() const;
 
+      /// \brief Set the memory budget of the textures and meshes, which
+      /// all the scenes of the process share. While it is exceeded, the
+      /// resources no scene uses are released, the least recently used
+      /// first. The GAZEBO_GPU_MEMORY_BUDGET environment variable sets the
+      /// budget in megabytes.
+      /// \param[in] _bytes The budget in bytes, 0 for no budget.
+      /// \sa GpuResourceCache
+      public: void SetGpuMemoryBudget(const size_t _bytes);
+
+      /// \brief Get the memory budget of the textures and meshes.
+      /// \return The budget in bytes, 0 if there is no budget.
+      public: size_t GpuMemoryBudget() const;
+
+      /// \brief Get the memory used by the textures and meshes of all the
+      /// scenes.
+      /// \return Memory used in bytes.
+      /// \sa Scene::GpuMemoryUsage
+      public: size_t GpuMemoryUsage() const;
+
+      /// \brief Set the directory where the textures of mesh materials are
+      /// cached in a block compressed format with their mipmaps, which
+      /// takes less GPU memory and loads faster. The compression is lossy,
+      /// so the cache is disabled by default. The
+      /// GAZEBO_TEXTURE_CACHE_PATH environment variable sets the path.
+      /// \param[in] _path Path of the directory, empty to disable the
+      /// cache.
+      /// \sa TextureCache
+      public: void SetTextureCachePath(const std::string &_path);
+
+      /// \brief Get the directory where textures are cached.
+      /// \return Path of the directory, empty if the cache is disabled.
+      public: std::string TextureCachePath() const;
+
+      /// \brief Get the file to load for a texture, which is its
+      /// compressed copy when the texture cache is enabled.
+      /// \param[in] _filename Path of the texture file.
+      /// \return Path of the cached texture, or _filename if it isn't
+      /// cached.
+      public: std::string CachedTexture(const std::string &_filename);
+
 #if OGRE_VERSION_MAJOR > 1 || OGRE_VERSION_MINOR >= 9
       /// \internal
       /// \brief Get a pointer to the Ogre overlay system.
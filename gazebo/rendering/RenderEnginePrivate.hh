@@ -18,12 +18,15 @@
 #ifndef _GAZEBO_RENDERING_RENDERENGINE_PRIVATE_HH_
 #define _GAZEBO_RENDERING_RENDERENGINE_PRIVATE_HH_
 
+#include <memory>
 #include <vector>
 #include "gazebo/common/CommonTypes.hh"
 #include "gazebo/transport/TransportTypes.hh"
 #include "gazebo/rendering/ogre_gazebo.h"
+#include "gazebo/rendering/GpuResourceCache.hh"
 #include "gazebo/rendering/RenderTypes.hh"
 #include "gazebo/rendering/RenderEngine.hh"
+#include "gazebo/rendering/TextureCache.hh"
 
 namespace Ogre
 {
@@ -64,9 +67,30 @@ namespace gazebo
       /// \brief Pointer to the window manager.
       public: WindowManagerPtr windowManager;
 
+      /// \brief EGL display of the off-screen context, null if rendering
+      /// with GLX.
+      public: void *eglDisplay = nullptr;
+
+      /// \brief EGL pbuffer surface of the off-screen context.
+      public: void *eglSurface = nullptr;
+
+      /// \brief EGL off-screen context.
+      public: void *eglContext = nullptr;
+
+      /// \brief Index of the EGL device of the off-screen context, -1 if
+      /// rendering with GLX.
+      public: int renderDevice = -1;
+
       /// \brief A list of supported fsaa levels
       public: std::vector<unsigned int> fsaaLevels;
 
+      /// \brief Keeps the textures and meshes of all the scenes within the
+      /// memory budget.
+      public: std::unique_ptr<GpuResourceCache> resourceCache;
+
+      /// \brief Block compressed copies of the texture files.
+      public: TextureCache textureCache;
+
 #if OGRE_VERSION_MAJOR > 1 || OGRE_VERSION_MINOR >= 9
       /// \brief Ogre overlay system needed for initialization of Ogre
       public: Ogre::OverlaySystem *overlaySystem;
@@ -18,6 +18,7 @@
 #include <gtest/gtest.h>
 #include "gazebo/test/ServerFixture.hh"
 #include "gazebo/rendering/RenderEngine.hh"
+#include "gazebo/rendering/RenderingIface.hh"
 
 using namespace gazebo;
 class RenderEngine_TEST : public RenderingFixture
@@ -50,6 +51,26 @@ TEST_F(RenderEngine_TEST, FSAATest)
   }
 }
 
+/////////////////////////////////////////////////
+TEST_F(RenderEngine_TEST, RenderDevice)
+{
+  Load("worlds/empty.world");
+
+  // The device is only known for off-screen contexts
+  rendering::RenderEngine *engine = rendering::RenderEngine::Instance();
+  if (engine->OffScreen())
+    EXPECT_GE(engine->RenderDevice(), 0);
+  else
+    EXPECT_EQ(-1, engine->RenderDevice());
+
+  // The device option overrides GAZEBO_RENDER_DEVICE
+  EXPECT_TRUE(rendering::render_device().empty());
+  rendering::set_render_device("auto");
+  EXPECT_EQ("auto", rendering::render_device());
+  rendering::set_render_device("");
+  EXPECT_TRUE(rendering::render_device().empty());
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
@@ -37,6 +37,15 @@
 /// \brief Render visuals that are selectable mask.
 #define GZ_VISIBILITY_SELECTABLE      0x00000002
 
+/// \def GZ_VISIBILITY_SHADOW_DYNAMIC
+/// \brief Part of GZ_VISIBILITY_ALL, cleared on the objects whose shadows
+/// are cached, see ShadowMapCache.
+#define GZ_VISIBILITY_SHADOW_DYNAMIC  0x08000000
+
+/// \def GZ_VISIBILITY_SHADOW_STATIC
+/// \brief Set on the objects whose shadows are cached, see ShadowMapCache.
+#define GZ_VISIBILITY_SHADOW_STATIC   0x20000000
+
 namespace gazebo
 {
   namespace rendering
@@ -25,6 +25,8 @@
 using namespace gazebo;
 
 bool g_lockstep = false;
+bool g_lockstepPipelined = false;
+std::string g_renderDevice;
 
 //////////////////////////////////////////////////
 bool rendering::load()
@@ -148,3 +150,27 @@ bool rendering::lockstep_enabled()
 {
   return g_lockstep;
 }
+
+//////////////////////////////////////////////////
+void rendering::set_lockstep_pipelined(bool _enable)
+{
+  g_lockstepPipelined = _enable;
+}
+
+//////////////////////////////////////////////////
+bool rendering::lockstep_pipelined()
+{
+  return g_lockstepPipelined;
+}
+
+//////////////////////////////////////////////////
+void rendering::set_render_device(const std::string &_device)
+{
+  g_renderDevice = _device;
+}
+
+//////////////////////////////////////////////////
+std::string rendering::render_device()
+{
+  return g_renderDevice;
+}
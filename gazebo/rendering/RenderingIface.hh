@@ -71,6 +71,36 @@ namespace gazebo
     GZ_RENDERING_VISIBLE
     bool lockstep_enabled();
 
+    /// \brief Set whether lockstepping is pipelined. Physics then steps on
+    /// while the rendering sensors render the poses of the step at which
+    /// they were due, one pose snapshot behind. The poses given to
+    /// update_scene_poses are held until Scene::CommitPoses.
+    /// \param[in] _enable True to pipeline lockstepping.
+    /// \sa lockstep_pipelined
+    GZ_RENDERING_VISIBLE
+    void set_lockstep_pipelined(bool _enable);
+
+    /// \brief Get whether lockstepping is pipelined.
+    /// \return True if lockstepping is pipelined.
+    /// \sa set_lockstep_pipelined
+    GZ_RENDERING_VISIBLE
+    bool lockstep_pipelined();
+
+    /// \brief Set the GPU device to render with off screen, which
+    /// overrides the GAZEBO_RENDER_DEVICE environment variable. Must be
+    /// called before rendering::load.
+    /// \param[in] _device Index of the EGL device, or "auto" to pick the
+    /// device from the master port, which spreads the servers of a node
+    /// over its GPUs. Empty to use GAZEBO_RENDER_DEVICE.
+    /// \sa RenderEngine::RenderDevice
+    GZ_RENDERING_VISIBLE
+    void set_render_device(const std::string &_device);
+
+    /// \brief Get the GPU device to render with off screen.
+    /// \return The device given to set_render_device.
+    GZ_RENDERING_VISIBLE
+    std::string render_device();
+
     /// \brief wait until a render request occurs
     /// \param[in] _name Name of the scene to retrieve
     /// \param[in] _timeoutsec timeout expressed in seconds
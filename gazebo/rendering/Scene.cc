@@ -15,6 +15,8 @@
  *
 */
 
+#include <algorithm>
+#include <chrono>
 #include <functional>
 
 #include <boost/lexical_cast.hpp>
@@ -28,7 +30,10 @@
 
 #include "gazebo/msgs/msgs.hh"
 
+#include "gazebo/common/CommonIface.hh"
 #include "gazebo/common/Exception.hh"
+#include "gazebo/common/MeshManager.hh"
+#include "gazebo/common/Tracer.hh"
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/Console.hh"
 #include "gazebo/rendering/Road2d.hh"
@@ -55,6 +60,7 @@
 #include "gazebo/rendering/WideAngleCamera.hh"
 #include "gazebo/rendering/DepthCamera.hh"
 #include "gazebo/rendering/GpuLaser.hh"
+#include "gazebo/rendering/GpuResourceCache.hh"
 #include "gazebo/rendering/Grid.hh"
 #include "gazebo/rendering/OriginVisual.hh"
 #include "gazebo/rendering/RFIDVisual.hh"
@@ -62,6 +68,7 @@
 #include "gazebo/rendering/VideoVisual.hh"
 #include "gazebo/rendering/TransmitterVisual.hh"
 #include "gazebo/rendering/SelectionObj.hh"
+#include "gazebo/rendering/ShadowMapCache.hh"
 #include "gazebo/rendering/RayQuery.hh"
 #include "gazebo/rendering/RenderingIface.hh"
 
@@ -97,6 +104,152 @@ struct VisualMessageLess {
     }
 } VisualMessageLessOp;
 
+/////////////////////////////////////////////////
+/// \brief Check whether a new visual may be merged into the static batches.
+/// \param[in] _msg Message of the visual.
+/// \param[in] _type Type of the visual.
+/// \return True if the visual belongs to a static model and is drawn with
+/// the default settings of the batches.
+static bool Batchable(const msgs::Visual &_msg, Visual::VisualType _type)
+{
+  return _type == Visual::VT_VISUAL &&
+    _msg.has_is_static() && _msg.is_static() &&
+    _msg.has_geometry() &&
+    _msg.geometry().type() != msgs::Geometry::HEIGHTMAP &&
+    _msg.plugin_size() == 0 &&
+    (!_msg.has_cast_shadows() || _msg.cast_shadows()) &&
+    (!_msg.has_transparency() || ignition::math::equal(
+       _msg.transparency(), 0.0)) &&
+    (!_msg.has_laser_retro() || ignition::math::equal(
+       _msg.laser_retro(), 0.0)) &&
+    (!_msg.has_visible() || _msg.visible());
+}
+
+/////////////////////////////////////////////////
+/// \brief Check whether the shadows of a new visual may be cached.
+/// \param[in] _msg Message of the visual.
+/// \param[in] _type Type of the visual.
+/// \return True if the visual belongs to a static model and casts shadows.
+static bool StaticShadowCaster(const msgs::Visual &_msg,
+    Visual::VisualType _type)
+{
+  return _type == Visual::VT_VISUAL &&
+    _msg.has_is_static() && _msg.is_static() &&
+    (!_msg.has_cast_shadows() || _msg.cast_shadows());
+}
+
+/////////////////////////////////////////////////
+/// \brief Collect the mesh files of visual messages that are not loaded
+/// yet.
+/// \param[in] _msgs The visual messages.
+/// \param[in,out] _collected Filenames of the messages already collected.
+/// \param[out] _meshes Full paths of the meshes to load.
+static void CollectVisualMeshes(const VisualMsgs_L &_msgs,
+    std::set<std::string> &_collected, std::vector<std::string> &_meshes)
+{
+  for (auto const &msg : _msgs)
+  {
+    if (!msg->has_geometry() || !msg->geometry().has_mesh() ||
+        msg->geometry().type() != msgs::Geometry::MESH)
+    {
+      continue;
+    }
+
+    const std::string &filename = msg->geometry().mesh().filename();
+    if (filename.empty() || !_collected.insert(filename).second)
+      continue;
+
+    const std::string fullname = common::find_file(filename);
+    if (!fullname.empty() &&
+        !common::MeshManager::Instance()->HasMesh(fullname))
+    {
+      _meshes.push_back(fullname);
+    }
+  }
+}
+
+/// \brief Smallest half size of a fitted octree (meters).
+static const Ogre::Real kMinOctreeHalfSize = 10;
+
+/////////////////////////////////////////////////
+/// \brief Fit the octree of an octree scene manager to the bounds of the
+/// scene, so that the size of its nodes suits the scene rather than the
+/// default 20 km cube. Resizing adds all the scene nodes to the octree
+/// again, so it is only done once the scene left the octree or became much
+/// smaller than it.
+/// \param[in] _manager The scene manager, other kinds are ignored.
+static void FitOctree(Ogre::SceneManager *_manager)
+{
+  Ogre::AxisAlignedBox octree;
+  if (!_manager->getOption("Size", &octree) || !octree.isFinite())
+    return;
+
+  const Ogre::AxisAlignedBox &bounds =
+    _manager->getRootSceneNode()->_getWorldAABB();
+  if (!bounds.isFinite())
+    return;
+
+  const Ogre::Vector3 halfSize = bounds.getHalfSize();
+  const Ogre::Real fit = std::max(kMinOctreeHalfSize,
+      std::max(halfSize.x, std::max(halfSize.y, halfSize.z)));
+  const Ogre::Vector3 octreeHalfSize = octree.getHalfSize();
+  if (octree.contains(bounds) && std::max(octreeHalfSize.x,
+        std::max(octreeHalfSize.y, octreeHalfSize.z)) <= 4 * fit)
+  {
+    return;
+  }
+
+  // A cube with room for the scene to move
+  const Ogre::Vector3 center = bounds.getCenter();
+  Ogre::AxisAlignedBox size(center - Ogre::Vector3(1.5 * fit),
+      center + Ogre::Vector3(1.5 * fit));
+  _manager->setOption("Size", &size);
+}
+
+namespace gazebo
+{
+  namespace rendering
+  {
+    /// \brief Remembers the last camera view whose visible objects were
+    /// found by the scene manager, so that a camera with the same view in
+    /// the same frame can reuse them.
+    class SceneViewCache : public Ogre::SceneManager::Listener
+    {
+      // Documentation inherited
+      public: virtual void preFindVisibleObjects(Ogre::SceneManager *,
+                  Ogre::SceneManager::IlluminationRenderStage _irs,
+                  Ogre::Viewport *_viewport)
+              {
+                // Shadow map renders replace the render queue too
+                this->findViewport =
+                  _irs == Ogre::SceneManager::IRS_NONE ? _viewport : nullptr;
+              }
+
+      /// \brief Viewport of the last search for visible objects.
+      public: Ogre::Viewport *findViewport = nullptr;
+
+      /// \brief Viewport whose visible objects are in the render queue,
+      /// null if none.
+      public: Ogre::Viewport *viewport = nullptr;
+
+      /// \brief Frame in which the viewport was rendered.
+      public: unsigned long frame = 0;
+
+      /// \brief View matrix of the viewport camera.
+      public: Ogre::Matrix4 view;
+
+      /// \brief Projection matrix of the viewport camera.
+      public: Ogre::Matrix4 projection;
+
+      /// \brief Visibility mask of the viewport.
+      public: uint32_t mask = 0;
+
+      /// \brief True if the viewport rendered shadows.
+      public: bool shadows = false;
+    };
+  }
+}
+
 //////////////////////////////////////////////////
 Scene::Scene()
   : dataPtr(new ScenePrivate)
@@ -204,7 +357,6 @@ Scene::Scene(const std::string &_name, const bool _enableVisualizations,
   this->dataPtr->selectedVis.reset();
 
   this->dataPtr->sceneSimTimePosesApplied = common::Time();
-  this->dataPtr->sceneSimTimePosesReceived = common::Time();
 
   {
     // Get shadow caster material name from physics::World
@@ -278,6 +430,14 @@ void Scene::Clear()
     this->dataPtr->node->Fini();
   this->dataPtr->node.reset();
 
+  for (auto const &mesh : this->dataPtr->meshLoads)
+    mesh.wait();
+  this->dataPtr->meshLoads.clear();
+  this->dataPtr->preloadedMeshes.clear();
+  this->dataPtr->visualsReady = true;
+  this->dataPtr->staticBatch.reset();
+  this->dataPtr->shadowMapCache.reset();
+
   {
     std::lock_guard<std::mutex> lock(*this->dataPtr->receiveMutex);
     this->dataPtr->modelMsgs.clear();
@@ -291,10 +451,8 @@ void Scene::Clear()
     this->dataPtr->roadMsgs.clear();
   }
 
-  {
-    std::lock_guard<std::recursive_mutex> lock(this->dataPtr->poseMsgMutex);
-    this->dataPtr->poseMsgs.clear();
-  }
+  this->dataPtr->poses.Clear();
+  this->dataPtr->pendingPoses.Clear();
 
   this->dataPtr->joints.clear();
 
@@ -328,6 +486,7 @@ void Scene::Clear()
     delete this->dataPtr->grids[i];
   this->dataPtr->grids.clear();
 
+  this->dataPtr->poseCullingCamera.reset();
   for (unsigned int i = 0; i < this->dataPtr->cameras.size(); ++i)
     this->dataPtr->cameras[i]->Fini();
   this->dataPtr->cameras.clear();
@@ -370,6 +529,27 @@ Scene::~Scene()
 void Scene::Load(sdf::ElementPtr _sdf)
 {
   this->dataPtr->sdf->Copy(_sdf);
+
+  const std::string kElementName = "ignition:visual_budget";
+  if (_sdf->HasElement(kElementName))
+    this->SetVisualBudget(_sdf->Get<double>(kElementName));
+
+  const std::string kStaticBatching = "ignition:static_batching";
+  if (_sdf->HasElement(kStaticBatching))
+    this->SetStaticBatching(_sdf->Get<bool>(kStaticBatching));
+
+  const std::string kMeshLod = "ignition:mesh_lod";
+  if (_sdf->HasElement(kMeshLod))
+    this->SetMeshLod(_sdf->Get<bool>(kMeshLod));
+
+  const std::string kShadowCaching = "ignition:shadow_caching";
+  if (_sdf->HasElement(kShadowCaching))
+    this->SetShadowCaching(_sdf->Get<bool>(kShadowCaching));
+
+  const std::string kHeightmapStreaming = "ignition:heightmap_streaming";
+  if (_sdf->HasElement(kHeightmapStreaming))
+    this->SetHeightmapStreaming(_sdf->Get<bool>(kHeightmapStreaming));
+
   this->Load();
 }
 
@@ -386,6 +566,9 @@ void Scene::Load()
   this->dataPtr->manager->setAmbientLight(
       Ogre::ColourValue(0.1, 0.1, 0.1, 0.1));
 
+  this->dataPtr->viewCache.reset(new SceneViewCache);
+  this->dataPtr->manager->addListener(this->dataPtr->viewCache.get());
+
 #if OGRE_VERSION_MAJOR > 1 || OGRE_VERSION_MINOR >= 9
   this->dataPtr->manager->addRenderQueueListener(
       RenderEngine::Instance()->OverlaySystem());
@@ -887,6 +1070,10 @@ void Scene::SelectVisual(const std::string &_name, const std::string &_mode)
 {
   this->dataPtr->selectedVis = this->GetVisual(_name);
   this->dataPtr->selectionMode = _mode;
+
+  // A selected model may be moved or highlighted
+  if (this->dataPtr->staticBatch && this->dataPtr->selectedVis)
+    this->dataPtr->staticBatch->Remove(this->dataPtr->selectedVis);
 }
 
 //////////////////////////////////////////////////
@@ -1586,24 +1773,12 @@ void Scene::MeshInformation(const Ogre::Mesh *_mesh,
 /////////////////////////////////////////////////
 bool Scene::ProcessSceneMsg(ConstScenePtr &_msg)
 {
+  for (int i = 0; i < _msg->model_size(); ++i)
   {
-    std::lock_guard<std::recursive_mutex> lock(this->dataPtr->poseMsgMutex);
-    for (int i = 0; i < _msg->model_size(); ++i)
-    {
-      PoseMsgs_M::iterator iter =
-          this->dataPtr->poseMsgs.find(_msg->model(i).id());
-      if (iter != this->dataPtr->poseMsgs.end())
-        iter->second.CopyFrom(_msg->model(i).pose());
-      else
-        this->dataPtr->poseMsgs.insert(
-            std::make_pair(_msg->model(i).id(), _msg->model(i).pose()));
+    this->dataPtr->poses.Write(_msg->model(i).id(),
+        msgs::ConvertIgn(_msg->model(i).pose()));
 
-      this->dataPtr->poseMsgs[_msg->model(i).id()].set_name(
-          _msg->model(i).name());
-      this->dataPtr->poseMsgs[_msg->model(i).id()].set_id(_msg->model(i).id());
-
-      this->ProcessModelMsg(_msg->model(i));
-    }
+    this->ProcessModelMsg(_msg->model(i));
   }
 
   for (int i = 0; i < _msg->light_size(); ++i)
@@ -1684,9 +1859,6 @@ bool Scene::ProcessSceneMsg(ConstScenePtr &_msg)
 //////////////////////////////////////////////////
 bool Scene::ProcessModelMsg(const msgs::Model &_msg)
 {
-  std::string modelName, linkName;
-
-  modelName = _msg.name() + "::";
   for (int j = 0; j < _msg.visual_size(); ++j)
   {
     boost::shared_ptr<msgs::Visual> vm(new msgs::Visual(
@@ -1725,23 +1897,10 @@ bool Scene::ProcessModelMsg(const msgs::Model &_msg)
 
   for (int j = 0; j < _msg.link_size(); ++j)
   {
-    linkName = modelName + _msg.link(j).name();
-
+    if (_msg.link(j).has_pose())
     {
-      std::lock_guard<std::recursive_mutex> lock(this->dataPtr->poseMsgMutex);
-      if (_msg.link(j).has_pose())
-      {
-        PoseMsgs_M::iterator iter =
-            this->dataPtr->poseMsgs.find(_msg.link(j).id());
-        if (iter != this->dataPtr->poseMsgs.end())
-          iter->second.CopyFrom(_msg.link(j).pose());
-        else
-          this->dataPtr->poseMsgs.insert(
-              std::make_pair(_msg.link(j).id(), _msg.link(j).pose()));
-
-        this->dataPtr->poseMsgs[_msg.link(j).id()].set_name(linkName);
-        this->dataPtr->poseMsgs[_msg.link(j).id()].set_id(_msg.link(j).id());
-      }
+      this->dataPtr->poses.Write(_msg.link(j).id(),
+          msgs::ConvertIgn(_msg.link(j).pose()));
     }
 
     if (_msg.link(j).has_inertial())
@@ -1817,6 +1976,8 @@ void Scene::OnVisualMsg(ConstVisualPtr &_msg)
 void Scene::PreRender()
 {
   IGN_PROFILE("rendering::Scene::PreRender");
+  GZ_TRACE_SCOPE("rendering::Scene::PreRender");
+  const auto preRenderStart = std::chrono::steady_clock::now();
   /* Deferred shading debug code. Delete me soon (July 17, 2012)
   static bool first = true;
 
@@ -1867,7 +2028,6 @@ void Scene::PreRender()
   static ModelMsgs_L::iterator modelIter;
   static VisualMsgs_L::iterator visualIter;
   static LightMsgs_L::iterator lightIter;
-  static PoseMsgs_M::iterator pIter;
   static SkeletonPoseMsgs_L::iterator spIter;
   static JointMsgs_L::iterator jointIter;
   static SensorMsgs_L::iterator sensorIter;
@@ -1981,9 +2141,58 @@ void Scene::PreRender()
       ++sensorIter;
   }
 
+  // With a visual budget, the meshes of new visuals are parsed on worker
+  // threads, and the visuals wait until they are loaded. Only part of the
+  // visuals may then be created in this frame.
+  bool visualsAllowed = true;
+  const double visualBudget = this->dataPtr->visualBudget;
+  if (visualBudget > 0)
+  {
+    auto &meshLoads = this->dataPtr->meshLoads;
+    if (std::all_of(meshLoads.begin(), meshLoads.end(),
+          [](const std::shared_future<const common::Mesh *> &_mesh)
+          {
+            return _mesh.wait_for(std::chrono::seconds(0)) ==
+              std::future_status::ready;
+          }))
+    {
+      meshLoads.clear();
+    }
+
+    if (meshLoads.empty())
+    {
+      std::vector<std::string> meshes;
+      for (auto const *copy : {&modelVisualMsgsCopy, &linkVisualMsgsCopy,
+          &visualMsgsCopy, &collisionVisualMsgsCopy})
+      {
+        CollectVisualMeshes(*copy, this->dataPtr->preloadedMeshes, meshes);
+      }
+
+      for (auto const &mesh : meshes)
+        meshLoads.push_back(common::MeshManager::Instance()->LoadAsync(mesh));
+    }
+    visualsAllowed = meshLoads.empty();
+  }
+
+  // The budget applies once a visual was created in this frame, so that a
+  // small budget still makes progress
+  const auto visualStart = std::chrono::steady_clock::now();
+  const size_t visualCount = this->dataPtr->visuals.size();
+  auto visualTimeLeft = [&]()
+  {
+    if (!visualsAllowed)
+      return false;
+    if (visualBudget <= 0 || this->dataPtr->visuals.size() <= visualCount)
+      return true;
+    visualsAllowed = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - visualStart).count() <
+      visualBudget;
+    return visualsAllowed;
+  };
+
   // Process the model visual messages.
   for (visualIter = modelVisualMsgsCopy.begin();
-      visualIter != modelVisualMsgsCopy.end();)
+      visualIter != modelVisualMsgsCopy.end() && visualTimeLeft();)
   {
     if (this->ProcessVisualMsg(*visualIter, Visual::VT_MODEL))
       modelVisualMsgsCopy.erase(visualIter++);
@@ -1993,7 +2202,7 @@ void Scene::PreRender()
 
   // Process the link visual messages.
   for (visualIter = linkVisualMsgsCopy.begin();
-      visualIter != linkVisualMsgsCopy.end();)
+      visualIter != linkVisualMsgsCopy.end() && visualTimeLeft();)
   {
     if (this->ProcessVisualMsg(*visualIter, Visual::VT_LINK))
       linkVisualMsgsCopy.erase(visualIter++);
@@ -2002,7 +2211,8 @@ void Scene::PreRender()
   }
 
   // Process the visual messages.
-  for (visualIter = visualMsgsCopy.begin(); visualIter != visualMsgsCopy.end();)
+  for (visualIter = visualMsgsCopy.begin();
+      visualIter != visualMsgsCopy.end() && visualTimeLeft();)
   {
     Visual::VisualType visualType = Visual::VT_VISUAL;
     if ((*visualIter)->has_type())
@@ -2016,7 +2226,7 @@ void Scene::PreRender()
 
   // Process the collision visual messages.
   for (visualIter = collisionVisualMsgsCopy.begin();
-      visualIter != collisionVisualMsgsCopy.end();)
+      visualIter != collisionVisualMsgsCopy.end() && visualTimeLeft();)
   {
     if (this->ProcessVisualMsg(*visualIter, Visual::VT_COLLISION))
       collisionVisualMsgsCopy.erase(visualIter++);
@@ -2024,6 +2234,34 @@ void Scene::PreRender()
       ++visualIter;
   }
 
+  // Visuals waiting for a parent do not count, they may never be created
+  this->dataPtr->visualsReady = (visualsAllowed ||
+    (modelVisualMsgsCopy.empty() && linkVisualMsgsCopy.empty() &&
+     visualMsgsCopy.empty() && collisionVisualMsgsCopy.empty())) &&
+    (!this->dataPtr->terrain || this->dataPtr->terrain->Ready());
+
+  // Batch the static models once the scene stops changing
+  if (this->dataPtr->staticBatch && this->dataPtr->visualsReady)
+    this->dataPtr->staticBatch->Update();
+
+  // Size the culling hierarchy for the scene once it stops changing
+  if (this->dataPtr->visualsReady)
+    FitOctree(this->dataPtr->manager);
+
+  // Measure the memory used by the scene
+  const common::Time wallTime = common::Time::GetWallTime();
+  if (wallTime - this->dataPtr->gpuMemoryTime >= common::Time(1.0))
+  {
+    std::vector<Ogre::Texture *> renderTextures;
+    for (auto const &camera : this->dataPtr->cameras)
+      renderTextures.push_back(camera->RenderTexture());
+    for (auto const &camera : this->dataPtr->userCameras)
+      renderTextures.push_back(camera->RenderTexture());
+    this->dataPtr->gpuMemoryUsage = GpuResourceCache::SceneUsage(
+        this->dataPtr->manager, renderTextures);
+    this->dataPtr->gpuMemoryTime = wallTime;
+  }
+
   // Process the joint messages.
   for (jointIter = jointMsgsCopy.begin(); jointIter != jointMsgsCopy.end();)
   {
@@ -2118,52 +2356,75 @@ void Scene::PreRender()
   RTShaderSystem::Instance()->Update();
   IGN_PROFILE_END();
 
+  // Process all the model poses last. A pose is held in the mailbox until
+  // a corresponding visual exists. We may receive pose updates over the
+  // wire before we receive the visual
+  IGN_PROFILE_BEGIN("poseMsgs");
+  // Poses of visuals outside the view of the culling camera are held,
+  // except every few frames
+  const unsigned int kPoseCullingPeriod = 10;
+  Ogre::Camera *cullingCamera = nullptr;
+  if (this->dataPtr->poseCullingCamera &&
+      ++this->dataPtr->poseCullingFrames < kPoseCullingPeriod)
   {
-    IGN_PROFILE_BEGIN("poseMsgMutex");
-    std::lock_guard<std::recursive_mutex> lock(this->dataPtr->poseMsgMutex);
-    IGN_PROFILE_END();
+    cullingCamera = this->dataPtr->poseCullingCamera->OgreCamera();
+  }
+  else
+  {
+    this->dataPtr->poseCullingFrames = 0;
+  }
 
-    // Process all the model messages last. Remove pose message from the list
-    // only when a corresponding visual exits. We may receive pose updates
-    // over the wire before  we recieve the visual
-    IGN_PROFILE_BEGIN("poseMsgs");
-    pIter = this->dataPtr->poseMsgs.begin();
-    while (pIter != this->dataPtr->poseMsgs.end())
-    {
-      Visual_M::iterator iter = this->dataPtr->visuals.find(pIter->first);
-      if (iter != this->dataPtr->visuals.end() && iter->second)
+  common::Time posesTime = this->dataPtr->poses.Take(
+      [this, cullingCamera](const uint32_t _id,
+                            const ignition::math::Pose3d &_pose)
       {
-        // If an object is selected, don't let the physics engine move it.
-        if (!this->dataPtr->selectedVis
-            || this->dataPtr->selectionMode != "move" ||
-            (iter->first != this->dataPtr->selectedVis->GetId() &&
-            !this->dataPtr->selectedVis->IsAncestorOf(iter->second)))
+        Visual_M::iterator iter = this->dataPtr->visuals.find(_id);
+        if (iter != this->dataPtr->visuals.end() && iter->second)
         {
-          ignition::math::Pose3d pose = msgs::ConvertIgn(pIter->second);
-          GZ_ASSERT(iter->second, "Visual pointer is NULL");
-          iter->second->SetPose(pose);
-          PoseMsgs_M::iterator prev = pIter++;
-          this->dataPtr->poseMsgs.erase(prev);
+          // The bounds include the children of the visual, as of the last
+          // frame. Visuals without bounds are always updated.
+          if (cullingCamera && iter->second->GetSceneNode())
+          {
+            const Ogre::AxisAlignedBox &box =
+                iter->second->GetSceneNode()->_getWorldAABB();
+            if (!box.isNull() && !cullingCamera->isVisible(box))
+              return false;
+          }
+
+          // If an object is selected, don't let the physics engine move it.
+          if (this->dataPtr->selectedVis &&
+              this->dataPtr->selectionMode == "move" &&
+              (iter->first == this->dataPtr->selectedVis->GetId() ||
+              this->dataPtr->selectedVis->IsAncestorOf(iter->second)))
+          {
+            return false;
+          }
+          if (iter->second->Pose() != _pose)
+          {
+            if (this->dataPtr->staticBatch)
+              this->dataPtr->staticBatch->Remove(iter->second);
+            if (this->dataPtr->shadowMapCache)
+              this->dataPtr->shadowMapCache->RemoveCaster(iter->second);
+          }
+          iter->second->SetPose(_pose);
+          return true;
         }
-        else
-          ++pIter;
-      }
-      else
-      {
-        // process light pose messages
-        auto lIter = this->dataPtr->lights.find(pIter->first);
+
+        // process light poses
+        auto lIter = this->dataPtr->lights.find(_id);
         if (lIter != this->dataPtr->lights.end())
         {
-          ignition::math::Pose3d pose = msgs::ConvertIgn(pIter->second);
-          lIter->second->SetPosition(pose.Pos());
-          lIter->second->SetRotation(pose.Rot());
-          auto prev = pIter++;
-          this->dataPtr->poseMsgs.erase(prev);
+          lIter->second->SetPosition(_pose.Pos());
+          lIter->second->SetRotation(_pose.Rot());
+          return true;
         }
-        else
-          ++pIter;
-      }
-    }
+        return false;
+      });
+  IGN_PROFILE_END();
+
+  {
+    IGN_PROFILE_BEGIN("poseMsgMutex");
+    std::lock_guard<std::recursive_mutex> lock(this->dataPtr->poseMsgMutex);
     IGN_PROFILE_END();
 
     // process skeleton pose msgs
@@ -2229,10 +2490,12 @@ void Scene::PreRender()
     }
 
     // official time stamp of approval
-    this->dataPtr->sceneSimTimePosesApplied =
-        this->dataPtr->sceneSimTimePosesReceived;
+    this->dataPtr->sceneSimTimePosesApplied = posesTime;
     IGN_PROFILE_END();
   }
+
+  this->dataPtr->preRenderTime = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - preRenderStart).count();
 }
 
 /////////////////////////////////////////////////
@@ -2812,6 +3075,10 @@ bool Scene::ProcessVisualMsg(ConstVisualPtr &_msg, Visual::VisualType _type)
   {
     if (iter != this->dataPtr->visuals.end())
     {
+      if (this->dataPtr->staticBatch)
+        this->dataPtr->staticBatch->Remove(iter->second);
+      if (this->dataPtr->shadowMapCache)
+        this->dataPtr->shadowMapCache->RemoveCaster(iter->second);
       this->dataPtr->visuals.erase(iter);
       return true;
     }
@@ -2822,6 +3089,10 @@ bool Scene::ProcessVisualMsg(ConstVisualPtr &_msg, Visual::VisualType _type)
   // Updating existing visual
   if (iter != this->dataPtr->visuals.end())
   {
+    if (this->dataPtr->staticBatch)
+      this->dataPtr->staticBatch->Remove(iter->second);
+    if (this->dataPtr->shadowMapCache)
+      this->dataPtr->shadowMapCache->RemoveCaster(iter->second);
     iter->second->UpdateFromMsg(_msg);
     return true;
   }
@@ -2934,6 +3205,7 @@ bool Scene::ProcessVisualMsg(ConstVisualPtr &_msg, Visual::VisualType _type)
     this->dataPtr->terrain->SetLOD(this->dataPtr->heightmapLOD);
     const double skirtLen = this->dataPtr->heightmapSkirtLength;
     this->dataPtr->terrain->SetSkirtLength(skirtLen);
+    this->dataPtr->terrain->SetStreaming(this->dataPtr->heightmapStreaming);
     this->dataPtr->terrain->LoadFromMsg(_msg);
   }
   visual->SetType(_type);
@@ -2949,6 +3221,27 @@ bool Scene::ProcessVisualMsg(ConstVisualPtr &_msg, Visual::VisualType _type)
     visual->SetTransparency(this->dataPtr->transparent ? 0.5 : 0.0);
   visual->SetWireframe(this->dataPtr->wireframe);
 
+  if (this->dataPtr->staticBatching && Batchable(*_msg, _type) &&
+      visual->GetVisibilityFlags() == GZ_VISIBILITY_ALL)
+  {
+    if (!this->dataPtr->staticBatch)
+    {
+      this->dataPtr->staticBatch.reset(new StaticBatch(
+            this->dataPtr->manager, this->Name() + "__STATIC_BATCH__"));
+    }
+    this->dataPtr->staticBatch->Add(visual);
+  }
+
+  if (this->dataPtr->shadowCaching && StaticShadowCaster(*_msg, _type))
+  {
+    if (!this->dataPtr->shadowMapCache)
+    {
+      this->dataPtr->shadowMapCache.reset(new ShadowMapCache(
+            this->dataPtr->manager, this->Name() + "__SHADOW_MAP_CACHE__"));
+    }
+    this->dataPtr->shadowMapCache->AddCaster(visual);
+  }
+
   return true;
 }
 
@@ -2962,25 +3255,20 @@ common::Time Scene::SimTime() const
 /////////////////////////////////////////////////
 void Scene::OnPoseMsg(ConstPosesStampedPtr &_msg)
 {
-  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->poseMsgMutex);
-  this->dataPtr->sceneSimTimePosesReceived =
-    common::Time(_msg->time().sec(), _msg->time().nsec());
-
-  for (int i = 0; i < _msg->pose_size(); ++i)
-  {
-    auto p = _msg->pose(i);
-    PoseMsgs_M::iterator iter =
-        this->dataPtr->poseMsgs.find(p.id());
-    if (iter != this->dataPtr->poseMsgs.end())
-      iter->second.CopyFrom(p);
-    else
-      this->dataPtr->poseMsgs.insert(std::make_pair(p.id(), p));
-  }
+  this->dataPtr->poses.Write(*_msg);
 }
 
 /////////////////////////////////////////////////
 void Scene::UpdatePoses(const msgs::PosesStamped &_msg)
 {
+  if (rendering::lockstep_pipelined())
+  {
+    // Physics runs ahead of the rendering, hold the poses until the
+    // sensors are due, see CommitPoses
+    this->dataPtr->pendingPoses.Write(_msg);
+    return;
+  }
+
   auto msgptr = boost::make_shared<const msgs::PosesStamped>(_msg);
   this->OnPoseMsg(msgptr);
 
@@ -2989,6 +3277,104 @@ void Scene::UpdatePoses(const msgs::PosesStamped &_msg)
   this->dataPtr->newPoseCondition.notify_all();
 }
 
+/////////////////////////////////////////////////
+void Scene::CommitPoses()
+{
+  this->dataPtr->poses.SetTime(this->dataPtr->pendingPoses.Take(
+      [this](const uint32_t _id, const ignition::math::Pose3d &_pose)
+      {
+        this->dataPtr->poses.Write(_id, _pose);
+        return true;
+      }));
+
+  std::unique_lock<std::mutex> lck(this->dataPtr->newPoseMutex);
+  this->dataPtr->newPoseAvailable = true;
+  this->dataPtr->newPoseCondition.notify_all();
+}
+
+/////////////////////////////////////////////////
+void Scene::SetVisualBudget(const double _seconds)
+{
+  this->dataPtr->visualBudget = std::max(_seconds, 0.0);
+}
+
+/////////////////////////////////////////////////
+double Scene::VisualBudget() const
+{
+  return this->dataPtr->visualBudget;
+}
+
+/////////////////////////////////////////////////
+double Scene::PreRenderTime() const
+{
+  return this->dataPtr->preRenderTime;
+}
+
+/////////////////////////////////////////////////
+void Scene::SetPoseCullingCamera(CameraPtr _camera)
+{
+  this->dataPtr->poseCullingCamera = _camera;
+  this->dataPtr->poseCullingFrames = 0;
+}
+
+/////////////////////////////////////////////////
+CameraPtr Scene::PoseCullingCamera() const
+{
+  return this->dataPtr->poseCullingCamera;
+}
+
+/////////////////////////////////////////////////
+void Scene::SetStaticBatching(const bool _enabled)
+{
+  this->dataPtr->staticBatching = _enabled;
+  if (!_enabled)
+    this->dataPtr->staticBatch.reset();
+}
+
+/////////////////////////////////////////////////
+bool Scene::StaticBatching() const
+{
+  return this->dataPtr->staticBatching;
+}
+
+/////////////////////////////////////////////////
+void Scene::SetMeshLod(const bool _enabled)
+{
+  this->dataPtr->meshLod = _enabled;
+}
+
+/////////////////////////////////////////////////
+bool Scene::MeshLod() const
+{
+  return this->dataPtr->meshLod;
+}
+
+/////////////////////////////////////////////////
+void Scene::SetShadowCaching(const bool _enabled)
+{
+  this->dataPtr->shadowCaching = _enabled;
+  if (!_enabled)
+    this->dataPtr->shadowMapCache.reset();
+}
+
+/////////////////////////////////////////////////
+bool Scene::ShadowCaching() const
+{
+  return this->dataPtr->shadowCaching;
+}
+
+/////////////////////////////////////////////////
+bool Scene::VisualsReady() const
+{
+  return this->dataPtr->visualsReady;
+}
+
+/////////////////////////////////////////////////
+size_t Scene::GpuMemoryUsage() const
+{
+  return this->dataPtr->gpuMemoryUsage;
+}
+
 /////////////////////////////////////////////////
 bool Scene::WaitForRenderRequest(double _timeoutsec)
 {
@@ -3343,6 +3729,84 @@ bool Scene::ShadowsEnabled() const
   return this->dataPtr->sdf->Get<bool>("shadows");
 }
 
+/////////////////////////////////////////////////
+void Scene::SetBatchRender(const bool _enabled)
+{
+  this->dataPtr->batchRender = _enabled;
+  if (this->dataPtr->viewCache)
+    this->dataPtr->viewCache->viewport = nullptr;
+}
+
+/////////////////////////////////////////////////
+bool Scene::BatchRender() const
+{
+  return this->dataPtr->batchRender;
+}
+
+/////////////////////////////////////////////////
+bool Scene::BeginCameraRender(Ogre::Viewport *_viewport)
+{
+  SceneViewCache *cache = this->dataPtr->viewCache.get();
+  if (!this->dataPtr->batchRender || !cache || !_viewport ||
+      !cache->viewport || cache->viewport == _viewport)
+  {
+    return false;
+  }
+
+  // The render queue must still hold the visible objects of the cached
+  // view, found in this frame
+  if (cache->findViewport != cache->viewport ||
+      cache->frame != Ogre::Root::getSingleton().getNextFrameNumber())
+  {
+    return false;
+  }
+
+  // Compositors may render the scene with other settings
+  if (Ogre::CompositorManager::getSingleton().hasCompositorChain(_viewport))
+    return false;
+
+  Ogre::Camera *camera = _viewport->getCamera();
+  if (!camera || cache->mask != _viewport->getVisibilityMask() ||
+      cache->shadows != _viewport->getShadowsEnabled() ||
+      cache->view != camera->getViewMatrix(true) ||
+      cache->projection != camera->getProjectionMatrix())
+  {
+    return false;
+  }
+
+  this->dataPtr->manager->setFindVisibleObjects(false);
+  return true;
+}
+
+/////////////////////////////////////////////////
+void Scene::EndCameraRender(Ogre::Viewport *_viewport, const bool _reused)
+{
+  SceneViewCache *cache = this->dataPtr->viewCache.get();
+  if (_reused)
+  {
+    this->dataPtr->manager->setFindVisibleObjects(true);
+    return;
+  }
+
+  if (!this->dataPtr->batchRender || !cache)
+    return;
+
+  // Remember the view if its visible objects are the last ones found
+  cache->viewport = nullptr;
+  if (_viewport && _viewport->getCamera() &&
+      cache->findViewport == _viewport &&
+      !Ogre::CompositorManager::getSingleton().hasCompositorChain(_viewport))
+  {
+    Ogre::Camera *camera = _viewport->getCamera();
+    cache->viewport = _viewport;
+    cache->frame = Ogre::Root::getSingleton().getNextFrameNumber();
+    cache->view = camera->getViewMatrix(true);
+    cache->projection = camera->getProjectionMatrix();
+    cache->mask = _viewport->getVisibilityMask();
+    cache->shadows = _viewport->getShadowsEnabled();
+  }
+}
+
 /////////////////////////////////////////////////
 bool Scene::SetShadowTextureSize(const unsigned int _size)
 {
@@ -3418,6 +3882,11 @@ void Scene::RemoveVisual(uint32_t _id)
   if (iter != this->dataPtr->visuals.end())
   {
     VisualPtr vis = iter->second;
+    if (this->dataPtr->staticBatch)
+      this->dataPtr->staticBatch->Remove(vis);
+    if (this->dataPtr->shadowMapCache)
+      this->dataPtr->shadowMapCache->RemoveCaster(vis);
+
     // Remove the terrain object if this is the heightmap visual
     if (this->dataPtr->terrainVisualId &&
         *this->dataPtr->terrainVisualId == _id)
@@ -3568,6 +4037,18 @@ double Scene::HeightmapSkirtLength() const
   return this->dataPtr->heightmapSkirtLength;
 }
 
+/////////////////////////////////////////////////
+void Scene::SetHeightmapStreaming(const bool _enabled)
+{
+  this->dataPtr->heightmapStreaming = _enabled;
+}
+
+/////////////////////////////////////////////////
+bool Scene::HeightmapStreaming() const
+{
+  return this->dataPtr->heightmapStreaming;
+}
+
 /////////////////////////////////////////////////
 void Scene::CreateCOMVisual(ConstLinkPtr &_msg, VisualPtr _linkVisual)
 {
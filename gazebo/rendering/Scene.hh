@@ -414,6 +414,36 @@ namespace gazebo
       /// \return True if shadows are enabled.
       public: bool ShadowsEnabled() const;
 
+      /// \brief Set whether cameras rendered in the same frame with the same
+      /// view share their work. A camera with the same pose, projection and
+      /// visibility mask as the camera rendered just before it in the frame
+      /// reuses the visible objects and shadow maps found by that camera,
+      /// instead of culling the scene and rendering the shadow maps again.
+      /// This helps rigs of co-located cameras, e.g. cameras with the same
+      /// pose and intrinsics but different image formats. Cameras with
+      /// compositors are always rendered on their own.
+      /// \param[in] _enabled True to enable the batched render mode.
+      public: void SetBatchRender(const bool _enabled);
+
+      /// \brief Get whether cameras with the same view share their work.
+      /// \return True if the batched render mode is enabled.
+      /// \sa SetBatchRender
+      public: bool BatchRender() const;
+
+      /// \internal
+      /// \brief Prepare the render of a camera viewport.
+      /// \param[in] _viewport Viewport about to be rendered.
+      /// \return True if the viewport reuses the visible objects of the
+      /// previous render, in which case EndCameraRender must be called.
+      public: bool BeginCameraRender(Ogre::Viewport *_viewport);
+
+      /// \internal
+      /// \brief Finish the render of a camera viewport.
+      /// \param[in] _viewport Viewport that was rendered.
+      /// \param[in] _reused Value returned by BeginCameraRender.
+      public: void EndCameraRender(Ogre::Viewport *_viewport,
+                  const bool _reused);
+
       /// \brief Set the shadow texture size
       /// \param[in] _size Size to set the shadow texture to. This must be a
       /// power of 2. The default size is 1024.
@@ -500,6 +530,19 @@ namespace gazebo
       /// \sa Heightmap::SkirtLength
       public: double HeightmapSkirtLength() const;
 
+      /// \brief Load the heightmap in the background, only around the
+      /// cameras when it uses terrain paging. It applies to the heightmaps
+      /// created afterwards, so it is best set with
+      /// <ignition:heightmap_streaming> in the scene SDF.
+      /// \param[in] _enabled True to stream the heightmap.
+      /// \sa Heightmap::SetStreaming
+      public: void SetHeightmapStreaming(const bool _enabled);
+
+      /// \brief Check whether the heightmap is loaded in the background.
+      /// \return True if the heightmap is streamed.
+      /// \sa Heightmap::Streaming
+      public: bool HeightmapStreaming() const;
+
       /// \brief Clear rendering::Scene
       public: void Clear();
 
@@ -582,6 +625,99 @@ namespace gazebo
       /// \param[in] _msg The message data.
       public: void UpdatePoses(const msgs::PosesStamped& _msg);
 
+      /// \brief Hand the poses held by UpdatePoses to the rendering, when
+      /// lockstepping is pipelined, and wake up WaitForRenderRequest. The
+      /// scene then renders the poses of the last step until the next
+      /// commit, while physics steps on.
+      /// \sa rendering::set_lockstep_pipelined
+      public: void CommitPoses();
+
+      /// \brief Set the time PreRender may spend creating visuals in one
+      /// frame. While a limit is set, the meshes of new visuals are also
+      /// parsed on worker threads before the visuals are created, and the
+      /// remaining visuals are created in the next frames.
+      /// The limit may also be set with <ignition:visual_budget> in the
+      /// scene SDF.
+      /// \param[in] _seconds Time limit in seconds, 0 for no limit.
+      /// \sa VisualsReady
+      public: void SetVisualBudget(const double _seconds);
+
+      /// \brief Get the time PreRender may spend creating visuals in one
+      /// frame.
+      /// \return Time limit in seconds, 0 if there is no limit.
+      public: double VisualBudget() const;
+
+      /// \brief Get the time the last PreRender took to process the scene
+      /// messages and to apply the poses of the visuals.
+      /// \return The time in seconds.
+      public: double PreRenderTime() const;
+
+      /// \brief Skip applying the poses of the visuals outside the view of
+      /// a camera, to save time in PreRender. The skipped poses are kept
+      /// and applied when the visual enters the view, and every few frames
+      /// so that visuals moving into the view are not missed.
+      /// \param[in] _camera The camera, null to apply all the poses.
+      /// \sa UserCamera::SetFrameBudget
+      public: void SetPoseCullingCamera(CameraPtr _camera);
+
+      /// \brief Get the camera outside the view of which poses are skipped.
+      /// \return The camera, null if all the poses are applied.
+      public: CameraPtr PoseCullingCamera() const;
+
+      /// \brief Enable merging the meshes of static models into a few
+      /// batches, see StaticBatch. Only the visuals created while it is
+      /// enabled are batched, so it is best set with
+      /// <ignition:static_batching> in the scene SDF. Batched models that
+      /// move, are selected or are updated by a message are drawn on their
+      /// own again, until the batches are built again.
+      /// \param[in] _enabled True to batch static models.
+      public: void SetStaticBatching(const bool _enabled);
+
+      /// \brief Check whether static models are batched.
+      /// \return True if static models are batched.
+      public: bool StaticBatching() const;
+
+      /// \brief Enable generating levels of detail for large meshes, see
+      /// Visual::InsertMesh. Only the meshes loaded while it is enabled
+      /// get levels of detail, so it is best set with <ignition:mesh_lod>
+      /// in the scene SDF. The distances at which a camera switches levels
+      /// may be scaled with Camera::SetLodBias.
+      /// \param[in] _enabled True to generate levels of detail.
+      public: void SetMeshLod(const bool _enabled);
+
+      /// \brief Check whether levels of detail are generated for large
+      /// meshes.
+      /// \return True if levels of detail are generated.
+      public: bool MeshLod() const;
+
+      /// \brief Enable caching the shadow maps of static models, see
+      /// ShadowMapCache. Shadow textures rendered from the same light view
+      /// as in the previous frame then only render the models that may
+      /// move. Only the visuals created while it is enabled are cached, so
+      /// it is best set with <ignition:shadow_caching> in the scene SDF.
+      /// \param[in] _enabled True to cache shadow maps.
+      public: void SetShadowCaching(const bool _enabled);
+
+      /// \brief Check whether the shadow maps of static models are cached.
+      /// \return True if shadow maps are cached.
+      public: bool ShadowCaching() const;
+
+      /// \brief Check whether the last PreRender created all the visuals
+      /// received, i.e. no visual was left for a later frame because of the
+      /// visual budget or of meshes still being parsed, and whether the
+      /// heightmap finished loading.
+      /// \return True if the scene is complete.
+      public: bool VisualsReady() const;
+
+      /// \brief Get the memory used by the meshes and textures drawn in
+      /// the scene, and by the render textures of its cameras. Resources
+      /// shared with other scenes are counted in each of them. The value is
+      /// measured once per second by PreRender, and may be read from any
+      /// thread.
+      /// \return Memory used in bytes.
+      /// \sa RenderEngine::GpuMemoryUsage
+      public: size_t GpuMemoryUsage() const;
+
       /// \brief Get the number of visuals.
       /// \return The number of visuals in the Scene.
       public: uint32_t VisualCount() const;
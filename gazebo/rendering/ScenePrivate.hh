@@ -17,12 +17,15 @@
 #ifndef GAZEBO_RENDERING_SCENE_PRIVATE_HH_
 #define GAZEBO_RENDERING_SCENE_PRIVATE_HH_
 
+#include <atomic>
 #include <condition_variable>
+#include <future>
 #include <list>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -34,7 +37,10 @@
 #include "gazebo/gazebo_config.h"
 #include "gazebo/msgs/msgs.hh"
 #include "gazebo/rendering/MarkerManager.hh"
+#include "gazebo/rendering/PoseMailbox.hh"
 #include "gazebo/rendering/RenderTypes.hh"
+#include "gazebo/rendering/ShadowMapCache.hh"
+#include "gazebo/rendering/StaticBatch.hh"
 #include "gazebo/transport/TransportTypes.hh"
 
 namespace SkyX
@@ -54,6 +60,7 @@ namespace gazebo
   namespace rendering
   {
     class Projector;
+    class SceneViewCache;
     class Visual;
     class Grid;
     class Heightmap;
@@ -70,10 +77,6 @@ namespace gazebo
     /// \brief List of light messages.
     typedef std::list<boost::shared_ptr<msgs::Light const> > LightMsgs_L;
 
-    /// \typedef PoseMsgs_M.
-    /// \brief List of messages.
-    typedef std::map<uint32_t, msgs::Pose> PoseMsgs_M;
-
     /// \typedef LightPoseMsgs_M.
     /// \brief List of messages.
     typedef std::map<std::string, msgs::Pose> LightPoseMsgs_M;
@@ -183,12 +186,17 @@ namespace gazebo
       /// \brief List of light modify message to process.
       public: LightMsgs_L lightModifyMsgs;
 
-      /// \brief List of pose message to process.
-      public: PoseMsgs_M poseMsgs;
+      /// \brief Poses of the visuals and lights to process, and their
+      /// sim time.
+      public: PoseMailbox poses;
 
       /// \brief List of pose message to process.
       public: LightPoseMsgs_M lightPoseMsgs;
 
+      /// \brief Poses held until CommitPoses, when lockstepping is
+      /// pipelined.
+      public: PoseMailbox pendingPoses;
+
       /// \brief List of scene message to process.
       public: SceneMsgs_L sceneMsgs;
 
@@ -231,7 +239,50 @@ namespace gazebo
       /// \brief Mutex to lock the various message buffers.
       public: std::mutex *receiveMutex = nullptr;
 
-      /// \brief Mutex to lock the pose message buffers.
+      /// \brief Time PreRender may spend creating visuals in one frame, in
+      /// seconds, 0 for no limit.
+      public: double visualBudget = 0.0;
+
+      /// \brief Duration of the last PreRender, in seconds.
+      public: double preRenderTime = 0.0;
+
+      /// \brief Camera outside the view of which poses are skipped.
+      public: CameraPtr poseCullingCamera;
+
+      /// \brief Number of PreRender calls since poses were last applied to
+      /// visuals outside the view of the pose culling camera.
+      public: unsigned int poseCullingFrames = 0;
+
+      /// \brief True to batch static models.
+      public: bool staticBatching = false;
+
+      /// \brief True to generate levels of detail for large meshes.
+      public: bool meshLod = false;
+
+      /// \brief True to cache the shadow maps of static models.
+      public: bool shadowCaching = false;
+
+      /// \brief Shadow maps of static models, created when the first
+      /// model is added.
+      public: std::unique_ptr<ShadowMapCache> shadowMapCache;
+
+      /// \brief Batches of static models, created when the first model is
+      /// batched.
+      public: std::unique_ptr<StaticBatch> staticBatch;
+
+      /// \brief False if the last PreRender left visuals to create.
+      public: std::atomic<bool> visualsReady{true};
+
+      /// \brief Meshes of new visuals being loaded, when a visual budget
+      /// is set.
+      public: std::vector<std::shared_future<const common::Mesh *> >
+              meshLoads;
+
+      /// \brief Mesh filenames of the visual messages already given to
+      /// MeshManager::LoadAsync.
+      public: std::set<std::string> preloadedMeshes;
+
+      /// \brief Mutex to lock the skeleton pose message buffers.
       public: std::recursive_mutex poseMsgMutex;
 
       /// \brief Communication Node
@@ -322,6 +373,16 @@ namespace gazebo
       /// \brief The heightmap skirt length
       public: double heightmapSkirtLength = 1.0;
 
+      /// \brief True to load the heightmap in the background
+      public: bool heightmapStreaming = false;
+
+      /// \brief Memory used by the meshes and textures of the scene, as of
+      /// the last measure.
+      public: std::atomic<size_t> gpuMemoryUsage{0};
+
+      /// \brief Wall time of the last measure of gpuMemoryUsage.
+      public: common::Time gpuMemoryTime;
+
       /// \brief All the projectors.
       public: std::map<std::string, Projector *> projectors;
 
@@ -358,10 +419,6 @@ namespace gazebo
       /// \brief Initialized.
       public: bool initialized;
 
-      /// \brief SimTime of this Scene, as we receive PosesStamped from
-      /// the world, we update this time accordingly.
-      public: common::Time sceneSimTimePosesReceived;
-
       /// \brief SimTime of this Scene, after applying PosesStamped to
       /// scene, we update this time accordingly.
       public: common::Time sceneSimTimePosesApplied;
@@ -387,6 +444,13 @@ namespace gazebo
 
       /// \brief Shadow caster render back faces
       public: bool shadowCasterRenderBackFaces = true;
+
+      /// \brief True if cameras with the same view in a frame reuse the
+      /// visible objects and shadow maps of the first one.
+      public: bool batchRender = false;
+
+      /// \brief Last view whose visible objects are in the render queue.
+      public: std::unique_ptr<SceneViewCache> viewCache;
     };
   }
 }
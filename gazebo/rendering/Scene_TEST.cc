@@ -16,6 +16,7 @@
 */
 
 #include <gtest/gtest.h>
+#include "gazebo/rendering/Camera.hh"
 #include "gazebo/rendering/Scene.hh"
 #include "gazebo/test/ServerFixture.hh"
 
@@ -365,6 +366,165 @@ TEST_F(Scene_TEST, Shadows)
   EXPECT_TRUE(scene->ShadowsEnabled());
 }
 
+/////////////////////////////////////////////////
+TEST_F(Scene_TEST, BatchRender)
+{
+  Load("worlds/shapes.world");
+
+  // Get the scene
+  gazebo::rendering::ScenePtr scene = gazebo::rendering::get_scene();
+  ASSERT_TRUE(scene != nullptr);
+
+  // Disabled by default
+  EXPECT_FALSE(scene->BatchRender());
+  EXPECT_FALSE(scene->BeginCameraRender(nullptr));
+
+  scene->SetBatchRender(true);
+  EXPECT_TRUE(scene->BatchRender());
+
+  // Nothing was rendered yet, so there is nothing to reuse
+  rendering::CameraPtr camera = scene->CreateCamera("test_camera", false);
+  ASSERT_TRUE(camera != nullptr);
+  EXPECT_FALSE(scene->BeginCameraRender(camera->OgreViewport()));
+
+  scene->SetBatchRender(false);
+  EXPECT_FALSE(scene->BatchRender());
+  scene->RemoveCamera(camera->Name());
+}
+
+/////////////////////////////////////////////////
+TEST_F(Scene_TEST, VisualBudget)
+{
+  Load("worlds/empty.world");
+
+  // Get the scene
+  gazebo::rendering::ScenePtr scene = gazebo::rendering::get_scene();
+  ASSERT_TRUE(scene != nullptr);
+
+  // No limit by default
+  EXPECT_DOUBLE_EQ(0.0, scene->VisualBudget());
+  EXPECT_TRUE(scene->VisualsReady());
+
+  scene->SetVisualBudget(-1.0);
+  EXPECT_DOUBLE_EQ(0.0, scene->VisualBudget());
+
+  // The visuals are still all created, over several frames if needed
+  scene->SetVisualBudget(1e-6);
+  EXPECT_DOUBLE_EQ(1e-6, scene->VisualBudget());
+
+  SpawnBox("budget_box",
+      ignition::math::Vector3d(1, 1, 1),
+      ignition::math::Vector3d(10, 10, 1),
+      ignition::math::Vector3d::Zero);
+
+  int sleep = 0;
+  int maxSleep = 50;
+  rendering::VisualPtr box;
+  while ((!box || !scene->VisualsReady()) && sleep < maxSleep)
+  {
+    event::Events::preRender();
+    event::Events::render();
+    event::Events::postRender();
+
+    box = scene->GetVisual("budget_box");
+    common::Time::MSleep(100);
+    sleep++;
+  }
+  ASSERT_TRUE(box != nullptr);
+  EXPECT_TRUE(scene->VisualsReady());
+  EXPECT_TRUE(scene->GetVisual("budget_box::link::visual") != nullptr);
+  EXPECT_GT(scene->PreRenderTime(), 0.0);
+
+  scene->SetVisualBudget(0.0);
+}
+
+/////////////////////////////////////////////////
+TEST_F(Scene_TEST, PoseCulling)
+{
+  Load("worlds/empty.world");
+
+  gazebo::rendering::ScenePtr scene = gazebo::rendering::get_scene();
+  ASSERT_TRUE(scene != nullptr);
+  EXPECT_TRUE(scene->PoseCullingCamera() == nullptr);
+
+  rendering::CameraPtr camera =
+      scene->CreateCamera("test_camera_pose_culling", false);
+  ASSERT_TRUE(camera != nullptr);
+
+  std::stringstream ss;
+  ss << "<sdf version='" << SDF_VERSION << "'>"
+     << "  <camera>"
+     << "    <horizontal_fov>1.0</horizontal_fov>"
+     << "    <image>"
+     << "      <width>320</width>"
+     << "      <height>240</height>"
+     << "    </image>"
+     << "  </camera>"
+     << "</sdf>";
+  sdf::ElementPtr cameraSDF(new sdf::Element);
+  sdf::initFile("camera.sdf", cameraSDF);
+  sdf::readString(ss.str(), cameraSDF);
+  camera->Load(cameraSDF);
+  camera->Init();
+  camera->CreateRenderTexture("test_camera_pose_culling_texture");
+  camera->SetWorldPose(ignition::math::Pose3d(0, 0, 0.5, 0, 0, 0));
+
+  // One box in front of the camera, one behind it
+  rendering::VisualPtr boxes[2];
+  const double x[2] = {5.0, -5.0};
+  for (int i = 0; i < 2; ++i)
+  {
+    boxes[i].reset(new rendering::Visual(
+        "pose_culling_box_" + std::to_string(i), scene->WorldVisual()));
+    boxes[i]->Load();
+    boxes[i]->AttachMesh("unit_box");
+    boxes[i]->SetWorldPosition(ignition::math::Vector3d(x[i], 0, 0.5));
+    scene->AddVisual(boxes[i]);
+  }
+
+  // Render once to compute the bounds of the boxes
+  camera->Update();
+  camera->Render(true);
+  camera->PostRender();
+
+  scene->SetPoseCullingCamera(camera);
+  EXPECT_TRUE(scene->PoseCullingCamera() == camera);
+
+  msgs::PosesStamped msg;
+  msgs::Set(msg.mutable_time(), common::Time(1.0));
+  for (int i = 0; i < 2; ++i)
+  {
+    msgs::Pose *pose = msg.add_pose();
+    pose->set_name(boxes[i]->Name());
+    pose->set_id(boxes[i]->GetId());
+    msgs::Set(pose, ignition::math::Pose3d(x[i], 1, 0.5, 0, 0, 0));
+  }
+  scene->UpdatePoses(msg);
+
+  // Only the box in view moves
+  scene->PreRender();
+  EXPECT_EQ(boxes[0]->WorldPose().Pos(),
+      ignition::math::Vector3d(x[0], 1, 0.5));
+  EXPECT_EQ(boxes[1]->WorldPose().Pos(),
+      ignition::math::Vector3d(x[1], 0, 0.5));
+
+  // The pose of the box out of view is applied after a few frames
+  int frames = 0;
+  while (boxes[1]->WorldPose().Pos().Y() < 0.5 && frames < 20)
+  {
+    scene->PreRender();
+    ++frames;
+  }
+  EXPECT_LT(frames, 20);
+  EXPECT_EQ(boxes[1]->WorldPose().Pos(),
+      ignition::math::Vector3d(x[1], 1, 0.5));
+
+  scene->SetPoseCullingCamera(rendering::CameraPtr());
+  EXPECT_TRUE(scene->PoseCullingCamera() == nullptr);
+
+  scene->RemoveCamera(camera->Name());
+}
+
 /////////////////////////////////////////////////
 TEST_F(Scene_TEST, AddRemoveLights)
 {
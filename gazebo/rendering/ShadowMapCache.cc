@@ -0,0 +1,635 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <list>
+#include <map>
+#include <set>
+#include <vector>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/rendering/ogre_gazebo.h"
+#include "gazebo/rendering/ShadowMapCache.hh"
+#include "gazebo/rendering/Visual.hh"
+
+using namespace gazebo;
+using namespace rendering;
+
+/// \brief Maximum number of light views cached per shadow texture.
+static const size_t kMaxViews = 4;
+
+/// \brief Visibility mask of the casters rendered on top of a cache, the
+/// bits that the objects of static visuals never have.
+static const uint32_t kDynamicMask =
+  ~(GZ_VISIBILITY_ALL & ~GZ_VISIBILITY_SHADOW_DYNAMIC) &
+  ~GZ_VISIBILITY_SHADOW_STATIC;
+
+/// \brief Material that copies a cache into a shadow texture.
+static const char kRestoreMaterial[] = "Gazebo/ShadowMapRestore";
+
+/////////////////////////////////////////////////
+/// \brief Get the visibility flags of the object of a static visual.
+/// \param[in] _flags Visibility flags of the object.
+/// \return The flags, without the dynamic bits.
+static uint32_t StaticFlags(const uint32_t _flags)
+{
+  return (_flags & ~kDynamicMask) | GZ_VISIBILITY_SHADOW_STATIC;
+}
+
+namespace gazebo
+{
+  namespace rendering
+  {
+    /// \brief Object attached to a static visual.
+    class ShadowMapObject
+    {
+      /// \brief The object, only used while it is attached to the visual.
+      public: Ogre::MovableObject *object = nullptr;
+
+      /// \brief Visibility flags of the object before it was added.
+      public: uint32_t flags = 0;
+
+      /// \brief True if the object was visible and cast shadows.
+      public: bool casts = false;
+    };
+
+    /// \brief A static visual.
+    class ShadowMapCaster
+    {
+      /// \brief The visual.
+      public: VisualWeakPtr visual;
+
+      /// \brief Transform of the scene node of the visual.
+      public: Ogre::Matrix4 transform;
+
+      /// \brief Objects attached to the visual.
+      public: std::vector<ShadowMapObject> objects;
+    };
+
+    /// \brief Cached static casters of a light view.
+    class ShadowMapView
+    {
+      /// \brief View matrix of the shadow camera.
+      public: Ogre::Matrix4 view;
+
+      /// \brief Projection matrix of the shadow camera.
+      public: Ogre::Matrix4 projection;
+
+      /// \brief Static state in which the view was last rendered.
+      public: unsigned int seen = 0;
+
+      /// \brief Static state rendered in the texture.
+      public: unsigned int built = 0;
+
+      /// \brief Frame in which the view was last rendered.
+      public: unsigned long frame = 0;
+
+      /// \brief The static casters, null if not built.
+      public: Ogre::TexturePtr texture;
+    };
+
+    /// \brief A shadow texture of the scene manager.
+    class ShadowMapTarget
+    {
+      /// \brief Visibility mask of the viewport before it was cached.
+      public: uint32_t mask = 0;
+
+      /// \brief Light views rendered into the texture.
+      public: std::list<ShadowMapView> views;
+    };
+  }
+}
+
+/// \brief Private data for the ShadowMapCache class.
+class gazebo::rendering::ShadowMapCachePrivate
+  : public Ogre::SceneManager::Listener, public Ogre::RenderQueueListener
+{
+  // Documentation inherited
+  public: virtual void shadowTextureCasterPreViewProj(Ogre::Light *,
+              Ogre::Camera *_camera, size_t)
+          {
+            Ogre::Viewport *viewport = _camera ? _camera->getViewport() :
+              nullptr;
+            if (!viewport)
+              return;
+
+            const unsigned long frame =
+              Ogre::Root::getSingleton().getNextFrameNumber();
+            if (frame != this->frame)
+            {
+              this->frame = frame;
+              this->Validate();
+            }
+
+            Ogre::TexturePtr shadowTexture;
+            for (size_t i = 0; i < this->manager->getShadowTextureCount();
+                 ++i)
+            {
+              Ogre::TexturePtr texture = this->manager->getShadowTexture(i);
+              if (!texture.isNull() &&
+                  texture->getBuffer()->getRenderTarget() ==
+                  viewport->getTarget())
+              {
+                shadowTexture = texture;
+              }
+            }
+            if (shadowTexture.isNull())
+              return;
+
+            auto inserted = this->targets.insert(
+                std::make_pair(viewport->getTarget(), ShadowMapTarget()));
+            ShadowMapTarget &target = inserted.first->second;
+            if (inserted.second)
+              target.mask = viewport->getVisibilityMask();
+
+            // Renders that reuse the visible objects of another view can't
+            // render the caches
+            Ogre::TexturePtr cache;
+            if (!this->casters.empty() &&
+                this->manager->getFindVisibleObjects() && this->RestorePass())
+            {
+              cache = this->Lookup(target, *_camera, shadowTexture);
+            }
+
+            if (cache.isNull())
+            {
+              viewport->setClearEveryFrame(true,
+                  Ogre::FBT_COLOUR | Ogre::FBT_DEPTH);
+              viewport->setVisibilityMask(target.mask);
+              this->restoreViewport = nullptr;
+              return;
+            }
+
+            // The cache is copied by the first render queue, and replaces
+            // the colour clear
+            viewport->setClearEveryFrame(true, Ogre::FBT_DEPTH);
+            viewport->setVisibilityMask(target.mask & kDynamicMask);
+            this->restoreViewport = viewport;
+            this->restorePass->getTextureUnitState(0)->setTextureName(
+                cache->getName());
+            ++this->hits;
+          }
+
+  // Documentation inherited
+  public: virtual void renderQueueStarted(Ogre::uint8,
+              const Ogre::String &, bool &)
+          {
+            if (!this->restoreViewport ||
+                this->manager->getCurrentViewport() != this->restoreViewport)
+            {
+              return;
+            }
+
+            this->restoreViewport = nullptr;
+            this->manager->_injectRenderWithPass(this->restorePass,
+                this->quad.get(), false);
+          }
+
+  /// \brief Get the pass that copies a cache into a shadow texture.
+  /// \return The pass, null if the material is not available.
+  public: Ogre::Pass *RestorePass()
+          {
+            if (this->restorePass || this->restoreFailed)
+              return this->restorePass;
+
+            this->restoreFailed = true;
+            Ogre::MaterialPtr material =
+              Ogre::MaterialManager::getSingleton().getByName(
+                  kRestoreMaterial);
+            if (material.isNull())
+            {
+              gzwarn << "Material[" << kRestoreMaterial << "] not found, "
+                     << "shadow maps are not cached" << std::endl;
+              return nullptr;
+            }
+
+            material->load();
+            Ogre::Technique *technique = material->getBestTechnique();
+            if (!technique || technique->getNumPasses() == 0u)
+            {
+              gzwarn << "Material[" << kRestoreMaterial << "] is not "
+                     << "supported, shadow maps are not cached" << std::endl;
+              return nullptr;
+            }
+
+            this->restorePass = technique->getPass(0);
+            this->restoreFailed = false;
+            this->quad.reset(new Ogre::Rectangle2D(true));
+            this->quad->setCorners(-1, 1, 1, -1);
+            this->quad->setBoundingBox(Ogre::AxisAlignedBox::BOX_INFINITE);
+            return this->restorePass;
+          }
+
+  /// \brief Find the cache of a light view, building it if the view was
+  /// already rendered without static changes.
+  /// \param[in] _target The shadow texture.
+  /// \param[in] _camera Shadow camera of the view.
+  /// \param[in] _shadowTexture Texture of the target.
+  /// \return The cache, null if the view is not cached.
+  public: Ogre::TexturePtr Lookup(ShadowMapTarget &_target,
+              const Ogre::Camera &_camera,
+              const Ogre::TexturePtr &_shadowTexture)
+          {
+            const Ogre::Matrix4 &view = _camera.getViewMatrix(true);
+            const Ogre::Matrix4 &projection = _camera.getProjectionMatrix();
+            auto iter = std::find_if(_target.views.begin(),
+                _target.views.end(), [&](const ShadowMapView &_view)
+                {
+                  return _view.view == view && _view.projection == projection;
+                });
+
+            if (iter == _target.views.end())
+            {
+              if (_target.views.size() >= kMaxViews)
+              {
+                auto oldest = std::min_element(_target.views.begin(),
+                    _target.views.end(),
+                    [](const ShadowMapView &_a, const ShadowMapView &_b)
+                    {
+                      return _a.frame < _b.frame;
+                    });
+                this->Release(*oldest);
+                _target.views.erase(oldest);
+              }
+
+              ShadowMapView newView;
+              newView.view = view;
+              newView.projection = projection;
+              newView.seen = this->epoch;
+              newView.frame = this->frame;
+              _target.views.push_back(newView);
+              return Ogre::TexturePtr();
+            }
+
+            iter->frame = this->frame;
+            const bool sameSize = !iter->texture.isNull() &&
+              iter->texture->getWidth() == _shadowTexture->getWidth() &&
+              iter->texture->getHeight() == _shadowTexture->getHeight() &&
+              iter->texture->getFormat() == _shadowTexture->getFormat();
+            if (sameSize && iter->built == this->epoch)
+              return iter->texture;
+
+            // Views that change every frame are not worth caching
+            if (iter->seen != this->epoch)
+            {
+              iter->seen = this->epoch;
+              return Ogre::TexturePtr();
+            }
+
+            if (!sameSize && !this->Create(*iter, _shadowTexture))
+              return Ogre::TexturePtr();
+
+            this->camera->setCustomViewMatrix(true, view);
+            this->camera->setCustomProjectionMatrix(true, projection);
+            iter->texture->getBuffer()->getRenderTarget()->update();
+            iter->built = this->epoch;
+            return iter->texture;
+          }
+
+  /// \brief Create the texture of a cached view.
+  /// \param[in] _view The view.
+  /// \param[in] _shadowTexture Texture to cache.
+  /// \return True if the texture was created.
+  public: bool Create(ShadowMapView &_view,
+              const Ogre::TexturePtr &_shadowTexture)
+          {
+            this->Release(_view);
+            try
+            {
+              _view.texture = Ogre::TextureManager::getSingleton().createManual(
+                  this->name + "_" + std::to_string(this->textureCount++),
+                  Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME,
+                  Ogre::TEX_TYPE_2D, _shadowTexture->getWidth(),
+                  _shadowTexture->getHeight(), 0,
+                  _shadowTexture->getFormat(), Ogre::TU_RENDERTARGET);
+            }
+            catch(Ogre::Exception &_e)
+            {
+              gzwarn << "Unable to create a shadow map cache["
+                     << _e.getDescription() << "]" << std::endl;
+              _view.texture.setNull();
+              return false;
+            }
+
+            Ogre::RenderTarget *target =
+              _view.texture->getBuffer()->getRenderTarget();
+            target->setAutoUpdated(false);
+            Ogre::Viewport *viewport = target->addViewport(this->camera);
+            viewport->setClearEveryFrame(true);
+            viewport->setBackgroundColour(Ogre::ColourValue::White);
+            viewport->setOverlaysEnabled(false);
+            viewport->setSkiesEnabled(false);
+            viewport->setShadowsEnabled(false);
+            viewport->setVisibilityMask(GZ_VISIBILITY_SHADOW_STATIC);
+            return true;
+          }
+
+  /// \brief Release the texture of a cached view.
+  /// \param[in] _view The view.
+  public: void Release(ShadowMapView &_view)
+          {
+            if (_view.texture.isNull())
+              return;
+            Ogre::TextureManager::getSingleton().remove(
+                _view.texture->getName());
+            _view.texture.setNull();
+          }
+
+  /// \brief Flag the objects attached to a static visual.
+  /// \param[in] _caster The visual.
+  /// \param[in] _node Scene node of the visual.
+  /// \return True if the objects changed since the last call.
+  public: bool Mark(ShadowMapCaster &_caster, Ogre::SceneNode *_node)
+          {
+            bool changed = _node->numAttachedObjects() !=
+              _caster.objects.size();
+            std::vector<ShadowMapObject> objects;
+            for (unsigned int i = 0; i < _node->numAttachedObjects(); ++i)
+            {
+              ShadowMapObject object;
+              object.object = _node->getAttachedObject(i);
+              object.casts = object.object->getVisible() &&
+                object.object->getCastShadows();
+
+              auto old = std::find_if(_caster.objects.begin(),
+                  _caster.objects.end(), [&](const ShadowMapObject &_old)
+                  {
+                    return _old.object == object.object;
+                  });
+
+              // Flags set by someone else are the new original flags
+              const uint32_t flags = object.object->getVisibilityFlags();
+              if (old != _caster.objects.end() &&
+                  flags == StaticFlags(old->flags))
+              {
+                object.flags = old->flags;
+                changed = changed || old->casts != object.casts;
+              }
+              else
+              {
+                object.flags = flags;
+                object.object->setVisibilityFlags(StaticFlags(flags));
+                changed = true;
+              }
+              objects.push_back(object);
+            }
+            _caster.objects.swap(objects);
+            return changed;
+          }
+
+  /// \brief Restore the flags of the objects attached to a static visual.
+  /// \param[in] _caster The visual.
+  public: void Unmark(const ShadowMapCaster &_caster)
+          {
+            VisualPtr visual = _caster.visual.lock();
+            Ogre::SceneNode *node = visual ? visual->GetSceneNode() : nullptr;
+            if (!node)
+              return;
+
+            // Detached objects may be destroyed
+            for (unsigned int i = 0; i < node->numAttachedObjects(); ++i)
+            {
+              Ogre::MovableObject *object = node->getAttachedObject(i);
+              for (auto const &cached : _caster.objects)
+              {
+                if (cached.object == object)
+                  object->setVisibilityFlags(cached.flags);
+              }
+            }
+          }
+
+  /// \brief Check the static visuals and the shadow textures, once per
+  /// frame once the scene graph is updated.
+  public: void Validate()
+          {
+            bool changed = false;
+            for (auto caster = this->casters.begin();
+                 caster != this->casters.end();)
+            {
+              VisualPtr visual = caster->visual.lock();
+              Ogre::SceneNode *node =
+                visual ? visual->GetSceneNode() : nullptr;
+              if (!node)
+              {
+                caster = this->casters.erase(caster);
+                changed = true;
+                continue;
+              }
+
+              const Ogre::Matrix4 &transform = node->_getFullTransform();
+              if (transform != caster->transform)
+              {
+                caster->transform = transform;
+                changed = true;
+              }
+              changed = this->Mark(*caster, node) || changed;
+              ++caster;
+            }
+
+            if (changed)
+              ++this->epoch;
+
+            // Forget the shadow textures that were destroyed
+            std::set<Ogre::RenderTarget *> current;
+            for (size_t i = 0; i < this->manager->getShadowTextureCount();
+                 ++i)
+            {
+              Ogre::TexturePtr texture = this->manager->getShadowTexture(i);
+              if (!texture.isNull())
+                current.insert(texture->getBuffer()->getRenderTarget());
+            }
+            for (auto target = this->targets.begin();
+                 target != this->targets.end();)
+            {
+              if (current.count(target->first))
+              {
+                ++target;
+                continue;
+              }
+              for (auto &view : target->second.views)
+                this->Release(view);
+              target = this->targets.erase(target);
+            }
+          }
+
+  /// \brief Scene manager.
+  public: Ogre::SceneManager *manager = nullptr;
+
+  /// \brief Name of the cache textures.
+  public: std::string name;
+
+  /// \brief Camera that renders the caches.
+  public: Ogre::Camera *camera = nullptr;
+
+  /// \brief Static visuals.
+  public: std::list<ShadowMapCaster> casters;
+
+  /// \brief Shadow textures rendered.
+  public: std::map<Ogre::RenderTarget *, ShadowMapTarget> targets;
+
+  /// \brief Incremented when the static casters change.
+  public: unsigned int epoch = 1;
+
+  /// \brief Frame of the last shadow texture render.
+  public: unsigned long frame = 0;
+
+  /// \brief Number of cache textures created.
+  public: unsigned int textureCount = 0;
+
+  /// \brief Number of shadow texture renders that used a cache.
+  public: uint64_t hits = 0;
+
+  /// \brief Viewport of the shadow texture being rendered, if a cache must
+  /// be copied into it.
+  public: Ogre::Viewport *restoreViewport = nullptr;
+
+  /// \brief Pass that copies a cache into a shadow texture.
+  public: Ogre::Pass *restorePass = nullptr;
+
+  /// \brief True if the restore material is not available.
+  public: bool restoreFailed = false;
+
+  /// \brief Fullscreen quad drawn with the restore pass.
+  public: std::unique_ptr<Ogre::Rectangle2D> quad;
+};
+
+/////////////////////////////////////////////////
+ShadowMapCache::ShadowMapCache(Ogre::SceneManager *_manager,
+    const std::string &_name)
+  : dataPtr(new ShadowMapCachePrivate)
+{
+  this->dataPtr->manager = _manager;
+  this->dataPtr->name = _name;
+  this->dataPtr->camera = _manager->createCamera(_name + "_camera");
+  _manager->addListener(this->dataPtr.get());
+  _manager->addRenderQueueListener(this->dataPtr.get());
+}
+
+/////////////////////////////////////////////////
+ShadowMapCache::~ShadowMapCache()
+{
+  this->Clear();
+  this->dataPtr->manager->removeRenderQueueListener(this->dataPtr.get());
+  this->dataPtr->manager->removeListener(this->dataPtr.get());
+  this->dataPtr->manager->destroyCamera(this->dataPtr->camera);
+}
+
+/////////////////////////////////////////////////
+void ShadowMapCache::AddCaster(VisualPtr _visual)
+{
+  Ogre::SceneNode *node = _visual ? _visual->GetSceneNode() : nullptr;
+  if (!node)
+    return;
+
+  ShadowMapCaster caster;
+  caster.visual = _visual;
+  caster.transform = node->_getFullTransform();
+  this->dataPtr->Mark(caster, node);
+  this->dataPtr->casters.push_back(caster);
+  ++this->dataPtr->epoch;
+}
+
+/////////////////////////////////////////////////
+bool ShadowMapCache::RemoveCaster(VisualPtr _visual)
+{
+  if (!_visual)
+    return false;
+
+  bool removed = false;
+  for (auto caster = this->dataPtr->casters.begin();
+       caster != this->dataPtr->casters.end();)
+  {
+    VisualPtr visual = caster->visual.lock();
+    if (visual && visual != _visual && !_visual->IsAncestorOf(visual))
+    {
+      ++caster;
+      continue;
+    }
+
+    this->dataPtr->Unmark(*caster);
+    caster = this->dataPtr->casters.erase(caster);
+    removed = true;
+  }
+
+  if (removed)
+    ++this->dataPtr->epoch;
+  return removed;
+}
+
+/////////////////////////////////////////////////
+void ShadowMapCache::Invalidate()
+{
+  ++this->dataPtr->epoch;
+}
+
+/////////////////////////////////////////////////
+void ShadowMapCache::Clear()
+{
+  for (auto const &caster : this->dataPtr->casters)
+    this->dataPtr->Unmark(caster);
+  this->dataPtr->casters.clear();
+
+  // Shadow textures that still exist render everything again
+  for (size_t i = 0; i < this->dataPtr->manager->getShadowTextureCount(); ++i)
+  {
+    Ogre::TexturePtr texture = this->dataPtr->manager->getShadowTexture(i);
+    if (texture.isNull())
+      continue;
+
+    auto target = this->dataPtr->targets.find(
+        texture->getBuffer()->getRenderTarget());
+    if (target == this->dataPtr->targets.end())
+      continue;
+
+    Ogre::Viewport *viewport = target->first->getViewport(0);
+    viewport->setClearEveryFrame(true, Ogre::FBT_COLOUR | Ogre::FBT_DEPTH);
+    viewport->setVisibilityMask(target->second.mask);
+  }
+
+  for (auto &target : this->dataPtr->targets)
+  {
+    for (auto &view : target.second.views)
+      this->dataPtr->Release(view);
+  }
+  this->dataPtr->targets.clear();
+  this->dataPtr->restoreViewport = nullptr;
+  ++this->dataPtr->epoch;
+}
+
+/////////////////////////////////////////////////
+size_t ShadowMapCache::CasterCount() const
+{
+  return this->dataPtr->casters.size();
+}
+
+/////////////////////////////////////////////////
+size_t ShadowMapCache::TextureCount() const
+{
+  size_t count = 0;
+  for (auto const &target : this->dataPtr->targets)
+  {
+    for (auto const &view : target.second.views)
+      count += view.texture.isNull() ? 0u : 1u;
+  }
+  return count;
+}
+
+/////////////////////////////////////////////////
+uint64_t ShadowMapCache::HitCount() const
+{
+  return this->dataPtr->hits;
+}
@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_RENDERING_SHADOWMAPCACHE_HH_
+#define GAZEBO_RENDERING_SHADOWMAPCACHE_HH_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "gazebo/rendering/RenderTypes.hh"
+#include "gazebo/util/system.hh"
+
+namespace Ogre
+{
+  class SceneManager;
+}
+
+namespace gazebo
+{
+  namespace rendering
+  {
+    // Forward declare private data class.
+    class ShadowMapCachePrivate;
+
+    /// \addtogroup gazebo_rendering
+    /// \{
+
+    /// \class ShadowMapCache ShadowMapCache.hh rendering/rendering.hh
+    /// \brief Caches the shadow maps of static shadow casters, so that only
+    /// the casters that may move are rendered into the shadow textures
+    /// each frame.
+    ///
+    /// The objects of the static visuals added are flagged with
+    /// GZ_VISIBILITY_SHADOW_STATIC instead of GZ_VISIBILITY_SHADOW_DYNAMIC.
+    /// When a shadow texture is rendered from the same light view in two
+    /// frames without static changes, the static casters are rendered once
+    /// into a cache texture. The next renders from that view copy the
+    /// cache, with its depth, into the shadow texture and only render the
+    /// other casters on top. The cache of a view is built again when a
+    /// static visual is added, removed, moved or hidden.
+    ///
+    /// Shadow maps depend on the view of the camera that renders them, so
+    /// views of cameras that move are not cached. Casters without any of
+    /// the dynamic visibility bits, e.g. objects only flagged with
+    /// GZ_VISIBILITY_GUI, are not rendered in cached shadow maps.
+    class GZ_RENDERING_VISIBLE ShadowMapCache
+    {
+      /// \brief Constructor.
+      /// \param[in] _manager Scene manager whose shadow textures are
+      /// cached.
+      /// \param[in] _name Name of the cache textures.
+      public: ShadowMapCache(Ogre::SceneManager *_manager,
+                  const std::string &_name);
+
+      /// \brief Destructor. Releases the cache textures and restores the
+      /// visibility flags of the static casters.
+      public: virtual ~ShadowMapCache();
+
+      /// \brief Add a static visual, with the objects attached to it. Its
+      /// child visuals must be added separately.
+      /// \param[in] _visual The visual.
+      public: void AddCaster(VisualPtr _visual);
+
+      /// \brief Stop caching the shadows of a visual and of its
+      /// descendants, e.g. because the visual moves or is removed.
+      /// \param[in] _visual The visual.
+      /// \return True if the shadows of visuals were cached.
+      public: bool RemoveCaster(VisualPtr _visual);
+
+      /// \brief Build the caches again with the next renders, e.g. after
+      /// static geometry changed in a way the cache does not detect.
+      public: void Invalidate();
+
+      /// \brief Remove all the visuals and release the cache textures.
+      public: void Clear();
+
+      /// \brief Get the number of static visuals.
+      /// \return Number of visuals.
+      public: size_t CasterCount() const;
+
+      /// \brief Get the number of cache textures.
+      /// \return Number of light views cached.
+      public: size_t TextureCount() const;
+
+      /// \brief Get the number of shadow texture renders that used a cache.
+      /// \return Number of renders since the cache was created.
+      public: uint64_t HitCount() const;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<ShadowMapCachePrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include "gazebo/rendering/ogre_gazebo.h"
+#include "gazebo/rendering/RenderingIface.hh"
+#include "gazebo/rendering/Scene.hh"
+#include "gazebo/rendering/ShadowMapCache.hh"
+#include "gazebo/rendering/Visual.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+class ShadowMapCache_TEST : public RenderingFixture
+{
+};
+
+/////////////////////////////////////////////////
+/// \brief Get the visibility flags of the entity of a box visual.
+/// \param[in] _visual The visual.
+/// \return Flags of the first object attached to the visual.
+static uint32_t EntityFlags(rendering::VisualPtr _visual)
+{
+  return _visual->GetSceneNode()->getAttachedObject(0)->getVisibilityFlags();
+}
+
+/////////////////////////////////////////////////
+TEST_F(ShadowMapCache_TEST, AddRemove)
+{
+  Load("worlds/empty.world");
+
+  gazebo::rendering::ScenePtr scene = gazebo::rendering::get_scene();
+  ASSERT_NE(scene, nullptr);
+
+  // Disabled by default
+  EXPECT_FALSE(scene->ShadowCaching());
+  scene->SetShadowCaching(true);
+  EXPECT_TRUE(scene->ShadowCaching());
+  scene->SetShadowCaching(false);
+
+  // Two boxes of a model, and a box of another model
+  rendering::VisualPtr model1(
+      new rendering::Visual("model1", scene->WorldVisual()));
+  model1->Load();
+  rendering::VisualPtr box1(new rendering::Visual("model1::box1", model1));
+  box1->Load();
+  box1->AttachMesh("unit_box");
+  rendering::VisualPtr box2(new rendering::Visual("model1::box2", model1));
+  box2->Load();
+  box2->AttachMesh("unit_box");
+
+  rendering::VisualPtr model2(
+      new rendering::Visual("model2", scene->WorldVisual()));
+  model2->Load();
+  rendering::VisualPtr box3(new rendering::Visual("model2::box3", model2));
+  box3->Load();
+  box3->AttachMesh("unit_box");
+
+  const uint32_t flags = EntityFlags(box1);
+  EXPECT_NE(0u, flags & GZ_VISIBILITY_SHADOW_DYNAMIC);
+  EXPECT_EQ(0u, flags & GZ_VISIBILITY_SHADOW_STATIC);
+
+  {
+    rendering::ShadowMapCache cache(scene->OgreSceneManager(), "test_cache");
+    EXPECT_EQ(0u, cache.CasterCount());
+    EXPECT_EQ(0u, cache.TextureCount());
+    EXPECT_EQ(0u, cache.HitCount());
+
+    cache.AddCaster(box1);
+    cache.AddCaster(box2);
+    cache.AddCaster(box3);
+    EXPECT_EQ(3u, cache.CasterCount());
+
+    // Static casters are only rendered by the cache, but are still seen by
+    // the cameras and the selection buffer
+    for (auto const &box : {box1, box2, box3})
+    {
+      const uint32_t staticFlags = EntityFlags(box);
+      EXPECT_EQ(0u, staticFlags & GZ_VISIBILITY_SHADOW_DYNAMIC);
+      EXPECT_NE(0u, staticFlags & GZ_VISIBILITY_SHADOW_STATIC);
+      EXPECT_NE(0u, staticFlags & GZ_VISIBILITY_SELECTABLE);
+      EXPECT_NE(0u, staticFlags & (GZ_VISIBILITY_ALL &
+            ~(GZ_VISIBILITY_GUI | GZ_VISIBILITY_SELECTABLE)));
+    }
+
+    // Removing a model removes its visuals, and restores their flags
+    EXPECT_TRUE(cache.RemoveCaster(model1));
+    EXPECT_EQ(1u, cache.CasterCount());
+    EXPECT_EQ(flags, EntityFlags(box1));
+    EXPECT_EQ(flags, EntityFlags(box2));
+    EXPECT_NE(flags, EntityFlags(box3));
+    EXPECT_FALSE(cache.RemoveCaster(model1));
+
+    cache.AddCaster(box1);
+    EXPECT_EQ(2u, cache.CasterCount());
+    cache.Clear();
+    EXPECT_EQ(0u, cache.CasterCount());
+    EXPECT_EQ(flags, EntityFlags(box1));
+    EXPECT_EQ(flags, EntityFlags(box3));
+
+    cache.AddCaster(box3);
+  }
+
+  // The destructor restores the flags too
+  EXPECT_EQ(flags, EntityFlags(box3));
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,272 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <chrono>
+#include <map>
+#include <sstream>
+#include <vector>
+
+#include "gazebo/rendering/ogre_gazebo.h"
+#include "gazebo/rendering/StaticBatch.hh"
+#include "gazebo/rendering/Visual.hh"
+
+using namespace gazebo;
+using namespace rendering;
+
+/// \brief Time without changes after which the batches are built again.
+static const std::chrono::duration<double> kQuietTime(1.0);
+
+/// \brief Size of the regions of the batches, in meters. Regions outside
+/// the view are culled as a whole.
+static const Ogre::Real kRegionSize = 50.0;
+
+/////////////////////////////////////////////////
+/// \brief Describe how a material renders. Visuals clone their materials,
+/// so identical looking visuals have different materials, which would each
+/// need their own batch.
+/// \param[in] _material The material.
+/// \return A string equal for materials that render the same.
+static std::string MaterialKey(const Ogre::MaterialPtr &_material)
+{
+  std::ostringstream key;
+  for (unsigned int t = 0; t < _material->getNumTechniques(); ++t)
+  {
+    Ogre::Technique *technique = _material->getTechnique(t);
+    key << technique->getSchemeName() << "{";
+    for (unsigned int p = 0; p < technique->getNumPasses(); ++p)
+    {
+      Ogre::Pass *pass = technique->getPass(p);
+      key << pass->getAmbient() << pass->getDiffuse() << pass->getSpecular()
+          << pass->getSelfIllumination() << pass->getShininess() << ","
+          << pass->getSourceBlendFactor() << pass->getDestBlendFactor()
+          << pass->getDepthWriteEnabled() << pass->getDepthCheckEnabled()
+          << pass->getLightingEnabled() << pass->getPolygonMode()
+          << pass->getCullingMode();
+      if (pass->hasVertexProgram())
+        key << "v" << pass->getVertexProgramName();
+      if (pass->hasFragmentProgram())
+        key << "f" << pass->getFragmentProgramName();
+      for (unsigned int u = 0; u < pass->getNumTextureUnitStates(); ++u)
+        key << "t" << pass->getTextureUnitState(u)->getTextureName();
+      key << ";";
+    }
+    key << "}";
+  }
+  return key.str();
+}
+
+/// \brief Private data for the StaticBatch class.
+class gazebo::rendering::StaticBatchPrivate
+{
+  /// \brief Show the entities hidden by the batches, and destroy them.
+  public: void Destroy()
+          {
+            for (auto const &name : this->entities)
+            {
+              if (this->manager->hasEntity(name))
+                this->manager->getEntity(name)->setVisible(true);
+            }
+            this->entities.clear();
+
+            if (this->geometry)
+            {
+              this->manager->destroyStaticGeometry(this->geometry);
+              this->geometry = nullptr;
+            }
+          }
+
+  /// \brief Scene manager.
+  public: Ogre::SceneManager *manager = nullptr;
+
+  /// \brief Name of the batches.
+  public: std::string name;
+
+  /// \brief The batches, null when they are not built.
+  public: Ogre::StaticGeometry *geometry = nullptr;
+
+  /// \brief Visuals to batch, by id of their root visual.
+  public: std::map<uint32_t, std::vector<VisualWeakPtr>> models;
+
+  /// \brief Names of the entities in the batches, which are hidden.
+  public: std::vector<std::string> entities;
+
+  /// \brief True if the visuals changed since the batches were built.
+  public: bool dirty = false;
+
+  /// \brief Time of the last change.
+  public: std::chrono::steady_clock::time_point changeTime;
+};
+
+/////////////////////////////////////////////////
+StaticBatch::StaticBatch(Ogre::SceneManager *_manager,
+    const std::string &_name)
+  : dataPtr(new StaticBatchPrivate)
+{
+  this->dataPtr->manager = _manager;
+  this->dataPtr->name = _name;
+}
+
+/////////////////////////////////////////////////
+StaticBatch::~StaticBatch()
+{
+  this->Clear();
+}
+
+/////////////////////////////////////////////////
+void StaticBatch::Add(VisualPtr _visual)
+{
+  if (!_visual)
+    return;
+
+  VisualPtr root = _visual->GetRootVisual();
+  const uint32_t rootId = root ? root->GetId() : _visual->GetId();
+  this->dataPtr->models[rootId].push_back(_visual);
+  this->dataPtr->dirty = true;
+  this->dataPtr->changeTime = std::chrono::steady_clock::now();
+}
+
+/////////////////////////////////////////////////
+bool StaticBatch::Remove(VisualPtr _visual)
+{
+  if (!_visual || this->dataPtr->models.empty())
+    return false;
+
+  VisualPtr root = _visual->GetRootVisual();
+  const uint32_t rootId = root ? root->GetId() : _visual->GetId();
+  if (this->dataPtr->models.erase(rootId) == 0u)
+    return false;
+
+  // The other visuals are drawn from their own entities until the next
+  // build, a batch can't be partly removed
+  this->dataPtr->Destroy();
+  this->dataPtr->dirty = true;
+  this->dataPtr->changeTime = std::chrono::steady_clock::now();
+  return true;
+}
+
+/////////////////////////////////////////////////
+void StaticBatch::Update(const bool _force)
+{
+  if (!this->dataPtr->dirty)
+    return;
+
+  if (!_force && std::chrono::steady_clock::now() -
+      this->dataPtr->changeTime < kQuietTime)
+  {
+    return;
+  }
+
+  this->dataPtr->Destroy();
+  this->dataPtr->dirty = false;
+
+  Ogre::StaticGeometry *geometry = nullptr;
+  std::map<std::string, Ogre::MaterialPtr> sharedMaterials;
+  for (auto model = this->dataPtr->models.begin();
+       model != this->dataPtr->models.end();)
+  {
+    for (auto const &weak : model->second)
+    {
+      VisualPtr visual = weak.lock();
+      if (!visual || !visual->GetVisible())
+        continue;
+
+      Ogre::SceneNode *node = visual->GetSceneNode();
+      for (unsigned int i = 0; i < node->numAttachedObjects(); ++i)
+      {
+        Ogre::Entity *entity =
+          dynamic_cast<Ogre::Entity *>(node->getAttachedObject(i));
+        if (!entity || !entity->isVisible() || entity->hasSkeleton())
+          continue;
+
+        if (!geometry)
+        {
+          geometry = this->dataPtr->manager->createStaticGeometry(
+              this->dataPtr->name);
+          geometry->setRegionDimensions(
+              Ogre::Vector3(kRegionSize, kRegionSize, kRegionSize));
+          geometry->setCastShadows(true);
+        }
+
+        // Identical materials are shared while the entity is queued, the
+        // batches keep the material of the first entity
+        std::vector<Ogre::MaterialPtr> materials;
+        for (unsigned int j = 0; j < entity->getNumSubEntities(); ++j)
+        {
+          Ogre::SubEntity *subEntity = entity->getSubEntity(j);
+          materials.push_back(subEntity->getMaterial());
+          if (materials.back().isNull())
+            continue;
+          auto shared = sharedMaterials.insert(std::make_pair(
+                MaterialKey(materials.back()), materials.back())).first;
+          subEntity->setMaterial(shared->second);
+        }
+
+        geometry->addEntity(entity, node->_getDerivedPosition(),
+            node->_getDerivedOrientation(), node->_getDerivedScale());
+
+        for (unsigned int j = 0; j < entity->getNumSubEntities(); ++j)
+        {
+          if (!materials[j].isNull())
+            entity->getSubEntity(j)->setMaterial(materials[j]);
+        }
+        this->dataPtr->entities.push_back(entity->getName());
+      }
+    }
+
+    // Models whose visuals were all destroyed are forgotten
+    bool alive = false;
+    for (auto const &weak : model->second)
+      alive = alive || !weak.expired();
+    if (alive)
+      ++model;
+    else
+      model = this->dataPtr->models.erase(model);
+  }
+
+  if (!geometry)
+    return;
+
+  geometry->build();
+  this->dataPtr->geometry = geometry;
+
+  // Prevent double rendering
+  for (auto const &name : this->dataPtr->entities)
+    this->dataPtr->manager->getEntity(name)->setVisible(false);
+}
+
+/////////////////////////////////////////////////
+void StaticBatch::Clear()
+{
+  this->dataPtr->Destroy();
+  this->dataPtr->models.clear();
+  this->dataPtr->dirty = false;
+}
+
+/////////////////////////////////////////////////
+size_t StaticBatch::VisualCount() const
+{
+  size_t count = 0;
+  for (auto const &model : this->dataPtr->models)
+    count += model.second.size();
+  return count;
+}
+
+/////////////////////////////////////////////////
+size_t StaticBatch::EntityCount() const
+{
+  return this->dataPtr->entities.size();
+}
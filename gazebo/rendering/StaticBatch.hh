@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_RENDERING_STATICBATCH_HH_
+#define GAZEBO_RENDERING_STATICBATCH_HH_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "gazebo/rendering/RenderTypes.hh"
+#include "gazebo/util/system.hh"
+
+namespace Ogre
+{
+  class SceneManager;
+}
+
+namespace gazebo
+{
+  namespace rendering
+  {
+    // Forward declare private data class.
+    class StaticBatchPrivate;
+
+    /// \addtogroup gazebo_rendering
+    /// \{
+
+    /// \class StaticBatch StaticBatch.hh rendering/rendering.hh
+    /// \brief Merges the meshes of visuals that do not move into a few
+    /// Ogre static geometry batches, so that thousands of static objects
+    /// are drawn with one draw call per material and region.
+    ///
+    /// The visuals keep their entities, hidden while they are batched, so
+    /// that selection and the Visual API still work. A batched visual that
+    /// changes must be removed with Remove, which draws its model from its
+    /// own entities again. The batches are built again once the visuals
+    /// stop changing.
+    class GZ_RENDERING_VISIBLE StaticBatch
+    {
+      /// \brief Constructor.
+      /// \param[in] _manager Scene manager to create the batches with.
+      /// \param[in] _name Name of the batches.
+      public: StaticBatch(Ogre::SceneManager *_manager,
+                  const std::string &_name);
+
+      /// \brief Destructor. Destroys the batches and shows the entities of
+      /// the visuals again.
+      public: virtual ~StaticBatch();
+
+      /// \brief Add a visual to batch, with the entities attached to it.
+      /// Its child visuals must be added separately.
+      /// \param[in] _visual The visual.
+      public: void Add(VisualPtr _visual);
+
+      /// \brief Stop batching the visuals of the model of a visual, e.g.
+      /// because the visual moves or is removed. The batches are destroyed
+      /// until the next Update that builds them.
+      /// \param[in] _visual The visual.
+      /// \return True if visuals were batched with the model.
+      public: bool Remove(VisualPtr _visual);
+
+      /// \brief Build the batches, if visuals changed and no visual was
+      /// added or removed for some time.
+      /// \param[in] _force True to build the batches at once.
+      public: void Update(const bool _force = false);
+
+      /// \brief Destroy the batches and remove all the visuals.
+      public: void Clear();
+
+      /// \brief Get the number of visuals to batch.
+      /// \return Number of visuals.
+      public: size_t VisualCount() const;
+
+      /// \brief Get the number of entities in the batches.
+      /// \return Number of entities, 0 if the batches are not built.
+      public: size_t EntityCount() const;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<StaticBatchPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
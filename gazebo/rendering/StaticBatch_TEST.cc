@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include "gazebo/rendering/ogre_gazebo.h"
+#include "gazebo/rendering/RenderingIface.hh"
+#include "gazebo/rendering/Scene.hh"
+#include "gazebo/rendering/StaticBatch.hh"
+#include "gazebo/rendering/Visual.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+class StaticBatch_TEST : public RenderingFixture
+{
+};
+
+/////////////////////////////////////////////////
+TEST_F(StaticBatch_TEST, AddRemove)
+{
+  Load("worlds/empty.world");
+
+  gazebo::rendering::ScenePtr scene = gazebo::rendering::get_scene();
+  ASSERT_NE(scene, nullptr);
+
+  // Disabled by default
+  EXPECT_FALSE(scene->StaticBatching());
+  scene->SetStaticBatching(true);
+  EXPECT_TRUE(scene->StaticBatching());
+  scene->SetStaticBatching(false);
+
+  // Two boxes of a model, and a box of another model
+  rendering::VisualPtr model1(
+      new rendering::Visual("model1", scene->WorldVisual()));
+  model1->Load();
+  rendering::VisualPtr box1(new rendering::Visual("model1::box1", model1));
+  box1->Load();
+  box1->AttachMesh("unit_box");
+  box1->SetMaterial("Gazebo/Red");
+  rendering::VisualPtr box2(new rendering::Visual("model1::box2", model1));
+  box2->Load();
+  box2->AttachMesh("unit_box");
+  box2->SetMaterial("Gazebo/Red");
+  box2->SetPosition(ignition::math::Vector3d(2, 0, 0));
+
+  rendering::VisualPtr model2(
+      new rendering::Visual("model2", scene->WorldVisual()));
+  model2->Load();
+  rendering::VisualPtr box3(new rendering::Visual("model2::box3", model2));
+  box3->Load();
+  box3->AttachMesh("unit_box");
+  box3->SetMaterial("Gazebo/Green");
+
+  rendering::StaticBatch batch(scene->OgreSceneManager(), "test_batch");
+  EXPECT_EQ(0u, batch.VisualCount());
+  batch.Add(box1);
+  batch.Add(box2);
+  batch.Add(box3);
+  EXPECT_EQ(3u, batch.VisualCount());
+
+  // The batches are built once the visuals stop changing
+  batch.Update();
+  EXPECT_EQ(0u, batch.EntityCount());
+  batch.Update(true);
+  EXPECT_EQ(3u, batch.EntityCount());
+  EXPECT_TRUE(scene->OgreSceneManager()->hasStaticGeometry("test_batch"));
+
+  // The entities are hidden while they are batched
+  Ogre::Entity *entity = dynamic_cast<Ogre::Entity *>(
+      box1->GetSceneNode()->getAttachedObject(0));
+  ASSERT_NE(entity, nullptr);
+  EXPECT_FALSE(entity->isVisible());
+
+  // Removing a visual removes its model, and shows the entities again
+  EXPECT_FALSE(batch.Remove(model1->GetParent()));
+  EXPECT_TRUE(batch.Remove(box2));
+  EXPECT_EQ(1u, batch.VisualCount());
+  EXPECT_EQ(0u, batch.EntityCount());
+  EXPECT_TRUE(entity->isVisible());
+  EXPECT_FALSE(scene->OgreSceneManager()->hasStaticGeometry("test_batch"));
+
+  batch.Update(true);
+  EXPECT_EQ(1u, batch.EntityCount());
+
+  batch.Clear();
+  EXPECT_EQ(0u, batch.VisualCount());
+  EXPECT_EQ(0u, batch.EntityCount());
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,430 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include "gazebo/common/CommonIface.hh"
+#include "gazebo/common/Console.hh"
+#include "gazebo/common/Image.hh"
+#include "gazebo/rendering/TextureCache.hh"
+
+using namespace gazebo;
+using namespace rendering;
+
+/// \brief Version of the cache format, part of the key of the files.
+static const char kCacheVersion[] = "1";
+
+/// \brief DDS header flags: caps, height, width, pixel format, mipmap
+/// count and linear size.
+static const uint32_t kDdsFlags =
+  0x1 | 0x2 | 0x4 | 0x1000 | 0x20000 | 0x80000;
+
+/// \brief DDS caps: texture, complex and mipmap.
+static const uint32_t kDdsCaps = 0x1000 | 0x8 | 0x400000;
+
+/// \brief DDS pixel format flag of a FourCC code.
+static const uint32_t kDdsFourCC = 0x4;
+
+/////////////////////////////////////////////////
+/// \brief Append a little endian 32 bit value.
+/// \param[in,out] _out Buffer.
+/// \param[in] _value The value.
+static void PutU32(std::string &_out, const uint32_t _value)
+{
+  for (int i = 0; i < 4; ++i)
+    _out.push_back(static_cast<char>((_value >> (8 * i)) & 0xff));
+}
+
+/////////////////////////////////////////////////
+/// \brief Append a little endian 16 bit value.
+/// \param[in,out] _out Buffer.
+/// \param[in] _value The value.
+static void PutU16(std::string &_out, const uint16_t _value)
+{
+  _out.push_back(static_cast<char>(_value & 0xff));
+  _out.push_back(static_cast<char>(_value >> 8));
+}
+
+/////////////////////////////////////////////////
+/// \brief Pack a color in 5:6:5 bits.
+/// \param[in] _c RGB color.
+/// \return The packed color.
+static uint16_t Pack565(const int *_c)
+{
+  return static_cast<uint16_t>(((_c[0] >> 3) << 11) | ((_c[1] >> 2) << 5) |
+      (_c[2] >> 3));
+}
+
+/////////////////////////////////////////////////
+/// \brief Unpack a 5:6:5 color to 8 bit channels, as the GPU does.
+/// \param[in] _packed The packed color.
+/// \param[out] _c RGB color.
+static void Unpack565(const uint16_t _packed, int *_c)
+{
+  const int r = (_packed >> 11) & 0x1f;
+  const int g = (_packed >> 5) & 0x3f;
+  const int b = _packed & 0x1f;
+  _c[0] = (r << 3) | (r >> 2);
+  _c[1] = (g << 2) | (g >> 4);
+  _c[2] = (b << 3) | (b >> 2);
+}
+
+/////////////////////////////////////////////////
+/// \brief Encode the colors of a 4x4 block in BC1, from the corners of
+/// their bounding box.
+/// \param[in] _block 16 RGBA pixels.
+/// \param[in,out] _out Buffer the 8 bytes of the block are appended to.
+static void EncodeColorBlock(const unsigned char *_block, std::string &_out)
+{
+  int lo[3] = {255, 255, 255};
+  int hi[3] = {0, 0, 0};
+  for (int i = 0; i < 16; ++i)
+  {
+    for (int c = 0; c < 3; ++c)
+    {
+      lo[c] = std::min(lo[c], static_cast<int>(_block[i * 4 + c]));
+      hi[c] = std::max(hi[c], static_cast<int>(_block[i * 4 + c]));
+    }
+  }
+
+  // Inset the box a little, the endpoints are rarely the best colors
+  for (int c = 0; c < 3; ++c)
+  {
+    const int inset = (hi[c] - lo[c]) >> 4;
+    lo[c] += inset;
+    hi[c] -= inset;
+  }
+
+  uint16_t c0 = Pack565(hi);
+  uint16_t c1 = Pack565(lo);
+  // The first color must be the greater, or BC1 switches to the three
+  // color mode.
+  if (c0 < c1)
+    std::swap(c0, c1);
+
+  int palette[4][3];
+  Unpack565(c0, palette[0]);
+  Unpack565(c1, palette[1]);
+  for (int c = 0; c < 3; ++c)
+  {
+    palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+    palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+  }
+
+  uint32_t indices = 0;
+  if (c0 != c1)
+  {
+    for (int i = 0; i < 16; ++i)
+    {
+      int best = 0;
+      int bestDist = 0;
+      for (int p = 0; p < 4; ++p)
+      {
+        int dist = 0;
+        for (int c = 0; c < 3; ++c)
+        {
+          const int d = static_cast<int>(_block[i * 4 + c]) - palette[p][c];
+          dist += d * d;
+        }
+        if (p == 0 || dist < bestDist)
+        {
+          best = p;
+          bestDist = dist;
+        }
+      }
+      indices |= static_cast<uint32_t>(best) << (2 * i);
+    }
+  }
+
+  PutU16(_out, c0);
+  PutU16(_out, c1);
+  PutU32(_out, indices);
+}
+
+/////////////////////////////////////////////////
+/// \brief Encode the alpha of a 4x4 block as in BC3, with eight
+/// interpolated values.
+/// \param[in] _block 16 RGBA pixels.
+/// \param[in,out] _out Buffer the 8 bytes of the block are appended to.
+static void EncodeAlphaBlock(const unsigned char *_block, std::string &_out)
+{
+  int a0 = 0;
+  int a1 = 255;
+  for (int i = 0; i < 16; ++i)
+  {
+    a0 = std::max(a0, static_cast<int>(_block[i * 4 + 3]));
+    a1 = std::min(a1, static_cast<int>(_block[i * 4 + 3]));
+  }
+
+  int palette[8] = {a0, a1, 0, 0, 0, 0, 0, 0};
+  for (int p = 1; p < 7; ++p)
+    palette[p + 1] = ((7 - p) * a0 + p * a1 + 3) / 7;
+
+  uint64_t indices = 0;
+  if (a0 != a1)
+  {
+    for (int i = 0; i < 16; ++i)
+    {
+      const int alpha = _block[i * 4 + 3];
+      int best = 0;
+      for (int p = 1; p < 8; ++p)
+      {
+        if (std::abs(alpha - palette[p]) < std::abs(alpha - palette[best]))
+          best = p;
+      }
+      indices |= static_cast<uint64_t>(best) << (3 * i);
+    }
+  }
+
+  _out.push_back(static_cast<char>(a0));
+  _out.push_back(static_cast<char>(a1));
+  for (int i = 0; i < 6; ++i)
+    _out.push_back(static_cast<char>((indices >> (8 * i)) & 0xff));
+}
+
+/// \brief Private data for the TextureCache class.
+class gazebo::rendering::TextureCachePrivate
+{
+  /// \brief Directory of the cache, empty if disabled.
+  public: std::string path;
+
+  /// \brief Compressed file of each texture file seen by the process,
+  /// empty for the files that can't be compressed.
+  public: std::map<std::string, std::string> textures;
+
+  /// \brief Protects the members.
+  public: std::mutex mutex;
+};
+
+/////////////////////////////////////////////////
+TextureCache::TextureCache()
+  : dataPtr(new TextureCachePrivate)
+{
+}
+
+/////////////////////////////////////////////////
+TextureCache::~TextureCache()
+{
+}
+
+/////////////////////////////////////////////////
+void TextureCache::SetPath(const std::string &_path)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->path = _path;
+  this->dataPtr->textures.clear();
+}
+
+/////////////////////////////////////////////////
+std::string TextureCache::Path() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->path;
+}
+
+/////////////////////////////////////////////////
+std::string TextureCache::Texture(const std::string &_filename)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (this->dataPtr->path.empty() || _filename.empty())
+    return std::string();
+
+  auto known = this->dataPtr->textures.find(_filename);
+  if (known != this->dataPtr->textures.end())
+    return known->second;
+  std::string &result = this->dataPtr->textures[_filename];
+
+  std::string filename = _filename;
+  if (!boost::filesystem::exists(filename))
+    filename = common::find_file(_filename);
+
+  std::string content;
+  {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file)
+      return result;
+    content.assign(std::istreambuf_iterator<char>(file),
+        std::istreambuf_iterator<char>());
+  }
+
+  const std::string key = common::get_sha1<std::string>(
+      std::string(kCacheVersion) + "\n" +
+      common::get_sha1<std::string>(content));
+  const boost::filesystem::path path =
+    boost::filesystem::path(this->dataPtr->path) / (key + ".dds");
+  if (boost::filesystem::exists(path))
+  {
+    result = path.string();
+    return result;
+  }
+
+  common::Image image;
+  if (image.Load(filename) != 0 || !image.Valid())
+    return result;
+
+  // Only 8 bit color images are compressed
+  const common::Image::PixelFormat format = image.GetPixelFormat();
+  if (format != common::Image::RGB_INT8 &&
+      format != common::Image::BGR_INT8 &&
+      format != common::Image::RGBA_INT8 &&
+      format != common::Image::BGRA_INT8)
+  {
+    return result;
+  }
+
+  const unsigned int width = image.GetWidth();
+  const unsigned int height = image.GetHeight();
+  const size_t count = static_cast<size_t>(width) * height;
+  std::vector<unsigned char> data(count * 4);
+  std::vector<unsigned char> pixels(count * 4);
+  if (!image.Data(data.data(), data.size()) ||
+      !common::Image::ConvertPixels(data.data(), format, pixels.data(),
+        common::Image::RGBA_INT8, count))
+  {
+    return result;
+  }
+
+  std::string dds;
+  if (!Compress(pixels.data(), width, height, dds))
+    return result;
+
+  boost::system::error_code ec;
+  boost::filesystem::create_directories(path.parent_path(), ec);
+
+  // Write to a temporary file first, other processes may read the cache.
+  const std::string tmpFilename = path.string() + ".tmp" +
+    boost::filesystem::unique_path("%%%%%%%%").string();
+  {
+    std::ofstream file(tmpFilename, std::ios::binary | std::ios::trunc);
+    file.write(dds.data(), dds.size());
+    if (!file)
+    {
+      gzwarn << "Unable to write texture cache file[" << path.string()
+             << "]\n";
+      file.close();
+      boost::filesystem::remove(tmpFilename, ec);
+      return result;
+    }
+  }
+
+  boost::filesystem::rename(tmpFilename, path, ec);
+  if (ec)
+  {
+    boost::filesystem::remove(tmpFilename, ec);
+    return result;
+  }
+
+  result = path.string();
+  return result;
+}
+
+/////////////////////////////////////////////////
+bool TextureCache::Compress(const unsigned char *_pixels,
+    const unsigned int _width, const unsigned int _height, std::string &_dds)
+{
+  if (!_pixels || _width == 0 || _height == 0)
+    return false;
+
+  const size_t count = static_cast<size_t>(_width) * _height;
+  bool alpha = false;
+  for (size_t i = 0; i < count && !alpha; ++i)
+    alpha = _pixels[i * 4 + 3] != 255;
+
+  uint32_t levels = 1;
+  for (unsigned int size = std::max(_width, _height); size > 1; size /= 2)
+    ++levels;
+
+  const uint32_t blockSize = alpha ? 16 : 8;
+  const uint32_t blocksX = (_width + 3) / 4;
+  const uint32_t blocksY = (_height + 3) / 4;
+
+  _dds.clear();
+  _dds.append("DDS ");
+  PutU32(_dds, 124);
+  PutU32(_dds, kDdsFlags);
+  PutU32(_dds, _height);
+  PutU32(_dds, _width);
+  PutU32(_dds, blocksX * blocksY * blockSize);
+  PutU32(_dds, 0);
+  PutU32(_dds, levels);
+  for (int i = 0; i < 11; ++i)
+    PutU32(_dds, 0);
+
+  // Pixel format
+  PutU32(_dds, 32);
+  PutU32(_dds, kDdsFourCC);
+  _dds.append(alpha ? "DXT5" : "DXT1");
+  for (int i = 0; i < 5; ++i)
+    PutU32(_dds, 0);
+
+  PutU32(_dds, kDdsCaps);
+  for (int i = 0; i < 4; ++i)
+    PutU32(_dds, 0);
+
+  std::vector<unsigned char> level(_pixels, _pixels + count * 4);
+  std::vector<unsigned char> next;
+  unsigned int width = _width;
+  unsigned int height = _height;
+  unsigned char block[64];
+  for (uint32_t l = 0; l < levels; ++l)
+  {
+    for (unsigned int by = 0; by < height; by += 4)
+    {
+      for (unsigned int bx = 0; bx < width; bx += 4)
+      {
+        // Blocks that cross the edge of the image repeat its last pixels
+        for (unsigned int y = 0; y < 4; ++y)
+        {
+          const unsigned int row = std::min(by + y, height - 1);
+          for (unsigned int x = 0; x < 4; ++x)
+          {
+            const unsigned int col = std::min(bx + x, width - 1);
+            std::copy_n(&level[(static_cast<size_t>(row) * width + col) * 4],
+                4, &block[(y * 4 + x) * 4]);
+          }
+        }
+
+        if (alpha)
+          EncodeAlphaBlock(block, _dds);
+        EncodeColorBlock(block, _dds);
+      }
+    }
+
+    if (l + 1 == levels)
+      break;
+
+    const unsigned int nextWidth = std::max(1u, width / 2);
+    const unsigned int nextHeight = std::max(1u, height / 2);
+    next.resize(static_cast<size_t>(nextWidth) * nextHeight * 4);
+    common::Image::Resize(level.data(), width, height, 4, next.data(),
+        nextWidth, nextHeight, common::Image::RESIZE_BOX);
+    level.swap(next);
+    width = nextWidth;
+    height = nextHeight;
+  }
+
+  return true;
+}
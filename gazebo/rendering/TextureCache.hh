@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_RENDERING_TEXTURECACHE_HH_
+#define GAZEBO_RENDERING_TEXTURECACHE_HH_
+
+#include <memory>
+#include <string>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace rendering
+  {
+    // Forward declare private data class.
+    class TextureCachePrivate;
+
+    /// \addtogroup gazebo_rendering
+    /// \{
+
+    /// \class TextureCache TextureCache.hh rendering/rendering.hh
+    /// \brief On-disk cache of block compressed textures, so that a texture
+    /// file is only decoded, mipmapped and compressed once on a host.
+    ///
+    /// A cached texture is a DDS file holding the full mipmap chain, in
+    /// DXT1 (BC1) when the image is opaque and in DXT5 (BC3) when it has
+    /// an alpha channel. Ogre uploads such a file to the GPU as is, which
+    /// takes a quarter to an eighth of the memory of the decoded image.
+    /// Cache files are named after a hash of the content of the texture
+    /// file, so that an edited file gets a new entry; they are written to
+    /// a temporary name and then renamed, so that several processes may
+    /// share the cache. The compression is lossy, so the cache is
+    /// disabled until a path is set.
+    class GZ_RENDERING_VISIBLE TextureCache
+    {
+      /// \brief Constructor.
+      public: TextureCache();
+
+      /// \brief Destructor.
+      public: virtual ~TextureCache();
+
+      /// \brief Set the directory of the cache.
+      /// \param[in] _path Path of the directory, empty to disable the
+      /// cache. The directory is created when needed.
+      public: void SetPath(const std::string &_path);
+
+      /// \brief Get the directory of the cache.
+      /// \return Path of the directory, empty if the cache is disabled.
+      public: std::string Path() const;
+
+      /// \brief Get the compressed copy of a texture file, compressing the
+      /// file the first time it is seen on the host. The result is kept
+      /// for the rest of the process.
+      /// \param[in] _filename Path of the texture file, PNG, JPEG or BMP.
+      /// \return Full path of the DDS file, empty if the cache is disabled
+      /// or the image can't be compressed, e.g. because it has 16 bit
+      /// channels.
+      public: std::string Texture(const std::string &_filename);
+
+      /// \brief Compress an image into a DDS file with a full mipmap
+      /// chain, in DXT5 if a pixel isn't opaque and in DXT1 otherwise.
+      /// \param[in] _pixels RGBA pixels, top row first, without padding.
+      /// \param[in] _width Width of the image.
+      /// \param[in] _height Height of the image.
+      /// \param[out] _dds Content of the DDS file.
+      /// \return False if a size is zero.
+      public: static bool Compress(const unsigned char *_pixels,
+                  const unsigned int _width, const unsigned int _height,
+                  std::string &_dds);
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<TextureCachePrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
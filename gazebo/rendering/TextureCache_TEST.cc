@@ -0,0 +1,146 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include "gazebo/common/Image.hh"
+#include "gazebo/rendering/TextureCache.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class TextureCacheTest : public gazebo::testing::AutoLogFixture { };
+
+/// \brief Read a little endian 32 bit value.
+/// \param[in] _data Buffer.
+/// \param[in] _offset Offset of the value.
+/// \return The value.
+static uint32_t U32(const std::string &_data, const size_t _offset)
+{
+  uint32_t value = 0;
+  for (int i = 3; i >= 0; --i)
+    value = (value << 8) | static_cast<unsigned char>(_data[_offset + i]);
+  return value;
+}
+
+/////////////////////////////////////////////////
+TEST_F(TextureCacheTest, Compress)
+{
+  std::string dds;
+  EXPECT_FALSE(rendering::TextureCache::Compress(nullptr, 4, 4, dds));
+
+  // Opaque red image
+  std::vector<unsigned char> pixels(8 * 8 * 4);
+  for (size_t i = 0; i < 64; ++i)
+  {
+    pixels[i * 4] = 255;
+    pixels[i * 4 + 3] = 255;
+  }
+  EXPECT_FALSE(rendering::TextureCache::Compress(pixels.data(), 0, 8, dds));
+  ASSERT_TRUE(rendering::TextureCache::Compress(pixels.data(), 8, 8, dds));
+
+  // Header, then 4 + 1 + 1 + 1 blocks of 8 bytes for the 4 mipmap levels
+  ASSERT_EQ(128u + 7 * 8, dds.size());
+  EXPECT_EQ("DDS ", dds.substr(0, 4));
+  EXPECT_EQ(124u, U32(dds, 4));
+  EXPECT_EQ(8u, U32(dds, 12));
+  EXPECT_EQ(8u, U32(dds, 16));
+  EXPECT_EQ(4u * 8, U32(dds, 20));
+  EXPECT_EQ(4u, U32(dds, 28));
+  EXPECT_EQ("DXT1", dds.substr(84, 4));
+
+  // Both endpoints are pure red in 5:6:5
+  EXPECT_EQ(0xf800f800u, U32(dds, 128));
+
+  // A transparent pixel selects DXT5, with blocks of 16 bytes. Blocks on
+  // the edge of a 5x3 image are padded.
+  pixels[3] = 0;
+  ASSERT_TRUE(rendering::TextureCache::Compress(pixels.data(), 5, 3, dds));
+  ASSERT_EQ(128u + 4 * 16, dds.size());
+  EXPECT_EQ(3u, U32(dds, 28));
+  EXPECT_EQ("DXT5", dds.substr(84, 4));
+  EXPECT_EQ(255, static_cast<unsigned char>(dds[128]));
+  EXPECT_EQ(0, static_cast<unsigned char>(dds[129]));
+
+  // A gray ramp goes from the darkest endpoint to the brightest
+  for (size_t i = 0; i < 16; ++i)
+  {
+    pixels[i * 4] = pixels[i * 4 + 1] = pixels[i * 4 + 2] =
+      static_cast<unsigned char>(i * 16);
+    pixels[i * 4 + 3] = 255;
+  }
+  ASSERT_TRUE(rendering::TextureCache::Compress(pixels.data(), 4, 4, dds));
+  ASSERT_EQ(128u + 3 * 8, dds.size());
+  const uint32_t indices = U32(dds, 132);
+  EXPECT_EQ(1u, indices & 0x3);
+  EXPECT_EQ(0u, indices >> 30);
+}
+
+/////////////////////////////////////////////////
+TEST_F(TextureCacheTest, Texture)
+{
+  const boost::filesystem::path dir =
+    boost::filesystem::temp_directory_path() /
+    boost::filesystem::unique_path("gazebo_texture_cache_%%%%%%%%");
+  boost::filesystem::create_directories(dir);
+
+  std::vector<unsigned char> pixels(16 * 16 * 3, 128);
+  common::Image image;
+  image.SetFromData(pixels.data(), 16, 16, common::Image::RGB_INT8);
+  const std::string filename = (dir / "gray.png").string();
+  image.SavePNG(filename);
+
+  // Disabled by default
+  rendering::TextureCache cache;
+  EXPECT_TRUE(cache.Path().empty());
+  EXPECT_TRUE(cache.Texture(filename).empty());
+
+  const std::string cachePath = (dir / "cache").string();
+  cache.SetPath(cachePath);
+  EXPECT_EQ(cachePath, cache.Path());
+  const std::string dds = cache.Texture(filename);
+  ASSERT_FALSE(dds.empty());
+  EXPECT_TRUE(boost::filesystem::exists(dds));
+  EXPECT_EQ(".dds", boost::filesystem::path(dds).extension().string());
+  EXPECT_EQ(128u + (16 + 4 + 1 + 1 + 1) * 8,
+      boost::filesystem::file_size(dds));
+
+  // Another cache finds the file, and a missing texture isn't cached
+  rendering::TextureCache other;
+  other.SetPath(cachePath);
+  EXPECT_EQ(dds, other.Texture(filename));
+  EXPECT_TRUE(other.Texture((dir / "missing.png").string()).empty());
+
+  // A copy of the texture shares the entry
+  const std::string copy = (dir / "copy.png").string();
+  boost::filesystem::copy_file(filename, copy);
+  EXPECT_EQ(dds, other.Texture(copy));
+
+  boost::filesystem::remove_all(dir);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -14,6 +14,8 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
+#include <chrono>
 #include <boost/bind/bind.hpp>
 #include <ignition/common/Profiler.hh>
 #include <ignition/math/Color.hh>
@@ -237,6 +239,16 @@ void UserCamera::Update()
   if (this->dataPtr->viewController)
     this->dataPtr->viewController->Update();
 
+  if (this->dataPtr->frameBudget > 0)
+  {
+    const ignition::math::Pose3d pose = this->WorldPose();
+    if (pose != this->dataPtr->lastPose)
+    {
+      this->dataPtr->moveTime = std::chrono::steady_clock::now();
+      this->dataPtr->lastPose = pose;
+    }
+  }
+
   // publish camera pose
   this->dataPtr->posePub->Publish(msgs::Convert(this->WorldPose()));
 }
@@ -253,6 +265,7 @@ void UserCamera::Render(const bool /*_force*/)
   IGN_PROFILE("rendering::UserCamera::Render");
   if (this->initialized)
   {
+    this->dataPtr->renderStart = std::chrono::steady_clock::now();
     this->newData = true;
     this->RenderImpl();
   }
@@ -263,11 +276,145 @@ void UserCamera::PostRender()
 {
   IGN_PROFILE("rendering::UserCamera::PostRender");
   Camera::PostRender();
+  this->UpdateFrameBudget();
+
+  // Read back and render the selection pass of visual requests
+  if (this->dataPtr->selectionBuffer)
+    this->dataPtr->selectionBuffer->UpdateAsync();
+}
+
+//////////////////////////////////////////////////
+void UserCamera::UpdateFrameBudget()
+{
+  const double budget = this->dataPtr->frameBudget;
+  if (!(budget > 0))
+    return;
+
+  const auto now = std::chrono::steady_clock::now();
+  const double frameTime = std::chrono::duration<double>(
+      now - this->dataPtr->renderStart).count() + this->scene->PreRenderTime();
+
+  // Average a few frames, so that a single slow frame doesn't change the
+  // quality
+  if (this->dataPtr->frameTime > 0)
+  {
+    this->dataPtr->frameTime =
+        0.8 * this->dataPtr->frameTime + 0.2 * frameTime;
+  }
+  else
+  {
+    this->dataPtr->frameTime = frameTime;
+  }
+
+  // The camera is considered idle a little while after it stopped, to
+  // avoid switching the quality between mouse events
+  const bool moving =
+      now - this->dataPtr->moveTime < std::chrono::milliseconds(500);
+
+  if (moving && this->dataPtr->frameTime > budget)
+    this->SetReducedQuality(true);
+  else if (!moving)
+    this->SetReducedQuality(false);
+
+  // Skip the poses of the visuals out of view until the frames are well
+  // within the budget again
+  CameraPtr cullingCamera = this->scene->PoseCullingCamera();
+  if (!cullingCamera && this->dataPtr->frameTime > budget)
+    this->scene->SetPoseCullingCamera(this->shared_from_this());
+  else if (cullingCamera.get() == this &&
+      this->dataPtr->frameTime < 0.8 * budget)
+  {
+    this->scene->SetPoseCullingCamera(CameraPtr());
+  }
+}
+
+//////////////////////////////////////////////////
+void UserCamera::SetReducedQuality(const bool _reduced)
+{
+  if (_reduced == this->dataPtr->reducedQuality)
+    return;
+  this->dataPtr->reducedQuality = _reduced;
+
+  Ogre::CompositorManager *compMgr =
+      Ogre::CompositorManager::getSingletonPtr();
+  const bool hasChain = this->viewport && compMgr &&
+      compMgr->hasCompositorChain(this->viewport);
+
+  if (_reduced)
+  {
+    this->dataPtr->fullQualityShadows = this->ShadowsEnabled();
+    this->SetShadowsEnabled(false);
+
+    this->dataPtr->fullQualityLodBias = this->LodBias();
+    this->SetLodBias(this->dataPtr->fullQualityLodBias * 0.5);
+
+    this->dataPtr->disabledCompositors.clear();
+    if (hasChain)
+    {
+      Ogre::CompositorChain::InstanceIterator it =
+          compMgr->getCompositorChain(this->viewport)->getCompositors();
+      while (it.hasMoreElements())
+      {
+        Ogre::CompositorInstance *instance = it.getNext();
+        if (instance->getEnabled())
+        {
+          instance->setEnabled(false);
+          this->dataPtr->disabledCompositors.push_back(
+              instance->getCompositor()->getName());
+        }
+      }
+    }
+  }
+  else
+  {
+    this->SetShadowsEnabled(this->dataPtr->fullQualityShadows);
+    this->SetLodBias(this->dataPtr->fullQualityLodBias);
+
+    if (hasChain)
+    {
+      for (auto const &name : this->dataPtr->disabledCompositors)
+        compMgr->setCompositorEnabled(this->viewport, name, true);
+    }
+    this->dataPtr->disabledCompositors.clear();
+  }
+}
+
+//////////////////////////////////////////////////
+void UserCamera::SetFrameBudget(const double _seconds)
+{
+  this->dataPtr->frameBudget = std::max(_seconds, 0.0);
+  this->dataPtr->frameTime = 0.0;
+
+  if (this->dataPtr->frameBudget > 0)
+    return;
+
+  this->SetReducedQuality(false);
+  if (this->scene && this->scene->PoseCullingCamera().get() == this)
+    this->scene->SetPoseCullingCamera(CameraPtr());
+}
+
+//////////////////////////////////////////////////
+double UserCamera::FrameBudget() const
+{
+  return this->dataPtr->frameBudget;
+}
+
+//////////////////////////////////////////////////
+double UserCamera::FrameTime() const
+{
+  return this->dataPtr->frameTime;
+}
+
+//////////////////////////////////////////////////
+bool UserCamera::ReducedQuality() const
+{
+  return this->dataPtr->reducedQuality;
 }
 
 //////////////////////////////////////////////////
 void UserCamera::Fini()
 {
+  this->SetFrameBudget(0.0);
   Camera::Fini();
 }
 
@@ -792,6 +939,39 @@ VisualPtr UserCamera::Visual(const ignition::math::Vector2i &_mousePos) const
   return result;
 }
 
+//////////////////////////////////////////////////
+void UserCamera::RequestVisual(const ignition::math::Vector2i &_mousePos)
+{
+  if (!this->dataPtr->selectionBuffer)
+    return;
+
+  int ratio = static_cast<int>(this->dataPtr->devicePixelRatio);
+  this->dataPtr->selectionBuffer->RequestSelection(
+      ratio * _mousePos.X(), ratio * _mousePos.Y());
+}
+
+//////////////////////////////////////////////////
+VisualPtr UserCamera::RequestedVisual(bool &_pending) const
+{
+  VisualPtr result;
+  _pending = false;
+
+  if (!this->dataPtr->selectionBuffer)
+    return result;
+
+  _pending = this->dataPtr->selectionBuffer->AsyncPending();
+
+  Ogre::Entity *entity = this->dataPtr->selectionBuffer->AsyncSelection();
+  if (entity && !entity->getUserObjectBindings().getUserAny().isEmpty())
+  {
+    result = this->scene->GetVisual(
+        Ogre::any_cast<std::string>(
+          entity->getUserObjectBindings().getUserAny()));
+  }
+
+  return result;
+}
+
 //////////////////////////////////////////////////
 std::string UserCamera::GetViewControllerTypeString()
 {
@@ -158,6 +158,33 @@ namespace gazebo
       /// \return Point to pixel ratio
       public: double DevicePixelRatio() const;
 
+      /// \brief Set a frame time budget. While the frames take longer than
+      /// the budget and the camera moves, shadows and the compositors of
+      /// the viewport, e.g. ambient occlusion or lens flare, are disabled
+      /// and meshes switch to lower levels of detail closer to the camera.
+      /// Full quality is restored once the camera stopped moving. While the
+      /// frames take longer than the budget, the scene also skips the poses
+      /// of the visuals outside the view, see Scene::SetPoseCullingCamera.
+      /// \param[in] _seconds The budget in seconds, 0 to always render at
+      /// full quality, which is the default.
+      public: void SetFrameBudget(const double _seconds);
+
+      /// \brief Get the frame time budget.
+      /// \return The budget in seconds, 0 if there is no budget.
+      /// \sa SetFrameBudget
+      public: double FrameBudget() const;
+
+      /// \brief Get the average time of the last frames, including scene
+      /// updates, rendering and buffer swap. It is only measured while a
+      /// frame budget is set.
+      /// \return The time in seconds.
+      public: double FrameTime() const;
+
+      /// \brief Check whether the camera currently renders at reduced
+      /// quality to meet the frame budget.
+      /// \return True if quality is reduced.
+      public: bool ReducedQuality() const;
+
       // Documentation Inherited
       public: virtual void CameraToViewportRay(const int _screenx,
                   const int _screeny,
@@ -191,6 +218,20 @@ namespace gazebo
       public: VisualPtr Visual(
                   const ignition::math::Vector2i &_mousePos) const;
 
+      /// \brief Request the visual at a mouse position without waiting for
+      /// the GPU, e.g. to highlight what the mouse hovers. The result is
+      /// available after the next two frames, and requests made before a
+      /// frame replace each other.
+      /// \param[in] _mousePos 2D position of the mouse in pixels.
+      /// \sa RequestedVisual
+      public: void RequestVisual(const ignition::math::Vector2i &_mousePos);
+
+      /// \brief Get the visual found by the last request completed.
+      /// \param[out] _pending True if a newer request is not complete yet.
+      /// \return The visual, or NULL.
+      /// \sa RequestVisual
+      public: VisualPtr RequestedVisual(bool &_pending) const;
+
       /// \brief Set the point the camera should orbit around.
       /// \param[in] _pt The focal point
       public: void SetFocalPoint(const ignition::math::Vector3d &_pt);
@@ -273,6 +314,14 @@ namespace gazebo
       /// \brief Toggle whether to show the visual.
       private: void ToggleShowVisual();
 
+      /// \brief Reduce or restore the rendering quality.
+      /// \param[in] _reduced True to reduce quality.
+      /// \sa SetFrameBudget
+      private: void SetReducedQuality(const bool _reduced);
+
+      /// \brief Update the frame time and the quality after a frame.
+      private: void UpdateFrameBudget();
+
       /// \brief Set whether to show the visual.
       /// \param[in] _show True to show the visual representation for this
       /// camera. Currently disabled.
@@ -17,7 +17,9 @@
 #ifndef GAZEBO_RENDERING_USERCAMERA_PRIVATE_HH_
 #define GAZEBO_RENDERING_USERCAMERA_PRIVATE_HH_
 
+#include <chrono>
 #include <string>
+#include <vector>
 #include <ignition/math/Pose3.hh>
 
 namespace gazebo
@@ -87,6 +89,33 @@ namespace gazebo
 
       /// \brief Initial camera pose.
       public: ignition::math::Pose3d initialPose;
+
+      /// \brief Frame time budget in seconds, 0 for no budget.
+      public: double frameBudget = 0.0;
+
+      /// \brief Average time of the last frames, in seconds.
+      public: double frameTime = 0.0;
+
+      /// \brief Time the current frame started rendering.
+      public: std::chrono::steady_clock::time_point renderStart;
+
+      /// \brief Time the camera last moved.
+      public: std::chrono::steady_clock::time_point moveTime;
+
+      /// \brief Pose of the camera in the previous frame.
+      public: ignition::math::Pose3d lastPose;
+
+      /// \brief True if quality is reduced to meet the frame budget.
+      public: bool reducedQuality = false;
+
+      /// \brief Shadows setting before quality was reduced.
+      public: bool fullQualityShadows = true;
+
+      /// \brief Level of detail bias before quality was reduced.
+      public: double fullQualityLodBias = 1.0;
+
+      /// \brief Names of the compositors disabled to reduce quality.
+      public: std::vector<std::string> disabledCompositors;
     };
   }
 }
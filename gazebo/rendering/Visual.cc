@@ -14,7 +14,11 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
+#include <utility>
+
 #include <boost/bind/bind.hpp>
+#include <boost/filesystem.hpp>
 #include <boost/function.hpp>
 #include <boost/lexical_cast.hpp>
 
@@ -31,8 +35,10 @@
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Exception.hh"
 #include "gazebo/common/Mesh.hh"
+#include "gazebo/common/MeshSimplifier.hh"
 #include "gazebo/common/Plugin.hh"
 #include "gazebo/common/Skeleton.hh"
+#include "gazebo/common/SystemPaths.hh"
 
 #include "gazebo/rendering/COMVisual.hh"
 #include "gazebo/rendering/Conversions.hh"
@@ -242,7 +248,7 @@ void Visual::Fini()
 VisualPtr Visual::Clone(const std::string &_name, VisualPtr _newParent)
 {
   VisualPtr result(new Visual(_name, _newParent));
-  result->Load(this->dataPtr->sdf);
+  result->Load(this->GetSDF());
   result->SetScale(this->dataPtr->scale);
   result->SetVisibilityFlags(this->dataPtr->visibilityFlags);
   std::string visName = this->Name();
@@ -1898,19 +1904,28 @@ bool Visual::GetVisible() const
 void Visual::SetPosition(const ignition::math::Vector3d &_pos)
 {
   GZ_ASSERT(this->dataPtr->sceneNode, "Visual SceneNode is NULL");
-  this->dataPtr->sceneNode->setPosition(_pos.X(), _pos.Y(), _pos.Z());
 
-  this->dataPtr->sdf->GetElement("pose")->Set(this->Pose());
+  // Moving a node flags it and its ancestors for an update of the scene
+  // graph, skip it if the position didn't change
+  const Ogre::Vector3 pos = Conversions::Convert(_pos);
+  if (this->dataPtr->sceneNode->getPosition() == pos)
+    return;
+
+  this->dataPtr->sceneNode->setPosition(pos);
+  this->dataPtr->sdfPoseDirty = true;
 }
 
 //////////////////////////////////////////////////
 void Visual::SetRotation(const ignition::math::Quaterniond &_rot)
 {
   GZ_ASSERT(this->dataPtr->sceneNode, "Visual SceneNode is null");
-  this->dataPtr->sceneNode->setOrientation(
-      Ogre::Quaternion(_rot.W(), _rot.X(), _rot.Y(), _rot.Z()));
 
-  this->dataPtr->sdf->GetElement("pose")->Set(this->Pose());
+  const Ogre::Quaternion rot = Conversions::Convert(_rot);
+  if (this->dataPtr->sceneNode->getOrientation() == rot)
+    return;
+
+  this->dataPtr->sceneNode->setOrientation(rot);
+  this->dataPtr->sdfPoseDirty = true;
 }
 
 //////////////////////////////////////////////////
@@ -2255,6 +2270,99 @@ void Visual::InsertMesh(const std::string &_meshName,
     this->InsertMesh(mesh);
   }*/
 }
+//////////////////////////////////////////////////
+/// \brief Add levels of detail to a manual Ogre mesh. The levels only have
+/// their own index buffers, with fewer triangles, and share the vertex
+/// buffers and the materials of the mesh.
+/// \param[in] _mesh The mesh.
+/// \param[in] _subMeshes Index in _mesh of each sub mesh of _ogreMesh.
+/// \param[in] _ogreMesh The Ogre mesh, before it is loaded.
+static void GenerateMeshLods(const common::Mesh *_mesh,
+    const std::vector<unsigned int> &_subMeshes, Ogre::MeshPtr _ogreMesh)
+{
+  // Meshes below this number of triangles are cheap enough to draw
+  static const size_t kMinTriangles = 10000;
+
+  // Fraction of the triangles kept by each level, and distance from which
+  // the level is used as a multiple of the radius of the mesh
+  static const std::vector<std::pair<double, double>> kLevels =
+    {{0.5, 10.0}, {0.25, 25.0}, {0.1, 60.0}};
+
+  if (_mesh->HasSkeleton())
+    return;
+
+  size_t triangles = 0;
+  for (auto const index : _subMeshes)
+  {
+    const common::SubMesh *subMesh = _mesh->GetSubMesh(index);
+    if (subMesh->GetPrimitiveType() == common::SubMesh::TRIANGLES)
+      triangles += subMesh->GetIndexCount() / 3;
+  }
+
+  const double radius = (_mesh->Max() - _mesh->Min()).Length() * 0.5;
+  if (triangles < kMinTriangles || !(radius > 0))
+    return;
+
+  common::MeshSimplifier simplifier;
+  simplifier.SetCachePath(
+      (boost::filesystem::path(common::SystemPaths::Instance()->GetLogPath())
+       / "mesh_lod").string());
+
+  // Index buffers of each level of each sub mesh
+  std::vector<std::vector<Ogre::IndexData *>> lods(_subMeshes.size());
+  for (unsigned int i = 0; i < _subMeshes.size(); ++i)
+  {
+    const common::SubMesh *subMesh = _mesh->GetSubMesh(_subMeshes[i]);
+    std::vector<unsigned int> indices(subMesh->GetIndexCount());
+    for (unsigned int j = 0; j < indices.size(); ++j)
+      indices[j] = subMesh->GetIndex(j);
+    const size_t subTriangles = indices.size() / 3;
+
+    for (auto const &level : kLevels)
+    {
+      // Each level simplifies the previous one, other primitives are kept
+      if (subMesh->GetPrimitiveType() == common::SubMesh::TRIANGLES)
+      {
+        indices = simplifier.Simplify(*subMesh, indices,
+            static_cast<size_t>(subTriangles * level.first));
+      }
+
+      Ogre::IndexData *indexData = new Ogre::IndexData();
+      indexData->indexCount = indices.size();
+      if (!indices.empty())
+      {
+        indexData->indexBuffer =
+          Ogre::HardwareBufferManager::getSingleton().createIndexBuffer(
+              Ogre::HardwareIndexBuffer::IT_32BIT, indices.size(),
+              Ogre::HardwareBuffer::HBU_STATIC_WRITE_ONLY, false);
+        uint32_t *data = static_cast<uint32_t *>(
+            indexData->indexBuffer->lock(Ogre::HardwareBuffer::HBL_DISCARD));
+        std::copy(indices.begin(), indices.end(), data);
+        indexData->indexBuffer->unlock();
+      }
+      lods[i].push_back(indexData);
+    }
+  }
+
+#if OGRE_VERSION_MAJOR == 1 && OGRE_VERSION_MINOR < 10
+  _ogreMesh->_setLodInfo(kLevels.size() + 1, false);
+#else
+  _ogreMesh->_setLodInfo(kLevels.size() + 1);
+#endif
+  for (unsigned int level = 1; level <= kLevels.size(); ++level)
+  {
+    Ogre::MeshLodUsage usage;
+    usage.userValue = radius * kLevels[level - 1].second;
+    usage.value =
+      _ogreMesh->getLodStrategy()->transformUserValue(usage.userValue);
+    usage.edgeData = nullptr;
+    _ogreMesh->_setLodUsage(level, usage);
+
+    for (unsigned int i = 0; i < lods.size(); ++i)
+      _ogreMesh->_setSubMeshLodFaceList(i, level, lods[i][level - 1]);
+  }
+}
+
 //////////////////////////////////////////////////
 void Visual::InsertMesh(const common::Mesh *_mesh, const std::string &_subMesh,
     bool _centerSubmesh)
@@ -2323,10 +2431,14 @@ void Visual::InsertMesh(const common::Mesh *_mesh, const std::string &_subMesh,
       ogreMesh->setSkeletonName(_mesh->GetName() + "_skeleton");
     }
 
+    // Index in _mesh of each Ogre sub mesh
+    std::vector<unsigned int> subMeshes;
+
     for (unsigned int i = 0; i < _mesh->GetSubMeshCount(); i++)
     {
       if (!_subMesh.empty() && _mesh->GetSubMesh(i)->GetName() != _subMesh)
         continue;
+      subMeshes.push_back(i);
 
       Ogre::SubMesh *ogreSubMesh;
       Ogre::VertexData *vertexData;
@@ -2545,6 +2657,9 @@ void Visual::InsertMesh(const common::Mesh *_mesh, const std::string &_subMesh,
           Ogre::Vector3(max.X(), max.Y(), max.Z())),
           false);
 
+    if (this->dataPtr->scene && this->dataPtr->scene->MeshLod())
+      GenerateMeshLods(_mesh, subMeshes, ogreMesh);
+
     // this line makes clear the mesh is loaded (avoids memory leaks)
     ogreMesh->load();
   }
@@ -3495,6 +3610,11 @@ void Visual::SetId(uint32_t _id)
 //////////////////////////////////////////////////
 sdf::ElementPtr Visual::GetSDF() const
 {
+  if (this->dataPtr->sdfPoseDirty && this->dataPtr->sdf)
+  {
+    this->dataPtr->sdf->GetElement("pose")->Set(this->Pose());
+    this->dataPtr->sdfPoseDirty = false;
+  }
   return this->dataPtr->sdf;
 }
 
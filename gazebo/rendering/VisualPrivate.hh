@@ -94,6 +94,12 @@ namespace gazebo
       /// \brief The SDF element for the visual.
       public: sdf::ElementPtr sdf;
 
+      /// \brief True if the pose of the scene node changed since it was
+      /// last written to the SDF element. Writing an SDF parameter is far
+      /// slower than moving a node, so it is deferred until the SDF is
+      /// read.
+      public: bool sdfPoseDirty = false;
+
       /// \brief The unique name for the visual's material.
       public: std::string myMaterialName;
 
@@ -2045,6 +2045,28 @@ TEST_F(Visual_TEST, Pose)
   EXPECT_EQ(sphereVis->Pose(), newSpherePose);
   EXPECT_EQ(sphereVis->WorldPose(), newSpherePose + boxPose);
   EXPECT_EQ(sphereVis->InitialRelativePose(), spherePose);
+
+  // the sdf is updated when read
+  EXPECT_EQ(sphereVis->GetSDF()->Get<ignition::math::Pose3d>("pose"),
+      newSpherePose);
+
+  // setting the same pose again keeps it
+  sphereVis->SetPose(newSpherePose);
+  EXPECT_EQ(sphereVis->Pose(), newSpherePose);
+  EXPECT_EQ(sphereVis->GetSDF()->Get<ignition::math::Pose3d>("pose"),
+      newSpherePose);
+
+  // moving the parent moves the child
+  ignition::math::Pose3d newBoxPose(2.0, 0.0, 1.0, 0.0, 0.0, 0.0);
+  boxVis->SetPose(newBoxPose);
+  EXPECT_EQ(sphereVis->Pose(), newSpherePose);
+  EXPECT_EQ(sphereVis->WorldPose(), newSpherePose + newBoxPose);
+
+  // a clone gets the last pose
+  gazebo::rendering::VisualPtr sphereClone =
+      sphereVis->Clone("sphere_clone", boxVis);
+  ASSERT_TRUE(sphereClone != nullptr);
+  EXPECT_EQ(sphereClone->Pose(), newSpherePose);
 }
 
 /////////////////////////////////////////////////
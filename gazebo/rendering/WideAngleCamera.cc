@@ -15,6 +15,11 @@
  *
 */
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
 #if defined(HAVE_OPENGL)
 
 #if defined(__APPLE__)
@@ -409,6 +414,182 @@ void CameraLens::ConvertToCustom()
   cf->AddElement("fun")->Set(this->dataPtr->fun.AsString());
 }
 
+//////////////////////////////////////////////////
+/// \brief Get the focal length used by the lens mapping shader.
+/// \param[in] _lens The lens.
+/// \param[in] _hfov Horizontal field of view of the camera.
+/// \return The focal length.
+static double LensFocalLength(const CameraLens *_lens, const double _hfov)
+{
+  if (!_lens->ScaleToHFOV())
+    return _lens->F();
+
+  double param = (_hfov/2.0) / _lens->C2() + _lens->C3();
+  double funRes = CameraLensPrivate::MapFunctionEnum(_lens->Fun()).Apply(
+      static_cast<float>(param));
+  return 1.0/(_lens->C1()*funRes);
+}
+
+//////////////////////////////////////////////////
+/// \brief Get the angle from the optical axis sampled by the lens mapping
+/// shader at a distance from the image center.
+/// \param[in] _lens The lens.
+/// \param[in] _f Focal length.
+/// \param[in] _radius Distance from the image center, 1 at the left and
+/// right edges of the image.
+/// \return The angle.
+static double LensAngle(const CameraLens *_lens, const double _f,
+    const double _radius)
+{
+  const double param = _radius / (_lens->C1() * _f);
+  const std::string fun = _lens->Fun();
+  double theta = param;
+  if (fun == "sin")
+    theta = std::asin(std::min(1.0, param));
+  else if (fun == "tan")
+    theta = std::atan(param);
+  return (theta - _lens->C3()) * _lens->C2();
+}
+
+//////////////////////////////////////////////////
+/// \brief Get the distance from the image center at which the lens maps an
+/// angle from the optical axis, the inverse of LensAngle.
+/// \param[in] _lens The lens.
+/// \param[in] _f Focal length.
+/// \param[in] _theta Angle from the optical axis.
+/// \return The distance from the image center.
+static double LensRadius(const CameraLens *_lens, const double _f,
+    const double _theta)
+{
+  return _lens->C1() * _f *
+    CameraLensPrivate::MapFunctionEnum(_lens->Fun()).Apply(
+        static_cast<float>(_theta / _lens->C2() + _lens->C3()));
+}
+
+//////////////////////////////////////////////////
+/// \brief Find the faces of the environment cube map sampled by the lens
+/// mapping shader.
+/// \param[in] _lens The lens.
+/// \param[in] _hfov Horizontal field of view of the camera.
+/// \param[in] _ratio Aspect ratio of the image.
+/// \param[in] _margin Angle added to the sampled angles, which covers the
+/// texels blended across the edges of the faces.
+/// \param[out] _faces True for each face in view.
+static void LensFacesInView(const CameraLens *_lens, const double _hfov,
+    const double _ratio, const double _margin, bool _faces[6])
+{
+  for (int i = 0; i < 6; ++i)
+    _faces[i] = true;
+
+  const double f = LensFocalLength(_lens, _hfov);
+  if (!(_lens->C2() > 0.0) || !(f > 0.0) || !std::isfinite(f) ||
+      !(_ratio > 0.0))
+  {
+    return;
+  }
+
+  for (int i = 0; i < 6; ++i)
+    _faces[i] = i == 4;
+
+  // The shader samples the direction (-sin(t) u, sin(t) v, cos(t)) for the
+  // point at distance r along (u, v) from the image center, t growing with
+  // r. Along each azimuth the sampled directions sweep from the forward
+  // face through one side face, then to the back face. A side face is
+  // entered first at its center azimuth and the back face at the diagonals,
+  // which are among the sampled azimuths, as are the image corners.
+  std::vector<double> azimuths;
+  for (int i = 0; i < 360; ++i)
+    azimuths.push_back(i * IGN_PI / 180.0);
+  const double corner = std::atan2(1.0 / _ratio, 1.0);
+  for (double azimuth : {corner, IGN_PI - corner, IGN_PI + corner,
+      -corner})
+  {
+    azimuths.push_back(azimuth);
+  }
+
+  const double cutOff = _lens->CutOffAngle();
+  for (double azimuth : azimuths)
+  {
+    const double u = std::cos(azimuth);
+    const double v = std::sin(azimuth);
+
+    // Distance to the edge of the image along the azimuth
+    double radius = std::numeric_limits<double>::max();
+    if (std::fabs(u) > 1e-9)
+      radius = std::min(radius, 1.0 / std::fabs(u));
+    if (std::fabs(v) > 1e-9)
+      radius = std::min(radius, 1.0 / (_ratio * std::fabs(v)));
+
+    double theta = std::min(cutOff, LensAngle(_lens, f, radius)) + _margin;
+    if (std::isnan(theta) || theta >= IGN_PI)
+    {
+      for (int i = 0; i < 6; ++i)
+        _faces[i] = true;
+      return;
+    }
+
+    const double side = std::atan(1.0 / std::max(std::fabs(u), std::fabs(v)));
+    if (theta > side)
+    {
+      if (std::fabs(u) >= std::fabs(v))
+        _faces[u < 0 ? 0 : 1] = true;
+      else
+        _faces[v > 0 ? 2 : 3] = true;
+    }
+    if (theta > IGN_PI - side)
+      _faces[5] = true;
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Get the environment texture size whose texels are no larger than
+/// the pixels of the image, at the angles seen by the lens.
+/// \param[in] _lens The lens.
+/// \param[in] _hfov Horizontal field of view of the camera.
+/// \param[in] _ratio Aspect ratio of the image.
+/// \param[in] _width Width of the image.
+/// \param[in] _maxSize Maximum texture size.
+/// \return The texture size.
+static int LensEnvTextureSize(const CameraLens *_lens, const double _hfov,
+    const double _ratio, const unsigned int _width, const int _maxSize)
+{
+  const double f = LensFocalLength(_lens, _hfov);
+  if (!(_lens->C2() > 0.0) || !(f > 0.0) || !std::isfinite(f) ||
+      !(_ratio > 0.0))
+  {
+    return _maxSize;
+  }
+
+  const double cornerRadius = std::sqrt(1.0 + 1.0 / (_ratio * _ratio));
+  const double thetaMax = std::min(
+      std::min(_lens->CutOffAngle(), LensAngle(_lens, f, cornerRadius)),
+      IGN_PI - 1e-3);
+
+  // Highest radial and tangential image pixel density, in units of half the
+  // image width per radian
+  double density = 0.0;
+  const int kSteps = 64;
+  const double kDelta = 1e-4;
+  for (int i = 0; i <= kSteps; ++i)
+  {
+    const double theta = thetaMax * i / kSteps;
+    density = std::max(density, std::fabs(LensRadius(_lens, f,
+          theta + kDelta) - LensRadius(_lens, f, theta)) / kDelta);
+    if (theta > kDelta)
+    {
+      density = std::max(density,
+          std::fabs(LensRadius(_lens, f, theta)) / std::sin(theta));
+    }
+  }
+
+  // A face spans 90 degrees with its coarsest texels, size / 2 per radian,
+  // at its center
+  const double size = std::ceil(_width * density);
+  if (!std::isfinite(size))
+    return _maxSize;
+  return std::max(16, std::min(_maxSize, static_cast<int>(size)));
+}
+
 //////////////////////////////////////////////////
 WideAngleCamera::WideAngleCamera(const std::string &_namePrefix,
                                  ScenePtr _scene, const bool _autoRender,
@@ -449,6 +630,13 @@ void WideAngleCamera::Init()
   this->dataPtr->envCameras[3]->pitch(Ogre::Degree(-90));
   this->dataPtr->envCameras[5]->yaw(Ogre::Degree(180));
 
+  if (this->dataPtr->envTextureAutoSize)
+  {
+    this->dataPtr->envTextureSize = LensEnvTextureSize(this->Lens(),
+        this->HFOV().Radian(), this->AspectRatio(), this->ImageWidth(),
+        this->dataPtr->envTextureSize);
+  }
+
   this->CreateEnvRenderTexture(this->scopedUniqueName + "_envRttTex");
 }
 
@@ -478,6 +666,13 @@ void WideAngleCamera::Load()
       this->dataPtr->envCubeMapTextureFormat = static_cast<Ogre::PixelFormat>(
         this->OgrePixelFormat(sdfLens->Get<std::string>(envTextureFormat)));
     }
+
+    const std::string envTextureAutoSize = "ignition:env_texture_auto_size";
+    if (sdfLens->HasElement(envTextureAutoSize))
+    {
+      this->dataPtr->envTextureAutoSize =
+        sdfLens->Get<bool>(envTextureAutoSize);
+    }
   }
   else
     this->dataPtr->lens->Load();
@@ -709,8 +904,16 @@ void WideAngleCamera::RenderImpl()
 {
   std::lock_guard<std::mutex> lock(this->dataPtr->renderMutex);
 
+  // Faces that the lens does not sample are left as they are
+  bool faces[6];
+  LensFacesInView(this->Lens(), this->HFOV().Radian(), this->AspectRatio(),
+      2.0 * (IGN_PI * 0.5) / this->dataPtr->envTextureSize, faces);
+
   for (int i = 0; i < 6; ++i)
-    this->dataPtr->envRenderTargets[i]->update();
+  {
+    if (faces[i])
+      this->dataPtr->envRenderTargets[i]->update();
+  }
 
   this->dataPtr->compMat->getTechnique(0)->getPass(0)->getTextureUnitState(0)->
       setTextureName(this->dataPtr->envCubeMapTexture->getName());
@@ -857,3 +1060,15 @@ std::vector<Ogre::Camera *> WideAngleCamera::OgreEnvCameras() const
   return std::vector<Ogre::Camera *>(
     std::begin(this->dataPtr->envCameras), std::end(this->dataPtr->envCameras));
 }
+
+//////////////////////////////////////////////////
+bool WideAngleCamera::EnvFaceInView(const unsigned int _face) const
+{
+  if (_face >= 6)
+    return false;
+
+  bool faces[6];
+  LensFacesInView(this->Lens(), this->HFOV().Radian(), this->AspectRatio(),
+      2.0 * (IGN_PI * 0.5) / this->EnvTextureSize(), faces);
+  return faces[_face];
+}
@@ -236,6 +236,14 @@ namespace gazebo
       /// \return A list of OGRE cameras
       public: std::vector<Ogre::Camera *> OgreEnvCameras() const;
 
+      /// \brief Check whether a face of the environment cube map is sampled
+      /// by the lens. Only these faces are rendered, which e.g. skips the
+      /// back face of a fisheye lens with a field of view below 250 degrees.
+      /// \param[in] _face Index of the face, in the Ogre cube map order:
+      /// +X, -X, +Y, -Y, +Z (forward) and -Z.
+      /// \return True if the face is seen in the image.
+      public: bool EnvFaceInView(const unsigned int _face) const;
+
       /// \brief Set the camera's render target
       /// \param[in] _textureName Name used as a base for environment texture
       protected: void CreateEnvRenderTexture(const std::string &_textureName);
@@ -47,6 +47,10 @@ namespace gazebo
       /// \brief Environment texture size
       public: int envTextureSize;
 
+      /// \brief True to lower the environment texture size to the angular
+      /// resolution of the lens.
+      public: bool envTextureAutoSize = false;
+
       /// \brief Compositor used to render rectangle with attached cube map
       public: Ogre::CompositorInstance *cubeMapCompInstance;
 
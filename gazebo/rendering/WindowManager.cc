@@ -96,12 +96,18 @@ int WindowManager::CreateWindow(const std::string &_ogreHandle,
   Ogre::NameValuePairList params;
   Ogre::RenderWindow *window = NULL;
 
-  // Mac and Windows *must* use externalWindow handle.
+  // An off-screen render engine has no window, Ogre wraps its EGL context
+  if (RenderEngine::Instance()->OffScreen())
+    params["currentGLContext"] = "true";
+  else
+  {
+    // Mac and Windows *must* use externalWindow handle.
 #if defined(__APPLE__) || defined(_MSC_VER)
-  params["externalWindowHandle"] = _ogreHandle;
+    params["externalWindowHandle"] = _ogreHandle;
 #else
-  params["parentWindowHandle"] = _ogreHandle;
+    params["parentWindowHandle"] = _ogreHandle;
 #endif
+  }
   params["FSAA"] = "4";
   params["stereoMode"] = "Frame Sequential";
 
@@ -71,6 +71,22 @@ namespace gazebo
       /// \brief A 2D overlay used for debugging the selection buffer. It
       /// is hidden by default.
       Ogre::Overlay *selectionDebugOverlay;
+
+      /// \brief True if an asynchronous request waits to be rendered.
+      bool requestPending = false;
+
+      /// \brief X coordinate of the pending request.
+      int requestX = 0;
+
+      /// \brief Y coordinate of the pending request.
+      int requestY = 0;
+
+      /// \brief True if the selection pass of a request was rendered and
+      /// waits to be read back.
+      bool readbackPending = false;
+
+      /// \brief Name of the entity found by the last request read back.
+      std::string asyncEntityName;
     };
   }
 }
@@ -110,6 +126,15 @@ void SelectionBuffer::Update()
   if (!this->dataPtr->renderTexture)
     return;
 
+  this->RenderSelection();
+
+  this->dataPtr->renderTexture->copyContentsToMemory(*this->dataPtr->pixelBox,
+      Ogre::RenderTarget::FB_FRONT);
+}
+
+/////////////////////////////////////////////////
+void SelectionBuffer::RenderSelection()
+{
   this->dataPtr->materialSwitchListener->Reset();
 
   // FIXME: added try-catch block to prevent crash in deferred rendering mode.
@@ -123,9 +148,6 @@ void SelectionBuffer::Update()
   catch(...)
   {
   }
-
-  this->dataPtr->renderTexture->copyContentsToMemory(*this->dataPtr->pixelBox,
-      Ogre::RenderTarget::FB_FRONT);
 }
 
 /////////////////////////////////////////////////
@@ -193,12 +215,93 @@ Ogre::Entity *SelectionBuffer::OnSelectionClick(int _x, int _y)
   if (!this->dataPtr->renderTexture)
     return NULL;
 
+  // The pass rendered for an asynchronous request is overwritten, it is
+  // rendered again by the next UpdateAsync
+  if (this->dataPtr->readbackPending)
+  {
+    this->dataPtr->readbackPending = false;
+    this->dataPtr->requestPending = true;
+  }
+
+  if (!this->SetSelectionCamera(_x, _y))
+    return nullptr;
+
+  // update render texture
+  this->Update();
+
+  const std::string entName = this->ReadSelection();
+  if (entName.empty())
+    return 0;
+  else
+    return this->dataPtr->sceneMgr->getEntity(entName);
+}
+
+/////////////////////////////////////////////////
+void SelectionBuffer::RequestSelection(int _x, int _y)
+{
+  this->dataPtr->requestPending = true;
+  this->dataPtr->requestX = _x;
+  this->dataPtr->requestY = _y;
+}
+
+/////////////////////////////////////////////////
+Ogre::Entity *SelectionBuffer::AsyncSelection() const
+{
+  // The entity may have been removed since the pass was rendered
+  if (this->dataPtr->asyncEntityName.empty() ||
+      !this->dataPtr->sceneMgr->hasEntity(this->dataPtr->asyncEntityName))
+  {
+    return nullptr;
+  }
+  return this->dataPtr->sceneMgr->getEntity(this->dataPtr->asyncEntityName);
+}
+
+/////////////////////////////////////////////////
+bool SelectionBuffer::AsyncPending() const
+{
+  return this->dataPtr->requestPending || this->dataPtr->readbackPending;
+}
+
+/////////////////////////////////////////////////
+void SelectionBuffer::UpdateAsync()
+{
+  if (!this->dataPtr->renderTexture)
+    return;
+
+  // The pass was rendered a frame ago, so the GPU is likely done with it
+  // and reading it back does not stall
+  if (this->dataPtr->readbackPending)
+  {
+    this->dataPtr->readbackPending = false;
+    this->dataPtr->renderTexture->copyContentsToMemory(
+        *this->dataPtr->pixelBox, Ogre::RenderTarget::FB_FRONT);
+    this->dataPtr->asyncEntityName = this->ReadSelection();
+  }
+
+  if (!this->dataPtr->requestPending)
+    return;
+  this->dataPtr->requestPending = false;
+
+  if (!this->SetSelectionCamera(this->dataPtr->requestX,
+        this->dataPtr->requestY))
+  {
+    this->dataPtr->asyncEntityName.clear();
+    return;
+  }
+
+  this->RenderSelection();
+  this->dataPtr->readbackPending = true;
+}
+
+/////////////////////////////////////////////////
+bool SelectionBuffer::SetSelectionCamera(int _x, int _y)
+{
   unsigned int targetWidth = this->dataPtr->renderTarget->getWidth();
   unsigned int targetHeight = this->dataPtr->renderTarget->getHeight();
 
   if (_x < 0 || _y < 0 || _x >= static_cast<int>(targetWidth)
       || _y >= static_cast<int>(targetHeight))
-    return nullptr;
+    return false;
 
   // 1x1 selection buffer, adapted from rviz
   // http://docs.ros.org/indigo/api/rviz/html/c++/selection__manager_8cpp.html
@@ -226,29 +329,25 @@ Ogre::Entity *SelectionBuffer::OnSelectionClick(int _x, int _y)
       this->dataPtr->camera->getDerivedOrientation());
   Ogre::Viewport* renderViewport = this->dataPtr->renderTexture->getViewport(0);
   renderViewport->setDimensions(0, 0, width, height);
+  return true;
+}
 
-  // update render texture
-  this->Update();
-
+/////////////////////////////////////////////////
+std::string SelectionBuffer::ReadSelection()
+{
   size_t posInStream = 0;
 
   ignition::math::Color::BGRA color(0);
   if (!this->dataPtr->buffer)
   {
     gzerr << "Selection buffer is null.\n";
-    return nullptr;
+    return std::string();
   }
   memcpy(static_cast<void *>(&color), this->dataPtr->buffer + posInStream, 4);
   ignition::math::Color cv;
   cv.SetFromARGB(color);
   cv.A(1.0);
-  const std::string &entName =
-    this->dataPtr->materialSwitchListener->GetEntityName(cv);
-
-  if (entName.empty())
-    return 0;
-  else
-    return this->dataPtr->sceneMgr->getEntity(entName);
+  return this->dataPtr->materialSwitchListener->GetEntityName(cv);
 }
 
 /////////////////////////////////////////////////
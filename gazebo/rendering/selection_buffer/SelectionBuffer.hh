@@ -53,6 +53,30 @@ namespace gazebo
       /// \return Returns the Ogre entity at the coordinate.
       public: Ogre::Entity *OnSelectionClick(int _x, int _y);
 
+      /// \brief Request the entity at a coordinate without waiting for the
+      /// GPU. The selection pass is rendered by the next UpdateAsync, and
+      /// its result is read back by the one after. Requests made before
+      /// the pass is rendered replace each other.
+      /// \param[in] _x X coordinate in pixels.
+      /// \param[in] _y Y coordinate in pixels.
+      /// \sa AsyncSelection
+      public: void RequestSelection(int _x, int _y);
+
+      /// \brief Get the result of the last request read back.
+      /// \return The Ogre entity found, or null if none was found or no
+      /// request completed yet.
+      /// \sa RequestSelection
+      public: Ogre::Entity *AsyncSelection() const;
+
+      /// \brief Get whether a request is not read back yet.
+      /// \return True if a request waits to be rendered or read back.
+      public: bool AsyncPending() const;
+
+      /// \brief Read back the selection pass rendered by the previous call,
+      /// then render the pass of the latest request. Call this once per
+      /// frame, after the frame is rendered.
+      public: void UpdateAsync();
+
       /// \brief Debug show overlay
       /// \param[in] _show True to show the selection buffer in an overlay.
       public: void ShowOverlay(bool _show);
@@ -69,6 +93,19 @@ namespace gazebo
       /// \brief Create the selection buffer offscreen render texture.
       private: void CreateRTTOverlays();
 
+      /// \brief Point the selection camera at a coordinate.
+      /// \param[in] _x X coordinate in pixels.
+      /// \param[in] _y Y coordinate in pixels.
+      /// \return False if the coordinate is outside the render target.
+      private: bool SetSelectionCamera(int _x, int _y);
+
+      /// \brief Render the selection pass, without reading it back.
+      private: void RenderSelection();
+
+      /// \brief Read back the selection pass and decode its entity.
+      /// \return Name of the entity, empty if none was found.
+      private: std::string ReadSelection();
+
       /// \internal
       /// \brief Pointer to private data.
       private: std::unique_ptr<SelectionBufferPrivate> dataPtr;
@@ -34,7 +34,7 @@ GZ_REGISTER_STATIC_SENSOR("altimeter", AltimeterSensor)
 
 /////////////////////////////////////////////////
 AltimeterSensor::AltimeterSensor()
-: Sensor(sensors::OTHER),
+: Sensor(sensors::INLINE),
   dataPtr(new AltimeterSensorPrivate)
 {
 }
@@ -15,7 +15,14 @@
  *
 */
 #include <boost/algorithm/string.hpp>
+#include <boost/make_shared.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <functional>
+#include <limits>
+#include <memory>
+#include <vector>
 #include <ignition/common/Profiler.hh>
 #include <ignition/msgs/Utility.hh>
 
@@ -108,12 +115,132 @@ void CameraSensor::Load(const std::string &_worldName)
           boost::bind(&CameraSensor::PrerenderEnded, this)));
   }
 
+  const std::string kElementName = "ignition:render_on_demand";
+  if (this->sdf->HasElement(kElementName))
+    this->dataPtr->renderOnDemand = this->sdf->Get<bool>(kElementName);
+
+  const std::string kWaitForScene = "ignition:wait_for_scene";
+  if (this->sdf->HasElement(kWaitForScene))
+    this->dataPtr->waitForScene = this->sdf->Get<bool>(kWaitForScene);
+
   this->imagePub = this->node->Advertise<msgs::ImageStamped>(this->Topic(), 50);
 
   ignition::transport::AdvertiseMessageOptions opts;
   opts.SetMsgsPerSec(50);
   this->imagePubIgn = this->nodeIgn.Advertise<ignition::msgs::Image>(
       this->TopicIgn(), opts);
+
+  sdf::ElementPtr cameraSdf = this->sdf->GetElement("camera");
+  const std::string kImageEncoding = "ignition:image_encoding";
+  if (cameraSdf->HasElement(kImageEncoding))
+  {
+    sdf::ElementPtr elem = cameraSdf->GetElement(kImageEncoding);
+    int quality = 90;
+    if (elem->HasElement("quality"))
+      quality = elem->Get<int>("quality");
+    if (elem->HasElement("format"))
+      this->SetImageEncoding(elem->Get<std::string>("format"), quality);
+  }
+}
+
+//////////////////////////////////////////////////
+void CameraSensor::SetImageEncoding(const std::string &_format,
+    const int _quality)
+{
+  if (!_format.empty() && _format != "png" && _format != "jpeg" &&
+      _format != "webp")
+  {
+    gzerr << "Unknown image encoding [" << _format << "] of camera ["
+          << this->Name() << "], use png, jpeg or webp" << std::endl;
+    return;
+  }
+
+  // The encodings in progress use the previous settings
+  this->dataPtr->encodeTasks.wait();
+
+  this->dataPtr->imageEncoding = _format;
+  this->dataPtr->imageQuality = std::max(1, std::min(100, _quality));
+  if (_format.empty())
+  {
+    this->dataPtr->compressedPub.reset();
+  }
+  else if (!this->dataPtr->compressedPub)
+  {
+    this->dataPtr->compressedPub =
+        this->node->Advertise<msgs::CompressedImageStamped>(
+        this->Topic() + "/compressed", 50);
+  }
+}
+
+//////////////////////////////////////////////////
+std::string CameraSensor::ImageEncoding() const
+{
+  return this->dataPtr->imageEncoding;
+}
+
+//////////////////////////////////////////////////
+std::string CameraSensor::CompressedTopic() const
+{
+  if (this->dataPtr->imageEncoding.empty())
+    return std::string();
+  return this->Topic() + "/compressed";
+}
+
+//////////////////////////////////////////////////
+void CameraSensor::PublishCompressed(const common::Time &_simTime)
+{
+  // Skip the frame rather than queue it behind a slow encoding
+  if (this->dataPtr->encoding.exchange(true))
+    return;
+
+  const common::Image::PixelFormat format =
+      common::Image::ConvertPixelFormat(this->camera->ImageFormat());
+  const unsigned int width = this->camera->ImageWidth();
+  const unsigned int height = this->camera->ImageHeight();
+  const unsigned int depth = this->camera->ImageDepth();
+  if (format != common::Image::L_INT8 && format != common::Image::RGB_INT8 &&
+      format != common::Image::BGR_INT8 && format != common::Image::RGBA_INT8 &&
+      format != common::Image::BGRA_INT8)
+  {
+    gzerr << "Unable to encode images of format ["
+          << this->camera->ImageFormat() << "] of camera [" << this->Name()
+          << "], compressed images are disabled" << std::endl;
+    this->dataPtr->encoding = false;
+    this->SetImageEncoding("");
+    return;
+  }
+
+  if (!this->camera->ImageData())
+  {
+    this->dataPtr->encoding = false;
+    return;
+  }
+
+  // The camera overwrites its image with the next frame, so the worker
+  // gets a copy
+  auto pixels = std::make_shared<std::vector<unsigned char>>(
+      this->camera->ImageData(),
+      this->camera->ImageData() + width * height * depth);
+
+  auto msg = boost::make_shared<msgs::CompressedImageStamped>();
+  msgs::Set(msg->mutable_time(), _simTime);
+  msg->set_width(width);
+  msg->set_height(height);
+  msg->set_pixel_format(format);
+  msg->set_format(this->dataPtr->imageEncoding);
+
+  transport::PublisherPtr pub = this->dataPtr->compressedPub;
+  const int quality = this->dataPtr->imageQuality;
+  std::atomic_bool &encoding = this->dataPtr->encoding;
+  this->dataPtr->encodeTasks.run([=, &encoding]()
+  {
+    if (common::Image::Encode(pixels->data(), width, height, format,
+          msg->format(), *msg->mutable_data(), quality))
+    {
+      pub->Publish(msg);
+    }
+    encoding = false;
+  });
 }
 
 //////////////////////////////////////////////////
@@ -143,42 +270,45 @@ void CameraSensor::Init()
       }
     }
 
-    std::string scopedName = this->parentName + "::" + this->Name();
-    this->camera = this->scene->CreateCamera(scopedName, false);
-
-    if (!this->camera)
-    {
-      gzerr << "Unable to create camera sensor[mono_camera]\n";
-      return;
-    }
-    this->camera->SetCaptureData(true);
-
     sdf::ElementPtr cameraSdf = this->sdf->GetElement("camera");
-    this->camera->Load(cameraSdf);
 
-    // Do some sanity checks
-    if (this->camera->ImageWidth() == 0 ||
-        this->camera->ImageHeight() == 0)
+    // The image size of the low quality profile is fixed at creation, since
+    // the render textures and buffers of the camera are sized by Init.
+    const std::string kLowQuality = "ignition:low_quality";
+    if (cameraSdf->HasElement(kLowQuality))
     {
-      gzthrow("image has zero size");
+      sdf::ElementPtr elem = cameraSdf->GetElement(kLowQuality);
+      if (elem->HasElement("shadows"))
+        this->dataPtr->lowQualityShadows = elem->Get<bool>("shadows");
+      if (elem->HasElement("enabled"))
+        this->dataPtr->lowQuality = elem->Get<bool>("enabled");
+
+      double scale = 1.0;
+      if (elem->HasElement("image_scale"))
+        scale = elem->Get<double>("image_scale");
+      if (scale <= 0.0 || scale > 1.0)
+      {
+        gzwarn << "Low quality image scale [" << scale << "] of camera ["
+               << this->Name() << "] must be in (0, 1], using 1"
+               << std::endl;
+        scale = 1.0;
+      }
+      if (this->dataPtr->lowQuality && scale < 1.0)
+      {
+        sdf::ElementPtr imageElem = cameraSdf->GetElement("image");
+        for (const auto &key : {"width", "height"})
+        {
+          const unsigned int size = std::max(1u, static_cast<unsigned int>(
+                std::round(imageElem->Get<unsigned int>(key) * scale)));
+          imageElem->GetElement(key)->Set(size);
+        }
+      }
     }
 
-    this->camera->Init();
-    this->camera->CreateRenderTexture(scopedName + "_RttTex");
-    ignition::math::Pose3d cameraPose = this->pose;
-    if (cameraSdf->HasElement("pose"))
-      cameraPose = cameraSdf->Get<ignition::math::Pose3d>("pose") + cameraPose;
-
-    this->camera->SetWorldPose(cameraPose);
-    this->camera->AttachToVisual(this->ParentId(), true, 0, 0);
-
-    if (cameraSdf->HasElement("noise"))
-    {
-      this->noises[CAMERA_NOISE] =
-        NoiseFactory::NewNoiseModel(cameraSdf->GetElement("noise"),
-        this->Type());
-      this->noises[CAMERA_NOISE]->SetCamera(this->camera);
-    }
+    // A lazy camera is created by its first update while it's active
+    this->LoadLazy();
+    if (!this->Lazy() && !this->CreateResources())
+      return;
   }
   else
     gzerr << "No world name\n";
@@ -192,10 +322,81 @@ void CameraSensor::Init()
   Sensor::Init();
 }
 
+//////////////////////////////////////////////////
+bool CameraSensor::CreateResources()
+{
+  std::string scopedName = this->parentName + "::" + this->Name();
+  this->camera = this->scene->CreateCamera(scopedName, false);
+
+  if (!this->camera)
+  {
+    gzerr << "Unable to create camera sensor[mono_camera]\n";
+    return false;
+  }
+  this->camera->SetCaptureData(true);
+
+  sdf::ElementPtr cameraSdf = this->sdf->GetElement("camera");
+  this->camera->Load(cameraSdf);
+
+  // Do some sanity checks
+  if (this->camera->ImageWidth() == 0 ||
+      this->camera->ImageHeight() == 0)
+  {
+    gzthrow("image has zero size");
+  }
+
+  this->camera->Init();
+  this->camera->CreateRenderTexture(scopedName + "_RttTex");
+  this->dataPtr->shadows = this->camera->ShadowsEnabled();
+  if (this->dataPtr->lowQuality)
+    this->camera->SetShadowsEnabled(this->dataPtr->lowQualityShadows);
+  ignition::math::Pose3d cameraPose = this->pose;
+  if (cameraSdf->HasElement("pose"))
+    cameraPose = cameraSdf->Get<ignition::math::Pose3d>("pose") + cameraPose;
+
+  this->camera->SetWorldPose(cameraPose);
+  this->camera->AttachToVisual(this->ParentId(), true, 0, 0);
+
+  if (cameraSdf->HasElement("noise"))
+  {
+    this->noises[CAMERA_NOISE] =
+      NoiseFactory::NewNoiseModel(cameraSdf->GetElement("noise"),
+      this->Type());
+    this->noises[CAMERA_NOISE]->SetCamera(this->camera);
+  }
+
+  // A camera created while the sensor is active computes its next
+  // rendering time again
+  this->dataPtr->nextRenderingTime.reset();
+  return true;
+}
+
+//////////////////////////////////////////////////
+void CameraSensor::ReleaseResources()
+{
+  // Finish publishing the last compressed frames first
+  this->dataPtr->encodeTasks.wait();
+  this->dataPtr->rendered = false;
+  this->dataPtr->renderNeeded = false;
+
+  auto noise = this->noises.find(CAMERA_NOISE);
+  if (noise != this->noises.end())
+  {
+    noise->second->Fini();
+    this->noises.erase(noise);
+  }
+
+  if (this->camera)
+    this->scene->RemoveCamera(this->camera->Name());
+  this->camera.reset();
+}
+
 //////////////////////////////////////////////////
 void CameraSensor::Fini()
 {
   this->imagePub.reset();
+  this->dataPtr->encodeTasks.wait();
+  this->dataPtr->compressedPub.reset();
 
   if (this->camera)
   {
@@ -215,7 +416,7 @@ void CameraSensor::SetActive(bool _value)
   {
     // the next rendering time must be reset to ensure it is properly
     // computed by CameraSensor::NeedsUpdate.
-    this->dataPtr->nextRenderingTime = std::numeric_limits<double>::quiet_NaN();
+    this->dataPtr->nextRenderingTime.reset();
   }
   Sensor::SetActive(_value);
 }
@@ -225,13 +426,13 @@ bool CameraSensor::NeedsUpdate()
 {
   if (this->useStrictRate)
   {
-    double simTime;
+    common::SimTimeNs simTime;
     if (this->scene)
-      simTime = this->scene->SimTime().Double();
+      simTime = common::SimTimeNs(this->scene->SimTime());
     else
-      simTime = this->world->SimTime().Double();
+      simTime = this->world->SimTimeNs();
 
-    if (simTime < this->lastMeasurementTime.Double())
+    if (simTime < common::SimTimeNs(this->lastMeasurementTime))
     {
       // Rendering sensors also set the lastMeasurementTime variable in Render()
       // and lastUpdateTime in Sensor::Update based on Scene::SimTime() which
@@ -241,14 +442,15 @@ bool CameraSensor::NeedsUpdate()
       return false;
     }
 
-    double dt = this->world->Physics()->GetMaxStepSize();
+    const common::SimTimeNs dt = common::SimTimeNs::FromSeconds(
+        this->world->Physics()->GetMaxStepSize());
 
     // If next rendering time is not set yet
-    if (std::isnan(this->dataPtr->nextRenderingTime))
+    if (!this->dataPtr->nextRenderingTime)
     {
       if (this->updatePeriod == 0
-          || (simTime > 0.0 &&
-          std::abs(std::fmod(simTime, this->updatePeriod.Double())) < dt))
+          || (simTime > common::SimTimeNs() &&
+          simTime.Mod(common::SimTimeNs(this->updatePeriod)) < dt))
       {
         this->dataPtr->nextRenderingTime = simTime;
         return true;
@@ -259,12 +461,13 @@ bool CameraSensor::NeedsUpdate()
       }
     }
 
-    if (simTime > this->dataPtr->nextRenderingTime + dt)
+    const common::SimTimeNs offset =
+      simTime - *this->dataPtr->nextRenderingTime;
+    if (offset > dt)
       return true;
 
     // Trigger on the tick the closest from the targeted rendering time
-    return (ignition::math::lessOrNearEqual(
-          std::abs(simTime - this->dataPtr->nextRenderingTime), dt / 2.0));
+    return std::max(offset, -offset) <= dt / 2;
   }
   else
   {
@@ -285,14 +488,22 @@ void CameraSensor::PrerenderEnded()
       this->NeedsUpdate())
   {
     // compute next rendering time, take care of the case where period is zero.
-    double dt;
+    common::SimTimeNs dt;
     if (this->updatePeriod <= 0.0)
-      dt = this->world->Physics()->GetMaxStepSize();
+    {
+      dt = common::SimTimeNs::FromSeconds(
+          this->world->Physics()->GetMaxStepSize());
+    }
     else
-      dt = this->updatePeriod.Double();
-    this->dataPtr->nextRenderingTime += dt;
-
-    this->dataPtr->renderNeeded = true;
+      dt = common::SimTimeNs(this->updatePeriod);
+    if (this->dataPtr->nextRenderingTime)
+      *this->dataPtr->nextRenderingTime += dt;
+
+    // The rendering time still advances when the rendering is skipped, so
+    // that the sensor stays in step with the world
+    this->dataPtr->renderNeeded =
+      (!this->dataPtr->renderOnDemand || this->HasListeners()) &&
+      (!this->dataPtr->waitForScene || this->scene->VisualsReady());
     this->lastMeasurementTime = this->scene->SimTime();
   }
 }
@@ -307,7 +518,9 @@ void CameraSensor::Render()
       return;
 
     // Update all the cameras
+    auto start = std::chrono::steady_clock::now();
     this->camera->Render();
+    this->AddStageDuration(SENSOR_STAGE_RENDER, start);
 
     this->dataPtr->rendered = true;
     this->dataPtr->renderNeeded = false;
@@ -317,8 +530,17 @@ void CameraSensor::Render()
     if (!this->camera || !this->IsActive() || !this->NeedsUpdate())
       return;
 
+    if (this->dataPtr->renderOnDemand && !this->HasListeners())
+      return;
+
+    // Images of a scene that is still being created are not published
+    if (this->dataPtr->waitForScene && !this->scene->VisualsReady())
+      return;
+
     // Update all the cameras
+    auto start = std::chrono::steady_clock::now();
     this->camera->Render();
+    this->AddStageDuration(SENSOR_STAGE_RENDER, start);
 
     this->dataPtr->rendered = true;
     this->lastMeasurementTime = this->scene->SimTime();
@@ -334,7 +556,9 @@ bool CameraSensor::UpdateImpl(const bool /*_force*/)
     return false;
 
   IGN_PROFILE_BEGIN("PostRender");
+  auto start = std::chrono::steady_clock::now();
   this->camera->PostRender();
+  this->AddStageDuration(SENSOR_STAGE_READBACK, start);
   IGN_PROFILE_END();
 
   IGN_PROFILE_BEGIN("fillarray");
@@ -342,21 +566,24 @@ bool CameraSensor::UpdateImpl(const bool /*_force*/)
   if ((this->imagePub && this->imagePub->HasConnections()) ||
       this->imagePubIgn.HasConnections())
   {
+    start = std::chrono::steady_clock::now();
     auto simTime = this->scene->SimTime();
     if (this->imagePub && this->imagePub->HasConnections())
     {
-      msgs::ImageStamped msg;
-      msgs::Set(msg.mutable_time(), simTime);
-      msg.mutable_image()->set_width(this->camera->ImageWidth());
-      msg.mutable_image()->set_height(this->camera->ImageHeight());
-      msg.mutable_image()->set_pixel_format(common::Image::ConvertPixelFormat(
-            this->camera->ImageFormat()));
-
-      msg.mutable_image()->set_step(this->camera->ImageWidth() *
+      // The message is shared with the subscribers instead of copied, so
+      // the frame is copied once, into the message
+      boost::shared_ptr<msgs::ImageStamped> msg(new msgs::ImageStamped);
+      msgs::Set(msg->mutable_time(), simTime);
+      msg->mutable_image()->set_width(this->camera->ImageWidth());
+      msg->mutable_image()->set_height(this->camera->ImageHeight());
+      msg->mutable_image()->set_pixel_format(
+          common::Image::ConvertPixelFormat(this->camera->ImageFormat()));
+
+      msg->mutable_image()->set_step(this->camera->ImageWidth() *
           this->camera->ImageDepth());
-      msg.mutable_image()->set_data(this->camera->ImageData(),
-          msg.image().width() * this->camera->ImageDepth() *
-          msg.image().height());
+      msg->mutable_image()->set_data(this->camera->ImageData(),
+          msg->image().width() * this->camera->ImageDepth() *
+          msg->image().height());
 
       this->imagePub->Publish(msg);
     }
@@ -380,6 +607,15 @@ bool CameraSensor::UpdateImpl(const bool /*_force*/)
 
       this->imagePubIgn.Publish(msg);
     }
+    this->AddStageDuration(SENSOR_STAGE_PUBLISH, start);
+  }
+
+  if (this->dataPtr->compressedPub &&
+      this->dataPtr->compressedPub->HasConnections())
+  {
+    start = std::chrono::steady_clock::now();
+    this->PublishCompressed(this->scene->SimTime());
+    this->AddStageDuration(SENSOR_STAGE_PUBLISH, start);
   }
 
   this->dataPtr->rendered = false;
@@ -441,12 +677,49 @@ bool CameraSensor::SaveFrame(const std::string &_filename)
     return false;
 }
 
+//////////////////////////////////////////////////
+void CameraSensor::SetLowQuality(const bool _enabled)
+{
+  if (this->camera && _enabled != this->dataPtr->lowQuality)
+  {
+    if (_enabled)
+    {
+      this->dataPtr->shadows = this->camera->ShadowsEnabled();
+      this->camera->SetShadowsEnabled(this->dataPtr->lowQualityShadows);
+    }
+    else
+    {
+      this->camera->SetShadowsEnabled(this->dataPtr->shadows);
+    }
+  }
+  this->dataPtr->lowQuality = _enabled;
+}
+
+//////////////////////////////////////////////////
+bool CameraSensor::LowQuality() const
+{
+  return this->dataPtr->lowQuality;
+}
+
+//////////////////////////////////////////////////
+bool CameraSensor::HasListeners()
+{
+  return (this->imagePub && this->imagePub->HasConnections()) ||
+    this->imagePubIgn.HasConnections() ||
+    (this->dataPtr->compressedPub &&
+     this->dataPtr->compressedPub->HasConnections()) ||
+    this->updated.ConnectionCount() > 0u ||
+    (this->camera && this->camera->HasFrameListeners());
+}
+
 //////////////////////////////////////////////////
 bool CameraSensor::IsActive() const
 {
   return Sensor::IsActive() ||
     (this->imagePub && this->imagePub->HasConnections()) ||
-    this->imagePubIgn.HasConnections();
+    this->imagePubIgn.HasConnections() ||
+    (this->dataPtr->compressedPub &&
+     this->dataPtr->compressedPub->HasConnections());
 }
 
 //////////////////////////////////////////////////
@@ -472,8 +745,11 @@ double CameraSensor::NextRequiredTimestamp() const
 {
   if (this->useStrictRate)
   {
-    if (!ignition::math::equal(this->updatePeriod.Double(), 0.0))
-      return this->dataPtr->nextRenderingTime;
+    if (!ignition::math::equal(this->updatePeriod.Double(), 0.0) &&
+        this->dataPtr->nextRenderingTime)
+    {
+      return this->dataPtr->nextRenderingTime->Double();
+    }
     else
       return std::numeric_limits<double>::quiet_NaN();
   }
@@ -488,5 +764,5 @@ void CameraSensor::ResetLastUpdateTime()
 {
   Sensor::ResetLastUpdateTime();
   if (this->useStrictRate)
-    this->dataPtr->nextRenderingTime = std::numeric_limits<double>::quiet_NaN();
+    this->dataPtr->nextRenderingTime.reset();
 }
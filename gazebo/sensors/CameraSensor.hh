@@ -89,7 +89,8 @@ namespace gazebo
       public: void SetActive(bool _value) override;
 
       /// \brief Returns a pointer to the rendering::Camera.
-      /// \return The Pointer to the camera sensor.
+      /// \return The Pointer to the camera sensor, null while a lazy sensor
+      /// hasn't created its camera, see Sensor::Lazy.
       public: rendering::CameraPtr Camera() const;
 
       /// \brief Gets the width of the image in pixels.
@@ -109,6 +110,43 @@ namespace gazebo
       /// \return True if successful, false if unsuccessful.
       public: bool SaveFrame(const std::string &_filename);
 
+      /// \brief Switch the camera to its low quality profile, or back, e.g.
+      /// when nobody watches its images. The profile is given by the
+      /// <ignition:low_quality> element of the camera: its image scale is
+      /// applied when the sensor is created, with <enabled> true, and its
+      /// shadows are switched at once.
+      /// \param[in] _enabled True to use the low quality profile.
+      /// \sa LowQuality
+      public: void SetLowQuality(const bool _enabled);
+
+      /// \brief Get whether the camera uses its low quality profile.
+      /// \return True if the low quality profile is used.
+      /// \sa SetLowQuality
+      public: bool LowQuality() const;
+
+      /// \brief Publish the images encoded, on the topic of the raw images
+      /// followed by "/compressed", as msgs::CompressedImageStamped. The
+      /// images are encoded on worker threads, only while the topic has
+      /// subscribers, and frames rendered while the previous one is
+      /// encoded are skipped. Only 8 bit pixel formats are encoded. The
+      /// encoding is also set by the <ignition:image_encoding> element of
+      /// the camera, with <format> and <quality> children.
+      /// \param[in] _format Encoding, "png", "jpeg" or "webp", or empty to
+      /// stop publishing compressed images.
+      /// \param[in] _quality Quality of the lossy encodings, from 1 to 100.
+      /// \sa ImageEncoding
+      public: void SetImageEncoding(const std::string &_format,
+                  const int _quality = 90);
+
+      /// \brief Get the encoding of the compressed images.
+      /// \return The encoding, empty if compressed images are disabled.
+      /// \sa SetImageEncoding
+      public: std::string ImageEncoding() const;
+
+      /// \brief Get the topic of the compressed images.
+      /// \return The topic, empty if compressed images are disabled.
+      public: std::string CompressedTopic() const;
+
       // Documentation inherited
       public: virtual bool IsActive() const override;
 
@@ -118,6 +156,17 @@ namespace gazebo
       /// \brief Finalize the camera
       protected: virtual void Fini() override;
 
+      // Documentation inherited
+      protected: bool CreateResources() override;
+
+      // Documentation inherited
+      protected: void ReleaseResources() override;
+
+      /// \brief Encode the current image and publish it, on a worker
+      /// thread.
+      /// \param[in] _simTime Time of the image.
+      private: void PublishCompressed(const common::Time &_simTime);
+
       /// \brief Handle the render event.
       protected: virtual void Render();
 
@@ -131,6 +180,13 @@ namespace gazebo
       /// \brief Handle the prerenderEnded event.
       protected: void PrerenderEnded();
 
+      /// \brief Check whether anything consumes the images of the sensor:
+      /// subscribers, callbacks of the sensor or frame listeners of the
+      /// camera. With <ignition:render_on_demand> the sensor renders only
+      /// while this is true.
+      /// \return True if the images are consumed.
+      protected: virtual bool HasListeners();
+
       /// \brief Pointer to the camera.
       protected: rendering::CameraPtr camera;
 
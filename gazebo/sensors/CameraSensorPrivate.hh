@@ -17,7 +17,14 @@
 #ifndef GAZEBO_SENSORS_CAMERASENSOR_PRIVATE_HH_
 #define GAZEBO_SENSORS_CAMERASENSOR_PRIVATE_HH_
 
-#include <limits>
+#include <tbb/task_group.h>
+
+#include <atomic>
+#include <optional>
+#include <string>
+
+#include "gazebo/common/SimTimeNs.hh"
+#include "gazebo/transport/TransportTypes.hh"
 
 namespace gazebo
 {
@@ -33,9 +40,41 @@ namespace gazebo
       /// \brief True if the sensor needs a rendering
       public: bool renderNeeded = false;
 
-      /// \brief Timestamp of the forthcoming rendering
-      public: double nextRenderingTime
-                           = std::numeric_limits<double>::quiet_NaN();
+      /// \brief Sim time of the forthcoming rendering, unset until the
+      /// sensor is first due
+      public: std::optional<common::SimTimeNs> nextRenderingTime;
+
+      /// \brief True to render only while the images have listeners.
+      public: bool renderOnDemand = false;
+
+      /// \brief True to skip rendering until the scene created all the
+      /// visuals received, see rendering::Scene::VisualsReady.
+      public: bool waitForScene = false;
+
+      /// \brief True if the low quality profile is used.
+      public: bool lowQuality = false;
+
+      /// \brief Shadows of the low quality profile.
+      public: bool lowQualityShadows = false;
+
+      /// \brief Shadows of the camera outside the low quality profile.
+      public: bool shadows = true;
+
+      /// \brief Encoding of the compressed images, empty if disabled.
+      public: std::string imageEncoding;
+
+      /// \brief Quality of the lossy image encodings, from 1 to 100.
+      public: int imageQuality = 90;
+
+      /// \brief Publisher of the compressed images, null if disabled.
+      public: transport::PublisherPtr compressedPub;
+
+      /// \brief Image encodings running on the tbb worker threads.
+      public: tbb::task_group encodeTasks;
+
+      /// \brief True while an image is being encoded. Frames rendered in
+      /// the meantime are not encoded.
+      public: std::atomic_bool encoding{false};
     };
   }
 }
@@ -16,6 +16,9 @@
 */
 
 #include <gtest/gtest.h>
+#include <mutex>
+#include <string>
+#include "gazebo/rendering/Camera.hh"
 #include "gazebo/test/ServerFixture.hh"
 #include "gazebo/test/helper_physics_generator.hh"
 
@@ -81,6 +84,168 @@ TEST_F(CameraSensor_TEST, CreateCamera)
   EXPECT_EQ(sensor->ImageHeight(), 0u);
 }
 
+/////////////////////////////////////////////////
+TEST_F(CameraSensor_TEST, LowQuality)
+{
+  this->Load("worlds/empty.world");
+  this->SpawnCamera("camera", "camera", ignition::math::Vector3d::Zero,
+      ignition::math::Vector3d::Zero);
+
+  sensors::CameraSensorPtr sensor =
+     std::dynamic_pointer_cast<sensors::CameraSensor>(
+       sensors::SensorManager::Instance()->GetSensor(
+         "default::camera::body::camera"));
+  ASSERT_TRUE(sensor != nullptr);
+  ASSERT_TRUE(sensor->Camera() != nullptr);
+
+  // Without an <ignition:low_quality> element the profile drops shadows
+  EXPECT_FALSE(sensor->LowQuality());
+  const bool shadows = sensor->Camera()->ShadowsEnabled();
+
+  sensor->SetLowQuality(true);
+  EXPECT_TRUE(sensor->LowQuality());
+  EXPECT_FALSE(sensor->Camera()->ShadowsEnabled());
+
+  sensor->SetLowQuality(false);
+  EXPECT_FALSE(sensor->LowQuality());
+  EXPECT_EQ(shadows, sensor->Camera()->ShadowsEnabled());
+
+  // The image size is unchanged
+  EXPECT_EQ(sensor->ImageWidth(), 320u);
+  EXPECT_EQ(sensor->ImageHeight(), 240u);
+}
+
+/////////////////////////////////////////////////
+TEST_F(CameraSensor_TEST, Lazy)
+{
+  this->Load("worlds/empty.world");
+  this->SpawnSDF(
+      "<sdf version='1.6'>"
+      "<model name='lazy_camera'>"
+      "  <static>true</static>"
+      "  <pose>0 0 1 0 0 0</pose>"
+      "  <link name='body'>"
+      "    <sensor name='camera' type='camera'>"
+      "      <always_on>false</always_on>"
+      "      <update_rate>10</update_rate>"
+      "      <ignition:lazy>true</ignition:lazy>"
+      "      <ignition:lazy_idle_time>0</ignition:lazy_idle_time>"
+      "      <camera>"
+      "        <horizontal_fov>1.0</horizontal_fov>"
+      "        <image><width>160</width><height>120</height></image>"
+      "        <clip><near>0.1</near><far>100</far></clip>"
+      "      </camera>"
+      "    </sensor>"
+      "  </link>"
+      "</model>"
+      "</sdf>");
+
+  sensors::CameraSensorPtr sensor;
+  int sleep = 0;
+  while (sleep++ < 50 && !sensor)
+  {
+    sensor = std::dynamic_pointer_cast<sensors::CameraSensor>(
+        sensors::SensorManager::Instance()->GetSensor(
+          "default::lazy_camera::body::camera"));
+    common::Time::MSleep(100);
+  }
+  ASSERT_TRUE(sensor != nullptr);
+  EXPECT_TRUE(sensor->Lazy());
+  EXPECT_DOUBLE_EQ(0.0, sensor->LazyIdleTime());
+
+  // Nothing is created while the sensor is inactive, and the image size
+  // comes from the SDF
+  EXPECT_FALSE(sensor->IsActive());
+  common::Time::MSleep(500);
+  EXPECT_FALSE(sensor->ResourcesCreated());
+  EXPECT_TRUE(sensor->Camera() == nullptr);
+  EXPECT_EQ(160u, sensor->ImageWidth());
+  EXPECT_EQ(120u, sensor->ImageHeight());
+
+  // The camera is created when the sensor becomes active
+  sensor->SetActive(true);
+  sleep = 0;
+  while (sleep++ < 50 && !sensor->ImageData())
+    common::Time::MSleep(100);
+  EXPECT_TRUE(sensor->ResourcesCreated());
+  EXPECT_TRUE(sensor->Camera() != nullptr);
+  EXPECT_TRUE(sensor->ImageData() != nullptr);
+
+  // And released once it has been idle
+  sensor->SetActive(false);
+  sleep = 0;
+  while (sleep++ < 50 && sensor->ResourcesCreated())
+    common::Time::MSleep(100);
+  EXPECT_FALSE(sensor->ResourcesCreated());
+  EXPECT_TRUE(sensor->Camera() == nullptr);
+}
+
+/////////////////////////////////////////////////
+std::mutex g_compressedMutex;
+boost::shared_ptr<const msgs::CompressedImageStamped> g_compressedMsg;
+
+/////////////////////////////////////////////////
+void OnCompressedImage(ConstCompressedImageStampedPtr &_msg)
+{
+  std::lock_guard<std::mutex> lock(g_compressedMutex);
+  g_compressedMsg = _msg;
+}
+
+/////////////////////////////////////////////////
+TEST_F(CameraSensor_TEST, CompressedImages)
+{
+  this->Load("worlds/empty.world");
+  this->SpawnCamera("camera", "camera", ignition::math::Vector3d::Zero,
+      ignition::math::Vector3d::Zero);
+
+  sensors::CameraSensorPtr sensor =
+     std::dynamic_pointer_cast<sensors::CameraSensor>(
+       sensors::SensorManager::Instance()->GetSensor(
+         "default::camera::body::camera"));
+  ASSERT_TRUE(sensor != nullptr);
+
+  // Disabled by default
+  EXPECT_TRUE(sensor->ImageEncoding().empty());
+  EXPECT_TRUE(sensor->CompressedTopic().empty());
+
+  // Unknown encodings are rejected
+  sensor->SetImageEncoding("bmp");
+  EXPECT_TRUE(sensor->ImageEncoding().empty());
+
+  sensor->SetImageEncoding("jpeg", 80);
+  EXPECT_EQ("jpeg", sensor->ImageEncoding());
+  EXPECT_EQ(sensor->Topic() + "/compressed", sensor->CompressedTopic());
+
+  transport::NodePtr node(new transport::Node());
+  node->Init();
+  transport::SubscriberPtr sub =
+      node->Subscribe(sensor->CompressedTopic(), &OnCompressedImage);
+
+  int sleep = 0;
+  bool received = false;
+  while (sleep++ < 50 && !received)
+  {
+    common::Time::MSleep(100);
+    std::lock_guard<std::mutex> lock(g_compressedMutex);
+    received = g_compressedMsg != nullptr;
+  }
+  ASSERT_TRUE(received);
+
+  {
+    std::lock_guard<std::mutex> lock(g_compressedMutex);
+    EXPECT_EQ("jpeg", g_compressedMsg->format());
+    EXPECT_EQ(320u, g_compressedMsg->width());
+    EXPECT_EQ(240u, g_compressedMsg->height());
+    ASSERT_GT(g_compressedMsg->data().size(), 2u);
+    EXPECT_EQ(std::string("\xFF\xD8", 2),
+        g_compressedMsg->data().substr(0, 2));
+    EXPECT_LT(g_compressedMsg->data().size(), 320u * 240u * 3u);
+  }
+
+  sensor->SetImageEncoding("");
+  EXPECT_TRUE(sensor->ImageEncoding().empty());
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
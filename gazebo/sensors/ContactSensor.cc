@@ -15,6 +15,7 @@
  *
 */
 #include <boost/algorithm/string.hpp>
+#include <functional>
 #include <sstream>
 
 #include <ignition/common/Profiler.hh>
@@ -111,16 +112,12 @@ void ContactSensor::Load(const std::string &_worldName)
 
   if (!this->dataPtr->collisions.empty())
   {
-    // request the contact manager to publish messages to a custom topic for
-    // this sensor
+    // request the contact manager to filter the contacts of this sensor's
+    // collisions, and to hand them directly to this sensor
     physics::ContactManager *mgr = this->world->Physics()->GetContactManager();
-    std::string topic = mgr->CreateFilter(this->dataPtr->filterName,
-        this->dataPtr->collisions);
-    if (!this->dataPtr->contactSub)
-    {
-      this->dataPtr->contactSub = this->node->Subscribe(topic,
-          &ContactSensor::OnContacts, this);
-    }
+    mgr->CreateFilter(this->dataPtr->filterName, this->dataPtr->collisions);
+    mgr->SetFilterCallback(this->dataPtr->filterName,
+        std::bind(&ContactSensor::OnContacts, this, std::placeholders::_1));
   }
 }
 
@@ -142,9 +139,6 @@ bool ContactSensor::UpdateImpl(const bool /*_force*/)
   if (this->dataPtr->incomingContacts.empty())
     return false;
 
-  std::vector<std::string>::iterator collIter;
-  std::string collision1;
-
   // Clear the outgoing contact message.
   this->dataPtr->contactsMsg.clear_contact();
 
@@ -152,42 +146,24 @@ bool ContactSensor::UpdateImpl(const bool /*_force*/)
   for (auto iter = this->dataPtr->incomingContacts.begin();
        iter != this->dataPtr->incomingContacts.end(); ++iter)
   {
-    // Iterate over all the contacts in the message
+    // Iterate over all the contacts in the message. The contact manager
+    // only hands out contacts of the collisions monitored by this sensor.
     for (int i = 0; i < (*iter)->contact_size(); ++i)
     {
-      collision1 = (*iter)->contact(i).collision1();
-
-      // Try to find the first collision's name
-      collIter = std::find(this->dataPtr->collisions.begin(),
-          this->dataPtr->collisions.end(), collision1);
+      int count = (*iter)->contact(i).position_size();
 
-      // If unable to find the first collision's name, try the second
-      if (collIter == this->dataPtr->collisions.end())
+      // Check to see if the contact arrays all have the same size.
+      if (count != (*iter)->contact(i).normal_size() ||
+          count != (*iter)->contact(i).wrench_size() ||
+          count != (*iter)->contact(i).depth_size())
       {
-        collision1 = (*iter)->contact(i).collision2();
-        collIter = std::find(this->dataPtr->collisions.begin(),
-            this->dataPtr->collisions.end(), collision1);
+        gzerr << "Contact message has invalid array sizes\n";
+        continue;
       }
 
-      // If this sensor is monitoring one of the collision's in the
-      // contact, then add the contact to our outgoing message.
-      if (collIter != this->dataPtr->collisions.end())
-      {
-        int count = (*iter)->contact(i).position_size();
-
-        // Check to see if the contact arrays all have the same size.
-        if (count != (*iter)->contact(i).normal_size() ||
-            count != (*iter)->contact(i).wrench_size() ||
-            count != (*iter)->contact(i).depth_size())
-        {
-          gzerr << "Contact message has invalid array sizes\n";
-          continue;
-        }
-
-        // Copy the contact message.
-        msgs::Contact *contactMsg = this->dataPtr->contactsMsg.add_contact();
-        contactMsg->CopyFrom((*iter)->contact(i));
-      }
+      // Copy the contact message.
+      msgs::Contact *contactMsg = this->dataPtr->contactsMsg.add_contact();
+      contactMsg->CopyFrom((*iter)->contact(i));
     }
   }
 
@@ -215,14 +191,18 @@ bool ContactSensor::UpdateImpl(const bool /*_force*/)
 //////////////////////////////////////////////////
 void ContactSensor::Fini()
 {
-  if (this->world && this->world->Running())
+  physics::ContactManager *mgr = nullptr;
+  if (this->world && this->world->Physics())
+    mgr = this->world->Physics()->GetContactManager();
+
+  if (mgr)
   {
-    physics::ContactManager *mgr =
-        this->world->Physics()->GetContactManager();
-    mgr->RemoveFilter(this->dataPtr->filterName);
+    if (this->world->Running())
+      mgr->RemoveFilter(this->dataPtr->filterName);
+    else
+      mgr->SetFilterCallback(this->dataPtr->filterName, nullptr);
   }
 
-  this->dataPtr->contactSub.reset();
   this->dataPtr->contactsPub.reset();
   Sensor::Fini();
 }
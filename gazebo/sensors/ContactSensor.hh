@@ -94,10 +94,10 @@ namespace gazebo
       /// to publish all contacts generated within a timestep onto
       /// Gazebo topic ~/physics/contacts.
       ///
-      /// Each ContactSensor subscribes to the Gazebo ~/physics/contacts topic,
-      /// retrieves all contact pairs in a time step and filters them wthin
-      /// ContactSensor::OnContacts against <collision> body name
-      /// specified by the ContactSensor SDF.
+      /// Each ContactSensor creates a contact filter in the ContactManager
+      /// for the <collision> bodies specified by the ContactSensor SDF.
+      /// ContactManager::PublishContacts hands the contact pairs of these
+      /// collisions in a time step directly to ContactSensor::OnContacts.
       /// All collision pairs between ContactSensor <collision> body and
       /// other bodies in the world are stored in an array inside
       /// contacts.proto.
@@ -14,10 +14,20 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <functional>
+#include <limits>
+#include <unordered_set>
 
 #include "ignition/common/Profiler.hh"
 
+#include "gazebo/common/CommonIface.hh"
+#include "gazebo/msgs/msgs.hh"
+
 #include "gazebo/physics/World.hh"
 
 #include "gazebo/rendering/DepthCamera.hh"
@@ -37,6 +47,21 @@ using namespace sensors;
 
 GZ_REGISTER_STATIC_SENSOR("depth", DepthCameraSensor)
 
+//////////////////////////////////////////////////
+/// \brief Add a single float field to a packed point cloud.
+/// \param[in] _name Name of the field.
+/// \param[in] _offset Offset of the field in a point, in bytes.
+/// \param[in,out] _msg The point cloud.
+static void AddFloatField(const std::string &_name, const uint32_t _offset,
+    msgs::PointCloudPacked &_msg)
+{
+  msgs::PointCloudPacked::Field *field = _msg.add_field();
+  field->set_name(_name);
+  field->set_offset(_offset);
+  field->set_datatype(msgs::PointCloudPacked::Field::FLOAT32);
+  field->set_count(1);
+}
+
 //////////////////////////////////////////////////
 DepthCameraSensor::DepthCameraSensor()
     : CameraSensor(),
@@ -55,6 +80,37 @@ DepthCameraSensor::~DepthCameraSensor()
 void DepthCameraSensor::Load(const std::string &_worldName)
 {
   CameraSensor::Load(_worldName);
+
+  // Packed point clouds, published when the camera outputs points
+  const std::string kElementName = "ignition:point_cloud";
+  if (this->sdf->HasElement(kElementName))
+  {
+    sdf::ElementPtr elem = this->sdf->GetElement(kElementName);
+    if (elem->HasElement("frame"))
+    {
+      const std::string frame = elem->Get<std::string>("frame");
+      if (frame != "camera" && frame != "world")
+      {
+        gzwarn << "Unknown point cloud frame [" << frame
+               << "], using [camera]" << std::endl;
+      }
+      this->dataPtr->pointsWorldFrame = frame == "world";
+    }
+    if (elem->HasElement("organized"))
+      this->dataPtr->pointsOrganized = elem->Get<bool>("organized");
+    if (elem->HasElement("voxel_size"))
+    {
+      this->dataPtr->pointsVoxelSize =
+        std::max(0.0, elem->Get<double>("voxel_size"));
+    }
+
+    std::string topicName = "~/";
+    topicName += this->ParentName() + "/" + this->Name() + "/points";
+    common::replaceAll(topicName, topicName, "::", "/");
+
+    this->dataPtr->pointsPub =
+      this->node->Advertise<msgs::PointCloudPacked>(topicName, 50);
+  }
 }
 
 //////////////////////////////////////////////////
@@ -90,6 +146,19 @@ void DepthCameraSensor::Init()
     sdf::ElementPtr cameraSdf = this->sdf->GetElement("camera");
     this->dataPtr->depthCamera->Load(cameraSdf);
 
+    if (this->dataPtr->pointsPub)
+    {
+      const std::string outputs = cameraSdf->GetElement("depth_camera")->
+          Get<std::string>("output");
+      if (outputs.find("points") == std::string::npos)
+      {
+        gzwarn << "Depth camera [" << this->Name() << "] has an "
+               << "<ignition:point_cloud> element but does not output "
+               << "points, no point cloud will be published" << std::endl;
+      }
+      this->ConnectPoints();
+    }
+
     // Do some sanity checks
     if (this->dataPtr->depthCamera->ImageWidth() == 0u ||
         this->dataPtr->depthCamera->ImageHeight() == 0u)
@@ -141,7 +210,9 @@ bool DepthCameraSensor::UpdateImpl(const bool /*_force*/)
     return false;
 
   IGN_PROFILE_BEGIN("PostRender");
+  auto start = std::chrono::steady_clock::now();
   this->camera->PostRender();
+  this->AddStageDuration(SENSOR_STAGE_READBACK, start);
   IGN_PROFILE_END();
 
   IGN_PROFILE_BEGIN("fillarray");
@@ -151,17 +222,18 @@ bool DepthCameraSensor::UpdateImpl(const bool /*_force*/)
       // generating point clouds instead
       this->dataPtr->depthCamera->DepthData())
   {
-    msgs::ImageStamped msg;
-    msgs::Set(msg.mutable_time(), this->scene->SimTime());
-    msg.mutable_image()->set_width(this->camera->ImageWidth());
-    msg.mutable_image()->set_height(this->camera->ImageHeight());
-    msg.mutable_image()->set_pixel_format(common::Image::R_FLOAT32);
+    start = std::chrono::steady_clock::now();
+    boost::shared_ptr<msgs::ImageStamped> msg(new msgs::ImageStamped);
+    msgs::Set(msg->mutable_time(), this->scene->SimTime());
+    msg->mutable_image()->set_width(this->camera->ImageWidth());
+    msg->mutable_image()->set_height(this->camera->ImageHeight());
+    msg->mutable_image()->set_pixel_format(common::Image::R_FLOAT32);
 
 
-    msg.mutable_image()->set_step(this->camera->ImageWidth() *
+    msg->mutable_image()->set_step(this->camera->ImageWidth() *
         this->camera->ImageDepth());
 
-    unsigned int depthSamples = msg.image().width() * msg.image().height();
+    unsigned int depthSamples = msg->image().width() * msg->image().height();
     float f;
     // cppchecker recommends using sizeof(varname)
     unsigned int depthBufferSize = depthSamples * sizeof(f);
@@ -184,8 +256,9 @@ bool DepthCameraSensor::UpdateImpl(const bool /*_force*/)
         this->dataPtr->depthBuffer[i] = -ignition::math::INF_D;
       }
     }
-    msg.mutable_image()->set_data(this->dataPtr->depthBuffer, depthBufferSize);
+    msg->mutable_image()->set_data(this->dataPtr->depthBuffer, depthBufferSize);
     this->imagePub->Publish(msg);
+    this->AddStageDuration(SENSOR_STAGE_PUBLISH, start);
   }
 
   this->SetRendered(false);
@@ -193,6 +266,142 @@ bool DepthCameraSensor::UpdateImpl(const bool /*_force*/)
   return true;
 }
 
+//////////////////////////////////////////////////
+void DepthCameraSensor::ConnectPoints()
+{
+  this->dataPtr->pointsConnection =
+    this->dataPtr->depthCamera->ConnectNewRGBPointCloud(
+        std::bind(&DepthCameraSensor::OnNewRGBPointCloud, this,
+          std::placeholders::_1, std::placeholders::_2,
+          std::placeholders::_3, std::placeholders::_4,
+          std::placeholders::_5));
+}
+
+//////////////////////////////////////////////////
+bool DepthCameraSensor::HasListeners()
+{
+  // The point cloud callback of the sensor is a frame listener of the depth
+  // camera, keep it connected only while the point cloud has subscribers.
+  bool points = false;
+  if (this->dataPtr->pointsPub && this->dataPtr->depthCamera)
+  {
+    points = this->dataPtr->pointsPub->HasConnections();
+    if (!points)
+      this->dataPtr->pointsConnection.reset();
+    else if (!this->dataPtr->pointsConnection)
+      this->ConnectPoints();
+  }
+
+  return points || CameraSensor::HasListeners();
+}
+
+//////////////////////////////////////////////////
+void DepthCameraSensor::OnNewRGBPointCloud(const float *_pcd,
+    unsigned int _width, unsigned int _height, unsigned int /*_depth*/,
+    const std::string &/*_format*/)
+{
+  if (!this->dataPtr->pointsPub->HasConnections())
+    return;
+
+  auto start = std::chrono::steady_clock::now();
+
+  IGN_PROFILE("DepthCameraSensor::OnNewRGBPointCloud");
+
+  const double voxelSize = this->dataPtr->pointsVoxelSize;
+  const bool organized = this->dataPtr->pointsOrganized && voxelSize <= 0.0;
+  const bool worldFrame = this->dataPtr->pointsWorldFrame;
+  const double nearClip = this->camera->NearClip();
+  const double farClip = this->camera->FarClip();
+  const ignition::math::Pose3d pose = this->camera->WorldPose();
+
+  // Same layout as the GPU points: x, y, z and rgb, 16 bytes per point
+  const uint32_t pointStep = 4 * sizeof(float);
+
+  boost::shared_ptr<msgs::PointCloudPacked> msg(new msgs::PointCloudPacked);
+  msgs::Set(msg->mutable_time(), this->scene->SimTime());
+  msg->set_frame(worldFrame ? "world" : this->ScopedName());
+  AddFloatField("x", 0, *msg);
+  AddFloatField("y", 4, *msg);
+  AddFloatField("z", 8, *msg);
+  AddFloatField("rgb", 12, *msg);
+  msg->set_is_bigendian(false);
+  msg->set_point_step(pointStep);
+
+  const size_t pixels = static_cast<size_t>(_width) * _height;
+  std::string *data = msg->mutable_data();
+  data->resize(pixels * pointStep);
+
+  // Voxels that already have a point
+  std::unordered_set<int64_t> voxels;
+
+  bool dense = true;
+  size_t count = 0;
+  for (size_t i = 0; i < pixels; ++i)
+  {
+    const float *p = _pcd + 4 * i;
+    float point[4];
+
+    // The optical z axis is the depth, the background has none
+    if (!(p[2] > nearClip && p[2] < farClip))
+    {
+      if (!organized)
+        continue;
+      point[0] = point[1] = point[2] =
+        std::numeric_limits<float>::quiet_NaN();
+      point[3] = 0.0f;
+      dense = false;
+    }
+    else
+    {
+      ignition::math::Vector3d pos(p[0], p[1], p[2]);
+
+      // From x right, y down, z forward to the camera frame, then to world
+      if (worldFrame)
+        pos = pose.CoordPositionAdd(ignition::math::Vector3d(p[2], -p[0],
+              -p[1]));
+
+      if (voxelSize > 0.0)
+      {
+        int64_t key = 0;
+        for (int k = 0; k < 3; ++k)
+        {
+          key = (key << 21) | (static_cast<int64_t>(
+                std::floor(pos[k] / voxelSize)) & 0x1FFFFF);
+        }
+        if (!voxels.insert(key).second)
+          continue;
+      }
+
+      point[0] = static_cast<float>(pos.X());
+      point[1] = static_cast<float>(pos.Y());
+      point[2] = static_cast<float>(pos.Z());
+
+      // Decode the color as documented by DepthCamera, and store it as
+      // 0x00RRGGBB bits, as PointCloud2 consumers expect
+      const uint32_t red = static_cast<uint32_t>(
+          std::floor(p[3] / 256.0f / 256.0f));
+      const uint32_t green = static_cast<uint32_t>(
+          std::floor((p[3] - red * 256.0f * 256.0f) / 256.0f));
+      const uint32_t blue = static_cast<uint32_t>(
+          std::floor(p[3] - red * 256.0f * 256.0f - green * 256.0f));
+      const uint32_t rgb = (red << 16) | (green << 8) | blue;
+      std::memcpy(&point[3], &rgb, sizeof(rgb));
+    }
+
+    std::memcpy(&(*data)[count * pointStep], point, pointStep);
+    ++count;
+  }
+  data->resize(count * pointStep);
+
+  msg->set_height(organized ? _height : 1);
+  msg->set_width(organized ? _width : static_cast<uint32_t>(count));
+  msg->set_row_step(msg->width() * pointStep);
+  msg->set_is_dense(dense);
+
+  this->dataPtr->pointsPub->Publish(msg);
+  this->AddStageDuration(SENSOR_STAGE_PUBLISH, start);
+}
+
 //////////////////////////////////////////////////
 const float *DepthCameraSensor::DepthData() const
 {
@@ -66,6 +66,25 @@ namespace gazebo
       // Documentation inherited
       protected: virtual bool UpdateImpl(const bool _force);
 
+      // Documentation inherited
+      protected: virtual bool HasListeners() override;
+
+      /// \brief Connect the point cloud callback of the sensor to the
+      /// depth camera.
+      private: void ConnectPoints();
+
+      /// \brief Pack and publish a point cloud of the depth camera.
+      /// \param[in] _pcd Points, four floats per pixel: x, y, z in the
+      /// optical frame and the color, see
+      /// rendering::DepthCamera::ConnectNewRGBPointCloud.
+      /// \param[in] _width Width of the point cloud.
+      /// \param[in] _height Height of the point cloud.
+      /// \param[in] _depth Depth of the point cloud.
+      /// \param[in] _format Format of the point cloud.
+      private: void OnNewRGBPointCloud(const float *_pcd,
+                   unsigned int _width, unsigned int _height,
+                   unsigned int _depth, const std::string &_format);
+
       /// \internal
       /// \brief Private data pointer
       private: std::unique_ptr<DepthCameraSensorPrivate> dataPtr;
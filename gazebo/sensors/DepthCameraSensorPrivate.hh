@@ -17,7 +17,9 @@
 #ifndef _GAZEBO_SENSORS_DEPTHCAMERASENSOR_PRIVATE_HH_
 #define _GAZEBO_SENSORS_DEPTHCAMERASENSOR_PRIVATE_HH_
 
+#include "gazebo/common/Event.hh"
 #include "gazebo/rendering/RenderTypes.hh"
+#include "gazebo/transport/TransportTypes.hh"
 
 namespace gazebo
 {
@@ -32,6 +34,25 @@ namespace gazebo
 
       /// \brief Local pointer to the depthCamera.
       public: rendering::DepthCameraPtr depthCamera;
+
+      /// \brief Publisher of packed point clouds, null unless the sensor
+      /// has an <ignition:point_cloud> element.
+      public: transport::PublisherPtr pointsPub;
+
+      /// \brief Connection to the point clouds of the depth camera.
+      public: event::ConnectionPtr pointsConnection;
+
+      /// \brief True to publish the points in the world frame rather than
+      /// in the optical frame of the camera.
+      public: bool pointsWorldFrame = false;
+
+      /// \brief True to publish one point per pixel, invalid points
+      /// included, rather than only the valid points.
+      public: bool pointsOrganized = true;
+
+      /// \brief Edge of the voxels used to downsample the points, zero to
+      /// keep all of them.
+      public: double pointsVoxelSize = 0.0;
     };
   }
 }
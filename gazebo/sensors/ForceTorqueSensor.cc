@@ -39,7 +39,7 @@ GZ_REGISTER_STATIC_SENSOR("force_torque", ForceTorqueSensor)
 
 //////////////////////////////////////////////////
 ForceTorqueSensor::ForceTorqueSensor()
-: Sensor(sensors::OTHER),
+: Sensor(sensors::INLINE),
   dataPtr(new ForceTorqueSensorPrivate)
 {
 }
@@ -163,6 +163,10 @@ void ForceTorqueSensor::Load(const std::string &_worldName)
 
   this->dataPtr->wrenchPub =
     this->node->Advertise<msgs::WrenchStamped>(this->Topic());
+
+  const std::string kBatchPeriod = "ignition:batch_period";
+  if (this->sdf->HasElement(kBatchPeriod))
+    this->SetBatchPeriod(this->sdf->Get<double>(kBatchPeriod));
 }
 
 //////////////////////////////////////////////////
@@ -176,6 +180,7 @@ void ForceTorqueSensor::Init()
 void ForceTorqueSensor::Fini()
 {
   this->dataPtr->wrenchPub.reset();
+  this->dataPtr->batchPub.reset();
   this->dataPtr->parentJoint.reset();
 
   Sensor::Fini();
@@ -276,15 +281,85 @@ bool ForceTorqueSensor::UpdateImpl(const bool /*_force*/)
 
   if (this->dataPtr->wrenchPub)
     this->dataPtr->wrenchPub->Publish(this->dataPtr->wrenchMsg);
+  if (this->dataPtr->batchPub)
+    this->AddBatchSample();
   IGN_PROFILE_END();
 
   return true;
 }
 
+//////////////////////////////////////////////////
+void ForceTorqueSensor::AddBatchSample()
+{
+  msgs::WrenchBatch &batch = this->dataPtr->batchMsg;
+  const common::SimTimeNs time(this->lastMeasurementTime);
+
+  // The samples of a period are published with the first sample of the
+  // next one
+  if (batch.time_ns_size() > 0 &&
+      time - this->dataPtr->batchStart >= this->dataPtr->batchPeriod)
+  {
+    this->dataPtr->batchPub->Publish(batch);
+    batch.Clear();
+  }
+
+  if (!this->dataPtr->batchPub->HasConnections())
+    return;
+
+  if (batch.time_ns_size() == 0)
+    this->dataPtr->batchStart = time;
+
+  const msgs::Wrench &sample = this->dataPtr->wrenchMsg.wrench();
+  batch.add_time_ns(time.Nanoseconds());
+  batch.add_force(sample.force().x());
+  batch.add_force(sample.force().y());
+  batch.add_force(sample.force().z());
+  batch.add_torque(sample.torque().x());
+  batch.add_torque(sample.torque().y());
+  batch.add_torque(sample.torque().z());
+}
+
+//////////////////////////////////////////////////
+void ForceTorqueSensor::SetBatchPeriod(const double _period)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->batchMsg.Clear();
+  if (_period <= 0.0)
+  {
+    this->dataPtr->batchPeriod = common::SimTimeNs();
+    this->dataPtr->batchPub.reset();
+    return;
+  }
+
+  this->dataPtr->batchPeriod = common::SimTimeNs::FromSeconds(_period);
+  if (!this->dataPtr->batchPub)
+  {
+    this->dataPtr->batchPub = this->node->Advertise<msgs::WrenchBatch>(
+        this->Topic() + "/batch", 50);
+  }
+}
+
+//////////////////////////////////////////////////
+double ForceTorqueSensor::BatchPeriod() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->batchPeriod.Double();
+}
+
+//////////////////////////////////////////////////
+std::string ForceTorqueSensor::BatchTopic() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (!this->dataPtr->batchPub)
+    return std::string();
+  return this->dataPtr->batchPub->GetTopic();
+}
+
 //////////////////////////////////////////////////
 bool ForceTorqueSensor::IsActive() const
 {
-  return Sensor::IsActive() || this->dataPtr->wrenchPub->HasConnections();
+  return Sensor::IsActive() || this->dataPtr->wrenchPub->HasConnections() ||
+      (this->dataPtr->batchPub && this->dataPtr->batchPub->HasConnections());
 }
 
 //////////////////////////////////////////////////
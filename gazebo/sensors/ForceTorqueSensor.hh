@@ -82,9 +82,34 @@ namespace gazebo
       public: event::ConnectionPtr ConnectUpdate(
                   std::function<void (msgs::WrenchStamped)> _subscriber);
 
+      /// \brief Publish the samples in batches as well, e.g. for rates
+      /// where the cost of a message per sample dominates. A batch is a
+      /// msgs::WrenchBatch with the consecutive samples of a period of sim
+      /// time, published on Topic() followed by "/batch" with the first
+      /// sample of the next period. The samples are only collected while
+      /// the batch topic has subscribers. The period is also set by the
+      /// <ignition:batch_period> element of the sensor.
+      /// \param[in] _period Sim time covered by a batch in seconds, 0 to
+      /// disable the batches.
+      /// \sa BatchPeriod
+      public: void SetBatchPeriod(const double _period);
+
+      /// \brief Get the sim time covered by a batch of samples.
+      /// \return The period in seconds, 0 if batches are disabled.
+      /// \sa SetBatchPeriod
+      public: double BatchPeriod() const;
+
+      /// \brief Get the topic of the batches.
+      /// \return The topic, empty if batches are disabled.
+      public: std::string BatchTopic() const;
+
       // Documentation inherited.
       protected: virtual bool UpdateImpl(const bool _force);
 
+      /// \brief Add the current sample to the batch, and publish the
+      /// batch when its period is over. The mutex must be locked.
+      private: void AddBatchSample();
+
       // Documentation inherited.
       protected: virtual void Fini();
 
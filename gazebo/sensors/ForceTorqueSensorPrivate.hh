@@ -20,6 +20,8 @@
 #include <mutex>
 #include <ignition/math/Matrix3.hh>
 
+#include "gazebo/common/SimTimeNs.hh"
+#include "gazebo/msgs/wrench_batch.pb.h"
 #include "gazebo/physics/PhysicsTypes.hh"
 #include "gazebo/transport/TransportTypes.hh"
 
@@ -44,7 +46,7 @@ namespace gazebo
       public: msgs::WrenchStamped wrenchMsg;
 
       /// \brief Mutex to protect the wrench message
-      public: std::mutex mutex;
+      public: mutable std::mutex mutex;
 
       /// \brief Which orientation we support for returning sensor measure
       public: enum MeasureFrame
@@ -66,6 +68,18 @@ namespace gazebo
       ///        orientation in a vector expressed in joint orientation.
       ///        Necessary is the measure is specified in joint frame.
       public: ignition::math::Matrix3d rotationSensorChild;
+
+      /// \brief Sim time covered by a batch of samples, 0 if disabled.
+      public: common::SimTimeNs batchPeriod;
+
+      /// \brief Batch publisher, null if disabled.
+      public: transport::PublisherPtr batchPub;
+
+      /// \brief Samples of the batch being collected.
+      public: msgs::WrenchBatch batchMsg;
+
+      /// \brief Sim time of the first sample of the batch.
+      public: common::SimTimeNs batchStart;
     };
   }
 }
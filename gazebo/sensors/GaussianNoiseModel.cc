@@ -14,6 +14,9 @@
  * limitations under the License.
  *
 */
+#include <atomic>
+#include <cmath>
+
 #include <ignition/math/Helpers.hh>
 #include <ignition/math/Rand.hh>
 
@@ -79,6 +82,58 @@ namespace gazebo
 using namespace gazebo;
 using namespace sensors;
 
+/// \brief Number of Gaussian noise models created, used to give each model
+/// its own generator stream.
+static std::atomic<uint64_t> g_gaussianNoiseModels(0);
+
+//////////////////////////////////////////////////
+/// \brief SplitMix64 step, used to expand a seed into a generator state.
+/// \param[in,out] _x State of the sequence.
+/// \return The next value.
+static uint64_t SplitMix64(uint64_t &_x)
+{
+  uint64_t z = (_x += 0x9e3779b97f4a7c15ull);
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+  return z ^ (z >> 31);
+}
+
+//////////////////////////////////////////////////
+/// \brief Rotate left.
+/// \param[in] _x Value.
+/// \param[in] _k Number of bits.
+/// \return The rotated value.
+static inline uint64_t Rotl(const uint64_t _x, const int _k)
+{
+  return (_x << _k) | (_x >> (64 - _k));
+}
+
+//////////////////////////////////////////////////
+/// \brief Xoshiro256** step.
+/// \param[in,out] _s State of the generator.
+/// \return The next value.
+static inline uint64_t Xoshiro256(uint64_t *_s)
+{
+  const uint64_t result = Rotl(_s[1] * 5, 7) * 9;
+  const uint64_t t = _s[1] << 17;
+  _s[2] ^= _s[0];
+  _s[3] ^= _s[1];
+  _s[1] ^= _s[2];
+  _s[0] ^= _s[3];
+  _s[2] ^= t;
+  _s[3] = Rotl(_s[3], 45);
+  return result;
+}
+
+//////////////////////////////////////////////////
+/// \brief Uniform sample in (0, 1].
+/// \param[in,out] _s State of the generator.
+/// \return The sample.
+static inline double Uniform(uint64_t *_s)
+{
+  return ((Xoshiro256(_s) >> 11) + 1) * (1.0 / 9007199254740992.0);
+}
+
 //////////////////////////////////////////////////
 GaussianNoiseModel::GaussianNoiseModel()
   : Noise(Noise::GAUSSIAN),
@@ -92,6 +147,9 @@ GaussianNoiseModel::GaussianNoiseModel()
     dynamicBiasStdDev(0),
     dynamicBiasCorrTime(0)
 {
+  this->SetBatchSeed(
+      (static_cast<uint64_t>(ignition::math::Rand::Seed()) << 32) ^
+      g_gaussianNoiseModels++);
 }
 
 //////////////////////////////////////////////////
@@ -184,6 +242,64 @@ double GaussianNoiseModel::ApplyImpl(double _in, double _dt)
   return output;
 }
 
+//////////////////////////////////////////////////
+void GaussianNoiseModel::ApplyBatchImpl(double *_values, const size_t _count,
+    const double _dt)
+{
+  const bool dynamicBias = this->dynamicBiasStdDev > 0 &&
+      this->dynamicBiasCorrTime > 0;
+
+  // Standard normal samples by pairs, with the Box-Muller transform. The
+  // dynamic bias needs a second sample per value.
+  const size_t sampleCount = dynamicBias ? 2 * _count : _count;
+  this->normals.resize(sampleCount + 1);
+  double *normals = this->normals.data();
+  for (size_t i = 0; i < sampleCount; i += 2)
+  {
+    const double r = std::sqrt(-2.0 * std::log(Uniform(this->rngState)));
+    const double theta = 2.0 * IGN_PI * Uniform(this->rngState);
+    normals[i] = r * std::cos(theta);
+    normals[i + 1] = r * std::sin(theta);
+  }
+
+  if (dynamicBias)
+  {
+    // See ApplyImpl
+    const double sigmaB = this->dynamicBiasStdDev;
+    const double tau = this->dynamicBiasCorrTime;
+    const double sigmaBD = sqrt(-sigmaB * sigmaB *
+        tau / 2 * expm1(-2 * _dt / tau));
+    const double phiD = exp(-_dt / tau);
+    for (size_t i = 0; i < _count; ++i)
+    {
+      this->bias = phiD * this->bias + sigmaBD * normals[_count + i];
+      _values[i] += this->bias + this->mean + this->stdDev * normals[i];
+    }
+  }
+  else
+  {
+    const double offset = this->bias + this->mean;
+    const double stdDev = this->stdDev;
+    for (size_t i = 0; i < _count; ++i)
+      _values[i] += offset + stdDev * normals[i];
+  }
+
+  if (this->quantized)
+  {
+    const double precision = this->precision;
+    for (size_t i = 0; i < _count; ++i)
+      _values[i] = std::round(_values[i] / precision) * precision;
+  }
+}
+
+//////////////////////////////////////////////////
+void GaussianNoiseModel::SetBatchSeed(const uint64_t _seed)
+{
+  uint64_t x = _seed;
+  for (auto &s : this->rngState)
+    s = SplitMix64(x);
+}
+
 //////////////////////////////////////////////////
 double GaussianNoiseModel::GetMean() const
 {
@@ -18,6 +18,7 @@
 #ifndef _GAZEBO_GAUSSIAN_NOISE_MODEL_HH_
 #define _GAZEBO_GAUSSIAN_NOISE_MODEL_HH_
 
+#include <cstdint>
 #include <vector>
 #include <string>
 
@@ -57,6 +58,21 @@ namespace gazebo
         // Documentation inherited.
         public: double ApplyImpl(double _in, double _dt);
 
+        /// \brief Apply noise to an array of values. The samples come from
+        /// a generator of the model, instead of the global generator used by
+        /// ApplyImpl. The generator is seeded from the global seed, see
+        /// ignition::math::Rand::Seed, and from the order in which the models
+        /// are created, so runs with the same seed are repeatable.
+        /// \param[in,out] _values The values.
+        /// \param[in] _count Number of values.
+        /// \param[in] _dt Time step of the values.
+        public: virtual void ApplyBatchImpl(double *_values,
+                    const size_t _count, const double _dt);
+
+        /// \brief Seed the generator used by ApplyBatchImpl.
+        /// \param[in] _seed The seed.
+        public: void SetBatchSeed(const uint64_t _seed);
+
         /// \brief Accessor for mean.
         /// \return Mean of Gaussian noise.
         public: double GetMean() const;
@@ -132,6 +148,12 @@ namespace gazebo
         /// \biref If type starts with GAUSSIAN, the correlation time of the
         /// process from which the dynamic bias will be driven.
         private: double dynamicBiasCorrTime;
+
+        /// \brief State of the generator used by ApplyBatchImpl.
+        private: uint64_t rngState[4];
+
+        /// \brief Normal samples of the current batch.
+        private: std::vector<double> normals;
     };
 
     /// \class GaussianNoiseModel
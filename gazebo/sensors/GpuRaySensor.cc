@@ -16,7 +16,10 @@
 */
 #include <boost/algorithm/string.hpp>
 #include <ignition/common/Profiler.hh>
+#include <algorithm>
+#include <chrono>
 #include <functional>
+#include <limits>
 #include <ignition/math.hh>
 #include <ignition/math/Helpers.hh>
 #include "gazebo/physics/World.hh"
@@ -102,6 +105,10 @@ void GpuRaySensor::Load(const std::string &_worldName)
           boost::bind(&GpuRaySensor::PrerenderEnded, this)));
   }
 
+  const std::string kElementName = "ignition:render_on_demand";
+  if (this->sdf->HasElement(kElementName))
+    this->dataPtr->renderOnDemand = this->sdf->Get<bool>(kElementName);
+
   this->dataPtr->scanPub =
     this->node->Advertise<msgs::LaserScanStamped>(this->Topic(), 50);
 
@@ -372,7 +379,7 @@ void GpuRaySensor::SetActive(bool _value)
   {
     // the next rendering time must be reset to ensure it is properly
     // computed by GpuRaySensor::NeedsUpdate.
-    this->dataPtr->nextRenderingTime = std::numeric_limits<double>::quiet_NaN();
+    this->dataPtr->nextRenderingTime.reset();
   }
   Sensor::SetActive(_value);
 }
@@ -382,13 +389,13 @@ bool GpuRaySensor::NeedsUpdate()
 {
   if (this->useStrictRate)
   {
-    double simTime;
+    common::SimTimeNs simTime;
     if (this->scene)
-      simTime = this->scene->SimTime().Double();
+      simTime = common::SimTimeNs(this->scene->SimTime());
     else
-      simTime = this->world->SimTime().Double();
+      simTime = this->world->SimTimeNs();
 
-    if (simTime < this->lastMeasurementTime.Double())
+    if (simTime < common::SimTimeNs(this->lastMeasurementTime))
     {
       // Rendering sensors also set the lastMeasurementTime variable in Render()
       // and lastUpdateTime in Sensor::Update based on Scene::SimTime() which
@@ -398,14 +405,15 @@ bool GpuRaySensor::NeedsUpdate()
       return false;
     }
 
-    double dt = this->world->Physics()->GetMaxStepSize();
+    const common::SimTimeNs dt = common::SimTimeNs::FromSeconds(
+        this->world->Physics()->GetMaxStepSize());
 
     // If next rendering time is not set yet
-    if (std::isnan(this->dataPtr->nextRenderingTime))
+    if (!this->dataPtr->nextRenderingTime)
     {
       if (this->updatePeriod == 0
-          || (simTime > 0.0 &&
-          std::abs(std::fmod(simTime, this->updatePeriod.Double())) < dt))
+          || (simTime > common::SimTimeNs() &&
+          simTime.Mod(common::SimTimeNs(this->updatePeriod)) < dt))
       {
         this->dataPtr->nextRenderingTime = simTime;
         return true;
@@ -416,12 +424,13 @@ bool GpuRaySensor::NeedsUpdate()
       }
     }
 
-    if (simTime > this->dataPtr->nextRenderingTime + dt)
+    const common::SimTimeNs offset =
+      simTime - *this->dataPtr->nextRenderingTime;
+    if (offset > dt)
       return true;
 
     // Trigger on the tick the closest from the targeted rendering time
-    return (ignition::math::lessOrNearEqual(
-          std::abs(simTime - this->dataPtr->nextRenderingTime), dt / 2.0));
+    return std::max(offset, -offset) <= dt / 2;
   }
   else
   {
@@ -663,18 +672,33 @@ void GpuRaySensor::PrerenderEnded()
       this->NeedsUpdate())
   {
     // compute next rendering time, take care of the case where period is zero.
-    double dt;
+    common::SimTimeNs dt;
     if (this->updatePeriod <= 0.0)
-      dt = this->world->Physics()->GetMaxStepSize();
+    {
+      dt = common::SimTimeNs::FromSeconds(
+          this->world->Physics()->GetMaxStepSize());
+    }
     else
-      dt = this->updatePeriod.Double();
-    this->dataPtr->nextRenderingTime += dt;
-
-    this->dataPtr->renderNeeded = true;
+      dt = common::SimTimeNs(this->updatePeriod);
+    if (this->dataPtr->nextRenderingTime)
+      *this->dataPtr->nextRenderingTime += dt;
+
+    // The rendering time still advances when the rendering is skipped, so
+    // that the sensor stays in step with the world
+    this->dataPtr->renderNeeded =
+      !this->dataPtr->renderOnDemand || this->HasListeners();
     this->lastMeasurementTime = this->scene->SimTime();
   }
 }
 
+//////////////////////////////////////////////////
+bool GpuRaySensor::HasListeners() const
+{
+  return (this->dataPtr->scanPub && this->dataPtr->scanPub->HasConnections())
+    || this->updated.ConnectionCount() > 0u ||
+    (this->dataPtr->laserCam && this->dataPtr->laserCam->HasFrameListeners());
+}
+
 //////////////////////////////////////////////////
 void GpuRaySensor::Render()
 {
@@ -684,7 +708,9 @@ void GpuRaySensor::Render()
     if (!this->dataPtr->renderNeeded)
       return;
 
+    auto start = std::chrono::steady_clock::now();
     this->dataPtr->laserCam->Render();
+    this->AddStageDuration(SENSOR_STAGE_RENDER, start);
     this->dataPtr->rendered = true;
     this->dataPtr->renderNeeded = false;
   }
@@ -693,9 +719,14 @@ void GpuRaySensor::Render()
     if (!this->dataPtr->laserCam || !this->IsActive() || !this->NeedsUpdate())
       return;
 
+    if (this->dataPtr->renderOnDemand && !this->HasListeners())
+      return;
+
     this->lastMeasurementTime = this->scene->SimTime();
 
+    auto start = std::chrono::steady_clock::now();
     this->dataPtr->laserCam->Render();
+    this->AddStageDuration(SENSOR_STAGE_RENDER, start);
     this->dataPtr->rendered = true;
   }
 }
@@ -708,7 +739,9 @@ bool GpuRaySensor::UpdateImpl(const bool /*_force*/)
   if (!this->dataPtr->rendered)
     return false;
   IGN_PROFILE_BEGIN("PostRender");
+  auto start = std::chrono::steady_clock::now();
   this->dataPtr->laserCam->PostRender();
+  this->AddStageDuration(SENSOR_STAGE_READBACK, start);
   IGN_PROFILE_END();
 
   IGN_PROFILE_BEGIN("fillarray");
@@ -750,6 +783,11 @@ bool GpuRaySensor::UpdateImpl(const bool /*_force*/)
     }
   }
 
+  auto &inRange = this->dataPtr->inRange;
+  auto &noisy = this->dataPtr->noisy;
+  inRange.clear();
+  noisy.clear();
+
   auto dataIter = this->dataPtr->laserCam->LaserDataBegin();
   auto dataEnd = this->dataPtr->laserCam->LaserDataEnd();
   for (int i = 0; dataIter != dataEnd; ++dataIter, ++i)
@@ -767,11 +805,11 @@ bool GpuRaySensor::UpdateImpl(const bool /*_force*/)
     {
       range = -ignition::math::INF_D;
     }
-    else if (this->noises.find(GPU_RAY_NOISE) != this->noises.end())
+    else
     {
-      range = this->noises[GPU_RAY_NOISE]->Apply(range);
-      range = ignition::math::clamp(range,
-          this->dataPtr->rangeMin, this->dataPtr->rangeMax);
+      // The noise is applied to all these ranges at once below
+      inRange.push_back(i);
+      noisy.push_back(range);
     }
 
     range = ignition::math::isnan(range) ? this->dataPtr->rangeMax : range;
@@ -779,8 +817,27 @@ bool GpuRaySensor::UpdateImpl(const bool /*_force*/)
     scan->set_intensities(i, intensity);
   }
 
+  auto noiseIter = this->noises.find(GPU_RAY_NOISE);
+  if (noiseIter != this->noises.end() && !inRange.empty())
+  {
+    start = std::chrono::steady_clock::now();
+    noiseIter->second->ApplyBatch(noisy.data(), noisy.size());
+    this->AddStageDuration(SENSOR_STAGE_NOISE, start);
+    for (size_t k = 0; k < inRange.size(); ++k)
+    {
+      double range = ignition::math::clamp(noisy[k],
+          this->dataPtr->rangeMin, this->dataPtr->rangeMax);
+      range = ignition::math::isnan(range) ? this->dataPtr->rangeMax : range;
+      scan->set_ranges(inRange[k], range);
+    }
+  }
+
   if (this->dataPtr->scanPub && this->dataPtr->scanPub->HasConnections())
+  {
+    start = std::chrono::steady_clock::now();
     this->dataPtr->scanPub->Publish(this->dataPtr->laserMsg);
+    this->AddStageDuration(SENSOR_STAGE_PUBLISH, start);
+  }
 
   this->dataPtr->rendered = false;
   IGN_PROFILE_END();
@@ -805,8 +862,11 @@ double GpuRaySensor::NextRequiredTimestamp() const
 {
   if (this->useStrictRate)
   {
-    if (!ignition::math::equal(this->updatePeriod.Double(), 0.0))
-      return this->dataPtr->nextRenderingTime;
+    if (!ignition::math::equal(this->updatePeriod.Double(), 0.0) &&
+        this->dataPtr->nextRenderingTime)
+    {
+      return this->dataPtr->nextRenderingTime->Double();
+    }
     else
       return std::numeric_limits<double>::quiet_NaN();
   }
@@ -821,5 +881,5 @@ void GpuRaySensor::ResetLastUpdateTime()
 {
   Sensor::ResetLastUpdateTime();
   if (this->useStrictRate)
-    this->dataPtr->nextRenderingTime = std::numeric_limits<double>::quiet_NaN();
+    this->dataPtr->nextRenderingTime.reset();
 }
@@ -273,6 +273,13 @@ namespace gazebo
       /// \brief Handle the prerenderEnded event.
       private: void PrerenderEnded();
 
+      /// \brief Check whether anything consumes the scans of the sensor:
+      /// subscribers, callbacks of the sensor or laser frame listeners. With
+      /// <ignition:render_on_demand> the sensor renders only while this is
+      /// true.
+      /// \return True if the scans are consumed.
+      private: bool HasListeners() const;
+
       /// \internal
       /// \brief Private data pointer.
       private: std::unique_ptr<GpuRaySensorPrivate> dataPtr;
@@ -17,10 +17,12 @@
 #ifndef _GAZEBO_SENSORS_GPURAYENSOR_PRIVATE_HH_
 #define _GAZEBO_SENSORS_GPURAYENSOR_PRIVATE_HH_
 
-#include <limits>
+#include <optional>
 #include <mutex>
+#include <vector>
 #include <sdf/sdf.hh>
 
+#include "gazebo/common/SimTimeNs.hh"
 #include "gazebo/rendering/RenderTypes.hh"
 #include "gazebo/transport/TransportTypes.hh"
 #include "gazebo/physics/PhysicsTypes.hh"
@@ -70,6 +72,14 @@ namespace gazebo
       /// \brief The maximum range.
       public: double rangeMax;
 
+      /// \brief Indices of the ranges of the last scan within the min and
+      /// max ranges.
+      public: std::vector<int> inRange;
+
+      /// \brief Ranges of the last scan within the min and max ranges, with
+      /// noise.
+      public: std::vector<double> noisy;
+
       /// \brief GPU laser rendering.
       public: rendering::GpuLaserPtr laserCam;
 
@@ -91,9 +101,12 @@ namespace gazebo
       /// \brief True if the sensor needs a rendering
       public: bool renderNeeded = false;
 
-      /// \brief Timestamp of the forthcoming rendering
-      public: double nextRenderingTime
-                           = std::numeric_limits<double>::quiet_NaN();
+      /// \brief Sim time of the forthcoming rendering, unset until the
+      /// sensor is first due
+      public: std::optional<common::SimTimeNs> nextRenderingTime;
+
+      /// \brief True to render only while the scans have listeners.
+      public: bool renderOnDemand = false;
     };
   }
 }
@@ -15,6 +15,7 @@
  *
 */
 #include <boost/algorithm/string.hpp>
+#include <chrono>
 #include <ignition/common/Profiler.hh>
 #include <ignition/math/Rand.hh>
 
@@ -37,7 +38,7 @@ GZ_REGISTER_STATIC_SENSOR("imu", ImuSensor)
 
 //////////////////////////////////////////////////
 ImuSensor::ImuSensor()
-: Sensor(sensors::OTHER),
+: Sensor(sensors::INLINE),
   dataPtr(new ImuSensorPrivate)
 {
   this->dataPtr->dataIndex = 0;
@@ -85,6 +86,10 @@ void ImuSensor::Load(const std::string &_worldName, sdf::ElementPtr _sdf)
       this->node->Advertise<msgs::IMU>(topicName, 500);
   }
 
+  const std::string kBatchPeriod = "ignition:batch_period";
+  if (this->sdf->HasElement(kBatchPeriod))
+    this->SetBatchPeriod(this->sdf->Get<double>(kBatchPeriod));
+
   // Get the imu element pointer
   sdf::ElementPtr imuElem = this->sdf->GetElement("imu");
 
@@ -228,6 +233,7 @@ void ImuSensor::Fini()
   // Clean transport
   {
     this->dataPtr->pub.reset();
+    this->dataPtr->batchPub.reset();
     this->dataPtr->linkDataSub.reset();
   }
 
@@ -389,6 +395,7 @@ bool ImuSensor::UpdateImpl(const bool /*_force*/)
     this->dataPtr->lastImuWorldLinearVel = imuWorldLinearVel;
 
     // Apply noise models
+    auto start = std::chrono::steady_clock::now();
     for (auto const &keyNoise : this->noises)
     {
       switch (keyNoise.first)
@@ -433,21 +440,108 @@ bool ImuSensor::UpdateImpl(const bool /*_force*/)
           break;
       }
     }
+    this->AddStageDuration(SENSOR_STAGE_NOISE, start);
     IGN_PROFILE_END();
 
     IGN_PROFILE_BEGIN("Publish");
     // Publish the message
     if (this->dataPtr->pub)
+    {
+      start = std::chrono::steady_clock::now();
       this->dataPtr->pub->Publish(this->dataPtr->imuMsg);
+      this->AddStageDuration(SENSOR_STAGE_PUBLISH, start);
+    }
+    if (this->dataPtr->batchPub)
+    {
+      start = std::chrono::steady_clock::now();
+      this->AddBatchSample(common::SimTimeNs(timestamp));
+      this->AddStageDuration(SENSOR_STAGE_PUBLISH, start);
+    }
     IGN_PROFILE_END();
   }
 
   return true;
 }
 
+//////////////////////////////////////////////////
+void ImuSensor::AddBatchSample(const common::SimTimeNs _time)
+{
+  msgs::IMUBatch &batch = this->dataPtr->batchMsg;
+
+  // The samples of a period are published with the first sample of the
+  // next one
+  if (batch.stamp_ns_size() > 0 &&
+      _time - this->dataPtr->batchStart >= this->dataPtr->batchPeriod)
+  {
+    this->dataPtr->batchPub->Publish(batch);
+    batch.clear_stamp_ns();
+    batch.clear_orientation();
+    batch.clear_angular_velocity();
+    batch.clear_linear_acceleration();
+  }
+
+  if (!this->dataPtr->batchPub->HasConnections())
+    return;
+
+  if (batch.stamp_ns_size() == 0)
+    this->dataPtr->batchStart = _time;
+
+  const msgs::IMU &sample = this->dataPtr->imuMsg;
+  batch.set_entity_name(sample.entity_name());
+  batch.add_stamp_ns(_time.Nanoseconds());
+  batch.add_orientation(sample.orientation().x());
+  batch.add_orientation(sample.orientation().y());
+  batch.add_orientation(sample.orientation().z());
+  batch.add_orientation(sample.orientation().w());
+  batch.add_angular_velocity(sample.angular_velocity().x());
+  batch.add_angular_velocity(sample.angular_velocity().y());
+  batch.add_angular_velocity(sample.angular_velocity().z());
+  batch.add_linear_acceleration(sample.linear_acceleration().x());
+  batch.add_linear_acceleration(sample.linear_acceleration().y());
+  batch.add_linear_acceleration(sample.linear_acceleration().z());
+}
+
+//////////////////////////////////////////////////
+void ImuSensor::SetBatchPeriod(const double _period)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->batchMsg.Clear();
+  if (_period <= 0.0 || !this->dataPtr->pub)
+  {
+    this->dataPtr->batchPeriod = common::SimTimeNs();
+    this->dataPtr->batchPub.reset();
+    return;
+  }
+
+  this->dataPtr->batchPeriod = common::SimTimeNs::FromSeconds(_period);
+  if (!this->dataPtr->batchPub)
+  {
+    this->dataPtr->batchPub = this->node->Advertise<msgs::IMUBatch>(
+        this->dataPtr->pub->GetTopic() + "/batch", 50);
+  }
+}
+
+//////////////////////////////////////////////////
+double ImuSensor::BatchPeriod() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->batchPeriod.Double();
+}
+
+//////////////////////////////////////////////////
+std::string ImuSensor::BatchTopic() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (!this->dataPtr->batchPub)
+    return std::string();
+  return this->dataPtr->batchPub->GetTopic();
+}
+
 //////////////////////////////////////////////////
 bool ImuSensor::IsActive() const
 {
   return this->active ||
-         (this->dataPtr->pub && this->dataPtr->pub->HasConnections());
+         (this->dataPtr->pub && this->dataPtr->pub->HasConnections()) ||
+         (this->dataPtr->batchPub &&
+          this->dataPtr->batchPub->HasConnections());
 }
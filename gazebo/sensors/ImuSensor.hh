@@ -108,6 +108,32 @@ namespace gazebo
       public: void SetWorldToReferenceOrientation(
         const ignition::math::Quaterniond &_orientation);
 
+      /// \brief Publish the samples in batches as well, e.g. for rates
+      /// where the cost of a message per sample dominates. A batch is a
+      /// msgs::IMUBatch with the consecutive samples of a period of sim
+      /// time, published on the topic of the samples followed by "/batch"
+      /// with the first sample of the next period. The samples are only
+      /// collected while the batch topic has subscribers. The period is
+      /// also set by the <ignition:batch_period> element of the sensor.
+      /// \param[in] _period Sim time covered by a batch in seconds, 0 to
+      /// disable the batches.
+      /// \sa BatchPeriod
+      public: void SetBatchPeriod(const double _period);
+
+      /// \brief Get the sim time covered by a batch of samples.
+      /// \return The period in seconds, 0 if batches are disabled.
+      /// \sa SetBatchPeriod
+      public: double BatchPeriod() const;
+
+      /// \brief Get the topic of the batches.
+      /// \return The topic, empty if batches are disabled.
+      public: std::string BatchTopic() const;
+
+      /// \brief Add the current sample to the batch, and publish the
+      /// batch when its period is over. The mutex must be locked.
+      /// \param[in] _time Sim time of the sample.
+      private: void AddBatchSample(const common::SimTimeNs _time);
+
       /// \brief Callback when link data is received
       /// \param[in] _msg Message containing link data
       private: void OnLinkData(ConstLinkDataPtr &_msg);
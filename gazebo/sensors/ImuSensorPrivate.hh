@@ -22,6 +22,8 @@
 #include <ignition/math/Vector3.hh>
 #include <ignition/math/Pose3.hh>
 
+#include "gazebo/common/SimTimeNs.hh"
+#include "gazebo/msgs/imu_batch.pb.h"
 #include "gazebo/physics/PhysicsTypes.hh"
 #include "gazebo/transport/TransportTypes.hh"
 
@@ -74,6 +76,18 @@ namespace gazebo
 
       /// \brief Noise free angular velocity.
       public: ignition::math::Vector3d angularVel;
+
+      /// \brief Sim time covered by a batch of samples, 0 if disabled.
+      public: common::SimTimeNs batchPeriod;
+
+      /// \brief Batch publisher, null if disabled.
+      public: transport::PublisherPtr batchPub;
+
+      /// \brief Samples of the batch being collected.
+      public: msgs::IMUBatch batchMsg;
+
+      /// \brief Sim time of the first sample of the batch.
+      public: common::SimTimeNs batchStart;
     };
   }
 }
@@ -19,6 +19,8 @@
 #include <sys/time.h>
 #endif
 #include <gtest/gtest.h>
+#include <mutex>
+#include <vector>
 
 #include "gazebo/test/ServerFixture.hh"
 #include "gazebo/test/helper_physics_generator.hh"
@@ -32,8 +34,19 @@ class ImuSensor_TEST : public ServerFixture,
 {
   public: void BasicImuSensorCheck(const std::string &_physicsEngine);
   public: void LinearAccelerationTest(const std::string &_physicsEngine);
+  public: void BatchTest(const std::string &_physicsEngine);
 };
 
+std::mutex g_batchMutex;
+std::vector<msgs::IMUBatch> g_batches;
+
+/////////////////////////////////////////////////
+void OnImuBatch(ConstIMUBatchPtr &_msg)
+{
+  std::lock_guard<std::mutex> lock(g_batchMutex);
+  g_batches.push_back(*_msg);
+}
+
 static std::string imuSensorString =
 "<sdf version='1.3'>"
 "  <sensor name='imu' type='imu'>"
@@ -146,6 +159,85 @@ void ImuSensor_TEST::LinearAccelerationTest(const std::string &_physicsEngine)
   EXPECT_NEAR(imuSensor->LinearAcceleration().Z(), -gravityZ, 0.4);
 }
 
+/////////////////////////////////////////////////
+// Publish the samples of an imu in batches
+void ImuSensor_TEST::BatchTest(const std::string &_physicsEngine)
+{
+  Load("worlds/empty.world", true, _physicsEngine);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  std::string imuSensorName = "imuSensor";
+  SpawnUnitImuSensor("imuModel", imuSensorName, "box",
+      "~/" + imuSensorName, ignition::math::Vector3d(0, 0, 3));
+
+  sensors::ImuSensorPtr imuSensor =
+      std::dynamic_pointer_cast<sensors::ImuSensor>(
+      sensors::get_sensor(imuSensorName));
+  ASSERT_TRUE(imuSensor != nullptr);
+
+  // Disabled by default
+  EXPECT_DOUBLE_EQ(0.0, imuSensor->BatchPeriod());
+  EXPECT_TRUE(imuSensor->BatchTopic().empty());
+
+  const double period = 0.05;
+  imuSensor->SetBatchPeriod(period);
+  EXPECT_DOUBLE_EQ(period, imuSensor->BatchPeriod());
+  ASSERT_FALSE(imuSensor->BatchTopic().empty());
+
+  transport::NodePtr node(new transport::Node());
+  node->Init();
+  {
+    std::lock_guard<std::mutex> lock(g_batchMutex);
+    g_batches.clear();
+  }
+  transport::SubscriberPtr sub =
+      node->Subscribe(imuSensor->BatchTopic(), &OnImuBatch);
+
+  sensors::SensorManager::Instance()->Init();
+  imuSensor->SetActive(true);
+
+  for (int i = 0; i < 50; ++i)
+  {
+    world->Step(100);
+    common::Time::MSleep(20);
+    std::lock_guard<std::mutex> lock(g_batchMutex);
+    if (g_batches.size() >= 3u)
+      break;
+  }
+
+  std::lock_guard<std::mutex> lock(g_batchMutex);
+  ASSERT_GE(g_batches.size(), 3u);
+
+  // Each batch holds the consecutive samples of a period
+  int64_t last = -1;
+  for (auto const &batch : g_batches)
+  {
+    const int count = batch.stamp_ns_size();
+    ASSERT_GT(count, 0);
+    EXPECT_EQ(count * 4, batch.orientation_size());
+    EXPECT_EQ(count * 3, batch.angular_velocity_size());
+    EXPECT_EQ(count * 3, batch.linear_acceleration_size());
+    EXPECT_EQ("imuModel::body", batch.entity_name());
+    EXPECT_LT(batch.stamp_ns(count - 1) - batch.stamp_ns(0),
+        static_cast<int64_t>(period * 1e9));
+    for (int i = 0; i < count; ++i)
+    {
+      EXPECT_GT(batch.stamp_ns(i), last);
+      last = batch.stamp_ns(i);
+    }
+  }
+
+  imuSensor->SetBatchPeriod(0);
+  EXPECT_TRUE(imuSensor->BatchTopic().empty());
+}
+
+/////////////////////////////////////////////////
+TEST_P(ImuSensor_TEST, BatchTest)
+{
+  BatchTest(GetParam());
+}
+
 /////////////////////////////////////////////////
 TEST_P(ImuSensor_TEST, BasicImuSensorCheck)
 {
@@ -117,9 +117,8 @@ void LogicalCameraSensorPrivate::AddVisibleModels(
   for (auto const &model : _models)
   {
     auto const &scopedName = model->GetScopedName();
-    auto const aabb = model->BoundingBox();
 
-    if (this->modelName != scopedName && this->frustum.Contains(aabb))
+    if (this->modelName != scopedName)
     {
       // Add new model msg
       msgs::LogicalCameraImage::Model *modelMsg = this->msg.add_model();
@@ -129,11 +128,6 @@ void LogicalCameraSensorPrivate::AddVisibleModels(
       msgs::Set(modelMsg->mutable_pose(),
           model->WorldPose() - _myPose);
     }
-    // Check nested models
-    // Note, the model AABB does not necessarily contain the nested model
-    // so nested models must be searched even if the frustum does not contain
-    // the parent model.
-    AddVisibleModels(_myPose, model->NestedModels());
   }
 }
 
@@ -158,8 +152,11 @@ bool LogicalCameraSensor::UpdateImpl(const bool _force)
     // Set the camera's pose in the message.
     msgs::Set(this->dataPtr->msg.mutable_pose(), myPose);
 
-    // Recursively check if models and nested models are in the frustum.
-    this->dataPtr->AddVisibleModels(myPose, this->world->Models());
+    // Find the models and nested models in the frustum. The world index
+    // tests their bounding boxes, so nested models are found even if the
+    // box of their parent is not in the frustum.
+    this->dataPtr->AddVisibleModels(myPose,
+        this->world->ModelsInFrustum(this->dataPtr->frustum));
     IGN_PROFILE_END();
 
     IGN_PROFILE_BEGIN("Publish");
@@ -34,7 +34,7 @@ GZ_REGISTER_STATIC_SENSOR("magnetometer", MagnetometerSensor)
 
 /////////////////////////////////////////////////
 MagnetometerSensor::MagnetometerSensor()
-: Sensor(sensors::OTHER),
+: Sensor(sensors::INLINE),
   dataPtr(new MagnetometerSensorPrivate)
 {
 }
@@ -15,7 +15,10 @@
  *
 */
 #include <boost/algorithm/string.hpp>
+#include <algorithm>
+#include <chrono>
 #include <functional>
+#include <limits>
 #include <ignition/common/Profiler.hh>
 #include <ignition/math/Pose3.hh>
 
@@ -240,7 +243,7 @@ void MultiCameraSensor::SetActive(bool _value)
   {
     // the next rendering time must be reset to ensure it is properly
     // computed by Sensor::NeedsUpdate.
-    this->dataPtr->nextRenderingTime = std::numeric_limits<double>::quiet_NaN();
+    this->dataPtr->nextRenderingTime.reset();
   }
   Sensor::SetActive(_value);
 }
@@ -250,13 +253,13 @@ bool MultiCameraSensor::NeedsUpdate()
 {
   if (this->useStrictRate)
   {
-    double simTime;
+    common::SimTimeNs simTime;
     if (this->scene)
-      simTime = this->scene->SimTime().Double();
+      simTime = common::SimTimeNs(this->scene->SimTime());
     else
-      simTime = this->world->SimTime().Double();
+      simTime = this->world->SimTimeNs();
 
-    if (simTime < this->lastMeasurementTime.Double())
+    if (simTime < common::SimTimeNs(this->lastMeasurementTime))
     {
       // Rendering sensors also set the lastMeasurementTime variable in Render()
       // and lastUpdateTime in Sensor::Update based on Scene::SimTime() which
@@ -266,14 +269,15 @@ bool MultiCameraSensor::NeedsUpdate()
       return false;
     }
 
-    double dt = this->world->Physics()->GetMaxStepSize();
+    const common::SimTimeNs dt = common::SimTimeNs::FromSeconds(
+        this->world->Physics()->GetMaxStepSize());
 
     // If next rendering time is not set yet
-    if (std::isnan(this->dataPtr->nextRenderingTime))
+    if (!this->dataPtr->nextRenderingTime)
     {
       if (this->updatePeriod == 0
-          || (simTime > 0.0 &&
-          std::abs(std::fmod(simTime, this->updatePeriod.Double())) < dt))
+          || (simTime > common::SimTimeNs() &&
+          simTime.Mod(common::SimTimeNs(this->updatePeriod)) < dt))
       {
         this->dataPtr->nextRenderingTime = simTime;
         return true;
@@ -284,12 +288,13 @@ bool MultiCameraSensor::NeedsUpdate()
       }
     }
 
-    if (simTime > this->dataPtr->nextRenderingTime + dt)
+    const common::SimTimeNs offset =
+      simTime - *this->dataPtr->nextRenderingTime;
+    if (offset > dt)
       return true;
 
     // Trigger on the tick the closest from the targeted rendering time
-    return (ignition::math::lessOrNearEqual(
-          std::abs(simTime - this->dataPtr->nextRenderingTime), dt / 2.0));
+    return std::max(offset, -offset) <= dt / 2;
   }
   else
   {
@@ -304,12 +309,16 @@ void MultiCameraSensor::PrerenderEnded()
       this->IsActive() && this->NeedsUpdate())
   {
     // compute next rendering time, take care of the case where period is zero.
-    double dt;
+    common::SimTimeNs dt;
     if (this->updatePeriod <= 0.0)
-      dt = this->world->Physics()->GetMaxStepSize();
+    {
+      dt = common::SimTimeNs::FromSeconds(
+          this->world->Physics()->GetMaxStepSize());
+    }
     else
-      dt = this->updatePeriod.Double();
-    this->dataPtr->nextRenderingTime += dt;
+      dt = common::SimTimeNs(this->updatePeriod);
+    if (this->dataPtr->nextRenderingTime)
+      *this->dataPtr->nextRenderingTime += dt;
 
     this->dataPtr->renderNeeded = true;
     this->lastMeasurementTime = this->scene->SimTime();
@@ -334,11 +343,13 @@ void MultiCameraSensor::Render()
       return;
     }
 
+    auto start = std::chrono::steady_clock::now();
     for (auto iter = this->dataPtr->cameras.begin();
         iter != this->dataPtr->cameras.end(); ++iter)
     {
       (*iter)->Render();
     }
+    this->AddStageDuration(SENSOR_STAGE_RENDER, start);
 
     this->dataPtr->rendered = true;
     this->dataPtr->renderNeeded = false;
@@ -357,11 +368,13 @@ void MultiCameraSensor::Render()
       return;
     }
 
+    auto start = std::chrono::steady_clock::now();
     for (auto iter = this->dataPtr->cameras.begin();
         iter != this->dataPtr->cameras.end(); ++iter)
     {
       (*iter)->Render();
     }
+    this->AddStageDuration(SENSOR_STAGE_RENDER, start);
 
     this->dataPtr->rendered = true;
     this->lastMeasurementTime = this->scene->SimTime();
@@ -388,7 +401,9 @@ bool MultiCameraSensor::UpdateImpl(const bool /*_force*/)
   for (auto iter = this->dataPtr->cameras.begin();
        iter != this->dataPtr->cameras.end(); ++iter, ++index)
   {
+    auto start = std::chrono::steady_clock::now();
     (*iter)->PostRender();
+    this->AddStageDuration(SENSOR_STAGE_READBACK, start);
 
     if (publish)
     {
@@ -401,7 +416,11 @@ bool MultiCameraSensor::UpdateImpl(const bool /*_force*/)
 
   IGN_PROFILE_BEGIN("Publish");
   if (publish)
+  {
+    auto start = std::chrono::steady_clock::now();
     this->dataPtr->imagePub->Publish(this->dataPtr->msg);
+    this->AddStageDuration(SENSOR_STAGE_PUBLISH, start);
+  }
   IGN_PROFILE_END();
 
   this->dataPtr->rendered = false;
@@ -470,8 +489,11 @@ double MultiCameraSensor::NextRequiredTimestamp() const
 {
   if (this->useStrictRate)
   {
-    if (!ignition::math::equal(this->updatePeriod.Double(), 0.0))
-      return this->dataPtr->nextRenderingTime;
+    if (!ignition::math::equal(this->updatePeriod.Double(), 0.0) &&
+        this->dataPtr->nextRenderingTime)
+    {
+      return this->dataPtr->nextRenderingTime->Double();
+    }
     else
       return std::numeric_limits<double>::quiet_NaN();
   }
@@ -486,5 +508,5 @@ void MultiCameraSensor::ResetLastUpdateTime()
 {
   Sensor::ResetLastUpdateTime();
   if (this->useStrictRate)
-    this->dataPtr->nextRenderingTime = std::numeric_limits<double>::quiet_NaN();
+    this->dataPtr->nextRenderingTime.reset();
 }
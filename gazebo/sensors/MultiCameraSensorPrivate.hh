@@ -19,8 +19,9 @@
 
 #include <vector>
 #include <mutex>
-#include <limits>
+#include <optional>
 
+#include "gazebo/common/SimTimeNs.hh"
 #include "gazebo/msgs/msgs.hh"
 #include "gazebo/transport/TransportTypes.hh"
 
@@ -50,9 +51,9 @@ namespace gazebo
       /// \brief True if the sensor needs a rendering
       public: bool renderNeeded = false;
 
-      /// \brief Timestamp of the forthcoming rendering
-      public: double nextRenderingTime
-                           = std::numeric_limits<double>::quiet_NaN();
+      /// \brief Sim time of the forthcoming rendering, unset until the
+      /// sensor is first due
+      public: std::optional<common::SimTimeNs> nextRenderingTime;
     };
   }
 }
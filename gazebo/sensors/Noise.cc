@@ -14,6 +14,7 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
 
 #include <boost/function.hpp>
 #include "gazebo/common/Assert.hh"
@@ -124,6 +125,47 @@ double Noise::ApplyImpl(double _in, double /*_dt*/)
   return _in;
 }
 
+//////////////////////////////////////////////////
+void Noise::ApplyBatch(double *_values, const size_t _count,
+    const double _dt)
+{
+  if (this->type == NONE)
+    return;
+  else if (this->type == CUSTOM)
+  {
+    for (size_t i = 0; i < _count; ++i)
+      _values[i] = this->Apply(_values[i], _dt);
+  }
+  else
+    this->ApplyBatchImpl(_values, _count, _dt);
+}
+
+//////////////////////////////////////////////////
+void Noise::ApplyBatch(float *_values, const size_t _count,
+    const double _dt)
+{
+  if (this->type == NONE)
+    return;
+
+  // Convert through a small double buffer, chunk by chunk
+  double buffer[256];
+  for (size_t first = 0; first < _count; first += 256)
+  {
+    const size_t n = std::min<size_t>(256, _count - first);
+    std::copy(_values + first, _values + first + n, buffer);
+    this->ApplyBatch(buffer, n, _dt);
+    std::copy(buffer, buffer + n, _values + first);
+  }
+}
+
+//////////////////////////////////////////////////
+void Noise::ApplyBatchImpl(double *_values, const size_t _count,
+    const double _dt)
+{
+  for (size_t i = 0; i < _count; ++i)
+    _values[i] = this->ApplyImpl(_values[i], _dt);
+}
+
 //////////////////////////////////////////////////
 Noise::NoiseType Noise::GetNoiseType() const
 {
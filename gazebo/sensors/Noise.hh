@@ -88,6 +88,30 @@ namespace gazebo
       /// \return Data with noise applied.
       public: virtual double ApplyImpl(double _in, double _dt = 0.0);
 
+      /// \brief Apply noise to an array of values in place, cheaper than
+      /// calling Apply for each value.
+      /// \param[in,out] _values The values.
+      /// \param[in] _count Number of values.
+      /// \param[in] _dt Time step of the values.
+      public: void ApplyBatch(double *_values, const size_t _count,
+                  const double _dt = 0.0);
+
+      /// \brief Apply noise to an array of single precision values in place.
+      /// \param[in,out] _values The values.
+      /// \param[in] _count Number of values.
+      /// \param[in] _dt Time step of the values.
+      public: void ApplyBatch(float *_values, const size_t _count,
+                  const double _dt = 0.0);
+
+      /// \brief Apply noise to an array of values. This gets overriden by
+      /// derived classes, and called by ApplyBatch. The default calls
+      /// ApplyImpl for each value.
+      /// \param[in,out] _values The values.
+      /// \param[in] _count Number of values.
+      /// \param[in] _dt Time step of the values.
+      public: virtual void ApplyBatchImpl(double *_values,
+                  const size_t _count, const double _dt);
+
       /// \brief Finalize the noise model
       public: virtual void Fini();
 
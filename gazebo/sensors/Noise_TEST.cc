@@ -16,6 +16,8 @@
 */
 
 #include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
 
 #include <boost/accumulators/accumulators.hpp>
 #include <boost/accumulators/statistics/stats.hpp>
@@ -374,6 +376,78 @@ TEST_F(NoiseTest, OnApplyNoise)
   }
 }
 
+//////////////////////////////////////////////////
+TEST_F(NoiseTest, ApplyBatch)
+{
+  const unsigned int count = 10000;
+
+  // NONE leaves the values
+  {
+    sensors::NoisePtr noise = sensors::NoiseFactory::NewNoiseModel(
+        NoiseSdf("none", 0, 0, 0, 0, 0));
+    std::vector<double> values(count, 42.0);
+    noise->ApplyBatch(values.data(), values.size());
+    for (auto v : values)
+      EXPECT_DOUBLE_EQ(42.0, v);
+  }
+
+  // CUSTOM calls the callback for each value
+  {
+    sensors::NoisePtr noise(new sensors::Noise(sensors::Noise::CUSTOM));
+    using namespace boost::placeholders;
+    noise->SetCustomNoiseCallback(boost::bind(&OnApplyCustomNoise, _1));
+    std::vector<float> values = {1.0f, 2.0f, 3.0f};
+    noise->ApplyBatch(values.data(), values.size());
+    EXPECT_FLOAT_EQ(2.0f, values[0]);
+    EXPECT_FLOAT_EQ(4.0f, values[1]);
+    EXPECT_FLOAT_EQ(6.0f, values[2]);
+  }
+
+  // GAUSSIAN has the expected statistics
+  const double mean = 10.0;
+  const double stddev = 5.0;
+  sensors::NoisePtr noise = sensors::NoiseFactory::NewNoiseModel(
+      NoiseSdf("gaussian", mean, stddev, 0, 0, 0));
+  sensors::GaussianNoiseModelPtr gaussianNoise =
+    std::dynamic_pointer_cast<sensors::GaussianNoiseModel>(noise);
+  ASSERT_TRUE(gaussianNoise != nullptr);
+
+  // An odd count, to check the last sample of the pairs
+  std::vector<double> values(count + 1, 42.0);
+  gaussianNoise->SetBatchSeed(7);
+  noise->ApplyBatch(values.data(), values.size());
+
+  boost::accumulators::accumulator_set<double,
+    boost::accumulators::stats<boost::accumulators::tag::mean,
+                               boost::accumulators::tag::variance > > acc;
+  for (auto v : values)
+    acc(v);
+  EXPECT_NEAR(boost::accumulators::mean(acc), 42.0 + mean,
+      g_sigma * stddev / sqrt(values.size()));
+  const double variance = stddev * stddev;
+  EXPECT_NEAR(boost::accumulators::variance(acc), variance,
+      g_sigma * sqrt(2 * variance * variance / (values.size() - 1)));
+
+  // The same seed gives the same samples, in double and single precision
+  std::vector<double> again(count + 1, 42.0);
+  gaussianNoise->SetBatchSeed(7);
+  noise->ApplyBatch(again.data(), again.size());
+  EXPECT_EQ(values, again);
+
+  std::vector<float> floats(count + 1, 42.0f);
+  gaussianNoise->SetBatchSeed(7);
+  noise->ApplyBatch(floats.data(), floats.size());
+  for (size_t i = 0; i < floats.size(); ++i)
+    EXPECT_NEAR(values[i], floats[i], 1e-4);
+
+  // Quantized
+  sensors::NoisePtr quantized = sensors::NoiseFactory::NewNoiseModel(
+      NoiseSdf("gaussian_quantized", mean, stddev, 0, 0, 0.5));
+  quantized->ApplyBatch(values.data(), values.size());
+  for (auto v : values)
+    EXPECT_DOUBLE_EQ(v, std::round(v / 0.5) * 0.5);
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
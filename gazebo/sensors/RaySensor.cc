@@ -14,6 +14,10 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
+#include <chrono>
+#include <string>
+
 #include <boost/algorithm/string.hpp>
 
 #include <ignition/common/Profiler.hh>
@@ -113,6 +117,10 @@ void RaySensor::Load(const std::string &_worldName)
         this->Type());
   }
 
+  const std::string kElementName = "ignition:float_scan";
+  if (rayElem->HasElement(kElementName))
+    this->dataPtr->floatScan = rayElem->Get<bool>(kElementName);
+
   this->dataPtr->parentEntity = this->world->EntityByName(this->ParentName());
 
   GZ_ASSERT(this->dataPtr->parentEntity != nullptr,
@@ -274,9 +282,7 @@ void RaySensor::Ranges(std::vector<double> &_ranges) const
 {
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
 
-  _ranges.resize(this->dataPtr->laserMsg.scan().ranges_size());
-  memcpy(&_ranges[0], this->dataPtr->laserMsg.scan().ranges().data(),
-         sizeof(_ranges[0]) * this->dataPtr->laserMsg.scan().ranges_size());
+  _ranges = this->dataPtr->ranges;
 }
 
 //////////////////////////////////////////////////
@@ -284,18 +290,18 @@ double RaySensor::Range(const unsigned int _index) const
 {
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
 
-  if (this->dataPtr->laserMsg.scan().ranges_size() == 0)
+  if (this->dataPtr->ranges.empty())
   {
     gzwarn << "ranges not constructed yet (zero sized)\n";
     return 0.0;
   }
-  if (static_cast<int>(_index) >= this->dataPtr->laserMsg.scan().ranges_size())
+  if (_index >= this->dataPtr->ranges.size())
   {
     gzerr << "Invalid range index[" << _index << "]\n";
     return 0.0;
   }
 
-  return this->dataPtr->laserMsg.scan().ranges(_index);
+  return this->dataPtr->ranges[_index];
 }
 
 //////////////////////////////////////////////////
@@ -303,19 +309,18 @@ double RaySensor::Retro(const unsigned int _index) const
 {
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
 
-  if (this->dataPtr->laserMsg.scan().intensities_size() == 0)
+  if (this->dataPtr->intensities.empty())
   {
     gzwarn << "Intensities not constructed yet (zero size)\n";
     return 0.0;
   }
-  if (static_cast<int>(_index) >=
-      this->dataPtr->laserMsg.scan().intensities_size())
+  if (_index >= this->dataPtr->intensities.size())
   {
     gzerr << "Invalid intensity index[" << _index << "]\n";
     return 0.0;
   }
 
-  return this->dataPtr->laserMsg.scan().intensities(_index);
+  return this->dataPtr->intensities[_index];
 }
 
 //////////////////////////////////////////////////
@@ -377,37 +382,25 @@ bool RaySensor::UpdateImpl(const bool /*_force*/)
   scan->set_range_min(this->RangeMin());
   scan->set_range_max(this->RangeMax());
 
-  scan->clear_ranges();
-  scan->clear_intensities();
-
   unsigned int rayCount = this->RayCount();
   unsigned int rangeCount = this->RangeCount();
   unsigned int verticalRayCount = this->VerticalRayCount();
   unsigned int verticalRangeCount = this->VerticalRangeCount();
 
-  // Interpolation: for every point in range count, compute interpolated value
-  // using four bounding ray samples.
-  // (vja, hja)   (vja, hjb)
-  //       x---------x
-  //       |         |
-  //       |    o    |
-  //       |         |
-  //       x---------x
-  // (vjb, hja)   (vjb, hjb)
-  // where o: is the range to be interpolated
-  //       x: ray sample
-  //       vja: is the previous index of ray in vertical direction
-  //       vjb: is the next index of ray in vertical direction
-  //       hja: is the previous index of ray in horizontal direction
-  //       hjb: is the next index of ray in horizontal direction
-  unsigned int hja, hjb;
-  unsigned int vja = 0, vjb = 0;
-  // percentage of interpolation between rays
-  double vb = 0, hb;
-  // indices of ray samples
-  int j1, j2, j3, j4;
-  // range values of ray samples
-  double r1, r2, r3, r4;
+  // Read all the rays at once, into buffers reused between updates
+  this->dataPtr->laserShape->Ranges(this->dataPtr->rayRanges);
+  this->dataPtr->laserShape->Retros(this->dataPtr->rayRetros);
+  const double *rayRanges = this->dataPtr->rayRanges.data();
+  const double *rayRetros = this->dataPtr->rayRetros.data();
+
+  const size_t count = static_cast<size_t>(rangeCount) * verticalRangeCount;
+  GZ_ASSERT(this->dataPtr->rayRanges.size() >=
+      static_cast<size_t>(rayCount) * verticalRayCount,
+      "Laser shape has fewer rays than the sensor");
+  this->dataPtr->ranges.resize(count);
+  this->dataPtr->intensities.resize(count);
+  double *ranges = this->dataPtr->ranges.data();
+  double *intensities = this->dataPtr->intensities.data();
 
   // Check for the common case of vertical and horizontal resolution being 1,
   // which means that ray count == range count and we can do simple lookup
@@ -417,94 +410,147 @@ bool RaySensor::UpdateImpl(const bool /*_force*/)
   bool interp =
     ((rayCount != rangeCount) || (verticalRayCount != verticalRangeCount));
 
-  // interpolate in vertical direction
-  for (unsigned int j = 0; j < verticalRangeCount; ++j)
+  if (!interp)
+  {
+    std::copy(rayRanges, rayRanges + count, ranges);
+    std::copy(rayRetros, rayRetros + count, intensities);
+  }
+  else
   {
-    if (interp)
+    // Interpolation: for every point in range count, compute interpolated
+    // value using four bounding ray samples.
+    // (vja, hja)   (vja, hjb)
+    //       x---------x
+    //       |         |
+    //       |    o    |
+    //       |         |
+    //       x---------x
+    // (vjb, hja)   (vjb, hjb)
+    // where o: is the range to be interpolated
+    //       x: ray sample
+    //       vja: is the previous index of ray in vertical direction
+    //       vjb: is the next index of ray in vertical direction
+    //       hja: is the previous index of ray in horizontal direction
+    //       hjb: is the next index of ray in horizontal direction
+
+    // The horizontal indices and weights are the same for every row
+    auto &hja = this->dataPtr->hja;
+    auto &hjb = this->dataPtr->hjb;
+    auto &hb = this->dataPtr->hb;
+    hja.resize(rangeCount);
+    hjb.resize(rangeCount);
+    hb.resize(rangeCount);
+    for (unsigned int i = 0; i < rangeCount; ++i)
+    {
+      double b = (rangeCount == 1)? 0 : static_cast<double>(i * (rayCount - 1))
+          / (rangeCount - 1);
+      hja[i] = static_cast<unsigned int>(floor(b));
+      hjb[i] = std::min(hja[i] + 1, rayCount - 1);
+      hb[i] = b - floor(b);
+
+      GZ_ASSERT(hja[i] < rayCount,
+          "Invalid horizontal ray index used for interpolation");
+      GZ_ASSERT(hjb[i] < rayCount,
+          "Invalid horizontal ray index used for interpolation");
+    }
+
+    // interpolate in vertical direction
+    for (unsigned int j = 0; j < verticalRangeCount; ++j)
     {
-      vb = (verticalRangeCount == 1) ? 0 :
+      double vb = (verticalRangeCount == 1) ? 0 :
           static_cast<double>(j * (verticalRayCount - 1))
           / (verticalRangeCount - 1);
-      vja = static_cast<int>(floor(vb));
-      vjb = std::min(vja + 1, verticalRayCount - 1);
+      unsigned int vja = static_cast<unsigned int>(floor(vb));
+      unsigned int vjb = std::min(vja + 1, verticalRayCount - 1);
       vb = vb - floor(vb);
 
       GZ_ASSERT(vja < verticalRayCount,
           "Invalid vertical ray index used for interpolation");
       GZ_ASSERT(vjb < verticalRayCount,
           "Invalid vertical ray index used for interpolation");
-    }
-    // interpolate in horizontal direction
-    for (unsigned int i = 0; i < rangeCount; ++i)
-    {
-      double range, intensity;
-      if (interp)
+
+      // Rows of ray samples above and below, and the output row
+      const double *ra = rayRanges + vja * rayCount;
+      const double *rb = rayRanges + vjb * rayCount;
+      const double *ia = rayRetros + vja * rayCount;
+      const double *ib = rayRetros + vjb * rayCount;
+      double *rangeRow = ranges + j * rangeCount;
+      double *intensityRow = intensities + j * rangeCount;
+
+      // interpolate in horizontal direction
+      for (unsigned int i = 0; i < rangeCount; ++i)
       {
-        hb = (rangeCount == 1)? 0 : static_cast<double>(i * (rayCount - 1))
-            / (rangeCount - 1);
-        hja = static_cast<int>(floor(hb));
-        hjb = std::min(hja + 1, rayCount - 1);
-        hb = hb - floor(hb);
-
-        GZ_ASSERT(hja < rayCount,
-            "Invalid horizontal ray index used for interpolation");
-        GZ_ASSERT(hjb < rayCount,
-            "Invalid horizontal ray index used for interpolation");
-
-        // indices of 4 corners
-        j1 = hja + vja * rayCount;
-        j2 = hjb + vja * rayCount;
-        j3 = hja + vjb * rayCount;
-        j4 = hjb + vjb * rayCount;
-
-        // range readings of 4 corners
-        r1 = this->LaserShape()->GetRange(j1);
-        r2 = this->LaserShape()->GetRange(j2);
-        r3 = this->LaserShape()->GetRange(j3);
-        r4 = this->LaserShape()->GetRange(j4);
-        range = (1-vb)*((1 - hb) * r1 + hb * r2)
-            + vb *((1 - hb) * r3 + hb * r4);
+        const double b = hb[i];
+        rangeRow[i] = (1 - vb) * ((1 - b) * ra[hja[i]] + b * ra[hjb[i]])
+            + vb * ((1 - b) * rb[hja[i]] + b * rb[hjb[i]]);
 
         // intensity is averaged
-        intensity = 0.25 * (this->LaserShape()->GetRetro(j1)
-            + this->LaserShape()->GetRetro(j2)
-            + this->LaserShape()->GetRetro(j3)
-            + this->LaserShape()->GetRetro(j4));
-      }
-      else
-      {
-        range = this->dataPtr->laserShape->GetRange(j * this->RayCount() + i);
-        intensity = this->dataPtr->laserShape->GetRetro(j *
-            this->RayCount() + i);
+        intensityRow[i] = 0.25 * (ia[hja[i]] + ia[hjb[i]] +
+            ib[hja[i]] + ib[hjb[i]]);
       }
+    }
+  }
 
-      // Mask ranges outside of min/max to +/- inf, as per REP 117
-      if (range >= this->RangeMax())
-      {
-        range = ignition::math::INF_D;
-      }
-      else if (range <= this->RangeMin())
-      {
-        range = -ignition::math::INF_D;
-      }
-      else if (this->noises.find(RAY_NOISE) !=
-               this->noises.end())
-      {
-        // currently supports only one noise model per laser sensor
-        range = this->noises[RAY_NOISE]->Apply(range);
-        range = ignition::math::clamp(range,
-            this->RangeMin(), this->RangeMax());
-      }
+  // Mask ranges outside of min/max to +/- inf, as per REP 117, and apply
+  // the noise to the others
+  const double rangeMin = this->RangeMin();
+  const double rangeMax = this->RangeMax();
+  auto &inRange = this->dataPtr->inRange;
+  auto &noisy = this->dataPtr->noisy;
+  inRange.clear();
+  for (size_t k = 0; k < count; ++k)
+  {
+    if (ranges[k] >= rangeMax)
+      ranges[k] = ignition::math::INF_D;
+    else if (ranges[k] <= rangeMin)
+      ranges[k] = -ignition::math::INF_D;
+    else
+      inRange.push_back(static_cast<unsigned int>(k));
+  }
 
-      scan->add_ranges(range);
-      scan->add_intensities(intensity);
-    }
+  // currently supports only one noise model per laser sensor
+  auto noiseIter = this->noises.find(RAY_NOISE);
+  if (noiseIter != this->noises.end() && !inRange.empty())
+  {
+    noisy.resize(inRange.size());
+    for (size_t k = 0; k < inRange.size(); ++k)
+      noisy[k] = ranges[inRange[k]];
+    auto start = std::chrono::steady_clock::now();
+    noiseIter->second->ApplyBatch(noisy.data(), noisy.size());
+    this->AddStageDuration(SENSOR_STAGE_NOISE, start);
+    for (size_t k = 0; k < inRange.size(); ++k)
+      ranges[inRange[k]] = ignition::math::clamp(noisy[k], rangeMin, rangeMax);
+  }
+
+  // Fill the message in one go
+  if (this->dataPtr->floatScan)
+  {
+    scan->clear_ranges();
+    scan->clear_intensities();
+    scan->mutable_ranges_float()->Resize(static_cast<int>(count), 0.0f);
+    scan->mutable_intensities_float()->Resize(static_cast<int>(count), 0.0f);
+    std::copy(ranges, ranges + count,
+        scan->mutable_ranges_float()->mutable_data());
+    std::copy(intensities, intensities + count,
+        scan->mutable_intensities_float()->mutable_data());
+  }
+  else
+  {
+    scan->mutable_ranges()->Resize(static_cast<int>(count), 0.0);
+    scan->mutable_intensities()->Resize(static_cast<int>(count), 0.0);
+    std::copy(ranges, ranges + count, scan->mutable_ranges()->mutable_data());
+    std::copy(intensities, intensities + count,
+        scan->mutable_intensities()->mutable_data());
   }
   IGN_PROFILE_END();
 
   IGN_PROFILE_BEGIN("Publish");
   if (this->dataPtr->scanPub && this->dataPtr->scanPub->HasConnections())
+  {
+    auto start = std::chrono::steady_clock::now();
     this->dataPtr->scanPub->Publish(this->dataPtr->laserMsg);
+    this->AddStageDuration(SENSOR_STAGE_PUBLISH, start);
+  }
   IGN_PROFILE_END();
 
   return true;
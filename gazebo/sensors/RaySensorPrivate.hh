@@ -18,6 +18,7 @@
 #define _GAZEBO_SENSORS_RAYSENSOR_PRIVATE_HH_
 
 #include <mutex>
+#include <vector>
 
 #include "gazebo/msgs/msgs.hh"
 #include "gazebo/physics/PhysicsTypes.hh"
@@ -48,6 +49,35 @@ namespace gazebo
 
       /// \brief Laser message.
       public: msgs::LaserScanStamped laserMsg;
+
+      /// \brief True to publish single precision ranges and intensities.
+      public: bool floatScan = false;
+
+      /// \brief Range of each ray of the last update.
+      public: std::vector<double> rayRanges;
+
+      /// \brief Retro value of each ray of the last update.
+      public: std::vector<double> rayRetros;
+
+      /// \brief For each horizontal range, the index of the rays on each
+      /// side of it.
+      public: std::vector<unsigned int> hja, hjb;
+
+      /// \brief For each horizontal range, the interpolation weight of the
+      /// ray at hjb.
+      public: std::vector<double> hb;
+
+      /// \brief Interpolated ranges of the last update, row by row.
+      public: std::vector<double> ranges;
+
+      /// \brief Interpolated intensities of the last update, row by row.
+      public: std::vector<double> intensities;
+
+      /// \brief Indices of the ranges within the min and max ranges.
+      public: std::vector<unsigned int> inRange;
+
+      /// \brief Ranges within the min and max ranges, with noise.
+      public: std::vector<double> noisy;
     };
   }
 }
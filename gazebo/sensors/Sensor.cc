@@ -14,6 +14,10 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
+#include <chrono>
+#include <string>
+
 #include "ignition/common/Profiler.hh"
 
 #include "gazebo/transport/transport.hh"
@@ -67,7 +71,7 @@ Sensor::Sensor(SensorCategory _cat)
 
   this->node = transport::NodePtr(new transport::Node());
 
-  this->dataPtr->updateDelay = common::Time(0.0);
+  this->dataPtr->updateDelay = common::SimTimeNs();
   this->updatePeriod = common::Time(0.0);
 
   this->dataPtr->id = physics::getUniqueId();
@@ -91,6 +95,16 @@ void Sensor::Load(const std::string &_worldName)
 {
   this->world = physics::get_world(_worldName);
 
+  // The update and render time of the sensor is reported in the statistics
+  // breakdown of the world, per model. The parent is a link or a joint of
+  // the model.
+  const size_t scope = this->parentName.rfind("::");
+  if (scope != std::string::npos && scope > 0)
+  {
+    this->dataPtr->modelCost = common::CostCounter::Create("model_sensor",
+        this->parentName.substr(0, scope));
+  }
+
   if (this->sdf->HasElement("pose"))
   {
     this->pose =
@@ -209,15 +223,16 @@ bool Sensor::NeedsUpdate()
   // Adjust time-to-update period to compensate for delays caused by another
   // sensor's update in the same thread.
 
-  common::Time simTime;
+  common::SimTimeNs simTime;
   if (this->dataPtr->category == IMAGE && this->scene)
-    simTime = this->scene->SimTime();
+    simTime = common::SimTimeNs(this->scene->SimTime());
   else
-    simTime = this->world->SimTime();
+    simTime = this->world->SimTimeNs();
 
   // case when last update occurred in the future probably due to
   // world reset
-  if (simTime <= this->lastMeasurementTime)
+  const common::SimTimeNs lastMeasurement(this->lastMeasurementTime);
+  if (simTime <= lastMeasurement)
   {
     // Rendering sensors also set the lastMeasurementTime variable in Render()
     // and lastUpdateTime in Sensor::Update based on Scene::SimTime() which
@@ -227,59 +242,76 @@ bool Sensor::NeedsUpdate()
     return false;
   }
 
-  return (simTime - this->lastMeasurementTime +
-      this->dataPtr->updateDelay) >= this->updatePeriod;
+  return (simTime - lastMeasurement + this->dataPtr->updateDelay) >=
+      common::SimTimeNs(this->updatePeriod);
 }
 
 //////////////////////////////////////////////////
 void Sensor::Update(const bool _force)
 {
+  if (this->dataPtr->lazy && !this->UpdateLazyResources(_force))
+    return;
+
   if (this->IsActive() || _force)
   {
     if (this->useStrictRate)
     {
-      if (this->UpdateImpl(_force))
+      auto start = std::chrono::steady_clock::now();
+      bool done = this->UpdateImpl(_force);
+      this->AddStageDuration(SENSOR_STAGE_UPDATE, start);
+      if (done)
+      {
+        this->dataPtr->latency.Add(
+            (this->world->SimTime() - this->lastMeasurementTime).Double());
         this->updated();
+      }
     }
     else
     {
-      common::Time simTime;
+      common::SimTimeNs simTime;
       if (this->dataPtr->category == IMAGE && this->scene)
-        simTime = this->scene->SimTime();
+        simTime = common::SimTimeNs(this->scene->SimTime());
       else
-        simTime = this->world->SimTime();
+        simTime = this->world->SimTimeNs();
 
       {
         std::lock_guard<std::mutex> lock(this->dataPtr->mutexLastUpdateTime);
 
-        if (simTime <= this->lastUpdateTime && !_force)
+        const common::SimTimeNs lastUpdate(this->lastUpdateTime);
+        if (simTime <= lastUpdate && !_force)
           return;
 
         // Adjust time-to-update period to compensate for delays caused by
         // another sensor's update in the same thread.
         // NOTE: If you change this equation, also change the matching equation
         // in Sensor::NeedsUpdate
-        common::Time adjustedElapsed = simTime -
-          this->lastUpdateTime + this->dataPtr->updateDelay;
+        const common::SimTimeNs period(this->updatePeriod);
+        const common::SimTimeNs adjustedElapsed = simTime - lastUpdate +
+          this->dataPtr->updateDelay;
 
-        if (adjustedElapsed < this->updatePeriod && !_force)
+        if (adjustedElapsed < period && !_force)
           return;
 
-        this->dataPtr->updateDelay = std::max(common::Time::Zero,
-            adjustedElapsed - this->updatePeriod);
+        this->dataPtr->updateDelay = std::max(common::SimTimeNs(),
+            adjustedElapsed - period);
 
         // if delay is more than a full update period, then give up trying
         // to catch up. This happens normally when the sensor just changed from
         // an inactive to an active state, or the sensor just cannot hit its
         // target update rate (worst case).
-        if (this->dataPtr->updateDelay >= this->updatePeriod)
-          this->dataPtr->updateDelay = common::Time::Zero;
+        if (this->dataPtr->updateDelay >= period)
+          this->dataPtr->updateDelay = common::SimTimeNs();
       }
 
-      if (this->UpdateImpl(_force))
+      auto start = std::chrono::steady_clock::now();
+      bool done = this->UpdateImpl(_force);
+      this->AddStageDuration(SENSOR_STAGE_UPDATE, start);
+      if (done)
       {
+        this->dataPtr->latency.Add(
+            (this->world->SimTime() - this->lastMeasurementTime).Double());
         std::lock_guard<std::mutex> lock(this->dataPtr->mutexLastUpdateTime);
-        this->lastUpdateTime = simTime;
+        this->lastUpdateTime = simTime.ToTime();
         this->updated();
       }
     }
@@ -469,9 +501,23 @@ void Sensor::FillMsg(msgs::Sensor &_msg)
     CameraSensor *camSensor = static_cast<CameraSensor*>(this);
     msgs::CameraSensor *camMsg = _msg.mutable_camera();
     auto cam = camSensor->Camera();
-    camMsg->set_horizontal_fov(cam->HFOV().Radian());
     camMsg->mutable_image_size()->set_x(camSensor->ImageWidth());
     camMsg->mutable_image_size()->set_y(camSensor->ImageHeight());
+
+    // A lazy sensor may not have created its camera yet
+    if (!cam)
+    {
+      sdf::ElementPtr cameraSdf = this->sdf->GetElement("camera");
+      camMsg->set_horizontal_fov(cameraSdf->Get<double>("horizontal_fov"));
+      camMsg->set_image_format(
+          cameraSdf->GetElement("image")->Get<std::string>("format"));
+      sdf::ElementPtr clipSdf = cameraSdf->GetElement("clip");
+      camMsg->set_near_clip(clipSdf->Get<double>("near"));
+      camMsg->set_far_clip(clipSdf->Get<double>("far"));
+      return;
+    }
+
+    camMsg->set_horizontal_fov(cam->HFOV().Radian());
     camMsg->set_image_format(cam->ImageFormat());
     camMsg->set_near_clip(cam->NearClip());
     camMsg->set_far_clip(cam->FarClip());
@@ -513,13 +559,67 @@ NoisePtr Sensor::Noise(const SensorNoiseType _type) const
   return this->noises.at(_type);
 }
 
+//////////////////////////////////////////////////
+const common::Histogram &Sensor::StageDuration(const SensorStage _stage) const
+{
+  return this->dataPtr->stageDurations[
+    std::min(_stage, SENSOR_STAGE_PUBLISH)];
+}
+
+//////////////////////////////////////////////////
+const common::Histogram &Sensor::Latency() const
+{
+  return this->dataPtr->latency;
+}
+
+//////////////////////////////////////////////////
+std::string Sensor::StageName(const SensorStage _stage)
+{
+  switch (_stage)
+  {
+    case SENSOR_STAGE_UPDATE:
+      return "update";
+    case SENSOR_STAGE_RENDER:
+      return "render";
+    case SENSOR_STAGE_READBACK:
+      return "readback";
+    case SENSOR_STAGE_NOISE:
+      return "noise";
+    case SENSOR_STAGE_PUBLISH:
+      return "publish";
+    default:
+      return "";
+  }
+}
+
+//////////////////////////////////////////////////
+void Sensor::AddStageDuration(const SensorStage _stage,
+    const std::chrono::steady_clock::time_point &_start)
+{
+  if (_stage >= SENSOR_STAGE_COUNT)
+    return;
+
+  const auto duration = std::chrono::steady_clock::now() - _start;
+  this->dataPtr->stageDurations[_stage].Add(
+      std::chrono::duration<double>(duration).count());
+
+  // The other stages are part of the update
+  if (this->dataPtr->modelCost &&
+      (_stage == SENSOR_STAGE_UPDATE || _stage == SENSOR_STAGE_RENDER))
+  {
+    this->dataPtr->modelCost->Add(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+          duration).count());
+  }
+}
+
 //////////////////////////////////////////////////
 void Sensor::ResetLastUpdateTime()
 {
   std::lock_guard<std::mutex> lock(this->dataPtr->mutexLastUpdateTime);
   this->lastUpdateTime = 0.0;
   this->lastMeasurementTime = 0.0;
-  this->dataPtr->updateDelay = 0.0;
+  this->dataPtr->updateDelay = common::SimTimeNs();
 }
 
 //////////////////////////////////////////////////
@@ -535,8 +635,98 @@ double Sensor::NextRequiredTimestamp() const
   return std::numeric_limits<double>::quiet_NaN();
 }
 
+//////////////////////////////////////////////////
+common::SimTimeNs Sensor::NextUpdateTime() const
+{
+  // Rendering sensors use the scene time, and strict rate sensors decide
+  // in UpdateImpl, so they are always candidates
+  if (this->useStrictRate || this->dataPtr->category == IMAGE)
+    return common::SimTimeNs();
+
+  // NOTE: This matches the adjusted elapsed time in Sensor::Update
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutexLastUpdateTime);
+  return common::SimTimeNs(this->lastUpdateTime) +
+    common::SimTimeNs(this->updatePeriod) - this->dataPtr->updateDelay;
+}
+
 //////////////////////////////////////////////////
 bool Sensor::StrictRate() const
 {
   return this->useStrictRate;
 }
+
+//////////////////////////////////////////////////
+bool Sensor::Lazy() const
+{
+  return this->dataPtr->lazy;
+}
+
+//////////////////////////////////////////////////
+double Sensor::LazyIdleTime() const
+{
+  return this->dataPtr->lazyIdleTime;
+}
+
+//////////////////////////////////////////////////
+bool Sensor::ResourcesCreated() const
+{
+  return this->dataPtr->resourcesCreated;
+}
+
+//////////////////////////////////////////////////
+void Sensor::LoadLazy()
+{
+  const std::string kLazy = "ignition:lazy";
+  if (this->sdf->HasElement(kLazy))
+    this->dataPtr->lazy = this->sdf->Get<bool>(kLazy);
+
+  const std::string kLazyIdleTime = "ignition:lazy_idle_time";
+  if (this->sdf->HasElement(kLazyIdleTime))
+  {
+    this->dataPtr->lazyIdleTime =
+      std::max(0.0, this->sdf->Get<double>(kLazyIdleTime));
+  }
+
+  this->dataPtr->resourcesCreated = !this->dataPtr->lazy;
+}
+
+//////////////////////////////////////////////////
+bool Sensor::CreateResources()
+{
+  return true;
+}
+
+//////////////////////////////////////////////////
+void Sensor::ReleaseResources()
+{
+}
+
+//////////////////////////////////////////////////
+bool Sensor::UpdateLazyResources(const bool _force)
+{
+  const common::Time simTime = this->world->SimTime();
+
+  // The sim time went back, e.g. on a world reset
+  if (simTime < this->dataPtr->lastActiveTime)
+    this->dataPtr->lastActiveTime = simTime;
+
+  if (this->IsActive() || _force)
+  {
+    this->dataPtr->lastActiveTime = simTime;
+    if (!this->dataPtr->resourcesCreated && !this->dataPtr->resourcesFailed)
+    {
+      this->dataPtr->resourcesCreated = this->CreateResources();
+      this->dataPtr->resourcesFailed = !this->dataPtr->resourcesCreated;
+    }
+    return this->dataPtr->resourcesCreated;
+  }
+
+  if (this->dataPtr->resourcesCreated &&
+      (simTime - this->dataPtr->lastActiveTime).Double() >=
+      this->dataPtr->lazyIdleTime)
+  {
+    this->ReleaseResources();
+    this->dataPtr->resourcesCreated = false;
+  }
+  return false;
+}
@@ -17,6 +17,7 @@
 #ifndef GAZEBO_SENSORS_SENSOR_HH_
 #define GAZEBO_SENSORS_SENSOR_HH_
 
+#include <chrono>
 #include <vector>
 #include <memory>
 #include <map>
@@ -32,6 +33,8 @@
 
 #include "gazebo/msgs/msgs.hh"
 #include "gazebo/common/Events.hh"
+#include "gazebo/common/Histogram.hh"
+#include "gazebo/common/SimTimeNs.hh"
 #include "gazebo/common/Time.hh"
 #include "gazebo/transport/TransportTypes.hh"
 #include "gazebo/util/system.hh"
@@ -185,10 +188,54 @@ namespace gazebo
       /// \return the timestamp
       public: virtual double NextRequiredTimestamp() const;
 
+      /// \brief Get the sim time from which the sensor is due for an update,
+      /// used by the SensorManager to skip the sensors that are not due.
+      /// Sensors that must be updated on every pass, such as the rendering
+      /// sensors and the sensors that follow a strict rate, return zero.
+      /// \return Sim time of the next update.
+      public: common::SimTimeNs NextUpdateTime() const;
+
+      /// \brief Get the histogram of the real time spent in a stage of the
+      /// sensor updates.
+      /// \param[in] _stage The stage.
+      /// \return Durations of the stage (seconds).
+      public: const common::Histogram &StageDuration(
+                  const SensorStage _stage) const;
+
+      /// \brief Get the histogram of the sim time elapsed between the
+      /// measurements of the sensor and the end of the updates publishing
+      /// them.
+      /// \return Latencies of the sensor (sim seconds).
+      public: const common::Histogram &Latency() const;
+
+      /// \brief Get the name of a sensor stage.
+      /// \param[in] _stage The stage.
+      /// \return Name of the stage, e.g. "render".
+      public: static std::string StageName(const SensorStage _stage);
+
       /// \brief Returns true if the sensor is to follow strict update rate
       /// \return True when sensor should follow strict update rate
       public: bool StrictRate() const;
 
+      /// \brief Check whether the heavy resources of the sensor, such as
+      /// its rendering camera, only exist while the sensor is active or
+      /// has subscribers. They are created on the first update that needs
+      /// them, and released once the sensor has been idle for
+      /// LazyIdleTime(). The ignition:lazy element of the sensor enables
+      /// it, for the sensors that support it.
+      /// \return True if the sensor is lazy.
+      public: bool Lazy() const;
+
+      /// \brief Get the time a lazy sensor keeps its resources after it
+      /// became idle, set by the ignition:lazy_idle_time element.
+      /// \return Idle time in sim seconds.
+      public: double LazyIdleTime() const;
+
+      /// \brief Check whether the resources of the sensor exist, which is
+      /// always the case for a sensor that isn't lazy.
+      /// \return True if the resources exist.
+      public: bool ResourcesCreated() const;
+
       /// \brief This gets overwritten by derived sensor types.
       ///        This function is called during Sensor::Update.
       ///        And in turn, Sensor::Update is called by
@@ -201,6 +248,31 @@ namespace gazebo
       /// \return True when sensor should be updated.
       protected: virtual bool NeedsUpdate();
 
+      /// \brief Record the duration of a stage of the sensor update.
+      /// \param[in] _stage The stage.
+      /// \param[in] _start Time at which the stage started.
+      protected: void AddStageDuration(const SensorStage _stage,
+                  const std::chrono::steady_clock::time_point &_start);
+
+      /// \brief Read the ignition:lazy and ignition:lazy_idle_time
+      /// elements. Sensors that support lazy instantiation call it in Init,
+      /// and only create their resources there if the sensor isn't lazy.
+      protected: void LoadLazy();
+
+      /// \brief Create the resources of a lazy sensor, when it becomes
+      /// active or gains a subscriber.
+      /// \return True if the resources were created.
+      protected: virtual bool CreateResources();
+
+      /// \brief Release the resources of a lazy sensor that has been idle.
+      protected: virtual void ReleaseResources();
+
+      /// \brief Create or release the resources of a lazy sensor before
+      /// an update.
+      /// \param[in] _force True if the update is forced.
+      /// \return True if the sensor may be updated.
+      private: bool UpdateLazyResources(const bool _force);
+
       /// \brief Load a plugin for this sensor.
       /// \param[in] _sdf SDF parameters.
       private: void LoadPlugin(sdf::ElementPtr _sdf);
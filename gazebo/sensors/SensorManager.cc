@@ -15,9 +15,19 @@
  *
 */
 
+#include <algorithm>
+#include <chrono>
 #include <functional>
+#include <thread>
 #include <boost/bind/bind.hpp>
-
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+
+#include "gazebo/common/CostCounter.hh"
+#include "gazebo/common/ThreadConfig.hh"
+#include "gazebo/common/Tracer.hh"
+#include "gazebo/msgs/msgs.hh"
 #include "gazebo/physics/Link.hh"
 #include "gazebo/physics/Model.hh"
 #include "gazebo/physics/PhysicsIface.hh"
@@ -25,6 +35,9 @@
 #include "gazebo/physics/PhysicsIface.hh"
 #include "gazebo/physics/World.hh"
 #include "gazebo/rendering/Camera.hh"
+#include "gazebo/rendering/RenderEngine.hh"
+#include "gazebo/rendering/RenderingIface.hh"
+#include "gazebo/rendering/Scene.hh"
 #include "gazebo/sensors/CameraSensor.hh"
 #include "gazebo/sensors/Sensor.hh"
 #include "gazebo/sensors/SensorFactory.hh"
@@ -46,6 +59,23 @@ boost::mutex g_sensorTimingMutex;
 /// max update rate needs to be recalculated
 bool g_sensorsDirty = true;
 
+/// \brief Time without progress after which a sensor worker is no longer
+/// waited for.
+static const common::Time kOffloadTimeout(5, 0);
+
+/// \brief Period of the progress messages of a worker that is idle.
+static const common::Time kOffloadHeartbeat(1, 0);
+
+/// \brief Order of the sensor schedule, a min-heap on the due time.
+/// \param[in] _a First entry.
+/// \param[in] _b Second entry.
+/// \return True if _a is due after _b.
+static bool LaterUpdate(const std::pair<common::SimTimeNs, SensorPtr> &_a,
+    const std::pair<common::SimTimeNs, SensorPtr> &_b)
+{
+  return _a.first > _b.first;
+}
+
 /// Performance metrics variables
 /// \brief last sensor measurement sim time
 std::map<std::string, gazebo::common::Time> sensorsLastMeasurementTime;
@@ -88,16 +118,31 @@ common::Time lastRealTime;
 
 //////////////////////////////////////////////////
 SensorManager::SensorManager()
-  : initialized(false), removeAllSensors(false)
+  : workerThreads(1), initialized(false), removeAllSensors(false)
 {
   // sensors::IMAGE container
   this->sensorContainers.push_back(new ImageSensorContainer());
+  this->sensorContainers.back()->threadName = "sensors_image";
 
   // sensors::RAY container
   this->sensorContainers.push_back(new SensorContainer());
+  this->sensorContainers.back()->threadName = "sensors_ray";
 
   // sensors::OTHER container
   this->sensorContainers.push_back(new SensorContainer());
+  this->sensorContainers.back()->threadName = "sensors_other";
+
+  // sensors::INLINE container
+  this->sensorContainers.push_back(new InlineSensorContainer());
+
+  // The time spent updating each container is reported in the world
+  // statistics breakdown.
+  const char *names[] = {"image", "ray", "other", "inline"};
+  for (size_t i = 0; i < this->sensorContainers.size(); ++i)
+  {
+    this->sensorContainers[i]->cost =
+      common::CostCounter::Create("sensor", names[i]);
+  }
 }
 
 //////////////////////////////////////////////////
@@ -129,10 +174,186 @@ void SensorManager::RunThreads()
        iter != this->sensorContainers.end(); ++iter)
   {
     GZ_ASSERT((*iter) != nullptr, "Sensor Constainer is null");
+    (*iter)->SetWorkerThreads(this->workerThreads);
     (*iter)->Run();
   }
 }
 
+//////////////////////////////////////////////////
+void SensorManager::SetWorkerThreads(const unsigned int _threads)
+{
+  this->workerThreads = _threads;
+}
+
+//////////////////////////////////////////////////
+unsigned int SensorManager::WorkerThreads() const
+{
+  return this->workerThreads;
+}
+
+//////////////////////////////////////////////////
+void SensorManager::SetBatchRender(const bool _enabled)
+{
+  this->batchRender = _enabled;
+  static_cast<ImageSensorContainer *>(
+      this->sensorContainers[sensors::IMAGE])->SetBatchRender(_enabled);
+}
+
+//////////////////////////////////////////////////
+bool SensorManager::BatchRender() const
+{
+  return this->batchRender;
+}
+
+//////////////////////////////////////////////////
+void SensorManager::SetOffloadPrimary(const bool _enabled)
+{
+  this->offloadPrimary = _enabled;
+}
+
+//////////////////////////////////////////////////
+bool SensorManager::OffloadPrimary() const
+{
+  return this->offloadPrimary;
+}
+
+//////////////////////////////////////////////////
+void SensorManager::SetOffloadWorker(const std::string &_name)
+{
+  this->offloadWorker = _name;
+}
+
+//////////////////////////////////////////////////
+std::string SensorManager::OffloadWorker() const
+{
+  return this->offloadWorker;
+}
+
+//////////////////////////////////////////////////
+size_t SensorManager::OffloadWorkerCount() const
+{
+  std::lock_guard<std::mutex> lock(this->offloadMutex);
+  return this->offloadWorkers.size();
+}
+
+//////////////////////////////////////////////////
+void SensorManager::ConnectOffload(const std::string &_worldName)
+{
+  if (!this->offloadWorld.empty() ||
+      (!this->offloadPrimary && this->offloadWorker.empty()))
+  {
+    return;
+  }
+
+  this->offloadWorld = _worldName;
+  const std::string topic = "/gazebo/" + _worldName +
+      "/sensor_offload/progress";
+  if (this->offloadPrimary)
+  {
+    if (!this->offloadNode.Subscribe(topic,
+        &SensorManager::OnOffloadProgress, this))
+    {
+      gzerr << "Unable to subscribe to [" << topic << "]\n";
+    }
+  }
+  else
+  {
+    this->offloadPub =
+        this->offloadNode.Advertise<msgs::SensorWorker>(topic);
+  }
+}
+
+//////////////////////////////////////////////////
+void SensorManager::OnOffloadProgress(const msgs::SensorWorker &_msg)
+{
+  std::lock_guard<std::mutex> lock(this->offloadMutex);
+  OffloadWorkerProgress &progress = this->offloadWorkers[_msg.name()];
+  progress.simTime = msgs::Convert(_msg.sim_time()).Double();
+  progress.nextRequired = _msg.has_next_required() ?
+      msgs::Convert(_msg.next_required()).Double() :
+      std::numeric_limits<double>::quiet_NaN();
+  progress.heard = common::Time::GetWallTime();
+}
+
+//////////////////////////////////////////////////
+void SensorManager::WaitForOffloadWorkers(double _clk, double _dt)
+{
+  const common::SimTimeNs clk = common::SimTimeNs::FromSeconds(_clk);
+  const common::SimTimeNs halfStep = common::SimTimeNs::FromSeconds(_dt) / 2;
+
+  while (physics::worlds_running())
+  {
+    bool waiting = false;
+    {
+      std::lock_guard<std::mutex> lock(this->offloadMutex);
+      const common::Time now = common::Time::GetWallTime();
+      for (auto iter = this->offloadWorkers.begin();
+           iter != this->offloadWorkers.end();)
+      {
+        const OffloadWorkerProgress &progress = iter->second;
+        if (now - progress.heard > kOffloadTimeout)
+        {
+          gzwarn << "Sensor worker[" << iter->first << "] stopped, it is "
+                 << "no longer waited for\n";
+          iter = this->offloadWorkers.erase(iter);
+          continue;
+        }
+
+        // The worker is due at this tick and has not rendered it yet
+        if (!std::isnan(progress.nextRequired) &&
+            common::SimTimeNs::FromSeconds(progress.nextRequired) -
+            halfStep <= clk &&
+            common::SimTimeNs::FromSeconds(progress.simTime) + halfStep < clk)
+        {
+          waiting = true;
+        }
+        ++iter;
+      }
+    }
+
+    if (!waiting)
+      return;
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  }
+}
+
+//////////////////////////////////////////////////
+void SensorManager::PublishOffloadProgress()
+{
+  if (this->offloadWorker.empty() || this->offloadWorld.empty())
+    return;
+
+  rendering::ScenePtr scene = rendering::get_scene(this->offloadWorld);
+  if (!scene)
+    return;
+
+  // The poses of the scene are rendered once no sensor is due at their
+  // time
+  const common::Time sceneTime = scene->SimTime();
+  const double nextRequired = this->NextRequiredTimestamp();
+  msgs::SensorWorker msg;
+  msg.set_name(this->offloadWorker);
+  if (std::isnan(nextRequired) || nextRequired > sceneTime.Double())
+    msgs::Set(msg.mutable_sim_time(), sceneTime);
+  else if (this->offloadProgress.has_sim_time())
+    msg.mutable_sim_time()->CopyFrom(this->offloadProgress.sim_time());
+  else
+    msgs::Set(msg.mutable_sim_time(), common::Time::Zero);
+  if (!std::isnan(nextRequired))
+    msgs::Set(msg.mutable_next_required(), common::Time(nextRequired));
+
+  const common::Time now = common::Time::GetWallTime();
+  if (msg.SerializeAsString() == this->offloadProgress.SerializeAsString() &&
+      now - this->offloadPublishTime < kOffloadHeartbeat)
+  {
+    return;
+  }
+
+  this->offloadPub.Publish(msg);
+  this->offloadProgress = msg;
+  this->offloadPublishTime = now;
+}
+
 //////////////////////////////////////////////////
 void SensorManager::Stop()
 {
@@ -162,10 +383,23 @@ bool SensorManager::Running() const
 //////////////////////////////////////////////////
 void SensorManager::WaitForSensors(double _clk, double _dt)
 {
+  if (this->offloadPrimary)
+    this->WaitForOffloadWorkers(_clk, _dt);
+
+  if (rendering::lockstep_pipelined())
+  {
+    this->WaitForSensorsPipelined(_clk, _dt);
+    return;
+  }
+
+  // Compare in nanoseconds, so that a sensor due half a step away is
+  // waited for on exactly one tick
+  const common::SimTimeNs clk = common::SimTimeNs::FromSeconds(_clk);
+  const common::SimTimeNs halfStep = common::SimTimeNs::FromSeconds(_dt) / 2;
   double tnext = this->NextRequiredTimestamp();
 
   while (!std::isnan(tnext)
-      && ignition::math::lessOrNearEqual(tnext - _dt / 2.0, _clk)
+      && common::SimTimeNs::FromSeconds(tnext) - halfStep <= clk
       && physics::worlds_running())
   {
     this->WaitForPrerendered(0.001);
@@ -173,6 +407,111 @@ void SensorManager::WaitForSensors(double _clk, double _dt)
   }
 }
 
+//////////////////////////////////////////////////
+void SensorManager::WaitForSensorsPipelined(double _clk, double _dt)
+{
+  // The world was reset
+  if (!std::isnan(this->pipelineTime) && _clk < this->pipelineTime)
+    this->pipelineTime = std::numeric_limits<double>::quiet_NaN();
+
+  const common::SimTimeNs clk = common::SimTimeNs::FromSeconds(_clk);
+  const common::SimTimeNs halfStep = common::SimTimeNs::FromSeconds(_dt) / 2;
+
+  while (physics::worlds_running())
+  {
+    double tnext = this->NextRequiredTimestamp();
+
+    // The sensors took the poses once they all moved past their time
+    if (!std::isnan(this->pipelineTime) && (std::isnan(tnext) ||
+        common::SimTimeNs::FromSeconds(tnext) - halfStep >
+        common::SimTimeNs::FromSeconds(this->pipelineTime)))
+    {
+      this->pipelineTime = std::numeric_limits<double>::quiet_NaN();
+    }
+
+    if (std::isnan(this->pipelineTime))
+    {
+      // Keep the scene up to date, and let the sensors render the poses
+      // of this tick if they are due. The sensors are not all scheduled
+      // before the scene has received poses.
+      rendering::ScenePtr scene = rendering::get_scene();
+      if (scene)
+        scene->CommitPoses();
+
+      if (!std::isnan(tnext) &&
+          common::SimTimeNs::FromSeconds(tnext) - halfStep <= clk)
+      {
+        this->pipelineTime = _clk;
+      }
+      return;
+    }
+
+    // Step on while the sensors render, up to the next tick where a
+    // sensor is due
+    const double horizon = this->PipelineHorizon(_dt);
+    if (std::isnan(horizon) || _clk < horizon - _dt / 2.0)
+      return;
+
+    this->WaitForPrerendered(0.001);
+  }
+}
+
+//////////////////////////////////////////////////
+double SensorManager::PipelineHorizon(double _dt)
+{
+  double rv = std::numeric_limits<double>::quiet_NaN();
+
+  for (auto &s : this->sensorContainers[sensors::IMAGE]->sensors)
+  {
+    // skip deactivated sensors
+    if (!s->IsActive()) continue;
+
+    double candidate = s->NextRequiredTimestamp();
+    if (std::isnan(candidate))
+      continue;
+
+    // A sensor that has yet to render the poses is next due one period
+    // later
+    if (candidate - _dt / 2.0 <= this->pipelineTime)
+    {
+      const double rate = s->UpdateRate();
+      candidate += rate > 0.0 ? std::max(1.0 / rate, _dt) : _dt;
+    }
+
+    if (std::isnan(rv) || rv > candidate)
+      rv = candidate;
+  }
+
+  return rv;
+}
+
+/// \brief Add a histogram to the performance metrics of a sensor.
+/// \param[in] _name Name of the histogram.
+/// \param[in] _histogram The histogram, skipped if empty.
+/// \param[out] _msg Performance metrics of the sensor.
+static void FillHistogram(const std::string &_name,
+    const common::Histogram &_histogram,
+    msgs::PerformanceMetrics::PerformanceSensorMetrics &_msg)
+{
+  if (_histogram.Count() == 0)
+    return;
+
+  msgs::PerformanceMetrics::Histogram *msg = _msg.add_histogram();
+  msg->set_name(_name);
+  msg->set_count(_histogram.Count());
+  msg->set_sum(_histogram.Sum());
+  msg->set_max(_histogram.Max());
+
+  unsigned int binCount = _histogram.BinCount();
+  while (binCount > 0 && _histogram.BinValue(binCount - 1) == 0)
+    --binCount;
+  for (unsigned int i = 0; i < binCount; ++i)
+  {
+    msg->add_upper_bound(_histogram.BinUpperBound(i));
+    msg->add_bin_count(_histogram.BinValue(i));
+  }
+}
+
 void PublishPerformanceMetrics()
 {
   if (node == nullptr)
@@ -217,10 +556,23 @@ void PublishPerformanceMetrics()
   lastRealTime = realTime;
   lastSimTime = simTime;
 
+  // Memory of the textures and meshes
+  rendering::ScenePtr scene = rendering::get_scene(world->Name());
+  if (scene)
+  {
+    performanceMetricsMsg.set_gpu_memory(
+        rendering::RenderEngine::Instance()->GpuMemoryUsage());
+    performanceMetricsMsg.set_scene_gpu_memory(scene->GpuMemoryUsage());
+  }
+
+  // Load of the transport IO threads
+  for (const double utilization : transport::getIOThreadUtilization())
+    performanceMetricsMsg.add_io_thread_utilization(utilization);
+
   /// update sim time for sensors
-  for (auto model: world->Models())
+  for (auto const &model : world->Models())
   {
-    for (auto link: model->GetLinks())
+    for (auto const &link : model->GetLinks())
     {
       for (unsigned int i = 0; i < link->GetSensorCount(); i++)
       {
@@ -287,6 +639,32 @@ void PublishPerformanceMetrics()
       performanceSensorMetricsMsg->set_fps(
         sensorPerformanceMetric.second.sensorAvgFPS);
     }
+
+    sensors::SensorPtr sensor =
+      sensors::get_sensor(sensorPerformanceMetric.first);
+    if (!sensor)
+      continue;
+
+    for (int stage = 0; stage < SENSOR_STAGE_COUNT; ++stage)
+    {
+      FillHistogram(Sensor::StageName(static_cast<SensorStage>(stage)),
+          sensor->StageDuration(static_cast<SensorStage>(stage)),
+          *performanceSensorMetricsMsg);
+    }
+    FillHistogram("latency", sensor->Latency(), *performanceSensorMetricsMsg);
+
+    // Culling and draw statistics of cameras
+    sensors::CameraSensorPtr cameraSensor =
+      std::dynamic_pointer_cast<sensors::CameraSensor>(sensor);
+    if (cameraSensor && cameraSensor->Camera())
+    {
+      rendering::CameraPtr camera = cameraSensor->Camera();
+      performanceSensorMetricsMsg->set_visible_objects(
+          camera->VisibleObjectCount());
+      performanceSensorMetricsMsg->set_batches(camera->BatchCount());
+      performanceSensorMetricsMsg->set_triangles(camera->TriangleCount());
+      performanceSensorMetricsMsg->set_culling_time(camera->CullingTime());
+    }
   }
 
   // Publish data
@@ -369,6 +747,8 @@ void SensorManager::Update(bool _force)
   if (this->sensorContainers[sensors::IMAGE]->sensors.size() > 0)
     this->sensorContainers[sensors::IMAGE]->Update(_force);
 
+  this->PublishOffloadProgress();
+
   PublishPerformanceMetrics();
 }
 
@@ -499,6 +879,24 @@ std::string SensorManager::CreateSensor(sdf::ElementPtr _elem,
     return std::string();
   }
 
+  // The image sensors are rendered by the workers, which render nothing
+  // else
+  this->ConnectOffload(_worldName);
+  const bool offloaded = this->offloadPrimary &&
+      sensor->Category() == sensors::IMAGE;
+  if (offloaded || (!this->offloadWorker.empty() &&
+      sensor->Category() != sensors::IMAGE))
+  {
+    this->worlds[_worldName] = physics::get_world(_worldName);
+    if (offloaded && rendering::lockstep_enabled())
+    {
+      this->worlds[_worldName]->SetSensorWaitFunc(
+          std::bind(&SensorManager::WaitForSensors, this,
+            std::placeholders::_1, std::placeholders::_2));
+    }
+    return std::string();
+  }
+
   // Must come before sensor->Load
   sensor->SetParent(_parentName, _parentId);
 
@@ -643,6 +1041,8 @@ SensorManager::SensorContainer::SensorContainer()
   this->stop = true;
   this->initialized = false;
   this->runThread = nullptr;
+  this->scheduleDirty = true;
+  this->workerThreads = 1;
 }
 
 //////////////////////////////////////////////////
@@ -681,6 +1081,8 @@ void SensorManager::SensorContainer::Fini()
 
   // Remove all the sensors from the current sensor vector.
   this->sensors.clear();
+  this->schedule.clear();
+  this->scheduleDirty = true;
 
   this->initialized = false;
 }
@@ -694,6 +1096,15 @@ void SensorManager::SensorContainer::Run()
   GZ_ASSERT(this->runThread, "Unable to create boost::thread.");
 }
 
+//////////////////////////////////////////////////
+void SensorManager::SensorContainer::SetWorkerThreads(
+    const unsigned int _threads)
+{
+  this->workerThreads = _threads;
+  if (this->workerThreads == 0)
+    this->workerThreads = std::max(1u, std::thread::hardware_concurrency());
+}
+
 //////////////////////////////////////////////////
 void SensorManager::SensorContainer::Stop()
 {
@@ -719,6 +1130,7 @@ bool SensorManager::SensorContainer::Running() const
 //////////////////////////////////////////////////
 void SensorManager::SensorContainer::RunLoop()
 {
+  common::ThreadConfig::Instance()->Apply(this->threadName);
   this->stop = false;
 
   physics::WorldPtr world = physics::get_world();
@@ -729,6 +1141,12 @@ void SensorManager::SensorContainer::RunLoop()
 
   engine->InitForThread();
 
+  {
+    boost::recursive_mutex::scoped_lock lock(this->mutex);
+    this->world = world;
+    this->scheduleDirty = true;
+  }
+
   // The original value was hardcode to 1.0. Changed the value to
   // 1000 * MaxStepSize in order to handle simulation with a
   // large step size.
@@ -737,7 +1155,7 @@ void SensorManager::SensorContainer::RunLoop()
   // Release engine pointer, we don't need it in the loop
   engine.reset();
 
-  common::Time sleepTime, startTime, eventTime, diffTime;
+  common::SimTimeNs sleepTime, startTime, eventTime, diffTime;
   double maxUpdateRate = 0;
 
   boost::mutex tmpMutex;
@@ -749,7 +1167,10 @@ void SensorManager::SensorContainer::RunLoop()
   {
     this->runCondition.wait(lock2);
     if (this->stop)
+    {
+      this->world.reset();
       return;
+    }
   }
 
 
@@ -774,18 +1195,23 @@ void SensorManager::SensorContainer::RunLoop()
 
     // Calculate an appropriate sleep time.
     if (maxUpdateRate > 0)
-      sleepTime.Set(1.0 / (maxUpdateRate));
+      sleepTime = common::SimTimeNs::FromSeconds(1.0 / maxUpdateRate);
     else
-      sleepTime.Set(0, 1e6);
+      sleepTime = common::SimTimeNs(1000000);
   };
 
   computeMaxUpdateRate();
 
   IGN_PROFILE_THREAD_NAME("SensorManager");
 
+  // Workers that update the sensors due at the same time. The sensors of
+  // an update are spread over the workers, which steal each other's work.
+  tbb::task_arena arena(this->workerThreads);
+
   while (!this->stop)
   {
     IGN_PROFILE("SensorManager::RunLoop");
+    GZ_TRACE_SCOPE("sensors::SensorManager::RunLoop");
 
     // If all the sensors get deleted, wait here.
     // Use a while loop since world resets will notify the runCondition.
@@ -793,38 +1219,55 @@ void SensorManager::SensorContainer::RunLoop()
     {
       this->runCondition.wait(lock2);
       if (this->stop)
+      {
+        this->world.reset();
         return;
+      }
     }
 
     computeMaxUpdateRate();
 
     // Get the start time of the update.
-    startTime = world->SimTime();
+    startTime = world->SimTimeNs();
 
     IGN_PROFILE_BEGIN("UpdateSensors");
-    this->Update(false);
+    const uint64_t updateStart = common::CostCounter::Now();
+    arena.execute([this]()
+    {
+      this->Update(false);
+    });
+    if (this->cost)
+      this->cost->Add(common::CostCounter::Now() - updateStart);
     IGN_PROFILE_END();
 
     // Compute the time it took to update the sensors.
     // It's possible that the world time was reset during the Update. This
     // would case a negative diffTime. Instead, just use a event time of zero
-    diffTime = std::max(common::Time::Zero, world->SimTime() - startTime);
-
-    // Set the default sleep time
-    eventTime = std::max(common::Time::Zero, sleepTime - diffTime);
+    diffTime = std::max(common::SimTimeNs(), world->SimTimeNs() - startTime);
+
+    // Sleep until the next sensor is due. If a sensor must be updated on
+    // every pass, fall back to the period of the fastest sensor.
+    const common::SimTimeNs nextTime = this->NextUpdateTime();
+    const common::SimTimeNs simTime = world->SimTimeNs();
+    if (nextTime > simTime)
+      eventTime = nextTime - simTime;
+    else
+      eventTime = std::max(common::SimTimeNs(), sleepTime - diffTime);
 
     // Make sure update time is reasonable.
     // During log playback, time can jump forward an arbitrary amount.
-    if (diffTime.sec >= maxSensorUpdate && !util::LogPlay::Instance()->IsOpen())
+    const int64_t diffSec =
+      diffTime.Nanoseconds() / common::SimTimeNs::kNsInSec;
+    if (diffSec >= maxSensorUpdate && !util::LogPlay::Instance()->IsOpen())
     {
       gzwarn << "Took over 1000*max_step_size to update a sensor "
-        << "(took " << diffTime.sec << " sec, which is more than "
+        << "(took " << diffSec << " sec, which is more than "
         << "the max update of " << maxSensorUpdate << " sec). "
         << "This warning can be ignored during log playback" << std::endl;
     }
 
     // Make sure eventTime is not negative.
-    if (eventTime < common::Time::Zero)
+    if (eventTime < common::SimTimeNs())
     {
       gzerr << "Time to next sensor update is negative." << std::endl;
       continue;
@@ -845,6 +1288,9 @@ void SensorManager::SensorContainer::RunLoop()
     }
     IGN_PROFILE_END();
   }
+
+  boost::recursive_mutex::scoped_lock lock(this->mutex);
+  this->world.reset();
 }
 
 //////////////////////////////////////////////////
@@ -855,15 +1301,100 @@ void SensorManager::SensorContainer::Update(bool _force)
   if (this->sensors.empty())
     gzlog << "Updating a sensor container without any sensors.\n";
 
-  // Update all the sensors in this container.
-  for (Sensor_V::iterator iter = this->sensors.begin();
-       iter != this->sensors.end(); ++iter)
+  // Outside of the run thread, or when forced, update all the sensors in
+  // this container.
+  if (_force || !this->world)
   {
-    GZ_ASSERT((*iter) != nullptr, "Sensor is null");
-    IGN_PROFILE_BEGIN((*iter)->Name().c_str());
-    (*iter)->Update(_force);
-    IGN_PROFILE_END();
+    for (Sensor_V::iterator iter = this->sensors.begin();
+         iter != this->sensors.end(); ++iter)
+    {
+      GZ_ASSERT((*iter) != nullptr, "Sensor is null");
+      IGN_PROFILE_BEGIN((*iter)->Name().c_str());
+      (*iter)->Update(_force);
+      IGN_PROFILE_END();
+    }
+    this->scheduleDirty = true;
+    return;
+  }
+
+  const common::SimTimeNs simTime = this->world->SimTimeNs();
+
+  // Time went back, e.g. on a world reset or during log playback
+  if (simTime < this->scheduleTime)
+    this->scheduleDirty = true;
+  this->scheduleTime = simTime;
+
+  if (this->scheduleDirty)
+    this->Schedule();
+
+  // Take the sensors that are due. Sensors that must be updated on every
+  // pass are queued at zero, so they are taken once per pass.
+  this->dueSensors.clear();
+  while (!this->schedule.empty() && this->schedule.front().first <= simTime)
+  {
+    std::pop_heap(this->schedule.begin(), this->schedule.end(), LaterUpdate);
+    this->dueSensors.push_back(this->schedule.back().second);
+    this->schedule.pop_back();
   }
+
+  // Update them, on the workers of the run thread if there are several.
+  // Each sensor guards its own data.
+  if (this->workerThreads > 1 && this->dueSensors.size() > 1)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, this->dueSensors.size(),
+          1), [this](const tbb::blocked_range<size_t> &_r)
+        {
+          // Workers may use the physics engine, e.g. to cast rays
+          thread_local bool physicsThread = false;
+          if (!physicsThread)
+          {
+            this->world->Physics()->InitForThread();
+            physicsThread = true;
+          }
+
+          for (size_t i = _r.begin(); i != _r.end(); ++i)
+            this->dueSensors[i]->Update(false);
+        });
+  }
+  else
+  {
+    for (auto &sensor : this->dueSensors)
+    {
+      IGN_PROFILE_BEGIN(sensor->Name().c_str());
+      sensor->Update(false);
+      IGN_PROFILE_END();
+    }
+  }
+
+  // Queue them by their next due time
+  for (auto &sensor : this->dueSensors)
+  {
+    this->schedule.push_back(std::make_pair(sensor->NextUpdateTime(), sensor));
+    std::push_heap(this->schedule.begin(), this->schedule.end(), LaterUpdate);
+  }
+}
+
+//////////////////////////////////////////////////
+common::SimTimeNs SensorManager::SensorContainer::NextUpdateTime() const
+{
+  boost::recursive_mutex::scoped_lock lock(this->mutex);
+  if (this->scheduleDirty || this->schedule.empty())
+    return common::SimTimeNs();
+  return this->schedule.front().first;
+}
+
+//////////////////////////////////////////////////
+void SensorManager::SensorContainer::Schedule()
+{
+  this->schedule.clear();
+  this->schedule.reserve(this->sensors.size());
+  for (auto &sensor : this->sensors)
+  {
+    GZ_ASSERT(sensor != nullptr, "Sensor is null");
+    this->schedule.push_back(std::make_pair(sensor->NextUpdateTime(), sensor));
+  }
+  std::make_heap(this->schedule.begin(), this->schedule.end(), LaterUpdate);
+  this->scheduleDirty = false;
 }
 
 //////////////////////////////////////////////////
@@ -901,6 +1432,7 @@ void SensorManager::SensorContainer::AddSensor(SensorPtr _sensor)
   {
     boost::recursive_mutex::scoped_lock lock(this->mutex);
     this->sensors.push_back(_sensor);
+    this->scheduleDirty = true;
     g_sensorsDirty = true;
   }
 
@@ -931,6 +1463,7 @@ bool SensorManager::SensorContainer::RemoveSensor(const std::string &_name)
     }
   }
 
+  this->scheduleDirty = true;
   g_sensorsDirty = true;
 
   return removed;
@@ -949,6 +1482,7 @@ void SensorManager::SensorContainer::ResetLastUpdateTimes()
     GZ_ASSERT((*iter) != nullptr, "Sensor is null");
     (*iter)->ResetLastUpdateTime();
   }
+  this->scheduleDirty = true;
 
   // Tell the run loop that world time has been reset.
   this->runCondition.notify_one();
@@ -971,11 +1505,18 @@ void SensorManager::SensorContainer::RemoveSensors()
   g_sensorsDirty = true;
 
   this->sensors.clear();
+  this->schedule.clear();
+  this->scheduleDirty = true;
 }
 
 //////////////////////////////////////////////////
 void SensorManager::ImageSensorContainer::Update(bool _force)
 {
+  // The scene is created by the first camera sensor
+  rendering::ScenePtr scene = rendering::get_scene();
+  if (scene && scene->BatchRender() != this->batchRender)
+    scene->SetBatchRender(this->batchRender);
+
   // Prerender phase
   event::Events::preRender();
 
@@ -994,6 +1535,55 @@ void SensorManager::ImageSensorContainer::Update(bool _force)
   SensorContainer::Update(_force);
 }
 
+//////////////////////////////////////////////////
+void SensorManager::ImageSensorContainer::SetBatchRender(const bool _enabled)
+{
+  this->batchRender = _enabled;
+}
+
+//////////////////////////////////////////////////
+void SensorManager::InlineSensorContainer::Run()
+{
+  {
+    boost::recursive_mutex::scoped_lock lock(this->mutex);
+    this->world = physics::get_world();
+    GZ_ASSERT(this->world != nullptr, "Pointer to World is null");
+    this->scheduleDirty = true;
+
+    // The sensors are cheap, the physics thread updates them all
+    this->workerThreads = 1;
+  }
+
+  this->stop = false;
+  this->updateEndConnection = event::Events::ConnectWorldUpdateEnd(
+      std::bind(&SensorManager::InlineSensorContainer::OnWorldUpdateEnd,
+        this));
+}
+
+//////////////////////////////////////////////////
+void SensorManager::InlineSensorContainer::Stop()
+{
+  this->stop = true;
+  this->updateEndConnection.reset();
+
+  boost::recursive_mutex::scoped_lock lock(this->mutex);
+  this->world.reset();
+}
+
+//////////////////////////////////////////////////
+void SensorManager::InlineSensorContainer::OnWorldUpdateEnd()
+{
+  if (this->stop || this->sensors.empty())
+    return;
+
+  IGN_PROFILE("SensorManager::InlineUpdate");
+  GZ_TRACE_SCOPE("sensors::SensorManager::InlineUpdate");
+  const uint64_t start = common::CostCounter::Now();
+  this->Update(false);
+  if (this->cost)
+    this->cost->Add(common::CostCounter::Now() - start);
+}
+
 //////////////////////////////////////////////////
 bool SensorManager::ImageSensorContainer::WaitForPrerendered(double _timeoutsec)
 {
@@ -1029,6 +1619,13 @@ SimTimeEventHandler::~SimTimeEventHandler()
 /////////////////////////////////////////////////
 void SimTimeEventHandler::AddRelativeEvent(const common::Time &_time,
                                            boost::condition_variable *_var)
+{
+  this->AddRelativeEvent(common::SimTimeNs(_time), _var);
+}
+
+/////////////////////////////////////////////////
+void SimTimeEventHandler::AddRelativeEvent(const common::SimTimeNs &_time,
+                                           boost::condition_variable *_var)
 {
   boost::mutex::scoped_lock lock(this->mutex);
 
@@ -1037,7 +1634,7 @@ void SimTimeEventHandler::AddRelativeEvent(const common::Time &_time,
 
   // Create the new event.
   SimTimeEvent *event = new SimTimeEvent;
-  event->time = world->SimTime() + _time;
+  event->time = world->SimTimeNs() + _time;
   event->condition = _var;
 
   // Add the event to the list.
@@ -1050,6 +1647,8 @@ void SimTimeEventHandler::OnUpdate(const common::UpdateInfo &_info)
   boost::mutex::scoped_lock timingLock(g_sensorTimingMutex);
   boost::mutex::scoped_lock lock(this->mutex);
 
+  const common::SimTimeNs simTime(_info.simTime);
+
   // Iterate over all the events.
   for (std::list<SimTimeEvent*>::iterator iter = this->events.begin();
       iter != this->events.end();)
@@ -1058,7 +1657,7 @@ void SimTimeEventHandler::OnUpdate(const common::UpdateInfo &_info)
 
     // Find events that have a time less than or equal to simulation
     // time.
-    if ((*iter)->time <= _info.simTime)
+    if ((*iter)->time <= simTime)
     {
       // Notify the event by triggering its condition.
       (*iter)->condition->notify_all();
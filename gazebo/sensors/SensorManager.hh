@@ -22,13 +22,20 @@
 #include <vector>
 #include <list>
 #include <map>
+#include <utility>
 #include <condition_variable>
+#include <limits>
+#include <mutex>
 
+#include <ignition/transport/Node.hh>
 #include <sdf/sdf.hh>
 
 #include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/common/CostCounter.hh"
+#include "gazebo/common/SimTimeNs.hh"
 #include "gazebo/common/SingletonT.hh"
 #include "gazebo/common/UpdateInfo.hh"
+#include "gazebo/msgs/sensor_worker.pb.h"
 #include "gazebo/sensors/SensorTypes.hh"
 #include "gazebo/sensors/Sensor.hh"
 #include "gazebo/util/system.hh"
@@ -47,7 +54,7 @@ namespace gazebo
     class GZ_SENSORS_VISIBLE SimTimeEvent
     {
       /// \brief The time at which to trigger the condition.
-      public: common::Time time;
+      public: common::SimTimeNs time;
 
       /// \brief The condition to notify.
       public: boost::condition_variable *condition;
@@ -71,6 +78,14 @@ namespace gazebo
       public: void AddRelativeEvent(const common::Time &_time,
                   boost::condition_variable *_var);
 
+      /// \brief Add a new event to the handler.
+      /// \param[in] _time Time of the new event, relative to the current
+      /// sim time.
+      /// \param[in] _var Condition to notify when the time has been
+      /// reached.
+      public: void AddRelativeEvent(const common::SimTimeNs &_time,
+                  boost::condition_variable *_var);
+
       /// \brief Called when the world is updated.
       /// \param[in] _info Update timing information.
       private: void OnUpdate(const common::UpdateInfo &_info);
@@ -118,6 +133,60 @@ namespace gazebo
       /// This will only run non-image based sensor updates.
       public: void RunThreads();
 
+      /// \brief Set the number of worker threads that update the ray and
+      /// other non-image sensors due at the same sim time. Takes effect
+      /// when the threads are run.
+      /// \param[in] _threads Number of threads per container, 1 to update
+      /// the sensors in the container thread, 0 to use all the cores.
+      public: void SetWorkerThreads(const unsigned int _threads);
+
+      /// \brief Get the number of worker threads per non-image container.
+      /// \return Number of threads, 0 for all the cores.
+      public: unsigned int WorkerThreads() const;
+
+      /// \brief Set whether the cameras due at the same time with the same
+      /// view share their culling and shadow maps, see
+      /// rendering::Scene::SetBatchRender.
+      /// \param[in] _enabled True to enable the batched render mode.
+      public: void SetBatchRender(const bool _enabled);
+
+      /// \brief Get whether the batched render mode is enabled.
+      /// \return True if the batched render mode is enabled.
+      public: bool BatchRender() const;
+
+      /// \brief Let worker processes render the image sensors of the
+      /// worlds of this process, see SetOffloadWorker. The image sensors
+      /// are then not created here, and in lockstep the world waits for
+      /// the workers whose sensors are due, as it waits for its own
+      /// sensors. A worker not heard from for 5 seconds is no longer
+      /// waited for. Call it before the worlds are loaded.
+      /// \param[in] _enabled True to offload the image sensors.
+      /// \sa physics::World::SetSensorOffloadEnabled
+      public: void SetOffloadPrimary(const bool _enabled);
+
+      /// \brief Get whether the image sensors are rendered by workers.
+      /// \return True if the image sensors are offloaded.
+      public: bool OffloadPrimary() const;
+
+      /// \brief Render the image sensors of a world for a primary process.
+      /// Only the image sensors are created, and after each update the
+      /// time up to which they rendered is published on the
+      /// /gazebo/<world>/sensor_offload/progress ignition transport topic.
+      /// The world of this process follows the state of the primary, see
+      /// physics::World::SetSensorOffloadFollower. Call it before the
+      /// worlds are loaded.
+      /// \param[in] _name Name of the worker, unique among the workers of
+      /// the world, or empty to create all the sensors.
+      public: void SetOffloadWorker(const std::string &_name);
+
+      /// \brief Get the name of this worker.
+      /// \return The name, empty if this process is not a worker.
+      public: std::string OffloadWorker() const;
+
+      /// \brief Get the number of workers the primary waits for.
+      /// \return Number of workers heard from.
+      public: size_t OffloadWorkerCount() const;
+
       /// \brief Stop the run thread
       public: void Stop();
 
@@ -184,6 +253,42 @@ namespace gazebo
       /// \param[in] _dt world time step
       private: void WaitForSensors(double _clk, double _dt);
 
+      /// \brief Pipelined version of WaitForSensors: the poses of the world
+      /// tick at which image sensors are due are handed to the scene, and
+      /// the world steps on until the next tick at which a sensor is due,
+      /// where it waits for the sensors to take the previous poses.
+      /// \param[in] _clk simulated clock of the world
+      /// \param[in] _dt world time step
+      /// \sa rendering::set_lockstep_pipelined
+      private: void WaitForSensorsPipelined(double _clk, double _dt);
+
+      /// \brief Get the earliest time at which an image sensor is due,
+      /// after the poses handed to the scene are rendered.
+      /// \param[in] _dt world time step
+      /// \return Sim time at which the world must wait for the sensors,
+      /// NaN if no sensor is scheduled.
+      private: double PipelineHorizon(double _dt);
+
+      /// \brief Block until the workers rendered the current world tick,
+      /// if their sensors are due.
+      /// \param[in] _clk simulated clock of the world
+      /// \param[in] _dt world time step
+      /// \sa SetOffloadPrimary
+      private: void WaitForOffloadWorkers(double _clk, double _dt);
+
+      /// \brief Subscribe to the progress of the workers, or advertise
+      /// the progress of this worker, for a world.
+      /// \param[in] _worldName Name of the world.
+      private: void ConnectOffload(const std::string &_worldName);
+
+      /// \brief Called when a worker published its progress.
+      /// \param[in] _msg The progress of the worker.
+      private: void OnOffloadProgress(const msgs::SensorWorker &_msg);
+
+      /// \brief Publish the progress of this worker, when it changed or
+      /// once a second.
+      private: void PublishOffloadProgress();
+
       /// \brief Wait until pre-rendering phase is over.
       /// \param[in] _timeoutsec timeout expressed in seconds
       /// \return True if timeout has NOT been met
@@ -214,20 +319,34 @@ namespace gazebo
                  public: void Fini();
 
                  /// \brief Run the sensor updates in a separate thread.
-                 public: void Run();
+                 public: virtual void Run();
 
                  /// \brief Stop the run thread.
-                 public: void Stop();
+                 public: virtual void Stop();
 
                  /// \brief Get whether running or stopped.
                  /// \return True if running.
                  public: bool Running() const;
 
-                 /// \brief Update the sensors.
+                 /// \brief Update the sensors. When run by the run thread,
+                 /// without _force, only the sensors that are due are
+                 /// updated, see Sensor::NextUpdateTime.
                  /// \param[in] _force True to force the sensors to update,
                  /// even if they are not active.
                  public: virtual void Update(bool _force = false);
 
+                 /// \brief Set the number of threads that update the
+                 /// sensors due at the same sim time, used by Run.
+                 /// \param[in] _threads Number of threads, 0 to use all the
+                 /// cores.
+                 public: void SetWorkerThreads(const unsigned int _threads);
+
+                 /// \brief Get the sim time at which the next sensor is due.
+                 /// \return Sim time of the earliest sensor update, zero if
+                 /// a sensor must be updated on every pass, or if the
+                 /// sensors are not scheduled yet.
+                 public: common::SimTimeNs NextUpdateTime() const;
+
                  /// \brief Add a new sensor to this container.
                  /// \param[in] _sensor Pointer to a sensor to add.
                  public: void AddSensor(SensorPtr _sensor);
@@ -255,11 +374,44 @@ namespace gazebo
                  /// runThread.
                  private: void RunLoop();
 
+                 /// \brief Queue all the sensors by the sim time at which
+                 /// they are due.
+                 private: void Schedule();
+
+                 /// \brief Sensors by the sim time at which they are due, as
+                 /// a min-heap. Used by the run thread.
+                 private: std::vector<std::pair<common::SimTimeNs,
+                          SensorPtr>> schedule;
+
+                 /// \brief True if the schedule must be rebuilt, e.g. after
+                 /// the sensors changed.
+                 protected: bool scheduleDirty;
+
+                 /// \brief Sensors due in the current update.
+                 private: Sensor_V dueSensors;
+
+                 /// \brief Number of threads that update the due sensors.
+                 protected: unsigned int workerThreads;
+
+                 /// \brief Sim time of the last scheduled update.
+                 private: common::SimTimeNs scheduleTime;
+
+                 /// \brief World of the run thread, null if not running.
+                 protected: physics::WorldPtr world;
+
                  /// \brief The set of sensors to maintain.
                  public: Sensor_V sensors;
 
+                 /// \brief Time spent updating the sensors, reported in
+                 /// the world statistics breakdown.
+                 public: common::CostCounterPtr cost;
+
+                 /// \brief Name of the run thread, see
+                 /// common::ThreadConfig.
+                 public: std::string threadName = "sensors";
+
                  /// \brief Flag to inidicate when to stop the runThread.
-                 private: bool stop;
+                 protected: bool stop;
 
                  /// \brief Flag to indicate that the sensors have been
                  /// initialized.
@@ -269,7 +421,7 @@ namespace gazebo
                  private: boost::thread *runThread;
 
                  /// \brief A mutex to manage access to the sensors vector.
-                 private: mutable boost::recursive_mutex mutex;
+                 protected: mutable boost::recursive_mutex mutex;
 
                  /// \brief Condition used to block the RunLoop if no
                  /// sensors are present.
@@ -292,11 +444,45 @@ namespace gazebo
                  /// even if they are not active.
                  public: virtual void Update(bool _force = false);
 
+                 /// \brief Set whether the scene renders the cameras in the
+                 /// batched render mode.
+                 /// \param[in] _enabled True to enable the mode.
+                 public: void SetBatchRender(const bool _enabled);
+
                  /// \brief used to wait for the end of prerendering
                  private: std::condition_variable conditionPrerendered;
+
+                 /// \brief True to enable the batched render mode.
+                 private: bool batchRender = false;
+               };
+      /// \endcond
+
+      /// \cond
+      /// \brief Inline sensors are updated in the physics thread, at the
+      /// end of each world update, instead of in a thread of their own.
+      private: class InlineSensorContainer : public SensorContainer
+               {
+                 /// \brief Start updating the sensors at the end of each
+                 /// world update.
+                 public: virtual void Run();
+
+                 /// \brief Stop updating the sensors.
+                 public: virtual void Stop();
+
+                 /// \brief Called at the end of each world update.
+                 private: void OnWorldUpdateEnd();
+
+                 /// \brief Connection to the world update end event.
+                 private: event::ConnectionPtr updateEndConnection;
                };
       /// \endcond
 
+      /// \brief Number of worker threads per non-image container.
+      private: unsigned int workerThreads;
+
+      /// \brief True to enable the batched render mode.
+      private: bool batchRender = false;
+
       /// \brief True if SensorManager::Init has been called
       ///        i.e. SensorManager::sensors are initialized.
       private: bool initialized;
@@ -332,6 +518,11 @@ namespace gazebo
       /// includes worlds without sensors..
       private: std::map<std::string, physics::WorldPtr> worlds;
 
+      /// \brief Sim time of the poses handed to the scene for the due
+      /// image sensors, NaN if they were taken. Used when lockstepping is
+      /// pipelined.
+      private: double pipelineTime = std::numeric_limits<double>::quiet_NaN();
+
       /// \brief Connect to the time reset event.
       private: event::ConnectionPtr timeResetConnection;
 
@@ -340,6 +531,50 @@ namespace gazebo
 
       /// \brief Connect to the remove sensor event.
       private: event::ConnectionPtr removeSensorConnection;
+
+      /// \brief Progress of a worker, as seen by the primary.
+      private: class OffloadWorkerProgress
+               {
+                 /// \brief Sim time up to which the sensors rendered.
+                 public: double simTime;
+
+                 /// \brief Sim time at which the next sensor is due, NaN
+                 /// if none is active.
+                 public: double nextRequired;
+
+                 /// \brief Wall time of the last progress message.
+                 public: common::Time heard;
+               };
+
+      /// \brief True if workers render the image sensors.
+      private: bool offloadPrimary = false;
+
+      /// \brief Name of this worker, empty if not a worker.
+      private: std::string offloadWorker;
+
+      /// \brief Name of the world whose sensors are offloaded, empty
+      /// before the first sensor is created.
+      private: std::string offloadWorld;
+
+      /// \brief Progress of the workers, by name. Protected by
+      /// offloadMutex.
+      private: std::map<std::string, OffloadWorkerProgress> offloadWorkers;
+
+      /// \brief Mutex to protect offloadWorkers, which is written by the
+      /// transport threads.
+      private: mutable std::mutex offloadMutex;
+
+      /// \brief Node of the progress topic, which may reach other hosts.
+      private: ignition::transport::Node offloadNode;
+
+      /// \brief Publisher of the progress of this worker.
+      private: ignition::transport::Node::Publisher offloadPub;
+
+      /// \brief Last progress published by this worker.
+      private: msgs::SensorWorker offloadProgress;
+
+      /// \brief Wall time of the last progress published by this worker.
+      private: common::Time offloadPublishTime;
     };
     /// \}
   }
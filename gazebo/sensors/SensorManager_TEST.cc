@@ -16,6 +16,7 @@
 */
 
 #include <gtest/gtest.h>
+#include <ignition/transport/Node.hh>
 #include "gazebo/physics/PhysicsIface.hh"
 #include "gazebo/common/Time.hh"
 #include "gazebo/test/ServerFixture.hh"
@@ -159,6 +160,43 @@ TEST_F(SensorManager_TEST, InitRemove)
   printf("Done done\n");
 }
 
+/////////////////////////////////////////////////
+/// \brief Test that image sensors are left to the workers
+TEST_F(SensorManager_TEST, OffloadPrimary)
+{
+  sensors::SensorManager *mgr = sensors::SensorManager::Instance();
+  mgr->SetOffloadPrimary(true);
+  EXPECT_TRUE(mgr->OffloadPrimary());
+  EXPECT_TRUE(mgr->OffloadWorker().empty());
+
+  Load("worlds/test_camera_laser.world");
+  EXPECT_TRUE(mgr->SensorsInitialized());
+  EXPECT_EQ(nullptr, mgr->GetSensor("default::camera_1::link::camera"));
+  EXPECT_EQ(nullptr, mgr->GetSensor("default::camera_2::link::camera"));
+
+  // The workers are known once they report their progress
+  EXPECT_EQ(0u, mgr->OffloadWorkerCount());
+  ignition::transport::Node node;
+  auto pub = node.Advertise<msgs::SensorWorker>(
+      "/gazebo/default/sensor_offload/progress");
+  msgs::SensorWorker msg;
+  msg.set_name("worker_1");
+  msgs::Set(msg.mutable_sim_time(), common::Time(1.0));
+  msgs::Set(msg.mutable_next_required(), common::Time(1.1));
+
+  int i = 0;
+  while (mgr->OffloadWorkerCount() == 0 && i < 100)
+  {
+    pub.Publish(msg);
+    common::Time::MSleep(100);
+    ++i;
+  }
+  EXPECT_LT(i, 100);
+  EXPECT_EQ(1u, mgr->OffloadWorkerCount());
+
+  mgr->SetOffloadPrimary(false);
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
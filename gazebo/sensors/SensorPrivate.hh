@@ -17,12 +17,16 @@
 #ifndef GAZEBO_SENSORS_SENSOR_PRIVATE_HH_
 #define GAZEBO_SENSORS_SENSOR_PRIVATE_HH_
 
+#include <array>
 #include <mutex>
 #include <sdf/sdf.hh>
 
 #include "gazebo/rendering/RenderTypes.hh"
 
+#include "gazebo/common/CostCounter.hh"
 #include "gazebo/common/Event.hh"
+#include "gazebo/common/Histogram.hh"
+#include "gazebo/common/SimTimeNs.hh"
 #include "gazebo/common/Time.hh"
 #include "gazebo/sensors/SensorTypes.hh"
 #include "gazebo/physics/PhysicsTypes.hh"
@@ -46,7 +50,34 @@ namespace gazebo
       public: SensorCategory category;
 
       /// \brief Keep track how much the update has been delayed.
-      public: common::Time updateDelay;
+      public: common::SimTimeNs updateDelay;
+
+      /// \brief Durations of the stages of the updates (seconds).
+      public: std::array<common::Histogram, SENSOR_STAGE_COUNT> stageDurations;
+
+      /// \brief Sim time from measurement to publication (seconds).
+      public: common::Histogram latency;
+
+      /// \brief True if the resources are created on demand.
+      public: bool lazy = false;
+
+      /// \brief Sim seconds a lazy sensor keeps its resources once idle.
+      public: double lazyIdleTime = 10.0;
+
+      /// \brief True once the resources exist.
+      public: bool resourcesCreated = true;
+
+      /// \brief True if creating the resources failed, which isn't tried
+      /// again.
+      public: bool resourcesFailed = false;
+
+      /// \brief Last sim time a lazy sensor was active.
+      public: common::Time lastActiveTime;
+
+      /// \brief Counter of the time spent updating and rendering the
+      /// sensors of the model of the parent, null if the parent isn't in a
+      /// model.
+      public: common::CostCounterPtr modelCost;
 
       /// \brief The sensors unique ID.
       public: uint32_t id;
@@ -319,8 +319,36 @@ namespace gazebo
       /// \brief A type of sensor is not a RAY or IMAGE sensor.
       OTHER = 2,
 
+      /// \brief Sensor cheap enough to be updated in the physics thread, at
+      /// the end of each world update.
+      INLINE = 3,
+
       /// \brief Number of Sensor Categories
-      CATEGORY_COUNT = 3
+      CATEGORY_COUNT = 4
+    };
+
+    /// \brief Stages of a sensor update whose duration is measured.
+    /// \sa Sensor::StageDuration
+    enum SensorStage
+    {
+      /// \brief Whole update of the sensor, including the stages below
+      /// that happen during the update.
+      SENSOR_STAGE_UPDATE = 0,
+
+      /// \brief Rendering of the sensor image.
+      SENSOR_STAGE_RENDER = 1,
+
+      /// \brief Read back of the rendered data from the GPU.
+      SENSOR_STAGE_READBACK = 2,
+
+      /// \brief Noise applied on the CPU.
+      SENSOR_STAGE_NOISE = 3,
+
+      /// \brief Serialization and publication of the sensor messages.
+      SENSOR_STAGE_PUBLISH = 4,
+
+      /// \brief Number of sensor stages
+      SENSOR_STAGE_COUNT = 5
     };
   }
 }
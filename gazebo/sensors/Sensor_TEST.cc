@@ -207,6 +207,43 @@ TEST_F(Sensor_TEST, SetPose)
   EXPECT_EQ(sensor.Pose(), ignition::math::Pose3d(0, 1, 2, 3, 4, 5));
 }
 
+/////////////////////////////////////////////////
+/// \brief Test the histograms of the sensor update stages
+TEST_F(Sensor_TEST, StageMetrics)
+{
+  EXPECT_EQ("update", sensors::Sensor::StageName(sensors::SENSOR_STAGE_UPDATE));
+  EXPECT_EQ("render", sensors::Sensor::StageName(sensors::SENSOR_STAGE_RENDER));
+  EXPECT_EQ("publish",
+      sensors::Sensor::StageName(sensors::SENSOR_STAGE_PUBLISH));
+
+  Load("worlds/ray_test.world");
+  sensors::SensorPtr sensor = sensors::SensorManager::Instance()->GetSensor(
+      "default::hokuyo::link::laser");
+  ASSERT_TRUE(sensor != nullptr);
+
+  // Scans are only published with subscribers
+  transport::NodePtr node = transport::NodePtr(new transport::Node());
+  node->Init();
+  transport::SubscriberPtr laserSub = node->Subscribe(
+      "~/hokuyo/link/laser/scan", &ReceiveHokuyoMsg);
+
+  for (int i = 0; i < 100 &&
+      sensor->StageDuration(sensors::SENSOR_STAGE_PUBLISH).Count() == 0; ++i)
+  {
+    common::Time::MSleep(50);
+  }
+
+  const common::Histogram &update =
+    sensor->StageDuration(sensors::SENSOR_STAGE_UPDATE);
+  EXPECT_GT(update.Count(), 0u);
+  EXPECT_GE(update.Max(), update.Quantile(0.5));
+  EXPECT_GT(sensor->StageDuration(sensors::SENSOR_STAGE_PUBLISH).Count(), 0u);
+  EXPECT_GT(sensor->Latency().Count(), 0u);
+
+  // A ray sensor does not render
+  EXPECT_EQ(0u, sensor->StageDuration(sensors::SENSOR_STAGE_RENDER).Count());
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
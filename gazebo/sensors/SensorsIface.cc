@@ -103,6 +103,30 @@ void sensors::run_threads()
   sensors::SensorManager::Instance()->RunThreads();
 }
 
+/////////////////////////////////////////////////
+void sensors::set_worker_threads(const unsigned int _threads)
+{
+  sensors::SensorManager::Instance()->SetWorkerThreads(_threads);
+}
+
+/////////////////////////////////////////////////
+void sensors::set_batch_render(const bool _enabled)
+{
+  sensors::SensorManager::Instance()->SetBatchRender(_enabled);
+}
+
+/////////////////////////////////////////////////
+void sensors::set_offload_primary(const bool _enabled)
+{
+  sensors::SensorManager::Instance()->SetOffloadPrimary(_enabled);
+}
+
+/////////////////////////////////////////////////
+void sensors::set_offload_worker(const std::string &_name)
+{
+  sensors::SensorManager::Instance()->SetOffloadWorker(_name);
+}
+
 /////////////////////////////////////////////////
 void sensors::run_once(bool _force)
 {
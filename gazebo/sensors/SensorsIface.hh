@@ -59,6 +59,33 @@ namespace gazebo
     GZ_SENSORS_VISIBLE
     void run_threads();
 
+    /// \brief Set the number of worker threads that update the non-image
+    /// sensors due at the same time, see SensorManager::SetWorkerThreads.
+    /// Call it before run_threads.
+    /// \param[in] _threads Number of threads, 0 to use all the cores.
+    GZ_SENSORS_VISIBLE
+    void set_worker_threads(const unsigned int _threads);
+
+    /// \brief Set whether the cameras with the same view share their
+    /// culling and shadow maps, see SensorManager::SetBatchRender.
+    /// \param[in] _enabled True to enable the batched render mode.
+    GZ_SENSORS_VISIBLE
+    void set_batch_render(const bool _enabled);
+
+    /// \brief Set whether worker processes render the image sensors, see
+    /// SensorManager::SetOffloadPrimary. Call it before the worlds are
+    /// loaded.
+    /// \param[in] _enabled True to offload the image sensors.
+    GZ_SENSORS_VISIBLE
+    void set_offload_primary(const bool _enabled);
+
+    /// \brief Render the image sensors for a primary process, see
+    /// SensorManager::SetOffloadWorker. Call it before the worlds are
+    /// loaded.
+    /// \param[in] _name Name of the worker.
+    GZ_SENSORS_VISIBLE
+    void set_offload_worker(const std::string &_name);
+
     /// \brief Stop the sensor generation loop.
     GZ_SENSORS_VISIBLE
     void stop();
@@ -15,10 +15,15 @@
  *
 */
 #include <boost/algorithm/string.hpp>
+#include <algorithm>
+#include <cmath>
+#include <vector>
 
 #include <ignition/common/Profiler.hh>
 #include <ignition/math/Vector3.hh>
 
+#include "gazebo/physics/Model.hh"
+#include "gazebo/physics/RayQuery.hh"
 #include "gazebo/physics/World.hh"
 #include "gazebo/physics/SurfaceParams.hh"
 #include "gazebo/physics/MeshShape.hh"
@@ -51,11 +56,17 @@ SonarSensor::SonarSensor()
 //////////////////////////////////////////////////
 SonarSensor::~SonarSensor()
 {
-  this->dataPtr->sonarCollision->Fini();
-  this->dataPtr->sonarCollision.reset();
+  if (this->dataPtr->sonarCollision)
+  {
+    this->dataPtr->sonarCollision->Fini();
+    this->dataPtr->sonarCollision.reset();
+  }
 
-  this->dataPtr->sonarShape->Fini();
-  this->dataPtr->sonarShape.reset();
+  if (this->dataPtr->sonarShape)
+  {
+    this->dataPtr->sonarShape->Fini();
+    this->dataPtr->sonarShape.reset();
+  }
 }
 
 //////////////////////////////////////////////////
@@ -83,7 +94,6 @@ void SonarSensor::Load(const std::string &_worldName)
   this->dataPtr->radius = sonarElem->Get<double>("radius");
   const std::string geometry =
       sonarElem->GetElement("geometry")->Get<std::string>();
-  double range = this->dataPtr->rangeMax - this->dataPtr->rangeMin;
 
   if (this->dataPtr->radius < 0 && geometry == "cone")
   {
@@ -117,6 +127,37 @@ void SonarSensor::Load(const std::string &_worldName)
   GZ_ASSERT(this->dataPtr->parentEntity != nullptr,
       "Unable to get the parent entity.");
 
+  const std::string kElementName = "ignition:ray_fan";
+  if (sonarElem->HasElement(kElementName))
+    this->LoadRayFan(sonarElem->GetElement(kElementName), geometry);
+  else
+    this->LoadCollision(geometry);
+
+  // Advertise the sensor's topic on which we will output range data.
+  this->dataPtr->sonarPub = this->node->Advertise<msgs::SonarStamped>(
+      this->Topic());
+
+  // Initialize the message that will be published on this->dataPtr->sonarPub.
+  this->dataPtr->sonarMsg.mutable_sonar()->set_geometry(geometry);
+  this->dataPtr->sonarMsg.mutable_sonar()->set_range_min(
+      this->dataPtr->rangeMin);
+  this->dataPtr->sonarMsg.mutable_sonar()->set_range_max(
+      this->dataPtr->rangeMax);
+  this->dataPtr->sonarMsg.mutable_sonar()->set_radius(
+      this->dataPtr->radius);
+
+  ignition::math::Pose3d referencePose =
+    this->pose + this->dataPtr->parentEntity->WorldPose();
+  msgs::Set(this->dataPtr->sonarMsg.mutable_sonar()->mutable_world_pose(),
+      referencePose);
+  this->dataPtr->sonarMsg.mutable_sonar()->set_range(0);
+}
+
+//////////////////////////////////////////////////
+void SonarSensor::LoadCollision(const std::string &_geometry)
+{
+  const double range = this->dataPtr->rangeMax - this->dataPtr->rangeMin;
+
   physics::PhysicsEnginePtr physicsEngine = this->world->Physics();
 
   GZ_ASSERT(physicsEngine != nullptr,
@@ -145,7 +186,7 @@ void SonarSensor::Load(const std::string &_worldName)
   GZ_ASSERT(this->dataPtr->sonarShape != nullptr,
       "Unable to get the sonar shape from the sonar collision.");
 
-  if (geometry == "sphere")
+  if (_geometry == "sphere")
   {
     // Use a scaled sphere mesh for the sonar collision shape.
     this->dataPtr->sonarShape->SetMesh("unit_sphere");
@@ -157,9 +198,9 @@ void SonarSensor::Load(const std::string &_worldName)
   }
   else
   {
-    if (geometry != "cone")
+    if (_geometry != "cone")
     {
-      gzerr << "Invalid sonar collision shape [" << geometry
+      gzerr << "Invalid sonar collision shape [" << _geometry
             << "]. Defaults to cone." << std::endl;
     }
 
@@ -185,13 +226,6 @@ void SonarSensor::Load(const std::string &_worldName)
   this->dataPtr->sonarCollision->SetCollideBits(~GZ_SENSOR_COLLIDE);
   this->dataPtr->sonarCollision->SetCategoryBits(GZ_SENSOR_COLLIDE);
 
-  /*std::vector<std::string> collisions;
-  collisions.push_back(this->dataPtr->sonarCollision->GetScopedName());
-
-  physics::ContactManager *contactMgr =
-    this->world->Physics()->GetContactManager();
-    */
-
   // Create a contact topic for the collision shape
   std::string topic =
     this->world->Physics()->GetContactManager()->CreateFilter(
@@ -201,25 +235,64 @@ void SonarSensor::Load(const std::string &_worldName)
   // Subscribe to the contact topic
   this->dataPtr->contactSub = this->node->Subscribe(topic,
       &SonarSensor::OnContacts, this);
+}
 
-  // Advertise the sensor's topic on which we will output range data.
-  this->dataPtr->sonarPub = this->node->Advertise<msgs::SonarStamped>(
-      this->Topic());
+//////////////////////////////////////////////////
+void SonarSensor::LoadRayFan(sdf::ElementPtr _elem,
+    const std::string &_geometry)
+{
+  int rings = 2;
+  int samples = 8;
+  if (_elem->HasElement("rings"))
+    rings = _elem->Get<int>("rings");
+  if (_elem->HasElement("samples"))
+    samples = _elem->Get<int>("samples");
+  if (rings < 1 || samples < 1)
+  {
+    gzerr << "Sonar ray fan rings [" << rings << "] and samples ["
+          << samples << "] must be > 0, using 2 and 8" << std::endl;
+    rings = 2;
+    samples = 8;
+  }
 
-  // Initialize the message that will be published on this->dataPtr->sonarPub.
-  this->dataPtr->sonarMsg.mutable_sonar()->set_geometry(geometry);
-  this->dataPtr->sonarMsg.mutable_sonar()->set_range_min(
-      this->dataPtr->rangeMin);
-  this->dataPtr->sonarMsg.mutable_sonar()->set_range_max(
-      this->dataPtr->rangeMax);
-  this->dataPtr->sonarMsg.mutable_sonar()->set_radius(
-      this->dataPtr->radius);
+  // The sonar looks along the -z axis of the sensor, like its cone shape.
+  // The rays are one along the axis and rings of rays around it, up to the
+  // half angle of the cone, or around the whole sphere.
+  double maxAngle = IGN_PI;
+  if (_geometry == "sphere")
+  {
+    rings *= 2;
+  }
+  else
+  {
+    if (_geometry != "cone")
+    {
+      gzerr << "Invalid sonar collision shape [" << _geometry
+            << "]. Defaults to cone." << std::endl;
+    }
+    maxAngle = std::atan2(this->dataPtr->radius, this->dataPtr->rangeMax);
+  }
 
-  ignition::math::Pose3d referencePose =
-    this->pose + this->dataPtr->parentEntity->WorldPose();
-  msgs::Set(this->dataPtr->sonarMsg.mutable_sonar()->mutable_world_pose(),
-      referencePose);
-  this->dataPtr->sonarMsg.mutable_sonar()->set_range(0);
+  this->dataPtr->rayDirs.clear();
+  this->dataPtr->rayDirs.push_back(-ignition::math::Vector3d::UnitZ);
+  for (int i = 1; i <= rings; ++i)
+  {
+    const double polar = maxAngle * i / rings;
+    if (polar >= IGN_PI - 1e-9)
+    {
+      this->dataPtr->rayDirs.push_back(ignition::math::Vector3d::UnitZ);
+      break;
+    }
+
+    // Stagger every other ring
+    for (int j = 0; j < samples; ++j)
+    {
+      const double azimuth = 2.0 * IGN_PI * (j + 0.5 * (i % 2)) / samples;
+      this->dataPtr->rayDirs.push_back(ignition::math::Vector3d(
+          std::sin(polar) * std::cos(azimuth),
+          std::sin(polar) * std::sin(azimuth), -std::cos(polar)));
+    }
+  }
 }
 
 //////////////////////////////////////////////////
@@ -237,7 +310,8 @@ void SonarSensor::Init()
 //////////////////////////////////////////////////
 void SonarSensor::Fini()
 {
-  if (this->world && this->world->Running())
+  if (this->world && this->world->Running() &&
+      this->dataPtr->sonarCollision)
   {
     physics::ContactManager *mgr = this->world->Physics()->GetContactManager();
     mgr->RemoveFilter(this->dataPtr->sonarCollision->GetScopedName());
@@ -296,6 +370,25 @@ bool SonarSensor::UpdateImpl(const bool /*_force*/)
   msgs::Set(this->dataPtr->sonarMsg.mutable_sonar()->mutable_world_pose(),
       referencePose);
 
+  if (this->dataPtr->rayDirs.empty())
+    this->UpdateContacts(referencePose);
+  else
+    this->UpdateRays(referencePose);
+  IGN_PROFILE_END();
+
+  IGN_PROFILE_BEGIN("Publish");
+  this->dataPtr->update(this->dataPtr->sonarMsg);
+
+  if (this->dataPtr->sonarPub)
+    this->dataPtr->sonarPub->Publish(this->dataPtr->sonarMsg);
+  IGN_PROFILE_END();
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+void SonarSensor::UpdateContacts(const ignition::math::Pose3d &_referencePose)
+{
   ignition::math::Vector3d pos;
 
   // A 5-step hysteresis window was chosen to reduce range value from
@@ -328,13 +421,13 @@ bool SonarSensor::UpdateImpl(const bool /*_force*/)
       {
         // Get the contact position relative to the reference position.
         pos = msgs::ConvertIgn((*iter)->contact(i).position(j)) -
-          referencePose.Pos();
+          _referencePose.Pos();
 
         // Compute the sensed range.
         double len = pos.Length() - (*iter)->contact(i).depth(j);
 
         // Debug output:
-        // std::cout << "  RP[" << referencePose << "]  P[" << pos
+        // std::cout << "  RP[" << _referencePose << "]  P[" << pos
         //   << "] L[" << len << "] D["
         //   << (*iter)->contact(i).depth(j) << "]\n";
 
@@ -343,7 +436,7 @@ bool SonarSensor::UpdateImpl(const bool /*_force*/)
         {
           this->dataPtr->sonarMsg.mutable_sonar()->set_range(len);
           msgs::Set(this->dataPtr->sonarMsg.mutable_sonar()->mutable_contact(),
-              referencePose.Rot().RotateVectorReverse(pos));
+              _referencePose.Rot().RotateVectorReverse(pos));
         }
       }
     }
@@ -351,16 +444,56 @@ bool SonarSensor::UpdateImpl(const bool /*_force*/)
 
   // Clear the incoming contact list.
   this->dataPtr->incomingContacts.clear();
-  IGN_PROFILE_END();
+}
 
-  IGN_PROFILE_BEGIN("Publish");
-  this->dataPtr->update(this->dataPtr->sonarMsg);
+//////////////////////////////////////////////////
+void SonarSensor::UpdateRays(const ignition::math::Pose3d &_referencePose)
+{
+  std::vector<physics::RayQuery> rays(this->dataPtr->rayDirs.size());
+  for (size_t i = 0; i < rays.size(); ++i)
+  {
+    const ignition::math::Vector3d dir =
+      _referencePose.Rot().RotateVector(this->dataPtr->rayDirs[i]);
+    rays[i].start = _referencePose.Pos() + dir * this->dataPtr->rangeMin;
+    rays[i].end = _referencePose.Pos() + dir * this->dataPtr->rangeMax;
+
+    // This prevents an assertion in bullet (issue #849)
+    if (rays[i].start == rays[i].end)
+      rays[i].end.Z() += 0.00001;
+  }
 
-  if (this->dataPtr->sonarPub)
-    this->dataPtr->sonarPub->Publish(this->dataPtr->sonarMsg);
-  IGN_PROFILE_END();
+  std::vector<physics::RayQueryResult> results;
+  {
+    // Acquire the mutex for avoiding race condition with the physics
+    // engine
+    boost::recursive_mutex::scoped_lock lock(*(
+          this->world->Physics()->GetPhysicsUpdateMutex()));
+    this->world->Physics()->CastRays(rays, results);
+  }
 
-  return true;
+  // Like the collision shape, the rays do not sense the model of the sonar
+  std::string ownPrefix;
+  physics::ModelPtr model = this->dataPtr->parentEntity->GetParentModel();
+  if (model)
+    ownPrefix = model->GetScopedName() + "::";
+
+  this->dataPtr->sonarMsg.mutable_sonar()->set_range(this->dataPtr->rangeMax);
+  for (size_t i = 0; i < results.size(); ++i)
+  {
+    if (!results[i].Hit() || (!ownPrefix.empty() &&
+          results[i].collision.compare(0, ownPrefix.size(), ownPrefix) == 0))
+    {
+      continue;
+    }
+
+    const double len = this->dataPtr->rangeMin + results[i].distance;
+    if (len < this->dataPtr->sonarMsg.sonar().range())
+    {
+      this->dataPtr->sonarMsg.mutable_sonar()->set_range(len);
+      msgs::Set(this->dataPtr->sonarMsg.mutable_sonar()->mutable_contact(),
+          this->dataPtr->rayDirs[i] * len);
+    }
+  }
 }
 
 //////////////////////////////////////////////////
@@ -20,6 +20,9 @@
 #include <memory>
 #include <string>
 
+#include <ignition/math/Pose3.hh>
+#include <sdf/sdf.hh>
+
 #include "gazebo/sensors/Sensor.hh"
 #include "gazebo/util/system.hh"
 
@@ -38,7 +41,18 @@ namespace gazebo
     /// \class SonarSensor SonarSensor.hh sensors/sensors.hh
     /// \brief Sensor with sonar cone.
     ///
-    /// This sensor uses a cone .
+    /// This sensor uses a cone collision shape and reports the closest
+    /// contact. With an <ignition:ray_fan> element in <sonar>, it casts a
+    /// fan of rays that covers the cone, or the sphere, instead. The fan
+    /// adds no collision shape and no contacts to the physics engine:
+    ///
+    /// <sonar>
+    ///   ...
+    ///   <ignition:ray_fan>
+    ///     <rings>2</rings>      <!-- Rings of rays around the axis -->
+    ///     <samples>8</samples>  <!-- Rays per ring -->
+    ///   </ignition:ray_fan>
+    /// </sonar>
     class GZ_SENSORS_VISIBLE SonarSensor: public Sensor
     {
       /// \brief Constructor
@@ -101,6 +115,27 @@ namespace gazebo
       /// \brief Callback for contact messages from the physics engine.
       private: void OnContacts(ConstContactsPtr &_msg);
 
+      /// \brief Create the collision shape of the sonar.
+      /// \param[in] _geometry Geometry of the sonar, cone or sphere.
+      private: void LoadCollision(const std::string &_geometry);
+
+      /// \brief Compute the directions of the ray fan of the sonar.
+      /// \param[in] _elem The <ignition:ray_fan> element.
+      /// \param[in] _geometry Geometry of the sonar, cone or sphere.
+      private: void LoadRayFan(sdf::ElementPtr _elem,
+                   const std::string &_geometry);
+
+      /// \brief Update the range from the received contacts, with the
+      /// mutex locked.
+      /// \param[in] _referencePose World pose of the sonar.
+      private: void UpdateContacts(
+                   const ignition::math::Pose3d &_referencePose);
+
+      /// \brief Update the range by casting the ray fan, with the mutex
+      /// locked.
+      /// \param[in] _referencePose World pose of the sonar.
+      private: void UpdateRays(const ignition::math::Pose3d &_referencePose);
+
       /// \internal
       /// \brief Internal data pointer
       private: std::unique_ptr<SonarSensorPrivate> dataPtr;
@@ -19,7 +19,9 @@
 
 #include <list>
 #include <mutex>
+#include <vector>
 #include <ignition/math/Pose3.hh>
+#include <ignition/math/Vector3.hh>
 
 #include "gazebo/msgs/msgs.hh"
 #include "gazebo/physics/PhysicsTypes.hh"
@@ -78,6 +80,10 @@ namespace gazebo
       /// \brief Counts the number of times there were no contacts. This is
       /// used to reduce the range value jumping.
       public: int emptyContactCount;
+
+      /// \brief Unit directions of the rays of the ray fan, in the sensor
+      /// frame. Empty if the sonar uses a collision shape.
+      public: std::vector<ignition::math::Vector3d> rayDirs;
     };
   }
 }
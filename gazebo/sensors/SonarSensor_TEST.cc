@@ -39,6 +39,10 @@ class SonarSensor_TEST : public ServerFixture,
   /// \brief Test sonar with just a ground plane.
   /// \param[in] _physicsEngine Name of physics engine to use.
   public: void GroundPlane(const std::string &_physicsEngine);
+
+  /// \brief Test a ray fan sonar with just a ground plane.
+  /// \param[in] _physicsEngine Name of physics engine to use.
+  public: void RayFan(const std::string &_physicsEngine);
 };
 
 static std::string sonarSensorString =
@@ -191,6 +195,72 @@ void SonarSensor_TEST::GroundPlane(const std::string &_physicsEngine)
   EXPECT_NEAR(sonar->Range(), 2.0, 0.01);
 }
 
+/////////////////////////////////////////////////
+void SonarSensor_TEST::RayFan(const std::string &_physicsEngine)
+{
+  if (_physicsEngine != "ode" && _physicsEngine != "bullet")
+  {
+    gzerr << "Ray casting is not supported by " << _physicsEngine
+          << std::endl;
+    return;
+  }
+
+  Load("worlds/empty.world", false, _physicsEngine);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  // The sonar body sits around the sensor, and is not sensed
+  std::ostringstream modelStr;
+  modelStr << "<sdf version='" << SDF_VERSION << "'>"
+    << "<model name='sonar'>"
+    << "<static>true</static>"
+    << "<pose>0 0 1 0 0 0</pose>"
+    << "<link name='body'>"
+    << "  <collision name='collision'>"
+    << "    <geometry><box><size>0.1 0.1 0.1</size></box></geometry>"
+    << "  </collision>"
+    << "  <sensor name='sonar' type='sonar'>"
+    << "    <sonar>"
+    << "      <min>0</min>"
+    << "      <max>2</max>"
+    << "      <radius>0.2</radius>"
+    << "      <ignition:ray_fan>"
+    << "        <rings>2</rings>"
+    << "        <samples>6</samples>"
+    << "      </ignition:ray_fan>"
+    << "    </sonar>"
+    << "    <always_on>true</always_on>"
+    << "  </sensor>"
+    << "</link>"
+    << "</model>"
+    << "</sdf>";
+  SpawnSDF(modelStr.str());
+  WaitUntilEntitySpawn("sonar", 100, 100);
+  WaitUntilSensorSpawn("sonar", 100, 100);
+
+  sensors::SonarSensorPtr sonar =
+    std::dynamic_pointer_cast<sensors::SonarSensor>(
+        sensors::get_sensor("sonar"));
+  ASSERT_TRUE(sonar != nullptr);
+  physics::ModelPtr model = world->ModelByName("sonar");
+  ASSERT_TRUE(model != nullptr);
+
+  // No collision shape is added for the sonar
+  physics::LinkPtr link = model->GetLink("body");
+  ASSERT_TRUE(link != nullptr);
+  EXPECT_EQ(1u, link->GetCollisions().size());
+
+  // Sonar should detect the ground plane right away
+  sonar->Update(true);
+  EXPECT_NEAR(sonar->Range(), 1.0, 0.01);
+
+  // Rotate the model, and the sonar should not see the ground plane
+  model->SetWorldPose(ignition::math::Pose3d(0, 0, 1, 0, 1.5707, 0));
+  sonar->Update(true);
+  EXPECT_NEAR(sonar->Range(), 2.0, 0.01);
+}
+
+/////////////////////////////////////////////////
 TEST_P(SonarSensor_TEST, CreateSonar)
 {
   std::string physics = std::get<0>(GetParam());
@@ -217,6 +287,12 @@ TEST_P(SonarSensor_TEST, GroundPlane)
   GroundPlane(physics);
 }
 
+TEST_P(SonarSensor_TEST, RayFan)
+{
+  std::string physics = std::get<0>(GetParam());
+  RayFan(physics);
+}
+
 INSTANTIATE_TEST_CASE_P(SonarTests, SonarSensor_TEST,
   ::testing::Combine(PHYSICS_ENGINE_VALUES,
   ::testing::Values(false, true)),);  // NOLINT
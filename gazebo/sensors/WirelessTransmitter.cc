@@ -14,6 +14,10 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
 #include <ignition/math/Rand.hh>
 
 #include "gazebo/msgs/msgs.hh"
@@ -36,6 +40,7 @@ const double WirelessTransmitterPrivate::NObstacle = 12.0;
 const double WirelessTransmitterPrivate::ModelStdDev = 6.0;
 const double WirelessTransmitterPrivate::Step = 1.0;
 const double WirelessTransmitterPrivate::MaxRadius = 10.0;
+const double WirelessTransmitterPrivate::MapResolution = 0.1;
 
 /////////////////////////////////////////////////
 WirelessTransmitter::WirelessTransmitter()
@@ -79,10 +84,19 @@ void WirelessTransmitter::Init()
 {
   WirelessTransceiver::Init();
 
-  // This ray will be used in SignalStrength() for checking obstacles
-  // between the transmitter and a given point.
-  this->dataPtr->testRay = boost::dynamic_pointer_cast<RayShape>(
-      this->world->Physics()->CreateShape("ray", CollisionPtr()));
+  // Iterate using a rectangular grid, but only choose the points within
+  // a circunference of radius MaxRadius
+  this->dataPtr->gridPoints.clear();
+  for (double x = -this->dataPtr->MaxRadius;
+       x <= this->dataPtr->MaxRadius; x += this->dataPtr->Step)
+  {
+    for (double y = -this->dataPtr->MaxRadius;
+         y <= this->dataPtr->MaxRadius; y += this->dataPtr->Step)
+    {
+      if (std::hypot(x, y) <= this->dataPtr->MaxRadius)
+        this->dataPtr->gridPoints.push_back(ignition::math::Vector3d(x, y, 0));
+    }
+  }
 }
 
 //////////////////////////////////////////////////
@@ -92,38 +106,27 @@ bool WirelessTransmitter::UpdateImpl(const bool /*_force*/)
 
   if (this->dataPtr->visualize)
   {
+    std::vector<ignition::math::Pose3d> receivers;
+    receivers.reserve(this->dataPtr->gridPoints.size());
+    for (auto const &point : this->dataPtr->gridPoints)
+    {
+      receivers.push_back(ignition::math::Pose3d(point,
+            ignition::math::Quaterniond::Identity) + this->referencePose);
+    }
+
+    // For the propagation model assume the receiver antenna has the same
+    // gain as the transmitter
+    std::vector<double> strengths =
+      this->SignalStrengths(receivers, this->Gain());
+
     msgs::PropagationGrid msg;
-    ignition::math::Pose3d pos;
-    ignition::math::Pose3d worldPose;
-    double strength;
-    msgs::PropagationParticle *p;
-
-    // Iterate using a rectangular grid, but only choose the points within
-    // a circunference of radius MaxRadius
-    for (double x = -this->dataPtr->MaxRadius;
-         x <= this->dataPtr->MaxRadius; x += this->dataPtr->Step)
+    for (size_t i = 0; i < strengths.size(); ++i)
     {
-      for (double y = -this->dataPtr->MaxRadius;
-           y <= this->dataPtr->MaxRadius; y += this->dataPtr->Step)
-      {
-        pos.Set(x, y, 0.0, 0, 0, 0);
-
-        worldPose = pos + this->referencePose;
-
-        if (this->referencePose.Pos().Distance(worldPose.Pos()) <=
-            this->dataPtr->MaxRadius)
-        {
-          // For the propagation model assume the receiver antenna has the same
-          // gain as the transmitter
-          strength = this->SignalStrength(worldPose, this->Gain());
-
-          // Add a new particle to the grid
-          p = msg.add_particle();
-          p->set_x(x);
-          p->set_y(y);
-          p->set_signal_level(strength);
-        }
-      }
+      // Add a new particle to the grid
+      msgs::PropagationParticle *p = msg.add_particle();
+      p->set_x(this->dataPtr->gridPoints[i].X());
+      p->set_y(this->dataPtr->gridPoints[i].Y());
+      p->set_signal_level(strengths[i]);
     }
     this->pub->Publish(msg);
   }
@@ -148,35 +151,110 @@ double WirelessTransmitter::SignalStrength(
     const ignition::math::Pose3d &_receiver,
     const double _rxGain)
 {
-  std::string entityName;
-  double dist;
-  ignition::math::Vector3d end = _receiver.Pos();
-  ignition::math::Vector3d start = this->referencePose.Pos();
-
-  // Avoid computing the intersection of coincident points
-  // This prevents an assertion in bullet (issue #849)
-  if (start == end)
+  return this->SignalStrengths({_receiver}, _rxGain)[0];
+}
+
+/////////////////////////////////////////////////
+std::vector<double> WirelessTransmitter::SignalStrengths(
+    const std::vector<ignition::math::Pose3d> &_receivers,
+    const double _rxGain)
+{
+  std::vector<double> strengths(_receivers.size());
+  if (_receivers.empty())
+    return strengths;
+
+  std::lock_guard<std::mutex> mapLock(this->dataPtr->mapMutex);
+
+  // The propagation map only holds static obstacles, which stay valid until
+  // the transmitter moves or a model is added or removed
+  const unsigned int modelCount = this->world->ModelCount();
+  if (this->dataPtr->mapPose != this->referencePose ||
+      this->dataPtr->mapModelCount != modelCount)
   {
-    end.Z() += 0.00001;
+    this->dataPtr->staticBlocked.clear();
+    this->dataPtr->mapPose = this->referencePose;
+    this->dataPtr->mapModelCount = modelCount;
   }
 
-  // Acquire the mutex for avoiding race condition with the physics engine
-  boost::recursive_mutex::scoped_lock lock(*(
-        this->world->Physics()->GetPhysicsUpdateMutex()));
+  const ignition::math::Vector3d start = this->referencePose.Pos();
+  std::vector<bool> obstacles(_receivers.size(), false);
+  std::vector<int64_t> keys(_receivers.size());
+  std::vector<bool> mapped(_receivers.size());
+  std::vector<physics::RayQuery> rays;
+  std::vector<size_t> rayReceivers;
+  for (size_t i = 0; i < _receivers.size(); ++i)
+  {
+    mapped[i] = WirelessTransmitterPrivate::MapKey(
+        _receivers[i].Pos() - start, keys[i]);
+    if (mapped[i] && this->dataPtr->staticBlocked.count(keys[i]))
+    {
+      obstacles[i] = true;
+      continue;
+    }
 
-  // Compute the value of n depending on the obstacles between Tx and Rx
-  double n = WirelessTransmitterPrivate::NEmpty;
+    physics::RayQuery ray;
+    ray.start = start;
+    ray.end = _receivers[i].Pos();
 
-  // Looking for obstacles between start and end points
-  this->dataPtr->testRay->SetPoints(start, end);
-  this->dataPtr->testRay->GetIntersection(dist, entityName);
+    // Avoid computing the intersection of coincident points
+    // This prevents an assertion in bullet (issue #849)
+    if (ray.start == ray.end)
+      ray.end.Z() += 0.00001;
 
-  // ToDo: The ray intersects with my own collision model. Fix it.
-  if (entityName != "")
+    rays.push_back(ray);
+    rayReceivers.push_back(i);
+  }
+
+  if (!rays.empty())
+  {
+    std::vector<physics::RayQueryResult> results;
+    {
+      // Acquire the mutex for avoiding race condition with the physics
+      // engine
+      boost::recursive_mutex::scoped_lock lock(*(
+            this->world->Physics()->GetPhysicsUpdateMutex()));
+
+      // Looking for obstacles between start and end points
+      this->world->Physics()->CastRays(rays, results);
+    }
+
+    for (size_t j = 0; j < results.size(); ++j)
+    {
+      // ToDo: The ray intersects with my own collision model. Fix it.
+      if (!results[j].Hit())
+        continue;
+
+      const size_t i = rayReceivers[j];
+      obstacles[i] = true;
+
+      if (!mapped[i])
+        continue;
+
+      EntityPtr entity = this->world->EntityByName(results[j].collision);
+      ModelPtr model = entity ? entity->GetParentModel() : ModelPtr();
+      if (model && model->IsStatic())
+        this->dataPtr->staticBlocked.insert(keys[i]);
+    }
+  }
+
+  for (size_t i = 0; i < _receivers.size(); ++i)
   {
-    n = WirelessTransmitterPrivate::NObstacle;
+    strengths[i] = this->PropagationModel(_receivers[i], _rxGain,
+        obstacles[i]);
   }
 
+  return strengths;
+}
+
+/////////////////////////////////////////////////
+double WirelessTransmitter::PropagationModel(
+    const ignition::math::Pose3d &_receiver, const double _rxGain,
+    const bool _obstacle) const
+{
+  // Compute the value of n depending on the obstacles between Tx and Rx
+  const double n = _obstacle ? WirelessTransmitterPrivate::NObstacle :
+      WirelessTransmitterPrivate::NEmpty;
+
   double distance = std::max(1.0,
       this->referencePose.Pos().Distance(_receiver.Pos()));
   double x = std::abs(ignition::math::Rand::DblNormal(0.0,
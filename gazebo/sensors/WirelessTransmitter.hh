@@ -19,6 +19,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 #include "gazebo/physics/physics.hh"
 #include "gazebo/sensors/WirelessTransceiver.hh"
 #include "gazebo/transport/TransportTypes.hh"
@@ -68,11 +69,34 @@ namespace gazebo
       public: double SignalStrength(const ignition::math::Pose3d &_receiver,
           const double _rxGain);
 
+      /// \brief Returns the signal strength at several receivers (dBm).
+      /// The line of sight to all the receivers is tested with a single
+      /// batch of rays. Receivers whose line of sight is blocked by a static
+      /// model are remembered in a propagation map, which is looked up
+      /// instead of casting their rays again while the transmitter does not
+      /// move and no model is added or removed.
+      /// \param[in] _receivers Poses of the receivers
+      /// \param[in] _rxGain Receiver gain value
+      /// \return Signal strength at each receiver (dBm), in the same order.
+      public: std::vector<double> SignalStrengths(
+          const std::vector<ignition::math::Pose3d> &_receivers,
+          const double _rxGain);
+
       /// \brief Get the std dev of the Gaussian random variable used in the
       /// propagation model.
       /// \return The standard deviation of the propagation model.
       public: double ModelStdDev() const;
 
+      /// \brief Evaluate the propagation model.
+      /// \param[in] _receiver Pose of the receiver
+      /// \param[in] _rxGain Receiver gain value
+      /// \param[in] _obstacle True if there are obstacles between the
+      /// transmitter and the receiver
+      /// \return Signal strength at the receiver (dBm).
+      private: double PropagationModel(
+          const ignition::math::Pose3d &_receiver, const double _rxGain,
+          const bool _obstacle) const;
+
       /// \internal
       /// \brief Private data pointer
       private: std::unique_ptr<WirelessTransmitterPrivate> dataPtr;
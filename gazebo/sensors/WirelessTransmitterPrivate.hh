@@ -17,7 +17,16 @@
 #ifndef _GAZEBO_SENSORS_WIRELESSTRANSMITTER_PRIVATE_HH_
 #define _GAZEBO_SENSORS_WIRELESSTRANSMITTER_PRIVATE_HH_
 
+#include <cmath>
+#include <cstdint>
+#include <mutex>
 #include <string>
+#include <unordered_set>
+#include <vector>
+
+#include <ignition/math/Pose3.hh>
+#include <ignition/math/Vector3.hh>
+
 #include "gazebo/physics/PhysicsTypes.hh"
 
 namespace gazebo
@@ -57,8 +66,48 @@ namespace gazebo
       /// \brief Reception frequency (MHz).
       public: double freq = 2442.0;
 
-      // \brief Ray used to test for collisions when placing entities
-      public: physics::RayShapePtr testRay;
+      /// \brief Resolution of the propagation map (m).
+      public: static const double MapResolution;
+
+      /// \brief Key of the propagation map cell holding a receiver.
+      /// \param[in] _offset Position of the receiver relative to the
+      /// transmitter, in the world frame.
+      /// \param[out] _key Key of the cell.
+      /// \return False if the receiver is too far to be in the map.
+      public: static bool MapKey(const ignition::math::Vector3d &_offset,
+                  int64_t &_key)
+              {
+                const int64_t half = int64_t(1) << 20;
+                _key = 0;
+                for (int i = 0; i < 3; ++i)
+                {
+                  const int64_t c = static_cast<int64_t>(
+                      std::floor(_offset[i] / MapResolution));
+                  if (c < -half || c >= half)
+                    return false;
+                  _key = (_key << 21) | (c + half);
+                }
+                return true;
+              }
+
+      /// \brief Points of the visualization grid, relative to the
+      /// transmitter.
+      public: std::vector<ignition::math::Vector3d> gridPoints;
+
+      /// \brief Propagation map: keys of the cells whose line of sight to
+      /// the transmitter is blocked by a static model, see MapKey. Those
+      /// receivers need no ray.
+      public: std::unordered_set<int64_t> staticBlocked;
+
+      /// \brief Transmitter pose the propagation map was computed for.
+      public: ignition::math::Pose3d mapPose;
+
+      /// \brief Number of models in the world when the propagation map was
+      /// computed.
+      public: unsigned int mapModelCount = 0;
+
+      /// \brief Protects the propagation map from concurrent receivers.
+      public: std::mutex mapMutex;
     };
   }
 }
@@ -16,6 +16,9 @@
 */
 
 #include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+
 #include "gazebo/test/ServerFixture.hh"
 
 using namespace gazebo;
@@ -24,6 +27,7 @@ class WirelessTransmitter_TEST : public ServerFixture
     public: WirelessTransmitter_TEST();
     public: void TestCreateWirelessTransmitter();
     public: void TestSignalStrength();
+    public: void TestSignalStrengths();
     public: void TestUpdateImpl();
     public: void TestUpdateImplNoVisual();
     public: void TestInvalidFreq();
@@ -159,6 +163,35 @@ void WirelessTransmitter_TEST::TestSignalStrength()
   EXPECT_NEAR(signStrengthAvg, -62.0, this->tx->ModelStdDev());
 }
 
+/////////////////////////////////////////////////
+/// \brief Test the batched signal strength function
+void WirelessTransmitter_TEST::TestSignalStrengths()
+{
+  this->tx->Update(true);
+  EXPECT_TRUE(this->tx->SignalStrengths({}, tx->Gain()).empty());
+
+  // Receivers in every direction at the same distance
+  std::vector<ignition::math::Pose3d> receivers;
+  for (int i = 0; i < 100; ++i)
+  {
+    double angle = i * 2 * M_PI / 100;
+    receivers.push_back(ignition::math::Pose3d(
+        ignition::math::Vector3d(4.24 * cos(angle), 4.24 * sin(angle), 0.055),
+        ignition::math::Quaterniond(0, 0, 0)));
+  }
+
+  std::vector<double> strengths =
+    this->tx->SignalStrengths(receivers, tx->Gain());
+  ASSERT_EQ(receivers.size(), strengths.size());
+
+  double signStrengthAvg = 0.0;
+  for (auto const strength : strengths)
+    signStrengthAvg += strength;
+  signStrengthAvg /= strengths.size();
+
+  EXPECT_NEAR(signStrengthAvg, -62.0, this->tx->ModelStdDev());
+}
+
 /////////////////////////////////////////////////
 /// \brief Callback executed for every propagation grid message received
 void WirelessTransmitter_TEST::TxMsg(const ConstPropagationGridPtr &_msg)
@@ -254,6 +287,12 @@ TEST_F(WirelessTransmitter_TEST, TestSignalStrength)
   TestSignalStrength();
 }
 
+/////////////////////////////////////////////////
+TEST_F(WirelessTransmitter_TEST, TestSignalStrengths)
+{
+  TestSignalStrengths();
+}
+
 /////////////////////////////////////////////////
 TEST_F(WirelessTransmitter_TEST, TestUpdateImpl)
 {
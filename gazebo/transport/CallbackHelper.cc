@@ -39,6 +39,26 @@ std::string CallbackHelper::GetMsgType() const
   return std::string();
 }
 
+/////////////////////////////////////////////////
+const google::protobuf::Descriptor *CallbackHelper::GetDescriptor() const
+{
+  return NULL;
+}
+
+/////////////////////////////////////////////////
+MessagePtr CallbackHelper::Parse(const std::string &/*_data*/) const
+{
+  return MessagePtr();
+}
+
+/////////////////////////////////////////////////
+bool CallbackHelper::HandleSharedData(
+    const std::shared_ptr<const std::string> &_newdata,
+    boost::function<void(uint32_t)> _cb, uint32_t _id)
+{
+  return this->HandleData(*_newdata, _cb, _id);
+}
+
 /////////////////////////////////////////////////
 bool CallbackHelper::GetLatching() const
 {
@@ -58,3 +78,53 @@ unsigned int CallbackHelper::GetId() const
 {
   return this->id;
 }
+
+/////////////////////////////////////////////////
+void CallbackHelper::SetQos(const SubscriptionQos &_qos)
+{
+  std::lock_guard<std::mutex> lock(this->qosMutex);
+  this->qos = _qos;
+}
+
+/////////////////////////////////////////////////
+SubscriptionQos CallbackHelper::Qos() const
+{
+  std::lock_guard<std::mutex> lock(this->qosMutex);
+  return this->qos;
+}
+
+/////////////////////////////////////////////////
+bool CallbackHelper::DeliveryDue()
+{
+  std::lock_guard<std::mutex> lock(this->qosMutex);
+  if (this->qos.Rate() <= 0.0)
+    return true;
+
+  const auto now = std::chrono::steady_clock::now();
+  const std::chrono::duration<double> period(1.0 / this->qos.Rate());
+  if (this->lastDelivery.time_since_epoch().count() != 0 &&
+      now - this->lastDelivery < period)
+  {
+    return false;
+  }
+
+  this->lastDelivery = now;
+  return true;
+}
+
+/////////////////////////////////////////////////
+size_t CallbackHelper::FirstDelivered(const size_t _count)
+{
+  if (_count == 0)
+    return 0;
+
+  // A rate limited callback gets the latest message when it is due
+  if (this->Qos().Rate() > 0.0)
+    return this->DeliveryDue() ? _count - 1 : _count;
+
+  const unsigned int depth = this->Qos().Depth();
+  if (depth > 0 && _count > depth)
+    return _count - depth;
+
+  return 0;
+}
@@ -21,6 +21,8 @@
 #include <boost/function.hpp>
 #include <boost/shared_ptr.hpp>
 
+#include <chrono>
+#include <memory>
 #include <vector>
 #include <string>
 #include <mutex>
@@ -29,6 +31,7 @@
 #include "gazebo/msgs/msgs.hh"
 #include "gazebo/common/Exception.hh"
 
+#include "gazebo/transport/SubscriptionQos.hh"
 #include "gazebo/transport/TransportTypes.hh"
 #include "gazebo/util/system.hh"
 
@@ -55,6 +58,19 @@ namespace gazebo
       /// \return String representation of the message type
       public: virtual std::string GetMsgType() const;
 
+      /// \brief Get the descriptor of the message type that is handled.
+      /// Callbacks with the same descriptor take the same message class,
+      /// so one parsed message may be shared between them.
+      /// \return The descriptor, NULL if the callback takes raw data.
+      public: virtual const google::protobuf::Descriptor *GetDescriptor()
+              const;
+
+      /// \brief Parse serialized data into the message type that is
+      /// handled, to be passed to HandleMessage.
+      /// \param[in] _data The serialized message.
+      /// \return The message, NULL if the callback takes raw data.
+      public: virtual MessagePtr Parse(const std::string &_data) const;
+
       /// \brief Process new incoming data
       /// \param[in] _newdata Incoming data to be processed
       /// \return true if successfully processed; false otherwise
@@ -64,6 +80,18 @@ namespace gazebo
       public: virtual bool HandleData(const std::string &_newdata,
                   boost::function<void(uint32_t)> _cb, uint32_t _id) = 0;
 
+      /// \brief Process new incoming data shared with other callbacks. A
+      /// callback that keeps the data may keep the pointer instead of a
+      /// copy. The default implementation calls HandleData.
+      /// \param[in] _newdata Incoming data to be processed
+      /// \param[in] _cb If non-null, callback to be invoked which signals
+      /// that transmission is complete.
+      /// \param[in] _id ID associated with the message data.
+      /// \return true if successfully processed; false otherwise
+      public: virtual bool HandleSharedData(
+                  const std::shared_ptr<const std::string> &_newdata,
+                  boost::function<void(uint32_t)> _cb, uint32_t _id);
+
       /// \brief Process new incoming message
       /// \param[in] _newMsg Incoming message to be processed
       /// \return true if successfully processed; false otherwise
@@ -87,6 +115,27 @@ namespace gazebo
       /// \return The unique ID of this callback.
       public: unsigned int GetId() const;
 
+      /// \brief Set the delivery policy of this callback.
+      /// \param[in] _qos The policy.
+      public: void SetQos(const SubscriptionQos &_qos);
+
+      /// \brief Get the delivery policy of this callback.
+      /// \return The policy.
+      public: SubscriptionQos Qos() const;
+
+      /// \brief Check whether a message may be delivered now under the
+      /// rate limit of the policy, and if so record the delivery.
+      /// \return True if the message may be delivered.
+      public: bool DeliveryDue();
+
+      /// \brief Select the messages of a batch, oldest first, to deliver
+      /// according to the policy. Records a delivery if the policy has a
+      /// rate limit.
+      /// \param[in] _count Number of messages in the batch.
+      /// \return Index of the first message to deliver; the following ones
+      /// are delivered too. Equal to _count if none is delivered.
+      public: size_t FirstDelivered(const size_t _count);
+
       /// \brief True means that the callback helper will get the last
       /// published message on the topic.
       protected: bool latching;
@@ -94,6 +143,15 @@ namespace gazebo
       /// \brief Mutex to protect the latching variable.
       protected: mutable std::mutex latchingMutex;
 
+      /// \brief Delivery policy.
+      private: SubscriptionQos qos;
+
+      /// \brief Time of the last delivery, used for rate limiting.
+      private: std::chrono::steady_clock::time_point lastDelivery;
+
+      /// \brief Protects the policy and the last delivery.
+      private: mutable std::mutex qosMutex;
+
       /// \brief A counter to generate the unique id of this callback.
       private: static unsigned int idCounter;
 
@@ -152,11 +210,35 @@ namespace gazebo
                 return true;
               }
 
+      // documentation inherited
+      public: virtual const google::protobuf::Descriptor *GetDescriptor()
+              const
+              {
+                return M::descriptor();
+              }
+
+      // documentation inherited
+      public: virtual MessagePtr Parse(const std::string &_data) const
+              {
+                boost::shared_ptr<M> m(new M);
+                m->ParseFromString(_data);
+                return m;
+              }
+
       // documentation inherited
       public: virtual bool HandleMessage(MessagePtr _newMsg)
               {
                 this->SetLatching(false);
-                this->callback(boost::dynamic_pointer_cast<M>(_newMsg));
+                boost::shared_ptr<M const> m =
+                  boost::dynamic_pointer_cast<M const>(_newMsg);
+
+                // A message of the same type but of another class, such as
+                // one built by a message factory, has to be converted.
+                if (!m && _newMsg)
+                  m = boost::dynamic_pointer_cast<M const>(
+                      this->Parse(_newMsg->SerializeAsString()));
+
+                this->callback(m);
                 return true;
               }
 
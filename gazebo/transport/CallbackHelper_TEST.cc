@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <google/protobuf/dynamic_message.h>
+#include <memory>
+#include <string>
+
+#include "gazebo/msgs/msgs.hh"
+#include "gazebo/transport/CallbackHelper.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class CallbackHelperTest : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+TEST_F(CallbackHelperTest, Typed)
+{
+  boost::shared_ptr<msgs::Int const> received;
+  transport::CallbackHelperT<msgs::Int> helper(
+      [&received](const boost::shared_ptr<msgs::Int const> &_msg)
+      {
+        received = _msg;
+      });
+  EXPECT_EQ(msgs::Int::descriptor(), helper.GetDescriptor());
+
+  // The published message is delivered without a copy
+  boost::shared_ptr<msgs::Int> msg(new msgs::Int);
+  msg->set_data(3);
+  EXPECT_TRUE(helper.HandleMessage(msg));
+  EXPECT_EQ(msg.get(), received.get());
+
+  // Serialized data is parsed
+  msg->set_data(4);
+  MessagePtr parsed = helper.Parse(msg->SerializeAsString());
+  ASSERT_TRUE(parsed != NULL);
+  EXPECT_TRUE(helper.HandleMessage(parsed));
+  ASSERT_TRUE(received != NULL);
+  EXPECT_EQ(4, received->data());
+
+  // A message of the same type but of another class is converted
+  google::protobuf::DynamicMessageFactory factory;
+  MessagePtr dynamic(
+      factory.GetPrototype(msgs::Int::descriptor())->New());
+  dynamic->ParseFromString(msg->SerializeAsString());
+  EXPECT_TRUE(helper.HandleMessage(dynamic));
+  ASSERT_TRUE(received != NULL);
+  EXPECT_NE(dynamic.get(), received.get());
+  EXPECT_EQ(4, received->data());
+}
+
+/////////////////////////////////////////////////
+TEST_F(CallbackHelperTest, Raw)
+{
+  std::string received;
+  transport::RawCallbackHelper helper(
+      [&received](const std::string &_data)
+      {
+        received = _data;
+      });
+  EXPECT_TRUE(helper.GetDescriptor() == NULL);
+  EXPECT_TRUE(helper.Parse("data") == NULL);
+
+  msgs::Int msg;
+  msg.set_data(5);
+  EXPECT_TRUE(helper.HandleData(msg.SerializeAsString(),
+        boost::function<void(uint32_t)>(), 0));
+  EXPECT_EQ(msg.SerializeAsString(), received);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
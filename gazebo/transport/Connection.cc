@@ -49,11 +49,16 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+
 #include <boost/bind/bind.hpp>
 #include <boost/function.hpp>
 #include <boost/lexical_cast.hpp>
 
 #include "gazebo/common/Console.hh"
+#include "gazebo/common/Tracer.hh"
 #include "gazebo/msgs/msgs.hh"
 
 #include "gazebo/transport/IOManager.hh"
@@ -68,6 +73,16 @@ extern void dummy_callback_fn(uint32_t);
 unsigned int Connection::idCounter = 0;
 IOManager *Connection::iomanager = NULL;
 
+/// \brief First byte of a binary header, which isn't a hexadecimal digit
+/// so that text headers are told apart.
+static const unsigned char kBinaryHeaderMarker = 0xb1;
+
+/// \brief Flag of a binary header followed by a timestamp.
+static const unsigned char kHeaderTimestampFlag = 0x01;
+
+/// \brief Default maximum number of bytes sent by a single write.
+static const size_t kDefaultWriteCoalesceLimit = 65536;
+
 // Version 1.52 of boost has an address::is_unspecfied function, but
 // Version 1.46.1 (installed on ubuntu) does not. So this helper function
 // is stolen from adress::is_unspecified function in boost v1.52.
@@ -94,6 +109,7 @@ Connection::Connection()
     iomanager = new IOManager();
 
   this->socket = new boost::asio::ip::tcp::socket(iomanager->GetIO());
+  this->strand = new boost::asio::io_service::strand(iomanager->GetIO());
 
   iomanager->IncCount();
   this->id = idCounter++;
@@ -104,6 +120,21 @@ Connection::Connection()
   this->writeQueue.clear();
   this->writeCount = 0;
 
+  this->writeCoalesceLimit = kDefaultWriteCoalesceLimit;
+  const char *coalesceEnv = getenv("GAZEBO_WRITE_COALESCE_LIMIT");
+  if (coalesceEnv)
+  {
+    try
+    {
+      this->writeCoalesceLimit = std::stoul(coalesceEnv);
+    }
+    catch(...)
+    {
+      gzwarn << "Invalid GAZEBO_WRITE_COALESCE_LIMIT[" << coalesceEnv
+        << "], using " << kDefaultWriteCoalesceLimit << "\n";
+    }
+  }
+
   this->localURI = std::string("http://") + this->GetLocalHostname() + ":" +
                    boost::lexical_cast<std::string>(this->GetLocalPort());
 
@@ -126,6 +157,9 @@ Connection::~Connection()
 {
   this->Shutdown();
 
+  delete this->strand;
+  this->strand = NULL;
+
   if (iomanager)
   {
     iomanager->DecCount();
@@ -186,8 +220,9 @@ bool Connection::Connect(const std::string &_host, unsigned int _port)
   // Use async connect so that we can use a custom timeout. This is useful
   // when trying to detect network errors.
   this->socket->async_connect(*endpointIter++,
-      common::weakBind(&Connection::OnConnect, this->shared_from_this(),
-        boost::asio::placeholders::error, endpointIter));
+      this->strand->wrap(common::weakBind(&Connection::OnConnect,
+        this->shared_from_this(), boost::asio::placeholders::error,
+        endpointIter)));
 
   // Wait for at most 60 seconds for a connection to be established.
   // The connectionCondition notification occurs in ::OnConnect.
@@ -233,8 +268,8 @@ void Connection::Listen(unsigned int port, const AcceptCallback &_acceptCB)
   this->acceptConn = ConnectionPtr(new Connection());
 
   this->acceptor->async_accept(*this->acceptConn->socket,
-      common::weakBind(&Connection::OnAccept, this->shared_from_this(),
-                  boost::asio::placeholders::error));
+      this->strand->wrap(common::weakBind(&Connection::OnAccept,
+        this->shared_from_this(), boost::asio::placeholders::error)));
 }
 
 //////////////////////////////////////////////////
@@ -262,8 +297,8 @@ void Connection::OnAccept(const boost::system::error_code &e)
     this->acceptConn = ConnectionPtr(new Connection());
 
     this->acceptor->async_accept(*this->acceptConn->socket,
-        common::weakBind(&Connection::OnAccept, this->shared_from_this(),
-          boost::asio::placeholders::error));
+        this->strand->wrap(common::weakBind(&Connection::OnAccept,
+          this->shared_from_this(), boost::asio::placeholders::error)));
   }
   else
   {
@@ -303,26 +338,67 @@ void Connection::EnqueueMsg(const std::string &_buffer,
     return;
   }
 
-  char headerBuffer[HEADER_LENGTH + 1];
-  snprintf(headerBuffer, HEADER_LENGTH + 1, "%08x",
-      static_cast<unsigned int>(_buffer.size()));
+  this->EnqueueMsg(std::make_shared<std::string>(_buffer), _cb, _id,
+      _force);
+}
 
+//////////////////////////////////////////////////
+void Connection::EnqueueMsg(const std::shared_ptr<const std::string> &_buffer,
+    boost::function<void(uint32_t)> _cb, uint32_t _id, bool _force)
+{
+  // Don't enqueue empty messages
+  if (!_buffer || _buffer->empty() || !this->IsOpen())
+  {
+    return;
+  }
+
+  std::vector<WriteFrame> dropped;
   {
     boost::recursive_mutex::scoped_lock lock(this->writeMutex);
 
-    if (this->writeQueue.empty() ||
-        (this->writeCount > 0 && this->writeQueue.size() == 1) ||
-        (this->writeQueue.back().size() + HEADER_LENGTH + _buffer.size() >
-         4096))
+    // The buffers of the write in progress point into the queue, which
+    // keeps them valid since a deque doesn't move elements on push_back
+    this->writeQueue.push_back(WriteFrame());
+    WriteFrame &frame = this->writeQueue.back();
+    frame.headerSize = HEADER_LENGTH;
+    if (this->binaryHeader)
     {
-      this->writeQueue.push_back(std::string(headerBuffer) + _buffer);
-      this->callbacks.push_back({std::make_pair(_cb, _id)});
+      // Binary headers are followed by the time the message was queued
+      EncodeHeader(_buffer->size() + TIMESTAMP_LENGTH, true,
+          frame.header.data());
+      frame.header[1] = static_cast<char>(kHeaderTimestampFlag);
+      const uint64_t stamp = static_cast<uint64_t>(GetTimestamp());
+      for (int i = 0; i < TIMESTAMP_LENGTH; ++i)
+      {
+        frame.header[HEADER_LENGTH + i] =
+          static_cast<char>((stamp >> (8 * i)) & 0xff);
+      }
+      frame.headerSize += TIMESTAMP_LENGTH;
     }
     else
+      EncodeHeader(_buffer->size(), false, frame.header.data());
+    frame.payload = _buffer;
+    frame.cb = _cb;
+    frame.id = _id;
+
+    // Drop the oldest frames that are not being written. The newer frames
+    // are shifted over them, since erasing from the middle of the deque
+    // would invalidate the frames of the write in progress.
+    while (this->writeQueueLimit > 0 &&
+        this->writeQueue.size() - this->writeFrames > this->writeQueueLimit)
     {
-      this->writeQueue.back() += std::string(headerBuffer) + _buffer;
-      this->callbacks.back().push_back(std::make_pair(_cb, _id));
+      auto oldest = this->writeQueue.begin() + this->writeFrames;
+      dropped.push_back(std::move(*oldest));
+      std::move(oldest + 1, this->writeQueue.end(), oldest);
+      this->writeQueue.pop_back();
     }
+    this->drops += dropped.size();
+  }
+
+  for (auto &drop : dropped)
+  {
+    if (!drop.cb.empty())
+      drop.cb(drop.id);
   }
 
   if (_force)
@@ -339,6 +415,7 @@ void Connection::EnqueueMsg(const std::string &_buffer,
 /////////////////////////////////////////////////
 void Connection::ProcessWriteQueue(bool _blocking)
 {
+  GZ_TRACE_SCOPE("transport::Connection::ProcessWriteQueue");
   boost::recursive_mutex::scoped_lock lock(this->writeMutex);
 
   if (!this->IsOpen())
@@ -355,24 +432,43 @@ void Connection::ProcessWriteQueue(bool _blocking)
 
   this->writeCount++;
 
-  // Write the serialized data to the socket. We use
-  // "gather-write" to send both the head and the data in
-  // a single write operation
+  // Gather the headers and the messages of the queued frames, up to the
+  // coalesce limit, and send them in a single write without copying them.
+  // Asio passes at most 64 buffers to a single system call.
+  static const size_t kMaxFrames = 32;
+  size_t bytes = 0;
+  this->writeBuffers.clear();
+  this->writeFrames = 0;
+  for (const auto &frame : this->writeQueue)
+  {
+    const size_t size = frame.headerSize + frame.payload->size();
+    if (this->writeFrames > 0 &&
+        (this->writeFrames == kMaxFrames ||
+         bytes + size > this->writeCoalesceLimit))
+    {
+      break;
+    }
+
+    this->writeBuffers.push_back(
+        boost::asio::buffer(frame.header.data(), frame.headerSize));
+    this->writeBuffers.push_back(boost::asio::buffer(frame.payload->data(),
+        frame.payload->size()));
+    bytes += size;
+    ++this->writeFrames;
+  }
+  this->writeStart = std::chrono::steady_clock::now();
+
   if (!_blocking)
   {
-    boost::asio::async_write(*this->socket,
-        boost::asio::buffer(this->writeQueue.front().c_str(),
-          this->writeQueue.front().size()),
-          common::weakBind(&Connection::OnWrite, this->shared_from_this(),
-            boost::asio::placeholders::error));
+    boost::asio::async_write(*this->socket, this->writeBuffers,
+          this->strand->wrap(common::weakBind(&Connection::OnWrite,
+            this->shared_from_this(), boost::asio::placeholders::error)));
   }
   else
   {
     try
     {
-      boost::asio::write(*this->socket,
-          boost::asio::buffer(this->writeQueue.front().c_str(),
-            this->writeQueue.front().size()));
+      boost::asio::write(*this->socket, this->writeBuffers);
     }
     catch(...)
     {
@@ -383,6 +479,153 @@ void Connection::ProcessWriteQueue(bool _blocking)
   }
 }
 
+//////////////////////////////////////////////////
+std::vector<double> Connection::GetIOThreadUtilization()
+{
+  if (iomanager)
+    return iomanager->ThreadUtilization();
+  return std::vector<double>();
+}
+
+//////////////////////////////////////////////////
+void Connection::SetBinaryHeader(const bool _binary)
+{
+  boost::recursive_mutex::scoped_lock lock(this->writeMutex);
+  this->binaryHeader = _binary;
+}
+
+//////////////////////////////////////////////////
+bool Connection::GetBinaryHeader() const
+{
+  return this->binaryHeader;
+}
+
+//////////////////////////////////////////////////
+void Connection::SetWriteCoalesceLimit(const size_t _limit)
+{
+  boost::recursive_mutex::scoped_lock lock(this->writeMutex);
+  this->writeCoalesceLimit = _limit;
+}
+
+//////////////////////////////////////////////////
+size_t Connection::GetWriteCoalesceLimit() const
+{
+  return this->writeCoalesceLimit;
+}
+
+//////////////////////////////////////////////////
+void Connection::SetWriteQueueLimit(const size_t _limit)
+{
+  boost::recursive_mutex::scoped_lock lock(this->writeMutex);
+  this->writeQueueLimit = _limit;
+}
+
+//////////////////////////////////////////////////
+size_t Connection::GetWriteQueueLimit() const
+{
+  return this->writeQueueLimit;
+}
+
+//////////////////////////////////////////////////
+void Connection::EncodeHeader(const size_t _size, const bool _binary,
+    char *_header)
+{
+  if (_binary)
+  {
+    const uint32_t size = static_cast<uint32_t>(_size);
+    _header[0] = static_cast<char>(kBinaryHeaderMarker);
+    _header[1] = 0;
+    _header[2] = 0;
+    _header[3] = 0;
+    for (int i = 0; i < 4; ++i)
+      _header[4 + i] = static_cast<char>((size >> (8 * i)) & 0xff);
+  }
+  else
+  {
+    char headerBuffer[HEADER_LENGTH + 1];
+    snprintf(headerBuffer, HEADER_LENGTH + 1, "%08x",
+        static_cast<unsigned int>(_size));
+    std::memcpy(_header, headerBuffer, HEADER_LENGTH);
+  }
+}
+
+//////////////////////////////////////////////////
+size_t Connection::DecodeHeader(const char *_header)
+{
+  if (static_cast<unsigned char>(_header[0]) == kBinaryHeaderMarker)
+  {
+    // The flags and reserved bytes are ignored, for future extensions
+    uint32_t size = 0;
+    for (int i = 0; i < 4; ++i)
+      size |= static_cast<uint32_t>(static_cast<unsigned char>(
+            _header[4 + i])) << (8 * i);
+    return size;
+  }
+
+  std::size_t dataSize = 0;
+  std::istringstream is(std::string(_header, HEADER_LENGTH));
+  if (!(is >> std::hex >> dataSize))
+    return 0;
+
+  return dataSize;
+}
+
+//////////////////////////////////////////////////
+bool Connection::HasHeaderTimestamp(const char *_header)
+{
+  return static_cast<unsigned char>(_header[0]) == kBinaryHeaderMarker &&
+    (static_cast<unsigned char>(_header[1]) & kHeaderTimestampFlag);
+}
+
+//////////////////////////////////////////////////
+int64_t Connection::GetTimestamp()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+//////////////////////////////////////////////////
+void Connection::OnReceived(std::string &_data, const bool _timestamped)
+{
+  ++this->messagesReceived;
+  this->bytesReceived += HEADER_LENGTH + _data.size();
+
+  if (!_timestamped || _data.size() < TIMESTAMP_LENGTH)
+    return;
+
+  uint64_t stamp = 0;
+  for (int i = 0; i < TIMESTAMP_LENGTH; ++i)
+  {
+    stamp |= static_cast<uint64_t>(static_cast<unsigned char>(_data[i]))
+      << (8 * i);
+  }
+  _data.erase(0, TIMESTAMP_LENGTH);
+
+  this->latency.Add((GetTimestamp() - static_cast<int64_t>(stamp)) * 1e-9);
+}
+
+//////////////////////////////////////////////////
+void Connection::FillStats(msgs::TransportStatistics::Connection &_msg)
+{
+  _msg.set_remote_uri(this->GetRemoteURI());
+  _msg.set_local_uri(this->GetLocalURI());
+  _msg.set_messages_sent(this->messagesSent);
+  _msg.set_bytes_sent(this->bytesSent);
+  _msg.set_messages_received(this->messagesReceived);
+  _msg.set_bytes_received(this->bytesReceived);
+  _msg.set_drops(this->drops);
+  _msg.set_write_time(this->writeTime * 1e-9);
+
+  boost::recursive_mutex::scoped_lock lock(this->writeMutex);
+  _msg.set_queue_depth(this->writeQueue.size());
+}
+
+//////////////////////////////////////////////////
+const common::Histogram &Connection::GetLatency() const
+{
+  return this->latency;
+}
+
 //////////////////////////////////////////////////
 std::string Connection::GetLocalURI() const
 {
@@ -398,17 +641,22 @@ std::string Connection::GetRemoteURI() const
 //////////////////////////////////////////////////
 void Connection::PostWrite()
 {
-  // Call the callbacks, if not NULL
-  if (!this->callbacks.empty())
-  {
-    for (auto const &callback : this->callbacks.front())
-      if (!callback.first.empty())
-        callback.first(callback.second);
-    this->callbacks.pop_front();
-  }
+  this->writeTime += std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - this->writeStart).count();
 
-  if (!this->writeQueue.empty())
+  // Call the callbacks of the written frames, if not NULL
+  for (; this->writeFrames > 0 && !this->writeQueue.empty();
+      --this->writeFrames)
+  {
+    const WriteFrame &frame = this->writeQueue.front();
+    ++this->messagesSent;
+    this->bytesSent += frame.headerSize + frame.payload->size();
+    if (!frame.cb.empty())
+      frame.cb(frame.id);
     this->writeQueue.pop_front();
+  }
+  this->writeFrames = 0;
+  this->writeBuffers.clear();
   this->writeCount--;
 }
 
@@ -490,7 +738,7 @@ void Connection::Close()
 
   boost::recursive_mutex::scoped_lock lock2(this->writeMutex);
   this->writeQueue.clear();
-  this->callbacks.clear();
+  this->writeFrames = 0;
 }
 
 //////////////////////////////////////////////////
@@ -572,6 +820,7 @@ bool Connection::Read(std::string &data)
       throw boost::system::system_error(error);
 
     data = std::string(&incoming[0], incoming.size());
+    this->OnReceived(data, HasHeaderTimestamp(header));
     result = true;
   }
 
@@ -630,16 +879,10 @@ unsigned int Connection::GetRemotePort() const
 //////////////////////////////////////////////////
 std::size_t Connection::ParseHeader(const std::string &header)
 {
-  std::size_t data_size = 0;
-  std::istringstream is(header);
-
-  if (!(is >> std::hex >> data_size))
-  {
-    // Header doesn't seem to be valid. Inform the caller
-    boost::system::error_code error(boost::asio::error::invalid_argument);
-  }
+  if (header.size() < HEADER_LENGTH)
+    return 0;
 
-  return data_size;
+  return DecodeHeader(header.data());
 }
 
 //////////////////////////////////////////////////
@@ -34,16 +34,23 @@
 #include <vector>
 #include <iostream>
 #include <iomanip>
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <deque>
+#include <memory>
 #include <utility>
 
 #include "gazebo/common/Event.hh"
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Exception.hh"
+#include "gazebo/common/Histogram.hh"
 #include "gazebo/common/WeakBind.hh"
+#include "gazebo/msgs/msgs.hh"
 #include "gazebo/util/system.hh"
 
 #define HEADER_LENGTH 8
+#define TIMESTAMP_LENGTH 8
 
 namespace gazebo
 {
@@ -99,6 +106,20 @@ namespace gazebo
     /// IP lookup.
     ///   - GAZEBO_HOSTNAME: Hostame to export. Setting this will override
     /// both GAZEBO_IP and the default IP lookup.
+    ///   - GAZEBO_IO_THREADS: Number of threads running the IO of all the
+    /// connections of the process, 1 by default.
+    ///   - GAZEBO_WRITE_COALESCE_LIMIT: Maximum number of bytes of queued
+    /// messages sent by a single write, 65536 by default.
+    ///
+    /// Each message is preceded by a header of HEADER_LENGTH bytes, either
+    /// the size of the message in hexadecimal text or, once the peer
+    /// accepted it, a binary header starting with a marker byte that isn't
+    /// a hexadecimal digit, followed by a flags byte, two reserved bytes
+    /// and the size as a little endian uint32. Both are always read.
+    /// Binary headers are followed by the wall time at which the message
+    /// was queued, TIMESTAMP_LENGTH bytes of little endian int64
+    /// nanoseconds counted in the size, which the reader strips to measure
+    /// the latency of the messages.
     ///
     /// \class Connection Connection.hh transport/transport.hh
     /// \brief Single TCP/IP connection manager
@@ -172,6 +193,80 @@ namespace gazebo
       /// to the socket, otherwise just enqueue the data for asynchronous write
       public: void EnqueueMsg(const std::string &_buffer, bool _force = false);
 
+      /// \brief Write data shared with other connections to the socket,
+      /// without copying it.
+      /// \param[in] _buffer Data to write, which must not change until
+      /// it's written.
+      /// \param[in] _cb If non-null, callback to be invoked after
+      /// transmission is complete.
+      /// \param[in] _id ID associated with the message data.
+      /// \param[in] _force If true, block until the data has been written
+      /// to the socket, otherwise just enqueue the data for asynchronous write
+      public: void EnqueueMsg(
+                  const std::shared_ptr<const std::string> &_buffer,
+                  boost::function<void(uint32_t)> _cb, uint32_t _id,
+                  bool _force = false);
+
+      /// \brief Write binary headers instead of text headers. Only enable
+      /// once the peer announced that it reads them.
+      /// \param[in] _binary True to write binary headers.
+      public: void SetBinaryHeader(const bool _binary);
+
+      /// \brief Check whether binary headers are written.
+      /// \return True if binary headers are written.
+      public: bool GetBinaryHeader() const;
+
+      /// \brief Set the maximum number of bytes of queued messages sent by
+      /// a single write. A larger message is still written at once.
+      /// \param[in] _limit Number of bytes.
+      public: void SetWriteCoalesceLimit(const size_t _limit);
+
+      /// \brief Get the maximum number of bytes sent by a single write.
+      /// \return Number of bytes.
+      public: size_t GetWriteCoalesceLimit() const;
+
+      /// \brief Set the maximum number of queued messages waiting to be
+      /// written. The oldest ones are dropped, and their callbacks invoked,
+      /// when a new message exceeds the limit.
+      /// \param[in] _limit Number of messages, 0 for no limit.
+      public: void SetWriteQueueLimit(const size_t _limit);
+
+      /// \brief Get the maximum number of queued messages waiting to be
+      /// written.
+      /// \return Number of messages, 0 if there is no limit.
+      public: size_t GetWriteQueueLimit() const;
+
+      /// \brief Write the header of a message.
+      /// \param[in] _size Size of the message.
+      /// \param[in] _binary True for a binary header, false for text.
+      /// \param[out] _header Buffer of HEADER_LENGTH bytes.
+      public: static void EncodeHeader(const size_t _size, const bool _binary,
+                  char *_header);
+
+      /// \brief Read the header of a message, binary or text.
+      /// \param[in] _header Buffer of HEADER_LENGTH bytes.
+      /// \return Size of the message, 0 if the header is invalid.
+      public: static size_t DecodeHeader(const char *_header);
+
+      /// \brief Check whether the header of a message is followed by a
+      /// timestamp.
+      /// \param[in] _header Buffer of HEADER_LENGTH bytes.
+      /// \return True for a binary header with the timestamp flag.
+      public: static bool HasHeaderTimestamp(const char *_header);
+
+      /// \brief Get the current wall time, as embedded in the messages.
+      /// \return Nanoseconds since the epoch.
+      public: static int64_t GetTimestamp();
+
+      /// \brief Get the counters of this connection.
+      /// \param[out] _msg Message receiving the counters.
+      public: void FillStats(msgs::TransportStatistics::Connection &_msg);
+
+      /// \brief Get the latency of the timestamped messages read, from
+      /// their queuing by the remote end to their reception.
+      /// \return Histogram of latencies in seconds.
+      public: const common::Histogram &GetLatency() const;
+
       /// \brief Get the local URI
       /// \return The local URI
       public: std::string GetLocalURI() const;
@@ -222,9 +317,10 @@ namespace gazebo
                 this->inboundHeader.resize(HEADER_LENGTH);
                 boost::asio::async_read(*this->socket,
                     boost::asio::buffer(this->inboundHeader),
-                    common::weakBind(f, this->shared_from_this(),
-                                boost::asio::placeholders::error,
-                                boost::make_tuple(_handler)));
+                    this->strand->wrap(common::weakBind(f,
+                        this->shared_from_this(),
+                        boost::asio::placeholders::error,
+                        boost::make_tuple(_handler))));
               }
 
       /// \brief Handle a completed read of a message header.
@@ -251,6 +347,8 @@ namespace gazebo
                   this->inboundHeader.clear();
 
                   inboundData_size = this->ParseHeader(header);
+                  this->inboundTimestamped =
+                    HasHeaderTimestamp(header.data());
 
                  if (inboundData_size > 0)
                   {
@@ -263,9 +361,9 @@ namespace gazebo
 
                     boost::asio::async_read(*this->socket,
                         boost::asio::buffer(this->inboundData),
-                        common::weakBind(f, this->shared_from_this(),
-                                    boost::asio::placeholders::error,
-                                    _handler));
+                        this->strand->wrap(common::weakBind(f,
+                            this->shared_from_this(),
+                            boost::asio::placeholders::error, _handler)));
                   }
                   else
                   {
@@ -311,6 +409,8 @@ namespace gazebo
 
                 if (data.empty())
                   gzerr << "OnReadData got empty data!!!\n";
+                else
+                  this->OnReceived(data, this->inboundTimestamped);
 
                 if (!_e && !transport::is_stopped())
                 {
@@ -333,6 +433,11 @@ namespace gazebo
       /// \brief Handle on-write callbacks
       public: void ProcessWriteQueue(bool _blocking = false);
 
+      /// \brief Get the utilization of each thread of the IO manager since
+      /// the previous call, see IOManager::ThreadUtilization.
+      /// \return Fraction of the wall time each IO thread was busy.
+      public: static std::vector<double> GetIOThreadUtilization();
+
       /// \brief Get the ID of the connection.
       /// \return The connection's unique ID.
       public: unsigned int GetId() const;
@@ -364,6 +469,13 @@ namespace gazebo
       /// \param[in] _header Header as a string
       private: std::size_t ParseHeader(const std::string &_header);
 
+      /// \brief Count a message read, and strip its timestamp if the header
+      /// announced one.
+      /// \param[in,out] _data The message.
+      /// \param[in] _timestamped True if the message starts with a
+      /// timestamp.
+      private: void OnReceived(std::string &_data, const bool _timestamped);
+
       /// \brief the read thread
       private: void ReadLoop(const ReadCallback &_cb);
 
@@ -389,17 +501,54 @@ namespace gazebo
       /// \brief Socket pointer
       private: boost::asio::ip::tcp::socket *socket;
 
+      /// \brief Serializes the handlers of the connection, which may run
+      /// on any thread of the IO manager.
+      private: boost::asio::io_service::strand *strand;
+
       /// \brief Accepts new connections.
       private: boost::asio::ip::tcp::acceptor *acceptor;
 
-      /// \brief Outgoing data queue
-      private: std::deque<std::string> writeQueue;
+      /// \brief A message waiting to be written.
+      private: struct WriteFrame
+               {
+                 /// \brief Header of the message, and its timestamp if
+                 /// the header is binary.
+                 std::array<char, HEADER_LENGTH + TIMESTAMP_LENGTH> header;
+
+                 /// \brief Number of bytes used in the header array.
+                 size_t headerSize;
+
+                 /// \brief The message, possibly shared with other
+                 /// connections.
+                 std::shared_ptr<const std::string> payload;
 
-      /// \brief List of callbacks, paired with writeQueue. The callbacks
-      /// are used to notify a publisher when a message is successfully sent.
-      private: std::deque< std::vector<
-               std::pair<boost::function<void(uint32_t)>, uint32_t> > >
-                 callbacks;
+                 /// \brief Callback used to notify a publisher when the
+                 /// message is successfully sent.
+                 boost::function<void(uint32_t)> cb;
+
+                 /// \brief ID associated with the message.
+                 uint32_t id;
+               };
+
+      /// \brief Outgoing data queue. The frames of the write in progress
+      /// are at the front, and their buffers point into it.
+      private: std::deque<WriteFrame> writeQueue;
+
+      /// \brief Number of frames of the write in progress.
+      private: size_t writeFrames = 0;
+
+      /// \brief Buffers of the write in progress.
+      private: std::vector<boost::asio::const_buffer> writeBuffers;
+
+      /// \brief Maximum number of bytes sent by a single write.
+      private: size_t writeCoalesceLimit;
+
+      /// \brief Maximum number of messages waiting to be written, 0 for no
+      /// limit.
+      private: size_t writeQueueLimit = 0;
+
+      /// \brief True to write binary headers.
+      private: bool binaryHeader = false;
 
       /// \brief Mutex to protect new connections.
       private: boost::mutex connectMutex;
@@ -425,6 +574,33 @@ namespace gazebo
       /// \brief Content data from a new message.
       private: std::vector<char> inboundData;
 
+      /// \brief True if the message being read starts with a timestamp.
+      private: bool inboundTimestamped = false;
+
+      /// \brief Number of messages written.
+      private: std::atomic<uint64_t> messagesSent{0};
+
+      /// \brief Number of bytes written, headers included.
+      private: std::atomic<uint64_t> bytesSent{0};
+
+      /// \brief Number of messages read.
+      private: std::atomic<uint64_t> messagesReceived{0};
+
+      /// \brief Number of bytes read, headers included.
+      private: std::atomic<uint64_t> bytesReceived{0};
+
+      /// \brief Number of messages dropped by the write queue limit.
+      private: std::atomic<uint64_t> drops{0};
+
+      /// \brief Time spent in writes, in nanoseconds.
+      private: std::atomic<uint64_t> writeTime{0};
+
+      /// \brief Start of the write in progress.
+      private: std::chrono::steady_clock::time_point writeStart;
+
+      /// \brief Latency of the timestamped messages read, in seconds.
+      private: common::Histogram latency;
+
       /// \brief Set to true to stop reading on the connection.
       private: bool readQuit;
 
@@ -18,6 +18,7 @@
 
 #include "gazebo/msgs/msgs.hh"
 #include "gazebo/common/Console.hh"
+#include "gazebo/common/ThreadConfig.hh"
 #include "gazebo/common/Events.hh"
 #include "gazebo/transport/TopicManager.hh"
 #include "gazebo/transport/ConnectionManager.hh"
@@ -301,6 +302,7 @@ void ConnectionManager::RunUpdate()
 //////////////////////////////////////////////////
 void ConnectionManager::Run()
 {
+  common::ThreadConfig::Instance()->Apply("connections");
   boost::mutex::scoped_lock lock(this->updateMutex);
 
   this->stopped = false;
@@ -308,8 +310,12 @@ void ConnectionManager::Run()
   while (!this->stop && this->masterConn && this->masterConn->IsOpen())
   {
     this->RunUpdate();
+
+    // Poll quickly while a shared memory ring is full, its reader doesn't
+    // signal when it makes room.
+    const bool shmWaiting = this->FlushShm();
     this->updateCondition.timed_wait(lock,
-       boost::posix_time::milliseconds(100));
+       boost::posix_time::milliseconds(shmWaiting ? 1 : 100));
   }
   this->RunUpdate();
 
@@ -318,6 +324,31 @@ void ConnectionManager::Run()
   this->masterConn->Shutdown();
 }
 
+//////////////////////////////////////////////////
+bool ConnectionManager::FlushShm()
+{
+  std::list<SubscriptionTransportPtr> links;
+  {
+    boost::mutex::scoped_lock lock(this->shmMutex);
+    for (auto iter = this->shmLinks.begin(); iter != this->shmLinks.end();)
+    {
+      SubscriptionTransportPtr link = iter->lock();
+      if (link)
+      {
+        links.push_back(link);
+        ++iter;
+      }
+      else
+        iter = this->shmLinks.erase(iter);
+    }
+  }
+
+  bool waiting = false;
+  for (auto &link : links)
+    waiting = link->FlushShm() || waiting;
+  return waiting;
+}
+
 //////////////////////////////////////////////////
 bool ConnectionManager::IsRunning() const
 {
@@ -356,6 +387,14 @@ void ConnectionManager::ProcessMessage(const std::string &_data)
     result.ParseFromString(packet.serialized_data());
     this->publishers.push_back(result);
   }
+  // The master batches the publishers advertised in one pass
+  else if (packet.type() == "publishers_add")
+  {
+    msgs::Publishers result;
+    result.ParseFromString(packet.serialized_data());
+    for (int i = 0; i < result.publisher_size(); ++i)
+      this->publishers.push_back(result.publisher(i));
+  }
   else if (packet.type() == "publisher_del")
   {
     msgs::Publish result;
@@ -483,9 +522,38 @@ void ConnectionManager::OnRead(ConnectionPtr _connection,
 
     // Create a transport link for the publisher to the remote subscriber
     // via the connection
+    // The subscriber announces whether it reads binary headers
+    if (sub.binary_header())
+      _connection->SetBinaryHeader(true);
+
     SubscriptionTransportPtr subLink(new SubscriptionTransport());
     subLink->Init(_connection, sub.latching());
 
+    // Apply the delivery policy of the subscriber before sending
+    SubscriptionQos qos;
+    qos.SetDepth(sub.qos_depth());
+    qos.SetRate(sub.qos_rate());
+    subLink->SetQos(qos);
+    _connection->SetWriteQueueLimit(qos.Depth());
+
+    // Use the shared memory ring of a subscriber on this host, if it can
+    // be opened. Otherwise the messages go through the connection.
+    if (sub.has_shm_name() && subLink->InitShm(sub.shm_name()))
+    {
+      boost::mutex::scoped_lock lock(this->shmMutex);
+      this->shmLinks.push_back(subLink);
+    }
+
+    // A subscriber receiving the multicast group of the topic only gets
+    // the messages the group can't carry through the connection
+    if (sub.multicast())
+    {
+      PublicationPtr publication =
+        TopicManager::Instance()->FindPublication(sub.topic());
+      if (publication)
+        subLink->SetMulticast(publication->Multicast());
+    }
+
     // Connect the publisher to this transport mechanism
     TopicManager::Instance()->ConnectPubToSub(sub.topic(), subLink);
   }
@@ -506,9 +574,36 @@ void ConnectionManager::Advertise(const std::string &topic,
   msg.set_host(this->serverConn->GetLocalAddress());
   msg.set_port(this->serverConn->GetLocalPort());
 
+  // Let the subscribers know the multicast group of the topic
+  PublicationPtr publication = TopicManager::Instance()->FindPublication(topic);
+  std::shared_ptr<MulticastSender> multicast =
+    publication ? publication->Multicast() : nullptr;
+  if (multicast)
+  {
+    msg.set_multicast_group(multicast->Group());
+    msg.set_multicast_port(multicast->Port());
+    msg.set_multicast_id(multicast->Id());
+  }
+
   this->masterConn->EnqueueMsg(msgs::Package("advertise", msg));
 }
 
+//////////////////////////////////////////////////
+void ConnectionManager::FillStats(msgs::TransportStatistics &_msg)
+{
+  std::list<ConnectionPtr> conns;
+  {
+    boost::recursive_mutex::scoped_lock lock(this->connectionMutex);
+    conns = this->connections;
+  }
+
+  for (auto &conn : conns)
+  {
+    if (conn)
+      conn->FillStats(*_msg.add_connection());
+  }
+}
+
 //////////////////////////////////////////////////
 void ConnectionManager::RegisterTopicNamespace(const std::string &_name)
 {
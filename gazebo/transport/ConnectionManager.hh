@@ -19,6 +19,7 @@
 
 
 #include <boost/shared_ptr.hpp>
+#include <boost/weak_ptr.hpp>
 #include <boost/interprocess/sync/interprocess_semaphore.hpp>
 #include <string>
 #include <list>
@@ -113,6 +114,11 @@ namespace gazebo
       /// \param[out] _publishers The updated list of publishers is written here
       public: void GetAllPublishers(std::list<msgs::Publish> &_publishers);
 
+      /// \brief Get the counters of the connections.
+      /// \param[in,out] _msg Message receiving a Connection entry for each
+      /// connection.
+      public: void FillStats(msgs::TransportStatistics &_msg);
+
       /// \brief Remove a connection from the manager
       /// \param[in] _conn The connection to be removed
       public: void RemoveConnection(ConnectionPtr &_conn);
@@ -164,6 +170,11 @@ namespace gazebo
       /// \brief Run the manager update loop once
       private: void RunUpdate();
 
+      /// \brief Write the messages of the subscription transports that
+      /// wait for room in their shared memory ring.
+      /// \return True if messages are still waiting.
+      private: bool FlushShm();
+
       /// \brief Condition used to trigger an update.
       private: boost::condition_variable updateCondition;
 
@@ -194,6 +205,12 @@ namespace gazebo
       /// \brief Condition used for synchronization
       private: boost::condition_variable namespaceCondition;
 
+      /// \brief Subscription transports using a shared memory ring.
+      private: std::list<boost::weak_ptr<SubscriptionTransport>> shmLinks;
+
+      /// \brief Mutex to protect shmLinks.
+      private: boost::mutex shmMutex;
+
       // Singleton implementation
       private: friend class SingletonT<ConnectionManager>;
     };
@@ -16,6 +16,7 @@
 */
 
 #include <gtest/gtest.h>
+#include <cstring>
 #include <string>
 #include <stdlib.h>
 
@@ -64,6 +65,70 @@ TEST_F(Connection, IPWhiteList)
     setenv("GAZEBO_IP_WHITE_LIST", ipEnv, 1);
 }
 
+/////////////////////////////////////////////////
+TEST_F(Connection, Header)
+{
+  char header[HEADER_LENGTH];
+
+  // Text headers are hexadecimal
+  transport::Connection::EncodeHeader(0x1a2b, false, header);
+  EXPECT_EQ("00001a2b", std::string(header, HEADER_LENGTH));
+  EXPECT_EQ(0x1a2bu, transport::Connection::DecodeHeader(header));
+
+  // Binary headers start with a byte that isn't a hexadecimal digit
+  transport::Connection::EncodeHeader(0x89abcdef, true, header);
+  EXPECT_EQ(std::string::npos,
+      std::string("0123456789abcdefABCDEF").find(header[0]));
+  EXPECT_EQ(0x89abcdefu, transport::Connection::DecodeHeader(header));
+  transport::Connection::EncodeHeader(7, true, header);
+  EXPECT_EQ(7u, transport::Connection::DecodeHeader(header));
+
+  // A flag announces a timestamp after a binary header
+  EXPECT_FALSE(transport::Connection::HasHeaderTimestamp(header));
+  header[1] = 0x01;
+  EXPECT_TRUE(transport::Connection::HasHeaderTimestamp(header));
+  EXPECT_EQ(7u, transport::Connection::DecodeHeader(header));
+  EXPECT_GT(transport::Connection::GetTimestamp(), 0);
+
+  // Invalid text headers are empty
+  std::memcpy(header, "zzzzzzzz", HEADER_LENGTH);
+  EXPECT_EQ(0u, transport::Connection::DecodeHeader(header));
+}
+
+/////////////////////////////////////////////////
+TEST_F(Connection, WriteCoalesceLimit)
+{
+  transport::Connection *connection = new transport::Connection();
+  EXPECT_EQ(65536u, connection->GetWriteCoalesceLimit());
+  EXPECT_FALSE(connection->GetBinaryHeader());
+  connection->SetWriteCoalesceLimit(1024);
+  EXPECT_EQ(1024u, connection->GetWriteCoalesceLimit());
+  connection->SetBinaryHeader(true);
+  EXPECT_TRUE(connection->GetBinaryHeader());
+  EXPECT_EQ(0u, connection->GetWriteQueueLimit());
+  connection->SetWriteQueueLimit(2);
+  EXPECT_EQ(2u, connection->GetWriteQueueLimit());
+
+  // Counters start at zero
+  msgs::TransportStatistics::Connection stats;
+  connection->FillStats(stats);
+  EXPECT_EQ(0u, stats.messages_sent());
+  EXPECT_EQ(0u, stats.bytes_received());
+  EXPECT_EQ(0u, stats.queue_depth());
+  EXPECT_EQ(0u, connection->GetLatency().Count());
+  delete connection;
+
+  // The default comes from the environment
+  setenv("GAZEBO_WRITE_COALESCE_LIMIT", "100", 1);
+  connection = new transport::Connection();
+  EXPECT_EQ(100u, connection->GetWriteCoalesceLimit());
+  delete connection;
+#ifndef _WIN32
+  unsetenv("GAZEBO_WRITE_COALESCE_LIMIT");
+#endif
+}
+
+/////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
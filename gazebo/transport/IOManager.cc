@@ -14,10 +14,22 @@
  * limitations under the License.
  *
 */
+#ifdef __linux__
+  #include <pthread.h>
+  #include <time.h>
+#endif
+
+#include <algorithm>
 #include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <mutex>
+#include <string>
 #include <boost/bind/bind.hpp>
 #include <boost/thread/thread.hpp>
 #include <iostream>
+#include "gazebo/common/Console.hh"
+#include "gazebo/common/ThreadConfig.hh"
 #include "gazebo/transport/IOManager.hh"
 
 namespace gazebo
@@ -27,6 +39,10 @@ namespace transport
 /////////////////////////////////////////////////
 class IOManagerPrivate
 {
+  /// \brief Run the IO service, on an IO thread.
+  /// \param[in] _index Index of the thread.
+  public: void Run(const size_t _index);
+
   /// \brief IO service.
   public: boost::asio::io_service *io_service = nullptr;
 
@@ -36,20 +52,112 @@ class IOManagerPrivate
   /// \brief Reference count of connections using this IOManager.
   public: std::atomic_int count;
 
-  /// \brief Thread for IOManager.
-  public: boost::thread *thread = nullptr;
+  /// \brief Threads for IOManager.
+  public: std::vector<boost::thread *> threads;
+
+  /// \brief Utilization of an IO thread.
+  public: struct ThreadClock
+          {
+#ifdef __linux__
+            /// \brief CPU clock of the thread.
+            clockid_t clock;
+#endif
+
+            /// \brief True once the clock is known.
+            bool valid = false;
+
+            /// \brief CPU time of the thread at the previous measurement.
+            double cpuTime = 0;
+
+            /// \brief Wall time at the previous measurement.
+            std::chrono::steady_clock::time_point wallTime;
+          };
+
+  /// \brief Clocks of the IO threads.
+  public: std::vector<ThreadClock> clocks;
+
+  /// \brief Protects the clocks.
+  public: std::mutex clockMutex;
 };
 
+#ifdef __linux__
+/////////////////////////////////////////////////
+/// \brief Read a CPU clock.
+/// \param[in] _clock The clock.
+/// \return Time in seconds, 0 on error.
+static double ClockTime(const clockid_t _clock)
+{
+  struct timespec ts;
+  if (clock_gettime(_clock, &ts) != 0)
+    return 0;
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+#endif
+
+/////////////////////////////////////////////////
+void IOManagerPrivate::Run(const size_t _index)
+{
+  common::ThreadConfig::Instance()->Apply("io_" + std::to_string(_index));
+#ifdef __linux__
+  {
+    std::lock_guard<std::mutex> lock(this->clockMutex);
+    ThreadClock &clock = this->clocks[_index];
+    if (pthread_getcpuclockid(pthread_self(), &clock.clock) == 0)
+    {
+      clock.valid = true;
+      clock.cpuTime = ClockTime(clock.clock);
+      clock.wallTime = std::chrono::steady_clock::now();
+    }
+  }
+#else
+  (void)_index;
+#endif
+
+  this->io_service->run();
+}
+
+/////////////////////////////////////////////////
+/// \brief Number of IO threads given by GAZEBO_IO_THREADS.
+/// \return Number of threads, 1 if unset or invalid.
+static unsigned int EnvThreadCount()
+{
+  const char *env = std::getenv("GAZEBO_IO_THREADS");
+  if (!env)
+    return 1;
+
+  try
+  {
+    return std::max(1, std::stoi(env));
+  }
+  catch(...)
+  {
+    gzwarn << "Invalid GAZEBO_IO_THREADS[" << env << "], using 1\n";
+  }
+  return 1;
+}
+
 /////////////////////////////////////////////////
 IOManager::IOManager()
+  : IOManager(EnvThreadCount())
+{
+}
+
+/////////////////////////////////////////////////
+IOManager::IOManager(const unsigned int _threadCount)
   : dataPtr(new IOManagerPrivate)
 {
   this->dataPtr->io_service = new boost::asio::io_service;
   this->dataPtr->work = new boost::asio::io_service::work(
       *this->dataPtr->io_service);
   this->dataPtr->count = 0;
-  this->dataPtr->thread = new boost::thread(boost::bind(
-      &boost::asio::io_service::run, this->dataPtr->io_service));
+
+  const unsigned int threadCount = std::max(1u, _threadCount);
+  this->dataPtr->clocks.resize(threadCount);
+  for (unsigned int i = 0; i < threadCount; ++i)
+  {
+    this->dataPtr->threads.push_back(new boost::thread(boost::bind(
+        &IOManagerPrivate::Run, this->dataPtr, i)));
+  }
 }
 
 /////////////////////////////////////////////////
@@ -72,12 +180,45 @@ void IOManager::Stop()
 {
   this->dataPtr->io_service->reset();
   this->dataPtr->io_service->stop();
-  if (this->dataPtr->thread)
+  for (auto &thread : this->dataPtr->threads)
   {
-    this->dataPtr->thread->join();
-    delete this->dataPtr->thread;
-    this->dataPtr->thread = nullptr;
+    thread->join();
+    delete thread;
+  }
+  this->dataPtr->threads.clear();
+}
+
+/////////////////////////////////////////////////
+unsigned int IOManager::ThreadCount() const
+{
+  return this->dataPtr->clocks.size();
+}
+
+/////////////////////////////////////////////////
+std::vector<double> IOManager::ThreadUtilization()
+{
+  std::vector<double> result;
+#ifdef __linux__
+  std::lock_guard<std::mutex> lock(this->dataPtr->clockMutex);
+  const auto now = std::chrono::steady_clock::now();
+  for (auto &clock : this->dataPtr->clocks)
+  {
+    if (!clock.valid)
+    {
+      result.push_back(0);
+      continue;
+    }
+
+    const double cpuTime = ClockTime(clock.clock);
+    const double wall =
+        std::chrono::duration<double>(now - clock.wallTime).count();
+    result.push_back(wall > 0 ?
+        std::min(1.0, std::max(0.0, (cpuTime - clock.cpuTime) / wall)) : 0);
+    clock.cpuTime = cpuTime;
+    clock.wallTime = now;
   }
+#endif
+  return result;
 }
 
 /////////////////////////////////////////////////
@@ -17,6 +17,7 @@
 #ifndef GAZEBO_TRANSPORT_IOMANAGER_HH_
 #define GAZEBO_TRANSPORT_IOMANAGER_HH_
 
+#include <vector>
 #include <boost/asio.hpp>
 #include "gazebo/util/system.hh"
 
@@ -32,11 +33,21 @@ namespace gazebo
 
     /// \class IOManager IOManager.hh transport/transport.hh
     /// \brief Manages boost::asio IO
+    ///
+    /// The IO service runs on a pool of threads, one by default. Set the
+    /// GAZEBO_IO_THREADS environment variable to use more, e.g. when a
+    /// process serves many remote subscribers. Handlers of a connection
+    /// are serialized by its strand, see Connection.
     class GZ_TRANSPORT_VISIBLE IOManager
     {
       /// \brief Constructor
       public: IOManager();
 
+      /// \brief Constructor
+      /// \param[in] _threadCount Number of threads running the IO
+      /// service, at least one.
+      public: explicit IOManager(const unsigned int _threadCount);
+
       /// \brief Destructor
       public: ~IOManager();
 
@@ -57,6 +68,16 @@ namespace gazebo
       /// \brief Stop the IO service
       public: void Stop();
 
+      /// \brief Get the number of threads running the IO service.
+      /// \return Number of threads.
+      public: unsigned int ThreadCount() const;
+
+      /// \brief Get the utilization of each IO thread since the previous
+      /// call, or since the threads started.
+      /// \return Fraction of the wall time each thread spent on the CPU,
+      /// in [0, 1]. Empty where thread CPU clocks are unavailable.
+      public: std::vector<double> ThreadUtilization();
+
       /// \internal
       /// \brief Pointer to private data.
       private: IOManagerPrivate *dataPtr;
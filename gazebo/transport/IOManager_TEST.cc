@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "gazebo/transport/IOManager.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class IOManagerTest : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+TEST_F(IOManagerTest, ThreadPool)
+{
+  transport::IOManager single(0);
+  EXPECT_EQ(1u, single.ThreadCount());
+  single.Stop();
+
+  transport::IOManager manager(3);
+  EXPECT_EQ(3u, manager.ThreadCount());
+
+  // Handlers only complete if they run on all the threads at once
+  std::atomic<int> started(0);
+  std::atomic<int> done(0);
+  for (int i = 0; i < 3; ++i)
+  {
+    manager.GetIO().post([&started, &done]()
+      {
+        ++started;
+        const auto deadline =
+            std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (started < 3 && std::chrono::steady_clock::now() < deadline)
+          continue;
+        if (started == 3)
+          ++done;
+      });
+  }
+
+  for (int i = 0; i < 500 && done < 3; ++i)
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  EXPECT_EQ(3, done);
+
+  const std::vector<double> utilization = manager.ThreadUtilization();
+#ifdef __linux__
+  ASSERT_EQ(3u, utilization.size());
+  for (const double value : utilization)
+  {
+    EXPECT_GE(value, 0.0);
+    EXPECT_LE(value, 1.0);
+  }
+#endif
+  manager.Stop();
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,524 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <boost/asio.hpp>
+#include <boost/thread/mutex.hpp>
+#include <atomic>
+#include <cstdlib>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/transport/Connection.hh"
+#include "gazebo/transport/Multicast.hh"
+
+using namespace gazebo;
+using namespace transport;
+
+/// \brief Marks the datagrams of a MulticastSender.
+static const uint32_t kMagic = 0x434d5a47;
+
+/// \brief Size of the header of a datagram: the magic number, the sender
+/// id, the sequence number and the timestamp, little endian.
+static const size_t kHeaderSize = 4 + 8 + 8 + 8;
+
+/// \brief Largest UDP payload.
+static const size_t kMaxDatagram = 65507;
+
+/// \brief Default multicast group.
+static const char *kDefaultGroup = "239.255.11.35";
+
+/// \brief Default first port of the multicast topics.
+static const unsigned int kDefaultPort = 11350;
+
+/// \brief Number of ports the topics are spread over.
+static const unsigned int kPortRange = 512;
+
+namespace gazebo
+{
+  namespace transport
+  {
+    /// \internal
+    /// \brief Private data of MulticastSender.
+    class MulticastSenderPrivate
+    {
+      /// \brief Service of the socket, only used for synchronous sends.
+      public: boost::asio::io_service io;
+
+      /// \brief The socket.
+      public: std::unique_ptr<boost::asio::ip::udp::socket> socket;
+
+      /// \brief Group and port the datagrams are sent to.
+      public: boost::asio::ip::udp::endpoint endpoint;
+
+      /// \brief Id of the sender.
+      public: uint64_t id = 0;
+
+      /// \brief Sequence number of the last message sent.
+      public: std::atomic<uint64_t> sequence{0};
+
+      /// \brief The message last sent.
+      public: std::shared_ptr<const std::string> lastData;
+
+      /// \brief Datagram buffer.
+      public: std::vector<char> buffer;
+
+      /// \brief Protects the socket and the message last sent.
+      public: boost::mutex mutex;
+    };
+
+    /// \internal
+    /// \brief Private data of MulticastReceiver, shared with its thread.
+    class MulticastReceiverPrivate
+    {
+      /// \brief Receive the next datagram.
+      public: void Receive();
+
+      /// \brief Handle a received datagram.
+      /// \param[in] _error Error of the receive.
+      /// \param[in] _size Size of the datagram.
+      public: void OnReceive(const boost::system::error_code &_error,
+                  const size_t _size);
+
+      /// \brief Service of the socket, run by the thread.
+      public: boost::asio::io_service io;
+
+      /// \brief The socket.
+      public: std::unique_ptr<boost::asio::ip::udp::socket> socket;
+
+      /// \brief Sender of the last datagram.
+      public: boost::asio::ip::udp::endpoint from;
+
+      /// \brief Id of the sender to receive from.
+      public: uint64_t id = 0;
+
+      /// \brief Sequence number of the last message received.
+      public: uint64_t sequence = 0;
+
+      /// \brief Number of messages received.
+      public: std::atomic<uint64_t> received{0};
+
+      /// \brief Number of messages lost.
+      public: std::atomic<uint64_t> lost{0};
+
+      /// \brief Latency of the messages, in seconds.
+      public: common::Histogram latency;
+
+      /// \brief Datagram buffer.
+      public: std::vector<char> buffer;
+
+      /// \brief Message buffer.
+      public: std::string message;
+
+      /// \brief Function receiving the messages.
+      public: boost::function<void (const std::string &)> callback;
+
+      /// \brief Protects the callback.
+      public: boost::mutex mutex;
+
+      /// \brief Thread running the service.
+      public: std::thread thread;
+    };
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Write an unsigned integer, little endian.
+/// \param[in] _value The integer.
+/// \param[in] _size Number of bytes to write.
+/// \param[out] _out Destination.
+static void WriteLittleEndian(const uint64_t _value, const size_t _size,
+    char *_out)
+{
+  for (size_t i = 0; i < _size; ++i)
+    _out[i] = static_cast<char>((_value >> (8 * i)) & 0xff);
+}
+
+/////////////////////////////////////////////////
+/// \brief Read an unsigned integer, little endian.
+/// \param[in] _in Source.
+/// \param[in] _size Number of bytes to read.
+/// \return The integer.
+static uint64_t ReadLittleEndian(const char *_in, const size_t _size)
+{
+  uint64_t value = 0;
+  for (size_t i = 0; i < _size; ++i)
+    value |= static_cast<uint64_t>(static_cast<unsigned char>(_in[i])) <<
+      (8 * i);
+  return value;
+}
+
+/////////////////////////////////////////////////
+/// \brief Get an environment variable.
+/// \param[in] _name Name of the variable.
+/// \param[in] _default Value if the variable is not set.
+/// \return The value.
+static std::string GetEnv(const char *_name, const std::string &_default)
+{
+  const char *value = std::getenv(_name);
+  return value && *value ? std::string(value) : _default;
+}
+
+/////////////////////////////////////////////////
+MulticastSender::MulticastSender()
+  : dataPtr(new MulticastSenderPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+MulticastSender::~MulticastSender()
+{
+}
+
+/////////////////////////////////////////////////
+bool MulticastSender::IsDesignated(const std::string &_topic)
+{
+  const std::string topics = GetEnv("GAZEBO_MULTICAST_TOPICS", "");
+
+  size_t start = 0;
+  while (start < topics.size())
+  {
+    size_t end = topics.find(',', start);
+    if (end == std::string::npos)
+      end = topics.size();
+
+    // Entries are topic names, scoped or not, matching the end of the
+    // fully scoped name
+    std::string entry = topics.substr(start, end - start);
+    const size_t first = entry.find_first_not_of(" ~/");
+    const size_t last = entry.find_last_not_of(' ');
+    if (first != std::string::npos)
+    {
+      entry = "/" + entry.substr(first, last + 1 - first);
+      if (_topic.size() >= entry.size() &&
+          _topic.compare(_topic.size() - entry.size(), entry.size(),
+            entry) == 0)
+      {
+        return true;
+      }
+    }
+
+    start = end + 1;
+  }
+
+  return false;
+}
+
+/////////////////////////////////////////////////
+size_t MulticastSender::MaxMessageSize()
+{
+  return kMaxDatagram - kHeaderSize;
+}
+
+/////////////////////////////////////////////////
+bool MulticastSender::Open(const std::string &_topic)
+{
+  // A stable hash of the topic spreads the topics over the ports, so that
+  // receivers only get the datagrams of their topics
+  uint32_t hash = 2166136261u;
+  for (const char c : _topic)
+    hash = (hash ^ static_cast<unsigned char>(c)) * 16777619u;
+
+  unsigned int basePort = kDefaultPort;
+  int ttl = 1;
+  try
+  {
+    basePort = std::stoul(GetEnv("GAZEBO_MULTICAST_PORT",
+          std::to_string(kDefaultPort)));
+    ttl = std::stoi(GetEnv("GAZEBO_MULTICAST_TTL", "1"));
+  }
+  catch(...)
+  {
+    gzwarn << "Invalid GAZEBO_MULTICAST_PORT or GAZEBO_MULTICAST_TTL, "
+      << "using the defaults\n";
+  }
+  const unsigned int port = basePort + hash % kPortRange;
+  if (port > 65535)
+  {
+    gzerr << "Invalid multicast port[" << port << "]\n";
+    return false;
+  }
+
+  boost::system::error_code error;
+  const std::string group = GetEnv("GAZEBO_MULTICAST_GROUP", kDefaultGroup);
+  const boost::asio::ip::address address =
+    boost::asio::ip::address::from_string(group, error);
+  if (error || !address.is_multicast())
+  {
+    gzerr << "Invalid multicast group[" << group << "]\n";
+    return false;
+  }
+
+  boost::mutex::scoped_lock lock(this->dataPtr->mutex);
+  this->dataPtr->endpoint = boost::asio::ip::udp::endpoint(address, port);
+  this->dataPtr->socket.reset(
+      new boost::asio::ip::udp::socket(this->dataPtr->io));
+  this->dataPtr->socket->open(this->dataPtr->endpoint.protocol(), error);
+  if (!error)
+  {
+    this->dataPtr->socket->set_option(
+        boost::asio::ip::multicast::hops(ttl), error);
+  }
+  if (!error)
+  {
+    this->dataPtr->socket->set_option(
+        boost::asio::ip::multicast::enable_loopback(true), error);
+  }
+  if (error)
+  {
+    gzerr << "Unable to open a multicast socket for topic[" << _topic
+      << "]: " << error.message() << "\n";
+    this->dataPtr->socket.reset();
+    return false;
+  }
+
+  std::random_device device;
+  this->dataPtr->id =
+    (static_cast<uint64_t>(device()) << 32) | static_cast<uint64_t>(device());
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool MulticastSender::IsValid() const
+{
+  return this->dataPtr->socket != nullptr;
+}
+
+/////////////////////////////////////////////////
+std::string MulticastSender::Group() const
+{
+  return this->dataPtr->endpoint.address().to_string();
+}
+
+/////////////////////////////////////////////////
+unsigned int MulticastSender::Port() const
+{
+  return this->dataPtr->endpoint.port();
+}
+
+/////////////////////////////////////////////////
+uint64_t MulticastSender::Id() const
+{
+  return this->dataPtr->id;
+}
+
+/////////////////////////////////////////////////
+bool MulticastSender::Send(const std::shared_ptr<const std::string> &_data)
+{
+  if (!_data || _data->size() > MaxMessageSize())
+    return false;
+
+  boost::mutex::scoped_lock lock(this->dataPtr->mutex);
+  if (!this->dataPtr->socket)
+    return false;
+
+  // The subscriptions of the group each pass on the same message
+  if (_data == this->dataPtr->lastData)
+    return true;
+
+  std::vector<char> &buffer = this->dataPtr->buffer;
+  buffer.resize(kHeaderSize + _data->size());
+  WriteLittleEndian(kMagic, 4, &buffer[0]);
+  WriteLittleEndian(this->dataPtr->id, 8, &buffer[4]);
+  WriteLittleEndian(this->dataPtr->sequence + 1, 8, &buffer[12]);
+  WriteLittleEndian(static_cast<uint64_t>(Connection::GetTimestamp()), 8,
+      &buffer[20]);
+  std::copy(_data->begin(), _data->end(), buffer.begin() + kHeaderSize);
+
+  boost::system::error_code error;
+  this->dataPtr->socket->send_to(boost::asio::buffer(buffer),
+      this->dataPtr->endpoint, 0, error);
+  if (error)
+  {
+    gzwarn << "Unable to send to multicast group[" << this->Group() << ":"
+      << this->Port() << "]: " << error.message() << "\n";
+    return false;
+  }
+
+  ++this->dataPtr->sequence;
+  this->dataPtr->lastData = _data;
+  return true;
+}
+
+/////////////////////////////////////////////////
+uint64_t MulticastSender::Sequence() const
+{
+  return this->dataPtr->sequence;
+}
+
+/////////////////////////////////////////////////
+MulticastReceiver::MulticastReceiver()
+  : dataPtr(new MulticastReceiverPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+MulticastReceiver::~MulticastReceiver()
+{
+  this->Stop();
+}
+
+/////////////////////////////////////////////////
+bool MulticastReceiver::Open(const std::string &_group,
+    const unsigned int _port, const uint64_t _id)
+{
+  boost::system::error_code error;
+  const boost::asio::ip::address address =
+    boost::asio::ip::address::from_string(_group, error);
+  if (error || !address.is_multicast() || _port > 65535)
+  {
+    gzerr << "Invalid multicast group[" << _group << ":" << _port << "]\n";
+    return false;
+  }
+
+  std::shared_ptr<MulticastReceiverPrivate> data = this->dataPtr;
+  if (data->socket)
+    return false;
+
+  // Several processes of a host may receive the same group
+  const boost::asio::ip::udp::endpoint listen(
+      address.is_v6() ? boost::asio::ip::address(
+        boost::asio::ip::address_v6::any()) :
+      boost::asio::ip::address(boost::asio::ip::address_v4::any()), _port);
+  data->socket.reset(new boost::asio::ip::udp::socket(data->io));
+  data->socket->open(listen.protocol(), error);
+  if (!error)
+  {
+    data->socket->set_option(
+        boost::asio::ip::udp::socket::reuse_address(true), error);
+  }
+  if (!error)
+    data->socket->bind(listen, error);
+  if (!error)
+  {
+    data->socket->set_option(
+        boost::asio::ip::multicast::join_group(address), error);
+  }
+  if (error)
+  {
+    gzwarn << "Unable to join multicast group[" << _group << ":" << _port
+      << "], using TCP: " << error.message() << "\n";
+    data->socket.reset();
+    return false;
+  }
+
+  data->id = _id;
+  data->buffer.resize(kMaxDatagram);
+  data->Receive();
+
+  // The thread owns the data too, so that the callback may destroy the
+  // receiver
+  data->thread = std::thread([data]()
+      {
+        data->io.run();
+      });
+  return true;
+}
+
+/////////////////////////////////////////////////
+void MulticastReceiver::SetCallback(
+    const boost::function<void(const std::string &)> &_cb)
+{
+  boost::mutex::scoped_lock lock(this->dataPtr->mutex);
+  this->dataPtr->callback = _cb;
+}
+
+/////////////////////////////////////////////////
+void MulticastReceiver::Stop()
+{
+  std::shared_ptr<MulticastReceiverPrivate> data = this->dataPtr;
+  {
+    boost::mutex::scoped_lock lock(data->mutex);
+    data->callback.clear();
+  }
+  data->io.stop();
+
+  // The thread may be the one destroying the receiver
+  if (data->thread.get_id() == std::this_thread::get_id())
+    data->thread.detach();
+  else if (data->thread.joinable())
+    data->thread.join();
+}
+
+/////////////////////////////////////////////////
+uint64_t MulticastReceiver::Received() const
+{
+  return this->dataPtr->received;
+}
+
+/////////////////////////////////////////////////
+uint64_t MulticastReceiver::Lost() const
+{
+  return this->dataPtr->lost;
+}
+
+/////////////////////////////////////////////////
+const common::Histogram &MulticastReceiver::Latency() const
+{
+  return this->dataPtr->latency;
+}
+
+/////////////////////////////////////////////////
+void MulticastReceiverPrivate::Receive()
+{
+  this->socket->async_receive_from(boost::asio::buffer(this->buffer),
+      this->from, [this](const boost::system::error_code &_error,
+        const size_t _size)
+      {
+        this->OnReceive(_error, _size);
+      });
+}
+
+/////////////////////////////////////////////////
+void MulticastReceiverPrivate::OnReceive(
+    const boost::system::error_code &_error, const size_t _size)
+{
+  if (_error == boost::asio::error::operation_aborted)
+    return;
+
+  const char *datagram = this->buffer.data();
+  if (!_error && _size >= kHeaderSize &&
+      ReadLittleEndian(datagram, 4) == kMagic &&
+      ReadLittleEndian(datagram + 4, 8) == this->id)
+  {
+    // Late and duplicate messages are discarded, missing ones are lost
+    const uint64_t seq = ReadLittleEndian(datagram + 12, 8);
+    if (seq > this->sequence)
+    {
+      if (this->sequence > 0)
+        this->lost += seq - this->sequence - 1;
+      this->sequence = seq;
+      ++this->received;
+
+      const int64_t stamp =
+        static_cast<int64_t>(ReadLittleEndian(datagram + 20, 8));
+      this->latency.Add((Connection::GetTimestamp() - stamp) * 1e-9);
+
+      this->message.assign(datagram + kHeaderSize, _size - kHeaderSize);
+      boost::function<void (const std::string &)> cb;
+      {
+        boost::mutex::scoped_lock lock(this->mutex);
+        cb = this->callback;
+      }
+      if (cb && !this->message.empty())
+        cb(this->message);
+    }
+  }
+
+  if (!this->io.stopped())
+    this->Receive();
+}
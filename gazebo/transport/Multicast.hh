@@ -0,0 +1,155 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_TRANSPORT_MULTICAST_HH_
+#define GAZEBO_TRANSPORT_MULTICAST_HH_
+
+#include <boost/function.hpp>
+#include <memory>
+#include <string>
+
+#include "gazebo/common/Histogram.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace transport
+  {
+    // Forward declare private data classes.
+    class MulticastSenderPrivate;
+    class MulticastReceiverPrivate;
+
+    /// \addtogroup gazebo_transport
+    /// \{
+
+    /// \class MulticastSender Multicast.hh transport/transport.hh
+    /// \brief Sends the messages of a topic to a UDP multicast group, so
+    /// that they are sent once whatever the number of remote subscribers.
+    ///
+    /// Only the topics listed in the GAZEBO_MULTICAST_TOPICS environment
+    /// variable are sent this way, a comma separated list of topic names
+    /// such as "~/pose/info,~/world_stats". Each datagram holds one
+    /// message, with the id of the sender and a sequence number. The group
+    /// is set by GAZEBO_MULTICAST_GROUP, the time to live by
+    /// GAZEBO_MULTICAST_TTL, and the port of each topic is derived from the
+    /// topic name and GAZEBO_MULTICAST_PORT. Messages too large for a
+    /// datagram, and latched messages, are sent through the connections.
+    class GZ_TRANSPORT_VISIBLE MulticastSender
+    {
+      /// \brief Constructor.
+      public: MulticastSender();
+
+      /// \brief Destructor.
+      public: virtual ~MulticastSender();
+
+      /// \brief Check whether a topic is listed in GAZEBO_MULTICAST_TOPICS.
+      /// \param[in] _topic Fully scoped name of the topic.
+      /// \return True if the topic should be sent to a multicast group.
+      public: static bool IsDesignated(const std::string &_topic);
+
+      /// \brief Get the largest message that fits in a datagram.
+      /// \return Size in bytes.
+      public: static size_t MaxMessageSize();
+
+      /// \brief Open the socket sending the messages of a topic.
+      /// \param[in] _topic Fully scoped name of the topic.
+      /// \return True if the socket was opened.
+      public: bool Open(const std::string &_topic);
+
+      /// \brief Check whether the socket was opened.
+      /// \return True if messages can be sent.
+      public: bool IsValid() const;
+
+      /// \brief Get the multicast group.
+      /// \return Address of the group.
+      public: std::string Group() const;
+
+      /// \brief Get the port the datagrams are sent to.
+      /// \return The port.
+      public: unsigned int Port() const;
+
+      /// \brief Get the id of the sender, which receivers use to ignore
+      /// other senders of the same group and port.
+      /// \return The id.
+      public: uint64_t Id() const;
+
+      /// \brief Send a message, once: the message last sent is not sent
+      /// again, so that each subscription of the group can pass it on.
+      /// \param[in] _data The serialized message.
+      /// \return True if the message was sent, now or before. False if it
+      /// has to be sent through the connections.
+      public: bool Send(const std::shared_ptr<const std::string> &_data);
+
+      /// \brief Get the number of messages sent.
+      /// \return Sequence number of the last message sent.
+      public: uint64_t Sequence() const;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<MulticastSenderPrivate> dataPtr;
+    };
+
+    /// \class MulticastReceiver Multicast.hh transport/transport.hh
+    /// \brief Receives the messages of a MulticastSender on a thread of
+    /// its own.
+    ///
+    /// Messages arriving out of order or twice are discarded, and missing
+    /// sequence numbers are counted as lost.
+    class GZ_TRANSPORT_VISIBLE MulticastReceiver
+    {
+      /// \brief Constructor.
+      public: MulticastReceiver();
+
+      /// \brief Destructor. Stops receiving.
+      public: virtual ~MulticastReceiver();
+
+      /// \brief Join a multicast group and start receiving.
+      /// \param[in] _group Address of the group.
+      /// \param[in] _port Port of the datagrams.
+      /// \param[in] _id Id of the sender to receive from.
+      /// \return True if the group was joined.
+      public: bool Open(const std::string &_group, const unsigned int _port,
+                  const uint64_t _id);
+
+      /// \brief Set the function receiving the messages. It is called on
+      /// the thread of the receiver, and may destroy the receiver.
+      /// \param[in] _cb The function.
+      public: void SetCallback(
+                  const boost::function<void(const std::string &)> &_cb);
+
+      /// \brief Stop receiving.
+      public: void Stop();
+
+      /// \brief Get the number of messages received.
+      /// \return Number of messages passed to the callback.
+      public: uint64_t Received() const;
+
+      /// \brief Get the number of messages lost.
+      /// \return Number of sequence numbers skipped.
+      public: uint64_t Lost() const;
+
+      /// \brief Get the latency of the messages received.
+      /// \return Histogram of the time in seconds from sending to receiving.
+      public: const common::Histogram &Latency() const;
+
+      /// \internal
+      /// \brief Private data pointer, shared with the receiving thread.
+      private: std::shared_ptr<MulticastReceiverPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "gazebo/transport/Multicast.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class MulticastTest : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+#ifdef _WIN32
+static int setenv(const char *envname, const char *envval, int overwrite)
+{
+  char *original = getenv(envname);
+  if (!original || !!overwrite)
+  {
+    std::string envstring = std::string(envname) + "=" + envval;
+    return _putenv(envstring.c_str());
+  }
+  return 0;
+}
+#endif
+
+/////////////////////////////////////////////////
+TEST_F(MulticastTest, Designated)
+{
+  setenv("GAZEBO_MULTICAST_TOPICS", "", 1);
+  EXPECT_FALSE(transport::MulticastSender::IsDesignated(
+        "/gazebo/default/pose/info"));
+
+  setenv("GAZEBO_MULTICAST_TOPICS",
+      "~/pose/info, /gazebo/default/world_stats,physics/contacts", 1);
+  EXPECT_TRUE(transport::MulticastSender::IsDesignated(
+        "/gazebo/default/pose/info"));
+  EXPECT_TRUE(transport::MulticastSender::IsDesignated(
+        "/gazebo/default/world_stats"));
+  EXPECT_TRUE(transport::MulticastSender::IsDesignated(
+        "/gazebo/other/physics/contacts"));
+  EXPECT_FALSE(transport::MulticastSender::IsDesignated(
+        "/gazebo/other/world_stats"));
+  EXPECT_FALSE(transport::MulticastSender::IsDesignated(
+        "/gazebo/default/upose/info"));
+  EXPECT_FALSE(transport::MulticastSender::IsDesignated(
+        "/gazebo/default/pose/info/extra"));
+  setenv("GAZEBO_MULTICAST_TOPICS", "", 1);
+}
+
+/////////////////////////////////////////////////
+TEST_F(MulticastTest, SendReceive)
+{
+  transport::MulticastSender sender;
+  EXPECT_FALSE(sender.IsValid());
+  EXPECT_FALSE(sender.Send(std::make_shared<std::string>("a")));
+
+  // Multicast sockets may be unavailable in the test environment
+  if (!sender.Open("/gazebo/test/multicast"))
+    return;
+  EXPECT_TRUE(sender.IsValid());
+
+  // The port depends on the topic, the id on the sender
+  transport::MulticastSender other;
+  if (other.Open("/gazebo/test/multicast"))
+  {
+    EXPECT_EQ(sender.Group(), other.Group());
+    EXPECT_EQ(sender.Port(), other.Port());
+    EXPECT_NE(sender.Id(), other.Id());
+  }
+
+  std::mutex mutex;
+  std::string received;
+  transport::MulticastReceiver receiver;
+  receiver.SetCallback([&mutex, &received](const std::string &_data)
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        received = _data;
+      });
+  const bool joined =
+    receiver.Open(sender.Group(), sender.Port(), sender.Id());
+
+  // The message last sent isn't sent again
+  auto data = std::make_shared<std::string>("pose");
+  EXPECT_TRUE(sender.Send(data));
+  EXPECT_TRUE(sender.Send(data));
+  EXPECT_EQ(1u, sender.Sequence());
+
+  // Messages too large for a datagram go through the connections
+  EXPECT_FALSE(sender.Send(std::make_shared<std::string>(
+          transport::MulticastSender::MaxMessageSize() + 1, 'x')));
+  EXPECT_EQ(1u, sender.Sequence());
+
+  if (!joined)
+    return;
+
+  // Delivery depends on the multicast routes of the host
+  for (int i = 0; i < 100 && receiver.Received() == 0; ++i)
+  {
+    EXPECT_TRUE(sender.Send(std::make_shared<std::string>("pose")));
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+
+  if (receiver.Received() > 0)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    EXPECT_EQ("pose", received);
+    EXPECT_GT(receiver.Latency().Count(), 0u);
+  }
+  receiver.Stop();
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -14,6 +14,11 @@
  * limitations under the License.
  *
 */
+#include <iterator>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
 #include <boost/algorithm/string.hpp>
 #include <boost/bind/bind.hpp>
 #include "gazebo/transport/TransportIface.hh"
@@ -196,6 +201,8 @@ bool Node::HandleData(const std::string &_topic, const std::string &_msg)
 {
   boost::recursive_mutex::scoped_lock lock(this->incomingMutex);
   this->incomingMsgs[_topic].push_back(_msg);
+  if (!this->incomingPending.exchange(true))
+    TopicManager::Instance()->AddIncomingNode(shared_from_this());
   ConnectionManager::Instance()->TriggerUpdate();
   return true;
 }
@@ -205,6 +212,8 @@ bool Node::HandleMessage(const std::string &_topic, MessagePtr _msg)
 {
   boost::recursive_mutex::scoped_lock lock(this->incomingMutex);
   this->incomingMsgsLocal[_topic].push_back(_msg);
+  if (!this->incomingPending.exchange(true))
+    TopicManager::Instance()->AddIncomingNode(shared_from_this());
   ConnectionManager::Instance()->TriggerUpdate();
   return true;
 }
@@ -214,6 +223,9 @@ void Node::ProcessIncoming()
 {
   boost::recursive_mutex::scoped_lock lock(this->processIncomingMutex);
 
+  // Messages received from now on queue the node again
+  this->incomingPending = false;
+
   if (!this->initialized ||
       (this->incomingMsgs.empty() && this->incomingMsgsLocal.empty()))
     return;
@@ -237,22 +249,39 @@ void Node::ProcessIncoming()
       cbIter = this->callbacks.find(inIter->first);
       if (cbIter != this->callbacks.end())
       {
-        std::list<std::string>::iterator msgInIter;
-        std::list<std::string>::iterator msgEndIter;
+        // Messages parsed for the typed callbacks, by message type, so
+        // that each message is parsed once per type
+        std::map<const google::protobuf::Descriptor *,
+          std::vector<MessagePtr> > parsed;
+
+        // Send the messages to all callbacks, each one getting the
+        // messages its delivery policy needs
+        for (liter = cbIter->second.begin();
+            liter != cbIter->second.end(); ++liter)
+        {
+          size_t index = (*liter)->FirstDelivered(inIter->second.size());
+          msgIter = std::next(inIter->second.begin(), index);
 
-        msgInIter = inIter->second.begin();
-        msgEndIter = inIter->second.end();
+          const google::protobuf::Descriptor *descriptor =
+            (*liter)->GetDescriptor();
+          if (!descriptor)
+          {
+            for (; msgIter != inIter->second.end(); ++msgIter)
+            {
+              using namespace boost::placeholders;
+              (*liter)->HandleData(*msgIter,
+                  boost::bind(&dummy_callback_fn, _1), 0);
+            }
+            continue;
+          }
 
-        // For each message in the buffer
-        for (msgIter = msgInIter; msgIter != msgEndIter; ++msgIter)
-        {
-          // Send the message to all callbacks
-          for (liter = cbIter->second.begin();
-              liter != cbIter->second.end(); ++liter)
+          std::vector<MessagePtr> &msgs = parsed[descriptor];
+          msgs.resize(inIter->second.size());
+          for (; msgIter != inIter->second.end(); ++msgIter, ++index)
           {
-            using namespace boost::placeholders;
-            (*liter)->HandleData(*msgIter,
-                boost::bind(&dummy_callback_fn, _1), 0);
+            if (!msgs[index])
+              msgs[index] = (*liter)->Parse(*msgIter);
+            (*liter)->HandleMessage(msgs[index]);
           }
         }
       }
@@ -276,20 +305,37 @@ void Node::ProcessIncoming()
       cbIter = this->callbacks.find(inIter->first);
       if (cbIter != this->callbacks.end())
       {
-        std::list<MessagePtr>::iterator msgInIter;
-        std::list<MessagePtr>::iterator msgEndIter;
-
-        msgInIter = inIter->second.begin();
-        msgEndIter = inIter->second.end();
+        // Serializations of the messages, made only for raw callbacks
+        std::vector<std::unique_ptr<std::string> > serialized;
 
-        // For each message in the buffer
-        for (msgIter = msgInIter; msgIter != msgEndIter; ++msgIter)
+        // Send the messages to all callbacks, each one getting the
+        // messages its delivery policy needs
+        for (liter = cbIter->second.begin();
+            liter != cbIter->second.end(); ++liter)
         {
-          // Send the message to all callbacks
-          for (liter = cbIter->second.begin();
-              liter != cbIter->second.end(); ++liter)
+          size_t index = (*liter)->FirstDelivered(inIter->second.size());
+          msgIter = std::next(inIter->second.begin(), index);
+
+          // Typed callbacks get the published message itself
+          if (!boost::dynamic_pointer_cast<RawCallbackHelper>(*liter))
           {
-            (*liter)->HandleMessage(*msgIter);
+            for (; msgIter != inIter->second.end(); ++msgIter)
+              (*liter)->HandleMessage(*msgIter);
+            continue;
+          }
+
+          // Raw callbacks share one serialization of each message
+          serialized.resize(inIter->second.size());
+          for (; msgIter != inIter->second.end(); ++msgIter, ++index)
+          {
+            if (!serialized[index])
+            {
+              serialized[index].reset(new std::string);
+              (*msgIter)->SerializeToString(serialized[index].get());
+            }
+            using namespace boost::placeholders;
+            (*liter)->HandleData(*serialized[index],
+                boost::bind(&dummy_callback_fn, _1), 0);
           }
         }
       }
@@ -362,6 +408,22 @@ bool Node::HasLatchedSubscriber(const std::string &_topic) const
   return false;
 }
 
+/////////////////////////////////////////////////
+SubscriptionQos Node::SubscriberQos(const std::string &_topic) const
+{
+  boost::recursive_mutex::scoped_lock lock(this->incomingMutex);
+
+  Callback_M::const_iterator iter = this->callbacks.find(_topic);
+  if (iter == this->callbacks.end() || iter->second.empty())
+    return SubscriptionQos();
+
+  SubscriptionQos qos = iter->second.front()->Qos();
+  for (const auto &cb : iter->second)
+    qos = qos.Merge(cb->Qos());
+
+  return qos;
+}
+
 /////////////////////////////////////////////////
 void Node::RemoveCallback(const std::string &_topic, unsigned int _id)
 {
@@ -26,11 +26,13 @@
 #endif
 #include <boost/bind.hpp>
 #include <boost/enable_shared_from_this.hpp>
+#include <atomic>
 #include <map>
 #include <list>
 #include <string>
 #include <vector>
 
+#include "gazebo/transport/SubscriptionQos.hh"
 #include "gazebo/transport/TransportTypes.hh"
 #include "gazebo/transport/TopicManager.hh"
 #include "gazebo/util/system.hh"
@@ -152,6 +154,12 @@ namespace gazebo
       /// \return True if a latched subscriber exists.
       public: bool HasLatchedSubscriber(const std::string &_topic) const;
 
+      /// \brief Get the delivery policy needed by the subscribers of this
+      /// node to a topic, the least restrictive of their policies.
+      /// \param[in] _topic Name of the topic.
+      /// \return The policy, reliable if there is no subscriber.
+      public: SubscriptionQos SubscriberQos(const std::string &_topic) const;
+
 
       /// \brief A convenience function for a one-time publication of
       /// a message. This is inefficient, compared to
@@ -241,11 +249,13 @@ namespace gazebo
       /// \param[in] _obj Class instance to be used on receipt of new message
       /// \param[in] _latching If true, latch latest incoming message;
       /// otherwise don't latch
+      /// \param[in] _qos Delivery policy of the subscription
       /// \return Pointer to new Subscriber object
       public: template<typename M, typename T>
       SubscriberPtr Subscribe(const std::string &_topic,
           void(T::*_fp)(const boost::shared_ptr<M const> &), T *_obj,
-          bool _latching = false)
+          bool _latching = false,
+          const SubscriptionQos &_qos = SubscriptionQos())
       {
         SubscribeOptions ops;
         std::string decodedTopic = this->DecodeTopicName(_topic);
@@ -256,6 +266,7 @@ namespace gazebo
           boost::recursive_mutex::scoped_lock lock(this->incomingMutex);
           this->callbacks[decodedTopic].push_back(CallbackHelperPtr(
                 new CallbackHelperT<M>(boost::bind(_fp, _obj, _1), _latching)));
+          this->callbacks[decodedTopic].back()->SetQos(_qos);
         }
 
         SubscriberPtr result =
@@ -271,11 +282,13 @@ namespace gazebo
       /// \param[in] _fp Function to be called on receipt of new message
       /// \param[in] _latching If true, latch latest incoming message;
       /// otherwise don't latch
+      /// \param[in] _qos Delivery policy of the subscription
       /// \return Pointer to new Subscriber object
       public: template<typename M>
       SubscriberPtr Subscribe(const std::string &_topic,
           void(*_fp)(const boost::shared_ptr<M const> &),
-                     bool _latching = false)
+          bool _latching = false,
+          const SubscriptionQos &_qos = SubscriptionQos())
       {
         SubscribeOptions ops;
         std::string decodedTopic = this->DecodeTopicName(_topic);
@@ -285,6 +298,7 @@ namespace gazebo
           boost::recursive_mutex::scoped_lock lock(this->incomingMutex);
           this->callbacks[decodedTopic].push_back(
               CallbackHelperPtr(new CallbackHelperT<M>(_fp, _latching)));
+          this->callbacks[decodedTopic].back()->SetQos(_qos);
         }
 
         SubscriberPtr result =
@@ -301,11 +315,13 @@ namespace gazebo
       /// \param[in] _obj Class instance to be used on receipt of new message
       /// \param[in] _latching If true, latch latest incoming message;
       /// otherwise don't latch
+      /// \param[in] _qos Delivery policy of the subscription
       /// \return Pointer to new Subscriber object
       template<typename T>
       SubscriberPtr Subscribe(const std::string &_topic,
           void(T::*_fp)(const std::string &), T *_obj,
-          bool _latching = false)
+          bool _latching = false,
+          const SubscriptionQos &_qos = SubscriptionQos())
       {
         SubscribeOptions ops;
         std::string decodedTopic = this->DecodeTopicName(_topic);
@@ -316,6 +332,7 @@ namespace gazebo
           boost::recursive_mutex::scoped_lock lock(this->incomingMutex);
           this->callbacks[decodedTopic].push_back(CallbackHelperPtr(
                 new RawCallbackHelper(boost::bind(_fp, _obj, _1))));
+          this->callbacks[decodedTopic].back()->SetQos(_qos);
         }
 
         SubscriberPtr result =
@@ -332,9 +349,11 @@ namespace gazebo
       /// \param[in] _fp Function to be called on receipt of new message
       /// \param[in] _latching If true, latch latest incoming message;
       /// otherwise don't latch
+      /// \param[in] _qos Delivery policy of the subscription
       /// \return Pointer to new Subscriber object
       SubscriberPtr Subscribe(const std::string &_topic,
-          void(*_fp)(const std::string &), bool _latching = false)
+          void(*_fp)(const std::string &), bool _latching = false,
+          const SubscriptionQos &_qos = SubscriptionQos())
       {
         SubscribeOptions ops;
         std::string decodedTopic = this->DecodeTopicName(_topic);
@@ -344,6 +363,7 @@ namespace gazebo
           boost::recursive_mutex::scoped_lock lock(this->incomingMutex);
           this->callbacks[decodedTopic].push_back(
               CallbackHelperPtr(new RawCallbackHelper(_fp)));
+          this->callbacks[decodedTopic].back()->SetQos(_qos);
         }
 
         SubscriberPtr result =
@@ -428,7 +448,11 @@ namespace gazebo
 
       private: boost::mutex publisherMutex;
       private: boost::mutex publisherDeleteMutex;
-      private: boost::recursive_mutex incomingMutex;
+      private: mutable boost::recursive_mutex incomingMutex;
+
+      /// \brief True while this node is queued in the topic manager for
+      /// processing of incoming messages.
+      private: std::atomic<bool> incomingPending{false};
 
       /// \brief make sure we don't call ProcessingIncoming simultaneously
       /// from separate threads.
@@ -17,9 +17,13 @@
 
 #include <boost/bind/bind.hpp>
 #include <boost/function.hpp>
+#include <chrono>
+#include <memory>
+#include "gazebo/common/Tracer.hh"
 #include "gazebo/common/WeakBind.hh"
 #include "SubscriptionTransport.hh"
 #include "Publication.hh"
+#include "Publisher.hh"
 #include "Node.hh"
 
 using namespace gazebo;
@@ -90,9 +94,17 @@ void Publication::AddSubscription(const CallbackHelperPtr _callback)
       for (std::map<uint32_t, MessagePtr>::iterator pubIter =
           this->prevMsgs.begin(); pubIter != this->prevMsgs.end(); ++pubIter)
       {
-        if (pubIter->second)
-        {
+        if (!pubIter->second)
+          continue;
+
+        // A remote subscription shares the serialized message
+        if (_callback->IsLocal())
           _callback->HandleMessage(pubIter->second);
+        else
+        {
+          using namespace boost::placeholders;
+          _callback->HandleSharedData(this->Serialize(pubIter->second),
+              boost::bind(&dummy_callback_fn, _1), 0);
         }
       }
       _callback->SetLatching(false);
@@ -110,8 +122,34 @@ void Publication::SetPrevMsg(uint32_t _pubId, MessagePtr _msg)
 //////////////////////////////////////////////////
 void Publication::ClearPrevMsgs()
 {
-  boost::mutex::scoped_lock lock(this->callbackMutex);
-  this->prevMsgs.clear();
+  {
+    boost::mutex::scoped_lock lock(this->callbackMutex);
+    this->prevMsgs.clear();
+  }
+
+  boost::mutex::scoped_lock lock(this->serializeMutex);
+  this->serializedMsg.reset();
+  this->serializedData.reset();
+}
+
+//////////////////////////////////////////////////
+std::shared_ptr<const std::string> Publication::Serialize(
+    const MessagePtr &_msg)
+{
+  boost::mutex::scoped_lock lock(this->serializeMutex);
+  if (_msg != this->serializedMsg || !this->serializedData)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    auto data = std::make_shared<std::string>();
+    _msg->SerializeToString(data.get());
+    this->serializeTime +=
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now() - start).count();
+    this->byteCount += data->size();
+    this->serializedMsg = _msg;
+    this->serializedData = data;
+  }
+  return this->serializedData;
 }
 
 //////////////////////////////////////////////////
@@ -294,9 +332,12 @@ void Publication::LocalPublish(const std::string &_data)
 int Publication::Publish(MessagePtr _msg, boost::function<void(uint32_t)> _cb,
     uint32_t _id)
 {
+  GZ_TRACE_SCOPE("transport::Publication::Publish");
   int result = 0;
   std::list<NodePtr>::iterator iter, endIter;
 
+  ++this->messageCount;
+
   {
     boost::mutex::scoped_lock lock(this->nodeMutex);
 
@@ -321,14 +362,15 @@ int Publication::Publish(MessagePtr _msg, boost::function<void(uint32_t)> _cb,
 
     if (!this->callbacks.empty())
     {
-      std::string data;
-      _msg->SerializeToString(&data);
+      // Serialize once, the remote subscriptions share the data
+      const std::shared_ptr<const std::string> sharedData =
+          this->Serialize(_msg);
       std::list<CallbackHelperPtr>::iterator cbIter;
       cbIter = this->callbacks.begin();
 
       while (cbIter != this->callbacks.end())
       {
-        if ((*cbIter)->HandleData(data, _cb, _id))
+        if ((*cbIter)->HandleSharedData(sharedData, _cb, _id))
         {
           ++result;
           ++cbIter;
@@ -526,3 +568,65 @@ MessagePtr Publication::GetPrevMsg(uint32_t _pubId)
     return MessagePtr();
 }
 
+
+//////////////////////////////////////////////////
+void Publication::FillStats(msgs::TransportStatistics::Topic &_msg) const
+{
+  _msg.set_name(this->topic);
+  _msg.set_msg_type(this->msgType);
+  _msg.set_messages(this->messageCount);
+  _msg.set_bytes(this->byteCount);
+  _msg.set_serialize_time(this->serializeTime * 1e-9);
+
+  {
+    unsigned int depth = 0;
+    uint64_t drops = 0;
+    boost::mutex::scoped_lock lock(this->callbackMutex);
+    for (const auto &pub : this->publishers)
+    {
+      depth += pub->GetOutgoingCount();
+      drops += pub->DropCount();
+    }
+    _msg.set_queue_depth(depth);
+    _msg.set_drops(drops);
+  }
+
+  std::list<PublicationTransportPtr> links;
+  {
+    boost::mutex::scoped_lock lock(this->nodeMutex);
+    links = this->transports;
+  }
+
+  // Messages lost by the multicast receivers
+  for (const auto &link : links)
+    _msg.set_drops(_msg.drops() + link->DropCount());
+
+  msgs::TransportStatistics::Histogram latency;
+  latency.set_count(0);
+  latency.set_sum(0);
+  for (const auto &link : links)
+    link->AddLatency(latency);
+
+  if (latency.count() > 0)
+    _msg.mutable_latency()->CopyFrom(latency);
+}
+
+//////////////////////////////////////////////////
+bool Publication::InitMulticast()
+{
+  boost::mutex::scoped_lock lock(this->multicastMutex);
+  if (!this->multicast && MulticastSender::IsDesignated(this->topic))
+  {
+    std::shared_ptr<MulticastSender> sender(new MulticastSender());
+    if (sender->Open(this->topic))
+      this->multicast = sender;
+  }
+  return this->multicast != nullptr;
+}
+
+//////////////////////////////////////////////////
+std::shared_ptr<MulticastSender> Publication::Multicast() const
+{
+  boost::mutex::scoped_lock lock(this->multicastMutex);
+  return this->multicast;
+}
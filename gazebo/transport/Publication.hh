@@ -22,12 +22,15 @@
 #include <boost/function.hpp>
 #include <boost/shared_ptr.hpp>
 #include <boost/thread/mutex.hpp>
+#include <atomic>
 #include <list>
+#include <memory>
 #include <string>
 #include <vector>
 #include <map>
 
 #include "gazebo/transport/CallbackHelper.hh"
+#include "gazebo/transport/Multicast.hh"
 #include "gazebo/transport/TransportTypes.hh"
 #include "gazebo/transport/PublicationTransport.hh"
 #include "gazebo/util/system.hh"
@@ -149,6 +152,16 @@ namespace gazebo
       /// \brief Clear all previous messages for a publisher.
       public: void ClearPrevMsgs();
 
+      /// \brief Serialize a message published on the topic. The last
+      /// serialization is kept, so that a message is serialized once for
+      /// the remote subscribers, the latched subscriptions and
+      /// Publisher::GetPrevMsg.
+      /// \param[in] _msg The message, which must not change once
+      /// published.
+      /// \return The serialized message.
+      public: std::shared_ptr<const std::string> Serialize(
+                  const MessagePtr &_msg);
+
       /// \brief Add a transport
       /// \param[in] _publink Pointer to publication transport object to
       /// be added
@@ -164,6 +177,20 @@ namespace gazebo
       /// \param[in,out] _pub Pointer to publisher object to be added
       public: void AddPublisher(PublisherPtr _pub);
 
+      /// \brief Get the counters of the topic.
+      /// \param[out] _msg Message receiving the counters.
+      public: void FillStats(msgs::TransportStatistics::Topic &_msg) const;
+
+      /// \brief Open the multicast sender of the topic, if the topic is
+      /// designated for multicast, see MulticastSender.
+      /// \return True if the topic is sent to a multicast group.
+      public: bool InitMulticast();
+
+      /// \brief Get the multicast sender of the topic.
+      /// \return The sender, null if the topic is not sent to a multicast
+      /// group.
+      public: std::shared_ptr<MulticastSender> Multicast() const;
+
       /// \brief Remove nodes that have been marked for removal
       private: void RemoveNodes();
 
@@ -211,6 +238,31 @@ namespace gazebo
 
       /// \brief Publishers and their last messages.
       private: std::map<uint32_t, MessagePtr> prevMsgs;
+
+      /// \brief Last message serialized by Serialize.
+      private: MessagePtr serializedMsg;
+
+      /// \brief Serialization of serializedMsg.
+      private: std::shared_ptr<const std::string> serializedData;
+
+      /// \brief Mutex to protect the last serialization.
+      private: boost::mutex serializeMutex;
+
+      /// \brief Number of messages published.
+      private: std::atomic<uint64_t> messageCount{0};
+
+      /// \brief Number of bytes serialized.
+      private: std::atomic<uint64_t> byteCount{0};
+
+      /// \brief Time spent serializing, in nanoseconds.
+      private: std::atomic<uint64_t> serializeTime{0};
+
+      /// \brief Sender of the multicast group of the topic, shared with the
+      /// remote subscriptions that receive the group.
+      private: std::shared_ptr<MulticastSender> multicast;
+
+      /// \brief Protects the multicast sender.
+      private: mutable boost::mutex multicastMutex;
     };
     /// \}
   }
@@ -14,10 +14,21 @@
  * limitations under the License.
  *
 */
+#ifdef __linux__
+  #include <unistd.h>
+#endif
+
 #include <boost/function.hpp>
+#include <boost/thread/mutex.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
 #include "gazebo/transport/TopicManager.hh"
 #include "gazebo/transport/ConnectionManager.hh"
+#include "gazebo/transport/Multicast.hh"
 #include "gazebo/transport/PublicationTransport.hh"
+#include "gazebo/transport/ShmRing.hh"
 #include "gazebo/common/WeakBind.hh"
 
 using namespace gazebo;
@@ -25,10 +36,146 @@ using namespace transport;
 
 int PublicationTransport::counter = 0;
 
+/// \brief Number of bytes of a shared memory ring. Larger messages are
+/// written in several parts.
+static const size_t kShmCapacity = 4 * 1024 * 1024;
+
+namespace gazebo
+{
+  namespace transport
+  {
+    /// \internal
+    /// \brief Reads the messages of a shared memory ring. The reader is
+    /// owned by its thread as well, so that the transport may be destroyed
+    /// by a callback invoked on the thread.
+    class ShmReader
+    {
+      /// \brief Set the function receiving the messages.
+      /// \param[in] _cb The function.
+      public: void SetCallback(
+                  const boost::function<void(const std::string &)> &_cb)
+              {
+                boost::mutex::scoped_lock lock(this->mutex);
+                this->callback = _cb;
+              }
+
+      /// \brief Read the messages until stopped or until the advertiser
+      /// closes the ring.
+      public: void Run();
+
+      /// \brief The ring.
+      public: ShmRing ring;
+
+      /// \brief True to stop reading.
+      public: std::atomic<bool> stop{false};
+
+      /// \brief Latency of the messages read, in seconds, shared with the
+      /// transport.
+      public: std::shared_ptr<common::Histogram> latency;
+
+      /// \brief Function receiving the messages.
+      private: boost::function<void (const std::string &)> callback;
+
+      /// \brief Protects the callback.
+      private: boost::mutex mutex;
+    };
+  }
+}
+
+/////////////////////////////////////////////////
+void ShmReader::Run()
+{
+  // Each frame is a native uint32 size and int64 timestamp followed by the
+  // message, possibly split over several waits.
+  char prefix[sizeof(uint32_t) + sizeof(int64_t)];
+  size_t prefixRead = 0;
+  std::string frame;
+  size_t frameRead = 0;
+
+  while (!this->stop)
+  {
+    // Once the advertiser opened the ring, remove its name so that the
+    // memory is released even if a process dies
+    if (this->ring.IsAttached())
+      this->ring.Unlink();
+
+    if (!this->ring.Wait(100))
+      continue;
+
+    while (!this->stop)
+    {
+      if (prefixRead < sizeof(prefix))
+      {
+        prefixRead += this->ring.Read(prefix + prefixRead,
+            sizeof(prefix) - prefixRead);
+        if (prefixRead < sizeof(prefix))
+          break;
+
+        uint32_t size;
+        std::memcpy(&size, prefix, sizeof(size));
+        frame.resize(size);
+        frameRead = 0;
+      }
+
+      frameRead += this->ring.Read(&frame[0] + frameRead,
+          frame.size() - frameRead);
+      if (frameRead < frame.size())
+        break;
+
+      prefixRead = 0;
+      int64_t stamp;
+      std::memcpy(&stamp, prefix + sizeof(uint32_t), sizeof(stamp));
+      this->latency->Add((Connection::GetTimestamp() - stamp) * 1e-9);
+
+      if (!frame.empty())
+      {
+        boost::function<void (const std::string &)> cb;
+        {
+          boost::mutex::scoped_lock lock(this->mutex);
+          cb = this->callback;
+        }
+        if (cb)
+          cb(frame);
+      }
+    }
+
+    if (this->ring.IsClosed() && this->ring.Available() == 0)
+      break;
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Add the values of a histogram to a histogram message.
+/// \param[in] _histogram The histogram.
+/// \param[in,out] _msg The message, with the same bins.
+static void AddHistogram(const common::Histogram &_histogram,
+    msgs::TransportStatistics::Histogram &_msg)
+{
+  if (_histogram.Count() == 0)
+    return;
+
+  _msg.set_count(_msg.count() + _histogram.Count());
+  _msg.set_sum(_msg.sum() + _histogram.Sum());
+  _msg.set_max(std::max(_msg.max(), _histogram.Max()));
+
+  unsigned int binCount = _histogram.BinCount();
+  while (binCount > 0 && _histogram.BinValue(binCount - 1) == 0)
+    --binCount;
+  for (unsigned int i = 0; i < binCount; ++i)
+  {
+    if (static_cast<int>(i) >= _msg.bin_count_size())
+    {
+      _msg.add_upper_bound(_histogram.BinUpperBound(i));
+      _msg.add_bin_count(0);
+    }
+    _msg.set_bin_count(i, _msg.bin_count(i) + _histogram.BinValue(i));
+  }
+}
+
 /////////////////////////////////////////////////
 PublicationTransport::PublicationTransport(const std::string &_topic,
                                            const std::string &_msgType)
-: topic(_topic), msgType(_msgType)
+: topic(_topic), msgType(_msgType), shmLatency(new common::Histogram())
 {
   this->id = counter++;
   TopicManager::Instance()->UpdatePublications(this->topic, this->msgType);
@@ -37,6 +184,10 @@ PublicationTransport::PublicationTransport(const std::string &_topic,
 /////////////////////////////////////////////////
 PublicationTransport::~PublicationTransport()
 {
+  this->StopShm();
+  if (this->multicast)
+    this->multicast->Stop();
+
   if (this->connection)
   {
     msgs::Subscribe sub;
@@ -54,7 +205,8 @@ PublicationTransport::~PublicationTransport()
 }
 
 /////////////////////////////////////////////////
-void PublicationTransport::Init(const ConnectionPtr &_conn, bool _latched)
+void PublicationTransport::Init(const ConnectionPtr &_conn, bool _latched,
+    const SubscriptionQos &_qos)
 {
   this->connection = _conn;
   msgs::Subscribe sub;
@@ -63,6 +215,53 @@ void PublicationTransport::Init(const ConnectionPtr &_conn, bool _latched)
   sub.set_host(this->connection->GetLocalAddress());
   sub.set_port(this->connection->GetLocalPort());
   sub.set_latching(_latched);
+  sub.set_binary_header(true);
+  if (!_qos.IsReliable())
+  {
+    sub.set_qos_depth(_qos.Depth());
+    sub.set_qos_rate(_qos.Rate());
+  }
+
+#ifdef __linux__
+  // Offer a shared memory ring to an advertiser on this host
+  const char *shmEnv = std::getenv("GAZEBO_SHM_TRANSPORT");
+  const std::string remote = this->connection->GetRemoteAddress();
+  if ((!shmEnv || std::string(shmEnv) != "0") &&
+      (remote == this->connection->GetLocalAddress() ||
+       remote.compare(0, 4, "127.") == 0))
+  {
+    // The local port keeps names unique across PID namespaces
+    const std::string name = "/gazebo-" + std::to_string(getpid()) + "-" +
+        std::to_string(this->connection->GetLocalPort()) + "-" +
+        std::to_string(this->id);
+
+    std::shared_ptr<ShmReader> reader(new ShmReader());
+    if (reader->ring.Create(name, kShmCapacity))
+    {
+      reader->SetCallback(this->callback);
+      reader->latency = this->shmLatency;
+      this->shmReader = reader;
+      this->shmThread = std::thread([reader]() {reader->Run();});
+      sub.set_shm_name(name);
+    }
+  }
+#endif
+
+  // Receive the multicast group of the advertiser, unless the shared
+  // memory ring is used
+  const char *multicastEnv = std::getenv("GAZEBO_MULTICAST_TRANSPORT");
+  if (!sub.has_shm_name() && !this->multicastGroup.empty() &&
+      (!multicastEnv || std::string(multicastEnv) != "0"))
+  {
+    std::unique_ptr<MulticastReceiver> receiver(new MulticastReceiver());
+    receiver->SetCallback(this->callback);
+    if (receiver->Open(this->multicastGroup, this->multicastPort,
+          this->multicastId))
+    {
+      this->multicast = std::move(receiver);
+      sub.set_multicast(true);
+    }
+  }
 
   this->connection->EnqueueMsg(msgs::Package("sub", sub));
 
@@ -79,6 +278,19 @@ void PublicationTransport::AddCallback(
     const boost::function<void(const std::string &)> &cb_)
 {
   this->callback = cb_;
+  if (this->shmReader)
+    this->shmReader->SetCallback(cb_);
+  if (this->multicast)
+    this->multicast->SetCallback(cb_);
+}
+
+/////////////////////////////////////////////////
+void PublicationTransport::SetMulticast(const std::string &_group,
+    const unsigned int _port, const uint64_t _id)
+{
+  this->multicastGroup = _group;
+  this->multicastPort = _port;
+  this->multicastId = _id;
 }
 
 /////////////////////////////////////////////////
@@ -99,6 +311,40 @@ void PublicationTransport::OnPublish(const std::string &_data)
   }
 }
 
+/////////////////////////////////////////////////
+void PublicationTransport::StopShm()
+{
+  if (!this->shmReader)
+    return;
+
+  this->shmReader->stop = true;
+  this->shmReader->ring.Close();
+
+  // The thread may be the one destroying the transport
+  if (this->shmThread.get_id() == std::this_thread::get_id())
+    this->shmThread.detach();
+  else if (this->shmThread.joinable())
+    this->shmThread.join();
+  this->shmReader.reset();
+}
+
+/////////////////////////////////////////////////
+void PublicationTransport::AddLatency(
+    msgs::TransportStatistics::Histogram &_msg) const
+{
+  if (this->connection)
+    AddHistogram(this->connection->GetLatency(), _msg);
+  AddHistogram(*this->shmLatency, _msg);
+  if (this->multicast)
+    AddHistogram(this->multicast->Latency(), _msg);
+}
+
+/////////////////////////////////////////////////
+uint64_t PublicationTransport::DropCount() const
+{
+  return this->multicast ? this->multicast->Lost() : 0;
+}
+
 /////////////////////////////////////////////////
 const ConnectionPtr PublicationTransport::GetConnection() const
 {
@@ -120,6 +366,10 @@ std::string PublicationTransport::GetMsgType() const
 /////////////////////////////////////////////////
 void PublicationTransport::Fini()
 {
+  this->StopShm();
+  if (this->multicast)
+    this->multicast->Stop();
+
   /// Cancel all async operatiopns.
   if (this->connection)
   {
@@ -20,7 +20,9 @@
 
 #include <boost/function.hpp>
 #include <boost/shared_ptr.hpp>
+#include <memory>
 #include <string>
+#include <thread>
 
 #include "gazebo/transport/Connection.hh"
 #include "gazebo/common/Event.hh"
@@ -30,6 +32,12 @@ namespace gazebo
 {
   namespace transport
   {
+    // Forward declare the reader of a shared memory ring.
+    class ShmReader;
+
+    // Forward declare the receiver of a multicast group.
+    class MulticastReceiver;
+
     /// \addtogroup gazebo_transport
     /// \{
 
@@ -37,6 +45,18 @@ namespace gazebo
     /// transport/transport.hh
     /// \brief Reads data from a remote advertiser, and passes the data
     /// along to local subscribers
+    ///
+    /// If the advertiser runs on the same host, the transport offers it a
+    /// shared memory ring, read by a thread of the transport. The
+    /// advertiser falls back to the connection if it can't open the ring.
+    /// Set the GAZEBO_SHM_TRANSPORT environment variable to 0 to always
+    /// use the connection.
+    ///
+    /// Otherwise, if the advertiser sends the topic to a multicast group,
+    /// the transport receives the group and the connection only carries
+    /// the latched messages and the messages too large for a datagram.
+    /// Set the GAZEBO_MULTICAST_TRANSPORT environment variable to 0 to
+    /// always use the connection.
     class GZ_TRANSPORT_VISIBLE PublicationTransport :
         public boost::enable_shared_from_this<PublicationTransport>
     {
@@ -49,11 +69,23 @@ namespace gazebo
       /// \brief Destructor
       public: virtual ~PublicationTransport();
 
-      /// \brief Initialize the transport
+      /// \brief Initialize the transport, and create the shared memory
+      /// ring if the advertiser runs on the same host.
       /// \param[in] _conn The underlying connection.
       /// \param[in] _latched True to grab the last message sent on the
       /// topic.
-      public: void Init(const ConnectionPtr &_conn, bool _latched);
+      /// \param[in] _qos Delivery policy applied by the publisher to the
+      /// messages sent on the connection.
+      public: void Init(const ConnectionPtr &_conn, bool _latched,
+                  const SubscriptionQos &_qos = SubscriptionQos());
+
+      /// \brief Receive the messages from the multicast group of the
+      /// advertiser, if the group can be joined. Call before Init.
+      /// \param[in] _group Address of the group.
+      /// \param[in] _port Port of the datagrams.
+      /// \param[in] _id Id of the multicast sender of the advertiser.
+      public: void SetMulticast(const std::string &_group,
+                  const unsigned int _port, const uint64_t _id);
 
       /// \brief Finalize the transport
       public: void Fini();
@@ -71,6 +103,16 @@ namespace gazebo
       /// \return The topic name
       public: std::string GetTopic() const;
 
+      /// \brief Add the latency of the messages received, through the
+      /// connection or the shared memory ring, to a histogram message.
+      /// \param[in,out] _msg The histogram message.
+      public: void AddLatency(msgs::TransportStatistics::Histogram &_msg)
+                  const;
+
+      /// \brief Get the number of messages lost by the multicast group.
+      /// \return Number of messages lost.
+      public: uint64_t DropCount() const;
+
       /// \brief Get the topic type
       /// \return The topic type
       public: std::string GetMsgType() const;
@@ -79,6 +121,9 @@ namespace gazebo
       /// \param[in] _data Data to be published.
       private: void OnPublish(const std::string &_data);
 
+      /// \brief Stop reading the shared memory ring.
+      private: void StopShm();
+
       /// \brief The topic for this publication transport.
       private: std::string topic;
 
@@ -91,6 +136,30 @@ namespace gazebo
       /// \brief Callback used when OnPublish is called.
       private: boost::function<void (const std::string &)> callback;
 
+      /// \brief Reader of the shared memory ring, shared with its thread.
+      /// Null if only the connection is used.
+      private: std::shared_ptr<ShmReader> shmReader;
+
+      /// \brief Thread reading the shared memory ring.
+      private: std::thread shmThread;
+
+      /// \brief Latency of the messages read from the shared memory ring,
+      /// shared with the reader.
+      private: std::shared_ptr<common::Histogram> shmLatency;
+
+      /// \brief Multicast group offered by the advertiser, empty if none.
+      private: std::string multicastGroup;
+
+      /// \brief Port of the multicast datagrams.
+      private: unsigned int multicastPort = 0;
+
+      /// \brief Id of the multicast sender.
+      private: uint64_t multicastId = 0;
+
+      /// \brief Receiver of the multicast group, null if only the
+      /// connection is used.
+      private: std::unique_ptr<MulticastReceiver> multicast;
+
       /// \brief Counter to give the publication transport a unique id.
       private: static int counter;
 
@@ -18,9 +18,12 @@
  * Author: Nate Koenig
  */
 
+#include <vector>
+
 #include <ignition/math/Helpers.hh>
 
 #include "gazebo/common/Exception.hh"
+#include "gazebo/common/Tracer.hh"
 #include "gazebo/common/WeakBind.hh"
 #include "gazebo/transport/Node.hh"
 #include "gazebo/transport/TopicManager.hh"
@@ -35,7 +38,7 @@ uint32_t Publisher::idCounter = 0;
 Publisher::Publisher(const std::string &_topic, const std::string &_msgType,
                      unsigned int _limit, double _hzRate)
   : topic(_topic), msgType(_msgType), queueLimit(_limit),
-    updatePeriod(0)
+    updatePeriod(0), messages(_limit)
 {
   if (!ignition::math::equal(_hzRate, 0.0))
     this->updatePeriod = 1.0 / _hzRate;
@@ -85,6 +88,36 @@ bool Publisher::WaitForConnection(const common::Time &_timeout) const
 //////////////////////////////////////////////////
 void Publisher::PublishImpl(const google::protobuf::Message &_message,
                             bool _block)
+{
+  GZ_TRACE_SCOPE("transport::Publisher::Publish");
+  if (!this->AcceptMessage(_message))
+    return;
+
+  // Save the latest message
+  MessagePtr msgPtr(_message.New());
+  msgPtr->CopyFrom(_message);
+
+  this->QueueMessage(msgPtr, _block);
+}
+
+//////////////////////////////////////////////////
+void Publisher::PublishImpl(MessagePtr _message, bool _block)
+{
+  GZ_TRACE_SCOPE("transport::Publisher::Publish");
+  if (!_message)
+  {
+    gzerr << "Publishing a null message on topic[" << this->topic << "]\n";
+    return;
+  }
+
+  if (!this->AcceptMessage(*_message))
+    return;
+
+  this->QueueMessage(_message, _block);
+}
+
+//////////////////////////////////////////////////
+bool Publisher::AcceptMessage(const google::protobuf::Message &_message)
 {
   if (_message.GetTypeName() != this->msgType)
     gzthrow("Invalid message type\n");
@@ -94,7 +127,7 @@ void Publisher::PublishImpl(const google::protobuf::Message &_message,
     gzerr << "Publishing an uninitialized message on topic[" <<
       this->topic << "]. Required field [" <<
       _message.InitializationErrorString() << "] missing.\n";
-    return;
+    return false;
   }
 
   // Check if a throttling rate has been set
@@ -108,28 +141,31 @@ void Publisher::PublishImpl(const google::protobuf::Message &_message,
         (this->currentTime - this->prevPublishTime).Double() <
         this->updatePeriod)
     {
-      return;
+      return false;
     }
 
     // Set the previous time a message was published
     this->prevPublishTime = this->currentTime;
   }
 
-  // Save the latest message
-  MessagePtr msgPtr(_message.New());
-  msgPtr->CopyFrom(_message);
+  return true;
+}
 
-  this->publication->SetPrevMsg(this->id, msgPtr);
+//////////////////////////////////////////////////
+void Publisher::QueueMessage(MessagePtr _msgPtr, bool _block)
+{
+  this->publication->SetPrevMsg(this->id, _msgPtr);
 
   {
     boost::mutex::scoped_lock lock(this->mutex);
 
-    this->messages.push_back(msgPtr);
+    // The ring drops its oldest message when full
+    const bool full = this->messages.full();
+    this->messages.push_back(_msgPtr);
 
-    if (this->messages.size() > this->queueLimit)
+    if (full)
     {
-      this->messages.pop_front();
-
+      ++this->dropCount;
       if (!queueLimitWarned)
       {
         gzwarn << "Queue limit reached for topic "
@@ -141,7 +177,9 @@ void Publisher::PublishImpl(const google::protobuf::Message &_message,
     }
   }
 
-  TopicManager::Instance()->AddNodeToProcess(this->node);
+  // Queue the publisher once, when it goes from idle to pending
+  if (!this->processPending.exchange(true))
+    TopicManager::Instance()->AddPublisherToProcess(shared_from_this());
 
   if (_block)
   {
@@ -154,11 +192,26 @@ void Publisher::PublishImpl(const google::protobuf::Message &_message,
   }
 }
 
+//////////////////////////////////////////////////
+bool Publisher::ProcessPending()
+{
+  this->processPending = false;
+  this->SendMessage();
+
+  boost::mutex::scoped_lock lock(this->mutex);
+  if (this->messages.empty())
+    return false;
+
+  this->processPending = true;
+  return true;
+}
+
 //////////////////////////////////////////////////
 void Publisher::SendMessage()
 {
-  std::list<MessagePtr> localBuffer;
-  std::list<uint32_t> localIds;
+  GZ_TRACE_SCOPE("transport::Publisher::SendMessage");
+  std::vector<MessagePtr> localBuffer;
+  std::vector<uint32_t> localIds;
 
   {
     boost::mutex::scoped_lock lock(this->mutex);
@@ -167,6 +220,8 @@ void Publisher::SendMessage()
       return;
     }
 
+    localBuffer.reserve(this->messages.size());
+    localIds.reserve(this->messages.size());
     for (unsigned int i = 0; i < this->messages.size(); ++i)
     {
       this->pubId = (this->pubId + 1) % 10000;
@@ -182,10 +237,10 @@ void Publisher::SendMessage()
   // Only send messages if there is something to send
   if (!localBuffer.empty())
   {
-    std::list<uint32_t>::iterator pubIter = localIds.begin();
+    std::vector<uint32_t>::iterator pubIter = localIds.begin();
 
     // Send all the current messages
-    for (std::list<MessagePtr>::iterator iter = localBuffer.begin();
+    for (std::vector<MessagePtr>::iterator iter = localBuffer.begin();
         iter != localBuffer.end(); ++iter, ++pubIter)
     {
       // Expected number of calls to the callback function
@@ -258,6 +313,12 @@ void Publisher::SetNode(NodePtr _node)
   this->node = _node;
 }
 
+//////////////////////////////////////////////////
+uint64_t Publisher::DropCount() const
+{
+  return this->dropCount;
+}
+
 //////////////////////////////////////////////////
 unsigned int Publisher::GetOutgoingCount() const
 {
@@ -293,7 +354,13 @@ void Publisher::OnPublishComplete(uint32_t _id)
 
     std::map<uint32_t, int>::iterator iter = this->pubIds.find(_id);
     if (iter != this->pubIds.end() && (--iter->second) <= 0)
+    {
       this->pubIds.erase(iter);
+
+      // Messages queued meanwhile can now be sent
+      if (this->pubIds.empty() && !this->messages.empty())
+        ConnectionManager::Instance()->TriggerUpdate();
+    }
   }
   catch(...)
   {
@@ -334,7 +401,7 @@ std::string Publisher::GetPrevMsg() const
   {
     MessagePtr msg = this->publication->GetPrevMsg(this->id);
     if (msg)
-      msg->SerializeToString(&result);
+      result = *this->publication->Serialize(msg);
   }
 
   return result;
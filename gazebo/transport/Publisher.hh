@@ -22,11 +22,14 @@
 #define GAZEBO_TRANSPORT_PUBLISHER_HH_
 
 #include <google/protobuf/message.h>
+#include <boost/circular_buffer.hpp>
 #include <boost/thread.hpp>
 #include <boost/shared_ptr.hpp>
+#include <atomic>
 #include <string>
 #include <list>
 #include <map>
+#include <memory>
 
 #include "gazebo/common/Time.hh"
 #include "gazebo/transport/TransportTypes.hh"
@@ -98,9 +101,37 @@ namespace gazebo
       /// not be sent out immediately. Check with  GetOutgoingCount() if
       /// there are still messages in the queue which need to be sent out.
       public: template< typename M>
-              void Publish(M _message, bool _block = false)
+              void Publish(const M &_message, bool _block = false)
               { this->PublishImpl(_message, _block); }
 
+      /// \brief Publish a shared message on the topic without copying it.
+      /// Local subscribers receive the same message, and it is serialized
+      /// once for all remote subscribers, so it must not be modified after
+      /// this call. This avoids copying large messages such as images.
+      /// \param[in] _message Message to be published
+      /// \param[in] _block Whether to block until the message is actually
+      /// written into the local message buffer, and SendMessage() is called.
+      public: template< typename M>
+              void Publish(const boost::shared_ptr<M> &_message,
+                  bool _block = false)
+              { this->PublishImpl(MessagePtr(_message), _block); }
+
+      /// \brief Publish a message handed over to the publisher, without
+      /// copying it. The message is shared with the local subscribers and
+      /// kept as the previous message, and it is serialized once for all
+      /// remote subscribers.
+      /// \param[in] _message Message to be published
+      /// \param[in] _block Whether to block until the message is actually
+      /// written into the local message buffer, and SendMessage() is called.
+      public: template< typename M>
+              void Publish(std::unique_ptr<M> _message, bool _block = false)
+              { this->PublishImpl(MessagePtr(_message.release()), _block); }
+
+      /// \brief Get the number of messages dropped because the queue
+      /// limit was reached.
+      /// \return Number of messages dropped since creation.
+      public: uint64_t DropCount() const;
+
       /// \brief Get the number of outgoing messages
       /// \return The number of outgoing messages
       public: unsigned int GetOutgoingCount() const;
@@ -120,6 +151,13 @@ namespace gazebo
       /// order to ensure the whole message buffer is sent out.
       public: void SendMessage();
 
+      /// \internal
+      /// \brief Send the queued messages on behalf of the topic manager,
+      /// which calls this for publishers that queued messages.
+      /// \return True if messages are still waiting to be sent, in which
+      /// case the publisher stays pending.
+      public: bool ProcessPending();
+
       /// \brief Set our containing node.
       /// \param[in] _node Pointer to a node. Should be the node that create
       /// this publisher.
@@ -147,6 +185,23 @@ namespace gazebo
       private: void PublishImpl(const google::protobuf::Message &_message,
                                 bool _block);
 
+      /// \brief Implementation of Publish for a shared message.
+      /// \param[in] _message Message to be published.
+      /// \param[in] _block Whether to block until the message is actually
+      /// written out.
+      private: void PublishImpl(MessagePtr _message, bool _block);
+
+      /// \brief Check that a message can be published now.
+      /// \param[in] _message Message to be published.
+      /// \return False if the message is invalid or throttled.
+      private: bool AcceptMessage(const google::protobuf::Message &_message);
+
+      /// \brief Queue a message and trigger its publication.
+      /// \param[in] _msgPtr Message to be published.
+      /// \param[in] _block Whether to block until the message is actually
+      /// written out.
+      private: void QueueMessage(MessagePtr _msgPtr, bool _block);
+
       /// \brief Callback when a publish is completed
       /// \param[in] _id ID associated with the publication.
       private: void OnPublishComplete(uint32_t _id);
@@ -169,8 +224,9 @@ namespace gazebo
       /// was produced.
       private: bool queueLimitWarned;
 
-      /// \brief List of messages to publish.
-      private: std::list<MessagePtr> messages;
+      /// \brief Messages to publish, a ring of queueLimit messages which
+      /// drops the oldest one when full.
+      private: boost::circular_buffer<MessagePtr> messages;
 
       /// \brief For mutual exclusion.
       private: mutable boost::mutex mutex;
@@ -191,6 +247,12 @@ namespace gazebo
       /// \brief Current publication ids.
       private: std::map<uint32_t, int> pubIds;
 
+      /// \brief Number of messages dropped by the queue limit.
+      private: std::atomic<uint64_t> dropCount{0};
+
+      /// \brief True while this publisher is queued in the topic manager.
+      private: std::atomic<bool> processPending{false};
+
       /// \brief Unique ID for this publisher.
       private: uint32_t id;
 
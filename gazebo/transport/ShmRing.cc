@@ -0,0 +1,416 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifdef __linux__
+  #include <fcntl.h>
+  #include <semaphore.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+  #include <cerrno>
+  #include <ctime>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <new>
+
+#include "gazebo/transport/ShmRing.hh"
+
+using namespace gazebo;
+using namespace transport;
+
+#ifdef __linux__
+/// \brief Value identifying an initialized ring.
+static const uint32_t kShmRingMagic = 0x475a5352;
+
+/// \brief Header at the start of the shared memory, followed by the bytes
+/// of the ring. The positions count every byte ever written and read, so
+/// that the ring is full when they differ by the capacity.
+struct ShmRingHeader
+{
+  /// \brief kShmRingMagic once the header is initialized.
+  std::atomic<uint32_t> magic;
+
+  /// \brief Non zero once a writer opened the ring.
+  std::atomic<uint32_t> attached;
+
+  /// \brief Non zero once either side closed the ring.
+  std::atomic<uint32_t> closed;
+
+  /// \brief Non zero while the reader waits on the semaphore.
+  std::atomic<uint32_t> waiting;
+
+  /// \brief Number of bytes of the ring.
+  uint64_t capacity;
+
+  /// \brief Number of bytes written.
+  alignas(64) std::atomic<uint64_t> head;
+
+  /// \brief Number of bytes read.
+  alignas(64) std::atomic<uint64_t> tail;
+
+  /// \brief Posted by the writer to wake up a waiting reader.
+  sem_t ready;
+};
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2,
+    "The shared memory ring needs lock free 64 bit atomics");
+
+/// \brief Offset of the bytes of the ring in the shared memory.
+static const size_t kShmRingOffset =
+    (sizeof(ShmRingHeader) + 63) & ~static_cast<size_t>(63);
+#endif
+
+namespace gazebo
+{
+  namespace transport
+  {
+    /// \internal
+    /// \brief Private data for the ShmRing class.
+    class ShmRingPrivate
+    {
+      /// \brief Name of the shared memory.
+      public: std::string name;
+
+      /// \brief True if this object created the ring.
+      public: bool owner = false;
+
+      /// \brief True once the name was removed.
+      public: bool unlinked = false;
+
+      /// \brief Start of the mapping, null if not mapped.
+      public: void *mapping = nullptr;
+
+      /// \brief Size of the mapping.
+      public: size_t mappingSize = 0;
+
+#ifdef __linux__
+      /// \brief Header of the ring, in the mapping.
+      public: ShmRingHeader *header = nullptr;
+#endif
+
+      /// \brief Bytes of the ring, in the mapping.
+      public: char *data = nullptr;
+
+      /// \brief Number of bytes of the ring.
+      public: size_t capacity = 0;
+    };
+  }
+}
+
+/////////////////////////////////////////////////
+ShmRing::ShmRing()
+  : dataPtr(new ShmRingPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+ShmRing::~ShmRing()
+{
+#ifdef __linux__
+  this->Close();
+  if (this->dataPtr->owner)
+    this->Unlink();
+  if (this->dataPtr->mapping)
+    munmap(this->dataPtr->mapping, this->dataPtr->mappingSize);
+#endif
+}
+
+/////////////////////////////////////////////////
+bool ShmRing::Create(const std::string &_name, const size_t _capacity)
+{
+#ifdef __linux__
+  if (this->IsValid() || _capacity == 0)
+    return false;
+
+  // Remove a ring left over by a process that died with the same id
+  int fd = shm_open(_name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+  if (fd < 0 && errno == EEXIST)
+  {
+    shm_unlink(_name.c_str());
+    fd = shm_open(_name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+  }
+  if (fd < 0)
+    return false;
+
+  // Reserve the memory now, so that running out of shared memory fails
+  // here rather than with a bus error on a later write.
+  const size_t size = kShmRingOffset + _capacity;
+  void *mapping = MAP_FAILED;
+  if (ftruncate(fd, size) == 0 && posix_fallocate(fd, 0, size) == 0)
+    mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+
+  if (mapping == MAP_FAILED)
+  {
+    shm_unlink(_name.c_str());
+    return false;
+  }
+
+  ShmRingHeader *header = new (mapping) ShmRingHeader;
+  header->attached = 0;
+  header->closed = 0;
+  header->waiting = 0;
+  header->capacity = _capacity;
+  header->head = 0;
+  header->tail = 0;
+  if (sem_init(&header->ready, 1, 0) != 0)
+  {
+    munmap(mapping, size);
+    shm_unlink(_name.c_str());
+    return false;
+  }
+  header->magic.store(kShmRingMagic, std::memory_order_release);
+
+  this->dataPtr->name = _name;
+  this->dataPtr->owner = true;
+  this->dataPtr->mapping = mapping;
+  this->dataPtr->mappingSize = size;
+  this->dataPtr->header = header;
+  this->dataPtr->data = static_cast<char *>(mapping) + kShmRingOffset;
+  this->dataPtr->capacity = _capacity;
+  return true;
+#else
+  (void)_name;
+  (void)_capacity;
+  return false;
+#endif
+}
+
+/////////////////////////////////////////////////
+bool ShmRing::Open(const std::string &_name)
+{
+#ifdef __linux__
+  if (this->IsValid())
+    return false;
+
+  const int fd = shm_open(_name.c_str(), O_RDWR, 0600);
+  if (fd < 0)
+    return false;
+
+  struct stat st;
+  void *mapping = MAP_FAILED;
+  size_t size = 0;
+  if (fstat(fd, &st) == 0 && st.st_size > static_cast<off_t>(kShmRingOffset))
+  {
+    size = st.st_size;
+    mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  }
+  close(fd);
+
+  if (mapping == MAP_FAILED)
+    return false;
+
+  ShmRingHeader *header = static_cast<ShmRingHeader *>(mapping);
+  if (header->magic.load(std::memory_order_acquire) != kShmRingMagic ||
+      header->capacity != size - kShmRingOffset || header->closed)
+  {
+    munmap(mapping, size);
+    return false;
+  }
+  header->attached = 1;
+
+  this->dataPtr->name = _name;
+  this->dataPtr->owner = false;
+  this->dataPtr->mapping = mapping;
+  this->dataPtr->mappingSize = size;
+  this->dataPtr->header = header;
+  this->dataPtr->data = static_cast<char *>(mapping) + kShmRingOffset;
+  this->dataPtr->capacity = header->capacity;
+  return true;
+#else
+  (void)_name;
+  return false;
+#endif
+}
+
+/////////////////////////////////////////////////
+bool ShmRing::IsValid() const
+{
+  return this->dataPtr->mapping != nullptr;
+}
+
+/////////////////////////////////////////////////
+std::string ShmRing::Name() const
+{
+  return this->dataPtr->name;
+}
+
+/////////////////////////////////////////////////
+size_t ShmRing::Capacity() const
+{
+  return this->dataPtr->capacity;
+}
+
+/////////////////////////////////////////////////
+size_t ShmRing::Write(const char *_data, const size_t _size)
+{
+#ifdef __linux__
+  if (!this->IsValid() || _size == 0)
+    return 0;
+
+  ShmRingHeader *header = this->dataPtr->header;
+  const size_t capacity = this->dataPtr->capacity;
+  const uint64_t head = header->head.load(std::memory_order_relaxed);
+  const uint64_t tail = header->tail.load(std::memory_order_acquire);
+  const size_t count = std::min(_size,
+      capacity - static_cast<size_t>(head - tail));
+  if (count == 0)
+    return 0;
+
+  // Copy in up to two parts, wrapping around the end of the ring
+  const size_t start = head % capacity;
+  const size_t first = std::min(count, capacity - start);
+  std::memcpy(this->dataPtr->data + start, _data, first);
+  std::memcpy(this->dataPtr->data, _data + first, count - first);
+
+  // Publish the bytes, then wake up the reader if it waits. The reader
+  // sets the flag before checking the head, so either it sees the new
+  // head or the writer sees the flag.
+  header->head.store(head + count, std::memory_order_seq_cst);
+  if (header->waiting.load(std::memory_order_seq_cst))
+    sem_post(&header->ready);
+
+  return count;
+#else
+  (void)_data;
+  (void)_size;
+  return 0;
+#endif
+}
+
+/////////////////////////////////////////////////
+size_t ShmRing::Read(char *_data, const size_t _size)
+{
+#ifdef __linux__
+  if (!this->IsValid() || _size == 0)
+    return 0;
+
+  ShmRingHeader *header = this->dataPtr->header;
+  const size_t capacity = this->dataPtr->capacity;
+  const uint64_t tail = header->tail.load(std::memory_order_relaxed);
+  const uint64_t head = header->head.load(std::memory_order_acquire);
+  const size_t count = std::min(_size, static_cast<size_t>(head - tail));
+  if (count == 0)
+    return 0;
+
+  const size_t start = tail % capacity;
+  const size_t first = std::min(count, capacity - start);
+  std::memcpy(_data, this->dataPtr->data + start, first);
+  std::memcpy(_data + first, this->dataPtr->data, count - first);
+
+  header->tail.store(tail + count, std::memory_order_release);
+  return count;
+#else
+  (void)_data;
+  (void)_size;
+  return 0;
+#endif
+}
+
+/////////////////////////////////////////////////
+size_t ShmRing::Available() const
+{
+#ifdef __linux__
+  if (!this->IsValid())
+    return 0;
+
+  const ShmRingHeader *header = this->dataPtr->header;
+  return static_cast<size_t>(header->head.load(std::memory_order_acquire) -
+      header->tail.load(std::memory_order_relaxed));
+#else
+  return 0;
+#endif
+}
+
+/////////////////////////////////////////////////
+bool ShmRing::Wait(const unsigned int _ms)
+{
+#ifdef __linux__
+  if (!this->IsValid())
+    return false;
+
+  ShmRingHeader *header = this->dataPtr->header;
+  header->waiting.store(1, std::memory_order_seq_cst);
+  if (this->Available() == 0 && !header->closed)
+  {
+    struct timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += _ms / 1000;
+    deadline.tv_nsec += (_ms % 1000) * 1000000L;
+    if (deadline.tv_nsec >= 1000000000L)
+    {
+      deadline.tv_sec += 1;
+      deadline.tv_nsec -= 1000000000L;
+    }
+    while (sem_timedwait(&header->ready, &deadline) != 0 && errno == EINTR)
+      continue;
+  }
+  header->waiting.store(0, std::memory_order_relaxed);
+
+  return this->Available() > 0 || header->closed;
+#else
+  (void)_ms;
+  return false;
+#endif
+}
+
+/////////////////////////////////////////////////
+void ShmRing::Close()
+{
+#ifdef __linux__
+  if (!this->IsValid())
+    return;
+
+  this->dataPtr->header->closed = 1;
+  sem_post(&this->dataPtr->header->ready);
+#endif
+}
+
+/////////////////////////////////////////////////
+bool ShmRing::IsClosed() const
+{
+#ifdef __linux__
+  return this->IsValid() && this->dataPtr->header->closed;
+#else
+  return false;
+#endif
+}
+
+/////////////////////////////////////////////////
+bool ShmRing::IsAttached() const
+{
+#ifdef __linux__
+  return this->IsValid() && this->dataPtr->header->attached;
+#else
+  return false;
+#endif
+}
+
+/////////////////////////////////////////////////
+void ShmRing::Unlink()
+{
+#ifdef __linux__
+  if (!this->IsValid() || this->dataPtr->unlinked)
+    return;
+
+  shm_unlink(this->dataPtr->name.c_str());
+  this->dataPtr->unlinked = true;
+#endif
+}
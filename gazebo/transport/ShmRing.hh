@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_TRANSPORT_SHMRING_HH_
+#define GAZEBO_TRANSPORT_SHMRING_HH_
+
+#include <memory>
+#include <string>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace transport
+  {
+    // Forward declare private data class.
+    class ShmRingPrivate;
+
+    /// \addtogroup gazebo_transport
+    /// \{
+
+    /// \class ShmRing ShmRing.hh transport/transport.hh
+    /// \brief Byte ring in shared memory, used to pass the messages of a
+    /// topic between two processes of the same host without a socket.
+    ///
+    /// The ring has a single writer and a single reader, which share a
+    /// write and a read position and never block each other. The reader
+    /// creates the ring and the writer opens it by name. Shared memory is
+    /// only available on Linux, elsewhere Create and Open fail and the
+    /// caller keeps using TCP.
+    class GZ_TRANSPORT_VISIBLE ShmRing
+    {
+      /// \brief Constructor.
+      public: ShmRing();
+
+      /// \brief Destructor. Closes and unmaps the ring, and removes its
+      /// name if it was created by this object.
+      public: virtual ~ShmRing();
+
+      /// \brief Create a ring, as the reader.
+      /// \param[in] _name Name of the shared memory, starting with '/'.
+      /// \param[in] _capacity Number of bytes the ring can hold.
+      /// \return True if the ring was created.
+      public: bool Create(const std::string &_name, const size_t _capacity);
+
+      /// \brief Open a ring created by another process, as the writer.
+      /// \param[in] _name Name given to Create.
+      /// \return True if the ring was opened.
+      public: bool Open(const std::string &_name);
+
+      /// \brief Check whether the ring was created or opened.
+      /// \return True if the ring can be used.
+      public: bool IsValid() const;
+
+      /// \brief Get the name of the ring.
+      /// \return Name given to Create or Open.
+      public: std::string Name() const;
+
+      /// \brief Get the capacity of the ring.
+      /// \return Number of bytes the ring can hold.
+      public: size_t Capacity() const;
+
+      /// \brief Write bytes, as many as there is room for.
+      /// \param[in] _data Bytes to write.
+      /// \param[in] _size Number of bytes to write.
+      /// \return Number of bytes written.
+      public: size_t Write(const char *_data, const size_t _size);
+
+      /// \brief Read bytes, as many as are available.
+      /// \param[out] _data Buffer receiving the bytes.
+      /// \param[in] _size Size of the buffer.
+      /// \return Number of bytes read.
+      public: size_t Read(char *_data, const size_t _size);
+
+      /// \brief Get the number of bytes ready to be read.
+      /// \return Number of bytes written and not read yet.
+      public: size_t Available() const;
+
+      /// \brief Wait until bytes are available or the ring is closed.
+      /// \param[in] _ms Maximum wait in milliseconds.
+      /// \return True if bytes are available or the ring is closed.
+      public: bool Wait(const unsigned int _ms);
+
+      /// \brief Mark the ring closed, and wake up the reader.
+      public: void Close();
+
+      /// \brief Check whether either side closed the ring.
+      /// \return True if the ring was closed.
+      public: bool IsClosed() const;
+
+      /// \brief Check whether a writer opened the ring.
+      /// \return True once Open succeeded in any process.
+      public: bool IsAttached() const;
+
+      /// \brief Remove the name of the ring, so that it is released once
+      /// both sides unmap it, even if a process dies. The ring can no
+      /// longer be opened afterwards.
+      public: void Unlink();
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<ShmRingPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <string>
+#include <thread>
+
+#ifdef __linux__
+  #include <unistd.h>
+#endif
+
+#include "gazebo/transport/ShmRing.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class ShmRingTest : public gazebo::testing::AutoLogFixture { };
+
+#ifdef __linux__
+/////////////////////////////////////////////////
+/// \brief Name of a ring unique to this test process.
+/// \param[in] _suffix Suffix of the name.
+/// \return The name.
+static std::string RingName(const std::string &_suffix)
+{
+  return "/gazebo-test-" + std::to_string(getpid()) + "-" + _suffix;
+}
+#endif
+
+/////////////////////////////////////////////////
+TEST_F(ShmRingTest, ReadWrite)
+{
+#ifdef __linux__
+  transport::ShmRing reader;
+  EXPECT_FALSE(reader.IsValid());
+  EXPECT_EQ(0u, reader.Write("a", 1));
+  ASSERT_TRUE(reader.Create(RingName("rw"), 8));
+  EXPECT_TRUE(reader.IsValid());
+  EXPECT_EQ(8u, reader.Capacity());
+  EXPECT_FALSE(reader.IsAttached());
+  EXPECT_FALSE(reader.Create(RingName("rw"), 8));
+
+  transport::ShmRing writer;
+  ASSERT_TRUE(writer.Open(RingName("rw")));
+  EXPECT_TRUE(reader.IsAttached());
+  EXPECT_EQ(8u, writer.Capacity());
+
+  // Writes stop when the ring is full
+  char buffer[16];
+  EXPECT_EQ(0u, reader.Available());
+  EXPECT_FALSE(reader.Wait(1));
+  EXPECT_EQ(6u, writer.Write("abcdef", 6));
+  EXPECT_EQ(2u, writer.Write("ghij", 4));
+  EXPECT_TRUE(reader.Wait(1));
+  EXPECT_EQ(8u, reader.Available());
+  EXPECT_EQ(5u, reader.Read(buffer, 5));
+  EXPECT_EQ("abcde", std::string(buffer, 5));
+
+  // Bytes wrap around the end of the ring
+  EXPECT_EQ(5u, writer.Write("klmnopq", 7));
+  EXPECT_EQ(8u, reader.Read(buffer, sizeof(buffer)));
+  EXPECT_EQ("fghklmno", std::string(buffer, 8));
+  EXPECT_EQ(0u, reader.Read(buffer, sizeof(buffer)));
+
+  // A waiting reader is woken up by a write
+  std::thread thread([&writer]()
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      writer.Write("r", 1);
+    });
+  EXPECT_TRUE(reader.Wait(5000));
+  thread.join();
+  EXPECT_EQ(1u, reader.Read(buffer, sizeof(buffer)));
+
+  // Closing wakes up the reader
+  EXPECT_FALSE(reader.IsClosed());
+  writer.Close();
+  EXPECT_TRUE(reader.IsClosed());
+  EXPECT_TRUE(reader.Wait(5000));
+
+  // A removed or closed ring can't be opened
+  transport::ShmRing other;
+  EXPECT_FALSE(other.Open(RingName("rw")));
+  reader.Unlink();
+  EXPECT_FALSE(other.Open(RingName("rw")));
+  EXPECT_FALSE(other.Open(RingName("missing")));
+#endif
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_TRANSPORT_SUBSCRIPTIONQOS_HH_
+#define GAZEBO_TRANSPORT_SUBSCRIPTIONQOS_HH_
+
+#include <algorithm>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace transport
+  {
+    /// \addtogroup gazebo_transport
+    /// \{
+
+    /// \class SubscriptionQos SubscriptionQos.hh transport/transport.hh
+    /// \brief Delivery policy of a subscription. The default policy is
+    /// reliable: every message is delivered. A subscription may instead
+    /// keep only the last messages waiting to be delivered, or be
+    /// delivered at a limited rate, so that a slow subscriber to a high
+    /// rate topic doesn't build up latency and memory.
+    ///
+    /// Remote publishers apply the policy before sending, so messages the
+    /// subscriber doesn't need never go over the wire.
+    class GZ_TRANSPORT_VISIBLE SubscriptionQos
+    {
+      /// \brief Constructor, for a reliable subscription.
+      public: SubscriptionQos() = default;
+
+      /// \brief Policy delivering every message.
+      /// \return The policy.
+      public: static SubscriptionQos Reliable()
+              {
+                return SubscriptionQos();
+              }
+
+      /// \brief Policy keeping only the last messages waiting to be
+      /// delivered, dropping the oldest ones.
+      /// \param[in] _depth Number of messages kept, at least 1.
+      /// \return The policy.
+      public: static SubscriptionQos KeepLast(const unsigned int _depth)
+              {
+                SubscriptionQos qos;
+                qos.SetDepth(std::max(1u, _depth));
+                return qos;
+              }
+
+      /// \brief Policy delivering only the latest message, which conflates
+      /// the messages received while the subscriber was busy.
+      /// \return The policy.
+      public: static SubscriptionQos Latest()
+              {
+                return KeepLast(1);
+              }
+
+      /// \brief Policy delivering the latest message at most at a rate.
+      /// \param[in] _rate Maximum delivery rate in Hz.
+      /// \return The policy.
+      public: static SubscriptionQos RateLimited(const double _rate)
+              {
+                SubscriptionQos qos = Latest();
+                qos.SetRate(_rate);
+                return qos;
+              }
+
+      /// \brief Set the number of messages kept while waiting to be
+      /// delivered.
+      /// \param[in] _depth Number of messages, 0 to keep all of them.
+      public: void SetDepth(const unsigned int _depth)
+              {
+                this->depth = _depth;
+              }
+
+      /// \brief Get the number of messages kept while waiting to be
+      /// delivered.
+      /// \return Number of messages, 0 if all of them are kept.
+      public: unsigned int Depth() const
+              {
+                return this->depth;
+              }
+
+      /// \brief Set the maximum delivery rate.
+      /// \param[in] _rate Rate in Hz, 0 for no limit.
+      public: void SetRate(const double _rate)
+              {
+                this->rate = std::max(0.0, _rate);
+              }
+
+      /// \brief Get the maximum delivery rate.
+      /// \return Rate in Hz, 0 if there is no limit.
+      public: double Rate() const
+              {
+                return this->rate;
+              }
+
+      /// \brief Check whether every message is delivered.
+      /// \return True if no message is dropped.
+      public: bool IsReliable() const
+              {
+                return this->depth == 0 && this->rate <= 0.0;
+              }
+
+      /// \brief Get the least restrictive of two policies, which delivers
+      /// every message needed by either of them. Used to send the messages
+      /// of several subscriptions over a single connection.
+      /// \param[in] _other The other policy.
+      /// \return The combined policy.
+      public: SubscriptionQos Merge(const SubscriptionQos &_other) const
+              {
+                SubscriptionQos qos;
+                if (this->depth > 0 && _other.depth > 0)
+                  qos.depth = std::max(this->depth, _other.depth);
+                if (this->rate > 0.0 && _other.rate > 0.0)
+                  qos.rate = std::max(this->rate, _other.rate);
+                return qos;
+              }
+
+      /// \brief Equality operator.
+      /// \param[in] _other The other policy.
+      /// \return True if the policies are equal.
+      public: bool operator==(const SubscriptionQos &_other) const
+              {
+                return this->depth == _other.depth &&
+                  this->rate == _other.rate;
+              }
+
+      /// \brief Number of messages kept, 0 to keep all of them.
+      private: unsigned int depth = 0;
+
+      /// \brief Maximum delivery rate in Hz, 0 for no limit.
+      private: double rate = 0.0;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <thread>
+
+#include "gazebo/transport/CallbackHelper.hh"
+#include "gazebo/transport/SubscriptionQos.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class SubscriptionQosTest : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+TEST_F(SubscriptionQosTest, Policies)
+{
+  transport::SubscriptionQos qos;
+  EXPECT_TRUE(qos.IsReliable());
+  EXPECT_EQ(0u, qos.Depth());
+  EXPECT_DOUBLE_EQ(0.0, qos.Rate());
+  EXPECT_EQ(qos, transport::SubscriptionQos::Reliable());
+
+  qos = transport::SubscriptionQos::KeepLast(0);
+  EXPECT_FALSE(qos.IsReliable());
+  EXPECT_EQ(1u, qos.Depth());
+  EXPECT_EQ(qos, transport::SubscriptionQos::Latest());
+
+  qos = transport::SubscriptionQos::RateLimited(10);
+  EXPECT_EQ(1u, qos.Depth());
+  EXPECT_DOUBLE_EQ(10.0, qos.Rate());
+  qos.SetRate(-1);
+  EXPECT_DOUBLE_EQ(0.0, qos.Rate());
+
+  // Merging keeps what either policy needs
+  transport::SubscriptionQos merged =
+    transport::SubscriptionQos::KeepLast(3).Merge(
+        transport::SubscriptionQos::RateLimited(10));
+  EXPECT_EQ(3u, merged.Depth());
+  EXPECT_DOUBLE_EQ(0.0, merged.Rate());
+
+  merged = transport::SubscriptionQos::RateLimited(5).Merge(
+      transport::SubscriptionQos::RateLimited(20));
+  EXPECT_DOUBLE_EQ(20.0, merged.Rate());
+
+  merged = transport::SubscriptionQos::Latest().Merge(
+      transport::SubscriptionQos::Reliable());
+  EXPECT_TRUE(merged.IsReliable());
+}
+
+/////////////////////////////////////////////////
+TEST_F(SubscriptionQosTest, Delivery)
+{
+  transport::RawCallbackHelper helper(
+      [](const std::string &) {});
+
+  // Reliable delivers everything
+  EXPECT_EQ(0u, helper.FirstDelivered(0));
+  EXPECT_EQ(0u, helper.FirstDelivered(5));
+  EXPECT_TRUE(helper.DeliveryDue());
+
+  helper.SetQos(transport::SubscriptionQos::KeepLast(2));
+  EXPECT_EQ(2u, helper.Qos().Depth());
+  EXPECT_EQ(0u, helper.FirstDelivered(1));
+  EXPECT_EQ(3u, helper.FirstDelivered(5));
+
+  helper.SetQos(transport::SubscriptionQos::Latest());
+  EXPECT_EQ(4u, helper.FirstDelivered(5));
+
+  // A rate limited callback gets the latest message once per period
+  helper.SetQos(transport::SubscriptionQos::RateLimited(10));
+  EXPECT_EQ(4u, helper.FirstDelivered(5));
+  EXPECT_EQ(5u, helper.FirstDelivered(5));
+  EXPECT_FALSE(helper.DeliveryDue());
+  std::this_thread::sleep_for(std::chrono::milliseconds(120));
+  EXPECT_TRUE(helper.DeliveryDue());
+  EXPECT_EQ(2u, helper.FirstDelivered(2));
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -16,6 +16,9 @@
 */
 #include <boost/bind/bind.hpp>
 #include <boost/function.hpp>
+#include <cstring>
+#include <list>
+#include <utility>
 #include "gazebo/transport/ConnectionManager.hh"
 #include "gazebo/transport/SubscriptionTransport.hh"
 
@@ -32,6 +35,13 @@ SubscriptionTransport::SubscriptionTransport()
 //////////////////////////////////////////////////
 SubscriptionTransport::~SubscriptionTransport()
 {
+  // Don't leave the publishers waiting for frames that won't be written
+  for (auto &frame : this->shmFrames)
+  {
+    if (frame.cb)
+      frame.cb(frame.id);
+  }
+
   ConnectionManager::Instance()->RemoveConnection(this->connection);
   this->connection.reset();
 }
@@ -43,23 +53,162 @@ void SubscriptionTransport::Init(ConnectionPtr _conn, bool _latching)
   this->latching = _latching;
 }
 
+//////////////////////////////////////////////////
+bool SubscriptionTransport::InitShm(const std::string &_name)
+{
+  std::unique_ptr<ShmRing> ring(new ShmRing());
+  if (!ring->Open(_name))
+    return false;
+
+  boost::mutex::scoped_lock lock(this->shmMutex);
+  this->shmRing = std::move(ring);
+  return true;
+}
+
+//////////////////////////////////////////////////
+void SubscriptionTransport::SetMulticast(
+    const std::shared_ptr<MulticastSender> &_sender)
+{
+  this->multicast = _sender;
+}
+
+//////////////////////////////////////////////////
+bool SubscriptionTransport::FlushShm()
+{
+  std::list<ShmFrame> done;
+  bool waiting = false;
+  {
+    boost::mutex::scoped_lock lock(this->shmMutex);
+    if (!this->shmRing)
+      return false;
+
+    // Each frame is a native uint32 size and int64 timestamp followed by
+    // the message, written in as many parts as the room in the ring allows.
+    while (!this->shmFrames.empty())
+    {
+      ShmFrame &frame = this->shmFrames.front();
+
+      // Frames are dropped once the reader left
+      if (!this->shmRing->IsClosed())
+      {
+        const uint32_t size = static_cast<uint32_t>(frame.data->size());
+        char header[sizeof(size) + sizeof(frame.stamp)];
+        std::memcpy(header, &size, sizeof(size));
+        std::memcpy(header + sizeof(size), &frame.stamp, sizeof(frame.stamp));
+        const size_t prefix = sizeof(header);
+        if (this->shmOffset < prefix)
+        {
+          this->shmOffset += this->shmRing->Write(header + this->shmOffset,
+              prefix - this->shmOffset);
+          if (this->shmOffset < prefix)
+            break;
+        }
+
+        this->shmOffset += this->shmRing->Write(
+            frame.data->data() + this->shmOffset - prefix,
+            prefix + size - this->shmOffset);
+        if (this->shmOffset < prefix + size)
+          break;
+      }
+
+      done.push_back(std::move(frame));
+      this->shmFrames.pop_front();
+      this->shmOffset = 0;
+    }
+    waiting = !this->shmFrames.empty();
+  }
+
+  // Tell the publishers outside of the lock, they may publish again
+  for (auto &frame : done)
+  {
+    if (frame.cb)
+      frame.cb(frame.id);
+  }
+
+  return waiting;
+}
+
 //////////////////////////////////////////////////
 bool SubscriptionTransport::HandleMessage(MessagePtr _newMsg)
 {
-  std::string data;
-  _newMsg->SerializeToString(&data);
+  auto data = std::make_shared<std::string>();
+  _newMsg->SerializeToString(data.get());
   using namespace boost::placeholders;
-  return this->HandleData(data, boost::bind(&dummy_callback_fn, _1), 0);
+  return this->HandleSharedData(data, boost::bind(&dummy_callback_fn, _1), 0);
 }
 
 //////////////////////////////////////////////////
 bool SubscriptionTransport::HandleData(const std::string &_newdata,
     boost::function<void(uint32_t)> _cb, uint32_t _id)
+{
+  return this->HandleSharedData(std::make_shared<std::string>(_newdata),
+      _cb, _id);
+}
+
+//////////////////////////////////////////////////
+bool SubscriptionTransport::HandleSharedData(
+    const std::shared_ptr<const std::string> &_newdata,
+    boost::function<void(uint32_t)> _cb, uint32_t _id)
 {
   bool result = false;
   if (this->connection->IsOpen())
   {
-    this->connection->EnqueueMsg(_newdata, _cb, _id);
+    // The multicast group carries the message to the subscriber, which
+    // applies its delivery policy itself. Latched messages are only for
+    // this subscriber.
+    if (this->multicast && !this->GetLatching() &&
+        this->multicast->Send(_newdata))
+    {
+      if (!_cb.empty())
+        _cb(_id);
+      return true;
+    }
+
+    // Messages above the rate of the subscriber are not sent
+    if (!this->DeliveryDue())
+    {
+      if (!_cb.empty())
+        _cb(_id);
+      return true;
+    }
+
+    bool shm = false;
+    std::list<ShmFrame> dropped;
+    {
+      boost::mutex::scoped_lock lock(this->shmMutex);
+      if (this->shmRing)
+      {
+        this->shmFrames.push_back(
+            {_newdata, _cb, _id, Connection::GetTimestamp()});
+        shm = true;
+
+        // Keep the last frames the subscriber needs. A partly written
+        // frame has to be completed.
+        const size_t depth = this->Qos().Depth();
+        const size_t partial = this->shmOffset > 0 ? 1 : 0;
+        while (depth > 0 && this->shmFrames.size() - partial > depth)
+        {
+          auto oldest = this->shmFrames.begin() + partial;
+          dropped.push_back(*oldest);
+          this->shmFrames.erase(oldest);
+        }
+      }
+    }
+
+    for (auto &frame : dropped)
+    {
+      if (!frame.cb.empty())
+        frame.cb(frame.id);
+    }
+
+    if (shm)
+    {
+      // Frames left waiting are written by the connection manager
+      if (this->FlushShm())
+        ConnectionManager::Instance()->TriggerUpdate();
+    }
+    else
+      this->connection->EnqueueMsg(_newdata, _cb, _id);
     result = true;
   }
   else
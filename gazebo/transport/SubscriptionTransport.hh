@@ -19,10 +19,15 @@
 
 #include <boost/function.hpp>
 #include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+#include <deque>
+#include <memory>
 #include <string>
 
 #include "Connection.hh"
 #include "CallbackHelper.hh"
+#include "Multicast.hh"
+#include "ShmRing.hh"
 #include "gazebo/util/system.hh"
 
 namespace gazebo
@@ -50,6 +55,28 @@ namespace gazebo
       /// don't latch
       public: void Init(ConnectionPtr _conn, bool _latching);
 
+      /// \brief Send the messages through a shared memory ring created by
+      /// a subscriber on the same host, instead of the connection. The
+      /// connection is still used to detect that the subscriber left.
+      /// \param[in] _name Name of the ring.
+      /// \return True if the ring was opened, false to keep using the
+      /// connection.
+      public: bool InitShm(const std::string &_name);
+
+      /// \brief Send the messages to the multicast group of the topic,
+      /// which the subscriber receives, instead of the connection. The
+      /// connection still carries the latched messages and the messages
+      /// too large for a datagram.
+      /// \param[in] _sender Sender of the group, null to use the
+      /// connection.
+      public: void SetMulticast(
+                  const std::shared_ptr<MulticastSender> &_sender);
+
+      /// \brief Write the messages waiting for room in the shared memory
+      /// ring.
+      /// \return True if messages are still waiting.
+      public: bool FlushShm();
+
       /// \brief Output a message to a connection
       /// \param[in] _newdata The message to be handled
       /// \return true if the message was handled successfully, false otherwise
@@ -59,6 +86,11 @@ namespace gazebo
       public: virtual bool HandleData(const std::string &_newdata,
                   boost::function<void(uint32_t)> _cb, uint32_t _id);
 
+      // Documentation inherited
+      public: virtual bool HandleSharedData(
+                  const std::shared_ptr<const std::string> &_newdata,
+                  boost::function<void(uint32_t)> _cb, uint32_t _id);
+
       // Documentation inherited
       public: virtual bool HandleMessage(MessagePtr _newMsg);
 
@@ -71,7 +103,43 @@ namespace gazebo
       /// is tied to a  remote connection
       public: virtual bool IsLocal() const;
 
+      /// \brief A message waiting to be written to the shared memory
+      /// ring.
+      private: struct ShmFrame
+               {
+                 /// \brief Serialized message.
+                 std::shared_ptr<const std::string> data;
+
+                 /// \brief Callback invoked once the message is written.
+                 boost::function<void(uint32_t)> cb;
+
+                 /// \brief ID associated with the message.
+                 uint32_t id;
+
+                 /// \brief Time the message was queued, see
+                 /// Connection::GetTimestamp.
+                 int64_t stamp;
+               };
+
       private: ConnectionPtr connection;
+
+      /// \brief Multicast sender of the topic, null if the subscriber
+      /// doesn't receive the group.
+      private: std::shared_ptr<MulticastSender> multicast;
+
+      /// \brief Shared memory ring, null if the connection is used.
+      private: std::unique_ptr<ShmRing> shmRing;
+
+      /// \brief Messages waiting for room in the ring, the first one
+      /// possibly partly written.
+      private: std::deque<ShmFrame> shmFrames;
+
+      /// \brief Number of bytes of the first frame already written,
+      /// including its size prefix.
+      private: size_t shmOffset = 0;
+
+      /// \brief Protects the ring and the waiting frames.
+      private: boost::mutex shmMutex;
     };
     /// \}
   }
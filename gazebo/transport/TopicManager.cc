@@ -149,18 +149,66 @@ void TopicManager::AddNodeToProcess(NodePtr _ptr)
   }
 }
 
+//////////////////////////////////////////////////
+void TopicManager::FillStats(msgs::TransportStatistics &_msg)
+{
+  std::vector<PublicationPtr> pubs;
+  {
+    boost::recursive_mutex::scoped_lock lock(this->nodeMutex);
+    for (const auto &topic : this->advertisedTopics)
+      pubs.push_back(topic.second);
+  }
+
+  for (const auto &pub : pubs)
+    pub->FillStats(*_msg.add_topic());
+}
+
+//////////////////////////////////////////////////
+void TopicManager::AddPublisherToProcess(PublisherPtr _pub)
+{
+  if (_pub)
+    this->publishersToProcess.push(_pub);
+}
+
+//////////////////////////////////////////////////
+void TopicManager::AddIncomingNode(NodePtr _node)
+{
+  if (_node)
+    this->incomingNodes.push(_node);
+}
+
 //////////////////////////////////////////////////
 void TopicManager::ProcessNodes(bool _onlyOut)
 {
   {
     boost::mutex::scoped_lock lock(this->processNodesMutex);
-    for (boost::unordered_set<NodePtr>::iterator iter =
-        this->nodesToProcess.begin();
-        iter != this->nodesToProcess.end(); ++iter)
+    if (!this->nodesToProcess.empty())
     {
-      (*iter)->ProcessPublishers();
+      for (boost::unordered_set<NodePtr>::iterator iter =
+          this->nodesToProcess.begin();
+          iter != this->nodesToProcess.end(); ++iter)
+      {
+        (*iter)->ProcessPublishers();
+      }
+      this->nodesToProcess.clear();
+    }
+  }
+
+  // Send the messages of the publishers that queued some. Publishers that
+  // still wait for a previous message to be delivered are queued again
+  // after the batch, so that they are retried on the next update.
+  {
+    std::vector<PublisherPtr> retry;
+    boost::weak_ptr<Publisher> weakPub;
+    while (this->publishersToProcess.try_pop(weakPub))
+    {
+      PublisherPtr pub = weakPub.lock();
+      if (pub && pub->ProcessPending())
+        retry.push_back(pub);
     }
-    this->nodesToProcess.clear();
+
+    for (auto &pub : retry)
+      this->publishersToProcess.push(pub);
   }
 
   // Note: In general there are very few nodes. So, parallelization is not
@@ -184,19 +232,16 @@ void TopicManager::ProcessNodes(bool _onlyOut)
   //   /// worry. This function is called again.
   // }
 
+  // Only the nodes that received messages are processed. Nodes left in the
+  // queue when incoming processing is paused are processed once resumed.
   if (!this->pauseIncoming && !_onlyOut)
   {
+    boost::weak_ptr<Node> weakNode;
+    while (!this->pauseIncoming && this->incomingNodes.try_pop(weakNode))
     {
-      int s = 0;
-      boost::recursive_mutex::scoped_lock lock(this->nodeMutex);
-      s = this->nodes.size();
-
-      for (int i = 0; i < s; ++i)
-      {
-        this->nodes[i]->ProcessIncoming();
-        if (this->pauseIncoming)
-          break;
-      }
+      NodePtr node = weakNode.lock();
+      if (node)
+        node->ProcessIncoming();
     }
   }
 }
@@ -343,22 +388,36 @@ void TopicManager::ConnectSubToPub(const msgs::Publish &_pub)
             _pub.msg_type()));
 
       bool latched = false;
+      SubscriptionQos qos;
       boost::mutex::scoped_lock lock(this->subscriberMutex);
       SubNodeMap::iterator nodeIter = this->subscribedNodes.find(_pub.topic());
 
       // Find if any local node has a latched subscriber for the new topic
-      // publication transport.
+      // publication transport, and the delivery policy that satisfies all
+      // the local subscribers.
       if (nodeIter != this->subscribedNodes.end())
       {
         std::list<NodePtr>::iterator cbIter;
         for (cbIter = nodeIter->second.begin();
-             cbIter != nodeIter->second.end() && !latched; ++cbIter)
+             cbIter != nodeIter->second.end(); ++cbIter)
         {
-          latched = (*cbIter)->HasLatchedSubscriber(_pub.topic());
+          latched = latched || (*cbIter)->HasLatchedSubscriber(_pub.topic());
+
+          const SubscriptionQos nodeQos =
+            (*cbIter)->SubscriberQos(_pub.topic());
+          qos = cbIter == nodeIter->second.begin() ? nodeQos :
+            qos.Merge(nodeQos);
         }
       }
 
-      publink->Init(conn, latched);
+      // Receive the multicast group of the publisher, if it has one
+      if (_pub.has_multicast_group())
+      {
+        publink->SetMulticast(_pub.multicast_group(), _pub.multicast_port(),
+            _pub.multicast_id());
+      }
+
+      publink->Init(conn, latched, qos);
 
       publication->AddTransport(publink);
     }
@@ -28,6 +28,8 @@
 #include <string>
 #include <vector>
 #include <boost/unordered/unordered_set.hpp>
+#include <boost/weak_ptr.hpp>
+#include <tbb/concurrent_queue.h>
 
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/Exception.hh"
@@ -121,6 +123,7 @@ namespace gazebo
                 publication->AddPublisher(pub);
                 if (!publication->GetLocallyAdvertised())
                 {
+                  publication->InitMulticast();
                   ConnectionManager::Instance()->Advertise(_topic,
                       _msgTypeName);
                 }
@@ -240,10 +243,28 @@ namespace gazebo
       /// \param[in] _pause If true pause processing; otherwse unpause
       public: void PauseIncoming(bool _pause);
 
+      /// \brief Get the counters of the topics advertised or subscribed to
+      /// by the process.
+      /// \param[in,out] _msg Message receiving a Topic entry for each
+      /// topic.
+      public: void FillStats(msgs::TransportStatistics &_msg);
+
       /// \brief Add a node to the list of nodes that requires processing.
       /// \param[in] _ptr Node to process.
       public: void AddNodeToProcess(NodePtr _ptr);
 
+      /// \brief Queue a publisher that has messages to send. The publisher
+      /// calls this when its first message is queued, so that ProcessNodes
+      /// only visits the publishers with pending messages.
+      /// \param[in] _pub Publisher to process.
+      public: void AddPublisherToProcess(PublisherPtr _pub);
+
+      /// \brief Queue a node that has received messages. The node calls
+      /// this when its first message is received, so that ProcessNodes
+      /// only visits the nodes with pending messages.
+      /// \param[in] _node Node to process.
+      public: void AddIncomingNode(NodePtr _node);
+
       /// \brief A map of string->list of Node pointers
       typedef std::map<std::string, std::list<NodePtr> > SubNodeMap;
 
@@ -256,6 +277,15 @@ namespace gazebo
       /// \brief Nodes that require processing.
       private: boost::unordered_set<NodePtr> nodesToProcess;
 
+      /// \brief Publishers with pending messages. Filled by any thread
+      /// without locking and drained in batches by ProcessNodes.
+      private: tbb::concurrent_queue<boost::weak_ptr<Publisher>>
+               publishersToProcess;
+
+      /// \brief Nodes with pending incoming messages. Filled by any thread
+      /// without locking and drained in batches by ProcessNodes.
+      private: tbb::concurrent_queue<boost::weak_ptr<Node>> incomingNodes;
+
       private: boost::recursive_mutex nodeMutex;
 
       /// \brief Used to protect subscription connection creation.
@@ -14,6 +14,12 @@
  * limitations under the License.
  *
 */
+#ifdef _WIN32
+  #include <process.h>
+#else
+  #include <unistd.h>
+#endif
+
 #include <condition_variable>
 #include <list>
 #include <boost/algorithm/string.hpp>
@@ -358,6 +364,28 @@ bool transport::getMinimalComms()
   return g_minimalComms;
 }
 
+/////////////////////////////////////////////////
+std::vector<double> transport::getIOThreadUtilization()
+{
+  return Connection::GetIOThreadUtilization();
+}
+
+/////////////////////////////////////////////////
+void transport::getStats(msgs::TransportStatistics &_msg)
+{
+  _msg.Clear();
+  msgs::Set(_msg.mutable_wall_time(), common::Time::GetWallTime());
+#ifdef _WIN32
+  const int pid = _getpid();
+#else
+  const int pid = getpid();
+#endif
+  _msg.set_process(boost::asio::ip::host_name() + ":" + std::to_string(pid));
+
+  TopicManager::Instance()->FillStats(_msg);
+  ConnectionManager::Instance()->FillStats(_msg);
+}
+
 /////////////////////////////////////////////////
 transport::ConnectionPtr transport::connectToMaster()
 {
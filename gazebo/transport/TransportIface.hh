@@ -25,6 +25,7 @@
 #include <string>
 #include <list>
 #include <map>
+#include <vector>
 
 #include "gazebo/transport/TransportTypes.hh"
 #include "gazebo/transport/SubscribeOptions.hh"
@@ -176,6 +177,23 @@ namespace gazebo
     GZ_TRANSPORT_VISIBLE
     bool getMinimalComms();
 
+    /// \brief Get the utilization of each IO thread of the process since
+    /// the previous call. The number of threads is set by the
+    /// GAZEBO_IO_THREADS environment variable.
+    /// \return Fraction of the wall time each IO thread was busy, empty if
+    /// unavailable.
+    GZ_TRANSPORT_VISIBLE
+    std::vector<double> getIOThreadUtilization();
+
+    /// \brief Get the transport counters of the process: for each topic,
+    /// the messages, bytes, queue depth, drops, serialization time and
+    /// latency, and for each connection, the messages and bytes written
+    /// and read, queue depth, drops and write time. The counters are kept
+    /// since the process started.
+    /// \param[out] _msg Message receiving the counters.
+    GZ_TRANSPORT_VISIBLE
+    void getStats(msgs::TransportStatistics &_msg);
+
     /// \brief Create a connection to master.
     /// \return Connection to the master, NULL on error.
     GZ_TRANSPORT_VISIBLE
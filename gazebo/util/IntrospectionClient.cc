@@ -96,6 +96,14 @@ std::set<std::string> IntrospectionClient::Managers() const
 bool IntrospectionClient::NewFilter(const std::string &_managerId,
     const std::set<std::string> &_newItems, std::string &_filterId,
     std::string &_newTopic) const
+{
+  return this->NewFilter(_managerId, _newItems, 0, _filterId, _newTopic);
+}
+
+//////////////////////////////////////////////////
+bool IntrospectionClient::NewFilter(const std::string &_managerId,
+    const std::set<std::string> &_newItems, const double _rate,
+    std::string &_filterId, std::string &_newTopic) const
 {
   if (_newItems.empty())
   {
@@ -117,6 +125,15 @@ bool IntrospectionClient::NewFilter(const std::string &_managerId,
     nextParam->mutable_value()->set_string_value(itemName);
   }
 
+  // Add the rate of the updates.
+  if (_rate > 0)
+  {
+    auto nextParam = req.add_param();
+    nextParam->set_name("rate");
+    nextParam->mutable_value()->set_type(gazebo::msgs::Any::DOUBLE);
+    nextParam->mutable_value()->set_double_value(_rate);
+  }
+
   // Request the service.
   auto service = "/introspection/" + _managerId + "/filter_new";
   if (!this->dataPtr->node.Request(service, req,
@@ -77,6 +77,23 @@ namespace gazebo
                              std::string &_filterId,
                              std::string &_newTopic) const;
 
+      /// \brief Create a new filter for observing item updates at a given
+      /// rate. This function will block until the result is received.
+      /// \param[in] _managerID ID of the manager to request the operation.
+      /// \param[in] _newItems Non-empty set of items to observe.
+      /// \param[in] _rate Rate of the updates in Hz, 0 for an update on each
+      /// update of the manager. The items are only sampled at this rate.
+      /// \param[out] _filterId Unique ID of the filter. You'll need this ID
+      /// for future filter updates or for removing it.
+      /// \param[out] _newTopic After the filter creation, a client should
+      /// subscribe to this topic for receiving updates.
+      /// \return True if the filter was successfully created or false otherwise
+      public: bool NewFilter(const std::string &_managerId,
+                             const std::set<std::string> &_newItems,
+                             const double _rate,
+                             std::string &_filterId,
+                             std::string &_newTopic) const;
+
       /// \brief Create a new filter for observing item updates. This function
       /// will create a new topic for sending periodic updates of the items
       /// specified in the filter. This function will not block, the result
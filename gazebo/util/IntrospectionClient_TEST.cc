@@ -297,6 +297,33 @@ TEST_F(IntrospectionClientTest, UpdateFilter)
   EXPECT_TRUE(this->callbackExecuted);
 }
 
+/////////////////////////////////////////////////
+TEST_F(IntrospectionClientTest, FilterRate)
+{
+  // Let's create a filter updated every 1000 seconds.
+  std::set<std::string> items = {"item1", "item2"};
+  std::string filterId;
+  std::string topic;
+  EXPECT_TRUE(this->client.NewFilter(this->managerId, items, 1e-3, filterId,
+        topic));
+
+  // Subscribe to my custom topic for receiving updates.
+  this->Subscribe(topic);
+
+  // The first update is published.
+  this->manager->Update();
+  this->WaitForCallback();
+  EXPECT_TRUE(this->callbackExecuted);
+  this->callbackExecuted = false;
+
+  // The next one is not due yet.
+  this->manager->Update();
+  this->WaitForCallback();
+  EXPECT_FALSE(this->callbackExecuted);
+
+  EXPECT_TRUE(this->client.RemoveFilter(this->managerId, filterId));
+}
+
 /////////////////////////////////////////////////
 TEST_F(IntrospectionClientTest, UpdateFilterAsync)
 {
@@ -14,7 +14,10 @@
  * limitations under the License.
  *
  */
+#include <chrono>
 #include <functional>
+#include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <ignition/math/Rand.hh>
@@ -114,6 +117,7 @@ bool IntrospectionManager::Register(const std::string &_item,
   this->dataPtr->allItems[_item] = _cb;
 
   this->dataPtr->itemsUpdated = true;
+  ++this->dataPtr->version;
 
   return true;
 }
@@ -135,6 +139,7 @@ bool IntrospectionManager::Unregister(const std::string &_item)
   this->dataPtr->allItems.erase(_item);
 
   this->dataPtr->itemsUpdated = true;
+  ++this->dataPtr->version;
 
   return true;
 }
@@ -146,6 +151,7 @@ void IntrospectionManager::Clear()
   this->dataPtr->allItemsKeys.clear();
   this->dataPtr->allItems.clear();
   this->dataPtr->itemsUpdated = true;
+  ++this->dataPtr->version;
 }
 
 //////////////////////////////////////////////////
@@ -164,110 +170,145 @@ std::set<std::string> IntrospectionManager::Items() const
 //////////////////////////////////////////////////
 void IntrospectionManager::Update()
 {
-  std::map<std::string, IntrospectionFilter> filtersCopy;
-  std::map<std::string, ObservedItem> observedItemsCopy;
-  std::map<std::string, std::function <gazebo::msgs::Any ()>> usedItemsCopy;
-
   {
     std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    if (!this->dataPtr->plan ||
+        this->dataPtr->plan->version != this->dataPtr->version)
+    {
+      this->dataPtr->BuildPlan();
+    }
+  }
 
-    filtersCopy = this->dataPtr->filters;
-    observedItemsCopy = this->dataPtr->observedItems;
+  // The plan is only used by this function, the callbacks are called and
+  // the messages are prepared without the mutex locked.
+  IntrospectionPlan &plan = *this->dataPtr->plan;
+  ++plan.updates;
+  const auto now = std::chrono::steady_clock::now();
+  bool publish = false;
 
-    for (const auto &observedItem: this->dataPtr->observedItems)
-    {
-      auto &item = observedItem.first;
-      // Sanity check: Make sure that someone registered this item.
-      if (this->dataPtr->allItemsKeys.count(item) == 0)
-      {
-        continue;
-      }
+  for (auto &filter : plan.filters)
+  {
+    // Check whether the filter is due for an update.
+    filter.due = now >= filter.next;
+    if (!filter.due)
+      continue;
+    filter.next = now + filter.period;
 
-      usedItemsCopy[item] = this->dataPtr->allItems[item];
-    }
+    // Prepare the next message to be sent, reusing the previous one.
+    auto &nextMsg = filter.msg;
+    nextMsg.Clear();
 
-    for (auto& filter: filtersCopy)
+    for (auto const index : filter.items)
     {
-      for (auto const &item : filter.second.items)
+      // Items shared by several filters are sampled once per update.
+      auto &item = plan.items[index];
+      if (item.sampled != plan.updates)
       {
-        // Sanity check: Make sure that someone registered this item.
-        if (this->dataPtr->allItemsKeys.count(item) == 0)
+        item.sampled = plan.updates;
+        try
+        {
+          gazebo::msgs::Any value = item.cb();
+          item.value.Swap(&value);
+        }
+        catch(...)
         {
-          continue;
+          gzerr << "Exception caught calling user callback" << std::endl;
+          item.value.Clear();
         }
-        usedItemsCopy[item] = this->dataPtr->allItems[item];
       }
+
+      // Sanity check: Make sure that the value was updated.
+      // (e.g.: an exception was not raised).
+      if (item.value.type() == gazebo::msgs::Any::NONE)
+        continue;
+
+      auto nextParam = nextMsg.add_param();
+      nextParam->set_name(item.name);
+      nextParam->mutable_value()->CopyFrom(item.value);
     }
+
+    // Sanity check: Make sure that we have at least one item updated.
+    filter.due = nextMsg.param_size() > 0;
+    publish = publish || filter.due;
   }
 
-  for (auto &observedItem : observedItemsCopy)
+  // Publish the updates of the filters.
+  if (publish)
   {
-    auto &item = observedItem.first;
-    auto itemIter = usedItemsCopy.find(item);
-
-    // Sanity check: Make sure that we can update the item.
-    if (itemIter == usedItemsCopy.end())
-      continue;
-
-    try
-    {
-      // Update the values of the items under observation.
-      gazebo::msgs::Any value = itemIter->second();
-      auto &lastValue = observedItem.second.lastValue;
-      lastValue.CopyFrom(value);
-    }
-    catch(...)
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    for (auto const &filter : plan.filters)
     {
-      gzerr << "Exception caught calling user callback" << std::endl;
-      continue;
+      if (!filter.due)
+        continue;
+
+      auto pub = this->dataPtr->filterPubs.find(filter.topic);
+      if (pub == this->dataPtr->filterPubs.end() ||
+          !pub->second.Publish(filter.msg))
+      {
+        gzerr << "Error publishing update for topic [" << filter.topic << "]"
+          << std::endl;
+      }
     }
   }
 
-  // Prepare the next message to be sent in each filter.
-  for (auto &filter : filtersCopy)
+  this->NotifyUpdates();
+}
+
+//////////////////////////////////////////////////
+void IntrospectionManagerPrivate::BuildPlan()
+{
+  std::unique_ptr<IntrospectionPlan> newPlan(new IntrospectionPlan);
+  newPlan->version = this->version;
+
+  // Index of each item in the items of the plan.
+  std::map<std::string, size_t> indices;
+  for (auto const &filter : this->filters)
   {
-    // First of all, clear the old message.
-    auto &nextMsg = filter.second.msg;
-    nextMsg.Clear();
+    IntrospectionPlan::Filter planFilter;
+    planFilter.id = filter.first;
+    planFilter.topic = this->prefix + "filter/" + filter.first;
+    if (filter.second.rate > 0)
+    {
+      planFilter.period =
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(1.0 / filter.second.rate));
+    }
 
-    // Insert the last value of each item under observation for this filter.
     for (auto const &item : filter.second.items)
     {
       // Sanity check: Make sure that someone registered this item.
-      if (usedItemsCopy.find(item) == usedItemsCopy.end())
-        continue;
-
-      // Sanity check: Make sure that the value was updated.
-      // (e.g.: an exception was not raised).
-      auto &lastValue = observedItemsCopy[item].lastValue;
-      if (lastValue.type() == gazebo::msgs::Any::NONE)
+      auto cb = this->allItems.find(item);
+      if (cb == this->allItems.end())
         continue;
 
-      auto nextParam = nextMsg.add_param();
-      nextParam->set_name(item);
-      nextParam->mutable_value()->CopyFrom(lastValue);
+      auto index = indices.find(item);
+      if (index == indices.end())
+      {
+        index = indices.emplace(item, newPlan->items.size()).first;
+        newPlan->items.emplace_back();
+        newPlan->items.back().name = item;
+        newPlan->items.back().cb = cb->second;
+      }
+      planFilter.items.push_back(index->second);
     }
 
-    // Sanity check: Make sure that we have at least one item updated.
-    if (nextMsg.param_size() == 0)
-      continue;
-
-    // Publish the update for this filter.
-    std::string topicName = this->dataPtr->prefix + "filter/" + filter.first;
-
+    // Keep the time of the next update of the existing filters.
+    if (this->plan)
     {
-      std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
-      if (this->dataPtr->filterPubs.find(topicName) ==
-          this->dataPtr->filterPubs.end() ||
-          !this->dataPtr->filterPubs[topicName].Publish(nextMsg))
+      for (auto const &oldFilter : this->plan->filters)
       {
-        gzerr << "Error publishing update for topic [" << topicName << "]"
-          << std::endl;
+        if (oldFilter.id == planFilter.id)
+        {
+          planFilter.next = oldFilter.next;
+          break;
+        }
       }
     }
+
+    newPlan->filters.push_back(std::move(planFilter));
   }
 
-  this->NotifyUpdates();
+  this->plan = std::move(newPlan);
 }
 
 //////////////////////////////////////////////////
@@ -298,7 +339,7 @@ void IntrospectionManager::NotifyUpdates()
 
 //////////////////////////////////////////////////
 bool IntrospectionManager::NewFilterImpl(const std::set<std::string> &_newItems,
-    std::string &_filterId)
+    const double _rate, std::string &_filterId)
 {
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
 
@@ -331,6 +372,8 @@ bool IntrospectionManager::NewFilterImpl(const std::set<std::string> &_newItems,
 
   // Add the items to the new filter.
   this->dataPtr->filters[_filterId].items = _newItems;
+  this->dataPtr->filters[_filterId].rate = _rate;
+  ++this->dataPtr->version;
 
   // Register the new filter in the list of observed items.
   for (auto const &item : _newItems)
@@ -341,7 +384,7 @@ bool IntrospectionManager::NewFilterImpl(const std::set<std::string> &_newItems,
 
 //////////////////////////////////////////////////
 bool IntrospectionManager::UpdateFilterImpl(const std::string &_filterId,
-    const std::set<std::string> &_newItems)
+    const std::set<std::string> &_newItems, const double _rate)
 {
   // Sanity check: Make sure that we have at least one item to be observed.
   if (_newItems.empty())
@@ -366,6 +409,9 @@ bool IntrospectionManager::UpdateFilterImpl(const std::string &_filterId,
 
   // Update the list of items for this filter.
   this->dataPtr->filters[_filterId].items = _newItems;
+  if (_rate >= 0)
+    this->dataPtr->filters[_filterId].rate = _rate;
+  ++this->dataPtr->version;
 
   // The next block is needed for updating the 'observedItems' data structure
   // that contains references to the filters.
@@ -429,6 +475,7 @@ bool IntrospectionManager::RemoveFilterImpl(const std::string &_filterId)
 
   // Let's remove the filter.
   this->dataPtr->filters.erase(_filterId);
+  ++this->dataPtr->version;
 
   // Remove any reference to this filter inside observedItems.
   for (auto const &oldItem : oldItems)
@@ -459,11 +506,22 @@ bool IntrospectionManager::NewFilter(const gazebo::msgs::Param_V &_req,
   }
 
   std::set<std::string> requestedItems;
+  double rate = 0;
 
   // Store the new filter.
   for (auto i = 0; i < _req.param_size(); ++i)
   {
     auto param = _req.param(i);
+    if (param.name() == "rate")
+    {
+      if (!this->ValidateRate(param, rate))
+      {
+        gzwarn << "Ignoring request." << std::endl;
+        return false;
+      }
+      continue;
+    }
+
     if (!this->ValidateParameter(param, {"item"}))
     {
       gzwarn << "Invalid parameter[" << param.name() << "] "
@@ -476,7 +534,7 @@ bool IntrospectionManager::NewFilter(const gazebo::msgs::Param_V &_req,
   }
 
   std::string topicName;
-  if (!this->NewFilterImpl(requestedItems, topicName))
+  if (!this->NewFilterImpl(requestedItems, rate, topicName))
   {
     gzwarn << "Ignoring request." << std::endl;
     return false;
@@ -501,10 +559,21 @@ bool IntrospectionManager::UpdateFilter(const gazebo::msgs::Param_V &_req,
 
   std::set<std::string> newItems;
   std::string filterId;
+  double rate = -1;
 
   for (auto i = 0; i < _req.param_size(); ++i)
   {
     auto param = _req.param(i);
+    if (param.name() == "rate")
+    {
+      if (!this->ValidateRate(param, rate))
+      {
+        gzwarn << "Ignoring request." << std::endl;
+        return false;
+      }
+      continue;
+    }
+
     if (!this->ValidateParameter(param, {"item", "filter_id"}))
     {
       gzwarn << "Ignoring request." << std::endl;
@@ -545,7 +614,7 @@ bool IntrospectionManager::UpdateFilter(const gazebo::msgs::Param_V &_req,
     return false;
   }
 
-  return this->UpdateFilterImpl(filterId, newItems);
+  return this->UpdateFilterImpl(filterId, newItems, rate);
 }
 
 //////////////////////////////////////////////////
@@ -642,3 +711,21 @@ bool IntrospectionManager::ValidateParameter(const gazebo::msgs::Param &_msg,
 
   return true;
 }
+
+//////////////////////////////////////////////////
+bool IntrospectionManager::ValidateRate(const gazebo::msgs::Param &_msg,
+    double &_rate) const
+{
+  if (!_msg.has_value() ||
+      _msg.value().type() != gazebo::msgs::Any::DOUBLE ||
+      !_msg.value().has_double_value() ||
+      _msg.value().double_value() < 0)
+  {
+    gzwarn << "Expected a parameter 'rate' with a positive DOUBLE value."
+          << std::endl;
+    return false;
+  }
+
+  _rate = _msg.value().double_value();
+  return true;
+}
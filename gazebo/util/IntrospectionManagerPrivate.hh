@@ -17,11 +17,14 @@
 #ifndef GAZEBO_UTIL_INTROSPECTION_MANAGER_PRIVATE_HH_
 #define GAZEBO_UTIL_INTROSPECTION_MANAGER_PRIVATE_HH_
 
+#include <chrono>
 #include <functional>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <set>
 #include <string>
+#include <vector>
 #include <ignition/transport.hh>
 #include "gazebo/msgs/any.pb.h"
 #include "gazebo/msgs/param_v.pb.h"
@@ -37,21 +40,81 @@ namespace gazebo
       /// \brief Items observed by this filter.
       std::set<std::string> items;
 
-      /// \brief Message containing the next update. A message is a collection
-      /// of items and values.
-      msgs::Param_V msg;
+      /// \brief Rate of the updates in Hz, 0 for an update on each call to
+      /// IntrospectionManager::Update.
+      double rate = 0;
     };
 
-    /// \brief Todo.
+    /// \brief Item observed by at least one filter.
     struct ObservedItem
     {
-      /// \brief ToDo.
-      gazebo::msgs::Any lastValue;
-
-      /// \brief ToDo.
+      /// \brief IDs of the filters that contain the item.
       std::set<std::string> filters;
     };
 
+    /// \brief Update of the filters compiled from the registered items and
+    /// the filters, so that an update does not look up or copy them. It is
+    /// only used by IntrospectionManager::Update, without the mutex locked,
+    /// and is built again when the items or the filters change.
+    struct IntrospectionPlan
+    {
+      /// \brief An item observed by at least one filter.
+      struct Item
+      {
+        /// \brief Name of the item.
+        std::string name;
+
+        /// \brief Callback used to get the value of the item.
+        std::function<gazebo::msgs::Any ()> cb;
+
+        /// \brief Last value of the item, of type NONE until the callback
+        /// succeeds.
+        gazebo::msgs::Any value;
+
+        /// \brief Number of the last update that sampled the item.
+        uint64_t sampled = 0;
+      };
+
+      /// \brief A filter.
+      struct Filter
+      {
+        /// \brief Topic where the filter publishes updates.
+        std::string topic;
+
+        /// \brief ID of the filter.
+        std::string id;
+
+        /// \brief Indices of the items of the filter in the items of the
+        /// plan. Items that are not registered are not included.
+        std::vector<size_t> items;
+
+        /// \brief Period of the updates, zero for an update on each call.
+        std::chrono::steady_clock::duration period =
+            std::chrono::steady_clock::duration::zero();
+
+        /// \brief Time of the next update.
+        std::chrono::steady_clock::time_point next;
+
+        /// \brief Message of the next update, reused by each update.
+        msgs::Param_V msg;
+
+        /// \brief True if the filter publishes in the current update.
+        bool due = false;
+      };
+
+      /// \brief Version of the items and filters the plan was built from.
+      uint64_t version = 0;
+
+      /// \brief Number of updates run with the plan.
+      uint64_t updates = 0;
+
+      /// \brief Items observed by at least one filter.
+      std::vector<Item> items;
+
+      /// \brief The filters.
+      std::vector<Filter> filters;
+    };
+
     /// \brief Private data for the IntrospectionManager class.
     class IntrospectionManagerPrivate
     {
@@ -92,6 +155,17 @@ namespace gazebo
       /// E.g."/introspection/abcxyz/".
       public: std::string prefix;
 
+      /// \brief Build the update plan from the registered items and the
+      /// filters. The mutex must be locked.
+      public: void BuildPlan();
+
+      /// \brief Version of the registered items and of the filters,
+      /// incremented when they change.
+      public: uint64_t version = 1;
+
+      /// \brief Update plan, built by IntrospectionManager::Update.
+      public: std::unique_ptr<IntrospectionPlan> plan;
+
       /// \brief Flag that will be true when the list of registered items has
       /// changed since the last update.
       public: bool itemsUpdated = false;
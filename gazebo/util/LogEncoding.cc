@@ -0,0 +1,231 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cstring>
+
+#include <boost/iostreams/filter/bzip2.hpp>
+#include <boost/iostreams/filter/zlib.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+#include <boost/iostreams/copy.hpp>
+
+#include "gazebo/gazebo_config.h"
+
+#ifdef HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+#ifdef HAVE_LZ4
+#include <lz4frame.h>
+#endif
+
+#include "gazebo/common/Base64.hh"
+#include "gazebo/common/Console.hh"
+#include "gazebo/util/LogEncoding.hh"
+
+using namespace gazebo;
+using namespace util;
+
+//////////////////////////////////////////////////
+std::vector<std::string> util::LogEncodings()
+{
+  std::vector<std::string> encodings = {"txt", "zlib", "bz2"};
+#ifdef HAVE_ZSTD
+  encodings.push_back("zstd");
+#endif
+#ifdef HAVE_LZ4
+  encodings.push_back("lz4");
+#endif
+  return encodings;
+}
+
+//////////////////////////////////////////////////
+bool util::IsLogEncodingSupported(const std::string &_encoding)
+{
+  for (auto const &encoding : LogEncodings())
+  {
+    if (encoding == _encoding)
+      return true;
+  }
+  return false;
+}
+
+//////////////////////////////////////////////////
+bool util::EncodeLogChunk(const std::string &_encoding,
+    const std::string &_data, std::string &_result)
+{
+  if (_encoding == "txt")
+  {
+    _result.append(_data);
+    return true;
+  }
+
+  std::string str;
+
+  if (_encoding == "zlib" || _encoding == "bz2")
+  {
+    boost::iostreams::filtering_ostream out;
+    if (_encoding == "zlib")
+      out.push(boost::iostreams::zlib_compressor());
+    else
+      out.push(boost::iostreams::bzip2_compressor());
+    out.push(std::back_inserter(str));
+    boost::iostreams::copy(boost::make_iterator_range(_data), out);
+  }
+#ifdef HAVE_ZSTD
+  else if (_encoding == "zstd")
+  {
+    str.resize(ZSTD_compressBound(_data.size()));
+    const size_t size = ZSTD_compress(&str[0], str.size(), _data.data(),
+        _data.size(), ZSTD_CLEVEL_DEFAULT);
+    if (ZSTD_isError(size))
+    {
+      gzerr << "Unable to compress log data with zstd: "
+            << ZSTD_getErrorName(size) << std::endl;
+      return false;
+    }
+    str.resize(size);
+  }
+#endif
+#ifdef HAVE_LZ4
+  else if (_encoding == "lz4")
+  {
+    LZ4F_preferences_t prefs;
+    std::memset(&prefs, 0, sizeof(prefs));
+    prefs.frameInfo.contentSize = _data.size();
+
+    str.resize(LZ4F_compressFrameBound(_data.size(), &prefs));
+    const size_t size = LZ4F_compressFrame(&str[0], str.size(),
+        _data.data(), _data.size(), &prefs);
+    if (LZ4F_isError(size))
+    {
+      gzerr << "Unable to compress log data with lz4: "
+            << LZ4F_getErrorName(size) << std::endl;
+      return false;
+    }
+    str.resize(size);
+  }
+#endif
+  else
+  {
+    gzerr << "Unknown log file encoding[" << _encoding << "]\n";
+    return false;
+  }
+
+  // Encode in base64.
+  Base64Encode(str.c_str(), str.size(), _result);
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool util::DecodeLogChunk(const std::string &_encoding,
+    const std::string &_text, std::string &_data)
+{
+  if (_encoding == "txt")
+  {
+    _data = _text;
+    return true;
+  }
+
+  if (!IsLogEncodingSupported(_encoding))
+    return false;
+
+  // Decode the base64 string
+  const std::string buffer = Base64Decode(_text);
+
+  if (_encoding == "zlib" || _encoding == "bz2")
+  {
+    boost::iostreams::filtering_istream in;
+    if (_encoding == "zlib")
+      in.push(boost::iostreams::zlib_decompressor());
+    else
+      in.push(boost::iostreams::bzip2_decompressor());
+    in.push(boost::make_iterator_range(buffer));
+
+    // Get the data
+    std::getline(in, _data, '\0');
+  }
+#ifdef HAVE_ZSTD
+  else if (_encoding == "zstd")
+  {
+    const auto size = ZSTD_getFrameContentSize(buffer.data(), buffer.size());
+    if (size == ZSTD_CONTENTSIZE_ERROR || size == ZSTD_CONTENTSIZE_UNKNOWN)
+    {
+      gzerr << "Invalid zstd data in log chunk" << std::endl;
+      return false;
+    }
+
+    _data.resize(size);
+    const size_t result = ZSTD_decompress(&_data[0], _data.size(),
+        buffer.data(), buffer.size());
+    if (ZSTD_isError(result))
+    {
+      gzerr << "Unable to decompress log data with zstd: "
+            << ZSTD_getErrorName(result) << std::endl;
+      return false;
+    }
+    _data.resize(result);
+  }
+#endif
+#ifdef HAVE_LZ4
+  else if (_encoding == "lz4")
+  {
+    LZ4F_dctx *context = nullptr;
+    if (LZ4F_isError(
+          LZ4F_createDecompressionContext(&context, LZ4F_VERSION)))
+    {
+      gzerr << "Unable to create an lz4 decompression context" << std::endl;
+      return false;
+    }
+
+    _data.clear();
+    std::vector<char> block(1 << 16);
+    const char *src = buffer.data();
+    size_t srcLeft = buffer.size();
+    size_t result = 1;
+    while (result != 0)
+    {
+      size_t dstSize = block.size();
+      size_t srcSize = srcLeft;
+      result = LZ4F_decompress(context, block.data(), &dstSize, src,
+          &srcSize, nullptr);
+      if (LZ4F_isError(result))
+      {
+        gzerr << "Unable to decompress log data with lz4: "
+              << LZ4F_getErrorName(result) << std::endl;
+        break;
+      }
+
+      _data.append(block.data(), dstSize);
+      src += srcSize;
+      srcLeft -= srcSize;
+
+      if (srcSize == 0 && dstSize == 0)
+      {
+        gzerr << "Truncated lz4 data in log chunk" << std::endl;
+        break;
+      }
+    }
+    LZ4F_freeDecompressionContext(context);
+
+    if (result != 0)
+      return false;
+  }
+#endif
+
+  _data += '\0';
+  return true;
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_UTIL_LOGENCODING_HH_
+#define GAZEBO_UTIL_LOGENCODING_HH_
+
+#include <string>
+#include <vector>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace util
+  {
+    /// \addtogroup gazebo_util
+    /// \{
+
+    /// \brief Get the chunk encodings of log files supported by this build.
+    /// "txt" is plain text. The other encodings are compressed data with
+    /// Base64 encoding: "zlib" and "bz2" are always available, "zstd" and
+    /// "lz4" when Gazebo was built with the libraries.
+    /// \return The supported encodings.
+    GZ_UTIL_VISIBLE
+    std::vector<std::string> LogEncodings();
+
+    /// \brief Check whether a chunk encoding is supported.
+    /// \param[in] _encoding The encoding.
+    /// \return True if the encoding is one of LogEncodings().
+    GZ_UTIL_VISIBLE
+    bool IsLogEncodingSupported(const std::string &_encoding);
+
+    /// \brief Encode the data of a log chunk.
+    /// \param[in] _encoding The encoding.
+    /// \param[in] _data Data to encode.
+    /// \param[out] _result The encoded data is appended to this string.
+    /// \return False if the encoding is not supported or failed.
+    GZ_UTIL_VISIBLE
+    bool EncodeLogChunk(const std::string &_encoding,
+        const std::string &_data, std::string &_result);
+
+    /// \brief Decode the data of a log chunk. Compressed data is followed
+    /// by a null character, as it has always been.
+    /// \param[in] _encoding The encoding.
+    /// \param[in] _text The encoded data.
+    /// \param[out] _data The decoded data.
+    /// \return False if the encoding is not supported or failed.
+    GZ_UTIL_VISIBLE
+    bool DecodeLogChunk(const std::string &_encoding,
+        const std::string &_text, std::string &_data);
+    /// \}
+  }
+}
+#endif
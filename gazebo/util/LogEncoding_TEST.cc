@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <string>
+
+#include "gazebo/util/LogEncoding.hh"
+#include "test/util.hh"
+
+class LogEncoding_TEST : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+/// \brief Encode and decode data with every supported encoding
+TEST_F(LogEncoding_TEST, EncodeDecode)
+{
+  std::string data = "<sdf version='1.6'><state world_name='default'>"
+    "<sim_time>1 500</sim_time></state></sdf>\n";
+  for (unsigned int i = 0; i < 6; ++i)
+    data += data;
+
+  EXPECT_TRUE(gazebo::util::IsLogEncodingSupported("txt"));
+  EXPECT_TRUE(gazebo::util::IsLogEncodingSupported("zlib"));
+  EXPECT_TRUE(gazebo::util::IsLogEncodingSupported("bz2"));
+  EXPECT_FALSE(gazebo::util::IsLogEncodingSupported("foo"));
+
+  for (auto const &encoding : gazebo::util::LogEncodings())
+  {
+    std::string text = "prefix";
+    EXPECT_TRUE(gazebo::util::EncodeLogChunk(encoding, data, text))
+      << encoding;
+    EXPECT_EQ(0u, text.find("prefix")) << encoding;
+
+    std::string decoded;
+    EXPECT_TRUE(gazebo::util::DecodeLogChunk(encoding, text.substr(6),
+          decoded)) << encoding;
+
+    // Compressed data is followed by a null character
+    if (encoding != "txt")
+    {
+      EXPECT_LT(text.size(), data.size()) << encoding;
+      ASSERT_FALSE(decoded.empty()) << encoding;
+      EXPECT_EQ('\0', decoded.back()) << encoding;
+      decoded.pop_back();
+    }
+    EXPECT_EQ(data, decoded) << encoding;
+  }
+
+  std::string text;
+  EXPECT_FALSE(gazebo::util::EncodeLogChunk("foo", data, text));
+  EXPECT_FALSE(gazebo::util::DecodeLogChunk("foo", text, data));
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
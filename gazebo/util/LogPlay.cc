@@ -23,12 +23,9 @@
 #endif
 
 #include <algorithm>
+#include <sstream>
 #include <boost/filesystem.hpp>
 #include <boost/lexical_cast.hpp>
-#include <boost/iostreams/filter/bzip2.hpp>
-#include <boost/iostreams/filter/zlib.hpp>
-#include <boost/iostreams/filtering_stream.hpp>
-#include <boost/iostreams/copy.hpp>
 #include <boost/archive/iterators/base64_from_binary.hpp>
 #include <boost/archive/iterators/binary_from_base64.hpp>
 #include <boost/archive/iterators/remove_whitespace.hpp>
@@ -37,9 +34,11 @@
 
 #include <ignition/math/Rand.hh>
 
+#include "gazebo/common/Base64.hh"
 #include "gazebo/common/Exception.hh"
 #include "gazebo/common/Console.hh"
-#include "gazebo/common/Base64.hh"
+#include "gazebo/common/ThreadConfig.hh"
+#include "gazebo/util/LogEncoding.hh"
 #include "gazebo/util/LogRecord.hh"
 
 #include "gazebo/util/LogPlayPrivate.hh"
@@ -58,11 +57,15 @@ LogPlay::LogPlay()
 /////////////////////////////////////////////////
 LogPlay::~LogPlay()
 {
+  this->dataPtr->StopPrefetch();
 }
 
 /////////////////////////////////////////////////
 void LogPlay::Open(const std::string &_logFile)
 {
+  // The prefetch thread reads the XML document of the previous log.
+  this->dataPtr->StopPrefetch();
+
   this->dataPtr->currentChunk.clear();
 
   boost::filesystem::path path(_logFile);
@@ -147,6 +150,10 @@ void LogPlay::Open(const std::string &_logFile)
   // Read in the header.
   this->ReadHeader();
 
+  // Collect the chunks and their frame index.
+  this->dataPtr->BuildIndex();
+  this->dataPtr->OpenTopics();
+
   this->dataPtr->logCurrXml = this->dataPtr->logStartXml;
   this->dataPtr->encoding.clear();
 
@@ -156,17 +163,13 @@ void LogPlay::Open(const std::string &_logFile)
   // Extract the initial "iterations" value from the log.
   this->dataPtr->iterationsFound = this->ReadIterations();
 
-  this->dataPtr->logCurrXml =
-    this->dataPtr->logStartXml->FirstChildElement("chunk");
-
-  if (!this->dataPtr->logCurrXml)
+  if (this->dataPtr->chunks.empty())
     gzthrow("Unable to find the first chunk");
 
-  if (!this->dataPtr->ChunkData(this->dataPtr->logCurrXml,
-                                this->dataPtr->currentChunk))
-  {
+  this->dataPtr->StartPrefetch();
+
+  if (!this->dataPtr->LoadChunk(0, this->dataPtr->currentChunk))
     gzthrow("Unable to decode log file");
-  }
 
   this->dataPtr->start = 0;
   this->dataPtr->end = -1 * this->dataPtr->kEndFrame.size();
@@ -258,6 +261,14 @@ void LogPlay::ReadHeader()
 /////////////////////////////////////////////////
 void LogPlay::ReadLogTimes()
 {
+  // The frame index has the first and last simulation times.
+  if (this->dataPtr->indexed && !this->dataPtr->frames.empty())
+  {
+    this->dataPtr->logStartTime = this->dataPtr->frames.front().time;
+    this->dataPtr->logEndTime = this->dataPtr->frames.back().time;
+    return;
+  }
+
   std::string chunk;
   bool found = false;
 
@@ -489,6 +500,63 @@ bool LogPlay::Step(const int _step, std::string &_data)
   return res;
 }
 
+/////////////////////////////////////////////////
+unsigned int LogPlay::FastForward(const unsigned int _steps,
+    const common::Time &_time, std::string &_data,
+    std::vector<std::string> &_skipped)
+{
+  _skipped.clear();
+
+  const std::string &kStartTime = this->dataPtr->kStartTime;
+  const std::string &kEndTime = this->dataPtr->kEndTime;
+  unsigned int steps = 0;
+  bool stopped = false;
+  bool skipped = false;
+  std::string frame;
+  while (!stopped && this->Step(frame))
+  {
+    ++steps;
+    skipped = false;
+    if (_steps > 0 && steps >= _steps)
+      break;
+
+    // Only the simulation time of the frame is read.
+    const size_t from = frame.find(kStartTime);
+    const size_t to = frame.find(kEndTime, from);
+    if (from != std::string::npos && to != std::string::npos)
+    {
+      common::Time time;
+      std::istringstream ss(frame.substr(from + kStartTime.size(),
+            to - from - kStartTime.size()));
+      ss >> time;
+      stopped = time >= _time;
+    }
+
+    // The states of a delta frame are not in the frames after it, and
+    // insertions and deletions must be played in order.
+    if (!stopped && (IsDeltaFrame(frame) ||
+          frame.find("<insertions>") != std::string::npos ||
+          frame.find("<deletions>") != std::string::npos))
+    {
+      _skipped.push_back(std::move(frame));
+      skipped = true;
+    }
+  }
+
+  if (steps == 0)
+    return 0;
+
+  // At the end of the log the last frame is played.
+  if (skipped)
+  {
+    frame = std::move(_skipped.back());
+    _skipped.pop_back();
+  }
+
+  _data = std::move(frame);
+  return steps;
+}
+
 /////////////////////////////////////////////////
 bool LogPlay::StepBack(std::string &_data)
 {
@@ -530,26 +598,172 @@ bool LogPlay::StepBack(std::string &_data)
   return true;
 }
 
+/////////////////////////////////////////////////
+bool LogPlay::FramesSinceKeyframe(std::vector<std::string> &_frames)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  _frames.clear();
+
+  const std::string &kStartFrame = this->dataPtr->kStartFrame;
+  const std::string &kEndFrame = this->dataPtr->kEndFrame;
+  if (this->dataPtr->end >= this->dataPtr->currentChunk.size() ||
+      this->dataPtr->currentChunk.compare(this->dataPtr->start,
+        kStartFrame.size(), kStartFrame) != 0)
+  {
+    return false;
+  }
+
+  // Walk back from the current frame to its keyframe. Decoding the
+  // previous chunks changes the encoding of the current chunk.
+  const std::string encoding = this->dataPtr->encoding;
+  std::shared_ptr<const std::string> chunk;
+  const std::string *text = &this->dataPtr->currentChunk;
+  size_t index = this->dataPtr->chunkIndex;
+  size_t from = this->dataPtr->start;
+  size_t to = this->dataPtr->end;
+  bool found = true;
+  while (true)
+  {
+    _frames.push_back(text->substr(from, to + kEndFrame.size() - from));
+    if (!IsDeltaFrame(_frames.back()))
+      break;
+
+    from = from > 0 ? text->rfind(kStartFrame, from - 1) : std::string::npos;
+    while (from == std::string::npos && index > 0)
+    {
+      if (!this->dataPtr->DecodedChunk(--index, chunk))
+        break;
+      text = chunk.get();
+      from = text->rfind(kStartFrame);
+    }
+
+    to = from == std::string::npos ? from : text->find(kEndFrame, from);
+    if (to == std::string::npos)
+    {
+      gzerr << "Unable to find the keyframe of a delta frame in log file["
+        << this->dataPtr->filename << "]\n";
+      found = false;
+      break;
+    }
+  }
+  this->dataPtr->encoding = encoding;
+
+  std::reverse(_frames.begin(), _frames.end());
+  return found;
+}
+
+/////////////////////////////////////////////////
+bool LogPlay::IsDeltaFrame(const std::string &_frame)
+{
+  const std::string &marker = LogRecord::DeltaFrameMarker();
+  const size_t pos = _frame.find('>');
+  return pos != std::string::npos &&
+    _frame.compare(pos + 1, marker.size(), marker) == 0;
+}
+
+/////////////////////////////////////////////////
+bool LogPlay::FrameDigest(const std::string &_frame, uint64_t &_iterations,
+    uint64_t &_digest)
+{
+  // The marker comes before the state, near the start of the frame.
+  const std::string kMarker = "<!--digest ";
+  const size_t pos = _frame.find(kMarker);
+  if (pos == std::string::npos || pos > _frame.find("<state"))
+    return false;
+
+  std::istringstream stream(_frame.substr(pos + kMarker.size(), 40));
+  stream >> _iterations >> std::hex >> _digest;
+  return !stream.fail();
+}
+
+/////////////////////////////////////////////////
+bool LogPlay::HasTopics() const
+{
+  return !this->dataPtr->topicFrames.empty();
+}
+
+/////////////////////////////////////////////////
+bool LogPlay::TopicMessages(const common::Time &_from,
+    const common::Time &_to, std::vector<LogPlayMessage> &_msgs)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  _msgs.clear();
+  auto &frames = this->dataPtr->topicFrames;
+  if (frames.empty())
+    return false;
+
+  auto compare = [](const common::Time &_time, const LogPlayFrame &_frame)
+  {
+    return _time < _frame.time;
+  };
+  auto first = std::upper_bound(frames.begin(), frames.end(), _from, compare);
+  auto last = std::upper_bound(first, frames.end(), _to, compare);
+
+  const std::string &text = this->dataPtr->topicChunk;
+  for (auto frame = first; frame != last; ++frame)
+  {
+    // Consecutive messages are mostly in the same chunk.
+    if (text.empty() || frame->chunk != this->dataPtr->topicChunkIndex)
+    {
+      tinyxml2::XMLElement *xml = this->dataPtr->topicChunks[frame->chunk];
+      const char *encoding = xml->Attribute("encoding");
+      const char *data = xml->GetText();
+      this->dataPtr->topicChunk.clear();
+      if (!encoding || !DecodeLogChunk(encoding, data ? data : "",
+            this->dataPtr->topicChunk))
+      {
+        gzerr << "Unable to decode a chunk of the recorded topics of log "
+          << "file[" << this->dataPtr->filename << "]\n";
+        this->dataPtr->topicChunk.clear();
+        return false;
+      }
+      this->dataPtr->topicChunkIndex = frame->chunk;
+    }
+
+    // <message topic='T' type='Y'><sim_time>S N</sim_time><data>D</data>
+    const size_t end = text.find("</sdf>", frame->offset);
+    const size_t topicFrom = text.find("topic='", frame->offset);
+    const size_t typeFrom = text.find("type='", frame->offset);
+    const size_t dataFrom = text.find("<data>", frame->offset);
+    const size_t dataTo = text.find("</data>", frame->offset);
+    if (end == std::string::npos || dataTo > end || topicFrom > dataFrom ||
+        typeFrom > dataFrom || dataFrom > dataTo)
+    {
+      gzwarn << "Skipping an invalid recorded message in log file["
+        << this->dataPtr->filename << "]\n";
+      continue;
+    }
+
+    LogPlayMessage msg;
+    msg.topic = text.substr(topicFrom + 7,
+        text.find('\'', topicFrom + 7) - topicFrom - 7);
+    msg.type = text.substr(typeFrom + 6,
+        text.find('\'', typeFrom + 6) - typeFrom - 6);
+    msg.time = frame->time;
+    msg.data = Base64Decode(text.substr(dataFrom + 6, dataTo - dataFrom - 6));
+    _msgs.push_back(std::move(msg));
+  }
+
+  return true;
+}
+
 /////////////////////////////////////////////////
 bool LogPlay::Rewind()
 {
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
 
   this->dataPtr->currentChunk.clear();
-  this->dataPtr->logCurrXml =
-    this->dataPtr->logStartXml->FirstChildElement("chunk");
 
-  if (!this->dataPtr->logCurrXml)
+  if (this->dataPtr->chunks.empty())
   {
     gzerr << "Unable to jump to the beginning of the log file\n";
     return false;
   }
 
-  if (!this->dataPtr->ChunkData(this->dataPtr->logCurrXml,
-                                this->dataPtr->currentChunk))
-  {
+  if (!this->dataPtr->LoadChunk(0, this->dataPtr->currentChunk))
     return false;
-  }
 
   // Skip first <sdf> block (it doesn't have a world state).
   this->dataPtr->end = this->dataPtr->currentChunk.find(
@@ -576,16 +790,13 @@ bool LogPlay::Forward()
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
 
   // Get the last chunk.
-  this->dataPtr->logCurrXml =
-    this->dataPtr->logStartXml->LastChildElement("chunk");
-
-  if (!this->dataPtr->logCurrXml)
+  if (this->dataPtr->chunks.empty())
   {
     gzerr << "Unable to jump to the end of the log file\n";
     return false;
   }
 
-  if (!this->dataPtr->ChunkData(this->dataPtr->logCurrXml,
+  if (!this->dataPtr->LoadChunk(this->dataPtr->chunks.size() - 1,
                                 this->dataPtr->currentChunk))
   {
     return false;
@@ -608,6 +819,50 @@ bool LogPlay::Seek(const common::Time &_time)
     return true;
   }
 
+  if (this->dataPtr->indexed && !this->dataPtr->frames.empty())
+  {
+    // Find the first frame at or after the target time, and move to the
+    // frame before it, as the binary search below does.
+    auto frame = std::lower_bound(this->dataPtr->frames.begin(),
+        this->dataPtr->frames.end(), _time,
+        [](const LogPlayFrame &_frame, const common::Time &_t)
+        {
+          return _frame.time < _t;
+        });
+
+    size_t chunkIndex = 0;
+    if (frame != this->dataPtr->frames.begin())
+    {
+      --frame;
+      chunkIndex = frame->chunk;
+    }
+
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+    if (!this->dataPtr->LoadChunk(chunkIndex, this->dataPtr->currentChunk))
+      return false;
+
+    // Without an earlier frame, stop at the first frame of the log.
+    if (frame == this->dataPtr->frames.begin() && frame->time >= _time)
+    {
+      this->dataPtr->start = this->dataPtr->currentChunk.find(
+          this->dataPtr->kStartFrame);
+    }
+    else
+      this->dataPtr->start = frame->offset;
+
+    this->dataPtr->end = this->dataPtr->currentChunk.find(
+        this->dataPtr->kEndFrame, this->dataPtr->start);
+    if (this->dataPtr->start == std::string::npos ||
+        this->dataPtr->end == std::string::npos)
+    {
+      gzerr << "Unable to find an <sdf> frame in current chunk\n";
+      return false;
+    }
+
+    return true;
+  }
+
   common::Time logTime = this->dataPtr->logStartTime;
 
   // 1st step: Locate the chunk: We're looking for the first chunk that has
@@ -690,21 +945,90 @@ bool LogPlay::Seek(const common::Time &_time)
 /////////////////////////////////////////////////
 bool LogPlay::Chunk(unsigned int _index, std::string &_data) const
 {
-  unsigned int count = 0;
-  this->dataPtr->logCurrXml =
-    this->dataPtr->logStartXml->FirstChildElement("chunk");
+  if (_index >= this->dataPtr->chunks.size())
+  {
+    this->dataPtr->logCurrXml = nullptr;
+    return false;
+  }
+
+  return this->dataPtr->LoadChunk(_index, _data);
+}
 
-  while (this->dataPtr->logCurrXml && count < _index)
+/////////////////////////////////////////////////
+void LogPlayPrivate::BuildIndex()
+{
+  this->indexed = ReadIndex(this->logStartXml, this->chunks, this->frames);
+}
+
+/////////////////////////////////////////////////
+bool LogPlayPrivate::ReadIndex(tinyxml2::XMLElement *_log,
+    std::vector<tinyxml2::XMLElement *> &_chunks,
+    std::vector<LogPlayFrame> &_frames)
+{
+  _chunks.clear();
+  _frames.clear();
+  bool indexed = true;
+
+  for (auto xml = _log->FirstChildElement("chunk"); xml;
+       xml = xml->NextSiblingElement("chunk"))
   {
-    count++;
-    this->dataPtr->logCurrXml =
-      this->dataPtr->logCurrXml->NextSiblingElement("chunk");
+    const char *index = xml->Attribute("frames");
+    if (!index)
+      indexed = false;
+    else if (indexed)
+    {
+      // Each frame has its offset, the simulation time in seconds and
+      // nanoseconds, and the iterations.
+      std::istringstream stream(index);
+      LogPlayFrame frame;
+      frame.chunk = _chunks.size();
+      uint64_t iterations;
+      while (stream >> frame.offset >> frame.time.sec >> frame.time.nsec
+             >> iterations)
+      {
+        _frames.push_back(frame);
+      }
+    }
+
+    _chunks.push_back(xml);
   }
 
-  if (this->dataPtr->logCurrXml && count == _index)
-    return this->dataPtr->ChunkData(this->dataPtr->logCurrXml, _data);
-  else
-    return false;
+  if (!indexed)
+    _frames.clear();
+
+  return indexed;
+}
+
+/////////////////////////////////////////////////
+void LogPlayPrivate::OpenTopics()
+{
+  this->topicDoc.Clear();
+  this->topicChunks.clear();
+  this->topicFrames.clear();
+  this->topicChunk.clear();
+
+  const boost::filesystem::path path =
+    boost::filesystem::path(this->filename).parent_path() /
+    LogRecord::TopicLogFilename();
+  if (!boost::filesystem::exists(path) ||
+      boost::filesystem::equivalent(path, this->filename))
+  {
+    return;
+  }
+
+  tinyxml2::XMLElement *log = nullptr;
+  if (this->topicDoc.LoadFile(path.string().c_str()) == tinyxml2::XML_SUCCESS)
+    log = this->topicDoc.FirstChildElement("gazebo_log");
+
+  // The messages are found with the frame index, written since topics can
+  // be recorded.
+  if (!log || !ReadIndex(log, this->topicChunks, this->topicFrames))
+  {
+    gzwarn << "Unable to read the recorded topics in [" << path.string()
+      << "]. The topics will not be played.\n";
+    this->topicChunks.clear();
+    this->topicFrames.clear();
+  }
 }
 
 /////////////////////////////////////////////////
@@ -728,91 +1052,230 @@ bool LogPlayPrivate::ChunkData(
     gzthrow("Encoding missing for a chunk in log file[" + this->filename + "]");
   }
 
-  if (this->encoding == "txt")
-    _data = _xml->GetText();
-  else if (this->encoding == "bz2")
+  const char *text = _xml->GetText();
+  if (!DecodeLogChunk(this->encoding, text ? text : "", _data))
   {
-    std::string data = _xml->GetText();
-    std::string buffer;
+    gzerr << "Unable to decode a chunk with encoding[" << this->encoding
+      << "] in log file[" << this->filename << "]\n";
+    return false;
+  }
 
-    // Decode the base64 string
-    buffer = Base64Decode(data);
+  return true;
+}
 
-    // Decompress the bz2 data
-    {
-      boost::iostreams::filtering_istream in;
-      in.push(boost::iostreams::bzip2_decompressor());
-      in.push(boost::make_iterator_range(buffer));
+/////////////////////////////////////////////////
+std::string LogPlay::Encoding() const
+{
+  return this->dataPtr->encoding;
+}
 
-      // Get the data
-      std::getline(in, _data, '\0');
-      _data += '\0';
-    }
+/////////////////////////////////////////////////
+bool LogPlayPrivate::LoadChunk(const size_t _index, std::string &_data)
+{
+  if (_index >= this->chunks.size())
+    return false;
+
+  {
+    std::lock_guard<std::mutex> lock(this->cacheMutex);
+    if (_index != this->chunkIndex)
+      this->direction = _index > this->chunkIndex ? 1 : -1;
+    this->chunkIndex = _index;
+    this->logCurrXml = this->chunks[_index];
+    this->prefetchRequest = true;
   }
-  else if (this->encoding == "zlib")
+  this->prefetchCondition.notify_one();
+
+  std::shared_ptr<const std::string> data;
+  if (!this->DecodedChunk(_index, data))
+    return false;
+
+  const char *chunkEncoding = this->logCurrXml->Attribute("encoding");
+  this->encoding = chunkEncoding ? chunkEncoding : "";
+  _data = *data;
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool LogPlayPrivate::DecodedChunk(const size_t _index,
+    std::shared_ptr<const std::string> &_data)
+{
+  if (_index >= this->chunks.size())
+    return false;
+
   {
-    std::string data = _xml->GetText();
-    std::string buffer;
+    std::unique_lock<std::mutex> lock(this->cacheMutex);
 
-    // Decode the base64 string
-    buffer = Base64Decode(data);
+    // The prefetch thread may be decoding this chunk already.
+    this->decodedCondition.wait(lock, [this, _index]()
+        {
+          return this->decoding.find(_index) == this->decoding.end();
+        });
 
-    // Decompress the zlib data
+    auto cached = this->cache.find(_index);
+    if (cached != this->cache.end())
     {
-      boost::iostreams::filtering_istream in;
-      in.push(boost::iostreams::zlib_decompressor());
-      in.push(boost::make_iterator_range(buffer));
-
-      // Get the data
-      std::getline(in, _data, '\0');
-      _data += '\0';
+      _data = cached->second;
+      this->cacheOrder.remove(_index);
+      this->cacheOrder.push_front(_index);
+      return true;
     }
   }
-  else
-  {
-    gzerr << "Invalid encoding[" << this->encoding << "] in log file["
-      << this->filename << "]\n";
+
+  auto data = std::make_shared<std::string>();
+  if (!this->ChunkData(this->chunks[_index], *data))
     return false;
-  }
 
+  std::lock_guard<std::mutex> lock(this->cacheMutex);
+  this->CacheChunk(_index, data);
+  _data = data;
   return true;
 }
 
 /////////////////////////////////////////////////
-std::string LogPlay::Encoding() const
+void LogPlayPrivate::CacheChunk(const size_t _index,
+    std::shared_ptr<const std::string> _data)
 {
-  return this->dataPtr->encoding;
+  this->cache[_index] = _data;
+  this->cacheOrder.remove(_index);
+  this->cacheOrder.push_front(_index);
+
+  while (this->cache.size() > this->kMaxCachedChunks)
+  {
+    this->cache.erase(this->cacheOrder.back());
+    this->cacheOrder.pop_back();
+  }
 }
 
 /////////////////////////////////////////////////
-unsigned int LogPlay::ChunkCount() const
+void LogPlayPrivate::StartPrefetch()
 {
-  unsigned int count = 0;
-  auto xml = this->dataPtr->logStartXml->FirstChildElement("chunk");
+  std::lock_guard<std::mutex> lock(this->cacheMutex);
+  if (this->prefetchRunning)
+    return;
 
-  while (xml)
+  this->chunkIndex = 0;
+  this->direction = 1;
+  this->prefetchRequest = false;
+  this->prefetchRunning = true;
+  this->prefetchThread = std::thread(&LogPlayPrivate::RunPrefetch, this);
+}
+
+/////////////////////////////////////////////////
+void LogPlayPrivate::StopPrefetch()
+{
   {
-    count++;
-    xml = xml->NextSiblingElement("chunk");
+    std::lock_guard<std::mutex> lock(this->cacheMutex);
+    this->prefetchRunning = false;
   }
+  this->prefetchCondition.notify_all();
 
-  return count;
+  if (this->prefetchThread.joinable())
+    this->prefetchThread.join();
+
+  this->cache.clear();
+  this->cacheOrder.clear();
+  this->decoding.clear();
 }
 
 /////////////////////////////////////////////////
-bool LogPlay::NextChunk()
+void LogPlayPrivate::RunPrefetch()
 {
-  auto next = this->dataPtr->logCurrXml->NextSiblingElement("chunk");
-  if (!next)
-    return false;
+  common::ThreadConfig::Instance()->Apply("log_prefetch");
+  std::unique_lock<std::mutex> lock(this->cacheMutex);
+  while (true)
+  {
+    this->prefetchCondition.wait(lock, [this]()
+        {
+          return this->prefetchRequest || !this->prefetchRunning;
+        });
+    if (!this->prefetchRunning)
+      return;
+    this->prefetchRequest = false;
 
-  this->dataPtr->logCurrXml = next;
-  if (!this->dataPtr->ChunkData(this->dataPtr->logCurrXml,
-                                this->dataPtr->currentChunk))
+    // Decode the next chunks in the direction of playback, nearest first.
+    // A new request restarts from the new current chunk.
+    for (size_t i = 1; i <= this->kPrefetchChunks && this->prefetchRunning &&
+         !this->prefetchRequest; ++i)
+    {
+      if (this->direction < 0 && i > this->chunkIndex)
+        break;
+      const size_t index = this->direction > 0 ?
+        this->chunkIndex + i : this->chunkIndex - i;
+      if (index >= this->chunks.size())
+        break;
+      if (this->cache.find(index) != this->cache.end())
+        continue;
+
+      tinyxml2::XMLElement *xml = this->chunks[index];
+      this->decoding.insert(index);
+      lock.unlock();
+
+      // The XML document is not modified while the thread runs, and the
+      // decoding does not use the members of this class.
+      auto data = std::make_shared<std::string>();
+      const char *chunkEncoding = xml->Attribute("encoding");
+      const char *text = xml->GetText();
+      const bool decoded = chunkEncoding &&
+        DecodeLogChunk(chunkEncoding, text ? text : "", *data);
+
+      lock.lock();
+      this->decoding.erase(index);
+      if (decoded)
+        this->CacheChunk(index, data);
+      this->decodedCondition.notify_all();
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+bool LogPlay::Activity(const unsigned int _intervals,
+    std::vector<float> &_activity) const
+{
+  _activity.clear();
+  if (!this->dataPtr->indexed || this->dataPtr->frames.empty() ||
+      _intervals == 0)
   {
     return false;
   }
 
+  _activity.resize(_intervals, 0.0f);
+
+  const double start = this->dataPtr->logStartTime.Double();
+  const double duration = this->dataPtr->logEndTime.Double() - start;
+  for (auto const &frame : this->dataPtr->frames)
+  {
+    unsigned int interval = 0;
+    if (duration > 0)
+    {
+      interval = static_cast<unsigned int>(
+          (frame.time.Double() - start) / duration * _intervals);
+    }
+    _activity[std::min(interval, _intervals - 1)] += 1.0f;
+  }
+
+  const float busiest = *std::max_element(_activity.begin(), _activity.end());
+  for (auto &activity : _activity)
+    activity /= busiest;
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+unsigned int LogPlay::ChunkCount() const
+{
+  return static_cast<unsigned int>(this->dataPtr->chunks.size());
+}
+
+/////////////////////////////////////////////////
+bool LogPlay::NextChunk()
+{
+  const size_t next = this->dataPtr->chunkIndex + 1;
+  if (!this->dataPtr->logCurrXml || next >= this->dataPtr->chunks.size())
+    return false;
+
+  if (!this->dataPtr->LoadChunk(next, this->dataPtr->currentChunk))
+    return false;
+
   this->dataPtr->start = 0;
   this->dataPtr->end = -1 * this->dataPtr->kEndFrame.size();
 
@@ -822,12 +1285,10 @@ bool LogPlay::NextChunk()
 /////////////////////////////////////////////////
 bool LogPlay::PrevChunk()
 {
-  auto prev = this->dataPtr->logCurrXml->PreviousSiblingElement("chunk");
-  if (!prev)
+  if (!this->dataPtr->logCurrXml || this->dataPtr->chunkIndex == 0)
     return false;
 
-  this->dataPtr->logCurrXml = prev;
-  if (!this->dataPtr->ChunkData(this->dataPtr->logCurrXml,
+  if (!this->dataPtr->LoadChunk(this->dataPtr->chunkIndex - 1,
                                 this->dataPtr->currentChunk))
   {
     return false;
@@ -19,6 +19,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "gazebo/common/SingletonT.hh"
 #include "gazebo/common/Time.hh"
@@ -37,6 +38,24 @@ namespace gazebo
     /// \addtogroup gazebo_physics
     /// \{
 
+    /// \class LogPlayMessage Logplay.hh util/util.hh
+    /// \brief A message of a topic recorded with the state.
+    /// \sa LogRecord::SetTopics, LogPlay::TopicMessages
+    class GZ_UTIL_VISIBLE LogPlayMessage
+    {
+      /// \brief Name of the topic, with its namespace.
+      public: std::string topic;
+
+      /// \brief Type of the message, such as "gazebo.msgs.ImageStamped".
+      public: std::string type;
+
+      /// \brief Simulation time at which the message was recorded.
+      public: common::Time time;
+
+      /// \brief The serialized message.
+      public: std::string data;
+    };
+
     /// \class Logplay Logplay.hh util/util.hh
     /// \brief Open and playback log files that were recorded using LogRecord.
     ///
@@ -115,6 +134,67 @@ namespace gazebo
       /// \param[out] _data Data from next entry in the log file.
       public: bool Step(const int _step, std::string &_data);
 
+      /// \brief Step forward over several frames without returning each of
+      /// them, to fast-forward the playback. Stepping stops at the first
+      /// frame at or after a simulation time, or after a number of frames.
+      /// The skipped frames are not parsed, except for finding their
+      /// simulation time.
+      /// \param[in] _steps Maximum number of frames to step, 0 for no
+      /// limit.
+      /// \param[in] _time Simulation time of the frame to stop at.
+      /// \param[out] _data The last frame stepped.
+      /// \param[out] _skipped The skipped frames needed to play the last
+      /// frame correctly, oldest first: the delta frames, and the frames
+      /// that insert or delete entities.
+      /// \return Number of frames stepped, 0 at the end of the log.
+      public: unsigned int FastForward(const unsigned int _steps,
+                  const common::Time &_time, std::string &_data,
+                  std::vector<std::string> &_skipped);
+
+      /// \brief Get the frames needed to rebuild the state of the current
+      /// frame, the one returned by the last step or seek, when the log was
+      /// recorded with keyframes: the last keyframe at or before the current
+      /// frame, followed by the delta frames up to the current frame. The
+      /// playback position does not change.
+      /// \param[out] _frames The frames, oldest first. Only the current
+      /// frame if it is not a delta frame.
+      /// \return False if there is no current frame, or if its keyframe was
+      /// not found.
+      /// \sa LogRecord::KeyframePeriod
+      public: bool FramesSinceKeyframe(std::vector<std::string> &_frames);
+
+      /// \brief Check whether a frame is a delta frame, which only has the
+      /// states that changed since the frame before it.
+      /// \param[in] _frame The frame.
+      /// \return True if the frame starts with
+      /// LogRecord::DeltaFrameMarker.
+      public: static bool IsDeltaFrame(const std::string &_frame);
+
+      /// \brief Get the state digest recorded in a frame.
+      /// \param[in] _frame The frame.
+      /// \param[out] _iterations Iterations of the world when the state was
+      /// captured.
+      /// \param[out] _digest The digest.
+      /// \return False if the frame has no digest.
+      /// \sa LogRecord::DigestFrameMarker
+      public: static bool FrameDigest(const std::string &_frame,
+                  uint64_t &_iterations, uint64_t &_digest);
+
+      /// \brief Check whether topics were recorded with the open log file,
+      /// in the file named LogRecord::TopicLogFilename next to it.
+      /// \return True if the log of the recorded topics was loaded.
+      public: bool HasTopics() const;
+
+      /// \brief Get the recorded messages of a time interval. Only the
+      /// chunks of the topic log that overlap the interval are decoded.
+      /// \param[in] _from Start of the interval, excluded.
+      /// \param[in] _to End of the interval, included.
+      /// \param[out] _msgs The messages, in the order they were recorded.
+      /// \return False if there are no recorded topics, or if a chunk could
+      /// not be decoded.
+      public: bool TopicMessages(const common::Time &_from,
+                  const common::Time &_to, std::vector<LogPlayMessage> &_msgs);
+
       /// \brief Jump to the closest sample that has its simulation time lower
       /// than the time specified as a parameter.
       /// \param[in] _time Target simulation time.
@@ -130,6 +210,17 @@ namespace gazebo
       /// \return True If the function succeed or false otherwise.
       public: bool Forward();
 
+      /// \brief Get an overview of the activity in the open log file, from
+      /// its frame index: the number of frames recorded in each of a number
+      /// of equal time intervals, relative to the busiest interval. States
+      /// are only recorded when they change, so busy intervals have more
+      /// frames.
+      /// \param[in] _intervals Number of intervals.
+      /// \param[out] _activity Activity of each interval, from 0 to 1.
+      /// \return False if the log file has no frame index.
+      public: bool Activity(const unsigned int _intervals,
+                  std::vector<float> &_activity) const;
+
       /// \brief Get the number of chunks (steps) in the open log file.
       /// \return The number of recorded states in the log file.
       public: unsigned int ChunkCount() const;
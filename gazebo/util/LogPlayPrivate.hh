@@ -25,8 +25,15 @@
 #include <tinyxml2.h>
 #endif
 
+#include <condition_variable>
+#include <list>
+#include <map>
+#include <memory>
 #include <mutex>
+#include <set>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "gazebo/common/Time.hh"
 #include "gazebo/util/system.hh"
@@ -35,6 +42,20 @@ namespace gazebo
 {
   namespace util
   {
+    /// \internal
+    /// \brief Entry of the frame index of a log file.
+    class LogPlayFrame
+    {
+      /// \brief Index of the chunk that contains the frame.
+      public: size_t chunk = 0;
+
+      /// \brief Offset of the frame in the decoded chunk data.
+      public: size_t offset = 0;
+
+      /// \brief Simulation time of the frame.
+      public: common::Time time;
+    };
+
     /// \internal
     /// \brief Private data for log play
     class LogPlayPrivate
@@ -47,9 +68,65 @@ namespace gazebo
                   tinyxml2::XMLElement *_xml,
                   std::string &_data);
 
+      /// \brief Get the decoded data of a chunk, from the cache of decoded
+      /// chunks if possible, and make it the current chunk. The prefetch
+      /// thread then decodes the next chunks in the direction of playback.
+      /// \param[in] _index Index of the chunk.
+      /// \param[out] _data Storage for the chunk's data.
+      /// \return True if the chunk was successfully parsed.
+      public: bool LoadChunk(const size_t _index, std::string &_data);
+
+      /// \brief Get the decoded data of a chunk, from the cache of decoded
+      /// chunks if possible, without changing the current chunk.
+      /// \param[in] _index Index of the chunk.
+      /// \param[out] _data The decoded data.
+      /// \return True if the chunk was successfully parsed.
+      public: bool DecodedChunk(const size_t _index,
+                  std::shared_ptr<const std::string> &_data);
+
+      /// \brief Add a decoded chunk to the cache, releasing the least
+      /// recently used chunks. cacheMutex must be locked.
+      /// \param[in] _index Index of the chunk.
+      /// \param[in] _data Decoded data of the chunk.
+      public: void CacheChunk(const size_t _index,
+                  std::shared_ptr<const std::string> _data);
+
+      /// \brief Start the prefetch thread.
+      public: void StartPrefetch();
+
+      /// \brief Stop the prefetch thread, and clear the cache.
+      public: void StopPrefetch();
+
+      /// \brief Prefetch thread function.
+      public: void RunPrefetch();
+
+      /// \brief Collect the chunks of the log file, and read the frame
+      /// index written by LogRecord in the "frames" attribute of the chunks.
+      /// Logs written before the index existed are not indexed.
+      public: void BuildIndex();
+
+      /// \brief Collect the chunks of a log and their frame index.
+      /// \param[in] _log The gazebo_log element of the log.
+      /// \param[out] _chunks The chunks, in order.
+      /// \param[out] _frames The frames that have a simulation time.
+      /// \return True if every chunk has a frame index.
+      public: static bool ReadIndex(tinyxml2::XMLElement *_log,
+                  std::vector<tinyxml2::XMLElement *> &_chunks,
+                  std::vector<LogPlayFrame> &_frames);
+
+      /// \brief Load the log of the recorded topics next to the log file,
+      /// if there is one.
+      public: void OpenTopics();
+
       /// \brief Max number of chunks to inspect when looking for XML elements.
       public: const unsigned int kNumChunksToTry = 2u;
 
+      /// \brief Number of chunks decoded ahead of the current chunk.
+      public: const size_t kPrefetchChunks = 2u;
+
+      /// \brief Max number of decoded chunks kept in memory.
+      public: const size_t kMaxCachedChunks = 8u;
+
       /// \brief XML tag delimiting the beginning of a frame.
       public: const std::string kStartFrame = "<sdf ";
 
@@ -71,6 +148,65 @@ namespace gazebo
       /// \brief Current position in the log file.
       public: tinyxml2::XMLElement *logCurrXml = nullptr;
 
+      /// \brief The chunks of the log file, in order.
+      public: std::vector<tinyxml2::XMLElement *> chunks;
+
+      /// \brief The frames of the log file that have a simulation time, in
+      /// order. Only valid if indexed is true.
+      public: std::vector<LogPlayFrame> frames;
+
+      /// \brief True if every chunk of the log file has a frame index.
+      public: bool indexed = false;
+
+      /// \brief Index of the current chunk, logCurrXml.
+      public: size_t chunkIndex = 0;
+
+      /// \brief Direction of playback, 1 forward and -1 backward.
+      public: int direction = 1;
+
+      /// \brief Decoded chunks, by index.
+      public: std::map<size_t, std::shared_ptr<const std::string>> cache;
+
+      /// \brief Indices of the cached chunks, most recently used first.
+      public: std::list<size_t> cacheOrder;
+
+      /// \brief Indices of the chunks being decoded by the prefetch thread.
+      public: std::set<size_t> decoding;
+
+      /// \brief Thread that decodes the chunks ahead of playback.
+      public: std::thread prefetchThread;
+
+      /// \brief True while the prefetch thread runs.
+      public: bool prefetchRunning = false;
+
+      /// \brief True when the current chunk changed.
+      public: bool prefetchRequest = false;
+
+      /// \brief Protects the cache and the prefetch state.
+      public: std::mutex cacheMutex;
+
+      /// \brief Signaled when the prefetch thread has work to do.
+      public: std::condition_variable prefetchCondition;
+
+      /// \brief Signaled when the prefetch thread decoded a chunk.
+      public: std::condition_variable decodedCondition;
+
+      /// \brief The XML document of the log of the recorded topics.
+      public: tinyxml2::XMLDocument topicDoc;
+
+      /// \brief The chunks of the log of the recorded topics.
+      public: std::vector<tinyxml2::XMLElement *> topicChunks;
+
+      /// \brief The recorded messages, one frame each. Empty if there are no
+      /// recorded topics.
+      public: std::vector<LogPlayFrame> topicFrames;
+
+      /// \brief Index of the decoded chunk of the topic log.
+      public: size_t topicChunkIndex = 0;
+
+      /// \brief Decoded data of the chunk topicChunkIndex, or empty.
+      public: std::string topicChunk;
+
       /// \brief Name of the log file.
       public: std::string filename;
 
@@ -17,11 +17,15 @@
 
 #include <gtest/gtest.h>
 #include <boost/filesystem.hpp>
+#include <algorithm>
 #include <string>
 #include <thread>
+#include <vector>
+#include "gazebo/common/Base64.hh"
 #include "gazebo/common/CommonIface.hh"
 #include "gazebo/common/Time.hh"
 #include "gazebo/util/LogPlay.hh"
+#include "gazebo/util/LogRecord.hh"
 #include "test_config.h"
 #include "test/util.hh"
 
@@ -346,6 +350,34 @@ TEST_F(LogPlay_TEST, MultiStep)
   EXPECT_EQ(shasum, expectedShashum);
 }
 
+/////////////////////////////////////////////////
+/// \brief Test stepping through every chunk, in both directions, while the
+/// next chunks are decoded ahead.
+TEST_F(LogPlay_TEST, StepAllChunks)
+{
+  gazebo::util::LogPlay *player = gazebo::util::LogPlay::Instance();
+
+  boost::filesystem::path logFilePath(TEST_PATH);
+  logFilePath /= boost::filesystem::path("logs");
+  logFilePath /= boost::filesystem::path("state.log");
+  EXPECT_NO_THROW(player->Open(logFilePath.string()));
+
+  std::vector<std::string> frames;
+  std::string frame;
+  EXPECT_TRUE(player->Rewind());
+  while (player->Step(frame))
+    frames.push_back(gazebo::common::get_sha1<std::string>(frame));
+  EXPECT_GT(frames.size(), player->ChunkCount());
+
+  // Stepping back gives the same frames, in reverse order
+  EXPECT_TRUE(player->Forward());
+  for (auto it = frames.rbegin(); it != frames.rend(); ++it)
+  {
+    ASSERT_TRUE(player->StepBack(frame));
+    EXPECT_EQ(*it, gazebo::common::get_sha1<std::string>(frame));
+  }
+}
+
 /////////////////////////////////////////////////
 /// \brief Test Seek().
 TEST_F(LogPlay_TEST, Seek)
@@ -406,6 +438,375 @@ TEST_F(LogPlay_TEST, Seek)
   EXPECT_EQ(shasum, expectedShashum4);
 }
 
+/////////////////////////////////////////////////
+/// \brief Test Seek() in a log file with a frame index.
+TEST_F(LogPlay_TEST, IndexedSeek)
+{
+  // \todo Make temporary files work in windows.
+#ifndef _WIN32
+  gazebo::util::LogPlay *player = gazebo::util::LogPlay::Instance();
+
+  boost::filesystem::path logFilePath(TEST_PATH);
+  logFilePath /= boost::filesystem::path("logs");
+  logFilePath /= boost::filesystem::path("state.log");
+  EXPECT_NO_THROW(player->Open(logFilePath.string()));
+
+  // Without an index there is no activity overview.
+  std::vector<float> activity;
+  EXPECT_FALSE(player->Activity(10u, activity));
+  EXPECT_TRUE(activity.empty());
+
+  // Write the log again, with a frame index in each chunk.
+  std::ostringstream stream;
+  stream << "/tmp/__gz_log_index_test" << std::this_thread::get_id();
+  std::string tmpFilename = stream.str();
+  std::ofstream destFile(tmpFilename, std::ios::binary);
+  ASSERT_TRUE(destFile.good());
+
+  destFile << player->Header();
+  for (unsigned int i = 0; i < player->ChunkCount(); ++i)
+  {
+    std::string chunk;
+    ASSERT_TRUE(player->Chunk(i, chunk));
+
+    // Compressed chunks are decoded with a trailing null character.
+    if (!chunk.empty() && chunk.back() == '\0')
+      chunk.pop_back();
+
+    destFile << "<chunk encoding='txt' frames='"
+      << gazebo::util::LogRecord::FrameIndex(chunk) << "'>\n"
+      << "<![CDATA[" << chunk << "]]>\n</chunk>\n";
+  }
+  destFile << "</gazebo_log>\n";
+  destFile.close();
+
+  EXPECT_NO_THROW(player->Open(tmpFilename));
+  std::remove(tmpFilename.c_str());
+
+  EXPECT_EQ(player->LogStartTime(), common::Time(28, 457000000));
+  EXPECT_EQ(player->LogEndTime(), common::Time(31, 745000000));
+
+  // The index gives the activity overview.
+  EXPECT_TRUE(player->Activity(10u, activity));
+  ASSERT_EQ(activity.size(), 10u);
+  EXPECT_FLOAT_EQ(*std::max_element(activity.begin(), activity.end()), 1.0f);
+  for (auto const value : activity)
+  {
+    EXPECT_GE(value, 0.0f);
+    EXPECT_LE(value, 1.0f);
+  }
+
+  // Same frames as in the Seek test.
+  std::string expectedShashum1 = "a2af44bc561194dfeae9526c224d56bb332a4233";
+  std::string expectedShashum2 = "113748a3c02575f514b27bc5b4307f621644ad41";
+  std::string expectedShashum3 = "0a61e946f14f7395a8bdb7974cb1e18c0d9e3d22";
+  std::string expectedShashum4 = "961cf9dcd38c12f33a8b2f3a3a6fdb879b2faa98";
+
+  std::string frame;
+  EXPECT_TRUE(player->Seek(common::Time(30.0)));
+  EXPECT_TRUE(player->Step(frame));
+  EXPECT_EQ(gazebo::common::get_sha1<std::string>(frame), expectedShashum1);
+
+  EXPECT_TRUE(player->Seek(common::Time(31.5)));
+  EXPECT_TRUE(player->Step(frame));
+  EXPECT_EQ(gazebo::common::get_sha1<std::string>(frame), expectedShashum2);
+
+  EXPECT_TRUE(player->Seek(common::Time(28.457)));
+  EXPECT_TRUE(player->Step(frame));
+  EXPECT_EQ(gazebo::common::get_sha1<std::string>(frame), expectedShashum3);
+
+  EXPECT_TRUE(player->Seek(common::Time(31.745)));
+  EXPECT_TRUE(player->Step(frame));
+  EXPECT_EQ(gazebo::common::get_sha1<std::string>(frame), expectedShashum4);
+
+  EXPECT_TRUE(player->Seek(common::Time(25.0)));
+  EXPECT_TRUE(player->Step(frame));
+  EXPECT_EQ(gazebo::common::get_sha1<std::string>(frame), expectedShashum3);
+
+  EXPECT_TRUE(player->Seek(common::Time(35.0)));
+  EXPECT_TRUE(player->Step(frame));
+  EXPECT_EQ(gazebo::common::get_sha1<std::string>(frame), expectedShashum4);
+
+  // Stepping back from a seek crosses chunks.
+  EXPECT_TRUE(player->Seek(common::Time(31.461)));
+  EXPECT_TRUE(player->Step(frame));
+  EXPECT_NE(frame.find("<sim_time>31 461000000</sim_time>"),
+      std::string::npos);
+  EXPECT_TRUE(player->Step(-2, frame));
+  EXPECT_NE(frame.find("<sim_time>31 459000000</sim_time>"),
+      std::string::npos);
+#endif
+}
+
+/////////////////////////////////////////////////
+/// \brief Test fast-forwarding the playback.
+TEST_F(LogPlay_TEST, FastForward)
+{
+  gazebo::util::LogPlay *player = gazebo::util::LogPlay::Instance();
+
+  // Open a correct log file.
+  boost::filesystem::path logFilePath(TEST_PATH);
+  logFilePath /= boost::filesystem::path("logs");
+  logFilePath /= boost::filesystem::path("state.log");
+
+  EXPECT_NO_THROW(player->Open(logFilePath.string()));
+
+  player->Rewind();
+
+  // Stop at a simulation time, the frames in between are not needed.
+  std::string frame;
+  std::vector<std::string> skipped;
+  EXPECT_EQ(5u, player->FastForward(0, common::Time(28.46), frame, skipped));
+  EXPECT_NE(frame.find("<sim_time>28 460000000</sim_time>"),
+      std::string::npos);
+  EXPECT_TRUE(skipped.empty());
+
+  // Stop after a number of frames, same as multi-step
+  player->Rewind();
+  EXPECT_EQ(10u, player->FastForward(10, common::Time::Maximum(), frame,
+        skipped));
+  EXPECT_EQ("960543e7ac9cb2bcab5a7ee0bec314efb8d07e97",
+      gazebo::common::get_sha1<std::string>(frame));
+
+  // Stop at the end of the log file.
+  EXPECT_TRUE(player->Forward());
+  EXPECT_TRUE(player->Step(-2, frame));
+  EXPECT_LT(0u, player->FastForward(0, common::Time::Maximum(), frame,
+        skipped));
+  EXPECT_EQ("961cf9dcd38c12f33a8b2f3a3a6fdb879b2faa98",
+      gazebo::common::get_sha1<std::string>(frame));
+  EXPECT_EQ(0u, player->FastForward(0, common::Time::Maximum(), frame,
+        skipped));
+}
+
+/////////////////////////////////////////////////
+/// \brief Test reading the state digests of frames.
+TEST_F(LogPlay_TEST, FrameDigest)
+{
+  const std::string &delta = gazebo::util::LogRecord::DeltaFrameMarker();
+  const std::string digest = gazebo::util::LogRecord::DigestFrameMarker(
+      1234u, 0x00ff00ff12345678ULL);
+  EXPECT_EQ("<!--digest 1234 00ff00ff12345678-->", digest);
+
+  uint64_t iterations = 0;
+  uint64_t value = 0;
+  EXPECT_TRUE(gazebo::util::LogPlay::FrameDigest(
+        "<sdf version='1.6'>" + digest + "<state/></sdf>", iterations, value));
+  EXPECT_EQ(1234u, iterations);
+  EXPECT_EQ(0x00ff00ff12345678ULL, value);
+
+  // The digest follows the delta marker, which stays first
+  const std::string deltaFrame =
+    "<sdf version='1.6'>" + delta + digest + "<state/></sdf>";
+  EXPECT_TRUE(gazebo::util::LogPlay::IsDeltaFrame(deltaFrame));
+  iterations = 0;
+  EXPECT_TRUE(gazebo::util::LogPlay::FrameDigest(deltaFrame, iterations,
+        value));
+  EXPECT_EQ(1234u, iterations);
+
+  EXPECT_FALSE(gazebo::util::LogPlay::FrameDigest(
+        "<sdf version='1.6'><state/></sdf>", iterations, value));
+  EXPECT_FALSE(gazebo::util::LogPlay::FrameDigest("", iterations, value));
+}
+
+/////////////////////////////////////////////////
+/// \brief Test LogPlay FramesSinceKeyframe.
+TEST_F(LogPlay_TEST, Keyframes)
+{
+  // \todo Make temporary files work in windows.
+#ifndef _WIN32
+  gazebo::util::LogPlay *player = gazebo::util::LogPlay::Instance();
+  const std::string &marker = gazebo::util::LogRecord::DeltaFrameMarker();
+
+  EXPECT_FALSE(player->IsDeltaFrame("<sdf version='1.6'><state/></sdf>"));
+  EXPECT_TRUE(player->IsDeltaFrame("<sdf version='1.6'>" + marker +
+        "<state/></sdf>"));
+  EXPECT_FALSE(player->IsDeltaFrame(""));
+
+  boost::filesystem::path logFilePath(TEST_PATH);
+  logFilePath /= boost::filesystem::path("logs");
+  logFilePath /= boost::filesystem::path("state.log");
+  EXPECT_NO_THROW(player->Open(logFilePath.string()));
+
+  // Write the log again, with keyframes at the start of the second and the
+  // fourth chunks, and delta frames in between.
+  std::ostringstream stream;
+  stream << "/tmp/__gz_log_keyframe_test" << std::this_thread::get_id();
+  std::string tmpFilename = stream.str();
+  std::ofstream destFile(tmpFilename, std::ios::binary);
+  ASSERT_TRUE(destFile.good());
+
+  destFile << player->Header();
+  for (unsigned int i = 0; i < player->ChunkCount(); ++i)
+  {
+    std::string chunk;
+    ASSERT_TRUE(player->Chunk(i, chunk));
+    if (!chunk.empty() && chunk.back() == '\0')
+      chunk.pop_back();
+
+    if (i > 0)
+    {
+      size_t from = chunk.find("<sdf ");
+      if (i != 1 && i != 3)
+        chunk.insert(chunk.find('>', from) + 1, marker);
+      while ((from = chunk.find("<sdf ", from + 1)) != std::string::npos)
+        chunk.insert(chunk.find('>', from) + 1, marker);
+    }
+
+    destFile << "<chunk encoding='txt'>\n"
+      << "<![CDATA[" << chunk << "]]>\n</chunk>\n";
+  }
+  destFile << "</gazebo_log>\n";
+  destFile.close();
+
+  EXPECT_NO_THROW(player->Open(tmpFilename));
+  std::remove(tmpFilename.c_str());
+
+  // No frame was played yet
+  std::vector<std::string> frames;
+  EXPECT_FALSE(player->FramesSinceKeyframe(frames));
+
+  // A keyframe
+  std::string frame;
+  EXPECT_TRUE(player->Seek(common::Time(28.457)));
+  EXPECT_TRUE(player->Step(frame));
+  EXPECT_FALSE(player->IsDeltaFrame(frame));
+  EXPECT_TRUE(player->FramesSinceKeyframe(frames));
+  ASSERT_EQ(1u, frames.size());
+  EXPECT_EQ(frame, frames[0]);
+
+  // A delta frame in the chunk after its keyframe
+  EXPECT_TRUE(player->Seek(common::Time(30.0)));
+  EXPECT_TRUE(player->Step(frame));
+  EXPECT_TRUE(player->IsDeltaFrame(frame));
+  EXPECT_TRUE(player->FramesSinceKeyframe(frames));
+  ASSERT_GT(frames.size(), 1000u);
+  EXPECT_NE(frames.front().find("<sim_time>28 457000000</sim_time>"),
+      std::string::npos);
+  EXPECT_FALSE(player->IsDeltaFrame(frames.front()));
+  EXPECT_TRUE(player->IsDeltaFrame(frames[1]));
+  EXPECT_EQ(frame, frames.back());
+
+  // The playback position did not change
+  EXPECT_EQ("txt", player->Encoding());
+  EXPECT_TRUE(player->Step(-1, frame));
+  EXPECT_EQ(frames[frames.size() - 2], frame);
+
+  // A delta frame after the second keyframe
+  EXPECT_TRUE(player->Seek(common::Time(31.5)));
+  EXPECT_TRUE(player->Step(frame));
+  EXPECT_TRUE(player->FramesSinceKeyframe(frames));
+  EXPECT_NE(frames.front().find("<sim_time>30 459000000</sim_time>"),
+      std::string::npos);
+  EXPECT_EQ(frame, frames.back());
+
+  // Fast-forwarding keeps the skipped delta frames
+  std::vector<std::string> skipped;
+  EXPECT_EQ(11u, player->FastForward(0, common::Time(31.511), frame,
+        skipped));
+  EXPECT_NE(frame.find("<sim_time>31 511000000</sim_time>"),
+      std::string::npos);
+  ASSERT_EQ(10u, skipped.size());
+  for (auto const &delta : skipped)
+    EXPECT_TRUE(player->IsDeltaFrame(delta));
+  EXPECT_NE(skipped.back().find("<sim_time>31 510000000</sim_time>"),
+      std::string::npos);
+#endif
+}
+
+/////////////////////////////////////////////////
+/// \brief Test reading the messages of recorded topics.
+TEST_F(LogPlay_TEST, Topics)
+{
+  // \todo Make temporary files work in windows.
+#ifndef _WIN32
+  gazebo::util::LogPlay *player = gazebo::util::LogPlay::Instance();
+
+  boost::filesystem::path logFilePath(TEST_PATH);
+  logFilePath /= boost::filesystem::path("logs");
+  logFilePath /= boost::filesystem::path("state.log");
+  EXPECT_NO_THROW(player->Open(logFilePath.string()));
+  EXPECT_FALSE(player->HasTopics());
+
+  std::vector<gazebo::util::LogPlayMessage> msgs;
+  EXPECT_FALSE(player->TopicMessages(common::Time::Zero,
+        common::Time(100), msgs));
+  EXPECT_TRUE(msgs.empty());
+
+  // Copy the state log to a directory, and record two chunks of messages
+  // next to it.
+  std::ostringstream stream;
+  stream << "/tmp/__gz_log_topics_test" << std::this_thread::get_id();
+  boost::filesystem::path dir(stream.str());
+  boost::filesystem::create_directories(dir);
+  {
+    std::ifstream srcFile(logFilePath.string(), std::ios::binary);
+    std::ofstream stateFile((dir / "state.log").string(), std::ios::binary);
+    stateFile << srcFile.rdbuf();
+  }
+
+  std::ofstream topicFile(
+      (dir / gazebo::util::LogRecord::TopicLogFilename()).string(),
+      std::ios::binary);
+  ASSERT_TRUE(topicFile.good());
+  topicFile << "<?xml version='1.0'?>\n<gazebo_log>\n"
+    << "<header>\n<log_version>1.0</log_version>\n</header>\n";
+  int count = 0;
+  for (unsigned int i = 0; i < 2; ++i)
+  {
+    std::string chunk;
+    for (unsigned int j = 0; j < 3; ++j, ++count)
+    {
+      std::string data("\0binary", 7);
+      data += std::to_string(count);
+      std::string encoded;
+      Base64Encode(data.c_str(), data.size(), encoded);
+      chunk += "<sdf version='1.6'><message topic='/gazebo/default/"
+        + std::string(j == 2 ? "scan" : "image") + "' type='gazebo.msgs."
+        + std::string(j == 2 ? "LaserScanStamped" : "ImageStamped")
+        + "'><sim_time>" + std::to_string(count) + " 500</sim_time><data>"
+        + encoded + "</data></message></sdf>\n";
+    }
+    topicFile << "<chunk encoding='txt' frames='"
+      << gazebo::util::LogRecord::FrameIndex(chunk) << "'>\n"
+      << "<![CDATA[" << chunk << "]]>\n</chunk>\n";
+  }
+  topicFile << "</gazebo_log>\n";
+  topicFile.close();
+
+  EXPECT_NO_THROW(player->Open((dir / "state.log").string()));
+  EXPECT_TRUE(player->HasTopics());
+
+  // The start of the interval is excluded, its end included
+  EXPECT_TRUE(player->TopicMessages(common::Time(1, 500), common::Time(4, 500),
+        msgs));
+  ASSERT_EQ(3u, msgs.size());
+  EXPECT_EQ("/gazebo/default/scan", msgs[0].topic);
+  EXPECT_EQ("gazebo.msgs.LaserScanStamped", msgs[0].type);
+  EXPECT_EQ(common::Time(2, 500), msgs[0].time);
+  EXPECT_EQ(std::string("\0binary2", 8), msgs[0].data);
+  EXPECT_EQ("/gazebo/default/image", msgs[1].topic);
+  EXPECT_EQ("gazebo.msgs.ImageStamped", msgs[1].type);
+  EXPECT_EQ(common::Time(3, 500), msgs[1].time);
+  EXPECT_EQ(std::string("\0binary4", 8), msgs[2].data);
+
+  // Every message, and none
+  EXPECT_TRUE(player->TopicMessages(common::Time::Zero, common::Time(100),
+        msgs));
+  EXPECT_EQ(6u, msgs.size());
+  EXPECT_TRUE(player->TopicMessages(common::Time(5, 500), common::Time(100),
+        msgs));
+  EXPECT_TRUE(msgs.empty());
+
+  // The state is played as before
+  std::string frame;
+  EXPECT_TRUE(player->Step(frame));
+  EXPECT_NE(frame.find("<world "), std::string::npos);
+
+  boost::filesystem::remove_all(dir);
+#endif
+}
+
 /////////////////////////////////////////////////
 /// \brief Test reading a log file that is missing the closing </gazebo_log>
 /// tag
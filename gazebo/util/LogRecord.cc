@@ -25,7 +25,12 @@
   #define access _access
 #endif
 
+#include <algorithm>
+#include <cstdlib>
 #include <functional>
+#include <memory>
+#include <sstream>
+#include <string>
 
 #include <boost/archive/iterators/base64_from_binary.hpp>
 #include <boost/archive/iterators/insert_linebreaks.hpp>
@@ -34,24 +39,24 @@
 
 #include <boost/date_time.hpp>
 #include <boost/filesystem.hpp>
-#include <boost/iostreams/filter/bzip2.hpp>
-#include <boost/iostreams/filter/zlib.hpp>
-#include <boost/iostreams/filtering_stream.hpp>
-#include <boost/iostreams/copy.hpp>
 #include <iomanip>
 
 #include <ignition/math/Rand.hh>
 
+#include <sdf/sdf_config.h>
+
+#include "gazebo/common/Base64.hh"
 #include "gazebo/common/CommonIface.hh"
 #include "gazebo/common/Assert.hh"
-#include "gazebo/common/Base64.hh"
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Events.hh"
 #include "gazebo/common/Exception.hh"
 #include "gazebo/common/Time.hh"
 #include "gazebo/common/SystemPaths.hh"
+#include "gazebo/common/ThreadConfig.hh"
 #include "gazebo/gazebo_config.h"
 #include "gazebo/transport/transport.hh"
+#include "gazebo/util/LogEncoding.hh"
 #include "gazebo/util/LogRecordPrivate.hh"
 #include "gazebo/util/LogRecord.hh"
 
@@ -91,6 +96,10 @@ LogRecord::LogRecord()
 
   this->dataPtr->logBasePath /= "/.gazebo/log/";
 
+  // The saved resources are shared by the logs of the base path.
+  this->dataPtr->resourceStore.SetPath(
+      (this->dataPtr->logBasePath / "resources").string());
+
   this->dataPtr->logsEnd = this->dataPtr->logs.end();
 
   this->dataPtr->connections.push_back(
@@ -139,7 +148,11 @@ bool LogRecord::Start(const LogRecordParams &_params)
 {
   this->dataPtr->period = _params.period;
   this->dataPtr->filter = _params.filter;
+  this->dataPtr->keyframePeriod = _params.keyframePeriod;
   this->dataPtr->recordResources = _params.recordResources;
+  this->dataPtr->topics = _params.topics;
+  this->dataPtr->queueSize = _params.queueSize;
+  this->dataPtr->dropOnOverflow = _params.dropOnOverflow;
   return this->Start(_params.encoding, _params.path);
 }
 
@@ -186,12 +199,25 @@ bool LogRecord::Start(const std::string &_encoding, const std::string &_path)
   if (!boost::filesystem::exists(this->dataPtr->logCompletePath))
     boost::filesystem::create_directories(this->dataPtr->logCompletePath);
 
-  if (_encoding != "bz2" && _encoding != "txt" && _encoding != "zlib")
+  if (!IsLogEncodingSupported(_encoding))
+  {
+    std::string encodings;
+    for (auto const &encoding : LogEncodings())
+      encodings += (encodings.empty() ? "" : ", ") + encoding;
     gzthrow("Invalid log encoding[" + _encoding +
-            "]. Must be one of [bz2, zlib, txt]");
+            "]. Must be one of [" + encodings + "]");
+  }
 
   this->dataPtr->encoding = _encoding;
 
+  // The write thread is signaled when chunks are encoded.
+  this->dataPtr->encoder.Start([this]()
+      {
+        this->dataPtr->dataAvailableCondition.notify_one();
+      });
+
+  this->StartTopics();
+
   {
     std::unique_lock<std::mutex> logLock(this->dataPtr->writeMutex);
     this->dataPtr->logsEnd = this->dataPtr->logs.end();
@@ -247,6 +273,7 @@ const std::string &LogRecord::Encoding() const
 //////////////////////////////////////////////////
 void LogRecord::Fini()
 {
+  this->StopTopics();
   this->dataPtr->logControlSub.reset();
   this->dataPtr->logStatusPub.reset();
   if (this->dataPtr->node)
@@ -267,6 +294,8 @@ void LogRecord::Fini()
 
   // Remove all the logs.
   this->ClearLogs();
+
+  this->dataPtr->encoder.Stop();
 }
 
 //////////////////////////////////////////////////
@@ -322,6 +351,35 @@ void LogRecord::SetPeriod(const double _period)
   this->dataPtr->period = _period;
 }
 
+//////////////////////////////////////////////////
+double LogRecord::KeyframePeriod() const
+{
+  return this->dataPtr->keyframePeriod;
+}
+
+//////////////////////////////////////////////////
+void LogRecord::SetKeyframePeriod(const double _period)
+{
+  this->dataPtr->keyframePeriod = _period;
+}
+
+//////////////////////////////////////////////////
+const std::string &LogRecord::DeltaFrameMarker()
+{
+  static const std::string marker = "<!--delta-->";
+  return marker;
+}
+
+//////////////////////////////////////////////////
+std::string LogRecord::DigestFrameMarker(const uint64_t _iterations,
+    const uint64_t _digest)
+{
+  std::ostringstream stream;
+  stream << "<!--digest " << _iterations << " " << std::hex
+    << std::setw(16) << std::setfill('0') << _digest << "-->";
+  return stream.str();
+}
+
 //////////////////////////////////////////////////
 std::string LogRecord::Filter() const
 {
@@ -352,6 +410,128 @@ void LogRecord::SetRecordResources(const bool _record)
   this->dataPtr->recordResources = _record;
 }
 
+//////////////////////////////////////////////////
+unsigned int LogRecord::QueueSize() const
+{
+  return this->dataPtr->queueSize;
+}
+
+//////////////////////////////////////////////////
+void LogRecord::SetQueueSize(const unsigned int _size)
+{
+  this->dataPtr->queueSize = _size;
+}
+
+//////////////////////////////////////////////////
+bool LogRecord::DropOnOverflow() const
+{
+  return this->dataPtr->dropOnOverflow;
+}
+
+//////////////////////////////////////////////////
+void LogRecord::SetDropOnOverflow(const bool _drop)
+{
+  this->dataPtr->dropOnOverflow = _drop;
+}
+
+//////////////////////////////////////////////////
+void LogRecord::SetQueueStatus(const unsigned int _queued,
+    const uint64_t _dropped, const common::Time &_lag)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->queueStatusMutex);
+  this->dataPtr->queuedStates = _queued;
+  this->dataPtr->droppedStates = _dropped;
+  this->dataPtr->recordLag = _lag;
+}
+
+//////////////////////////////////////////////////
+unsigned int LogRecord::QueuedStates() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->queueStatusMutex);
+  return this->dataPtr->queuedStates;
+}
+
+//////////////////////////////////////////////////
+uint64_t LogRecord::DroppedStates() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->queueStatusMutex);
+  return this->dataPtr->droppedStates;
+}
+
+//////////////////////////////////////////////////
+common::Time LogRecord::RecordLag() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->queueStatusMutex);
+  return this->dataPtr->recordLag;
+}
+
+//////////////////////////////////////////////////
+std::vector<std::string> LogRecord::Topics() const
+{
+  return this->dataPtr->topics;
+}
+
+//////////////////////////////////////////////////
+void LogRecord::SetTopics(const std::vector<std::string> &_topics)
+{
+  this->dataPtr->topics = _topics;
+}
+
+//////////////////////////////////////////////////
+void LogRecord::SetSimTime(const common::Time &_time)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->topicMutex);
+  this->dataPtr->simTime = _time;
+}
+
+//////////////////////////////////////////////////
+const std::string &LogRecord::TopicLogFilename()
+{
+  static const std::string filename = "topics.log";
+  return filename;
+}
+
+//////////////////////////////////////////////////
+void LogRecord::StartTopics()
+{
+  if (this->dataPtr->topics.empty())
+    return;
+
+  // The recorded messages are given to the log on each update.
+  this->Add(TopicLogFilename(), TopicLogFilename(),
+      [this](std::ostringstream &_stream)
+      {
+        std::lock_guard<std::mutex> lock(this->dataPtr->topicMutex);
+        if (this->dataPtr->topicBuffer.empty())
+          return false;
+
+        _stream << this->dataPtr->topicBuffer;
+        this->dataPtr->topicBuffer.clear();
+        return true;
+      });
+
+  for (auto const &topic : this->dataPtr->topics)
+  {
+    std::unique_ptr<LogRecordPrivate::TopicRecorder> recorder(
+        new LogRecordPrivate::TopicRecorder);
+    recorder->parent = this;
+    recorder->data = this->dataPtr.get();
+    recorder->topic = this->dataPtr->node->DecodeTopicName(topic);
+    recorder->subscriber = this->dataPtr->node->Subscribe(topic,
+        &LogRecordPrivate::TopicRecorder::OnMessage, recorder.get());
+    this->dataPtr->topicRecorders.push_back(std::move(recorder));
+  }
+}
+
+//////////////////////////////////////////////////
+void LogRecord::StopTopics()
+{
+  // Removing the subscriptions waits for the callbacks in progress.
+  for (auto &recorder : this->dataPtr->topicRecorders)
+    recorder->subscriber.reset();
+  this->dataPtr->topicRecorders.clear();
+}
+
 //////////////////////////////////////////////////
 void LogRecord::Add(const std::string &_name, const std::string &_filename,
                     std::function<bool (std::ostringstream &)> _logCallback)
@@ -382,7 +562,8 @@ void LogRecord::Add(const std::string &_name, const std::string &_filename,
   // Create a new log object
   try
   {
-    newLog = new LogRecordPrivate::Log(this, _filename, _logCallback);
+    newLog = new LogRecordPrivate::Log(this, _filename, _logCallback,
+        &this->dataPtr->encoder);
   }
   catch(...)
   {
@@ -510,6 +691,8 @@ void LogRecord::SetBasePath(const std::string &_path)
   }
 
   this->dataPtr->logBasePath = _path;
+  this->dataPtr->resourceStore.SetPath(
+      (this->dataPtr->logBasePath / "resources").string());
 }
 
 //////////////////////////////////////////////////
@@ -549,11 +732,8 @@ bool LogRecord::SaveModels(const std::set<std::string> &_models)
         modelFound = true;
         boost::filesystem::path destModelPath =
           this->dataPtr->logCompletePath / model;
-        if (!gazebo::common::copyDir(srcModelPath, destModelPath))
-        {
-          gzerr << "Failed to copy model from '" << srcModelPath.string()
-                 << "' to '" << destModelPath.string() << "'" << std::endl;
-        }
+        this->dataPtr->resourceStore.Add(srcModelPath.string(),
+            destModelPath.string());
         break;
       }
     }
@@ -631,15 +811,7 @@ bool LogRecord::SaveFiles(const std::set<std::string> &_files)
         srcPath = srcPath / modelPath;
         boost::filesystem::path destPath =
           this->dataPtr->logCompletePath / modelPath;
-        boost::system::error_code errorCode;
-        boost::filesystem::create_directories(destPath, errorCode);
-        if (errorCode != boost::system::errc::success ||
-            !gazebo::common::copyDir(srcPath, destPath))
-        {
-          gzerr << "Failed to copy model from '" << srcPath.string()
-                 << "' to '" << destPath.string() << "'" << std::endl;
-          saveError = true;
-        }
+        this->dataPtr->resourceStore.Add(srcPath.string(), destPath.string());
       }
       // else copy only the specified file
       else
@@ -647,17 +819,7 @@ bool LogRecord::SaveFiles(const std::set<std::string> &_files)
         srcPath = srcPath / fileName;
         boost::filesystem::path destPath =
           this->dataPtr->logCompletePath / fileName;
-        boost::system::error_code errorCode;
-        boost::filesystem::create_directories(
-            destPath.parent_path(), errorCode);
-        if (errorCode == boost::system::errc::success)
-          boost::filesystem::copy_file(srcPath, destPath, errorCode);
-        else
-        {
-          gzerr << "Failed to copy file from '" << srcPath.string()
-                 << "' to '" << destPath.string() << "'" << std::endl;
-          saveError = true;
-        }
+        this->dataPtr->resourceStore.Add(srcPath.string(), destPath.string());
       }
     }
     else
@@ -680,6 +842,7 @@ void LogRecord::Notify()
 //////////////////////////////////////////////////
 void LogRecord::RunUpdate()
 {
+  common::ThreadConfig::Instance()->Apply("log_update");
   std::unique_lock<std::mutex> updateLock(this->dataPtr->updateMutex);
   this->dataPtr->startThreadCondition.notify_all();
 
@@ -733,6 +896,7 @@ void LogRecord::Update()
 //////////////////////////////////////////////////
 void LogRecord::RunWrite()
 {
+  common::ThreadConfig::Instance()->Apply("log_write");
   // Wait for new data.
   std::unique_lock<std::mutex> lock(this->dataPtr->runWriteMutex);
   this->dataPtr->startThreadCondition.notify_all();
@@ -769,10 +933,12 @@ common::Time LogRecord::RunTime() const
 //////////////////////////////////////////////////
 LogRecordPrivate::Log::Log(LogRecord *_parent,
     const std::string &_relativeFilename,
-    std::function<bool (std::ostringstream &)> _logCB)
+    std::function<bool (std::ostringstream &)> _logCB,
+    ChunkEncoder *_encoder)
 {
   this->parent = _parent;
   this->logCB = _logCB;
+  this->encoder = _encoder;
 
   this->relativeFilename = _relativeFilename;
 }
@@ -788,61 +954,265 @@ unsigned int LogRecordPrivate::Log::Update()
 {
   std::ostringstream stream;
 
-  // Get log data via the callback.
+  // Get log data via the callback, and queue it for encoding.
   if (this->logCB(stream))
   {
-    std::string data = stream.str();
-    if (!data.empty())
+    auto chunk = std::make_shared<Chunk>();
+    chunk->data = stream.str();
+    if (!chunk->data.empty())
     {
-      const std::string &encodingLocal = this->parent->Encoding();
+      chunk->encoding = this->parent->Encoding();
+      this->chunks.push_back(chunk);
+      this->encoder->Push(chunk);
+    }
+  }
 
-      this->buffer.append("<chunk encoding='");
-      this->buffer.append(encodingLocal);
-      this->buffer.append("'>\n");
+  unsigned int size = this->buffer.size();
+  for (auto const &chunk : this->chunks)
+  {
+    if (chunk->done)
+      size += chunk->text.size();
+  }
 
-      this->buffer.append("<![CDATA[");
-      // Compress the data.
-      if (encodingLocal == "bz2")
-      {
-        std::string str;
+  return size;
+}
 
-        // Compress to bzip2
-        {
-          boost::iostreams::filtering_ostream out;
-          out.push(boost::iostreams::bzip2_compressor());
-          out.push(std::back_inserter(str));
-          boost::iostreams::copy(boost::make_iterator_range(data), out);
-        }
+//////////////////////////////////////////////////
+LogRecordPrivate::ChunkEncoder::~ChunkEncoder()
+{
+  this->Stop();
+}
 
-        // Encode in base64.
-        Base64Encode(str.c_str(), str.size(), this->buffer);
-      }
-      else if (encodingLocal == "zlib")
+//////////////////////////////////////////////////
+void LogRecordPrivate::ChunkEncoder::Start(std::function<void ()> _done)
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  if (this->running)
+    return;
+
+  // Leave a core to the simulation. GAZEBO_LOG_ENCODER_THREADS=0 encodes
+  // the chunks on the update thread.
+  unsigned int count =
+    std::max(1u, std::min(4u, std::thread::hardware_concurrency() / 2));
+  const char *env = common::getEnv("GAZEBO_LOG_ENCODER_THREADS");
+  if (env)
+    count = std::max(0, std::atoi(env));
+
+  if (count == 0)
+    return;
+
+  this->doneCallback = _done;
+  this->maxPending = 2 * count;
+  this->running = true;
+  for (unsigned int i = 0; i < count; ++i)
+    this->threads.emplace_back(&ChunkEncoder::Run, this);
+}
+
+//////////////////////////////////////////////////
+void LogRecordPrivate::ChunkEncoder::Stop()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->running = false;
+  }
+  this->queueCondition.notify_all();
+
+  for (auto &thread : this->threads)
+  {
+    if (thread.joinable())
+      thread.join();
+  }
+  this->threads.clear();
+}
+
+//////////////////////////////////////////////////
+void LogRecordPrivate::ChunkEncoder::Push(std::shared_ptr<Chunk> _chunk)
+{
+  {
+    std::unique_lock<std::mutex> lock(this->mutex);
+
+    // Backpressure: wait for a chunk to be encoded.
+    if (this->running && this->pending >= this->maxPending)
+    {
+      ++this->stalls;
+      const common::Time start = common::Time::GetWallTime();
+      this->doneCondition.wait(lock, [this]()
+          {
+            return this->pending < this->maxPending || !this->running;
+          });
+      this->stallTime += common::Time::GetWallTime() - start;
+    }
+
+    if (this->running)
+    {
+      ++this->pending;
+      this->queue.push_back(std::move(_chunk));
+      lock.unlock();
+      this->queueCondition.notify_one();
+      return;
+    }
+  }
+
+  Encode(*_chunk);
+}
+
+//////////////////////////////////////////////////
+void LogRecordPrivate::ChunkEncoder::Wait(
+    const std::shared_ptr<Chunk> &_chunk)
+{
+  std::unique_lock<std::mutex> lock(this->mutex);
+  this->doneCondition.wait(lock, [&_chunk]()
       {
-        std::string str;
+        return _chunk->done.load();
+      });
+}
+
+//////////////////////////////////////////////////
+void LogRecordPrivate::ChunkEncoder::Encode(Chunk &_chunk)
+{
+  _chunk.text = "<chunk encoding='" + _chunk.encoding + "' frames='" +
+    LogRecord::FrameIndex(_chunk.data) + "'>\n<![CDATA[";
+  EncodeLogChunk(_chunk.encoding, _chunk.data, _chunk.text);
+  _chunk.text.append("]]>\n</chunk>\n");
+
+  std::string().swap(_chunk.data);
+  _chunk.done = true;
+}
 
-        // Compress to zlib
+//////////////////////////////////////////////////
+void LogRecordPrivate::ChunkEncoder::Run()
+{
+  std::unique_lock<std::mutex> lock(this->mutex);
+  while (true)
+  {
+    // The queued chunks are encoded before stopping.
+    this->queueCondition.wait(lock, [this]()
         {
-          boost::iostreams::filtering_ostream out;
-          out.push(boost::iostreams::zlib_compressor());
-          out.push(std::back_inserter(str));
-          boost::iostreams::copy(boost::make_iterator_range(data), out);
-        }
+          return !this->queue.empty() || !this->running;
+        });
+    if (this->queue.empty())
+      return;
+
+    auto chunk = std::move(this->queue.front());
+    this->queue.pop_front();
+    lock.unlock();
+
+    Encode(*chunk);
+
+    lock.lock();
+    --this->pending;
+    this->doneCondition.notify_all();
+    lock.unlock();
+
+    if (this->doneCallback)
+      this->doneCallback();
+
+    lock.lock();
+  }
+}
+
+//////////////////////////////////////////////////
+unsigned int LogRecord::PendingChunks() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->encoder.mutex);
+  return this->dataPtr->encoder.pending;
+}
+
+//////////////////////////////////////////////////
+uint64_t LogRecord::EncoderStalls() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->encoder.mutex);
+  return this->dataPtr->encoder.stalls;
+}
+
+//////////////////////////////////////////////////
+common::Time LogRecord::EncoderStallTime() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->encoder.mutex);
+  return this->dataPtr->encoder.stallTime;
+}
+
+//////////////////////////////////////////////////
+std::string LogRecord::FrameIndex(const std::string &_data)
+{
+  const std::string startFrame = "<sdf ";
+  const std::string endFrame = "</sdf>";
+  const std::string startTime = "<sim_time>";
+  const std::string endTime = "</sim_time>";
+  const std::string startIterations = "<iterations>";
+  const std::string endIterations = "</iterations>";
+
+  std::ostringstream index;
+  size_t from = _data.find(startFrame);
+  while (from != std::string::npos)
+  {
+    const size_t to = _data.find(endFrame, from);
 
-        // Encode in base64.
-        Base64Encode(str.c_str(), str.size(), this->buffer);
+    // Frames without a simulation time, such as the world description,
+    // are not indexed
+    size_t timeFrom = _data.find(startTime, from);
+    if (timeFrom != std::string::npos && timeFrom < to)
+    {
+      timeFrom += startTime.size();
+      common::Time time;
+      std::istringstream timeStream(
+          _data.substr(timeFrom, _data.find(endTime, timeFrom) - timeFrom));
+      timeStream >> time;
+
+      uint64_t iterations = 0;
+      size_t iterFrom = _data.find(startIterations, from);
+      if (iterFrom != std::string::npos && iterFrom < to)
+      {
+        iterFrom += startIterations.size();
+        std::istringstream iterStream(_data.substr(iterFrom,
+              _data.find(endIterations, iterFrom) - iterFrom));
+        iterStream >> iterations;
       }
-      else if (encodingLocal == "txt")
-        this->buffer.append(data);
-      else
-        gzerr << "Unknown log file encoding[" << encodingLocal << "]\n";
-      this->buffer.append("]]>\n");
 
-      this->buffer.append("</chunk>\n");
+      if (index.tellp() > 0)
+        index << " ";
+      index << from << " " << time.sec << " " << time.nsec << " "
+        << iterations;
     }
+
+    if (to == std::string::npos)
+      break;
+    from = _data.find(startFrame, to);
   }
 
-  return this->buffer.size();
+  return index.str();
+}
+
+//////////////////////////////////////////////////
+void LogRecordPrivate::TopicRecorder::OnMessage(const std::string &_data)
+{
+  std::string encoded;
+  Base64Encode(_data.c_str(), _data.size(), encoded);
+
+  std::lock_guard<std::mutex> lock(this->data->topicMutex);
+
+  // The publication of the topic exists while messages arrive.
+  if (this->msgType.empty())
+  {
+    transport::PublicationPtr pub =
+      transport::TopicManager::Instance()->FindPublication(this->topic);
+    if (pub)
+      this->msgType = pub->GetMsgType();
+  }
+
+  // Each message is a frame with a simulation time, so that it is in the
+  // frame index of its chunk.
+  std::ostringstream stream;
+  stream << "<sdf version='" << SDF_VERSION << "'>"
+    << "<message topic='" << this->topic << "' type='" << this->msgType
+    << "'><sim_time>" << this->data->simTime << "</sim_time><data>"
+    << encoded << "</data></message></sdf>\n";
+  this->data->topicBuffer += stream.str();
+
+  // Large messages, such as images, are written without waiting for the
+  // world to request an update.
+  if (this->data->topicBuffer.size() > 16u * 1024u * 1024u)
+    this->parent->Notify();
 }
 
 //////////////////////////////////////////////////
@@ -875,6 +1245,8 @@ void LogRecordPrivate::Log::Stop()
   if (this->logFile.is_open())
   {
     this->Update();
+    for (auto const &chunk : this->chunks)
+      this->encoder->Wait(chunk);
     this->Write();
 
     std::string xmlEnd = "</gazebo_log>";
@@ -912,6 +1284,13 @@ void LogRecordPrivate::Log::Start(const boost::filesystem::path &_path)
 //////////////////////////////////////////////////
 void LogRecordPrivate::Log::Write()
 {
+  // Append the encoded chunks to the buffer, in order.
+  while (!this->chunks.empty() && this->chunks.front()->done)
+  {
+    this->buffer.append(this->chunks.front()->text);
+    this->chunks.pop_front();
+  }
+
   // Make sure the file is open for writing
   if (!this->logFile.is_open())
   {
@@ -1003,6 +1382,19 @@ void LogRecord::PublishLogStatus()
   // Set whether to save model
   msg.mutable_log_file()->set_record_resources(this->dataPtr->recordResources);
 
+  // Backpressure of the compression threads
+  msg.set_pending_chunks(this->PendingChunks());
+  msg.set_encoder_stalls(this->EncoderStalls());
+  msgs::Set(msg.mutable_encoder_stall_time(), this->EncoderStallTime());
+
+  // Lag of the log worker, with a recording queue
+  if (this->dataPtr->queueSize > 0)
+  {
+    msg.set_queued_states(this->QueuedStates());
+    msg.set_dropped_states(this->DroppedStates());
+    msgs::Set(msg.mutable_record_lag(), this->RecordLag());
+  }
+
   // Get the size of the log file
   size = this->FileSize();
 
@@ -1030,6 +1422,7 @@ void LogRecord::PublishLogStatus()
 //////////////////////////////////////////////////
 void LogRecord::Cleanup()
 {
+  common::ThreadConfig::Instance()->Apply("log_cleanup");
   std::unique_lock<std::mutex> lock(this->dataPtr->controlMutex);
   this->dataPtr->startThreadCondition.notify_all();
 
@@ -1044,6 +1437,9 @@ void LogRecord::Cleanup()
   this->dataPtr->running = false;
   this->dataPtr->stopThread = true;
 
+  // No more messages once the last update is done.
+  this->StopTopics();
+
   // Kick the update thread
   {
     std::lock_guard<std::mutex> updateLock(this->dataPtr->updateMutex);
@@ -1079,6 +1475,12 @@ void LogRecord::Cleanup()
     iter->second->Stop();
   }
 
+  // The topics may change before the next run.
+  this->Remove(TopicLogFilename());
+
+  // The log is complete once its resources are saved.
+  this->dataPtr->resourceStore.Wait();
+
   // Reset the times
   this->dataPtr->startTime = this->dataPtr->currTime = common::Time();
 
@@ -20,6 +20,7 @@
 #include <fstream>
 #include <set>
 #include <string>
+#include <vector>
 
 #include "gazebo/msgs/msgs.hh"
 #include "gazebo/common/SingletonT.hh"
@@ -38,7 +39,8 @@ namespace gazebo
     /// \sa LogRecord::Start
     class LogRecordParams
     {
-      /// \brief The type of encoding (txt, zlib, or bz2).
+      /// \brief The type of encoding (txt, zlib, bz2, zstd or lz4).
+      /// \sa LogEncodings
       public: std::string encoding = "zlib";
 
       /// \brief Path in which to store log files.
@@ -51,9 +53,28 @@ namespace gazebo
       /// \brief Log filter string
       public: std::string filter;
 
+      /// \brief Keyframe period in seconds of simulation time. A value
+      /// <= 0 records every state in full.
+      /// \sa LogRecord::KeyframePeriod
+      public: double keyframePeriod = 0;
+
       /// \brief Recording resources. True will record state logs
       /// together with model meshes and materials.
       public: bool recordResources = false;
+
+      /// \brief Capacity of the queue of states captured by the simulation
+      /// for the log worker. With 0, the simulation waits for the log worker
+      /// on every iteration.
+      /// \sa LogRecord::QueueSize
+      public: unsigned int queueSize = 0;
+
+      /// \brief True to drop the states captured while the queue is full,
+      /// false to wait for the log worker.
+      public: bool dropOnOverflow = true;
+
+      /// \brief Topics whose messages are recorded.
+      /// \sa LogRecord::SetTopics
+      public: std::vector<std::string> topics;
     };
 
     // Forward declare private data class
@@ -145,6 +166,37 @@ namespace gazebo
       /// \param[in] _period New log recording period in seconds.
       public: void SetPeriod(const double _period);
 
+      /// \brief Get the keyframe period. With a period > 0, a state is
+      /// recorded in full once per period. The states in between, the delta
+      /// frames, only have the models and lights that changed since the
+      /// state before them, which makes the logs of large worlds much
+      /// smaller. A delta frame starts with DeltaFrameMarker.
+      /// \return Keyframe period in seconds of simulation time. A value
+      /// <= 0 records every state in full, which is the default.
+      public: double KeyframePeriod() const;
+
+      /// \brief Set the keyframe period.
+      /// \param[in] _period New keyframe period in seconds.
+      /// \sa KeyframePeriod
+      public: void SetKeyframePeriod(const double _period);
+
+      /// \brief Get the marker that follows the opening tag of the delta
+      /// frames, an XML comment ignored by the SDF parser.
+      /// \return The marker.
+      /// \sa KeyframePeriod
+      public: static const std::string &DeltaFrameMarker();
+
+      /// \brief Get the marker that records the state digest of a frame,
+      /// an XML comment written after the delta frame marker when the world
+      /// computes state digests.
+      /// \param[in] _iterations Iterations of the world when the state was
+      /// captured.
+      /// \param[in] _digest The digest, see physics::World::StateDigest.
+      /// \return The marker.
+      /// \sa LogPlay::FrameDigest
+      public: static std::string DigestFrameMarker(const uint64_t _iterations,
+                  const uint64_t _digest);
+
       /// \brief Get the log recording filter string.
       /// \return Log recording filter string.
       public: std::string Filter() const;
@@ -162,6 +214,81 @@ namespace gazebo
       /// \param[in] _record True to save model resources when recording.
       public: void SetRecordResources(const bool _record);
 
+      /// \brief Get the capacity of the recording queue. With a queue, the
+      /// simulation captures the states to record and queues them for the
+      /// log worker thread, rather than waiting for the worker on every
+      /// iteration, so that a slow worker does not slow the simulation.
+      /// \return Number of states. 0 if the simulation waits for the log
+      /// worker, which is the default.
+      public: unsigned int QueueSize() const;
+
+      /// \brief Set the capacity of the recording queue, used from the next
+      /// start of the logger.
+      /// \param[in] _size Number of states.
+      /// \sa QueueSize
+      public: void SetQueueSize(const unsigned int _size);
+
+      /// \brief Get what happens to a state captured while the recording
+      /// queue is full.
+      /// \return True if the state is dropped, and counted in
+      /// DroppedStates. False if the simulation waits for the log worker.
+      public: bool DropOnOverflow() const;
+
+      /// \brief Set what happens to a state captured while the recording
+      /// queue is full.
+      /// \param[in] _drop True to drop the state.
+      /// \sa DropOnOverflow
+      public: void SetDropOnOverflow(const bool _drop);
+
+      /// \brief Update the status of the recording queue, published with
+      /// the log status. Called by the log worker.
+      /// \param[in] _queued Number of states in the queue.
+      /// \param[in] _dropped Number of states dropped since the start of
+      /// the logger.
+      /// \param[in] _lag Simulation time between the newest state queued
+      /// and the state recorded last.
+      public: void SetQueueStatus(const unsigned int _queued,
+                  const uint64_t _dropped, const common::Time &_lag);
+
+      /// \brief Get the number of states in the recording queue.
+      /// \return Number of states.
+      public: unsigned int QueuedStates() const;
+
+      /// \brief Get the number of states dropped because the recording
+      /// queue was full.
+      /// \return Number of states since the start of the logger.
+      public: uint64_t DroppedStates() const;
+
+      /// \brief Get how far the log worker is behind the simulation.
+      /// \return Simulation time between the newest state queued and the
+      /// state recorded last.
+      public: common::Time RecordLag() const;
+
+      /// \brief Get the topics recorded by the logger.
+      /// \return Names of the topics.
+      /// \sa SetTopics
+      public: std::vector<std::string> Topics() const;
+
+      /// \brief Set the topics to record, from the next start of the
+      /// logger. The serialized messages of the topics are stored as they
+      /// arrive, stamped with the simulation time, in the log file named
+      /// TopicLogFilename next to the state log. LogPlay publishes them
+      /// again during playback.
+      /// \param[in] _topics Names of the topics. A leading "~" is replaced
+      /// by the namespace of the world.
+      public: void SetTopics(const std::vector<std::string> &_topics);
+
+      /// \brief Set the simulation time used to stamp the messages of the
+      /// recorded topics. The world sets it on each iteration while the
+      /// logger runs.
+      /// \param[in] _time Current simulation time.
+      public: void SetSimTime(const common::Time &_time);
+
+      /// \brief Get the filename of the log of the recorded topics.
+      /// \return The filename, relative to the log directory.
+      /// \sa SetTopics
+      public: static const std::string &TopicLogFilename();
+
       /// \brief Get whether the logger is ready to start, which implies
       /// that any previous runs have finished.
       // \return True if logger is ready to start.
@@ -176,14 +303,15 @@ namespace gazebo
       public: bool Start(const LogRecordParams &_params);
 
       /// \brief Start the logger.
-      /// \param[in] _encoding The type of encoding (txt, zlib, or bz2).
+      /// \param[in] _encoding The type of encoding (txt, zlib, bz2, zstd
+      /// or lz4).
       /// \param[in] _path Path in which to store log files.
       public: bool Start(const std::string &_encoding="zlib",
                          const std::string &_path="");
 
       /// \brief Get the encoding used.
-      /// \return Either [txt, zlib, or bz2], where txt is plain txt and bz2
-      /// and zlib are compressed data with Base64 encoding.
+      /// \return One of [txt, zlib, bz2, zstd or lz4], where txt is plain
+      /// txt and the others are compressed data with Base64 encoding.
       public: const std::string &Encoding() const;
 
       /// \brief Get the filename for a log object.
@@ -215,13 +343,18 @@ namespace gazebo
       /// \return True if an Update has not yet been completed.
       public: bool FirstUpdate() const;
 
-      /// \brief Return true if all the models are saved successfully.
+      /// \brief Save model directories in the log directory. The models
+      /// are saved by a background thread, in a content addressed store
+      /// shared by the logs: each log links to the stored files, which are
+      /// only copied once.
       /// \return True if all the models are saved successfully.
+      /// \sa LogResourceStore
       public: bool SaveModels(const std::set<std::string> &models);
 
-      /// \brief Return true if all the files are saved successfully.
+      /// \brief Save files in the log directory, like SaveModels.
       /// \return True if all the files are saved successfully, and false if
-      /// there are errors saving the files.
+      /// there are errors saving the files, such as files not found.
+      /// \sa LogResourceStore
       public: bool SaveFiles(const std::set<std::string> &resources);
 
       /// \brief Write all logs.
@@ -232,6 +365,31 @@ namespace gazebo
       /// \return Size of the buffer, in bytes.
       public: unsigned int BufferSize() const;
 
+      /// \brief Get the number of chunks queued for compression or being
+      /// compressed. Chunks are compressed by a pool of threads, and are
+      /// written in order once compressed.
+      /// \return Number of chunks.
+      public: unsigned int PendingChunks() const;
+
+      /// \brief Get the number of times recording waited for the
+      /// compression threads, because too many chunks were pending.
+      /// \return Number of waits since the logger was created.
+      public: uint64_t EncoderStalls() const;
+
+      /// \brief Get the total time recording waited for the compression
+      /// threads.
+      /// \return Wall clock time.
+      public: common::Time EncoderStallTime() const;
+
+      /// \brief Build the frame index of a chunk, stored in the "frames"
+      /// attribute of the chunk so that LogPlay can seek without decoding
+      /// the other chunks. For each frame that has a simulation time, the
+      /// index lists the offset of the frame in the chunk data, the
+      /// simulation time in seconds and nanoseconds, and the iterations.
+      /// \param[in] _data Data of the chunk, before encoding.
+      /// \return The index, space separated.
+      public: static std::string FrameIndex(const std::string &_data);
+
       /// \brief Update the log files
       ///
       /// Captures the current state of all registered entities, and outputs
@@ -259,6 +417,13 @@ namespace gazebo
       /// to trigger a cleanup.
       private: void Cleanup();
 
+      /// \brief Add the log of the recorded topics, and subscribe to the
+      /// topics.
+      private: void StartTopics();
+
+      /// \brief Unsubscribe from the recorded topics.
+      private: void StopTopics();
+
       /// \brief Used to get the simulation pause state.
       private: void OnPause(const bool _pause);
 
@@ -17,15 +17,23 @@
 #ifndef _GAZEBO_UTIL_LOGRECORD_PRIVATE_HH_
 #define _GAZEBO_UTIL_LOGRECORD_PRIVATE_HH_
 
+#include <atomic>
+#include <deque>
 #include <list>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 #include <thread>
+#include <vector>
 #include <functional>
 #include <condition_variable>
 #include <boost/filesystem.hpp>
 
+#include "gazebo/common/Time.hh"
+#include "gazebo/util/LogResourceStore.hh"
+
 namespace gazebo
 {
   namespace util
@@ -39,6 +47,113 @@ namespace gazebo
       /// \brief Destructor (makes style checker happy)
       public: virtual ~LogRecordPrivate() = default;
 
+      /// \brief A chunk of log data, encoded by the chunk encoder.
+      public: class Chunk
+      {
+        /// \brief Data to encode, cleared once encoded.
+        public: std::string data;
+
+        /// \brief Encoding of the chunk.
+        public: std::string encoding;
+
+        /// \brief The complete <chunk> element, set once encoded.
+        public: std::string text;
+
+        /// \brief True once the chunk is encoded.
+        public: std::atomic<bool> done{false};
+      };
+
+      /// \brief Pool of threads that compress and encode chunks, so that
+      /// the update thread only collects the data of the logs. The number
+      /// of chunks waiting to be encoded is bounded: the update thread
+      /// waits for the encoder when the bound is reached.
+      public: class ChunkEncoder
+      {
+        /// \brief Destructor, stops the threads.
+        public: ~ChunkEncoder();
+
+        /// \brief Start the threads, if they are not running.
+        /// \param[in] _done Function called by the threads after each
+        /// chunk is encoded.
+        public: void Start(std::function<void ()> _done);
+
+        /// \brief Stop the threads, once the queued chunks are encoded.
+        public: void Stop();
+
+        /// \brief Queue a chunk for encoding. The chunk is encoded on the
+        /// calling thread if the encoder is not running.
+        /// \param[in] _chunk The chunk.
+        public: void Push(std::shared_ptr<Chunk> _chunk);
+
+        /// \brief Wait for a chunk to be encoded.
+        /// \param[in] _chunk The chunk.
+        public: void Wait(const std::shared_ptr<Chunk> &_chunk);
+
+        /// \brief Encode a chunk.
+        /// \param[in] _chunk The chunk.
+        public: static void Encode(Chunk &_chunk);
+
+        /// \brief Thread function that encodes the queued chunks.
+        private: void Run();
+
+        /// \brief Mutex to protect the queue and the statistics.
+        public: mutable std::mutex mutex;
+
+        /// \brief Signaled when chunks are queued, or to stop the threads.
+        public: std::condition_variable queueCondition;
+
+        /// \brief Signaled when a chunk is encoded.
+        public: std::condition_variable doneCondition;
+
+        /// \brief Chunks waiting for a thread.
+        public: std::deque<std::shared_ptr<Chunk>> queue;
+
+        /// \brief The encoding threads.
+        public: std::vector<std::thread> threads;
+
+        /// \brief Function called after each chunk is encoded.
+        public: std::function<void ()> doneCallback;
+
+        /// \brief True while the threads are running.
+        public: bool running = false;
+
+        /// \brief Number of chunks queued or being encoded.
+        public: unsigned int pending = 0;
+
+        /// \brief Maximum number of chunks queued or being encoded.
+        public: unsigned int maxPending = 0;
+
+        /// \brief Number of times the update thread waited for the
+        /// encoder.
+        public: uint64_t stalls = 0;
+
+        /// \brief Total time the update thread waited for the encoder.
+        public: common::Time stallTime;
+      };
+
+      /// \brief Records the messages of a topic.
+      public: class TopicRecorder
+      {
+        /// \brief Called with each serialized message of the topic.
+        /// \param[in] _data The message.
+        public: void OnMessage(const std::string &_data);
+
+        /// \brief The logger.
+        public: LogRecord *parent = nullptr;
+
+        /// \brief Private data of the logger.
+        public: LogRecordPrivate *data = nullptr;
+
+        /// \brief Name of the topic, with its namespace.
+        public: std::string topic;
+
+        /// \brief Type of the messages, found with the first message.
+        public: std::string msgType;
+
+        /// \brief Subscription to the topic.
+        public: transport::SubscriberPtr subscriber;
+      };
+
       /// \brief Log helper class
       public: class Log
       {
@@ -48,8 +163,10 @@ namespace gazebo
         /// generate, sans the complete path.
         /// \param[in] _logCB Callback function, which is used to get log
         /// data.
+        /// \param[in] _encoder Encoder of the chunks.
         public: Log(LogRecord *_parent, const std::string &_relativeFilename,
-                    std::function<bool (std::ostringstream &)> _logCB);
+                    std::function<bool (std::ostringstream &)> _logCB,
+                    ChunkEncoder *_encoder);
 
         /// \brief Destructor
         public: virtual ~Log();
@@ -61,11 +178,12 @@ namespace gazebo
         /// \brief Stop logging.
         public: void Stop();
 
-        /// \brief Write data to disk.
+        /// \brief Write the encoded chunks to disk, in order.
         public: void Write();
 
-        /// \brief Update the data buffer.
-        /// \return The size of the data buffer.
+        /// \brief Queue the new log data for encoding.
+        /// \return The size of the data buffer and of the chunks being
+        /// encoded.
         public: unsigned int Update();
 
         /// \brief Clear the data buffer.
@@ -90,6 +208,12 @@ namespace gazebo
         /// \brief Callback from which to get data.
         public: std::function<bool (std::ostringstream &)> logCB;
 
+        /// \brief Encoder of the chunks.
+        public: ChunkEncoder *encoder;
+
+        /// \brief Chunks not written yet, in order.
+        public: std::deque<std::shared_ptr<Chunk>> chunks;
+
         /// \brief Data buffer.
         public: std::string buffer;
 
@@ -110,6 +234,9 @@ namespace gazebo
       /// \brief All the log objects.
       public: Log_M logs;
 
+      /// \brief Encoder of the chunks of all the logs.
+      public: ChunkEncoder encoder;
+
       /// \brief Iterator used to update the log objects.
       public: Log_M::iterator updateIter;
 
@@ -206,12 +333,52 @@ namespace gazebo
       /// \brief Record period.
       public: double period = -1.0;
 
+      /// \brief Keyframe period, in seconds.
+      public: double keyframePeriod = 0.0;
+
       /// \brief Record filter string.
       public: std::string filter = "";
 
       /// \brief Record with model resources.
       public: bool recordResources = false;
 
+      /// \brief Capacity of the recording queue.
+      public: unsigned int queueSize = 0;
+
+      /// \brief True to drop states when the recording queue is full.
+      public: bool dropOnOverflow = true;
+
+      /// \brief Number of states in the recording queue.
+      public: unsigned int queuedStates = 0;
+
+      /// \brief Number of states dropped from the recording queue.
+      public: uint64_t droppedStates = 0;
+
+      /// \brief Lag of the log worker.
+      public: common::Time recordLag;
+
+      /// \brief Protects the status of the recording queue.
+      public: mutable std::mutex queueStatusMutex;
+
+      /// \brief Topics to record.
+      public: std::vector<std::string> topics;
+
+      /// \brief Recorders of the topics, while the logger runs.
+      public: std::vector<std::unique_ptr<TopicRecorder>> topicRecorders;
+
+      /// \brief Frames of the recorded messages, not yet given to the log.
+      public: std::string topicBuffer;
+
+      /// \brief Simulation time used to stamp the recorded messages.
+      public: common::Time simTime;
+
+      /// \brief Protects the topic buffer and the simulation time.
+      public: std::mutex topicMutex;
+
+      /// \brief Store of the model resources, which saves them on its own
+      /// thread.
+      public: LogResourceStore resourceStore;
+
       /// \brief List of saved models if record with resources is enabled.
       public: std::set<std::string> savedModels;
 
@@ -16,6 +16,8 @@
 */
 #include <gtest/gtest.h>
 #include <boost/filesystem.hpp>
+#include <string>
+#include <vector>
 
 #include "gazebo/common/CommonIface.hh"
 #include "gazebo/common/Console.hh"
@@ -53,6 +55,9 @@ TEST_F(LogRecord_TEST, Constructor)
   EXPECT_FALSE(recorder->Paused());
   EXPECT_FALSE(recorder->Running());
   EXPECT_TRUE(recorder->FirstUpdate());
+  EXPECT_EQ(0u, recorder->PendingChunks());
+  EXPECT_EQ(0u, recorder->EncoderStalls());
+  EXPECT_EQ(common::Time::Zero, recorder->EncoderStallTime());
 
   // Init without a subdirectory
   EXPECT_FALSE(recorder->Init(""));
@@ -210,6 +215,27 @@ TEST_F(LogRecord_TEST, Filter)
   EXPECT_EQ(recorder->Filter(), "");
 }
 
+/////////////////////////////////////////////////
+/// \brief Test LogRecord keyframe period
+TEST_F(LogRecord_TEST, KeyframePeriod)
+{
+  gazebo::util::LogRecord *recorder = gazebo::util::LogRecord::Instance();
+
+  // Every state is recorded in full by default
+  EXPECT_DOUBLE_EQ(recorder->KeyframePeriod(), 0);
+
+  recorder->SetKeyframePeriod(1.5);
+  EXPECT_DOUBLE_EQ(recorder->KeyframePeriod(), 1.5);
+
+  recorder->SetKeyframePeriod(0);
+  EXPECT_DOUBLE_EQ(recorder->KeyframePeriod(), 0);
+
+  // The marker is a comment, ignored by XML parsers
+  const std::string &marker = gazebo::util::LogRecord::DeltaFrameMarker();
+  EXPECT_EQ(0u, marker.find("<!--"));
+  EXPECT_EQ(marker.size() - 3, marker.rfind("-->"));
+}
+
 /////////////////////////////////////////////////
 /// \brief Test LogRecord record resources
 TEST_F(LogRecord_TEST, RecordResources)
@@ -226,6 +252,72 @@ TEST_F(LogRecord_TEST, RecordResources)
   EXPECT_FALSE(recorder->RecordResources());
 }
 
+/////////////////////////////////////////////////
+/// \brief Test LogRecord recorded topics
+TEST_F(LogRecord_TEST, Topics)
+{
+  gazebo::util::LogRecord *recorder = gazebo::util::LogRecord::Instance();
+
+  // check default values
+  EXPECT_TRUE(recorder->Topics().empty());
+  EXPECT_EQ("topics.log", gazebo::util::LogRecord::TopicLogFilename());
+
+  std::vector<std::string> topics = {"~/camera/image", "/gazebo/scan"};
+  recorder->SetTopics(topics);
+  EXPECT_EQ(topics, recorder->Topics());
+
+  recorder->SetTopics({});
+  EXPECT_TRUE(recorder->Topics().empty());
+}
+
+/////////////////////////////////////////////////
+/// \brief Test the recording queue parameters and status
+TEST_F(LogRecord_TEST, Queue)
+{
+  gazebo::util::LogRecord *recorder = gazebo::util::LogRecord::Instance();
+
+  // check default values
+  EXPECT_EQ(0u, recorder->QueueSize());
+  EXPECT_TRUE(recorder->DropOnOverflow());
+  EXPECT_EQ(0u, recorder->QueuedStates());
+  EXPECT_EQ(0u, recorder->DroppedStates());
+  EXPECT_EQ(gazebo::common::Time::Zero, recorder->RecordLag());
+
+  recorder->SetQueueSize(64);
+  EXPECT_EQ(64u, recorder->QueueSize());
+  recorder->SetDropOnOverflow(false);
+  EXPECT_FALSE(recorder->DropOnOverflow());
+
+  recorder->SetQueueStatus(3, 12, gazebo::common::Time(0, 5000000));
+  EXPECT_EQ(3u, recorder->QueuedStates());
+  EXPECT_EQ(12u, recorder->DroppedStates());
+  EXPECT_EQ(gazebo::common::Time(0, 5000000), recorder->RecordLag());
+
+  recorder->SetQueueSize(0);
+  recorder->SetDropOnOverflow(true);
+  recorder->SetQueueStatus(0, 0, gazebo::common::Time::Zero);
+}
+
+/////////////////////////////////////////////////
+/// \brief Test the frame index of a chunk
+TEST_F(LogRecord_TEST, FrameIndex)
+{
+  EXPECT_TRUE(gazebo::util::LogRecord::FrameIndex("").empty());
+
+  // The world description has no simulation time and is not indexed
+  std::string world = "<sdf version='1.6'><world name='default'/></sdf>\n";
+  EXPECT_TRUE(gazebo::util::LogRecord::FrameIndex(world).empty());
+
+  std::string state = "<sdf version='1.6'><state world_name='default'>"
+    "<sim_time>1 500</sim_time><iterations>7</iterations></state></sdf>\n";
+  EXPECT_EQ("49 1 500 7 163 1 500 7",
+      gazebo::util::LogRecord::FrameIndex(world + state + state));
+
+  // Old states have no iterations
+  EXPECT_EQ("0 2 0 0", gazebo::util::LogRecord::FrameIndex(
+        "<sdf version='1.6'><state><sim_time>2 0</sim_time></state></sdf>"));
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
@@ -0,0 +1,297 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <boost/version.hpp>
+#if BOOST_VERSION < 106600
+#include <boost/uuid/sha1.hpp>
+#else
+#include <boost/uuid/detail/sha1.hpp>
+#endif
+
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/util/LogResourceStorePrivate.hh"
+#include "gazebo/util/LogResourceStore.hh"
+
+using namespace gazebo;
+using namespace util;
+
+namespace fs = boost::filesystem;
+
+/////////////////////////////////////////////////
+LogResourceStore::LogResourceStore()
+: dataPtr(new LogResourceStorePrivate)
+{
+}
+
+/////////////////////////////////////////////////
+LogResourceStore::~LogResourceStore()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->stop = true;
+    this->dataPtr->queueCondition.notify_all();
+  }
+
+  if (this->dataPtr->thread.joinable())
+    this->dataPtr->thread.join();
+}
+
+/////////////////////////////////////////////////
+void LogResourceStore::SetPath(const std::string &_path)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->path = _path;
+}
+
+/////////////////////////////////////////////////
+std::string LogResourceStore::Path() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->path.string();
+}
+
+/////////////////////////////////////////////////
+void LogResourceStore::Add(const std::string &_source,
+    const std::string &_destination)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->queue.emplace_back(_source, _destination);
+  ++this->dataPtr->pending;
+
+  if (!this->dataPtr->thread.joinable())
+  {
+    this->dataPtr->thread =
+      std::thread(&LogResourceStorePrivate::Run, this->dataPtr.get());
+  }
+  this->dataPtr->queueCondition.notify_one();
+}
+
+/////////////////////////////////////////////////
+void LogResourceStore::Wait()
+{
+  std::unique_lock<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->doneCondition.wait(lock, [this]
+      {
+        return this->dataPtr->pending == 0;
+      });
+}
+
+/////////////////////////////////////////////////
+unsigned int LogResourceStore::Pending() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->pending;
+}
+
+/////////////////////////////////////////////////
+uint64_t LogResourceStore::HashedFiles() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->hashed;
+}
+
+/////////////////////////////////////////////////
+std::string LogResourceStore::FileHash(const std::string &_filename)
+{
+  std::ifstream file(_filename, std::ios::binary);
+  if (!file)
+    return "";
+
+  boost::uuids::detail::sha1 sha1;
+  std::vector<char> block(1 << 16);
+  while (file)
+  {
+    file.read(block.data(), block.size());
+    if (file.gcount() > 0)
+      sha1.process_bytes(block.data(), file.gcount());
+  }
+  if (file.bad())
+    return "";
+
+  unsigned int hash[5];
+  sha1.get_digest(hash);
+
+  std::ostringstream stream;
+  for (std::size_t i = 0; i < sizeof(hash) / sizeof(hash[0]); ++i)
+  {
+    stream << std::setfill('0') << std::setw(sizeof(hash[0]) * 2)
+      << std::hex << hash[i];
+  }
+  return stream.str();
+}
+
+/////////////////////////////////////////////////
+void LogResourceStorePrivate::Run()
+{
+  std::unique_lock<std::mutex> lock(this->mutex);
+  while (true)
+  {
+    this->queueCondition.wait(lock, [this]
+        {
+          return this->stop || !this->queue.empty();
+        });
+
+    // The queued resources are saved before stopping.
+    if (this->queue.empty())
+      break;
+
+    const auto resource = this->queue.front();
+    this->queue.pop_front();
+    const fs::path root = this->path;
+
+    lock.unlock();
+    this->Save(root, resource.first, resource.second);
+    lock.lock();
+
+    --this->pending;
+    this->doneCondition.notify_all();
+  }
+}
+
+/////////////////////////////////////////////////
+void LogResourceStorePrivate::Save(const fs::path &_root,
+    const fs::path &_source, const fs::path &_destination)
+{
+  boost::system::error_code ec;
+  if (fs::is_directory(_source, ec))
+  {
+    fs::remove_all(_destination, ec);
+    fs::create_directories(_destination, ec);
+
+    for (fs::recursive_directory_iterator file(_source, ec), end;
+         !ec && file != end; file.increment(ec))
+    {
+      const fs::path relative = fs::relative(file->path(), _source, ec);
+      if (ec)
+        break;
+
+      if (fs::is_directory(file->path()))
+        fs::create_directories(_destination / relative, ec);
+      else if (fs::is_regular_file(file->path()))
+        this->SaveFile(_root, file->path(), _destination / relative);
+    }
+
+    if (ec)
+    {
+      gzerr << "Failed to save model from '" << _source.string()
+        << "' to '" << _destination.string() << "': " << ec.message()
+        << std::endl;
+    }
+  }
+  else
+  {
+    this->SaveFile(_root, _source, _destination);
+  }
+}
+
+/////////////////////////////////////////////////
+bool LogResourceStorePrivate::SaveFile(const fs::path &_root,
+    const fs::path &_source, const fs::path &_destination)
+{
+  const std::string hash = this->Hash(_source);
+  if (hash.empty())
+  {
+    gzerr << "Unable to read file '" << _source.string() << "'" << std::endl;
+    return false;
+  }
+
+  boost::system::error_code ec;
+  const fs::path stored = _root / hash.substr(0, 2) / hash;
+  if (!fs::exists(stored, ec))
+  {
+    // Copy to a temporary file and rename it, so that a partial copy is
+    // never found in the store, even with several servers recording.
+    std::ostringstream tmp;
+    tmp << stored.string() << ".tmp" << std::this_thread::get_id() << "."
+      << std::chrono::steady_clock::now().time_since_epoch().count();
+
+    fs::create_directories(stored.parent_path(), ec);
+    fs::copy_file(_source, tmp.str(), ec);
+    if (!ec)
+    {
+      // The stored files are shared by the logs, which must not modify them.
+      fs::permissions(tmp.str(), fs::owner_read | fs::group_read |
+          fs::others_read, ec);
+      fs::rename(tmp.str(), stored, ec);
+    }
+
+    if (ec)
+    {
+      boost::system::error_code removeError;
+      fs::remove(tmp.str(), removeError);
+      if (!fs::exists(stored, removeError))
+      {
+        gzerr << "Failed to store file '" << _source.string() << "' in '"
+          << _root.string() << "': " << ec.message() << std::endl;
+        return false;
+      }
+    }
+  }
+
+  ec.clear();
+  fs::create_directories(_destination.parent_path(), ec);
+  fs::remove(_destination, ec);
+  fs::create_hard_link(stored, _destination, ec);
+
+  // The store may be on another file system than the log.
+  if (ec)
+  {
+    ec.clear();
+    fs::copy_file(stored, _destination, ec);
+  }
+
+  if (ec)
+  {
+    gzerr << "Failed to copy file from '" << _source.string()
+      << "' to '" << _destination.string() << "': " << ec.message()
+      << std::endl;
+    return false;
+  }
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+std::string LogResourceStorePrivate::Hash(const fs::path &_source)
+{
+  boost::system::error_code ec;
+  const uintmax_t size = fs::file_size(_source, ec);
+  if (ec)
+    return "";
+  const std::time_t time = fs::last_write_time(_source, ec);
+  if (ec)
+    return "";
+
+  FileHash &entry = this->hashes[fs::absolute(_source).string()];
+  if (entry.hash.empty() || entry.size != size || entry.time != time)
+  {
+    entry.size = size;
+    entry.time = time;
+    entry.hash = LogResourceStore::FileHash(_source.string());
+
+    std::lock_guard<std::mutex> lock(this->mutex);
+    ++this->hashed;
+  }
+
+  return entry.hash;
+}
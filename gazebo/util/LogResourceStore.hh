@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_UTIL_LOGRESOURCESTORE_HH_
+#define GAZEBO_UTIL_LOGRESOURCESTORE_HH_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace util
+  {
+    // Forward declare private data class
+    class LogResourceStorePrivate;
+
+    /// \addtogroup gazebo_util
+    /// \{
+
+    /// \class LogResourceStore LogResourceStore.hh util/util.hh
+    /// \brief Content addressed store of the resources saved with logs,
+    /// such as model meshes and materials.
+    ///
+    /// Each file is stored once, under the SHA1 hash of its content, and the
+    /// log directories get hard links to the stored files. A file is copied
+    /// instead when hard links are not possible, e.g. when the store and the
+    /// log are on different file systems. Files are saved by a background
+    /// thread, and are only hashed again when their size or modification
+    /// time changed.
+    /// \sa LogRecord::SaveModels, LogRecord::SaveFiles
+    class GZ_UTIL_VISIBLE LogResourceStore
+    {
+      /// \brief Constructor.
+      public: LogResourceStore();
+
+      /// \brief Destructor, saves the queued resources first.
+      public: virtual ~LogResourceStore();
+
+      /// \brief Set the directory of the store.
+      /// \param[in] _path Path of the directory, created when the first
+      /// file is stored.
+      public: void SetPath(const std::string &_path);
+
+      /// \brief Get the directory of the store.
+      /// \return Path of the directory.
+      public: std::string Path() const;
+
+      /// \brief Queue a resource to save in a log directory.
+      /// \param[in] _source Path of a file, or of a directory to save with
+      /// its content.
+      /// \param[in] _destination Path of the resource in the log directory.
+      /// A directory replaces the previous one.
+      public: void Add(const std::string &_source,
+                  const std::string &_destination);
+
+      /// \brief Wait for the queued resources to be saved.
+      public: void Wait();
+
+      /// \brief Get the number of resources queued or being saved.
+      /// \return Number of resources.
+      public: unsigned int Pending() const;
+
+      /// \brief Get the number of files hashed since the store was created.
+      /// Unchanged files saved again are not hashed again.
+      /// \return Number of files.
+      public: uint64_t HashedFiles() const;
+
+      /// \brief Get the SHA1 hash of the content of a file, read in blocks.
+      /// \param[in] _filename Path of the file.
+      /// \return The hash as 40 hexadecimal characters, empty if the file
+      /// could not be read.
+      public: static std::string FileHash(const std::string &_filename);
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<LogResourceStorePrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_UTIL_LOGRESOURCESTOREPRIVATE_HH_
+#define GAZEBO_UTIL_LOGRESOURCESTOREPRIVATE_HH_
+
+#include <condition_variable>
+#include <cstdint>
+#include <ctime>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include <boost/filesystem.hpp>
+
+namespace gazebo
+{
+  namespace util
+  {
+    /// \internal
+    /// \brief Private data for LogResourceStore.
+    class LogResourceStorePrivate
+    {
+      /// \brief Hash of a file, valid while the file is unchanged.
+      public: class FileHash
+      {
+        /// \brief Size of the file when it was hashed.
+        public: uintmax_t size = 0;
+
+        /// \brief Modification time of the file when it was hashed.
+        public: std::time_t time = 0;
+
+        /// \brief The hash.
+        public: std::string hash;
+      };
+
+      /// \brief Thread function that saves the queued resources.
+      public: void Run();
+
+      /// \brief Save a file or a directory.
+      /// \param[in] _root Directory of the store.
+      /// \param[in] _source Path of the resource.
+      /// \param[in] _destination Path of the resource in the log directory.
+      public: void Save(const boost::filesystem::path &_root,
+                  const boost::filesystem::path &_source,
+                  const boost::filesystem::path &_destination);
+
+      /// \brief Store a file, and link it in a log directory.
+      /// \param[in] _root Directory of the store.
+      /// \param[in] _source Path of the file.
+      /// \param[in] _destination Path of the link.
+      /// \return False on error.
+      public: bool SaveFile(const boost::filesystem::path &_root,
+                  const boost::filesystem::path &_source,
+                  const boost::filesystem::path &_destination);
+
+      /// \brief Get the hash of a file, from the cache if the file did not
+      /// change. Only used by the saving thread.
+      /// \param[in] _source Path of the file.
+      /// \return The hash, empty on error.
+      public: std::string Hash(const boost::filesystem::path &_source);
+
+      /// \brief Directory of the store.
+      public: boost::filesystem::path path;
+
+      /// \brief Resources to save, source and destination.
+      public: std::deque<std::pair<std::string, std::string>> queue;
+
+      /// \brief Hashes of the files saved, by path. Only used by the saving
+      /// thread.
+      public: std::map<std::string, FileHash> hashes;
+
+      /// \brief Number of files hashed.
+      public: uint64_t hashed = 0;
+
+      /// \brief Number of resources queued or being saved.
+      public: unsigned int pending = 0;
+
+      /// \brief The saving thread, started with the first resource.
+      public: std::thread thread;
+
+      /// \brief True to stop the thread.
+      public: bool stop = false;
+
+      /// \brief Protects the members.
+      public: mutable std::mutex mutex;
+
+      /// \brief Signaled when resources are queued, or to stop the thread.
+      public: std::condition_variable queueCondition;
+
+      /// \brief Signaled when a resource is saved.
+      public: std::condition_variable doneCondition;
+    };
+  }
+}
+#endif
@@ -0,0 +1,158 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "gazebo/util/LogResourceStore.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class LogResourceStore_TEST : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+/// \brief Write a file.
+/// \param[in] _path Path of the file.
+/// \param[in] _content Content of the file.
+static void write_file(const boost::filesystem::path &_path,
+    const std::string &_content)
+{
+  boost::filesystem::create_directories(_path.parent_path());
+  std::ofstream file(_path.string(), std::ios::binary);
+  file << _content;
+}
+
+/////////////////////////////////////////////////
+/// \brief Read a file.
+/// \param[in] _path Path of the file.
+/// \return Content of the file.
+static std::string read_file(const boost::filesystem::path &_path)
+{
+  std::ifstream file(_path.string(), std::ios::binary);
+  std::ostringstream stream;
+  stream << file.rdbuf();
+  return stream.str();
+}
+
+/////////////////////////////////////////////////
+/// \brief Test hashing files.
+TEST_F(LogResourceStore_TEST, FileHash)
+{
+  std::ostringstream stream;
+  stream << "/tmp/__gz_log_resource_hash_test" << std::this_thread::get_id();
+  boost::filesystem::path dir(stream.str());
+  boost::filesystem::remove_all(dir);
+
+  EXPECT_TRUE(util::LogResourceStore::FileHash(
+        (dir / "missing").string()).empty());
+
+  write_file(dir / "empty", "");
+  EXPECT_EQ("da39a3ee5e6b4b0d3255bfef95601890afd80709",
+      util::LogResourceStore::FileHash((dir / "empty").string()));
+
+  write_file(dir / "abc", "abc");
+  EXPECT_EQ("a9993e364706816aba3e25717850c26c9cd0d89d",
+      util::LogResourceStore::FileHash((dir / "abc").string()));
+
+  // Larger than a block
+  write_file(dir / "large", std::string(100000, 'a'));
+  EXPECT_EQ(40u, util::LogResourceStore::FileHash(
+        (dir / "large").string()).size());
+
+  boost::filesystem::remove_all(dir);
+}
+
+/////////////////////////////////////////////////
+/// \brief Test saving resources in two logs.
+TEST_F(LogResourceStore_TEST, Save)
+{
+  std::ostringstream stream;
+  stream << "/tmp/__gz_log_resource_test" << std::this_thread::get_id();
+  boost::filesystem::path dir(stream.str());
+  boost::filesystem::remove_all(dir);
+
+  write_file(dir / "models" / "robot" / "model.config", "config");
+  write_file(dir / "models" / "robot" / "meshes" / "base.dae", "mesh");
+  write_file(dir / "models" / "robot" / "meshes" / "copy.dae", "mesh");
+  write_file(dir / "box.stl", "box");
+
+  util::LogResourceStore store;
+  EXPECT_TRUE(store.Path().empty());
+  store.SetPath((dir / "store").string());
+  EXPECT_EQ((dir / "store").string(), store.Path());
+  EXPECT_EQ(0u, store.Pending());
+
+  for (auto const &log : {"log1", "log2"})
+  {
+    store.Add((dir / "models" / "robot").string(),
+        (dir / log / "robot").string());
+    store.Add((dir / "box.stl").string(),
+        (dir / log / "res" / "box.stl").string());
+  }
+  store.Add((dir / "missing").string(), (dir / "log1" / "missing").string());
+  store.Wait();
+  EXPECT_EQ(0u, store.Pending());
+
+  for (auto const &log : {"log1", "log2"})
+  {
+    EXPECT_EQ("config", read_file(dir / log / "robot" / "model.config"));
+    EXPECT_EQ("mesh", read_file(dir / log / "robot" / "meshes" / "base.dae"));
+    EXPECT_EQ("mesh", read_file(dir / log / "robot" / "meshes" / "copy.dae"));
+    EXPECT_EQ("box", read_file(dir / log / "res" / "box.stl"));
+  }
+  EXPECT_FALSE(boost::filesystem::exists(dir / "log1" / "missing"));
+
+  // Each file was hashed once, and each content stored once
+  EXPECT_EQ(4u, store.HashedFiles());
+  unsigned int stored = 0;
+  for (boost::filesystem::recursive_directory_iterator file(dir / "store"),
+       end; file != end; ++file)
+  {
+    if (boost::filesystem::is_regular_file(file->path()))
+      ++stored;
+  }
+  EXPECT_EQ(3u, stored);
+
+#ifndef _WIN32
+  // The logs link to the stored files
+  EXPECT_EQ(5u, boost::filesystem::hard_link_count(
+        dir / "log1" / "robot" / "meshes" / "base.dae"));
+#endif
+
+  // A changed file is hashed again
+  write_file(dir / "box.stl", "a larger box");
+  store.Add((dir / "box.stl").string(),
+      (dir / "log2" / "res" / "box.stl").string());
+  store.Wait();
+  EXPECT_EQ(5u, store.HashedFiles());
+  EXPECT_EQ("a larger box", read_file(dir / "log2" / "res" / "box.stl"));
+  EXPECT_EQ("box", read_file(dir / "log1" / "res" / "box.stl"));
+
+  boost::filesystem::remove_all(dir);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
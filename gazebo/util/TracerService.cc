@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <boost/filesystem.hpp>
+#include <ignition/transport.hh>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/common/SystemPaths.hh"
+#include "gazebo/common/Time.hh"
+#include "gazebo/common/Tracer.hh"
+#include "gazebo/util/TracerServicePrivate.hh"
+#include "gazebo/util/TracerService.hh"
+
+using namespace gazebo;
+using namespace util;
+
+//////////////////////////////////////////////////
+TracerService::TracerService(const std::string &_name)
+  : dataPtr(new TracerServicePrivate)
+{
+  this->dataPtr->name = _name;
+  this->dataPtr->prefix = "/gazebo/" + _name + "/tracer/";
+
+  std::string service = this->dataPtr->prefix + "enable";
+  if (!this->dataPtr->node.Advertise(service, &TracerService::OnEnable, this))
+    gzerr << "Error advertising service [" << service << "]" << std::endl;
+
+  service = this->dataPtr->prefix + "dump";
+  if (!this->dataPtr->node.Advertise(service, &TracerService::OnDump, this))
+    gzerr << "Error advertising service [" << service << "]" << std::endl;
+}
+
+//////////////////////////////////////////////////
+TracerService::~TracerService()
+{
+}
+
+//////////////////////////////////////////////////
+std::string TracerService::Prefix() const
+{
+  return this->dataPtr->prefix;
+}
+
+//////////////////////////////////////////////////
+bool TracerService::OnEnable(const gazebo::msgs::Any &_req,
+    gazebo::msgs::Empty &/*_rep*/)
+{
+  if (_req.type() != gazebo::msgs::Any::BOOLEAN || !_req.has_bool_value())
+  {
+    gzwarn << "Expected a BOOLEAN value to enable the tracer." << std::endl;
+    return false;
+  }
+
+  common::Tracer::Instance()->SetEnabled(_req.bool_value());
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool TracerService::OnDump(const gazebo::msgs::GzString &_req,
+    gazebo::msgs::GzString &_rep)
+{
+  std::string filename = _req.data();
+  if (filename.empty())
+  {
+    // E.g. ~/.gazebo/trace-server-2026-10-14T10:20:30.123456.json
+    boost::filesystem::path path(
+        common::SystemPaths::Instance()->GetLogPath());
+    path /= "trace-" + this->dataPtr->name + "-" +
+      common::Time::GetWallTimeAsISOString() + ".json";
+    filename = path.string();
+  }
+
+  if (!common::Tracer::Instance()->Dump(filename))
+    return false;
+
+  _rep.set_data(filename);
+  return true;
+}
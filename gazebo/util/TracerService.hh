@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_UTIL_TRACERSERVICE_HH_
+#define GAZEBO_UTIL_TRACERSERVICE_HH_
+
+#include <memory>
+#include <string>
+
+#include "gazebo/msgs/any.pb.h"
+#include "gazebo/msgs/empty.pb.h"
+#include "gazebo/msgs/gz_string.pb.h"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace util
+  {
+    // Forward declare private data class.
+    class TracerServicePrivate;
+
+    /// addtogroup gazebo_util
+    /// \{
+
+    /// \class TracerService TracerService.hh util/util.hh
+    /// \brief Services controlling the common::Tracer of the process:
+    ///   - /gazebo/<name>/tracer/enable, with a BOOLEAN msgs::Any
+    ///     request, enables or disables tracing.
+    ///   - /gazebo/<name>/tracer/dump, with a msgs::GzString request with
+    ///     the path of the file, writes the trace in the Chrome trace event
+    ///     format. With an empty path the file is written to the log
+    ///     directory. The response has the path of the file.
+    class GZ_UTIL_VISIBLE TracerService
+    {
+      /// \brief Constructor, advertises the services.
+      /// \param[in] _name Name of the process in the services, e.g.
+      /// "server".
+      public: explicit TracerService(const std::string &_name);
+
+      /// \brief Destructor.
+      public: virtual ~TracerService();
+
+      /// \brief Get the prefix of the services.
+      /// \return E.g. "/gazebo/server/tracer/".
+      public: std::string Prefix() const;
+
+      /// \brief Callback of the enable service.
+      /// \param[in] _req Request, a BOOLEAN value.
+      /// \param[out] _rep Not used.
+      /// \return True if the request was valid.
+      private: bool OnEnable(const gazebo::msgs::Any &_req,
+                   gazebo::msgs::Empty &_rep);
+
+      /// \brief Callback of the dump service.
+      /// \param[in] _req Path of the file, may be empty.
+      /// \param[out] _rep Path of the file written.
+      /// \return True if the file was written.
+      private: bool OnDump(const gazebo::msgs::GzString &_req,
+                   gazebo::msgs::GzString &_rep);
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<TracerServicePrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
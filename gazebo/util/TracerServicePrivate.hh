@@ -0,0 +1,42 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_UTIL_TRACERSERVICEPRIVATE_HH_
+#define GAZEBO_UTIL_TRACERSERVICEPRIVATE_HH_
+
+#include <string>
+#include <ignition/transport.hh>
+
+namespace gazebo
+{
+  namespace util
+  {
+    /// \internal
+    /// \brief Private data for the TracerService class.
+    class TracerServicePrivate
+    {
+      /// \brief Node used for the services.
+      public: ignition::transport::Node node;
+
+      /// \brief Name of the process.
+      public: std::string name;
+
+      /// \brief Prefix of the services.
+      public: std::string prefix;
+    };
+  }
+}
+#endif
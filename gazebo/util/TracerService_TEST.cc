@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <boost/filesystem.hpp>
+#include <ignition/transport.hh>
+
+#include "gazebo/common/Tracer.hh"
+#include "gazebo/msgs/any.pb.h"
+#include "gazebo/msgs/empty.pb.h"
+#include "gazebo/msgs/gz_string.pb.h"
+#include "gazebo/util/TracerService.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class TracerServiceTest : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+TEST_F(TracerServiceTest, EnableAndDump)
+{
+  util::TracerService service("test");
+  EXPECT_EQ("/gazebo/test/tracer/", service.Prefix());
+
+  ignition::transport::Node node;
+  const unsigned int timeout = 2000;
+  bool result = false;
+
+  // Enable the tracer
+  msgs::Any enable;
+  enable.set_type(msgs::Any::BOOLEAN);
+  enable.set_bool_value(true);
+  msgs::Empty empty;
+  EXPECT_TRUE(node.Request(service.Prefix() + "enable", enable, timeout,
+        empty, result));
+  EXPECT_TRUE(result);
+  EXPECT_TRUE(common::Tracer::Enabled());
+
+  {
+    GZ_TRACE_SCOPE("TracerServiceTest::EnableAndDump");
+  }
+
+  // The request must be a boolean
+  msgs::Any invalid;
+  invalid.set_type(msgs::Any::STRING);
+  invalid.set_string_value("true");
+  EXPECT_TRUE(node.Request(service.Prefix() + "enable", invalid, timeout,
+        empty, result));
+  EXPECT_FALSE(result);
+  EXPECT_TRUE(common::Tracer::Enabled());
+
+  // Dump the trace
+  boost::filesystem::path path = boost::filesystem::temp_directory_path() /
+    boost::filesystem::unique_path("gz_trace_%%%%%%.json");
+  msgs::GzString filename;
+  filename.set_data(path.string());
+  msgs::GzString written;
+  EXPECT_TRUE(node.Request(service.Prefix() + "dump", filename, timeout,
+        written, result));
+  EXPECT_TRUE(result);
+  EXPECT_EQ(path.string(), written.data());
+  EXPECT_TRUE(boost::filesystem::exists(path));
+  EXPECT_LT(0u, boost::filesystem::file_size(path));
+  boost::filesystem::remove(path);
+
+  // Disable the tracer
+  enable.set_bool_value(false);
+  EXPECT_TRUE(node.Request(service.Prefix() + "enable", enable, timeout,
+        empty, result));
+  EXPECT_TRUE(result);
+  EXPECT_FALSE(common::Tracer::Enabled());
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,37 @@
+// This fragment shader converts a rendered RGB image to a Bayer mosaic. It's
+// intended to be drawn by Ogre's Compositor framework into a single channel
+// render target, so that only one byte per pixel is read back from the GPU
+// instead of converting the RGB image on the CPU.
+//
+// Each pixel of the mosaic keeps one channel of the input image, chosen by
+// the parity of its column and row. Red pixels are at the parity given in
+// `redOffset`, blue pixels at the other parity in both directions, and green
+// pixels everywhere else.
+
+// The RGB image of the camera.
+uniform sampler2D RT;
+
+// Other parameters are set in C++, via
+// Ogre::GpuProgramParameters::setNamedConstant()
+
+// Image size in pixels.
+uniform vec2 size;
+// Column and row parity (0 or 1) of the red pixels.
+uniform vec2 redOffset;
+
+void main()
+{
+  vec3 color = texture2D(RT, gl_TexCoord[0].xy).rgb;
+
+  // Number of directions in which the parity differs from the red pixels
+  vec2 parity = mod(floor(gl_TexCoord[0].xy * size), 2.0);
+  float diff = dot(abs(parity - redOffset), vec2(1.0, 1.0));
+
+  float value = color.g;
+  if (diff < 0.5)
+    value = color.r;
+  else if (diff > 1.5)
+    value = color.b;
+
+  gl_FragColor = vec4(value, value, value, 1.0);
+}
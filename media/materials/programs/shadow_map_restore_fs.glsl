@@ -0,0 +1,22 @@
+// This fragment shader copies a cached shadow map of the static casters
+// into a shadow texture, before the other casters are rendered on top of it.
+// The depth buffer is written too, so that the casters behind the static
+// ones keep failing the depth test.
+//
+// The shadow casters write the normalized device depth in the red channel,
+// see shadow_caster_fp.glsl.
+
+// The cached shadow map.
+uniform sampler2D cache;
+
+// Viewport size, as width, height, 1 / width and 1 / height.
+uniform vec4 viewportSize;
+
+void main()
+{
+  // The cache has the size of the shadow texture, copy texel to texel
+  float depth = texture2D(cache, gl_FragCoord.xy * viewportSize.zw).r;
+
+  gl_FragColor = vec4(depth, depth, depth, 1.0);
+  gl_FragDepth = depth * 0.5 + 0.5;
+}
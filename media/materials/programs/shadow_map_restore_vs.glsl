@@ -0,0 +1,6 @@
+// Simple vertex shader for the fullscreen quad that copies a cached shadow
+// map, see shadow_map_restore_fs.glsl.
+void main()
+{
+  gl_Position = gl_ModelViewProjectionMatrix * gl_Vertex;
+}
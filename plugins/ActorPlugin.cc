@@ -15,23 +15,275 @@
  *
 */
 
+#include <algorithm>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
 #include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
 
 #include <ignition/math.hh>
 #include <ignition/common/Profiler.hh>
 #include "gazebo/physics/physics.hh"
 #include "plugins/ActorPlugin.hh"
 
+namespace gazebo
+{
+  /// \brief Positions of the models of a world, hashed in a uniform grid of
+  /// the ground plane. A grid is built once per world iteration, and shared
+  /// by all the actor plugins of the world. It is not changed once built, so
+  /// it may be read by the navigation worker thread.
+  class ActorModelGrid
+  {
+    /// \brief Get the grid of the current iteration of a world, building
+    /// it if needed.
+    /// \param[in] _world The world.
+    /// \return The grid.
+    public: static std::shared_ptr<const ActorModelGrid> Get(
+                const physics::WorldPtr &_world);
+
+    /// \brief Visit the models closer than a distance to a point.
+    /// \param[in] _center The point.
+    /// \param[in] _radius The distance.
+    /// \param[in] _visit Function called with the name and position of
+    /// each model closer than _radius.
+    public: void Query(const ignition::math::Vector3d &_center,
+                const double _radius,
+                const std::function<void (const std::string &_name,
+                  const ignition::math::Vector3d &_pos)> &_visit) const;
+
+    /// \brief Key of the cell which contains a position.
+    /// \param[in] _x Cell column.
+    /// \param[in] _y Cell row.
+    /// \return The key.
+    private: static int64_t Key(const int64_t _x, const int64_t _y);
+
+    /// \brief Cell of a coordinate.
+    /// \param[in] _value The coordinate.
+    /// \return Index of the cell along the coordinate's axis.
+    private: static int64_t Cell(const double _value);
+
+    /// \brief Size of the cells, the largest distance the actors query.
+    private: static constexpr double kCellSize = 4.0;
+
+    /// \brief Names of the models.
+    private: std::vector<std::string> names;
+
+    /// \brief Positions of the models.
+    private: std::vector<ignition::math::Vector3d> positions;
+
+    /// \brief Indices of the models in each cell, by cell key.
+    private: std::unordered_map<int64_t, std::vector<size_t>> cells;
+  };
+
+  /// \brief Thread computing the poses of the actors which navigate off the
+  /// physics thread. The actor plugins share one worker, which stops when
+  /// the last of them is destroyed.
+  class ActorNavigationWorker
+  {
+    /// \brief Get the shared worker, starting it if needed.
+    /// \return The worker.
+    public: static std::shared_ptr<ActorNavigationWorker> Get();
+
+    /// \brief Destructor, stops the thread.
+    public: ~ActorNavigationWorker();
+
+    /// \brief Queue the computation of a pose.
+    /// \param[in] _job Function computing the pose.
+    /// \return The pose, once computed.
+    public: std::future<ignition::math::Pose3d> Push(
+                const std::function<ignition::math::Pose3d ()> &_job);
+
+    /// \brief Thread function.
+    private: void Run();
+
+    /// \brief The thread.
+    private: std::thread thread;
+
+    /// \brief Mutex to protect the jobs and stop flag.
+    private: std::mutex mutex;
+
+    /// \brief Notified when a job is queued or the thread must stop.
+    private: std::condition_variable condition;
+
+    /// \brief Queued jobs.
+    private: std::deque<std::function<void ()>> jobs;
+
+    /// \brief True to stop the thread.
+    private: bool stop = false;
+  };
+}
+
 using namespace gazebo;
 GZ_REGISTER_MODEL_PLUGIN(ActorPlugin)
 
 #define WALKING_ANIMATION "walking"
 
+/////////////////////////////////////////////////
+std::shared_ptr<const ActorModelGrid> ActorModelGrid::Get(
+    const physics::WorldPtr &_world)
+{
+  // Last grid built for each world
+  static std::mutex mutex;
+  static std::map<std::string,
+      std::pair<uint32_t, std::shared_ptr<const ActorModelGrid>>> grids;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  auto &entry = grids[_world->Name()];
+  if (entry.second && entry.first == _world->Iterations())
+    return entry.second;
+
+  IGN_PROFILE("ActorModelGrid::Get");
+
+  auto grid = std::make_shared<ActorModelGrid>();
+  const unsigned int count = _world->ModelCount();
+  grid->names.reserve(count);
+  grid->positions.reserve(count);
+  for (unsigned int i = 0; i < count; ++i)
+  {
+    physics::ModelPtr model = _world->ModelByIndex(i);
+    if (!model)
+      continue;
+
+    const ignition::math::Vector3d pos = model->WorldPose().Pos();
+    grid->cells[Key(Cell(pos.X()), Cell(pos.Y()))].push_back(
+        grid->names.size());
+    grid->names.push_back(model->GetName());
+    grid->positions.push_back(pos);
+  }
+
+  entry.first = _world->Iterations();
+  entry.second = grid;
+  return grid;
+}
+
+/////////////////////////////////////////////////
+void ActorModelGrid::Query(const ignition::math::Vector3d &_center,
+    const double _radius,
+    const std::function<void (const std::string &_name,
+      const ignition::math::Vector3d &_pos)> &_visit) const
+{
+  const int64_t minX = Cell(_center.X() - _radius);
+  const int64_t maxX = Cell(_center.X() + _radius);
+  const int64_t minY = Cell(_center.Y() - _radius);
+  const int64_t maxY = Cell(_center.Y() + _radius);
+
+  for (int64_t x = minX; x <= maxX; ++x)
+  {
+    for (int64_t y = minY; y <= maxY; ++y)
+    {
+      auto cell = this->cells.find(Key(x, y));
+      if (cell == this->cells.end())
+        continue;
+
+      for (const size_t index : cell->second)
+      {
+        if ((this->positions[index] - _center).Length() < _radius)
+          _visit(this->names[index], this->positions[index]);
+      }
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+int64_t ActorModelGrid::Key(const int64_t _x, const int64_t _y)
+{
+  return static_cast<int64_t>((static_cast<uint64_t>(_x) << 32) ^
+      (static_cast<uint64_t>(_y) & 0xffffffffu));
+}
+
+/////////////////////////////////////////////////
+int64_t ActorModelGrid::Cell(const double _value)
+{
+  return static_cast<int64_t>(std::floor(_value / kCellSize));
+}
+
+/////////////////////////////////////////////////
+std::shared_ptr<ActorNavigationWorker> ActorNavigationWorker::Get()
+{
+  static std::mutex mutex;
+  static std::weak_ptr<ActorNavigationWorker> shared;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  std::shared_ptr<ActorNavigationWorker> worker = shared.lock();
+  if (!worker)
+  {
+    worker = std::make_shared<ActorNavigationWorker>();
+    worker->thread = std::thread(&ActorNavigationWorker::Run, worker.get());
+    shared = worker;
+  }
+  return worker;
+}
+
+/////////////////////////////////////////////////
+ActorNavigationWorker::~ActorNavigationWorker()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->stop = true;
+  }
+  this->condition.notify_all();
+  if (this->thread.joinable())
+    this->thread.join();
+}
+
+/////////////////////////////////////////////////
+std::future<ignition::math::Pose3d> ActorNavigationWorker::Push(
+    const std::function<ignition::math::Pose3d ()> &_job)
+{
+  auto task =
+      std::make_shared<std::packaged_task<ignition::math::Pose3d ()>>(_job);
+  std::future<ignition::math::Pose3d> result = task->get_future();
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->jobs.push_back([task]() {(*task)();});
+  }
+  this->condition.notify_one();
+  return result;
+}
+
+/////////////////////////////////////////////////
+void ActorNavigationWorker::Run()
+{
+  std::unique_lock<std::mutex> lock(this->mutex);
+  while (true)
+  {
+    this->condition.wait(lock, [this]
+        {
+          return this->stop || !this->jobs.empty();
+        });
+
+    // Finish the queued jobs before stopping, their plugins wait for them
+    if (this->jobs.empty())
+      return;
+
+    std::function<void ()> job = this->jobs.front();
+    this->jobs.pop_front();
+
+    lock.unlock();
+    job();
+    lock.lock();
+  }
+}
+
 /////////////////////////////////////////////////
 ActorPlugin::ActorPlugin()
 {
 }
 
+/////////////////////////////////////////////////
+ActorPlugin::~ActorPlugin()
+{
+  this->connections.clear();
+  this->FinishNavigation(false);
+}
+
 /////////////////////////////////////////////////
 void ActorPlugin::Load(physics::ModelPtr _model, sdf::ElementPtr _sdf)
 {
@@ -62,6 +314,11 @@ void ActorPlugin::Load(physics::ModelPtr _model, sdf::ElementPtr _sdf)
   else
     this->animationFactor = 4.5;
 
+  // Optionally compute the navigation on a worker thread. The pose computed
+  // during a world update is applied at the beginning of the next one.
+  if (_sdf->HasElement("threaded") && _sdf->Get<bool>("threaded"))
+    this->navigationWorker = ActorNavigationWorker::Get();
+
   // Add our own name to models we should ignore when avoiding obstacles.
   this->ignoreModels.push_back(this->actor->GetName());
 
@@ -81,6 +338,9 @@ void ActorPlugin::Load(physics::ModelPtr _model, sdf::ElementPtr _sdf)
 /////////////////////////////////////////////////
 void ActorPlugin::Reset()
 {
+  // Discard the pose computed before the reset
+  this->FinishNavigation(false);
+
   this->velocity = 0.8;
   this->lastUpdate = 0;
 
@@ -106,7 +366,7 @@ void ActorPlugin::Reset()
 }
 
 /////////////////////////////////////////////////
-void ActorPlugin::ChooseNewTarget()
+void ActorPlugin::ChooseNewTarget(const ActorModelGrid &_grid)
 {
   ignition::math::Vector3d newTarget(this->target);
   while ((newTarget - this->target).Length() < 2.0)
@@ -114,41 +374,37 @@ void ActorPlugin::ChooseNewTarget()
     newTarget.X(ignition::math::Rand::DblUniform(-3, 3.5));
     newTarget.Y(ignition::math::Rand::DblUniform(-10, 2));
 
-    for (unsigned int i = 0; i < this->world->ModelCount(); ++i)
-    {
-      double dist = (this->world->ModelByIndex(i)->WorldPose().Pos()
-          - newTarget).Length();
-      if (dist < 2.0)
-      {
-        newTarget = this->target;
-        break;
-      }
-    }
+    bool blocked = false;
+    _grid.Query(newTarget, 2.0,
+        [&blocked](const std::string &, const ignition::math::Vector3d &)
+        {
+          blocked = true;
+        });
+    if (blocked)
+      newTarget = this->target;
   }
   this->target = newTarget;
 }
 
 /////////////////////////////////////////////////
-void ActorPlugin::HandleObstacles(ignition::math::Vector3d &_pos)
+void ActorPlugin::HandleObstacles(const ActorModelGrid &_grid,
+    const ignition::math::Vector3d &_actorPos, ignition::math::Vector3d &_pos)
 {
-  for (unsigned int i = 0; i < this->world->ModelCount(); ++i)
-  {
-    physics::ModelPtr model = this->world->ModelByIndex(i);
-    if (std::find(this->ignoreModels.begin(), this->ignoreModels.end(),
-          model->GetName()) == this->ignoreModels.end())
-    {
-      ignition::math::Vector3d offset = model->WorldPose().Pos() -
-        this->actor->WorldPose().Pos();
-      double modelDist = offset.Length();
-      if (modelDist < 4.0)
+  _grid.Query(_actorPos, 4.0,
+      [&](const std::string &_name, const ignition::math::Vector3d &_modelPos)
       {
-        double invModelDist = this->obstacleWeight / modelDist;
+        if (std::find(this->ignoreModels.begin(), this->ignoreModels.end(),
+              _name) != this->ignoreModels.end())
+        {
+          return;
+        }
+
+        ignition::math::Vector3d offset = _modelPos - _actorPos;
+        double invModelDist = this->obstacleWeight / offset.Length();
         offset.Normalize();
         offset *= invModelDist;
         _pos -= offset;
-      }
-    }
-  }
+      });
 }
 
 /////////////////////////////////////////////////
@@ -160,9 +416,37 @@ void ActorPlugin::OnUpdate(const common::UpdateInfo &_info)
   // Time delta
   double dt = (_info.simTime - this->lastUpdate).Double();
 
-  ignition::math::Pose3d pose = this->actor->WorldPose();
-  ignition::math::Vector3d pos = this->target - pose.Pos();
-  ignition::math::Vector3d rpy = pose.Rot().Euler();
+  std::shared_ptr<const ActorModelGrid> grid =
+      ActorModelGrid::Get(this->world);
+
+  if (this->navigationWorker)
+  {
+    // Apply the pose computed during the previous update, and compute the
+    // next one while the world updates.
+    this->FinishNavigation(true);
+
+    ignition::math::Pose3d pose = this->actor->WorldPose();
+    this->navigation = this->navigationWorker->Push(
+        [this, grid, pose, dt]()
+        {
+          return this->Navigate(*grid, pose, dt);
+        });
+  }
+  else
+  {
+    this->ApplyPose(this->Navigate(*grid, this->actor->WorldPose(), dt));
+  }
+
+  this->lastUpdate = _info.simTime;
+  IGN_PROFILE_END();
+}
+
+/////////////////////////////////////////////////
+ignition::math::Pose3d ActorPlugin::Navigate(const ActorModelGrid &_grid,
+    ignition::math::Pose3d _pose, const double _dt)
+{
+  ignition::math::Vector3d pos = this->target - _pose.Pos();
+  ignition::math::Vector3d rpy = _pose.Rot().Euler();
 
   double distance = pos.Length();
 
@@ -170,15 +454,15 @@ void ActorPlugin::OnUpdate(const common::UpdateInfo &_info)
   // target.
   if (distance < 0.3)
   {
-    this->ChooseNewTarget();
-    pos = this->target - pose.Pos();
+    this->ChooseNewTarget(_grid);
+    pos = this->target - _pose.Pos();
   }
 
   // Normalize the direction vector, and apply the target weight
   pos = pos.Normalize() * this->targetWeight;
 
   // Adjust the direction vector by avoiding obstacles
-  this->HandleObstacles(pos);
+  this->HandleObstacles(_grid, _pose.Pos(), pos);
 
   // Compute the yaw orientation
   ignition::math::Angle yaw = atan2(pos.Y(), pos.X()) + 1.5707 - rpy.Z();
@@ -187,28 +471,44 @@ void ActorPlugin::OnUpdate(const common::UpdateInfo &_info)
   // Rotate in place, instead of jumping.
   if (std::abs(yaw.Radian()) > IGN_DTOR(10))
   {
-    pose.Rot() = ignition::math::Quaterniond(1.5707, 0, rpy.Z()+
+    _pose.Rot() = ignition::math::Quaterniond(1.5707, 0, rpy.Z()+
         yaw.Radian()*0.001);
   }
   else
   {
-    pose.Pos() += pos * this->velocity * dt;
-    pose.Rot() = ignition::math::Quaterniond(1.5707, 0, rpy.Z()+yaw.Radian());
+    _pose.Pos() += pos * this->velocity * _dt;
+    _pose.Rot() =
+        ignition::math::Quaterniond(1.5707, 0, rpy.Z()+yaw.Radian());
   }
 
   // Make sure the actor stays within bounds
-  pose.Pos().X(std::max(-3.0, std::min(3.5, pose.Pos().X())));
-  pose.Pos().Y(std::max(-10.0, std::min(2.0, pose.Pos().Y())));
-  pose.Pos().Z(1.2138);
+  _pose.Pos().X(std::max(-3.0, std::min(3.5, _pose.Pos().X())));
+  _pose.Pos().Y(std::max(-10.0, std::min(2.0, _pose.Pos().Y())));
+  _pose.Pos().Z(1.2138);
+
+  return _pose;
+}
 
+/////////////////////////////////////////////////
+void ActorPlugin::ApplyPose(const ignition::math::Pose3d &_pose)
+{
   // Distance traveled is used to coordinate motion with the walking
   // animation
-  double distanceTraveled = (pose.Pos() -
+  double distanceTraveled = (_pose.Pos() -
       this->actor->WorldPose().Pos()).Length();
 
-  this->actor->SetWorldPose(pose, false, false);
+  this->actor->SetWorldPose(_pose, false, false);
   this->actor->SetScriptTime(this->actor->ScriptTime() +
     (distanceTraveled * this->animationFactor));
-  this->lastUpdate = _info.simTime;
-  IGN_PROFILE_END();
+}
+
+/////////////////////////////////////////////////
+void ActorPlugin::FinishNavigation(const bool _apply)
+{
+  if (!this->navigation.valid())
+    return;
+
+  ignition::math::Pose3d pose = this->navigation.get();
+  if (_apply)
+    this->ApplyPose(pose);
 }
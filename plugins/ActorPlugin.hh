@@ -18,6 +18,8 @@
 #ifndef GAZEBO_PLUGINS_ACTORPLUGIN_HH_
 #define GAZEBO_PLUGINS_ACTORPLUGIN_HH_
 
+#include <future>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -27,12 +29,21 @@
 
 namespace gazebo
 {
+  // Forward declare helper classes.
+  class ActorModelGrid;
+  class ActorNavigationWorker;
+
   class GZ_PLUGIN_VISIBLE ActorPlugin : public ModelPlugin
   {
     /// \brief Constructor
     public: ActorPlugin();
 
-    /// \brief Load the actor plugin.
+    /// \brief Destructor
+    public: virtual ~ActorPlugin();
+
+    /// \brief Load the actor plugin. Set <threaded>true</threaded> to
+    /// compute the navigation on a worker thread shared by the actors, which
+    /// moves the actors one world update later.
     /// \param[in] _model Pointer to the parent model.
     /// \param[in] _sdf Pointer to the plugin's SDF elements.
     public: virtual void Load(physics::ModelPtr _model, sdf::ElementPtr _sdf);
@@ -45,13 +56,37 @@ namespace gazebo
     private: void OnUpdate(const common::UpdateInfo &_info);
 
     /// \brief Helper function to choose a new target location
-    private: void ChooseNewTarget();
+    /// \param[in] _grid Positions of the models of the world.
+    private: void ChooseNewTarget(const ActorModelGrid &_grid);
 
     /// \brief Helper function to avoid obstacles. This implements a very
     /// simple vector-field algorithm.
+    /// \param[in] _grid Positions of the models of the world.
+    /// \param[in] _actorPos Position of the actor.
     /// \param[in] _pos Direction vector that should be adjusted according
     /// to nearby obstacles.
-    private: void HandleObstacles(ignition::math::Vector3d &_pos);
+    private: void HandleObstacles(const ActorModelGrid &_grid,
+                 const ignition::math::Vector3d &_actorPos,
+                 ignition::math::Vector3d &_pos);
+
+    /// \brief Compute the next pose of the actor: walk towards the target,
+    /// avoiding obstacles. Doesn't change the actor itself, so that it may
+    /// run on the navigation worker thread.
+    /// \param[in] _grid Positions of the models of the world.
+    /// \param[in] _pose Current pose of the actor.
+    /// \param[in] _dt Time since the last update.
+    /// \return The next pose of the actor.
+    private: ignition::math::Pose3d Navigate(const ActorModelGrid &_grid,
+                 ignition::math::Pose3d _pose, const double _dt);
+
+    /// \brief Move the actor to a pose computed by Navigate.
+    /// \param[in] _pose The new pose.
+    private: void ApplyPose(const ignition::math::Pose3d &_pose);
+
+    /// \brief Wait for the pose computed by the navigation worker thread,
+    /// if any, and optionally apply it.
+    /// \param[in] _apply True to move the actor to the computed pose.
+    private: void FinishNavigation(const bool _apply);
 
     /// \brief Pointer to the parent actor.
     private: physics::ActorPtr actor;
@@ -89,6 +124,14 @@ namespace gazebo
 
     /// \brief Custom trajectory info.
     private: physics::TrajectoryInfoPtr trajectoryInfo;
+
+    /// \brief Thread computing the poses of the actors which navigate on a
+    /// worker thread, null if navigating on the physics thread.
+    private: std::shared_ptr<ActorNavigationWorker> navigationWorker;
+
+    /// \brief Pose being computed by the navigation worker thread, applied
+    /// at the beginning of the next world update.
+    private: std::future<ignition::math::Pose3d> navigation;
   };
 }
 #endif
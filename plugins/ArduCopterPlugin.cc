@@ -17,6 +17,10 @@
 #include <functional>
 #include <fcntl.h>
 
+#ifdef __linux__
+  #include <sys/epoll.h>
+#endif
+
 #ifdef _WIN32
   #include <Winsock2.h>
   #include <Ws2def.h>
@@ -36,6 +40,10 @@
 typedef SSIZE_T ssize_t;
 #endif
 
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <vector>
@@ -160,9 +168,34 @@ double Rotor::kDefaultRotorVelocitySlowdownSim = 10.0;
 double Rotor::kDefaultFrequencyCutoff = 5.0;
 double Rotor::kDefaultSamplingRate = 0.2;
 
+namespace gazebo
+{
+  class ArduCopterLockstep;
+}
+
 // Private data class
 class gazebo::ArduCopterPluginPrivate
 {
+  /// \brief Receive a servo packet without waiting, unless one was already
+  /// received in this step.
+  /// \return True if a servo packet was received in this step.
+  public: bool ReadServo()
+  {
+    if (this->servoSize < 0)
+    {
+      #ifdef _WIN32
+      this->servoSize = recv(this->handle,
+          reinterpret_cast<char *>(&this->servo), sizeof(this->servo), 0);
+      #else
+      this->servoSize = recv(this->handle, &this->servo,
+          sizeof(this->servo), 0);
+      #endif
+      if (this->servoSize >= 0)
+        this->servoTime = std::chrono::steady_clock::now();
+    }
+    return this->servoSize >= 0;
+  }
+
   /// \brief Bind to an adress and port
   /// \param[in] _address Address to bind to.
   /// \param[in] _port Port to bind to.
@@ -230,6 +263,17 @@ class gazebo::ArduCopterPluginPrivate
     #endif
   }
 
+  /// \brief Close the socket.
+  public: void Close()
+  {
+    #ifdef _WIN32
+    closesocket(this->handle);
+    #else
+    close(this->handle);
+    #endif
+    this->handle = -1;
+  }
+
   /// \brief Pointer to the update event connection.
   public: event::ConnectionPtr updateConnection;
 
@@ -261,6 +305,241 @@ class gazebo::ArduCopterPluginPrivate
   /// \brief number of times ArduCotper skips update
   /// before marking ArduCopter offline
   public: int connectionTimeoutMaxCount;
+
+  /// \brief Address of the ArduCopter SITL instance.
+  public: std::string fdmAddress = "127.0.0.1";
+
+  /// \brief Port the state packets are sent to.
+  public: int fdmPortOut = 9003;
+
+  /// \brief Milliseconds to wait for a servo packet while ArduCopter is
+  /// online.
+  public: int lockstepTimeoutMs = 1000;
+
+  /// \brief Vehicles waited for at once, null in the single lockstep mode.
+  public: std::shared_ptr<ArduCopterLockstep> lockstep;
+
+  /// \brief Servo packet of this step.
+  public: ServoPacket servo;
+
+  /// \brief Size of the servo packet of this step, negative if none was
+  /// received yet.
+  public: ssize_t servoSize = -1;
+
+  /// \brief Wall time the servo packet of this step was received.
+  public: std::chrono::steady_clock::time_point servoTime;
+
+  /// \brief Wall time the last state packet was sent.
+  public: std::chrono::steady_clock::time_point stateTime;
+
+  /// \brief True if a state packet was sent and no servo packet was
+  /// received since.
+  public: bool stateSent = false;
+
+  /// \brief Sum of the receive delays, in milliseconds.
+  public: double latencySum = 0;
+
+  /// \brief Largest receive delay, in milliseconds.
+  public: double latencyMax = 0;
+
+  /// \brief Number of receive delays.
+  public: uint64_t latencyCount = 0;
+
+  /// \brief Number of steps without a servo packet while online.
+  public: uint64_t timeouts = 0;
+};
+
+/// \brief The vehicles of a world in the batched lockstep mode. Their
+/// servo packets are waited for at once, with a single timeout per step.
+class gazebo::ArduCopterLockstep
+{
+  /// \brief Get the vehicles of a world.
+  /// \param[in] _world Name of the world.
+  /// \return The vehicles, shared by all the plugins of the world.
+  public: static std::shared_ptr<ArduCopterLockstep> Get(
+              const std::string &_world)
+  {
+    static std::mutex instancesMutex;
+    static std::map<std::string, std::weak_ptr<ArduCopterLockstep>> instances;
+
+    std::lock_guard<std::mutex> lock(instancesMutex);
+    auto lockstep = instances[_world].lock();
+    if (!lockstep)
+    {
+      lockstep.reset(new ArduCopterLockstep);
+      instances[_world] = lockstep;
+    }
+    return lockstep;
+  }
+
+  /// \brief Constructor.
+  private: ArduCopterLockstep()
+  {
+    #ifdef __linux__
+    this->epollHandle = epoll_create1(EPOLL_CLOEXEC);
+    if (this->epollHandle < 0)
+      gzerr << "epoll_create1 failed, waiting with select.\n";
+    #endif
+  }
+
+  /// \brief Destructor.
+  public: ~ArduCopterLockstep()
+  {
+    #ifdef __linux__
+    if (this->epollHandle >= 0)
+      close(this->epollHandle);
+    #endif
+  }
+
+  /// \brief Add a vehicle.
+  /// \param[in] _vehicle The vehicle.
+  public: void Add(ArduCopterPluginPrivate *_vehicle)
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->vehicles.push_back(_vehicle);
+    #ifdef __linux__
+    if (this->epollHandle >= 0)
+    {
+      // edge triggered, so that packets left for the next step do not wake
+      // up the wait again
+      struct epoll_event event;
+      event.events = EPOLLIN | EPOLLET;
+      event.data.ptr = _vehicle;
+      epoll_ctl(this->epollHandle, EPOLL_CTL_ADD, _vehicle->handle, &event);
+    }
+    #endif
+  }
+
+  /// \brief Remove a vehicle.
+  /// \param[in] _vehicle The vehicle.
+  public: void Remove(ArduCopterPluginPrivate *_vehicle)
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->vehicles.erase(std::remove(this->vehicles.begin(),
+        this->vehicles.end(), _vehicle), this->vehicles.end());
+    #ifdef __linux__
+    if (this->epollHandle >= 0)
+    {
+      epoll_ctl(this->epollHandle, EPOLL_CTL_DEL, _vehicle->handle,
+          nullptr);
+    }
+    #endif
+  }
+
+  /// \brief Receive the servo packets of all the vehicles for a step. Only
+  /// the first call of each step waits, the vehicles then read their
+  /// packets from ArduCopterPluginPrivate::servo.
+  /// \param[in] _iteration World iteration of the step.
+  public: void Receive(const uint64_t _iteration)
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if (this->received && _iteration == this->iteration)
+      return;
+    this->received = true;
+    this->iteration = _iteration;
+
+    // Packets that are already there, and the vehicles still waited for.
+    // Vehicles with an offline controller are polled like in the single
+    // lockstep mode, with a short wait shared by all of them.
+    int pending = 0;
+    bool missing = false;
+    int timeoutMs = 1;
+    for (auto vehicle : this->vehicles)
+    {
+      vehicle->servoSize = -1;
+      if (!vehicle->ReadServo())
+      {
+        missing = true;
+        if (vehicle->arduCopterOnline)
+        {
+          ++pending;
+          timeoutMs = std::max(timeoutMs, vehicle->lockstepTimeoutMs);
+        }
+      }
+    }
+
+    if (!missing)
+      return;
+
+    const auto deadline = std::chrono::steady_clock::now() +
+        std::chrono::milliseconds(timeoutMs);
+    bool waitOffline = pending == 0;
+    while (pending > 0 || waitOffline)
+    {
+      waitOffline = false;
+      auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+          deadline - std::chrono::steady_clock::now()).count();
+      if (remaining <= 0)
+        break;
+
+      if (!this->Wait(static_cast<int>(remaining)))
+        break;
+
+      for (auto vehicle : this->vehicles)
+      {
+        const bool waited = vehicle->servoSize < 0;
+        if (vehicle->ReadServo() && waited && vehicle->arduCopterOnline)
+          --pending;
+      }
+    }
+  }
+
+  /// \brief Wait until a socket of a vehicle without a servo packet can be
+  /// read.
+  /// \param[in] _timeoutMs Milliseconds to wait.
+  /// \return True if a socket can be read.
+  private: bool Wait(const int _timeoutMs)
+  {
+    #ifdef __linux__
+    if (this->epollHandle >= 0)
+    {
+      this->events.resize(std::max<size_t>(this->vehicles.size(), 1));
+      int count = epoll_wait(this->epollHandle, this->events.data(),
+          static_cast<int>(this->events.size()), _timeoutMs);
+      return count > 0;
+    }
+    #endif
+
+    fd_set fds;
+    FD_ZERO(&fds);
+    int maxHandle = -1;
+    for (auto vehicle : this->vehicles)
+    {
+      if (vehicle->servoSize < 0)
+      {
+        FD_SET(vehicle->handle, &fds);
+        maxHandle = std::max(maxHandle, vehicle->handle);
+      }
+    }
+    if (maxHandle < 0)
+      return false;
+
+    struct timeval tv;
+    tv.tv_sec = _timeoutMs / 1000;
+    tv.tv_usec = (_timeoutMs % 1000) * 1000UL;
+    return select(maxHandle + 1, &fds, NULL, NULL, &tv) > 0;
+  }
+
+  /// \brief Protects the vehicles.
+  private: std::mutex mutex;
+
+  /// \brief The vehicles.
+  private: std::vector<ArduCopterPluginPrivate *> vehicles;
+
+  /// \brief True once the packets of a step were received.
+  private: bool received = false;
+
+  /// \brief World iteration of the last step the packets were received
+  /// for.
+  private: uint64_t iteration = 0;
+
+  #ifdef __linux__
+  /// \brief The epoll instance the sockets are registered in.
+  private: int epollHandle = -1;
+
+  /// \brief Events returned by epoll_wait.
+  private: std::vector<struct epoll_event> events;
+  #endif
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -277,12 +556,6 @@ ArduCopterPlugin::ArduCopterPlugin()
   setsockopt(this->dataPtr->handle, IPPROTO_TCP, TCP_NODELAY,
       reinterpret_cast<const char *>(&one), sizeof(one));
 
-  if (!this->dataPtr->Bind("127.0.0.1", 9002))
-  {
-    gzerr << "failed to bind with 127.0.0.1:9002, aborting plugin.\n";
-    return;
-  }
-
   this->dataPtr->arduCopterOnline = false;
 
   this->dataPtr->connectionTimeoutCount = 0;
@@ -303,6 +576,11 @@ ArduCopterPlugin::ArduCopterPlugin()
 /////////////////////////////////////////////////
 ArduCopterPlugin::~ArduCopterPlugin()
 {
+  this->dataPtr->updateConnection.reset();
+  if (this->dataPtr->lockstep)
+    this->dataPtr->lockstep->Remove(this->dataPtr.get());
+  if (this->dataPtr->handle >= 0)
+    this->dataPtr->Close();
 }
 
 /////////////////////////////////////////////////
@@ -313,6 +591,26 @@ void ArduCopterPlugin::Load(physics::ModelPtr _model, sdf::ElementPtr _sdf)
 
   this->dataPtr->model = _model;
 
+  // Sockets
+  std::string listenAddress;
+  int fdmPortIn;
+  getSdfParam<std::string>(_sdf, "listen_addr", listenAddress, "127.0.0.1");
+  getSdfParam<int>(_sdf, "fdm_port_in", fdmPortIn, 9002);
+  getSdfParam<std::string>(_sdf, "fdm_addr", this->dataPtr->fdmAddress,
+      this->dataPtr->fdmAddress);
+  getSdfParam<int>(_sdf, "fdm_port_out", this->dataPtr->fdmPortOut,
+      this->dataPtr->fdmPortOut);
+
+  // Bind closes the socket if it fails
+  if (!this->dataPtr->Bind(listenAddress.c_str(),
+        static_cast<uint16_t>(fdmPortIn)))
+  {
+    gzerr << "failed to bind with " << listenAddress << ":" << fdmPortIn
+          << ", aborting plugin.\n";
+    this->dataPtr->handle = -1;
+    return;
+  }
+
   // per rotor
   if (_sdf->HasElement("rotor"))
   {
@@ -455,6 +753,23 @@ void ArduCopterPlugin::Load(physics::ModelPtr _model, sdf::ElementPtr _sdf)
   getSdfParam<int>(_sdf, "connectionTimeoutMaxCount",
     this->dataPtr->connectionTimeoutMaxCount, 10);
 
+  getSdfParam<int>(_sdf, "lockstep_timeout_ms",
+    this->dataPtr->lockstepTimeoutMs, this->dataPtr->lockstepTimeoutMs);
+
+  std::string lockstep;
+  getSdfParam<std::string>(_sdf, "lockstep", lockstep, "single");
+  if (lockstep == "batched")
+  {
+    this->dataPtr->lockstep =
+        ArduCopterLockstep::Get(_model->GetWorld()->Name());
+    this->dataPtr->lockstep->Add(this->dataPtr.get());
+  }
+  else if (lockstep != "single")
+  {
+    gzerr << "Unknown lockstep mode [" << lockstep
+          << "], using 'single'.\n";
+  }
+
   // Listen to the update event. This event is broadcast every simulation
   // iteration.
   this->dataPtr->updateConnection = event::Events::ConnectWorldUpdateBegin(
@@ -534,20 +849,34 @@ void ArduCopterPlugin::ReceiveMotorCommand()
   // Once ArduCopter presence is detected, it takes this many
   // missed receives before declaring the FCS offline.
 
-  ServoPacket pkt;
-  int waitMs = 1;
-  if (this->dataPtr->arduCopterOnline)
+  // In the batched lockstep mode, the packets of all the vehicles are
+  // received at once by the first vehicle updated in the step.
+  ServoPacket &pkt = this->dataPtr->servo;
+  ssize_t recvSize;
+  if (this->dataPtr->lockstep)
   {
-    // increase timeout for receive once we detect a packet from
-    // ArduCopter FCS.
-    waitMs = 1000;
+    this->dataPtr->lockstep->Receive(
+        this->dataPtr->model->GetWorld()->Iterations());
+    recvSize = this->dataPtr->servoSize;
   }
   else
   {
-    // Otherwise skip quickly and do not set control force.
-    waitMs = 1;
+    int waitMs = 1;
+    if (this->dataPtr->arduCopterOnline)
+    {
+      // increase timeout for receive once we detect a packet from
+      // ArduCopter FCS.
+      waitMs = this->dataPtr->lockstepTimeoutMs;
+    }
+    else
+    {
+      // Otherwise skip quickly and do not set control force.
+      waitMs = 1;
+    }
+    recvSize = this->dataPtr->Recv(&pkt, sizeof(ServoPacket), waitMs);
+    this->dataPtr->servoTime = std::chrono::steady_clock::now();
   }
-  ssize_t recvSize = this->dataPtr->Recv(&pkt, sizeof(ServoPacket), waitMs);
+
   ssize_t expectedPktSize =
     sizeof(pkt.motorSpeed[0])*this->dataPtr->rotors.size();
   if ((recvSize == -1) || (recvSize < expectedPktSize))
@@ -560,9 +889,11 @@ void ArduCopterPlugin::ReceiveMotorCommand()
             << " controller expected size (" << expectedPktSize << ").\n";
     }
 
-    gazebo::common::Time::NSleep(100);
+    if (!this->dataPtr->lockstep)
+      gazebo::common::Time::NSleep(100);
     if (this->dataPtr->arduCopterOnline)
     {
+      ++this->dataPtr->timeouts;
       gzwarn << "Broken ArduCopter connection, count ["
              << this->dataPtr->connectionTimeoutCount
              << "/" << this->dataPtr->connectionTimeoutMaxCount
@@ -587,6 +918,18 @@ void ArduCopterPlugin::ReceiveMotorCommand()
       this->dataPtr->arduCopterOnline = true;
     }
 
+    // delay between the last state and this reply
+    if (this->dataPtr->stateSent)
+    {
+      const double latency = std::chrono::duration<double, std::milli>(
+          this->dataPtr->servoTime - this->dataPtr->stateTime).count();
+      this->dataPtr->latencySum += latency;
+      this->dataPtr->latencyMax = std::max(this->dataPtr->latencyMax,
+          latency);
+      ++this->dataPtr->latencyCount;
+      this->dataPtr->stateSent = false;
+    }
+
     // compute command based on requested motorSpeed
     for (unsigned i = 0; i < this->dataPtr->rotors.size(); ++i)
     {
@@ -700,10 +1043,25 @@ void ArduCopterPlugin::SendState() const
   pkt.velocityXYZ[2] = velNEDFrame.Z();
 
   struct sockaddr_in sockaddr;
-  this->dataPtr->MakeSockAddr("127.0.0.1", 9003, sockaddr);
+  this->dataPtr->MakeSockAddr(this->dataPtr->fdmAddress.c_str(),
+      static_cast<uint16_t>(this->dataPtr->fdmPortOut), sockaddr);
 
+  this->dataPtr->stateTime = std::chrono::steady_clock::now();
+  this->dataPtr->stateSent = true;
   ::sendto(this->dataPtr->handle,
            reinterpret_cast<raw_type *>(&pkt),
            sizeof(pkt), 0,
            (struct sockaddr *)&sockaddr, sizeof(sockaddr));
 }
+
+/////////////////////////////////////////////////
+uint64_t ArduCopterPlugin::ReceiveLatency(double &_meanMs, double &_maxMs,
+    uint64_t &_timeouts) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  const uint64_t count = this->dataPtr->latencyCount;
+  _meanMs = count > 0 ? this->dataPtr->latencySum / count : 0.0;
+  _maxMs = this->dataPtr->latencyMax;
+  _timeouts = this->dataPtr->timeouts;
+  return count;
+}
@@ -17,6 +17,7 @@
 #ifndef GAZEBO_PLUGINS_ARDUCOPTERPLUGIN_HH_
 #define GAZEBO_PLUGINS_ARDUCOPTERPLUGIN_HH_
 
+#include <memory>
 #include <sdf/sdf.hh>
 #include <gazebo/common/common.hh>
 #include <gazebo/physics/physics.hh>
@@ -45,6 +46,24 @@ namespace gazebo
   /// <imuName>     scoped name for the imu sensor
   /// <connectionTimeoutMaxCount> timeout before giving up on
   ///                             controller synchronization
+  ///
+  /// Optional parameters:
+  /// <listen_addr>   address the servo packets are received on
+  ///                 (default 127.0.0.1)
+  /// <fdm_port_in>   port the servo packets are received on (default 9002)
+  /// <fdm_addr>      address of the ArduCopter SITL instance
+  ///                 (default 127.0.0.1)
+  /// <fdm_port_out>  port the state packets are sent to (default 9003)
+  /// <lockstep>      'single' to wait for the servo packet of each vehicle
+  ///                 in turn (default), or 'batched' to wait for the
+  ///                 packets of all the vehicles with this mode in the world
+  ///                 at once, so that a swarm waits only as long as its
+  ///                 slowest autopilot in each step
+  /// <lockstep_timeout_ms> milliseconds to wait for the servo packets of
+  ///                 the vehicles whose controller is online (default 1000).
+  ///                 In the batched mode the timeout is shared by all the
+  ///                 vehicles, and a vehicle that misses it only keeps its
+  ///                 last command for the step.
   class GZ_PLUGIN_VISIBLE ArduCopterPlugin : public ModelPlugin
   {
     /// \brief Constructor.
@@ -56,6 +75,16 @@ namespace gazebo
     // Documentation Inherited.
     public: virtual void Load(physics::ModelPtr _model, sdf::ElementPtr _sdf);
 
+    /// \brief Get the statistics of the delay between sending the state to
+    /// ArduCopter and receiving its servo packet.
+    /// \param[out] _meanMs Mean delay in milliseconds.
+    /// \param[out] _maxMs Largest delay in milliseconds.
+    /// \param[out] _timeouts Number of steps without a servo packet while
+    /// the controller was online.
+    /// \return Number of servo packets the statistics are computed from.
+    public: uint64_t ReceiveLatency(double &_meanMs, double &_maxMs,
+                uint64_t &_timeouts) const;
+
     /// \brief Update the control surfaces controllers.
     /// \param[in] _info Update information provided by the server.
     private: void OnUpdate();
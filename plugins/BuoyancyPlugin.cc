@@ -15,19 +15,174 @@
  *
 */
 
+#include <cmath>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+
 #include "ignition/common/Profiler.hh"
 #include "gazebo/common/Assert.hh"
+#include "gazebo/common/CommonIface.hh"
 #include "gazebo/common/Events.hh"
+#include "gazebo/common/Mesh.hh"
+#include "gazebo/common/MeshManager.hh"
 #include "plugins/BuoyancyPlugin.hh"
 
 using namespace gazebo;
 
 GZ_REGISTER_MODEL_PLUGIN(BuoyancyPlugin)
 
+/// \brief Voxels of the collision shapes, by shape description.
+static std::map<std::string, std::weak_ptr<const common::VoxelVolume>>
+    g_shapeVoxels;
+
+/// \brief Mutex to protect g_shapeVoxels.
+static std::mutex g_shapeVoxelsMutex;
+
+/////////////////////////////////////////////////
+/// \brief Get the voxels of a collision shape, in the collision frame.
+/// Collisions with the same shape share their voxels.
+/// \param[in] _collision The collision.
+/// \param[in] _voxelSize Edge length of the voxels.
+/// \return The voxels, null if the shape has no volume.
+static std::shared_ptr<const common::VoxelVolume> ShapeVoxels(
+    const physics::CollisionPtr &_collision, const double _voxelSize)
+{
+  physics::ShapePtr shape = _collision->GetShape();
+  if (!shape)
+    return nullptr;
+
+  // Describe the shape, which identifies its voxels
+  std::ostringstream key;
+  key.precision(9);
+  key << _voxelSize << " ";
+
+  const common::SubMesh *subMesh = nullptr;
+  const common::Mesh *mesh = nullptr;
+  bool centerSubMesh = false;
+  if (_collision->HasType(physics::Base::BOX_SHAPE))
+  {
+    auto box = boost::dynamic_pointer_cast<physics::BoxShape>(shape);
+    key << "box " << box->Size();
+  }
+  else if (_collision->HasType(physics::Base::SPHERE_SHAPE))
+  {
+    auto sphere = boost::dynamic_pointer_cast<physics::SphereShape>(shape);
+    key << "sphere " << sphere->GetRadius();
+  }
+  else if (_collision->HasType(physics::Base::CYLINDER_SHAPE))
+  {
+    auto cylinder =
+      boost::dynamic_pointer_cast<physics::CylinderShape>(shape);
+    key << "cylinder " << cylinder->GetRadius() << " "
+        << cylinder->GetLength();
+  }
+  else if (_collision->HasType(physics::Base::MESH_SHAPE))
+  {
+    auto meshShape = boost::dynamic_pointer_cast<physics::MeshShape>(shape);
+    const std::string uri = meshShape->GetMeshURI();
+    common::MeshManager *meshManager = common::MeshManager::Instance();
+    mesh = meshManager->GetMesh(uri);
+    if (!mesh)
+      mesh = meshManager->GetMesh(common::find_file(uri));
+
+    std::string subMeshName;
+    sdf::ElementPtr meshElem = meshShape->GetSDF();
+    if (meshElem && meshElem->HasElement("submesh"))
+    {
+      sdf::ElementPtr subMeshElem = meshElem->GetElement("submesh");
+      subMeshName = subMeshElem->Get<std::string>("name");
+      centerSubMesh = subMeshElem->Get<bool>("center");
+      if (mesh && subMeshName != "__default__" && !subMeshName.empty())
+        subMesh = mesh->GetSubMesh(subMeshName);
+    }
+    key << "mesh " << uri << " " << subMeshName << " " << centerSubMesh
+        << " " << meshShape->Scale();
+  }
+  else
+  {
+    key << "other " << shape->ComputeVolume();
+  }
+
+  std::lock_guard<std::mutex> lock(g_shapeVoxelsMutex);
+  std::shared_ptr<const common::VoxelVolume> cached =
+    g_shapeVoxels[key.str()].lock();
+  if (cached)
+    return cached;
+
+  std::shared_ptr<common::VoxelVolume> voxels(new common::VoxelVolume);
+  if (_collision->HasType(physics::Base::BOX_SHAPE))
+  {
+    auto box = boost::dynamic_pointer_cast<physics::BoxShape>(shape);
+    const ignition::math::Vector3d half = 0.5 * box->Size();
+    voxels->Build(ignition::math::AxisAlignedBox(-half, half), _voxelSize,
+        [](const ignition::math::Vector3d &) {return true;});
+  }
+  else if (_collision->HasType(physics::Base::SPHERE_SHAPE))
+  {
+    auto sphere = boost::dynamic_pointer_cast<physics::SphereShape>(shape);
+    const double r = sphere->GetRadius();
+    voxels->Build(ignition::math::AxisAlignedBox(
+          ignition::math::Vector3d(-r, -r, -r),
+          ignition::math::Vector3d(r, r, r)), _voxelSize,
+        [r](const ignition::math::Vector3d &_p) {return _p.Length() <= r;});
+  }
+  else if (_collision->HasType(physics::Base::CYLINDER_SHAPE))
+  {
+    auto cylinder =
+      boost::dynamic_pointer_cast<physics::CylinderShape>(shape);
+    const double r = cylinder->GetRadius();
+    const double h = 0.5 * cylinder->GetLength();
+    voxels->Build(ignition::math::AxisAlignedBox(
+          ignition::math::Vector3d(-r, -r, -h),
+          ignition::math::Vector3d(r, r, h)), _voxelSize,
+        [r](const ignition::math::Vector3d &_p)
+        {
+          return _p.X() * _p.X() + _p.Y() * _p.Y() <= r * r;
+        });
+  }
+  else if (mesh)
+  {
+    auto meshShape = boost::dynamic_pointer_cast<physics::MeshShape>(shape);
+    if (subMesh)
+    {
+      common::SubMesh part(subMesh);
+      if (centerSubMesh)
+        part.Center(ignition::math::Vector3d::Zero);
+      voxels->Build(part, meshShape->Scale(), _voxelSize);
+    }
+    else
+    {
+      voxels->Build(*mesh, meshShape->Scale(), _voxelSize);
+    }
+  }
+
+  // Other shapes, and meshes that are not closed, count as a cube of their
+  // volume
+  if (voxels->VoxelCount() == 0)
+  {
+    const double volume = shape->ComputeVolume();
+    if (!(volume > 0))
+      return nullptr;
+
+    const double half = 0.5 * std::cbrt(volume);
+    voxels->Build(ignition::math::AxisAlignedBox(
+          ignition::math::Vector3d(-half, -half, -half),
+          ignition::math::Vector3d(half, half, half)), 2.0 * half,
+        [](const ignition::math::Vector3d &) {return true;});
+  }
+
+  g_shapeVoxels[key.str()] = voxels;
+  return voxels;
+}
+
 /////////////////////////////////////////////////
 BuoyancyPlugin::BuoyancyPlugin()
   // Density of liquid water at 1 atm pressure and 15 degrees Celsius.
-  : fluidDensity(999.1026)
+  : fluidDensity(999.1026), hasFluidLevel(false), fluidLevel(0.0),
+    voxelSize(0.05)
 {
 }
 
@@ -47,6 +202,23 @@ void BuoyancyPlugin::Load(physics::ModelPtr _model, sdf::ElementPtr _sdf)
     this->fluidDensity = this->sdf->Get<double>("fluid_density");
   }
 
+  if (this->sdf->HasElement("fluid_level"))
+  {
+    this->hasFluidLevel = true;
+    this->fluidLevel = this->sdf->Get<double>("fluid_level");
+  }
+
+  if (this->sdf->HasElement("voxel_size"))
+  {
+    this->voxelSize = this->sdf->Get<double>("voxel_size");
+    if (this->voxelSize <= 0)
+    {
+      gzwarn << "Nonpositive voxel size specified in BuoyancyPlugin, "
+             << "using 0.05" << std::endl;
+      this->voxelSize = 0.05;
+    }
+  }
+
   // Get "center of volume" and "volume" that were inputted in SDF
   // SDF input is recommended for mesh or polylines collision shapes
   if (this->sdf->HasElement("link"))
@@ -140,6 +312,19 @@ void BuoyancyPlugin::Load(physics::ModelPtr _model, sdf::ElementPtr _sdf)
       this->volPropsMap[id].cov =
           weightedPosSum/volumeSum - link->WorldPose().Pos();
       this->volPropsMap[id].volume = volumeSum;
+
+      if (!this->hasFluidLevel)
+        continue;
+
+      // Describe the collisions by voxels, to find their submerged part
+      for (auto collision : link->GetCollisions())
+      {
+        CollisionVoxels collisionVoxels;
+        collisionVoxels.collision = collision;
+        collisionVoxels.voxels = ShapeVoxels(collision, this->voxelSize);
+        if (collisionVoxels.voxels)
+          this->volPropsMap[id].voxels.push_back(collisionVoxels);
+      }
     }
   }
 }
@@ -147,7 +332,7 @@ void BuoyancyPlugin::Load(physics::ModelPtr _model, sdf::ElementPtr _sdf)
 /////////////////////////////////////////////////
 void BuoyancyPlugin::Init()
 {
-  this->updateConnection = event::Events::ConnectWorldUpdateBegin(
+  this->updateConnection = this->ConnectWorldUpdateBegin(
       std::bind(&BuoyancyPlugin::OnUpdate, this));
 }
 
@@ -156,9 +341,36 @@ void BuoyancyPlugin::OnUpdate()
 {
   IGN_PROFILE("BuoyancyPlugin::OnUpdate");
   IGN_PROFILE_BEGIN("Update");
-  for (auto link : this->model->GetLinks())
+  for (auto const &link : this->model->GetLinks())
   {
-    VolumeProperties volumeProperties = this->volPropsMap[link->GetId()];
+    const VolumeProperties &volumeProperties =
+      this->volPropsMap[link->GetId()];
+
+    // Only the part of the link below the surface is buoyant
+    if (!volumeProperties.voxels.empty())
+    {
+      double submerged = 0;
+      ignition::math::Vector3d weightedPosSum;
+      for (auto const &collisionVoxels : volumeProperties.voxels)
+      {
+        ignition::math::Vector3d centroid;
+        const double volume = collisionVoxels.voxels->Submerged(
+            collisionVoxels.collision->WorldPose(), this->fluidLevel,
+            centroid);
+        submerged += volume;
+        weightedPosSum += volume * centroid;
+      }
+
+      if (submerged > 0)
+      {
+        ignition::math::Vector3d buoyancy =
+            -this->fluidDensity * submerged *
+            this->model->GetWorld()->Gravity();
+        link->AddForceAtWorldPosition(buoyancy, weightedPosSum / submerged);
+      }
+      continue;
+    }
+
     double volume = volumeProperties.volume;
     GZ_ASSERT(volume > 0, "Nonpositive volume found in volume properties!");
 
@@ -19,14 +19,29 @@
 #define GAZEBO_PLUGINS_BUOYANCYPLUGIN_HH_
 
 #include <map>
+#include <memory>
+#include <vector>
 #include <ignition/math/Vector3.hh>
 
 #include "gazebo/common/Event.hh"
 #include "gazebo/common/Plugin.hh"
+#include "gazebo/common/VoxelVolume.hh"
 #include "gazebo/physics/physics.hh"
 
 namespace gazebo
 {
+  /// \brief The voxels of a collision, used to compute the submerged part
+  /// of a link when the fluid has a surface.
+  class CollisionVoxels
+  {
+    /// \brief The collision.
+    public: physics::CollisionPtr collision;
+
+    /// \brief Voxels of the collision shape in the collision frame, shared
+    /// by the collisions with the same shape.
+    public: std::shared_ptr<const common::VoxelVolume> voxels;
+  };
+
   /// \brief A class for storing the volume properties of a link.
   class VolumeProperties
   {
@@ -38,6 +53,10 @@ namespace gazebo
 
     /// \brief Volume of this link.
     public: double volume;
+
+    /// \brief Voxels of the collisions of the link, empty if the volume
+    /// was set in SDF or the fluid has no surface.
+    public: std::vector<CollisionVoxels> voxels;
   };
 
   /// \brief A plugin that simulates buoyancy of an object immersed in fluid.
@@ -57,6 +76,12 @@ namespace gazebo
   /// to compute these properties from the link collision shapes. This
   /// computation will not be accurate if the object is not composed of simple
   /// collision shapes.
+  /// <fluid_level> The height of the fluid surface in the world frame. If
+  /// set, links whose volume is not specified are described by voxels of
+  /// their box, sphere, cylinder and mesh collisions, and only the part
+  /// below the surface is buoyant. The force is applied at the center of
+  /// the submerged volume. Other shapes count as a cube of their volume.
+  /// <voxel_size> The edge length of the voxels, 0.05 m by default.
   class GZ_PLUGIN_VISIBLE BuoyancyPlugin : public ModelPlugin
   {
     /// \brief Constructor.
@@ -88,6 +113,15 @@ namespace gazebo
     /// \brief Map of <link ID, point> pairs mapping link IDs to the CoV (center
     /// of volume) and volume of the link.
     protected: std::map<int, VolumeProperties> volPropsMap;
+
+    /// \brief True if the fluid has a surface at fluidLevel.
+    protected: bool hasFluidLevel;
+
+    /// \brief Height of the fluid surface in the world frame.
+    protected: double fluidLevel;
+
+    /// \brief Edge length of the voxels of the collisions.
+    protected: double voxelSize;
   };
 }
 
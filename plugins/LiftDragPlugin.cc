@@ -17,7 +17,11 @@
 
 #include <algorithm>
 #include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 #include <ignition/common/Profiler.hh>
 #include <ignition/math/Pose3.hh>
@@ -28,10 +32,510 @@
 #include "gazebo/transport/transport.hh"
 #include "plugins/LiftDragPlugin.hh"
 
+namespace gazebo
+{
+  /// \brief The lift and drag surfaces of a world, evaluated together once
+  /// per step. Their parameters are kept in contiguous arrays, and the pose,
+  /// wind and air density of a link are looked up once for all the surfaces
+  /// of the link.
+  class LiftDragSystem
+  {
+    /// \brief Constructor.
+    /// \param[in] _world World of the surfaces.
+    public: explicit LiftDragSystem(physics::WorldPtr _world);
+
+    /// \brief Get the system of a world, creating it if needed.
+    /// \param[in] _world The world.
+    /// \return The system, shared by the plugins of the world.
+    public: static std::shared_ptr<LiftDragSystem> Instance(
+                physics::WorldPtr _world);
+
+    /// \brief Add the surface of a plugin.
+    /// \param[in] _plugin Loaded plugin with a link.
+    public: void Add(LiftDragPlugin *_plugin);
+
+    /// \brief Remove the surface of a plugin.
+    /// \param[in] _plugin The plugin.
+    public: void Remove(LiftDragPlugin *_plugin);
+
+    /// \brief Evaluate and apply the forces of all the surfaces.
+    public: void Update();
+
+    /// \brief Evaluate and apply the forces of the surface of a plugin.
+    /// \param[in] _plugin The plugin.
+    public: void Update(LiftDragPlugin *_plugin);
+
+    /// \brief Evaluate and apply the forces of a range of surfaces.
+    /// \param[in] _first First surface.
+    /// \param[in] _last One past the last surface.
+    private: void Evaluate(const size_t _first, const size_t _last);
+
+    /// \brief Rebuild the list of links of the surfaces.
+    private: void IndexLinks();
+
+    /// \brief Look up the pose, wind and air density of a link.
+    /// \param[in] _index Index of the link in linkList.
+    private: void RefreshLink(const size_t _index);
+
+    /// \brief World of the surfaces.
+    private: physics::WorldPtr world;
+
+    /// \brief Connection to the world update begin event.
+    private: event::ConnectionPtr updateConnection;
+
+    /// \brief Mutex to protect the surfaces.
+    private: std::mutex mutex;
+
+    /// \brief Plugin of each surface.
+    private: std::vector<LiftDragPlugin *> plugins;
+
+    /// \brief Link of each surface.
+    private: std::vector<physics::LinkPtr> links;
+
+    /// \brief Control joint of each surface, may be null.
+    private: std::vector<physics::JointPtr> joints;
+
+    /// \brief Index of the link of each surface in linkList.
+    private: std::vector<size_t> linkIndex;
+
+    /// \brief Aerodynamic parameters of each surface, see LiftDragPlugin.
+    private: std::vector<double> cla, cda, cma, alphaStall, claStall,
+             cdaStall, cmaStall, alpha0, area, rho, controlJointRadToCL;
+
+    /// \brief Geometry of each surface in the link frame,
+    /// see LiftDragPlugin.
+    private: std::vector<ignition::math::Vector3d> cp, forward, upward;
+
+    /// \brief Flags of each surface, see LiftDragPlugin.
+    private: std::vector<char> radialSymmetry, useWind, useAtmosphere;
+
+    /// \brief Velocity of the air at the center of pressure of each
+    /// surface, relative to the surface, in the world frame.
+    private: std::vector<ignition::math::Vector3d> vel;
+
+    /// \brief Control joint angle of each surface.
+    private: std::vector<double> controlAngle;
+
+    /// \brief Force and torque of each surface, in the world frame.
+    private: std::vector<ignition::math::Vector3d> force, torque;
+
+    /// \brief Angle of attack and sweep of each surface.
+    private: std::vector<double> alpha, sweep;
+
+    /// \brief Whether each surface moves fast enough to generate forces.
+    private: std::vector<char> active;
+
+    /// \brief Links of the surfaces, each listed once.
+    private: std::vector<physics::LinkPtr> linkList;
+
+    /// \brief Whether a link of linkList needs the wind or the air density.
+    private: std::vector<char> linkWind, linkAtmosphere;
+
+    /// \brief Pose of each link of linkList.
+    private: std::vector<ignition::math::Pose3d> linkPose;
+
+    /// \brief Wind velocity at each link of linkList.
+    private: std::vector<ignition::math::Vector3d> linkWindVel;
+
+    /// \brief Air density at each link of linkList.
+    private: std::vector<double> linkRho;
+
+    /// \brief True if linkList must be rebuilt.
+    private: bool linksDirty = true;
+  };
+}
+
 using namespace gazebo;
 
 GZ_REGISTER_MODEL_PLUGIN(LiftDragPlugin)
 
+/// \brief Lift and drag systems by world.
+static std::map<physics::World *, std::weak_ptr<LiftDragSystem>>
+    g_liftDragSystems;
+
+/// \brief Mutex to protect g_liftDragSystems.
+static std::mutex g_liftDragSystemsMutex;
+
+/////////////////////////////////////////////////
+LiftDragSystem::LiftDragSystem(physics::WorldPtr _world)
+  : world(_world)
+{
+  this->updateConnection = event::Events::ConnectWorldUpdateBegin(
+      std::bind(static_cast<void (LiftDragSystem::*)()>(
+          &LiftDragSystem::Update), this));
+}
+
+/////////////////////////////////////////////////
+std::shared_ptr<LiftDragSystem> LiftDragSystem::Instance(
+    physics::WorldPtr _world)
+{
+  std::lock_guard<std::mutex> lock(g_liftDragSystemsMutex);
+  std::weak_ptr<LiftDragSystem> &weak = g_liftDragSystems[_world.get()];
+  std::shared_ptr<LiftDragSystem> system = weak.lock();
+  if (!system)
+  {
+    system.reset(new LiftDragSystem(_world));
+    weak = system;
+  }
+  return system;
+}
+
+/////////////////////////////////////////////////
+void LiftDragSystem::Add(LiftDragPlugin *_plugin)
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  this->plugins.push_back(_plugin);
+  this->links.push_back(_plugin->link);
+  this->joints.push_back(_plugin->controlJoint);
+  this->linkIndex.push_back(0);
+  this->cla.push_back(_plugin->cla);
+  this->cda.push_back(_plugin->cda);
+  this->cma.push_back(_plugin->cma);
+  this->alphaStall.push_back(_plugin->alphaStall);
+  this->claStall.push_back(_plugin->claStall);
+  this->cdaStall.push_back(_plugin->cdaStall);
+  this->cmaStall.push_back(_plugin->cmaStall);
+  this->alpha0.push_back(_plugin->alpha0);
+  this->area.push_back(_plugin->area);
+  this->rho.push_back(_plugin->rho);
+  this->controlJointRadToCL.push_back(_plugin->controlJointRadToCL);
+  this->cp.push_back(_plugin->cp);
+  this->forward.push_back(_plugin->forward);
+  this->upward.push_back(_plugin->upward);
+  this->radialSymmetry.push_back(_plugin->radialSymmetry);
+  this->useWind.push_back(_plugin->useWind);
+  this->useAtmosphere.push_back(_plugin->useAtmosphere);
+
+  const size_t count = this->plugins.size();
+  this->vel.resize(count);
+  this->controlAngle.resize(count);
+  this->force.resize(count);
+  this->torque.resize(count);
+  this->alpha.resize(count);
+  this->sweep.resize(count);
+  this->active.resize(count);
+  this->linksDirty = true;
+}
+
+/////////////////////////////////////////////////
+/// \brief Remove an element of an array by moving the last one in its
+/// place.
+/// \param[in,out] _array The array.
+/// \param[in] _index Index of the element.
+template<typename T>
+static void SwapRemove(std::vector<T> &_array, const size_t _index)
+{
+  _array[_index] = _array.back();
+  _array.pop_back();
+}
+
+/////////////////////////////////////////////////
+void LiftDragSystem::Remove(LiftDragPlugin *_plugin)
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  auto iter = std::find(this->plugins.begin(), this->plugins.end(), _plugin);
+  if (iter == this->plugins.end())
+    return;
+
+  const size_t i = iter - this->plugins.begin();
+  SwapRemove(this->plugins, i);
+  SwapRemove(this->links, i);
+  SwapRemove(this->joints, i);
+  SwapRemove(this->linkIndex, i);
+  SwapRemove(this->cla, i);
+  SwapRemove(this->cda, i);
+  SwapRemove(this->cma, i);
+  SwapRemove(this->alphaStall, i);
+  SwapRemove(this->claStall, i);
+  SwapRemove(this->cdaStall, i);
+  SwapRemove(this->cmaStall, i);
+  SwapRemove(this->alpha0, i);
+  SwapRemove(this->area, i);
+  SwapRemove(this->rho, i);
+  SwapRemove(this->controlJointRadToCL, i);
+  SwapRemove(this->cp, i);
+  SwapRemove(this->forward, i);
+  SwapRemove(this->upward, i);
+  SwapRemove(this->radialSymmetry, i);
+  SwapRemove(this->useWind, i);
+  SwapRemove(this->useAtmosphere, i);
+  SwapRemove(this->vel, i);
+  SwapRemove(this->controlAngle, i);
+  SwapRemove(this->force, i);
+  SwapRemove(this->torque, i);
+  SwapRemove(this->alpha, i);
+  SwapRemove(this->sweep, i);
+  SwapRemove(this->active, i);
+  this->linksDirty = true;
+}
+
+/////////////////////////////////////////////////
+void LiftDragSystem::IndexLinks()
+{
+  this->linkList.clear();
+  this->linkWind.clear();
+  this->linkAtmosphere.clear();
+
+  std::map<physics::Link *, size_t> indices;
+  for (size_t i = 0; i < this->links.size(); ++i)
+  {
+    auto inserted = indices.insert(
+        std::make_pair(this->links[i].get(), this->linkList.size()));
+    if (inserted.second)
+    {
+      this->linkList.push_back(this->links[i]);
+      this->linkWind.push_back(false);
+      this->linkAtmosphere.push_back(false);
+    }
+
+    const size_t index = inserted.first->second;
+    this->linkIndex[i] = index;
+    this->linkWind[index] = this->linkWind[index] || this->useWind[i];
+    this->linkAtmosphere[index] =
+      this->linkAtmosphere[index] || this->useAtmosphere[i];
+  }
+
+  this->linkPose.resize(this->linkList.size());
+  this->linkWindVel.resize(this->linkList.size());
+  this->linkRho.resize(this->linkList.size());
+  this->linksDirty = false;
+}
+
+/////////////////////////////////////////////////
+void LiftDragSystem::RefreshLink(const size_t _index)
+{
+  const physics::LinkPtr &link = this->linkList[_index];
+  this->linkPose[_index] = link->WorldPose();
+  this->linkWindVel[_index] = (this->world->WindEnabled() &&
+      this->linkWind[_index]) ?
+    this->world->Wind().WorldLinearVel(link.get()) :
+    ignition::math::Vector3d::Zero;
+  this->linkRho[_index] = (this->world->AtmosphereEnabled() &&
+      this->linkAtmosphere[_index]) ?
+    this->world->Atmosphere().MassDensity(this->linkPose[_index].Pos().Z()) :
+    0.0;
+}
+
+/////////////////////////////////////////////////
+void LiftDragSystem::Update()
+{
+  IGN_PROFILE("LiftDragSystem::Update");
+  std::lock_guard<std::mutex> lock(this->mutex);
+  this->Evaluate(0, this->plugins.size());
+}
+
+/////////////////////////////////////////////////
+void LiftDragSystem::Update(LiftDragPlugin *_plugin)
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  auto iter = std::find(this->plugins.begin(), this->plugins.end(), _plugin);
+  if (iter != this->plugins.end())
+  {
+    const size_t i = iter - this->plugins.begin();
+    this->Evaluate(i, i + 1);
+  }
+}
+
+/////////////////////////////////////////////////
+void LiftDragSystem::Evaluate(const size_t _first, const size_t _last)
+{
+  if (_first >= _last)
+    return;
+
+  if (this->linksDirty)
+    this->IndexLinks();
+
+  // Look up the state of each link once for all its surfaces, or only the
+  // links of the surfaces evaluated
+  if (_first == 0 && _last == this->plugins.size())
+  {
+    for (size_t l = 0; l < this->linkList.size(); ++l)
+      this->RefreshLink(l);
+  }
+  else
+  {
+    for (size_t i = _first; i < _last; ++i)
+      this->RefreshLink(this->linkIndex[i]);
+  }
+
+  for (size_t i = _first; i < _last; ++i)
+  {
+    // get linear velocity at cp in inertial frame, relative to the air
+    this->vel[i] = this->links[i]->WorldLinearVel(this->cp[i]);
+    if (this->useWind[i])
+      this->vel[i] -= this->linkWindVel[this->linkIndex[i]];
+    this->controlAngle[i] = this->joints[i] ?
+      this->joints[i]->Position(0) : 0.0;
+  }
+
+  const double minRatio = -1.0;
+  const double maxRatio = 1.0;
+
+  // Compute the forces of the surfaces, without touching the links
+  for (size_t i = _first; i < _last; ++i)
+  {
+    const ignition::math::Vector3d &v = this->vel[i];
+    ignition::math::Vector3d velI = v;
+    velI.Normalize();
+
+    this->active[i] = v.Length() > 0.01;
+    if (!this->active[i])
+      continue;
+
+    // pose of body
+    const ignition::math::Pose3d &pose = this->linkPose[this->linkIndex[i]];
+
+    // rotate forward and upward vectors into inertial frame
+    ignition::math::Vector3d forwardI = pose.Rot().RotateVector(
+        this->forward[i]);
+
+    ignition::math::Vector3d upwardI;
+    if (this->radialSymmetry[i])
+    {
+      // use inflow velocity to determine upward direction
+      // which is the component of inflow perpendicular to forward direction.
+      ignition::math::Vector3d tmp = forwardI.Cross(velI);
+      upwardI = forwardI.Cross(tmp).Normalize();
+    }
+    else
+    {
+      upwardI = pose.Rot().RotateVector(this->upward[i]);
+    }
+
+    // spanwiseI: a vector normal to lift-drag-plane described in inertial
+    // frame
+    ignition::math::Vector3d spanwiseI = forwardI.Cross(upwardI).Normalize();
+
+    // check sweep (angle between velI and lift-drag-plane)
+    double sinSweepAngle = ignition::math::clamp(
+        spanwiseI.Dot(velI), minRatio, maxRatio);
+
+    // get cos from trig identity
+    double cosSweepAngle = 1.0 - sinSweepAngle * sinSweepAngle;
+    double sweepAngle = asin(sinSweepAngle);
+
+    // truncate sweep to within +/-90 deg
+    while (fabs(sweepAngle) > 0.5 * M_PI)
+      sweepAngle = sweepAngle > 0 ? sweepAngle - M_PI : sweepAngle + M_PI;
+    this->sweep[i] = sweepAngle;
+
+    // angle of attack is the angle between velI projected into lift-drag
+    // plane and forward vector, removing spanwise velocity from vel
+    ignition::math::Vector3d velInLDPlane = v - v.Dot(spanwiseI)*velI;
+
+    // get direction of drag
+    ignition::math::Vector3d dragDirection = -velInLDPlane;
+    dragDirection.Normalize();
+
+    // get direction of lift
+    ignition::math::Vector3d liftI = spanwiseI.Cross(velInLDPlane);
+    liftI.Normalize();
+
+    // get direction of moment
+    ignition::math::Vector3d momentDirection = spanwiseI;
+
+    // compute angle between upwardI and liftI, both unit vectors
+    double cosAlpha =
+      ignition::math::clamp(liftI.Dot(upwardI), minRatio, maxRatio);
+
+    // if forwardI is in the same direction as lift, alpha is positive.
+    double a;
+    if (liftI.Dot(forwardI) >= 0.0)
+      a = this->alpha0[i] + acos(cosAlpha);
+    else
+      a = this->alpha0[i] - acos(cosAlpha);
+
+    // normalize to within +/-90 deg
+    while (fabs(a) > 0.5 * M_PI)
+      a = a > 0 ? a - M_PI : a + M_PI;
+    this->alpha[i] = a;
+
+    // compute dynamic pressure
+    const double density = this->useAtmosphere[i] && atmosphereEnabled ?
+      this->linkRho[this->linkIndex[i]] : this->rho[i];
+    double speedInLDPlane = velInLDPlane.Length();
+    double q = 0.5 * density * speedInLDPlane * speedInLDPlane;
+
+    const double stall = this->alphaStall[i];
+
+    // compute cl at cp, check for stall, correct for sweep
+    double cl;
+    if (a > stall)
+    {
+      cl = (this->cla[i] * stall + this->claStall[i] * (a - stall))
+           * cosSweepAngle;
+      // make sure cl is still great than 0
+      cl = std::max(0.0, cl);
+    }
+    else if (a < -stall)
+    {
+      cl = (-this->cla[i] * stall + this->claStall[i] * (a + stall))
+           * cosSweepAngle;
+      // make sure cl is still less than 0
+      cl = std::min(0.0, cl);
+    }
+    else
+      cl = this->cla[i] * a * cosSweepAngle;
+
+    // modify cl per control joint value
+    /// \TODO: also change cm and cd
+    cl = cl + this->controlJointRadToCL[i] * this->controlAngle[i];
+
+    // compute lift force at cp
+    ignition::math::Vector3d lift = cl * q * this->area[i] * liftI;
+
+    // compute cd at cp, check for stall, correct for sweep
+    double cd;
+    if (a > stall)
+    {
+      cd = (this->cda[i] * stall + this->cdaStall[i] * (a - stall))
+           * cosSweepAngle;
+    }
+    else if (a < -stall)
+    {
+      cd = (-this->cda[i] * stall + this->cdaStall[i] * (a + stall))
+           * cosSweepAngle;
+    }
+    else
+      cd = (this->cda[i] * a) * cosSweepAngle;
+
+    // make sure drag is positive
+    cd = fabs(cd);
+
+    // drag at cp
+    ignition::math::Vector3d drag = cd * q * this->area[i] * dragDirection;
+
+    /// \TODO: implement cm
+    /// for now, cm is zero, as cm needs testing
+    double cm = 0.0;
+
+    // compute moment (torque) at cp
+    ignition::math::Vector3d moment = cm * q * this->area[i] *
+      momentDirection;
+
+    // force and torque about cg in inertial frame
+    this->force[i] = lift + drag;
+    this->torque[i] = moment;
+
+    // Correct for nan or inf
+    this->force[i].Correct();
+    this->torque[i].Correct();
+  }
+
+  // apply forces at cg (with torques for position shift)
+  for (size_t i = _first; i < _last; ++i)
+  {
+    if (!this->active[i])
+      continue;
+
+    this->plugins[i]->alpha = this->alpha[i];
+    this->plugins[i]->sweep = this->sweep[i];
+    this->cp[i].Correct();
+    this->links[i]->AddForceAtRelativePosition(this->force[i], this->cp[i]);
+    this->links[i]->AddTorque(this->torque[i]);
+  }
+}
+
 /////////////////////////////////////////////////
 LiftDragPlugin::LiftDragPlugin() : cla(1.0), cda(0.01), cma(0.01), rho(1.2041)
 {
@@ -49,6 +553,8 @@ LiftDragPlugin::LiftDragPlugin() : cla(1.0), cda(0.01), cma(0.01), rho(1.2041)
   this->claStall = 0.0;
 
   this->radialSymmetry = false;
+  this->useWind = false;
+  this->useAtmosphere = false;
 
   /// \TODO: what's flat plate drag?
   this->cdaStall = 1.0;
@@ -61,6 +567,8 @@ LiftDragPlugin::LiftDragPlugin() : cla(1.0), cda(0.01), cma(0.01), rho(1.2041)
 /////////////////////////////////////////////////
 LiftDragPlugin::~LiftDragPlugin()
 {
+  if (this->system)
+    this->system->Remove(this);
 }
 
 /////////////////////////////////////////////////
@@ -139,11 +647,6 @@ void LiftDragPlugin::Load(physics::ModelPtr _model,
       gzerr << "Link with name[" << linkName << "] not found. "
         << "The LiftDragPlugin will not generate forces\n";
     }
-    else
-    {
-      this->updateConnection = event::Events::ConnectWorldUpdateBegin(
-          std::bind(&LiftDragPlugin::OnUpdate, this));
-    }
   }
 
   if (_sdf->HasElement("control_joint_name"))
@@ -158,247 +661,25 @@ void LiftDragPlugin::Load(physics::ModelPtr _model,
 
   if (_sdf->HasElement("control_joint_rad_to_cl"))
     this->controlJointRadToCL = _sdf->Get<double>("control_joint_rad_to_cl");
-}
 
-/////////////////////////////////////////////////
-void LiftDragPlugin::OnUpdate()
-{
-  GZ_ASSERT(this->link, "Link was NULL");
-  // get linear velocity at cp in inertial frame
-  ignition::math::Vector3d vel = this->link->WorldLinearVel(this->cp);
-  ignition::math::Vector3d velI = vel;
-  velI.Normalize();
-
-  // smoothing
-  // double e = 0.8;
-  // this->velSmooth = e*vel + (1.0 - e)*velSmooth;
-  // vel = this->velSmooth;
-
-  if (vel.Length() <= 0.01)
-    return;
-
-  IGN_PROFILE("LiftDragPlugin::OnUpdate");
-  IGN_PROFILE_BEGIN(std::string(this->link->GetName()).c_str());
-
-  // pose of body
-  ignition::math::Pose3d pose = this->link->WorldPose();
-
-  // rotate forward and upward vectors into inertial frame
-  ignition::math::Vector3d forwardI = pose.Rot().RotateVector(this->forward);
-
-  ignition::math::Vector3d upwardI;
-  if (this->radialSymmetry)
-  {
-    // use inflow velocity to determine upward direction
-    // which is the component of inflow perpendicular to forward direction.
-    ignition::math::Vector3d tmp = forwardI.Cross(velI);
-    upwardI = forwardI.Cross(tmp).Normalize();
-  }
-  else
-  {
-    upwardI = pose.Rot().RotateVector(this->upward);
-  }
-
-  // spanwiseI: a vector normal to lift-drag-plane described in inertial frame
-  ignition::math::Vector3d spanwiseI = forwardI.Cross(upwardI).Normalize();
-
-  const double minRatio = -1.0;
-  const double maxRatio = 1.0;
-  // check sweep (angle between velI and lift-drag-plane)
-  double sinSweepAngle = ignition::math::clamp(
-      spanwiseI.Dot(velI), minRatio, maxRatio);
-
-  // get cos from trig identity
-  double cosSweepAngle = 1.0 - sinSweepAngle * sinSweepAngle;
-  this->sweep = asin(sinSweepAngle);
-
-  // truncate sweep to within +/-90 deg
-  while (fabs(this->sweep) > 0.5 * M_PI)
-    this->sweep = this->sweep > 0 ? this->sweep - M_PI
-                                  : this->sweep + M_PI;
-
-  // angle of attack is the angle between
-  // velI projected into lift-drag plane
-  //  and
-  // forward vector
-  //
-  // projected = spanwiseI Xcross ( vector Xcross spanwiseI)
-  //
-  // so,
-  // removing spanwise velocity from vel
-  ignition::math::Vector3d velInLDPlane = vel - vel.Dot(spanwiseI)*velI;
-
-  // get direction of drag
-  ignition::math::Vector3d dragDirection = -velInLDPlane;
-  dragDirection.Normalize();
-
-  // get direction of lift
-  ignition::math::Vector3d liftI = spanwiseI.Cross(velInLDPlane);
-  liftI.Normalize();
-
-  // get direction of moment
-  ignition::math::Vector3d momentDirection = spanwiseI;
-
-  // compute angle between upwardI and liftI
-  // in general, given vectors a and b:
-  //   cos(theta) = a.Dot(b)/(a.Length()*b.Lenghth())
-  // given upwardI and liftI are both unit vectors, we can drop the denominator
-  //   cos(theta) = a.Dot(b)
-  double cosAlpha =
-    ignition::math::clamp(liftI.Dot(upwardI), minRatio, maxRatio);
-
-  // Is alpha positive or negative? Test:
-  // forwardI points toward zero alpha
-  // if forwardI is in the same direction as lift, alpha is positive.
-  // liftI is in the same direction as forwardI?
-  if (liftI.Dot(forwardI) >= 0.0)
-    this->alpha = this->alpha0 + acos(cosAlpha);
-  else
-    this->alpha = this->alpha0 - acos(cosAlpha);
-
-  // normalize to within +/-90 deg
-  while (fabs(this->alpha) > 0.5 * M_PI)
-    this->alpha = this->alpha > 0 ? this->alpha - M_PI
-                                  : this->alpha + M_PI;
-
-  // compute dynamic pressure
-  double speedInLDPlane = velInLDPlane.Length();
-  double q = 0.5 * this->rho * speedInLDPlane * speedInLDPlane;
-
-  // compute cl at cp, check for stall, correct for sweep
-  double cl;
-  if (this->alpha > this->alphaStall)
-  {
-    cl = (this->cla * this->alphaStall +
-          this->claStall * (this->alpha - this->alphaStall))
-         * cosSweepAngle;
-    // make sure cl is still great than 0
-    cl = std::max(0.0, cl);
-  }
-  else if (this->alpha < -this->alphaStall)
-  {
-    cl = (-this->cla * this->alphaStall +
-          this->claStall * (this->alpha + this->alphaStall))
-         * cosSweepAngle;
-    // make sure cl is still less than 0
-    cl = std::min(0.0, cl);
-  }
-  else
-    cl = this->cla * this->alpha * cosSweepAngle;
-
-  // modify cl per control joint value
-  if (this->controlJoint)
-  {
-    double controlAngle = this->controlJoint->Position(0);
-    cl = cl + this->controlJointRadToCL * controlAngle;
-    /// \TODO: also change cm and cd
-  }
-
-  // compute lift force at cp
-  ignition::math::Vector3d lift = cl * q * this->area * liftI;
-
-  // compute cd at cp, check for stall, correct for sweep
-  double cd;
-  if (this->alpha > this->alphaStall)
-  {
-    cd = (this->cda * this->alphaStall +
-          this->cdaStall * (this->alpha - this->alphaStall))
-         * cosSweepAngle;
-  }
-  else if (this->alpha < -this->alphaStall)
-  {
-    cd = (-this->cda * this->alphaStall +
-          this->cdaStall * (this->alpha + this->alphaStall))
-         * cosSweepAngle;
-  }
-  else
-    cd = (this->cda * this->alpha) * cosSweepAngle;
+  if (_sdf->HasElement("use_wind"))
+    this->useWind = _sdf->Get<bool>("use_wind");
 
-  // make sure drag is positive
-  cd = fabs(cd);
+  if (_sdf->HasElement("use_atmosphere"))
+    this->useAtmosphere = _sdf->Get<bool>("use_atmosphere");
 
-  // drag at cp
-  ignition::math::Vector3d drag = cd * q * this->area * dragDirection;
-
-  // compute cm at cp, check for stall, correct for sweep
-  double cm;
-  if (this->alpha > this->alphaStall)
-  {
-    cm = (this->cma * this->alphaStall +
-          this->cmaStall * (this->alpha - this->alphaStall))
-         * cosSweepAngle;
-    // make sure cm is still great than 0
-    cm = std::max(0.0, cm);
-  }
-  else if (this->alpha < -this->alphaStall)
+  // The surfaces of the world are evaluated together each step
+  if (this->link)
   {
-    cm = (-this->cma * this->alphaStall +
-          this->cmaStall * (this->alpha + this->alphaStall))
-         * cosSweepAngle;
-    // make sure cm is still less than 0
-    cm = std::min(0.0, cm);
+    this->system = LiftDragSystem::Instance(this->world);
+    this->system->Add(this);
   }
-  else
-    cm = this->cma * this->alpha * cosSweepAngle;
-
-  /// \TODO: implement cm
-  /// for now, reset cm to zero, as cm needs testing
-  cm = 0.0;
-
-  // compute moment (torque) at cp
-  ignition::math::Vector3d moment = cm * q * this->area * momentDirection;
-
-  // moment arm from cg to cp in inertial plane
-  ignition::math::Vector3d momentArm = pose.Rot().RotateVector(
-    this->cp - this->link->GetInertial()->CoG());
-  // gzerr << this->cp << " : " << this->link->GetInertial()->GetCoG() << "\n";
-
-  // force and torque about cg in inertial frame
-  ignition::math::Vector3d force = lift + drag;
-  // + moment.Cross(momentArm);
-
-  ignition::math::Vector3d torque = moment;
-  // - lift.Cross(momentArm) - drag.Cross(momentArm);
-
-  // debug
-  //
-  // if ((this->link->GetName() == "wing_1" ||
-  //      this->link->GetName() == "wing_2") &&
-  //     (vel.Length() > 50.0 &&
-  //      vel.Length() < 50.0))
-  if (0)
-  {
-    gzdbg << "=============================\n";
-    gzdbg << "sensor: [" << this->GetHandle() << "]\n";
-    gzdbg << "Link: [" << this->link->GetName()
-          << "] pose: [" << pose
-          << "] dynamic pressure: [" << q << "]\n";
-    gzdbg << "spd: [" << vel.Length()
-          << "] vel: [" << vel << "]\n";
-    gzdbg << "LD plane spd: [" << velInLDPlane.Length()
-          << "] vel : [" << velInLDPlane << "]\n";
-    gzdbg << "forward (inertial): " << forwardI << "\n";
-    gzdbg << "upward (inertial): " << upwardI << "\n";
-    gzdbg << "lift dir (inertial): " << liftI << "\n";
-    gzdbg << "Span direction (normal to LD plane): " << spanwiseI << "\n";
-    gzdbg << "sweep: " << this->sweep << "\n";
-    gzdbg << "alpha: " << this->alpha << "\n";
-    gzdbg << "lift: " << lift << "\n";
-    gzdbg << "drag: " << drag << " cd: "
-          << cd << " cda: " << this->cda << "\n";
-    gzdbg << "moment: " << moment << "\n";
-    gzdbg << "cp momentArm: " << momentArm << "\n";
-    gzdbg << "force: " << force << "\n";
-    gzdbg << "torque: " << torque << "\n";
-  }
-
-  // Correct for nan or inf
-  force.Correct();
-  this->cp.Correct();
-  torque.Correct();
+}
 
-  // apply forces at cg (with torques for position shift)
-  this->link->AddForceAtRelativePosition(force, this->cp);
-  this->link->AddTorque(torque);
-  IGN_PROFILE_END();
+/////////////////////////////////////////////////
+void LiftDragPlugin::OnUpdate()
+{
+  GZ_ASSERT(this->link, "Link was NULL");
+  if (this->system)
+    this->system->Update(this);
 }
@@ -17,6 +17,7 @@
 #ifndef GAZEBO_PLUGINS_LIFTDRAGPLUGIN_HH_
 #define GAZEBO_PLUGINS_LIFTDRAGPLUGIN_HH_
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -28,7 +29,13 @@
 
 namespace gazebo
 {
+  // Forward declare the system that evaluates the surfaces of a world.
+  class LiftDragSystem;
+
   /// \brief A plugin that simulates lift and drag.
+  ///
+  /// The surfaces of all the plugins of a world are evaluated together,
+  /// once per step, by a shared lift and drag system.
   class GZ_PLUGIN_VISIBLE LiftDragPlugin : public ModelPlugin
   {
     /// \brief Constructor.
@@ -40,10 +47,12 @@ namespace gazebo
     // Documentation Inherited.
     public: virtual void Load(physics::ModelPtr _model, sdf::ElementPtr _sdf);
 
-    /// \brief Callback for World Update events.
+    /// \brief Evaluate and apply the forces of this surface alone. The
+    /// surfaces are normally evaluated together by the system of the world.
     protected: virtual void OnUpdate();
 
-    /// \brief Connection to World Update events.
+    /// \brief Connection to World Update events, unused since the system
+    /// of the world updates the surfaces.
     protected: event::ConnectionPtr updateConnection;
 
     /// \brief Pointer to world.
@@ -134,8 +143,23 @@ namespace gazebo
     /// value.
     protected: double controlJointRadToCL;
 
+    /// \brief True to subtract the wind velocity from the velocity of the
+    /// surface, when the wind of the world is enabled.
+    protected: bool useWind;
+
+    /// \brief True to use the air density of the atmosphere of the world
+    /// at the altitude of the link instead of rho, when the atmosphere is
+    /// enabled.
+    protected: bool useAtmosphere;
+
     /// \brief SDF for this plugin;
     protected: sdf::ElementPtr sdf;
+
+    /// \brief System that evaluates the surfaces of the world.
+    private: std::shared_ptr<LiftDragSystem> system;
+
+    /// \brief The system reads the parameters of the surface.
+    private: friend class LiftDragSystem;
   };
 }
 #endif
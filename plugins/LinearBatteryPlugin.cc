@@ -22,6 +22,7 @@
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/Time.hh"
 #include "gazebo/common/Battery.hh"
+#include "gazebo/physics/BatterySystem.hh"
 #include "gazebo/physics/physics.hh"
 #include "plugins/LinearBatteryPlugin.hh"
 
@@ -46,6 +47,13 @@ LinearBatteryPlugin::LinearBatteryPlugin()
   this->tau = 0.0;
 }
 
+/////////////////////////////////////////////////
+LinearBatteryPlugin::~LinearBatteryPlugin()
+{
+  if (this->batched && this->world)
+    this->world->Batteries().RemoveLinearBattery(this->batteryId);
+}
+
 /////////////////////////////////////////////////
 void LinearBatteryPlugin::Load(physics::ModelPtr _parent, sdf::ElementPtr _sdf)
 {
@@ -98,6 +106,22 @@ void LinearBatteryPlugin::Load(physics::ModelPtr _parent, sdf::ElementPtr _sdf)
       gzerr << "Battery with name[" << batteryName << "] not found. "
             << "The LinearBatteryPlugin will not update its voltage\n";
     }
+    else if (_sdf->HasElement("batched") && _sdf->Get<bool>("batched"))
+    {
+      // Updated with the other batched batteries, at the rate of the
+      // battery system
+      physics::BatterySystem::LinearBattery params;
+      params.e0 = this->e0;
+      params.e1 = this->e1;
+      params.q0 = this->q0;
+      params.c = this->c;
+      params.r = this->r;
+      params.tau = this->tau;
+      this->batteryId = this->world->Batteries().AddLinearBattery(
+          this->battery, this->link->GetScopedName() + "::" + batteryName,
+          params);
+      this->batched = true;
+    }
     else
     {
       this->battery->SetUpdateFunc(
@@ -123,6 +147,9 @@ void LinearBatteryPlugin::Reset()
   this->iraw = 0.0;
   this->ismooth = 0.0;
   this->Init();
+
+  if (this->batched)
+    this->world->Batteries().ResetLinearBattery(this->batteryId);
 }
 
 /////////////////////////////////////////////////
@@ -32,6 +32,9 @@ namespace gazebo
     /// \brief Constructor.
     public: LinearBatteryPlugin();
 
+    /// \brief Destructor.
+    public: virtual ~LinearBatteryPlugin();
+
     // Documentation Inherited.
     public: virtual void Load(physics::ModelPtr _model, sdf::ElementPtr _sdf);
 
@@ -92,6 +95,15 @@ namespace gazebo
 
     /// \brief Instantaneous battery charge in Ah.
     protected: double q;
+
+    /// \brief True if the battery is updated by the battery system of the
+    /// world, together with the other batched batteries, instead of by
+    /// OnUpdateVoltage. Set with the <batched> element.
+    protected: bool batched = false;
+
+    /// \brief Identifier of the battery in the battery system of the
+    /// world, if batched.
+    protected: uint32_t batteryId = 0;
   };
 }
 #endif
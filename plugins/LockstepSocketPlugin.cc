@@ -0,0 +1,323 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/common/Events.hh"
+#include "gazebo/physics/World.hh"
+#include "plugins/LockstepSocketPlugin.hh"
+
+using namespace gazebo;
+
+GZ_REGISTER_WORLD_PLUGIN(LockstepSocketPlugin)
+
+namespace gazebo
+{
+  /// \brief Step request of the controller.
+  struct LockstepRequest
+  {
+    /// \brief Number of steps to take.
+    uint32_t steps;
+
+    /// \brief Sequence number, echoed by the step done message.
+    uint32_t sequence;
+  };
+
+  /// \brief Step done message.
+  struct LockstepDone
+  {
+    /// \brief Sequence number of the request.
+    uint32_t sequence;
+
+    /// \brief Unused, zero.
+    uint32_t reserved;
+
+    /// \brief Iterations of the world.
+    uint64_t iterations;
+
+    /// \brief Simulation time in nanoseconds.
+    int64_t simTimeNs;
+  };
+
+  /// \internal
+  /// \brief Private data for the LockstepSocketPlugin class
+  class LockstepSocketPluginPrivate
+  {
+    /// \brief Wait until a socket is readable, or the world stops.
+    /// \param[in] _fd The socket.
+    /// \return True if readable.
+    public: bool WaitReadable(const int _fd)
+    {
+      pollfd pfd;
+      pfd.fd = _fd;
+      pfd.events = POLLIN;
+      while (!this->stop)
+      {
+        // the timeout only bounds the time to notice that the world stops
+        const int ret = poll(&pfd, 1, 100);
+        if (ret > 0)
+          return true;
+        if (ret < 0 && errno != EINTR)
+          return false;
+      }
+      return false;
+    }
+
+    /// \brief Read or write a whole message.
+    /// \param[in] _write True to write, false to read.
+    /// \param[in] _data The message.
+    /// \param[in] _size Size of the message.
+    /// \return False if the controller disconnected.
+    public: bool Transfer(const bool _write, void *_data, const size_t _size)
+    {
+      char *data = static_cast<char *>(_data);
+      size_t done = 0;
+      while (done < _size)
+      {
+        if (!_write && !this->WaitReadable(this->client))
+          return false;
+        const ssize_t ret = _write ?
+            send(this->client, data + done, _size - done, MSG_NOSIGNAL) :
+            recv(this->client, data + done, _size - done, 0);
+        if (ret < 0 && errno == EINTR)
+          continue;
+        if (ret <= 0)
+          return false;
+        done += ret;
+      }
+      return true;
+    }
+
+    /// \brief Answer a request.
+    /// \param[in] _sequence Sequence number of the request.
+    /// \return False if the controller disconnected.
+    public: bool SendDone(const uint32_t _sequence)
+    {
+      LockstepDone done;
+      done.sequence = _sequence;
+      done.reserved = 0;
+      done.iterations = this->world->Iterations();
+      done.simTimeNs = this->world->SimTimeNs().Nanoseconds();
+      return this->Transfer(true, &done, sizeof(done));
+    }
+
+    /// \brief Close the connection of the controller.
+    public: void CloseClient()
+    {
+      if (this->client >= 0)
+      {
+        close(this->client);
+        this->client = -1;
+        gzmsg << "Lockstep controller disconnected\n";
+      }
+    }
+
+    /// \brief The world.
+    public: physics::WorldPtr world;
+
+    /// \brief Listening socket.
+    public: int listener = -1;
+
+    /// \brief Socket of the connected controller, -1 if none.
+    public: int client = -1;
+
+    /// \brief Path of the Unix socket, empty for TCP.
+    public: std::string unixSocket;
+
+    /// \brief Steps left of the current request.
+    public: uint32_t remaining = 0;
+
+    /// \brief Sequence number of the current request.
+    public: uint32_t sequence = 0;
+
+    /// \brief True once the world stops.
+    public: std::atomic<bool> stop{false};
+
+    /// \brief Event connections.
+    public: std::vector<event::ConnectionPtr> connections;
+  };
+}
+
+/////////////////////////////////////////////////
+LockstepSocketPlugin::LockstepSocketPlugin()
+  : dataPtr(new LockstepSocketPluginPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+LockstepSocketPlugin::~LockstepSocketPlugin()
+{
+  this->dataPtr->connections.clear();
+  this->dataPtr->CloseClient();
+  if (this->dataPtr->listener >= 0)
+    close(this->dataPtr->listener);
+  if (!this->dataPtr->unixSocket.empty())
+    unlink(this->dataPtr->unixSocket.c_str());
+}
+
+/////////////////////////////////////////////////
+void LockstepSocketPlugin::Load(physics::WorldPtr _world,
+    sdf::ElementPtr _sdf)
+{
+  this->dataPtr->world = _world;
+
+  if (_sdf->HasElement("unix_socket"))
+  {
+    this->dataPtr->unixSocket = _sdf->Get<std::string>("unix_socket");
+
+    sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (this->dataPtr->unixSocket.size() >= sizeof(addr.sun_path))
+    {
+      gzerr << "Unix socket path [" << this->dataPtr->unixSocket
+            << "] is too long\n";
+      return;
+    }
+    strncpy(addr.sun_path, this->dataPtr->unixSocket.c_str(),
+        sizeof(addr.sun_path) - 1);
+    unlink(addr.sun_path);
+
+    this->dataPtr->listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (this->dataPtr->listener < 0 ||
+        bind(this->dataPtr->listener, reinterpret_cast<sockaddr *>(&addr),
+          sizeof(addr)) != 0)
+    {
+      gzerr << "Unable to bind Unix socket [" << this->dataPtr->unixSocket
+            << "]: " << strerror(errno) << "\n";
+      return;
+    }
+  }
+  else
+  {
+    const std::string address = _sdf->Get<std::string>("address",
+        "127.0.0.1").first;
+    const int port = _sdf->Get<int>("port", 9015).first;
+
+    sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    if (inet_pton(AF_INET, address.c_str(), &addr.sin_addr) != 1)
+    {
+      gzerr << "Invalid lockstep address [" << address << "]\n";
+      return;
+    }
+
+    this->dataPtr->listener = socket(AF_INET, SOCK_STREAM, 0);
+    int one = 1;
+    if (this->dataPtr->listener >= 0)
+    {
+      setsockopt(this->dataPtr->listener, SOL_SOCKET, SO_REUSEADDR, &one,
+          sizeof(one));
+    }
+    if (this->dataPtr->listener < 0 ||
+        bind(this->dataPtr->listener, reinterpret_cast<sockaddr *>(&addr),
+          sizeof(addr)) != 0)
+    {
+      gzerr << "Unable to bind lockstep socket [" << address << ":" << port
+            << "]: " << strerror(errno) << "\n";
+      return;
+    }
+  }
+
+  if (listen(this->dataPtr->listener, 1) != 0)
+  {
+    gzerr << "Unable to listen on the lockstep socket: " << strerror(errno)
+          << "\n";
+    close(this->dataPtr->listener);
+    this->dataPtr->listener = -1;
+    return;
+  }
+
+  this->dataPtr->connections.push_back(
+      event::Events::ConnectWorldUpdateBegin(
+      std::bind(&LockstepSocketPlugin::OnWorldUpdateBegin, this)));
+  this->dataPtr->connections.push_back(
+      event::Events::ConnectWorldUpdateEnd(
+      std::bind(&LockstepSocketPlugin::OnWorldUpdateEnd, this)));
+  this->dataPtr->connections.push_back(
+      event::Events::ConnectStop([this]() {this->dataPtr->stop = true;}));
+}
+
+/////////////////////////////////////////////////
+void LockstepSocketPlugin::OnWorldUpdateBegin()
+{
+  // The world thread blocks here, between two steps, until the controller
+  // requests more steps. Nothing is polled meanwhile.
+  while (this->dataPtr->remaining == 0 && !this->dataPtr->stop)
+  {
+    if (this->dataPtr->client < 0)
+    {
+      if (!this->dataPtr->WaitReadable(this->dataPtr->listener))
+        continue;
+      this->dataPtr->client = accept(this->dataPtr->listener, nullptr,
+          nullptr);
+      if (this->dataPtr->client < 0)
+        continue;
+
+      int one = 1;
+      if (this->dataPtr->unixSocket.empty())
+      {
+        setsockopt(this->dataPtr->client, IPPROTO_TCP, TCP_NODELAY, &one,
+            sizeof(one));
+      }
+      gzmsg << "Lockstep controller connected\n";
+    }
+
+    LockstepRequest request;
+    if (!this->dataPtr->Transfer(false, &request, sizeof(request)))
+    {
+      this->dataPtr->CloseClient();
+      continue;
+    }
+
+    if (request.steps == 0)
+    {
+      if (!this->dataPtr->SendDone(request.sequence))
+        this->dataPtr->CloseClient();
+      continue;
+    }
+
+    this->dataPtr->remaining = request.steps;
+    this->dataPtr->sequence = request.sequence;
+  }
+}
+
+/////////////////////////////////////////////////
+void LockstepSocketPlugin::OnWorldUpdateEnd()
+{
+  if (this->dataPtr->remaining == 0 || --this->dataPtr->remaining > 0)
+    return;
+
+  if (!this->dataPtr->SendDone(this->dataPtr->sequence))
+    this->dataPtr->CloseClient();
+}
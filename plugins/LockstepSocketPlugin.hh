@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PLUGINS_LOCKSTEPSOCKETPLUGIN_HH_
+#define GAZEBO_PLUGINS_LOCKSTEPSOCKETPLUGIN_HH_
+
+#include <memory>
+
+#include "gazebo/common/Plugin.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  // Forward declaration
+  class LockstepSocketPluginPrivate;
+
+  /// \brief Steps the world in lockstep with an external controller over
+  /// a persistent socket, without transport messages or polling.
+  ///
+  /// The world thread waits for a step request of the controller, takes
+  /// the requested steps at full speed and answers with a step done
+  /// message, then waits again. The world does not advance while no
+  /// controller is connected. Set the real time update rate to 0 so that
+  /// the steps are not throttled. The world must not be paused.
+  ///
+  /// Messages are packed, in host byte order:
+  /// - request: uint32 steps, uint32 sequence number. Zero steps answers
+  ///   at once with the current iteration, without stepping.
+  /// - step done: uint32 sequence number of the request, uint32 zero,
+  ///   uint64 iterations, int64 simulation time in nanoseconds.
+  ///
+  /// Example:
+  /// \verbatim
+  ///   <plugin name="lockstep" filename="libLockstepSocketPlugin.so">
+  ///     <!-- TCP address and port, or a Unix socket path -->
+  ///     <address>127.0.0.1</address>
+  ///     <port>9015</port>
+  ///     <unix_socket>/tmp/gazebo_lockstep</unix_socket>
+  ///   </plugin>
+  /// \endverbatim
+  class GZ_PLUGIN_VISIBLE LockstepSocketPlugin : public WorldPlugin
+  {
+    /// \brief Constructor.
+    public: LockstepSocketPlugin();
+
+    /// \brief Destructor.
+    public: virtual ~LockstepSocketPlugin();
+
+    // Documentation inherited
+    public: virtual void Load(physics::WorldPtr _world, sdf::ElementPtr _sdf);
+
+    /// \brief Wait for a step request before the first step of a request.
+    private: void OnWorldUpdateBegin();
+
+    /// \brief Answer the controller after the last step of a request.
+    private: void OnWorldUpdateEnd();
+
+    /// \internal
+    /// \brief Private data pointer.
+    private: std::unique_ptr<LockstepSocketPluginPrivate> dataPtr;
+  };
+}
+#endif
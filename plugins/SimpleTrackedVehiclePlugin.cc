@@ -58,6 +58,15 @@ GZ_REGISTER_MODEL_PLUGIN(SimpleTrackedVehiclePlugin)
 
 SimpleTrackedVehiclePlugin::~SimpleTrackedVehiclePlugin()
 {
+  if (this->odePhysics != nullptr)
+  {
+    for (auto collision : this->trackCollisions)
+    {
+      this->odePhysics->SetContactSurfaceCallback(collision,
+          physics::ODEPhysics::ContactSurfaceCallback());
+    }
+  }
+
   if (this->body != nullptr)
   {
     if (globalTracks.find(this->body) != globalTracks.end())
@@ -203,11 +212,6 @@ void SimpleTrackedVehiclePlugin::Init()
 
   physics::ModelPtr model = this->body->GetModel();
 
-  this->contactManager = model->GetWorld()->Physics()->GetContactManager();
-  // otherwise contact manager would not publish any contacts (since we are not
-  // a real contact subscriber)
-  this->contactManager->SetNeverDropContacts(true);
-
   // set correct categories and collide bitmasks
   this->SetGeomCategories();
 
@@ -219,10 +223,40 @@ void SimpleTrackedVehiclePlugin::Init()
   this->node = transport::NodePtr(new transport::Node());
   this->node->Init(model->GetWorld()->Name());
 
-  this->beforePhysicsUpdateConnection =
-      event::Events::ConnectBeforePhysicsUpdate(
+  // the drive state is computed before the collisions are updated, and
+  // applied to the contacts of each track while its contact joints are
+  // created
+  this->worldUpdateConnection =
+      event::Events::ConnectWorldUpdateBegin(
           std::bind(&SimpleTrackedVehiclePlugin::DriveTracks, this,
                     std::placeholders::_1));
+
+  this->odePhysics = boost::dynamic_pointer_cast<physics::ODEPhysics>(
+      model->GetWorld()->Physics());
+  GZ_ASSERT(this->odePhysics != nullptr,
+            "SimpleTrackedVehiclePlugin: physics engine is not ODE");
+
+  auto& gtracks = globalTracks.at(this->body);
+  for (auto trackSide : gtracks)
+  {
+    const auto side = trackSide.first;
+    for (auto trackLink : trackSide.second)
+    {
+      for (auto const &collision : trackLink->GetCollisions())
+      {
+        auto odeCollision =
+            boost::dynamic_pointer_cast<physics::ODECollision>(collision);
+        if (odeCollision == nullptr)
+          continue;
+
+        this->trackCollisions.push_back(odeCollision.get());
+        this->odePhysics->SetContactSurfaceCallback(odeCollision.get(),
+            std::bind(&SimpleTrackedVehiclePlugin::DriveContacts, this, side,
+                      std::placeholders::_1, std::placeholders::_2,
+                      std::placeholders::_3, std::placeholders::_4));
+      }
+    }
+  }
 }
 
 void SimpleTrackedVehiclePlugin::Reset()
@@ -302,11 +336,7 @@ size_t SimpleTrackedVehiclePlugin::GetNumTracks(const Tracks side) const
 void SimpleTrackedVehiclePlugin::DriveTracks(
     const common::UpdateInfo &/*_unused*/)
 {
-  if (this->contactManager->GetContactCount() == 0)
-    return;
-
   IGN_PROFILE("SimpleTrackedVehiclePlugin::DriveTracks");
-  IGN_PROFILE_BEGIN("Update");
 
   /////////////////////////////////////////////
   // Calculate the desired center of rotation
@@ -314,177 +344,104 @@ void SimpleTrackedVehiclePlugin::DriveTracks(
 
   const auto leftBeltSpeed = -this->trackVelocity[Tracks::LEFT];
   const auto rightBeltSpeed = -this->trackVelocity[Tracks::RIGHT];
+  this->beltSpeed[Tracks::LEFT] = leftBeltSpeed;
+  this->beltSpeed[Tracks::RIGHT] = rightBeltSpeed;
 
   // the desired linear and angular speeds (set by desired track velocities)
-  const auto linearSpeed = (leftBeltSpeed + rightBeltSpeed) / 2;
-  const auto angularSpeed = -(leftBeltSpeed - rightBeltSpeed) *
+  this->linearSpeed = (leftBeltSpeed + rightBeltSpeed) / 2;
+  this->angularSpeed = -(leftBeltSpeed - rightBeltSpeed) *
     this->GetSteeringEfficiency() / this->GetTracksSeparation();
 
   // radius of the turn the robot is doing
   const auto desiredRotationRadiusSigned =
-                               (fabs(angularSpeed) < 0.1) ?
+                               (fabs(this->angularSpeed) < 0.1) ?
                                // is driving straight
                                dInfinity :
                                (
-                                 (fabs(linearSpeed) < 0.1) ?
+                                 (fabs(this->linearSpeed) < 0.1) ?
                                  // is rotating about a single point
                                  0 :
                                  // general movement
-                                 linearSpeed / angularSpeed);
+                                 this->linearSpeed / this->angularSpeed);
+  this->drivingStraight = desiredRotationRadiusSigned == dInfinity;
+
+  this->bodyPose = this->body->WorldPose();
+  this->bodyYAxisGlobal =
+    this->bodyPose.Rot().RotateVector(ignition::math::Vector3d(0, 1, 0));
+  this->centerOfRotation =
+    (this->bodyYAxisGlobal * desiredRotationRadiusSigned) +
+    this->bodyPose.Pos();
+}
+
+void SimpleTrackedVehiclePlugin::DriveContacts(const Tracks _side,
+    physics::ODECollision *_track, physics::ODECollision *_other,
+    dContact *_contacts, const unsigned int _count)
+{
+  if (_track->GetSurface()->collideWithoutContact ||
+      _other->GetSurface()->collideWithoutContact)
+    return;
 
-  const auto bodyPose = this->body->WorldPose();
-  const auto bodyYAxisGlobal =
-    bodyPose.Rot().RotateVector(ignition::math::Vector3d(0, 1, 0));
-  const auto centerOfRotation =
-    (bodyYAxisGlobal * desiredRotationRadiusSigned) + bodyPose.Pos();
+  if (!_track->GetLink()->GetEnabled() || !_other->GetLink()->GetEnabled())
+    return;
+
+  IGN_PROFILE("SimpleTrackedVehiclePlugin::DriveContacts");
 
   ////////////////////////////////////////////////////////////////////////
   // For each contact, compute the friction force direction and speed of
   // surface movement.
   ////////////////////////////////////////////////////////////////////////
-  size_t i = 0;
-  const auto contacts = this->contactManager->GetContacts();
-  const auto model = this->body->GetModel();
+  const dReal beltSpeed = this->beltSpeed[_side];
+  const auto trackPosition = _track->WorldPose().Pos();
 
-  for (auto contact : contacts)
+  for (unsigned int i = 0; i < _count; ++i)
   {
-    // Beware! There may be invalid contacts beyond GetContactCount()...
-    if (i == this->contactManager->GetContactCount())
-      break;
-
-    ++i;
-
-    if (contact->collision1->GetSurface()->collideWithoutContact ||
-      contact->collision2->GetSurface()->collideWithoutContact)
-      continue;
-
-    if (!contact->collision1->GetLink()->GetEnabled() ||
-      !contact->collision2->GetLink()->GetEnabled())
-      continue;
-
-    if (contact->collision1->IsStatic() && contact->collision2->IsStatic())
-    {
-      // we're not interested in static model collisions
-      // (they do not have any ODE bodies).
-      continue;
-    }
-
-    if (model != contact->collision1->GetLink()->GetModel() &&
-        model != contact->collision2->GetLink()->GetModel())
-    {
-      // Verify one of the collisions' bodies is a track of this vehicle
-      continue;
-    }
-
-    dBodyID body1 = dynamic_cast<physics::ODELink&>(
-      *contact->collision1->GetLink()).GetODEId();
-    dBodyID body2 = dynamic_cast<physics::ODELink& >(
-      *contact->collision2->GetLink()).GetODEId();
-
-    dGeomID geom1 = dynamic_cast<physics::ODECollision& >(
-      *contact->collision1).GetCollisionId();
-    dGeomID geom2 = dynamic_cast<physics::ODECollision& >(
-      *contact->collision2).GetCollisionId();
-
-    bool bodiesSwapped = false;
-    if (body1 == 0)
-    {
-      std::swap(body1, body2);
-      std::swap(geom1, geom2);
-
-      // we'll take care of the normal flipping later
-      bodiesSwapped = true;
-    }
-
-    // determine if track is the first or second collision element
-    const bool isGeom1Track = (dGeomGetCategoryBits(geom1) & BELT_CATEGORY) > 0;
-    const bool isGeom2Track = (dGeomGetCategoryBits(geom2) & BELT_CATEGORY) > 0;
-
-    if (!isGeom1Track && !isGeom2Track)
-      continue;
-
-    // speed and geometry of the track in collision
-    const auto trackGeom = (isGeom1Track ? geom1 : geom2);
-    // the != means XOR here; we basically want to get the collision belonging
-    // to the track, but we might have swapped the ODE bodies in between,
-    // so we have to account for it
-    const physics::Collision* trackCollision =
-      ((isGeom1Track != bodiesSwapped) ? contact->collision1
-                                       : contact->collision2);
-    const dReal beltSpeed =
-      (dGeomGetCategoryBits(trackGeom) & LEFT_CATEGORY) != 0 ?
-      leftBeltSpeed : rightBeltSpeed;
-
-    // remember if we've found at least one contact joint (we should!)
-    bool foundContact = false;
-    for (auto contactIterator = ContactIterator::begin(body1, geom1, geom2);
-         contactIterator != ContactIterator::end();
-         ++contactIterator)
-    {
-      dContact* odeContact = contactIterator.getPointer();
-
-      // now we're sure it is a contact between our two geometries
-      foundContact = true;
-
-      const ignition::math::Vector3d contactWorldPosition(
-        odeContact->geom.pos[0],
-        odeContact->geom.pos[1],
-        odeContact->geom.pos[2]);
-
-      ignition::math::Vector3d contactNormal(
-        odeContact->geom.normal[0],
-        odeContact->geom.normal[1],
-        odeContact->geom.normal[2]);
-
-      // We always want contactNormal to point "inside" the track.
-      // The dot product is 1 for co-directional vectors and -1 for
-      // opposite-pointing vectors.
-      // The contact can be flipped either by swapping body1 and body2 above,
-      // or by having some flipped faces on collision meshes.
-      const double normalToTrackCenterDot =
-        contactNormal.Dot(
-          trackCollision->WorldPose().Pos() - contactWorldPosition);
-      if (normalToTrackCenterDot < 0)
-      {
-        contactNormal = -contactNormal;
-      }
-
-      // vector tangent to the belt pointing in the belt's movement direction
-      auto beltDirection(contactNormal.Cross(bodyYAxisGlobal));
-
-      if (beltSpeed > 0)
-        beltDirection = -beltDirection;
-
-      const auto frictionDirection =
-        this->ComputeFrictionDirection(linearSpeed,
-                                       angularSpeed,
-                                       desiredRotationRadiusSigned == dInfinity,
-                                       bodyPose,
-                                       bodyYAxisGlobal,
-                                       centerOfRotation,
-                                       contactWorldPosition,
-                                       contactNormal,
-                                       beltDirection);
-
-      odeContact->fdir1[0] = frictionDirection.X();
-      odeContact->fdir1[1] = frictionDirection.Y();
-      odeContact->fdir1[2] = frictionDirection.Z();
-
-      // use friction direction and motion1 to simulate the track movement
-      odeContact->surface.mode |= dContactFDir1 | dContactMotion1;
-
-      odeContact->surface.motion1 = this->ComputeSurfaceMotion(
-        beltSpeed, beltDirection, frictionDirection);
-    }
-
-    if (!foundContact)
-    {
-      gzwarn << "No ODE contact joint found for contact " <<
-             contact->DebugString() << std::endl;
-      continue;
-    }
+    dContact &odeContact = _contacts[i];
+
+    const ignition::math::Vector3d contactWorldPosition(
+      odeContact.geom.pos[0],
+      odeContact.geom.pos[1],
+      odeContact.geom.pos[2]);
+
+    ignition::math::Vector3d contactNormal(
+      odeContact.geom.normal[0],
+      odeContact.geom.normal[1],
+      odeContact.geom.normal[2]);
+
+    // We always want contactNormal to point "inside" the track.
+    // The dot product is 1 for co-directional vectors and -1 for
+    // opposite-pointing vectors.
+    // The contact can be flipped either by the order of the geoms in the
+    // collision pair, or by having some flipped faces on collision meshes.
+    if (contactNormal.Dot(trackPosition - contactWorldPosition) < 0)
+      contactNormal = -contactNormal;
+
+    // vector tangent to the belt pointing in the belt's movement direction
+    auto beltDirection(contactNormal.Cross(this->bodyYAxisGlobal));
+
+    if (beltSpeed > 0)
+      beltDirection = -beltDirection;
+
+    const auto frictionDirection =
+      this->ComputeFrictionDirection(this->linearSpeed,
+                                     this->angularSpeed,
+                                     this->drivingStraight,
+                                     this->bodyPose,
+                                     this->bodyYAxisGlobal,
+                                     this->centerOfRotation,
+                                     contactWorldPosition,
+                                     contactNormal,
+                                     beltDirection);
+
+    odeContact.fdir1[0] = frictionDirection.X();
+    odeContact.fdir1[1] = frictionDirection.Y();
+    odeContact.fdir1[2] = frictionDirection.Z();
+
+    // use friction direction and motion1 to simulate the track movement
+    odeContact.surface.mode |= dContactFDir1 | dContactMotion1;
+
+    odeContact.surface.motion1 = this->ComputeSurfaceMotion(
+      beltSpeed, beltDirection, frictionDirection);
   }
-  IGN_PROFILE_END();
 }
 
 ignition::math::Vector3d SimpleTrackedVehiclePlugin::ComputeFrictionDirection(
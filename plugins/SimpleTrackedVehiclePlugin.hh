@@ -20,12 +20,14 @@
 
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include <boost/algorithm/string.hpp>
 
 #include <gazebo/physics/ode/ode_inc.h>
 #include <gazebo/physics/ode/ODELink.hh>
 #include <gazebo/physics/ode/ODECollision.hh>
+#include <gazebo/physics/ode/ODEPhysics.hh>
 #include <gazebo/ode/contact.h>
 
 #include "gazebo/common/Plugin.hh"
@@ -59,6 +61,9 @@ namespace gazebo {
   ///     Can appear multiple times.
   /// <collide_without_contact_bitmask> Collision bitmask that will be set to
   ///     the whole vehicle (default is 1u).
+  ///
+  /// The contacts of the tracks are adjusted by contact surface functions of
+  /// ODEPhysics, so only the contacts of this vehicle's tracks are visited.
 
   class GZ_PLUGIN_VISIBLE SimpleTrackedVehiclePlugin :
     public TrackedVehiclePlugin
@@ -97,9 +102,21 @@ namespace gazebo {
     /// \brief Desired velocities of the tracks.
     protected: std::unordered_map<Tracks, double> trackVelocity;
 
-    /// \brief Compute and apply the forces that make the tracks move.
+    /// \brief Compute the desired motion of the vehicle for this step,
+    /// which DriveContacts applies to the contacts of the tracks.
     protected: void DriveTracks(const common::UpdateInfo &/*_unused*/);
 
+    /// \brief Set the friction direction and surface motion of the contacts
+    /// of a track collision, so that they make the track move.
+    /// \param[in] _side Side of the track.
+    /// \param[in] _track The track collision.
+    /// \param[in] _other The other collision of the contacts.
+    /// \param[in,out] _contacts The contacts.
+    /// \param[in] _count Number of contacts.
+    protected: void DriveContacts(const Tracks _side,
+      physics::ODECollision *_track, physics::ODECollision *_other,
+      dContact *_contacts, const unsigned int _count);
+
     /// \brief Return the number of tracks on the given side. Should always be
     /// at least 1 for the main track. If flippers are present, the number is
     /// higher.
@@ -144,7 +161,34 @@ namespace gazebo {
 
     private: transport::NodePtr node;
 
-    private: event::ConnectionPtr beforePhysicsUpdateConnection;
+    private: event::ConnectionPtr worldUpdateConnection;
+
+    /// \brief The physics engine the contact surface functions are set in.
+    private: physics::ODEPhysicsPtr odePhysics;
+
+    /// \brief Track collisions with a contact surface function.
+    private: std::vector<physics::ODECollision *> trackCollisions;
+
+    /// \brief Desired belt speeds of this step.
+    private: std::unordered_map<Tracks, double> beltSpeed;
+
+    /// \brief Desired linear speed of the vehicle in this step.
+    private: double linearSpeed = 0;
+
+    /// \brief Desired angular speed of the vehicle in this step.
+    private: double angularSpeed = 0;
+
+    /// \brief True if the vehicle drives straight in this step.
+    private: bool drivingStraight = true;
+
+    /// \brief Pose of the body at the start of this step.
+    private: ignition::math::Pose3d bodyPose;
+
+    /// \brief Direction of the y-axis of the body in world frame.
+    private: ignition::math::Vector3d bodyYAxisGlobal;
+
+    /// \brief Desired center of rotation of the vehicle in this step.
+    private: ignition::math::Vector3d centerOfRotation;
 
     /// \brief This bitmask will be set to the whole vehicle body.
     protected: unsigned int collideWithoutContactBitmask;
@@ -155,8 +199,6 @@ namespace gazebo {
     /// \brief Category for all items on the left side.
     protected: static const unsigned int LEFT_CATEGORY = 0x40000000;
 
-    private: physics::ContactManager *contactManager;
-
     /// \class ContactIterator
     /// \brief An iterator over all contacts between two geometries.
     class ContactIterator : std::iterator<std::input_iterator_tag, dContact>
@@ -18,12 +18,22 @@
 #include <curl/curl.h>
 #include <boost/filesystem.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <string>
+#include <thread>
+#include <vector>
+
 #include <ignition/math/Angle.hh>
 #include <ignition/math/Helpers.hh>
 #include <ignition/math/SphericalCoordinates.hh>
 #include <ignition/math/Vector2.hh>
 #include <gazebo/physics/physics.hh>
 #include <gazebo/common/CommonIface.hh>
+#include <gazebo/common/Image.hh>
 #include <gazebo/transport/Node.hh>
 
 #include "StaticMapPlugin.hh"
@@ -73,19 +83,39 @@ namespace gazebo
         const std::string &_mapType, const std::string &_apiKey,
         const std::string &_saveDirPath);
 
+    /// \brief Stitch the map tiles into a single texture image.
+    /// \param[in] _xNumTiles Number of tiles in x direction
+    /// \param[in] _yNumTiles Number of tiles in y direction
+    /// \param[in] _tiles Tile image filenames
+    /// \param[in] _texturesPath Directory of the tile images, where the
+    /// texture is saved too.
+    /// \return Filename of the texture, or empty if the tiles could not
+    /// be stitched.
+    public: std::string StitchAtlas(
+        const unsigned int _xNumTiles, const unsigned int _yNumTiles,
+        const std::vector<std::string> &_tiles,
+        const std::string &_texturesPath) const;
+
     /// \brief Create textured map model and save it in specified path.
     /// \param[in] _name Name of map model
     /// \param[in] _tileWorldSize Size of map tiles in meters
     /// \param[in] _xNumTiles Number of tiles in x direction
     /// \param[in] _yNumTiles Number of tiles in y direction
     /// \param[in] _tiles Tile image filenames
+    /// \param[in] _atlas Filename of the texture of all the tiles, or empty
+    /// to create a visual per tile.
     /// \param[in] _modelPath Path to model directory
     /// \return True if map tile model has been successfully created.
     public: bool CreateMapTileModel(
         const std::string &_name,
         const double _tileWorldSize,
         const unsigned int xNumTiles, const unsigned int yNumTiles,
-        const std::vector<std::string> &_tiles, const std::string &_modelPath);
+        const std::vector<std::string> &_tiles, const std::string &_atlas,
+        const std::string &_modelPath);
+
+    /// \brief Download the map tiles, create the map model and spawn it.
+    /// Runs in createThread.
+    public: void CreateMap();
 
     /// \brief Get the ground resolution at the specified latitude and zoom
     /// level.
@@ -146,6 +176,21 @@ namespace gazebo
 
     /// \brief True if the plugin is loaded successfully
     public: bool loaded = false;
+
+    /// \brief True to keep downloaded tiles in the tile cache.
+    public: bool tileCache = true;
+
+    /// \brief Number of tiles downloaded at the same time.
+    public: unsigned int maxDownloads = 8u;
+
+    /// \brief True to stitch the tiles into a single texture.
+    public: bool atlas = true;
+
+    /// \brief Thread that downloads the tiles and creates the model.
+    public: std::thread createThread;
+
+    /// \brief Set to abort the creation of the map.
+    public: std::atomic<bool> stop{false};
   };
 }
 
@@ -163,56 +208,134 @@ size_t WriteData(void *_ptr, size_t _size, size_t _nmemb, FILE *_stream)
 }
 
 /////////////////////////////////////////////////
-bool DownloadFile(const std::string &_url, const std::string &_outputFile)
+/// \brief A file to download.
+class Download
 {
-  if (_url.empty())
-    return false;
+  /// \brief URL of the file.
+  public: std::string url;
 
-  CURL *curl = curl_easy_init();
+  /// \brief Path the file is saved to.
+  public: std::string path;
 
-  curl_easy_setopt(curl, CURLOPT_URL, _url.c_str());
-  curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteData);
+  /// \brief True once the file was downloaded successfully.
+  public: bool done = false;
 
-  FILE *fp = fopen(_outputFile.c_str(), "wb");
-  if (!fp)
-  {
-    gzerr << "Could not download model[" << _url << "] because we were"
-      << "unable to write to file[" << _outputFile << "]."
-      << "Please fix file permissions.";
-    return false;
-  }
-  curl_easy_setopt(curl, CURLOPT_WRITEDATA, fp);
+  /// \brief Open output file while downloading.
+  public: FILE *file = nullptr;
+
+  /// \brief Transfer handle while downloading.
+  public: CURL *handle = nullptr;
 
-  char errbuf[CURL_ERROR_SIZE];
-  // provide a buffer to store errors in
-  curl_easy_setopt(curl, CURLOPT_ERRORBUFFER, errbuf);
-  // set the error buffer as empty before performing a request
-  errbuf[0] = 0;
+  /// \brief Error buffer of the transfer.
+  public: char errbuf[CURL_ERROR_SIZE];
+};
 
-  CURLcode success = curl_easy_perform(curl);
-  if (success != CURLE_OK)
+/////////////////////////////////////////////////
+/// \brief Download files, several at the same time.
+/// \param[in,out] _downloads The files. Download::done is set for the
+/// files that were downloaded.
+/// \param[in] _maxConcurrent Maximum number of transfers at the same time.
+/// \param[in] _stop Flag that aborts the transfers when set.
+void DownloadFiles(std::vector<Download> &_downloads,
+    const unsigned int _maxConcurrent, const std::atomic<bool> &_stop)
+{
+  CURLM *multi = curl_multi_init();
+  size_t next = 0;
+  int running = 0;
+
+  // start as many transfers as allowed
+  auto start = [&]()
   {
-    gzerr << "Error in REST request" << std::endl;
-    size_t len = strlen(errbuf);
-    fprintf(stderr, "\nlibcurl: (%d) ", success);
-    if (len)
+    while (next < _downloads.size() &&
+        running < static_cast<int>(std::max(_maxConcurrent, 1u)))
     {
-      fprintf(stderr, "%s%s", errbuf,
-              ((errbuf[len - 1] != '\n') ? "\n" : ""));
+      Download &download = _downloads[next++];
+      download.file = fopen(download.path.c_str(), "wb");
+      if (!download.file)
+      {
+        gzerr << "Could not download map tile[" << download.url
+              << "] because we were unable to write to file["
+              << download.path << "]. Please fix file permissions."
+              << std::endl;
+        continue;
+      }
+
+      CURL *curl = curl_easy_init();
+      curl_easy_setopt(curl, CURLOPT_URL, download.url.c_str());
+      curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteData);
+      curl_easy_setopt(curl, CURLOPT_WRITEDATA, download.file);
+      curl_easy_setopt(curl, CURLOPT_ERRORBUFFER, download.errbuf);
+      curl_easy_setopt(curl, CURLOPT_PRIVATE, &download);
+      download.errbuf[0] = 0;
+      download.handle = curl;
+      curl_multi_add_handle(multi, curl);
+      ++running;
     }
-    else
-      fprintf(stderr, "%s\n", curl_easy_strerror(success));
-  }
-  fclose(fp);
+  };
 
-  // Update the status code.
-  int statusCode = 0;
-  curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &statusCode);
+  start();
+  while (running > 0 && !_stop)
+  {
+    int active = 0;
+    curl_multi_perform(multi, &active);
 
-  // Cleaning.
-  curl_easy_cleanup(curl);
+    // finish the completed transfers
+    int queued = 0;
+    while (CURLMsg *msg = curl_multi_info_read(multi, &queued))
+    {
+      if (msg->msg != CURLMSG_DONE)
+        continue;
 
-  return true;
+      CURL *curl = msg->easy_handle;
+      Download *download = nullptr;
+      curl_easy_getinfo(curl, CURLINFO_PRIVATE, &download);
+
+      long statusCode = 0;
+      curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &statusCode);
+
+      fclose(download->file);
+      download->file = nullptr;
+      if (msg->data.result != CURLE_OK)
+      {
+        gzerr << "Error downloading map tile[" << download->url << "]: "
+              << (download->errbuf[0] ? download->errbuf :
+                  curl_easy_strerror(msg->data.result)) << std::endl;
+      }
+      else if (statusCode != 200)
+      {
+        gzerr << "Error downloading map tile[" << download->url
+              << "]: HTTP status " << statusCode << std::endl;
+      }
+      else
+        download->done = true;
+
+      curl_multi_remove_handle(multi, curl);
+      curl_easy_cleanup(curl);
+      download->handle = nullptr;
+      --running;
+    }
+
+    start();
+    if (running > 0)
+      curl_multi_wait(multi, nullptr, 0, 100, nullptr);
+  }
+
+  // abort the transfers left when stopped
+  for (auto &download : _downloads)
+  {
+    if (download.handle)
+    {
+      curl_multi_remove_handle(multi, download.handle);
+      curl_easy_cleanup(download.handle);
+      download.handle = nullptr;
+    }
+    if (download.file)
+    {
+      fclose(download.file);
+      download.file = nullptr;
+    }
+  }
+  curl_multi_cleanup(multi);
 }
 
 
@@ -261,6 +384,14 @@ StaticMapPlugin::StaticMapPlugin()
 {
 }
 
+/////////////////////////////////////////////////
+StaticMapPlugin::~StaticMapPlugin()
+{
+  this->dataPtr->stop = true;
+  if (this->dataPtr->createThread.joinable())
+    this->dataPtr->createThread.join();
+}
+
 /////////////////////////////////////////////////
 void StaticMapPlugin::Load(physics::WorldPtr _world, sdf::ElementPtr _sdf)
 {
@@ -322,6 +453,15 @@ void StaticMapPlugin::Load(physics::WorldPtr _world, sdf::ElementPtr _sdf)
   if (_sdf->HasElement("use_cache"))
     this->dataPtr->useCache = _sdf->Get<bool>("use_cache");
 
+  if (_sdf->HasElement("tile_cache"))
+    this->dataPtr->tileCache = _sdf->Get<bool>("tile_cache");
+
+  if (_sdf->HasElement("max_downloads"))
+    this->dataPtr->maxDownloads = _sdf->Get<unsigned int>("max_downloads");
+
+  if (_sdf->HasElement("atlas"))
+    this->dataPtr->atlas = _sdf->Get<bool>("atlas");
+
   if (_sdf->HasElement("pose"))
     this->dataPtr->modelPose = _sdf->Get<ignition::math::Pose3d>("pose");
 
@@ -367,38 +507,59 @@ void StaticMapPlugin::Init()
     return;
   }
 
+  // download the tiles without blocking the world
+  this->dataPtr->createThread =
+      std::thread(&StaticMapPluginPrivate::CreateMap, this->dataPtr.get());
+}
+
+/////////////////////////////////////////////////
+void StaticMapPluginPrivate::CreateMap()
+{
+  auto basePath = common::SystemPaths::Instance()->GetLogPath() /
+        boost::filesystem::path("models");
+  boost::filesystem::path modelPath = basePath / this->modelName;
 
   // create tmp dir to save model files
   boost::filesystem::path tmpModelPath =
-      boost::filesystem::temp_directory_path() / this->dataPtr->modelName;
+      boost::filesystem::temp_directory_path() / this->modelName;
   boost::filesystem::path scriptsPath(tmpModelPath / "materials" / "scripts");
   boost::filesystem::create_directories(scriptsPath);
   boost::filesystem::path texturesPath(tmpModelPath / "materials" / "textures");
   boost::filesystem::create_directories(texturesPath);
 
   // download map tile images into model/materials/textures
-  std::vector<std::string> tiles = this->dataPtr->DownloadMapTiles(
-      this->dataPtr->center.X(),
-      this->dataPtr->center.Y(),
-      this->dataPtr->zoom,
-      this->dataPtr->tileSizePx,
-      this->dataPtr->worldSize,
-      this->dataPtr->mapType,
-      this->dataPtr->apiKey,
+  std::vector<std::string> tiles = this->DownloadMapTiles(
+      this->center.X(),
+      this->center.Y(),
+      this->zoom,
+      this->tileSizePx,
+      this->worldSize,
+      this->mapType,
+      this->apiKey,
       texturesPath.string());
 
   // assume square model for now
   unsigned int xNumTiles = std::sqrt(tiles.size());
   unsigned int yNumTiles = xNumTiles;
 
-  double tileWorldSize = this->dataPtr->GroundResolution(
-      IGN_DTOR(this->dataPtr->center.X()), this->dataPtr->zoom)
-      * this->dataPtr->tileSizePx;
+  double tileWorldSize = this->GroundResolution(
+      IGN_DTOR(this->center.X()), this->zoom)
+      * this->tileSizePx;
+
+  if (this->stop)
+    return;
+
+  std::string atlasFilename;
+  if (this->atlas)
+  {
+    atlasFilename = this->StitchAtlas(xNumTiles, yNumTiles, tiles,
+        texturesPath.string());
+  }
 
   // create model and spawn it into the world
-  if (this->dataPtr->CreateMapTileModel(
-      this->dataPtr->modelName, tileWorldSize,
-      xNumTiles, yNumTiles, tiles, tmpModelPath.string()))
+  if (this->CreateMapTileModel(
+      this->modelName, tileWorldSize,
+      xNumTiles, yNumTiles, tiles, atlasFilename, tmpModelPath.string()))
   {
     // verify model dir is created
     if (common::exists(tmpModelPath.string()))
@@ -429,8 +590,8 @@ void StaticMapPlugin::Init()
         }
       }
       // spawn the model
-      this->dataPtr->SpawnModel("model://" + this->dataPtr->modelName,
-          this->dataPtr->modelPose);
+      this->SpawnModel("model://" + this->modelName,
+          this->modelPose);
     }
     else
       gzerr << "Failed to create model: " << tmpModelPath.string() << std::endl;
@@ -493,8 +654,22 @@ std::vector<std::string> StaticMapPluginPrivate::DownloadMapTiles(
     y += halfTileSize;
   double startx = x;
 
+  // tiles downloaded before, by map type, zoom, tile size and tile center
+  std::stringstream cacheKey;
+  cacheKey << _zoom << "_" << _tileSizePx;
+  boost::filesystem::path cachePath =
+      common::SystemPaths::Instance()->GetLogPath() /
+      boost::filesystem::path("map_tiles") / _mapType / cacheKey.str();
+  if (this->tileCache)
+  {
+    boost::system::error_code ec;
+    boost::filesystem::create_directories(cachePath, ec);
+  }
+
   // download map tiles using google static map API
   std::string url = "https://maps.googleapis.com/maps/api/staticmap";
+  std::vector<Download> downloads;
+  this->mapTileFilenames.clear();
   for (unsigned int i = 0; i < yNumTiles; ++i)
   {
     for (unsigned int j = 0; j < xNumTiles; ++j)
@@ -521,16 +696,96 @@ std::vector<std::string> StaticMapPluginPrivate::DownloadMapTiles(
                << std::setprecision(9) << latLon.LatitudeReference().Degree()
                << "_" << latLon.LongitudeReference().Degree() << ".png";
       std::string fullPath = _saveDirPath + "/" + filename.str();
-      DownloadFile(fullURL, fullPath);
-      gzmsg << "Downloading map tile: " << filename.str() << std::endl;
-      mapTileFilenames.push_back(filename.str());
+      std::string cachedPath = (cachePath / filename.str()).string();
+      this->mapTileFilenames.push_back(filename.str());
+
+      if (this->tileCache && common::exists(cachedPath) &&
+          common::copyFile(cachedPath, fullPath))
+      {
+        gzmsg << "Using cached map tile: " << filename.str() << std::endl;
+      }
+      else
+      {
+        Download download;
+        download.url = fullURL;
+        download.path = fullPath;
+        downloads.push_back(download);
+        gzmsg << "Downloading map tile: " << filename.str() << std::endl;
+      }
 
       x += _tileSizePx;
     }
     x = startx;
     y += _tileSizePx;
   }
-  return mapTileFilenames;
+
+  DownloadFiles(downloads, this->maxDownloads, this->stop);
+
+  if (this->tileCache)
+  {
+    for (const auto &download : downloads)
+    {
+      if (download.done)
+      {
+        common::copyFile(download.path, (cachePath /
+            boost::filesystem::path(download.path).filename()).string());
+      }
+    }
+  }
+
+  return this->mapTileFilenames;
+}
+
+/////////////////////////////////////////////////
+std::string StaticMapPluginPrivate::StitchAtlas(
+    const unsigned int _xNumTiles, const unsigned int _yNumTiles,
+    const std::vector<std::string> &_tiles,
+    const std::string &_texturesPath) const
+{
+  // larger textures are not supported by all graphics cards
+  const unsigned int maxAtlasSizePx = 8192u;
+  const unsigned int width = _xNumTiles * this->tileSizePx;
+  const unsigned int height = _yNumTiles * this->tileSizePx;
+  if (_tiles.size() < 2u || _tiles.size() < _xNumTiles * _yNumTiles ||
+      width > maxAtlasSizePx || height > maxAtlasSizePx)
+  {
+    return std::string();
+  }
+
+  // copy the tiles row by row, the first tile is the top left one
+  const size_t tileLine = this->tileSizePx * 3u;
+  const size_t atlasLine = width * 3u;
+  std::vector<unsigned char> atlasData(atlasLine * height);
+  std::vector<unsigned char> tileData(tileLine * this->tileSizePx);
+  for (unsigned int i = 0; i < _yNumTiles; ++i)
+  {
+    for (unsigned int j = 0; j < _xNumTiles; ++j)
+    {
+      common::Image tile;
+      if (tile.Load(_texturesPath + "/" + _tiles[j + i * _xNumTiles]) != 0 ||
+          tile.GetWidth() != this->tileSizePx ||
+          tile.GetHeight() != this->tileSizePx ||
+          !tile.RGBData(tileData.data(), tileData.size()))
+      {
+        gzwarn << "Unable to stitch map tile '" << _tiles[j + i * _xNumTiles]
+               << "', using a visual per tile." << std::endl;
+        return std::string();
+      }
+
+      for (unsigned int row = 0; row < this->tileSizePx; ++row)
+      {
+        memcpy(&atlasData[(i * this->tileSizePx + row) * atlasLine +
+            j * tileLine], &tileData[row * tileLine], tileLine);
+      }
+    }
+  }
+
+  const std::string filename = "atlas.png";
+  common::Image atlasImage;
+  atlasImage.SetFromData(atlasData.data(), width, height,
+      common::Image::RGB_INT8);
+  atlasImage.SavePNG(_texturesPath + "/" + filename);
+  return filename;
 }
 
 /////////////////////////////////////////////////
@@ -538,11 +793,29 @@ bool StaticMapPluginPrivate::CreateMapTileModel(
     const std::string &_name,
     const double _tileWorldSize,
     const unsigned int _xNumTiles, const unsigned int _yNumTiles,
-    const std::vector<std::string> &_tiles, const std::string &_modelPath)
+    const std::vector<std::string> &_tiles, const std::string &_atlas,
+    const std::string &_modelPath)
 {
   // create material script
   std::stringstream materialScriptStr;
-  for (unsigned int i = 0; i < _yNumTiles; ++i)
+  if (!_atlas.empty())
+  {
+    materialScriptStr <<
+      "material " << _name << "/atlas\n"
+      "{\n"
+      "  technique\n"
+      "  {\n"
+      "    pass\n"
+      "    {\n"
+      "      texture_unit\n"
+      "      {\n"
+      "        texture " << _atlas << "\n"
+      "      }\n"
+      "    }\n"
+      "  }\n"
+      "}\n\n";
+  }
+  for (unsigned int i = 0; _atlas.empty() && i < _yNumTiles; ++i)
   {
     for (unsigned int j = 0; j < _xNumTiles; ++j)
     {
@@ -617,7 +890,27 @@ bool StaticMapPluginPrivate::CreateMapTileModel(
     "        </box>\n"
     "      </geometry>\n"
     "    </collision>\n";
-  for (unsigned int i = 0; i < _yNumTiles; ++i)
+  if (!_atlas.empty())
+  {
+    // a single visual covering all the tiles
+    newModelStr <<
+      "    <visual name='visual'>\n"
+      "      <pose>0 0 " << zPos << " " << tileRot << "</pose>\n"
+      "      <geometry>\n"
+      "        <box>\n"
+      "          <size>" << colSize << "</size>\n"
+      "        </box>\n"
+      "      </geometry>\n"
+      "      <material>\n"
+      "        <script>\n"
+      "          <uri>model://" << _name << "/materials/scripts</uri>\n"
+      "          <uri>model://" << _name << "/materials/textures</uri>\n"
+      "          <name>" << _name << "/atlas</name>\n"
+      "        </script>\n"
+      "      </material>\n"
+      "    </visual>\n";
+  }
+  for (unsigned int i = 0; _atlas.empty() && i < _yNumTiles; ++i)
   {
     for (unsigned int j = 0; j < _xNumTiles; ++j)
     {
@@ -52,11 +52,25 @@ namespace gazebo
   ///              API documentation for more details.
   /// <use_cache>  Use model in gazebo model path if exists, otherwise
   ///              recreate the model and save it in <HOME>/.gazebo/models
+  /// <tile_cache> Keep downloaded tiles in <HOME>/.gazebo/map_tiles, by map
+  ///              type, zoom, tile size and tile center, and reuse them
+  ///              when a map is created again (default true)
+  /// <max_downloads> Number of tiles downloaded at the same time
+  ///              (default 8)
+  /// <atlas>      Stitch the tiles into a single texture, so that the map
+  ///              is drawn as a single visual, if the texture is at most
+  ///              8192 pixels wide (default true)
+  ///
+  /// The tiles are downloaded and the model is created in a background
+  /// thread, so loading the world is not delayed by the download.
   class GZ_PLUGIN_VISIBLE StaticMapPlugin : public WorldPlugin
   {
     /// \brief Constructor.
     public: StaticMapPlugin();
 
+    /// \brief Destructor.
+    public: virtual ~StaticMapPlugin();
+
     /// \brief Load the plugin.
     /// \param[in] _world Pointer to world
     /// \param[in] _sdf Pointer to the SDF configuration.
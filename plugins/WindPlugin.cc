@@ -304,11 +304,8 @@ void WindPlugin::OnUpdate()
   // Process each model.
   for (auto const &model : models)
   {
-    // Get all the links
-    physics::Link_V links = model->GetLinks();
-
     // Process each link.
-    for (auto const &link : links)
+    for (auto const &link : model->GetLinks())
     {
       // Skip links for which the wind is disabled
       if (!link->WindMode())
@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gazebo/transport/Publisher.hh>
+
+#include "plugins/events/EventQueue.hh"
+
+using namespace gazebo;
+
+/////////////////////////////////////////////
+EventQueue::EventQueue()
+{
+  this->thread = std::thread(&EventQueue::Run, this);
+}
+
+/////////////////////////////////////////////
+EventQueue::~EventQueue()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->stop = true;
+  }
+  this->condition.notify_one();
+  this->thread.join();
+}
+
+/////////////////////////////////////////////
+void EventQueue::Push(const transport::PublisherPtr &_pub,
+    std::shared_ptr<const google::protobuf::Message> _msg)
+{
+  bool wake;
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    wake = this->entries.empty();
+    this->entries.emplace_back(_pub, std::move(_msg));
+  }
+
+  // the thread only waits while the queue is empty
+  if (wake)
+    this->condition.notify_one();
+}
+
+/////////////////////////////////////////////
+void EventQueue::Run()
+{
+  std::vector<Entry> batch;
+  std::unique_lock<std::mutex> lock(this->mutex);
+  while (true)
+  {
+    this->condition.wait(lock, [this]
+        {
+          return this->stop || !this->entries.empty();
+        });
+
+    if (this->entries.empty() && this->stop)
+      break;
+
+    // publish all the messages queued so far without holding the lock
+    batch.swap(this->entries);
+    lock.unlock();
+    for (const auto &entry : batch)
+      entry.first->Publish(*entry.second);
+    batch.clear();
+    lock.lock();
+  }
+}
@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PLUGINS_EVENTS_EVENTQUEUE_HH_
+#define GAZEBO_PLUGINS_EVENTS_EVENTQUEUE_HH_
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <google/protobuf/message.h>
+
+#include <gazebo/transport/TransportTypes.hh>
+
+namespace gazebo
+{
+  /// \brief A queue of event messages, published in batches by a thread of
+  /// its own, so that emitting an event costs the physics thread only a
+  /// copy of the message.
+  class EventQueue
+  {
+    /// \brief A message and the publisher to publish it with.
+    public: typedef std::pair<transport::PublisherPtr,
+                std::shared_ptr<const google::protobuf::Message>> Entry;
+
+    /// \brief Constructor. Starts the publishing thread.
+    public: EventQueue();
+
+    /// \brief Destructor. Publishes the messages left and stops the thread.
+    public: virtual ~EventQueue();
+
+    /// \brief Queue a message, messages are published in the order they
+    /// were queued.
+    /// \param[in] _pub The publisher.
+    /// \param[in] _msg The message, which must not be changed afterwards.
+    public: void Push(const transport::PublisherPtr &_pub,
+                std::shared_ptr<const google::protobuf::Message> _msg);
+
+    /// \brief Publish the queued messages until stopped.
+    private: void Run();
+
+    /// \brief Messages not published yet.
+    private: std::vector<Entry> entries;
+
+    /// \brief Protects entries and stop.
+    private: std::mutex mutex;
+
+    /// \brief Signaled when messages are queued or the thread must stop.
+    private: std::condition_variable condition;
+
+    /// \brief True to stop the thread.
+    private: bool stop = false;
+
+    /// \brief The publishing thread.
+    private: std::thread thread;
+  };
+
+  /// \def EventQueuePtr
+  /// \brief Shared pointer to an event queue
+  typedef std::shared_ptr<EventQueue> EventQueuePtr;
+}
+#endif
@@ -62,7 +62,8 @@ void EventSource::Emit(const std::string &_data) const
   if (this->IsActive())
   {
     // add event name, type and data as strings (data is JSON)
-    gazebo::msgs::SimEvent msg;
+    auto event = std::make_shared<gazebo::msgs::SimEvent>();
+    gazebo::msgs::SimEvent &msg = *event;
     msg.set_type(this->type);
     msg.set_name(this->name);
     msg.set_data(_data);
@@ -75,10 +76,19 @@ void EventSource::Emit(const std::string &_data) const
     msgs::Set(worldStatsMsg->mutable_real_time(), this->world->RealTime());
     msgs::Set(worldStatsMsg->mutable_pause_time(), this->world->PauseTime());
     // send it on the publisher we got in the ctor
-    this->pub->Publish(msg);
+    if (this->queue)
+      this->queue->Push(this->pub, event);
+    else
+      this->pub->Publish(msg);
   }
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void EventSource::SetQueue(EventQueuePtr _queue)
+{
+  this->queue = _queue;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 bool EventSource::IsActive() const
 {
@@ -26,6 +26,7 @@
 #include "gazebo/common/common.hh"
 #include "gazebo/transport/TransportTypes.hh"
 
+#include "EventQueue.hh"
 #include "SimEventsException.hh"
 
 namespace gazebo
@@ -49,6 +50,11 @@ namespace gazebo
     /// \param[in] _data the JSON data related to this event.
     public: void Emit(const std::string& _data) const;
 
+    /// \brief Set a queue that publishes the emitted events in another
+    /// thread, instead of publishing them in the calling thread.
+    /// \param[in] _queue The queue, or null to publish directly.
+    public: void SetQueue(EventQueuePtr _queue);
+
     /// \brief Load from an sdf element (with possible configuration data)
     /// \param[in] _sdf the sdf element for the event in the world file
     public: virtual void Load(const sdf::ElementPtr _sdf);
@@ -76,6 +82,10 @@ namespace gazebo
 
     /// \brief a way to send messages to the other topics (to the REST)
     protected: transport::PublisherPtr pub;
+
+    /// \brief Queue the events are published from, null to publish them
+    /// directly.
+    protected: EventQueuePtr queue;
   };
 
   typedef std::shared_ptr<EventSource> EventSourcePtr;
@@ -42,10 +42,25 @@ void InRegionEventSource::Load(const sdf::ElementPtr _sdf)
   else
     gzerr << this->name << " is missing a region element" << std::endl;
 
+  // the event data only depends on the state
+  this->insideJson = "{\"state\":\"inside\",\"region\":\"" +
+      this->regionName + "\", \"model\":\"" + this->modelName + "\"}";
+  this->outsideJson = "{\"state\":\"outside\",\"region\":\"" +
+      this->regionName + "\", \"model\":\"" + this->modelName + "\"}";
+
   // Listen to the update event. This event is broadcast every
   // simulation iteration.
-  this->updateConnection = event::Events::ConnectWorldUpdateBegin(
-      std::bind(&InRegionEventSource::Update, this));
+  if (!this->engine)
+  {
+    this->updateConnection = event::Events::ConnectWorldUpdateBegin(
+        std::bind(&InRegionEventSource::Update, this));
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void InRegionEventSource::SetEngine(RegionEventEnginePtr _engine)
+{
+  this->engine = _engine;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -70,6 +85,13 @@ void InRegionEventSource::Init()
         << "' does not exist" << std::endl;
   }
 
+  if (this->engine && this->model && this->region)
+  {
+    this->engine->AddInclusion(this->model, this->region,
+        std::bind(&InRegionEventSource::OnInclusion, this,
+          std::placeholders::_1));
+  }
+
   this->Info();
 }
 
@@ -111,20 +133,12 @@ void InRegionEventSource::Update()
   bool currentState = this->region->Contains(point);
 
   if (oldState != currentState)
-  {
-    this->isInside = currentState;
-    std::string json = "{";
-    if (this->isInside)
-    {
-      json += "\"state\":\"inside\",";
-    }
-    else
-    {
-      json += "\"state\":\"outside\",";
-    }
-    json += "\"region\":\"" + this->regionName + "\", ";
-    json += "\"model\":\"" + this->modelName + "\"";
-    json += "}";
-    this->Emit(json);
-  }
+    this->OnInclusion(currentState);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void InRegionEventSource::OnInclusion(const bool _inside)
+{
+  this->isInside = _inside;
+  this->Emit(this->isInside ? this->insideJson : this->outsideJson);
 }
@@ -23,6 +23,7 @@
 #include <vector>
 
 #include "plugins/events/Region.hh"
+#include "plugins/events/RegionEventEngine.hh"
 #include "plugins/events/EventSource.hh"
 
 namespace gazebo
@@ -41,6 +42,11 @@ namespace gazebo
     /// \brief Initialize the event
     public: virtual void Init();
 
+    /// \brief Let an engine check the model against the region, instead of
+    /// checking it in Update every iteration. Must be called before Load.
+    /// \param[in] _engine The engine.
+    public: void SetEngine(RegionEventEnginePtr _engine);
+
     /// \brief Called every simulation step
     public: void Update();
 
@@ -73,6 +79,19 @@ namespace gazebo
 
     /// \brief true if the model is currently inside the region
     private: bool isInside;
+
+    /// \brief Engine that checks the model, null to check it in Update.
+    private: RegionEventEnginePtr engine;
+
+    /// \brief Event data emitted when the model enters the region.
+    private: std::string insideJson;
+
+    /// \brief Event data emitted when the model leaves the region.
+    private: std::string outsideJson;
+
+    /// \brief Set isInside and emit the event of the new state.
+    /// \param[in] _inside True if the model is inside the region.
+    private: void OnInclusion(const bool _inside);
   };
 }
 #endif
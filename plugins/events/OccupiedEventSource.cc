@@ -93,13 +93,37 @@ void OccupiedEventSource::Load(const sdf::ElementPtr _sdf)
     this->msgPub = this->node->Advertise<gazebo::msgs::GzString>(topic);
 
     this->msg.set_data(data);
+    this->queuedMsg = std::make_shared<const msgs::GzString>(this->msg);
 
     // Connect to the update event.
-    this->updateConnection = event::Events::ConnectWorldUpdateBegin(
-        std::bind(&OccupiedEventSource::Update, this));
+    if (this->engine)
+    {
+      this->engine->AddOccupancy(regionIter->second,
+          std::bind(&OccupiedEventSource::OnOccupied, this));
+    }
+    else
+    {
+      this->updateConnection = event::Events::ConnectWorldUpdateBegin(
+          std::bind(&OccupiedEventSource::Update, this));
+    }
   }
 }
 
+/////////////////////////////////////////////////
+void OccupiedEventSource::SetEngine(RegionEventEnginePtr _engine)
+{
+  this->engine = _engine;
+}
+
+/////////////////////////////////////////////////
+void OccupiedEventSource::OnOccupied()
+{
+  if (this->queue)
+    this->queue->Push(this->msgPub, this->queuedMsg);
+  else
+    this->msgPub->Publish(this->msg);
+}
+
 /////////////////////////////////////////////////
 void OccupiedEventSource::Update()
 {
@@ -107,7 +131,7 @@ void OccupiedEventSource::Update()
   physics::Model_V models = this->world->Models();
 
   // Process each model.
-  for (physics::Model_V::iterator iter = models.begin();
+  for (physics::Model_V::const_iterator iter = models.begin();
        iter != models.end(); ++iter)
   {
     // Skip models that are static
@@ -117,7 +141,7 @@ void OccupiedEventSource::Update()
     // If inside, then transmit the desired message.
     if (this->regions[this->regionName]->Contains((*iter)->WorldPose().Pos()))
     {
-      this->msgPub->Publish(this->msg);
+      this->OnOccupied();
     }
   }
 }
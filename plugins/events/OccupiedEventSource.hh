@@ -20,6 +20,7 @@
 
 #include <string>
 #include <map>
+#include <memory>
 
 #include <sdf/sdf.hh>
 
@@ -29,6 +30,7 @@
 #include <gazebo/util/system.hh>
 
 #include "Region.hh"
+#include "RegionEventEngine.hh"
 #include "EventSource.hh"
 
 namespace gazebo
@@ -68,9 +70,18 @@ namespace gazebo
     // Documentation inherited
     public: virtual void Load(const sdf::ElementPtr _sdf);
 
+    /// \brief Let an engine find the models in the region, instead of
+    /// testing every model in Update every iteration. Must be called before
+    /// Load.
+    /// \param[in] _engine The engine.
+    public: void SetEngine(RegionEventEnginePtr _engine);
+
     /// \brief Update function called once every cycle
     private: void Update();
 
+    /// \brief Transmit the message for a model inside the region.
+    private: void OnOccupied();
+
     /// \brief SDF pointer.
     private: sdf::ElementPtr sdf;
 
@@ -91,6 +102,12 @@ namespace gazebo
 
     /// \brief The region used for the in region check.
     private: std::string regionName;
+
+    /// \brief Engine that finds the models, null to test them in Update.
+    private: RegionEventEnginePtr engine;
+
+    /// \brief Copy of msg that is queued when an event occurs.
+    private: std::shared_ptr<const msgs::GzString> queuedMsg;
   };
 }
 #endif
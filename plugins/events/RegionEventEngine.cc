@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+
+#include <gazebo/common/Console.hh>
+#include <gazebo/common/Events.hh>
+#include <gazebo/physics/Model.hh>
+#include <gazebo/physics/World.hh>
+
+#include "plugins/events/RegionEventEngine.hh"
+
+using namespace gazebo;
+
+/////////////////////////////////////////////
+RegionEventEngine::RegionEventEngine(physics::WorldPtr _world)
+  : world(_world)
+{
+}
+
+/////////////////////////////////////////////
+RegionEventEngine::~RegionEventEngine()
+{
+  this->updateConnection.reset();
+}
+
+/////////////////////////////////////////////
+void RegionEventEngine::Load(const sdf::ElementPtr &_sdf)
+{
+  if (_sdf->HasElement("region_check_rate"))
+  {
+    double rate = _sdf->Get<double>("region_check_rate");
+    if (rate > 0)
+      this->period = common::Time(1.0 / rate);
+    else if (rate < 0)
+      gzerr << "<region_check_rate> must not be negative, ignoring it.\n";
+  }
+}
+
+/////////////////////////////////////////////
+void RegionEventEngine::AddInclusion(const physics::ModelPtr &_model,
+    const RegionPtr &_region, const InclusionCallback &_callback)
+{
+  auto iter = std::find_if(this->inclusionModels.begin(),
+      this->inclusionModels.end(), [&_model](const InclusionModel &_m)
+      {
+        return _m.model == _model;
+      });
+  if (iter == this->inclusionModels.end())
+  {
+    this->inclusionModels.emplace_back();
+    iter = this->inclusionModels.end() - 1;
+    iter->model = _model;
+  }
+
+  Inclusion inclusion;
+  inclusion.region = _region;
+  inclusion.callback = _callback;
+  iter->inclusions.push_back(inclusion);
+
+  // the regions of the model must be checked again
+  iter->checked = false;
+
+  if (!this->updateConnection)
+  {
+    this->updateConnection = event::Events::ConnectWorldUpdateBegin(
+        std::bind(&RegionEventEngine::Update, this, std::placeholders::_1));
+  }
+}
+
+/////////////////////////////////////////////
+void RegionEventEngine::AddOccupancy(const RegionPtr &_region,
+    const OccupancyCallback &_callback)
+{
+  Occupancy occupancy;
+  occupancy.region = _region;
+  occupancy.callback = _callback;
+  this->occupancies.push_back(occupancy);
+
+  if (!this->updateConnection)
+  {
+    this->updateConnection = event::Events::ConnectWorldUpdateBegin(
+        std::bind(&RegionEventEngine::Update, this, std::placeholders::_1));
+  }
+}
+
+/////////////////////////////////////////////
+void RegionEventEngine::Update(const common::UpdateInfo &_info)
+{
+  if (this->checked && this->period > common::Time::Zero &&
+      _info.simTime - this->lastCheck < this->period &&
+      _info.simTime >= this->lastCheck)
+  {
+    return;
+  }
+  this->checked = true;
+  this->lastCheck = _info.simTime;
+
+  // a model is only checked against its regions again once it moved
+  for (auto &inclusionModel : this->inclusionModels)
+  {
+    const ignition::math::Vector3d position =
+        inclusionModel.model->WorldPose().Pos();
+    if (inclusionModel.checked && position == inclusionModel.position)
+      continue;
+    inclusionModel.checked = true;
+    inclusionModel.position = position;
+
+    for (auto &inclusion : inclusionModel.inclusions)
+    {
+      const bool inside = inclusion.region->Contains(position);
+      if (inside != inclusion.inside)
+      {
+        inclusion.inside = inside;
+        inclusion.callback(inside);
+      }
+    }
+  }
+
+  // the models whose bounding box overlaps a volume of the region may be
+  // inside the region
+  for (const auto &occupancy : this->occupancies)
+  {
+    this->candidates.clear();
+    for (const auto &box : occupancy.region->boxes)
+    {
+      auto models = this->world->ModelsInBox(box);
+      this->candidates.insert(this->candidates.end(), models.begin(),
+          models.end());
+    }
+    std::sort(this->candidates.begin(), this->candidates.end());
+    this->candidates.erase(std::unique(this->candidates.begin(),
+        this->candidates.end()), this->candidates.end());
+
+    for (const auto &model : this->candidates)
+    {
+      // like World::Models, only the top level models are considered
+      if (model->GetParent() &&
+          model->GetParent()->HasType(physics::Base::MODEL))
+      {
+        continue;
+      }
+
+      if (!model->IsStatic() &&
+          occupancy.region->Contains(model->WorldPose().Pos()))
+      {
+        occupancy.callback(model);
+      }
+    }
+  }
+}
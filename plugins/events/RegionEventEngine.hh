@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PLUGINS_EVENTS_REGIONEVENTENGINE_HH_
+#define GAZEBO_PLUGINS_EVENTS_REGIONEVENTENGINE_HH_
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <sdf/sdf.hh>
+#include <ignition/math/Vector3.hh>
+
+#include <gazebo/common/Time.hh>
+#include <gazebo/common/UpdateInfo.hh>
+#include <gazebo/common/Event.hh>
+#include <gazebo/physics/PhysicsTypes.hh>
+
+#include "plugins/events/Region.hh"
+
+namespace gazebo
+{
+  /// \brief Checks the models of a world against regions for the region
+  /// event sources, with a single connection to the world update.
+  ///
+  /// The checks run at a configurable rate. A model is only checked
+  /// against its regions again once it moved, and the models inside a
+  /// region are found with World::ModelsInBox instead of testing every
+  /// top level model of the world. The engine is configured by the following
+  /// optional element of the SimEventsPlugin:
+  ///
+  /// <region_check_rate> Checks per second of simulation time, 0 to check
+  ///                     every iteration (default 0).
+  class RegionEventEngine
+  {
+    /// \brief Function called when a model enters or leaves a region.
+    /// \param[in] _inside True if the model entered the region.
+    public: typedef std::function<void (const bool _inside)>
+                InclusionCallback;
+
+    /// \brief Function called for each model inside a region, at each
+    /// check.
+    /// \param[in] _model The model.
+    public: typedef std::function<void (const physics::ModelPtr &_model)>
+                OccupancyCallback;
+
+    /// \brief Constructor
+    /// \param[in] _world The world.
+    public: explicit RegionEventEngine(physics::WorldPtr _world);
+
+    /// \brief Destructor
+    public: virtual ~RegionEventEngine();
+
+    /// \brief Load the options.
+    /// \param[in] _sdf The SimEventsPlugin element.
+    public: void Load(const sdf::ElementPtr &_sdf);
+
+    /// \brief Watch a model entering and leaving a region. The model
+    /// starts outside of the region.
+    /// \param[in] _model The model.
+    /// \param[in] _region The region.
+    /// \param[in] _callback Function called when the model enters or leaves
+    /// the region.
+    public: void AddInclusion(const physics::ModelPtr &_model,
+                const RegionPtr &_region, const InclusionCallback &_callback);
+
+    /// \brief Watch the non static models inside a region.
+    /// \param[in] _region The region.
+    /// \param[in] _callback Function called for each model inside the
+    /// region at each check.
+    public: void AddOccupancy(const RegionPtr &_region,
+                const OccupancyCallback &_callback);
+
+    /// \brief Run the checks that are due.
+    /// \param[in] _info World update information.
+    private: void Update(const common::UpdateInfo &_info);
+
+    /// \brief A region watched for one model.
+    private: class Inclusion
+    {
+      /// \brief The region.
+      public: RegionPtr region;
+
+      /// \brief Function called when the model enters or leaves.
+      public: InclusionCallback callback;
+
+      /// \brief True if the model is inside the region.
+      public: bool inside = false;
+    };
+
+    /// \brief A model and the regions it is watched for.
+    private: class InclusionModel
+    {
+      /// \brief The model.
+      public: physics::ModelPtr model;
+
+      /// \brief Position of the model at the last check.
+      public: ignition::math::Vector3d position;
+
+      /// \brief True once the model was checked.
+      public: bool checked = false;
+
+      /// \brief The regions.
+      public: std::vector<Inclusion> inclusions;
+    };
+
+    /// \brief A region watched for the models inside it.
+    private: class Occupancy
+    {
+      /// \brief The region.
+      public: RegionPtr region;
+
+      /// \brief Function called for each model inside.
+      public: OccupancyCallback callback;
+    };
+
+    /// \brief The world.
+    private: physics::WorldPtr world;
+
+    /// \brief Models watched for entering and leaving regions.
+    private: std::vector<InclusionModel> inclusionModels;
+
+    /// \brief Regions watched for the models inside them.
+    private: std::vector<Occupancy> occupancies;
+
+    /// \brief Time between checks, zero to check every iteration.
+    private: common::Time period;
+
+    /// \brief Simulation time of the last check.
+    private: common::Time lastCheck;
+
+    /// \brief True once a check ran.
+    private: bool checked = false;
+
+    /// \brief Models found in a region, reused by the checks.
+    private: physics::Model_V candidates;
+
+    /// \brief Connection to the world update.
+    private: event::ConnectionPtr updateConnection;
+  };
+
+  /// \def RegionEventEnginePtr
+  /// \brief Shared pointer to a region event engine
+  typedef std::shared_ptr<RegionEventEngine> RegionEventEnginePtr;
+}
+#endif
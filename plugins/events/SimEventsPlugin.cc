@@ -41,7 +41,9 @@ void SimEventsPlugin::OnModelInfo(ConstModelPtr &_msg)
 ////////////////////////////////////////////////////////////////////////////////
 SimEventsPlugin::~SimEventsPlugin()
 {
+  this->regionEngine.reset();
   this->events.clear();
+  this->queue.reset();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -80,6 +82,11 @@ void SimEventsPlugin::Load(physics::WorldPtr _parent, sdf::ElementPtr _sdf)
   // Create a publisher on the Rest plugin topic
   this->pub = this->node->Advertise<gazebo::msgs::SimEvent>(topic);
 
+  // events are checked by a shared engine and published from a queue
+  this->regionEngine.reset(new RegionEventEngine(this->world));
+  this->regionEngine->Load(this->sdf);
+  this->queue.reset(new EventQueue);
+
   // Subscribe to model spawning
   this->spawnSub = this->node->Subscribe("~/model/info",
       &SimEventsPlugin::OnModelInfo, this);
@@ -123,14 +130,18 @@ void SimEventsPlugin::Load(physics::WorldPtr _parent, sdf::ElementPtr _sdf)
     }
     else if (eventType == "inclusion")
     {
-      event.reset(new InRegionEventSource(this->pub,
-                                          this->world,
-                                          this->regions));
+      auto inRegion = new InRegionEventSource(this->pub,
+                                              this->world,
+                                              this->regions);
+      inRegion->SetEngine(this->regionEngine);
+      event.reset(inRegion);
     }
     else if (eventType == "occupied")
     {
-      event.reset(new OccupiedEventSource(this->pub,
-            this->world, this->regions));
+      auto occupied = new OccupiedEventSource(this->pub,
+            this->world, this->regions);
+      occupied->SetEngine(this->regionEngine);
+      event.reset(occupied);
     }
     else if (eventType == "existence" )
     {
@@ -150,6 +161,7 @@ void SimEventsPlugin::Load(physics::WorldPtr _parent, sdf::ElementPtr _sdf)
 
     if (event)
     {
+      event->SetQueue(this->queue);
       event->Load(child);
       events.push_back(event);
     }
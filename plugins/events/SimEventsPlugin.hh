@@ -23,6 +23,8 @@
 #include <string>
 #include <vector>
 
+#include "EventQueue.hh"
+#include "RegionEventEngine.hh"
 #include "SimEventsException.hh"
 #include "SimStateEventSource.hh"
 
@@ -64,6 +66,12 @@ namespace gazebo
     /// \brief List of all sim event emitters
     private: std::vector<EventSourcePtr> events;
 
+    /// \brief Checks the in region and occupied events.
+    private: RegionEventEnginePtr regionEngine;
+
+    /// \brief Queue the events are published from.
+    private: EventQueuePtr queue;
+
     /// \brief Node for communication.
     private: transport::NodePtr node;
 
@@ -14,6 +14,9 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
+#include <chrono>
+#include <functional>
 #include <iostream>
 #include <cstring>
 #include <stdlib.h>
@@ -186,11 +189,26 @@ static size_t WriteMemoryCallback(void *_contents,
 RestApi::RestApi()
   :isLoggedIn(false)
 {
+  // initialize curl before the sender thread creates its handle, since
+  // a lazy initialization in curl_easy_init is not thread safe
+  curl_global_init(CURL_GLOBAL_ALL);
+  this->postsThread = std::thread(std::bind(&RestApi::RunPosts, this));
 }
 
 /////////////////////////////////////////////////
 RestApi::~RestApi()
 {
+  {
+    std::lock_guard<std::mutex> lock(this->postsMutex);
+    this->stopPosts = true;
+    if (!this->posts.empty())
+    {
+      gzwarn << this->posts.size() << " post(s) were not sent" << std::endl;
+    }
+  }
+  this->postsCondition.notify_all();
+  if (this->postsThread.joinable())
+    this->postsThread.join();
   curl_global_cleanup();
 }
 
@@ -203,8 +221,44 @@ void RestApi::PostJsonData(const char *_route, const char *_json)
   {
     std::lock_guard<std::mutex> lock(this->postsMutex);
     this->posts.push_back(post);
+    this->TrimPosts();
+    if (!this->isLoggedIn)
+    {
+      gzmsg << this->posts.size() << " post(s) queued to be sent"
+            << std::endl;
+    }
+  }
+  this->postsCondition.notify_one();
+}
+
+/////////////////////////////////////////////////
+void RestApi::SetBatchSize(const unsigned int _size)
+{
+  std::lock_guard<std::mutex> lock(this->postsMutex);
+  this->batchSize = std::max(1u, _size);
+}
+
+/////////////////////////////////////////////////
+void RestApi::SetMaxQueuedPosts(const unsigned int _size)
+{
+  std::lock_guard<std::mutex> lock(this->postsMutex);
+  this->maxQueuedPosts = std::max(1u, _size);
+  this->TrimPosts();
+}
+
+/////////////////////////////////////////////////
+void RestApi::TrimPosts()
+{
+  while (this->posts.size() > this->maxQueuedPosts)
+  {
+    this->posts.pop_front();
+    // warn once per burst of dropped posts, not for each of them
+    if (this->droppedPosts++ == 0)
+    {
+      gzwarn << "REST post queue is full (" << this->maxQueuedPosts
+             << " posts), dropping the oldest posts" << std::endl;
+    }
   }
-  this->SendUnpostedPosts();
 }
 
 /////////////////////////////////////////////////
@@ -213,10 +267,15 @@ std::string RestApi::Login(const std::string &_urlStr,
                            const std::string &_userStr,
                            const std::string &_passStr)
 {
-  this->isLoggedIn = false;
-  this->url = _urlStr;
-  this->user = _userStr;
-  this->pass = _passStr;
+  Service newService;
+  newService.url = _urlStr;
+  newService.user = _userStr;
+  newService.pass = _passStr;
+  {
+    std::lock_guard<std::mutex> lock(this->postsMutex);
+    this->isLoggedIn = false;
+    this->service = newService;
+  }
 
   // at this point we want to test the (user supplied) login data
   // so we're hitting the server on the login route ('/login')
@@ -224,71 +283,157 @@ std::string RestApi::Login(const std::string &_urlStr,
   std::string resp;
 
   gzmsg << "login route: " << this->loginRoute << std::endl;
-  resp = this->Request(loginRoute, "");
+  resp = this->Request(nullptr, newService, loginRoute, "");
   gzmsg << "login response: " << resp << std::endl;
 
-  this->isLoggedIn = true;
-  this->SendUnpostedPosts();
+  {
+    std::lock_guard<std::mutex> lock(this->postsMutex);
+    this->isLoggedIn = true;
+  }
+  this->postsCondition.notify_one();
   return resp;
 }
 
 /////////////////////////////////////////////////
 void RestApi::Logout()
 {
-  this->isLoggedIn = false;
+  {
+    std::lock_guard<std::mutex> lock(this->postsMutex);
+    this->isLoggedIn = false;
+  }
   gzmsg << "Logout" << std::endl;
 }
 
 /////////////////////////////////////////////////
-void RestApi::SendUnpostedPosts()
+void RestApi::RunPosts()
 {
-  if (this->isLoggedIn)
+  // a single handle keeps the connection to the service alive between
+  // posts, instead of connecting (and negotiating SSL) for each of them
+  CURL *curl = curl_easy_init();
+
+  // delay before retrying a failed post, doubled after each failure
+  const std::chrono::milliseconds minBackoff(500);
+  const std::chrono::milliseconds maxBackoff(30000);
+  std::chrono::milliseconds backoff(0);
+
+  std::unique_lock<std::mutex> lock(this->postsMutex);
+  while (!this->stopPosts)
   {
-    while (!this->posts.empty())
+    if (!this->isLoggedIn || this->posts.empty())
+    {
+      backoff = std::chrono::milliseconds(0);
+      this->postsCondition.wait(lock);
+      continue;
+    }
+
+    if (backoff.count() > 0)
     {
-      Post post;
+      this->postsCondition.wait_for(lock, backoff,
+          [this] {return this->stopPosts || !this->isLoggedIn;});
+      if (this->stopPosts || !this->isLoggedIn)
+        continue;
+    }
+
+    // take the consecutive posts to the same route out of the queue, so
+    // that the queue may keep accepting (and dropping) posts meanwhile
+    std::list<Post> batch;
+    const std::string route = this->posts.front().route;
+    while (!this->posts.empty() && batch.size() < this->batchSize &&
+        this->posts.front().route == route)
+    {
+      batch.splice(batch.end(), this->posts, this->posts.begin());
+    }
+    const Service current = this->service;
+    this->droppedPosts = 0;
+    lock.unlock();
+
+    std::string body;
+    if (batch.size() == 1)
+    {
+      body = batch.front().json;
+    }
+    else
+    {
+      body = "[";
+      for (const auto &post : batch)
       {
-        std::lock_guard<std::mutex> lock(this->postsMutex);
-        post = this->posts.front();
-
-        //  You can generate a similar request on the cmd line like so:
-        //  curl --verbose --connect-timeout 5 -X POST
-        //    -H \"Content-Type: application/json \" -k --user"
-        this->Request(post.route, post.json);
-        this->posts.pop_front();
+        if (body.size() > 1)
+          body += ",";
+        body += post.json;
       }
+      body += "]";
+    }
+
+    bool sent = false;
+    try
+    {
+      //  You can generate a similar request on the cmd line like so:
+      //  curl --verbose --connect-timeout 5 -X POST
+      //    -H \"Content-Type: application/json \" -k --user"
+      this->Request(curl, current, route, body);
+      sent = true;
+    }
+    catch(RestException &_e)
+    {
+      gzerr << "Failed to post " << batch.size() << " event(s) to "
+            << route << ": " << _e.what() << std::endl;
+    }
+
+    lock.lock();
+    if (sent)
+    {
+      backoff = std::chrono::milliseconds(0);
+    }
+    else
+    {
+      // put the posts back in front of the queue, in their order
+      this->posts.splice(this->posts.begin(), batch);
+      this->TrimPosts();
+      backoff = std::min(maxBackoff, std::max(minBackoff, backoff * 2));
     }
   }
-  else
-  {
-    gzmsg << posts.size() << " post(s) queued to be sent" << std::endl;
-  }
+  lock.unlock();
+
+  curl_easy_cleanup(curl);
 }
 
 /////////////////////////////////////////////////
 std::string RestApi::GetUser() const
 {
-  return this->user;
+  std::lock_guard<std::mutex> lock(this->postsMutex);
+  return this->service.user;
 }
 
 /////////////////////////////////////////////////
-std::string RestApi::Request(const std::string &_reqUrl,
+std::string RestApi::Request(void *_curl, const Service &_service,
+                             const std::string &_reqUrl,
                              const std::string &_postJsonStr)
 {
-  if (this->url.empty())
+  if (_service.url.empty())
     throw RestException("A URL must be specified for web service");
 
-  if (this->user.empty())
+  if (_service.user.empty())
   {
     std::string e = "No user specified for the web service. Please login.";
     throw RestException(e.c_str());
   }
   // build full url (with server)
-  std::string path = url + _reqUrl;
-  CURL *curl = curl_easy_init();
+  std::string path = _service.url + _reqUrl;
+  CURL *curl = static_cast<CURL *>(_curl);
+  if (curl)
+  {
+    // clear the options of the previous request, the connection to the
+    // server stays open
+    curl_easy_reset(curl);
+  }
+  else
+  {
+    curl = curl_easy_init();
+  }
   curl_easy_setopt(curl, CURLOPT_URL, path.c_str() );
 
   // in case things go wrong
+  struct data config;
   if (trace_requests)
   {
     gzmsg << "RestApi::Request" << std::endl;
@@ -296,7 +441,6 @@ std::string RestApi::Request(const std::string &_reqUrl,
     gzmsg << "  data: " << _postJsonStr << std::endl;
     gzmsg << std::endl;
 
-    struct data config;
     config.trace_ascii = 1;  //  enable ascii tracing
     curl_easy_setopt(curl, CURLOPT_DEBUGFUNCTION, TraceRequest);
     curl_easy_setopt(curl, CURLOPT_DEBUGDATA, &config);
@@ -331,12 +475,15 @@ std::string RestApi::Request(const std::string &_reqUrl,
 
   // set user name and password for the authentication
   curl_easy_setopt(curl, CURLOPT_HTTPAUTH, CURLAUTH_BASIC);
-  std::string userpass = this->user + ":" + this->pass;
+  std::string userpass = _service.user + ":" + _service.pass;
   curl_easy_setopt(curl, CURLOPT_USERPWD, userpass.c_str());
 
   // connection timeout 10 sec
   curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT, 10);
 
+  // keep idle connections alive, they are reused by the next request
+  curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE, 1L);
+
   // is this a POST?
   struct curl_slist *slist = NULL;
   if (!_postJsonStr.empty())
@@ -358,24 +505,34 @@ std::string RestApi::Request(const std::string &_reqUrl,
 
   curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &http_code);
 
-  curl_easy_cleanup(curl);
+  if (_curl)
+  {
+    // the headers and the debug data are freed below
+    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, NULL);
+    curl_easy_setopt(curl, CURLOPT_DEBUGDATA, NULL);
+  }
+  else
+  {
+    curl_easy_cleanup(curl);
+  }
+  // copy the data into a string, and clean up
+  std::string response(chunk.memory, chunk.size);
+  curl_slist_free_all(slist);
+  if (chunk.memory)
+    free(chunk.memory);
+
   if (res != CURLE_OK)
   {
-    gzerr << "Request to " << url << " failed: "
+    gzerr << "Request to " << _service.url << " failed: "
           << curl_easy_strerror(res) << std::endl;
     throw RestException(curl_easy_strerror(res));
   }
-  // copy the data into a string
-  std::string response(chunk.memory, chunk.size);
 
   if (http_code != 200)
   {
-    gzerr << "Request to " << url << " error: " << response << std::endl;
+    gzerr << "Request to " << _service.url << " error: " << response
+          << std::endl;
     throw RestException(response.c_str());
   }
-  // clean up
-  curl_slist_free_all(slist);
-  if (chunk.memory)
-    free(chunk.memory);
   return response;
 }
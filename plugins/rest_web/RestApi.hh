@@ -18,9 +18,11 @@
 #ifndef GAZEBO_PLUGINS_REST_WEB_RESTAPI_HH_
 #define GAZEBO_PLUGINS_REST_WEB_RESTAPI_HH_
 
+#include <condition_variable>
 #include <string>
 #include <list>
 #include <mutex>
+#include <thread>
 #include <gazebo/common/Console.hh>
 
 #include "RestException.hh"
@@ -29,6 +31,10 @@ namespace gazebo
 {
   /// \class RestApi RestApi.hh RestApi.hh
   /// \brief REST interface
+  ///
+  /// Posts are queued and sent by a dedicated thread, which reuses one
+  /// connection to the service and retries failed posts with an
+  /// exponential backoff.
   class RestApi
   {
     /// \brief Constructor
@@ -53,35 +59,64 @@ namespace gazebo
     /// a new call to Login has to be made to resume sending messages.
     public: void Logout();
 
-    /// \brief Notify the service with a http POST
+    /// \brief Notify the service with a http POST. The post is queued and
+    /// this function returns immediately. Posts are kept while logged out,
+    /// and the oldest posts are dropped when the queue is full.
     /// \param[in] _route on the web server
     /// \param[in] _json the data to send to the server
     public: void PostJsonData(const char *_route, const char *_json);
 
+    /// \brief Set the maximum number of queued posts sent in a single
+    /// POST. Consecutive posts to the same route are then sent together as
+    /// a JSON array, which the service must accept. The default of 1 sends
+    /// each post on its own, as it was given to PostJsonData.
+    /// \param[in] _size Maximum number of posts per POST, at least 1.
+    public: void SetBatchSize(const unsigned int _size);
+
+    /// \brief Set the maximum number of posts awaiting to be sent.
+    /// \param[in] _size Maximum number of queued posts, at least 1.
+    public: void SetMaxQueuedPosts(const unsigned int _size);
+
     /// \brief Returns the username
     /// \return The user name
     public: std::string GetUser() const;
 
+    /// \brief Login information of the REST service
+    private: struct Service
+      {
+        /// \brief REST service host url
+        std::string url;
+
+        /// \brief REST service username
+        std::string user;
+
+        /// \brief REST service password
+        std::string pass;
+      };
+
     /// \brief A Request/Respone (can be used for GET and POST)
+    /// \param[in] _curl A curl easy handle to reuse, which keeps its
+    /// connection to the service alive between requests. A temporary
+    /// handle is used if null.
+    /// \param[in] _service The login information.
     /// \param[in] _requestUrl The request url.
     /// \param[in] _postStr The data to post
-    /// \throws RestException When this->url or this->user are empty, and
+    /// \throws RestException When the url or the user are empty, and
     /// when the request failed.
     /// \return The web server response
-    private: std::string Request(const std::string &_requestUrl,
+    private: std::string Request(void *_curl, const Service &_service,
+                                 const std::string &_requestUrl,
                                  const std::string &_postStr);
 
-    /// \brief Sends unposted posts
-    private: void SendUnpostedPosts();
+    /// \brief Entry point of the thread sending the queued posts
+    private: void RunPosts();
 
-    /// \brief Login information: REST service host url
-    private: std::string url;
+    /// \brief Drop the oldest posts above the maximum queue size. The
+    /// caller must hold postsMutex.
+    private: void TrimPosts();
 
-    /// \brief Login information: REST service username
-    private: std::string user;
-
-    /// \brief Login information: REST service password
-    private: std::string pass;
+    /// \brief Login information, protected by postsMutex
+    private: Service service;
 
     /// \brief Login information: login route
     private: std::string loginRoute;
@@ -99,8 +134,28 @@ namespace gazebo
     /// \brief List of unposted posts. Posts await when isLoggedIn is false
     private: std::list<Post> posts;
 
-    /// \brief A mutex to ensure integrity of the post list
-    private: std::mutex postsMutex;
+    /// \brief A mutex to ensure integrity of the post list and of the
+    /// login information
+    private: mutable std::mutex postsMutex;
+
+    /// \brief Signals new posts, login changes and shutdown to the
+    /// sender thread
+    private: std::condition_variable postsCondition;
+
+    /// \brief Maximum number of posts sent in a single POST
+    private: unsigned int batchSize = 1;
+
+    /// \brief Maximum number of queued posts
+    private: unsigned int maxQueuedPosts = 1000;
+
+    /// \brief Number of posts dropped since the last warning
+    private: unsigned int droppedPosts = 0;
+
+    /// \brief True to stop the sender thread
+    private: bool stopPosts = false;
+
+    /// \brief Thread sending the queued posts
+    private: std::thread postsThread;
   };
 }
 
@@ -29,6 +29,9 @@
 
 #endif
 
+#include <algorithm>
+#include <cstdlib>
+
 #include "RestWebPlugin.hh"
 
 
@@ -114,7 +117,14 @@ void RestWebPlugin::Init()
 //////////////////////////////////////////////////
 void RestWebPlugin::Load(int /*_argc*/, char ** /*_argv*/)
 {
-  // nothing to do for now
+  // events are posted one per request unless the service accepts arrays
+  const char *batchSize = common::getEnv("GAZEBO_REST_BATCH_SIZE");
+  if (batchSize)
+    this->restApi.SetBatchSize(std::max(1, std::atoi(batchSize)));
+
+  const char *maxQueued = common::getEnv("GAZEBO_REST_MAX_QUEUED_POSTS");
+  if (maxQueued)
+    this->restApi.SetMaxQueuedPosts(std::max(1, std::atoi(maxQueued)));
 }
 
 //////////////////////////////////////////////////
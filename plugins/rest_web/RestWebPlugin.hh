@@ -41,7 +41,10 @@ namespace gazebo
     /// \brief Destructor
     public: virtual ~RestWebPlugin();
 
-    /// \brief Plugin Load
+    /// \brief Plugin Load. The GAZEBO_REST_BATCH_SIZE environment variable
+    /// sets the maximum number of events sent as a JSON array in a single
+    /// POST (1 by default), and GAZEBO_REST_MAX_QUEUED_POSTS the maximum
+    /// number of events awaiting to be sent (1000 by default).
     /// \param[in] _argc Argument count
     /// \param[in] _argv Argument vector
     public: virtual void Load(int _argc, char **_argv);
@@ -58,7 +61,8 @@ namespace gazebo
     /// \param[in] _msg The post message
     public: void OnEventRestPost(ConstRestPostPtr &_msg);
 
-    /// \brief Called everytime a SimEvent message is received
+    /// \brief Called everytime a SimEvent message is received. The event
+    /// is queued to be posted: a success response means it was queued.
     /// \param[in] The SimEvent message
     public: void OnSimEvent(ConstSimEventPtr &_msg);
 
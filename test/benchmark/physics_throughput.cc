@@ -0,0 +1,420 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <unistd.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/any.hpp>
+
+#include "gazebo/common/SystemPaths.hh"
+#include "gazebo/physics/physics.hh"
+#include "gazebo/physics/WorldBatch.hh"
+#include "gazebo/test/ServerFixture.hh"
+#include "gazebo/test/helper_physics_generator.hh"
+#include "test/performance/BenchmarkLibrary.hh"
+#include "test_config.h"
+
+using namespace gazebo;
+
+/// \brief Results of the benchmarks, written to physics_throughput.json
+/// when the program exits.
+static test::benchmark::Reporter g_reporter("physics_throughput");
+
+class PhysicsThroughput : public ServerFixture,
+                          public testing::WithParamInterface<const char*>
+{
+  /// \brief Measure the steady state step time of generated worlds.
+  /// \param[in] _physicsEngine Physics engine to use.
+  /// \param[in] _scenario Name of the world generator.
+  /// \param[in] _sizes Default sizes of the worlds, replaced by the
+  /// GAZEBO_BENCHMARK_SIZES environment variable.
+  public: void Run(const std::string &_physicsEngine,
+                   const std::string &_scenario,
+                   const std::vector<unsigned int> &_sizes);
+};
+
+/////////////////////////////////////////////////
+/// \brief Read a comma separated list of numbers from the environment.
+/// \param[in] _name Name of the environment variable.
+/// \param[in] _default Values used if the variable is not set.
+/// \return The values.
+static std::vector<unsigned int> EnvList(const char *_name,
+    const std::vector<unsigned int> &_default)
+{
+  const char *env = std::getenv(_name);
+  if (!env)
+    return _default;
+
+  std::vector<unsigned int> values;
+  std::istringstream in(env);
+  std::string token;
+  while (std::getline(in, token, ','))
+  {
+    if (!token.empty())
+      values.push_back(std::stoul(token));
+  }
+  return values;
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the resident memory of the process.
+/// \return Resident memory (megabytes), 0 if unknown.
+static double ResidentMemory()
+{
+  std::ifstream statm("/proc/self/statm");
+  double size = 0, resident = 0;
+  if (!(statm >> size >> resident))
+    return 0;
+  return resident * sysconf(_SC_PAGESIZE) / (1024.0 * 1024.0);
+}
+
+/////////////////////////////////////////////////
+/// \brief SDF of the inertia of a link.
+/// \param[in] _mass Mass of the link.
+/// \param[in] _i Diagonal of the inertia matrix.
+/// \return The <inertial> element.
+static std::string Inertial(const double _mass, const double _i)
+{
+  std::ostringstream out;
+  out << "<inertial><mass>" << _mass << "</mass><inertia>"
+      << "<ixx>" << _i << "</ixx><iyy>" << _i << "</iyy><izz>" << _i
+      << "</izz><ixy>0</ixy><ixz>0</ixz><iyz>0</iyz></inertia></inertial>";
+  return out.str();
+}
+
+/////////////////////////////////////////////////
+/// \brief SDF of a link with the same collision and visual geometry.
+/// \param[in] _name Name of the link.
+/// \param[in] _pose Pose of the link in the model.
+/// \param[in] _geometry The <geometry> element.
+/// \param[in] _mass Mass of the link.
+/// \param[in] _i Diagonal of the inertia matrix.
+/// \return The <link> element.
+static std::string Link(const std::string &_name, const std::string &_pose,
+    const std::string &_geometry, const double _mass, const double _i)
+{
+  return "<link name='" + _name + "'><pose>" + _pose + "</pose>" +
+    Inertial(_mass, _i) +
+    "<collision name='collision'>" + _geometry + "</collision>" +
+    "<visual name='visual'>" + _geometry + "</visual></link>";
+}
+
+/////////////////////////////////////////////////
+/// \brief Generate the models of a benchmark world.
+/// \param[in] _scenario Name of the world generator.
+/// \param[in] _size Number of stacks, spheres, chains, robots, objects or
+/// vehicles.
+/// \return The models, empty if the scenario is unknown.
+static std::string Models(const std::string &_scenario,
+    const unsigned int _size)
+{
+  std::ostringstream out;
+  // Entities are laid out on a square grid
+  const unsigned int side = static_cast<unsigned int>(
+      std::ceil(std::sqrt(static_cast<double>(_size))));
+
+  if (_scenario == "boxes")
+  {
+    // Stacks of 5 boxes, resting on each other
+    const std::string box =
+      "<geometry><box><size>0.5 0.5 0.5</size></box></geometry>";
+    for (unsigned int i = 0; i < _size; ++i)
+    {
+      for (unsigned int k = 0; k < 5; ++k)
+      {
+        out << "<model name='box_" << i << "_" << k << "'><pose>"
+            << (i % side) * 1.0 << " " << (i / side) * 1.0 << " "
+            << 0.25 + 0.5 * k << " 0 0 0</pose>"
+            << Link("link", "0 0 0 0 0 0", box, 1.0, 0.0417) << "</model>";
+      }
+    }
+  }
+  else if (_scenario == "spheres")
+  {
+    // Spheres falling on the ground and on each other
+    const std::string sphere =
+      "<geometry><sphere><radius>0.2</radius></sphere></geometry>";
+    for (unsigned int i = 0; i < _size; ++i)
+    {
+      out << "<model name='sphere_" << i << "'><pose>"
+          << (i % side) * 0.5 << " " << (i / side) * 0.5 << " "
+          << 1.0 + 0.3 * (i % 7) << " 0 0 0</pose>"
+          << Link("link", "0 0 0 0 0 0", sphere, 1.0, 0.016) << "</model>";
+    }
+  }
+  else if (_scenario == "pendulums")
+  {
+    // Chains of 5 links hanging from the world
+    const std::string rod =
+      "<geometry><box><size>0.05 0.05 0.5</size></box></geometry>";
+    for (unsigned int i = 0; i < _size; ++i)
+    {
+      out << "<model name='pendulum_" << i << "'><pose>"
+          << (i % side) * 1.0 << " " << (i / side) * 1.0
+          << " 3 0.5 0 0</pose>";
+      for (unsigned int k = 0; k < 5; ++k)
+      {
+        std::ostringstream pose;
+        pose << "0 0 " << -0.25 - 0.5 * k << " 0 0 0";
+        out << Link("link_" + std::to_string(k), pose.str(), rod, 0.5, 0.01)
+            << "<joint name='joint_" << k << "' type='revolute'><parent>"
+            << (k == 0 ? std::string("world") :
+                "link_" + std::to_string(k - 1))
+            << "</parent><child>link_" << k << "</child>"
+            << "<pose>0 0 0.25 0 0 0</pose><axis><xyz>1 0 0</xyz></axis>"
+            << "</joint>";
+      }
+      out << "</model>";
+    }
+  }
+  else if (_scenario == "pr2")
+  {
+    for (unsigned int i = 0; i < _size; ++i)
+    {
+      out << "<include><uri>model://pr2</uri><name>pr2_" << i
+          << "</name><pose>" << (i % side) * 3.0 << " " << (i / side) * 3.0
+          << " 0 0 0 0</pose></include>";
+    }
+  }
+  else if (_scenario == "mesh_bin")
+  {
+    // Meshes dropped in a bin
+    const double width = 0.4 * side + 0.4;
+    const std::string wall = "<geometry><box><size>" +
+      std::to_string(width) + " 0.1 1</size></box></geometry>";
+    out << "<model name='bin'><static>true</static>";
+    for (unsigned int k = 0; k < 4; ++k)
+    {
+      std::ostringstream pose;
+      const double offset = width * 0.5;
+      pose << (k < 2 ? 0.0 : (k == 2 ? -offset : offset)) << " "
+           << (k < 2 ? (k == 0 ? -offset : offset) : 0.0) << " 0.5 0 0 "
+           << (k < 2 ? 0.0 : 1.5708);
+      out << Link("wall_" + std::to_string(k), pose.str(), wall, 1, 1);
+    }
+    out << "</model>";
+
+    const std::string mesh = std::string("<geometry><mesh><uri>file://") +
+      TEST_PATH + "/data/cordless_drill/meshes/cordless_drill.dae" +
+      "</uri></mesh></geometry>";
+    for (unsigned int i = 0; i < _size; ++i)
+    {
+      out << "<model name='mesh_" << i << "'><pose>"
+          << (i % side) * 0.4 - width * 0.5 + 0.4 << " "
+          << (i / side) * 0.4 - width * 0.5 + 0.4 << " "
+          << 0.5 + 0.3 * (i % 5) << " 0 0 " << 0.7 * i << "</pose>"
+          << Link("link", "0 0 0 0 0 0", mesh, 0.5, 0.005) << "</model>";
+    }
+  }
+  else if (_scenario == "heightmap_vehicles")
+  {
+    // Four wheeled vehicles rolling down the sides of a bowl
+    out << "<model name='heightmap'><static>true</static><link name='link'>"
+        << "<collision name='collision'><geometry><heightmap>"
+        << "<uri>file://media/materials/textures/heightmap_bowl.png</uri>"
+        << "<size>129 129 10</size><pos>0 0 0</pos></heightmap></geometry>"
+        << "</collision></link></model>";
+
+    const std::string chassis =
+      "<geometry><box><size>1 0.6 0.2</size></box></geometry>";
+    const std::string wheel = "<geometry><cylinder><radius>0.15</radius>"
+      "<length>0.1</length></cylinder></geometry>";
+    for (unsigned int i = 0; i < _size; ++i)
+    {
+      const double angle = 2 * IGN_PI * i / _size;
+      out << "<model name='vehicle_" << i << "'><pose>"
+          << 40 * std::cos(angle) << " " << 40 * std::sin(angle)
+          << " 11 0 0 " << angle + IGN_PI << "</pose>"
+          << Link("chassis", "0 0 0.3 0 0 0", chassis, 5.0, 0.2);
+      for (unsigned int k = 0; k < 4; ++k)
+      {
+        std::ostringstream pose;
+        pose << (k < 2 ? 0.4 : -0.4) << " " << (k % 2 ? 0.35 : -0.35)
+             << " 0.15 1.5708 0 0";
+        const std::string name = "wheel_" + std::to_string(k);
+        out << Link(name, pose.str(), wheel, 0.5, 0.003)
+            << "<joint name='" << name << "_joint' type='revolute'>"
+            << "<parent>chassis</parent><child>" << name << "</child>"
+            << "<axis><xyz>0 1 0</xyz>"
+            << "<use_parent_model_frame>true</use_parent_model_frame>"
+            << "</axis></joint>";
+      }
+      out << "</model>";
+    }
+  }
+  return out.str();
+}
+
+/////////////////////////////////////////////////
+void PhysicsThroughput::Run(const std::string &_physicsEngine,
+    const std::string &_scenario, const std::vector<unsigned int> &_sizes)
+{
+  if (_scenario == "heightmap_vehicles" && _physicsEngine == "simbody")
+  {
+    gzwarn << "Simbody doesn't support heightmaps, skipping" << std::endl;
+    return;
+  }
+  if (_scenario == "pr2" &&
+      common::SystemPaths::Instance()->FindFileURI("model://pr2").empty())
+  {
+    gzwarn << "The pr2 model is not available, skipping" << std::endl;
+    return;
+  }
+
+  // The fixture provides the transport and the plugins of the server. The
+  // benchmark worlds don't run in their own threads.
+  this->Load("worlds/empty.world", true, _physicsEngine);
+
+  // Island threads are an option of ODE
+  const std::vector<unsigned int> threadCounts = _physicsEngine == "ode" ?
+    EnvList("GAZEBO_BENCHMARK_THREADS", {0, 4}) :
+    std::vector<unsigned int>({0});
+
+  for (auto size : EnvList("GAZEBO_BENCHMARK_SIZES", _sizes))
+  {
+    for (auto threads : threadCounts)
+    {
+      std::ostringstream name;
+      name << _physicsEngine << "/" << _scenario << "/" << size
+           << "/threads" << threads;
+
+      std::ostringstream worldSDF;
+      worldSDF << "<sdf version='" << SDF_VERSION << "'>"
+               << "<world name='" << _scenario << "'>"
+               << "<physics type='" << _physicsEngine << "'>"
+               << "<max_step_size>0.001</max_step_size>"
+               << "<real_time_update_rate>0</real_time_update_rate>"
+               << "</physics>"
+               << "<include><uri>model://ground_plane</uri></include>"
+               << Models(_scenario, size)
+               << "</world></sdf>";
+
+      sdf::SDFPtr sdf(new sdf::SDF());
+      sdf::init(sdf);
+      ASSERT_TRUE(sdf::readString(worldSDF.str(), sdf)) << name.str();
+
+      const double memoryBefore = ResidentMemory();
+      auto worlds = physics::WorldBatch::CreateWorlds(
+          sdf->Root()->GetElement("world"), 1);
+      ASSERT_EQ(1u, worlds.size());
+      physics::WorldPtr world = worlds[0];
+      physics::PhysicsEnginePtr physics = world->Physics();
+      ASSERT_TRUE(physics != nullptr);
+      EXPECT_EQ(_physicsEngine, physics->GetType());
+      if (threads > 0)
+        physics->SetParam("island_threads", static_cast<int>(threads));
+
+      // Let the worlds settle before measuring
+      world->Advance(500);
+      const double memoryAfter = ResidentMemory();
+
+      test::benchmark::Options options;
+      options.warmupTime = 0.5;
+      options.repetitionTime = 0.05;
+      options.repetitions = 20;
+      test::benchmark::Result &result = g_reporter.Measure(name.str(),
+          [&world]()
+          {
+            world->Advance(1);
+          }, options);
+
+      // Contacts are only kept when someone listens to them
+      physics->GetContactManager()->SetNeverDropContacts(true);
+      world->Advance(1);
+      const unsigned int contacts =
+        physics->GetContactManager()->GetContactCount();
+      physics->GetContactManager()->SetNeverDropContacts(false);
+
+      // Not all the engines have a fixed number of solver iterations
+      double iterations = -1;
+      try
+      {
+        iterations = boost::any_cast<int>(physics->GetParam("iters"));
+      }
+      catch(...)
+      {
+      }
+
+      const double stepTime = result.Percentile(50);
+      result.metrics.push_back({"size", size});
+      result.metrics.push_back({"threads", threads});
+      result.metrics.push_back({"steps_per_second",
+          stepTime > 0 ? 1.0 / stepTime : 0.0});
+      result.metrics.push_back({"real_time_factor", stepTime > 0 ?
+          physics->GetMaxStepSize() / stepTime : 0.0});
+      result.metrics.push_back({"contacts", contacts});
+      result.metrics.push_back({"solver_iterations", iterations});
+      result.metrics.push_back({"memory_mb", memoryAfter - memoryBefore});
+      result.metrics.push_back({"models",
+          static_cast<double>(world->ModelCount())});
+
+      world->Fini();
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_P(PhysicsThroughput, Boxes)
+{
+  Run(GetParam(), "boxes", {10, 100});
+}
+
+/////////////////////////////////////////////////
+TEST_P(PhysicsThroughput, Spheres)
+{
+  Run(GetParam(), "spheres", {10, 100, 1000});
+}
+
+/////////////////////////////////////////////////
+TEST_P(PhysicsThroughput, Pendulums)
+{
+  Run(GetParam(), "pendulums", {1, 10, 50});
+}
+
+/////////////////////////////////////////////////
+TEST_P(PhysicsThroughput, PR2)
+{
+  Run(GetParam(), "pr2", {1, 4});
+}
+
+/////////////////////////////////////////////////
+TEST_P(PhysicsThroughput, MeshBin)
+{
+  Run(GetParam(), "mesh_bin", {10, 50});
+}
+
+/////////////////////////////////////////////////
+TEST_P(PhysicsThroughput, HeightmapVehicles)
+{
+  Run(GetParam(), "heightmap_vehicles", {1, 10});
+}
+
+INSTANTIATE_TEST_CASE_P(PhysicsEngines, PhysicsThroughput,
+                        PHYSICS_ENGINE_VALUES);
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,532 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gazebo/common/SystemPaths.hh"
+#include "gazebo/msgs/msgs.hh"
+#include "gazebo/rendering/rendering.hh"
+#include "gazebo/sensors/sensors.hh"
+#include "gazebo/test/ServerFixture.hh"
+#include "test/performance/BenchmarkLibrary.hh"
+
+using namespace gazebo;
+
+/// \brief Results of the benchmarks, written to rendering_throughput.json
+/// when the program exits.
+static test::benchmark::Reporter g_reporter("rendering_throughput");
+
+/// \brief Configuration of a generated rendering world.
+struct RenderingConfig
+{
+  /// \brief Name of the benchmark.
+  std::string name;
+
+  /// \brief Number of static box models.
+  unsigned int visuals = 100;
+
+  /// \brief Number of lights, the first one being the sun.
+  unsigned int lights = 1;
+
+  /// \brief True to render shadows.
+  bool shadows = false;
+
+  /// \brief Number of camera sensors.
+  unsigned int cameras = 1;
+
+  /// \brief Image width of the cameras.
+  unsigned int width = 320;
+
+  /// \brief Image height of the cameras.
+  unsigned int height = 240;
+
+  /// \brief Horizontal beams of a GPU lidar, 0 for no lidar.
+  unsigned int beams = 0;
+
+  /// \brief Vertical beams of the GPU lidar.
+  unsigned int layers = 1;
+};
+
+class RenderingThroughput : public RenderingFixture
+{
+  /// \brief Measure the frame time of the sensors of a generated world.
+  /// \param[in] _config The world.
+  public: void Run(const RenderingConfig &_config);
+
+  /// \brief Count a camera frame.
+  /// \param[in] _msg The image.
+  private: void OnImage(ConstImageStampedPtr &_msg);
+
+  /// \brief Receive a frame of the other cameras.
+  /// \param[in] _msg The image.
+  private: void OnOtherImage(ConstImageStampedPtr &_msg);
+
+  /// \brief Count a lidar scan.
+  /// \param[in] _msg The scan.
+  private: void OnScan(ConstLaserScanStampedPtr &_msg);
+
+  /// \brief Sample the scene update time, in the rendering thread.
+  private: void OnPreRenderEnded();
+
+  /// \brief Sample the culling time of the cameras, in the rendering
+  /// thread.
+  private: void OnPostRender();
+
+  /// \brief Wait for the next frame of the first sensor.
+  /// \return False on timeout.
+  private: bool WaitForFrame();
+
+  /// \brief Protects the frame counters and the samples.
+  private: std::mutex mutex;
+
+  /// \brief Notified when a frame is received.
+  private: std::condition_variable frameReceived;
+
+  /// \brief Frames received from the first camera.
+  private: uint64_t imageFrames = 0;
+
+  /// \brief Scans received from the lidar.
+  private: uint64_t scanFrames = 0;
+
+  /// \brief Sum of the scene update times since the start of the
+  /// measurement (seconds).
+  private: double sceneUpdateTime = 0;
+
+  /// \brief Number of scene updates since the start of the measurement.
+  private: uint64_t sceneUpdates = 0;
+
+  /// \brief Sum of the culling times of the cameras since the start of
+  /// the measurement (seconds).
+  private: double cullingTime = 0;
+
+  /// \brief Number of frames in which culling was sampled.
+  private: uint64_t cullingFrames = 0;
+
+  /// \brief Name of the camera whose frames are counted.
+  private: std::string firstCamera;
+
+  /// \brief Rendering cameras of the camera sensors.
+  private: std::vector<rendering::CameraPtr> cameras;
+};
+
+/////////////////////////////////////////////////
+/// \brief Generate a world for the rendering benchmarks.
+/// \param[in] _config The world.
+/// \return SDF of the world.
+static std::string WorldSDF(const RenderingConfig &_config)
+{
+  std::ostringstream out;
+  out << "<sdf version='" << SDF_VERSION << "'><world name='default'>"
+      << "<scene><shadows>" << (_config.shadows ? "true" : "false")
+      << "</shadows></scene>"
+      << "<include><uri>model://ground_plane</uri></include>";
+
+  for (unsigned int i = 0; i < _config.lights; ++i)
+  {
+    if (i == 0)
+    {
+      out << "<light name='sun' type='directional'>"
+          << "<cast_shadows>true</cast_shadows><pose>0 0 10 0 0 0</pose>"
+          << "<diffuse>0.8 0.8 0.8 1</diffuse>"
+          << "<direction>-0.5 0.1 -0.9</direction></light>";
+    }
+    else
+    {
+      out << "<light name='spot_" << i << "' type='spot'>"
+          << "<cast_shadows>true</cast_shadows><pose>"
+          << 4.0 * (i % 4) << " " << 4.0 * (i / 4) << " 6 0 0 0</pose>"
+          << "<diffuse>0.5 0.5 0.5 1</diffuse><direction>0 0 -1</direction>"
+          << "<attenuation><range>20</range></attenuation>"
+          << "<spot><inner_angle>0.6</inner_angle>"
+          << "<outer_angle>1</outer_angle><falloff>1</falloff></spot>"
+          << "</light>";
+    }
+  }
+
+  // Static boxes on a grid in front of the sensors
+  const unsigned int side = static_cast<unsigned int>(
+      std::ceil(std::sqrt(static_cast<double>(_config.visuals))));
+  const std::string box =
+    "<geometry><box><size>0.5 0.5 0.5</size></box></geometry>";
+  for (unsigned int i = 0; i < _config.visuals; ++i)
+  {
+    out << "<model name='box_" << i << "'><static>true</static><pose>"
+        << 2.0 + (i % side) << " " << (i / side) - side * 0.5 << " "
+        << 0.25 + 0.5 * (i % 3) << " 0 0 0</pose><link name='link'>"
+        << "<collision name='collision'>" << box << "</collision>"
+        << "<visual name='visual'>" << box << "</visual></link></model>";
+  }
+
+  out << "<model name='sensors'><static>true</static>"
+      << "<pose>0 0 1 0 0 0</pose><link name='link'>";
+  for (unsigned int i = 0; i < _config.cameras; ++i)
+  {
+    out << "<sensor name='camera_" << i << "' type='camera'>"
+        << "<always_on>true</always_on><update_rate>0</update_rate>"
+        << "<pose>0 0 0 0 0 " << 0.3 * i << "</pose>"
+        << "<camera><horizontal_fov>1.047</horizontal_fov><image>"
+        << "<width>" << _config.width << "</width>"
+        << "<height>" << _config.height << "</height>"
+        << "<format>R8G8B8</format></image>"
+        << "<clip><near>0.1</near><far>100</far></clip></camera></sensor>";
+  }
+  if (_config.beams > 0)
+  {
+    const double vertical = _config.layers > 1 ? 0.26 : 0.0;
+    out << "<sensor name='gpu_lidar' type='gpu_ray'>"
+        << "<always_on>true</always_on><update_rate>0</update_rate>"
+        << "<ray><scan><horizontal><samples>" << _config.beams
+        << "</samples><resolution>1</resolution>"
+        << "<min_angle>-3.1</min_angle><max_angle>3.1</max_angle>"
+        << "</horizontal><vertical><samples>" << _config.layers
+        << "</samples><resolution>1</resolution>"
+        << "<min_angle>" << -vertical << "</min_angle>"
+        << "<max_angle>" << vertical << "</max_angle></vertical></scan>"
+        << "<range><min>0.1</min><max>50</max>"
+        << "<resolution>0.01</resolution></range></ray></sensor>";
+  }
+  out << "</link></model></world></sdf>";
+  return out.str();
+}
+
+/////////////////////////////////////////////////
+void RenderingThroughput::OnImage(ConstImageStampedPtr &/*_msg*/)
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  ++this->imageFrames;
+  this->frameReceived.notify_all();
+}
+
+/////////////////////////////////////////////////
+void RenderingThroughput::OnOtherImage(ConstImageStampedPtr &/*_msg*/)
+{
+}
+
+/////////////////////////////////////////////////
+void RenderingThroughput::OnScan(ConstLaserScanStampedPtr &/*_msg*/)
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  ++this->scanFrames;
+  this->frameReceived.notify_all();
+}
+
+/////////////////////////////////////////////////
+void RenderingThroughput::OnPreRenderEnded()
+{
+  rendering::ScenePtr scene = rendering::get_scene();
+  if (!scene)
+    return;
+
+  std::lock_guard<std::mutex> lock(this->mutex);
+  this->sceneUpdateTime += scene->PreRenderTime();
+  ++this->sceneUpdates;
+}
+
+/////////////////////////////////////////////////
+void RenderingThroughput::OnPostRender()
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  for (auto &camera : this->cameras)
+    this->cullingTime += camera->CullingTime();
+  ++this->cullingFrames;
+}
+
+/////////////////////////////////////////////////
+bool RenderingThroughput::WaitForFrame()
+{
+  std::unique_lock<std::mutex> lock(this->mutex);
+  uint64_t &frames = this->cameras.empty() ? this->scanFrames :
+    this->imageFrames;
+  const uint64_t next = frames + 1;
+  return this->frameReceived.wait_for(lock, std::chrono::seconds(10),
+      [&frames, next]() {return frames >= next;});
+}
+
+/////////////////////////////////////////////////
+void RenderingThroughput::Run(const RenderingConfig &_config)
+{
+  // Worlds are loaded from a file
+  const std::string path = common::SystemPaths::Instance()->TmpPath() +
+    "/rendering_throughput.world";
+  {
+    std::ofstream file(path);
+    file << WorldSDF(_config);
+  }
+  this->Load(path);
+  std::remove(path.c_str());
+
+  if (rendering::RenderEngine::Instance()->GetRenderPathType() ==
+      rendering::RenderEngine::NONE)
+  {
+    gzerr << "No rendering engine, unable to run the rendering benchmark\n";
+    return;
+  }
+
+  // Subscribing makes the sensors render and publish
+  std::vector<sensors::SensorPtr> sensorList;
+  std::vector<transport::SubscriberPtr> subs;
+  for (unsigned int i = 0; i < _config.cameras; ++i)
+  {
+    const std::string name = "camera_" + std::to_string(i);
+    WaitUntilSensorSpawn(name, 100, 100);
+    sensors::CameraSensorPtr sensor =
+      std::dynamic_pointer_cast<sensors::CameraSensor>(
+          sensors::get_sensor(name));
+    ASSERT_TRUE(sensor != nullptr);
+    sensorList.push_back(sensor);
+    this->cameras.push_back(sensor->Camera());
+    // Only the frames of the first camera are counted
+    subs.push_back(this->node->Subscribe(sensor->Topic(), i == 0 ?
+          &RenderingThroughput::OnImage : &RenderingThroughput::OnOtherImage,
+          this));
+  }
+
+  uint64_t rays = 0;
+  if (_config.beams > 0)
+  {
+    WaitUntilSensorSpawn("gpu_lidar", 100, 100);
+    sensors::GpuRaySensorPtr sensor =
+      std::dynamic_pointer_cast<sensors::GpuRaySensor>(
+          sensors::get_sensor("gpu_lidar"));
+    ASSERT_TRUE(sensor != nullptr);
+    sensorList.push_back(sensor);
+    rays = sensor->RangeCount() * sensor->VerticalRangeCount();
+    subs.push_back(this->node->Subscribe(sensor->Topic(),
+          &RenderingThroughput::OnScan, this));
+  }
+  ASSERT_FALSE(sensorList.empty());
+
+  std::vector<event::ConnectionPtr> connections;
+  connections.push_back(event::Events::ConnectPreRenderEnded(
+      std::bind(&RenderingThroughput::OnPreRenderEnded, this)));
+  connections.push_back(event::Events::ConnectPostRender(
+      std::bind(&RenderingThroughput::OnPostRender, this)));
+
+  // Stage durations of the sensors before the measurement
+  const std::vector<SensorStage> stages =
+    {SENSOR_STAGE_RENDER, SENSOR_STAGE_READBACK, SENSOR_STAGE_PUBLISH};
+  auto stageTotals = [&sensorList, &stages]()
+  {
+    std::vector<std::pair<double, uint64_t>> totals;
+    for (auto stage : stages)
+    {
+      std::pair<double, uint64_t> total(0.0, 0u);
+      for (auto &sensor : sensorList)
+      {
+        total.first += sensor->StageDuration(stage).Sum();
+        total.second += sensor->StageDuration(stage).Count();
+      }
+      totals.push_back(total);
+    }
+    return totals;
+  };
+
+  // Wait for the first frames, the scene may still be loading
+  ASSERT_TRUE(this->WaitForFrame()) << _config.name;
+
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->sceneUpdateTime = 0;
+    this->sceneUpdates = 0;
+    this->cullingTime = 0;
+    this->cullingFrames = 0;
+    this->imageFrames = 0;
+    this->scanFrames = 0;
+  }
+  const auto before = stageTotals();
+  const auto start = std::chrono::steady_clock::now();
+
+  test::benchmark::Options options;
+  options.warmupTime = 1.0;
+  options.repetitionTime = 0;
+  options.repetitions = 100;
+  bool timedOut = false;
+  test::benchmark::Result &result = g_reporter.Measure(_config.name,
+      [this, &timedOut]()
+      {
+        timedOut = !this->WaitForFrame() || timedOut;
+      }, options);
+  EXPECT_FALSE(timedOut) << _config.name;
+
+  const double elapsed = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start).count();
+  const auto after = stageTotals();
+  connections.clear();
+  subs.clear();
+
+  std::lock_guard<std::mutex> lock(this->mutex);
+
+  // Mean durations per sensor update. Culling is done while rendering.
+  auto stageMean = [&before, &after](const size_t _index)
+  {
+    const uint64_t count = after[_index].second - before[_index].second;
+    return count > 0 ?
+      (after[_index].first - before[_index].first) / count : 0.0;
+  };
+  const double culling = this->cullingFrames > 0 && !this->cameras.empty() ?
+    this->cullingTime / (this->cullingFrames * this->cameras.size()) : 0.0;
+  const double frameTime = result.Percentile(50);
+
+  result.metrics.push_back({"visuals", _config.visuals});
+  result.metrics.push_back({"lights", _config.lights});
+  result.metrics.push_back({"shadows", _config.shadows ? 1 : 0});
+  result.metrics.push_back({"cameras", _config.cameras});
+  result.metrics.push_back({"width", _config.width});
+  result.metrics.push_back({"height", _config.height});
+  result.metrics.push_back({"rays", static_cast<double>(rays)});
+  result.metrics.push_back({"fps", frameTime > 0 ? 1.0 / frameTime : 0.0});
+  result.metrics.push_back({"scene_update", this->sceneUpdates > 0 ?
+      this->sceneUpdateTime / this->sceneUpdates : 0.0});
+  result.metrics.push_back({"culling", culling});
+  result.metrics.push_back({"render", std::max(stageMean(0) - culling,
+      0.0)});
+  result.metrics.push_back({"readback", stageMean(1)});
+  result.metrics.push_back({"publish", stageMean(2)});
+  if (rays > 0)
+  {
+    result.metrics.push_back({"rays_per_second",
+        elapsed > 0 ? rays * this->scanFrames / elapsed : 0.0});
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(RenderingThroughput, Visuals100)
+{
+  RenderingConfig config;
+  config.name = "visuals/100";
+  Run(config);
+}
+
+/////////////////////////////////////////////////
+TEST_F(RenderingThroughput, Visuals1000)
+{
+  RenderingConfig config;
+  config.name = "visuals/1000";
+  config.visuals = 1000;
+  Run(config);
+}
+
+/////////////////////////////////////////////////
+TEST_F(RenderingThroughput, Lights4)
+{
+  RenderingConfig config;
+  config.name = "lights/4/shadows_off";
+  config.lights = 4;
+  Run(config);
+}
+
+/////////////////////////////////////////////////
+TEST_F(RenderingThroughput, Lights4Shadows)
+{
+  RenderingConfig config;
+  config.name = "lights/4/shadows_on";
+  config.lights = 4;
+  config.shadows = true;
+  Run(config);
+}
+
+/////////////////////////////////////////////////
+TEST_F(RenderingThroughput, Camera720p)
+{
+  RenderingConfig config;
+  config.name = "cameras/1/1280x720";
+  config.width = 1280;
+  config.height = 720;
+  Run(config);
+}
+
+/////////////////////////////////////////////////
+TEST_F(RenderingThroughput, Cameras4)
+{
+  RenderingConfig config;
+  config.name = "cameras/4/640x480";
+  config.cameras = 4;
+  config.width = 640;
+  config.height = 480;
+  Run(config);
+}
+
+/////////////////////////////////////////////////
+TEST_F(RenderingThroughput, GpuRay)
+{
+  RenderingConfig config;
+  config.name = "gpu_ray/640x1";
+  config.cameras = 0;
+  config.beams = 640;
+  Run(config);
+}
+
+/////////////////////////////////////////////////
+TEST_F(RenderingThroughput, GpuRay16Layers)
+{
+  RenderingConfig config;
+  config.name = "gpu_ray/1800x16";
+  config.cameras = 0;
+  config.beams = 1800;
+  config.layers = 16;
+  Run(config);
+}
+
+/////////////////////////////////////////////////
+// Poses are handed to the scene by the transport threads, so the time to
+// take them in limits the number of moving visuals.
+TEST_F(RenderingThroughput, PoseIngest)
+{
+  Load("worlds/empty.world");
+  rendering::ScenePtr scene = rendering::get_scene();
+  ASSERT_TRUE(scene != nullptr);
+
+  for (unsigned int count : {100u, 1000u, 10000u})
+  {
+    msgs::PosesStamped msg;
+    msgs::Set(msg.mutable_time(), common::Time(1, 0));
+    for (unsigned int i = 0; i < count; ++i)
+    {
+      msgs::Pose *pose = msg.add_pose();
+      pose->set_name("visual_" + std::to_string(i));
+      pose->set_id(100000 + i);
+      msgs::Set(pose, ignition::math::Pose3d(i, 0, 1, 0, 0, 0));
+    }
+
+    test::benchmark::Result &result = g_reporter.Measure(
+        "pose_ingest/" + std::to_string(count),
+        [&scene, &msg]()
+        {
+          scene->UpdatePoses(msg);
+        });
+    const double time = result.Percentile(50);
+    result.metrics.push_back({"poses", count});
+    result.metrics.push_back({"poses_per_second",
+        time > 0 ? count / time : 0.0});
+  }
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
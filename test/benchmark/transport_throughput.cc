@@ -0,0 +1,444 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <signal.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gazebo/msgs/msgs.hh"
+#include "gazebo/transport/transport.hh"
+#include "gazebo/test/ServerFixture.hh"
+#include "test/performance/BenchmarkLibrary.hh"
+
+using namespace gazebo;
+
+/// \brief Results of the benchmarks, written to transport_throughput.json
+/// when the program exits.
+static test::benchmark::Reporter g_reporter("transport_throughput");
+
+/// \brief Topic of the benchmark messages.
+static const char kDataTopic[] = "/gazebo/benchmark/transport";
+
+/// \brief Topic on which a remote process acknowledges each message.
+static const char kAckTopic[] = "/gazebo/benchmark/transport_ack";
+
+/// \brief Sizes of the messages, from 64 B to 8 MB.
+static const std::vector<size_t> kSizes =
+  {64, 1024, 16 * 1024, 256 * 1024, 1024 * 1024, 8 * 1024 * 1024};
+
+/////////////////////////////////////////////////
+/// \brief Get the current time of the steady clock, shared by the
+/// processes of the host.
+/// \return Time in nanoseconds.
+static uint64_t Now()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the CPU time used by the process.
+/// \return User and system time in nanoseconds.
+static uint64_t CpuTime()
+{
+  rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000000000ull +
+    (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) * 1000ull;
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the latency of a benchmark message.
+/// \param[in] _msg The message, which starts with its send time.
+/// \return Time since the message was sent (nanoseconds).
+static uint64_t Latency(const msgs::GzString &_msg)
+{
+  uint64_t sent = 0;
+  if (_msg.data().size() >= sizeof(sent))
+    std::memcpy(&sent, _msg.data().data(), sizeof(sent));
+  return Now() - sent;
+}
+
+/// \brief Receives the benchmark messages, or their acknowledgements
+/// from a remote process, and records their latencies.
+class BenchmarkSubscriber
+{
+  /// \brief Constructor.
+  /// \param[in] _topic Topic to subscribe to.
+  /// \param[in] _remote True if the messages are acknowledgements.
+  public: BenchmarkSubscriber(const std::string &_topic, const bool _remote)
+          : remote(_remote)
+  {
+    this->node.reset(new transport::Node());
+    this->node->Init();
+    this->sub = this->node->Subscribe(_topic,
+        &BenchmarkSubscriber::OnMsg, this);
+  }
+
+  /// \brief Forget the messages received so far.
+  public: void Reset()
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->count = 0;
+    this->latencies.clear();
+    this->remoteCpuStart = this->remoteCpu = 0;
+  }
+
+  /// \brief Wait until a number of messages were received.
+  /// \param[in] _count Number of messages.
+  /// \param[in] _timeout Time to wait (seconds).
+  /// \return True if the messages were received.
+  public: bool Wait(const uint64_t _count, const double _timeout)
+  {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    return this->received.wait_for(lock,
+        std::chrono::duration<double>(_timeout),
+        [this, _count]() {return this->count >= _count;});
+  }
+
+  /// \brief Receive a message.
+  /// \param[in] _msg The message, or the latency and CPU time of the
+  /// remote process.
+  private: void OnMsg(ConstGzStringPtr &_msg)
+  {
+    double latency = 0;
+    uint64_t cpu = 0;
+    if (this->remote)
+    {
+      std::istringstream in(_msg->data());
+      in >> latency >> cpu;
+    }
+    else
+    {
+      latency = Latency(*_msg) * 1e-9;
+    }
+
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if (this->remote)
+    {
+      if (this->count == 0)
+        this->remoteCpuStart = cpu;
+      this->remoteCpu = cpu;
+    }
+    ++this->count;
+    this->latencies.push_back(latency);
+    this->received.notify_all();
+  }
+
+  /// \brief True if the messages are acknowledgements.
+  public: const bool remote;
+
+  /// \brief Protects the counts and latencies.
+  public: std::mutex mutex;
+
+  /// \brief Notified when a message is received.
+  public: std::condition_variable received;
+
+  /// \brief Number of messages received.
+  public: uint64_t count = 0;
+
+  /// \brief Latencies of the messages received (seconds).
+  public: std::vector<double> latencies;
+
+  /// \brief CPU time of the remote process at the first acknowledgement
+  /// (nanoseconds).
+  public: uint64_t remoteCpuStart = 0;
+
+  /// \brief CPU time of the remote process at the last acknowledgement
+  /// (nanoseconds).
+  public: uint64_t remoteCpu = 0;
+
+  /// \brief Node of the subscriber.
+  private: transport::NodePtr node;
+
+  /// \brief The subscriber.
+  private: transport::SubscriberPtr sub;
+};
+
+/// \brief Subscriber of a remote process, acknowledging each message with
+/// its latency and the CPU time of the process.
+class RemoteSubscriber
+{
+  /// \brief Constructor.
+  /// \param[in] _node Node of the process.
+  /// \param[in] _ack Publisher of the acknowledgements.
+  public: RemoteSubscriber(transport::NodePtr _node,
+              transport::PublisherPtr _ack)
+          : ack(_ack)
+  {
+    this->sub = _node->Subscribe(kDataTopic, &RemoteSubscriber::OnMsg, this);
+  }
+
+  /// \brief Acknowledge a message.
+  /// \param[in] _msg The message.
+  private: void OnMsg(ConstGzStringPtr &_msg)
+  {
+    msgs::GzString reply;
+    reply.set_data(std::to_string(Latency(*_msg) * 1e-9) + " " +
+        std::to_string(CpuTime()));
+    this->ack->Publish(reply);
+  }
+
+  /// \brief Publisher of the acknowledgements.
+  private: transport::PublisherPtr ack;
+
+  /// \brief The subscriber.
+  private: transport::SubscriberPtr sub;
+};
+
+class TransportThroughput : public ServerFixture
+{
+  /// \brief Tear down, stopping the remote process.
+  protected: virtual void TearDown()
+  {
+    if (this->pid > 0)
+    {
+      kill(this->pid, SIGKILL);
+      waitpid(this->pid, nullptr, 0);
+      this->pid = -1;
+    }
+    ServerFixture::TearDown();
+  }
+
+  /// \brief Measure the throughput and latency of messages of several
+  /// sizes.
+  /// \param[in] _publishers Number of publishers.
+  /// \param[in] _subscribers Number of subscribers.
+  /// \param[in] _remote True to subscribe in another process.
+  public: void Run(const unsigned int _publishers,
+                   const unsigned int _subscribers, const bool _remote);
+
+  /// \brief Run the subscribers of a remote process, until the process is
+  /// killed.
+  /// \param[in] _subscribers Number of subscribers.
+  public: static void RunRemote(const unsigned int _subscribers);
+
+  /// \brief Process of the remote subscribers.
+  protected: pid_t pid = -1;
+};
+
+/////////////////////////////////////////////////
+void TransportThroughput::RunRemote(const unsigned int _subscribers)
+{
+  if (!transport::init())
+  {
+    gzerr << "Unable to initialize transport" << std::endl;
+    _exit(1);
+  }
+  transport::run();
+
+  transport::NodePtr node(new transport::Node());
+  node->Init();
+  transport::PublisherPtr ack =
+    node->Advertise<msgs::GzString>(kAckTopic, 100000);
+  std::vector<std::unique_ptr<RemoteSubscriber>> subs;
+  for (unsigned int i = 0; i < _subscribers; ++i)
+    subs.emplace_back(new RemoteSubscriber(node, ack));
+
+  while (true)
+    common::Time::MSleep(500);
+}
+
+/////////////////////////////////////////////////
+void TransportThroughput::Run(const unsigned int _publishers,
+    const unsigned int _subscribers, const bool _remote)
+{
+  // The remote process is forked before the server starts its threads, it
+  // connects to the master of the server
+  if (_remote)
+  {
+    this->pid = fork();
+    ASSERT_GE(this->pid, 0);
+    if (this->pid == 0)
+      RunRemote(_subscribers);
+  }
+
+  this->Load("worlds/empty.world", true);
+
+  // In the remote setup there is one subscriber, of the acknowledgements
+  std::vector<std::unique_ptr<BenchmarkSubscriber>> subs;
+  for (unsigned int i = 0; i < (_remote ? 1 : _subscribers); ++i)
+    subs.emplace_back(new BenchmarkSubscriber(
+          _remote ? kAckTopic : kDataTopic, _remote));
+
+  std::vector<transport::NodePtr> nodes;
+  std::vector<transport::PublisherPtr> pubs;
+  for (unsigned int i = 0; i < _publishers; ++i)
+  {
+    nodes.emplace_back(new transport::Node());
+    nodes.back()->Init();
+    pubs.push_back(nodes.back()->Advertise<msgs::GzString>(kDataTopic,
+          100000));
+  }
+
+  if (_remote)
+  {
+    for (auto &pub : pubs)
+      ASSERT_TRUE(pub->WaitForConnection(common::Time(30, 0)));
+    // Let the acknowledgements connect too
+    msgs::GzString msg;
+    msg.set_data(std::string(sizeof(uint64_t), '\0'));
+    bool acknowledged = false;
+    for (int i = 0; i < 30 && !acknowledged; ++i)
+    {
+      pubs[0]->Publish(msg);
+      acknowledged = subs[0]->Wait(1, 1);
+    }
+    ASSERT_TRUE(acknowledged);
+  }
+
+  const std::string setup = _remote ? "remote" : "local";
+  for (auto size : kSizes)
+  {
+    std::ostringstream name;
+    name << setup << "/" << size << "B/pub" << _publishers << "/sub"
+         << _subscribers;
+
+    // Each message of a run is delivered to every subscriber
+    const uint64_t messages = std::max<uint64_t>(16,
+        std::min<uint64_t>(10000, 256ull * 1024 * 1024 / size /
+          _publishers));
+    const uint64_t deliveries = messages * _publishers * _subscribers;
+
+    msgs::GzString msg;
+    msg.set_data(std::string(size, 'x'));
+    auto stamp = [&msg]()
+    {
+      const uint64_t now = Now();
+      std::memcpy(&(*msg.mutable_data())[0], &now, sizeof(now));
+    };
+
+    // Throughput: the publishers send as fast as they can
+    for (auto &sub : subs)
+      sub->Reset();
+    const uint64_t cpuStart = CpuTime();
+    const uint64_t start = Now();
+    for (uint64_t m = 0; m < messages; ++m)
+    {
+      for (auto &pub : pubs)
+      {
+        stamp();
+        pub->Publish(msg);
+      }
+    }
+    bool complete = true;
+    for (auto &sub : subs)
+    {
+      complete = sub->Wait(_remote ? deliveries : messages * _publishers,
+          60) && complete;
+    }
+    const double elapsed = (Now() - start) * 1e-9;
+    const double cpu = (CpuTime() - cpuStart) * 1e-9;
+    EXPECT_TRUE(complete) << name.str();
+
+    uint64_t delivered = 0;
+    double remoteCpu = 0;
+    for (auto &sub : subs)
+    {
+      std::lock_guard<std::mutex> lock(sub->mutex);
+      delivered += sub->count;
+      remoteCpu += (sub->remoteCpu - sub->remoteCpuStart) * 1e-9;
+    }
+
+    // Latency: one message at a time, so that it doesn't queue
+    test::benchmark::Result result;
+    result.name = name.str();
+    result.iterations = 1;
+    const uint64_t pings = std::min<uint64_t>(messages, 2000);
+    for (auto &sub : subs)
+      sub->Reset();
+    for (uint64_t m = 0; m < pings; ++m)
+    {
+      stamp();
+      pubs[m % pubs.size()]->Publish(msg);
+      for (auto &sub : subs)
+        sub->Wait(_remote ? (m + 1) * _subscribers : m + 1, 10);
+    }
+    for (auto &sub : subs)
+    {
+      std::lock_guard<std::mutex> lock(sub->mutex);
+      result.times.insert(result.times.end(), sub->latencies.begin(),
+          sub->latencies.end());
+    }
+
+    result.metrics.push_back({"size", size});
+    result.metrics.push_back({"publishers", _publishers});
+    result.metrics.push_back({"subscribers", _subscribers});
+    result.metrics.push_back({"delivered", static_cast<double>(delivered)});
+    result.metrics.push_back({"messages_per_second",
+        elapsed > 0 ? delivered / elapsed : 0.0});
+    result.metrics.push_back({"megabytes_per_second",
+        elapsed > 0 ? delivered * size / elapsed / (1024 * 1024) : 0.0});
+    // CPU of the publishers and, in the local setup, the subscribers
+    result.metrics.push_back({"cpu_per_message",
+        delivered > 0 ? cpu / delivered : 0.0});
+    if (_remote)
+    {
+      result.metrics.push_back({"remote_cpu_per_message",
+          delivered > 0 ? remoteCpu / delivered : 0.0});
+    }
+    g_reporter.Add(result);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(TransportThroughput, Local)
+{
+  Run(1, 1, false);
+}
+
+/////////////////////////////////////////////////
+TEST_F(TransportThroughput, LocalFanOut)
+{
+  Run(1, 4, false);
+}
+
+/////////////////////////////////////////////////
+TEST_F(TransportThroughput, LocalFanIn)
+{
+  Run(4, 1, false);
+}
+
+/////////////////////////////////////////////////
+TEST_F(TransportThroughput, Remote)
+{
+  Run(1, 1, true);
+}
+
+/////////////////////////////////////////////////
+TEST_F(TransportThroughput, RemoteFanOut)
+{
+  Run(1, 4, true);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
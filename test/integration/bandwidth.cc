@@ -81,6 +81,23 @@ void BandwidthTest::Bandwidth(const std::string &_physicsEngine)
                totalBw, meanSize, count, dt.Double());
 
         EXPECT_GT(totalBw, 1000.0);
+
+        // The transport counters of the server saw the messages
+        msgs::TransportStatistics stats;
+        transport::getStats(stats);
+        bool found = false;
+        for (const auto &topicStats : stats.topic())
+        {
+          if (topicStats.name() != topic)
+            continue;
+          found = true;
+          std::cout << "  Published[" << topicStats.messages()
+            << "] Queue[" << topicStats.queue_depth()
+            << "] Drops[" << topicStats.drops() << "]\n";
+          EXPECT_GE(topicStats.messages(), count);
+        }
+        EXPECT_TRUE(found);
+
         g_bwBytes.clear();
         g_bwTime.clear();
 
@@ -14,6 +14,7 @@
  * limitations under the License.
  *
 */
+#include <cmath>
 #include <mutex>
 #include <functional>
 
@@ -1219,6 +1220,89 @@ TEST_F(CameraSensor, PointCloud)
   delete [] depthImg;
 }
 
+/////////////////////////////////////////////////
+std::mutex g_pointsMutex;
+msgs::PointCloudPacked g_points;
+unsigned int g_pointsCount = 0;
+void OnPointCloudPacked(ConstPointCloudPackedPtr &_msg)
+{
+  std::lock_guard<std::mutex> lock(g_pointsMutex);
+  g_points = *_msg;
+  ++g_pointsCount;
+}
+
+/////////////////////////////////////////////////
+TEST_F(CameraSensor, PointCloudPacked)
+{
+  // The point cloud camera of the world publishes its points in the world
+  // frame
+  Load("worlds/pointcloud_camera.world");
+
+  // Make sure the render engine is available.
+  if (rendering::RenderEngine::Instance()->GetRenderPathType() ==
+      rendering::RenderEngine::NONE)
+  {
+    gzerr << "No rendering engine, unable to run camera test\n";
+    return;
+  }
+
+  sensors::DepthCameraSensorPtr camSensor =
+    std::dynamic_pointer_cast<sensors::DepthCameraSensor>(
+        sensors::get_sensor("pointcloud_camera_sensor"));
+  ASSERT_TRUE(camSensor != nullptr);
+  unsigned int width = camSensor->DepthCamera()->ImageWidth();
+  unsigned int height = camSensor->DepthCamera()->ImageHeight();
+
+  transport::SubscriberPtr sub = this->node->Subscribe(
+      "~/pointcloud_camera/link/pointcloud_camera_sensor/points",
+      OnPointCloudPacked);
+
+  int sleep = 0;
+  while (sleep++ < 300)
+  {
+    {
+      std::lock_guard<std::mutex> lock(g_pointsMutex);
+      if (g_pointsCount > 0)
+        break;
+    }
+    common::Time::MSleep(10);
+  }
+  sub.reset();
+
+  std::lock_guard<std::mutex> lock(g_pointsMutex);
+  ASSERT_GT(g_pointsCount, 0u);
+  EXPECT_EQ("world", g_points.frame());
+  EXPECT_EQ(height, g_points.height());
+  EXPECT_EQ(width, g_points.width());
+  EXPECT_EQ(16u, g_points.point_step());
+  EXPECT_EQ(width * 16u, g_points.row_step());
+  ASSERT_EQ(4, g_points.field_size());
+  EXPECT_EQ("rgb", g_points.field(3).name());
+  EXPECT_EQ(12u, g_points.field(3).offset());
+  ASSERT_EQ(width * height * 16u, g_points.data().size());
+
+  // The boxes fill the view: every point is valid and on the camera facing
+  // side of a box, the camera being at the origin of its model
+  EXPECT_TRUE(g_points.is_dense());
+  physics::WorldPtr world = physics::get_world();
+  ASSERT_TRUE(world != nullptr);
+  const float *points =
+    reinterpret_cast<const float *>(g_points.data().data());
+  for (unsigned int i = 0; i < width * height; i += 97)
+  {
+    const float x = points[4 * i];
+    bool onBox = false;
+    for (auto name : {"tr_box", "tl_box", "br_box", "bl_box"})
+    {
+      physics::ModelPtr box = world->ModelByName(name);
+      ASSERT_TRUE(box != nullptr);
+      if (std::fabs(x - (box->WorldPose().Pos().X() - 0.5)) < 1e-3)
+        onBox = true;
+    }
+    EXPECT_TRUE(onBox) << x;
+  }
+}
+
 /////////////////////////////////////////////////
 TEST_F(CameraSensor, LensFlare)
 {
@@ -14,6 +14,8 @@
  * limitations under the License.
  *
 */
+#include <cmath>
+
 #include <ignition/msgs.hh>
 #include <ignition/transport.hh>
 #include "gazebo/gui/GuiIface.hh"
@@ -595,5 +597,144 @@ void Marker_TEST::CornerCases()
   delete mainWindow;
 }
 
+/////////////////////////////////////////////////
+void Marker_TEST::Batched()
+{
+  this->resMaxPercentChange = 5.0;
+  this->shareMaxPercentChange = 2.0;
+
+  this->Load("worlds/empty_bright.world", false, false, false);
+
+  gazebo::gui::MainWindow *mainWindow = new gazebo::gui::MainWindow();
+  QVERIFY(mainWindow != nullptr);
+
+  // Create the main window.
+  mainWindow->Load();
+  mainWindow->Init();
+  mainWindow->show();
+
+  this->ProcessEventsAndDraw(mainWindow);
+
+  gazebo::rendering::ScenePtr scene = gazebo::rendering::get_scene();
+  QVERIFY(scene != nullptr);
+
+  // Create our node for communication
+  ignition::transport::Node node;
+
+  std::string arrayTopic = "/marker_array";
+  std::string listTopic = "/marker/list";
+
+  std::vector<std::string> serviceList;
+  node.ServiceList(serviceList);
+  QVERIFY(std::find(serviceList.begin(), serviceList.end(), arrayTopic)
+          != serviceList.end());
+
+  // A long path and a list of boxes, with a color per box
+  ignition::msgs::Marker_V markers;
+  ignition::msgs::Marker *path = markers.add_marker();
+  path->set_ns("batched");
+  path->set_id(1);
+  path->set_action(ignition::msgs::Marker::ADD_MODIFY);
+  path->set_type(ignition::msgs::Marker::LINE_STRIP);
+  for (int i = 0; i < 5000; ++i)
+  {
+    ignition::msgs::Set(path->add_point(),
+        ignition::math::Vector3d(i * 0.001, std::sin(i * 0.01), 0.1));
+  }
+
+  ignition::msgs::Marker *boxes = markers.add_marker();
+  boxes->set_ns("batched");
+  boxes->set_id(2);
+  boxes->set_action(ignition::msgs::Marker::ADD_MODIFY);
+  boxes->set_type(ignition::msgs::Marker::BOX);
+  ignition::msgs::Set(boxes->mutable_scale(),
+      ignition::math::Vector3d(0.1, 0.1, 0.1));
+  for (int i = 0; i < 100; ++i)
+  {
+    ignition::msgs::Set(boxes->add_point(),
+        ignition::math::Vector3d(i % 10, i / 10, 0.5));
+    ignition::msgs::Set(boxes->add_materials()->mutable_diffuse(),
+        ignition::math::Color(i * 0.01f, 0, 1));
+  }
+
+  auto visCount = scene->VisualCount();
+
+  ignition::msgs::Boolean rep;
+  bool result;
+  QVERIFY(node.Request(arrayTopic, markers, 5000u, rep, result));
+  QVERIFY(result);
+  QVERIFY(rep.data());
+
+  this->ProcessEventsAndDraw(mainWindow);
+
+  // One visual per marker
+  QCOMPARE(scene->VisualCount(), visCount + 2);
+  QVERIFY(scene->GetVisual("__GZ_MARKER_VISUAL_batched_1") != nullptr);
+  QVERIFY(scene->GetVisual("__GZ_MARKER_VISUAL_batched_2") != nullptr);
+
+  // The shape list reports its points and the size of its shapes
+  {
+    ignition::msgs::Marker_V list;
+    QVERIFY(node.Request(listTopic, 5000u, list, result));
+    QCOMPARE(list.marker().size(), 2);
+    for (const auto &marker : list.marker())
+    {
+      if (marker.id() == 1)
+      {
+        QCOMPARE(marker.point().size(), 5000);
+      }
+      else
+      {
+        QCOMPARE(marker.point().size(), 100);
+        QVERIFY(ignition::math::equal(marker.scale().x(), 0.1));
+        QVERIFY(ignition::math::equal(marker.point(99).y(), 9.0));
+      }
+    }
+  }
+
+  // Move a few points, and shrink the path
+  markers.mutable_marker(0)->clear_point();
+  for (int i = 0; i < 4000; ++i)
+  {
+    ignition::msgs::Set(markers.mutable_marker(0)->add_point(),
+        ignition::math::Vector3d(i * 0.001, std::sin(i * 0.01), 0.1));
+  }
+  ignition::msgs::Set(markers.mutable_marker(1)->mutable_point(5),
+      ignition::math::Vector3d(5, 5, 1));
+  QVERIFY(node.Request(arrayTopic, markers, 5000u, rep, result));
+
+  this->ProcessEventsAndDraw(mainWindow);
+
+  {
+    ignition::msgs::Marker_V list;
+    QVERIFY(node.Request(listTopic, 5000u, list, result));
+    QCOMPARE(list.marker().size(), 2);
+    for (const auto &marker : list.marker())
+    {
+      if (marker.id() == 1)
+      {
+        QCOMPARE(marker.point().size(), 4000);
+      }
+      else
+      {
+        QCOMPARE(marker.point().size(), 100);
+        QVERIFY(ignition::math::equal(marker.point(5).z(), 1.0));
+      }
+    }
+  }
+
+  // Delete everything
+  ignition::msgs::Marker_V deleteAll;
+  deleteAll.add_marker()->set_action(ignition::msgs::Marker::DELETE_ALL);
+  QVERIFY(node.Request(arrayTopic, deleteAll, 5000u, rep, result));
+
+  this->ProcessEventsAndDraw(mainWindow);
+
+  QCOMPARE(scene->VisualCount(), visCount);
+
+  mainWindow->close();
+  delete mainWindow;
+}
+
 // Generate a main function for the test
 QTEST_MAIN(Marker_TEST)
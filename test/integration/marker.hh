@@ -29,5 +29,8 @@ class Marker_TEST : public QTestFixture
 
   /// \brief Test corner cases.
   private slots: void CornerCases();
+
+  /// \brief Test many markers in one request, and shape lists.
+  private slots: void Batched();
 };
 #endif
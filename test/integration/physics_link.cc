@@ -15,6 +15,7 @@
  *
 */
 #include <string.h>
+#include <vector>
 #include <boost/algorithm/string.hpp>
 #include <ignition/math/MassMatrix3.hh>
 #include <ignition/math/Pose3.hh>
@@ -75,6 +76,10 @@ class PhysicsLinkTest : public ServerFixture,
   /// \brief Test velocity setting functions.
   /// \param[in] _physicsEngine Type of physics engine to use.
   public: void SetVelocity(const std::string &_physicsEngine);
+
+  /// \brief Test the velocities cached after each step.
+  /// \param[in] _physicsEngine Type of physics engine to use.
+  public: void KinematicsCache(const std::string &_physicsEngine);
 };
 
 /////////////////////////////////////////////////
@@ -820,6 +825,121 @@ void PhysicsLinkTest::SetVelocity(const std::string &_physicsEngine)
   EXPECT_NEAR(rpy.Z(), 0.0, g_tolerance);
 }
 
+/////////////////////////////////////////////////
+void PhysicsLinkTest::KinematicsCache(const std::string &_physicsEngine)
+{
+  Load("worlds/blank.world", true, _physicsEngine);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != NULL);
+  world->SetGravity(ignition::math::Vector3d::Zero);
+
+  SpawnBox("box", ignition::math::Vector3d::One,
+      ignition::math::Vector3d(0, 0, 1), ignition::math::Vector3d::Zero,
+      false);
+  physics::ModelPtr model = world->ModelByName("box");
+  ASSERT_TRUE(model != NULL);
+  physics::LinkPtr link = model->GetLink();
+  ASSERT_TRUE(link != NULL);
+
+  // Nothing is cached before the first step
+  EXPECT_FALSE(link->KinematicsCached());
+
+  const ignition::math::Vector3d linearVel(0, 0, 1);
+  const ignition::math::Vector3d angularVel(0, 0.5, 0);
+  link->SetLinearVel(linearVel);
+  link->SetAngularVel(angularVel);
+  world->Step(1);
+  EXPECT_TRUE(link->KinematicsCached());
+
+  // The cached velocities match the ones computed from the engine
+  const ignition::math::Vector3d worldVel = link->WorldLinearVel();
+  const ignition::math::Vector3d relativeAngularVel =
+      link->RelativeAngularVel();
+  link->ClearKinematicsCache();
+  EXPECT_EQ(worldVel, link->WorldLinearVel());
+  EXPECT_EQ(relativeAngularVel, link->RelativeAngularVel());
+  EXPECT_EQ(link->WorldPose().Rot().RotateVectorReverse(worldVel),
+      link->RelativeLinearVel());
+
+  // Setting the velocity drops the cache
+  world->Step(1);
+  EXPECT_TRUE(link->KinematicsCached());
+  link->SetLinearVel(ignition::math::Vector3d::Zero);
+  link->SetAngularVel(ignition::math::Vector3d::Zero);
+  EXPECT_FALSE(link->KinematicsCached());
+  EXPECT_EQ(ignition::math::Vector3d::Zero, link->WorldLinearVel());
+  EXPECT_EQ(ignition::math::Vector3d::Zero, link->RelativeAngularVel());
+
+  // So does setting the pose
+  world->Step(1);
+  EXPECT_TRUE(link->KinematicsCached());
+  link->SetWorldPose(ignition::math::Pose3d(0, 0, 2, 0, 0, 0));
+  EXPECT_FALSE(link->KinematicsCached());
+}
+
+/////////////////////////////////////////////////
+// Links at rest fall asleep with ODE auto disabling, and wake up.
+TEST_F(PhysicsLinkTest, AsleepODE)
+{
+  Load("worlds/empty.world", true, "ode");
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != NULL);
+
+  SpawnBox("box", ignition::math::Vector3d::One,
+      ignition::math::Vector3d(0, 0, 0.5), ignition::math::Vector3d::Zero,
+      false);
+  physics::ModelPtr model = world->ModelByName("box");
+  ASSERT_TRUE(model != NULL);
+  physics::LinkPtr link = model->GetLink();
+  ASSERT_TRUE(link != NULL);
+
+  std::vector<bool> changes;
+  event::ConnectionPtr connection = link->ConnectEnabled(
+      [&changes](bool _enabled)
+      {
+        changes.push_back(_enabled);
+      });
+
+  EXPECT_FALSE(link->Asleep());
+  EXPECT_FALSE(model->Asleep());
+
+  // The box rests on the ground, ODE disables it after a second
+  for (int i = 0; i < 5000 && !link->Asleep(); ++i)
+    world->Step(1);
+  EXPECT_TRUE(link->Asleep());
+  EXPECT_TRUE(model->Asleep());
+  EXPECT_FALSE(link->GetEnabled());
+
+  // The change is notified at the beginning of the next step
+  world->Step(1);
+  ASSERT_EQ(1u, changes.size());
+  EXPECT_FALSE(changes[0]);
+
+  // A sleeping box doesn't move
+  const ignition::math::Pose3d pose = link->WorldPose();
+  world->Step(100);
+  EXPECT_EQ(pose, link->WorldPose());
+  EXPECT_TRUE(link->Asleep());
+
+  // Wake it up
+  model->Wake();
+  EXPECT_FALSE(link->Asleep());
+  EXPECT_FALSE(model->Asleep());
+  EXPECT_TRUE(link->GetEnabled());
+  world->Step(1);
+  ASSERT_EQ(2u, changes.size());
+  EXPECT_TRUE(changes[1]);
+
+  // A force wakes it up too
+  for (int i = 0; i < 5000 && !link->Asleep(); ++i)
+    world->Step(1);
+  EXPECT_TRUE(link->Asleep());
+  link->AddForce(ignition::math::Vector3d(0, 0, 1000));
+  world->Step(1);
+  EXPECT_FALSE(link->Asleep());
+  EXPECT_LT(pose.Pos().Z(), link->WorldPose().Pos().Z());
+}
+
 /////////////////////////////////////////////////
 TEST_P(PhysicsLinkTest, AddForce)
 {
@@ -856,6 +976,12 @@ TEST_P(PhysicsLinkTest, SetVelocity)
   SetVelocity(GetParam());
 }
 
+/////////////////////////////////////////////////
+TEST_P(PhysicsLinkTest, KinematicsCache)
+{
+  KinematicsCache(GetParam());
+}
+
 INSTANTIATE_TEST_CASE_P(PhysicsEngines, PhysicsLinkTest,
                         PHYSICS_ENGINE_VALUES,);  // NOLINT
 
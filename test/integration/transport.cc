@@ -18,6 +18,8 @@
 #ifndef _WIN32
 #include <unistd.h>
 #endif
+#include <memory>
+#include <utility>
 #include "gazebo/test/ServerFixture.hh"
 
 using namespace gazebo;
@@ -186,6 +188,66 @@ TEST_F(TransportTest, DirectPublish)
   ASSERT_GT(timeout, 0) << "Not received a message in 10 seconds";
 }
 
+/////////////////////////////////////////////////
+/// \brief Last image received by ReceiveImageMsg.
+boost::shared_ptr<const msgs::ImageStamped> g_imageMsg;
+
+/////////////////////////////////////////////////
+void ReceiveImageMsg(ConstImageStampedPtr &_msg)
+{
+  g_imageMsg = _msg;
+}
+
+/////////////////////////////////////////////////
+TEST_F(TransportTest, SharedPublish)
+{
+  Load("worlds/empty.world");
+
+  g_imageMsg.reset();
+
+  transport::NodePtr node = transport::NodePtr(new transport::Node());
+  node->Init();
+  transport::PublisherPtr imagePub =
+    node->Advertise<msgs::ImageStamped>("~/test/image");
+  transport::SubscriberPtr imageSub = node->Subscribe("~/test/image",
+      &ReceiveImageMsg);
+
+  boost::shared_ptr<msgs::ImageStamped> msg(new msgs::ImageStamped);
+  msgs::Set(msg->mutable_time(), common::Time(1, 2));
+  msg->mutable_image()->set_width(4);
+  msg->mutable_image()->set_height(2);
+  msg->mutable_image()->set_pixel_format(common::Image::L_INT8);
+  msg->mutable_image()->set_step(4);
+  msg->mutable_image()->set_data(std::string(8, 'a'));
+  imagePub->Publish(msg);
+
+  int timeout = 1000;
+  while (!g_imageMsg && --timeout > 0)
+    common::Time::MSleep(10);
+  ASSERT_GT(timeout, 0) << "Not received a message in 10 seconds";
+
+  // A local subscriber receives the published message itself
+  EXPECT_EQ(msg.get(), g_imageMsg.get());
+  EXPECT_EQ(std::string(8, 'a'), g_imageMsg->image().data());
+  g_imageMsg.reset();
+
+  // A message handed over to the publisher is kept without a copy
+  std::unique_ptr<msgs::ImageStamped> owned(new msgs::ImageStamped(*msg));
+  owned->mutable_image()->set_data(std::string(8, 'b'));
+  const msgs::ImageStamped *ownedPtr = owned.get();
+  imagePub->Publish(std::move(owned));
+
+  timeout = 1000;
+  while (!g_imageMsg && --timeout > 0)
+    common::Time::MSleep(10);
+  ASSERT_GT(timeout, 0) << "Not received a message in 10 seconds";
+
+  EXPECT_EQ(ownedPtr, g_imageMsg.get());
+  EXPECT_EQ(ownedPtr, imagePub->GetPrevMsgPtr().get());
+  EXPECT_EQ(g_imageMsg->SerializeAsString(), imagePub->GetPrevMsg());
+  g_imageMsg.reset();
+}
+
 /////////////////////////////////////////////////
 void SinglePub()
 {
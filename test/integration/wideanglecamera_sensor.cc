@@ -226,6 +226,58 @@ TEST_F(WideAngleCameraSensor, Projection)
 #endif
 }
 
+/////////////////////////////////////////////////
+TEST_F(WideAngleCameraSensor, EnvFacesInView)
+{
+#if not defined(__APPLE__)
+  Load("worlds/usercamera_test.world");
+
+  // Make sure the render engine is available.
+  if (rendering::RenderEngine::Instance()->GetRenderPathType() ==
+      rendering::RenderEngine::NONE)
+  {
+    gzerr << "No rendering engine, unable to run wide angle camera test\n";
+    return;
+  }
+
+  // Spawn a stereographic camera of 86 degrees horizontal field of view,
+  // whose image corners reach past the +X and -X faces but not the others
+  std::string modelName = "camera_model";
+  std::string cameraName = "camera_sensor";
+  SpawnWideAngleCamera(modelName, cameraName,
+      ignition::math::Vector3d::Zero, ignition::math::Vector3d::Zero,
+      320, 240, 10, 1.5);
+  sensors::WideAngleCameraSensorPtr camSensor =
+      std::dynamic_pointer_cast<sensors::WideAngleCameraSensor>(
+      sensors::get_sensor(cameraName));
+  ASSERT_NE(camSensor, nullptr);
+
+  rendering::WideAngleCameraPtr camera =
+      boost::dynamic_pointer_cast<rendering::WideAngleCamera>(
+      camSensor->Camera());
+  ASSERT_NE(camera, nullptr);
+
+  EXPECT_TRUE(camera->EnvFaceInView(0));
+  EXPECT_TRUE(camera->EnvFaceInView(1));
+  EXPECT_FALSE(camera->EnvFaceInView(2));
+  EXPECT_FALSE(camera->EnvFaceInView(3));
+  EXPECT_TRUE(camera->EnvFaceInView(4));
+  EXPECT_FALSE(camera->EnvFaceInView(5));
+  EXPECT_FALSE(camera->EnvFaceInView(6));
+
+  // A small cutoff angle leaves only the forward face
+  camera->Lens()->SetCutOffAngle(0.5);
+  for (unsigned int i = 0; i < 6; ++i)
+    EXPECT_EQ(i == 4, camera->EnvFaceInView(i)) << i;
+
+  // A very wide lens sees the whole cube
+  camera->Lens()->SetCutOffAngle(IGN_PI);
+  camera->SetHFOV(ignition::math::Angle(6.0));
+  for (unsigned int i = 0; i < 6; ++i)
+    EXPECT_TRUE(camera->EnvFaceInView(i)) << i;
+#endif
+}
+
 /////////////////////////////////////////////////
 TEST_F(WideAngleCameraSensor, TextureFormat)
 {
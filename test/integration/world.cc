@@ -14,6 +14,8 @@
  * limitations under the License.
  *
 */
+#include <mutex>
+
 #include "gazebo/test/ServerFixture.hh"
 #include "gazebo/physics/Light.hh"
 #include "gazebo/physics/physics.hh"
@@ -554,6 +556,65 @@ TEST_F(WorldTest, RemoveModelUnPaused)
   EXPECT_FALSE(boxModel != NULL);
 }
 
+/////////////////////////////////////////////////
+/// \brief Check whether a list of models contains a model.
+/// \param[in] _models The models.
+/// \param[in] _name Name of the model.
+/// \return True if a model of the list has the name.
+bool HasModel(const physics::Model_V &_models, const std::string &_name)
+{
+  for (auto const &model : _models)
+  {
+    if (model->GetName() == _name)
+      return true;
+  }
+  return false;
+}
+
+/////////////////////////////////////////////////
+TEST_F(WorldTest, ModelsInRegion)
+{
+  // A box at the origin, a sphere at +y and a cylinder at -y, all unit
+  // sized and resting on the ground plane
+  Load("worlds/shapes.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != NULL);
+
+  physics::Model_V models = world->ModelsInBox(
+      ignition::math::AxisAlignedBox(ignition::math::Vector3d(-0.2, 1, 0.2),
+        ignition::math::Vector3d(0.2, 2, 0.8)));
+  EXPECT_TRUE(HasModel(models, "sphere"));
+  EXPECT_FALSE(HasModel(models, "box"));
+  EXPECT_FALSE(HasModel(models, "cylinder"));
+
+  models = world->ModelsInSphere(ignition::math::Vector3d(0, -2.5, 0.5), 0.6);
+  EXPECT_TRUE(HasModel(models, "cylinder"));
+  EXPECT_FALSE(HasModel(models, "box"));
+  EXPECT_FALSE(HasModel(models, "sphere"));
+
+  // A frustum at x = -5 looking along +x at the box
+  ignition::math::Frustum frustum;
+  frustum.SetNear(0.1);
+  frustum.SetFar(10);
+  frustum.SetFOV(ignition::math::Angle(0.1));
+  frustum.SetAspectRatio(1.0);
+  frustum.SetPose(ignition::math::Pose3d(-5, 0, 0.5, 0, 0, 0));
+  models = world->ModelsInFrustum(frustum);
+  EXPECT_TRUE(HasModel(models, "box"));
+  EXPECT_FALSE(HasModel(models, "sphere"));
+  EXPECT_FALSE(HasModel(models, "cylinder"));
+
+  // Models that move are found at their new pose after a step
+  physics::ModelPtr box = world->ModelByName("box");
+  ASSERT_TRUE(box != NULL);
+  box->SetWorldPose(ignition::math::Pose3d(0, -2.5, 0.5, 0, 0, 0));
+  world->Step(1);
+  models = world->ModelsInSphere(ignition::math::Vector3d(0, -2.5, 0.5), 0.6);
+  EXPECT_TRUE(HasModel(models, "box"));
+  models = world->ModelsInFrustum(frustum);
+  EXPECT_FALSE(HasModel(models, "box"));
+}
+
 /////////////////////////////////////////////////
 /// \brief Check if WorldUpdateBegin, BeforePhysicsUpdate and WorldUpdateEnd
 /// events are called, and if the BeforePhysicsUpdate event is really called
@@ -627,6 +688,169 @@ TEST_F(WorldTest, CheckWorldEventsWork)
   worldUpdateEndEventConnection.reset();
 }
 
+/// \brief Mutex of the statistics breakdown received.
+std::mutex g_breakdownMutex;
+
+/// \brief Last statistics breakdown received.
+msgs::WorldStatisticsBreakdown g_breakdown;
+
+/// \brief Number of statistics breakdowns received.
+int g_breakdownCount = 0;
+
+/////////////////////////////////////////////////
+/// \brief Callback for the statistics breakdown.
+/// \param[in] _msg The breakdown.
+void onBreakdown(ConstWorldStatisticsBreakdownPtr &_msg)
+{
+  std::lock_guard<std::mutex> lock(g_breakdownMutex);
+  g_breakdown = *_msg;
+  ++g_breakdownCount;
+}
+
+/////////////////////////////////////////////////
+TEST_F(WorldTest, StatsBreakdown)
+{
+  Load("worlds/empty.world", false);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != NULL);
+
+  transport::SubscriberPtr sub = this->node->Subscribe(
+      "~/world_stats/breakdown", &onBreakdown);
+
+  // The breakdown is published once per second
+  for (int i = 0; i < 100; ++i)
+  {
+    {
+      std::lock_guard<std::mutex> lock(g_breakdownMutex);
+      if (g_breakdownCount > 0)
+        break;
+    }
+    common::Time::MSleep(100);
+  }
+
+  std::lock_guard<std::mutex> lock(g_breakdownMutex);
+  ASSERT_GT(g_breakdownCount, 0);
+  const double window = msgs::Convert(g_breakdown.window()).Double();
+  EXPECT_GT(window, 0.5);
+  EXPECT_GT(g_breakdown.iterations(), 0u);
+
+  // The phases cover most of the real time, mostly sleeping to keep the
+  // update rate
+  double total = 0;
+  bool physics = false;
+  for (auto const &phase : g_breakdown.phase())
+  {
+    EXPECT_GE(phase.time(), 0.0);
+    total += phase.time();
+    physics = physics || phase.name() == "updatePhysics";
+  }
+  EXPECT_TRUE(physics);
+  EXPECT_GT(total, 0.5 * window);
+}
+
+/////////////////////////////////////////////////
+// A box resting on the ground plane is charged with contacts and solver rows
+TEST_F(WorldTest, ModelCostBreakdown)
+{
+  Load("worlds/empty.world", false);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != NULL);
+
+  SpawnBox("box", ignition::math::Vector3d::One,
+      ignition::math::Vector3d(0, 0, 0.5), ignition::math::Vector3d::Zero);
+  ASSERT_TRUE(world->ModelByName("box") != NULL);
+
+  {
+    std::lock_guard<std::mutex> lock(g_breakdownMutex);
+    g_breakdownCount = 0;
+  }
+  transport::SubscriberPtr sub = this->node->Subscribe(
+      "~/world_stats/breakdown", &onBreakdown);
+
+  // Wait for a window that starts after the box was spawned
+  for (int i = 0; i < 100; ++i)
+  {
+    {
+      std::lock_guard<std::mutex> lock(g_breakdownMutex);
+      if (g_breakdownCount > 2)
+        break;
+    }
+    common::Time::MSleep(100);
+  }
+
+  std::lock_guard<std::mutex> lock(g_breakdownMutex);
+  ASSERT_GT(g_breakdownCount, 2);
+
+  bool box = false;
+  bool ground = false;
+  for (auto const &model : g_breakdown.model())
+  {
+    if (model.name() == "box")
+    {
+      box = true;
+      EXPECT_GT(model.contacts(), 0u);
+      // Each contact point has a normal and two friction rows
+      EXPECT_GE(model.solver_rows(), 3 * model.contacts());
+      EXPECT_DOUBLE_EQ(0.0, model.plugin_time());
+    }
+    ground = ground || model.name() == "ground_plane";
+  }
+  EXPECT_TRUE(box);
+  EXPECT_TRUE(ground);
+}
+
+/////////////////////////////////////////////////
+// The core of a step of the reference world doesn't allocate once the
+// world runs steadily
+TEST_F(WorldTest, StepAllocations)
+{
+  if (!common::AllocationCounter::Available())
+  {
+    gzdbg << "Allocations are not counted, skipping" << std::endl;
+    return;
+  }
+
+  Load("worlds/empty.world", false);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != NULL);
+
+  {
+    std::lock_guard<std::mutex> lock(g_breakdownMutex);
+    g_breakdownCount = 0;
+  }
+  transport::SubscriberPtr sub = this->node->Subscribe(
+      "~/world_stats/breakdown", &onBreakdown);
+
+  // Wait for a window of 5 seconds that starts after the first steps
+  for (int i = 0; i < 200; ++i)
+  {
+    {
+      std::lock_guard<std::mutex> lock(g_breakdownMutex);
+      if (g_breakdownCount > 7)
+        break;
+    }
+    common::Time::MSleep(100);
+  }
+
+  std::lock_guard<std::mutex> lock(g_breakdownMutex);
+  ASSERT_GT(g_breakdownCount, 7);
+  EXPECT_GT(g_breakdown.iterations(), 0u);
+
+  unsigned int checked = 0;
+  for (auto const &phase : g_breakdown.phase())
+  {
+    EXPECT_TRUE(phase.has_allocations()) << phase.name();
+    if (phase.name() == "updateCollision" ||
+        phase.name() == "updatePhysics" ||
+        phase.name() == "setWorldPose")
+    {
+      EXPECT_EQ(0u, phase.allocations()) << phase.name();
+      ++checked;
+    }
+  }
+  EXPECT_GE(checked, 2u);
+}
+
 /////////////////////////////////////////////////
 TEST_F(WorldTest, URI)
 {
@@ -0,0 +1,463 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GAZEBO_TEST_PERFORMANCE_BENCHMARKLIBRARY_HH_
+#define GAZEBO_TEST_PERFORMANCE_BENCHMARKLIBRARY_HH_
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace gazebo
+{
+  namespace test
+  {
+    namespace benchmark
+    {
+      /// \brief Hardware counters of the calling thread, read with the
+      /// Linux perf_event_open system call. The counters are unavailable on
+      /// other platforms, in most virtual machines, and when
+      /// /proc/sys/kernel/perf_event_paranoid forbids them.
+      class PerfCounters
+      {
+        /// \brief Constructor, opens the counters that are available.
+        public: PerfCounters()
+        {
+#ifdef __linux__
+          const std::pair<const char *, uint64_t> events[] =
+          {
+            {"cycles", PERF_COUNT_HW_CPU_CYCLES},
+            {"instructions", PERF_COUNT_HW_INSTRUCTIONS},
+            {"cache_misses", PERF_COUNT_HW_CACHE_MISSES},
+            {"branch_misses", PERF_COUNT_HW_BRANCH_MISSES}
+          };
+          for (auto const &event : events)
+          {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = event.second;
+            attr.disabled = this->fds.empty() ? 1 : 0;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_GROUP |
+              PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+            const int leader = this->fds.empty() ? -1 : this->fds[0];
+            const int fd = static_cast<int>(syscall(__NR_perf_event_open,
+                  &attr, 0, -1, leader, 0));
+            if (fd < 0)
+            {
+              // Without the group leader none of the counters work
+              if (this->fds.empty())
+                return;
+              continue;
+            }
+            this->fds.push_back(fd);
+            this->names.push_back(event.first);
+          }
+#endif
+        }
+
+        /// \brief Destructor, closes the counters.
+        public: ~PerfCounters()
+        {
+#ifdef __linux__
+          for (auto fd : this->fds)
+            close(fd);
+#endif
+        }
+
+        /// \brief Check whether any counter is available.
+        /// \return True if the counters can be read.
+        public: bool Available() const
+        {
+          return !this->fds.empty();
+        }
+
+        /// \brief Get the names of the available counters.
+        /// \return Names, in the order of the values returned by Stop.
+        public: const std::vector<std::string> &Names() const
+        {
+          return this->names;
+        }
+
+        /// \brief Reset and start the counters.
+        public: void Start()
+        {
+#ifdef __linux__
+          if (this->fds.empty())
+            return;
+          ioctl(this->fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+          ioctl(this->fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+        }
+
+        /// \brief Stop the counters and read them.
+        /// \return Counts since Start, scaled up when the kernel had to
+        /// share the hardware with other counters. Empty if the counters
+        /// are unavailable.
+        public: std::vector<double> Stop()
+        {
+          std::vector<double> values;
+#ifdef __linux__
+          if (this->fds.empty())
+            return values;
+          ioctl(this->fds[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+          // Number of counters, time enabled, time running, then the counts
+          std::vector<uint64_t> data(3 + this->fds.size());
+          const ssize_t size = read(this->fds[0], data.data(),
+              data.size() * sizeof(uint64_t));
+          if (size < static_cast<ssize_t>(3 * sizeof(uint64_t)) ||
+              data[0] != this->fds.size())
+          {
+            return values;
+          }
+
+          const double scale = data[2] > 0 ?
+            static_cast<double>(data[1]) / data[2] : 1.0;
+          for (size_t i = 0; i < this->fds.size(); ++i)
+            values.push_back(data[3 + i] * scale);
+#endif
+          return values;
+        }
+
+        /// \brief File descriptors of the counters, the group leader first.
+        private: std::vector<int> fds;
+
+        /// \brief Names of the counters.
+        private: std::vector<std::string> names;
+      };
+
+      /// \brief Options of a benchmark.
+      class Options
+      {
+        /// \brief Real time spent running the function before measuring,
+        /// to warm up the caches and the branch predictors (seconds).
+        public: double warmupTime = 0.1;
+
+        /// \brief Minimum real time of a repetition (seconds). The number
+        /// of calls per repetition is chosen during the warm up to reach
+        /// it.
+        public: double repetitionTime = 0.01;
+
+        /// \brief Number of measured repetitions.
+        public: unsigned int repetitions = 30;
+      };
+
+      /// \brief Statistics of the durations of a benchmark.
+      class Result
+      {
+        /// \brief Name of the benchmark.
+        public: std::string name;
+
+        /// \brief Number of calls of the function per repetition.
+        public: uint64_t iterations = 0;
+
+        /// \brief Duration of a call in each repetition (seconds), sorted.
+        public: std::vector<double> times;
+
+        /// \brief Names of the hardware counters.
+        public: std::vector<std::string> counterNames;
+
+        /// \brief Median count of each hardware counter per call.
+        public: std::vector<double> counters;
+
+        /// \brief Other values measured by the benchmark, by name, e.g.
+        /// the memory used.
+        public: std::vector<std::pair<std::string, double>> metrics;
+
+        /// \brief Get a percentile of the durations, interpolated between
+        /// the closest repetitions.
+        /// \param[in] _p Percentile, between 0 and 100.
+        /// \return Duration of a call (seconds), 0 without repetitions.
+        public: double Percentile(const double _p) const
+        {
+          return Percentile(this->times, _p);
+        }
+
+        /// \brief Get the mean duration of a call.
+        /// \return Duration (seconds), 0 without repetitions.
+        public: double Mean() const
+        {
+          if (this->times.empty())
+            return 0;
+          double sum = 0;
+          for (auto t : this->times)
+            sum += t;
+          return sum / this->times.size();
+        }
+
+        /// \brief Get a percentile of sorted values.
+        /// \param[in] _values Sorted values.
+        /// \param[in] _p Percentile, between 0 and 100.
+        /// \return Interpolated percentile, 0 if there are no values.
+        public: static double Percentile(const std::vector<double> &_values,
+                    const double _p)
+        {
+          if (_values.empty())
+            return 0;
+          const double rank = std::min(std::max(_p, 0.0), 100.0) / 100.0 *
+            (_values.size() - 1);
+          const size_t low = static_cast<size_t>(rank);
+          const size_t high = std::min(low + 1, _values.size() - 1);
+          return _values[low] + (rank - low) * (_values[high] - _values[low]);
+        }
+      };
+
+      /// \brief Measure a function at steady state. The function runs for
+      /// the warm up time, then in repetitions of a fixed number of calls,
+      /// each timed and counted separately.
+      /// \param[in] _name Name of the benchmark.
+      /// \param[in] _func Function to measure.
+      /// \param[in] _options Options of the benchmark.
+      /// \return The statistics of the repetitions.
+      inline Result Measure(const std::string &_name,
+          const std::function<void()> &_func,
+          const Options &_options = Options())
+      {
+        typedef std::chrono::steady_clock Clock;
+        auto seconds = [](const Clock::duration &_d)
+        {
+          return std::chrono::duration<double>(_d).count();
+        };
+
+        Result result;
+        result.name = _name;
+
+        // Warm up, and choose the number of calls per repetition
+        uint64_t calls = 0;
+        const auto warmupStart = Clock::now();
+        double elapsed = 0;
+        do
+        {
+          _func();
+          ++calls;
+          elapsed = seconds(Clock::now() - warmupStart);
+        } while (elapsed < _options.warmupTime);
+        const double callTime = elapsed / calls;
+        result.iterations = std::max<uint64_t>(1,
+            static_cast<uint64_t>(_options.repetitionTime / callTime));
+
+        PerfCounters perf;
+        result.counterNames = perf.Names();
+        std::vector<std::vector<double>> counts(result.counterNames.size());
+
+        for (unsigned int r = 0; r < _options.repetitions; ++r)
+        {
+          perf.Start();
+          const auto start = Clock::now();
+          for (uint64_t i = 0; i < result.iterations; ++i)
+            _func();
+          const auto end = Clock::now();
+          const std::vector<double> values = perf.Stop();
+
+          result.times.push_back(seconds(end - start) / result.iterations);
+          for (size_t i = 0; i < values.size() && i < counts.size(); ++i)
+            counts[i].push_back(values[i] / result.iterations);
+        }
+
+        std::sort(result.times.begin(), result.times.end());
+        for (auto &values : counts)
+        {
+          std::sort(values.begin(), values.end());
+          result.counters.push_back(Result::Percentile(values, 50));
+        }
+        return result;
+      }
+
+      /// \brief Write a string as a JSON string literal.
+      /// \param[in] _out Output stream.
+      /// \param[in] _str The string.
+      inline void WriteJsonString(std::ostream &_out, const std::string &_str)
+      {
+        _out << '"';
+        for (auto c : _str)
+        {
+          if (c == '"' || c == '\\')
+            _out << '\\' << c;
+          else if (static_cast<unsigned char>(c) < 0x20)
+          {
+            _out << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+                 << static_cast<int>(c) << std::dec << std::setfill(' ');
+          }
+          else
+            _out << c;
+        }
+        _out << '"';
+      }
+
+      /// \brief Write the results of benchmarks as JSON, e.g.
+      /// {"suite": "physics", "benchmarks": [{"name": "step",
+      /// "iterations": 1000, "repetitions": 30, "time": {"min": ...,
+      /// "mean": ..., "p50": ..., "p90": ..., "p99": ..., "p999": ..., "max": ...},
+      /// "counters": {"cycles": ..., ...}, "metrics": {...}}]}. The times
+      /// are in seconds and the counters are per call.
+      /// \param[in] _out Output stream.
+      /// \param[in] _suite Name of the suite of benchmarks.
+      /// \param[in] _results The results.
+      inline void WriteJson(std::ostream &_out, const std::string &_suite,
+          const std::vector<Result> &_results)
+      {
+        std::ostringstream out;
+        out << std::setprecision(9);
+        out << "{\"suite\": ";
+        WriteJsonString(out, _suite);
+        out << ", \"benchmarks\": [";
+        for (size_t i = 0; i < _results.size(); ++i)
+        {
+          const Result &result = _results[i];
+          out << (i > 0 ? ",\n  " : "\n  ") << "{\"name\": ";
+          WriteJsonString(out, result.name);
+          out << ", \"iterations\": " << result.iterations
+              << ", \"repetitions\": " << result.times.size()
+              << ", \"time\": {\"min\": " << result.Percentile(0)
+              << ", \"mean\": " << result.Mean()
+              << ", \"p50\": " << result.Percentile(50)
+              << ", \"p90\": " << result.Percentile(90)
+              << ", \"p99\": " << result.Percentile(99)
+              << ", \"p999\": " << result.Percentile(99.9)
+              << ", \"max\": " << result.Percentile(100) << "}";
+          out << ", \"counters\": {";
+          for (size_t c = 0; c < result.counters.size() &&
+              c < result.counterNames.size(); ++c)
+          {
+            if (c > 0)
+              out << ", ";
+            WriteJsonString(out, result.counterNames[c]);
+            out << ": " << result.counters[c];
+          }
+          out << "}, \"metrics\": {";
+          for (size_t m = 0; m < result.metrics.size(); ++m)
+          {
+            if (m > 0)
+              out << ", ";
+            WriteJsonString(out, result.metrics[m].first);
+            out << ": " << result.metrics[m].second;
+          }
+          out << "}}";
+        }
+        out << "\n]}\n";
+        _out << out.str();
+      }
+
+      /// \brief Collects the results of the benchmarks of a test program,
+      /// and writes them when destroyed. The JSON is written to
+      /// <suite>.json in the directory named by the GAZEBO_BENCHMARK_DIR
+      /// environment variable if it is set, and a summary is printed to
+      /// standard out.
+      class Reporter
+      {
+        /// \brief Constructor.
+        /// \param[in] _suite Name of the suite of benchmarks.
+        public: explicit Reporter(const std::string &_suite)
+                : suite(_suite)
+        {
+        }
+
+        /// \brief Destructor, writes the results.
+        public: ~Reporter()
+        {
+          const char *dir = std::getenv("GAZEBO_BENCHMARK_DIR");
+          if (!dir || this->results.empty())
+            return;
+
+          const std::string path = std::string(dir) + "/" + this->suite +
+            ".json";
+          std::ofstream file(path);
+          if (!file)
+          {
+            std::cerr << "Unable to write benchmark results to ["
+                      << path << "]" << std::endl;
+            return;
+          }
+          WriteJson(file, this->suite, this->results);
+        }
+
+        /// \brief Run a benchmark and keep its result.
+        /// \param[in] _name Name of the benchmark.
+        /// \param[in] _func Function to measure.
+        /// \param[in] _options Options of the benchmark.
+        /// \return The result, valid until the next benchmark is run. Its
+        /// metrics may be added to until the results are written.
+        public: Result &Measure(const std::string &_name,
+                    const std::function<void()> &_func,
+                    const Options &_options = Options())
+        {
+          return this->Add(benchmark::Measure(_name, _func, _options));
+        }
+
+        /// \brief Keep the result of a benchmark measured by the caller,
+        /// e.g. when each sample is a latency timed by another thread.
+        /// \param[in] _result The result. Its times are sorted.
+        /// \return The result kept, valid until the next benchmark is run.
+        public: Result &Add(const Result &_result)
+        {
+          this->results.push_back(_result);
+          Result &result = this->results.back();
+          std::sort(result.times.begin(), result.times.end());
+
+          std::cout << "Benchmark[" << this->suite << "/" << result.name
+                    << "] Iterations[" << result.iterations
+                    << "] P50[" << result.Percentile(50)
+                    << "] P90[" << result.Percentile(90)
+                    << "] P99[" << result.Percentile(99) << "]";
+          for (size_t c = 0; c < result.counters.size(); ++c)
+          {
+            std::cout << " " << result.counterNames[c] << "["
+                      << result.counters[c] << "]";
+          }
+          std::cout << std::endl;
+          return result;
+        }
+
+        /// \brief Get the results.
+        /// \return The results of the benchmarks run so far.
+        public: const std::vector<Result> &Results() const
+        {
+          return this->results;
+        }
+
+        /// \brief Name of the suite.
+        private: std::string suite;
+
+        /// \brief Results of the benchmarks.
+        private: std::vector<Result> results;
+      };
+    }
+  }
+}
+#endif
@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <sstream>
+
+#include "BenchmarkLibrary.hh"
+
+using namespace gazebo::test::benchmark;
+
+/////////////////////////////////////////////////
+TEST(BenchmarkLibrary, Percentile)
+{
+  EXPECT_DOUBLE_EQ(0.0, Result::Percentile({}, 50));
+  EXPECT_DOUBLE_EQ(3.0, Result::Percentile({3.0}, 90));
+
+  const std::vector<double> values = {1, 2, 3, 4, 5};
+  EXPECT_DOUBLE_EQ(1.0, Result::Percentile(values, 0));
+  EXPECT_DOUBLE_EQ(3.0, Result::Percentile(values, 50));
+  EXPECT_DOUBLE_EQ(4.6, Result::Percentile(values, 90));
+  EXPECT_DOUBLE_EQ(5.0, Result::Percentile(values, 100));
+  EXPECT_DOUBLE_EQ(5.0, Result::Percentile(values, 200));
+}
+
+/////////////////////////////////////////////////
+TEST(BenchmarkLibrary, Measure)
+{
+  Options options;
+  options.warmupTime = 0.01;
+  options.repetitionTime = 0.001;
+  options.repetitions = 5;
+
+  uint64_t calls = 0;
+  volatile double sink = 0;
+  Result result = Measure("sqrt", [&]()
+      {
+        ++calls;
+        sink = sink + std::sqrt(static_cast<double>(calls));
+      }, options);
+
+  EXPECT_EQ("sqrt", result.name);
+  EXPECT_GT(result.iterations, 1u);
+  ASSERT_EQ(5u, result.times.size());
+  EXPECT_GT(calls, 5 * result.iterations);
+  EXPECT_GT(result.Percentile(0), 0.0);
+  EXPECT_LE(result.Percentile(0), result.Percentile(50));
+  EXPECT_LE(result.Percentile(50), result.Percentile(100));
+  EXPECT_GE(result.Mean(), result.Percentile(0));
+
+  // The counters are unavailable on some machines
+  ASSERT_EQ(result.counterNames.size(), result.counters.size());
+  PerfCounters perf;
+  if (perf.Available())
+  {
+    ASSERT_FALSE(result.counterNames.empty());
+    EXPECT_EQ("cycles", result.counterNames[0]);
+    EXPECT_GT(result.counters[0], 0.0);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(BenchmarkLibrary, WriteJson)
+{
+  Result result;
+  result.name = "a\"b";
+  result.iterations = 10;
+  result.times = {1e-6, 2e-6, 3e-6};
+  result.counterNames = {"cycles"};
+  result.counters = {1500};
+  result.metrics = {{"contacts", 12}};
+
+  std::ostringstream out;
+  WriteJson(out, "suite", {result});
+  const std::string json = out.str();
+  EXPECT_EQ(0u, json.find("{\"suite\": \"suite\", \"benchmarks\": ["));
+  EXPECT_NE(std::string::npos, json.find("\"name\": \"a\\\"b\""));
+  EXPECT_NE(std::string::npos, json.find("\"iterations\": 10"));
+  EXPECT_NE(std::string::npos, json.find("\"repetitions\": 3"));
+  EXPECT_NE(std::string::npos, json.find("\"p50\": 2e-06"));
+  EXPECT_NE(std::string::npos, json.find("\"counters\": {\"cycles\": 1500}"));
+  EXPECT_NE(std::string::npos, json.find("\"metrics\": {\"contacts\": 12}"));
+  EXPECT_NE(std::string::npos, json.find("\"p999\": 2.998e-06"));
+}
+
+/////////////////////////////////////////////////
+TEST(BenchmarkLibrary, ReporterAdd)
+{
+  Reporter reporter("suite");
+  Result result;
+  result.name = "latency";
+  result.times = {3, 1, 2};
+  Result &kept = reporter.Add(result);
+  EXPECT_EQ("latency", kept.name);
+  EXPECT_EQ(std::vector<double>({1, 2, 3}), kept.times);
+  ASSERT_EQ(1u, reporter.Results().size());
+  EXPECT_DOUBLE_EQ(2.0, reporter.Results()[0].Percentile(50));
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <string>
+#include <vector>
+
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+
+class MasterStressTest : public ServerFixture
+{
+};
+
+/////////////////////////////////////////////////
+/// \brief Get the number of subscribers of a topic known to the master.
+/// \param[in] _topic Fully scoped name of the topic.
+/// \return Number of subscribers, -1 on error.
+static int SubscriberCount(const std::string &_topic)
+{
+  transport::ConnectionPtr connection = transport::connectToMaster();
+  if (!connection)
+    return -1;
+
+  msgs::Request *request = msgs::CreateRequest("topic_info", _topic);
+  connection->EnqueueMsg(msgs::Package("request", *request), true);
+  delete request;
+
+  // Skip the notifications sent to all the connections
+  msgs::Packet packet;
+  for (int i = 0; i < 100 && packet.type() != "topic_info_response"; ++i)
+  {
+    std::string data;
+    if (!connection->Read(data))
+      return -1;
+    packet.ParseFromString(data);
+  }
+  if (packet.type() != "topic_info_response")
+    return -1;
+
+  msgs::TopicInfo info;
+  info.ParseFromString(packet.serialized_data());
+  return info.subscriber_size();
+}
+
+/////////////////////////////////////////////////
+void IntCB(ConstIntPtr &/*_msg*/)
+{
+}
+
+/////////////////////////////////////////////////
+// Advertise and subscribe to many topics, as a world with thousands of
+// sensors does at startup, and time the master.
+TEST_F(MasterStressTest, ManyTopics)
+{
+  Load("worlds/empty.world");
+
+  #ifdef USE_LOW_MEMORY_TESTS
+    const unsigned int topicCount = 2000;
+  #else
+    const unsigned int topicCount = 10000;
+  #endif
+
+  const std::string msgType = msgs::Int().GetTypeName();
+  const size_t initialCount = transport::getAdvertisedTopics(msgType).size();
+
+  transport::NodePtr pubNode(new transport::Node());
+  pubNode->Init("default");
+  transport::NodePtr subNode(new transport::Node());
+  subNode->Init("default");
+
+  // Advertise, until every topic came back from the master
+  std::vector<transport::PublisherPtr> pubs;
+  common::Time startTime = common::Time::GetWallTime();
+  for (unsigned int i = 0; i < topicCount; ++i)
+  {
+    pubs.push_back(pubNode->Advertise<msgs::Int>(
+          "~/test/master_stress/" + std::to_string(i)));
+  }
+
+  int waitCount = 0;
+  while (transport::getAdvertisedTopics(msgType).size() <
+      initialCount + topicCount && ++waitCount < 6000)
+  {
+    common::Time::MSleep(10);
+  }
+  const common::Time advertiseTime = common::Time::GetWallTime() - startTime;
+  EXPECT_EQ(initialCount + topicCount,
+      transport::getAdvertisedTopics(msgType).size());
+
+  // Subscribe, until the master knows the subscriber of the last topic,
+  // as it processes the messages in order
+  std::vector<transport::SubscriberPtr> subs;
+  startTime = common::Time::GetWallTime();
+  for (unsigned int i = 0; i < topicCount; ++i)
+  {
+    subs.push_back(subNode->Subscribe(
+          "~/test/master_stress/" + std::to_string(i), &IntCB));
+  }
+
+  const std::string lastTopic = "/gazebo/default/test/master_stress/" +
+    std::to_string(topicCount - 1);
+  waitCount = 0;
+  while (SubscriberCount(lastTopic) < 1 && ++waitCount < 600)
+    common::Time::MSleep(100);
+  const common::Time subscribeTime = common::Time::GetWallTime() - startTime;
+  EXPECT_EQ(1, SubscriberCount(lastTopic));
+
+  // Out the times for human testing purposes
+  gzmsg << "Time to advertise " << topicCount << " topics = "
+    << advertiseTime << "\n";
+  gzmsg << "Time to subscribe to " << topicCount << " topics = "
+    << subscribeTime << "\n";
+
+  // Both are expected to take well under a second per thousand topics
+  EXPECT_LT(advertiseTime.Double(), topicCount * 0.001);
+  EXPECT_LT(subscribeTime.Double(), topicCount * 0.001);
+
+  subs.clear();
+  pubs.clear();
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "gazebo/physics/physics.hh"
+#include "gazebo/physics/WorldBatch.hh"
+#include "gazebo/test/ServerFixture.hh"
+#include "BenchmarkLibrary.hh"
+
+using namespace gazebo;
+
+class WorldBenchmark : public ServerFixture {};
+
+/////////////////////////////////////////////////
+// Steady state cost of the world update and of its data structures. Set
+// GAZEBO_BENCHMARK_DIR to write the results to world.json.
+TEST_F(WorldBenchmark, Shapes)
+{
+  Load("worlds/shapes.world", true);
+
+  // A copy of the world that doesn't run in its own thread, so that it can
+  // be stepped by the benchmark without waiting for the world thread.
+  auto worlds = physics::WorldBatch::CreateWorlds(
+      physics::get_world("default")->SDF(), 1);
+  ASSERT_EQ(1u, worlds.size());
+  physics::WorldPtr world = worlds[0];
+
+  physics::ModelPtr box = world->ModelByName("box");
+  ASSERT_TRUE(box != NULL);
+
+  test::benchmark::Reporter reporter("world");
+
+  auto const &step = reporter.Measure("shapes/World::Advance", [&world]()
+      {
+        world->Advance(1);
+      });
+  EXPECT_GT(step.Percentile(50), 0.0);
+
+  const ignition::math::Pose3d pose(1, 2, 0.5, 0, 0, 0);
+  reporter.Measure("shapes/Model::SetWorldPose", [&box, &pose]()
+      {
+        box->SetWorldPose(pose);
+      });
+
+  reporter.Measure("shapes/WorldState", [&world]()
+      {
+        physics::WorldState state(world);
+      });
+
+  EXPECT_EQ(3u, reporter.Results().size());
+}
+
+/////////////////////////////////////////////////
+/// Main
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
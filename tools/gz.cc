@@ -19,6 +19,7 @@
 #include <tinyxml.h>
 #include <boost/filesystem.hpp>
 #include <boost/algorithm/string.hpp>
+#include <algorithm>
 #include <streambuf>
 
 #include <gazebo/common/common.hh>
@@ -203,6 +204,80 @@ bool Command::Run(int _argc, char **_argv)
   return result;
 }
 
+/////////////////////////////////////////////////
+/// \brief Mutex of the statistics breakdown received by WaitForBreakdown.
+static boost::mutex g_breakdownMutex;
+
+/// \brief Signaled when a statistics breakdown is received.
+static boost::condition_variable g_breakdownCondition;
+
+/// \brief Statistics breakdown received, null until one is.
+static ConstWorldStatisticsBreakdownPtr g_breakdown;
+
+/////////////////////////////////////////////////
+/// \brief Callback for the statistics breakdown.
+/// \param[in] _msg The breakdown.
+static void OnBreakdown(ConstWorldStatisticsBreakdownPtr &_msg)
+{
+  boost::mutex::scoped_lock lock(g_breakdownMutex);
+  g_breakdown = _msg;
+  g_breakdownCondition.notify_all();
+}
+
+/////////////////////////////////////////////////
+/// \brief Wait for the next statistics breakdown of a world, which is
+/// published once per second.
+/// \param[in] _node Node of the world.
+/// \return The breakdown, null if none was received in time.
+static ConstWorldStatisticsBreakdownPtr WaitForBreakdown(
+    transport::NodePtr _node)
+{
+  transport::SubscriberPtr sub =
+    _node->Subscribe("~/world_stats/breakdown", &OnBreakdown);
+
+  boost::mutex::scoped_lock lock(g_breakdownMutex);
+  g_breakdown.reset();
+  const auto deadline = boost::get_system_time() +
+    boost::posix_time::seconds(10);
+  while (!g_breakdown)
+  {
+    if (!g_breakdownCondition.timed_wait(lock, deadline))
+      break;
+  }
+  if (!g_breakdown)
+    std::cerr << "No statistics breakdown received from the world\n";
+  return g_breakdown;
+}
+
+/////////////////////////////////////////////////
+/// \brief Print the costs charged to a model.
+/// \param[in] _cost Costs of the model.
+/// \param[in] _msg The breakdown holding the costs.
+static void PrintModelCost(
+    const msgs::WorldStatisticsBreakdown::ModelCost &_cost,
+    const msgs::WorldStatisticsBreakdown &_msg)
+{
+  const double window = std::max(1e-9,
+      msgs::Convert(_msg.window()).Double());
+  const double iterations = static_cast<double>(
+      std::max<uint64_t>(1, _msg.iterations()));
+  printf("  %s Plugin[%g] Sensor[%g] Percent[%4.2f] Contacts[%g] "
+      "SolverRows[%g]\n", _cost.name().c_str(), _cost.plugin_time(),
+      _cost.sensor_time(),
+      100.0 * (_cost.plugin_time() + _cost.sensor_time()) / window,
+      _cost.contacts() / iterations, _cost.solver_rows() / iterations);
+}
+
+/////////////////////////////////////////////////
+/// \brief Print the header of the model costs of a breakdown.
+/// \param[in] _msg The breakdown.
+static void PrintModelCostHeader(const msgs::WorldStatisticsBreakdown &_msg)
+{
+  printf("Window[%4.2f] Iterations[%llu]\n",
+      msgs::Convert(_msg.window()).Double(),
+      static_cast<unsigned long long>(_msg.iterations()));
+}
+
 /////////////////////////////////////////////////
 WorldCommand::WorldCommand()
   : Command("world", "Modify world properties")
@@ -217,7 +292,10 @@ WorldCommand::WorldCommand()
      "Step simulation mulitple iteration.")
     ("reset-all,r", "Reset time and model poses")
     ("reset-time,t", "Reset time")
-    ("reset-models,o", "Reset models");
+    ("reset-models,o", "Reset models")
+    ("top,T", po::value<unsigned int>()->implicit_value(10),
+     "Print the models that cost the most over the last seconds, 10 by "
+     "default.");
 }
 
 /////////////////////////////////////////////////
@@ -227,6 +305,11 @@ void WorldCommand::HelpDetailed()
     "\tChange properties of a Gazebo world on a running\n "
     "\tserver. If a name for the world, option -w, is not specified\n"
     "\tthe first world found on the Gazebo master will be used.\n"
+    "\n"
+    "\tWith option -T, the models are ranked by the real time spent in\n"
+    "\tthe event callbacks of their plugins and in the updates of their\n"
+    "\tsensors over the last seconds, then by their solver rows. See\n"
+    "\tgz help model for the costs printed.\n"
     << std::endl;
 }
 
@@ -241,6 +324,34 @@ bool WorldCommand::RunImpl()
   transport::NodePtr node(new transport::Node());
   node->Init(worldName);
 
+  if (this->vm.count("top"))
+  {
+    ConstWorldStatisticsBreakdownPtr breakdown = WaitForBreakdown(node);
+    if (!breakdown)
+      return false;
+
+    std::vector<const msgs::WorldStatisticsBreakdown::ModelCost *> models;
+    for (auto const &model : breakdown->model())
+      models.push_back(&model);
+    std::sort(models.begin(), models.end(),
+        [](const msgs::WorldStatisticsBreakdown::ModelCost *_a,
+           const msgs::WorldStatisticsBreakdown::ModelCost *_b)
+        {
+          const double a = _a->plugin_time() + _a->sensor_time();
+          const double b = _b->plugin_time() + _b->sensor_time();
+          if (a != b)
+            return a > b;
+          return _a->solver_rows() > _b->solver_rows();
+        });
+    if (models.size() > this->vm["top"].as<unsigned int>())
+      models.resize(this->vm["top"].as<unsigned int>());
+
+    PrintModelCostHeader(*breakdown);
+    for (auto const &model : models)
+      PrintModelCost(*model, *breakdown);
+    return true;
+  }
+
   transport::PublisherPtr pub =
     node->Advertise<msgs::WorldControl>("~/world_control");
   pub->WaitForConnection();
@@ -392,6 +503,8 @@ ModelCommand::ModelCommand()
     ("spawn-file,f", po::value<std::string>(), "Spawn model from SDF file.")
     ("spawn-string,s", "Spawn model from SDF string, pass by a pipe.")
     ("info,i", "Output model state information to the terminal.")
+    ("cost,c", "Output the costs charged to the model over the last "
+     "seconds.")
     ("pose,p",
      "Output model pose as a space separated 6-tuple: x y z roll pitch yaw.")
     ("pose-x,x", po::value<double>(), "x value")
@@ -410,6 +523,14 @@ void ModelCommand::HelpDetailed()
     "\tspawn a new model. If a name for the world, option -w, is\n"
     "\tnot pecified, the first world found on the Gazebo master\n"
     "\twill be used.\n"
+    "\n"
+    "\tWith option -c, the costs charged to the model, without its\n"
+    "\tnested models, over the last seconds are printed: the real time\n"
+    "\tspent in the event callbacks of its plugins and in the updates of\n"
+    "\tits sensors, in seconds and as a percentage of the real time,\n"
+    "\tand the contact points and estimated solver constraint rows of\n"
+    "\tits collisions and joints per iteration. Contacts are only\n"
+    "\tcounted by the ODE physics engine.\n"
     << std::endl;
 }
 
@@ -531,6 +652,22 @@ bool ModelCommand::RunImpl()
 
     return this->ProcessSpawn(sdfString, modelName, pose, node);
   }
+  else if (this->vm.count("cost"))
+  {
+    ConstWorldStatisticsBreakdownPtr breakdown = WaitForBreakdown(node);
+    if (!breakdown)
+      return false;
+
+    PrintModelCostHeader(*breakdown);
+    msgs::WorldStatisticsBreakdown::ModelCost cost;
+    cost.set_name(modelName);
+    for (auto const &model : breakdown->model())
+    {
+      if (model.name() == modelName)
+        cost = model;
+    }
+    PrintModelCost(cost, *breakdown);
+  }
   else if (this->vm.count("info") || this->vm.count("pose"))
   {
     boost::shared_ptr<msgs::Response> response = gazebo::transport::request(
@@ -901,7 +1038,12 @@ StatsCommand::StatsCommand()
     ("world-name,w", po::value<std::string>(), "World name.")
     ("duration,d", po::value<uint64_t>(), "Duration (seconds) to run.")
     ("plot,p", "Output comma-separated values, useful for processing and "
-     "plotting.");
+     "plotting.")
+    ("sensors,s", "Print the update cost and latency histograms of each "
+     "sensor instead of the world statistics.")
+    ("breakdown,b", "Print the real time spent in each phase of the world "
+     "steps, and by each plugin and sensor container, instead of the world "
+     "statistics.");
 }
 
 /////////////////////////////////////////////////
@@ -911,6 +1053,16 @@ void StatsCommand::HelpDetailed()
     "\tPrint gzserver statics to standard out. If a name for the world, \n"
     "\toption -w, is not specified, the first world found on \n"
     "\tthe Gazebo master will be used.\n"
+    "\n"
+    "\tWith option -s, the real time spent in each stage of the sensor\n"
+    "\tupdates (update, render, readback, noise, publish) and the sim\n"
+    "\ttime from measurement to publication (latency) are printed for\n"
+    "\teach sensor, in seconds.\n"
+    "\n"
+    "\tWith option -b, the real time spent in each phase of the world\n"
+    "\tsteps, in the event callbacks of each plugin and in each sensor\n"
+    "\tcontainer over the last seconds is printed, per iteration and as\n"
+    "\ta percentage of the real time.\n"
     << std::endl;
 }
 
@@ -925,8 +1077,19 @@ bool StatsCommand::RunImpl()
   transport::NodePtr node(new transport::Node());
   node->Init(worldName);
 
-  transport::SubscriberPtr sub =
-    node->Subscribe("~/world_stats", &StatsCommand::CB, this);
+  transport::SubscriberPtr sub;
+  if (this->vm.count("sensors"))
+  {
+    sub = node->Subscribe("/gazebo/performance_metrics",
+        &StatsCommand::SensorsCB, this);
+  }
+  else if (this->vm.count("breakdown"))
+  {
+    sub = node->Subscribe("~/world_stats/breakdown",
+        &StatsCommand::BreakdownCB, this);
+  }
+  else
+    sub = node->Subscribe("~/world_stats", &StatsCommand::CB, this);
 
   boost::mutex::scoped_lock lock(this->sigMutex);
   if (this->vm.count("duration"))
@@ -1003,6 +1166,111 @@ void StatsCommand::CB(ConstWorldStatisticsPtr &_msg)
         percent, simTime.Double(), realTime.Double(), paused);
 }
 
+/////////////////////////////////////////////////
+/// \brief Estimate a quantile of a performance metrics histogram.
+/// \param[in] _msg The histogram.
+/// \param[in] _q Quantile, between 0 and 1.
+/// \return Upper bound of the bin holding the quantile, capped by the
+/// largest value.
+static double HistogramQuantile(const msgs::PerformanceMetrics::Histogram &_msg,
+    const double _q)
+{
+  const double rank = _q * _msg.count();
+  uint64_t count = 0;
+  for (int i = 0; i < _msg.bin_count_size() && i < _msg.upper_bound_size();
+      ++i)
+  {
+    count += _msg.bin_count(i);
+    if (count > 0 && count >= rank)
+      return std::min(_msg.upper_bound(i), _msg.max());
+  }
+  return _msg.max();
+}
+
+/////////////////////////////////////////////////
+void StatsCommand::SensorsCB(ConstPerformanceMetricsPtr &_msg)
+{
+  GZ_ASSERT(_msg, "Invalid message received");
+
+  static bool first = true;
+  if (first && this->vm.count("plot"))
+  {
+    std::cout << "# sensor, stage, count, mean (sec), p50 (sec), "
+      << "p90 (sec), p99 (sec), max (sec)\n";
+  }
+  first = false;
+
+  for (auto const &sensor : _msg->sensor())
+  {
+    for (auto const &histogram : sensor.histogram())
+    {
+      const double mean = histogram.count() > 0 ?
+        histogram.sum() / histogram.count() : 0.0;
+      const char *format = this->vm.count("plot") ?
+        "%s, %s, %llu, %g, %g, %g, %g, %g\n" :
+        "Sensor[%s] Stage[%s] Count[%llu] Mean[%g] P50[%g] P90[%g] "
+        "P99[%g] Max[%g]\n";
+      printf(format, sensor.name().c_str(), histogram.name().c_str(),
+          static_cast<unsigned long long>(histogram.count()), mean,
+          HistogramQuantile(histogram, 0.5),
+          HistogramQuantile(histogram, 0.9),
+          HistogramQuantile(histogram, 0.99), histogram.max());
+    }
+  }
+  fflush(stdout);
+}
+
+/////////////////////////////////////////////////
+void StatsCommand::BreakdownCB(ConstWorldStatisticsBreakdownPtr &_msg)
+{
+  GZ_ASSERT(_msg, "Invalid message received");
+
+  const double window = msgs::Convert(_msg->window()).Double();
+  if (window <= 0)
+    return;
+  const double iterations = static_cast<double>(
+      std::max<uint64_t>(1, _msg->iterations()));
+
+  static bool first = true;
+  if (first && this->vm.count("plot"))
+  {
+    std::cout << "# group, name, count, time (sec), time per iteration "
+      << "(sec), real time (percent)\n";
+  }
+  first = false;
+
+  if (!this->vm.count("plot"))
+  {
+    printf("Window[%4.2f] Iterations[%llu]\n", window,
+        static_cast<unsigned long long>(_msg->iterations()));
+  }
+
+  auto print = [&](const char *_group,
+      const google::protobuf::RepeatedPtrField<
+        msgs::WorldStatisticsBreakdown::Cost> &_costs)
+  {
+    for (auto const &cost : _costs)
+    {
+      const char *format = this->vm.count("plot") ?
+        "%s, %s, %llu, %g, %g, %4.2f\n" :
+        "  %s[%s] Count[%llu] Time[%g] PerIteration[%g] Percent[%4.2f]\n";
+      printf(format, _group, cost.name().c_str(),
+          static_cast<unsigned long long>(cost.count()), cost.time(),
+          cost.time() / iterations, 100.0 * cost.time() / window);
+      if (cost.has_allocations() && !this->vm.count("plot"))
+      {
+        printf("    Allocations[%g] Bytes[%g] per iteration\n",
+            cost.allocations() / iterations,
+            cost.allocation_bytes() / iterations);
+      }
+    }
+  };
+  print("Phase", _msg->phase());
+  print("Plugin", _msg->plugin());
+  print("Sensor", _msg->sensor());
+  fflush(stdout);
+}
+
 /////////////////////////////////////////////////
 SDFCommand::SDFCommand()
   : Command("sdf",
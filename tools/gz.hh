@@ -195,6 +195,14 @@ namespace gazebo
     /// \param[in] _msg World statistics message.
     private: void CB(ConstWorldStatisticsPtr &_msg);
 
+    /// \brief Performance metrics callback.
+    /// \param[in] _msg Performance metrics message.
+    private: void SensorsCB(ConstPerformanceMetricsPtr &_msg);
+
+    /// \brief World statistics breakdown callback.
+    /// \param[in] _msg Cost breakdown message.
+    private: void BreakdownCB(ConstWorldStatisticsBreakdownPtr &_msg);
+
     /// \brief Sim time buffer
     private: std::list<common::Time> simTimes;
 
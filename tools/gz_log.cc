@@ -14,17 +14,26 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <iomanip>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
 #include <boost/algorithm/string.hpp>
+#include <boost/filesystem.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <boost/date_time/posix_time/posix_time_io.hpp>
-#include <boost/iostreams/filter/bzip2.hpp>
-#include <boost/iostreams/filter/zlib.hpp>
-#include <boost/iostreams/filtering_stream.hpp>
-#include <boost/iostreams/copy.hpp>
 
 #include <ignition/math/Pose3.hh>
 #include <ignition/math/Vector3.hh>
 
+#include <gazebo/physics/StateHasher.hh>
 #include <gazebo/util/util.hh>
 #include "gz_log.hh"
 
@@ -32,6 +41,34 @@ sdf::ElementPtr g_stateSdf;
 
 using namespace gazebo;
 
+/////////////////////////////////////////////////
+void NameFilter::Init(const std::string &_pattern)
+{
+  this->matches.clear();
+  this->all = _pattern.empty() || _pattern == "*";
+  if (!this->all)
+  {
+    std::string regexStr = _pattern;
+    boost::replace_all(regexStr, "*", ".*");
+    this->regex = boost::regex(regexStr);
+  }
+}
+
+/////////////////////////////////////////////////
+bool NameFilter::Match(const std::string &_name)
+{
+  if (this->all)
+    return true;
+
+  auto iter = this->matches.find(_name);
+  if (iter == this->matches.end())
+  {
+    iter = this->matches.emplace(_name,
+        boost::regex_match(_name, this->regex)).first;
+  }
+  return iter->second;
+}
+
 /////////////////////////////////////////////////
 FilterBase::FilterBase(bool _xmlOutput, const std::string &_stamp)
 : xmlOutput(_xmlOutput), stamp(_stamp)
@@ -168,10 +205,14 @@ void JointFilter::Init(const std::string &_filter)
     if (this->parts.empty())
       this->parts.push_back(_filter);
   }
+
+  // The first element in the filter must be a joint name or a star.
+  this->names.Init(this->parts.empty() ? "" : this->parts.front());
 }
 
 /////////////////////////////////////////////////
-std::string JointFilter::FilterParts(gazebo::physics::JointState &_state,
+std::string JointFilter::FilterParts(
+    const gazebo::physics::JointState &_state,
               std::list<std::string>::iterator _partIter)
 {
   std::ostringstream result;
@@ -224,28 +265,21 @@ std::string JointFilter::FilterParts(gazebo::physics::JointState &_state,
 }
 
 /////////////////////////////////////////////////
-std::string JointFilter::Filter(gazebo::physics::ModelState &_state)
+std::string JointFilter::Filter(const gazebo::physics::ModelState &_state)
 {
   std::ostringstream result;
 
-  gazebo::physics::JointState_M states;
-  std::list<std::string>::iterator partIter;
-
   /// Get an iterator to the list of the command line parts.
-  partIter = this->parts.begin();
-
-  // The first element in the filter must be a link name or a star.
-  std::string regexStr = *partIter;
-  boost::replace_all(regexStr, "*", ".*");
-  boost::regex regex(regexStr);
-  states = _state.GetJointStates(regex);
-
+  std::list<std::string>::iterator partIter = this->parts.begin();
   ++partIter;
 
-  // Filter all the link states that were found.
-  for (gazebo::physics::JointState_M::iterator iter =
-      states.begin(); iter != states.end(); ++iter)
+  // Filter all the joint states that match.
+  for (auto iter = _state.GetJointStates().begin();
+      iter != _state.GetJointStates().end(); ++iter)
   {
+    if (!this->names.Match(iter->first))
+      continue;
+
     // Filter the elements of the joint (angle).
     // If no filter parts were specified,
     // then output the whole joint state.
@@ -289,10 +323,13 @@ void LinkFilter::Init(const std::string &_filter)
     if (this->parts.empty())
       this->parts.push_back(_filter);
   }
+
+  // The first element in the filter must be a link name or a star.
+  this->names.Init(this->parts.empty() ? "" : this->parts.front());
 }
 
 /////////////////////////////////////////////////
-std::string LinkFilter::FilterParts(gazebo::physics::LinkState &_state,
+std::string LinkFilter::FilterParts(const gazebo::physics::LinkState &_state,
               std::list<std::string>::iterator _partIter)
 {
   std::ostringstream result;
@@ -328,33 +365,21 @@ std::string LinkFilter::FilterParts(gazebo::physics::LinkState &_state,
 }
 
 /////////////////////////////////////////////////
-std::string LinkFilter::Filter(gazebo::physics::ModelState &_state)
+std::string LinkFilter::Filter(const gazebo::physics::ModelState &_state)
 {
   std::ostringstream result;
 
-  gazebo::physics::LinkState_M states;
-  std::list<std::string>::iterator partIter;
-
   /// Get an iterator to the list of the command line parts.
-  partIter = this->parts.begin();
-
-  // The first element in the filter must be a link name or a star.
-  if (*partIter != "*")
-  {
-    std::string regexStr = *partIter;
-    boost::replace_all(regexStr, "*", ".*");
-    boost::regex regex(regexStr);
-    states = _state.GetLinkStates(regex);
-  }
-  else
-    states = _state.GetLinkStates();
-
+  std::list<std::string>::iterator partIter = this->parts.begin();
   ++partIter;
 
-  // Filter all the link states that were found.
-  for (gazebo::physics::LinkState_M::iterator iter =
-      states.begin(); iter != states.end(); ++iter)
+  // Filter all the link states that match.
+  for (auto iter = _state.GetLinkStates().begin();
+      iter != _state.GetLinkStates().end(); ++iter)
   {
+    if (!this->names.Match(iter->first))
+      continue;
+
     // Filter the elements of the link (pose, velocity,
     // acceleration, wrench). If no filter parts were specified,
     // then output the whole link state.
@@ -397,6 +422,7 @@ void ModelFilter::Init(const std::string &_filter)
   this->jointFilter = NULL;
   this->parts.clear();
 
+  this->names.Init("");
   if (_filter.empty())
     return;
 
@@ -412,6 +438,10 @@ void ModelFilter::Init(const std::string &_filter)
       this->parts.push_back(mainParts.front());
   }
 
+  // The first element in the filter must be a model name or a star.
+  if (!this->parts.empty())
+    this->names.Init(this->parts.front());
+
   if (mainParts.empty())
     return;
 
@@ -439,7 +469,8 @@ void ModelFilter::Init(const std::string &_filter)
 }
 
 /////////////////////////////////////////////////
-std::string ModelFilter::FilterParts(gazebo::physics::ModelState &_state,
+std::string ModelFilter::FilterParts(
+    const gazebo::physics::ModelState &_state,
               std::list<std::string>::iterator _partIter)
 {
   std::ostringstream result;
@@ -467,31 +498,21 @@ std::string ModelFilter::FilterParts(gazebo::physics::ModelState &_state,
 }
 
 /////////////////////////////////////////////////
-std::string ModelFilter::Filter(gazebo::physics::WorldState &_state)
+std::string ModelFilter::Filter(const gazebo::physics::WorldState &_state)
 {
   std::ostringstream result;
 
-  gazebo::physics::ModelState_M states;
   std::list<std::string>::iterator partIter = this->parts.begin();
+  if (partIter != this->parts.end())
+    ++partIter;
 
-  // The first element in the filter must be a model name or a star.
-  if (partIter != this->parts.end() && !this->parts.empty() &&
-      !(*partIter).empty() && (*partIter) != "*")
+  // Filter all the model states that match.
+  for (auto iter = _state.GetModelStates().begin();
+      iter != _state.GetModelStates().end(); ++iter)
   {
-    std::string regexStr = *partIter;
-    boost::replace_all(regexStr, "*", ".*");
-    boost::regex regex(regexStr);
-    states = _state.GetModelStates(regex);
-  }
-  else
-    states = _state.GetModelStates();
+    if (!this->names.Match(iter->first))
+      continue;
 
-  ++partIter;
-
-  // Filter all the model states that were found.
-  for (gazebo::physics::ModelState_M::iterator iter =
-      states.begin(); iter != states.end(); ++iter)
-  {
     // If no link filter, and no model parts, then output the
     // whole model state.
     if (!this->linkFilter && !this->jointFilter &&
@@ -527,7 +548,10 @@ StateFilter::StateFilter(bool _xmlOutput, const std::string &_stamp,
               double _hz)
 : FilterBase(_xmlOutput, _stamp), filter(_xmlOutput, _stamp),
   hz(_hz)
-{}
+{
+  this->stateSdf.reset(new sdf::Element);
+  sdf::initFile("state.sdf", this->stateSdf);
+}
 
 /////////////////////////////////////////////////
 void StateFilter::Init(const std::string &_filter)
@@ -536,36 +560,55 @@ void StateFilter::Init(const std::string &_filter)
 }
 
 /////////////////////////////////////////////////
-std::string StateFilter::Filter(const std::string &_stateString)
+void StateFilter::Parse(const std::string &_stateString,
+    gazebo::physics::WorldState &_state)
 {
-  gazebo::physics::WorldState state;
-
   // Read and parse the state information
-  g_stateSdf->Clear();
-  sdf::readString(_stateString, g_stateSdf);
-  state.Load(g_stateSdf);
-
-  std::ostringstream result;
+  this->stateSdf->Clear();
+  sdf::readString(_stateString, this->stateSdf);
+  _state.Load(this->stateSdf);
+}
 
+/////////////////////////////////////////////////
+bool StateFilter::Skip(const gazebo::common::Time &_time)
+{
   if (this->hz > 0.0 && this->prevTime != gazebo::common::Time::Zero)
   {
-    if ((state.GetSimTime() - this->prevTime).Double() <
-        1.0 / this->hz)
-    {
-      return result.str();
-    }
+    if ((_time - this->prevTime).Double() < 1.0 / this->hz)
+      return true;
   }
 
+  this->prevTime = _time;
+  return false;
+}
+
+/////////////////////////////////////////////////
+std::string StateFilter::Filter(const std::string &_stateString)
+{
+  gazebo::physics::WorldState state;
+  this->Parse(_stateString, state);
+
+  if (this->Skip(state.GetSimTime()))
+    return std::string();
+
+  return this->Filter(state);
+}
+
+/////////////////////////////////////////////////
+std::string StateFilter::Filter(const gazebo::physics::WorldState &_state)
+{
+  std::ostringstream result;
+
   if (this->xmlOutput)
   {
     result << "<sdf version='" << SDF_VERSION << "'>\n"
-      << "<state world_name='" << state.GetName() << "'>\n"
-      << "<sim_time>" << state.GetSimTime() << "</sim_time>\n"
-      << "<real_time>" << state.GetRealTime() << "</real_time>\n"
-      << "<wall_time>" << state.GetWallTime() << "</wall_time>\n"
-      << "<iterations>" << state.GetIterations() << "</iterations>\n";
+      << "<state world_name='" << _state.GetName() << "'>\n"
+      << "<sim_time>" << _state.GetSimTime() << "</sim_time>\n"
+      << "<real_time>" << _state.GetRealTime() << "</real_time>\n"
+      << "<wall_time>" << _state.GetWallTime() << "</wall_time>\n"
+      << "<iterations>" << _state.GetIterations() << "</iterations>\n";
 
-    auto insertions = state.Insertions();
+    auto insertions = _state.Insertions();
     if (insertions.size() > 0)
       result << "<insertions>" << std::endl;
     for (auto insertion : insertions)
@@ -573,7 +616,7 @@ std::string StateFilter::Filter(const std::string &_stateString)
     if (insertions.size() > 0)
       result << "</insertions>" << std::endl;
 
-    auto deletions = state.Deletions();
+    auto deletions = _state.Deletions();
     if (deletions.size() > 0)
       result << "<deletions>" << std::endl;
     for (auto deletion : deletions)
@@ -587,10 +630,361 @@ std::string StateFilter::Filter(const std::string &_stateString)
   if (this->xmlOutput)
     result << "</state></sdf>\n";
 
-  this->prevTime = state.GetSimTime();
   return result.str();
 }
 
+/// \brief Output of a state processed by ProcessStates.
+class StateOutput
+{
+  /// \brief Simulation time of the state.
+  public: gazebo::common::Time time;
+
+  /// \brief Output of the state, one string per table for an export.
+  public: std::vector<std::string> outputs;
+};
+
+/// \brief Process the states of the open log file, from the current
+/// position to the end of the file, on worker threads. The states are read
+/// in batches, which the workers process while the next batches are read
+/// and the previous ones are consumed.
+/// \param[in] _threads Number of worker threads, at least 1.
+/// \param[in] _process Function called by a worker, given its index, to
+/// process a state.
+/// \param[in] _consume Function called with the output of each state, in
+/// the order of the states.
+static void ProcessStates(const unsigned int _threads,
+    const std::function<void (const unsigned int, const std::string &,
+      StateOutput &)> &_process,
+    const std::function<void (const StateOutput &)> &_consume)
+{
+  const size_t kBatchSize = 256;
+
+  // States being processed, with their output.
+  struct Batch
+  {
+    std::vector<std::string> states;
+    std::vector<StateOutput> outputs;
+    bool done = false;
+  };
+
+  std::mutex mutex;
+  std::condition_variable workCondition;
+  std::condition_variable doneCondition;
+
+  // Batches not consumed yet, in order, and batches not processed yet.
+  std::deque<std::shared_ptr<Batch>> pending;
+  std::deque<std::shared_ptr<Batch>> work;
+  bool reading = true;
+
+  std::vector<std::thread> workers;
+  for (unsigned int w = 0; w < _threads; ++w)
+  {
+    workers.emplace_back([&, w]()
+        {
+          std::unique_lock<std::mutex> lock(mutex);
+          while (true)
+          {
+            workCondition.wait(lock, [&]()
+                {
+                  return !work.empty() || !reading;
+                });
+            if (work.empty())
+              return;
+
+            auto batch = work.front();
+            work.pop_front();
+            lock.unlock();
+
+            batch->outputs.resize(batch->states.size());
+            for (size_t i = 0; i < batch->states.size(); ++i)
+              _process(w, batch->states[i], batch->outputs[i]);
+            std::vector<std::string>().swap(batch->states);
+
+            lock.lock();
+            batch->done = true;
+            doneCondition.notify_all();
+          }
+        });
+  }
+
+  gazebo::util::LogPlay *play = gazebo::util::LogPlay::Instance();
+  const size_t maxPending = 2 * _threads;
+  std::string stateString;
+  bool more = true;
+  while (true)
+  {
+    // Read batches ahead of the consumer.
+    while (more && pending.size() < maxPending)
+    {
+      auto batch = std::make_shared<Batch>();
+      batch->states.reserve(kBatchSize);
+      while (batch->states.size() < kBatchSize &&
+             (more = play->Step(stateString)))
+      {
+        batch->states.push_back(stateString);
+      }
+
+      std::lock_guard<std::mutex> lock(mutex);
+      if (!batch->states.empty())
+      {
+        pending.push_back(batch);
+        work.push_back(batch);
+        workCondition.notify_one();
+      }
+      if (!more)
+      {
+        reading = false;
+        workCondition.notify_all();
+      }
+    }
+
+    // Consume the oldest batch once it is processed.
+    std::shared_ptr<Batch> batch;
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      if (pending.empty())
+        break;
+      doneCondition.wait(lock, [&]()
+          {
+            return pending.front()->done;
+          });
+      batch = pending.front();
+      pending.pop_front();
+    }
+
+    for (auto const &output : batch->outputs)
+      _consume(output);
+  }
+
+  for (auto &worker : workers)
+    worker.join();
+}
+
+/////////////////////////////////////////////////
+StreamFilter::StreamFilter(bool _xmlOutput, const std::string &_stamp,
+    double _hz, const std::string &_filter, unsigned int _threads)
+  : xmlOutput(_xmlOutput), stamp(_stamp), hz(_hz), filter(_filter),
+    threads(_threads)
+{
+}
+
+/////////////////////////////////////////////////
+void StreamFilter::Run(
+    const std::function<void (const std::string &)> &_write)
+{
+  // The output rate depends on the states output before, it is applied in
+  // order.
+  StateFilter rate(this->xmlOutput, this->stamp, this->hz);
+  rate.Init(this->filter);
+
+  if (this->threads == 0)
+  {
+    std::string stateString;
+    while (gazebo::util::LogPlay::Instance()->Step(stateString))
+    {
+      std::string output = rate.Filter(stateString);
+      if (!output.empty())
+        _write(output);
+    }
+    return;
+  }
+
+  // Each worker has its own filter, which caches the names it matched,
+  // and its own state element. The filters are made here since loading
+  // the SDF description is not thread safe.
+  std::vector<std::unique_ptr<StateFilter>> filters;
+  for (unsigned int i = 0; i < this->threads; ++i)
+  {
+    filters.emplace_back(new StateFilter(this->xmlOutput, this->stamp));
+    filters.back()->Init(this->filter);
+  }
+
+  ProcessStates(this->threads,
+      [&filters](const unsigned int _worker, const std::string &_stateString,
+        StateOutput &_output)
+      {
+        gazebo::physics::WorldState state;
+        filters[_worker]->Parse(_stateString, state);
+        _output.time = state.GetSimTime();
+        _output.outputs.push_back(filters[_worker]->Filter(state));
+      },
+      [&](const StateOutput &_output)
+      {
+        if (!rate.Skip(_output.time) && !_output.outputs[0].empty())
+          _write(_output.outputs[0]);
+      });
+}
+
+/// \brief Entity names exported by a LogExporter worker.
+class ExportSelection
+{
+  /// \brief Model names.
+  public: NameFilter models;
+
+  /// \brief Link names.
+  public: NameFilter links;
+
+  /// \brief Joint names.
+  public: NameFilter joints;
+};
+
+/// \brief Stream a pose as x,y,z,qw,qx,qy,qz columns.
+/// \param[in] _out The stream.
+/// \param[in] _pose The pose.
+static void ExportPose(std::ostream &_out,
+    const ignition::math::Pose3d &_pose)
+{
+  _out << ',' << _pose.Pos().X() << ',' << _pose.Pos().Y()
+    << ',' << _pose.Pos().Z() << ',' << _pose.Rot().W()
+    << ',' << _pose.Rot().X() << ',' << _pose.Rot().Y()
+    << ',' << _pose.Rot().Z();
+}
+
+/// \brief Add the rows of a model state, and of its nested models, to the
+/// tables of an export.
+/// \param[in] _state The model state.
+/// \param[in] _name Scoped name of the model.
+/// \param[in] _time Simulation time column.
+/// \param[in] _selection Exported names.
+/// \param[out] _tables Streams of the model, link and joint tables.
+static void ExportModel(const gazebo::physics::ModelState &_state,
+    const std::string &_name, const std::string &_time,
+    ExportSelection &_selection, std::vector<std::ostringstream> &_tables)
+{
+  _tables[0] << _time << ',' << _name;
+  ExportPose(_tables[0], _state.Pose());
+  _tables[0] << '\n';
+
+  for (auto const &link : _state.GetLinkStates())
+  {
+    if (!_selection.links.Match(link.first))
+      continue;
+
+    // The angular velocity is stored as Euler angles.
+    const ignition::math::Pose3d &vel = link.second.Velocity();
+    const ignition::math::Vector3d angular = vel.Rot().Euler();
+    _tables[1] << _time << ',' << _name << "::" << link.first;
+    ExportPose(_tables[1], link.second.Pose());
+    _tables[1] << ',' << vel.Pos().X() << ',' << vel.Pos().Y()
+      << ',' << vel.Pos().Z() << ',' << angular.X()
+      << ',' << angular.Y() << ',' << angular.Z() << '\n';
+  }
+
+  for (auto const &joint : _state.GetJointStates())
+  {
+    if (!_selection.joints.Match(joint.first))
+      continue;
+
+    for (unsigned int axis = 0; axis < joint.second.GetAngleCount(); ++axis)
+    {
+      _tables[2] << _time << ',' << _name << "::" << joint.first
+        << ',' << axis << ',' << joint.second.Position(axis) << '\n';
+    }
+  }
+
+  for (auto const &nested : _state.NestedModelStates())
+  {
+    ExportModel(nested.second, _name + "::" + nested.first, _time,
+        _selection, _tables);
+  }
+}
+
+/////////////////////////////////////////////////
+LogExporter::LogExporter(const std::string &_filter, unsigned int _threads)
+  : threads(std::max(1u, _threads))
+{
+  // Keep the name of each part of model/link/joint, without the state
+  // components that follow a '.'.
+  std::vector<std::string> parts;
+  boost::split(parts, _filter, boost::is_any_of("/"));
+  for (auto &part : parts)
+    part = part.substr(0, part.find('.'));
+
+  this->models = parts.size() > 0 ? parts[0] : "";
+  this->links = parts.size() > 1 ? parts[1] : "";
+  this->joints = parts.size() > 2 ? parts[2] : "";
+}
+
+/////////////////////////////////////////////////
+bool LogExporter::Export(const std::string &_path)
+{
+  const std::vector<std::string> names = {"models", "links", "joints"};
+  const std::vector<std::string> headers = {
+    "sim_time,model,x,y,z,qw,qx,qy,qz",
+    "sim_time,link,x,y,z,qw,qx,qy,qz,vx,vy,vz,wx,wy,wz",
+    "sim_time,joint,axis,position"};
+
+  boost::system::error_code ec;
+  boost::filesystem::create_directories(_path, ec);
+
+  std::vector<std::ofstream> files;
+  for (size_t i = 0; i < names.size(); ++i)
+  {
+    const std::string filename =
+      (boost::filesystem::path(_path) / (names[i] + ".csv")).string();
+    files.emplace_back(filename, std::ios::out | std::ios::binary);
+    if (!files.back().is_open())
+    {
+      std::cerr << "Unable to open file[" << filename << "] for writing.\n";
+      return false;
+    }
+    files.back() << headers[i] << '\n';
+  }
+
+  // Each worker has its own state element and name caches.
+  std::vector<std::unique_ptr<StateFilter>> parsers;
+  std::vector<ExportSelection> selections(this->threads);
+  for (auto &selection : selections)
+  {
+    parsers.emplace_back(new StateFilter(false, ""));
+    selection.models.Init(this->models);
+    selection.links.Init(this->links);
+    selection.joints.Init(this->joints);
+  }
+
+  ProcessStates(this->threads,
+      [&](const unsigned int _worker, const std::string &_stateString,
+        StateOutput &_output)
+      {
+        gazebo::physics::WorldState state;
+        parsers[_worker]->Parse(_stateString, state);
+        _output.time = state.GetSimTime();
+
+        std::ostringstream time;
+        time << _output.time.sec << '.' << std::setw(9)
+          << std::setfill('0') << _output.time.nsec;
+
+        std::vector<std::ostringstream> tables(3);
+        for (auto &table : tables)
+          table.precision(std::numeric_limits<double>::max_digits10);
+
+        for (auto const &model : state.GetModelStates())
+        {
+          if (selections[_worker].models.Match(model.first))
+          {
+            ExportModel(model.second, model.first, time.str(),
+                selections[_worker], tables);
+          }
+        }
+
+        for (auto &table : tables)
+          _output.outputs.push_back(table.str());
+      },
+      [&files](const StateOutput &_output)
+      {
+        for (size_t i = 0; i < files.size(); ++i)
+          files[i] << _output.outputs[i];
+      });
+
+  for (auto &file : files)
+  {
+    file.close();
+    if (file.fail())
+      return false;
+  }
+  return true;
+}
+
 /////////////////////////////////////////////////
 LogCommand::LogCommand()
   : Command("log", "Introspects and manipulates Gazebo log files.")
@@ -618,11 +1012,21 @@ LogCommand::LogCommand()
      "encoding commands. By default, the output file will have the same "
      "encoding as the source file. Override with the --encoding option")
     ("encoding,n", po::value<std::string>(),
-     "Specify the encoding (txt, zlib, or bz2) for an output file. "
-     "Valid in conjunction with the output command. See also the "
+     "Specify the encoding (txt, zlib, bz2, zstd or lz4) for an output "
+     "file. Valid in conjunction with the output command. See also the "
      "--output argument.")
+    ("export,x", po::value<std::string>(),
+     "Export the states of a log file to CSV tables models.csv, links.csv "
+     "and joints.csv, in the given directory. The filter option selects "
+     "the exported entities by name.")
+    ("diff-digest", po::value<std::string>(),
+     "Compare the state digests recorded in the log file with those of "
+     "the given log file, and print the first step where they differ. "
+     "The digests are recorded when the world has state digests "
+     "enabled.")
     ("filter", po::value<std::string>(),
-     "Filter output. Valid only with the echo, step, and output commands");
+     "Filter output. Valid only with the echo, step, output and export "
+     "commands");
 }
 
 /////////////////////////////////////////////////
@@ -700,6 +1104,13 @@ bool LogCommand::RunImpl()
     this->Output(this->vm["output"].as<std::string>(), filter, raw, stamp, hz,
         encoding);
   }
+  else if (this->vm.count("export"))
+    this->Export(this->vm["export"].as<std::string>(), filter);
+  else if (this->vm.count("diff-digest"))
+  {
+    return this->DiffDigest(filename,
+        this->vm["diff-digest"].as<std::string>());
+  }
   else if (this->vm.count("echo"))
     this->Echo(filter, raw, stamp, hz);
   else if (this->vm.count("step"))
@@ -841,10 +1252,13 @@ void LogCommand::Output(const std::string &_outFilename,
   std::string stateString, bufferString;
 
   std::string encoding = _encoding.empty() ? play->Encoding() : _encoding;
-  if (encoding != "txt" && encoding != "zlib" && encoding != "bz2")
+  if (!gazebo::util::IsLogEncodingSupported(encoding))
   {
     std::cerr << "Invalid log file encoding[" << encoding << "]. "
-      << "Use one of: txt, bz2, zlib.\n";
+      << "Use one of:";
+    for (auto const &supported : gazebo::util::LogEncodings())
+      std::cerr << " " << supported;
+    std::cerr << ".\n";
     outFile.close();
     return;
   }
@@ -856,29 +1270,23 @@ void LogCommand::Output(const std::string &_outFilename,
     outFile.write(header.c_str(), header.size());
   }
 
-  StateFilter filter(!_raw, _stamp, _hz);
-  filter.Init(_filter);
+  // The first frame is the world description.
+  if (play->Step(stateString) && !_raw)
+    this->OutputWriter(outFile, stateString, _raw, encoding);
 
-  unsigned int i = 0;
-  while (play->Step(stateString))
-  {
-    if (i == 0 && !_raw)
-    {
-      this->OutputWriter(outFile, stateString, _raw, encoding);
-    }
-    else
-    {
-      bufferString += filter.Filter(stateString);
+  StreamFilter filter(!_raw, _stamp, _hz, _filter,
+      std::thread::hardware_concurrency());
 
-      if (i%1000 == 0 && !bufferString.empty())
+  unsigned int i = 0;
+  filter.Run([&](const std::string &_output)
       {
-        this->OutputWriter(outFile, bufferString, _raw, encoding);
-        bufferString.clear();
-      }
-    }
-
-    ++i;
-  }
+        bufferString += _output;
+        if (++i % 1000 == 0)
+        {
+          this->OutputWriter(outFile, bufferString, _raw, encoding);
+          bufferString.clear();
+        }
+      });
 
   if (!bufferString.empty())
     this->OutputWriter(outFile, bufferString, _raw, encoding);
@@ -892,6 +1300,126 @@ void LogCommand::Output(const std::string &_outFilename,
   outFile.close();
 }
 
+/////////////////////////////////////////////////
+void LogCommand::Export(const std::string &_path, const std::string &_filter)
+{
+  gazebo::util::LogPlay *play = gazebo::util::LogPlay::Instance();
+
+  // The first frame is the world description.
+  std::string sdfString;
+  play->Step(sdfString);
+
+  LogExporter exporter(_filter, std::thread::hardware_concurrency());
+  if (!exporter.Export(_path))
+    std::cerr << "Unable to export the log file to [" << _path << "]\n";
+}
+
+/////////////////////////////////////////////////
+/// \brief State digest recorded in a log frame.
+class LogFrameDigest
+{
+  /// \brief Iterations of the world when the state was captured.
+  public: uint64_t iterations = 0;
+
+  /// \brief The digest.
+  public: uint64_t digest = 0;
+
+  /// \brief Simulation time of the frame.
+  public: gazebo::common::Time simTime;
+};
+
+/////////////////////////////////////////////////
+/// \brief Read the state digests of the open log file, from the current
+/// position to the end.
+/// \return The digests, in the order of the frames.
+static std::vector<LogFrameDigest> ReadDigests()
+{
+  std::vector<LogFrameDigest> digests;
+  std::string frame;
+  while (gazebo::util::LogPlay::Instance()->Step(frame))
+  {
+    LogFrameDigest digest;
+    if (!gazebo::util::LogPlay::FrameDigest(frame, digest.iterations,
+          digest.digest))
+    {
+      continue;
+    }
+
+    const std::string kStart = "<sim_time>";
+    const size_t pos = frame.find(kStart);
+    if (pos != std::string::npos)
+    {
+      std::istringstream stream(frame.substr(pos + kStart.size(), 32));
+      stream >> digest.simTime;
+    }
+    digests.push_back(digest);
+  }
+  return digests;
+}
+
+/////////////////////////////////////////////////
+bool LogCommand::DiffDigest(const std::string &_filename,
+    const std::string &_other)
+{
+  const std::vector<LogFrameDigest> first = ReadDigests();
+  if (!this->LoadLogFromFile(_other))
+    return false;
+  const std::vector<LogFrameDigest> second = ReadDigests();
+
+  if (first.empty() || second.empty())
+  {
+    std::cerr << "The log file [" << (first.empty() ? _filename : _other)
+      << "] has no state digests. Record it with state digests enabled.\n";
+    return false;
+  }
+
+  // Both logs are read in full, so a scan finds the exact first step that
+  // differs, even if the runs converge again afterwards.
+  std::unordered_map<uint64_t, uint64_t> secondDigests;
+  for (auto const &frame : second)
+    secondDigests[frame.iterations] = frame.digest;
+
+  size_t common = 0;
+  const LogFrameDigest *lastMatch = nullptr;
+  for (auto const &frame : first)
+  {
+    auto other = secondDigests.find(frame.iterations);
+    if (other == secondDigests.end())
+      continue;
+
+    ++common;
+    if (other->second == frame.digest)
+    {
+      lastMatch = &frame;
+      continue;
+    }
+
+    std::cout << "Diverged at iteration " << frame.iterations
+      << ", sim time " << std::fixed << std::setprecision(6)
+      << frame.simTime.Double() << ": "
+      << gazebo::physics::StateHasher::ToString(frame.digest) << " != "
+      << gazebo::physics::StateHasher::ToString(other->second) << "\n";
+    if (lastMatch)
+    {
+      std::cout << "Last match at iteration " << lastMatch->iterations
+        << ", sim time " << lastMatch->simTime.Double() << "\n";
+    }
+    else
+      std::cout << "The first common step already differs.\n";
+    return false;
+  }
+
+  if (common == 0)
+  {
+    std::cerr << "The log files have no step in common.\n";
+    return false;
+  }
+
+  std::cout << "The state digests of " << common
+    << " common steps match.\n";
+  return true;
+}
+
 /////////////////////////////////////////////////
 void LogCommand::Echo(const std::string &_filter, bool _raw,
     const std::string &_stamp, double _hz)
@@ -903,30 +1431,24 @@ void LogCommand::Echo(const std::string &_filter, bool _raw,
   if (!_raw)
     std::cout << play->Header() << std::endl;
 
-  StateFilter filter(!_raw, _stamp, _hz);
-  filter.Init(_filter);
-
-  unsigned int i = 0;
-  while (play->Step(stateString))
+  auto write = [_raw](const std::string &_output)
   {
-    if (i > 0)
-      stateString = filter.Filter(stateString);
-    else if (i == 0 && _raw)
-      stateString.clear();
+    if (!_raw)
+      std::cout << "<chunk encoding='txt'><![CDATA[\n";
 
-    if (!stateString.empty())
-    {
-      if (!_raw)
-        std::cout << "<chunk encoding='txt'><![CDATA[\n";
+    std::cout << _output;
 
-      std::cout << stateString;
+    if (!_raw)
+      std::cout << "]]></chunk>\n";
+  };
 
-      if (!_raw)
-        std::cout << "]]></chunk>\n";
-    }
+  // The first frame is the world description.
+  if (play->Step(stateString) && !_raw && !stateString.empty())
+    write(stateString);
 
-    ++i;
-  }
+  StreamFilter filter(!_raw, _stamp, _hz, _filter,
+      std::thread::hardware_concurrency());
+  filter.Run(write);
 
   if (!_raw)
     std::cout << "</gazebo_log>\n";
@@ -1074,43 +1596,9 @@ void LogCommand::OutputWriter(std::ofstream &_outFile,
 {
   if (!_raw)
   {
-    std::string buffer = "<chunk encoding='" + _encoding + "'>\n<![CDATA[";
-
-    if (_encoding == "txt")
-      buffer.append(_stateString);
-    else if (_encoding == "zlib")
-    {
-      std::string str;
-
-      // Compress to zlib
-      {
-        boost::iostreams::filtering_ostream out;
-        out.push(boost::iostreams::zlib_compressor());
-        out.push(std::back_inserter(str));
-        boost::iostreams::copy(
-            boost::make_iterator_range(_stateString), out);
-      }
-
-      // Encode in base64.
-      Base64Encode(str.c_str(), str.size(), buffer);
-    }
-    else if (_encoding == "bz2")
-    {
-      std::string str;
-
-      // Compress to bzip2
-      {
-        boost::iostreams::filtering_ostream out;
-        out.push(boost::iostreams::bzip2_compressor());
-        out.push(std::back_inserter(str));
-        boost::iostreams::copy(
-            boost::make_iterator_range(_stateString), out);
-      }
-
-      // Encode in base64.
-      Base64Encode(str.c_str(), str.size(), buffer);
-    }
-
+    std::string buffer = "<chunk encoding='" + _encoding + "' frames='" +
+      gazebo::util::LogRecord::FrameIndex(_stateString) + "'>\n<![CDATA[";
+    gazebo::util::EncodeLogChunk(_encoding, _stateString, buffer);
     buffer.append("]]>\n</chunk>\n");
     _outFile.write(buffer.c_str(), buffer.size());
   }
@@ -17,14 +17,43 @@
 #ifndef GAZEBO_TOOLS_GZLOG_HH_
 #define GAZEBO_TOOLS_GZLOG_HH_
 
+#include <functional>
 #include <string>
 #include <list>
+#include <unordered_map>
+
+#include <boost/regex.hpp>
+#include <sdf/sdf.hh>
 
 #include <gazebo/physics/WorldState.hh>
 #include "gz.hh"
 
 namespace gazebo
 {
+  /// \brief Names matched by a filter pattern, in which '*' matches any
+  /// sequence of characters. The pattern is compiled once, and the result
+  /// is cached for each name, since the same entities are in every state.
+  class NameFilter
+  {
+    /// \brief Set the pattern.
+    /// \param[in] _pattern The pattern. Empty or "*" matches every name.
+    public: void Init(const std::string &_pattern);
+
+    /// \brief Check whether a name matches the pattern.
+    /// \param[in] _name The name.
+    /// \return True if the name matches.
+    public: bool Match(const std::string &_name);
+
+    /// \brief True if every name matches.
+    private: bool all = true;
+
+    /// \brief The compiled pattern.
+    private: boost::regex regex;
+
+    /// \brief Result of the match, by name.
+    private: std::unordered_map<std::string, bool> matches;
+  };
+
   /// \brief Base class for all filters.
   class FilterBase
   {
@@ -76,17 +105,20 @@ namespace gazebo
     /// \param[in] _state Link state to filter.
     /// \param[in] _partIter Iterator to the filtered string parts.
     /// \return Filtered joint string.
-    public: std::string FilterParts(gazebo::physics::JointState &_state,
+    public: std::string FilterParts(const gazebo::physics::JointState &_state,
                 std::list<std::string>::iterator _partIter);
 
     /// \brief Filter the joints in a Model state, and output the result
     /// as a string.
     /// \param[in] _state The model state to filter.
     /// \return Filtered string.
-    public: std::string Filter(gazebo::physics::ModelState &_state);
+    public: std::string Filter(const gazebo::physics::ModelState &_state);
 
     /// \brief The list of filter strings.
     public: std::list<std::string> parts;
+
+    /// \brief The joint names to output.
+    private: NameFilter names;
   };
 
   /// \brief Filter for link state.
@@ -106,17 +138,20 @@ namespace gazebo
     /// \param[in] _state Link state to filter.
     /// \param[in] _partIter Iterator to the filtered string parts.
     /// \return Filtered string
-    public: std::string FilterParts(gazebo::physics::LinkState &_state,
+    public: std::string FilterParts(const gazebo::physics::LinkState &_state,
                 std::list<std::string>::iterator _partIter);
 
     /// \brief Filter the links in a Model state, and output the result
     /// as a string.
     /// \param[in] _state The model state to filter.
     /// \return Filtered string.
-    public: std::string Filter(gazebo::physics::ModelState &_state);
+    public: std::string Filter(const gazebo::physics::ModelState &_state);
 
     /// \brief The list of filter strings.
     public: std::list<std::string> parts;
+
+    /// \brief The link names to output.
+    private: NameFilter names;
   };
 
   /// \brief Filter for model state.
@@ -139,14 +174,14 @@ namespace gazebo
     /// \param[in] _state Model state to filter.
     /// \param[in] _partIter Iterator to the filtered string parts.
     /// \return Filtered string
-    public: std::string FilterParts(gazebo::physics::ModelState &_state,
+    public: std::string FilterParts(const gazebo::physics::ModelState &_state,
                 std::list<std::string>::iterator _partIter);
 
     /// \brief Filter the models in a World state, and output the result
     /// as a string.
     /// \param[in] _state The World state to filter.
     /// \return Filtered string.
-    public: std::string Filter(gazebo::physics::WorldState &_state);
+    public: std::string Filter(const gazebo::physics::WorldState &_state);
 
     /// \brief The list of model parts to filter.
     public: std::list<std::string> parts;
@@ -156,6 +191,9 @@ namespace gazebo
 
     /// \brief Pointer to the joint filter.
     public: JointFilter *jointFilter;
+
+    /// \brief The model names to output.
+    private: NameFilter names;
   };
 
   /// \brief Filter interface for an entire state.
@@ -177,9 +215,29 @@ namespace gazebo
     /// \return Filtered string
     public: std::string Filter(const std::string &_stateString);
 
+    /// \brief Filter a parsed state, ignoring the output rate.
+    /// \param[in] _state The state to filter.
+    /// \return Filtered string
+    public: std::string Filter(const gazebo::physics::WorldState &_state);
+
+    /// \brief Parse a state.
+    /// \param[in] _stateString The state string.
+    /// \param[out] _state The parsed state.
+    public: void Parse(const std::string &_stateString,
+                gazebo::physics::WorldState &_state);
+
+    /// \brief Check whether a state is skipped to output states at the
+    /// requested rate. States must be checked in order.
+    /// \param[in] _time Simulation time of the state.
+    /// \return True if the state is skipped.
+    public: bool Skip(const gazebo::common::Time &_time);
+
     /// \brief Filter for a model.
     private: ModelFilter filter;
 
+    /// \brief State element used to parse the states.
+    private: sdf::ElementPtr stateSdf;
+
     /// \brief Rate at which to output states.
     private: double hz;
 
@@ -187,6 +245,77 @@ namespace gazebo
     private: gazebo::common::Time prevTime;
   };
 
+  /// \brief Filters the states of the open log file on several threads,
+  /// keeping their order.
+  class StreamFilter
+  {
+    /// \brief Constructor
+    /// \param[in] _xmlOutput True to format output as XML
+    /// \param[in] _stamp Type of stamp to apply.
+    /// Valid values are (sim,real,wall)
+    /// \param[in] _hz Rate at which to output states, 0 for every state.
+    /// \param[in] _filter The filter parameters.
+    /// \param[in] _threads Number of worker threads. With 0, the states
+    /// are filtered on the calling thread.
+    public: StreamFilter(bool _xmlOutput, const std::string &_stamp,
+                double _hz, const std::string &_filter,
+                unsigned int _threads);
+
+    /// \brief Filter the states of the open log file, from the current
+    /// position to the end of the file.
+    /// \param[in] _write Function called with the output of each state
+    /// that has some, in the order of the states.
+    public: void Run(
+                const std::function<void (const std::string &)> &_write);
+
+    /// \brief True to format output as XML.
+    private: bool xmlOutput;
+
+    /// \brief Type of stamp to apply.
+    private: std::string stamp;
+
+    /// \brief Rate at which to output states.
+    private: double hz;
+
+    /// \brief The filter parameters.
+    private: std::string filter;
+
+    /// \brief Number of worker threads.
+    private: unsigned int threads;
+  };
+
+  /// \brief Exports the states of the open log file to CSV tables, one per
+  /// entity type: models.csv, links.csv and joints.csv. A row has the
+  /// simulation time, the scoped name of the entity, and typed columns.
+  class LogExporter
+  {
+    /// \brief Constructor
+    /// \param[in] _filter Selection of the entities, in the
+    /// model/link/joint form of the filter option. Only the names are
+    /// used, e.g. "pr2/r_*" exports the pr2 model and its links whose name
+    /// starts with "r_".
+    /// \param[in] _threads Number of worker threads, at least 1.
+    public: LogExporter(const std::string &_filter, unsigned int _threads);
+
+    /// \brief Export the states, from the current position of the open
+    /// log file to its end.
+    /// \param[in] _path Directory of the tables, created if needed.
+    /// \return True on success.
+    public: bool Export(const std::string &_path);
+
+    /// \brief Name pattern of the models.
+    private: std::string models;
+
+    /// \brief Name pattern of the links.
+    private: std::string links;
+
+    /// \brief Name pattern of the joints.
+    private: std::string joints;
+
+    /// \brief Number of worker threads.
+    private: unsigned int threads;
+  };
+
   /// \brief Log command
   class LogCommand : public Command
   {
@@ -216,12 +345,30 @@ namespace gazebo
     /// \param[in] _hz Hertz rate.
     /// \param[in] _encoding Specify output log file encoding. If empty, the
     /// encoding from the source log file is used.
-    /// Valid values include (txt, zlib, bz2)
+    /// Valid values include (txt, zlib, bz2, zstd, lz4)
     private: void Output(const std::string &_outFilename,
                  const std::string &_filter, const bool _raw,
                  const std::string &_stamp, const double _hz,
                  const std::string &_encoding = "");
 
+    /// \brief Export the states of a log file to CSV tables.
+    /// \param[in] _path Directory of the tables.
+    /// \param[in] _filter Filter string
+    /// \sa LogExporter
+    private: void Export(const std::string &_path,
+                 const std::string &_filter);
+
+    /// \brief Compare the state digests of the open log file with those of
+    /// another log file, and print the first frame where they differ.
+    /// Frames are matched by iteration, so the logs may have been recorded
+    /// with different periods.
+    /// \param[in] _filename Path of the open log file.
+    /// \param[in] _other Path of the other log file.
+    /// \return False if a log file has no state digests, or if the
+    /// digests differ.
+    private: bool DiffDigest(const std::string &_filename,
+                 const std::string &_other);
+
     /// \brief Dump the contents of a log file to screen
     /// \param[in] _filter Filter string
     /// \param[in] _raw True to output data without xml formatting.
@@ -264,7 +411,7 @@ namespace gazebo
     /// \param[in] _outFile Output file stream reference.
     /// \param[in] _stateString SDF state string to write
     /// \param[in] _raw True to output data without xml formatting.
-    /// \param[in] _encoding Encoding type: txt, zlib, bz2
+    /// \param[in] _encoding Encoding type: txt, zlib, bz2, zstd, lz4
     private: void OutputWriter(std::ofstream &_outFile,
                  const std::string &_stateString,
                  const bool _raw, const std::string &_encoding);
@@ -24,7 +24,12 @@
 #include <sdf/sdf_config.h>
 
 #include <stdio.h>
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
 #include <string>
+#include <vector>
 
 // This header file isn't needed if shasums are used
 // #include "test/data/pr2_state_log_expected.h"
@@ -299,6 +304,96 @@ TEST(gz_log, HzFilter)
   EXPECT_EQ(validEcho, echo);
 }
 
+/////////////////////////////////////////////////
+/// Check that filtering a log of thousands of states, which is done in
+/// batches on several threads, keeps the order of the states.
+TEST(gz_log, FilterOrder)
+{
+  std::string echo = custom_exec(std::string(GZ_LOG_PATH +
+        " -e -r --stamp sim --filter double_pendulum_with_base.pose.z -f ") +
+      PROJECT_SOURCE_PATH + "/test/logs/state.log");
+
+  std::istringstream stream(echo);
+  double time, z;
+  double prevTime = 0;
+  size_t count = 0;
+  while (stream >> time >> z)
+  {
+    EXPECT_GT(time, prevTime);
+    prevTime = time;
+    ++count;
+  }
+  EXPECT_GT(count, 3000u);
+
+  // The output rate is applied in order too
+  echo = custom_exec(std::string(GZ_LOG_PATH +
+        " -e -r -z 10 --stamp sim --filter double_pendulum_with_base.pose.z"
+        " -f ") + PROJECT_SOURCE_PATH + "/test/logs/state.log");
+
+  stream.clear();
+  stream.str(echo);
+  prevTime = 0;
+  count = 0;
+  while (stream >> time >> z)
+  {
+    EXPECT_GE(time - prevTime, 0.1 - 1e-6);
+    prevTime = time;
+    ++count;
+  }
+  EXPECT_GT(count, 30u);
+  EXPECT_LT(count, 40u);
+}
+
+/////////////////////////////////////////////////
+/// \brief Read the lines of a file.
+/// \param[in] _filename Name of the file.
+/// \return The lines.
+std::vector<std::string> read_lines(const std::string &_filename)
+{
+  std::vector<std::string> lines;
+  std::ifstream file(_filename);
+  std::string line;
+  while (std::getline(file, line))
+    lines.push_back(line);
+  return lines;
+}
+
+/////////////////////////////////////////////////
+/// Check the CSV tables of 'gz log --export'
+TEST(gz_log, Export)
+{
+  const std::string path = "/tmp/__gz_log_export_test";
+  custom_exec("rm -rf " + path);
+  custom_exec(std::string(GZ_LOG_PATH + " -x " + path +
+        " --filter pr2/r_upper* -f ") +
+      PROJECT_SOURCE_PATH + "/test/data/pr2_state.log");
+
+  // One row per state for the model
+  std::vector<std::string> models = read_lines(path + "/models.csv");
+  ASSERT_EQ(3u, models.size());
+  EXPECT_EQ("sim_time,model,x,y,z,qw,qx,qy,qz", models[0]);
+  EXPECT_NEAR(0.021344, std::stod(models[1]), 1e-6);
+  EXPECT_NEAR(0.028958, std::stod(models[2]), 1e-6);
+  EXPECT_NE(std::string::npos, models[1].find(",pr2,"));
+
+  // Only the selected links
+  std::vector<std::string> links = read_lines(path + "/links.csv");
+  ASSERT_GT(links.size(), 1u);
+  EXPECT_EQ("sim_time,link,x,y,z,qw,qx,qy,qz,vx,vy,vz,wx,wy,wz", links[0]);
+  for (size_t i = 1; i < links.size(); ++i)
+  {
+    EXPECT_NE(std::string::npos, links[i].find(",pr2::r_upper"));
+    EXPECT_EQ(15, std::count(links[i].begin(), links[i].end(), ',') + 1);
+  }
+
+  // Every joint, since no joint was selected
+  std::vector<std::string> joints = read_lines(path + "/joints.csv");
+  ASSERT_GT(joints.size(), 1u);
+  EXPECT_EQ("sim_time,joint,axis,position", joints[0]);
+
+  custom_exec("rm -rf " + path);
+}
+
 /////////////////////////////////////////////////
 /// Check to raw filtering with time stamps
 TEST(gz_log, RawFilterStamp)
@@ -373,6 +468,65 @@ TEST(gz_log, Step)
     FAIL() << "Please add support for sdf version: " << SDF_VERSION;
 }
 
+/////////////////////////////////////////////////
+/// \brief Write a text log file whose frames carry state digests.
+/// \param[in] _path Path of the log file.
+/// \param[in] _digests Digest of each frame, the frame of iteration i + 1.
+void write_digest_log(const std::string &_path,
+    const std::vector<uint64_t> &_digests)
+{
+  std::ofstream out(_path);
+  out << "<?xml version='1.0'?>\n<gazebo_log>\n<header>\n"
+    << "<log_version>1.0</log_version>\n"
+    << "<gazebo_version>11.0.0</gazebo_version>\n"
+    << "<rand_seed>1</rand_seed>\n<log_start>0 0</log_start>\n"
+    << "<log_end>0 0</log_end>\n</header>\n"
+    << "<chunk encoding='txt'>\n<![CDATA["
+    << "<sdf version='1.6'><world name='default'></world></sdf>";
+  for (size_t i = 0; i < _digests.size(); ++i)
+  {
+    out << "<sdf version='1.6'><!--digest " << i + 1 << " " << std::hex
+      << std::setw(16) << std::setfill('0') << _digests[i] << std::dec
+      << "--><state world_name='default'><sim_time>0 " << (i + 1) * 1000000
+      << "</sim_time></state></sdf>";
+  }
+  out << "]]>\n</chunk>\n</gazebo_log>\n";
+}
+
+/////////////////////////////////////////////////
+/// Check 'gz log --diff-digest'
+TEST(gz_log, DiffDigest)
+{
+  const std::string first = "/tmp/__gz_log_digest_test_1";
+  const std::string second = "/tmp/__gz_log_digest_test_2";
+  write_digest_log(first, {1, 2, 3, 4, 5});
+
+  // Same trajectory
+  write_digest_log(second, {1, 2, 3, 4, 5});
+  std::string output = custom_exec(GZ_LOG_PATH + " -f " + first +
+      " --diff-digest " + second);
+  EXPECT_NE(std::string::npos, output.find("5 common steps match"))
+    << output;
+
+  // Diverges at the fourth step
+  write_digest_log(second, {1, 2, 3, 40, 50});
+  output = custom_exec(GZ_LOG_PATH + " -f " + first +
+      " --diff-digest " + second);
+  EXPECT_NE(std::string::npos, output.find(
+        "Diverged at iteration 4, sim time 0.004000: "
+        "0000000000000004 != 0000000000000028")) << output;
+  EXPECT_NE(std::string::npos, output.find("Last match at iteration 3"))
+    << output;
+
+  // A log without digests can't be compared
+  output = custom_exec(GZ_LOG_PATH + " -f " + first + " --diff-digest " +
+      PROJECT_SOURCE_PATH + "/test/data/pr2_state.log");
+  EXPECT_EQ(std::string::npos, output.find("match")) << output;
+
+  std::remove(first.c_str());
+  std::remove(second.c_str());
+}
+
 /////////////////////////////////////////////////
 TEST(gz_log, HangCheck)
 {
@@ -52,11 +52,13 @@ TopicCommand::TopicCommand()
      "View topic data using a QT widget.")
     ("hz,z", po::value<std::string>(), "Get publish frequency.")
     ("bw,b", po::value<std::string>(), "Get topic bandwidth.")
+    ("stats,s", po::value<std::string>()->implicit_value(""),
+     "Get transport statistics of the server, optionally of one topic.")
     ("publish,p", po::value<std::string>(), "Publish message on a topic.")
     ("request,r", po::value<std::string>(), "Send a request.")
     ("unformatted,u", "Output data from echo without formatting.")
     ("duration,d", po::value<uint64_t>(), "Duration (seconds) to run. "
-     "Applicable with echo, hz, and bw")
+     "Applicable with echo, hz, bw, and stats")
     ("msg,m", po::value<std::string>(), "Message to send on topic. "
      "Applicable with publish and request")
     ("file,f", po::value<std::string>(), "Path to a file containing the "
@@ -96,6 +98,8 @@ bool TopicCommand::RunImpl()
     this->Hz(this->vm["hz"].as<std::string>());
   else if (this->vm.count("bw"))
     this->Bw(this->vm["bw"].as<std::string>());
+  else if (this->vm.count("stats"))
+    this->Stats(this->vm["stats"].as<std::string>());
   else if (this->vm.count("view"))
     this->View(this->vm["view"].as<std::string>());
   else if (this->vm.count("publish"))
@@ -347,6 +351,88 @@ void TopicCommand::Bw(const std::string &_topic)
     this->sigCondition.wait(lock);
 }
 
+/////////////////////////////////////////////////
+/// \brief Estimate a quantile of a latency histogram.
+/// \param[in] _msg The histogram.
+/// \param[in] _q Quantile, between 0 and 1.
+/// \return Upper bound of the bin holding the quantile, capped by the
+/// largest value, in seconds.
+static double Quantile(const msgs::TransportStatistics::Histogram &_msg,
+    const double _q)
+{
+  const double target = _q * _msg.count();
+  uint64_t count = 0;
+  for (int i = 0; i < _msg.bin_count_size(); ++i)
+  {
+    count += _msg.bin_count(i);
+    if (count >= target)
+      return std::min(_msg.upper_bound(i), _msg.max());
+  }
+  return _msg.max();
+}
+
+/////////////////////////////////////////////////
+void TopicCommand::StatsCB(ConstTransportStatisticsPtr &_msg)
+{
+  std::cout << "Process[" << _msg->process() << "]\n";
+
+  for (const auto &topic : _msg->topic())
+  {
+    if (!this->statsTopic.empty() && topic.name() != this->statsTopic)
+      continue;
+
+    std::cout << "  Topic[" << topic.name() << "] "
+      << "Messages[" << topic.messages() << "] "
+      << "Bytes[" << topic.bytes() << "] "
+      << "Queue[" << topic.queue_depth() << "] "
+      << "Drops[" << topic.drops() << "] "
+      << std::fixed << std::setprecision(6)
+      << "Serialize[" << topic.serialize_time() << " s]";
+
+    if (topic.has_latency() && topic.latency().count() > 0)
+    {
+      const msgs::TransportStatistics::Histogram &latency = topic.latency();
+      std::cout << " Latency[mean " << latency.sum() / latency.count()
+        << " p50 " << Quantile(latency, 0.5)
+        << " p99 " << Quantile(latency, 0.99)
+        << " max " << latency.max() << " s]";
+    }
+    std::cout << std::defaultfloat << "\n";
+  }
+
+  if (!this->statsTopic.empty())
+    return;
+
+  for (const auto &conn : _msg->connection())
+  {
+    std::cout << "  Connection[" << conn.remote_uri() << "] "
+      << "Sent[" << conn.messages_sent() << " msgs, "
+      << conn.bytes_sent() << " B] "
+      << "Received[" << conn.messages_received() << " msgs, "
+      << conn.bytes_received() << " B] "
+      << "Queue[" << conn.queue_depth() << "] "
+      << "Drops[" << conn.drops() << "] "
+      << std::fixed << std::setprecision(6)
+      << "Write[" << conn.write_time() << " s]"
+      << std::defaultfloat << "\n";
+  }
+}
+
+/////////////////////////////////////////////////
+void TopicCommand::Stats(const std::string &_topic)
+{
+  this->statsTopic = _topic;
+  transport::SubscriberPtr sub = this->node->Subscribe(
+      "~/transport/stats", &TopicCommand::StatsCB, this);
+
+  boost::mutex::scoped_lock lock(this->sigMutex);
+  if (this->vm.count("duration"))
+    this->sigCondition.timed_wait(lock,
+        boost::posix_time::seconds(this->vm["duration"].as<uint64_t>()));
+  else
+    this->sigCondition.wait(lock);
+}
+
 /////////////////////////////////////////////////
 void TopicCommand::View(const std::string &_topic)
 {
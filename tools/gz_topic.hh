@@ -72,6 +72,15 @@ namespace gazebo
     /// \param[in] _topic Topic name.
     private: void Bw(const std::string &_topic);
 
+    /// \brief Subscription callback used by Stats().
+    /// \param[in] _msg Transport counters of the server.
+    private: void StatsCB(ConstTransportStatisticsPtr &_msg);
+
+    /// \brief Output the transport counters of the server.
+    /// \param[in] _topic Topic to output, empty for all the topics and
+    /// connections.
+    private: void Stats(const std::string &_topic);
+
     /// \brief View topic information using QT.
     /// \param[in] _topic Name of the topic to view. Empty will bring up
     /// a topic selector.
@@ -103,6 +112,9 @@ namespace gazebo
 
     /// \brief Buffer of message publish times, used by Bw().
     private: std::vector<common::Time> bwTime;
+
+    /// \brief Topic output by Stats(), empty for all.
+    private: std::string statsTopic;
   };
 }
 #endif